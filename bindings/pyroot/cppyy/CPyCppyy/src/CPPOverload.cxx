@@ -654,9 +654,12 @@ static PyObject* mp_call(CPPOverload* pymeth, PyObject* args, PyObject* kwds)
 // look for known signatures ...
     auto& dispatchMap = pymeth->fMethodInfo->fDispatchMap;
     PyCallable* memoized_pc = nullptr;
-    for (const auto& p : dispatchMap) {
-        if (p.first == sighash) {
-            memoized_pc = p.second;
+    for (auto ip = dispatchMap.begin(); ip != dispatchMap.end(); ++ip) {
+        if (ip->first == sighash) {
+            memoized_pc = ip->second;
+        // keep the most recent signature up front, as hot loops tend to repeat it
+            if (ip != dispatchMap.begin())
+                std::iter_swap(dispatchMap.begin(), ip);
             break;
         }
     }
@@ -1441,6 +1441,30 @@ void Cppyy::AddTypeReducer(const std::string& /*reducable*/, const std::string&
 
 
 // type offsets --------------------------------------------------------------
+static bool HasVirtualBase(TClass* klass)
+{
+// true if any class in the hierarchy of klass is inherited virtually, in which
+// case base offsets depend on the actual object and can not be memoized
+    TList* bases = klass->GetListOfBases();
+    if (!bases)
+        return false;
+    for (auto base : TRangeDynCast<TBaseClass>(bases)) {
+        if (!base)
+            continue;
+        if (base->Property() & kIsVirtualBase)
+            return true;
+        TClass* bcl = base->GetClassPointer();
+        if (bcl && HasVirtualBase(bcl))
+            return true;
+    }
+    return false;
+}
+
+// memoized up-cast offsets of hierarchies without virtual bases; these sit on
+// the path of every method call through a derived instance
+static std::map<std::pair<Cppyy::TCppType_t, Cppyy::TCppType_t>, ptrdiff_t> sBaseOffsets;
+static std::map<Cppyy::TCppType_t, bool> sHasVirtualBase;
+
 ptrdiff_t Cppyy::GetBaseOffset(TCppType_t derived, TCppType_t base,
     TCppObject_t address, int direction, bool rerror)
 {
@@ -1448,6 +1472,11 @@ ptrdiff_t Cppyy::GetBaseOffset(TCppType_t derived, TCppType_t base,
     if (derived == base || !(base && derived))
         return (ptrdiff_t)0;
 
+    auto key = std::make_pair(derived, base);
+    auto io = sBaseOffsets.find(key);
+    if (io != sBaseOffsets.end())
+        return direction < 0 ? -io->second : io->second;
+
     TClassRef& cd = type_from_handle(derived);
     TClassRef& cb = type_from_handle(base);
 
@@ -1477,6 +1506,12 @@ ptrdiff_t Cppyy::GetBaseOffset(TCppType_t derived, TCppType_t base,
     if (offset == -1)   // Cling error, treat silently
         return rerror ? (ptrdiff_t)offset : 0;
 
+    auto iv = sHasVirtualBase.find(derived);
+    if (iv == sHasVirtualBase.end())
+        iv = sHasVirtualBase.emplace(derived, HasVirtualBase(cd.GetClass())).first;
+    if (!iv->second)
+        sBaseOffsets[key] = (ptrdiff_t)offset;
+
     return (ptrdiff_t)(direction < 0 ? -offset : offset);
 }
 
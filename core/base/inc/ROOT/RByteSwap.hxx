@@ -0,0 +1,31 @@
+/// \file ROOT/RByteSwap.hxx
+/// \date 2024-10-14
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RByteSwap
+#define ROOT_RByteSwap
+
+#include <cstddef>
+
+namespace ROOT {
+namespace Internal {
+
+/// Copy `n` elements of 2, 4 or 8 bytes from `src` to `dst`, reversing the byte order of every element, i.e.
+/// converting between the big-endian on-file representation and a little-endian host. The buffers need not be
+/// aligned. `dst` and `src` may be identical, for an in-place conversion, but must not overlap otherwise.
+/// Depending on the host, the conversion uses AVX2 or NEON byte shuffles, selected at runtime on x86-64.
+void ByteSwapCopy16(void *dst, const void *src, std::size_t n);
+void ByteSwapCopy32(void *dst, const void *src, std::size_t n);
+void ByteSwapCopy64(void *dst, const void *src, std::size_t n);
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
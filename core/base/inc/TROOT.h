@@ -120,6 +120,7 @@ protected:
    TString         fGitCommit;              ///< Git commit SHA1 of built
    TString         fGitBranch;              ///< Git branch
    TString         fGitDate;                ///< Date and time when make was run
+   std::atomic<bool> fGitInfoRead{false};   ///<! Whether etc/gitinfo.txt was read
    Int_t           fTimer;                  ///< Timer flag
    std::atomic<TApplication*> fApplication; ///< Pointer to current application
    TInterpreter    *fInterpreter;           ///< Command interpreter
@@ -220,8 +221,8 @@ public:
    Bool_t            GetForceStyle() const { return fForceStyle; }
    Int_t             GetBuiltDate() const { return fBuiltDate; }
    Int_t             GetBuiltTime() const { return fBuiltTime; }
-   const char       *GetGitCommit() const { return fGitCommit; }
-   const char       *GetGitBranch() const { return fGitBranch; }
+   const char       *GetGitCommit() const;
+   const char       *GetGitBranch() const;
    const char       *GetGitDate();
    Int_t             GetVersionDate() const { return fVersionDate; }
    Int_t             GetVersionTime() const { return fVersionTime; }
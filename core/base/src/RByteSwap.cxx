@@ -0,0 +1,153 @@
+/// \file RByteSwap.cxx
+/// \date 2024-10-14
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RByteSwap.hxx"
+#include "Byteswap.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define R__BYTESWAP_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define R__BYTESWAP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+/// Byte-swaps the elements one by one; memcpy makes the possibly unaligned accesses well-defined and is
+/// optimized away by the compiler.
+template <typename T, T (*kSwap)(T)>
+void ByteSwapScalar(unsigned char *dst, const unsigned char *src, std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      T x;
+      std::memcpy(&x, src + i * sizeof(T), sizeof(T));
+      x = kSwap(x);
+      std::memcpy(dst + i * sizeof(T), &x, sizeof(T));
+   }
+}
+
+std::uint16_t Swap16(std::uint16_t x)
+{
+   return R__bswap_16(x);
+}
+std::uint32_t Swap32(std::uint32_t x)
+{
+   return R__bswap_32(x);
+}
+std::uint64_t Swap64(std::uint64_t x)
+{
+   return R__bswap_64(x);
+}
+
+#if defined(R__BYTESWAP_X86)
+
+/// Byte-swaps the leading multiple of 32 bytes with a per-lane shuffle of elements of N bytes.
+/// Returns the number of elements processed.
+template <std::size_t N>
+__attribute__((target("avx2"))) std::size_t
+ByteSwapAvx2(unsigned char *dst, const unsigned char *src, std::size_t n)
+{
+   constexpr std::size_t kNElemsPerBlock = 32 / N;
+   // For every byte of a 16 byte lane, the index of its source byte
+   alignas(16) unsigned char idx[16];
+   for (std::size_t b = 0; b < 16; ++b)
+      idx[b] = static_cast<unsigned char>((b / N) * N + (N - 1 - b % N));
+   const __m128i lane = _mm_load_si128(reinterpret_cast<const __m128i *>(idx));
+   const __m256i mask = _mm256_broadcastsi128_si256(lane);
+   std::size_t i = 0;
+   for (; i + 2 * kNElemsPerBlock <= n; i += 2 * kNElemsPerBlock) {
+      const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * N));
+      const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * N + 32));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * N), _mm256_shuffle_epi8(a, mask));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * N + 32), _mm256_shuffle_epi8(b, mask));
+   }
+   for (; i + kNElemsPerBlock <= n; i += kNElemsPerBlock) {
+      const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * N));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * N), _mm256_shuffle_epi8(a, mask));
+   }
+   return i;
+}
+
+#elif defined(R__BYTESWAP_NEON)
+
+/// Byte-swaps the leading multiple of 16 bytes with the NEON element reversal instructions.
+/// Returns the number of elements processed.
+template <std::size_t N>
+std::size_t ByteSwapNeon(unsigned char *dst, const unsigned char *src, std::size_t n)
+{
+   constexpr std::size_t kNElemsPerBlock = 16 / N;
+   std::size_t i = 0;
+   for (; i + kNElemsPerBlock <= n; i += kNElemsPerBlock) {
+      const uint8x16_t a = vld1q_u8(src + i * N);
+      uint8x16_t r;
+      if (N == 2)
+         r = vrev16q_u8(a);
+      else if (N == 4)
+         r = vrev32q_u8(a);
+      else
+         r = vrev64q_u8(a);
+      vst1q_u8(dst + i * N, r);
+   }
+   return i;
+}
+
+#endif
+
+/// Returns the number of leading elements that were processed by a vectorized kernel
+template <std::size_t N>
+std::size_t ByteSwapVectorized(unsigned char *dst, const unsigned char *src, std::size_t n)
+{
+#if defined(R__BYTESWAP_X86)
+   static const auto kernel = []() {
+      if (__builtin_cpu_supports("avx2"))
+         return &ByteSwapAvx2<N>;
+      return static_cast<decltype(&ByteSwapAvx2<N>)>(nullptr);
+   }();
+   return kernel ? kernel(dst, src, n) : 0;
+#elif defined(R__BYTESWAP_NEON)
+   return ByteSwapNeon<N>(dst, src, n);
+#else
+   (void)dst;
+   (void)src;
+   (void)n;
+   return 0;
+#endif
+}
+
+template <typename T, T (*kSwap)(T)>
+void ByteSwapCopy(void *dst, const void *src, std::size_t n)
+{
+   auto d = static_cast<unsigned char *>(dst);
+   auto s = static_cast<const unsigned char *>(src);
+   const std::size_t done = ByteSwapVectorized<sizeof(T)>(d, s, n);
+   ByteSwapScalar<T, kSwap>(d + done * sizeof(T), s + done * sizeof(T), n - done);
+}
+
+} // anonymous namespace
+
+void ROOT::Internal::ByteSwapCopy16(void *dst, const void *src, std::size_t n)
+{
+   ByteSwapCopy<std::uint16_t, Swap16>(dst, src, n);
+}
+
+void ROOT::Internal::ByteSwapCopy32(void *dst, const void *src, std::size_t n)
+{
+   ByteSwapCopy<std::uint32_t, Swap32>(dst, src, n);
+}
+
+void ROOT::Internal::ByteSwapCopy64(void *dst, const void *src, std::size_t n)
+{
+   ByteSwapCopy<std::uint64_t, Swap64>(dst, src, n);
+}
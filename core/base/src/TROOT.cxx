@@ -706,8 +706,6 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
    fBuiltDate       = IDATQQ(__DATE__);
    fBuiltTime       = ITIMQQ(__TIME__);
 
-   ReadGitInfo();
-
    fClasses         = new THashTable(800,3); fClasses->UseRWLock();
    //fIdMap           = new IdMap_t;
    fStreamerInfo    = new TObjArray(100); fStreamerInfo->UseRWLock();
@@ -2424,10 +2422,17 @@ Longptr_t TROOT::ProcessLineFast(const char *line, Int_t *error)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Read Git commit information and branch name from the
-/// etc/gitinfo.txt file.
+/// etc/gitinfo.txt file. The file is read on the first request of the
+/// information rather than at start-up, which most processes never do.
 
 void TROOT::ReadGitInfo()
 {
+   if (fGitInfoRead)
+      return;
+   R__LOCKGUARD(gROOTMutex);
+   if (fGitInfoRead)
+      return;
+
    TString filename = "gitinfo.txt";
    gSystem->PrependPathName(TROOT::GetEtcDir(), filename);
 
@@ -2447,6 +2452,25 @@ void TROOT::ReadGitInfo()
    } else {
       Error("ReadGitInfo()", "Cannot determine git info: etc/gitinfo.txt not found!");
    }
+   fGitInfoRead = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the Git commit SHA1 of the build.
+
+const char *TROOT::GetGitCommit() const
+{
+   const_cast<TROOT *>(this)->ReadGitInfo();
+   return fGitCommit;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the Git branch of the build.
+
+const char *TROOT::GetGitBranch() const
+{
+   const_cast<TROOT *>(this)->ReadGitInfo();
+   return fGitBranch;
 }
 
 Bool_t &GetReadingObject() {
@@ -2473,6 +2497,7 @@ void TROOT::SetReadingObject(Bool_t flag)
 
 const char *TROOT::GetGitDate()
 {
+   ReadGitInfo();
    if (fGitDate == "") {
       Int_t iday,imonth,iyear, ihour, imin;
       static const char *months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
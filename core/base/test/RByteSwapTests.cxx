@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/RByteSwap.hxx"
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+// Checks all element counts around the vector widths, at an unaligned offset, both out-of-place and in-place.
+void CheckByteSwap(std::size_t width, void (*swap)(void *, const void *, std::size_t))
+{
+   for (std::size_t n = 0; n < 100; ++n) {
+      std::vector<unsigned char> src(n * width + 1);
+      for (std::size_t i = 0; i < src.size(); ++i)
+         src[i] = static_cast<unsigned char>(i * 37 + 11);
+      std::vector<unsigned char> expected(n * width);
+      for (std::size_t i = 0; i < n; ++i)
+         for (std::size_t b = 0; b < width; ++b)
+            expected[i * width + b] = src[1 + i * width + width - 1 - b];
+
+      std::vector<unsigned char> dst(n * width + 1);
+      swap(dst.data() + 1, src.data() + 1, n);
+      EXPECT_EQ(expected, std::vector<unsigned char>(dst.begin() + 1, dst.end())) << "n=" << n;
+
+      swap(src.data() + 1, src.data() + 1, n);
+      EXPECT_EQ(expected, std::vector<unsigned char>(src.begin() + 1, src.end())) << "n=" << n;
+   }
+}
+} // anonymous namespace
+
+TEST(RByteSwap, ByteSwapCopy)
+{
+   CheckByteSwap(2, ROOT::Internal::ByteSwapCopy16);
+   CheckByteSwap(4, ROOT::Internal::ByteSwapCopy32);
+   CheckByteSwap(8, ROOT::Internal::ByteSwapCopy64);
+}
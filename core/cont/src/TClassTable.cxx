@@ -450,6 +450,9 @@ void TClassTable::Add(const char *cname, Version_t id,  const std::type_info &in
    fgIdMap->Add(info.name(),r);
 
    fgSorted = kFALSE;
+
+   // A class which was not found so far might be found now
+   TClass::InvalidateFailedLookups();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -500,6 +503,9 @@ void TClassTable::Add(TProtoClass *proto)
    r->fProto= proto;
 
    fgSorted = kFALSE;
+
+   // A class which was not found so far might be found now
+   TClass::InvalidateFailedLookups();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -527,6 +533,7 @@ ROOT::TClassAlt* TClassTable::AddAlternate(const char *normName, const char *alt
    }
 
    fgAlternate[slot] = new TClassAlt(alternate,normName,fgAlternate[slot]);
+   TClass::InvalidateFailedLookups();
    return fgAlternate[slot];
 }
 
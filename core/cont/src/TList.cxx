@@ -71,6 +71,11 @@ not forced by other constraints:
 Methods 3, 4 and 5 can also easily iterate backwards using either
 a backward TIter (using argument kIterBackward) or by using
 LastLink() and lnk->Prev() or by using the Before() member.
+
+The links are allocated, together with the control block of their
+shared pointer, from thread-local free lists: the memory of the links
+of destroyed lists is reused by the next lists filled in the same thread
+instead of going through the global operator new each time.
 */
 
 #include "TList.h"
@@ -79,8 +84,109 @@ LastLink() and lnk->Prev() or by using the Before() member.
 #include "TVirtualMutex.h"
 #include "TBuffer.h"
 
+#include <cstddef>
+#include <new>
 #include <string>
 
+namespace {
+
+/// Thread-local free lists of memory blocks, one per multiple of kGranularity bytes.
+/// The state is trivially destructible so that it stays accessible while and after
+/// the thread-local objects are destroyed, e.g. for the lists deleted at exit.
+struct TObjLinkPoolState {
+   static constexpr std::size_t kGranularity = 16;
+   static constexpr std::size_t kNSizes = 16;          ///< Blocks larger than 256 bytes are not pooled
+   static constexpr std::size_t kMaxFreeBlocks = 1024; ///< Per size and thread, to bound the memory kept
+
+   struct FreeBlock {
+      FreeBlock *fNext;
+   };
+   enum EStatus { kUninitialized, kAlive, kDestroyed };
+
+   FreeBlock *fHeads[kNSizes];
+   std::size_t fNFree[kNSizes];
+   EStatus fStatus;
+};
+
+thread_local TObjLinkPoolState gObjLinkPool; // zero-initialized, i.e. kUninitialized
+
+/// Releases the free blocks of the thread at its end.
+struct TObjLinkPoolGuard {
+   TObjLinkPoolGuard() { gObjLinkPool.fStatus = TObjLinkPoolState::kAlive; }
+   ~TObjLinkPoolGuard()
+   {
+      gObjLinkPool.fStatus = TObjLinkPoolState::kDestroyed;
+      for (std::size_t i = 0; i < TObjLinkPoolState::kNSizes; ++i) {
+         while (auto block = gObjLinkPool.fHeads[i]) {
+            gObjLinkPool.fHeads[i] = block->fNext;
+            ::operator delete(block);
+         }
+      }
+   }
+};
+
+void *AllocateLinkMemory(std::size_t size)
+{
+   auto &pool = gObjLinkPool;
+   const std::size_t sizeIdx = (size + TObjLinkPoolState::kGranularity - 1) / TObjLinkPoolState::kGranularity;
+   if (sizeIdx >= TObjLinkPoolState::kNSizes || pool.fStatus == TObjLinkPoolState::kDestroyed)
+      return ::operator new(size);
+   if (pool.fStatus == TObjLinkPoolState::kUninitialized) {
+      thread_local TObjLinkPoolGuard guard;
+      (void)guard;
+   }
+   if (auto block = pool.fHeads[sizeIdx]) {
+      pool.fHeads[sizeIdx] = block->fNext;
+      --pool.fNFree[sizeIdx];
+      return block;
+   }
+   return ::operator new(sizeIdx * TObjLinkPoolState::kGranularity);
+}
+
+void DeallocateLinkMemory(void *ptr, std::size_t size)
+{
+   auto &pool = gObjLinkPool;
+   const std::size_t sizeIdx = (size + TObjLinkPoolState::kGranularity - 1) / TObjLinkPoolState::kGranularity;
+   // blocks freed by another thread than the one allocating them simply move to the pool of this thread
+   if (sizeIdx >= TObjLinkPoolState::kNSizes || pool.fStatus != TObjLinkPoolState::kAlive ||
+       pool.fNFree[sizeIdx] >= TObjLinkPoolState::kMaxFreeBlocks) {
+      ::operator delete(ptr);
+      return;
+   }
+   auto block = static_cast<TObjLinkPoolState::FreeBlock *>(ptr);
+   block->fNext = pool.fHeads[sizeIdx];
+   pool.fHeads[sizeIdx] = block;
+   ++pool.fNFree[sizeIdx];
+}
+
+/// Allocator of the links and their shared pointer control block, see std::allocate_shared.
+template <class T>
+struct TObjLinkAllocator {
+   using value_type = T;
+
+   TObjLinkAllocator() = default;
+   template <class U>
+   TObjLinkAllocator(const TObjLinkAllocator<U> &)
+   {
+   }
+
+   T *allocate(std::size_t n) { return static_cast<T *>(AllocateLinkMemory(n * sizeof(T))); }
+   void deallocate(T *ptr, std::size_t n) { DeallocateLinkMemory(ptr, n * sizeof(T)); }
+
+   template <class U>
+   bool operator==(const TObjLinkAllocator<U> &) const
+   {
+      return true;
+   }
+   template <class U>
+   bool operator!=(const TObjLinkAllocator<U> &) const
+   {
+      return false;
+   }
+};
+
+} // anonymous namespace
+
 ClassImp(TList);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -733,7 +839,7 @@ TList::TObjLinkPtr_t TList::NewLink(TObject *obj, const TObjLinkPtr_t &prev)
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
    R__COLLECTION_WRITE_GUARD();
 
-   auto newlink = std::make_shared<TObjLink>(obj);
+   auto newlink = std::allocate_shared<TObjLink>(TObjLinkAllocator<TObjLink>(), obj);
    if (prev) {
       InsertAfter(newlink, prev);
    }
@@ -748,7 +854,7 @@ TList::TObjLinkPtr_t TList::NewOptLink(TObject *obj, Option_t *opt, const TObjLi
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
    R__COLLECTION_WRITE_GUARD();
 
-   auto newlink = std::make_shared<TObjOptLink>(obj, opt);
+   auto newlink = std::allocate_shared<TObjOptLink>(TObjLinkAllocator<TObjOptLink>(), obj, opt);
    if (prev) {
       InsertAfter(newlink, prev);
    }
@@ -0,0 +1,104 @@
+/// \file ROOT/RTrace.hxx
+/// \ingroup Base ROOT7
+/// \date 2024-06-10
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RTrace
+#define ROOT7_RTrace
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ROOT {
+namespace Experimental {
+
+/**
+ Recorder of a timeline of the scopes marked with R__TRACE_SCOPE, e.g. the tasks of the implicit
+ multi-threading, the reading and decompression of baskets and pages, the refills of the TTreeCache,
+ and the processing and merging of RDataFrame event loops.
+
+ The scopes are only compiled in if ROOT is built with `R__ENABLE_TRACING` defined; otherwise
+ R__TRACE_SCOPE expands to nothing. When compiled in, a scope costs a relaxed atomic load unless
+ the recording is enabled with Enable().
+
+ Each thread records into its own ring buffer, without locks: when it is full, the oldest events
+ of the thread are overwritten. WriteChromeTrace() exports the events in the JSON trace event
+ format, which can be opened with https://ui.perfetto.dev or chrome://tracing. It should be called
+ once the recording threads are idle, e.g. after Disable().
+
+ ~~~{.cpp}
+ ROOT::Experimental::RTraceRecorder::Enable();
+ df.Histo1D("x")->Draw();
+ ROOT::Experimental::RTraceRecorder::Disable();
+ ROOT::Experimental::RTraceRecorder::WriteChromeTrace("trace.json");
+ ~~~
+ */
+class RTraceRecorder {
+   static std::atomic<bool> fgEnabled;
+
+public:
+   /// Start recording, with ring buffers of `eventsPerThread` events. The events recorded before are discarded.
+   static void Enable(std::size_t eventsPerThread = 1 << 16);
+   /// Stop recording. The events recorded so far are kept until the next call to Enable().
+   static void Disable() { fgEnabled.store(false, std::memory_order_relaxed); }
+   static bool IsEnabled() { return fgEnabled.load(std::memory_order_relaxed); }
+
+   /// Monotonic time in nanoseconds
+   static std::uint64_t Now();
+   /// Record a scope of the calling thread. `category` and `name` must outlive the recorder, e.g. be string literals.
+   static void Record(const char *category, const char *name, std::uint64_t startNs, std::uint64_t durationNs);
+
+   /// Write the recorded events to `fileName` in the JSON trace event format. Returns false on I/O error.
+   static bool WriteChromeTrace(const std::string &fileName);
+};
+
+/// RAII object recording its lifetime as a scope of the timeline, see R__TRACE_SCOPE
+class RTraceScope {
+   const char *fCategory;
+   const char *fName;
+   std::uint64_t fStart = 0; ///< 0 if the recorder was disabled at construction
+
+public:
+   RTraceScope(const char *category, const char *name) : fCategory(category), fName(name)
+   {
+      if (RTraceRecorder::IsEnabled())
+         fStart = RTraceRecorder::Now();
+   }
+   RTraceScope(const RTraceScope &) = delete;
+   RTraceScope &operator=(const RTraceScope &) = delete;
+   ~RTraceScope()
+   {
+      if (fStart)
+         RTraceRecorder::Record(fCategory, fName, fStart, RTraceRecorder::Now() - fStart);
+   }
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#define R__TRACE_CONCAT_IMPL(A, B) A##B
+#define R__TRACE_CONCAT(A, B) R__TRACE_CONCAT_IMPL(A, B)
+
+/// Record the enclosing scope in the timeline of RTraceRecorder, with a category (e.g. "io") and a name,
+/// both string literals. Compiled out unless `R__ENABLE_TRACING` is defined.
+#ifdef R__ENABLE_TRACING
+#define R__TRACE_SCOPE(CATEGORY, NAME) \
+   ::ROOT::Experimental::RTraceScope R__TRACE_CONCAT(R__traceScope, __LINE__)(CATEGORY, NAME)
+#else
+#define R__TRACE_SCOPE(CATEGORY, NAME) \
+   do {                                \
+   } while (false)
+#endif
+
+#endif
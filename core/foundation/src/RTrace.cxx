@@ -0,0 +1,161 @@
+/// \file RTrace.cxx
+/// \ingroup Base ROOT7
+/// \date 2024-06-10
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RTrace.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace ROOT::Experimental;
+
+std::atomic<bool> RTraceRecorder::fgEnabled{false};
+
+namespace {
+
+struct RTraceEvent {
+   const char *fCategory;
+   const char *fName;
+   std::uint64_t fStart;
+   std::uint64_t fDuration;
+};
+
+/// Ring buffer of the events of a thread. Only written by its thread; fNWritten is published
+/// with release semantics after each event so that the exporter sees complete events.
+struct RThreadTraceBuffer {
+   std::vector<RTraceEvent> fEvents;
+   std::atomic<std::uint64_t> fNWritten{0};
+   unsigned int fThreadIndex;
+
+   RThreadTraceBuffer(std::size_t capacity, unsigned int threadIndex) : fEvents(capacity), fThreadIndex(threadIndex) {}
+};
+
+struct RTraceRegistry {
+   std::mutex fMutex; ///< Taken when a thread registers its buffer, and to export
+   /// Buffers of all the threads that recorded since Enable(), kept after the threads end
+   std::vector<std::shared_ptr<RThreadTraceBuffer>> fBuffers;
+   std::size_t fCapacity = 1 << 16;
+   std::atomic<unsigned int> fGeneration{0}; ///< Incremented by Enable(), to replace the buffers of the threads
+   unsigned int fNThreads = 0;
+};
+
+RTraceRegistry &GetRegistry()
+{
+   static RTraceRegistry registry;
+   return registry;
+}
+
+struct RLocalTraceBuffer {
+   std::shared_ptr<RThreadTraceBuffer> fBuffer;
+   unsigned int fGeneration = 0;
+};
+
+RThreadTraceBuffer &GetLocalBuffer()
+{
+   thread_local RLocalTraceBuffer local;
+   auto &registry = GetRegistry();
+   const auto generation = registry.fGeneration.load(std::memory_order_acquire);
+   if (!local.fBuffer || local.fGeneration != generation) {
+      std::lock_guard<std::mutex> lock(registry.fMutex);
+      local.fBuffer = std::make_shared<RThreadTraceBuffer>(registry.fCapacity, registry.fNThreads++);
+      local.fGeneration = generation;
+      registry.fBuffers.emplace_back(local.fBuffer);
+   }
+   return *local.fBuffer;
+}
+
+/// Names are string literals in practice, but escape the characters that would break the JSON anyway
+void WriteJSONString(FILE *file, const char *str)
+{
+   std::fputc('"', file);
+   for (; *str; ++str) {
+      if (*str == '"' || *str == '\\')
+         std::fputc('\\', file);
+      if (static_cast<unsigned char>(*str) >= 0x20)
+         std::fputc(*str, file);
+   }
+   std::fputc('"', file);
+}
+
+} // anonymous namespace
+
+void RTraceRecorder::Enable(std::size_t eventsPerThread)
+{
+   auto &registry = GetRegistry();
+   {
+      std::lock_guard<std::mutex> lock(registry.fMutex);
+      registry.fBuffers.clear();
+      registry.fCapacity = std::max<std::size_t>(eventsPerThread, 1);
+      registry.fNThreads = 0;
+      registry.fGeneration.fetch_add(1, std::memory_order_release);
+   }
+   fgEnabled.store(true, std::memory_order_relaxed);
+}
+
+std::uint64_t RTraceRecorder::Now()
+{
+   using namespace std::chrono;
+   // never 0, which RTraceScope uses for "not recording"
+   return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() | 1;
+}
+
+void RTraceRecorder::Record(const char *category, const char *name, std::uint64_t startNs, std::uint64_t durationNs)
+{
+   auto &buffer = GetLocalBuffer();
+   const auto n = buffer.fNWritten.load(std::memory_order_relaxed);
+   buffer.fEvents[n % buffer.fEvents.size()] = {category, name, startNs, durationNs};
+   buffer.fNWritten.store(n + 1, std::memory_order_release);
+}
+
+bool RTraceRecorder::WriteChromeTrace(const std::string &fileName)
+{
+   FILE *file = std::fopen(fileName.c_str(), "w");
+   if (!file)
+      return false;
+
+   auto &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   // times are written in microseconds relative to the first event
+   std::uint64_t origin = UINT64_MAX;
+   for (const auto &buffer : registry.fBuffers) {
+      const auto n = buffer->fNWritten.load(std::memory_order_acquire);
+      const auto first = n > buffer->fEvents.size() ? n - buffer->fEvents.size() : 0;
+      for (auto i = first; i < n; ++i)
+         origin = std::min(origin, buffer->fEvents[i % buffer->fEvents.size()].fStart);
+   }
+
+   std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+   bool firstEvent = true;
+   for (const auto &buffer : registry.fBuffers) {
+      std::fprintf(file, "%s\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                   firstEvent ? "" : ",", buffer->fThreadIndex, buffer->fThreadIndex);
+      firstEvent = false;
+      const auto n = buffer->fNWritten.load(std::memory_order_acquire);
+      const auto first = n > buffer->fEvents.size() ? n - buffer->fEvents.size() : 0;
+      for (auto i = first; i < n; ++i) {
+         const auto &event = buffer->fEvents[i % buffer->fEvents.size()];
+         std::fputs(",\n{\"ph\":\"X\",\"name\":", file);
+         WriteJSONString(file, event.fName);
+         std::fputs(",\"cat\":", file);
+         WriteJSONString(file, event.fCategory);
+         std::fprintf(file, ",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->fThreadIndex,
+                      (event.fStart - origin) / 1000., event.fDuration / 1000.);
+      }
+   }
+   std::fputs("\n]}\n", file);
+   return std::fclose(file) == 0;
+}
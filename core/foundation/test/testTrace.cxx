@@ -0,0 +1,67 @@
+// The scopes are compiled in for this test, whatever the configuration of ROOT
+#define R__ENABLE_TRACING
+#include "ROOT/RTrace.hxx"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using ROOT::Experimental::RTraceRecorder;
+
+namespace {
+std::string ReadFile(const std::string &fileName)
+{
+   std::ifstream file(fileName);
+   std::stringstream content;
+   content << file.rdbuf();
+   return content.str();
+}
+
+std::size_t CountOccurrences(const std::string &str, const std::string &pattern)
+{
+   std::size_t count = 0;
+   for (auto pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+      ++count;
+   return count;
+}
+} // anonymous namespace
+
+TEST(RTrace, DisabledRecordsNothing)
+{
+   RTraceRecorder::Enable();
+   RTraceRecorder::Disable();
+   {
+      R__TRACE_SCOPE("test", "disabled");
+   }
+   const std::string fileName = "testTrace_disabled.json";
+   ASSERT_TRUE(RTraceRecorder::WriteChromeTrace(fileName));
+   EXPECT_EQ(ReadFile(fileName).find("disabled"), std::string::npos);
+   std::remove(fileName.c_str());
+}
+
+TEST(RTrace, ScopesOfSeveralThreads)
+{
+   RTraceRecorder::Enable(8);
+   auto work = []() {
+      for (int i = 0; i < 20; ++i) {
+         R__TRACE_SCOPE("test", "scope");
+      }
+   };
+   std::thread t1(work), t2(work);
+   t1.join();
+   t2.join();
+   RTraceRecorder::Disable();
+
+   const std::string fileName = "testTrace_threads.json";
+   ASSERT_TRUE(RTraceRecorder::WriteChromeTrace(fileName));
+   const auto trace = ReadFile(fileName);
+   // the ring buffers keep the last 8 events of each thread
+   EXPECT_EQ(CountOccurrences(trace, "\"name\":\"scope\""), 16u);
+   EXPECT_EQ(CountOccurrences(trace, "\"thread_name\""), 2u);
+   EXPECT_EQ(trace.find("{\"displayTimeUnit\""), 0u);
+   std::remove(fileName.c_str());
+}
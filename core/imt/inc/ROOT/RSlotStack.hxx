@@ -11,27 +11,34 @@
 #ifndef ROOT_RSLOTSTACK
 #define ROOT_RSLOTSTACK
 
-#include <ROOT/TSpinMutex.hxx>
-
-#include <stack>
+#include <atomic>
+#include <memory>
 
 namespace ROOT {
 namespace Internal {
 
-/// A thread-safe stack of N indexes (0 to size - 1).
+/// A thread-safe pool of N indexes (0 to size - 1).
 /// RSlotStack can be used to safely assign a "processing slot" number to
 /// each thread in multi-thread applications.
 /// In release builds, pop and push operations are unchecked, potentially
 /// resulting in undefined behavior if more slot numbers than available are
-/// requested.
+/// returned.
 /// An important design assumption is that a slot will almost always be available
 /// when a thread asks for it, and if it is not available it will be very soon,
-/// therefore a spinlock is used for synchronization.
+/// therefore the slots are taken and returned without locks and a thread that
+/// finds none busy-waits for one.
+/// Each thread first tries to take the slot it used last, so that the data
+/// attached to a slot tends to stay in the caches of the same core.
 class RSlotStack {
 private:
+   struct alignas(64) Slot {
+      std::atomic<bool> fBusy{false};
+   };
+
    const unsigned int fSize;
-   std::stack<unsigned int> fStack;
-   ROOT::TSpinMutex fMutex;
+   std::unique_ptr<Slot[]> fSlots;
+
+   bool TryAcquire(unsigned int slot);
 
 public:
    RSlotStack() = delete;
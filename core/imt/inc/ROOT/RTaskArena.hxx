@@ -43,6 +43,8 @@ class ROpaqueTaskArena;
 
 namespace Internal {
 
+class RNumaPinningObserver;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the available number of logical cores.
 ///
@@ -53,6 +55,12 @@ namespace Internal {
 ////////////////////////////////////////////////////////////////////////////////
 int LogicalCPUBandwidthControl();
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the number of NUMA nodes with CPUs that the process is allowed to
+/// run on (linux only, otherwise 1).
+////////////////////////////////////////////////////////////////////////////////
+unsigned NumaNodesInAffinity();
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Wrapper for tbb::task_arena.
@@ -69,6 +77,7 @@ private:
    RTaskArenaWrapper(unsigned maxConcurrency = 0);
    friend std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency);
    std::unique_ptr<ROOT::ROpaqueTaskArena> fTBBArena;
+   std::unique_ptr<RNumaPinningObserver> fPinningObserver; ///< Pins the workers to NUMA nodes, if requested
    static unsigned fNWorkers;
 };
 
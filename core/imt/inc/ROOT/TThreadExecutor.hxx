@@ -28,8 +28,11 @@
 #include "RTaskArena.hxx"
 #include "TError.h"
 
+#include <algorithm> //std::sort, std::inplace_merge
+#include <cstddef> //std::size_t
 #include <functional> //std::function
 #include <initializer_list>
+#include <iterator> //std::iterator_traits
 #include <memory>
 #include <numeric> //std::accumulate
 #include <type_traits> //std::enable_if
@@ -95,9 +98,23 @@ namespace ROOT {
       template<class T, class R> auto Reduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs));
       template<class T, class BINARYOP> auto Reduce(const std::vector<T> &objs, BINARYOP redfunc) -> decltype(redfunc(objs.front(), objs.front()));
 
+      // Parallel algorithms
+      //
+      void ParallelFor(std::size_t begin, std::size_t end, std::size_t grainSize,
+                       const std::function<void(std::size_t begin, std::size_t end)> &f);
+      template <class RandomIt, class Compare = std::less<>>
+      void ParallelSort(RandomIt first, RandomIt last, Compare comp = Compare{}, std::size_t grainSize = 0);
+      template <class RandomIt, class OutputIt, class BinaryOp = std::plus<>>
+      OutputIt InclusiveScan(RandomIt first, RandomIt last, OutputIt dFirst, BinaryOp op = BinaryOp{},
+                             std::size_t grainSize = 0);
+      template <class RandomIt, class UnaryPredicate>
+      RandomIt Partition(RandomIt first, RandomIt last, UnaryPredicate pred, std::size_t grainSize = 0);
+
       unsigned GetPoolSize() const;
 
    private:
+      std::vector<std::size_t> ChunkBounds(std::size_t n, std::size_t grainSize) const;
+
       // Implementation of the Map functions declared in the parent class (TExecutorCRTP)
       //
       template <class F, class Cond = validMapReturnCond<F>>
@@ -597,6 +614,133 @@ namespace ROOT {
       return redfunc(objs);
    }
 
+   //////////////////////////////////////////////////////////////////////////
+   /// \brief Sort the range [first, last) in parallel, like std::sort.
+   ///
+   /// The range is split in chunks of at least `grainSize` elements that are sorted in parallel
+   /// and then merged pairwise, the merges of each round running in parallel.
+   /// \param first, last The range to sort.
+   /// \param comp Comparison function object, as for std::sort.
+   /// \param grainSize Minimum number of elements per chunk, a default value is used if 0.
+   template <class RandomIt, class Compare>
+   void TThreadExecutor::ParallelSort(RandomIt first, RandomIt last, Compare comp, std::size_t grainSize)
+   {
+      const auto bounds = ChunkBounds(last - first, grainSize);
+      const std::size_t nChunks = bounds.size() - 1;
+      if (nChunks < 2) {
+         std::sort(first, last, comp);
+         return;
+      }
+      ParallelFor(0u, nChunks, 1u, [&](std::size_t begin, std::size_t end) {
+         for (auto c = begin; c < end; ++c)
+            std::sort(first + bounds[c], first + bounds[c + 1], comp);
+      });
+      for (std::size_t width = 1; width < nChunks; width *= 2) {
+         const std::size_t nMerges = (nChunks + 2 * width - 1) / (2 * width);
+         ParallelFor(0u, nMerges, 1u, [&](std::size_t begin, std::size_t end) {
+            for (auto m = begin; m < end; ++m) {
+               const auto lo = 2 * width * m;
+               const auto mid = std::min(lo + width, nChunks);
+               const auto hi = std::min(lo + 2 * width, nChunks);
+               if (mid < hi)
+                  std::inplace_merge(first + bounds[lo], first + bounds[mid], first + bounds[hi], comp);
+            }
+         });
+      }
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// \brief Compute the inclusive prefix "sums" of [first, last) in parallel, like std::inclusive_scan.
+   ///
+   /// Each chunk is scanned in parallel, then the totals of the previous chunks are added to it in
+   /// a second parallel pass: `op` must be associative. The output may be the input range itself.
+   /// \param first, last The input range.
+   /// \param dFirst The beginning of the output range, a random access iterator.
+   /// \param op Binary associative operation, std::plus by default.
+   /// \param grainSize Minimum number of elements per chunk, a default value is used if 0.
+   /// \return The iterator past the last element written.
+   template <class RandomIt, class OutputIt, class BinaryOp>
+   OutputIt TThreadExecutor::InclusiveScan(RandomIt first, RandomIt last, OutputIt dFirst, BinaryOp op,
+                                           std::size_t grainSize)
+   {
+      using T = typename std::iterator_traits<RandomIt>::value_type;
+      const auto bounds = ChunkBounds(last - first, grainSize);
+      const std::size_t nChunks = bounds.size() - 1;
+      if (nChunks == 0)
+         return dFirst;
+      std::vector<T> totals(nChunks);
+      ParallelFor(0u, nChunks, 1u, [&](std::size_t begin, std::size_t end) {
+         for (auto c = begin; c < end; ++c) {
+            T acc = first[bounds[c]];
+            dFirst[bounds[c]] = acc;
+            for (auto i = bounds[c] + 1; i < bounds[c + 1]; ++i) {
+               acc = op(acc, first[i]);
+               dFirst[i] = acc;
+            }
+            totals[c] = acc;
+         }
+      });
+      for (std::size_t c = 1; c < nChunks; ++c)
+         totals[c] = op(totals[c - 1], totals[c]);
+      ParallelFor(1u, nChunks, 1u, [&](std::size_t begin, std::size_t end) {
+         for (auto c = begin; c < end; ++c) {
+            for (auto i = bounds[c]; i < bounds[c + 1]; ++i)
+               dFirst[i] = op(totals[c - 1], dFirst[i]);
+         }
+      });
+      return dFirst + bounds.back();
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// \brief Reorder [first, last) in parallel so that the elements satisfying `pred` come first,
+   /// like std::stable_partition: the relative order of the elements is kept in both groups.
+   ///
+   /// The elements are moved through a temporary buffer, so they must be default constructible
+   /// and move assignable. `pred` is called exactly once per element, concurrently.
+   /// \param first, last The range to partition.
+   /// \param pred Unary predicate returning true for the elements of the first group.
+   /// \param grainSize Minimum number of elements per chunk, a default value is used if 0.
+   /// \return The iterator to the first element of the second group.
+   template <class RandomIt, class UnaryPredicate>
+   RandomIt TThreadExecutor::Partition(RandomIt first, RandomIt last, UnaryPredicate pred, std::size_t grainSize)
+   {
+      using T = typename std::iterator_traits<RandomIt>::value_type;
+      const auto bounds = ChunkBounds(last - first, grainSize);
+      const std::size_t nChunks = bounds.size() - 1;
+      if (nChunks < 2)
+         return std::stable_partition(first, last, pred);
+
+      const std::size_t n = bounds.back();
+      std::vector<char> selected(n);
+      std::vector<std::size_t> nSelected(nChunks + 1, 0u); // becomes the number of selected elements before each chunk
+      ParallelFor(0u, nChunks, 1u, [&](std::size_t begin, std::size_t end) {
+         for (auto c = begin; c < end; ++c) {
+            for (auto i = bounds[c]; i < bounds[c + 1]; ++i) {
+               selected[i] = pred(first[i]) ? 1 : 0;
+               nSelected[c + 1] += selected[i];
+            }
+         }
+      });
+      for (std::size_t c = 1; c <= nChunks; ++c)
+         nSelected[c] += nSelected[c - 1];
+      const std::size_t nTotalSelected = nSelected[nChunks];
+
+      std::vector<T> buffer(n);
+      ParallelFor(0u, nChunks, 1u, [&](std::size_t begin, std::size_t end) {
+         for (auto c = begin; c < end; ++c) {
+            auto posSelected = nSelected[c];
+            auto posOther = nTotalSelected + bounds[c] - nSelected[c];
+            for (auto i = bounds[c]; i < bounds[c + 1]; ++i)
+               buffer[selected[i] ? posSelected++ : posOther++] = std::move(first[i]);
+         }
+      });
+      ParallelFor(0u, nChunks, 1u, [&](std::size_t begin, std::size_t end) {
+         for (auto c = begin; c < end; ++c)
+            std::move(buffer.begin() + bounds[c], buffer.begin() + bounds[c + 1], first + bounds[c]);
+      });
+      return first + nTotalSelected;
+   }
+
 } // namespace ROOT
 
 #endif   // R__USE_IMT
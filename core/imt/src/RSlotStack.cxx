@@ -8,31 +8,49 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
-#include <ROOT/TSeq.hxx>
 #include <ROOT/RSlotStack.hxx>
 
 #include <cassert>
-#include <mutex> // std::lock_guard
+#include <thread> // std::this_thread::yield
 
-ROOT::Internal::RSlotStack::RSlotStack(unsigned int size) : fSize(size)
+namespace {
+/// The stack and the slot last taken by this thread
+struct RLastSlot {
+   const ROOT::Internal::RSlotStack *fStack = nullptr;
+   unsigned int fSlot = 0;
+};
+thread_local RLastSlot gLastSlot;
+} // anonymous namespace
+
+ROOT::Internal::RSlotStack::RSlotStack(unsigned int size) : fSize(size), fSlots(new Slot[size]) {}
+
+bool ROOT::Internal::RSlotStack::TryAcquire(unsigned int slot)
 {
-   for (auto i : ROOT::TSeqU(size))
-      fStack.push(i);
+   auto &busy = fSlots[slot].fBusy;
+   // cheap load first, so that threads do not fight over the cache line of a taken slot
+   return !busy.load(std::memory_order_relaxed) && !busy.exchange(true, std::memory_order_acquire);
 }
 
 void ROOT::Internal::RSlotStack::ReturnSlot(unsigned int slot)
 {
-   std::lock_guard<ROOT::TSpinMutex> guard(fMutex);
-   assert(fStack.size() < fSize && "Trying to put back a slot to a full stack!");
-   (void)fSize;
-   fStack.push(slot);
+   assert(slot < fSize && fSlots[slot].fBusy.load() && "Trying to put back a slot to a full stack!");
+   fSlots[slot].fBusy.store(false, std::memory_order_release);
 }
 
 unsigned int ROOT::Internal::RSlotStack::GetSlot()
 {
-   std::lock_guard<ROOT::TSpinMutex> guard(fMutex);
-   assert(!fStack.empty() && "Trying to pop a slot from an empty stack!");
-   const auto slot = fStack.top();
-   fStack.pop();
-   return slot;
+   auto &last = gLastSlot;
+   const unsigned int start = last.fStack == this && last.fSlot < fSize ? last.fSlot : 0u;
+   while (true) {
+      for (unsigned int i = 0; i < fSize; ++i) {
+         const unsigned int slot = (start + i) % fSize;
+         if (TryAcquire(slot)) {
+            last.fStack = this;
+            last.fSlot = slot;
+            return slot;
+         }
+      }
+      assert(false && "Trying to pop a slot from an empty stack!");
+      std::this_thread::yield();
+   }
 }
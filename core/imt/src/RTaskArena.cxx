@@ -7,13 +7,21 @@
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TThread.h"
+#include <atomic>
 #include <fstream>
 #include <mutex>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 #include "tbb/task_arena.h"
 #define TBB_PREVIEW_GLOBAL_CONTROL 1 // required for TBB versions preceding 2019_U4
 #include "tbb/global_control.h"
+#define TBB_PREVIEW_LOCAL_OBSERVER 1 // required for arena observers in TBB versions preceding 2021
+#include "tbb/task_scheduler_observer.h"
+#ifdef R__LINUX
+#include <sched.h>
+#endif
 
 //////////////////////////////////////////////////////////////////////////
 ///
@@ -40,6 +48,12 @@
 /// root[] gTA->Access().max_concurrency() // call to tbb::task_arena::max_concurrency()
 /// ~~~
 ///
+/// On linux, setting the environment variable `ROOT_IMT_PIN_THREADS=1` pins
+/// the worker threads of the arena to the NUMA nodes of the machine, in turn:
+/// each worker runs only on the CPUs of its node, so that the memory it
+/// allocates (first touch) stays local for the rest of its life. This has no
+/// effect if the process may run on a single NUMA node only.
+///
 //////////////////////////////////////////////////////////////////////////
 
 namespace ROOT {
@@ -82,6 +96,100 @@ int LogicalCPUBandwidthControl()
    return std::thread::hardware_concurrency();
 }
 
+namespace {
+
+#ifdef R__LINUX
+/// The CPUs of each NUMA node that the process is allowed to run on; nodes without such CPUs are skipped.
+std::vector<cpu_set_t> GetNumaNodeCPUs()
+{
+   std::vector<cpu_set_t> nodes;
+   cpu_set_t allowed;
+   CPU_ZERO(&allowed);
+   if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+      return nodes;
+   for (int node = 0;; ++node) {
+      std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      if (!f)
+         break;
+      // the format is a comma separated list of ranges, e.g. "0-3,8-11"
+      std::string list;
+      std::getline(f, list);
+      std::istringstream ranges(list);
+      std::string range;
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      while (std::getline(ranges, range, ',')) {
+         if (range.empty())
+            continue;
+         const auto dash = range.find('-');
+         const int first = std::stoi(range.substr(0, dash));
+         const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+         for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed))
+               CPU_SET(cpu, &cpus);
+         }
+      }
+      if (CPU_COUNT(&cpus) > 0)
+         nodes.push_back(cpus);
+   }
+   return nodes;
+}
+#endif
+
+bool IsThreadPinningRequested()
+{
+   const char *env = gSystem->Getenv("ROOT_IMT_PIN_THREADS");
+   return env && std::strtol(env, nullptr, 0) > 0;
+}
+
+} // anonymous namespace
+
+unsigned NumaNodesInAffinity()
+{
+#ifdef R__LINUX
+   const auto nNodes = GetNumaNodeCPUs().size();
+   return nNodes > 0 ? nNodes : 1u;
+#else
+   return 1u;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Observer of the task arena restricting each worker thread to the CPUs of a
+/// NUMA node, the nodes being assigned in turn. A worker keeps its node when it
+/// leaves and re-enters the arena, so that the buffers it allocated stay local.
+////////////////////////////////////////////////////////////////////////////////
+class RNumaPinningObserver : public tbb::task_scheduler_observer {
+#ifdef R__LINUX
+   std::vector<cpu_set_t> fNodes;
+#endif
+   std::atomic<unsigned> fNextNode{0};
+
+public:
+   RNumaPinningObserver(tbb::task_arena &arena) : tbb::task_scheduler_observer(arena)
+   {
+#ifdef R__LINUX
+      fNodes = GetNumaNodeCPUs();
+#endif
+      observe(true);
+   }
+   ~RNumaPinningObserver() { observe(false); }
+
+   void on_scheduler_entry(bool isWorker) final
+   {
+#ifdef R__LINUX
+      // the threads joining the arena to wait for their tasks are left alone
+      thread_local bool isPinned = false;
+      if (!isWorker || isPinned || fNodes.size() < 2)
+         return;
+      const auto &cpus = fNodes[fNextNode++ % fNodes.size()];
+      isPinned = sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+      (void)isWorker;
+#endif
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initializes the tbb::task_arena within RTaskArenaWrapper.
 ///
@@ -89,6 +197,7 @@ int LogicalCPUBandwidthControl()
 /// * Checks for CPU bandwidth control and avoids oversubscribing
 /// * If no BC in place and maxConcurrency<1, defaults to the default tbb number of threads,
 /// which is CPU affinity aware
+/// * Pins the workers to the NUMA nodes if `ROOT_IMT_PIN_THREADS` is set
 ////////////////////////////////////////////////////////////////////////////////
 RTaskArenaWrapper::RTaskArenaWrapper(unsigned maxConcurrency) : fTBBArena(new ROpaqueTaskArena{})
 {
@@ -104,12 +213,16 @@ RTaskArenaWrapper::RTaskArenaWrapper(unsigned maxConcurrency) : fTBBArena(new RO
                                    "from this task arena available for execution.");
    }
    fTBBArena->initialize(maxConcurrency);
+   if (IsThreadPinningRequested())
+      fPinningObserver = std::make_unique<RNumaPinningObserver>(*fTBBArena);
    fNWorkers = maxConcurrency;
    ROOT::EnableThreadSafety();
 }
 
 RTaskArenaWrapper::~RTaskArenaWrapper()
 {
+   // stop observing before the arena is destroyed
+   fPinningObserver.reset();
    fNWorkers = 0u;
 }
 
@@ -3,6 +3,7 @@
 
 #include "ROOT/TThreadExecutor.hxx"
 #include "ROpaqueTaskArena.hxx"
+#include "ROOT/RTrace.hxx"
 #if !defined(_MSC_VER)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
@@ -26,6 +27,8 @@
 /// This class inherits its interfaces from ROOT::TExecutorCRTP\n, adapting them for multithreaded
 /// parallelism and extends them supporting:
 /// * Parallel `Foreach` operations.
+/// * Parallel algorithms on ranges with grain-size control: `ParallelFor`, `ParallelSort`,
+/// `InclusiveScan` and a stable `Partition`.
 /// * Custom task granularity and partial reduction, by specifying reduction function
 /// and the number of chunks as extra parameters for the Map call. This is specially useful
 /// to reduce the size of intermediate results when dealing with a sizeable number of elements
@@ -169,11 +172,57 @@ void TThreadExecutor::ParallelFor(unsigned start, unsigned end, unsigned step,
    }
    fTaskArenaW->Access().execute([&] {
       tbb::this_task_arena::isolate([&] {
-         tbb::parallel_for(start, end, step, f);
+         tbb::parallel_for(start, end, step, [&f](unsigned int i) {
+            R__TRACE_SCOPE("imt", "TThreadExecutor task");
+            f(i);
+         });
       });
    });
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// \brief Execute a function in parallel over the subranges of [begin, end).
+///
+/// \param begin Start index of the loop.
+/// \param end End index of the loop.
+/// \param grainSize Minimum number of indices passed to a single call of `f`.
+/// \param f function to execute on the subranges [b, e) of [begin, end).
+void TThreadExecutor::ParallelFor(std::size_t begin, std::size_t end, std::size_t grainSize,
+                                  const std::function<void(std::size_t begin, std::size_t end)> &f)
+{
+   if (GetPoolSize() > tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism)) {
+      Warning("TThreadExecutor::ParallelFor",
+              "tbb::global_control is limiting the number of parallel workers."
+              " Proceeding with %zu threads this time",
+              tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
+   }
+   if (begin >= end)
+      return;
+   fTaskArenaW->Access().execute([&] {
+      tbb::this_task_arena::isolate([&] {
+         tbb::parallel_for(tbb::blocked_range<std::size_t>(begin, end, std::max<std::size_t>(grainSize, 1u)),
+                           [&f](const tbb::blocked_range<std::size_t> &r) {
+                              R__TRACE_SCOPE("imt", "TThreadExecutor task");
+                              f(r.begin(), r.end());
+                           });
+      });
+   });
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// \brief Split n elements in chunks of at least `grainSize` elements (16384 if 0), at most four
+/// per worker thread. Returns the bounds of the chunks, i.e. the number of chunks plus one values.
+std::vector<std::size_t> TThreadExecutor::ChunkBounds(std::size_t n, std::size_t grainSize) const
+{
+   if (grainSize == 0)
+      grainSize = 16384;
+   const std::size_t nChunks = std::min<std::size_t>((n + grainSize - 1) / grainSize, 4 * GetPoolSize());
+   std::vector<std::size_t> bounds(nChunks + 1);
+   for (std::size_t c = 0; c <= nChunks; ++c)
+      bounds[c] = nChunks ? n / nChunks * c + n % nChunks * c / nChunks : 0;
+   return bounds;
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// \brief "Reduce" in parallel an std::vector<double> into a single double value
 ///
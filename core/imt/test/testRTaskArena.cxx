@@ -1,11 +1,14 @@
 #include "TROOT.h"
+#include "TSystem.h"
 #include "ROOT/RTaskArena.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 #include "../src/ROpaqueTaskArena.hxx"
 
 #include "ROOT/TestSupport.hxx"
 
+#include <algorithm>
 #include <fstream>
+#include <numeric>
 #include <random>
 #include <thread>
 #include <chrono>
@@ -84,6 +87,21 @@ TEST(RTaskArena, KeepSize)
    ASSERT_EQ(ROOT::Internal::RTaskArenaWrapper::TaskArenaSize(), nCores);
 }
 
+TEST(RTaskArena, NumaPinning)
+{
+   ASSERT_GE(ROOT::Internal::NumaNodesInAffinity(), 1u);
+   gSystem->Setenv("ROOT_IMT_PIN_THREADS", "1");
+   {
+      const unsigned nCores = plausibleNCores(randGenerator);
+      auto gTAInstance = ROOT::Internal::GetGlobalTaskArena(nCores);
+      ROOT::TThreadExecutor threadExecutor;
+      auto squares = threadExecutor.Map([](int x) { return x * x; }, ROOT::TSeqI(100));
+      EXPECT_EQ(squares[99], 99 * 99);
+   }
+   gSystem->Unsetenv("ROOT_IMT_PIN_THREADS");
+   EXPECT_EQ(ROOT::Internal::RTaskArenaWrapper::TaskArenaSize(), 0u);
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Integration Tests
 
@@ -298,4 +316,40 @@ TEST(TThreadExecutor, TSeqActions)
    EXPECT_EQ(redfunc(ttex.Map(func, ROOT::TSeqI(5, 2, -2))), 8);
 }
 
+TEST(TThreadExecutor, ParallelAlgorithms)
+{
+   ROOT::TThreadExecutor ttex;
+   std::mt19937 gen(42);
+   std::uniform_int_distribution<int> dist(0, 1000);
+   for (std::size_t grainSize : {0u, 1u, 7u, 100u}) {
+      std::vector<int> v(10000);
+      for (auto &x : v)
+         x = dist(gen);
+
+      auto sorted = v;
+      ttex.ParallelSort(sorted.begin(), sorted.end(), std::less<int>(), grainSize);
+      EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+      EXPECT_TRUE(std::is_permutation(sorted.begin(), sorted.end(), v.begin()));
+
+      std::vector<long> scan(v.size()), refScan(v.size());
+      std::partial_sum(v.begin(), v.end(), refScan.begin());
+      ttex.InclusiveScan(v.begin(), v.end(), scan.begin(), std::plus<long>(), grainSize);
+      EXPECT_TRUE(std::equal(scan.begin(), scan.end(), refScan.begin()));
+
+      auto partitioned = v, refPartitioned = v;
+      auto isEven = [](int x) { return x % 2 == 0; };
+      auto mid = ttex.Partition(partitioned.begin(), partitioned.end(), isEven, grainSize);
+      auto refMid = std::stable_partition(refPartitioned.begin(), refPartitioned.end(), isEven);
+      EXPECT_EQ(mid - partitioned.begin(), refMid - refPartitioned.begin());
+      EXPECT_EQ(partitioned, refPartitioned);
+
+      std::vector<int> visited(v.size(), 0);
+      ttex.ParallelFor(0u, v.size(), grainSize, [&](std::size_t begin, std::size_t end) {
+         for (auto i = begin; i < end; ++i)
+            visited[i]++;
+      });
+      EXPECT_EQ(std::count(visited.begin(), visited.end(), 1), static_cast<long>(v.size()));
+   }
+}
+
 #endif
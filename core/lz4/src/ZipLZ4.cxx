@@ -9,12 +9,14 @@
  *************************************************************************/
 
 #include "ZipLZ4.h"
+#include "RZipContext.h"
 
 #include "ROOT/RConfig.hxx"
 
 #include <cinttypes>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <lz4.h>
 #include <lz4hc.h>
@@ -30,6 +32,23 @@ static const int kChecksumOffset = 2 + 1 + 3 + 3;
 static const int kChecksumSize = sizeof(XXH64_canonical_t);
 static const int kHeaderSize = kChecksumOffset + kChecksumSize;
 
+namespace {
+void *CreateState(int)
+{
+   return std::malloc(LZ4_sizeofState());
+}
+
+void *CreateStateHC(int)
+{
+   return std::malloc(LZ4_sizeofStateHC());
+}
+
+void FreeState(void *state)
+{
+   std::free(state);
+}
+} // anonymous namespace
+
 void R__zipLZ4(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
 {
    int LZ4_version = LZ4_versionNumber();
@@ -51,10 +70,18 @@ void R__zipLZ4(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, in
    if (cxlevel > 9) {
       cxlevel = 9;
    }
+   // The compression states are reused by all calls of the thread, see RZipContext.h
    if (cxlevel >= 4) {
-      returnStatus = LZ4_compress_HC(src, &tgt[kHeaderSize], *srcsize, *tgtsize - kHeaderSize, cxlevel);
+      void *state = R__getZipContext(kZipContextLZ4HC, 0, CreateStateHC, FreeState);
+      if (R__unlikely(!state))
+         return;
+      returnStatus =
+         LZ4_compress_HC_extStateHC(state, src, &tgt[kHeaderSize], *srcsize, *tgtsize - kHeaderSize, cxlevel);
    } else {
-      returnStatus = LZ4_compress_default(src, &tgt[kHeaderSize], *srcsize, *tgtsize - kHeaderSize);
+      void *state = R__getZipContext(kZipContextLZ4, 0, CreateState, FreeState);
+      if (R__unlikely(!state))
+         return;
+      returnStatus = LZ4_compress_fast_extState(state, src, &tgt[kHeaderSize], *srcsize, *tgtsize - kHeaderSize, 1);
    }
 
    if (R__unlikely(returnStatus == 0)) { /* LZ4 compression failed */
@@ -13,17 +13,38 @@
 #define LZMA_API_STATIC
 #endif
 #include "ZipLZMA.h"
+#include "RZipContext.h"
 #include "lzma.h"
 #include <stdio.h>
+#include <stdlib.h>
 
 static const int kHeaderSize = 9;
 
+/* The streams are cached per thread, see RZipContext.h.  Initializing a coder on a stream
+   that was used before reuses its memory when possible.
+ */
+static void *R__createLZMAStream(int param)
+{
+   lzma_stream init = LZMA_STREAM_INIT;
+   lzma_stream *stream = (lzma_stream *)malloc(sizeof(lzma_stream));
+   (void)param;
+   if (stream)
+      *stream = init;
+   return stream;
+}
+
+static void R__freeLZMAStream(void *stream)
+{
+   lzma_end((lzma_stream *)stream);
+   free(stream);
+}
+
 void R__zipLZMA(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
 {
    uint64_t out_size;             /* compressed size */
    unsigned in_size   = (unsigned) (*srcsize);
    uint32_t dict_size_est = in_size/4;
-   lzma_stream stream = LZMA_STREAM_INIT;
+   lzma_stream *stream;
    lzma_options_lzma opt_lzma2;
    lzma_filter filters[] = {
       { .id = LZMA_FILTER_LZMA2, .options = &opt_lzma2 },
@@ -57,28 +78,31 @@ void R__zipLZMA(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
       opt_lzma2.dict_size = dict_size_est;
    }
 
-   returnStatus = lzma_stream_encoder(&stream,
+   stream = (lzma_stream *)R__getZipContext(kZipContextLZMAEncoder, 0, R__createLZMAStream, R__freeLZMAStream);
+   if (!stream) {
+      return;
+   }
+
+   returnStatus = lzma_stream_encoder(stream,
                                       filters,
                                       LZMA_CHECK_CRC32);
    if (returnStatus != LZMA_OK) {
       return;
    }
 
-   stream.next_in   = (const uint8_t *)src;
-   stream.avail_in  = (size_t)(*srcsize);
+   stream->next_in   = (const uint8_t *)src;
+   stream->avail_in  = (size_t)(*srcsize);
 
-   stream.next_out  = (uint8_t *)(&tgt[kHeaderSize]);
-   stream.avail_out = (size_t)(*tgtsize) - kHeaderSize;
+   stream->next_out  = (uint8_t *)(&tgt[kHeaderSize]);
+   stream->avail_out = (size_t)(*tgtsize) - kHeaderSize;
 
-   returnStatus = lzma_code(&stream, LZMA_FINISH);
+   returnStatus = lzma_code(stream, LZMA_FINISH);
    if (returnStatus != LZMA_STREAM_END) {
       /* No need to print an error message. We simply abandon the compression
          the buffer cannot be compressed or compressed buffer would be larger than original buffer
       */
-      lzma_end(&stream);
       return;
    }
-   lzma_end(&stream);
 
 
    tgt[0] = 'X';  /* Signature of LZMA from XZ Utils */
@@ -86,7 +110,7 @@ void R__zipLZMA(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
    tgt[2] = 0;
 
    in_size   = (unsigned) (*srcsize);
-   out_size  = stream.total_out;             /* compressed size */
+   out_size  = stream->total_out;            /* compressed size */
 
    tgt[3] = (char)(out_size & 0xff);
    tgt[4] = (char)((out_size >> 8) & 0xff);
@@ -96,17 +120,23 @@ void R__zipLZMA(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
    tgt[7] = (char)((in_size >> 8) & 0xff);
    tgt[8] = (char)((in_size >> 16) & 0xff);
 
-   *irep = (int)stream.total_out + kHeaderSize;
+   *irep = (int)stream->total_out + kHeaderSize;
 }
 
 void R__unzipLZMA(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
 {
-   lzma_stream stream = LZMA_STREAM_INIT;
+   lzma_stream *stream;
    lzma_ret returnStatus;
 
    *irep = 0;
 
-   returnStatus = lzma_stream_decoder(&stream,
+   stream = (lzma_stream *)R__getZipContext(kZipContextLZMADecoder, 0, R__createLZMAStream, R__freeLZMAStream);
+   if (!stream) {
+      fprintf(stderr, "R__unzipLZMA: cannot allocate the lzma stream\n");
+      return;
+   }
+
+   returnStatus = lzma_stream_decoder(stream,
                                       UINT64_MAX,
                                       0U);
    if (returnStatus != LZMA_OK) {
@@ -116,20 +146,18 @@ void R__unzipLZMA(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
       return;
    }
 
-   stream.next_in   = (const uint8_t *)(&src[kHeaderSize]);
-   stream.avail_in  = (size_t)(*srcsize) - kHeaderSize;
-   stream.next_out  = (uint8_t *)tgt;
-   stream.avail_out = (size_t)(*tgtsize);
+   stream->next_in   = (const uint8_t *)(&src[kHeaderSize]);
+   stream->avail_in  = (size_t)(*srcsize) - kHeaderSize;
+   stream->next_out  = (uint8_t *)tgt;
+   stream->avail_out = (size_t)(*tgtsize);
 
-   returnStatus = lzma_code(&stream, LZMA_FINISH);
+   returnStatus = lzma_code(stream, LZMA_FINISH);
    if (returnStatus != LZMA_STREAM_END) {
       fprintf(stderr,
               "R__unzipLZMA: error %d in lzma_code\n",
               returnStatus);
-      lzma_end(&stream);
       return;
    }
-   lzma_end(&stream);
 
-   *irep = (int)stream.total_out;
+   *irep = (int)stream->total_out;
 }
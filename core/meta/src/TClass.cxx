@@ -99,6 +99,8 @@ In order to access the name of a class within the ROOT type system, the method T
 #include <cassert>
 #include <vector>
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
 
 #include "TSpinLockGuard.h"
 
@@ -466,6 +468,65 @@ namespace ROOT {
    };
 }
 
+namespace {
+   // Generation counters of the lookup caches of TClass::GetClass. A TClass found by a lookup stays
+   // valid until a TClass is removed; a failed lookup stays valid until a TClass, a dictionary or an
+   // interpreter declaration is added.
+   std::atomic<ULong64_t> gClassRemovalGeneration{0};
+   std::atomic<ULong64_t> gClassAdditionGeneration{0};
+
+   struct ClassLookupResult {
+      TClass *fClass = nullptr;
+      ULong64_t fGeneration = 0; ///< Removal generation if fClass is set, addition generation otherwise
+      bool fLoadTried = false;   ///< For a failed lookup, whether loading the class was attempted
+   };
+
+   // The caches are per thread, so that a lookup hitting the cache takes no lock and writes
+   // to no shared memory.
+   template <typename Key>
+   using ClassLookupCache_t = std::unordered_map<Key, ClassLookupResult>;
+
+   /// Return true if `cache` has a valid result for `key`, and store it in `cl`.
+   template <typename Key>
+   bool FindInClassLookupCache(const ClassLookupCache_t<Key> &cache, const Key &key, Bool_t load, TClass *&cl)
+   {
+      auto it = cache.find(key);
+      if (it == cache.end())
+         return false;
+      const auto &result = it->second;
+      if (result.fClass) {
+         if (result.fGeneration != gClassRemovalGeneration.load(std::memory_order_acquire))
+            return false;
+      } else if (result.fGeneration != gClassAdditionGeneration.load(std::memory_order_acquire) ||
+                 (load && !result.fLoadTried)) {
+         return false;
+      }
+      cl = result.fClass;
+      return true;
+   }
+
+   /// Store the result `cl` of the lookup of `key`. The generations must have been read before
+   /// the lookup started, so that a concurrent change invalidates the result.
+   template <typename Key>
+   void StoreInClassLookupCache(ClassLookupCache_t<Key> &cache, const Key &key, Bool_t load, TClass *cl,
+                                ULong64_t removalGeneration, ULong64_t additionGeneration)
+   {
+      auto &result = cache[key];
+      result.fClass = cl;
+      result.fGeneration = cl ? removalGeneration : additionGeneration;
+      result.fLoadTried = load;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// static: Forget the failed lookups cached by TClass::GetClass. To be called
+/// when new dictionaries or interpreter declarations become available.
+
+void TClass::InvalidateFailedLookups()
+{
+   ++gClassAdditionGeneration;
+}
+
 IdMap_t *TClass::GetIdMap() {
 
 #ifdef R__COMPLETE_MEM_TERMINATION
@@ -496,6 +557,7 @@ void TClass::AddClass(TClass *cl)
    if (!cl) return;
 
    R__LOCKGUARD(gInterpreterMutex);
+   InvalidateFailedLookups();
    gROOT->GetListOfClasses()->Add(cl);
    if (cl->GetTypeInfo()) {
       GetIdMap()->Add(cl->GetTypeInfo()->name(),cl);
@@ -522,6 +584,7 @@ void TClass::RemoveClass(TClass *oldcl)
    if (!oldcl) return;
 
    R__LOCKGUARD(gInterpreterMutex);
+   ++gClassRemovalGeneration;
    gROOT->GetListOfClasses()->Remove(oldcl);
    if (oldcl->GetTypeInfo()) {
       GetIdMap()->Remove(oldcl->GetTypeInfo()->name());
@@ -2981,6 +3044,34 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
 
    if (!gROOT->GetListOfClasses())  return nullptr;
 
+   // Repeated lookups, including the failed ones, are answered by the cache
+   // of the thread without taking any lock.
+   TTHREAD_TLS_DECL(ClassLookupCache_t<std::string>, cache);
+   TTHREAD_TLS_DECL(std::string, key);
+   key.assign(name);
+   TClass *cl = nullptr;
+   if (FindInClassLookupCache(cache, key, load, cl))
+      return cl;
+
+   const auto removalGeneration = gClassRemovalGeneration.load(std::memory_order_acquire);
+   const auto additionGeneration = gClassAdditionGeneration.load(std::memory_order_acquire);
+   cl = GetClassUncached(name, load, silent, hint_pair_offset, hint_pair_size);
+   // Only the classes with a compiled dictionary are final, the other ones can be replaced when
+   // a dictionary or the interpreter provides more information. The hints can create the TClass
+   // of a pair, so a failed lookup with hints does not apply to the lookups without them.
+   if (cl ? (cl->IsLoaded() && !cl->TestBit(kUnloading)) : !hint_pair_offset) {
+      // GetClassUncached might have looked up other names
+      key.assign(name);
+      StoreInClassLookupCache(cache, key, load, cl, removalGeneration, additionGeneration);
+   }
+   return cl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of GetClass(const char*), without the lookup cache.
+
+TClass *TClass::GetClassUncached(const char *name, Bool_t load, Bool_t silent, size_t hint_pair_offset, size_t hint_pair_size)
+{
    // FindObject will take the read lock before actually getting the
    // TClass pointer so we will need not get a partially initialized
    // object.
@@ -3251,11 +3342,33 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to class with name.
 
-TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /* silent */, size_t hint_pair_offset, size_t hint_pair_size)
+TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t silent, size_t hint_pair_offset, size_t hint_pair_size)
 {
    if (!gROOT->GetListOfClasses())
       return nullptr;
 
+   // Repeated lookups, including the failed ones, are answered by the cache
+   // of the thread without taking any lock.
+   TTHREAD_TLS_DECL(ClassLookupCache_t<std::type_index>, cache);
+   const std::type_index key(typeinfo);
+   TClass *cl = nullptr;
+   if (FindInClassLookupCache(cache, key, load, cl))
+      return cl;
+
+   const auto removalGeneration = gClassRemovalGeneration.load(std::memory_order_acquire);
+   const auto additionGeneration = gClassAdditionGeneration.load(std::memory_order_acquire);
+   cl = GetClassUncached(typeinfo, load, silent, hint_pair_offset, hint_pair_size);
+   // Only the classes with a compiled dictionary are final, see GetClass(const char*)
+   if (cl ? (cl->IsLoaded() && !cl->TestBit(kUnloading)) : !hint_pair_offset)
+      StoreInClassLookupCache(cache, key, load, cl, removalGeneration, additionGeneration);
+   return cl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of GetClass(const std::type_info&), without the lookup cache.
+
+TClass *TClass::GetClassUncached(const std::type_info& typeinfo, Bool_t load, Bool_t /* silent */, size_t hint_pair_offset, size_t hint_pair_size)
+{
    //protect access to TROOT::GetIdMap
    R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -6313,6 +6426,8 @@ void TClass::SetUnloaded()
       return;
    }
    SetBit(kUnloading);
+   // The cached lookups must not return this class as loaded anymore
+   ++gClassRemovalGeneration;
 
    //R__ASSERT(fState == kLoaded);
    if (fState != kLoaded) {
@@ -1,6 +1,7 @@
 #include "TClass.h"
 #include "THashTable.h"
 #include "TInterpreter.h"
+#include "TNamed.h"
 
 #include "gtest/gtest.h"
 
@@ -22,3 +23,21 @@ TEST(TClass, DictCheck)
 
    EXPECT_STREQ(errMsg.c_str(), "Missing dictionary for C, ") << errMsg;
 }
+
+TEST(TClass, LookupCache)
+{
+   // Repeated lookups are answered by the cache
+   auto c = TClass::GetClass("TNamed");
+   ASSERT_NE(c, nullptr);
+   EXPECT_EQ(TClass::GetClass("TNamed"), c);
+   EXPECT_EQ(TClass::GetClass(typeid(TNamed)), c);
+   EXPECT_EQ(TClass::GetClass(typeid(TNamed)), c);
+
+   // A failed lookup is forgotten once the class is declared
+   EXPECT_EQ(TClass::GetClass("LookupCacheDeclaredLater"), nullptr);
+   EXPECT_EQ(TClass::GetClass("LookupCacheDeclaredLater"), nullptr);
+   gInterpreter->Declare("struct LookupCacheDeclaredLater { int fX = 0; };");
+   auto declared = TClass::GetClass("LookupCacheDeclaredLater");
+   ASSERT_NE(declared, nullptr);
+   EXPECT_STREQ(declared->GetName(), "LookupCacheDeclaredLater");
+}
@@ -5745,6 +5745,9 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
 
    R__LOCKGUARD(gInterpreterMutex);
 
+   // The new autoload keys can make loadable classes for which a lookup failed before
+   TClass::InvalidateFailedLookups();
+
    // open the [system].rootmap files
    if (!fMapfile) {
       fMapfile = new TEnv();
@@ -6768,6 +6771,9 @@ void TCling::UpdateListsOnCommitted(const cling::Transaction &T) {
    // If the transaction does not contain anything we can return earlier.
    if (!HandleNewTransaction(T)) return;
 
+   // The new declarations can make known classes for which a lookup failed before
+   TClass::InvalidateFailedLookups();
+
    bool isTUTransaction = false;
    if (!T.empty() && T.decls_begin() + 1 == T.decls_end() && !T.hasNestedTransactions()) {
       clang::Decl* FirstDecl = *(T.decls_begin()->m_DGR.begin());
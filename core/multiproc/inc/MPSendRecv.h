@@ -53,6 +53,13 @@ int MPSend(TSocket *s, unsigned code, T obj);
 
 MPCodeBufPair MPRecv(TSocket *s);
 
+// Message header: the code and the size of the object, written as UInt_t and ULong_t (8 bytes)
+constexpr int kMPHeaderSize = sizeof(UInt_t) + 8;
+
+// These are used by MPSend() to stream the object directly after the header, without intermediate copies
+void MPWriteHeader(TBufferFile &wBuf, unsigned code);
+int MPSendBuffer(TSocket *s, TBufferFile &wBuf);
+
 
 //this version reads classes from the message
 template<class T, typename std::enable_if<std::is_class<T>::value>::type * = nullptr>
@@ -96,13 +103,10 @@ int MPSend(TSocket *s, unsigned code, T obj)
       Error("MPSend", "[E] Could not find cling definition for class %s\n", typeid(T).name());
       return -1;
    }
-   TBufferFile objBuf(TBuffer::kWrite);
-   objBuf.WriteObjectAny(&obj, c);
    TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   MPWriteHeader(wBuf, code);
+   wBuf.WriteObjectAny(&obj, c);
+   return MPSendBuffer(s, wBuf);
 }
 
 /// \cond
@@ -133,18 +137,12 @@ int MPSend(TSocket *s, unsigned code, T obj)
 template < class T, typename std::enable_if < std::is_pointer<T>::value && std::is_constructible<TObject *, T>::value >::type * >
 int MPSend(TSocket *s, unsigned code, T obj)
 {
-   //find out the size of the object
-   TBufferFile objBuf(TBuffer::kWrite);
-   if(obj != nullptr)
-      objBuf.WriteObjectAny(obj, obj->IsA());
-
-   //write everything together in a buffer
+   //stream the object directly after the header, its size is filled in afterwards
    TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   if(objBuf.Length())
-      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   MPWriteHeader(wBuf, code);
+   if(obj != nullptr)
+      wBuf.WriteObjectAny(obj, obj->IsA());
+   return MPSendBuffer(s, wBuf);
 }
 
 /// \endcond
@@ -12,7 +12,16 @@
 #include "MPSendRecv.h"
 #include "TBufferFile.h"
 #include "MPCode.h"
+#include "MPSharedRing.h"
 #include <memory> //unique_ptr
+#include <cstring> //memcpy
+
+namespace {
+// the object is in the shared memory ring of the socket if this bit of the object size is set
+constexpr ULong64_t kMPSharedBit = 1ULL << 63;
+// smaller objects are always sent through the socket
+constexpr ULong64_t kMPSharedMinSize = 4096;
+} // namespace
 
 //////////////////////////////////////////////////////////////////////////
 /// Send a message with the specified code on the specified socket.
@@ -32,9 +41,49 @@
 int MPSend(TSocket *s, unsigned code)
 {
    TBufferFile wBuf(TBuffer::kWrite);
+   MPWriteHeader(wBuf, code);
+   return MPSendBuffer(s, wBuf);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Write the header of a message with the specified code to an empty buffer.
+/// The object, if any, must be streamed to the same buffer afterwards and
+/// the message sent with MPSendBuffer(), which fills in the object size.
+/// \param wBuf an empty TBufferFile in write mode
+/// \param code the code to be sent
+void MPWriteHeader(TBufferFile &wBuf, unsigned code)
+{
    wBuf.WriteUInt(code);
-   wBuf.WriteULong(0);
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   wBuf.WriteULong(0); // object size, see MPSendBuffer()
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Complete the header of a message prepared with MPWriteHeader() and send it.
+/// The object is sent at offset ::kMPHeaderSize, MPRecv() reads it at the same
+/// offset so that the object references stored in the buffer stay valid.\n
+/// If the socket connects the client with a worker and the object is large, the
+/// object is copied to the shared memory ring of the socket and only the header
+/// and the position in the ring are sent through the socket.
+/// \param s a pointer to a valid TSocket. No validity checks are performed\n
+/// \param wBuf the buffer holding header and object
+/// \return the number of bytes sent, as per TSocket::SendRaw
+int MPSendBuffer(TSocket *s, TBufferFile &wBuf)
+{
+   Int_t len = wBuf.Length();
+   ULong64_t objSize = len - kMPHeaderSize;
+   ULong64_t pos = 0;
+   MPSharedRing *ring = objSize >= kMPSharedMinSize ? MPGetSharedRing(s->GetDescriptor()) : nullptr;
+   if (ring && ring->Write(wBuf.Buffer() + kMPHeaderSize, objSize, pos)) {
+      //the object was copied: overwrite its start with the position in the ring
+      wBuf.SetBufferOffset(sizeof(UInt_t));
+      wBuf.WriteULong64(objSize | kMPSharedBit);
+      wBuf.WriteULong64(pos);
+      return s->SendRaw(wBuf.Buffer(), kMPHeaderSize + 8);
+   }
+   wBuf.SetBufferOffset(sizeof(UInt_t));
+   wBuf.WriteULong(objSize);
+   wBuf.SetBufferOffset(len);
+   return s->SendRaw(wBuf.Buffer(), len);
 }
 
 
@@ -53,33 +102,46 @@ int MPSend(TSocket *s, unsigned code)
 /// \return ::MPCodeBufPair, i.e. an std::pair containing message code and (possibly) object
 MPCodeBufPair MPRecv(TSocket *s)
 {
-   char *rawbuf = new char[sizeof(UInt_t)];
-   //receive message code
-   unsigned nBytes = s->RecvRaw(rawbuf, sizeof(UInt_t));
+   //receive message code and object size at once
+   //ULong_t is sent as 8 bytes irrespective of the size of the type
+   char header[kMPHeaderSize];
+   unsigned nBytes = s->RecvRaw(header, kMPHeaderSize);
    if (nBytes == 0) {
       return std::make_pair(MPCode::kRecvError, nullptr);
    }
-   //read message code
-   TBufferFile bufReader(TBuffer::kRead, sizeof(UInt_t), rawbuf, false);
+   TBufferFile bufReader(TBuffer::kRead, kMPHeaderSize, header, false);
    unsigned code;
    bufReader.ReadUInt(code);
-   delete [] rawbuf;
+   ULong64_t classBufSize;
+   bufReader.ReadULong64(classBufSize);
 
-   //receive object size
-   //ULong_t is sent as 8 bytes irrespective of the size of the type
-   rawbuf = new char[8];
-   s->RecvRaw(rawbuf, 8);
-   bufReader.SetBuffer(rawbuf, 8, false);
-   ULong_t classBufSize;
-   bufReader.ReadULong(classBufSize);
-   delete [] rawbuf;
+   //the object may have been passed through the shared memory ring of the socket
+   //its position in the ring follows the header
+   bool inRing = classBufSize & kMPSharedBit;
+   ULong64_t ringPos = 0;
+   if (inRing) {
+      classBufSize &= ~kMPSharedBit;
+      char posBuf[8];
+      s->RecvRaw(posBuf, 8);
+      bufReader.SetBuffer(posBuf, 8, false);
+      bufReader.ReadULong64(ringPos);
+   }
 
    //receive object if needed
+   //the object is placed after the header, at the same offset as in the sent buffer
    std::unique_ptr<TBufferFile> objBuf; //defaults to nullptr
    if (classBufSize != 0) {
-      char *classBuf = new char[classBufSize];
-      s->RecvRaw(classBuf, classBufSize);
-      objBuf.reset(new TBufferFile(TBuffer::kRead, classBufSize, classBuf, true)); //the buffer is deleted by TBuffer's dtor
+      char *classBuf = new char[kMPHeaderSize + classBufSize];
+      memcpy(classBuf, header, kMPHeaderSize);
+      MPSharedRing *ring = inRing ? MPGetSharedRing(s->GetDescriptor()) : nullptr;
+      if (ring)
+         ring->Read(classBuf + kMPHeaderSize, classBufSize, ringPos);
+      else if (inRing)
+         Error("MPRecv", "[E] Received an object in shared memory, but the socket has no shared memory\n");
+      else
+         s->RecvRaw(classBuf + kMPHeaderSize, classBufSize);
+      objBuf.reset(new TBufferFile(TBuffer::kRead, kMPHeaderSize + classBufSize, classBuf, true)); //the buffer is deleted by TBuffer's dtor
+      objBuf->SetBufferOffset(kMPHeaderSize);
    }
 
    return std::make_pair(code, std::move(objBuf));
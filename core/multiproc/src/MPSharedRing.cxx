@@ -0,0 +1,118 @@
+/* @(#)root/multiproc:$Id$ */
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "MPSharedRing.h"
+#include "TError.h"
+#include <cstring> //memcpy
+#include <map>
+#include <new> //placement new
+#include <sys/mman.h> //mmap
+
+namespace {
+std::map<int, std::shared_ptr<MPSharedRing>> &GetRings()
+{
+   static std::map<int, std::shared_ptr<MPSharedRing>> rings;
+   return rings;
+}
+
+// keep the data area on its own cache lines
+constexpr ULong64_t kControlSize = 128;
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+/// Map a ring with a data area of the given size.
+/// \return nullptr if the shared memory could not be mapped
+std::shared_ptr<MPSharedRing> MPSharedRing::Create(ULong64_t size)
+{
+   if (size == 0)
+      return nullptr;
+   void *mem = mmap(nullptr, kControlSize + size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   if (mem == MAP_FAILED) {
+      Error("MPSharedRing::Create", "[W] Could not map %llu bytes of shared memory, using sockets only\n",
+            kControlSize + size);
+      return nullptr;
+   }
+   std::shared_ptr<MPSharedRing> ring(new MPSharedRing);
+   ring->fControl = new (mem) Control;
+   ring->fData = static_cast<char *>(mem) + kControlSize;
+   ring->fSize = size;
+   ring->fMapSize = kControlSize + size;
+   return ring;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Unmap the ring, the mapping of the other process is not affected.
+MPSharedRing::~MPSharedRing()
+{
+   if (fControl)
+      munmap(fControl, fMapSize);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Called by the writer: copy len bytes to a contiguous region of the ring.
+/// \param pos set to the position, which must be passed to Read()
+/// \return false if there is not enough free space, the data must then be sent otherwise
+bool MPSharedRing::Write(const char *buf, ULong64_t len, ULong64_t &pos)
+{
+   if (len > fSize)
+      return false;
+   pos = fControl->fHead.load(std::memory_order_relaxed);
+   ULong64_t offset = pos % fSize;
+   if (offset + len > fSize)
+      pos += fSize - offset; // does not fit before the end, start again at the beginning
+   if (pos + len - fControl->fTail.load(std::memory_order_acquire) > fSize)
+      return false;
+   memcpy(fData + pos % fSize, buf, len);
+   fControl->fHead.store(pos + len, std::memory_order_release);
+   return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Called by the reader: copy len bytes written at pos and release the space,
+/// as well as the space of all data written before.
+void MPSharedRing::Read(char *buf, ULong64_t len, ULong64_t pos)
+{
+   memcpy(buf, fData + pos % fSize, len);
+   fControl->fTail.store(pos + len, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Use the ring for the messages sent and received on the socket descriptor fd.
+/// Passing nullptr removes the ring of the descriptor.
+void MPSetSharedRing(int fd, std::shared_ptr<MPSharedRing> ring)
+{
+   if (ring)
+      GetRings()[fd] = std::move(ring);
+   else
+      GetRings().erase(fd);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Return the ring used for the socket descriptor fd, nullptr if there is none.
+MPSharedRing *MPGetSharedRing(int fd)
+{
+   auto &rings = GetRings();
+   auto iter = rings.find(fd);
+   return iter != rings.end() ? iter->second.get() : nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Called by a worker after forking: remove all rings inherited from the
+/// client, except the one of its own socket descriptor.
+void MPKeepSharedRing(int fd)
+{
+   auto &rings = GetRings();
+   for (auto iter = rings.begin(); iter != rings.end();) {
+      if (iter->first != fd)
+         iter = rings.erase(iter);
+      else
+         ++iter;
+   }
+}
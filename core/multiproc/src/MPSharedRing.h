@@ -0,0 +1,54 @@
+/* @(#)root/multiproc:$Id$ */
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_MPSharedRing
+#define ROOT_MPSharedRing
+
+#include "RtypesCore.h"
+
+#include <atomic>
+#include <memory>
+
+//////////////////////////////////////////////////////////////////////////
+/// Ring buffer in anonymous shared memory, used to pass the objects sent
+/// by MPSend() between the client and a worker without going through the socket.
+/// It is created by the client before forking, so that both processes map it.
+/// There is one writer and one reader: the socket message announcing an object
+/// in the ring is received in the order the objects were written, and the reader
+/// releases the space after copying the object out.
+class MPSharedRing {
+   struct Control {
+      std::atomic<ULong64_t> fHead{0}; ///< end of the written data, modified by the writer
+      std::atomic<ULong64_t> fTail{0}; ///< end of the released data, modified by the reader
+   };
+
+   Control *fControl = nullptr; ///< control block at the start of the mapping
+   char *fData = nullptr;       ///< data area after the control block
+   ULong64_t fSize = 0;         ///< size of the data area
+   ULong64_t fMapSize = 0;      ///< size of the mapping
+
+   MPSharedRing() = default;
+
+public:
+   static std::shared_ptr<MPSharedRing> Create(ULong64_t size);
+   ~MPSharedRing();
+   MPSharedRing(const MPSharedRing &) = delete;
+   MPSharedRing &operator=(const MPSharedRing &) = delete;
+
+   bool Write(const char *buf, ULong64_t len, ULong64_t &pos);
+   void Read(char *buf, ULong64_t len, ULong64_t pos);
+};
+
+// Registry of the rings by socket descriptor, used by MPSend() and MPRecv()
+void MPSetSharedRing(int fd, std::shared_ptr<MPSharedRing> ring);
+MPSharedRing *MPGetSharedRing(int fd);
+void MPKeepSharedRing(int fd);
+
+#endif
@@ -10,6 +10,8 @@
  *************************************************************************/
 
 #include "MPCode.h"
+#include "MPSharedRing.h"
+#include "TEnv.h" //gEnv
 #include "TGuiFactory.h" //gGuiFactory
 #include "TError.h" //gErrorIgnoreLevel
 #include "TMPClient.h"
@@ -36,6 +38,12 @@
 /// functionalities to users should inherit (possibly privately) from
 /// TMPClient, and the workers executing tasks should inherit from TMPWorker.
 ///
+/// Besides the socket, each worker shares a ring buffer in anonymous shared
+/// memory with the client. Large objects sent with MPSend() between the two
+/// are passed through it instead of the socket. Its size in MB is set with
+/// the `MultiProc.SharedMemorySize` resource (default 64, 0 disables it);
+/// memory is only used when the ring is actually written.
+///
 //////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////
@@ -71,9 +79,13 @@ TMPClient::~TMPClient()
 {
    Broadcast(MPCode::kShutdownOrder);
    TList *l = fMon.GetListOfActives();
+   for (auto s : *l)
+      MPSetSharedRing(((TSocket *)s)->GetDescriptor(), nullptr);
    l->Delete();
    delete l;
    l = fMon.GetListOfDeActives();
+   for (auto s : *l)
+      MPSetSharedRing(((TSocket *)s)->GetDescriptor(), nullptr);
    l->Delete();
    delete l;
    fMon.RemoveAll();
@@ -133,6 +145,9 @@ bool TMPClient::Fork(TMPWorker &server)
    pid_t pid = 1; //must be positive to handle the case in which fNWorkers is 0
    int sockets[2]; //sockets file descriptors
    unsigned nWorker = 0;
+   Int_t ringSizeMB = gEnv->GetValue("MultiProc.SharedMemorySize", 64);
+   ULong64_t ringSize = ringSizeMB > 0 ? ringSizeMB * 1024ULL * 1024ULL : 0;
+   std::shared_ptr<MPSharedRing> ring; //shared memory of the current worker and the client
    for (; nWorker < fNWorkers; ++nWorker) {
       //create socket pair
       int ret = socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
@@ -141,6 +156,7 @@ bool TMPClient::Fork(TMPWorker &server)
          --nWorker;
          continue;
       }
+      ring = MPSharedRing::Create(ringSize);
 
       //fork
       {
@@ -156,6 +172,7 @@ bool TMPClient::Fork(TMPWorker &server)
          close(sockets[1]); //we don't need this
          TSocket *s = new TSocket(sockets[0], (std::to_string(pid)).c_str()); //TSocket's constructor with this signature seems much faster than TSocket(int fd)
          if (s && s->IsValid()) {
+            MPSetSharedRing(sockets[0], ring);
             fMon.Add(s);
             fWorkerPids.push_back(pid);
          } else {
@@ -172,6 +189,9 @@ bool TMPClient::Fork(TMPWorker &server)
       //CHILD/WORKER
       fIsParent = false;
       close(sockets[0]); //we don't need this
+      //forget the shared memory of the other workers
+      MPSetSharedRing(sockets[1], ring);
+      MPKeepSharedRing(sockets[1]);
 
       //override signal handler (make the servers exit on SIGINT)
       TSeqCollection *signalHandlers = gSystem->GetListOfSignalHandlers();
@@ -299,6 +319,7 @@ void TMPClient::DeActivate(TSocket *s)
 /// \param s the socket to be removed from the monitor fMon
 void TMPClient::Remove(TSocket *s)
 {
+   MPSetSharedRing(s->GetDescriptor(), nullptr);
    fMon.Remove(s);
    delete s;
 }
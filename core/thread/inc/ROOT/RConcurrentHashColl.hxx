@@ -16,9 +16,6 @@
 #include "Rtypes.h"
 
 namespace ROOT {
-
-class TRWSpinLock;
-
 namespace Internal {
 
 struct RHashMap;
@@ -27,10 +24,14 @@ using RUidColl = std::vector<Int_t>;
 /// This class is a thread-safe associative collection connecting
 /// a 256 bits digest/hash to a collection of uid (integer)
 /// This is used in the handling of the StreamerInfo record in TFile.
+///
+/// The hashes are split in shards, each with its own lock taken only by
+/// Insert(): Find() does not lock, so that concurrent lookups never wait.
+/// Elements are never removed, and the collections of uid returned by Find()
+/// stay valid as long as the RConcurrentHashColl.
 class RConcurrentHashColl {
 private:
    mutable std::unique_ptr<RHashMap> fHashMap;
-   mutable std::unique_ptr<ROOT::TRWSpinLock> fRWLock;
 
 public:
    class HashValue {
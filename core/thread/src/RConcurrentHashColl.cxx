@@ -1,22 +1,13 @@
 #include <ROOT/RConcurrentHashColl.hxx>
-#include <ROOT/TRWSpinLock.hxx>
-#include <ROOT/TSeq.hxx>
-#include <ROOT/RSha256.hxx>
 
+#include <atomic>
+#include <deque>
 #include <memory>
-#include <set>
-#include <unordered_map>
+#include <mutex>
+
+// Must come after the standard headers: it defines short macros such as `h`
+#include <ROOT/RSha256.hxx>
 
-namespace std
-{
-template <> struct hash<ROOT::Internal::RConcurrentHashColl::HashValue>
-{
-   std::size_t operator()(const ROOT::Internal::RConcurrentHashColl::HashValue& key) const noexcept
-   {
-      return key.Hash();
-   }
-};
-}
 namespace ROOT {
 namespace Internal {
 
@@ -34,23 +25,85 @@ RConcurrentHashColl::HashValue::HashValue(const char *data, int len)
    Sha256(reinterpret_cast<const unsigned char *>(data), len, fDigest);
 }
 
+namespace {
+
+struct REntry {
+   RConcurrentHashColl::HashValue fHash;
+   RUidColl fUids;
+};
+
+/// Node of the chain of a bucket. Never modified once reachable by the readers.
+struct RLink {
+   const REntry *fEntry;
+   const RLink *fNext;
+};
+
+/// Hash table of the entries of a shard. When it is full, a table twice as large replaces
+/// it, but it is only deleted with the collection since readers may still be traversing it.
+struct RTable {
+   std::size_t fMask;
+   std::unique_ptr<std::atomic<const RLink *>[]> fBuckets;
+   std::deque<RLink> fLinks;
+
+   explicit RTable(std::size_t nBuckets) : fMask(nBuckets - 1), fBuckets(new std::atomic<const RLink *>[nBuckets])
+   {
+      for (std::size_t i = 0; i < nBuckets; ++i)
+         fBuckets[i].store(nullptr, std::memory_order_relaxed);
+   }
+
+   /// The bits of the digest used for the buckets are not the ones used for the shards
+   std::atomic<const RLink *> &Bucket(const RConcurrentHashColl::HashValue &hash)
+   {
+      return fBuckets[hash.Get()[1] & fMask];
+   }
+
+   const REntry *Find(const RConcurrentHashColl::HashValue &hash)
+   {
+      for (auto link = Bucket(hash).load(std::memory_order_acquire); link; link = link->fNext) {
+         if (link->fEntry->fHash == hash)
+            return link->fEntry;
+      }
+      return nullptr;
+   }
+
+   /// Only called with the lock of the shard
+   void Add(const REntry &entry)
+   {
+      auto &bucket = Bucket(entry.fHash);
+      fLinks.push_back({&entry, bucket.load(std::memory_order_relaxed)});
+      bucket.store(&fLinks.back(), std::memory_order_release);
+   }
+};
+
+struct alignas(64) RShard {
+   std::atomic<RTable *> fTable{nullptr};
+   std::mutex fMutex;                          ///< Taken by the writers only
+   std::deque<REntry> fEntries;                ///< Stable addresses, returned by Find()
+   std::vector<std::unique_ptr<RTable>> fTables; ///< The current table is the last one
+};
+
+constexpr std::size_t kNShards = 32;
+constexpr std::size_t kMinBuckets = 16;
+
+} // anonymous namespace
+
 struct RHashMap {
-   std::unordered_map<ROOT::Internal::RConcurrentHashColl::HashValue, RUidColl> fHashMap;
+   RShard fShards[kNShards];
+
+   RShard &GetShard(const RConcurrentHashColl::HashValue &hash) { return fShards[hash.Get()[0] % kNShards]; }
 };
 
-RConcurrentHashColl::RConcurrentHashColl()
-   : fHashMap(std::make_unique<RHashMap>()), fRWLock(std::make_unique<ROOT::TRWSpinLock>()){};
+RConcurrentHashColl::RConcurrentHashColl() : fHashMap(std::make_unique<RHashMap>()) {}
 
 RConcurrentHashColl::~RConcurrentHashColl() = default;
 
 const RUidColl* RConcurrentHashColl::Find(const HashValue &hash) const
 {
-   ROOT::TRWSpinLockReadGuard rg(*fRWLock);
-   auto iter = fHashMap->fHashMap.find(hash);
-   if (iter != fHashMap->fHashMap.end())
-      return &(iter->second);
-   else
+   auto table = fHashMap->GetShard(hash).fTable.load(std::memory_order_acquire);
+   if (!table)
       return nullptr;
+   auto entry = table->Find(hash);
+   return entry ? &entry->fUids : nullptr;
 }
 
 RConcurrentHashColl::HashValue RConcurrentHashColl::Hash(char *buffer, int len)
@@ -60,9 +113,28 @@ RConcurrentHashColl::HashValue RConcurrentHashColl::Hash(char *buffer, int len)
 
 bool RConcurrentHashColl::Insert(const HashValue &hash, RUidColl &&values) const
 {
-   ROOT::TRWSpinLockWriteGuard wg(*fRWLock);
-   auto ret = fHashMap->fHashMap.insert({hash, std::move(values)});
-   return ret.second;
+   auto &shard = fHashMap->GetShard(hash);
+   std::lock_guard<std::mutex> lock(shard.fMutex);
+   auto table = shard.fTable.load(std::memory_order_relaxed);
+   if (table && table->Find(hash))
+      return false;
+
+   shard.fEntries.push_back({hash, std::move(values)});
+   if (table && shard.fEntries.size() <= 2 * (table->fMask + 1)) {
+      table->Add(shard.fEntries.back());
+      return true;
+   }
+
+   // (re)build a larger table with all the entries, then publish it
+   std::size_t nBuckets = kMinBuckets;
+   while (nBuckets < shard.fEntries.size())
+      nBuckets *= 2;
+   auto newTable = std::make_unique<RTable>(nBuckets);
+   for (const auto &entry : shard.fEntries)
+      newTable->Add(entry);
+   shard.fTable.store(newTable.get(), std::memory_order_release);
+   shard.fTables.emplace_back(std::move(newTable));
+   return true;
 }
 
 } // End NS Internal
@@ -24,7 +24,13 @@ In other word, the lock is re-entrant for both reading and writing.
 
 The implementation tries to make faster the scenario when readers come
 and go but there is no writer. In that case, readers will not pay the
-price of taking the internal spin lock.
+price of taking the internal spin lock. The readers are counted in
+several counters, each in its own cache line, and a thread only updates
+the counter selected by the hash of its id: concurrent readers on
+different threads do not write to a shared cache line. A writer announces
+itself by setting fWriter and then waits for the sum of the counters to
+drop to zero; a reader increments its counter before checking fWriter, so
+that either the writer sees the reader or the reader sees the writer.
 
 Moreover, this RW lock tries to be fair with writers, giving them the
 possibility to claim the lock and wait for only the remaining readers,
@@ -36,6 +42,8 @@ thus preventing starvation.
 #include "TMutex.h"
 #include "TError.h"
 #include <assert.h>
+#include <cstdint>
+#include <functional>
 
 using namespace ROOT;
 
@@ -65,49 +73,72 @@ Internal::UniqueLockRecurseCount::UniqueLockRecurseCount()
 
 
 ////////////////////////////////////////////////////////////////////////////
-/// Acquire the lock in read mode.
+/// The reader counter of the current thread.
+///
+/// The slot is chosen by a multiplicative hash of the thread id, which does
+/// not need any thread-local storage. Threads sharing a slot only share the
+/// cache line, the lock stays correct since only the sum of the counters
+/// matters.
 template <typename MutexT, typename RecurseCountsT>
-TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::ReadLock()
+std::atomic<int> &TReentrantRWLock<MutexT, RecurseCountsT>::GetLocalReaders() const
 {
-   ++fReaderReservation;
+   const std::uint64_t hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+   const auto slot = (hash * 0x9E3779B97F4A7C15ull) >> (64 - kReaderSlotBits);
+   return fReaderSlots[slot].fReaders;
+}
 
-   // if (fReaders == std::numeric_limits<decltype(fReaders)>::max()) {
-   //    ::Fatal("TRWSpinLock::WriteLock", "Too many recursions in TRWSpinLock!");
-   // }
+////////////////////////////////////////////////////////////////////////////
+/// The total number of readers.
+template <typename MutexT, typename RecurseCountsT>
+int TReentrantRWLock<MutexT, RecurseCountsT>::GetReaders() const
+{
+   int readers = 0;
+   for (unsigned slot = 0; slot < kNReaderSlots; ++slot)
+      readers += fReaderSlots[slot].fReaders;
+   return readers;
+}
 
+////////////////////////////////////////////////////////////////////////////
+/// Acquire the lock in read mode.
+template <typename MutexT, typename RecurseCountsT>
+TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::ReadLock()
+{
    auto local = fRecurseCounts.GetLocal();
+   auto &localReaders = GetLocalReaders();
 
    TVirtualRWMutex::Hint_t *hint = nullptr;
 
+   // Announce the reader before looking for a writer, a writer setting
+   // fWriter concurrently will see it and wait for it.
+   ++localReaders;
+
    if (!fWriter) {
       // There is no writer, go freely to the critical section
-      ++fReaders;
-      --fReaderReservation;
-
       hint = fRecurseCounts.IncrementReadCount(local, fMutex);
 
    } else if (fRecurseCounts.IsCurrentWriter(local)) {
 
-      --fReaderReservation;
       // This can run concurrently with another thread trying to get
       // the read lock and ending up in the next section ("Wait for writers, if any")
       // which need to also get the local readers count and thus can
       // modify the map.
       hint = fRecurseCounts.IncrementReadCount(local, fMutex);
-      ++fReaders;
 
    } else {
       // A writer claimed the RW lock, we will need to wait on the
       // internal lock
-      --fReaderReservation;
-
       std::unique_lock<MutexT> lock(fMutex);
 
       // Wait for writers, if any
       if (fWriter && fRecurseCounts.IsNotCurrentWriter(local)) {
          auto readerCount = fRecurseCounts.GetLocalReadersCount(local);
-         if (readerCount == 0)
+         if (readerCount == 0) {
+            // Withdraw the announcement, the writer might be waiting for it
+            --localReaders;
+            fCond.notify_all();
             fCond.wait(lock, [this] { return !fWriter; });
+            ++localReaders;
+         }
          // else
          //   There is a writer **but** we have outstanding readers
          //   locks, this must mean that the writer is actually
@@ -120,10 +151,8 @@ TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::ReadLock()
          //   of the two.
       }
 
-      hint = fRecurseCounts.IncrementReadCount(local);
-
       // This RW lock now belongs to the readers
-      ++fReaders;
+      hint = fRecurseCounts.IncrementReadCount(local);
 
       lock.unlock();
    }
@@ -146,8 +175,8 @@ void TReentrantRWLock<MutexT, RecurseCountsT>::ReadUnLock(TVirtualRWMutex::Hint_
       localReaderCount = reinterpret_cast<size_t*>(hint);
    }
 
-   --fReaders;
-   if (fWriterReservation && fReaders == 0) {
+   --GetLocalReaders();
+   if (fWriterReservation && GetReaders() == 0) {
       // We still need to lock here to prevent interleaving with a writer
       std::lock_guard<MutexT> lock(fMutex);
 
@@ -177,12 +206,13 @@ TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::WriteLock()
    // Release this thread's reader lock(s)
    auto &readerCount = fRecurseCounts.GetLocalReadersCount(local);
    TVirtualRWMutex::Hint_t *hint = reinterpret_cast<TVirtualRWMutex::Hint_t *>(&readerCount);
+   auto &localReaders = GetLocalReaders();
 
-   fReaders -= readerCount;
+   localReaders -= readerCount;
 
    // Wait for other writers, if any
    if (fWriter && fRecurseCounts.IsNotCurrentWriter(local)) {
-      if (readerCount && fReaders == 0) {
+      if (readerCount && GetReaders() == 0) {
          // we decrease fReaders to zero, let's wake up the
          // other writer.
          fCond.notify_all();
@@ -194,15 +224,12 @@ TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::WriteLock()
    fWriter = true;
    fRecurseCounts.SetIsWriter(local);
 
-   // Wait until all reader reservations finish
-   while (fReaderReservation) {
-   };
-
-   // Wait for remaining readers
-   fCond.wait(lock, [this] { return fReaders == 0; });
+   // Wait for remaining readers, including the ones which announced
+   // themselves before seeing fWriter
+   fCond.wait(lock, [this] { return GetReaders() == 0; });
 
    // Restore this thread's reader lock(s)
-   fReaders += readerCount;
+   localReaders += readerCount;
 
    --fWriterReservation;
 
@@ -334,15 +361,13 @@ TReentrantRWLock<MutexT, RecurseCountsT>::Rewind(const State &earlierState) {
    }
 
    if (pStateDelta->fDeltaReadersCount != 0) {
+      // Move the readers of this thread by the same amount as its local count below.
+      GetLocalReaders() += static_cast<int>(typedState.fReadersCount + 1 - *typedState.fReadersCountLoc);
       // Claim a recurse-state +1 to be able to call Unlock() below.
       *typedState.fReadersCountLoc = typedState.fReadersCount + 1;
-      // ReadersCount and Readers can be read/updated before actually holding the R/W lock.
-      // (See WriteLock and ReadLock methods) but fReaders is an atomic, so that should be fine
-      // but that's weird, that does not account to other change in fReaders during between
-      // the snapshot and the rewind ... humm unless the lock held is a WriteLock
-      // (the actual use case) in which case there is no other thread that can update fReaders
-      // and we also assume that the "user code" is balanced and release all read locks it takes.
-      fReaders = typedState.fReadersCount + 1;
+      // Only the readers of this thread are adjusted, by a delta: the readers of other
+      // threads are not overwritten even if they updated their slot in the meantime.
+      // We assume that the "user code" is balanced and release all read locks it takes.
       // Release this thread's reader lock(s)
       ReadUnLock(hint);
    }
@@ -381,7 +406,7 @@ void TReentrantRWLock<MutexT, RecurseCountsT>::Apply(std::unique_ptr<StateDelta>
    if (typedDelta->fDeltaReadersCount != 0) {
       ReadLock();
       // "- 1" due to ReadLock() above.
-      fReaders += typedDelta->fDeltaReadersCount - 1;
+      GetLocalReaders() += typedDelta->fDeltaReadersCount - 1;
       *typedDelta->fReadersCountLoc += typedDelta->fDeltaReadersCount - 1;
    }
 }
@@ -19,6 +19,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <thread>
 #include <unordered_map>
 
@@ -278,9 +279,17 @@ struct RecurseCountsTBBUnique {
 template <typename MutexT = ROOT::TSpinMutex, typename RecurseCountsT = Internal::RecurseCounts>
 class TReentrantRWLock {
 private:
+   /// Number of reader counters; the threads are spread over them by hashing their id.
+   static constexpr unsigned kReaderSlotBits = 6;
+   static constexpr unsigned kNReaderSlots = 1u << kReaderSlotBits;
+
+   /// A counter of readers, alone in its cache line so that readers of different slots do not
+   /// write to the same cache line.
+   struct alignas(64) ReaderSlot {
+      std::atomic<int> fReaders{0};
+   };
 
-   std::atomic<int> fReaders;           ///<! Number of readers
-   std::atomic<int> fReaderReservation; ///<! A reader wants access
+   std::unique_ptr<ReaderSlot[]> fReaderSlots; ///<! Number of readers, distributed over the slots
    std::atomic<int> fWriterReservation; ///<! A writer wants access
    std::atomic<bool> fWriter;           ///<! Is there a writer?
    MutexT fMutex;                       ///<! RWlock internal mutex
@@ -295,13 +304,19 @@ private:
 
    void AssertReadCountLocIsFromCurrentThread(const size_t* presumedLocalReadersCount);
 
+   /// The reader counter of the current thread.
+   std::atomic<int> &GetLocalReaders() const;
+
+   /// The total number of readers: the sum over the slots.
+   int GetReaders() const;
+
 public:
    using State = TVirtualRWMutex::State;
    using StateDelta = TVirtualRWMutex::StateDelta;
 
    ////////////////////////////////////////////////////////////////////////
    /// Regular constructor.
-   TReentrantRWLock() : fReaders(0), fReaderReservation(0), fWriterReservation(0), fWriter(false) {}
+   TReentrantRWLock() : fReaderSlots(new ReaderSlot[kNReaderSlots]), fWriterReservation(0), fWriter(false) {}
 
    TVirtualRWMutex::Hint_t *ReadLock();
    void ReadUnLock(TVirtualRWMutex::Hint_t *);
@@ -0,0 +1,70 @@
+#include "ROOT/RConcurrentHashColl.hxx"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using ROOT::Internal::RConcurrentHashColl;
+using ROOT::Internal::RUidColl;
+
+static RConcurrentHashColl::HashValue HashOf(int i)
+{
+   std::string key = "key" + std::to_string(i);
+   return RConcurrentHashColl::Hash(&key[0], key.size());
+}
+
+TEST(RConcurrentHashColl, InsertFind)
+{
+   RConcurrentHashColl coll;
+   EXPECT_EQ(coll.Find(HashOf(0)), nullptr);
+   EXPECT_TRUE(coll.Insert(HashOf(0), RUidColl{1, 2}));
+   EXPECT_FALSE(coll.Insert(HashOf(0), RUidColl{3}));
+   const RUidColl *uids = coll.Find(HashOf(0));
+   ASSERT_NE(uids, nullptr);
+   EXPECT_EQ(*uids, (RUidColl{1, 2}));
+
+   // the collections stay valid while the tables grow
+   for (int i = 1; i < 10000; ++i)
+      EXPECT_TRUE(coll.Insert(HashOf(i), RUidColl{i}));
+   EXPECT_EQ(coll.Find(HashOf(0)), uids);
+   for (int i = 1; i < 10000; ++i) {
+      auto found = coll.Find(HashOf(i));
+      ASSERT_NE(found, nullptr);
+      EXPECT_EQ(found->front(), i);
+   }
+}
+
+TEST(RConcurrentHashColl, ConcurrentInsertFind)
+{
+   RConcurrentHashColl coll;
+   const int nKeys = 2000;
+   std::vector<RConcurrentHashColl::HashValue> hashes;
+   for (int i = 0; i < nKeys; ++i)
+      hashes.push_back(HashOf(i));
+
+   std::vector<int> nInserted(4, 0), nMismatches(4, 0);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&, t]() {
+         for (int i = 0; i < nKeys; ++i) {
+            const int key = (i + t * nKeys / 4) % nKeys;
+            if (!coll.Find(hashes[key]) && coll.Insert(hashes[key], RUidColl{key}))
+               ++nInserted[t];
+            auto uids = coll.Find(hashes[key]);
+            if (!uids || uids->front() != key)
+               ++nMismatches[t];
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+
+   int total = 0;
+   for (int t = 0; t < 4; ++t) {
+      total += nInserted[t];
+      EXPECT_EQ(nMismatches[t], 0);
+   }
+   EXPECT_EQ(total, nKeys);
+}
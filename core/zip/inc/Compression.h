@@ -101,6 +101,8 @@ struct RCompressionSetting {
          kLZ4,
          /// Use ZSTD compression
          kZSTD,
+         /// Use ZSTD compression with a dictionary trained for each branch from its first baskets
+         kZSTDDict,
          /// Undefined compression algorithm (must be kept the last of the list in case a new algorithm is added).
          kUndefined
       };
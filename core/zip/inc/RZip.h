@@ -10,6 +10,8 @@
  *************************************************************************/
 #include "Compression.h"
 
+#include <cstddef>
+
 /**
  * These are definitions of various free functions for the C-style compression routines in ROOT.
  */
@@ -33,6 +35,27 @@ extern "C" void R__zip(int cxlevel, int *srcsize, char *src, int *tgtsize, char
 
 extern "C" void R__unzip(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
 
+/**
+ * Compress with the zstd dictionary `dictID`, see R__registerZipDictionary. The result is decompressed by
+ * R__unzip provided that the dictionary is registered in the reading process, too.  If the dictionary is
+ * not registered, this is the same as plain zstd compression.
+ */
+extern "C" void R__zipWithDictionary(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep,
+                                     unsigned dictID);
+
+/**
+ * Train a zstd dictionary of at most `capacity` bytes from `nsamples` samples stored one after the other in
+ * `samples`. Returns the size of the dictionary, or 0 if the samples are not suitable.
+ */
+extern "C" size_t R__trainZipDictionary(char *dict, size_t capacity, const char *samples, const size_t *sampleSizes,
+                                        unsigned nsamples);
+
+/**
+ * Make the dictionary available to R__zipWithDictionary and R__unzip in this process. Returns its ID, or 0
+ * if it is not a valid dictionary or if a different dictionary with the same ID was registered before.
+ */
+extern "C" unsigned R__registerZipDictionary(const char *dict, size_t size);
+
 extern "C" int R__unzip_header(int *srcsize, unsigned char *src, int *tgtsize);
 
 enum { kMAXZIPBUF = 0xffffff }; // 16 MB
@@ -0,0 +1,55 @@
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+ * Per-thread cache of the contexts of the compression algorithms used by R__zipMultipleAlgorithm and R__unzip.
+ * Setting up a context can cost more than compressing or decompressing a small buffer, so every thread keeps one
+ * context of each kind and reuses it for all its calls, be they from TBasket, TKey, the RNTuple page
+ * (de)compressors or TTreeCacheUnzip.
+ */
+
+#ifndef ROOT_RZipContext
+#define ROOT_RZipContext
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum ERZipContextKind {
+   kZipContextZLIBDeflate,
+   kZipContextZLIBInflate,
+   kZipContextLZMAEncoder,
+   kZipContextLZMADecoder,
+   kZipContextLZ4,
+   kZipContextLZ4HC,
+   kZipContextZSTDCompress,
+   kZipContextZSTDDecompress,
+   kZipContextNKinds
+};
+
+typedef void *(*R__ZipContextCreate_t)(int param);
+typedef void (*R__ZipContextDestroy_t)(void *context);
+
+/**
+ * Return the context of the given kind of the calling thread.  If there is none yet, or if it was created with a
+ * different `param` (e.g. a different compression level), it is created by `create(param)`.  Returns NULL if
+ * `create` fails.  The context is freed by `destroy` when the thread exits or in R__releaseZipContexts.
+ */
+void *R__getZipContext(enum ERZipContextKind kind, int param, R__ZipContextCreate_t create,
+                       R__ZipContextDestroy_t destroy);
+
+/**
+ * Free the contexts of the calling thread, e.g. to give back the memory of the LZMA encoder after writing.
+ */
+void R__releaseZipContexts(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -45,6 +45,7 @@ namespace ROOT {
      case EAlgorithm::EValues::kOldCompressionAlgo: return "Old compression algorithm";
      case EAlgorithm::EValues::kLZ4: return "lz4";
      case EAlgorithm::EValues::kZSTD: return "zstd";
+     case EAlgorithm::EValues::kZSTDDict: return "zstd with dictionary";
      default: return "Undefined compression algorithm";
      }
   }
@@ -9,6 +9,7 @@
 #include "Compression.h"
 #include "RConfigure.h"
 #include "RZip.h"
+#include "RZipContext.h"
 #include "Bits.h"
 #include "ZipLZMA.h"
 #include "ZipLZ4.h"
@@ -102,7 +103,9 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
      R__zipLZMA(cxlevel, srcsize, src, tgtsize, tgt, irep);
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kLZ4) {
      R__zipLZ4(cxlevel, srcsize, src, tgtsize, tgt, irep);
-  } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+  } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD ||
+             compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTDDict) {
+     // Without a dictionary (see R__zipWithDictionary), kZSTDDict is plain zstd.
      R__zipZSTD(cxlevel, srcsize, src, tgtsize, tgt, irep);
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kOldCompressionAlgo || compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal) {
      R__zipOld(cxlevel, srcsize, src, tgtsize, tgt, irep);
@@ -114,6 +117,35 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
   }
 }
 
+void R__zipWithDictionary(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictID)
+{
+  *irep = 0;
+
+  // Same checks as in R__zipMultipleAlgorithm.
+  if (*srcsize < 1 + HDRSIZE + 1) {
+     return;
+  }
+  if (*tgtsize <= HDRSIZE) {
+     return;
+  }
+  if (cxlevel <= 0) {
+    return;
+  }
+
+  R__zipZSTDDict(cxlevel, srcsize, src, tgtsize, tgt, irep, dictID);
+}
+
+size_t R__trainZipDictionary(char *dict, size_t capacity, const char *samples, const size_t *sampleSizes,
+                             unsigned nsamples)
+{
+  return R__trainZSTDDict(dict, capacity, samples, sampleSizes, nsamples);
+}
+
+unsigned R__registerZipDictionary(const char *dict, size_t size)
+{
+  return R__registerZSTDDict(dict, size);
+}
+
   // The very old algorithm for backward compatibility
   // 0 for selecting with R__ZipMode in a backward compatible way
   // 3 for selecting in other cases
@@ -175,6 +207,54 @@ static void R__zipOld(int cxlevel, int *srcsize, char *src, int *tgtsize, char *
     return;
 }
 
+/**
+ * The zlib streams are cached per thread, see RZipContext.h: resetting a stream is much cheaper than
+ * initializing it. The deflate streams are created for a given compression level.
+ */
+static void *R__createDeflateStream(int cxlevel)
+{
+   z_stream *stream = new z_stream;
+   stream->zalloc = (alloc_func)0;
+   stream->zfree = (free_func)0;
+   stream->opaque = (voidpf)0;
+   int err = deflateInit(stream, cxlevel);
+   if (err != Z_OK) {
+      printf("error %d in deflateInit (zlib)\n", err);
+      delete stream;
+      return nullptr;
+   }
+   return stream;
+}
+
+static void R__freeDeflateStream(void *stream)
+{
+   deflateEnd(static_cast<z_stream *>(stream));
+   delete static_cast<z_stream *>(stream);
+}
+
+static void *R__createInflateStream(int)
+{
+   z_stream *stream = new z_stream;
+   stream->next_in = Z_NULL;
+   stream->avail_in = 0;
+   stream->zalloc = (alloc_func)0;
+   stream->zfree = (free_func)0;
+   stream->opaque = (voidpf)0;
+   int err = inflateInit(stream);
+   if (err != Z_OK) {
+      fprintf(stderr, "R__unzip: error %d in inflateInit (zlib)\n", err);
+      delete stream;
+      return nullptr;
+   }
+   return stream;
+}
+
+static void R__freeInflateStream(void *stream)
+{
+   inflateEnd(static_cast<z_stream *>(stream));
+   delete static_cast<z_stream *>(stream);
+}
+
 /**
  * Compress buffer contents using the venerable zlib algorithm.
  */
@@ -183,7 +263,7 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
   int err;
   int method   = Z_DEFLATED;
 
-    z_stream stream;
+    z_stream *stream;
     //Don't use the globals but want name similar to help see similarities in code
     unsigned l_in_size, l_out_size;
     *irep = 0;
@@ -197,40 +277,35 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
        return;
     }
 
-    stream.next_in   = (Bytef*)src;
-    stream.avail_in  = (uInt)(*srcsize);
-
-    stream.next_out  = (Bytef*)(&tgt[HDRSIZE]);
-    stream.avail_out = (uInt)(*tgtsize) - HDRSIZE;
-
-    stream.zalloc    = (alloc_func)0;
-    stream.zfree     = (free_func)0;
-    stream.opaque    = (voidpf)0;
-
     if (cxlevel > 9) cxlevel = 9;
-    err = deflateInit(&stream, cxlevel);
+    stream = static_cast<z_stream *>(
+       R__getZipContext(kZipContextZLIBDeflate, cxlevel, R__createDeflateStream, R__freeDeflateStream));
+    if (!stream)
+       return;
+    err = deflateReset(stream);
     if (err != Z_OK) {
-       printf("error %d in deflateInit (zlib)\n",err);
+       printf("error %d in deflateReset (zlib)\n",err);
        return;
     }
 
-    while ((err = deflate(&stream, Z_FINISH)) != Z_STREAM_END) {
+    stream->next_in   = (Bytef*)src;
+    stream->avail_in  = (uInt)(*srcsize);
+
+    stream->next_out  = (Bytef*)(&tgt[HDRSIZE]);
+    stream->avail_out = (uInt)(*tgtsize) - HDRSIZE;
+
+    while ((err = deflate(stream, Z_FINISH)) != Z_STREAM_END) {
        if (err != Z_OK) {
-          deflateEnd(&stream);
           return;
        }
     }
 
-    err = deflateEnd(&stream);
-    if (err != Z_OK)
-       printf("error %d in deflateEnd (zlib)\n",err);
-
     tgt[0] = 'Z';               /* Signature ZLib */
     tgt[1] = 'L';
     tgt[2] = (char) method;
 
     l_in_size   = (unsigned) (*srcsize);
-    l_out_size  = stream.total_out;             /* compressed size */
+    l_out_size  = stream->total_out;            /* compressed size */
     tgt[3] = (char)(l_out_size & 0xff);
     tgt[4] = (char)((l_out_size >> 8) & 0xff);
     tgt[5] = (char)((l_out_size >> 16) & 0xff);
@@ -239,7 +314,7 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
     tgt[7] = (char)((l_in_size >> 8) & 0xff);
     tgt[8] = (char)((l_in_size >> 16) & 0xff);
 
-    *irep = stream.total_out + HDRSIZE;
+    *irep = stream->total_out + HDRSIZE;
 }
 
 
@@ -395,33 +470,31 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
 
 void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
 {
-     z_stream stream; /* decompression stream */
+     z_stream *stream; /* decompression stream */
      int err = 0;
 
-     stream.next_in = (Bytef *)(&src[HDRSIZE]);
-     stream.avail_in = (uInt)(*srcsize) - HDRSIZE;
-     stream.next_out = (Bytef *)tgt;
-     stream.avail_out = (uInt)(*tgtsize);
-     stream.zalloc = (alloc_func)0;
-     stream.zfree = (free_func)0;
-     stream.opaque = (voidpf)0;
-
-     err = inflateInit(&stream);
+     stream = static_cast<z_stream *>(
+        R__getZipContext(kZipContextZLIBInflate, 0, R__createInflateStream, R__freeInflateStream));
+     if (!stream)
+        return;
+     err = inflateReset(stream);
      if (err != Z_OK) {
-        fprintf(stderr, "R__unzip: error %d in inflateInit (zlib)\n", err);
+        fprintf(stderr, "R__unzip: error %d in inflateReset (zlib)\n", err);
         return;
      }
 
-     while ((err = inflate(&stream, Z_FINISH)) != Z_STREAM_END) {
+     stream->next_in = (Bytef *)(&src[HDRSIZE]);
+     stream->avail_in = (uInt)(*srcsize) - HDRSIZE;
+     stream->next_out = (Bytef *)tgt;
+     stream->avail_out = (uInt)(*tgtsize);
+
+     while ((err = inflate(stream, Z_FINISH)) != Z_STREAM_END) {
         if (err != Z_OK) {
-           inflateEnd(&stream);
            fprintf(stderr, "R__unzip: error %d in inflate (zlib)\n", err);
            return;
         }
      }
 
-     inflateEnd(&stream);
-
-     *irep = stream.total_out;
+     *irep = stream->total_out;
      return;
 }
@@ -0,0 +1,64 @@
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "RZipContext.h"
+
+namespace {
+
+struct RZipContextSlot {
+   void *fContext = nullptr;
+   int fParam = 0;
+   R__ZipContextDestroy_t fDestroy = nullptr;
+
+   void Release()
+   {
+      if (fContext)
+         fDestroy(fContext);
+      fContext = nullptr;
+   }
+};
+
+struct RZipContexts {
+   RZipContextSlot fSlots[kZipContextNKinds];
+
+   ~RZipContexts()
+   {
+      for (auto &slot : fSlots)
+         slot.Release();
+   }
+};
+
+RZipContexts &GetThreadZipContexts()
+{
+   thread_local RZipContexts contexts;
+   return contexts;
+}
+
+} // anonymous namespace
+
+void *R__getZipContext(ERZipContextKind kind, int param, R__ZipContextCreate_t create, R__ZipContextDestroy_t destroy)
+{
+   if (kind < 0 || kind >= kZipContextNKinds)
+      return nullptr;
+
+   auto &slot = GetThreadZipContexts().fSlots[kind];
+   if (slot.fContext && slot.fParam == param)
+      return slot.fContext;
+
+   slot.Release();
+   slot.fContext = create(param);
+   slot.fParam = param;
+   slot.fDestroy = destroy;
+   return slot.fContext;
+}
+
+void R__releaseZipContexts()
+{
+   for (auto &slot : GetThreadZipContexts().fSlots)
+      slot.Release();
+}
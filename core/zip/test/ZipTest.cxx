@@ -1,9 +1,13 @@
 #include <Compression.h>
 #include <RZip.h>
+#include <RZipContext.h>
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <memory>
+#include <thread>
+#include <vector>
 
 static void testZipBufferSizes(ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm)
 {
@@ -68,3 +72,49 @@ TEST(RZip, ZipBufferSizesZSTD)
 {
    testZipBufferSizes(ROOT::RCompressionSetting::EAlgorithm::kZSTD);
 }
+
+static void testZipRoundTrip(ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm)
+{
+   static constexpr int BufferSize = 4096;
+   std::vector<char> source(BufferSize);
+   std::vector<char> compressed(BufferSize);
+   std::vector<char> target(BufferSize);
+   for (int i = 0; i < BufferSize; i++)
+      source[i] = static_cast<char>(i % 13 + i / 100);
+
+   // The (de)compression contexts are reused across calls with different levels.
+   for (int cxlevel = 1; cxlevel <= 9; cxlevel++) {
+      int srcsize = BufferSize;
+      int tgtsize = BufferSize;
+      int irep = 0;
+      R__zipMultipleAlgorithm(cxlevel, &srcsize, source.data(), &tgtsize, compressed.data(), &irep,
+                              compressionAlgorithm);
+      ASSERT_GT(irep, 0);
+
+      int zipsize = irep;
+      int unzipsize = BufferSize;
+      irep = 0;
+      R__unzip(&zipsize, reinterpret_cast<unsigned char *>(compressed.data()), &unzipsize,
+               reinterpret_cast<unsigned char *>(target.data()), &irep);
+      ASSERT_EQ(BufferSize, irep);
+      EXPECT_EQ(0, memcmp(source.data(), target.data(), BufferSize));
+   }
+}
+
+TEST(RZip, ZipContextReuse)
+{
+   const auto algorithms = {ROOT::RCompressionSetting::EAlgorithm::kZLIB, ROOT::RCompressionSetting::EAlgorithm::kLZMA,
+                            ROOT::RCompressionSetting::EAlgorithm::kLZ4, ROOT::RCompressionSetting::EAlgorithm::kZSTD};
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 4; t++) {
+      threads.emplace_back([&algorithms] {
+         for (auto algorithm : algorithms)
+            testZipRoundTrip(algorithm);
+         R__releaseZipContexts();
+         for (auto algorithm : algorithms)
+            testZipRoundTrip(algorithm);
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+}
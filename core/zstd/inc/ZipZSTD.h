@@ -12,11 +12,20 @@
 
 // NOTE: the ROOT compression libraries aren't consistently written in C++; hence the
 // #ifdef's to avoid problems with C code.
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+
+// Dictionary compression: a dictionary is registered once per process and referred to by its ID, which zstd
+// stores in every frame so that R__unzipZSTD finds the dictionary it needs.
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictID);
+size_t R__trainZSTDDict(char *dict, size_t capacity, const char *samples, const size_t *sampleSizes,
+                        unsigned nsamples);
+unsigned R__registerZSTDDict(const char *dict, size_t size);
 #ifdef __cplusplus
 }
 #endif
@@ -9,12 +9,16 @@
  *************************************************************************/
 
 #include "ZipZSTD.h"
+#include "RZipContext.h"
 
 #include "ROOT/RConfig.hxx"
 
 #include "zdict.h"
 #include <zstd.h>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #include <iostream>
 
@@ -22,18 +26,93 @@ static const int kHeaderSize = 9;
 
 static const size_t errorCodeSmallBuffer = (size_t)-70;
 
-void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+namespace {
+
+struct ZSTDDictDeleter {
+   void operator()(ZSTD_CDict *dict) const { ZSTD_freeCDict(dict); }
+   void operator()(ZSTD_DDict *dict) const { ZSTD_freeDDict(dict); }
+};
+
+/// A dictionary registered with R__registerZSTDDict, with its digested forms
+struct ZSTDDict {
+   std::string fContent;
+   std::unique_ptr<ZSTD_DDict, ZSTDDictDeleter> fDDict;
+   /// Digested dictionaries for compression, by compression level
+   std::unordered_map<int, std::unique_ptr<ZSTD_CDict, ZSTDDictDeleter>> fCDicts;
+};
+
+struct ZSTDDictRegistry {
+   std::mutex fMutex;
+   std::unordered_map<unsigned, ZSTDDict> fDicts;
+};
+
+ZSTDDictRegistry &GetDictRegistry()
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
-    Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+   // Never deleted: baskets may still be (de)compressed during the tear down.
+   static ZSTDDictRegistry *registry = new ZSTDDictRegistry;
+   return *registry;
+}
 
-    *irep = 0;
+/// The returned dictionary lives until the end of the process.
+const ZSTD_CDict *GetCDict(unsigned dictID, int level)
+{
+   auto &registry = GetDictRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   auto iter = registry.fDicts.find(dictID);
+   if (iter == registry.fDicts.end())
+      return nullptr;
+   auto &cdict = iter->second.fCDicts[level];
+   if (!cdict) {
+      const auto &content = iter->second.fContent;
+      cdict.reset(ZSTD_createCDict(content.data(), content.size(), level));
+   }
+   return cdict.get();
+}
 
-    size_t retval = ZSTD_compressCCtx(fCtx.get(),
-                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
-                                        src, static_cast<size_t>(*srcsize),
-                                        2*cxlevel);
+/// The returned dictionary lives until the end of the process.
+const ZSTD_DDict *GetDDict(unsigned dictID)
+{
+   auto &registry = GetDictRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   auto iter = registry.fDicts.find(dictID);
+   return (iter == registry.fDicts.end()) ? nullptr : iter->second.fDDict.get();
+}
+
+void *CreateCCtx(int)
+{
+   return ZSTD_createCCtx();
+}
+
+void FreeCCtx(void *ctx)
+{
+   ZSTD_freeCCtx(static_cast<ZSTD_CCtx *>(ctx));
+}
+
+void *CreateDCtx(int)
+{
+   return ZSTD_createDCtx();
+}
+
+void FreeDCtx(void *ctx)
+{
+   ZSTD_freeDCtx(static_cast<ZSTD_DCtx *>(ctx));
+}
+
+/// The compression context of the calling thread, see RZipContext.h
+ZSTD_CCtx *GetCCtx()
+{
+   return static_cast<ZSTD_CCtx *>(R__getZipContext(kZipContextZSTDCompress, 0, CreateCCtx, FreeCCtx));
+}
+
+/// The decompression context of the calling thread, see RZipContext.h
+ZSTD_DCtx *GetDCtx()
+{
+   return static_cast<ZSTD_DCtx *>(R__getZipContext(kZipContextZSTDDecompress, 0, CreateDCtx, FreeDCtx));
+}
 
+/// Check the result of the compression and write the ROOT header in front of the zstd frame.
+void FinishZip(size_t retval, int *srcsize, char *tgt, int *irep)
+{
     if (R__unlikely(ZSTD_isError(retval))) {
         if (R__unlikely(retval != errorCodeSmallBuffer)) {
             std::cerr << "Error in zip ZSTD. Type = " << ZSTD_getErrorName(retval) <<
@@ -58,10 +137,78 @@ void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
     tgt[8] = (inflate_size >> 16) & 0xff;
 }
 
+} // anonymous namespace
+
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+    *irep = 0;
+
+    ZSTD_CCtx *ctx = GetCCtx();
+    if (R__unlikely(!ctx))
+        return;
+
+    size_t retval = ZSTD_compressCCtx(ctx,
+                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                        src, static_cast<size_t>(*srcsize),
+                                        2*cxlevel);
+
+    FinishZip(retval, srcsize, tgt, irep);
+}
+
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, unsigned dictID)
+{
+    const ZSTD_CDict *cdict = GetCDict(dictID, 2*cxlevel);
+    if (R__unlikely(!cdict)) {
+        // Unknown dictionary: the frame is still valid, it only compresses less.
+        R__zipZSTD(cxlevel, srcsize, src, tgtsize, tgt, irep);
+        return;
+    }
+
+    *irep = 0;
+
+    ZSTD_CCtx *ctx = GetCCtx();
+    if (R__unlikely(!ctx))
+        return;
+
+    size_t retval = ZSTD_compress_usingCDict(ctx,
+                                             &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                             src, static_cast<size_t>(*srcsize),
+                                             cdict);
+
+    FinishZip(retval, srcsize, tgt, irep);
+}
+
+size_t R__trainZSTDDict(char *dict, size_t capacity, const char *samples, const size_t *sampleSizes,
+                        unsigned nsamples)
+{
+    size_t retval = ZDICT_trainFromBuffer(dict, capacity, samples, sampleSizes, nsamples);
+    if (ZDICT_isError(retval))
+        return 0;
+    return retval;
+}
+
+unsigned R__registerZSTDDict(const char *dict, size_t size)
+{
+    unsigned dictID = ZDICT_getDictID(dict, size);
+    if (dictID == 0)
+        return 0;
+
+    auto &registry = GetDictRegistry();
+    std::lock_guard<std::mutex> lock(registry.fMutex);
+    auto &entry = registry.fDicts[dictID];
+    if (entry.fContent.empty()) {
+        entry.fContent.assign(dict, size);
+        entry.fDDict.reset(ZSTD_createDDict(dict, size));
+    } else if (entry.fContent.compare(0, std::string::npos, dict, size) != 0) {
+        std::cerr << "R__registerZSTDDict: a different dictionary with ID " << dictID <<
+        " is already registered" << std::endl;
+        return 0;
+    }
+    return dictID;
+}
+
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
-    Ctx_ptr fCtx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
     *irep = 0;
 
     if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
@@ -77,9 +224,29 @@ void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
       return;
     }
 
-    size_t retval = ZSTD_decompressDCtx(fCtx.get(),
-                                        (char *)tgt, static_cast<size_t>(*tgtsize),
-                                        (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    ZSTD_DCtx *ctx = GetDCtx();
+    if (R__unlikely(!ctx))
+        return;
+
+    size_t retval;
+    // Frames compressed with R__zipZSTDDict carry the ID of their dictionary.
+    unsigned dictID = ZSTD_getDictID_fromFrame(&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    if (dictID != 0) {
+      const ZSTD_DDict *ddict = GetDDict(dictID);
+      if (R__unlikely(!ddict)) {
+        std::cerr << "R__unzipZSTD: buffer compressed with the dictionary " << dictID <<
+        ", which is not registered." << std::endl;
+        return;
+      }
+      retval = ZSTD_decompress_usingDDict(ctx,
+                                          (char *)tgt, static_cast<size_t>(*tgtsize),
+                                          (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize),
+                                          ddict);
+    } else {
+      retval = ZSTD_decompressDCtx(ctx,
+                                   (char *)tgt, static_cast<size_t>(*tgtsize),
+                                   (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    }
 
     /* The error code 18446744073709551546 arises when the tgt buffer is too small
      * However this error is already handled outside of the compression algorithm
@@ -0,0 +1,46 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoBVHVoxelFinder
+#define ROOT_TGeoBVHVoxelFinder
+
+#include "TGeoVoxelFinder.h"
+
+class TGeoBVHVoxelFinder : public TGeoVoxelFinder {
+private:
+   void *fBVH = nullptr; //! bounding volume hierarchy of the daughter bounding boxes
+
+   TGeoBVHVoxelFinder(const TGeoBVHVoxelFinder &) = delete;
+   TGeoBVHVoxelFinder &operator=(const TGeoBVHVoxelFinder &) = delete;
+
+   void BuildBVH();
+   void DeleteBVH();
+   void CheckBVH();
+   Double_t DistToBox(Int_t inode, const Double_t *point, const Double_t *invdir) const;
+
+public:
+   TGeoBVHVoxelFinder() = default;
+   TGeoBVHVoxelFinder(TGeoVolume *vol);
+   ~TGeoBVHVoxelFinder() override;
+
+   Double_t Efficiency() override;
+   void FindOverlaps(Int_t inode) const override;
+   Int_t *GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td) override;
+   Int_t *GetNextCandidates(const Double_t *point, Int_t &ncheck, TGeoStateInfo &td) override;
+   Int_t *GetNextVoxel(const Double_t *point, const Double_t *dir, Int_t &ncheck, TGeoStateInfo &td) override;
+   void Print(Option_t *option = "") const override;
+   Double_t Safety(const Double_t *point, Double_t safmax, Bool_t boxbounds = kFALSE);
+   void SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td) override;
+   void Voxelize(Option_t *option = "") override;
+
+   ClassDefOverride(TGeoBVHVoxelFinder, 1) // voxel finder based on a bounding volume hierarchy
+};
+
+#endif
@@ -14,6 +14,8 @@
 
 #include "TGeoBBox.h"
 
+#include <atomic>
+
 /////////////////////////////////////////////////////////////////////////////
 //                                                                         //
 // TGeoCompositeShape - composite shape class. A composite shape contains  //
@@ -27,7 +29,12 @@ class TGeoBoolNode;
 class TGeoCompositeShape : public TGeoBBox {
 private:
    // data members
-   TGeoBoolNode *fNode; // top boolean node
+   TGeoBoolNode *fNode;                            // top boolean node
+   mutable std::atomic<void *> fCompiled{nullptr}; //! flattened form of the boolean tree, built on first use
+   static Int_t fgLookupBins;                      //! number of bins per axis of the inside/outside lookup table
+
+   const void *GetCompiled() const;
+   void DeleteCompiled();
 
 protected:
    TGeoCompositeShape(const TGeoCompositeShape &) = delete;
@@ -68,6 +75,8 @@ public:
    Int_t GetNmeshVertices() const override;
    Bool_t GetPointsOnSegments(Int_t /*npoints*/, Double_t * /*array*/) const override { return kFALSE; }
    void InspectShape() const override;
+   static Int_t GetLookupTableBins();
+   static void SetLookupTableBins(Int_t nbins);
    Bool_t IsComposite() const override { return kTRUE; }
    Bool_t IsCylType() const override { return kFALSE; }
    void MakeNode(const char *expression);
@@ -0,0 +1,93 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoFlatGeometry
+#define ROOT_TGeoFlatGeometry
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class TGeoManager;
+class TGeoNode;
+class TGeoShape;
+class TGeoVolume;
+
+class TGeoFlatGeometry {
+public:
+   /// A logical volume, its daughters are the placements [fFirstDaughter, fFirstDaughter + fNdaughters)
+   struct Volume {
+      const TGeoVolume *fVolume = nullptr; ///< Original volume
+      const TGeoShape *fShape = nullptr;   ///< Shape of the volume
+      Int_t fFirstDaughter = 0;            ///< Index of the first daughter placement
+      Int_t fNdaughters = 0;               ///< Number of daughters
+      Bool_t fAssembly = kFALSE;           ///< The volume is an assembly
+   };
+
+   /// A volume placed in its mother. The local transform and the bounding box in the mother frame
+   /// of the placement with index i are stored at index i of the SoA arrays.
+   struct Placement {
+      const TGeoNode *fNode = nullptr; ///< Original node
+      Int_t fVolume = 0;               ///< Index of the placed volume
+   };
+
+   /// A touchable (placement path) of the upper levels of the tree having a precomputed global transform
+   struct Touchable {
+      Int_t fParent = -1;     ///< Index of the parent touchable, -1 for the top
+      Int_t fPlacement = -1;  ///< Index of the placement, -1 for the top
+      Int_t fFirstChild = -1; ///< Index of the touchable of the first daughter, -1 if not expanded
+   };
+
+   /// Number of values of an affine transform: 9 rotation and 3 translation components
+   static constexpr Int_t kNtransform = 12;
+
+private:
+   const TGeoNode *fTopNode = nullptr;                   ///< Top node of the original geometry
+   std::vector<Volume> fVolumes;                         ///< Logical volumes, the top volume first
+   std::vector<Placement> fPlacements;                   ///< Placements, the daughters of a volume are contiguous
+   std::vector<Double_t> fTransforms[kNtransform];       ///< Local transforms of the placements, SoA
+   std::vector<Float_t> fTransformsF[kNtransform];       ///< Single precision copy of the local transforms, SoA
+   std::vector<Double_t> fBoxes[6];                      ///< Bounding boxes in the mother frame: dx,dy,dz,ox,oy,oz
+   std::vector<Touchable> fTouchables;                   ///< Precomputed touchables, breadth first
+   std::vector<Double_t> fGlobalTransforms[kNtransform]; ///< Global transforms of the touchables, SoA
+   Int_t fMaxDepth = 0;                                  ///< Depth of the geometry tree
+
+   void ExpandTouchables(Int_t maxdepth, Int_t maxtouchables);
+
+public:
+   TGeoFlatGeometry(const TGeoManager *geom, Int_t touchableDepth = 3, Int_t maxTouchables = 100000);
+
+   const TGeoNode *GetTopNode() const { return fTopNode; }
+   Int_t GetNvolumes() const { return fVolumes.size(); }
+   Int_t GetNplacements() const { return fPlacements.size(); }
+   Int_t GetNtouchables() const { return fTouchables.size(); }
+   Int_t GetMaxDepth() const { return fMaxDepth; }
+
+   const Volume &GetVolume(Int_t ivol) const { return fVolumes[ivol]; }
+   const Placement &GetPlacement(Int_t iplace) const { return fPlacements[iplace]; }
+   const Touchable &GetTouchable(Int_t itouch) const { return fTouchables[itouch]; }
+
+   /// Component K (0-8 rotation, 9-11 translation) of the local transforms of all placements
+   const Double_t *GetTransforms(Int_t k) const { return fTransforms[k].data(); }
+   const Float_t *GetTransformsF(Int_t k) const { return fTransformsF[k].data(); }
+   /// Component K (0-2 half lengths, 3-5 origin) of the placement bounding boxes in the mother frame
+   const Double_t *GetBoxes(Int_t k) const { return fBoxes[k].data(); }
+   /// Component K of the global transforms of all touchables
+   const Double_t *GetGlobalTransforms(Int_t k) const { return fGlobalTransforms[k].data(); }
+
+   void GetTransform(Int_t iplace, Double_t *tr) const;
+   void GetGlobalTransform(Int_t itouch, Double_t *tr) const;
+
+   static void MasterToLocal(const Double_t *tr, const Double_t *master, Double_t *local);
+   static void MasterToLocalVect(const Double_t *tr, const Double_t *master, Double_t *local);
+   static void Multiply(const Double_t *left, const Double_t *right, Double_t *result);
+};
+
+#endif
@@ -0,0 +1,55 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoFlatNavigator
+#define ROOT_TGeoFlatNavigator
+
+#include "TGeoFlatGeometry.h"
+#include "TGeoShape.h"
+
+#include <vector>
+
+class TGeoFlatNavigator {
+private:
+   const TGeoFlatGeometry *fGeometry; ///< Navigated geometry
+   Int_t fLevel = 0;                  ///< Current level, 0 for the top volume
+   Bool_t fOutside = kTRUE;           ///< The current point is outside the top volume
+   std::vector<Int_t> fPlacements;    ///< Placement index per level, -1 for the top
+   std::vector<Int_t> fVolumes;       ///< Volume index per level
+   std::vector<Int_t> fTouchables;    ///< Touchable index per level, -1 below the precomputed touchables
+   std::vector<Double_t> fGlobal;     ///< Global transform per level, TGeoFlatGeometry::kNtransform values each
+
+   const Double_t *GetGlobal(Int_t level) const { return &fGlobal[level * TGeoFlatGeometry::kNtransform]; }
+   Bool_t DescendOne(const Double_t *point);
+   void LocateDown(const Double_t *point);
+   void Pop() { fLevel--; }
+   void Push(Int_t iplace);
+   void Relocate(const Double_t *point);
+
+public:
+   TGeoFlatNavigator(const TGeoFlatGeometry *geom);
+
+   Bool_t FindNode(const Double_t *point);
+   Double_t FindNextBoundary(const Double_t *point, const Double_t *dir, Int_t &inext,
+                             Double_t stepmax = TGeoShape::Big()) const;
+   Double_t Step(Double_t *point, const Double_t *dir, Double_t stepmax = TGeoShape::Big());
+   Double_t Safety(const Double_t *point) const;
+
+   Int_t GetLevel() const { return fLevel; }
+   Bool_t IsOutside() const { return fOutside; }
+   Int_t GetPlacement(Int_t level) const { return fPlacements[level]; }
+   Int_t GetCurrentVolumeIndex() const { return fVolumes[fLevel]; }
+   const TGeoNode *GetCurrentNode() const;
+   const TGeoVolume *GetCurrentVolume() const { return fGeometry->GetVolume(fVolumes[fLevel]).fVolume; }
+   /// Global transform of the current level, see TGeoFlatGeometry
+   const Double_t *GetCurrentMatrix() const { return GetGlobal(fLevel); }
+};
+
+#endif
@@ -12,6 +12,7 @@
 #ifndef ROOT_TGeoManager
 #define ROOT_TGeoManager
 
+#include <atomic>
 #include <mutex>
 #include <thread>
 #include <map>
@@ -53,6 +54,7 @@ protected:
    static Int_t fgMaxDaughters;         //! Maximum number of daughters
    static Int_t fgMaxXtruVert;          //! Maximum number of Xtru vertices
    static UInt_t fgExportPrecision;     //! Precision to be used in ASCII exports
+   static Int_t fgBVHVoxelsThreshold;   //! Minimum number of daughters for BVH voxels (0 = never)
    static EDefaultUnits fgDefaultUnits; //! Default units in GDML if not explicit in some tags
 
    TGeoManager(const TGeoManager &) = delete;
@@ -111,24 +113,23 @@ private:
    // Map of navigator arrays per thread
    typedef std::map<std::thread::id, TGeoNavigatorArray *> NavigatorsMap_t;
    typedef NavigatorsMap_t::iterator NavigatorsMapIt_t;
-   typedef std::map<std::thread::id, Int_t> ThreadsMap_t;
-   typedef ThreadsMap_t::const_iterator ThreadsMapIt_t;
    // Map of constant properties
    typedef std::map<std::string, Double_t> ConstPropMap_t;
 
-   NavigatorsMap_t fNavigators;      //! Map between thread id's and navigator arrays
-   static ThreadsMap_t *fgThreadId;  //! Thread id's map
-   static Int_t fgNumThreads;        //! Number of registered threads
-   static Bool_t fgLockNavigators;   //! Lock existing navigators
-   TGeoNavigator *fCurrentNavigator; //! current navigator
-   TGeoVolume *fCurrentVolume;       //! current volume
-   TGeoVolume *fTopVolume;           //! top level volume in geometry
-   TGeoNode *fTopNode;               //! top physical node
-   TGeoVolume *fMasterVolume;        // master volume
-   TGeoHMatrix *fGLMatrix;           // matrix to be used for view transformations
-   TObjArray *fUniqueVolumes;        //-> list of unique volumes
-   TGeoShape *fClippingShape;        //! clipping shape for raytracing
-   TGeoElementTable *fElementTable;  //! table of elements
+   NavigatorsMap_t fNavigators;                       //! Map between thread id's and navigator arrays
+   static std::atomic<Int_t> fgNumThreads;            //! Number of registered threads
+   static std::atomic<UInt_t> fgThreadsGeneration;    //! Incremented when the thread id's are reset
+   static std::atomic<UInt_t> fgNavigatorsGeneration; //! Incremented when navigator arrays are created or deleted
+   static Bool_t fgLockNavigators;                    //! Lock existing navigators
+   TGeoNavigator *fCurrentNavigator;                  //! current navigator
+   TGeoVolume *fCurrentVolume;                        //! current volume
+   TGeoVolume *fTopVolume;                            //! top level volume in geometry
+   TGeoNode *fTopNode;                                //! top physical node
+   TGeoVolume *fMasterVolume;                         // master volume
+   TGeoHMatrix *fGLMatrix;                            // matrix to be used for view transformations
+   TObjArray *fUniqueVolumes;                         //-> list of unique volumes
+   TGeoShape *fClippingShape;                         //! clipping shape for raytracing
+   TGeoElementTable *fElementTable;                   //! table of elements
 
    Int_t fNLevel;                     // maximum accepted level in geometry
    TGeoVolume *fPaintVolume;          //! volume currently painted
@@ -457,6 +458,8 @@ public:
    static Bool_t IsLocked();
    static void SetExportPrecision(UInt_t prec);
    static UInt_t GetExportPrecision();
+   static void SetBVHVoxelsThreshold(Int_t ndaughters);
+   static Int_t GetBVHVoxelsThreshold();
    static void SetDefaultUnits(EDefaultUnits new_value);
    static EDefaultUnits GetDefaultUnits();
    static Bool_t LockDefaultUnits(Bool_t new_value);
@@ -0,0 +1,55 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoMaterialScan
+#define ROOT_TGeoMaterialScan
+
+#include "TGeoShape.h"
+
+#include <vector>
+
+class TGeoFlatGeometry;
+
+class TGeoMaterialScan {
+public:
+   /// Material budget integrated along a ray
+   struct Result {
+      Double_t fRadLen = 0.; ///< Thickness in radiation lengths
+      Double_t fIntLen = 0.; ///< Thickness in nuclear interaction lengths
+      Double_t fLength = 0.; ///< Length traversed inside the geometry
+   };
+
+private:
+   const TGeoFlatGeometry *fGeometry;   ///< Scanned geometry
+   std::vector<Double_t> fInvRadLen;    ///< Inverse radiation length of the material of each volume
+   std::vector<Double_t> fInvIntLen;    ///< Inverse interaction length of the material of each volume
+   std::vector<Double_t> fVolumeRadLen; ///< Radiation lengths accumulated in each volume by all the scans
+   std::vector<Double_t> fVolumeIntLen; ///< Interaction lengths accumulated in each volume by all the scans
+   Int_t fBatchSize = 64;               ///< Number of rays traced per task
+
+   void ScanBatch(Int_t first, Int_t last, const Double_t *points, const Double_t *dirs, Result *results,
+                  Double_t maxlength, Double_t *volRadLen, Double_t *volIntLen) const;
+
+public:
+   TGeoMaterialScan(const TGeoFlatGeometry *geom);
+
+   void Scan(Int_t nrays, const Double_t *points, const Double_t *dirs, Result *results,
+             Double_t maxlength = TGeoShape::Big());
+   void Reset();
+
+   Int_t GetBatchSize() const { return fBatchSize; }
+   void SetBatchSize(Int_t nrays) { fBatchSize = nrays > 0 ? nrays : 1; }
+   /// Radiation lengths accumulated in the volume of index IVOL of the flat geometry since the last Reset()
+   Double_t GetVolumeRadLen(Int_t ivol) const { return fVolumeRadLen[ivol]; }
+   /// Interaction lengths accumulated in the volume of index IVOL of the flat geometry since the last Reset()
+   Double_t GetVolumeIntLen(Int_t ivol) const { return fVolumeIntLen[ivol]; }
+};
+
+#endif
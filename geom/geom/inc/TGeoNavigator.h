@@ -51,6 +51,10 @@ private:
    Double_t fLastPoint[3];       //! last point for which safety was computed
    Double_t fLastPWSaftyPnt[3];  //! last point for which parallel world safety was "evaluated"
    Double_t fLastPWSafety{-1};   //! last safety returned from parallel world (negative if invalid)
+   Double_t fSafetyCenter[3]{};  //! center of the last safety sphere
+   Double_t fSafetyRadius{-1};   //! radius of the last safety sphere (negative if invalid)
+   Double_t fSafetyMatrix[12]{}; //! global rotation and translation of the node of the safety sphere
+   TGeoNode *fSafetyNode{};      //! node of the safety sphere, nullptr if computed outside
    Int_t fThreadId;              //! thread id for this navigator
    Int_t fLevel;                 //! current geometry level;
    Int_t fNmany;                 //! number of overlapping nodes on current branch
@@ -84,6 +88,11 @@ private:
    TString fPath;                //! path to current node
 
    static Bool_t fgUsePWSafetyCaching; //! global mode is caching enabled for parallel world safety calls
+   static Bool_t fgUseSafetyCaching;   //! global mode is reusing the last safety sphere enabled
+   static Bool_t fgUseBVHSafetyBounds; //! global mode are bounding box distances used as daughter safeties
+
+   Double_t ComputeSafety(Bool_t inside);
+   Bool_t IsSafetySphereValid() const;
 
 public:
    TGeoNavigator();
@@ -108,6 +117,8 @@ public:
    TGeoNode *FindNextBoundary(Double_t stepmax = TGeoShape::Big(), const char *path = "", Bool_t frombdr = kFALSE);
    TGeoNode *FindNextDaughterBoundary(Double_t *point, Double_t *dir, Int_t &idaughter, Bool_t compmatrix = kFALSE);
    TGeoNode *FindNextBoundaryAndStep(Double_t stepmax = TGeoShape::Big(), Bool_t compsafe = kFALSE);
+   void FindNextBoundary_v(Int_t ntracks, const Double_t *points, const Double_t *dirs, Double_t *steps, Int_t *inext,
+                           Double_t stepmax = TGeoShape::Big());
    TGeoNode *FindNode(Bool_t safe_start = kTRUE);
    TGeoNode *FindNode(Double_t x, Double_t y, Double_t z);
    Double_t *FindNormal(Bool_t forward = kTRUE);
@@ -117,6 +128,7 @@ public:
    void ResetState();
    void ResetAll();
    Double_t Safety(Bool_t inside = kFALSE);
+   void Safety_v(Int_t ntracks, const Double_t *points, Double_t *safe);
    TGeoNode *SearchNode(Bool_t downwards = kFALSE, const TGeoNode *skipnode = nullptr);
    TGeoNode *Step(Bool_t is_geom = kTRUE, Bool_t cross = kTRUE);
    const Double_t *GetLastPoint() const { return fLastPoint; }
@@ -231,6 +243,14 @@ public:
    static void SetPWSafetyCaching(Bool_t b) { fgUsePWSafetyCaching = b; }
    static Bool_t IsPWSafetyCaching() { return fgUsePWSafetyCaching; }
 
+   // enable/disable the reuse of the last safety sphere by Safety()
+   static void SetSafetyCaching(Bool_t b) { fgUseSafetyCaching = b; }
+   static Bool_t IsSafetyCaching() { return fgUseSafetyCaching; }
+   // enable/disable lower bound daughter safeties from the BVH voxels
+   static void SetBVHSafetyBounds(Bool_t b) { fgUseBVHSafetyBounds = b; }
+   static Bool_t IsBVHSafetyBounds() { return fgUseBVHSafetyBounds; }
+   void ResetSafetyCache() { fSafetyRadius = -1; }
+
    //--- point/vector reference frame conversion
    void LocalToMaster(const Double_t *local, Double_t *master) const { fCache->LocalToMaster(local, master); }
    void LocalToMasterVect(const Double_t *local, Double_t *master) const { fCache->LocalToMasterVect(local, master); }
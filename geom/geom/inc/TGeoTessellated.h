@@ -12,6 +12,7 @@
 #ifndef ROOT_TGeoTessellated
 #define ROOT_TGeoTessellated
 
+#include <atomic>
 #include <map>
 #include "TGeoVector3.h"
 #include "TGeoTypedefs.h"
@@ -67,19 +68,33 @@ private:
    std::vector<Vertex_t> fVertices; // List of vertices
    std::vector<TGeoFacet> fFacets;  // List of facets
    std::multimap<long, int> fVerticesMap; //! Temporary map used to deduplicate vertices
+   mutable std::atomic<void *> fBVH{nullptr}; //! Bounding volume hierarchy of the facets, built on first use
 
    TGeoTessellated(const TGeoTessellated &) = delete;
    TGeoTessellated &operator=(const TGeoTessellated &) = delete;
 
+   void BuildBVH() const;
+   void DeleteBVH();
+   const void *GetBVH() const;
+   double DistToFacets(const double *point, const double *dir, int facing, int *itriangle = nullptr) const;
+   double SafetyToFacets(const double *point, int *itriangle = nullptr) const;
+
 public:
    // constructors
    TGeoTessellated() {}
    TGeoTessellated(const char *name, int nfacets = 0);
    TGeoTessellated(const char *name, const std::vector<Vertex_t> &vertices);
    // destructor
-   ~TGeoTessellated() override {}
+   ~TGeoTessellated() override;
 
    void ComputeBBox() override;
+   void ComputeNormal(const double *point, const double *dir, double *norm) override;
+   bool Contains(const double *point) const override;
+   double DistFromInside(const double *point, const double *dir, int iact = 1, double step = TGeoShape::Big(),
+                         double *safe = nullptr) const override;
+   double DistFromOutside(const double *point, const double *dir, int iact = 1, double step = TGeoShape::Big(),
+                          double *safe = nullptr) const override;
+   double Safety(const double *point, bool in = true) const override;
    void CloseShape(bool check = true, bool fixFlipped = true, bool verbose = true);
 
    bool AddFacet(const Vertex_t &pt0, const Vertex_t &pt1, const Vertex_t &pt2);
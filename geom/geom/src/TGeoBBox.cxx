@@ -1200,8 +1200,17 @@ void TGeoBBox::FillBuffer3D(TBuffer3D &buffer, Int_t reqSections, Bool_t localFr
 
 void TGeoBBox::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
 {
-   for (Int_t i = 0; i < vecsize; i++)
-      inside[i] = Contains(&points[3 * i]);
+   if (IsA() != TGeoBBox::Class()) {
+      for (Int_t i = 0; i < vecsize; i++)
+         inside[i] = Contains(&points[3 * i]);
+      return;
+   }
+   // branch-free loop which the compiler can vectorise
+   for (Int_t i = 0; i < vecsize; i++) {
+      const Double_t *point = &points[3 * i];
+      inside[i] = (TMath::Abs(point[0] - fOrigin[0]) <= fDX) & (TMath::Abs(point[1] - fOrigin[1]) <= fDY) &
+                  (TMath::Abs(point[2] - fOrigin[2]) <= fDZ);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1221,8 +1230,23 @@ void TGeoBBox::ComputeNormal_v(const Double_t *points, const Double_t *dirs, Dou
 void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize,
                                 Double_t *step) const
 {
-   for (Int_t i = 0; i < vecsize; i++)
-      dists[i] = DistFromInside(&points[3 * i], &dirs[3 * i], 3, step[i]);
+   if (IsA() != TGeoBBox::Class()) {
+      for (Int_t i = 0; i < vecsize; i++)
+         dists[i] = DistFromInside(&points[3 * i], &dirs[3 * i], 3, step[i]);
+      return;
+   }
+   // branch-free version of DistFromInside(), a negative distance on any axis means the point is outside
+   const Double_t half[3] = {fDX, fDY, fDZ};
+   for (Int_t i = 0; i < vecsize; i++) {
+      Double_t smin = TGeoShape::Big();
+      for (Int_t j = 0; j < 3; j++) {
+         Double_t d = dirs[3 * i + j];
+         Double_t p = points[3 * i + j] - fOrigin[j];
+         Double_t s = (d != 0) ? (TMath::Sign(half[j], d) - p) / d : TGeoShape::Big();
+         smin = TMath::Min(smin, s);
+      }
+      dists[i] = TMath::Max(smin, 0.);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1242,6 +1266,18 @@ void TGeoBBox::DistFromOutside_v(const Double_t *points, const Double_t *dirs, D
 
 void TGeoBBox::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
 {
-   for (Int_t i = 0; i < vecsize; i++)
-      safe[i] = Safety(&points[3 * i], inside[i]);
+   if (IsA() != TGeoBBox::Class()) {
+      for (Int_t i = 0; i < vecsize; i++)
+         safe[i] = Safety(&points[3 * i], inside[i]);
+      return;
+   }
+   // branch-free version of Safety(): the inside safety is the negated outside one
+   for (Int_t i = 0; i < vecsize; i++) {
+      const Double_t *point = &points[3 * i];
+      Double_t safx = TMath::Abs(point[0] - fOrigin[0]) - fDX;
+      Double_t safy = TMath::Abs(point[1] - fOrigin[1]) - fDY;
+      Double_t safz = TMath::Abs(point[2] - fOrigin[2]) - fDZ;
+      Double_t saf = TMath::Max(safx, TMath::Max(safy, safz));
+      safe[i] = inside[i] ? -saf : saf;
+   }
 }
@@ -0,0 +1,438 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoBVHVoxelFinder
+\ingroup Geometry_classes
+
+Voxel finder using a bounding volume hierarchy (BVH) of the bounding boxes
+of the daughters instead of the slices of TGeoVoxelFinder.
+
+The slice based voxelization becomes slow to build and large in memory for
+volumes with many daughters, for instance flat assemblies of calorimeter cells.
+The BVH is built in O(N log N), in parallel for large volumes, and queries for
+the daughters containing a point or crossed by a ray are logarithmic.
+
+The finder is used for volumes with at least the number of daughters set with
+TGeoManager::SetBVHVoxelsThreshold(), which must be called before closing the
+geometry. The BVH itself is not streamed, it is rebuilt on first use.
+*/
+
+#include "TGeoBVHVoxelFinder.h"
+
+#include "TGeoBBox.h"
+#include "TGeoManager.h"
+#include "TGeoNode.h"
+#include "TGeoStateInfo.h"
+#include "TGeoVolume.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <bvh/v2/bvh.h>
+#include <bvh/v2/vec.h>
+#include <bvh/v2/ray.h>
+#include <bvh/v2/node.h>
+#include <bvh/v2/stack.h>
+#include <bvh/v2/thread_pool.h>
+#include <bvh/v2/default_builder.h>
+
+ClassImp(TGeoBVHVoxelFinder);
+
+namespace {
+using Scalar = Double_t;
+using BBox = bvh::v2::BBox<Scalar, 3>;
+using Vec3 = bvh::v2::Vec<Scalar, 3>;
+using Ray = bvh::v2::Ray<Scalar, 3>;
+using Node = bvh::v2::Node<Scalar, 3>;
+using Bvh = bvh::v2::Bvh<Node>;
+
+// bounding boxes are enlarged by this amount to stay on the safe side, like the voxel limits
+constexpr Double_t kBoxTolerance = 1E-6;
+
+Double_t BoxMin(const Double_t *boxes, Int_t inode, Int_t i)
+{
+   return boxes[6 * inode + 3 + i] - boxes[6 * inode + i] - kBoxTolerance;
+}
+
+Double_t BoxMax(const Double_t *boxes, Int_t inode, Int_t i)
+{
+   return boxes[6 * inode + 3 + i] + boxes[6 * inode + i] + kBoxTolerance;
+}
+
+bool Contains(const BBox &box, const Double_t *point)
+{
+   return point[0] >= box.min[0] && point[0] <= box.max[0] && point[1] >= box.min[1] && point[1] <= box.max[1] &&
+          point[2] >= box.min[2] && point[2] <= box.max[2];
+}
+
+Double_t SquaredDistance(const BBox &box, const Double_t *point)
+{
+   Double_t d2 = 0.;
+   for (Int_t i = 0; i < 3; i++) {
+      Double_t d = std::max(box.min[i] - point[i], point[i] - box.max[i]);
+      if (d > 0)
+         d2 += d * d;
+   }
+   return d2;
+}
+
+bool Overlaps(const BBox &box1, const BBox &box2)
+{
+   for (Int_t i = 0; i < 3; i++) {
+      if (box1.max[i] < box2.min[i] || box2.max[i] < box1.min[i])
+         return false;
+   }
+   return true;
+}
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor
+
+TGeoBVHVoxelFinder::TGeoBVHVoxelFinder(TGeoVolume *vol) : TGeoVoxelFinder(vol) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+TGeoBVHVoxelFinder::~TGeoBVHVoxelFinder()
+{
+   DeleteBVH();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the hierarchy from the bounding boxes of the daughters. Volumes with
+/// many daughters are processed by a pool of threads.
+
+void TGeoBVHVoxelFinder::BuildBVH()
+{
+   DeleteBVH();
+   Int_t nd = fVolume->GetNdaughters();
+   if (!nd || !fBoxes)
+      return;
+   std::vector<BBox> bboxes(nd);
+   std::vector<Vec3> centers(nd);
+   for (Int_t id = 0; id < nd; id++) {
+      for (Int_t i = 0; i < 3; i++) {
+         bboxes[id].min[i] = BoxMin(fBoxes, id, i);
+         bboxes[id].max[i] = BoxMax(fBoxes, id, i);
+      }
+      centers[id] = bboxes[id].get_center();
+   }
+
+   typename bvh::v2::DefaultBuilder<Node>::Config config;
+   config.quality = bvh::v2::DefaultBuilder<Node>::Quality::High;
+   auto bvh = new Bvh;
+   if (bboxes.size() < config.parallel_threshold) {
+      *bvh = bvh::v2::DefaultBuilder<Node>::build(bboxes, centers, config);
+   } else {
+      bvh::v2::ThreadPool pool;
+      *bvh = bvh::v2::DefaultBuilder<Node>::build(pool, bboxes, centers, config);
+   }
+   fBVH = bvh;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the hierarchy.
+
+void TGeoBVHVoxelFinder::DeleteBVH()
+{
+   delete (Bvh *)fBVH;
+   fBVH = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure the boxes and the hierarchy are up to date.
+
+void TGeoBVHVoxelFinder::CheckBVH()
+{
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   } else if (!fBVH) {
+      // retrieved from file
+      BuildBVH();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Distance along the ray to the enlarged bounding box of daughter INODE,
+/// 0 if the point is inside and TGeoShape::Big() if the box is missed.
+
+Double_t TGeoBVHVoxelFinder::DistToBox(Int_t inode, const Double_t *point, const Double_t *invdir) const
+{
+   Double_t tnear = 0.;
+   Double_t tfar = TGeoShape::Big();
+   for (Int_t i = 0; i < 3; i++) {
+      Double_t t1 = (BoxMin(fBoxes, inode, i) - point[i]) * invdir[i];
+      Double_t t2 = (BoxMax(fBoxes, inode, i) - point[i]) * invdir[i];
+      if (t1 > t2)
+         std::swap(t1, t2);
+      // NaN for a null direction component and a point on the box face: the slab does not constrain the ray
+      if (t1 > tnear)
+         tnear = t1;
+      if (t2 < tfar)
+         tfar = t2;
+      if (tnear > tfar)
+         return TGeoShape::Big();
+   }
+   return tnear;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Ratio between the number of leaves and the number of daughters.
+
+Double_t TGeoBVHVoxelFinder::Efficiency()
+{
+   printf("Voxelization efficiency for %s\n", fVolume->GetName());
+   CheckBVH();
+   auto bvh = (Bvh *)fBVH;
+   if (!bvh)
+      return 0.;
+   Int_t nleaves = 0;
+   for (const auto &node : bvh->nodes) {
+      if (node.is_leaf())
+         nleaves++;
+   }
+   Double_t eff = Double_t(nleaves) / fVolume->GetNdaughters();
+   printf("Total efficiency : %g\n", eff);
+   return eff;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the list of nodes for which the bboxes overlap with inode's bbox.
+
+void TGeoBVHVoxelFinder::FindOverlaps(Int_t inode) const
+{
+   auto bvh = (Bvh *)fBVH;
+   if (!bvh) {
+      TGeoVoxelFinder::FindOverlaps(inode);
+      return;
+   }
+   BBox box;
+   for (Int_t i = 0; i < 3; i++) {
+      // strict overlaps, as in TGeoVoxelFinder::FindOverlaps()
+      box.min[i] = BoxMin(fBoxes, inode, i) + 2 * kBoxTolerance;
+      box.max[i] = BoxMax(fBoxes, inode, i) - 2 * kBoxTolerance;
+   }
+   std::vector<Int_t> ovlps;
+   bvh::v2::GrowingStack<Bvh::Index> stack;
+   bvh->traverse_top_down<false>(
+      bvh->get_root().index, stack,
+      [&](size_t begin, size_t end) {
+         for (size_t prim_id = begin; prim_id < end; ++prim_id) {
+            Int_t id = bvh->prim_ids[prim_id];
+            if (id != inode) {
+               BBox other;
+               for (Int_t i = 0; i < 3; i++) {
+                  other.min[i] = BoxMin(fBoxes, id, i) + kBoxTolerance;
+                  other.max[i] = BoxMax(fBoxes, id, i) - kBoxTolerance;
+               }
+               if (Overlaps(other, box))
+                  ovlps.push_back(id);
+            }
+         }
+         return false;
+      },
+      [&](const Node &left, const Node &right) {
+         return std::make_tuple(Overlaps(left.get_bbox(), box), Overlaps(right.get_bbox(), box), false);
+      });
+   TGeoNode *node = fVolume->GetNode(inode);
+   if (ovlps.empty()) {
+      node->SetOverlaps(nullptr, 0);
+      return;
+   }
+   std::sort(ovlps.begin(), ovlps.end());
+   Int_t *list = new Int_t[ovlps.size()];
+   std::copy(ovlps.begin(), ovlps.end(), list);
+   node->SetOverlaps(list, ovlps.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the list of daughter indices whose bounding box contains the point,
+/// in increasing order. Returns nullptr if there is none.
+
+Int_t *TGeoBVHVoxelFinder::GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td)
+{
+   CheckBVH();
+   nelem = 0;
+   auto bvh = (Bvh *)fBVH;
+   if (!bvh || !Contains(bvh->get_root().get_bbox(), point))
+      return nullptr;
+   bvh::v2::GrowingStack<Bvh::Index> stack;
+   bvh->traverse_top_down<false>(
+      bvh->get_root().index, stack,
+      [&](size_t begin, size_t end) {
+         for (size_t prim_id = begin; prim_id < end; ++prim_id) {
+            Int_t id = bvh->prim_ids[prim_id];
+            Bool_t inside = kTRUE;
+            for (Int_t i = 0; inside && i < 3; i++)
+               inside = point[i] >= BoxMin(fBoxes, id, i) && point[i] <= BoxMax(fBoxes, id, i);
+            if (inside)
+               td.fVoxCheckList[nelem++] = id;
+         }
+         return false;
+      },
+      [&](const Node &left, const Node &right) {
+         return std::make_tuple(Contains(left.get_bbox(), point), Contains(right.get_bbox(), point), false);
+      });
+   td.fVoxNcandidates = nelem;
+   if (!nelem)
+      return nullptr;
+   std::sort(td.fVoxCheckList, td.fVoxCheckList + nelem);
+   return td.fVoxCheckList;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// All candidates are returned by GetNextVoxel(), there are no further voxels.
+
+Int_t *TGeoBVHVoxelFinder::GetNextCandidates(const Double_t * /*point*/, Int_t &ncheck, TGeoStateInfo & /*td*/)
+{
+   ncheck = 0;
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the next daughter crossed by the ray prepared by SortCrossedVoxels(),
+/// in the order in which the ray enters their bounding boxes. Returns nullptr
+/// once the next bounding box is farther than the current step.
+
+Int_t *TGeoBVHVoxelFinder::GetNextVoxel(const Double_t *point, const Double_t * /*dir*/, Int_t &ncheck,
+                                         TGeoStateInfo &td)
+{
+   ncheck = 0;
+   if (td.fVoxCurrent >= td.fVoxNcandidates)
+      return nullptr;
+   Int_t *next = &td.fVoxCheckList[td.fVoxCurrent];
+   if (DistToBox(*next, point, td.fVoxInvdir) > gGeoManager->GetStep()) {
+      td.fVoxCurrent = td.fVoxNcandidates;
+      return nullptr;
+   }
+   td.fVoxCurrent++;
+   ncheck = 1;
+   return next;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the hierarchy statistics.
+
+void TGeoBVHVoxelFinder::Print(Option_t *) const
+{
+   const_cast<TGeoBVHVoxelFinder *>(this)->CheckBVH();
+   auto bvh = (Bvh *)fBVH;
+   printf("BVH voxels for volume %s (nd=%i)\n", fVolume->GetName(), fVolume->GetNdaughters());
+   if (!bvh)
+      return;
+   Int_t nleaves = 0;
+   for (const auto &node : bvh->nodes) {
+      if (node.is_leaf())
+         nleaves++;
+   }
+   printf("   %zu nodes, %i leaves\n", bvh->nodes.size(), nleaves);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the safe distance from POINT, in the frame of the volume, to the
+/// daughters, but not larger than SAFMAX. The daughters are visited by increasing
+/// distance of the BVH nodes and those whose bounding box is farther than the
+/// current safety are skipped. With BOXBOUNDS, the distance to the bounding box
+/// of a daughter not containing the point is taken as its safety, which gives a
+/// cheaper lower bound.
+
+Double_t TGeoBVHVoxelFinder::Safety(const Double_t *point, Double_t safmax, Bool_t boxbounds)
+{
+   CheckBVH();
+   Double_t safe = safmax;
+   auto bvh = (Bvh *)fBVH;
+   if (!bvh)
+      return safe;
+   bvh::v2::GrowingStack<Bvh::Index> stack;
+   bvh->traverse_top_down<false>(
+      bvh->get_root().index, stack,
+      [&](size_t begin, size_t end) {
+         for (size_t prim_id = begin; prim_id < end; ++prim_id) {
+            Int_t id = bvh->prim_ids[prim_id];
+            BBox box;
+            for (Int_t i = 0; i < 3; i++) {
+               box.min[i] = BoxMin(fBoxes, id, i);
+               box.max[i] = BoxMax(fBoxes, id, i);
+            }
+            const Double_t d2 = SquaredDistance(box, point);
+            if (d2 >= safe * safe)
+               continue;
+            const Double_t dsafe = (boxbounds && d2 > 0) ? std::sqrt(d2) : fVolume->GetNode(id)->Safety(point, kFALSE);
+            if (dsafe < safe)
+               safe = dsafe;
+         }
+         return false;
+      },
+      [&](const Node &left, const Node &right) {
+         const Double_t d2left = SquaredDistance(left.get_bbox(), point);
+         const Double_t d2right = SquaredDistance(right.get_bbox(), point);
+         const Double_t safe2 = safe * safe;
+         return std::make_tuple(d2left < safe2, d2right < safe2, d2right < d2left);
+      });
+   return safe;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the daughters whose bounding box is crossed by the ray starting at
+/// POINT along DIR and sort them by the distance to their bounding box.
+
+void TGeoBVHVoxelFinder::SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td)
+{
+   CheckBVH();
+   td.fVoxCurrent = 0;
+   td.fVoxNcandidates = 0;
+   auto bvh = (Bvh *)fBVH;
+   if (!bvh)
+      return;
+   for (Int_t i = 0; i < 3; i++)
+      td.fVoxInvdir[i] = 1. / dir[i];
+
+   // per thread scratch space, the navigation is called once per step
+   thread_local std::vector<std::pair<Double_t, Int_t>> crossed;
+   crossed.clear();
+   Ray ray(Vec3(point[0], point[1], point[2]), Vec3(dir[0], dir[1], dir[2]), 0., TGeoShape::Big());
+   bvh::v2::GrowingStack<Bvh::Index> stack;
+   bvh->intersect<false, true>(ray, bvh->get_root().index, stack, [&](size_t begin, size_t end) {
+      for (size_t prim_id = begin; prim_id < end; ++prim_id) {
+         Int_t id = bvh->prim_ids[prim_id];
+         Double_t dist = DistToBox(id, point, td.fVoxInvdir);
+         if (dist < TGeoShape::Big())
+            crossed.emplace_back(dist, id);
+      }
+      return false;
+   });
+   std::sort(crossed.begin(), crossed.end());
+   for (const auto &c : crossed)
+      td.fVoxCheckList[td.fVoxNcandidates++] = c.second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the bounding boxes of the daughters and build the hierarchy.
+/// If the volume is an assembly, make sure the bbox is computed.
+
+void TGeoBVHVoxelFinder::Voxelize(Option_t * /*option*/)
+{
+   if (fVolume->IsAssembly())
+      fVolume->GetShape()->ComputeBBox();
+   Int_t nd = fVolume->GetNdaughters();
+   TGeoVolume *vd;
+   for (Int_t i = 0; i < nd; i++) {
+      vd = fVolume->GetNode(i)->GetVolume();
+      if (vd->IsAssembly())
+         vd->GetShape()->ComputeBBox();
+   }
+   BuildVoxelLimits();
+   BuildBVH();
+   SetNeedRebuild(kFALSE);
+}
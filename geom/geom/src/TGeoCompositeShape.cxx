@@ -177,14 +177,31 @@ Composite shapes can be subsequently used for defining volumes.
 Moreover, these volumes contain other volumes, following the general
 criteria. Volumes created based on composite shapes cannot be divided.
 
+#### Flattened evaluation
+
+Contains() does not walk the tree of Boolean nodes. On first use, the tree is
+flattened together with the trees of the composite components into an array of
+operations, in which each primitive carries its transformation with respect to
+the composite frame. The primitives placed with the same transformation share
+the transformed point. Each operation has a bounding box in the composite frame,
+so that whole branches are rejected without calling the primitives. Optionally,
+a regular grid of TGeoCompositeShape::SetLookupTableBins() bins per axis
+classifies the space of the bounding box as fully inside, fully outside or on
+the boundary of the composite, answering most queries with a table lookup.
+
 */
 
 #include <iostream>
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <vector>
 #include "TRandom3.h"
 
 #include "TGeoManager.h"
 #include "TGeoMatrix.h"
 #include "TGeoBoolNode.h"
+#include "TMath.h"
 
 #include "TVirtualPad.h"
 #include "TVirtualViewer3D.h"
@@ -194,6 +211,193 @@ criteria. Volumes created based on composite shapes cannot be divided.
 #include "TGeoCompositeShape.h"
 ClassImp(TGeoCompositeShape);
 
+Int_t TGeoCompositeShape::fgLookupBins = 0;
+
+namespace {
+/// Flattened Boolean tree. The operations are stored in pre-order: the left operand of an
+/// operation follows it and the index of the right operand is stored.
+struct CompiledComposite {
+   enum EOpType { kLeaf, kUnion, kIntersection, kSubtraction };
+   enum ECellState : char { kMixed = 0, kInside = 1, kOutside = 2 };
+   struct Op {
+      EOpType fType = kLeaf;
+      Int_t fRight = -1;                // index of the right operand
+      const TGeoShape *fShape = nullptr; // primitive of a leaf
+      Int_t fTransform = -1;            // transformation of a leaf, -1 for identity
+      Bool_t fBounded = kTRUE;          // the bounding box is meaningful
+      Double_t fMin[3] = {0, 0, 0};     // bounding box in the composite frame
+      Double_t fMax[3] = {0, 0, 0};
+   };
+   std::vector<Op> fOps;
+   std::vector<std::array<Double_t, 12>> fTransforms; // rotation and translation
+   // lookup table
+   Int_t fNbins = 0;
+   Double_t fMin[3] = {0, 0, 0};
+   Double_t fWidth[3] = {0, 0, 0};
+   std::vector<char> fTable;
+};
+
+std::mutex gCompileMutex;
+
+void MasterToLocal(const std::array<Double_t, 12> &tr, const Double_t *master, Double_t *local)
+{
+   const Double_t mt0 = master[0] - tr[9];
+   const Double_t mt1 = master[1] - tr[10];
+   const Double_t mt2 = master[2] - tr[11];
+   local[0] = mt0 * tr[0] + mt1 * tr[3] + mt2 * tr[6];
+   local[1] = mt0 * tr[1] + mt1 * tr[4] + mt2 * tr[7];
+   local[2] = mt0 * tr[2] + mt1 * tr[5] + mt2 * tr[8];
+}
+
+/// Append the operations of SHAPE placed with MATRIX in the composite frame
+Int_t Compile(CompiledComposite &cc, const TGeoShape *shape, const TGeoHMatrix &matrix)
+{
+   using CC = CompiledComposite;
+   const Int_t iop = cc.fOps.size();
+   cc.fOps.emplace_back();
+   if (shape->IsComposite() && ((const TGeoCompositeShape *)shape)->GetBoolNode()) {
+      TGeoBoolNode *node = ((const TGeoCompositeShape *)shape)->GetBoolNode();
+      TGeoHMatrix left = matrix * TGeoHMatrix(*node->GetLeftMatrix());
+      TGeoHMatrix right = matrix * TGeoHMatrix(*node->GetRightMatrix());
+      Compile(cc, node->GetLeftShape(), left);
+      const Int_t iright = Compile(cc, node->GetRightShape(), right);
+      CC::Op &op = cc.fOps[iop];
+      op.fRight = iright;
+      const CC::Op &lop = cc.fOps[iop + 1];
+      const CC::Op &rop = cc.fOps[iright];
+      switch (node->GetBooleanOperator()) {
+      case TGeoBoolNode::kGeoUnion: op.fType = CC::kUnion; break;
+      case TGeoBoolNode::kGeoIntersection: op.fType = CC::kIntersection; break;
+      case TGeoBoolNode::kGeoSubtraction: op.fType = CC::kSubtraction; break;
+      }
+      if (op.fType == CC::kSubtraction || (op.fType == CC::kIntersection && !rop.fBounded)) {
+         op.fBounded = lop.fBounded;
+         std::copy(lop.fMin, lop.fMin + 3, op.fMin);
+         std::copy(lop.fMax, lop.fMax + 3, op.fMax);
+      } else if (op.fType == CC::kIntersection && !lop.fBounded) {
+         op.fBounded = rop.fBounded;
+         std::copy(rop.fMin, rop.fMin + 3, op.fMin);
+         std::copy(rop.fMax, rop.fMax + 3, op.fMax);
+      } else {
+         op.fBounded = lop.fBounded && rop.fBounded;
+         for (Int_t i = 0; i < 3; i++) {
+            if (op.fType == CC::kUnion) {
+               op.fMin[i] = std::min(lop.fMin[i], rop.fMin[i]);
+               op.fMax[i] = std::max(lop.fMax[i], rop.fMax[i]);
+            } else {
+               op.fMin[i] = std::max(lop.fMin[i], rop.fMin[i]);
+               op.fMax[i] = std::min(lop.fMax[i], rop.fMax[i]);
+            }
+         }
+      }
+      return iop;
+   }
+
+   CC::Op &op = cc.fOps[iop];
+   op.fType = CC::kLeaf;
+   op.fShape = shape;
+   std::array<Double_t, 12> tr;
+   std::copy(matrix.GetRotationMatrix(), matrix.GetRotationMatrix() + 9, tr.begin());
+   std::copy(matrix.GetTranslation(), matrix.GetTranslation() + 3, tr.begin() + 9);
+   if (!matrix.IsIdentity()) {
+      // primitives placed with the same transformation share the transformed point
+      auto it = std::find(cc.fTransforms.begin(), cc.fTransforms.end(), tr);
+      op.fTransform = it - cc.fTransforms.begin();
+      if (it == cc.fTransforms.end())
+         cc.fTransforms.push_back(tr);
+   }
+   // bounding box of the primitive in the composite frame
+   op.fBounded = !shape->TestShapeBit(TGeoShape::kGeoHalfSpace);
+   const TGeoBBox *box = (const TGeoBBox *)shape;
+   const Double_t half[3] = {box->GetDX(), box->GetDY(), box->GetDZ()};
+   const Double_t *origin = box->GetOrigin();
+   for (Int_t i = 0; i < 3; i++) {
+      Double_t dd = TGeoShape::Tolerance();
+      Double_t oo = tr[9 + i];
+      for (Int_t j = 0; j < 3; j++) {
+         dd += TMath::Abs(tr[3 * i + j]) * half[j];
+         oo += tr[3 * i + j] * origin[j];
+      }
+      op.fMin[i] = oo - dd;
+      op.fMax[i] = oo + dd;
+   }
+   return iop;
+}
+
+/// Inside test of the operation IOP. LOCALS holds the transformed points, computed
+/// when first needed as flagged in DONE.
+Bool_t Evaluate(const CompiledComposite &cc, Int_t iop, const Double_t *point, Double_t *locals, char *done)
+{
+   using CC = CompiledComposite;
+   const CC::Op &op = cc.fOps[iop];
+   if (op.fBounded && (point[0] < op.fMin[0] || point[0] > op.fMax[0] || point[1] < op.fMin[1] ||
+                       point[1] > op.fMax[1] || point[2] < op.fMin[2] || point[2] > op.fMax[2]))
+      return kFALSE;
+   switch (op.fType) {
+   case CC::kLeaf: {
+      if (op.fTransform < 0)
+         return op.fShape->Contains(point);
+      Double_t *local = &locals[3 * op.fTransform];
+      if (!done[op.fTransform]) {
+         MasterToLocal(cc.fTransforms[op.fTransform], point, local);
+         done[op.fTransform] = 1;
+      }
+      return op.fShape->Contains(local);
+   }
+   case CC::kUnion:
+      return Evaluate(cc, iop + 1, point, locals, done) || Evaluate(cc, op.fRight, point, locals, done);
+   case CC::kIntersection:
+      return Evaluate(cc, iop + 1, point, locals, done) && Evaluate(cc, op.fRight, point, locals, done);
+   case CC::kSubtraction:
+      return Evaluate(cc, iop + 1, point, locals, done) && !Evaluate(cc, op.fRight, point, locals, done);
+   }
+   return kFALSE;
+}
+
+/// Classify the cell centered in POINT with half diagonal RADIUS with respect to the operation IOP
+char Classify(const CompiledComposite &cc, Int_t iop, const Double_t *point, Double_t radius)
+{
+   using CC = CompiledComposite;
+   const CC::Op &op = cc.fOps[iop];
+   if (op.fBounded) {
+      for (Int_t i = 0; i < 3; i++) {
+         if (point[i] + radius < op.fMin[i] || point[i] - radius > op.fMax[i])
+            return CC::kOutside;
+      }
+   }
+   if (op.fType == CC::kLeaf) {
+      Double_t local[3];
+      if (op.fTransform < 0)
+         std::copy(point, point + 3, local);
+      else
+         MasterToLocal(cc.fTransforms[op.fTransform], point, local);
+      const Bool_t inside = op.fShape->Contains(local);
+      // the safety is an underestimate of the distance to the surface
+      if (op.fShape->Safety(local, inside) < radius)
+         return CC::kMixed;
+      return inside ? CC::kInside : CC::kOutside;
+   }
+   const char left = Classify(cc, iop + 1, point, radius);
+   const char right = Classify(cc, op.fRight, point, radius);
+   switch (op.fType) {
+   case CC::kUnion:
+      if (left == CC::kInside || right == CC::kInside)
+         return CC::kInside;
+      return (left == CC::kOutside && right == CC::kOutside) ? CC::kOutside : CC::kMixed;
+   case CC::kIntersection:
+      if (left == CC::kOutside || right == CC::kOutside)
+         return CC::kOutside;
+      return (left == CC::kInside && right == CC::kInside) ? CC::kInside : CC::kMixed;
+   case CC::kSubtraction:
+      if (left == CC::kOutside || right == CC::kInside)
+         return CC::kOutside;
+      return (left == CC::kInside && right == CC::kOutside) ? CC::kInside : CC::kMixed;
+   default: break;
+   }
+   return CC::kMixed;
+}
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Needed just for cleanup.
 
@@ -272,6 +476,7 @@ TGeoCompositeShape::TGeoCompositeShape(const char *name, TGeoBoolNode *node) : T
 
 TGeoCompositeShape::~TGeoCompositeShape()
 {
+   DeleteCompiled();
    if (fNode)
       delete fNode;
 }
@@ -304,6 +509,8 @@ Double_t TGeoCompositeShape::Capacity() const
 
 void TGeoCompositeShape::ComputeBBox()
 {
+   // the components may have changed, the flattened tree is rebuilt on next use
+   DeleteCompiled();
    if (fNode)
       fNode->ComputeBBox(fDX, fDY, fDZ, fOrigin);
 }
@@ -322,9 +529,102 @@ void TGeoCompositeShape::ComputeNormal(const Double_t *point, const Double_t *di
 
 Bool_t TGeoCompositeShape::Contains(const Double_t *point) const
 {
-   if (fNode)
-      return fNode->Contains(point);
-   return kFALSE;
+   const auto cc = (const CompiledComposite *)GetCompiled();
+   if (!cc)
+      return kFALSE;
+   if (cc->fNbins) {
+      Int_t index = 0;
+      for (Int_t i = 0; i < 3; i++) {
+         Int_t bin = (Int_t)((point[i] - cc->fMin[i]) / cc->fWidth[i]);
+         if (point[i] < cc->fMin[i] || bin >= cc->fNbins)
+            return kFALSE;
+         index = index * cc->fNbins + bin;
+      }
+      if (cc->fTable[index] != CompiledComposite::kMixed)
+         return cc->fTable[index] == CompiledComposite::kInside;
+   }
+   // transformed points, shared by the primitives having the same transformation
+   constexpr Int_t kMaxStack = 32;
+   const Int_t ntr = cc->fTransforms.size();
+   if (ntr <= kMaxStack) {
+      Double_t locals[3 * kMaxStack];
+      char done[kMaxStack] = {0};
+      return Evaluate(*cc, 0, point, locals, done);
+   }
+   std::vector<Double_t> locals(3 * ntr);
+   std::vector<char> done(ntr, 0);
+   return Evaluate(*cc, 0, point, locals.data(), done.data());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the flattened Boolean tree, building it on first use.
+
+const void *TGeoCompositeShape::GetCompiled() const
+{
+   void *compiled = fCompiled.load(std::memory_order_acquire);
+   if (compiled || !fNode)
+      return compiled;
+   std::lock_guard<std::mutex> lock(gCompileMutex);
+   compiled = fCompiled.load(std::memory_order_acquire);
+   if (compiled)
+      return compiled;
+   auto cc = new CompiledComposite;
+   Compile(*cc, this, TGeoHMatrix());
+   const Int_t nbins = fgLookupBins;
+   if (nbins > 0) {
+      Double_t radius2 = 0.;
+      const Double_t half[3] = {fDX, fDY, fDZ};
+      for (Int_t i = 0; i < 3; i++) {
+         cc->fMin[i] = fOrigin[i] - half[i];
+         cc->fWidth[i] = 2. * half[i] / nbins;
+         radius2 += 0.25 * cc->fWidth[i] * cc->fWidth[i];
+      }
+      const Double_t radius = TMath::Sqrt(radius2);
+      cc->fTable.resize(nbins * nbins * nbins);
+      Double_t center[3];
+      Int_t index = 0;
+      for (Int_t ix = 0; ix < nbins; ix++) {
+         center[0] = cc->fMin[0] + (ix + 0.5) * cc->fWidth[0];
+         for (Int_t iy = 0; iy < nbins; iy++) {
+            center[1] = cc->fMin[1] + (iy + 0.5) * cc->fWidth[1];
+            for (Int_t iz = 0; iz < nbins; iz++) {
+               center[2] = cc->fMin[2] + (iz + 0.5) * cc->fWidth[2];
+               cc->fTable[index++] = Classify(*cc, 0, center, radius);
+            }
+         }
+      }
+      cc->fNbins = nbins;
+   }
+   fCompiled.store(cc, std::memory_order_release);
+   return cc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the flattened Boolean tree.
+
+void TGeoCompositeShape::DeleteCompiled()
+{
+   delete (CompiledComposite *)fCompiled.exchange(nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of bins per axis of the inside/outside lookup table of composite shapes.
+
+Int_t TGeoCompositeShape::GetLookupTableBins()
+{
+   return fgLookupBins;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of bins per axis of the lookup table classifying the bounding box
+/// of composite shapes in cells fully inside, fully outside or crossed by the surface.
+/// The table is built on first use of a shape, with NBINS^3 cells, and speeds up
+/// Contains() for large composites. The default 0 disables the table. Only affects
+/// the shapes used for the first time after the call.
+
+void TGeoCompositeShape::SetLookupTableBins(Int_t nbins)
+{
+   fgLookupBins = TMath::Max(nbins, 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -399,6 +699,7 @@ void TGeoCompositeShape::InspectShape() const
 
 void TGeoCompositeShape::MakeNode(const char *expression)
 {
+   DeleteCompiled();
    if (fNode)
       delete fNode;
    fNode = nullptr;
@@ -0,0 +1,223 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoFlatGeometry
+\ingroup Geometry_classes
+
+Flat, read-only representation of a closed geometry for navigation.
+
+The node/volume/matrix object graph is exported into contiguous arrays:
+  - the logical volumes, each referring to a contiguous range of daughter placements;
+  - the placements, with the index of the placed volume;
+  - the local transforms of the placements as structure of arrays (SoA), in
+    double and single precision: component k of the transform of placement i is
+    GetTransforms(k)[i], with k = 0..8 for the rotation matrix and k = 9..11 for
+    the translation;
+  - the bounding boxes of the placements in the frame of their mother, also SoA;
+  - the touchables of the upper levels of the tree, which are visited by most
+    tracks, with their precomputed global transforms.
+
+The arrays only hold plain numbers and indices, so they can be copied as they are
+to other memory spaces such as GPUs. The shapes are still the original TGeoShape
+objects. TGeoFlatNavigator navigates on this structure.
+
+Overlapping (MANY) nodes are treated as non-overlapping and scaling
+transformations are not supported.
+*/
+
+#include "TGeoFlatGeometry.h"
+
+#include "TError.h"
+#include "TGeoBBox.h"
+#include "TGeoManager.h"
+#include "TGeoMatrix.h"
+#include "TGeoNode.h"
+#include "TGeoVolume.h"
+#include "TMath.h"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Export the closed geometry GEOM. The global transforms are precomputed for the
+/// touchables up to TOUCHABLEDEPTH levels below the top volume, as long as their
+/// number does not exceed MAXTOUCHABLES.
+
+TGeoFlatGeometry::TGeoFlatGeometry(const TGeoManager *geom, Int_t touchableDepth, Int_t maxTouchables)
+{
+   if (!geom || !geom->IsClosed()) {
+      ::Error("TGeoFlatGeometry", "The geometry must be closed before being exported");
+      return;
+   }
+   fTopNode = geom->GetTopNode();
+   // number the volumes breadth first, the daughters of each volume are appended in order
+   std::unordered_map<const TGeoVolume *, Int_t> indices;
+   std::vector<const TGeoVolume *> order{geom->GetTopVolume()};
+   indices[order[0]] = 0;
+   Bool_t scaled = kFALSE;
+   for (std::size_t iv = 0; iv < order.size(); iv++) {
+      const TGeoVolume *vol = order[iv];
+      Volume v;
+      v.fVolume = vol;
+      v.fShape = vol->GetShape();
+      v.fFirstDaughter = fPlacements.size();
+      v.fNdaughters = vol->GetNdaughters();
+      v.fAssembly = vol->IsAssembly();
+      for (Int_t id = 0; id < v.fNdaughters; id++) {
+         const TGeoNode *node = vol->GetNode(id);
+         const TGeoVolume *dvol = node->GetVolume();
+         auto it = indices.find(dvol);
+         if (it == indices.end()) {
+            it = indices.emplace(dvol, order.size()).first;
+            order.push_back(dvol);
+         }
+         Placement p;
+         p.fNode = node;
+         p.fVolume = it->second;
+         fPlacements.push_back(p);
+
+         const TGeoMatrix *mat = node->GetMatrix();
+         scaled |= mat->IsScale();
+         const Double_t *rot = mat->GetRotationMatrix();
+         const Double_t *tr = mat->GetTranslation();
+         for (Int_t k = 0; k < 9; k++)
+            fTransforms[k].push_back(rot[k]);
+         for (Int_t k = 0; k < 3; k++)
+            fTransforms[9 + k].push_back(tr[k]);
+         // bounding box of the daughter in the mother frame
+         const TGeoBBox *box = (const TGeoBBox *)dvol->GetShape();
+         const Double_t half[3] = {box->GetDX(), box->GetDY(), box->GetDZ()};
+         const Double_t *origin = box->GetOrigin();
+         for (Int_t i = 0; i < 3; i++) {
+            Double_t dd = 0.;
+            Double_t oo = tr[i];
+            for (Int_t j = 0; j < 3; j++) {
+               dd += TMath::Abs(rot[3 * i + j]) * half[j];
+               oo += rot[3 * i + j] * origin[j];
+            }
+            fBoxes[i].push_back(dd);
+            fBoxes[3 + i].push_back(oo);
+         }
+      }
+      fVolumes.push_back(v);
+   }
+   if (scaled)
+      ::Warning("TGeoFlatGeometry", "Scaling transformations are not supported and are exported without scale");
+   for (Int_t k = 0; k < kNtransform; k++)
+      fTransformsF[k].assign(fTransforms[k].begin(), fTransforms[k].end());
+
+   // depth of the tree below each volume
+   std::vector<Int_t> depth(fVolumes.size(), -1);
+   std::function<Int_t(Int_t)> computeDepth = [&](Int_t iv) {
+      if (depth[iv] < 0) {
+         const Volume &v = fVolumes[iv];
+         depth[iv] = 0;
+         for (Int_t ip = v.fFirstDaughter; ip < v.fFirstDaughter + v.fNdaughters; ip++)
+            depth[iv] = std::max(depth[iv], computeDepth(fPlacements[ip].fVolume) + 1);
+      }
+      return depth[iv];
+   };
+   fMaxDepth = computeDepth(0);
+
+   ExpandTouchables(touchableDepth, maxTouchables);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the touchables breadth first down to MAXDEPTH levels, computing their
+/// global transforms.
+
+void TGeoFlatGeometry::ExpandTouchables(Int_t maxdepth, Int_t maxtouchables)
+{
+   Double_t global[kNtransform], local[kNtransform], result[kNtransform];
+   fTouchables.emplace_back();
+   std::vector<Int_t> levels{0};
+   const Double_t identity[kNtransform] = {1., 0., 0., 0., 1., 0., 0., 0., 1., 0., 0., 0.};
+   for (Int_t k = 0; k < kNtransform; k++)
+      fGlobalTransforms[k].push_back(identity[k]);
+   for (std::size_t it = 0; it < fTouchables.size(); it++) {
+      if (levels[it] >= maxdepth)
+         break;
+      Int_t ivol = fTouchables[it].fPlacement < 0 ? 0 : fPlacements[fTouchables[it].fPlacement].fVolume;
+      const Volume &v = fVolumes[ivol];
+      if (!v.fNdaughters)
+         continue;
+      if ((Int_t)fTouchables.size() + v.fNdaughters > maxtouchables)
+         break;
+      fTouchables[it].fFirstChild = fTouchables.size();
+      GetGlobalTransform(it, global);
+      for (Int_t ip = v.fFirstDaughter; ip < v.fFirstDaughter + v.fNdaughters; ip++) {
+         Touchable t;
+         t.fParent = it;
+         t.fPlacement = ip;
+         fTouchables.push_back(t);
+         levels.push_back(levels[it] + 1);
+         GetTransform(ip, local);
+         Multiply(global, local, result);
+         for (Int_t k = 0; k < kNtransform; k++)
+            fGlobalTransforms[k].push_back(result[k]);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the local transform of placement IPLACE into TR.
+
+void TGeoFlatGeometry::GetTransform(Int_t iplace, Double_t *tr) const
+{
+   for (Int_t k = 0; k < kNtransform; k++)
+      tr[k] = fTransforms[k][iplace];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the global transform of touchable ITOUCH into TR.
+
+void TGeoFlatGeometry::GetGlobalTransform(Int_t itouch, Double_t *tr) const
+{
+   for (Int_t k = 0; k < kNtransform; k++)
+      tr[k] = fGlobalTransforms[k][itouch];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert a point from the mother to the local frame of transform TR.
+
+void TGeoFlatGeometry::MasterToLocal(const Double_t *tr, const Double_t *master, Double_t *local)
+{
+   const Double_t mt0 = master[0] - tr[9];
+   const Double_t mt1 = master[1] - tr[10];
+   const Double_t mt2 = master[2] - tr[11];
+   local[0] = mt0 * tr[0] + mt1 * tr[3] + mt2 * tr[6];
+   local[1] = mt0 * tr[1] + mt1 * tr[4] + mt2 * tr[7];
+   local[2] = mt0 * tr[2] + mt1 * tr[5] + mt2 * tr[8];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert a direction from the mother to the local frame of transform TR.
+
+void TGeoFlatGeometry::MasterToLocalVect(const Double_t *tr, const Double_t *master, Double_t *local)
+{
+   local[0] = master[0] * tr[0] + master[1] * tr[3] + master[2] * tr[6];
+   local[1] = master[0] * tr[1] + master[1] * tr[4] + master[2] * tr[7];
+   local[2] = master[0] * tr[2] + master[1] * tr[5] + master[2] * tr[8];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compose the transforms: RESULT = LEFT * RIGHT, RIGHT being applied first.
+
+void TGeoFlatGeometry::Multiply(const Double_t *left, const Double_t *right, Double_t *result)
+{
+   for (Int_t i = 0; i < 3; i++) {
+      for (Int_t j = 0; j < 3; j++)
+         result[3 * i + j] =
+            left[3 * i] * right[j] + left[3 * i + 1] * right[3 + j] + left[3 * i + 2] * right[6 + j];
+      result[9 + i] =
+         left[3 * i] * right[9] + left[3 * i + 1] * right[10] + left[3 * i + 2] * right[11] + left[9 + i];
+   }
+}
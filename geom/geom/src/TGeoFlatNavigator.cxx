@@ -0,0 +1,303 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoFlatNavigator
+\ingroup Geometry_classes
+
+Navigator running on a TGeoFlatGeometry.
+
+The state is a stack of placement indices and global transforms, one entry per
+level, preallocated for the depth of the geometry. The global transforms of the
+upper levels are taken from the precomputed touchables of the flat geometry and
+only the deeper levels are composed on the fly. Daughters are prefiltered with
+their bounding boxes, stored contiguously for each mother volume.
+
+Unlike TGeoNavigator, the current point and direction are passed with each call,
+so that one navigator can be used per track or per thread with little state.
+
+~~~ {.cpp}
+TGeoFlatGeometry flat(gGeoManager);
+TGeoFlatNavigator nav(&flat);
+Double_t point[3] = {0, 0, 0}, dir[3] = {0, 0, 1};
+nav.FindNode(point);
+while (!nav.IsOutside())
+   nav.Step(point, dir);
+~~~
+*/
+
+#include "TGeoFlatNavigator.h"
+
+#include "TGeoNode.h"
+#include "TGeoShape.h"
+#include "TMath.h"
+
+static const Double_t gTolerance = TGeoShape::Tolerance();
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor. The navigator keeps a pointer to GEOM, which must outlive it.
+
+TGeoFlatNavigator::TGeoFlatNavigator(const TGeoFlatGeometry *geom) : fGeometry(geom)
+{
+   const Int_t nlevels = geom->GetMaxDepth() + 1;
+   fPlacements.assign(nlevels, -1);
+   fVolumes.assign(nlevels, 0);
+   fTouchables.assign(nlevels, -1);
+   fGlobal.assign(nlevels * TGeoFlatGeometry::kNtransform, 0.);
+   fTouchables[0] = 0;
+   fGeometry->GetGlobalTransform(0, fGlobal.data());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the current node, the top node at level 0.
+
+const TGeoNode *TGeoFlatNavigator::GetCurrentNode() const
+{
+   return fLevel ? fGeometry->GetPlacement(fPlacements[fLevel]).fNode : fGeometry->GetTopNode();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enter the daughter placement IPLACE of the current volume.
+
+void TGeoFlatNavigator::Push(Int_t iplace)
+{
+   const Int_t parent = fTouchables[fLevel];
+   const Int_t mother = fVolumes[fLevel];
+   fLevel++;
+   fPlacements[fLevel] = iplace;
+   fVolumes[fLevel] = fGeometry->GetPlacement(iplace).fVolume;
+   Double_t *global = &fGlobal[fLevel * TGeoFlatGeometry::kNtransform];
+   if (parent >= 0 && fGeometry->GetTouchable(parent).fFirstChild >= 0) {
+      // precomputed global transform
+      const Int_t itouch =
+         fGeometry->GetTouchable(parent).fFirstChild + iplace - fGeometry->GetVolume(mother).fFirstDaughter;
+      fTouchables[fLevel] = itouch;
+      fGeometry->GetGlobalTransform(itouch, global);
+   } else {
+      fTouchables[fLevel] = -1;
+      Double_t local[TGeoFlatGeometry::kNtransform];
+      fGeometry->GetTransform(iplace, local);
+      TGeoFlatGeometry::Multiply(GetGlobal(fLevel - 1), local, global);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enter the daughter of the current volume containing the global POINT.
+/// Assemblies are entered only if one of their components contains the point.
+/// Returns kFALSE if no daughter contains the point.
+
+Bool_t TGeoFlatNavigator::DescendOne(const Double_t *point)
+{
+   const TGeoFlatGeometry::Volume &vol = fGeometry->GetVolume(fVolumes[fLevel]);
+   if (!vol.fNdaughters)
+      return kFALSE;
+   Double_t local[3], dlocal[3], tr[TGeoFlatGeometry::kNtransform];
+   TGeoFlatGeometry::MasterToLocal(GetGlobal(fLevel), point, local);
+   const Double_t *bdx = fGeometry->GetBoxes(0);
+   const Double_t *bdy = fGeometry->GetBoxes(1);
+   const Double_t *bdz = fGeometry->GetBoxes(2);
+   const Double_t *box = fGeometry->GetBoxes(3);
+   const Double_t *boy = fGeometry->GetBoxes(4);
+   const Double_t *boz = fGeometry->GetBoxes(5);
+   for (Int_t ip = vol.fFirstDaughter; ip < vol.fFirstDaughter + vol.fNdaughters; ip++) {
+      if (TMath::Abs(local[0] - box[ip]) > bdx[ip] || TMath::Abs(local[1] - boy[ip]) > bdy[ip] ||
+          TMath::Abs(local[2] - boz[ip]) > bdz[ip])
+         continue;
+      const TGeoFlatGeometry::Volume &dvol = fGeometry->GetVolume(fGeometry->GetPlacement(ip).fVolume);
+      if (dvol.fAssembly) {
+         Push(ip);
+         if (DescendOne(point))
+            return kTRUE;
+         Pop();
+         continue;
+      }
+      fGeometry->GetTransform(ip, tr);
+      TGeoFlatGeometry::MasterToLocal(tr, local, dlocal);
+      if (dvol.fShape->Contains(dlocal)) {
+         Push(ip);
+         return kTRUE;
+      }
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Descend from the current level to the deepest node containing the global POINT.
+
+void TGeoFlatNavigator::LocateDown(const Double_t *point)
+{
+   while (DescendOne(point)) {
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Go up from the current level until a volume contains the global POINT, then
+/// descend to the deepest node containing it.
+
+void TGeoFlatNavigator::Relocate(const Double_t *point)
+{
+   Double_t local[3];
+   while (fLevel > 0) {
+      const TGeoFlatGeometry::Volume &vol = fGeometry->GetVolume(fVolumes[fLevel]);
+      TGeoFlatGeometry::MasterToLocal(GetGlobal(fLevel), point, local);
+      if (!vol.fAssembly && vol.fShape->Contains(local))
+         break;
+      Pop();
+   }
+   if (fLevel == 0) {
+      FindNode(point);
+      return;
+   }
+   LocateDown(point);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Locate the global POINT starting from the top volume. Returns kFALSE if the
+/// point is outside the geometry.
+
+Bool_t TGeoFlatNavigator::FindNode(const Double_t *point)
+{
+   fLevel = 0;
+   Double_t local[3];
+   TGeoFlatGeometry::MasterToLocal(GetGlobal(0), point, local);
+   fOutside = !fGeometry->GetVolume(0).fShape->Contains(local);
+   if (!fOutside)
+      LocateDown(point);
+   return !fOutside;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distance from the global POINT along DIR to the next boundary of
+/// the current state, limited to STEPMAX. INEXT is set to the index of the
+/// placement entered, or -1 if the current volume is exited or no boundary is
+/// crossed within STEPMAX. The state is not changed.
+
+Double_t TGeoFlatNavigator::FindNextBoundary(const Double_t *point, const Double_t *dir, Int_t &inext,
+                                             Double_t stepmax) const
+{
+   inext = -1;
+   Double_t local[3], ldir[3];
+   TGeoFlatGeometry::MasterToLocal(GetGlobal(fLevel), point, local);
+   TGeoFlatGeometry::MasterToLocalVect(GetGlobal(fLevel), dir, ldir);
+   const TGeoFlatGeometry::Volume &vol = fGeometry->GetVolume(fVolumes[fLevel]);
+   if (fOutside)
+      return TMath::Min(vol.fShape->DistFromOutside(local, ldir, 3, stepmax), stepmax);
+   Double_t snext = stepmax;
+   if (!vol.fAssembly)
+      snext = TMath::Max(0., TMath::Min(vol.fShape->DistFromInside(local, ldir, 3, stepmax), stepmax));
+   if (!vol.fNdaughters)
+      return snext;
+
+   Double_t dlocal[3], ddir[3], tr[TGeoFlatGeometry::kNtransform];
+   const Double_t *bd[3] = {fGeometry->GetBoxes(0), fGeometry->GetBoxes(1), fGeometry->GetBoxes(2)};
+   const Double_t *bo[3] = {fGeometry->GetBoxes(3), fGeometry->GetBoxes(4), fGeometry->GetBoxes(5)};
+   for (Int_t ip = vol.fFirstDaughter; ip < vol.fFirstDaughter + vol.fNdaughters; ip++) {
+      // slab test of the ray against the bounding box of the daughter
+      Double_t tnear = 0.;
+      Double_t tfar = snext + gTolerance;
+      for (Int_t j = 0; j < 3 && tnear <= tfar; j++) {
+         const Double_t lo = bo[j][ip] - bd[j][ip] - gTolerance - local[j];
+         const Double_t hi = bo[j][ip] + bd[j][ip] + gTolerance - local[j];
+         if (ldir[j] == 0.) {
+            if (lo > 0. || hi < 0.)
+               tnear = TGeoShape::Big();
+            continue;
+         }
+         const Double_t t1 = lo / ldir[j];
+         const Double_t t2 = hi / ldir[j];
+         tnear = TMath::Max(tnear, TMath::Min(t1, t2));
+         tfar = TMath::Min(tfar, TMath::Max(t1, t2));
+      }
+      if (tnear > tfar)
+         continue;
+      fGeometry->GetTransform(ip, tr);
+      TGeoFlatGeometry::MasterToLocal(tr, local, dlocal);
+      TGeoFlatGeometry::MasterToLocalVect(tr, ldir, ddir);
+      const TGeoShape *shape = fGeometry->GetVolume(fGeometry->GetPlacement(ip).fVolume).fShape;
+      const Double_t dist = shape->DistFromOutside(dlocal, ddir, 3, snext);
+      if (dist < snext) {
+         snext = dist;
+         inext = ip;
+      }
+   }
+   return snext;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Propagate the global POINT along DIR to the next boundary, but not further
+/// than STEPMAX, and update the state to the volume entered. POINT is moved to
+/// the boundary. Returns the step made.
+
+Double_t TGeoFlatNavigator::Step(Double_t *point, const Double_t *dir, Double_t stepmax)
+{
+   Int_t inext;
+   const Double_t step = FindNextBoundary(point, dir, inext, stepmax);
+   for (Int_t i = 0; i < 3; i++)
+      point[i] += step * dir[i];
+   if (fOutside) {
+      if (step < stepmax) {
+         const Double_t pushed[3] = {point[0] + gTolerance * dir[0], point[1] + gTolerance * dir[1],
+                                     point[2] + gTolerance * dir[2]};
+         FindNode(pushed);
+      }
+      return step;
+   }
+   if (inext < 0 && step >= stepmax)
+      return step;
+   // locate a point pushed just across the boundary
+   const Double_t pushed[3] = {point[0] + gTolerance * dir[0], point[1] + gTolerance * dir[1],
+                               point[2] + gTolerance * dir[2]};
+   if (inext >= 0) {
+      Push(inext);
+      if (fGeometry->GetVolume(fVolumes[fLevel]).fAssembly)
+         Relocate(pushed);
+      else
+         LocateDown(pushed);
+   } else {
+      if (fLevel == 0)
+         fOutside = kTRUE;
+      else
+         Relocate(pushed);
+   }
+   return step;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the safe distance from the global POINT to the boundaries of the
+/// current volume and of its daughters.
+
+Double_t TGeoFlatNavigator::Safety(const Double_t *point) const
+{
+   Double_t local[3];
+   TGeoFlatGeometry::MasterToLocal(GetGlobal(fLevel), point, local);
+   const TGeoFlatGeometry::Volume &vol = fGeometry->GetVolume(fVolumes[fLevel]);
+   if (fOutside)
+      return TMath::Max(0., vol.fShape->Safety(local, kFALSE));
+   Double_t safe = vol.fAssembly ? TGeoShape::Big() : TMath::Max(0., vol.fShape->Safety(local, kTRUE));
+
+   Double_t dlocal[3], tr[TGeoFlatGeometry::kNtransform];
+   const Double_t *bd[3] = {fGeometry->GetBoxes(0), fGeometry->GetBoxes(1), fGeometry->GetBoxes(2)};
+   const Double_t *bo[3] = {fGeometry->GetBoxes(3), fGeometry->GetBoxes(4), fGeometry->GetBoxes(5)};
+   for (Int_t ip = vol.fFirstDaughter; ip < vol.fFirstDaughter + vol.fNdaughters; ip++) {
+      // the distance to the bounding box is a lower limit of the safety
+      Double_t rsq = 0.;
+      for (Int_t j = 0; j < 3; j++) {
+         const Double_t d = TMath::Abs(local[j] - bo[j][ip]) - bd[j][ip];
+         if (d > 0.)
+            rsq += d * d;
+      }
+      if (rsq >= safe * safe)
+         continue;
+      fGeometry->GetTransform(ip, tr);
+      TGeoFlatGeometry::MasterToLocal(tr, local, dlocal);
+      const TGeoShape *shape = fGeometry->GetVolume(fGeometry->GetPlacement(ip).fVolume).fShape;
+      safe = TMath::Min(safe, TMath::Max(0., shape->Safety(dlocal, kFALSE)));
+   }
+   return safe;
+}
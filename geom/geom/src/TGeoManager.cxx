@@ -249,7 +249,6 @@ in order to enhance rays.
 #include "TKey.h"
 #include "THashList.h"
 #include "TClass.h"
-#include "ThreadLocalStorage.h"
 #include "TBufferText.h"
 
 #include "TGeoVoxelFinder.h"
@@ -286,6 +285,13 @@ in order to enhance rays.
 #include "TGDMLMatrix.h"
 #include "TGeoOpticalSurface.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 // statics and globals
 
 TGeoManager *gGeoManager = nullptr;
@@ -299,10 +305,12 @@ Int_t TGeoManager::fgVerboseLevel = 1;
 Int_t TGeoManager::fgMaxLevel = 1;
 Int_t TGeoManager::fgMaxDaughters = 1;
 Int_t TGeoManager::fgMaxXtruVert = 1;
-Int_t TGeoManager::fgNumThreads = 0;
+std::atomic<Int_t> TGeoManager::fgNumThreads{0};
+std::atomic<UInt_t> TGeoManager::fgThreadsGeneration{0};
+std::atomic<UInt_t> TGeoManager::fgNavigatorsGeneration{0};
 UInt_t TGeoManager::fgExportPrecision = 17;
+Int_t TGeoManager::fgBVHVoxelsThreshold = 0;
 TGeoManager::EDefaultUnits TGeoManager::fgDefaultUnits = TGeoManager::kRootUnits;
-TGeoManager::ThreadsMap_t *TGeoManager::fgThreadId = nullptr;
 static Bool_t gGeometryLocked = kFALSE;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -310,8 +318,6 @@ static Bool_t gGeometryLocked = kFALSE;
 
 TGeoManager::TGeoManager()
 {
-   if (!fgThreadId)
-      fgThreadId = new TGeoManager::ThreadsMap_t;
    if (TClass::IsCallingNew() == TClass::kDummyNew) {
       fTimeCut = kFALSE;
       fTmin = 0.;
@@ -423,8 +429,6 @@ void TGeoManager::Init()
    }
 
    gGeoManager = this;
-   if (!fgThreadId)
-      fgThreadId = new TGeoManager::ThreadsMap_t;
    fTimeCut = kFALSE;
    fTmin = 0.;
    fTmax = 999.;
@@ -788,10 +792,8 @@ Int_t TGeoManager::AddVolume(TGeoVolume *volume)
 
 TGeoNavigator *TGeoManager::AddNavigator()
 {
-   if (fMultiThread) {
-      TGeoManager::ThreadId();
+   if (fMultiThread)
       fgMutex.lock();
-   }
    std::thread::id threadId = std::this_thread::get_id();
    NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
    TGeoNavigatorArray *array = nullptr;
@@ -800,6 +802,7 @@ TGeoNavigator *TGeoManager::AddNavigator()
    else {
       array = new TGeoNavigatorArray(this);
       fNavigators.insert(NavigatorsMap_t::value_type(threadId, array));
+      fgNavigatorsGeneration++;
    }
    TGeoNavigator *nav = array->AddNavigator();
    if (fClosed)
@@ -814,20 +817,10 @@ TGeoNavigator *TGeoManager::AddNavigator()
 
 TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 {
-   TTHREAD_TLS(TGeoNavigator *) tnav = nullptr;
    if (!fMultiThread)
       return fCurrentNavigator;
-   TGeoNavigator *nav = tnav; // TTHREAD_TLS_GET(TGeoNavigator*,tnav);
-   if (nav)
-      return nav;
-   std::thread::id threadId = std::this_thread::get_id();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end())
-      return nullptr;
-   TGeoNavigatorArray *array = it->second;
-   nav = array->GetCurrentNavigator();
-   tnav = nav; // TTHREAD_TLS_SET(TGeoNavigator*,tnav,nav);
-   return nav;
+   TGeoNavigatorArray *array = GetListOfNavigators();
+   return array ? array->GetCurrentNavigator() : nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -835,11 +828,23 @@ TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 
 TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 {
-   std::thread::id threadId = std::this_thread::get_id();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end())
-      return nullptr;
-   TGeoNavigatorArray *array = it->second;
+   // The array of the calling thread is cached in thread local storage. The map is only
+   // searched again after navigator arrays were created or deleted by any manager.
+   thread_local const TGeoManager *tmanager = nullptr;
+   thread_local UInt_t tgeneration = 0;
+   thread_local TGeoNavigatorArray *tarray = nullptr;
+   UInt_t generation = fgNavigatorsGeneration.load(std::memory_order_acquire);
+   if (tmanager == this && tgeneration == generation)
+      return tarray;
+   if (fMultiThread)
+      fgMutex.lock();
+   NavigatorsMap_t::const_iterator it = fNavigators.find(std::this_thread::get_id());
+   TGeoNavigatorArray *array = (it == fNavigators.end()) ? nullptr : it->second;
+   if (fMultiThread)
+      fgMutex.unlock();
+   tmanager = this;
+   tgeneration = generation;
+   tarray = array;
    return array;
 }
 
@@ -848,18 +853,16 @@ TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 
 Bool_t TGeoManager::SetCurrentNavigator(Int_t index)
 {
-   std::thread::id threadId = std::this_thread::get_id();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) {
+   TGeoNavigatorArray *array = GetListOfNavigators();
+   if (!array) {
       Error("SetCurrentNavigator", "No navigator defined for this thread\n");
-      std::cout << "  thread id: " << threadId << std::endl;
+      std::cout << "  thread id: " << std::this_thread::get_id() << std::endl;
       return kFALSE;
    }
-   TGeoNavigatorArray *array = it->second;
    TGeoNavigator *nav = array->SetCurrentNavigator(index);
    if (!nav) {
       Error("SetCurrentNavigator", "Navigator %d not existing for this thread\n", index);
-      std::cout << "  thread id: " << threadId << std::endl;
+      std::cout << "  thread id: " << std::this_thread::get_id() << std::endl;
       return kFALSE;
    }
    if (!fMultiThread)
@@ -889,6 +892,7 @@ void TGeoManager::ClearNavigators()
          delete arr;
    }
    fNavigators.clear();
+   fgNavigatorsGeneration++;
    if (fMultiThread)
       fgMutex.unlock();
 }
@@ -905,8 +909,10 @@ void TGeoManager::RemoveNavigator(const TGeoNavigator *nav)
       if (arr) {
          if ((TGeoNavigator *)arr->Remove((TObject *)nav)) {
             delete nav;
-            if (!arr->GetEntries())
+            if (!arr->GetEntries()) {
                fNavigators.erase(it);
+               fgNavigatorsGeneration++;
+            }
             if (fMultiThread)
                fgMutex.unlock();
             return;
@@ -985,11 +991,8 @@ void TGeoManager::ClearThreadsMap()
 {
    if (gGeoManager && !gGeoManager->IsMultiThread())
       return;
-   fgMutex.lock();
-   if (!fgThreadId->empty())
-      fgThreadId->clear();
    fgNumThreads = 0;
-   fgMutex.unlock();
+   fgThreadsGeneration++;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -998,23 +1001,18 @@ void TGeoManager::ClearThreadsMap()
 
 Int_t TGeoManager::ThreadId()
 {
-   TTHREAD_TLS(Int_t) tid = -1;
-   Int_t ttid = tid; // TTHREAD_TLS_GET(Int_t,tid);
-   if (ttid > -1)
-      return ttid;
+   // The id is kept in thread local storage until ClearThreadsMap() resets the numbering
+   thread_local Int_t tid = -1;
+   thread_local UInt_t tgeneration = 0;
+   UInt_t generation = fgThreadsGeneration.load(std::memory_order_acquire);
+   if (tid > -1 && tgeneration == generation)
+      return tid;
    if (gGeoManager && !gGeoManager->IsMultiThread())
       return 0;
-   std::thread::id threadId = std::this_thread::get_id();
-   TGeoManager::ThreadsMapIt_t it = fgThreadId->find(threadId);
-   if (it != fgThreadId->end())
-      return it->second;
-   // Map needs to be updated.
-   fgMutex.lock();
-   (*fgThreadId)[threadId] = fgNumThreads;
-   tid = fgNumThreads; // TTHREAD_TLS_SET(Int_t,tid,fgNumThreads);
-   ttid = fgNumThreads++;
-   fgMutex.unlock();
-   return ttid;
+   // Register the thread without locking
+   tid = fgNumThreads.fetch_add(1);
+   tgeneration = generation;
+   return tid;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3124,24 +3122,46 @@ void TGeoManager::RestoreMasterVolume()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Voxelize all non-divided volumes.
+/// Voxelize all non-divided volumes. The voxelization of a volume only depends
+/// on its daughters, so the volumes are voxelized in parallel when implicit
+/// multithreading is enabled.
 
 void TGeoManager::Voxelize(Option_t *option)
 {
    TGeoVolume *vol;
-   //   TGeoVoxelFinder *vox = 0;
    if (!fStreamVoxels && fgVerboseLevel > 0)
       Info("Voxelize", "Voxelizing...");
-   //   Int_t nentries = fVolumes->GetSize();
+   std::vector<TGeoVolume *> volumes;
+   volumes.reserve(fVolumes->GetEntriesFast());
    TIter next(fVolumes);
    while ((vol = (TGeoVolume *)next())) {
       if (!fIsGeomReading)
          vol->SortNodes();
-      if (!fStreamVoxels) {
-         vol->Voxelize(option);
-      }
-      if (!fIsGeomReading)
-         vol->FindOverlaps();
+      // the bounding boxes of the assemblies are shared by their mothers, compute them upfront
+      if (vol->IsAssembly())
+         vol->GetShape()->ComputeBBox();
+      volumes.push_back(vol);
+   }
+   if (!fStreamVoxels) {
+      auto voxelize = [&](Int_t first, Int_t last) {
+         for (Int_t i = first; i < last; ++i)
+            volumes[i]->Voxelize(option);
+      };
+      const Int_t nvolumes = volumes.size();
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled() && nvolumes >= 100) {
+         const Int_t nchunks = std::min<Int_t>(nvolumes / 10, 4 * ROOT::GetThreadPoolSize());
+         const Int_t chunkSize = (nvolumes + nchunks - 1) / nchunks;
+         ROOT::TThreadExecutor pool;
+         pool.Foreach([&](Int_t ichunk) { voxelize(ichunk * chunkSize, std::min(nvolumes, (ichunk + 1) * chunkSize)); },
+                      ROOT::TSeqI(nchunks));
+      } else
+#endif
+         voxelize(0, nvolumes);
+   }
+   if (!fIsGeomReading) {
+      for (auto volume : volumes)
+         volume->FindOverlaps();
    }
 }
 
@@ -4342,3 +4362,19 @@ UInt_t TGeoManager::GetExportPrecision()
 {
    return fgExportPrecision;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Volumes with at least this number of daughters are voxelized with a bounding
+/// volume hierarchy (TGeoBVHVoxelFinder) instead of slices. This is faster to
+/// build and needs less memory for large flat volumes. A value of 0 (default)
+/// disables it. Must be called before closing the geometry.
+
+void TGeoManager::SetBVHVoxelsThreshold(Int_t ndaughters)
+{
+   fgBVHVoxelsThreshold = ndaughters;
+}
+
+Int_t TGeoManager::GetBVHVoxelsThreshold()
+{
+   return fgBVHVoxelsThreshold;
+}
@@ -0,0 +1,152 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoMaterialScan
+\ingroup Geometry_classes
+
+Material budget scan of batches of rays.
+
+Each ray is tracked through a TGeoFlatGeometry with a TGeoFlatNavigator, which
+only keeps the stack of placements and global transforms, and the thickness of
+the crossed materials is integrated in radiation and nuclear interaction lengths.
+The totals per volume over all the scanned rays are accumulated as well.
+
+The rays are split in batches of GetBatchSize() rays. When implicit
+multithreading is enabled, the batches are traced in parallel, provided that the
+geometry was prepared for multithreaded navigation with
+TGeoManager::SetMaxThreads() for at least the size of the thread pool, as some
+shapes keep per-thread data.
+
+~~~ {.cpp}
+TGeoFlatGeometry flat(gGeoManager);
+TGeoMaterialScan scan(&flat);
+std::vector<TGeoMaterialScan::Result> results(nrays);
+scan.Scan(nrays, points, dirs, results.data());
+~~~
+*/
+
+#include "TGeoMaterialScan.h"
+
+#include "TGeoFlatGeometry.h"
+#include "TGeoFlatNavigator.h"
+#include "TGeoManager.h"
+#include "TGeoMaterial.h"
+#include "TGeoVolume.h"
+#include "TROOT.h"
+
+#include <algorithm>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor. The scan keeps a pointer to GEOM, which must outlive it.
+
+TGeoMaterialScan::TGeoMaterialScan(const TGeoFlatGeometry *geom) : fGeometry(geom)
+{
+   const Int_t nvolumes = geom->GetNvolumes();
+   fInvRadLen.assign(nvolumes, 0.);
+   fInvIntLen.assign(nvolumes, 0.);
+   for (Int_t ivol = 0; ivol < nvolumes; ivol++) {
+      const TGeoVolume *vol = geom->GetVolume(ivol).fVolume;
+      const TGeoMaterial *mat = vol->IsAssembly() ? nullptr : vol->GetMaterial();
+      if (!mat)
+         continue;
+      if (mat->GetRadLen() > 0. && mat->GetRadLen() < TGeoShape::Big())
+         fInvRadLen[ivol] = 1. / mat->GetRadLen();
+      if (mat->GetIntLen() > 0. && mat->GetIntLen() < TGeoShape::Big())
+         fInvIntLen[ivol] = 1. / mat->GetIntLen();
+   }
+   Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Clear the totals accumulated per volume.
+
+void TGeoMaterialScan::Reset()
+{
+   fVolumeRadLen.assign(fInvRadLen.size(), 0.);
+   fVolumeIntLen.assign(fInvIntLen.size(), 0.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Trace the rays [FIRST, LAST) with a navigator of their own, adding the
+/// material per volume to VOLRADLEN and VOLINTLEN.
+
+void TGeoMaterialScan::ScanBatch(Int_t first, Int_t last, const Double_t *points, const Double_t *dirs,
+                                 Result *results, Double_t maxlength, Double_t *volRadLen, Double_t *volIntLen) const
+{
+   TGeoFlatNavigator nav(fGeometry);
+   Double_t point[3];
+   for (Int_t iray = first; iray < last; iray++) {
+      const Double_t *dir = &dirs[3 * iray];
+      std::copy(&points[3 * iray], &points[3 * iray + 3], point);
+      Result &res = results[iray];
+      res = Result();
+      Double_t length = 0.;
+      nav.FindNode(point);
+      if (nav.IsOutside()) {
+         // move to the top volume, if the ray hits it
+         length = nav.Step(point, dir, maxlength);
+         if (nav.IsOutside())
+            continue;
+      }
+      while (!nav.IsOutside() && length < maxlength) {
+         const Int_t ivol = nav.GetCurrentVolumeIndex();
+         const Double_t step = nav.Step(point, dir, maxlength - length);
+         length += step;
+         res.fLength += step;
+         const Double_t radlen = step * fInvRadLen[ivol];
+         const Double_t intlen = step * fInvIntLen[ivol];
+         res.fRadLen += radlen;
+         res.fIntLen += intlen;
+         volRadLen[ivol] += radlen;
+         volIntLen[ivol] += intlen;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Scan NRAYS rays starting from POINTS along the unit vectors DIRS, both given
+/// as x,y,z triplets in the global frame, and fill the material budget of each
+/// ray in RESULTS. The rays are tracked until they leave the top volume, but not
+/// further than MAXLENGTH.
+
+void TGeoMaterialScan::Scan(Int_t nrays, const Double_t *points, const Double_t *dirs, Result *results,
+                            Double_t maxlength)
+{
+   const Int_t nvolumes = fInvRadLen.size();
+   const Int_t nbatches = (nrays + fBatchSize - 1) / fBatchSize;
+   // per batch totals of each volume, summed afterwards in a deterministic order
+   std::vector<Double_t> volRadLen(nbatches * nvolumes, 0.);
+   std::vector<Double_t> volIntLen(nbatches * nvolumes, 0.);
+   auto scanBatch = [&](Int_t ibatch) {
+      ScanBatch(ibatch * fBatchSize, std::min(nrays, (ibatch + 1) * fBatchSize), points, dirs, results, maxlength,
+                &volRadLen[ibatch * nvolumes], &volIntLen[ibatch * nvolumes]);
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nbatches > 1 && gGeoManager && gGeoManager->IsMultiThread() &&
+       gGeoManager->GetMaxThreads() >= (Int_t)ROOT::GetThreadPoolSize()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(scanBatch, ROOT::TSeqI(nbatches));
+   } else
+#endif
+   {
+      for (Int_t ibatch = 0; ibatch < nbatches; ibatch++)
+         scanBatch(ibatch);
+   }
+   for (Int_t ibatch = 0; ibatch < nbatches; ibatch++) {
+      for (Int_t ivol = 0; ivol < nvolumes; ivol++) {
+         fVolumeRadLen[ivol] += volRadLen[ibatch * nvolumes + ivol];
+         fVolumeIntLen[ivol] += volIntLen[ibatch * nvolumes + ivol];
+      }
+   }
+}
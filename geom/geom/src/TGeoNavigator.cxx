@@ -39,15 +39,22 @@ gGeoManager->SetCurrentNavigator(0);
 #include "TGeoVolume.h"
 #include "TGeoPatternFinder.h"
 #include "TGeoVoxelFinder.h"
+#include "TGeoBVHVoxelFinder.h"
 #include "TMath.h"
 #include "TGeoParallelWorld.h"
 #include "TGeoPhysicalNode.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 static Double_t gTolerance = TGeoShape::Tolerance();
 const char *kGeoOutsidePath = " ";
 const Int_t kN3 = 3 * sizeof(Double_t);
 
 Bool_t TGeoNavigator::fgUsePWSafetyCaching = kFALSE;
+Bool_t TGeoNavigator::fgUseSafetyCaching = kFALSE;
+Bool_t TGeoNavigator::fgUseBVHSafetyBounds = kFALSE;
 
 ClassImp(TGeoNavigator);
 
@@ -1642,6 +1649,7 @@ TGeoNode *TGeoNavigator::InitTrack(Double_t x, Double_t y, Double_t z, Double_t
 
 void TGeoNavigator::ResetState()
 {
+   ResetSafetyCache();
    fSearchOverlaps = kFALSE;
    fIsOutside = kFALSE;
    fIsEntering = fIsExiting = kFALSE;
@@ -1685,8 +1693,59 @@ double TGeoNavigator::GetPWSafety(Double_t cpoint[3], Double_t saf_max)
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute safe distance from the current point. This represent the distance
 /// from POINT to the closest boundary.
+///
+/// If SetSafetyCaching() is enabled, the safety computed for a point is kept as
+/// a sphere free of boundaries. As long as the current point stays inside the
+/// sphere and in the same touchable, the distance to the surface of the sphere
+/// is returned without geometry query. This is a lower bound of the safety.
 
 Double_t TGeoNavigator::Safety(Bool_t inside)
+{
+   if (!fgUseSafetyCaching || inside || fIsOnBoundary)
+      return ComputeSafety(inside);
+   if (IsSafetySphereValid()) {
+      const Double_t d0 = fPoint[0] - fSafetyCenter[0];
+      const Double_t d1 = fPoint[1] - fSafetyCenter[1];
+      const Double_t d2 = fPoint[2] - fSafetyCenter[2];
+      const Double_t safe = fSafetyRadius - TMath::Sqrt(d0 * d0 + d1 * d1 + d2 * d2);
+      // too close to the surface of the sphere, a new query gives a better estimate
+      if (safe > gTolerance) {
+         fSafety = safe;
+         return fSafety;
+      }
+   }
+   const Double_t safe = ComputeSafety(kFALSE);
+   fSafetyRadius = -1;
+   if (safe > gTolerance && safe < TGeoShape::Big()) {
+      memcpy(fSafetyCenter, fPoint, kN3);
+      fSafetyRadius = safe;
+      fSafetyNode = fIsOutside ? nullptr : fCurrentNode;
+      memcpy(fSafetyMatrix, fGlobalMatrix->GetRotationMatrix(), 9 * sizeof(Double_t));
+      memcpy(&fSafetyMatrix[9], fGlobalMatrix->GetTranslation(), kN3);
+   }
+   return safe;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if the last safety sphere was computed in the current touchable,
+/// identified by its node and its global transformation.
+
+Bool_t TGeoNavigator::IsSafetySphereValid() const
+{
+   if (fSafetyRadius < 0)
+      return kFALSE;
+   if (fIsOutside)
+      return fSafetyNode == nullptr;
+   if (fSafetyNode != fCurrentNode)
+      return kFALSE;
+   return !memcmp(fSafetyMatrix, fGlobalMatrix->GetRotationMatrix(), 9 * sizeof(Double_t)) &&
+          !memcmp(&fSafetyMatrix[9], fGlobalMatrix->GetTranslation(), kN3);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute safe distance from the current point, without using the safety sphere.
+
+Double_t TGeoNavigator::ComputeSafety(Bool_t inside)
 {
    if (fIsOnBoundary) {
       fSafety = 0;
@@ -1803,6 +1862,21 @@ Double_t TGeoNavigator::Safety(Bool_t inside)
       }
    }
 
+   //---> visit the daughters by distance with the BVH voxels
+   if (voxels->IsA() == TGeoBVHVoxelFinder::Class()) {
+      safe = ((TGeoBVHVoxelFinder *)voxels)->Safety(point, fSafety, fgUseBVHSafetyBounds);
+      if (safe < gTolerance) {
+         fSafety = 0;
+         fIsOnBoundary = kTRUE;
+         return fSafety;
+      }
+      if (safe < fSafety)
+         fSafety = safe;
+      if (fNmany && !inside)
+         SafetyOverlaps();
+      return fSafety;
+   }
+
    //---> check fast unsafe voxels
    Double_t *boxes = voxels->GetBoxes();
    for (id = 0; id < nd; id++) {
@@ -1840,6 +1914,169 @@ Double_t TGeoNavigator::Safety(Bool_t inside)
    return fSafety;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Basket version of FindNextBoundary() for NTRACKS tracks located in the
+/// current node, e.g. after FindNode() or cd(). POINTS and DIRS hold the
+/// master coordinates and directions of the tracks as consecutive triplets,
+/// as for the TGeoShape::*_v() methods.
+/// On output, STEPS holds the distance to the next boundary, limited to STEPMAX,
+/// and INEXT the index of the daughter of the current volume entered at this
+/// distance, or -1 if the track exits the current volume or no boundary is found
+/// within STEPMAX. The state of the navigator is not changed.
+///
+/// The distances are computed daughter by daughter for all tracks, using the
+/// vectorised shape methods, so that the same shape code is applied to many
+/// tracks in a row. Daughters whose bounding box is not crossed by a track
+/// within its current step are skipped for that track.
+
+void TGeoNavigator::FindNextBoundary_v(Int_t ntracks, const Double_t *points, const Double_t *dirs, Double_t *steps,
+                                       Int_t *inext, Double_t stepmax)
+{
+   if (ntracks <= 0)
+      return;
+   TGeoVolume *vol = fCurrentNode->GetVolume();
+   const Int_t n3 = 3 * ntracks;
+   std::vector<Double_t> lpoints(n3), ldirs(n3), lsteps(ntracks);
+   for (Int_t i = 0; i < ntracks; i++) {
+      fGlobalMatrix->MasterToLocal(&points[3 * i], &lpoints[3 * i]);
+      fGlobalMatrix->MasterToLocalVect(&dirs[3 * i], &ldirs[3 * i]);
+      lsteps[i] = stepmax;
+      inext[i] = -1;
+   }
+   // distance to exit the current volume
+   vol->GetShape()->DistFromInside_v(lpoints.data(), ldirs.data(), steps, ntracks, lsteps.data());
+   for (Int_t i = 0; i < ntracks; i++)
+      steps[i] = TMath::Max(0., TMath::Min(steps[i], stepmax));
+
+   Int_t nd = vol->GetNdaughters();
+   if (!nd)
+      return;
+   TGeoVoxelFinder *voxels = vol->GetVoxels();
+   if (voxels && voxels->NeedRebuild()) {
+      voxels->Voxelize();
+      vol->FindOverlaps();
+   }
+   const Double_t *boxes = voxels ? voxels->GetBoxes() : nullptr;
+   // tracks selected for the current daughter, in the daughter frame
+   std::vector<Int_t> selected(ntracks);
+   std::vector<Double_t> dpoints(n3), ddirs(n3), dsteps(ntracks), ddists(ntracks);
+   for (Int_t id = 0; id < nd; id++) {
+      TGeoNode *current = vol->GetNode(id);
+      if (fGeometry->IsActivityEnabled() && !current->GetVolume()->IsActive())
+         continue;
+      Int_t nsel = 0;
+      for (Int_t i = 0; i < ntracks; i++) {
+         const Double_t *lpoint = &lpoints[3 * i];
+         const Double_t *ldir = &ldirs[3 * i];
+         if (boxes) {
+            // distance along the track to the bounding box of the daughter
+            const Double_t *box = &boxes[6 * id];
+            Double_t tnear = 0.;
+            Double_t tfar = steps[i] + gTolerance;
+            for (Int_t j = 0; j < 3 && tnear <= tfar; j++) {
+               Double_t lo = box[j + 3] - box[j] - gTolerance - lpoint[j];
+               Double_t hi = box[j + 3] + box[j] + gTolerance - lpoint[j];
+               if (ldir[j] == 0.) {
+                  if (lo > 0. || hi < 0.)
+                     tnear = TGeoShape::Big();
+                  continue;
+               }
+               Double_t t1 = lo / ldir[j];
+               Double_t t2 = hi / ldir[j];
+               tnear = TMath::Max(tnear, TMath::Min(t1, t2));
+               tfar = TMath::Min(tfar, TMath::Max(t1, t2));
+            }
+            if (tnear > tfar)
+               continue;
+         }
+         Double_t *dpoint = &dpoints[3 * nsel];
+         current->MasterToLocal(lpoint, dpoint);
+         // skip overlapping daughters containing the point, as FindNextDaughterBoundary()
+         if (current->IsOverlapping() && current->GetVolume()->Contains(dpoint) &&
+             current->GetVolume()->GetShape()->Safety(dpoint, kTRUE) > gTolerance)
+            continue;
+         current->MasterToLocalVect(ldir, &ddirs[3 * nsel]);
+         dsteps[nsel] = steps[i];
+         selected[nsel++] = i;
+      }
+      if (!nsel)
+         continue;
+      current->GetVolume()->GetShape()->DistFromOutside_v(dpoints.data(), ddirs.data(), ddists.data(), nsel,
+                                                          dsteps.data());
+      for (Int_t k = 0; k < nsel; k++) {
+         Int_t i = selected[k];
+         if (ddists[k] < steps[i] - gTolerance) {
+            steps[i] = ddists[k];
+            inext[i] = id;
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Basket version of Safety() for NTRACKS points located in the current node.
+/// POINTS holds the master coordinates as consecutive triplets, SAFE receives
+/// the distance of each point to the closest boundary. Overlapping daughters
+/// are not taken into account. The state of the navigator is not changed.
+
+void TGeoNavigator::Safety_v(Int_t ntracks, const Double_t *points, Double_t *safe)
+{
+   if (ntracks <= 0)
+      return;
+   TGeoVolume *vol = fCurrentNode->GetVolume();
+   const Int_t n3 = 3 * ntracks;
+   std::vector<Double_t> lpoints(n3);
+   for (Int_t i = 0; i < ntracks; i++)
+      fGlobalMatrix->MasterToLocal(&points[3 * i], &lpoints[3 * i]);
+   // safety with respect to the current volume
+   std::unique_ptr<Bool_t[]> inside(new Bool_t[ntracks]);
+   std::fill(inside.get(), inside.get() + ntracks, kTRUE);
+   vol->GetShape()->Safety_v(lpoints.data(), inside.get(), safe, ntracks);
+   for (Int_t i = 0; i < ntracks; i++)
+      safe[i] = TMath::Max(0., safe[i]);
+
+   Int_t nd = vol->GetNdaughters();
+   if (!nd)
+      return;
+   TGeoVoxelFinder *voxels = vol->GetVoxels();
+   if (voxels && voxels->NeedRebuild()) {
+      voxels->Voxelize();
+      vol->FindOverlaps();
+   }
+   const Double_t *boxes = voxels ? voxels->GetBoxes() : nullptr;
+   std::fill(inside.get(), inside.get() + ntracks, kFALSE);
+   std::vector<Int_t> selected(ntracks);
+   std::vector<Double_t> dpoints(n3), dsafe(ntracks);
+   for (Int_t id = 0; id < nd; id++) {
+      TGeoNode *current = vol->GetNode(id);
+      Int_t nsel = 0;
+      for (Int_t i = 0; i < ntracks; i++) {
+         const Double_t *lpoint = &lpoints[3 * i];
+         if (boxes) {
+            // the distance to the bounding box is a lower limit for the safety to the daughter
+            const Double_t *box = &boxes[6 * id];
+            Double_t rsq = 0.;
+            for (Int_t j = 0; j < 3; j++) {
+               Double_t d = TMath::Abs(lpoint[j] - box[j + 3]) - box[j];
+               if (d > 0.)
+                  rsq += d * d;
+            }
+            if (rsq >= safe[i] * safe[i])
+               continue;
+         }
+         current->MasterToLocal(lpoint, &dpoints[3 * nsel]);
+         selected[nsel++] = i;
+      }
+      if (!nsel)
+         continue;
+      current->GetVolume()->GetShape()->Safety_v(dpoints.data(), inside.get(), dsafe.data(), nsel);
+      for (Int_t k = 0; k < nsel; k++) {
+         Int_t i = selected[k];
+         safe[i] = TMath::Max(0., TMath::Min(safe[i], dsafe[k]));
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute safe distance from the current point within an overlapping node
 
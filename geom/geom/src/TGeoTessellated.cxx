@@ -14,8 +14,12 @@
 \ingroup Geometry_classes
 
 Tessellated solid class. It is composed by a set of planar faces having triangular or
-quadrilateral shape. The class does not provide navigation functionality, it just wraps the data
-for the composing faces.
+quadrilateral shape.
+
+The navigation functions work on the triangles of the facets, indexed in a bounding volume
+hierarchy (BVH) built when closing the shape, or on first use for shapes read from a file.
+Distances along a ray and safeties are then logarithmic in the number of facets. The facets
+must form a closed body; their orientation is deduced from the sign of the enclosed volume.
 */
 
 #include <iostream>
@@ -30,13 +34,102 @@ for the composing faces.
 #include "TBuffer3DTypes.h"
 #include "TMath.h"
 
+#include <algorithm>
 #include <array>
+#include <mutex>
 #include <vector>
 
+#include <bvh/v2/bvh.h>
+#include <bvh/v2/vec.h>
+#include <bvh/v2/node.h>
+#include <bvh/v2/stack.h>
+#include <bvh/v2/thread_pool.h>
+#include <bvh/v2/default_builder.h>
+
 ClassImp(TGeoTessellated);
 
 using Vertex_t = Tessellated::Vertex_t;
 
+namespace {
+using BBox = bvh::v2::BBox<double, 3>;
+using Vec3 = bvh::v2::Vec<double, 3>;
+using Node = bvh::v2::Node<double, 3>;
+using Bvh = bvh::v2::Bvh<Node>;
+
+/// The triangles of the facets, stored as structure of arrays in the order of the BVH leaves,
+/// so that the triangles of a leaf are contiguous and tested in a vectorisable loop.
+struct FacetBVH {
+   Bvh fBvh;
+   std::vector<double> fP0[3]; // first vertex
+   std::vector<double> fE1[3]; // first edge
+   std::vector<double> fE2[3]; // second edge
+   std::vector<double> fN[3];  // outward unit normal
+   std::vector<int> fFacet;    // facet index
+};
+
+// serializes the lazy construction of the BVH of shapes read from a file
+std::mutex gBVHMutex;
+
+double BoxDistance2(const BBox &box, const double *point)
+{
+   double dist2 = 0.;
+   for (int i = 0; i < 3; ++i) {
+      double d = std::max({box.min[i] - point[i], point[i] - box.max[i], 0.});
+      dist2 += d * d;
+   }
+   return dist2;
+}
+
+/// Squared distance from POINT to the triangle K (Ericson, Real-Time Collision Detection, 5.1.5)
+double TriangleDistance2(const FacetBVH &data, size_t k, const double *point)
+{
+   double a[3], ab[3], ac[3], ap[3], bp[3], cp[3], closest[3];
+   for (int i = 0; i < 3; ++i) {
+      a[i] = data.fP0[i][k];
+      ab[i] = data.fE1[i][k];
+      ac[i] = data.fE2[i][k];
+      ap[i] = point[i] - a[i];
+      bp[i] = ap[i] - ab[i];
+      cp[i] = ap[i] - ac[i];
+   }
+   auto dot = [](const double *u, const double *v) { return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; };
+   auto set = [&](double v, double w) {
+      for (int i = 0; i < 3; ++i)
+         closest[i] = a[i] + v * ab[i] + w * ac[i];
+   };
+   const double d1 = dot(ab, ap);
+   const double d2 = dot(ac, ap);
+   const double d3 = dot(ab, bp);
+   const double d4 = dot(ac, bp);
+   const double d5 = dot(ab, cp);
+   const double d6 = dot(ac, cp);
+   const double va = d3 * d6 - d5 * d4;
+   const double vb = d5 * d2 - d1 * d6;
+   const double vc = d1 * d4 - d3 * d2;
+   if (d1 <= 0. && d2 <= 0.)
+      set(0., 0.);
+   else if (d3 >= 0. && d4 <= d3)
+      set(1., 0.);
+   else if (d6 >= 0. && d5 <= d6)
+      set(0., 1.);
+   else if (vc <= 0. && d1 >= 0. && d3 <= 0.)
+      set(d1 / (d1 - d3), 0.);
+   else if (vb <= 0. && d2 >= 0. && d6 <= 0.)
+      set(0., d2 / (d2 - d6));
+   else if (va <= 0. && d4 - d3 >= 0. && d5 - d6 >= 0.) {
+      const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+      set(1. - w, w);
+   } else {
+      const double denom = 1. / (va + vb + vc);
+      set(vb * denom, vc * denom);
+   }
+   double dist2 = 0.;
+   for (int i = 0; i < 3; ++i)
+      dist2 += (point[i] - closest[i]) * (point[i] - closest[i]);
+   return dist2;
+}
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compact consecutive equal vertices
 
@@ -320,6 +413,7 @@ bool TGeoTessellated::FacetCheck(int ifacet) const
 
 void TGeoTessellated::CloseShape(bool check, bool fixFlipped, bool verbose)
 {
+   DeleteBVH();
    // Compute bounding box
    fDefined = true;
    fNvert = fVertices.size();
@@ -328,16 +422,15 @@ void TGeoTessellated::CloseShape(bool check, bool fixFlipped, bool verbose)
    // Cleanup the vertex map
    std::multimap<long, int>().swap(fVerticesMap);
 
-   if (fVertices.size() > 0) {
-      if (!check)
-         return;
-
+   if (fVertices.size() > 0 && check) {
       // Check facets
       for (auto i = 0; i < fNfacets; ++i)
          FacetCheck(i);
 
       fClosedBody = CheckClosure(fixFlipped, verbose);
    }
+   if (!fFacets.empty())
+      BuildBVH();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -540,6 +633,8 @@ void TGeoTessellated::ResizeCenter(double maxsize)
    fDX *= scale;
    fDY *= scale;
    fDZ *= scale;
+   // rebuilt on next use
+   DeleteBVH();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -704,3 +799,283 @@ TGeoTessellated *TGeoTessellated::ImportFromObjFormat(const char *objfile, bool
    tsl->Print();
    return tsl;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+TGeoTessellated::~TGeoTessellated()
+{
+   DeleteBVH();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Split the facets into triangles and index them in a bounding volume hierarchy.
+/// Large meshes are processed by a pool of threads.
+
+void TGeoTessellated::BuildBVH() const
+{
+   // triangles in facet order
+   FacetBVH tri;
+   double volume = 0.;
+   for (int ifacet = 0; ifacet < (int)fFacets.size(); ++ifacet) {
+      const auto &facet = fFacets[ifacet];
+      for (int i = 1; i < facet.GetNvert() - 1; ++i) {
+         const Vertex_t &p0 = fVertices[facet[0]];
+         const Vertex_t e1 = fVertices[facet[i]] - p0;
+         const Vertex_t e2 = fVertices[facet[i + 1]] - p0;
+         Vertex_t normal = Vertex_t::Cross(e1, e2);
+         if (normal.Mag2() == 0.)
+            continue; // degenerated triangle
+         // six times the signed volume of the tetrahedron (origin, triangle)
+         volume += Vertex_t::Dot(p0, normal);
+         normal.Normalize();
+         for (int j = 0; j < 3; ++j) {
+            tri.fP0[j].push_back(p0[j]);
+            tri.fE1[j].push_back(e1[j]);
+            tri.fE2[j].push_back(e2[j]);
+            tri.fN[j].push_back(normal[j]);
+         }
+         tri.fFacet.push_back(ifacet);
+      }
+   }
+   const size_t ntri = tri.fFacet.size();
+   if (!ntri)
+      return;
+   // the facets were made consistent by CheckClosure, but may all point inwards
+   const double orientation = (volume < 0.) ? -1. : 1.;
+
+   std::vector<BBox> bboxes(ntri);
+   std::vector<Vec3> centers(ntri);
+   for (size_t k = 0; k < ntri; ++k) {
+      for (int j = 0; j < 3; ++j) {
+         const double p0 = tri.fP0[j][k];
+         const double p1 = p0 + tri.fE1[j][k];
+         const double p2 = p0 + tri.fE2[j][k];
+         bboxes[k].min[j] = std::min({p0, p1, p2}) - TGeoShape::Tolerance();
+         bboxes[k].max[j] = std::max({p0, p1, p2}) + TGeoShape::Tolerance();
+      }
+      centers[k] = bboxes[k].get_center();
+   }
+   auto data = new FacetBVH;
+   typename bvh::v2::DefaultBuilder<Node>::Config config;
+   config.quality = bvh::v2::DefaultBuilder<Node>::Quality::High;
+   if (ntri < config.parallel_threshold) {
+      data->fBvh = bvh::v2::DefaultBuilder<Node>::build(bboxes, centers, config);
+   } else {
+      bvh::v2::ThreadPool pool;
+      data->fBvh = bvh::v2::DefaultBuilder<Node>::build(pool, bboxes, centers, config);
+   }
+
+   // store the triangles in the order of the leaves
+   for (size_t i = 0; i < data->fBvh.prim_ids.size(); ++i) {
+      const size_t k = data->fBvh.prim_ids[i];
+      for (int j = 0; j < 3; ++j) {
+         data->fP0[j].push_back(tri.fP0[j][k]);
+         data->fE1[j].push_back(tri.fE1[j][k]);
+         data->fE2[j].push_back(tri.fE2[j][k]);
+         data->fN[j].push_back(orientation * tri.fN[j][k]);
+      }
+      data->fFacet.push_back(tri.fFacet[k]);
+   }
+   delete (FacetBVH *)fBVH.exchange(data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the hierarchy of the facets.
+
+void TGeoTessellated::DeleteBVH()
+{
+   delete (FacetBVH *)fBVH.exchange(nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the hierarchy of the facets, building it if needed (e.g. after reading
+/// the shape from a file). Returns nullptr if the shape has no facets.
+
+const void *TGeoTessellated::GetBVH() const
+{
+   void *data = fBVH.load(std::memory_order_acquire);
+   if (data || fFacets.empty())
+      return data;
+   std::lock_guard<std::mutex> lock(gBVHMutex);
+   if (!fBVH.load(std::memory_order_acquire))
+      BuildBVH();
+   return fBVH.load(std::memory_order_acquire);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Distance from POINT along DIR to the closest triangle crossed. FACING selects
+/// the triangles: 1 for exiting ones, -1 for entering ones and 0 for all. The
+/// index of the triangle is returned in ITRIANGLE if requested.
+
+double TGeoTessellated::DistToFacets(const double *point, const double *dir, int facing, int *itriangle) const
+{
+   constexpr double kEdgeTolerance = 1.e-12;
+   const auto data = (const FacetBVH *)GetBVH();
+   const double *p0[3] = {data->fP0[0].data(), data->fP0[1].data(), data->fP0[2].data()};
+   const double *e1[3] = {data->fE1[0].data(), data->fE1[1].data(), data->fE1[2].data()};
+   const double *e2[3] = {data->fE2[0].data(), data->fE2[1].data(), data->fE2[2].data()};
+   const double *nn[3] = {data->fN[0].data(), data->fN[1].data(), data->fN[2].data()};
+   double best = TGeoShape::Big();
+   int ibest = -1;
+
+   bvh::v2::Ray<double, 3> ray(Vec3(point[0], point[1], point[2]), Vec3(dir[0], dir[1], dir[2]),
+                               -TGeoShape::Tolerance(), TGeoShape::Big());
+   bvh::v2::GrowingStack<Bvh::Index> stack;
+   auto leaf_fn = [&](size_t begin, size_t end) {
+      // Moller-Trumbore test of all triangles of the leaf
+      for (size_t k = begin; k < end; ++k) {
+         const double pv0 = dir[1] * e2[2][k] - dir[2] * e2[1][k];
+         const double pv1 = dir[2] * e2[0][k] - dir[0] * e2[2][k];
+         const double pv2 = dir[0] * e2[1][k] - dir[1] * e2[0][k];
+         const double det = e1[0][k] * pv0 + e1[1][k] * pv1 + e1[2][k] * pv2;
+         const double invdet = (det != 0.) ? 1. / det : 0.;
+         const double tv0 = point[0] - p0[0][k];
+         const double tv1 = point[1] - p0[1][k];
+         const double tv2 = point[2] - p0[2][k];
+         const double u = (tv0 * pv0 + tv1 * pv1 + tv2 * pv2) * invdet;
+         const double qv0 = tv1 * e1[2][k] - tv2 * e1[1][k];
+         const double qv1 = tv2 * e1[0][k] - tv0 * e1[2][k];
+         const double qv2 = tv0 * e1[1][k] - tv1 * e1[0][k];
+         const double v = (dir[0] * qv0 + dir[1] * qv1 + dir[2] * qv2) * invdet;
+         const double t = (e2[0][k] * qv0 + e2[1][k] * qv1 + e2[2][k] * qv2) * invdet;
+         const double dn = dir[0] * nn[0][k] + dir[1] * nn[1][k] + dir[2] * nn[2][k];
+         const bool hit = (det != 0.) & (u >= -kEdgeTolerance) & (v >= -kEdgeTolerance) &
+                          (u + v <= 1. + kEdgeTolerance) & (t > ray.tmin) & (t < ray.tmax) &
+                          ((facing == 0) | (facing * dn > 0.));
+         if (hit) {
+            ray.tmax = t;
+            ibest = k;
+         }
+      }
+      return false;
+   };
+   data->fBvh.intersect<false, true>(ray, data->fBvh.get_root().index, stack, leaf_fn);
+   if (ibest >= 0)
+      best = std::max(ray.tmax, 0.);
+   if (itriangle)
+      *itriangle = ibest;
+   return best;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Distance from POINT to the closest triangle. The index of the triangle is
+/// returned in ITRIANGLE if requested.
+
+double TGeoTessellated::SafetyToFacets(const double *point, int *itriangle) const
+{
+   const auto data = (const FacetBVH *)GetBVH();
+   double best2 = TGeoShape::Big();
+   int ibest = -1;
+   bvh::v2::GrowingStack<Bvh::Index> stack;
+   auto leaf_fn = [&](size_t begin, size_t end) {
+      for (size_t k = begin; k < end; ++k) {
+         const double dist2 = TriangleDistance2(*data, k, point);
+         if (dist2 < best2) {
+            best2 = dist2;
+            ibest = k;
+         }
+      }
+      return false;
+   };
+   auto inner_fn = [&](const Node &left, const Node &right) {
+      const double dleft = BoxDistance2(left.get_bbox(), point);
+      const double dright = BoxDistance2(right.get_bbox(), point);
+      return std::make_tuple(dleft < best2, dright < best2, dleft > dright);
+   };
+   data->fBvh.traverse_top_down<false>(data->fBvh.get_root().index, stack, leaf_fn, inner_fn);
+   if (itriangle)
+      *itriangle = ibest;
+   return std::sqrt(best2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the normal to the closest facet, oriented along DIR.
+
+void TGeoTessellated::ComputeNormal(const double *point, const double *dir, double *norm)
+{
+   const auto data = (const FacetBVH *)GetBVH();
+   if (!data) {
+      TGeoBBox::ComputeNormal(point, dir, norm);
+      return;
+   }
+   int itriangle = -1;
+   SafetyToFacets(point, &itriangle);
+   double dn = 0.;
+   for (int i = 0; i < 3; ++i) {
+      norm[i] = data->fN[i][itriangle];
+      dn += norm[i] * dir[i];
+   }
+   if (dn < 0.) {
+      for (int i = 0; i < 3; ++i)
+         norm[i] = -norm[i];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Test if the point is inside the tessellated solid: the closest facet crossed
+/// by a ray from the point must be exited.
+
+bool TGeoTessellated::Contains(const double *point) const
+{
+   if (!TGeoBBox::Contains(point))
+      return false;
+   if (!GetBVH())
+      return true;
+   // direction chosen to avoid running along the edges of axis aligned meshes
+   constexpr double kDir[3] = {0.48, 0.6, 0.64};
+   int itriangle = -1;
+   DistToFacets(point, kDir, 0, &itriangle);
+   if (itriangle < 0)
+      return false;
+   const auto data = (const FacetBVH *)GetBVH();
+   return kDir[0] * data->fN[0][itriangle] + kDir[1] * data->fN[1][itriangle] + kDir[2] * data->fN[2][itriangle] > 0.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute distance from inside point to the surface of the tessellated solid.
+
+double TGeoTessellated::DistFromInside(const double *point, const double *dir, int iact, double step, double *safe) const
+{
+   if (iact < 3 && safe) {
+      *safe = Safety(point, true);
+      if (iact == 0)
+         return TGeoShape::Big();
+      if (iact == 1 && step < *safe)
+         return TGeoShape::Big();
+   }
+   if (!GetBVH())
+      return TGeoBBox::DistFromInside(point, dir, fDX, fDY, fDZ, fOrigin, step);
+   const double dist = DistToFacets(point, dir, 1);
+   // no facet to exit: the point is outside
+   return (dist < TGeoShape::Big()) ? dist : 0.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute distance from outside point to the surface of the tessellated solid.
+
+double TGeoTessellated::DistFromOutside(const double *point, const double *dir, int iact, double step, double *safe) const
+{
+   if (iact < 3 && safe) {
+      *safe = Safety(point, false);
+      if (iact == 0)
+         return TGeoShape::Big();
+      if (iact == 1 && step < *safe)
+         return TGeoShape::Big();
+   }
+   // check the bounding box first
+   const double sdist = TGeoBBox::DistFromOutside(point, dir, fDX, fDY, fDZ, fOrigin, step);
+   if (sdist >= step || !GetBVH())
+      return sdist;
+   return DistToFacets(point, dir, -1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Computes the closest distance from given point to the surface of the mesh.
+
+double TGeoTessellated::Safety(const double *point, bool in) const
+{
+   if (!GetBVH())
+      return TGeoBBox::Safety(point, in);
+   return SafetyToFacets(point);
+}
@@ -1235,8 +1235,19 @@ const TBuffer3D &TGeoTube::GetBuffer3D(Int_t reqSections, Bool_t localFrame) con
 
 void TGeoTube::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
 {
-   for (Int_t i = 0; i < vecsize; i++)
-      inside[i] = Contains(&points[3 * i]);
+   if (IsA() != TGeoTube::Class()) {
+      for (Int_t i = 0; i < vecsize; i++)
+         inside[i] = Contains(&points[3 * i]);
+      return;
+   }
+   // branch-free loop which the compiler can vectorise
+   const Double_t rmin2 = fRmin * fRmin;
+   const Double_t rmax2 = fRmax * fRmax;
+   for (Int_t i = 0; i < vecsize; i++) {
+      const Double_t *point = &points[3 * i];
+      Double_t r2 = point[0] * point[0] + point[1] * point[1];
+      inside[i] = (TMath::Abs(point[2]) <= fDz) & (r2 >= rmin2) & (r2 <= rmax2);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
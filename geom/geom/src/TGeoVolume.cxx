@@ -399,6 +399,7 @@ volumes (or volume assemblies) as content.
 #include "TGeoShapeAssembly.h"
 #include "TGeoScaledShape.h"
 #include "TGeoCompositeShape.h"
+#include "TGeoBVHVoxelFinder.h"
 #include "TGeoVoxelFinder.h"
 #include "TGeoExtension.h"
 
@@ -1860,7 +1861,10 @@ TGeoVolume *TGeoVolume::CloneVolume() const
    // copy voxels
    TGeoVoxelFinder *voxels = nullptr;
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      if (fVoxels->InheritsFrom(TGeoBVHVoxelFinder::Class()))
+         voxels = new TGeoBVHVoxelFinder(vol);
+      else
+         voxels = new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -2484,7 +2488,11 @@ void TGeoVolume::Voxelize(Option_t *option)
       fVoxels = nullptr;
    }
    // Create the voxels structure
-   fVoxels = new TGeoVoxelFinder(this);
+   Int_t nbvh = TGeoManager::GetBVHVoxelsThreshold();
+   if (nbvh > 0 && nd >= nbvh)
+      fVoxels = new TGeoBVHVoxelFinder(this);
+   else
+      fVoxels = new TGeoVoxelFinder(this);
    fVoxels->Voxelize(option);
    if (fVoxels) {
       if (fVoxels->IsInvalid()) {
@@ -3022,7 +3030,10 @@ TGeoVolume *TGeoVolumeAssembly::CloneVolume() const
    // copy voxels
    TGeoVoxelFinder *voxels = nullptr;
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      if (fVoxels->InheritsFrom(TGeoBVHVoxelFinder::Class()))
+         voxels = new TGeoBVHVoxelFinder(vol);
+      else
+         voxels = new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -25,6 +25,7 @@
 
 class TString;
 class TGeoHMatrix;
+class TGeoNavigator;
 class TGeoNode;
 class TGeoVolume;
 class TGeoShape;
@@ -71,6 +72,8 @@ private:
 
    void DefineColors() const;
    void LocalToMasterVect(const Double_t *local, Double_t *master) const;
+   Bool_t RaytracePixel(TGeoNavigator *nav, const Double_t *cop, const Double_t *dir, Bool_t outside, Bool_t inclipst,
+                        const Double_t *tosource, Int_t &base_color, Double_t &light) const;
 
 protected:
    void ClearVisibleVolumes();
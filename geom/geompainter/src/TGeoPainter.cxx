@@ -56,6 +56,14 @@ using TBuffer3D mechanism.
 #include "TBuffer3DTypes.h"
 #include "TVirtualViewer3D.h"
 #include "TVirtualX.h"
+#include "TGeoNavigator.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 ClassImp(TGeoPainter);
 
@@ -1705,7 +1713,144 @@ void TGeoPainter::RandomRays(Int_t nrays, Double_t startx, Double_t starty, Doub
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Raytrace current drawn geometry
+/// Trace the ray starting from COP along DIR with the navigator NAV, which was
+/// initialized in COP and backed up. Return kFALSE if no visible volume is hit,
+/// otherwise fill the color of the volume and the light of the hit point.
+
+Bool_t TGeoPainter::RaytracePixel(TGeoNavigator *nav, const Double_t *cop, const Double_t *dir, Bool_t outside,
+                                  Bool_t inclipst, const Double_t *tosource, Int_t &base_color, Double_t &light) const
+{
+   Int_t rtMode = fGeoManager->GetRTmode();
+   Bool_t inclip = inclipst;
+   Double_t local[3], normal[3];
+   Double_t stemin = 0, stemax = TGeoShape::Big();
+   Double_t step, steptot = 0;
+   TGeoNode *next = nullptr;
+   TGeoNode *nextnode = nullptr;
+   TGeoVolume *nextvol;
+   Int_t up;
+   const Double_t *ppoint = nav->GetCurrentPoint();
+   nav->DoRestoreState();
+   nav->SetOutside(outside);
+   nav->SetCurrentPoint(cop);
+   nav->SetCurrentDirection(dir);
+   // current ray pointing to pixel (px,py)
+   Bool_t done = kFALSE;
+   Double_t *norm = nullptr;
+   base_color = 1;
+   // propagate to the clipping shape if any
+   if (fClippingShape) {
+      if (inclip) {
+         stemin = fClippingShape->DistFromInside(cop, dir, 3);
+         stemax = TGeoShape::Big();
+      } else {
+         stemax = fClippingShape->DistFromOutside(cop, dir, 3);
+         stemin = 0;
+      }
+   }
+
+   while (!done) {
+      if (fClippingShape) {
+         if (stemin > 1E10)
+            break;
+         if (stemin > 0) {
+            // we are inside clipping shape
+            nav->SetStep(stemin);
+            next = nav->Step();
+            steptot = 0;
+            stemin = 0;
+            up = 0;
+            while (next) {
+               // we found something after clipping region
+               nextvol = next->GetVolume();
+               if (nextvol->TestAttBit(TGeoAtt::kVisOnScreen)) {
+                  done = kTRUE;
+                  base_color = nextvol->GetLineColor();
+                  fClippingShape->ComputeNormal(ppoint, dir, normal);
+                  norm = normal;
+                  break;
+               }
+               up++;
+               next = nav->GetMother(up);
+            }
+            if (done)
+               break;
+            inclip = fClippingShape->Contains(ppoint);
+            nav->SetStep(1E-3);
+            while (inclip) {
+               nav->Step();
+               inclip = fClippingShape->Contains(ppoint);
+            }
+            stemax = fClippingShape->DistFromOutside(ppoint, dir, 3);
+         }
+      }
+      nextnode = nav->FindNextBoundaryAndStep();
+      step = nav->GetStep();
+      if (step > 1E10)
+         break;
+      steptot += step;
+      next = nextnode;
+      // Check the step
+      if (fClippingShape) {
+         if (steptot > stemax) {
+            steptot = 0;
+            inclip = fClippingShape->Contains(ppoint);
+            if (inclip) {
+               stemin = fClippingShape->DistFromInside(ppoint, dir, 3);
+               stemax = TGeoShape::Big();
+               continue;
+            } else {
+               stemin = 0;
+               stemax = fClippingShape->DistFromOutside(ppoint, dir, 3);
+            }
+         }
+      }
+      // Check if next node is visible
+      if (!nextnode)
+         continue;
+      nextvol = nextnode->GetVolume();
+      if (nextvol->TestAttBit(TGeoAtt::kVisOnScreen)) {
+         done = kTRUE;
+         base_color = nextvol->GetLineColor();
+         next = nextnode;
+         break;
+      }
+   }
+   if (!done)
+      return kFALSE;
+   // current ray intersect a visible volume having color=base_color
+   if (rtMode > 0) {
+      Double_t ldir[3];
+      nav->MasterToLocal(nav->GetCurrentPoint(), local);
+      nav->MasterToLocalVect(nav->GetCurrentDirection(), ldir);
+      for (Int_t i = 0; i < 3; ++i)
+         local[i] += 1.E-8 * ldir[i];
+      step = next->GetVolume()->GetShape()->DistFromInside(local, ldir, 3);
+      for (Int_t i = 0; i < 3; ++i)
+         local[i] += step * ldir[i];
+      next->GetVolume()->GetShape()->ComputeNormal(local, ldir, normal);
+      norm = normal;
+   } else {
+      if (!norm)
+         norm = nav->FindNormalFast();
+      if (!norm)
+         return kFALSE;
+   }
+   Double_t calf = norm[0] * tosource[0] + norm[1] * tosource[1] + norm[2] * tosource[2];
+   light = TMath::Abs(calf);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Raytrace current drawn geometry.
+///
+/// The image is rendered progressively: a coarse pass tracing one pixel out of
+/// kCoarse x kCoarse is drawn first, then the remaining pixels are traced in strips
+/// of columns. If implicit multithreading is enabled and the geometry was prepared
+/// for multithreaded navigation (TGeoManager::SetMaxThreads() with at least the
+/// size of the thread pool), the pixels of a strip are traced in parallel, each
+/// thread using its own navigator. The navigation uses the BVH voxels of the
+/// volumes having many daughters, see TGeoManager::SetBVHVoxelsThreshold().
 
 void TGeoPainter::Raytrace(Option_t *)
 {
@@ -1714,7 +1859,6 @@ void TGeoPainter::Raytrace(Option_t *)
    TView *view = gPad->GetView();
    if (!view)
       return;
-   Int_t rtMode = fGeoManager->GetRTmode();
    TGeoVolume *top = fGeoManager->GetTopVolume();
    if (top != fTopVolume)
       fGeoManager->SetTopVolume(fTopVolume);
@@ -1749,7 +1893,7 @@ void TGeoPainter::Raytrace(Option_t *)
    Double_t dview = view->GetDview();
    Double_t dproj = view->GetDproj();
    Double_t local[3] = {0, 0, 1};
-   Double_t dir[3], normal[3];
+   Double_t dir[3];
    LocalToMasterVect(local, dir);
    Double_t min[3], max[3];
    view->GetRange(min, max);
@@ -1759,174 +1903,144 @@ void TGeoPainter::Raytrace(Option_t *)
    Double_t cop[3];
    for (Int_t i = 0; i < 3; i++)
       cop[i] = cov[i] - dir[i] * dview;
-   fGeoManager->InitTrack(cop, dir);
-   Bool_t outside = fGeoManager->IsOutside();
-   fGeoManager->DoBackupState();
    if (fClippingShape)
       inclipst = fClippingShape->Contains(cop);
-   Int_t px, py;
-   Double_t xloc, yloc, modloc;
    Int_t pxmin, pxmax, pymin, pymax;
    pxmin = gPad->UtoAbsPixel(0);
    pxmax = gPad->UtoAbsPixel(1);
    pymin = gPad->VtoAbsPixel(1);
    pymax = gPad->VtoAbsPixel(0);
-   TGeoNode *next = nullptr;
-   TGeoNode *nextnode = nullptr;
-   Double_t step, steptot;
-   Double_t *norm;
-   const Double_t *point = fGeoManager->GetCurrentPoint();
-   Double_t *ppoint = (Double_t *)point;
    Double_t tosource[3];
-   Double_t calf;
    Double_t phi = 45. * krad;
    tosource[0] = -dir[0] * TMath::Cos(phi) + dir[1] * TMath::Sin(phi);
    tosource[1] = -dir[0] * TMath::Sin(phi) - dir[1] * TMath::Cos(phi);
    tosource[2] = -dir[2];
 
-   Bool_t done;
-   //   Int_t istep;
-   Int_t base_color, color;
-   Double_t light;
-   Double_t stemin = 0, stemax = TGeoShape::Big();
+   const Int_t npx = pxmax - pxmin;
+   const Int_t npy = pymax - pymin;
+   if (npx <= 0 || npy <= 0)
+      return;
+   // the pixel coordinates in the view plane only depend on the column or the row
+   std::vector<Double_t> xlocs(npx), ylocs(npy);
+   for (Int_t ix = 0; ix < npx; ix++)
+      xlocs[ix] = gPad->AbsPixeltoX(pxmax - ix) * du - u0;
+   for (Int_t iy = 0; iy < npy; iy++)
+      ylocs[iy] = gPad->AbsPixeltoY(pymax - iy) * dv - v0;
+
+   // color and light of each pixel, the color is -1 for the pixels not hitting anything
+   std::vector<Int_t> colors(npx * npy, -1);
+   std::vector<Double_t> lights(npx * npy, 0.);
+   std::vector<char> traced(npx * npy, 0);
+
+   // Trace the pixels of columns [ixfirst, ixlast) and rows multiple of ystride with the navigator
+   // of the calling thread
+   auto traceColumns = [&](Int_t ixfirst, Int_t ixlast, Int_t xstride, Int_t ystride) {
+      TGeoNavigator *nav = fGeoManager->GetCurrentNavigator();
+      if (!nav)
+         nav = fGeoManager->AddNavigator();
+      Double_t pdir[3], plocal[3];
+      for (Int_t i = 0; i < 3; i++)
+         pdir[i] = dir[i];
+      nav->InitTrack(cop, pdir);
+      Bool_t outside = nav->IsOutside();
+      nav->DoBackupState();
+      for (Int_t ix = ixfirst; ix < ixlast; ix++) {
+         if (ix % xstride)
+            continue;
+         for (Int_t iy = 0; iy < npy; iy += ystride) {
+            const Int_t ipix = ix * npy + iy;
+            if (traced[ipix])
+               continue;
+            Double_t modloc = TMath::Sqrt(xlocs[ix] * xlocs[ix] + ylocs[iy] * ylocs[iy] + dproj * dproj);
+            plocal[0] = xlocs[ix] / modloc;
+            plocal[1] = ylocs[iy] / modloc;
+            plocal[2] = dproj / modloc;
+            LocalToMasterVect(plocal, pdir);
+            Int_t color;
+            Double_t light;
+            if (RaytracePixel(nav, cop, pdir, outside, inclipst, tosource, color, light)) {
+               colors[ipix] = color;
+               lights[ipix] = light;
+            }
+         }
+      }
+   };
+
+   Bool_t parallel = kFALSE;
+#ifdef R__USE_IMT
+   // every thread of the pool must be able to get a thread id and a navigator
+   parallel = ROOT::IsImplicitMTEnabled() && fGeoManager->IsMultiThread() &&
+              fGeoManager->GetMaxThreads() >= (Int_t)ROOT::GetThreadPoolSize();
+#endif
+   // Trace a strip of columns, in chunks of kChunk columns
+   constexpr Int_t kChunk = 4;
+   auto traceStrip = [&](Int_t ixfirst, Int_t ixlast, Int_t stride) {
+#ifdef R__USE_IMT
+      if (parallel) {
+         const Int_t nchunks = (ixlast - ixfirst + kChunk - 1) / kChunk;
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(
+            [&](Int_t ichunk) {
+               const Int_t first = ixfirst + ichunk * kChunk;
+               traceColumns(first, std::min(ixlast, first + kChunk), stride, stride);
+            },
+            ROOT::TSeqI(nchunks));
+         return;
+      }
+#endif
+      traceColumns(ixfirst, ixlast, stride, stride);
+   };
+
    TPoint *pxy = new TPoint[1];
-   TGeoVolume *nextvol;
-   Int_t up;
-   Int_t ntotal = pxmax * pymax;
-   Int_t nrays = 0;
    TStopwatch *timer = new TStopwatch();
    timer->Start();
-   for (px = pxmin; px < pxmax; px++) {
-      for (py = pymin; py < pymax; py++) {
-         if ((nrays % 100) == 0)
-            OpProgress("Raytracing", nrays, ntotal, timer, kFALSE);
+   Int_t ntotal = npx * npy;
+   Int_t nrays = 0;
+   // coarse pass, each traced pixel is drawn as a block
+   constexpr Int_t kCoarse = 4;
+   traceStrip(0, npx, kCoarse);
+   for (Int_t ix = 0; ix < npx; ix += kCoarse) {
+      for (Int_t iy = 0; iy < npy; iy += kCoarse) {
+         const Int_t ipix = ix * npy + iy;
+         traced[ipix] = 1;
          nrays++;
-         base_color = 1;
-         steptot = 0;
-         Bool_t inclip = inclipst;
-         xloc = gPad->AbsPixeltoX(pxmin + pxmax - px);
-         xloc = xloc * du - u0;
-         yloc = gPad->AbsPixeltoY(pymin + pymax - py);
-         yloc = yloc * dv - v0;
-         modloc = TMath::Sqrt(xloc * xloc + yloc * yloc + dproj * dproj);
-         local[0] = xloc / modloc;
-         local[1] = yloc / modloc;
-         local[2] = dproj / modloc;
-         LocalToMasterVect(local, dir);
-         fGeoManager->DoRestoreState();
-         fGeoManager->SetOutside(outside);
-         fGeoManager->SetCurrentPoint(cop);
-         fGeoManager->SetCurrentDirection(dir);
-         //         fGeoManager->InitTrack(cop,dir);
-         // current ray pointing to pixel (px,py)
-         done = kFALSE;
-         norm = nullptr;
-         // propagate to the clipping shape if any
-         if (fClippingShape) {
-            if (inclip) {
-               stemin = fClippingShape->DistFromInside(cop, dir, 3);
-               stemax = TGeoShape::Big();
+         if (colors[ipix] < 0)
+            continue;
+         gVirtualX->SetFillColor(GetColor(colors[ipix], lights[ipix]));
+         gVirtualX->SetFillStyle(1001);
+         gVirtualX->DrawBox(pxmin + ix, pymin + iy, std::min(pxmax, pxmin + ix + kCoarse) - 1,
+                            std::min(pymax, pymin + iy + kCoarse) - 1, TVirtualX::kFilled);
+      }
+   }
+   gVirtualX->UpdateWindow(1);
+   OpProgress("Raytracing", nrays, ntotal, timer, kFALSE);
+
+   // full resolution pass, by strips of columns
+   constexpr Int_t kStrip = 32;
+   for (Int_t ixstrip = 0; ixstrip < npx; ixstrip += kStrip) {
+      const Int_t ixlast = std::min(npx, ixstrip + kStrip);
+      traceStrip(ixstrip, ixlast, 1);
+      for (Int_t ix = ixstrip; ix < ixlast; ix++) {
+         for (Int_t iy = 0; iy < npy; iy++) {
+            const Int_t ipix = ix * npy + iy;
+            if (!traced[ipix])
+               nrays++;
+            Int_t color;
+            if (colors[ipix] >= 0) {
+               color = GetColor(colors[ipix], lights[ipix]);
             } else {
-               stemax = fClippingShape->DistFromOutside(cop, dir, 3);
-               stemin = 0;
-            }
-         }
-
-         while (!done) {
-            if (fClippingShape) {
-               if (stemin > 1E10)
-                  break;
-               if (stemin > 0) {
-                  // we are inside clipping shape
-                  fGeoManager->SetStep(stemin);
-                  next = fGeoManager->Step();
-                  steptot = 0;
-                  stemin = 0;
-                  up = 0;
-                  while (next) {
-                     // we found something after clipping region
-                     nextvol = next->GetVolume();
-                     if (nextvol->TestAttBit(TGeoAtt::kVisOnScreen)) {
-                        done = kTRUE;
-                        base_color = nextvol->GetLineColor();
-                        fClippingShape->ComputeNormal(ppoint, dir, normal);
-                        norm = normal;
-                        break;
-                     }
-                     up++;
-                     next = fGeoManager->GetMother(up);
-                  }
-                  if (done)
-                     break;
-                  inclip = fClippingShape->Contains(ppoint);
-                  fGeoManager->SetStep(1E-3);
-                  while (inclip) {
-                     fGeoManager->Step();
-                     inclip = fClippingShape->Contains(ppoint);
-                  }
-                  stemax = fClippingShape->DistFromOutside(ppoint, dir, 3);
-               }
+               // erase the coarse block drawn over pixels not hitting anything
+               if (colors[(ix - ix % kCoarse) * npy + iy - iy % kCoarse] < 0)
+                  continue;
+               color = gPad->GetFillColor();
             }
-            nextnode = fGeoManager->FindNextBoundaryAndStep();
-            step = fGeoManager->GetStep();
-            if (step > 1E10)
-               break;
-            steptot += step;
-            next = nextnode;
-            // Check the step
-            if (fClippingShape) {
-               if (steptot > stemax) {
-                  steptot = 0;
-                  inclip = fClippingShape->Contains(ppoint);
-                  if (inclip) {
-                     stemin = fClippingShape->DistFromInside(ppoint, dir, 3);
-                     stemax = TGeoShape::Big();
-                     continue;
-                  } else {
-                     stemin = 0;
-                     stemax = fClippingShape->DistFromOutside(ppoint, dir, 3);
-                  }
-               }
-            }
-            // Check if next node is visible
-            if (!nextnode)
-               continue;
-            nextvol = nextnode->GetVolume();
-            if (nextvol->TestAttBit(TGeoAtt::kVisOnScreen)) {
-               done = kTRUE;
-               base_color = nextvol->GetLineColor();
-               next = nextnode;
-               break;
-            }
-         }
-         if (!done)
-            continue;
-         // current ray intersect a visible volume having color=base_color
-         if (rtMode > 0) {
-            fGeoManager->MasterToLocal(gGeoManager->GetCurrentPoint(), local);
-            fGeoManager->MasterToLocalVect(gGeoManager->GetCurrentDirection(), dir);
-            for (Int_t i = 0; i < 3; ++i)
-               local[i] += 1.E-8 * dir[i];
-            step = next->GetVolume()->GetShape()->DistFromInside(local, dir, 3);
-            for (Int_t i = 0; i < 3; ++i)
-               local[i] += step * dir[i];
-            next->GetVolume()->GetShape()->ComputeNormal(local, dir, normal);
-            norm = normal;
-         } else {
-            if (!norm)
-               norm = fGeoManager->FindNormalFast();
-            if (!norm)
-               continue;
+            gVirtualX->SetMarkerColor(color);
+            pxy[0].fX = pxmin + ix;
+            pxy[0].fY = pymin + iy;
+            gVirtualX->DrawPolyMarker(1, pxy);
          }
-         calf = norm[0] * tosource[0] + norm[1] * tosource[1] + norm[2] * tosource[2];
-         light = TMath::Abs(calf);
-         color = GetColor(base_color, light);
-         // Now we know the color of the pixel, just draw it
-         gVirtualX->SetMarkerColor(color);
-         pxy[0].fX = px;
-         pxy[0].fY = py;
-         gVirtualX->DrawPolyMarker(1, pxy);
       }
+      OpProgress("Raytracing", nrays, ntotal, timer, kFALSE);
    }
    delete[] pxy;
    timer->Stop();
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <TGeoBVHVoxelFinder.h>
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMatrix.h>
+#include <TGeoMedium.h>
+#include <TGeoNavigator.h>
+#include <TGeoNode.h>
+#include <TGeoVolume.h>
+#include <TMath.h>
+#include <TRandom3.h>
+
+#include <string>
+#include <vector>
+
+struct NavResult {
+   std::string fPath;
+   std::string fNext;
+   double fStep;
+};
+
+// Build a calorimeter-like flat volume with many (partly rotated) cells and navigate through it
+std::vector<NavResult> Navigate(int bvhThreshold)
+{
+   TGeoManager::SetBVHVoxelsThreshold(bvhThreshold);
+   auto geom = new TGeoManager("calo", "flat volume with many cells");
+   auto mat = new TGeoMaterial("Vacuum", 0, 0, 0);
+   auto med = new TGeoMedium("Vacuum", 1, mat);
+   auto top = geom->MakeBox("TOP", med, 100., 100., 100.);
+   geom->SetTopVolume(top);
+   auto cell = geom->MakeBox("CELL", med, 0.4, 0.4, 0.4);
+   int copy = 0;
+   for (int i = 0; i < 30; ++i) {
+      for (int j = 0; j < 30; ++j) {
+         for (int k = 0; k < 4; ++k) {
+            auto rot = new TGeoRotation("", 10. * ((i + j + k) % 5), 0., 0.);
+            top->AddNode(cell, copy++, new TGeoCombiTrans(i - 15., j - 15., k - 2., rot));
+         }
+      }
+   }
+   geom->CloseGeometry();
+
+   auto voxels = top->GetVoxels();
+   EXPECT_EQ(bvhThreshold > 0, voxels && voxels->InheritsFrom(TGeoBVHVoxelFinder::Class()));
+
+   std::vector<NavResult> results;
+   TRandom3 rnd(1234);
+   auto nav = geom->GetCurrentNavigator();
+   for (int n = 0; n < 2000; ++n) {
+      double point[3] = {rnd.Uniform(-16, 16), rnd.Uniform(-16, 16), rnd.Uniform(-3, 3)};
+      double theta = TMath::ACos(rnd.Uniform(-1, 1));
+      double phi = rnd.Uniform(0, TMath::TwoPi());
+      double dir[3] = {TMath::Sin(theta) * TMath::Cos(phi), TMath::Sin(theta) * TMath::Sin(phi), TMath::Cos(theta)};
+      if (n % 10 == 0) {
+         // axis aligned directions
+         dir[0] = dir[1] = dir[2] = 0.;
+         dir[n / 10 % 3] = 1.;
+      }
+      nav->InitTrack(point, dir);
+      NavResult res;
+      res.fPath = nav->GetPath();
+      auto next = nav->FindNextBoundary();
+      res.fNext = next ? next->GetName() : "";
+      res.fStep = nav->GetStep();
+      results.emplace_back(res);
+   }
+   delete geom;
+   TGeoManager::SetBVHVoxelsThreshold(0);
+   return results;
+}
+
+TEST(Geometry, BVHVoxels)
+{
+   auto slices = Navigate(0);
+   auto bvh = Navigate(100);
+   ASSERT_EQ(slices.size(), bvh.size());
+   for (std::size_t i = 0; i < slices.size(); ++i) {
+      EXPECT_EQ(slices[i].fPath, bvh[i].fPath) << "point " << i;
+      EXPECT_EQ(slices[i].fNext, bvh[i].fNext) << "point " << i;
+      EXPECT_NEAR(slices[i].fStep, bvh[i].fStep, 1e-9) << "point " << i;
+   }
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <TGeoBBox.h>
+#include <TGeoBoolNode.h>
+#include <TGeoCompositeShape.h>
+#include <TGeoManager.h>
+#include <TGeoMatrix.h>
+#include <TGeoSphere.h>
+#include <TGeoTube.h>
+#include <TRandom3.h>
+
+// Compare the flattened evaluation of a nested composite with the recursion on the Boolean nodes
+void CheckComposite(int nbins)
+{
+   TGeoCompositeShape::SetLookupTableBins(nbins);
+   auto geom = new TGeoManager("composite", "nested composite shapes");
+   new TGeoBBox("B", 10., 10., 10.);
+   new TGeoTube("T", 0., 4., 12.);
+   new TGeoSphere("S", 0., 6.);
+   auto r1 = new TGeoRotation("r1", 0., 90., 0.);
+   r1->RegisterYourself();
+   auto t1 = new TGeoTranslation("t1", 8., 8., 0.);
+   t1->RegisterYourself();
+   auto t2 = new TGeoTranslation("t2", -8., 8., 0.);
+   t2->RegisterYourself();
+   auto inner = new TGeoCompositeShape("INNER", "B-(T+T:r1)");
+   auto outer = new TGeoCompositeShape("OUTER", "(INNER-S:t1)+(S:t2*B)");
+
+   TRandom3 rnd(4321);
+   for (int n = 0; n < 20000; ++n) {
+      double point[3] = {rnd.Uniform(-15, 15), rnd.Uniform(-15, 15), rnd.Uniform(-15, 15)};
+      EXPECT_EQ(inner->GetBoolNode()->Contains(point), inner->Contains(point)) << "point " << n;
+      EXPECT_EQ(outer->GetBoolNode()->Contains(point), outer->Contains(point)) << "point " << n;
+   }
+   delete geom;
+   TGeoCompositeShape::SetLookupTableBins(0);
+}
+
+TEST(Geometry, CompositeCompiled)
+{
+   CheckComposite(0);
+}
+
+TEST(Geometry, CompositeLookupTable)
+{
+   CheckComposite(16);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <TGeoFlatGeometry.h>
+#include <TGeoFlatNavigator.h>
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMatrix.h>
+#include <TGeoMedium.h>
+#include <TGeoNavigator.h>
+#include <TGeoNode.h>
+#include <TGeoVolume.h>
+#include <TMath.h>
+#include <TRandom3.h>
+
+// Track through a layered geometry with TGeoNavigator and TGeoFlatNavigator and compare the crossed nodes
+TEST(Geometry, FlatNavigation)
+{
+   auto geom = new TGeoManager("flat", "flat navigation");
+   auto mat = new TGeoMaterial("Vacuum", 0, 0, 0);
+   auto med = new TGeoMedium("Vacuum", 1, mat);
+   auto top = geom->MakeBox("TOP", med, 50., 50., 50.);
+   geom->SetTopVolume(top);
+   auto layer = geom->MakeTube("LAYER", med, 5., 30., 2.);
+   auto cell = geom->MakeBox("CELL", med, 1., 1., 1.5);
+   auto pin = geom->MakeTube("PIN", med, 0., 0.3, 1.4);
+   cell->AddNode(pin, 0, new TGeoTranslation(0.5, 0., 0.));
+   for (int i = 0; i < 24; ++i) {
+      double phi = 15. * i;
+      auto rot = new TGeoRotation("", phi, 0., 0.);
+      double r = 15. + 3. * (i % 3);
+      layer->AddNode(cell, i,
+                     new TGeoCombiTrans(r * TMath::Cos(phi * TMath::DegToRad()), r * TMath::Sin(phi * TMath::DegToRad()),
+                                        0., rot));
+   }
+   for (int k = 0; k < 5; ++k)
+      top->AddNode(layer, k, new TGeoCombiTrans(0., 0., 8. * k - 16., new TGeoRotation("", 7. * k, 0., 0.)));
+   geom->CloseGeometry();
+
+   TGeoFlatGeometry flat(geom, 1);
+   EXPECT_EQ(flat.GetNvolumes(), 4);
+   EXPECT_EQ(flat.GetNplacements(), 5 + 24 + 1);
+   EXPECT_EQ(flat.GetMaxDepth(), 3);
+   EXPECT_EQ(flat.GetNtouchables(), 6);
+
+   TGeoFlatNavigator fnav(&flat);
+   auto nav = geom->GetCurrentNavigator();
+   TRandom3 rnd(42);
+   for (int n = 0; n < 500; ++n) {
+      double point[3] = {rnd.Uniform(-30, 30), rnd.Uniform(-30, 30), rnd.Uniform(-20, 20)};
+      double theta = TMath::ACos(rnd.Uniform(-1, 1));
+      double phi = rnd.Uniform(0, TMath::TwoPi());
+      double dir[3] = {TMath::Sin(theta) * TMath::Cos(phi), TMath::Sin(theta) * TMath::Sin(phi), TMath::Cos(theta)};
+      nav->InitTrack(point, dir);
+      fnav.FindNode(point);
+      ASSERT_EQ(nav->GetLevel(), fnav.GetLevel()) << "track " << n;
+      EXPECT_EQ(nav->GetCurrentNode(), fnav.GetCurrentNode()) << "track " << n;
+      EXPECT_NEAR(nav->Safety(), fnav.Safety(point), 1e-9) << "track " << n;
+      for (int istep = 0; istep < 100 && !nav->IsOutside(); ++istep) {
+         nav->FindNextBoundaryAndStep();
+         double step = fnav.Step(point, dir);
+         EXPECT_NEAR(nav->GetStep(), step, 1e-6) << "track " << n << " step " << istep;
+         EXPECT_EQ(nav->IsOutside(), fnav.IsOutside()) << "track " << n << " step " << istep;
+         if (nav->IsOutside() || fnav.IsOutside())
+            break;
+         ASSERT_EQ(nav->GetCurrentNode(), fnav.GetCurrentNode()) << "track " << n << " step " << istep;
+      }
+   }
+   delete geom;
+}
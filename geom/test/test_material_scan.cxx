@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <TGeoFlatGeometry.h>
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMaterialScan.h>
+#include <TGeoMatrix.h>
+#include <TGeoMedium.h>
+#include <TGeoVolume.h>
+#include <TMath.h>
+
+#include <vector>
+
+// Scan a stack of slabs of known radiation and interaction lengths, given as negative values to be taken as they are
+TEST(Geometry, MaterialScan)
+{
+   auto geom = new TGeoManager("scan", "material scan");
+   auto vacuum = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0, 0, 0));
+   auto dense = new TGeoMedium("Dense", 2, new TGeoMaterial("Dense", 10., 5., 5., -2., -20.));
+   auto light = new TGeoMedium("Light", 3, new TGeoMaterial("Light", 10., 5., 1., -8., -40.));
+   auto top = geom->MakeBox("TOP", vacuum, 20., 20., 20.);
+   geom->SetTopVolume(top);
+   auto slab1 = geom->MakeBox("SLAB1", dense, 10., 10., 1.);
+   auto slab2 = geom->MakeBox("SLAB2", light, 10., 10., 2.);
+   top->AddNode(slab1, 0, new TGeoTranslation(0., 0., -5.));
+   top->AddNode(slab2, 0, new TGeoTranslation(0., 0., 5.));
+   geom->CloseGeometry();
+
+   TGeoFlatGeometry flat(geom);
+   TGeoMaterialScan scan(&flat);
+   scan.SetBatchSize(7);
+   const int nrays = 100;
+   std::vector<double> points(3 * nrays), dirs(3 * nrays);
+   for (int i = 0; i < nrays; ++i) {
+      // rays from outside the top volume, crossing both slabs at an angle
+      const double theta = 0.2 * i / nrays;
+      points[3 * i] = 0.;
+      points[3 * i + 1] = 0.;
+      points[3 * i + 2] = -30.;
+      dirs[3 * i] = TMath::Sin(theta);
+      dirs[3 * i + 1] = 0.;
+      dirs[3 * i + 2] = TMath::Cos(theta);
+   }
+   std::vector<TGeoMaterialScan::Result> results(nrays);
+   scan.Scan(nrays, points.data(), dirs.data(), results.data());
+   double totalRadLen = 0.;
+   for (int i = 0; i < nrays; ++i) {
+      const double cost = dirs[3 * i + 2];
+      EXPECT_NEAR(results[i].fRadLen, (2. / 2. + 4. / 8.) / cost, 1e-8) << "ray " << i;
+      EXPECT_NEAR(results[i].fIntLen, (2. / 20. + 4. / 40.) / cost, 1e-8) << "ray " << i;
+      EXPECT_NEAR(results[i].fLength, 40. / cost, 1e-8) << "ray " << i;
+      totalRadLen += results[i].fRadLen;
+   }
+   double volumeRadLen = 0.;
+   for (int ivol = 0; ivol < flat.GetNvolumes(); ++ivol) {
+      if (flat.GetVolume(ivol).fVolume == slab1) {
+         EXPECT_GT(scan.GetVolumeRadLen(ivol), 0.);
+      }
+      volumeRadLen += scan.GetVolumeRadLen(ivol);
+   }
+   EXPECT_NEAR(volumeRadLen, totalRadLen, 1e-8);
+
+   // rays missing the geometry and limited in length
+   double miss[3] = {0., 0., -30.}, away[3] = {0., 0., -1.};
+   TGeoMaterialScan::Result res;
+   scan.Scan(1, miss, away, &res);
+   EXPECT_EQ(res.fLength, 0.);
+   double inside[3] = {0., 0., -5.}, up[3] = {0., 0., 1.};
+   scan.Scan(1, inside, up, &res, 0.5);
+   EXPECT_NEAR(res.fRadLen, 0.25, 1e-8);
+   delete geom;
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMatrix.h>
+#include <TGeoMedium.h>
+#include <TGeoNavigator.h>
+#include <TGeoNode.h>
+#include <TGeoVolume.h>
+#include <TMath.h>
+#include <TRandom3.h>
+
+#include <vector>
+
+// Compare the basket navigation methods with the scalar ones for tracks starting in the top volume
+TEST(Geometry, NavigatorBasket)
+{
+   auto geom = new TGeoManager("basket", "basket navigation");
+   auto mat = new TGeoMaterial("Vacuum", 0, 0, 0);
+   auto med = new TGeoMedium("Vacuum", 1, mat);
+   auto top = geom->MakeBox("TOP", med, 20., 20., 20.);
+   geom->SetTopVolume(top);
+   auto box = geom->MakeBox("BOX", med, 1., 2., 0.5);
+   auto tube = geom->MakeTube("TUBE", med, 0.5, 1.5, 1.);
+   int copy = 0;
+   for (int i = 0; i < 6; ++i) {
+      for (int j = 0; j < 6; ++j) {
+         auto rot = new TGeoRotation("", 15. * i, 10. * j, 0.);
+         top->AddNode((i + j) % 2 ? box : tube, copy++, new TGeoCombiTrans(5. * i - 12.5, 5. * j - 12.5, 0., rot));
+      }
+   }
+   geom->CloseGeometry();
+
+   auto nav = geom->GetCurrentNavigator();
+   TRandom3 rnd(4321);
+   std::vector<double> points, dirs, steps;
+   std::vector<TGeoNode *> nodes;
+   std::vector<double> safeties;
+   while (nodes.size() < 1000) {
+      double point[3] = {rnd.Uniform(-18, 18), rnd.Uniform(-18, 18), rnd.Uniform(-4, 4)};
+      double theta = TMath::ACos(rnd.Uniform(-1, 1));
+      double phi = rnd.Uniform(0, TMath::TwoPi());
+      double dir[3] = {TMath::Sin(theta) * TMath::Cos(phi), TMath::Sin(theta) * TMath::Sin(phi), TMath::Cos(theta)};
+      nav->InitTrack(point, dir);
+      if (nav->GetLevel() != 0)
+         continue;
+      safeties.push_back(nav->Safety());
+      auto next = nav->FindNextBoundary();
+      nodes.push_back(next);
+      steps.push_back(nav->GetStep());
+      points.insert(points.end(), point, point + 3);
+      dirs.insert(dirs.end(), dir, dir + 3);
+   }
+
+   const int ntracks = nodes.size();
+   std::vector<double> bsteps(ntracks), bsafe(ntracks);
+   std::vector<int> inext(ntracks);
+   nav->cd("/TOP_1");
+   nav->FindNextBoundary_v(ntracks, points.data(), dirs.data(), bsteps.data(), inext.data());
+   nav->Safety_v(ntracks, points.data(), bsafe.data());
+   for (int i = 0; i < ntracks; ++i) {
+      EXPECT_NEAR(steps[i], bsteps[i], 1e-9) << "track " << i;
+      if (inext[i] >= 0)
+         EXPECT_EQ(nodes[i], top->GetNode(inext[i])) << "track " << i;
+      EXPECT_NEAR(safeties[i], bsafe[i], 1e-9) << "track " << i;
+   }
+   delete geom;
+}
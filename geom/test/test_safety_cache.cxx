@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMatrix.h>
+#include <TGeoMedium.h>
+#include <TGeoNavigator.h>
+#include <TGeoVolume.h>
+#include <TRandom3.h>
+
+#include <vector>
+
+TGeoManager *MakeCells(int bvhThreshold)
+{
+   TGeoManager::SetBVHVoxelsThreshold(bvhThreshold);
+   auto geom = new TGeoManager("cells", "volume with many cells");
+   auto med = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0, 0, 0));
+   auto top = geom->MakeBox("TOP", med, 30., 30., 30.);
+   geom->SetTopVolume(top);
+   auto cell = geom->MakeSphere("CELL", med, 0., 0.8);
+   int copy = 0;
+   for (int i = 0; i < 10; ++i)
+      for (int j = 0; j < 10; ++j)
+         for (int k = 0; k < 5; ++k)
+            top->AddNode(cell, copy++, new TGeoTranslation(3. * i - 13.5, 3. * j - 13.5, 3. * k - 6.));
+   geom->CloseGeometry();
+   TGeoManager::SetBVHVoxelsThreshold(0);
+   return geom;
+}
+
+std::vector<double> Safeties(int bvhThreshold, bool bounds, bool caching)
+{
+   auto geom = MakeCells(bvhThreshold);
+   TGeoNavigator::SetBVHSafetyBounds(bounds);
+   TGeoNavigator::SetSafetyCaching(caching);
+   auto nav = geom->GetCurrentNavigator();
+   std::vector<double> safeties;
+   TRandom3 rnd(777);
+   for (int n = 0; n < 200; ++n) {
+      double point[3] = {rnd.Uniform(-20, 20), rnd.Uniform(-20, 20), rnd.Uniform(-10, 10)};
+      const double dir[3] = {0.6, 0.8, 0.};
+      nav->FindNode(point[0], point[1], point[2]);
+      // small moves around the point, in the same volume
+      for (int istep = 0; istep < 5; ++istep) {
+         for (int i = 0; i < 3; ++i)
+            point[i] += 0.01 * dir[i];
+         nav->SetCurrentPoint(point);
+         safeties.push_back(nav->Safety());
+      }
+   }
+   TGeoNavigator::SetBVHSafetyBounds(false);
+   TGeoNavigator::SetSafetyCaching(false);
+   delete geom;
+   return safeties;
+}
+
+TEST(Geometry, SafetyCache)
+{
+   auto exact = Safeties(0, false, false);
+   auto bvh = Safeties(100, false, false);
+   auto bounds = Safeties(100, true, false);
+   auto cached = Safeties(0, false, true);
+   ASSERT_EQ(exact.size(), bvh.size());
+   int ncached = 0;
+   for (std::size_t i = 0; i < exact.size(); ++i) {
+      EXPECT_NEAR(exact[i], bvh[i], 1e-9) << "point " << i;
+      // the lower bounds are safe and not larger than the exact safety
+      EXPECT_LE(bounds[i], exact[i] + 1e-9) << "point " << i;
+      EXPECT_GT(bounds[i], 0.) << "point " << i;
+      EXPECT_LE(cached[i], exact[i] + 1e-9) << "point " << i;
+      if (cached[i] < exact[i] - 1e-9)
+         ncached++;
+   }
+   // most moves stay within the safety sphere of the first point
+   EXPECT_GT(ncached, 400);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <TGeoBBox.h>
+#include <TGeoTessellated.h>
+#include <TMath.h>
+#include <TRandom3.h>
+
+using Vertex_t = Tessellated::Vertex_t;
+
+// A box made of quadrilateral facets, optionally with inward pointing normals
+TGeoTessellated *MakeBoxMesh(double dx, double dy, double dz, bool inward)
+{
+   auto mesh = new TGeoTessellated("mesh", 6);
+   Vertex_t v[8];
+   for (int i = 0; i < 8; ++i)
+      v[i] = Vertex_t((i & 1) ? dx : -dx, (i & 2) ? dy : -dy, (i & 4) ? dz : -dz);
+   // counter-clockwise seen from outside
+   const int faces[6][4] = {{0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+   for (const auto &f : faces) {
+      if (inward)
+         mesh->AddFacet(v[f[3]], v[f[2]], v[f[1]], v[f[0]]);
+      else
+         mesh->AddFacet(v[f[0]], v[f[1]], v[f[2]], v[f[3]]);
+   }
+   mesh->CloseShape(true, true, false);
+   return mesh;
+}
+
+void CompareWithBox(bool inward)
+{
+   const double dx = 3., dy = 2., dz = 1.;
+   TGeoBBox box(dx, dy, dz);
+   auto mesh = MakeBoxMesh(dx, dy, dz, inward);
+   EXPECT_TRUE(mesh->IsClosedBody());
+
+   TRandom3 rnd(7);
+   for (int n = 0; n < 2000; ++n) {
+      double point[3] = {rnd.Uniform(-5, 5), rnd.Uniform(-5, 5), rnd.Uniform(-5, 5)};
+      double theta = TMath::ACos(rnd.Uniform(-1, 1));
+      double phi = rnd.Uniform(0, TMath::TwoPi());
+      double dir[3] = {TMath::Sin(theta) * TMath::Cos(phi), TMath::Sin(theta) * TMath::Sin(phi), TMath::Cos(theta)};
+      bool inside = box.Contains(point);
+      EXPECT_EQ(inside, mesh->Contains(point)) << "point " << n;
+      if (inside) {
+         EXPECT_NEAR(box.DistFromInside(point, dir), mesh->DistFromInside(point, dir), 1e-9) << "point " << n;
+         EXPECT_NEAR(box.Safety(point, true), mesh->Safety(point, true), 1e-9) << "point " << n;
+      } else {
+         double dbox = box.DistFromOutside(point, dir);
+         double dmesh = mesh->DistFromOutside(point, dir);
+         if (dbox < TGeoShape::Big())
+            EXPECT_NEAR(dbox, dmesh, 1e-9) << "point " << n;
+         else
+            EXPECT_GE(dmesh, TGeoShape::Big()) << "point " << n;
+         // the box safety is only a lower limit outside
+         EXPECT_GE(mesh->Safety(point, false), box.Safety(point, false) - 1e-9) << "point " << n;
+      }
+   }
+   delete mesh;
+}
+
+TEST(Geometry, TessellatedNavigation)
+{
+   CompareWithBox(false);
+   CompareWithBox(true);
+}
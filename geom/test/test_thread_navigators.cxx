@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <TGeoNavigator.h>
+#include <TGeoVolume.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+// Each worker thread gets its own id and sees its own current navigator
+TEST(Geometry, ThreadNavigators)
+{
+   constexpr int kNthreads = 8;
+   auto geom = new TGeoManager("threads", "per-thread navigators");
+   auto mat = new TGeoMaterial("Vacuum", 0, 0, 0);
+   auto med = new TGeoMedium("Vacuum", 1, mat);
+   auto top = geom->MakeBox("TOP", med, 10., 10., 10.);
+   geom->SetTopVolume(top);
+   geom->CloseGeometry();
+   geom->SetMaxThreads(kNthreads);
+
+   std::vector<int> ids(kNthreads, -1);
+   std::vector<int> failures(kNthreads, 0);
+   std::vector<std::thread> workers;
+   for (int i = 0; i < kNthreads; ++i) {
+      workers.emplace_back([&, i]() {
+         auto nav1 = geom->AddNavigator();
+         if (geom->GetCurrentNavigator() != nav1)
+            failures[i]++;
+         auto nav2 = geom->AddNavigator();
+         if (geom->GetCurrentNavigator() != nav2)
+            failures[i]++;
+         geom->SetCurrentNavigator(0);
+         if (geom->GetCurrentNavigator() != nav1)
+            failures[i]++;
+         for (int n = 0; n < 1000; ++n) {
+            if (geom->GetCurrentNavigator()->FindNode(0., 0., 0.) != geom->GetTopNode())
+               failures[i]++;
+         }
+         ids[i] = TGeoManager::ThreadId();
+         geom->RemoveNavigator(nav2);
+         geom->RemoveNavigator(nav1);
+      });
+   }
+   for (auto &worker : workers)
+      worker.join();
+
+   std::set<int> unique(ids.begin(), ids.end());
+   EXPECT_EQ(unique.size(), (std::size_t)kNthreads);
+   for (int i = 0; i < kNthreads; ++i) {
+      EXPECT_EQ(failures[i], 0) << "thread " << i;
+      EXPECT_GE(ids[i], 0);
+   }
+   delete geom;
+}
@@ -41,6 +41,7 @@
 #include "TEnv.h"
 #include "TError.h"
 #include "TGraph.h"
+#include "TVirtualGraphPainter.h"
 #include "TGraph2D.h"
 #include "TGaxis.h"
 #include "TScatter.h"
@@ -300,6 +301,11 @@ Bool_t TWebCanvas::IsJSSupportedClass(TObject *obj, Bool_t many_primitives)
    if (!obj)
       return kTRUE;
 
+   // Large graphs are painted on the server, which only sends the decimated points
+   if ((obj->IsA() == TGraph::Class()) && (TVirtualGraphPainter::GetDecimationThreshold() > 0) &&
+       (static_cast<TGraph *>(obj)->GetN() > TVirtualGraphPainter::GetDecimationThreshold()))
+      return kFALSE;
+
    static const struct {
       const char *name{nullptr};
       bool with_derived{false};
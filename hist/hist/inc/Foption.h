@@ -50,6 +50,8 @@ struct Foption_t {
    int BinVolume;   // "WIDTH": scale content by the bin width/volume
    double hRobust;  //  value of h parameter used in robust fitting
    ROOT::EExecutionPolicy ExecPolicy;  //  Choose the execution Policy: "SERIAL", "MULTITHREAD" or "MULTIPROCESS"
+   int AutoExecPolicy;  // Choose the execution policy and the vectorization according to the data size (no "SERIAL" or "MULTITHREAD")
+   int AutoGradient;    // Use the gradient of formula functions from automatic differentiation when available (no "NUMGRAD")
 
   Foption_t() :
       Quiet        (0),
@@ -75,7 +77,9 @@ struct Foption_t {
       StoreResult  (0),
       BinVolume    (0),
       hRobust      (0),
-      ExecPolicy   (ROOT::EExecutionPolicy::kSequential)
+      ExecPolicy   (ROOT::EExecutionPolicy::kSequential),
+      AutoExecPolicy(1),
+      AutoGradient (1)
    {}
 };
 
@@ -0,0 +1,192 @@
+/// \file ROOT/TH1ConcurrentFill.hxx
+/// \ingroup Hist
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFill
+#define ROOT_TH1ConcurrentFill
+
+#include "TH1.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+class TH1ConcurrentFiller;
+
+/**
+ \class ROOT::Experimental::TH1ConcurrentFillManager
+ \ingroup Hist
+ Fills a classic histogram (TH1, TH2, TH3 or TProfile) from many threads concurrently,
+ without a copy of the histogram per thread.
+
+ The sums per bin are kept in arrays of atomic doubles, split in `nShards` shards: each
+ thread adds to the shard selected by its thread id. One shard takes about the memory of
+ the histogram itself; more shards reduce the contention of threads filling the same bins.
+ The statistics (sum of weights, of weights times x etc.) are accumulated per shard too,
+ each shard in its own cache line.
+
+ Threads can either call Fill() directly, or fill through a TH1ConcurrentFiller obtained
+ with MakeFiller(): it updates the bins directly as well, but accumulates the statistics
+ locally and adds them to the manager when it is flushed or destroyed.
+
+ Once all threads are done, GetResult() returns an ordinary histogram, identical to one
+ filled with the same entries (up to the rounding of sums done in a different order).
+
+ The axes of the model histogram must not be extendable, and it must not be a TProfile2D
+ or TProfile3D.
+
+ ~~~{.cpp}
+ TH1D model("h", "h", 100, 0, 1);
+ ROOT::Experimental::TH1ConcurrentFillManager manager(model, 4);
+ // in each thread:
+ {
+    auto filler = manager.MakeFiller();
+    for (...)
+       filler.Fill(x, w);
+ }
+ std::unique_ptr<TH1> h = manager.GetResult();
+ ~~~
+*/
+class TH1ConcurrentFillManager {
+   friend class TH1ConcurrentFiller;
+
+   /// The statistics of a shard, in the layout of TH1::GetStats(), alone in their cache line(s)
+   struct alignas(64) Stats {
+      std::atomic<Double_t> fSums[TH1::kNstat];
+      std::atomic<Long64_t> fEntries{0};
+      Stats();
+   };
+
+   std::unique_ptr<TH1> fModel;  ///< Empty copy of the histogram, for its axes and type
+   Int_t fDimension = 1;         ///< Dimension of the histogram
+   Bool_t fIsProfile = kFALSE;   ///< Whether the histogram is a TProfile
+   Int_t fNStats = 4;            ///< Number of statistics of the histogram
+   Int_t fNArrays = 2;           ///< Number of sums per bin: 2, or 4 for a TProfile
+   Int_t fNcells = 0;            ///< Number of bins, including under- and overflows
+   std::vector<std::unique_ptr<std::atomic<Double_t>[]>> fShards; ///< Sums per bin, fNArrays arrays per shard
+   std::unique_ptr<Stats[]> fStats;                              ///< Statistics per shard
+   std::atomic<Bool_t> fWeighted{kFALSE}; ///< Whether a weight different from 1 has been filled
+
+   unsigned int GetShardIndex() const;
+   Int_t FindBin(Double_t x, Double_t y, Double_t z, Bool_t &inRange) const;
+   Bool_t FillBin(unsigned int shard, Double_t x, Double_t y, Double_t z, Double_t w, Double_t *stats);
+   void FillImpl(Double_t x, Double_t y, Double_t z, Double_t w);
+   void AddStats(unsigned int shard, const Double_t *stats, Long64_t entries);
+
+public:
+   TH1ConcurrentFillManager(const TH1 &model, unsigned int nShards = 1);
+   ~TH1ConcurrentFillManager();
+   TH1ConcurrentFillManager(const TH1ConcurrentFillManager &) = delete;
+   TH1ConcurrentFillManager &operator=(const TH1ConcurrentFillManager &) = delete;
+
+   /// Fill x with weight 1.
+   void Fill(Double_t x) { FillImpl(x, 0, 0, 1.); }
+   /// As for the histogram: fill x with weight w for a 1D histogram, (x,y) for a 2D histogram or a TProfile.
+   void Fill(Double_t x, Double_t yw)
+   {
+      if (fDimension == 1 && !fIsProfile)
+         FillImpl(x, 0, 0, yw);
+      else
+         FillImpl(x, yw, 0, 1.);
+   }
+   /// As for the histogram: fill (x,y) with weight w for a 2D histogram or a TProfile, (x,y,z) for a 3D histogram.
+   void Fill(Double_t x, Double_t y, Double_t zw)
+   {
+      if (fDimension == 3)
+         FillImpl(x, y, zw, 1.);
+      else
+         FillImpl(x, y, 0, zw);
+   }
+   /// Fill (x,y,z) with weight w, for a 3D histogram.
+   void Fill(Double_t x, Double_t y, Double_t z, Double_t w) { FillImpl(x, y, z, w); }
+
+   /// Return a filler for the calling thread, that accumulates the statistics locally.
+   TH1ConcurrentFiller MakeFiller();
+
+   /// Return a new histogram with the filled entries. Must not be called while filling.
+   std::unique_ptr<TH1> GetResult() const;
+};
+
+/**
+ \class ROOT::Experimental::TH1ConcurrentFiller
+ \ingroup Hist
+ Fills the histogram of a TH1ConcurrentFillManager from one thread. The bins are updated
+ directly, the statistics are added to the manager by Flush() and by the destructor.
+ Fill() has the same signatures as in TH1ConcurrentFillManager.
+*/
+class TH1ConcurrentFiller {
+   TH1ConcurrentFillManager *fManager;
+   unsigned int fShard;
+   Double_t fStats[TH1::kNstat] = {};
+   Long64_t fEntries = 0;
+
+   void FillImpl(Double_t x, Double_t y, Double_t z, Double_t w)
+   {
+      if (fManager->FillBin(fShard, x, y, z, w, fStats))
+         ++fEntries;
+   }
+
+public:
+   TH1ConcurrentFiller(TH1ConcurrentFillManager &manager)
+      : fManager(&manager), fShard(manager.GetShardIndex())
+   {
+   }
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller(TH1ConcurrentFiller &&other)
+      : fManager(other.fManager), fShard(other.fShard), fEntries(other.fEntries)
+   {
+      std::copy(std::begin(other.fStats), std::end(other.fStats), std::begin(fStats));
+      other.fManager = nullptr;
+   }
+   ~TH1ConcurrentFiller() { Flush(); }
+
+   void Fill(Double_t x) { FillImpl(x, 0, 0, 1.); }
+   void Fill(Double_t x, Double_t yw)
+   {
+      if (fManager->fDimension == 1 && !fManager->fIsProfile)
+         FillImpl(x, 0, 0, yw);
+      else
+         FillImpl(x, yw, 0, 1.);
+   }
+   void Fill(Double_t x, Double_t y, Double_t zw)
+   {
+      if (fManager->fDimension == 3)
+         FillImpl(x, y, zw, 1.);
+      else
+         FillImpl(x, y, 0, zw);
+   }
+   void Fill(Double_t x, Double_t y, Double_t z, Double_t w) { FillImpl(x, y, z, w); }
+
+   /// Add the statistics accumulated so far to the manager.
+   void Flush()
+   {
+      if (!fManager || !fEntries)
+         return;
+      fManager->AddStats(fShard, fStats, fEntries);
+      std::fill(std::begin(fStats), std::end(fStats), 0.);
+      fEntries = 0;
+   }
+};
+
+inline TH1ConcurrentFiller TH1ConcurrentFillManager::MakeFiller()
+{
+   return TH1ConcurrentFiller(*this);
+}
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
@@ -96,7 +96,7 @@ private:
    Bool_t            fReadyToExecute;              ///<! Transient to force initialization
    std::atomic<Bool_t>  fClingInitialized;         ///<! Transient to force re-initialization
    Bool_t            fAllParametersSetted;         ///<  Flag to control if all parameters are setted
-   Bool_t            fLazyInitialization = kFALSE; ///<! Transient flag to control lazy initialization (needed for reading from files)
+   std::atomic<Bool_t> fLazyInitialization{kFALSE}; ///<! Transient flag to control lazy initialization (needed for reading from files)
    std::unique_ptr<TMethodCall> fMethod;           ///<! Pointer to methodcall
    TString           fClingName;                   ///<! Unique name passed to Cling to define the function ( double clingName(double*x, double*p) )
    std::string       fSavedInputFormula;           ///<! Unique name used to defined the function and used in the global map (need to be saved in case of lazy initialization)
@@ -271,6 +271,7 @@ public:
    Bool_t         IsValid() const { return fReadyToExecute && fClingInitialized; }
    Bool_t IsVectorized() const { return fVectorized; }
    Bool_t         IsLinear() const { return TestBit(kLinear); }
+   static Bool_t  LoadCompiledFormulas(const char *library);
    void           Print(Option_t *option = "") const override;
    void           SetName(const char* name) override;
    void           SetParameter(const char* name, Double_t value);
@@ -285,6 +286,7 @@ public:
    void           SetVariable(const TString &name, Double_t value);
    void           SetVariables(const std::pair<TString,Double_t> *vars, const Int_t size);
    void SetVectorized(Bool_t vectorized);
+   static Int_t   WriteCompiledFormulas(const char *fileName);
 
    ClassDefOverride(TFormula,14)
 };
@@ -29,6 +29,8 @@
 #include "TVectorDfwd.h"
 #include "TFitResultPtr.h"
 
+#include <atomic>
+
 class TBrowser;
 class TAxis;
 class TH1;
@@ -51,6 +53,7 @@ protected:
    Double_t           fMinimum;   ///< Minimum value for plotting along y
    Double_t           fMaximum;   ///< Maximum value for plotting along y
    TString fOption;               ///< Options used for drawing the graph
+   mutable std::atomic<Int_t> fEvalHint{0}; ///<! Point found by the last search of Eval(), where the next one starts
 
    static void        SwapValues(Double_t* arr, Int_t pos1, Int_t pos2);
    virtual void       SwapPoints(Int_t pos1, Int_t pos2);
@@ -65,6 +68,8 @@ protected:
    virtual void       FillZero(Int_t begin, Int_t end, Bool_t from_ctor = kTRUE);
    Double_t         **ShrinkAndCopy(Int_t size, Int_t iend);
    virtual Bool_t     DoMerge(const TGraph * g);
+   Int_t              FindSortedX(Double_t x, Int_t hint) const;
+   Double_t           InterpolateSorted(Double_t x, Int_t low) const;
 
    TString            SaveArray(std::ostream &out, const char *suffix, Int_t frameNumber, Double_t *arr);
    void               SaveHistogramAndFunctions(std::ostream &out, const char *varname, Int_t &frameNumber, Option_t *option);
@@ -112,6 +117,7 @@ public:
    virtual void          DrawGraph(Int_t n, const Double_t *x=nullptr, const Double_t *y=nullptr, Option_t *option="");
    virtual void          DrawPanel(); // *MENU*
    virtual Double_t      Eval(Double_t x, TSpline *spline=nullptr, Option_t *option="") const;
+   void                  Eval(Int_t n, const Double_t *x, Double_t *y) const;
    void                  ExecuteEvent(Int_t event, Int_t px, Int_t py) override;
    virtual void          Expand(Int_t newsize);
    virtual void          Expand(Int_t newsize, Int_t step);
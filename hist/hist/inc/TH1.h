@@ -149,7 +149,6 @@ protected:
                                Option_t * opt, Bool_t doerr = kFALSE) const;
 
    virtual void     DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride=1);
-   Bool_t    GetStatOverflowsBehaviour() const { return EStatOverflows::kNeutral == fStatOverflows ? fgStatOverflows : EStatOverflows::kConsider == fStatOverflows; }
 
    static bool CheckAxisLimits(const TAxis* a1, const TAxis* a2);
    static bool CheckBinLimits(const TAxis* a1, const TAxis* a2);
@@ -172,7 +171,8 @@ public:
       kIsNotW      = BIT(19),  ///< Histogram is forced to be not weighted even when the histogram is filled with weighted
                                /// different than 1.
       kAutoBinPTwo = BIT(20),  ///< Use Power(2)-based algorithm for autobinning
-      kIsHighlight = BIT(21)   ///< bit set if histo is highlight
+      kIsHighlight = BIT(21),  ///< bit set if histo is highlight
+      kLazySumw2   = BIT(22)   ///< Sum of squares of weights requested but not created while weights are 1, see SetLazySumw2()
    };
    /// Size of statistics data (size of  array used in GetStats()/ PutStats )
    ///  - s[0]  = sumw       s[1]  = sumw2
@@ -321,6 +321,7 @@ public:
 
    virtual Double_t GetSkewness(Int_t axis=1) const;
            EStatOverflows GetStatOverflows() const { return fStatOverflows; } ///< Get the behaviour adopted by the object about the statoverflows. See EStatOverflows for more information.
+           Bool_t   GetStatOverflowsBehaviour() const { return EStatOverflows::kNeutral == fStatOverflows ? fgStatOverflows : EStatOverflows::kConsider == fStatOverflows; } ///< Whether under/overflows are used in the statistics, resolving kNeutral with the global flag
            TAxis*   GetXaxis()  { return &fXaxis; }
            TAxis*   GetYaxis()  { return &fYaxis; }
            TAxis*   GetZaxis()  { return &fZaxis; }
@@ -395,6 +396,7 @@ public:
    virtual void     SetLabelFont(Style_t font=62, Option_t *axis="X");
    virtual void     SetLabelOffset(Float_t offset=0.005, Option_t *axis="X");
    virtual void     SetLabelSize(Float_t size=0.02, Option_t *axis="X");
+           void     SetLazySumw2(Bool_t lazy = kTRUE);
 
    /*
     * Set the minimum / maximum value for the Y axis (1-D histograms) or Z axis (2-D histograms)
@@ -41,6 +41,8 @@ public:
    Double_t  GetYMax();
    Double_t  GetYMin();
    Bool_t    IsInside(Double_t x, Double_t y) const;
+   /// True if (x,y) is inside the bounding box of the bin, which must have been computed (GetXMin() etc.)
+   Bool_t    IsInsideBoundingBox(Double_t x, Double_t y) const { return x >= fXmin && x <= fXmax && y >= fYmin && y <= fYmax; }
    void      SetChanged(Bool_t flag){fChanged = flag;}
    void      SetContent(Double_t content){fContent = content; SetChanged(true);}
 
@@ -152,6 +154,10 @@ protected:
    void         SetBinError(Int_t, Int_t, Int_t, Double_t) override {}     ///< NOT IMPLEMENTED for TH2Poly
 
 
+protected:
+   Int_t        FindBinInPartition(Double_t x, Double_t y, TH2PolyBin *&bin) const;
+   void         FillFoundBin(Int_t binnr, TH2PolyBin *bin, Double_t x, Double_t y, Double_t w);
+
 protected:
     enum {
       kNOverflow = 9  /// Number of overflows bins
@@ -32,6 +32,7 @@ class THn: public THnBase {
 protected:
    void AllocCoordBuf() const;
    void InitStorage(Int_t* nbins, Int_t chunkSize) override;
+   Bool_t AddSameBinning(const std::vector<const THnBase*>& hists) override;
 
    THn() = default;
    THn(const char* name, const char* title, Int_t dim, const Int_t* nbins,
@@ -26,6 +26,8 @@
 #include "TObjArray.h"
 #include "TArrayD.h"
 
+#include <vector>
+
 class TAxis;
 class TH1;
 class TH1D;
@@ -111,6 +113,10 @@ protected:
                           Bool_t wantNDim, Option_t* option = "") const;
    Bool_t PrintBin(Long64_t idx, Int_t* coord, Option_t* options) const;
    void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
+   void AddStatistics(const THnBase* h, Double_t c);
+   /// Add the bin contents of hists, if they all have the same binning as this histogram and
+   /// the storage allows adding them bin by bin. Returns false (doing nothing) otherwise.
+   virtual Bool_t AddSameBinning(const std::vector<const THnBase*>& /*hists*/) { return kFALSE; }
    THnBase* RebinBase(Int_t group) const;
    THnBase* RebinBase(const Int_t* group) const;
    void ResetBase(Option_t *option= "");
@@ -123,6 +123,7 @@ public:
    void SetUseBinsNEvents(UInt_t nEvents);
    void SetTuneFactor(Double_t rho);
    void SetRange(Double_t xMin, Double_t xMax); ///< By default computed from the data
+   void SetFastEvaluation(Double_t tolerance = 1.E-4);
 
    void Draw(const Option_t* option = "") override;
 
@@ -130,6 +131,7 @@ public:
    Double_t operator()(const Double_t* x, const Double_t* p = nullptr) const;  // Needed for creating TF1
 
    Double_t GetValue(Double_t x) const { return (*this)(x); }
+   void Evaluate(UInt_t n, const Double_t* x, Double_t* y) const;
    Double_t GetError(Double_t x) const;
 
    Double_t GetBias(Double_t x) const;
@@ -164,6 +166,9 @@ public:
       TKDE *fKDE;
       UInt_t fNWeights;               ///< Number of kernel weights (bandwidth as vectorized for binning)
       std::vector<Double_t> fWeights; ///< Kernel weights (bandwidth)
+      std::vector<Double_t> fGrid;    ///< Density tabulated on a uniform grid over the range, for the fast evaluation
+      Double_t fGridStep = 0.;        ///< Step of the grid
+      Double_t fGridTolerance = 0.;   ///< Tolerance the grid was computed with, 0 if there is no grid
    public:
       TKernel(Double_t weight, TKDE *kde);
       void ComputeAdaptiveWeights();
@@ -171,6 +176,9 @@ public:
       Double_t GetWeight(Double_t x) const;
       Double_t GetFixedWeight() const;
       const std::vector<Double_t> &GetAdaptiveWeights() const;
+      void ComputeGrid(Double_t tolerance);
+      Double_t GetGridTolerance() const { return fGridTolerance; }
+      Double_t GetGridValue(Double_t x) const;
    };
 
    friend class TKernel;
@@ -221,6 +229,7 @@ private:
    Double_t fAdaptiveBandwidthFactor;  ///< Geometric mean of the kernel density estimation from the data for adaptive iteration
 
    Double_t fWeightSize;               ///< Caches the weight size
+   Double_t fGridTolerance;            ///< Tolerance of the tabulated fast evaluation, 0 if not used
 
    std::vector<Double_t> fCanonicalBandwidths;
    std::vector<Double_t> fKernelSigmas2;
@@ -298,7 +307,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDefOverride(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDefOverride(TKDE, 4) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
@@ -81,6 +81,12 @@ public:
    virtual Double_t AtAsDouble(ULong64_t linidx) const = 0;
    virtual void SetAsDouble(ULong64_t linidx, Double_t value) = 0;
    virtual void AddAt(ULong64_t linidx, Double_t value) = 0;
+   /// Add the elements [first, last) of other, an array with the same layout.
+   /// This array must already be allocated (e.g. by AddAt()) when called concurrently.
+   virtual void AddRange(const TNDArray& other, ULong64_t first, ULong64_t last) {
+      for (ULong64_t i = first; i < last; ++i)
+         AddAt(i, other.AtAsDouble(i));
+   }
 
 protected:
    std::vector<Long64_t> fSizes; ///< bin count
@@ -165,6 +171,21 @@ public:
          fData.resize(fSizes[0], T());
       fData[linidx] += (T) value;
    }
+   void AddRange(const TNDArray& other, ULong64_t first, ULong64_t last) override {
+      const TNDArrayT<T>* same = dynamic_cast<const TNDArrayT<T>*>(&other);
+      if (!same) {
+         TNDArray::AddRange(other, first, last);
+         return;
+      }
+      if (same->fData.empty())
+         return;
+      if (fData.empty())
+         fData.resize(fSizes[0], T());
+      T* data = fData.data();
+      const T* otherData = same->fData.data();
+      for (ULong64_t i = first; i < last; ++i)
+         data[i] += otherData[i];
+   }
 
 protected:
    std::vector<T> fData;   // data
@@ -16,6 +16,9 @@
 #include "TVectorD.h"
 #include "TMatrixD.h"
 
+#include <cstddef>
+
+class TCollection;
 class TList;
 
 class TPrincipal : public TNamed {
@@ -42,9 +45,6 @@ protected:
    Bool_t      fIsNormalised;         ///< Normalize matrix?
    Bool_t      fStoreData;            ///< Should we store input data?
 
-   TPrincipal(const TPrincipal&);
-   TPrincipal& operator=(const TPrincipal&);
-
    void        MakeNormalised();
    void        MakeRealCode(const char *filename, const char *prefix, Option_t *option="");
 
@@ -52,8 +52,27 @@ public:
    TPrincipal();
    ~TPrincipal() override;
    TPrincipal(Long64_t nVariables, Option_t *opt="ND");
+   TPrincipal(const TPrincipal&);
+   TPrincipal& operator=(const TPrincipal&);
 
    virtual void       AddRow(const Double_t *x);
+   virtual void       AddRows(Long64_t nRows, const Double_t *x);
+   /// Add a data point given by its fNumberOfVariables values, e.g. to fill the
+   /// object from the columns of an RDataFrame, in parallel with implicit multithreading:
+   /// ~~~{.cpp}
+   /// auto pca = df.Fill(TPrincipal(3, "N"), {"x", "y", "z"});
+   /// pca->MakePrincipals();
+   /// ~~~
+   template <typename... Values>
+   void               Fill(Values... values)
+   {
+      const Double_t row[] = {static_cast<Double_t>(values)...};
+      if (sizeof...(Values) != static_cast<std::size_t>(fNumberOfVariables)) {
+         Error("Fill", "%d values given for %d variables", static_cast<Int_t>(sizeof...(Values)), fNumberOfVariables);
+         return;
+      }
+      AddRow(row);
+   }
    void       Browse(TBrowser *b) override;
    void       Clear(Option_t *option="") override;
    /// Return the covariance matrix. \note Only the lower diagonal of the covariance matrix is computed by the class
@@ -70,6 +89,7 @@ public:
    virtual void       MakeHistograms(const char *name = "pca", Option_t *option="epsdx"); // *MENU*
    virtual void       MakeMethods(const char *classname = "PCA", Option_t *option=""); // *MENU*
    virtual void       MakePrincipals();            // *MENU*
+   Long64_t           Merge(TCollection *list);
    virtual void       P2X(const Double_t *p, Double_t *x, Int_t nTest);
    void       Print(Option_t *opt="MSE") const override;         // *MENU*
    virtual void       SumOfSquareResiduals(const Double_t *x, Double_t *s);
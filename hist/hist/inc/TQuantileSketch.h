@@ -0,0 +1,70 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TQuantileSketch
+#define ROOT_TQuantileSketch
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TQuantileSketch                                                      //
+//                                                                      //
+// Streaming, mergeable approximation of the quantiles of a dataset     //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TNamed.h"
+
+#include <vector>
+
+class TCollection;
+
+class TQuantileSketch : public TNamed {
+
+protected:
+   Double_t fCompression{100.};    ///< Compression: upper bound on the number of centroids
+   Double_t fSumW{0.};             ///< Sum of weights of all entries
+   Double_t fMin;                  ///< Smallest value filled
+   Double_t fMax;                  ///< Largest value filled
+   Long64_t fEntries{0};           ///< Number of entries
+   std::vector<Double_t> fMeans;   ///< Means of the centroids, in increasing order
+   std::vector<Double_t> fWeights; ///< Weights of the centroids
+   std::vector<Double_t> fBufferX; ///< Values filled since the last compression
+   std::vector<Double_t> fBufferW; ///< Weights of the values in fBufferX
+
+   void AddCentroids(const std::vector<Double_t> &means, const std::vector<Double_t> &weights);
+   std::size_t GetBufferSize() const { return 5 * std::size_t(fCompression) + 50; }
+
+public:
+   TQuantileSketch();
+   TQuantileSketch(const char *name, const char *title, Double_t compression = 100.);
+
+   void Fill(Double_t x) { Fill(x, 1.); }
+   void Fill(Double_t x, Double_t w);
+   void FillN(Int_t n, const Double_t *x, const Double_t *w, Int_t stride = 1);
+   void Compress();
+   Long64_t Merge(TCollection *list);
+   void Reset(Option_t *option = "");
+   void Print(Option_t *option = "") const override;
+
+   Double_t GetCompression() const { return fCompression; }
+   Long64_t GetEntries() const { return fEntries; }
+   Double_t GetSumOfWeights() const { return fSumW; }
+   Double_t GetMinimum() const { return fMin; }
+   Double_t GetMaximum() const { return fMax; }
+   Int_t GetNCentroids() const;
+
+   Double_t GetQuantile(Double_t prob) const;
+   Int_t GetQuantiles(Int_t nprobSum, Double_t *q, const Double_t *probSum) const;
+   Double_t GetCDF(Double_t x) const;
+
+   ClassDefOverride(TQuantileSketch, 1) // Streaming, mergeable approximation of quantiles (t-digest)
+};
+
+#endif
@@ -29,6 +29,7 @@ class TVirtualGraphPainter : public TObject {
 
 private:
    static TVirtualGraphPainter   *fgPainter; //Pointer to class painter
+   static Int_t                   fgDecimationThreshold; //Number of points above which graphs are decimated when painted
 
 public:
    TVirtualGraphPainter() { }
@@ -47,6 +48,8 @@ public:
 
    static TVirtualGraphPainter *GetPainter();
    static void                  SetPainter(TVirtualGraphPainter *painter);
+   static Int_t                 GetDecimationThreshold();
+   static void                  SetDecimationThreshold(Int_t npoints);
 
    ClassDefOverride(TVirtualGraphPainter,0)  //Abstract interface for histogram painters
 };
@@ -6,6 +6,7 @@
 #include "TF1.h"
 #include "TF2.h"
 #include "TF3.h"
+#include "TFormula.h"
 #include "TError.h"
 #include "TGraph.h"
 #include "TMultiGraph.h"
@@ -35,10 +36,14 @@
 #include "TFitResultPtr.h"
 #include "TFitResult.h"
 
+#include <algorithm>
+#include <cctype>
 #include <cstdlib>
 #include <cmath>
 #include <memory>
 #include <limits>
+#include <set>
+#include <string>
 
 //#define DEBUG
 
@@ -55,6 +60,14 @@ namespace HFit {
 
    int CheckFitFunction(const TF1 * f1, int hdim);
 
+   bool IsVectorizableFormula(const TF1 & f1);
+
+   // Minimal numbers of fit points to use automatically the vectorized evaluation of a formula
+   // and the multi-threaded evaluation of the objective function. For smaller fits, the overhead
+   // of the vectorized interface and of the thread pool dominates.
+   constexpr unsigned int kMinSizeVectorized = 256;
+   constexpr unsigned int kMinSizeMultiThread = 10000;
+
 
    void GetFunctionRange(const TF1 & f1, ROOT::Fit::DataRange & range);
 
@@ -116,6 +129,56 @@ int HFit::CheckFitFunction(const TF1 * f1, int dim) {
 
 }
 
+bool HFit::IsVectorizableFormula(const TF1 & f1) {
+   // Check whether the formula of f1 only uses functions that have a vectorized
+   // implementation, so it can be compiled with the ROOT::Double_v signature.
+   // This is a conservative check on the expression given by the user.
+   const TFormula *formula = f1.GetFormula();
+   if (!formula || formula->IsVectorized() || formula->GetNdim() == 0)
+      return false;
+   static const std::set<std::string> allowed{"x",   "y",     "z",    "t",     "pi",   "gaus", "expo",  "sin",
+                                              "cos", "tan",   "asin", "acos",  "atan", "atan2", "exp",  "log",
+                                              "log10", "sqrt", "cbrt", "pow",  "abs",  "ceil", "floor", "min",
+                                              "max", "sign"};
+   const std::string expr = formula->GetTitle();
+   std::size_t i = 0;
+   while (i < expr.size()) {
+      const char c = expr[i];
+      if (c == '[') {
+         // parameter names can be arbitrary
+         i = expr.find(']', i);
+         if (i == std::string::npos)
+            return false;
+         ++i;
+      } else if (std::isdigit(c) || c == '.') {
+         // skip numbers, including their exponent
+         while (i < expr.size() && (std::isdigit(expr[i]) || expr[i] == '.'))
+            ++i;
+         if (i < expr.size() && (expr[i] == 'e' || expr[i] == 'E')) {
+            ++i;
+            if (i < expr.size() && (expr[i] == '+' || expr[i] == '-'))
+               ++i;
+         }
+      } else if (std::isalpha(c) || c == '_') {
+         std::size_t end = i;
+         while (end < expr.size() && (std::isalnum(expr[end]) || expr[end] == '_'))
+            ++end;
+         const std::string name = expr.substr(i, end - i);
+         const bool isPolN = name.size() > 3 && name.compare(0, 3, "pol") == 0 &&
+                             std::all_of(name.begin() + 3, name.end(), [](char d) { return std::isdigit(d); });
+         if (!isPolN && allowed.count(name) == 0)
+            return false;
+         i = end;
+      } else if (c == ':' || c == '"' || c == '{') {
+         // namespaced functions and other C++ constructs
+         return false;
+      } else {
+         ++i;
+      }
+   }
+   return true;
+}
+
 
 void HFit::GetFunctionRange(const TF1 & f1, ROOT::Fit::DataRange & range) {
    // get the range form the function and fill and return the DataRange object
@@ -235,6 +298,35 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
    }
 
 
+#ifdef R__HAS_CLAD
+   // use by default the gradient of formula functions computed by automatic differentiation (with clad):
+   // the minimizer then does not need to compute numerically the derivatives of the objective function
+   if (fitOption.AutoGradient && !fitOption.Gradient && !linear && !fitOption.User && !fitOption.Integral &&
+       !fitOption.PChi2 && !fitdata->HaveCoordErrors() && !f1->IsVectorized() && f1->GetFormula() &&
+       f1->GetFormula()->IsValid()) {
+      if (f1->GetFormula()->GenerateGradientPar())
+         fitOption.Gradient = 1;
+   }
+#endif
+
+   // choose the evaluation of the fit according to the data size, unless the user asked explicitly for one
+   bool autoVectorized = false;
+   if (fitOption.AutoExecPolicy) {
+      if (fitOption.ExecPolicy == ROOT::EExecutionPolicy::kMultiThread && fitdata->Size() < HFit::kMinSizeMultiThread)
+         fitOption.ExecPolicy = ROOT::EExecutionPolicy::kSequential;
+#ifdef R__HAS_VECCORE
+      if (!linear && !fitOption.Gradient && !fitOption.User && fitdata->Size() >= HFit::kMinSizeVectorized &&
+          HFit::IsVectorizableFormula(*f1)) {
+         f1->SetVectorized(true);
+         autoVectorized = f1->IsVectorized();
+         if (autoVectorized && !f1->GetFormula()->IsValid()) {
+            f1->SetVectorized(false);
+            autoVectorized = false;
+         }
+      }
+#endif
+   }
+
    // set the fit function
    // if option grad is specified use gradient
    if ( (linear || fitOption.Gradient) )
@@ -379,6 +471,10 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
       Warning("Fit","Abnormal termination of minimization.");
    iret |= !fitok;
 
+   // give back the function to the user as it was
+   if (autoVectorized)
+      f1->SetVectorized(false);
+
 
    const ROOT::Fit::FitResult & fitResult = fitter->Result();
    // one could set directly the fit result in TF1
@@ -695,6 +791,12 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
    TString opt = option;
    opt.ToUpper();
 
+   // parse first the options which contain letters of other options
+   if (opt.Contains("NUMGRAD")) {
+      fitOption.AutoGradient = 0;
+      opt.ReplaceAll("NUMGRAD","");
+   }
+
    // parse firt the specific options
    if (type == EFitObjectType::kHistogram) {
 
@@ -717,11 +819,13 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
 
       if (opt.Contains("SERIAL")) {
          fitOption.ExecPolicy = ROOT::EExecutionPolicy::kSequential;
+         fitOption.AutoExecPolicy = 0;
          opt.ReplaceAll("SERIAL","");
       }
 
       if (opt.Contains("MULTITHREAD")) {
          fitOption.ExecPolicy = ROOT::EExecutionPolicy::kMultiThread;
+         fitOption.AutoExecPolicy = 0;
          opt.ReplaceAll("MULTITHREAD","");
       }
 
@@ -0,0 +1,57 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_HistParallel
+#define ROOT_HistParallel
+
+#include "RConfigure.h"
+#include "Rtypes.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace ROOT {
+namespace Internal {
+namespace Hist {
+
+/// Minimal number of operations of a loop for it to be run in parallel
+constexpr Long64_t kParallelWork = 1 << 20;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(i) for i in [0, n). The calls must be independent of each other;
+/// they are run in parallel when implicit multithreading is enabled and the
+/// loop performs at least kParallelWork operations in total. Callers that need
+/// results independent of the number of threads reduce per-task partial results
+/// in the order of the tasks.
+
+template <class F>
+void Foreach(Int_t n, Long64_t work, F &&func)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && n > 1 && work >= kParallelWork) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(func, ROOT::TSeqI(n));
+      return;
+   }
+#else
+   (void)work;
+#endif
+   for (Int_t i = 0; i < n; i++)
+      func(i);
+}
+
+} // namespace Hist
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -434,6 +434,53 @@ Int_t TAxis::FindFixBin(Double_t x) const
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the bin numbers of the n abscissas x[0], x[stride], ..., x[(n-1)*stride]
+/// and store them in bins[0], ..., bins[n-1].
+///
+/// Equivalent to calling TAxis::FindFixBin for each value, but the loops have no
+/// branches: for fixed bins the bin index is computed arithmetically for all values
+/// and for variable bins a branch-free binary search is used, so that the compiler
+/// can vectorize them.
+
+void TAxis::FindFixBins(Int_t n, const Double_t *x, Int_t *bins, Int_t stride) const
+{
+   const Double_t xmin = fXmin;
+   const Double_t xmax = fXmax;
+   const Int_t overflow = fNbins + 1;
+   if (!fXbins.fN) {        //*-* fix bins
+      const Double_t nbins = fNbins;
+      const Double_t width = xmax - xmin;
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i * stride];
+         const bool under = xi < xmin;
+         const bool over = !(xi < xmax);  // note the way to catch NaN
+         // out of range values are replaced before the conversion to int, that could overflow
+         const Double_t xc = (under || over) ? xmin : xi;
+         const Int_t bin = 1 + int(nbins * (xc - xmin) / width);
+         bins[i] = under ? 0 : (over ? overflow : bin);
+      }
+   } else {                  //*-* variable bin sizes
+      const Double_t *edges = fXbins.fArray;
+      const Int_t nedges = fXbins.fN;
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i * stride];
+         const bool under = xi < xmin;
+         const bool over = !(xi < xmax);
+         // index of the last edge <= xi, as TMath::BinarySearch
+         const Double_t *base = edges;
+         Int_t len = nedges;
+         while (len > 1) {
+            const Int_t half = len / 2;
+            base = (base[half] <= xi) ? base + half : base;
+            len -= half;
+         }
+         const Int_t bin = 1 + Int_t(base - edges);
+         bins[i] = under ? 0 : (over ? overflow : bin);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return label for bin
 
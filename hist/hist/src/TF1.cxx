@@ -17,6 +17,8 @@
 #include "TBuffer.h"
 #include "TMath.h"
 #include "TF1.h"
+#include "TF2.h"
+#include "TF3.h"
 #include "TH1.h"
 #include "TGraph.h"
 #include "TVirtualPad.h"
@@ -1528,6 +1530,41 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate function with given coordinates and parameters, without modifying the function.
+///
+/// Contrary to TF1::EvalPar, this function can be called concurrently by several threads
+/// on the same TF1 object (e.g. in the tasks of an RDataFrame event loop with implicit
+/// multi-threading), without cloning the function or locking, in these cases:
+///  - functions defined by a formula expression. The formula is compiled only once, also
+///    when the function is read from a file;
+///  - functions defined by a C++ callable object, whose call operator must be thread safe.
+///
+/// The parameters are passed explicitly. If params is nullptr, the current parameters of the
+/// function are used, and they must not be changed at the same time by another thread.
+/// Interpreted functions, compositions of functions and classes deriving from TF1 (other than
+/// TF2 and TF3) are evaluated with TF1::EvalPar while holding the global ROOT lock.
+/// As for TF1::EvalPar, the normalization of normalized functions uses the integral computed
+/// with the current parameters.
+
+Double_t TF1::EvalParConst(const Double_t *x, const Double_t *params) const
+{
+   const bool isBaseClass = (IsA() == TF1::Class() || IsA() == TF2::Class() || IsA() == TF3::Class());
+   if (isBaseClass && fType == EFType::kFormula) {
+      const Double_t result = fFormula->EvalPar(x, params);
+      return (fNormalized && fNormIntegral != 0) ? result / fNormIntegral : result;
+   }
+   if (isBaseClass && fFunctor && (fType == EFType::kPtrScalarFreeFcn || fType == EFType::kTemplScalar)) {
+      if (!params) params = fParams->GetParameters();
+      const Double_t result = ((TF1FunctorPointerImpl<Double_t> *)fFunctor.get())->fImpl(x, params);
+      return (fNormalized && fNormIntegral != 0) ? result / fNormIntegral : result;
+   }
+
+   // the other types of functions store the evaluation arguments in the function object
+   R__LOCKGUARD(gROOTMutex);
+   return const_cast<TF1 *>(this)->EvalPar(x, params);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -20,11 +20,14 @@
 #include "TInterpreterValue.h"
 #include "TFormula.h"
 #include "TRegexp.h"
+#include "TSystem.h"
 
 #include "ROOT/StringUtils.hxx"
 
 #include <array>
 #include <iostream>
+#include <fstream>
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <functional>
@@ -263,6 +266,27 @@ static const TString gNamePrefix = "TFormula__";
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
 
+// source of the scalar formula expressions compiled with Cling, used to write a library of compiled formulas
+struct TFormulaSource {
+   std::string fCode; // definition of the function, as given to Cling
+   int fNargs;        // number of arguments of the function (variables and parameters)
+};
+static std::map<std::string, TFormulaSource> gClingFunctionSources;
+
+// names of the symbols of a library of compiled formulas (see TFormula::WriteCompiledFormulas)
+static const char *gCompiledKeysSymbol = "ROOT_TFormula_CompiledKeys";
+static const char *gCompiledFuncsSymbol = "ROOT_TFormula_CompiledFuncs";
+
+static void RegisterFormulaSource(const std::string &key, TString code, int nargs)
+{
+   // vectorized formulas cannot be compiled without VecCore, they are not saved
+   if (key.find(" (vectorized)") != std::string::npos)
+      return;
+   if (code.BeginsWith("#pragma"))
+      code.Remove(0, code.First('\n') + 1);
+   gClingFunctionSources.emplace(key, TFormulaSource{code.Data(), nargs});
+}
+
 static void R__v5TFormulaUpdater(Int_t nobjects, TObject **from, TObject **to)
 {
    auto **fromv5 = (ROOT::v5::TFormula **)from;
@@ -731,7 +755,7 @@ void TFormula::Copy(TObject &obj) const
    fnew.fAllParametersSetted = fAllParametersSetted;
    fnew.fClingName = fClingName;
    fnew.fSavedInputFormula = fSavedInputFormula;
-   fnew.fLazyInitialization = fLazyInitialization;
+   fnew.fLazyInitialization = fLazyInitialization.load();
 
    // case of function based on a C++  expression (lambda's) which is ready to be compiled
    if (fLambdaPtr && TestBit(TFormula::kLambda)) {
@@ -2363,6 +2387,7 @@ void TFormula::ProcessFormula(TString &formula)
                   // put function ptr in the static map
                   R__LOCKGUARD(gROOTMutex);
                   gClingFunctions.insert(std::make_pair(inputFormulaVecFlag, (void *)fFuncPtr));
+                  RegisterFormulaSource(inputFormulaVecFlag, fClingInput, hasParameters ? 2 : (hasVariables ? 1 : 0));
                }
             }
             if (!fClingInitialized) {
@@ -3204,6 +3229,9 @@ bool TFormula::GenerateGradientPar() {
    // formula. In that case, the hasher will give identical id and we can
    // reuse the already generated gradient function.
    if (!functionExists(GetGradientFuncName())) {
+      // the formula may come from a library of compiled formulas and be unknown to Cling
+      if (!functionExists(fClingName.Data()))
+         gInterpreter->Declare(fClingInput);
       std::string GradientCall
           ("clad::gradient(" + std::string(fClingName.Data()) + ", \"p\");");
       if (!DeclareGenerationInput(GetGradientFuncName(),
@@ -3269,6 +3297,9 @@ bool TFormula::GenerateHessianPar()
    // formula. In that case, the hasher will give identical id and we can
    // reuse the already generated hessian function.
    if (!functionExists(GetHessianFuncName())) {
+      // the formula may come from a library of compiled formulas and be unknown to Cling
+      if (!functionExists(fClingName.Data()))
+         gInterpreter->Declare(fClingInput);
       std::string indexes = (fNpar - 1 == 0) ? "0" : std::string("0:")
           + std::to_string(fNpar - 1);
       std::string HessianCall
@@ -3508,12 +3539,114 @@ void TFormula::ReInitializeEvalMethod() {
       // put function ptr in the static map
       R__LOCKGUARD(gROOTMutex);
       gClingFunctions.insert(std::make_pair(fSavedInputFormula, (void *)fFuncPtr));
+      RegisterFormulaSource(fSavedInputFormula, fClingInput, (fNpar > 0) ? 2 : ((fNdim > 0) ? 1 : 0));
    }
 
 
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the C++ source of a library containing all the (non vectorized) formula
+/// expressions compiled so far with Cling in this process.
+///
+/// Once the source is compiled into a shared library, for example with ACLiC
+/// (`.L formulas.cxx+`) or with the compiler and `root-config --cflags --libs`,
+/// TFormula::LoadCompiledFormulas() makes these expressions available to all the
+/// TFormula and TF1 objects created afterwards, which then do not need to be
+/// compiled by Cling at all.
+/// A typical use is to run once a job creating all the formulas, for example:
+/// ~~~ {.cpp}
+///    root -b -q 'createFunctions.C' -e 'TFormula::WriteCompiledFormulas("formulas.cxx")'
+/// ~~~
+/// Formulas calling user functions compile only if their declarations are added to the file.
+/// Returns the number of written expressions, or -1 if the file cannot be written.
+
+Int_t TFormula::WriteCompiledFormulas(const char *fileName)
+{
+   std::ofstream out(fileName);
+   if (!out) {
+      ::Error("TFormula::WriteCompiledFormulas", "Cannot open file %s", fileName);
+      return -1;
+   }
+
+   R__LOCKGUARD(gROOTMutex);
+   out << "// Library of formula expressions compiled ahead of time, written by TFormula::WriteCompiledFormulas.\n"
+       << "// Load it with TFormula::LoadCompiledFormulas().\n\n"
+       << "#include \"TMath.h\"\n"
+       << "#include \"Math/ChebyshevPol.h\"\n"
+       << "#include \"Math/PdfFuncMathCore.h\"\n"
+       << "#include \"Math/ProbFuncMathCore.h\"\n"
+       << "#include \"Math/SpecFuncMathCore.h\"\n\n"
+       << "namespace {\n\n";
+   std::vector<std::string> wrappers;
+   for (auto &entry : gClingFunctionSources) {
+      const TFormulaSource &source = entry.second;
+      const std::string name = source.fCode.substr(source.fCode.find(gNamePrefix.Data()),
+                                                   source.fCode.find('(') - source.fCode.find(gNamePrefix.Data()));
+      // wrapper with the signature of the functions generated by Cling (see TFormula::DoEval)
+      wrappers.push_back(name + "_wrapper");
+      out << source.fCode << "\n"
+          << "void " << wrappers.back() << "(void *, int, void **args, void *ret)\n{\n"
+          << "   *(Double_t *)ret = " << name << "(";
+      if (source.fNargs > 0)
+         out << "*(Double_t **)args[0]";
+      if (source.fNargs > 1)
+         out << ", *(Double_t **)args[1]";
+      out << ");\n}\n\n";
+   }
+   out << "} // anonymous namespace\n\n"
+       << "extern \"C\" {\n"
+       << "const char *" << gCompiledKeysSymbol << "[] = {\n";
+   for (auto &entry : gClingFunctionSources) {
+      std::string key;
+      for (char c : entry.first) {
+         if (c == '"' || c == '\\')
+            key += '\\';
+         key += c;
+      }
+      out << "   \"" << key << "\",\n";
+   }
+   out << "   nullptr};\n"
+       << "void (*" << gCompiledFuncsSymbol << "[])(void *, int, void **, void *) = {\n";
+   for (auto &wrapper : wrappers)
+      out << "   &" << wrapper << ",\n";
+   out << "   nullptr};\n"
+       << "}\n";
+
+   return wrappers.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load a library of formula expressions compiled ahead of time, written with
+/// TFormula::WriteCompiledFormulas().
+///
+/// The TFormula and TF1 objects created afterwards with one of these expressions
+/// use the compiled function directly instead of compiling their expression with Cling.
+/// Expressions are identified after the parsing of the formula, therefore all
+/// formulas that differ only by the names of their parameters or by white spaces share
+/// the same compiled function.
+/// Returns false if the library cannot be loaded or does not contain compiled formulas.
+
+Bool_t TFormula::LoadCompiledFormulas(const char *library)
+{
+   if (gSystem->Load(library) < 0) {
+      ::Error("TFormula::LoadCompiledFormulas", "Cannot load library %s", library);
+      return false;
+   }
+   auto keys = (const char **)gSystem->DynFindSymbol(library, gCompiledKeysSymbol);
+   auto funcs = (CallFuncSignature *)gSystem->DynFindSymbol(library, gCompiledFuncsSymbol);
+   if (!keys || !funcs) {
+      ::Error("TFormula::LoadCompiledFormulas", "Library %s does not contain compiled formulas", library);
+      return false;
+   }
+
+   R__LOCKGUARD(gROOTMutex);
+   for (int i = 0; keys[i] && funcs[i]; ++i)
+      gClingFunctions.emplace(keys[i], (void *)funcs[i]);
+   return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the expression formula.
 ///
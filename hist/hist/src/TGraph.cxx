@@ -33,6 +33,7 @@
 #include "TPluginManager.h"
 #include "strtok.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <string>
 #include <cassert>
@@ -949,6 +950,8 @@ void TGraph::DrawPanel()
 ///   If the points are sorted in X a binary search is used (significantly faster)
 ///   One needs to set the bit  TGraph::SetBit(TGraph::kIsSortedX) before calling
 ///   TGraph::Eval to indicate that the graph is sorted in X.
+///   The search starts from the points found by the previous call, so that it is
+///   fastest when x is close to the previous value.
 
 Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
 {
@@ -991,14 +994,9 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    Int_t low  = -1;
    Int_t up  = -1;
    if (TestBit(TGraph::kIsSortedX) ) {
-      low = TMath::BinarySearch(fNpoints, fX, x);
-      if (low == -1)  {
-         // use first two points for doing an extrapolation
-         low = 0;
-      }
-      if (fX[low] == x) return fY[low];
-      if (low == fNpoints-1) low--; // for extrapolating
-      up = low+1;
+      low = FindSortedX(x, fEvalHint.load(std::memory_order_relaxed));
+      fEvalHint.store(low, std::memory_order_relaxed);
+      return InterpolateSorted(x, low);
    }
    else {
       // case TGraph is not sorted
@@ -1042,6 +1040,81 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    return yn;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the linear interpolation of the graph (see Eval(Double_t, TSpline *, Option_t *))
+/// at the n points x, and store it in y.
+/// For a graph sorted in X (see TGraph::kIsSortedX) the search of each point starts from
+/// the one of the previous point, which makes it very fast if x is sorted or nearly so.
+
+void TGraph::Eval(Int_t n, const Double_t *x, Double_t *y) const
+{
+   if (fNpoints < 2 || !TestBit(TGraph::kIsSortedX)) {
+      for (Int_t i = 0; i < n; ++i)
+         y[i] = Eval(x[i]);
+      return;
+   }
+   Int_t low = fEvalHint.load(std::memory_order_relaxed);
+   for (Int_t i = 0; i < n; ++i) {
+      low = FindSortedX(x[i], low);
+      y[i] = InterpolateSorted(x[i], low);
+   }
+   fEvalHint.store(low, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the last point with fX <= x, or -1 if there is none, for a
+/// graph sorted in X. The search starts at the point hint and widens the interval
+/// it checks by doubling steps, so it takes log(distance to hint) comparisons.
+
+Int_t TGraph::FindSortedX(Double_t x, Int_t hint) const
+{
+   if (hint < 0 || hint >= fNpoints)
+      hint = 0;
+   Int_t lo, hi;  // the result is in [lo, hi)
+   if (fX[hint] <= x) {
+      if (hint == fNpoints - 1 || x < fX[hint + 1])
+         return hint;
+      lo = hint + 1;
+      Int_t step = 1;
+      hi = lo + step;
+      while (hi < fNpoints && fX[hi] <= x) {
+         lo = hi;
+         step *= 2;
+         hi = lo + step;
+      }
+      hi = std::min(hi, fNpoints);
+   } else {
+      hi = hint;
+      Int_t step = 1;
+      lo = hi - step;
+      while (lo >= 0 && fX[lo] > x) {
+         hi = lo;
+         step *= 2;
+         lo = hi - step;
+      }
+      lo = std::max(lo, -1);
+   }
+   // last point <= x among the points lo+1, ..., hi-1, or lo
+   return std::upper_bound(fX + lo + 1, fX + hi, x) - fX - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Linear interpolation at x of a graph sorted in X, given low = FindSortedX(x).
+/// Points outside the graph are extrapolated from the first or last two points.
+
+Double_t TGraph::InterpolateSorted(Double_t x, Int_t low) const
+{
+   if (low == -1)  {
+      // use first two points for doing an extrapolation
+      low = 0;
+   }
+   if (fX[low] == x) return fY[low];
+   if (low == fNpoints-1) low--; // for extrapolating
+   Int_t up = low+1;
+   if (fX[low] == fX[up]) return fY[low];
+   return fY[up] + (x - fX[up]) * (fY[low] - fY[up]) / (fX[low] - fX[up]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -1151,6 +1224,7 @@ TObject *TGraph::FindObject(const TObject *obj) const
 /// "B"  | Use this option when you want to fix one or more parameters and the fitting function is a predefined one (e.g gaus, expo,..), otherwise in case of pre-defined functions, some default initial values and limits are set.
 /// "C"  | In case of linear fitting, do no calculate the chisquare (saves CPU time).
 /// "G"  | Uses the gradient implemented in `TF1::GradientPar` for the minimization. This allows to use Automatic Differentiation when it is supported by the provided TF1 function.
+/// "NUMGRAD" | Does not use by default the gradient of formula functions computed with Automatic Differentiation (clad), and lets the minimizer compute numerically the derivatives.
 /// "EX0" | When fitting a TGraphErrors or TGraphAsymErrors do not consider errors in the X coordinates
 /// "ROB" | In case of linear fitting, compute the LTS regression coefficients (robust (resistant) regression), using the default fraction of good points "ROB=0.x" - compute the LTS regression coefficients, using 0.x as a fraction of good points
 ///
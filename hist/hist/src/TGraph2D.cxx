@@ -30,6 +30,7 @@
 #include <cassert>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -1121,18 +1122,30 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
 
    Double_t x, y, z;
 
-   for (Int_t ix = 1; ix <= fNpx; ix++) {
-      x  = hxmin + (ix - 0.5) * dx;
-      for (Int_t iy = 1; iy <= fNpy; iy++) {
-         y  = hymin + (iy - 0.5) * dy;
-         // do interpolation
-         if (oldInterp)
+   if (oldInterp) {
+      for (Int_t ix = 1; ix <= fNpx; ix++) {
+         x  = hxmin + (ix - 0.5) * dx;
+         for (Int_t iy = 1; iy <= fNpy; iy++) {
+            y  = hymin + (iy - 0.5) * dy;
+            // do interpolation
             z  = ((TGraphDelaunay*)fDelaunay)->ComputeZ(x, y);
-         else
-            z  = ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(x, y);
 
-         fHistogram->Fill(x, y, z);
+            fHistogram->Fill(x, y, z);
+         }
+      }
+   } else {
+      // interpolate all the bin centres at once, in parallel if implicit MT is enabled
+      const Int_t n = fNpx * fNpy;
+      std::vector<Double_t> xs(n), ys(n), zs(n);
+      for (Int_t ix = 1; ix <= fNpx; ix++) {
+         for (Int_t iy = 1; iy <= fNpy; iy++) {
+            xs[(ix - 1) * fNpy + iy - 1] = hxmin + (ix - 0.5) * dx;
+            ys[(ix - 1) * fNpy + iy - 1] = hymin + (iy - 0.5) * dy;
+         }
       }
+      ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(n, xs.data(), ys.data(), zs.data());
+      for (Int_t i = 0; i < n; i++)
+         fHistogram->Fill(xs[i], ys[i], zs[i]);
    }
 
    hzmin = GetZminE();
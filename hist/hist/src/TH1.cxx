@@ -9,6 +9,7 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <climits>
@@ -385,6 +386,10 @@ When using the options 2 or 3 above, the labels are automatically
 ~~~ {.cpp}
         Double_t error = h->GetBinError(bin);
 ~~~
+ The array of the sum of squares of weights takes as much memory as the
+ bin contents. TH1::SetLazySumw2 defers it as long as all the weights
+ are 1, when it is equal to the bin contents: it is only created by the
+ first weighted fill or by an operation changing the errors.
 
 \anchor associated-functions
 ### Associated functions
@@ -830,6 +835,9 @@ Bool_t TH1::Add(TF1 *f1, Double_t c1, Option_t *option)
       return kFALSE;
    }
 
+   // the function has no error: the deferred sum of squares of weights must be kept as it is
+   if (TestBit(kLazySumw2)) Sumw2();
+
    TString opt = option;
    opt.ToLower();
    Bool_t integral = kFALSE;
@@ -980,8 +988,8 @@ Bool_t TH1::Add(const TH1 *h1, Double_t c1)
       return (iret >= 0);
    }
 
-   //    Create Sumw2 if h1 has Sumw2 set
-   if (fSumw2.fN == 0 && h1->GetSumw2N() != 0) Sumw2();
+   //    Create Sumw2 if h1 has Sumw2 set, or if it was deferred (see TH1::SetLazySumw2)
+   if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || TestBit(kLazySumw2))) Sumw2();
 
    //   - Add statistics
    Double_t entries = TMath::Abs( GetEntries() + c1 * h1->GetEntries() );
@@ -1144,8 +1152,8 @@ Bool_t TH1::Add(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2)
       }
    }
 
-   //    Create Sumw2 if h1 or h2 have Sumw2 set
-   if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || h2->GetSumw2N() != 0)) Sumw2();
+   //    Create Sumw2 if h1 or h2 have Sumw2 set, or if it was deferred (see TH1::SetLazySumw2)
+   if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || h2->GetSumw2N() != 0 || TestBit(kLazySumw2))) Sumw2();
 
    //   - Add statistics
    Double_t nEntries = TMath::Abs( c1*h1->GetEntries() + c2*h2->GetEntries() );
@@ -2846,6 +2854,8 @@ Bool_t TH1::Divide(TF1 *f1, Double_t c1)
       return kFALSE;
    }
 
+   if (TestBit(kLazySumw2)) Sumw2();
+
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
 
@@ -2921,8 +2931,8 @@ Bool_t TH1::Divide(const TH1 *h1)
       return false;
    }
 
-   //    Create Sumw2 if h1 has Sumw2 set
-   if (fSumw2.fN == 0 && h1->GetSumw2N() != 0) Sumw2();
+   //    Create Sumw2 if h1 has Sumw2 set, or if it was deferred (see TH1::SetLazySumw2)
+   if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || TestBit(kLazySumw2))) Sumw2();
 
    //   - Loop on bins (including underflows/overflows)
    for (Int_t i = 0; i < fNcells; ++i) {
@@ -2990,8 +3000,9 @@ Bool_t TH1::Divide(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2, Optio
       return kFALSE;
    }
 
-   //    Create Sumw2 if h1 or h2 have Sumw2 set, or if binomial errors are explicitly requested
-   if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || h2->GetSumw2N() != 0 || binomial)) Sumw2();
+   //    Create Sumw2 if h1 or h2 have Sumw2 set, or if binomial errors are explicitly requested,
+   //    or if it was deferred (see TH1::SetLazySumw2)
+   if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || h2->GetSumw2N() != 0 || binomial || TestBit(kLazySumw2))) Sumw2();
 
    SetMinimum();
    SetMaximum();
@@ -3479,23 +3490,64 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
-   ntimes *= stride;
-   for (i=0;i<ntimes;i+=stride) {
-      bin =fXaxis.FindBin(x[i]);
-      if (bin <0) continue;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin, ww);
-      if (bin == 0 || bin > nbins) {
-         if (!GetStatOverflowsBehaviour()) continue;
+   if (fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) {
+      // the axis can be extended while filling: find the bins one by one
+      ntimes *= stride;
+      for (i=0;i<ntimes;i+=stride) {
+         bin =fXaxis.FindBin(x[i]);
+         if (bin <0) continue;
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+         if (bin == 0 || bin > nbins) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         Double_t z= ww;
+         fTsumw   += z;
+         fTsumw2  += z*z;
+         fTsumwx  += z*x[i];
+         fTsumwx2 += z*x[i]*x[i];
       }
-      Double_t z= ww;
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
+      return;
    }
+
+   // The bins of a block of entries are looked up at once, then the contents and the
+   // statistics are updated, the latter in local variables stored at the end.
+   constexpr Int_t kBlockSize = 256;
+   Int_t bins[kBlockSize];
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+   for (Int_t first = 0; first < ntimes; first += kBlockSize) {
+      const Int_t n = std::min(kBlockSize, ntimes - first);
+      const Double_t *xb = x + first*stride;
+      const Double_t *wb = w ? w + first*stride : nullptr;
+      fXaxis.FindFixBins(n, xb, bins, stride);
+      if (wb && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i=0;i<n;i++) {
+            if (wb[i*stride] != 1.0) {
+               Sumw2();
+               break;
+            }
+         }
+      }
+      for (i=0;i<n;i++) {
+         bin = bins[i];
+         if (wb) ww = wb[i*stride];
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+         if ((bin == 0 || bin > nbins) && !statOverflows) continue;
+         const Double_t xi = xb[i*stride];
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*xi;
+         tsumwx2 += ww*xi*xi;
+      }
+   }
+   fTsumw   = tsumw;
+   fTsumw2  = tsumw2;
+   fTsumwx  = tsumwx;
+   fTsumwx2 = tsumwx2;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3962,6 +4014,7 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///   "B"  | Use this option when you want to fix or set limits on one or more parameters and the fitting function is a predefined one (e.g gaus, expo,..), otherwise in case of pre-defined functions, some default initial values and limits will be used.
 ///   "C"  | In case of linear fitting, do no calculate the chisquare (saves CPU time).
 ///   "G"  | Uses the gradient implemented in `TF1::GradientPar` for the minimization. This allows to use Automatic Differentiation when it is supported by the provided TF1 function.
+///   "NUMGRAD" | Does not use by default the gradient of formula functions computed with Automatic Differentiation (clad), and lets the minimizer compute numerically the derivatives.
 ///   "WIDTH" | Scales the histogran bin content by the bin width (useful for variable bins histograms)
 ///   "SERIAL" | Runs in serial mode. By defult if ROOT is built with MT support and MT is enables, the fit is perfomed in multi-thread     - "E"  Perform better Errors estimation using Minos technique
 ///   "MULTITHREAD" | Forces usage of multi-thread execution whenever possible
@@ -3973,6 +4026,7 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///   - for linear functions (`polN`, `chenbyshev` or formula expressions combined using operator `++`) a linear minimization is used.
 ///   - only the status of the fit is returned;
 ///   - the fit is performed in Multithread whenever is enabled in ROOT;
+///   - when ROOT is built with clad, the gradient of formula functions is computed with Automatic Differentiation and used in the minimization;
 ///   - only the last fitted function is saved in the histogram;
 ///   - the histogram is drawn after fitting overalyed with the resulting fitting function
 ///
@@ -6046,6 +6100,8 @@ Bool_t TH1::Multiply(TF1 *f1, Double_t c1)
       return kFALSE;
    }
 
+   if (TestBit(kLazySumw2)) Sumw2();
+
    // delete buffer if it is there since it will become invalid
    if (fBuffer) BufferEmpty(1);
 
@@ -6115,8 +6171,8 @@ Bool_t TH1::Multiply(const TH1 *h1)
       return false;
    }
 
-   //    Create Sumw2 if h1 has Sumw2 set
-   if (fSumw2.fN == 0 && h1->GetSumw2N() != 0) Sumw2();
+   //    Create Sumw2 if h1 has Sumw2 set, or if it was deferred (see TH1::SetLazySumw2)
+   if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || TestBit(kLazySumw2))) Sumw2();
 
    //   - Reset min-  maximum
    SetMinimum();
@@ -6169,8 +6225,8 @@ Bool_t TH1::Multiply(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2, Opt
       return false;
    }
 
-   //    Create Sumw2 if h1 or h2 have Sumw2 set
-   if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || h2->GetSumw2N() != 0)) Sumw2();
+   //    Create Sumw2 if h1 or h2 have Sumw2 set, or if it was deferred (see TH1::SetLazySumw2)
+   if (fSumw2.fN == 0 && (h1->GetSumw2N() != 0 || h2->GetSumw2N() != 0 || TestBit(kLazySumw2))) Sumw2();
 
    //   - Reset min - maximum
    SetMinimum();
@@ -9009,9 +9065,13 @@ void TH1::SetStats(Bool_t stats)
 /// if the static function TH1::SetDefaultSumw2 has been called before.
 /// If flag = false the structure containing the sum of the square of weights
 /// is rest and it will be empty, but it is not deleted (i.e. GetSumw2()->fN = 0)
+///
+/// See TH1::SetLazySumw2 to create the structure only when the histogram is
+/// filled with weights.
 
 void TH1::Sumw2(Bool_t flag)
 {
+   ResetBit(kLazySumw2);
    if (!flag) {
       // clear the array if existing - do nothing otherwise
       if (fSumw2.fN > 0 ) fSumw2.Set(0);
@@ -9034,6 +9094,47 @@ void TH1::Sumw2(Bool_t flag)
          fSumw2.fArray[i] = TMath::Abs(RetrieveBinContent(i));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Defer the creation of the structure storing the sum of squares of weights
+/// (see TH1::Sumw2) until it differs from the bin contents, to save memory.
+///
+/// As long as the histogram is filled with unit weights, the sum of squares of
+/// weights of a bin is equal to its content, so that the array is not needed:
+/// GetBinError() returns sqrt(bin content) as with Sumw2. The array is created
+/// (and the histogram becomes a normal histogram with Sumw2) by the first fill
+/// with a weight different from 1, or by any operation modifying the errors
+/// differently from the contents: Scale(), Add(), Multiply(), Divide(),
+/// SetBinContent() and SetBinError(). Meanwhile GetSumw2N() returns 0.
+///
+/// If the structure already exists (e.g. because of TH1::SetDefaultSumw2) it is
+/// deleted, provided all its values are equal to the bin contents.
+/// The deferred state is kept in the bit TH1::kLazySumw2, which is written with
+/// the histogram. With lazy = false the structure is created immediately.
+/// Not supported by profiles.
+
+void TH1::SetLazySumw2(Bool_t lazy)
+{
+   if (!lazy) {
+      if (TestBit(kLazySumw2)) Sumw2();
+      return;
+   }
+   if (InheritsFrom("TProfile") || InheritsFrom("TProfile2D") || InheritsFrom("TProfile3D")) {
+      Warning("SetLazySumw2", "The sum of squares of weights of a profile cannot be deferred");
+      return;
+   }
+   if (fSumw2.fN) {
+      if (fBuffer) BufferEmpty();
+      for (Int_t bin = 0; bin < fNcells; ++bin) {
+         if (fSumw2.fArray[bin] != TMath::Abs(RetrieveBinContent(bin))) {
+            Warning("SetLazySumw2", "The histogram has weighted entries, its sum of squares of weights is kept");
+            return;
+         }
+      }
+      fSumw2.Set(0);
+   }
+   SetBit(kLazySumw2);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to function with name.
 ///
@@ -9214,6 +9315,8 @@ void TH1::SetBinError(Int_t bin, Double_t error)
 
 void TH1::SetBinContent(Int_t bin, Double_t content)
 {
+   // the error of the bin must not follow its new content
+   if (TestBit(kLazySumw2)) Sumw2();
    fEntries++;
    fTsumw = 0;
    if (bin < 0) return;
@@ -0,0 +1,214 @@
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TH1ConcurrentFill.hxx"
+
+#include "TAxis.h"
+#include "TMath.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+void AtomicAdd(std::atomic<Double_t> &sum, Double_t value)
+{
+   Double_t old = sum.load(std::memory_order_relaxed);
+   while (!sum.compare_exchange_weak(old, old + value, std::memory_order_relaxed))
+      ;
+}
+
+} // unnamed namespace
+
+ROOT::Experimental::TH1ConcurrentFillManager::Stats::Stats()
+{
+   for (auto &sum : fSums)
+      sum.store(0., std::memory_order_relaxed);
+}
+
+ROOT::Experimental::TH1ConcurrentFillManager::TH1ConcurrentFillManager(const TH1 &model, unsigned int nShards)
+{
+   if (model.InheritsFrom(TProfile2D::Class()) || model.InheritsFrom(TProfile3D::Class()))
+      throw std::invalid_argument("TH1ConcurrentFillManager: TProfile2D and TProfile3D are not supported");
+   if (model.GetXaxis()->CanExtend() || model.GetYaxis()->CanExtend() || model.GetZaxis()->CanExtend())
+      throw std::invalid_argument("TH1ConcurrentFillManager: the axes of the histogram must not be extendable");
+
+   fModel.reset(static_cast<TH1 *>(model.Clone()));
+   fModel->SetDirectory(nullptr);
+   fModel->Reset();
+
+   fDimension = fModel->GetDimension();
+   fIsProfile = fModel->InheritsFrom(TProfile::Class());
+   // see TH1::GetStats(), TH2::GetStats(), TH3::GetStats() and TProfile::GetStats()
+   fNStats = fIsProfile ? 6 : (fDimension == 1 ? 4 : (fDimension == 2 ? 7 : 11));
+   // sum of w and of w^2 per bin, or for a TProfile of w*y, w*y^2, w and w^2
+   fNArrays = fIsProfile ? 4 : 2;
+   fNcells = fModel->GetNcells();
+
+   if (nShards == 0)
+      nShards = 1;
+   for (unsigned int i = 0; i < nShards; ++i) {
+      const std::size_t size = fNArrays * fNcells;
+      fShards.emplace_back(new std::atomic<Double_t>[size]);
+      for (std::size_t j = 0; j < size; ++j)
+         fShards.back()[j].store(0., std::memory_order_relaxed);
+   }
+   fStats.reset(new Stats[nShards]);
+}
+
+ROOT::Experimental::TH1ConcurrentFillManager::~TH1ConcurrentFillManager() = default;
+
+unsigned int ROOT::Experimental::TH1ConcurrentFillManager::GetShardIndex() const
+{
+   return std::hash<std::thread::id>{}(std::this_thread::get_id()) % fShards.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the global bin of (x,y,z) and whether it is in the range of all axes.
+
+Int_t ROOT::Experimental::TH1ConcurrentFillManager::FindBin(Double_t x, Double_t y, Double_t z, Bool_t &inRange) const
+{
+   const TAxis *xaxis = fModel->GetXaxis();
+   const Int_t binx = xaxis->FindFixBin(x);
+   inRange = binx > 0 && binx <= xaxis->GetNbins();
+   if (fDimension == 1)
+      return binx;
+   const TAxis *yaxis = fModel->GetYaxis();
+   const Int_t biny = yaxis->FindFixBin(y);
+   inRange = inRange && biny > 0 && biny <= yaxis->GetNbins();
+   const Int_t nx = xaxis->GetNbins() + 2;
+   if (fDimension == 2)
+      return binx + nx * biny;
+   const TAxis *zaxis = fModel->GetZaxis();
+   const Int_t binz = zaxis->FindFixBin(z);
+   inRange = inRange && binz > 0 && binz <= zaxis->GetNbins();
+   return binx + nx * (biny + (yaxis->GetNbins() + 2) * binz);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add an entry to the bins of shard `shard` and its statistics to `stats`, following
+/// TH1::Fill() (or TProfile::Fill()). Returns false if the entry is rejected, which
+/// happens only for a TProfile with a y range.
+
+Bool_t ROOT::Experimental::TH1ConcurrentFillManager::FillBin(unsigned int shard, Double_t x, Double_t y, Double_t z,
+                                                             Double_t w, Double_t *stats)
+{
+   if (fIsProfile) {
+      const TProfile *prof = static_cast<const TProfile *>(fModel.get());
+      const Double_t ymin = prof->GetYmin();
+      const Double_t ymax = prof->GetYmax();
+      if (ymin != ymax && (y < ymin || y > ymax || TMath::IsNaN(y)))
+         return kFALSE;
+   }
+   if (w != 1.0 && !fWeighted.load(std::memory_order_relaxed))
+      fWeighted.store(kTRUE, std::memory_order_relaxed);
+
+   Bool_t inRange;
+   const Int_t bin = FindBin(x, y, z, inRange);
+   std::atomic<Double_t> *sums = fShards[shard].get();
+   if (fIsProfile) {
+      AtomicAdd(sums[bin], w * y);
+      AtomicAdd(sums[fNcells + bin], w * y * y);
+      AtomicAdd(sums[2 * fNcells + bin], w);
+      AtomicAdd(sums[3 * fNcells + bin], w * w);
+   } else {
+      AtomicAdd(sums[bin], w);
+      AtomicAdd(sums[fNcells + bin], w * w);
+   }
+
+   if (!inRange && !fModel->GetStatOverflowsBehaviour())
+      return kTRUE;
+   stats[0] += w;
+   stats[1] += w * w;
+   stats[2] += w * x;
+   stats[3] += w * x * x;
+   if (fIsProfile || fDimension > 1) {
+      stats[4] += w * y;
+      stats[5] += w * y * y;
+   }
+   if (fDimension > 1) {
+      stats[6] += w * x * y;
+      if (fDimension > 2) {
+         stats[7] += w * z;
+         stats[8] += w * z * z;
+         stats[9] += w * x * z;
+         stats[10] += w * y * z;
+      }
+   }
+   return kTRUE;
+}
+
+void ROOT::Experimental::TH1ConcurrentFillManager::FillImpl(Double_t x, Double_t y, Double_t z, Double_t w)
+{
+   Double_t stats[TH1::kNstat] = {};
+   const unsigned int shard = GetShardIndex();
+   if (FillBin(shard, x, y, z, w, stats))
+      AddStats(shard, stats, 1);
+}
+
+void ROOT::Experimental::TH1ConcurrentFillManager::AddStats(unsigned int shard, const Double_t *stats,
+                                                            Long64_t entries)
+{
+   Stats &shardStats = fStats[shard];
+   for (Int_t i = 0; i < fNStats; ++i) {
+      if (stats[i] != 0.)
+         AtomicAdd(shardStats.fSums[i], stats[i]);
+   }
+   shardStats.fEntries.fetch_add(entries, std::memory_order_relaxed);
+}
+
+std::unique_ptr<TH1> ROOT::Experimental::TH1ConcurrentFillManager::GetResult() const
+{
+   std::unique_ptr<TH1> result(static_cast<TH1 *>(fModel->Clone()));
+   result->SetDirectory(nullptr);
+   const Bool_t weighted = fWeighted.load() || fModel->GetSumw2N();
+
+   std::vector<Double_t> sums(fNArrays * fNcells, 0.);
+   for (const auto &shard : fShards) {
+      for (std::size_t i = 0; i < sums.size(); ++i)
+         sums[i] += shard[i].load(std::memory_order_relaxed);
+   }
+
+   if (fIsProfile) {
+      TProfile *prof = static_cast<TProfile *>(result.get());
+      if (weighted)
+         prof->Sumw2();
+      TArrayD *binSumw2 = prof->GetBinSumw2();
+      for (Int_t bin = 0; bin < fNcells; ++bin) {
+         prof->fArray[bin] = sums[bin];
+         prof->GetSumw2()->fArray[bin] = sums[fNcells + bin];
+         prof->SetBinEntries(bin, sums[2 * fNcells + bin]);
+         if (binSumw2->fN)
+            binSumw2->fArray[bin] = sums[3 * fNcells + bin];
+      }
+   } else {
+      if (weighted)
+         result->Sumw2();
+      for (Int_t bin = 0; bin < fNcells; ++bin) {
+         // AddBinContent, unlike SetBinContent, leaves the statistics alone
+         result->AddBinContent(bin, sums[bin]);
+         if (weighted)
+            result->GetSumw2()->fArray[bin] = sums[fNcells + bin];
+      }
+   }
+
+   Double_t stats[TH1::kNstat] = {};
+   Long64_t entries = 0;
+   for (std::size_t shard = 0; shard < fShards.size(); ++shard) {
+      for (Int_t i = 0; i < fNStats; ++i)
+         stats[i] += fStats[shard].fSums[i].load(std::memory_order_relaxed);
+      entries += fStats[shard].fEntries.load(std::memory_order_relaxed);
+   }
+   result->PutStats(stats);
+   result->SetEntries(entries);
+   return result;
+}
@@ -8,9 +8,17 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include "TROOT.h"
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 #define PRINTRANGE(a, b, bn)                                                                                          \
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
@@ -762,6 +770,7 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
 
+   std::vector<const TH1 *> hists;
    TIter next(&fInputList);
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -778,13 +787,30 @@ Bool_t TH1Merger::SameAxesMerge() {
       for (Int_t i=0; i<TH1::kNstat; i++)
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
-
-         //Int_t nx = hist->GetXaxis()->GetNbins();
-         // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
-         MergeBin(hist, ibin, ibin);
-      }
+      hists.push_back(hist);
    }
+
+   // loop on bins of the histograms and do the merge. Each range of bins is merged with all
+   // histograms in the order of the list, so the result does not depend on how the bins are
+   // split between threads
+   auto mergeBins = [&](Int_t first, Int_t last) {
+      for (const TH1 *hist : hists)
+         MergeBinRange(hist, first, last);
+   };
+   const Int_t ncells = fH0->fNcells;
+#ifdef R__USE_IMT
+   // bins merged by each task
+   constexpr Int_t kChunkSize = 1 << 16;
+   if (ROOT::IsImplicitMTEnabled() && ncells > kChunkSize && hists.size() * ncells >= 4 * kChunkSize) {
+      const Int_t nchunks = (ncells + kChunkSize - 1) / kChunkSize;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t ichunk) {
+         mergeBins(ichunk * kChunkSize, std::min(ncells, (ichunk + 1) * kChunkSize));
+      }, ROOT::TSeqI(nchunks));
+   } else
+#endif
+      mergeBins(0, ncells);
+
    //copy merged stats
    fH0->PutStats(totstats);
    fH0->SetEntries(nentries);
@@ -1149,6 +1175,29 @@ void TH1Merger::MergeBin(const TH1 *hist, Int_t ibin, Int_t cbin)
    return;
 }
 
+// merge the bins [first, last) of hist into the same bins of this histogram. When both
+// store their contents as doubles the arrays are added directly.
+void TH1Merger::MergeBinRange(const TH1 *hist, Int_t first, Int_t last)
+{
+   const TArrayD *src = dynamic_cast<const TArrayD *>(hist);
+   TArrayD *dest = dynamic_cast<TArrayD *>(fH0);
+   if (fIsProfileMerge || !src || !dest || hist->IsA() != fH0->IsA()) {
+      for (Int_t bin = first; bin < last; ++bin)
+         MergeBin(hist, bin, bin);
+      return;
+   }
+   const Double_t *cu = src->fArray;
+   Double_t *sum = dest->fArray;
+   for (Int_t bin = first; bin < last; ++bin)
+      sum[bin] += cu[bin];
+   if (fH0->fSumw2.fN) {
+      const Double_t *e1sq = hist->fSumw2.fN ? hist->fSumw2.fArray : cu;
+      Double_t *sumw2 = fH0->fSumw2.fArray;
+      for (Int_t bin = first; bin < last; ++bin)
+         sumw2[bin] += e1sq[bin];
+   }
+}
+
 // merge profile input bin (ibin) of histograms hist ibin into current bin cbin of this histogram
 template<class TProfileType>
 void TH1Merger::MergeProfileBin(const TProfileType *h, Int_t hbin, Int_t pbin)
@@ -126,6 +126,9 @@ private:
    // function doing the bin merge for histograms and profiles
    void MergeBin(const TH1 *hist, Int_t inbin, Int_t outbin);
 
+   // merge the bins [first, last) of a histogram with the same axes
+   void MergeBinRange(const TH1 *hist, Int_t first, Int_t last);
+
    void MergeBin(const TProfile *hist, Int_t inbin, Int_t outbin) { MergeProfileBin<TProfile>(hist, inbin, outbin); }
    void MergeBin(const TProfile2D *hist, Int_t inbin, Int_t outbin) { MergeProfileBin<TProfile2D>(hist, inbin, outbin); }
    void MergeBin(const TProfile3D *hist, Int_t inbin, Int_t outbin) { MergeProfileBin<TProfile3D>(hist, inbin, outbin); }
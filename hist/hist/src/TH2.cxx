@@ -28,6 +28,8 @@
 #include "TVirtualHistPainter.h"
 #include "snprintf.h"
 
+#include <algorithm>
+
 ClassImp(TH2);
 
 /** \addtogroup Histograms
@@ -665,31 +667,89 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
-   for (i=ifirst;i<ntimes;i+=stride) {
-      fEntries++;
-      binx = fXaxis.FindBin(x[i]);
-      biny = fYaxis.FindBin(y[i]);
-      if (binx <0 || biny <0) continue;
-      bin  = biny*(fXaxis.GetNbins()+2) + binx;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin,ww);
-      if (binx == 0 || binx > fXaxis.GetNbins()) {
-         if (!GetStatOverflowsBehaviour()) continue;
+   if ((fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) || (fYaxis.CanExtend() && !fYaxis.IsAlphanumeric())) {
+      // an axis can be extended while filling: find the bins one by one
+      for (i=ifirst;i<ntimes;i+=stride) {
+         fEntries++;
+         binx = fXaxis.FindBin(x[i]);
+         biny = fYaxis.FindBin(y[i]);
+         if (binx <0 || biny <0) continue;
+         bin  = biny*(fXaxis.GetNbins()+2) + binx;
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > fXaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         if (biny == 0 || biny > fYaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         Double_t z= ww; //(ww > 0 ? ww : -ww);
+         fTsumw   += z;
+         fTsumw2  += z*z;
+         fTsumwx  += z*x[i];
+         fTsumwx2 += z*x[i]*x[i];
+         fTsumwy  += z*y[i];
+         fTsumwy2 += z*y[i]*y[i];
+         fTsumwxy += z*x[i]*y[i];
+      }
+      return;
+   }
+
+   // The bins of a block of entries are looked up at once, then the contents and the
+   // statistics are updated, the latter in local variables stored at the end.
+   constexpr Int_t kBlockSize = 256;
+   Int_t binsx[kBlockSize], binsy[kBlockSize];
+   const Int_t nbinsx = fXaxis.GetNbins();
+   const Int_t nbinsy = fYaxis.GetNbins();
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+   Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+   const Int_t nentries = (ntimes - ifirst + stride - 1)/stride;
+   for (Int_t first = 0; first < nentries; first += kBlockSize) {
+      const Int_t n = std::min(kBlockSize, nentries - first);
+      const Int_t offset = ifirst + first*stride;
+      const Double_t *xb = x + offset;
+      const Double_t *yb = y + offset;
+      const Double_t *wb = w ? w + offset : nullptr;
+      fXaxis.FindFixBins(n, xb, binsx, stride);
+      fYaxis.FindFixBins(n, yb, binsy, stride);
+      fEntries += n;
+      if (wb && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i=0;i<n;i++) {
+            if (wb[i*stride] != 1.0) {
+               Sumw2();
+               break;
+            }
+         }
       }
-      if (biny == 0 || biny > fYaxis.GetNbins()) {
-         if (!GetStatOverflowsBehaviour()) continue;
+      for (i=0;i<n;i++) {
+         binx = binsx[i];
+         biny = binsy[i];
+         bin  = biny*(nbinsx+2) + binx;
+         if (wb) ww = wb[i*stride];
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (!statOverflows && (binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy)) continue;
+         const Double_t xi = xb[i*stride];
+         const Double_t yi = yb[i*stride];
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*xi;
+         tsumwx2 += ww*xi*xi;
+         tsumwy  += ww*yi;
+         tsumwy2 += ww*yi*yi;
+         tsumwxy += ww*xi*yi;
       }
-      Double_t z= ww; //(ww > 0 ? ww : -ww);
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
-      fTsumwy  += z*y[i];
-      fTsumwy2 += z*y[i]*y[i];
-      fTsumwxy += z*x[i]*y[i];
    }
+   fTsumw   = tsumw;
+   fTsumw2  = tsumw2;
+   fTsumwx  = tsumwx;
+   fTsumwx2 = tsumwx2;
+   fTsumwy  = tsumwy;
+   fTsumwy2 = tsumwy2;
+   fTsumwxy = tsumwxy;
 }
 
 
@@ -2615,6 +2675,8 @@ void TH2::Reset(Option_t *option)
 
 void TH2::SetBinContent(Int_t bin, Double_t content)
 {
+   // the error of the bin must not follow its new content
+   if (TestBit(kLazySumw2)) Sumw2();
    fEntries++;
    fTsumw = 0;
    if (bin < 0) return;
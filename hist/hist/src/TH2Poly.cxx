@@ -17,7 +17,16 @@
 #include "Riostream.h"
 #include "TList.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#include <algorithm>
 #include <cassert>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 ClassImp(TH2Poly);
 
@@ -609,6 +618,19 @@ void TH2Poly::Reset(Option_t *opt)
 
 Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
 {
+   TH2PolyBin *bin = nullptr;
+   return FindBinInPartition(x, y, bin);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the bin containing (x,y) with the partitioning algorithm.
+/// Returns the bin number and sets `bin` to the bin containing (x,y), or returns the
+/// number of the overflow or sea bin (see GetBinContent()) and sets `bin` to nullptr.
+/// The histogram is not modified, so this can be called concurrently.
+
+Int_t TH2Poly::FindBinInPartition(Double_t x, Double_t y, TH2PolyBin *&bin) const
+{
+   bin = nullptr;
 
    // Checks for overflow/underflow
    Int_t overflow = 0;
@@ -631,15 +653,17 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
 
    if (fIsEmpty[n+fCellX*m]) return -5;
 
-   TH2PolyBin *bin;
-
    TIter next(&fCells[n+fCellX*m]);
    TObject *obj;
 
-   // Search for the bin in the cell
+   // Search for the bin in the cell. The bounding boxes of the bins of the partition
+   // are known and much cheaper to test than the polygons.
    while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
+      TH2PolyBin *candidate = (TH2PolyBin*)obj;
+      if (candidate->IsInsideBoundingBox(x,y) && candidate->IsInside(x,y)) {
+         bin = candidate;
+         return bin->GetBinNumber();
+      }
    }
 
    // If the search has not returned a bin, the point must be on "the sea"
@@ -673,69 +697,42 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
    // create sum of weight square array if weights are different than 1
    if (!fSumw2.fN && w != 1.0 && !TestBit(TH1::kIsNotW) )  Sumw2();
 
-   Int_t overflow = 0;
-   if      (y > fYaxis.GetXmax()) overflow += -1;
-   else if (y > fYaxis.GetXmin()) overflow += -4;
-   else                           overflow += -7;
-   if      (x > fXaxis.GetXmax()) overflow += -2;
-   else if(x > fXaxis.GetXmin())  overflow += -1;
-   if (overflow != -5) {
-      fOverflow[-overflow - 1]+= w;
-      if (fSumw2.fN) fSumw2.fArray[-overflow - 1] += w*w;
-      return overflow;
-   }
-
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
+   TH2PolyBin *bin = nullptr;
+   Int_t binnr = FindBinInPartition(x, y, bin);
+   FillFoundBin(binnr, bin, x, y, w);
+   return binnr;
+}
 
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
+////////////////////////////////////////////////////////////////////////////////
+/// Increment by w the bin number binnr found by FindBinInPartition() for (x,y),
+/// which is the overflow or sea bin if bin is nullptr, and update the statistics.
 
-   if (fIsEmpty[n+fCellX*m]) {
-      fOverflow[4]+= w;
-      if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-      return -5;
+void TH2Poly::FillFoundBin(Int_t binnr, TH2PolyBin *bin, Double_t x, Double_t y, Double_t w)
+{
+   if (!bin) {
+      fOverflow[-binnr - 1]+= w;
+      if (fSumw2.fN) fSumw2.fArray[-binnr - 1] += w*w;
+      return;
    }
 
-   TH2PolyBin *bin;
-   Int_t bi;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      // needs to account offset in array for overflow bins
-      bi = bin->GetBinNumber()-1+kNOverflow;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
-
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumw2  = fTsumw2 + w*w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) {
-            assert(bi < fSumw2.fN);
-            fSumw2.fArray[bi] += w*w;
-         }
-         fEntries++;
-
-         SetBinContentChanged(kTRUE);
+   // needs to account offset in array for overflow bins
+   Int_t bi = binnr-1+kNOverflow;
+   bin->Fill(w);
 
-         return bin->GetBinNumber();
-      }
+   // Statistics
+   fTsumw   = fTsumw + w;
+   fTsumw2  = fTsumw2 + w*w;
+   fTsumwx  = fTsumwx + w*x;
+   fTsumwx2 = fTsumwx2 + w*x*x;
+   fTsumwy  = fTsumwy + w*y;
+   fTsumwy2 = fTsumwy2 + w*y*y;
+   if (fSumw2.fN) {
+      assert(bi < fSumw2.fN);
+      fSumw2.fArray[bi] += w*w;
    }
+   fEntries++;
 
-   fOverflow[4]+= w;
-   if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-   return -5;
+   SetBinContentChanged(kTRUE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -769,14 +766,41 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights, if nullptr each entry has weight 1
 /// \param [in] stride:  step size through arrays x, y and w
+///
+/// The bins of all the entries are found first, in parallel if implicit
+/// multithreading is enabled (ROOT::EnableImplicitMT()), then they are filled.
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
-   for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+   if (fNcells <= kNOverflow || ntimes <= 0) return;
+
+   // Finding the bins is the expensive part and does not modify the histogram: it is done
+   // first for all the entries, in parallel if implicit multithreading is enabled.
+   std::vector<TH2PolyBin*> bins(ntimes);
+   std::vector<Int_t> binnrs(ntimes);
+   auto findBins = [&](Int_t first, Int_t last) {
+      for (Int_t i = first; i < last; ++i)
+         binnrs[i] = FindBinInPartition(x[i*stride], y[i*stride], bins[i]);
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && ntimes >= 1000) {
+      const Int_t nchunks = std::min<Int_t>(ntimes / 100, 4 * ROOT::GetThreadPoolSize());
+      const Int_t chunkSize = (ntimes + nchunks - 1) / nchunks;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t ichunk) {
+         findBins(ichunk * chunkSize, std::min(ntimes, (ichunk + 1) * chunkSize));
+      }, ROOT::TSeqI(nchunks));
+   } else
+#endif
+   findBins(0, ntimes);
+
+   for (Int_t i = 0; i < ntimes; ++i) {
+      const Double_t ww = w ? w[i*stride] : 1.;
+      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+      FillFoundBin(binnrs[i], bins[i], x[i*stride], y[i*stride], ww);
    }
 }
 
@@ -1092,8 +1116,12 @@ void TH2Poly::Honeycomb(Double_t xstart, Double_t ystart, Double_t a, Int_t k, I
       }
    } else {
       Error("Honeycomb", "Unknown option");
+      return;
    }
 
+   // About one partition cell per hexagon keeps the number of bins tested by FindBin small
+   if (k > fCellX || s > fCellY)
+      ChangePartition(std::max(k, fCellX), std::max(s, fCellY));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
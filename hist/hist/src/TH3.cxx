@@ -3467,6 +3467,8 @@ void TH3::Reset(Option_t *option)
 
 void TH3::SetBinContent(Int_t bin, Double_t content)
 {
+   // the error of the bin must not follow its new content
+   if (TestBit(kLazySumw2)) Sumw2();
    fEntries++;
    fTsumw = 0;
    if (bin < 0) return;
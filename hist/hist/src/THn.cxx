@@ -11,6 +11,16 @@
 
 #include "THn.h"
 
+#include "TAxis.h"
+#include "TROOT.h"
+
+#include <algorithm>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 namespace {
    //______________________________________________________________________________
    //
@@ -244,6 +254,72 @@ void THn::InitStorage(Int_t* nbins, Int_t /*chunkSize*/)
    fSumw2.Init(fNdimensions, nbins, true /*addOverflow*/);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin contents of hists, which must all be THn with the same binning as
+/// this histogram; returns kFALSE otherwise. The bins are added array by array,
+/// without the lookup of each bin done by Add(); for large histograms and if
+/// implicit multi-threading is enabled, ranges of bins are added in parallel.
+/// Each bin gets the contents of hists in their order, as with Add().
+
+Bool_t THn::AddSameBinning(const std::vector<const THnBase*>& hists)
+{
+   std::vector<const THn*> hns;
+   Bool_t haveErrors = GetCalculateErrors();
+   for (const THnBase* h: hists) {
+      const THn* hn = dynamic_cast<const THn*>(h);
+      if (!hn || hn->GetNdimensions() != fNdimensions)
+         return kFALSE;
+      for (Int_t d = 0; d < fNdimensions; ++d) {
+         const TAxis* axis = GetAxis(d);
+         const TAxis* otherAxis = hn->GetAxis(d);
+         if (axis->GetNbins() != otherAxis->GetNbins() || axis->GetXmin() != otherAxis->GetXmin()
+             || axis->GetXmax() != otherAxis->GetXmax())
+            return kFALSE;
+         const TArrayD* bins = axis->GetXbins();
+         const TArrayD* otherBins = otherAxis->GetXbins();
+         if (bins->fN != otherBins->fN || !std::equal(bins->fArray, bins->fArray + bins->fN, otherBins->fArray))
+            return kFALSE;
+      }
+      haveErrors |= hn->GetCalculateErrors();
+      hns.push_back(hn);
+   }
+
+   // Trigger error calculation if any of hists has it, and allocate the arrays
+   // before they are filled concurrently
+   if (haveErrors && !GetCalculateErrors())
+      Sumw2();
+   TNDArray& content = GetArray();
+   content.AddAt(0, 0.);
+   if (haveErrors)
+      fSumw2.AddAt(0, 0.);
+
+   auto addBins = [&](Long64_t first, Long64_t last) {
+      for (const THn* hn: hns) {
+         if (haveErrors) {
+            if (hn->GetCalculateErrors())
+               fSumw2.AddRange(hn->fSumw2, first, last);
+            else
+               fSumw2.AddRange(hn->GetArray(), first, last);
+         }
+         content.AddRange(hn->GetArray(), first, last);
+      }
+   };
+   const Long64_t nbins = GetNbins();
+#ifdef R__USE_IMT
+   // bins added by each task
+   constexpr Long64_t kChunkSize = 1 << 16;
+   if (ROOT::IsImplicitMTEnabled() && nbins > kChunkSize && (Long64_t)hns.size() * nbins >= 4 * kChunkSize) {
+      const Long64_t nchunks = (nbins + kChunkSize - 1) / kChunkSize;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Long64_t ichunk) {
+         addBins(ichunk * kChunkSize, std::min(nbins, (ichunk + 1) * kChunkSize));
+      }, ROOT::TSeq<Long64_t>(nchunks));
+   } else
+#endif
+      addBins(0, nbins);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset the contents of a THn.
 
@@ -846,9 +846,18 @@ void THnBase::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
    delete [] coord;
    delete [] x;
 
-   // add also the statistics
+   AddStatistics(h, c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics (sums of weights and entries) of h scaled by c to the
+/// ones of this histogram, once its bin contents have been added.
+
+void THnBase::AddStatistics(const THnBase* h, Double_t c)
+{
    fTsumw += c * h->fTsumw;
-   if (haveErrors) {
+   // h->fTsumw2 is -1 if h does not calculate errors
+   if (GetCalculateErrors() && h->GetCalculateErrors()) {
       fTsumw2 += c * c * h->fTsumw2;
       if (h->fTsumwx.fN == fNdimensions && h->fTsumwx2.fN == fNdimensions) {
          for (Int_t d = 0; d < fNdimensions; ++d) {
@@ -900,14 +909,26 @@ Long64_t THnBase::Merge(TCollection* list)
    if (list->IsEmpty()) return (Long64_t)GetEntries();
 
    Long64_t sumNbins = GetNbins();
+   std::vector<const THnBase*> hists;
+   Bool_t allThn = kTRUE;
    TIter iter(list);
    const TObject* addMeObj = nullptr;
    while ((addMeObj = iter())) {
       const THnBase* addMe = dynamic_cast<const THnBase*>(addMeObj);
       if (addMe) {
          sumNbins += addMe->GetNbins();
-      }
+         hists.push_back(addMe);
+      } else
+         allThn = kFALSE;
+   }
+
+   // Fast path for histograms with identical binning, adding the bins directly
+   if (allThn && AddSameBinning(hists)) {
+      for (const THnBase* addMe: hists)
+         AddStatistics(addMe, 1.);
+      return (Long64_t)GetEntries();
    }
+
    Reserve(sumNbins);
 
    iter.Reset();
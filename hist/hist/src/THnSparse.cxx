@@ -270,9 +270,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromCoords(const Int_t* coord) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the bin table.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the bin table's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -318,9 +318,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the bin table.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the bin table's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -570,14 +570,16 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the member fBins, a flat
+open addressing hash table (with linear probing) that stores the hash next to
+the linear index, so that a lookup usually touches a single cache line.
+For an entry with the same hash, the coordinates of the bin it points to are
+compared to the coordinates passed to GetBin(). If they do not match, these two
+coordinates have the same hash - which is extremely unlikely but (for the case
+where the compact bin coordinates are larger than 8 bytes) possible. The probing
+then continues with the next slots of the table until the matching bin or an
+empty slot is found. The table is transient: it is rebuilt from the chunks when
+a histogram read from a file is filled or queried.
 */
 
 
@@ -649,6 +651,44 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
    fCompactCoord = new THnSparseCompactBinCoord(fNdimensions, nbins);
 }
 
+namespace {
+/// Slot of the bin with the given hash in a table of mask + 1 slots. The hash of
+/// histograms with few bins is the linear bin index: it is mixed to spread the bins.
+inline ULong64_t GetBinTableSlot(ULong64_t hash, ULong64_t mask)
+{
+   return ((hash * 0x9E3779B97F4A7C15ULL) >> 24) & mask;
+}
+
+/// Number of slots of the table of filled bins for nbins bins: a power of 2 such that
+/// the table is at most half full.
+inline Long64_t GetBinTableSize(Long64_t nbins)
+{
+   Long64_t nslots = 16;
+   while (nslots < 2 * nbins)
+      nslots *= 2;
+   return nslots;
+}
+} // unnamed namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set up the table of filled bins fBins with nslots slots (a power of 2),
+/// inserting all the filled bins.
+
+void THnSparse::ResizeBinTable(Long64_t nslots)
+{
+   std::vector<std::pair<ULong64_t, Long64_t>> table(nslots, {0, 0});
+   const ULong64_t mask = nslots - 1;
+   for (const auto &entry : fBins) {
+      if (!entry.second)
+         continue;
+      ULong64_t slot = GetBinTableSlot(entry.first, mask);
+      while (table[slot].second)
+         slot = (slot + 1) & mask;
+      table[slot] = entry;
+   }
+   fBins.swap(table);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///We have been streamed; set up fBins
 
@@ -658,8 +698,8 @@ void THnSparse::FillExMap()
    THnSparseArrayChunk* chunk = nullptr;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   fBins.assign(GetBinTableSize(GetNbins()), {0, 0});
+   const ULong64_t mask = fBins.size() - 1;
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
@@ -667,18 +707,10 @@ void THnSparse::FillExMap()
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
       for (; buf < endbuf; buf += singleCoordSize, ++idx) {
          Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
+         ULong64_t slot = GetBinTableSlot(hash, mask);
+         while (fBins[slot].second)
+            slot = (slot + 1) & mask;
+         fBins[slot] = {hash, idx + 1};
       }
    }
 }
@@ -687,11 +719,12 @@ void THnSparse::FillExMap()
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
+   if (fBins.empty() && fBinContent.GetEntriesFast()) {
       FillExMap();
    }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
+   Long64_t nslots = GetBinTableSize(nbins);
+   if (nslots > (Long64_t)fBins.size()) {
+      ResizeBinTable(nslots);
    }
 }
 
@@ -790,19 +823,20 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 {
    THnSparseCompactBinCoord* cc = GetCompactCoord();
    ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
+   if (fBins.empty())
+      Reserve(0);
+   // The table stores the hash next to the bin index: only bins with the same hash need to
+   // be compared in their chunk. Bins with the same hash occupy consecutive slots.
+   ULong64_t mask = fBins.size() - 1;
+   ULong64_t slot = GetBinTableSlot(hash, mask);
+   while (Long64_t linidx = fBins[slot].second) {
       // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
+      if (fBins[slot].first == hash) {
+         THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
+         if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
+            return linidx - 1; // we store idx+1, 0 is "empty slot"
+      }
+      slot = (slot + 1) & mask;
    }
    if (!allocate) return -1;
 
@@ -819,16 +853,14 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
+   if (2 * GetNbins() > (Long64_t)fBins.size()) {
+      ResizeBinTable(2 * fBins.size());
+      mask = fBins.size() - 1;
+      slot = GetBinTableSlot(hash, mask);
+      while (fBins[slot].second)
+         slot = (slot + 1) & mask;
    }
+   fBins[slot] = {hash, newidx + 1};
    return newidx;
 }
 
@@ -880,7 +912,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += sizeof(std::pair<ULong64_t, Long64_t>) * fBins.size() /* bin table */;
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -962,8 +994,7 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   fBins.clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -70,7 +70,7 @@ TKDE::TKDE() :
    fUseBins(false), fNewData(false), fUseMinMaxFromData(false),
    fNBins(0), fNEvents(0), fSumOfCounts(0), fUseBinsNEvents(0),
    fMean(0.),fSigma(0.), fSigmaRob(0.), fXMin(0.), fXMax(0.),
-   fRho(0.), fAdaptiveBandwidthFactor(0.), fWeightSize(0)
+   fRho(0.), fAdaptiveBandwidthFactor(0.), fWeightSize(0), fGridTolerance(0)
 {
 }
 
@@ -111,6 +111,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fAdaptiveBandwidthFactor = 1.;
    fRho = rho;
    fWeightSize = 0;
+   fGridTolerance = 0;
    fCanonicalBandwidths = std::vector<Double_t>(kTotalKernels, 0.0);
    fKernelSigmas2 = std::vector<Double_t>(kTotalKernels, -1.0);
    fSettedOptions = std::vector<Bool_t>(4, kFALSE);
@@ -389,6 +390,21 @@ void TKDE::SetRange(Double_t xMin, Double_t xMax) {
    fKernel.reset();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Use a fast evaluation of the density in the range of the KDE: the density is
+/// tabulated once on a uniform grid and then interpolated linearly.
+/// The grid starts with 256 intervals and is refined by halving them until
+/// the interpolation at the middle of the intervals differs by less than
+/// tolerance times the maximum of the density from the exact value (or the grid
+/// has 2^20 intervals). This makes evaluating the KDE many times, e.g. for
+/// drawing or with Evaluate(), independent of the number of data points or bins.
+/// Outside the range the density is computed exactly.
+/// A tolerance <= 0 disables the fast evaluation, which is the default.
+
+void TKDE::SetFastEvaluation(Double_t tolerance) {
+   fGridTolerance = std::max(tolerance, 0.);
+}
+
 // private methods
 
 void TKDE::SetUseBins() {
@@ -745,9 +761,23 @@ Double_t TKDE::operator()(Double_t x) const {
       // in case of failed re-initialization
       if (!fKernel) return TMath::QuietNaN();
    }
+   if (fGridTolerance > 0 && x >= fXMin && x <= fXMax) {
+      if (fKernel->GetGridTolerance() != fGridTolerance)
+         fKernel->ComputeGrid(fGridTolerance);
+      if (fKernel->GetGridTolerance() > 0)
+         return fKernel->GetGridValue(x);
+   }
    return (*fKernel)(x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the kernel density estimate at the n points x, and store it in y.
+
+void TKDE::Evaluate(UInt_t n, const Double_t* x, Double_t* y) const {
+   for (UInt_t i = 0; i < n; ++i)
+      y[i] = (*this)(x[i]);
+}
+
 Double_t TKDE::GetMean() const {
    // return the mean of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
@@ -1045,6 +1075,58 @@ Double_t TKDE::TKernel::operator()(Double_t x) const {
    return result / nSum;
 }
 
+////////////////////////////////////////////////////
+/// Tabulate the density in the range of the KDE, see TKDE::SetFastEvaluation().
+/// The points computed to check a grid become the odd points of the next one.
+
+void TKDE::TKernel::ComputeGrid(Double_t tolerance) {
+   const UInt_t kMaxIntervals = 1 << 20;
+   const Double_t xmin = fKDE->fXMin;
+   const Double_t xmax = fKDE->fXMax;
+   fGrid.clear();
+   fGridTolerance = 0;
+   if (!(xmin < xmax))
+      return;
+
+   UInt_t n = 256;
+   std::vector<Double_t> grid(n + 1);
+   Double_t maxValue = 0;
+   for (UInt_t i = 0; i <= n; ++i) {
+      grid[i] = (*this)(xmin + i * (xmax - xmin) / n);
+      maxValue = std::max(maxValue, grid[i]);
+   }
+   std::vector<Double_t> refined;
+   Bool_t converged = kFALSE;
+   while (!converged && n < kMaxIntervals) {
+      const Double_t step = (xmax - xmin) / n;
+      Double_t maxDiff = 0;
+      refined.resize(2 * n + 1);
+      for (UInt_t i = 0; i < n; ++i) {
+         const Double_t mid = (*this)(xmin + (i + 0.5) * step);
+         maxDiff = std::max(maxDiff, std::abs(mid - 0.5 * (grid[i] + grid[i + 1])));
+         maxValue = std::max(maxValue, mid);
+         refined[2 * i] = grid[i];
+         refined[2 * i + 1] = mid;
+      }
+      refined[2 * n] = grid[n];
+      grid.swap(refined);
+      n *= 2;
+      converged = maxDiff <= tolerance * maxValue;
+   }
+   fGrid.swap(grid);
+   fGridStep = (xmax - xmin) / n;
+   fGridTolerance = tolerance;
+}
+
+////////////////////////////////////////////////////
+/// Interpolate the tabulated density at x, which must be in the range of the KDE.
+
+Double_t TKDE::TKernel::GetGridValue(Double_t x) const {
+   const Double_t t = (x - fKDE->fXMin) / fGridStep;
+   const UInt_t i = std::min(UInt_t(std::max(t, 0.)), UInt_t(fGrid.size() - 2));
+   return fGrid[i] + (t - i) * (fGrid[i + 1] - fGrid[i]);
+}
+
 ////////////////////////////////////////////////////
 /// compute the bin index given a data point x
 UInt_t TKDE::Index(Double_t x) const {
@@ -396,6 +396,9 @@
 #include "TBrowser.h"
 #include "TDecompChol.h"
 #include "TDatime.h"
+#include "HistParallel.h"
+
+#include <vector>
 
 
 #define RADDEG (180. / TMath::Pi())
@@ -413,6 +416,9 @@
 #define PARAM_RELERR   3
 #define PARAM_MAXTERMS 4
 
+// Number of data points of the blocks processed by a task
+static const Int_t kSampleBlock = 4096;
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -1393,9 +1399,17 @@ void TMultiDimFit::MakeCoefficients()
    for (i = 0; i < fSampleSize; i++)
       fResiduals(i) = fQuantity(i);
 
-   for (i = 0; i < fNCoefficients; i++)
-      for (j = 0; j < fSampleSize; j++)
-         fResiduals(j) -= fCoefficients(i) * fFunctions(i,j);
+   const Int_t nblocks = (fSampleSize + kSampleBlock - 1) / kSampleBlock;
+   ROOT::Internal::Hist::Foreach(nblocks, Long64_t(fSampleSize) * fNCoefficients, [&](Int_t block) {
+      const Int_t first = block * kSampleBlock;
+      const Int_t last  = TMath::Min(first + kSampleBlock, fSampleSize);
+      Double_t *res = fResiduals.GetMatrixArray();
+      for (Int_t k = 0; k < fNCoefficients; k++) {
+         const Double_t *fk = fFunctions.GetMatrixArray() + Long64_t(k) * fSampleSize;
+         for (Int_t l = first; l < last; l++)
+            res[l] -= fCoefficients(k) * fk[l];
+      }
+   });
 
    // Compute the max and minimum, and squared sum of the evaluated
    // residuals
@@ -1503,55 +1517,85 @@ void TMultiDimFit::MakeCorrelation()
 
 Double_t TMultiDimFit::MakeGramSchmidt(Int_t function)
 {
+   // The sample is processed by blocks, in parallel when implicit
+   // multithreading is enabled. The partial sums of the blocks are
+   // added in order, so that the result doesn't depend on the number
+   // of threads.
+   const Int_t nc      = fNCoefficients;
+   const Int_t nblocks = (fSampleSize + kSampleBlock - 1) / kSampleBlock;
+   const Long64_t work = Long64_t(fSampleSize) * (2 * nc + fNVariables);
+   const Int_t *powers = &fPowers[function * fNVariables];
+   const Double_t *x   = fVariables.GetMatrixArray();
+   const Double_t *d   = fQuantity.GetMatrixArray();
+   Double_t *f = fFunctions.GetMatrixArray() + Long64_t(nc) * fSampleSize;
+   Double_t *w = fOrthFunctions.GetMatrixArray();
+   Double_t *wc = w + Long64_t(nc) * fSampleSize;
 
    // calculate w_i, that is, evaluate the current function at data
-   // point i
-   Double_t f2                        = 0;
-   fOrthCoefficients(fNCoefficients)      = 0;
-   fOrthFunctionNorms(fNCoefficients)  = 0;
-   Int_t j        = 0;
-   Int_t k        = 0;
-
-   for (j = 0; j < fSampleSize; j++) {
-      fFunctions(fNCoefficients, j) = 1;
-      fOrthFunctions(fNCoefficients, j) = 0;
-      // First, however, we need to calculate f_fNCoefficients
-      for (k = 0; k < fNVariables; k++) {
-         Int_t    p   =  fPowers[function * fNVariables + k];
-         Double_t x   =  fVariables(j * fNVariables + k);
-         fFunctions(fNCoefficients, j) *= EvalFactor(p,x);
+   // point i, f dot f, and f_fNCoefficients dot w_j for each j
+   std::vector<Double_t> sums(nblocks * (nc + 1));
+   ROOT::Internal::Hist::Foreach(nblocks, work, [&](Int_t b) {
+      const Int_t first = b * kSampleBlock;
+      const Int_t last  = TMath::Min(first + kSampleBlock, fSampleSize);
+      Double_t *blockSums = &sums[b * (nc + 1)];
+      Double_t f2 = 0;
+      for (Int_t j = first; j < last; j++) {
+         Double_t fj = 1;
+         for (Int_t k = 0; k < fNVariables; k++)
+            fj *= EvalFactor(powers[k], x[j * fNVariables + k]);
+         f[j] = fj;
+         f2  += fj * fj;
       }
-
-      // Calculate f dot f in f2
-      f2 += fFunctions(fNCoefficients,j) *  fFunctions(fNCoefficients,j);
-      // Assign to w_fNCoefficients f_fNCoefficients
-      fOrthFunctions(fNCoefficients, j) = fFunctions(fNCoefficients, j);
-   }
-
-   // the first column of w is equal to f
-   for (j = 0; j < fNCoefficients; j++) {
-      Double_t fdw = 0;
-      // Calculate (f_fNCoefficients dot w_j) / w_j^2
-      for (k = 0; k < fSampleSize; k++) {
-         fdw += fFunctions(fNCoefficients, k) * fOrthFunctions(j,k)
-         / fOrthFunctionNorms(j);
+      blockSums[0] = f2;
+      for (Int_t l = 0; l < nc; l++) {
+         const Double_t *wl = w + Long64_t(l) * fSampleSize;
+         Double_t fdw = 0;
+         for (Int_t j = first; j < last; j++)
+            fdw += f[j] * wl[j];
+         blockSums[l + 1] = fdw;
       }
-
-      fOrthCurvatureMatrix(fNCoefficients,j) = fdw;
-      // and subtract it from the current value of w_ij
-      for (k = 0; k < fSampleSize; k++)
-         fOrthFunctions(fNCoefficients,k) -= fdw * fOrthFunctions(j,k);
+   });
+
+   Double_t f2 = 0;
+   std::vector<Double_t> fdw(nc, 0.);
+   for (Int_t b = 0; b < nblocks; b++) {
+      f2 += sums[b * (nc + 1)];
+      for (Int_t l = 0; l < nc; l++)
+         fdw[l] += sums[b * (nc + 1) + l + 1];
+   }
+   // (f_fNCoefficients dot w_j) / w_j^2
+   for (Int_t l = 0; l < nc; l++) {
+      fdw[l] /= fOrthFunctionNorms(l);
+      fOrthCurvatureMatrix(nc,l) = fdw[l];
    }
 
-   for (j = 0; j < fSampleSize; j++) {
-      // calculate squared length of w_fNCoefficients
-      fOrthFunctionNorms(fNCoefficients) +=
-      fOrthFunctions(fNCoefficients,j)
-      * fOrthFunctions(fNCoefficients,j);
-
-      // calculate D dot w_fNCoefficients in A
-      fOrthCoefficients(fNCoefficients) += fQuantity(j)
-      * fOrthFunctions(fNCoefficients, j);
+   // the first column of w is equal to f, subtract the projections
+   // on the previous w_j, and calculate the squared length of
+   // w_fNCoefficients and D dot w_fNCoefficients in A
+   ROOT::Internal::Hist::Foreach(nblocks, work, [&](Int_t b) {
+      const Int_t first = b * kSampleBlock;
+      const Int_t last  = TMath::Min(first + kSampleBlock, fSampleSize);
+      for (Int_t j = first; j < last; j++)
+         wc[j] = f[j];
+      for (Int_t l = 0; l < nc; l++) {
+         const Double_t *wl = w + Long64_t(l) * fSampleSize;
+         for (Int_t j = first; j < last; j++)
+            wc[j] -= fdw[l] * wl[j];
+      }
+      Double_t norm = 0, dw = 0;
+      for (Int_t j = first; j < last; j++) {
+         norm += wc[j] * wc[j];
+         dw   += d[j] * wc[j];
+      }
+      sums[2 * b]     = norm;
+      sums[2 * b + 1] = dw;
+   });
+
+   fOrthFunctionNorms(nc) = 0;
+   fOrthCoefficients(nc)  = 0;
+   for (Int_t b = 0; b < nblocks; b++) {
+      fOrthFunctionNorms(nc) += sums[2 * b];
+      fOrthCoefficients(nc)  += sums[2 * b + 1];
    }
 
    // First test, but only if didn't user specify
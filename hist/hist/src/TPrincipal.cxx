@@ -219,10 +219,77 @@ Christian Holm August 2000, CERN
 #include "TBrowser.h"
 #include "TROOT.h"
 #include "Riostream.h"
+#include "HistParallel.h"
+
+#include <algorithm>
+#include <vector>
 
 
 ClassImp(TPrincipal);
 
+namespace {
+
+/// Number of rows of the blocks of TPrincipal::AddRows
+constexpr Long64_t kRowBlock = 256;
+/// Number of blocks whose moments are computed together before being added
+constexpr Long64_t kBlocksPerGroup = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mean values and covariance matrix (lower triangle, nvar x nvar) of the
+/// nrows rows of x. The centered values are transposed into buffer, so that
+/// the covariance is computed as a rank-nrows update with contiguous inner loops.
+
+void BlockMoments(Int_t nvar, Int_t nrows, const Double_t *x, Double_t *mean, Double_t *cov,
+                  std::vector<Double_t> &buffer)
+{
+   std::fill(mean, mean + nvar, 0.);
+   for (Int_t r = 0; r < nrows; r++)
+      for (Int_t i = 0; i < nvar; i++)
+         mean[i] += x[r * nvar + i];
+   for (Int_t i = 0; i < nvar; i++)
+      mean[i] /= nrows;
+
+   buffer.resize(nvar * nrows);
+   for (Int_t r = 0; r < nrows; r++)
+      for (Int_t i = 0; i < nvar; i++)
+         buffer[i * nrows + r] = x[r * nvar + i] - mean[i];
+
+   for (Int_t i = 0; i < nvar; i++) {
+      const Double_t *ci = &buffer[i * nrows];
+      for (Int_t j = 0; j <= i; j++) {
+         const Double_t *cj = &buffer[j * nrows];
+         Double_t sum = 0;
+         for (Int_t r = 0; r < nrows; r++)
+            sum += ci[r] * cj[r];
+         cov[i * nvar + j] = sum / nrows;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Combine the mean values and covariance matrix (lower triangle) of na data
+/// points with those of nb other points, see T.F. Chan, G.H. Golub and
+/// R.J. LeVeque, "Updating formulae and a pairwise algorithm for computing
+/// sample variances", STAN-CS-79-773 (1979).
+
+void AddMoments(Int_t nvar, Double_t na, Double_t *mean, Double_t *cov, Double_t nb, const Double_t *meanB,
+                const Double_t *covB)
+{
+   const Double_t fa = na / (na + nb);
+   const Double_t fb = nb / (na + nb);
+   for (Int_t i = 0; i < nvar; i++) {
+      const Double_t di = meanB[i] - mean[i];
+      for (Int_t j = 0; j <= i; j++) {
+         const Int_t index = i * nvar + j;
+         cov[index] = fa * cov[index] + fb * covB[index] + fa * fb * di * (meanB[j] - mean[j]);
+      }
+   }
+   for (Int_t i = 0; i < nvar; i++)
+      mean[i] += fb * (meanB[i] - mean[i]);
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Empty constructor. Do not use.
 
@@ -311,7 +378,7 @@ TPrincipal::TPrincipal(Long64_t nVariables, Option_t *opt)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Copy constructor.
+/// Copy constructor. The histograms are not copied.
 
 TPrincipal::TPrincipal(const TPrincipal& pr) :
   TNamed(pr),
@@ -325,7 +392,7 @@ TPrincipal::TPrincipal(const TPrincipal& pr) :
   fOffDiagonal(pr.fOffDiagonal),
   fUserData(pr.fUserData),
   fTrace(pr.fTrace),
-  fHistograms(pr.fHistograms),
+  fHistograms(nullptr),
   fIsNormalised(pr.fIsNormalised),
   fStoreData(pr.fStoreData)
 {
@@ -465,6 +532,65 @@ void TPrincipal::AddRow(const Double_t *p)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add nRows data points and update the covariance matrix. The input
+/// array holds the rows one after the other, it must be
+/// <TT>nRows * fNumberOfVariables</TT> long.
+///
+/// The result is the same as calling AddRow() for each row, up to rounding,
+/// but much faster for many rows: the mean values and covariance matrix of
+/// blocks of rows are computed with vectorisable loops, in parallel when
+/// implicit multithreading is enabled, and combined in order with the
+/// accumulated ones. The result doesn't depend on the number of threads.
+
+void TPrincipal::AddRows(Long64_t nRows, const Double_t *x)
+{
+   if (!x || nRows <= 0)
+      return;
+   if (nRows > std::numeric_limits<Int_t>::max() - fNumberOfDataPoints) {
+      Error("AddRows", "`fNumberOfDataPoints` would exceed its allowed maximum %d, cannot add %lld rows.",
+            std::numeric_limits<Int_t>::max(), nRows);
+      return;
+   }
+
+   const Int_t nvar = fNumberOfVariables;
+   const Long64_t nstats = nvar + nvar * nvar;
+   const Long64_t nblocks = (nRows + kRowBlock - 1) / kRowBlock;
+   const Int_t firstRow = fNumberOfDataPoints;
+   Double_t *meanValues = fMeanValues.GetMatrixArray();
+   Double_t *covMatrix = fCovarianceMatrix.GetMatrixArray();
+
+   std::vector<Double_t> stats(std::min(nblocks, kBlocksPerGroup) * nstats);
+   for (Long64_t first = 0; first < nblocks; first += kBlocksPerGroup) {
+      const Int_t nGroup = std::min(kBlocksPerGroup, nblocks - first);
+      auto blockRows = [&](Int_t b) { return (Int_t)std::min(kRowBlock, nRows - (first + b) * kRowBlock); };
+      ROOT::Internal::Hist::Foreach(nGroup, nGroup * kRowBlock * nvar * nvar, [&](Int_t b) {
+         std::vector<Double_t> buffer;
+         Double_t *blockStats = &stats[b * nstats];
+         BlockMoments(nvar, blockRows(b), x + (first + b) * kRowBlock * nvar, blockStats, blockStats + nvar, buffer);
+      });
+      for (Int_t b = 0; b < nGroup; b++) {
+         const Double_t *blockStats = &stats[b * nstats];
+         AddMoments(nvar, fNumberOfDataPoints, meanValues, covMatrix, blockRows(b), blockStats, blockStats + nvar);
+         fNumberOfDataPoints += blockRows(b);
+      }
+   }
+
+   // Store the data points in the internal vector
+   if (!fStoreData)
+      return;
+   const Long64_t needed = Long64_t(fNumberOfDataPoints) * nvar;
+   if (needed > std::numeric_limits<Int_t>::max()) {
+      Error("AddRows", "the stored data would exceed %d values, the rows are not stored.",
+            std::numeric_limits<Int_t>::max());
+      return;
+   }
+   const Int_t size = fUserData.GetNrows();
+   if (needed > size)
+      fUserData.ResizeTo(std::max<Long64_t>(needed, std::min<Long64_t>(size + size / 2, std::numeric_limits<Int_t>::max())));
+   std::copy(x, x + nRows * nvar, fUserData.GetMatrixArray() + Long64_t(firstRow) * nvar);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Browse the TPrincipal object in the TBrowser.
 
@@ -875,6 +1001,63 @@ void TPrincipal::MakeMethods(const char *classname, Option_t *opt)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the data points of the TPrincipal objects of list into this one,
+/// e.g. objects filled in parallel. The mean values and covariance matrices
+/// are combined exactly; the stored data points, if any, are appended.
+/// The principal components have to be computed again with MakePrincipals().
+/// Returns the number of data points, or -1 in case of error.
+
+Long64_t TPrincipal::Merge(TCollection *list)
+{
+   if (!list)
+      return fNumberOfDataPoints;
+
+   TIter next(list);
+   while (TObject *obj = next()) {
+      auto *other = dynamic_cast<TPrincipal *>(obj);
+      if (!other) {
+         Error("Merge", "Cannot merge an object of class %s", obj->ClassName());
+         return -1;
+      }
+      if (other->fNumberOfVariables != fNumberOfVariables) {
+         Error("Merge", "Cannot merge objects with %d and %d variables", fNumberOfVariables,
+               other->fNumberOfVariables);
+         return -1;
+      }
+      if (other->fNumberOfDataPoints == 0)
+         continue;
+      if (other->fNumberOfDataPoints > std::numeric_limits<Int_t>::max() - fNumberOfDataPoints) {
+         Error("Merge", "`fNumberOfDataPoints` would exceed its allowed maximum %d", std::numeric_limits<Int_t>::max());
+         return -1;
+      }
+
+      if (fStoreData) {
+         if (other->fStoreData) {
+            const Long64_t offset = Long64_t(fNumberOfDataPoints) * fNumberOfVariables;
+            const Long64_t n = Long64_t(other->fNumberOfDataPoints) * fNumberOfVariables;
+            if (offset + n > std::numeric_limits<Int_t>::max()) {
+               Error("Merge", "The stored data would exceed %d values", std::numeric_limits<Int_t>::max());
+               return -1;
+            }
+            if (offset + n > fUserData.GetNrows())
+               fUserData.ResizeTo(offset + n);
+            std::copy(other->fUserData.GetMatrixArray(), other->fUserData.GetMatrixArray() + n,
+                      fUserData.GetMatrixArray() + offset);
+         } else {
+            Warning("Merge", "The data points of %s are not stored, the stored data will be incomplete",
+                    other->GetName());
+         }
+      }
+
+      AddMoments(fNumberOfVariables, fNumberOfDataPoints, fMeanValues.GetMatrixArray(),
+                 fCovarianceMatrix.GetMatrixArray(), other->fNumberOfDataPoints,
+                 other->fMeanValues.GetMatrixArray(), other->fCovarianceMatrix.GetMatrixArray());
+      fNumberOfDataPoints += other->fNumberOfDataPoints;
+   }
+   return fNumberOfDataPoints;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Perform the principal components analysis.
 /// This is done in several stages in the TMatrix::EigenVectors method:
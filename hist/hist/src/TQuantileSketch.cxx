@@ -0,0 +1,291 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TQuantileSketch.h"
+#include "TCollection.h"
+#include "TMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+ClassImp(TQuantileSketch);
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** \class TQuantileSketch
+    \ingroup Histograms
+Streaming approximation of the quantiles of a dataset, that can be filled like a
+histogram without storing the data, and merged.
+
+It implements the merging t-digest of T. Dunning and O. Ertl ("Computing extremely
+accurate quantiles using t-digests", arXiv:1902.04023): the data are summarised by
+centroids (a mean and a weight), small near the extremes of the distribution and
+larger in its bulk. The quantiles are interpolated between the centroids; their
+relative accuracy is best for probabilities close to 0 and 1. The number of
+centroids, hence the memory and the accuracy, is set by the compression: it is
+smaller than the compression and grows only logarithmically with the number of
+entries.
+
+Filled values are buffered and merged into the centroids in groups. Sketches with
+the same compression can be merged with Merge(), e.g. the per-thread sketches of
+RDataFrame's Fill action:
+
+~~~{.cpp}
+TQuantileSketch model("q", "quantiles of x");
+auto sketch = df.Fill(model, {"x"});
+double median = sketch->GetQuantile(0.5);
+~~~
+
+Only positive weights are supported: entries with a weight <= 0 are ignored.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor.
+
+TQuantileSketch::TQuantileSketch()
+   : fMin(std::numeric_limits<Double_t>::infinity()), fMax(-std::numeric_limits<Double_t>::infinity())
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a sketch with the given compression (at least 10).
+
+TQuantileSketch::TQuantileSketch(const char *name, const char *title, Double_t compression)
+   : TNamed(name, title),
+     fCompression(std::max(compression, 10.)),
+     fMin(std::numeric_limits<Double_t>::infinity()),
+     fMax(-std::numeric_limits<Double_t>::infinity())
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the value x with weight w.
+
+void TQuantileSketch::Fill(Double_t x, Double_t w)
+{
+   if (!(w > 0) || TMath::IsNaN(x))
+      return;
+   fBufferX.push_back(x);
+   fBufferW.push_back(w);
+   fSumW += w;
+   ++fEntries;
+   fMin = std::min(fMin, x);
+   fMax = std::max(fMax, x);
+   if (fBufferX.size() >= GetBufferSize())
+      Compress();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the n values x[0], x[stride], ... with the weights w (or 1 if w is null).
+
+void TQuantileSketch::FillN(Int_t n, const Double_t *x, const Double_t *w, Int_t stride)
+{
+   for (Int_t i = 0; i < n; ++i)
+      Fill(x[i * stride], w ? w[i * stride] : 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the (unsorted) centroids means, with the given weights, with the centroids
+/// of the sketch. fSumW must already include their weights.
+
+void TQuantileSketch::AddCentroids(const std::vector<Double_t> &means, const std::vector<Double_t> &weights)
+{
+   const std::size_t n = fMeans.size() + means.size();
+   std::vector<Double_t> allMeans(fMeans);
+   std::vector<Double_t> allWeights(fWeights);
+   allMeans.insert(allMeans.end(), means.begin(), means.end());
+   allWeights.insert(allWeights.end(), weights.begin(), weights.end());
+   std::vector<std::size_t> order(n);
+   std::iota(order.begin(), order.end(), 0);
+   std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) { return allMeans[i] < allMeans[j]; });
+
+   // scale function k2 of the t-digest: a centroid spans at most one unit of k, so that the
+   // size of the centroids is proportional to q(1-q) and the extreme ones are single values
+   const Double_t norm = fCompression / (4. * std::log(std::max(fSumW / fCompression, 1.)) + 24.);
+   auto k = [&](Double_t q) { return norm * std::log(q / (1. - q)); };
+
+   fMeans.clear();
+   fWeights.clear();
+   Double_t mean = allMeans[order[0]];
+   Double_t weight = allWeights[order[0]];
+   Double_t weightSoFar = 0;
+   Double_t kLeft = k(0.);
+   for (std::size_t i = 1; i < n; ++i) {
+      const Double_t x = allMeans[order[i]];
+      const Double_t w = allWeights[order[i]];
+      if (k((weightSoFar + weight + w) / fSumW) - kLeft <= 1.) {
+         weight += w;
+         mean += (x - mean) * w / weight;
+      } else {
+         fMeans.push_back(mean);
+         fWeights.push_back(weight);
+         weightSoFar += weight;
+         kLeft = k(weightSoFar / fSumW);
+         mean = x;
+         weight = w;
+      }
+   }
+   fMeans.push_back(mean);
+   fWeights.push_back(weight);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the buffered values into the centroids.
+
+void TQuantileSketch::Compress()
+{
+   if (fBufferX.empty())
+      return;
+   AddCentroids(fBufferX, fBufferW);
+   fBufferX.clear();
+   fBufferW.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the entries of the TQuantileSketch objects in list to this sketch.
+/// Returns the number of entries, or -1 if list contains other objects.
+
+Long64_t TQuantileSketch::Merge(TCollection *list)
+{
+   if (!list)
+      return fEntries;
+   std::vector<Double_t> means, weights;
+   TIter next(list);
+   while (TObject *obj = next()) {
+      auto sketch = dynamic_cast<TQuantileSketch *>(obj);
+      if (!sketch) {
+         Error("Merge", "Cannot merge object %s of class %s", obj->GetName(), obj->ClassName());
+         return -1;
+      }
+      means.insert(means.end(), sketch->fMeans.begin(), sketch->fMeans.end());
+      means.insert(means.end(), sketch->fBufferX.begin(), sketch->fBufferX.end());
+      weights.insert(weights.end(), sketch->fWeights.begin(), sketch->fWeights.end());
+      weights.insert(weights.end(), sketch->fBufferW.begin(), sketch->fBufferW.end());
+      fSumW += sketch->fSumW;
+      fEntries += sketch->fEntries;
+      fMin = std::min(fMin, sketch->fMin);
+      fMax = std::max(fMax, sketch->fMax);
+   }
+   means.insert(means.end(), fBufferX.begin(), fBufferX.end());
+   weights.insert(weights.end(), fBufferW.begin(), fBufferW.end());
+   fBufferX.clear();
+   fBufferW.clear();
+   if (!means.empty())
+      AddCentroids(means, weights);
+   return fEntries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all entries.
+
+void TQuantileSketch::Reset(Option_t *)
+{
+   fSumW = 0;
+   fEntries = 0;
+   fMin = std::numeric_limits<Double_t>::infinity();
+   fMax = -std::numeric_limits<Double_t>::infinity();
+   fMeans.clear();
+   fWeights.clear();
+   fBufferX.clear();
+   fBufferW.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the number of entries and of centroids, and with option "all" the centroids.
+
+void TQuantileSketch::Print(Option_t *option) const
+{
+   Printf("TQuantileSketch %s: %lld entries, sum of weights %g, range [%g, %g], %d centroids", GetName(), fEntries,
+          fSumW, fMin, fMax, GetNCentroids());
+   if (TString(option).Contains("all", TString::kIgnoreCase)) {
+      for (std::size_t i = 0; i < fMeans.size(); ++i)
+         Printf("  mean %g weight %g", fMeans[i], fWeights[i]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of centroids, after merging the buffered values.
+
+Int_t TQuantileSketch::GetNCentroids() const
+{
+   const_cast<TQuantileSketch *>(this)->Compress();
+   return fMeans.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the approximate quantile of probability prob, or NaN if the sketch is empty.
+/// The quantile is interpolated linearly between the centroids, each placed at the
+/// middle of its weight, and between the extreme centroids and the minimum and maximum.
+
+Double_t TQuantileSketch::GetQuantile(Double_t prob) const
+{
+   const_cast<TQuantileSketch *>(this)->Compress();
+   const std::size_t n = fMeans.size();
+   if (n == 0)
+      return TMath::QuietNaN();
+   prob = std::min(std::max(prob, 0.), 1.);
+   if (n == 1)
+      return fMin + prob * (fMax - fMin);
+
+   const Double_t target = prob * fSumW;
+   Double_t cum = fWeights[0] / 2;
+   if (target <= cum)
+      return fMin + (fMeans[0] - fMin) * target / cum;
+   for (std::size_t i = 0; i + 1 < n; ++i) {
+      const Double_t next = cum + (fWeights[i] + fWeights[i + 1]) / 2;
+      if (target <= next)
+         return fMeans[i] + (fMeans[i + 1] - fMeans[i]) * (target - cum) / (next - cum);
+      cum = next;
+   }
+   return fMeans[n - 1] + (fMax - fMeans[n - 1]) * std::min(1., (target - cum) / (fSumW - cum));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the quantiles q of the probabilities probSum, as TH1::GetQuantiles().
+/// If probSum is null, the quantiles are computed at the probabilities
+/// 1/nprobSum, 2/nprobSum, ..., 1. Returns the number of quantiles computed.
+
+Int_t TQuantileSketch::GetQuantiles(Int_t nprobSum, Double_t *q, const Double_t *probSum) const
+{
+   for (Int_t i = 0; i < nprobSum; ++i)
+      q[i] = GetQuantile(probSum ? probSum[i] : Double_t(i + 1) / nprobSum);
+   return nprobSum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the approximate fraction of the sum of weights of the values below x,
+/// interpolated as for GetQuantile().
+
+Double_t TQuantileSketch::GetCDF(Double_t x) const
+{
+   const_cast<TQuantileSketch *>(this)->Compress();
+   const std::size_t n = fMeans.size();
+   if (n == 0)
+      return TMath::QuietNaN();
+   if (x < fMin)
+      return 0.;
+   if (x >= fMax)
+      return 1.;
+   if (n == 1)
+      return (x - fMin) / (fMax - fMin);
+
+   Double_t cum = fWeights[0] / 2;
+   if (x < fMeans[0])
+      return cum * (x - fMin) / (fMeans[0] - fMin) / fSumW;
+   for (std::size_t i = 0; i + 1 < n; ++i) {
+      const Double_t next = cum + (fWeights[i] + fWeights[i + 1]) / 2;
+      if (x < fMeans[i + 1])
+         return (cum + (next - cum) * (x - fMeans[i]) / (fMeans[i + 1] - fMeans[i])) / fSumW;
+      cum = next;
+   }
+   return (cum + (fSumW - cum) * (x - fMeans[n - 1]) / (fMax - fMeans[n - 1])) / fSumW;
+}
@@ -790,6 +790,36 @@ Double_t TSpline3::Eval(Double_t x) const
    return fPoly[klow].Eval(x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the knot interval of x as FindX(x), checking first the interval hint and
+/// the next one, e.g. the interval of a previous, close, value of x.
+
+Int_t TSpline3::FindX(Double_t x, Int_t hint) const
+{
+   if (!fKstep && x > fXmin && x < fXmax) {
+      for (Int_t k = hint; k >= 0 && k < fNp - 1 && k <= hint + 1; ++k) {
+         if (fPoly[k].X() < x && x <= fPoly[k + 1].X())
+            return k;
+      }
+   }
+   return FindX(x);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Eval this spline at the n points x, and store the values in y. The search of
+/// the knot interval of each point starts from the one of the previous point.
+/// Like Eval(Double_t), it does not modify the spline and can be called concurrently.
+
+void TSpline3::Eval(Int_t n, const Double_t *x, Double_t *y) const
+{
+   Int_t klow = 0;
+   for (Int_t i = 0; i < n; ++i) {
+      klow = FindX(x[i], klow);
+      const Int_t k = (klow >= fNp-1 && fNp > 1) ? fNp-2 : klow;
+      y[i] = fPoly[k].Eval(x[i]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Derivative.
 
@@ -1566,6 +1596,35 @@ Double_t TSpline5::Eval(Double_t x) const
    return fPoly[klow].Eval(x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the knot interval of x as FindX(x), checking first the interval hint and
+/// the next one, e.g. the interval of a previous, close, value of x.
+
+Int_t TSpline5::FindX(Double_t x, Int_t hint) const
+{
+   if (!fKstep && x > fXmin && x < fXmax) {
+      for (Int_t k = hint; k >= 0 && k < fNp - 1 && k <= hint + 1; ++k) {
+         if (fPoly[k].X() < x && x <= fPoly[k + 1].X())
+            return k;
+      }
+   }
+   return FindX(x);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Eval this spline at the n points x, and store the values in y. The search of
+/// the knot interval of each point starts from the one of the previous point.
+/// Like Eval(Double_t), it does not modify the spline and can be called concurrently.
+
+void TSpline5::Eval(Int_t n, const Double_t *x, Double_t *y) const
+{
+   Int_t klow = 0;
+   for (Int_t i = 0; i < n; ++i) {
+      klow = FindX(x[i], klow);
+      y[i] = fPoly[klow].Eval(x[i]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Derivative.
 
@@ -14,6 +14,7 @@
 #include "TPluginManager.h"
 
 TVirtualGraphPainter *TVirtualGraphPainter::fgPainter = nullptr;
+Int_t TVirtualGraphPainter::fgDecimationThreshold = 10000;
 
 ClassImp(TVirtualGraphPainter);
 
@@ -48,3 +49,26 @@ void TVirtualGraphPainter::SetPainter(TVirtualGraphPainter *painter)
 {
    fgPainter = painter;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning the number of points above which graphs drawn
+/// with a line or with markers are decimated when painted, see
+/// SetDecimationThreshold().
+
+Int_t TVirtualGraphPainter::GetDecimationThreshold()
+{
+   return fgDecimationThreshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function to set the number of points above which graphs are
+/// decimated when painted. Only the points which make a difference on the
+/// pixels of the pad are then sent to the pad painter: for a line, the first,
+/// last, minimum and maximum points of each pixel column; for markers, one
+/// point per pixel. The reduction is computed at paint time, hence again at
+/// each zoom. A value of 0 disables the decimation.
+
+void TVirtualGraphPainter::SetDecimationThreshold(Int_t npoints)
+{
+   fgDecimationThreshold = npoints < 0 ? 0 : npoints;
+}
@@ -21,6 +21,7 @@
 #include <TFormula.h>
 #include <TF1.h>
 #include <TF2.h>
+#include <TH1.h>
 #include <TFitResult.h>
 
 #include "gtest/gtest.h"
@@ -165,3 +166,28 @@ TEST(TFormulaGradientPar, GetGradFormula)
 #endif // R__WIN32
 }
 
+
+// A default fit of a formula function uses the gradient from clad,
+// and gives the same result as a fit with numerical derivatives
+TEST(TFormulaGradientPar, FitUsesGradientByDefault)
+{
+   TH1D h("h", "h", 50, -5, 5);
+   h.SetDirectory(nullptr);
+   TF1 gen("gen", "gaus", -5, 5);
+   gen.SetParameters(1, 0.5, 1.2);
+   h.FillRandom("gen", 10000);
+
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+   f1.SetParameters(500, 0, 1);
+   auto r1 = h.Fit(&f1, "S Q N");
+   EXPECT_TRUE(f1.GetFormula()->HasGeneratedGradient());
+
+   TF1 f2("f2", "[0]*exp(-0.5*((x-[1])/[2])*((x-[1])/[2]))", -5, 5);
+   f2.SetParameters(500, 0, 1);
+   auto r2 = h.Fit(&f2, "S Q N NUMGRAD");
+   EXPECT_FALSE(f2.GetFormula()->HasGeneratedGradient());
+
+   EXPECT_LT(r1->NCalls(), r2->NCalls());
+   for (int i = 0; i < 3; ++i)
+      EXPECT_NEAR(r1->Parameter(i), r2->Parameter(i), 1e-3 * r2->ParError(i));
+}
@@ -1,8 +1,14 @@
 #include "gtest/gtest.h"
 
 #include "THn.h"
+#include "THnSparse.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TList.h"
+#include "TRandom3.h"
+
+#include <map>
+#include <vector>
 
 // Filling THn
 TEST(THn, Fill) {
@@ -144,3 +150,77 @@ TEST(THn, GetBinCenter)
    EXPECT_DOUBLE_EQ(centers.at(0), 2.5);
    EXPECT_DOUBLE_EQ(centers.at(1), -1.5);
 }
+
+// Merging THn with the same binning adds the arrays directly: the result must be the same
+// as adding them bin by bin, also when only some of the inputs have errors.
+TEST(THn, MergeSameBinning)
+{
+   Int_t bins[3] = {20, 30, 10};
+   Double_t xmin[3] = {0., -1., 0.};
+   Double_t xmax[3] = {1., 1., 10.};
+   THnD merged("merged", "merged", 3, bins, xmin, xmax);
+   THnD added("added", "added", 3, bins, xmin, xmax);
+   std::vector<std::unique_ptr<THnF>> inputs;
+   TList list;
+   TRandom3 rndm(7);
+   for (Int_t i = 0; i < 4; ++i) {
+      inputs.emplace_back(new THnF(TString::Format("h%d", i), "h", 3, bins, xmin, xmax));
+      if (i == 2)
+         inputs.back()->Sumw2();
+      Double_t x[3];
+      for (Int_t j = 0; j < 5000; ++j) {
+         x[0] = rndm.Uniform(-0.1, 1.1);
+         x[1] = rndm.Gaus();
+         x[2] = rndm.Uniform(0., 10.);
+         inputs.back()->Fill(x, i == 2 ? 0.5 : 1.);
+      }
+      list.Add(inputs.back().get());
+      added.RebinnedAdd(inputs.back().get());
+   }
+   merged.Merge(&list);
+
+   EXPECT_TRUE(merged.GetCalculateErrors());
+   EXPECT_DOUBLE_EQ(added.GetEntries(), merged.GetEntries());
+   EXPECT_DOUBLE_EQ(added.GetSumw(), merged.GetSumw());
+   EXPECT_DOUBLE_EQ(added.GetSumw2(), merged.GetSumw2());
+   for (Long64_t bin = 0; bin < added.GetNbins(); ++bin) {
+      EXPECT_EQ(added.GetBinContent(bin), merged.GetBinContent(bin));
+      EXPECT_EQ(added.GetBinError2(bin), merged.GetBinError2(bin));
+   }
+}
+
+// Filling and looking up the bins of a THnSparse, with compact coordinates that fit into
+// the hash (4 dimensions) and that do not, so that hashes can collide (10 dimensions).
+TEST(THnSparse, FillAndLookup)
+{
+   for (Int_t ndim : {4, 10}) {
+      std::vector<Int_t> bins(ndim, 1000);
+      std::vector<Double_t> xmin(ndim, 0.), xmax(ndim, 1.);
+      THnSparseD hs("hs", "hs", ndim, bins.data(), xmin.data(), xmax.data(), 256);
+
+      TRandom3 rndm(42);
+      std::map<std::vector<Int_t>, Double_t> expected;
+      std::vector<Double_t> x(ndim);
+      std::vector<Int_t> coord(ndim);
+      for (Int_t i = 0; i < 20000; ++i) {
+         // few distinct values per axis so that bins are filled several times
+         for (Int_t d = 0; d < ndim; ++d) {
+            coord[d] = 1 + rndm.Integer(ndim == 4 ? 20 : 3);
+            x[d] = (coord[d] - 0.5) / 1000.;
+         }
+         const Double_t w = rndm.Uniform(0.5, 1.5);
+         hs.Fill(x.data(), w);
+         expected[coord] += w;
+      }
+
+      EXPECT_EQ((Long64_t)expected.size(), hs.GetNbins());
+      for (const auto &binAndContent : expected) {
+         const Long64_t bin = hs.GetBin(binAndContent.first.data(), kFALSE);
+         ASSERT_GE(bin, 0);
+         EXPECT_DOUBLE_EQ(binAndContent.second, hs.GetBinContent(bin));
+      }
+      for (Int_t d = 0; d < ndim; ++d)
+         coord[d] = 500;
+      EXPECT_EQ(-1, hs.GetBin(coord.data(), kFALSE));
+   }
+}
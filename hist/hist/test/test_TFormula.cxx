@@ -2,8 +2,31 @@
 
 #include "TFormula.h"
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
 // Test that autoloading works (ROOT-9840)
 TEST(TFormula, Interp)
 {
   TFormula f("func", "TGeoBBox::DeclFileLine()");
 }
+
+// Test that the compiled expressions are written out for a library of compiled formulas
+TEST(TFormula, WriteCompiledFormulas)
+{
+  TFormula f1("f1", "[0]*exp(-x/[1])");
+  TFormula f2("f2", "[a] * exp(-x / [b])");
+  EXPECT_EQ(f1.GetUniqueFuncName(), f2.GetUniqueFuncName());
+
+  const char *fileName = "test_TFormula_compiled.cxx";
+  EXPECT_GE(TFormula::WriteCompiledFormulas(fileName), 1);
+  std::ifstream in(fileName);
+  std::string code((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  EXPECT_NE(code.find(f1.GetUniqueFuncName().Data()), std::string::npos);
+  EXPECT_NE(code.find("ROOT_TFormula_CompiledFuncs"), std::string::npos);
+  std::remove(fileName);
+
+  EXPECT_FALSE(TFormula::LoadCompiledFormulas("libDoesNotExist"));
+}
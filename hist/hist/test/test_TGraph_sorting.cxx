@@ -5,6 +5,7 @@
 #include "TGraphMultiErrors.h"
 #include "TGraphBentErrors.h"
 
+#include <cmath>
 #include <vector>
 
 TEST(TGraphSortTest, TGraphSortingTest)
@@ -153,3 +154,31 @@ TEST(TGraphSortTest, TGraphMultiErrorsSortingTest)
     ASSERT_TRUE(isValSorted);
     ASSERT_TRUE(isErrSorted);
 }
+
+TEST(TGraphSortTest, TGraphSortedEvalTest)
+{
+   const int n = 100;
+   TGraph sorted(n);
+   TGraph unsorted(n);
+   for (int i = 0; i < n; i++) {
+      sorted.SetPoint(i, i * 0.5, std::sin(i * 0.5));
+      unsorted.SetPoint(n - 1 - i, i * 0.5, std::sin(i * 0.5));
+   }
+   sorted.SetBit(TGraph::kIsSortedX);
+
+   // points in increasing, decreasing and random order, inside and outside of the graph
+   std::vector<Double_t> x;
+   for (int i = 0; i < 300; i++)
+      x.push_back(-2. + i * 0.2);
+   for (int i = 0; i < 300; i++)
+      x.push_back(58. - i * 0.2);
+   for (int i = 0; i < 300; i++)
+      x.push_back(-2. + (i * 37 % 300) * 0.2);
+
+   std::vector<Double_t> y(x.size());
+   sorted.Eval(x.size(), x.data(), y.data());
+   for (std::size_t i = 0; i < x.size(); i++) {
+      EXPECT_DOUBLE_EQ(sorted.Eval(x[i]), unsorted.Eval(x[i])) << "x = " << x[i];
+      EXPECT_DOUBLE_EQ(y[i], unsorted.Eval(x[i])) << "x = " << x[i];
+   }
+}
@@ -1,9 +1,12 @@
 #include "gtest/gtest.h"
 
 #include "TH1.h"
+#include "TH1D.h"
 #include "TH1F.h"
+#include "TH2D.h"
 #include "THLimitsFinder.h"
 
+#include <limits>
 #include <vector>
 
 // StatOverflows TH1
@@ -63,3 +66,101 @@ TEST(TH1, SmoothArrayCrossCheck)
       EXPECT_FLOAT_EQ(arr2[i], 1.0);
    }
 }
+
+// TH1::FillN and TH2::FillN look up the bins of blocks of entries at once:
+// the result must be the same as filling the entries one by one.
+TEST(TH1, FillNSameAsFill)
+{
+   const int n = 1000;
+   std::vector<double> x(n), y(n), w(n);
+   for (int i = 0; i < n; ++i) {
+      x[i] = -1.5 + 3. * i / n;
+      y[i] = 2. - 4. * ((i * 7) % n) / n;
+      w[i] = (i % 3) ? 1. : 0.5 + 0.001 * i;
+   }
+   x[10] = std::numeric_limits<double>::quiet_NaN();
+   x[20] = 1e300;
+   y[30] = -1e300;
+
+   const double edges[] = {-1., -0.5, 0., 0.1, 0.2, 0.8, 1.};
+   for (bool variable : {false, true}) {
+      TH1D h1("h1", "h1", 6, -1, 1);
+      TH1D h1n("h1n", "h1n", 6, -1, 1);
+      TH2D h2("h2", "h2", 6, -1, 1, 5, -1, 1);
+      TH2D h2n("h2n", "h2n", 6, -1, 1, 5, -1, 1);
+      if (variable) {
+         for (TH1 *h : {(TH1 *)&h1, (TH1 *)&h1n, (TH1 *)&h2, (TH1 *)&h2n})
+            h->GetXaxis()->Set(6, edges);
+      }
+      for (int i = 0; i < n; ++i) {
+         h1.Fill(x[i], w[i]);
+         h2.Fill(x[i], y[i], w[i]);
+      }
+      h1n.FillN(n, x.data(), w.data());
+      h2n.FillN(n, x.data(), y.data(), w.data());
+
+      for (int bin = 0; bin < h1.GetNcells(); ++bin) {
+         EXPECT_EQ(h1.GetBinContent(bin), h1n.GetBinContent(bin));
+         EXPECT_EQ(h1.GetBinError(bin), h1n.GetBinError(bin));
+      }
+      for (int bin = 0; bin < h2.GetNcells(); ++bin) {
+         EXPECT_EQ(h2.GetBinContent(bin), h2n.GetBinContent(bin));
+         EXPECT_EQ(h2.GetBinError(bin), h2n.GetBinError(bin));
+      }
+      double s1[TH1::kNstat], s1n[TH1::kNstat], s2[TH1::kNstat], s2n[TH1::kNstat];
+      h1.GetStats(s1);
+      h1n.GetStats(s1n);
+      h2.GetStats(s2);
+      h2n.GetStats(s2n);
+      for (int i = 0; i < 4; ++i)
+         EXPECT_EQ(s1[i], s1n[i]);
+      for (int i = 0; i < 7; ++i)
+         EXPECT_EQ(s2[i], s2n[i]);
+      EXPECT_EQ(h1.GetEntries(), h1n.GetEntries());
+      EXPECT_EQ(h2.GetEntries(), h2n.GetEntries());
+   }
+}
+
+// The sum of squares of weights of TH1::SetLazySumw2 is created by the first weighted fill,
+// and the histogram then behaves as if Sumw2 had been called from the start
+TEST(TH1, LazySumw2)
+{
+   TH2D lazy("lazy", "lazy", 10, 0, 10, 5, 0, 5);
+   TH2D reference("reference", "reference", 10, 0, 10, 5, 0, 5);
+   lazy.SetLazySumw2();
+   reference.Sumw2();
+   for (int i = 0; i < 100; ++i) {
+      lazy.Fill(i % 12 - 1, i % 6);
+      reference.Fill(i % 12 - 1, i % 6);
+   }
+   EXPECT_TRUE(lazy.TestBit(TH1::kLazySumw2));
+   EXPECT_EQ(lazy.GetSumw2N(), 0);
+   for (int bin = 0; bin < lazy.GetNcells(); ++bin)
+      EXPECT_EQ(lazy.GetBinError(bin), reference.GetBinError(bin));
+
+   lazy.Fill(3.5, 2.5, 3.);
+   reference.Fill(3.5, 2.5, 3.);
+   EXPECT_FALSE(lazy.TestBit(TH1::kLazySumw2));
+   EXPECT_EQ(lazy.GetSumw2N(), lazy.GetNcells());
+   lazy.Add(&reference, 2.);
+   reference.Add(&reference, 2.);
+   for (int bin = 0; bin < lazy.GetNcells(); ++bin)
+      EXPECT_EQ(lazy.GetBinError(bin), reference.GetBinError(bin));
+
+   // an operation changing the errors differently from the contents creates the array
+   TH1D h("h", "h", 10, 0, 10);
+   h.Sumw2();
+   h.Fill(1.5);
+   h.SetLazySumw2();
+   EXPECT_EQ(h.GetSumw2N(), 0);
+   h.SetBinContent(2, 4.);
+   EXPECT_EQ(h.GetSumw2N(), h.GetNcells());
+   EXPECT_EQ(h.GetBinError(2), 1.);
+
+   // the array is kept when the weights were not all 1
+   TH1D weighted("weighted", "weighted", 10, 0, 10);
+   weighted.Fill(1.5, 2.);
+   weighted.SetLazySumw2();
+   EXPECT_FALSE(weighted.TestBit(TH1::kLazySumw2));
+   EXPECT_EQ(weighted.GetSumw2N(), weighted.GetNcells());
+}
@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/TH1ConcurrentFill.hxx"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Fill `model` with the same entries serially and from several threads through a
+// TH1ConcurrentFillManager. With integer values and weights the sums are exact, so the
+// results must be identical whatever the order of the entries.
+template <typename H, typename F>
+void CheckConcurrentFill(const H &model, F fill)
+{
+   const int nThreads = 4;
+   const int nPerThread = 2000;
+
+   std::unique_ptr<H> serial(static_cast<H *>(model.Clone("serial")));
+   serial->SetDirectory(nullptr);
+   for (int t = 0; t < nThreads; ++t)
+      for (int i = 0; i < nPerThread; ++i)
+         fill(*serial, t, i);
+
+   ROOT::Experimental::TH1ConcurrentFillManager manager(model, 3);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&manager, &fill, t]() {
+         auto filler = manager.MakeFiller();
+         // fill half of the entries through the filler and half directly
+         for (int i = 0; i < nPerThread; ++i) {
+            if (i % 2)
+               fill(filler, t, i);
+            else
+               fill(manager, t, i);
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   auto result = manager.GetResult();
+
+   ASSERT_EQ(result->GetNcells(), serial->GetNcells());
+   EXPECT_EQ(result->GetEntries(), serial->GetEntries());
+   for (int bin = 0; bin < serial->GetNcells(); ++bin) {
+      EXPECT_EQ(result->GetBinContent(bin), serial->GetBinContent(bin)) << "bin " << bin;
+      EXPECT_EQ(result->GetBinError(bin), serial->GetBinError(bin)) << "bin " << bin;
+   }
+   Double_t stats[TH1::kNstat] = {}, serialStats[TH1::kNstat] = {};
+   result->GetStats(stats);
+   serial->GetStats(serialStats);
+   for (int i = 0; i < TH1::kNstat; ++i)
+      EXPECT_EQ(stats[i], serialStats[i]) << "statistic " << i;
+}
+
+TEST(TH1ConcurrentFill, TH1D)
+{
+   TH1D model("h", "h", 20, 0, 40);
+   CheckConcurrentFill(model, [](auto &h, int t, int i) { h.Fill((i * 7 + t) % 45 - 2, 1 + (i + t) % 3); });
+}
+
+TEST(TH1ConcurrentFill, TH2D)
+{
+   TH2D model("h", "h", 10, 0, 20, 8, 0, 16);
+   CheckConcurrentFill(model, [](auto &h, int t, int i) { h.Fill((i * 7 + t) % 23 - 1, (i + 3 * t) % 17, 1); });
+}
+
+TEST(TH1ConcurrentFill, TProfile)
+{
+   TProfile model("p", "p", 10, 0, 20);
+   CheckConcurrentFill(model, [](auto &h, int t, int i) { h.Fill((i * 7 + t) % 22 - 1, (i + t) % 5, 1 + i % 2); });
+}
+
+TEST(TH1ConcurrentFill, Unsupported)
+{
+   TProfile2D profile("p", "p", 10, 0, 1, 10, 0, 1);
+   EXPECT_THROW(ROOT::Experimental::TH1ConcurrentFillManager{profile}, std::invalid_argument);
+   TH1D extendable("h", "h", 10, 0, 1);
+   extendable.SetCanExtend(TH1::kAllAxes);
+   EXPECT_THROW(ROOT::Experimental::TH1ConcurrentFillManager{extendable}, std::invalid_argument);
+}
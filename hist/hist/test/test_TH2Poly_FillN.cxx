@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+
+#include "TH2Poly.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+// TH2Poly::FillN finds the bins of all the entries first: the result must be the same
+// as filling them one by one, including overflows and the sea.
+TEST(TH2Poly, FillNSameAsFill)
+{
+   TH2Poly h1("h1", "h1", -1, 21, -1, 21);
+   TH2Poly h2("h2", "h2", -1, 21, -1, 21);
+   h1.Honeycomb(0, 0, 0.2, 50, 50);
+   h2.Honeycomb(0, 0, 0.2, 50, 50);
+
+   const int n = 5000;
+   std::vector<double> x(n), y(n), w(n);
+   TRandom3 rndm(1);
+   for (int i = 0; i < n; ++i) {
+      x[i] = rndm.Uniform(-2, 22);
+      y[i] = rndm.Uniform(-2, 22);
+      w[i] = rndm.Uniform(0.5, 2);
+      h1.Fill(x[i], y[i], w[i]);
+   }
+   h2.FillN(n, x.data(), y.data(), w.data());
+
+   EXPECT_EQ(h1.GetEntries(), h2.GetEntries());
+   for (int bin = -9; bin <= h1.GetNumberOfBins(); ++bin) {
+      if (bin == 0)
+         continue;
+      EXPECT_EQ(h1.GetBinContent(bin), h2.GetBinContent(bin));
+      EXPECT_EQ(h1.GetBinError(bin), h2.GetBinError(bin));
+   }
+   for (int i = 0; i < 100; ++i)
+      EXPECT_EQ(h1.FindBin(x[i], y[i]), h2.FindBin(x[i], y[i]));
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+
+#include "TPrincipal.h"
+#include "TList.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+static std::vector<double> MakeRows(int nrows, int nvar)
+{
+   TRandom3 r(7);
+   std::vector<double> x(nrows * nvar);
+   for (int i = 0; i < nrows; i++) {
+      const double common = r.Gaus();
+      for (int j = 0; j < nvar; j++)
+         x[i * nvar + j] = 10. * j + (j + 1) * common + r.Gaus();
+   }
+   return x;
+}
+
+static void ExpectSameMoments(const TPrincipal &a, const TPrincipal &b, int nvar)
+{
+   for (int i = 0; i < nvar; i++) {
+      EXPECT_NEAR((*a.GetMeanValues())(i), (*b.GetMeanValues())(i), 1e-9);
+      for (int j = 0; j <= i; j++)
+         EXPECT_NEAR((*a.GetCovarianceMatrix())(i, j), (*b.GetCovarianceMatrix())(i, j), 1e-9);
+   }
+}
+
+TEST(TPrincipal, AddRows)
+{
+   const int nvar = 5, nrows = 100003;
+   const auto x = MakeRows(nrows, nvar);
+
+   TPrincipal byRow(nvar, "D");
+   for (int i = 0; i < nrows; i++)
+      byRow.AddRow(&x[i * nvar]);
+   TPrincipal blocked(nvar, "D");
+   blocked.AddRows(1000, x.data());
+   blocked.AddRows(nrows - 1000, &x[1000 * nvar]);
+
+   ExpectSameMoments(byRow, blocked, nvar);
+   for (int i : {0, 999, 1000, nrows - 1})
+      EXPECT_EQ(blocked.GetRow(i)[nvar - 1], x[i * nvar + nvar - 1]);
+}
+
+TEST(TPrincipal, Merge)
+{
+   const int nvar = 3, nrows = 20000;
+   const auto x = MakeRows(nrows, nvar);
+
+   TPrincipal all(nvar, "ND");
+   all.AddRows(nrows, x.data());
+   TPrincipal first(nvar, "ND"), second(nvar, "ND"), third(nvar, "ND");
+   for (int i = 0; i < nrows; i++)
+      (i < 7000 ? first : second).Fill(x[i * nvar], x[i * nvar + 1], x[i * nvar + 2]);
+
+   TList list;
+   list.Add(&second);
+   list.Add(&third);
+   EXPECT_EQ(first.Merge(&list), nrows);
+   ExpectSameMoments(all, first, nvar);
+   EXPECT_EQ(first.GetRow(nrows - 1)[0], x[(nrows - 1) * nvar]);
+
+   all.MakePrincipals();
+   first.MakePrincipals();
+   for (int i = 0; i < nvar; i++)
+      EXPECT_NEAR((*all.GetEigenValues())(i), (*first.GetEigenValues())(i), 1e-9);
+}
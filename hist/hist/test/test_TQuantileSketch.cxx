@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+
+#include "TQuantileSketch.h"
+#include "TList.h"
+#include "TRandom3.h"
+
+#include <algorithm>
+#include <vector>
+
+// Exact quantile of the sorted values, as the sketch interpolates them
+static double ExactQuantile(const std::vector<double> &sorted, double prob)
+{
+   return sorted[std::min<std::size_t>(sorted.size() - 1, prob * sorted.size())];
+}
+
+TEST(TQuantileSketch, Quantiles)
+{
+   TQuantileSketch sketch("q", "q", 200);
+   TRandom3 r(1);
+   std::vector<double> values(200000);
+   for (auto &x : values) {
+      x = r.Exp(2.);
+      sketch.Fill(x);
+   }
+   std::sort(values.begin(), values.end());
+
+   EXPECT_EQ(sketch.GetEntries(), (Long64_t)values.size());
+   EXPECT_LT(sketch.GetNCentroids(), 500);
+   EXPECT_EQ(sketch.GetQuantile(0.), values.front());
+   EXPECT_EQ(sketch.GetQuantile(1.), values.back());
+   for (double prob : {1.E-4, 1.E-3, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 0.9999}) {
+      const double q = sketch.GetQuantile(prob);
+      // the error on the probability is small, and smallest in the tails
+      const double probOfQ = std::lower_bound(values.begin(), values.end(), q) - values.begin();
+      EXPECT_NEAR(probOfQ / values.size(), prob, 0.01 * std::min(1., 10 * std::min(prob, 1 - prob)) + 1.E-5)
+         << "prob " << prob;
+      EXPECT_NEAR(sketch.GetCDF(q), prob, 1.E-6);
+      EXPECT_NEAR(q, ExactQuantile(values, prob), 0.05 * (1 + ExactQuantile(values, prob)));
+   }
+}
+
+TEST(TQuantileSketch, Merge)
+{
+   TRandom3 r(2);
+   TQuantileSketch all("all", "all");
+   std::vector<TQuantileSketch> parts(4, TQuantileSketch("part", "part"));
+   for (int i = 0; i < 100000; ++i) {
+      const double x = r.Gaus();
+      const double w = r.Uniform(0.5, 1.5);
+      all.Fill(x, w);
+      parts[i % 4].Fill(x, w);
+   }
+   TList list;
+   for (int i = 1; i < 4; ++i)
+      list.Add(&parts[i]);
+   EXPECT_EQ(parts[0].Merge(&list), all.GetEntries());
+   EXPECT_NEAR(parts[0].GetSumOfWeights(), all.GetSumOfWeights(), 1.E-6 * all.GetSumOfWeights());
+   EXPECT_EQ(parts[0].GetMinimum(), all.GetMinimum());
+   EXPECT_EQ(parts[0].GetMaximum(), all.GetMaximum());
+   double q[5], qAll[5];
+   const double probs[5] = {0.001, 0.1, 0.5, 0.9, 0.999};
+   parts[0].GetQuantiles(5, q, probs);
+   all.GetQuantiles(5, qAll, probs);
+   for (int i = 0; i < 5; ++i)
+      EXPECT_NEAR(q[i], qAll[i], 0.02) << "prob " << probs[i];
+   list.Clear();
+}
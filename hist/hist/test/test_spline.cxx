@@ -4,8 +4,10 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <fstream>
 #include <string>
+#include <vector>
 
 class FileDeleterRAII {
    const std::string fFileName;
@@ -49,4 +51,33 @@ TEST(TSpline, Precision)
          << "Spline value (" << splineVal << ") and expected value (" << expectedVal << ") differ more than allowed ("
          << tolerance << ")" << std::endl;
    }
-}
\ No newline at end of file
+}
+
+TEST(TSpline, BatchEval)
+{
+   const int n = 20;
+   Double_t x[n], y[n];
+   for (int i = 0; i < n; ++i) {
+      x[i] = i * i * 0.05; // not equidistant
+      y[i] = std::sin(x[i]);
+   }
+   TSpline3 s3("s3", x, y, n);
+   TSpline5 s5("s5", x, y, n);
+
+   // increasing, then decreasing, then scattered points, including some outside of the knots
+   std::vector<Double_t> xs;
+   for (int i = 0; i < 200; ++i)
+      xs.push_back(-1. + i * 0.1);
+   for (int i = 0; i < 200; ++i)
+      xs.push_back(19. - i * 0.1);
+   for (int i = 0; i < 200; ++i)
+      xs.push_back(-1. + (i * 67 % 200) * 0.1);
+
+   std::vector<Double_t> y3(xs.size()), y5(xs.size());
+   s3.Eval(xs.size(), xs.data(), y3.data());
+   s5.Eval(xs.size(), xs.data(), y5.data());
+   for (std::size_t i = 0; i < xs.size(); ++i) {
+      EXPECT_DOUBLE_EQ(y3[i], s3.Eval(xs[i])) << "x = " << xs[i];
+      EXPECT_DOUBLE_EQ(y5[i], s5.Eval(xs[i])) << "x = " << xs[i];
+   }
+}
@@ -6,6 +6,8 @@
 #include "gtest/gtest.h"
 
 #include <iostream>
+#include <thread>
+#include <vector>
 
 class MyClass {
 public:
@@ -274,3 +276,39 @@ TEST(TF1, Save)
    args[0] = 11;
    EXPECT_EQ(0., linear.GetSave(args));
 }
+
+// Test that EvalParConst can be used concurrently on the same function
+TEST(TF1, EvalParConstThreads)
+{
+   TF1 f1("fconst", "[0]*exp(-x/[1])", 0, 10);
+   TF1 f2("fconstfunc", func, 0, 10, 1);
+   f1.SetParameters(2, 3);
+   f2.SetParameter(0, 1);
+
+   const int nthreads = 4;
+   const int npoints = 1000;
+   std::vector<double> results(nthreads * npoints);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nthreads; ++t) {
+      threads.emplace_back([&, t]() {
+         const double p[] = {double(t + 1), 2.};
+         for (int i = 0; i < npoints; ++i) {
+            const double x = 0.01 * i;
+            results[t * npoints + i] = f1.EvalParConst(&x, p) + f2.EvalParConst(&x, p);
+         }
+      });
+   }
+   for (auto &th : threads)
+      th.join();
+
+   for (int t = 0; t < nthreads; ++t) {
+      const double p[] = {double(t + 1), 2.};
+      for (int i = 0; i < npoints; ++i) {
+         double x = 0.01 * i;
+         EXPECT_DOUBLE_EQ(results[t * npoints + i], f1.EvalPar(&x, p) + f2.EvalPar(&x, p));
+      }
+   }
+   // the current parameters are used without explicit parameters
+   double x = 1.;
+   EXPECT_DOUBLE_EQ(f1.EvalParConst(&x), f1.Eval(x));
+}
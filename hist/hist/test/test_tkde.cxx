@@ -10,6 +10,8 @@
 #include "TH1.h"
 #include "Math/DistFuncMathCore.h"
 
+#include <algorithm>
+
 
 struct TestKDE {
 
@@ -496,4 +498,30 @@ TEST(TKDE, tkde_io_mirror)
    for (size_t i = 0; i < t.xtest.size(); ++i) {
       EXPECT_NEAR(t.values1[i], t.values2[i], delta);
    }
-}
\ No newline at end of file
+}
+// The fast evaluation interpolates a grid refined until it agrees with the exact density
+TEST(TKDE, tkde_fast_evaluation)
+{
+   TRandom3 r(2222);
+   std::vector<double> data(5000);
+   for (auto &x : data)
+      x = (r.Rndm() < 0.2) ? r.Gaus(10, 1) : r.Gaus(10, 7);
+   TKDE kde(data.size(), data.data(), -10., 30., "KernelType:Gaussian;Iteration:Adaptive;Mirror:noMirror", 1);
+
+   const int n = 1000;
+   std::vector<double> x(n), exact(n), fast(n);
+   for (int i = 0; i < n; ++i)
+      x[i] = -12. + 44. * i / (n - 1);
+   kde.Evaluate(n, x.data(), exact.data());
+   const double maxValue = *std::max_element(exact.begin(), exact.end());
+
+   const double tolerance = 1.E-4;
+   kde.SetFastEvaluation(tolerance);
+   kde.Evaluate(n, x.data(), fast.data());
+   for (int i = 0; i < n; ++i) {
+      EXPECT_NEAR(exact[i], fast[i], 4 * tolerance * maxValue) << "x = " << x[i];
+      EXPECT_EQ(kde(x[i]), fast[i]);
+   }
+   // outside the range the density is computed exactly
+   EXPECT_EQ(exact[0], fast[0]);
+}
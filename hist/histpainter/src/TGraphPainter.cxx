@@ -39,7 +39,16 @@
 #include "TRegexp.h"
 #include "strlcpy.h"
 #include "snprintf.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include <atomic>
+#endif
 
 Int_t TGraphPainter::fgMaxPointsPerLine = 50;
 
@@ -49,6 +58,204 @@ static std::unique_ptr<TMarker> gHighlightMarker;    // highlight marker
 
 ClassImp(TGraphPainter);
 
+namespace {
+
+/// Number of points above which the decimation runs in parallel with implicit multi-threading
+constexpr Long64_t kParallelDecimationPoints = 4000000;
+
+/// Run `func(first, last, chunk)` on `nchunks` consecutive chunks of [0, n), in parallel with implicit
+/// multi-threading for large inputs. Returns the number of chunks.
+template <typename F>
+Int_t ForEachChunk(Long64_t n, F &&func)
+{
+   Int_t nchunks = 1;
+#ifdef R__USE_IMT
+   if (n >= kParallelDecimationPoints && ROOT::IsImplicitMTEnabled()) {
+      nchunks = std::min<Long64_t>(4 * ROOT::GetThreadPoolSize(), n / (kParallelDecimationPoints / 16));
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t chunk) { func(n * chunk / nchunks, n * (chunk + 1) / nchunks, chunk); },
+                   ROOT::TSeqI(nchunks));
+      return nchunks;
+   }
+#endif
+   func(0, n, 0);
+   return nchunks;
+}
+
+/// Map a coordinate to a pixel of [0, npix), -1 below the range, npix above it and for the points which cannot be
+/// drawn on a log scale
+inline Int_t ToPixel(Double_t v, Bool_t logv, Double_t vmin, Double_t scale, Int_t npix)
+{
+   if (logv) {
+      if (v <= 0)
+         return -1;
+      v = std::log10(v);
+   }
+   const Double_t p = (v - vmin) * scale;
+   if (!(p >= 0))
+      return -1;
+   return p >= npix ? npix : (Int_t)p;
+}
+
+/// First, last, lowest and highest points of a pixel column, as indices in the arrays of the graph
+struct PixelColumn {
+   Long64_t fFirst = -1;
+   Long64_t fLast = -1;
+   Long64_t fMin = -1;
+   Long64_t fMax = -1;
+
+   void Add(Long64_t i, const Double_t *y)
+   {
+      if (fFirst < 0) {
+         fFirst = fMin = fMax = i;
+      } else {
+         if (y[i] < y[fMin]) fMin = i;
+         if (y[i] > y[fMax]) fMax = i;
+      }
+      fLast = i;
+   }
+
+   /// Merge the column as seen by the next chunk of points
+   void Merge(const PixelColumn &next, const Double_t *y)
+   {
+      if (next.fFirst < 0) return;
+      if (fFirst < 0) {
+         *this = next;
+         return;
+      }
+      if (y[next.fMin] < y[fMin]) fMin = next.fMin;
+      if (y[next.fMax] > y[fMax]) fMax = next.fMax;
+      fLast = next.fLast;
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reduce a polyline whose x coordinates are sorted to the first, last, lowest
+/// and highest points of each pixel column of the pad, which is how it is
+/// rendered anyway. Of the points out of the x range of the pad, only the ones
+/// next to it are kept, for the segments crossing the pad borders.
+/// Returns false, without reducing anything, if x is not sorted.
+
+Bool_t DecimatePolyLine(Long64_t n, const Double_t *x, const Double_t *y, std::vector<Double_t> &xr,
+                        std::vector<Double_t> &yr)
+{
+   const Int_t npx = std::max(1, (Int_t)(gPad->GetWw() * gPad->GetAbsWNDC()));
+   const Bool_t logx = gPad->GetLogx();
+   const Double_t xmin = gPad->GetX1();
+   const Double_t scale = npx / (gPad->GetX2() - xmin);
+
+   // Column 0 gathers the points before the pad and column npx + 1 the points after it
+   std::vector<std::vector<PixelColumn>> columns(1);
+   std::vector<char> sorted(1, 1);
+   auto fill = [&](Long64_t first, Long64_t last, Int_t chunk) {
+      auto &cols = columns[chunk];
+      cols.assign(npx + 2, PixelColumn());
+      for (Long64_t i = first; i < last; ++i) {
+         if (i > 0 && x[i] < x[i - 1]) {
+            sorted[chunk] = 0;
+            return;
+         }
+         cols[ToPixel(x[i], logx, xmin, scale, npx) + 1].Add(i, y);
+      }
+   };
+#ifdef R__USE_IMT
+   if (n >= kParallelDecimationPoints && ROOT::IsImplicitMTEnabled()) {
+      columns.resize(4 * ROOT::GetThreadPoolSize());
+      sorted.assign(columns.size(), 1);
+   }
+#endif
+   const Int_t nchunks = ForEachChunk(n, fill);
+   for (Int_t chunk = 0; chunk < nchunks; ++chunk) {
+      if (!sorted[chunk]) return kFALSE;
+      if (chunk > 0) {
+         for (Int_t c = 0; c < npx + 2; ++c)
+            columns[0][c].Merge(columns[chunk][c], y);
+      }
+   }
+
+   xr.clear();
+   yr.clear();
+   auto keep = [&](Long64_t i) {
+      xr.push_back(x[i]);
+      yr.push_back(y[i]);
+   };
+   const auto &cols = columns[0];
+   if (cols[0].fLast >= 0) keep(cols[0].fLast);
+   for (Int_t c = 1; c <= npx; ++c) {
+      const auto &col = cols[c];
+      if (col.fFirst < 0) continue;
+      Long64_t idx[4] = {col.fFirst, std::min(col.fMin, col.fMax), std::max(col.fMin, col.fMax), col.fLast};
+      for (Int_t k = 0; k < 4; ++k) {
+         if (k == 0 || idx[k] != idx[k - 1]) keep(idx[k]);
+      }
+   }
+   if (cols[npx + 1].fFirst >= 0) keep(cols[npx + 1].fFirst);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep one point per pixel of the pad for markers; the points out of the pad
+/// are not drawn and dropped.
+
+void DecimatePolyMarker(Long64_t n, const Double_t *x, const Double_t *y, std::vector<Double_t> &xr,
+                        std::vector<Double_t> &yr)
+{
+   const Int_t npx = std::max(1, (Int_t)(gPad->GetWw() * gPad->GetAbsWNDC()));
+   const Int_t npy = std::max(1, (Int_t)(gPad->GetWh() * gPad->GetAbsHNDC()));
+   const Bool_t logx = gPad->GetLogx();
+   const Bool_t logy = gPad->GetLogy();
+   const Double_t xmin = gPad->GetX1();
+   const Double_t ymin = gPad->GetY1();
+   const Double_t xscale = npx / (gPad->GetX2() - xmin);
+   const Double_t yscale = npy / (gPad->GetY2() - ymin);
+
+   // One bit per pixel, set by the first point falling on it
+   const std::size_t nwords = ((std::size_t)npx * npy + 63) / 64;
+   std::vector<std::vector<Long64_t>> kept(1);
+#ifdef R__USE_IMT
+   const Bool_t parallel = n >= kParallelDecimationPoints && ROOT::IsImplicitMTEnabled();
+   std::vector<std::atomic<ULong64_t>> pixels(parallel ? nwords : 0);
+   for (auto &w : pixels) w = 0;
+   if (parallel) kept.resize(4 * ROOT::GetThreadPoolSize());
+#else
+   const Bool_t parallel = kFALSE;
+#endif
+   std::vector<ULong64_t> serialPixels(parallel ? 0 : nwords, 0);
+
+   auto fill = [&](Long64_t first, Long64_t last, Int_t chunk) {
+      for (Long64_t i = first; i < last; ++i) {
+         const Int_t px = ToPixel(x[i], logx, xmin, xscale, npx);
+         const Int_t py = ToPixel(y[i], logy, ymin, yscale, npy);
+         if (px < 0 || px >= npx || py < 0 || py >= npy) continue;
+         const std::size_t bit = (std::size_t)py * npx + px;
+         const ULong64_t mask = 1ull << (bit % 64);
+         Bool_t isNew;
+#ifdef R__USE_IMT
+         if (parallel)
+            isNew = !(pixels[bit / 64].fetch_or(mask, std::memory_order_relaxed) & mask);
+         else
+#endif
+         {
+            isNew = !(serialPixels[bit / 64] & mask);
+            serialPixels[bit / 64] |= mask;
+         }
+         if (isNew) kept[chunk].push_back(i);
+      }
+   };
+   const Int_t nchunks = ForEachChunk(n, fill);
+
+   xr.clear();
+   yr.clear();
+   for (Int_t chunk = 0; chunk < nchunks; ++chunk) {
+      for (auto i : kept[chunk]) {
+         xr.push_back(x[i]);
+         yr.push_back(y[i]);
+      }
+   }
+}
+
+} // anonymous namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -1443,6 +1650,23 @@ void TGraphPainter::PaintGraph(TGraph *theGraph, Int_t npoints, const Double_t *
    theGraph->TAttFill::Modify();
    theGraph->TAttMarker::Modify();
 
+   // Large graphs drawn with a line or with markers only are reduced to the
+   // points which make a difference on the pixels of the pad.
+   std::vector<Double_t> xdecimated, ydecimated;
+   Int_t threshold = TVirtualGraphPainter::GetDecimationThreshold();
+   if (threshold > 0 && npoints > threshold && !optionR && !optionCurve && !optionFill && !optionBar && !optionE &&
+       (optionLine != (optionMark || optionStar)) && TMath::Abs(theGraph->GetLineWidth()) <= 99 &&
+       !theGraph->InheritsFrom(TGraphPolar::Class()) && gPad->GetX2() > gPad->GetX1() && gPad->GetY2() > gPad->GetY1()) {
+      Bool_t decimated = kTRUE;
+      if (optionLine) decimated = DecimatePolyLine(npoints, x, y, xdecimated, ydecimated);
+      else            DecimatePolyMarker(npoints, x, y, xdecimated, ydecimated);
+      if (decimated && !xdecimated.empty()) {
+         npoints = (Int_t)xdecimated.size();
+         x = xdecimated.data();
+         y = ydecimated.data();
+      }
+   }
+
    // Draw the graph with a polyline or a fill area
    gxwork.resize(2*npoints+10);
    gywork.resize(2*npoints+10);
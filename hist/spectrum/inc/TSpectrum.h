@@ -54,6 +54,7 @@ public:
    ~TSpectrum() override;
    virtual TH1        *Background(const TH1 *hist,Int_t niter=20, Option_t *option="");
    TH1                *GetHistogram() const {return fHistogram;}
+   Int_t               GetMaxPeaks() const {return fMaxPeaks;}
    Int_t               GetNPeaks() const {return fNPeaks;}
    Double_t            *GetPositionX() const {return fPositionX;}
    Double_t            *GetPositionY() const {return fPositionY;}
@@ -70,6 +71,8 @@ public:
    const char         *DeconvolutionRL(Double_t *source, const Double_t *response,Int_t ssize, Int_t numberIterations,Int_t numberRepetitions, Double_t boost );
    const char         *Unfolding(Double_t *source,const Double_t **respMatrix,Int_t ssizex, Int_t ssizey,Int_t numberIterations,Int_t numberRepetitions, Double_t boost);
    Int_t               SearchHighRes(Double_t *source,Double_t *destVector, Int_t ssize,Double_t sigma, Double_t threshold,bool backgroundRemove,Int_t deconIterations,bool markov, Int_t averWindow);
+   const char         *Background(Int_t nspectra, Double_t **spectra, Int_t ssize, Int_t numberIterations, Int_t direction, Int_t filterOrder, bool smoothing, Int_t smoothWindow, bool compton);
+   Int_t               SearchHighRes(Int_t nspectra, Double_t **source, Double_t **destVector, Int_t ssize, Double_t sigma, Double_t threshold, bool backgroundRemove, Int_t deconIterations, bool markov, Int_t averWindow, Int_t *npeaks, Double_t *positions);
    Int_t               Search1HighRes(Double_t *source,Double_t *destVector, Int_t ssize,Double_t sigma, Double_t threshold,bool backgroundRemove,Int_t deconIterations,bool markov, Int_t averWindow);
 
    static Int_t        StaticSearch(const TH1 *hist, Double_t sigma=2, Option_t *option="goff", Double_t threshold=0.05);
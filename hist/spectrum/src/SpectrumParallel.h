@@ -0,0 +1,55 @@
+// @(#)root/spectrum:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_SpectrumParallel
+#define ROOT_SpectrumParallel
+
+#include "RConfigure.h"
+#include "Rtypes.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace ROOT {
+namespace Internal {
+namespace Spectrum {
+
+/// Minimal number of multiply-adds of a loop for it to be run in parallel
+constexpr Long64_t kParallelWork = 1 << 20;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(i) for i in [0, n). The calls must be independent of each other;
+/// they are run in parallel when implicit multithreading is enabled and the
+/// loop performs at least kParallelWork operations in total.
+
+template <class F>
+void Foreach(Int_t n, Long64_t work, F &&func)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && n > 1 && work >= kParallelWork) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(func, ROOT::TSeqI(n));
+      return;
+   }
+#else
+   (void)work;
+#endif
+   for (Int_t i = 0; i < n; i++)
+      func(i);
+}
+
+} // namespace Spectrum
+} // namespace Internal
+} // namespace ROOT
+
+#endif
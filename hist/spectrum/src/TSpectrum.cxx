@@ -8,6 +8,10 @@
 #include "TH1.h"
 #include "TMath.h"
 #include "snprintf.h"
+#include "SpectrumParallel.h"
+
+#include <algorithm>
+#include <vector>
 
 /** \class TSpectrum
     \ingroup Spectrum
@@ -2564,6 +2568,81 @@ Int_t TSpectrum::Search1HighRes(Double_t *source,Double_t *destVector, int ssize
                         deconIterations,markov,averWindow);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Estimate the background of nspectra one-dimensional spectra of the same
+/// size, see Background(Double_t *, Int_t, Int_t, Int_t, Int_t, bool, Int_t, bool).
+///
+/// The spectra are processed in parallel when implicit multithreading is
+/// enabled. Returns nullptr if all the background estimations succeeded,
+/// otherwise the error message of the first spectrum that failed.
+
+const char *TSpectrum::Background(Int_t nspectra, Double_t **spectra, Int_t ssize,
+                                  Int_t numberIterations,
+                                  Int_t direction, Int_t filterOrder,
+                                  bool smoothing, Int_t smoothWindow,
+                                  bool compton)
+{
+   if (nspectra <= 0 || !spectra)
+      return "Wrong Parameters";
+   std::vector<const char *> errors(nspectra, nullptr);
+   ROOT::Internal::Spectrum::Foreach(nspectra, (Long64_t)nspectra * ssize * numberIterations, [&](Int_t i) {
+      errors[i] = Background(spectra[i], ssize, numberIterations, direction, filterOrder, smoothing,
+                             smoothWindow, compton);
+   });
+   for (const char *error : errors) {
+      if (error)
+         return error;
+   }
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Search the peaks of nspectra one-dimensional spectra of the same size,
+/// see SearchHighRes(Double_t *, Double_t *, Int_t, Double_t, Double_t, bool, Int_t, bool, Int_t).
+///
+/// The spectra are processed in parallel when implicit multithreading is
+/// enabled, the results do not depend on the number of threads.
+///
+/// #### Parameters:
+///
+///  - nspectra: number of spectra
+///  - source: the nspectra source spectra
+///  - destVector: the nspectra resulting deconvolved spectra, may be the
+///    same as source
+///  - npeaks: array of size nspectra, filled with the number of peaks found in
+///    each spectrum
+///  - positions: array of size nspectra * GetMaxPeaks(); the positions of the
+///    peaks of spectrum i are stored from positions[i * GetMaxPeaks()]
+///
+/// The other parameters are the ones of the single spectrum search.
+/// Returns the total number of peaks found. GetNPeaks() and GetPositionX()
+/// are not modified.
+
+Int_t TSpectrum::SearchHighRes(Int_t nspectra, Double_t **source, Double_t **destVector, Int_t ssize,
+                               Double_t sigma, Double_t threshold,
+                               bool backgroundRemove, Int_t deconIterations,
+                               bool markov, Int_t averWindow,
+                               Int_t *npeaks, Double_t *positions)
+{
+   if (nspectra <= 0 || !source || !destVector || !npeaks || !positions) {
+      Error("SearchHighRes", "Invalid parameters");
+      return 0;
+   }
+   const Int_t maxPeaks = fMaxPeaks;
+   const Long64_t work = (Long64_t)nspectra * ssize * (deconIterations + 1) * (Int_t)(7 * sigma + 0.5);
+   ROOT::Internal::Spectrum::Foreach(nspectra, work, [&](Int_t i) {
+      // each search needs its own peak buffers
+      TSpectrum s(maxPeaks);
+      npeaks[i] = s.SearchHighRes(source[i], destVector[i], ssize, sigma, threshold, backgroundRemove,
+                                  deconIterations, markov, averWindow);
+      std::copy(s.GetPositionX(), s.GetPositionX() + npeaks[i], positions + (Long64_t)i * maxPeaks);
+   });
+   Int_t total = 0;
+   for (Int_t i = 0; i < nspectra; i++)
+      total += npeaks[i];
+   return total;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static function, interface to TSpectrum::Search.
 
@@ -46,6 +46,7 @@
 #include "TList.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "SpectrumParallel.h"
 #define PEAK_WINDOW 1024
 
 Int_t TSpectrum2::fgIterations    = 3;
@@ -945,7 +946,10 @@ const char *TSpectrum2::Deconvolution(Double_t **source, Double_t **resp,
          }
       }
       for (lindex = 0; lindex < numberIterations; lindex++) {
-         for (i2 = 0; i2 < ssizey; i2++) {
+         // the rows of the new estimate only depend on the previous one
+         ROOT::Internal::Spectrum::Foreach(ssizey, (Long64_t)ssizex * ssizey * lhx * lhy, [&](Int_t i2) {
+            Int_t i1, j1, j2, j1min, j1max, j2min, j2max;
+            Double_t lda, ldb, ldc;
             for (i1 = 0; i1 < ssizex; i1++) {
                ldb = 0;
                j2min = i2;
@@ -979,7 +983,7 @@ const char *TSpectrum2::Deconvolution(Double_t **source, Double_t **resp,
                   lda = 0;
                working_space[i1][i2 + 4 * ssizey] = lda;
             }
-         }
+         });
          for (i2 = 0; i2 < ssizey; i2++) {
             for (i1 = 0; i1 < ssizex; i1++)
                working_space[i1][i2 + 3 * ssizey] =
@@ -1566,7 +1570,10 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
    }
    //START OF ITERATIONS
    for(lindex = 0; lindex < deconIterations; lindex++){
-      for(i2 = 0; i2 < ssizey_ext; i2++){
+      // the rows of the new estimate only depend on the previous one
+      ROOT::Internal::Spectrum::Foreach(ssizey_ext, (Long64_t)ssizex_ext * ssizey_ext * lhx * lhy, [&](Int_t i2) {
+         Int_t i1, j1, j2, j1min, j1max, j2min, j2max, k;
+         Double_t lda, ldb, ldc;
          for(i1 = 0; i1 < ssizex_ext; i1++){
             lda = working_space[i1][i2 + ssizey_ext];
             ldc = working_space[i1][i2 + 14 * ssizey_ext];
@@ -1609,7 +1616,7 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
                working_space[i1][i2 + 2 * ssizey_ext] = lda;
             }
          }
-      }
+      });
       for(i2 = 0; i2 < ssizey_ext; i2++){
          for(i1 = 0; i1 < ssizex_ext; i1++)
             working_space[i1][i2 + ssizey_ext] = working_space[i1][i2 + 2 * ssizey_ext];
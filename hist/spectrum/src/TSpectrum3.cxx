@@ -50,6 +50,7 @@
 #include "TSpectrum3.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "SpectrumParallel.h"
 #define PEAK_WINDOW 1024
 
 ClassImp(TSpectrum3);
@@ -1736,7 +1737,10 @@ const char *TSpectrum3::Deconvolution(Double_t***source, const Double_t***resp,
          }
       }
       for (lindex = 0; lindex < numberIterations; lindex++) {
-         for (i3 = 0; i3 < ssizez; i3++) {
+         // the planes of the new estimate only depend on the previous one
+         ROOT::Internal::Spectrum::Foreach(ssizez, (Long64_t)ssizex * ssizey * ssizez * lhx * lhy * lhz, [&](Int_t i3) {
+            Int_t i1, i2, j1, j2, j3, j1min, j1max, j2min, j2max, j3min, j3max;
+            Double_t lda, ldb, ldc;
             for (i2 = 0; i2 < ssizey; i2++) {
                for (i1 = 0; i1 < ssizex; i1++) {
                   ldb = 0;
@@ -1781,7 +1785,7 @@ const char *TSpectrum3::Deconvolution(Double_t***source, const Double_t***resp,
                   working_space[i1][i2][i3 + 4 * ssizez] = lda;
                }
             }
-         }
+         });
          for (i3 = 0; i3 < ssizez; i3++) {
             for (i2 = 0; i2 < ssizey; i2++) {
                for (i1 = 0; i1 < ssizex; i1++)
@@ -3028,7 +3032,10 @@ Int_t TSpectrum3::SearchHighRes(const Double_t***source,Double_t***dest, Int_t s
 
 //START OF ITERATIONS
    for (lindex=0;lindex<deconIterations;lindex++){
-      for (i3 = 0; i3 < sizez_ext; i3++) {
+      // the planes of the new estimate only depend on the previous one
+      ROOT::Internal::Spectrum::Foreach(sizez_ext, (Long64_t)sizex_ext * sizey_ext * sizez_ext * lhx * lhy * lhz, [&](Int_t i3) {
+         Int_t i1, i2, j1, j2, j3, j1min, j1max, j2min, j2max, j3min, j3max;
+         Double_t lda, ldb, ldc;
          for (i2 = 0; i2 < sizey_ext; i2++) {
             for (i1 = 0; i1 < sizex_ext; i1++) {
                if (TMath::Abs(working_space[i1][i2][i3 + 3 * sizez_ext])>1e-6 && TMath::Abs(working_space[i1][i2][i3 + 1 * sizez_ext])>1e-6){
@@ -3081,7 +3088,7 @@ Int_t TSpectrum3::SearchHighRes(const Double_t***source,Double_t***dest, Int_t s
                }
             }
          }
-      }
+      });
       for (i3 = 0; i3 < sizez_ext; i3++) {
          for (i2 = 0; i2 < sizey_ext; i2++) {
             for (i1 = 0; i1 < sizex_ext; i1++)
@@ -210,6 +210,13 @@ class TUnfold : public TObject {
    TMatrixDSparse *fEinv;
    /// matrix E
    TMatrixDSparse *fE;
+   /// cached product A<sup>T</sup>Vyy<sup>-1</sup>, independent of tau
+   TMatrixDSparse *fAtVyyInv; //!
+   /// cached product A<sup>T</sup>Vyy<sup>-1</sup>A, independent of tau
+   TMatrixDSparse *fAtVyyInvA; //!
+   /// cached product L<sup>T</sup>L, independent of tau
+   TMatrixDSparse *fLSquared; //!
+   void ClearCachedProducts(void); // delete the cached tau-independent products
  protected:
    // Int_t IsNotSymmetric(TMatrixDSparse const &m) const;
    virtual Double_t DoUnfold(void);     // the unfolding algorithm
@@ -114,7 +114,15 @@ constraint, both x and &lambda; are determined.
 #include <TMatrixDSymEigen.h>
 #include <TMath.h>
 #include "TUnfold.h"
+#include "RConfigure.h"
+#include "TROOT.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -124,6 +132,81 @@ constraint, both x and &lambda; are determined.
 
 ClassImp(TUnfold)
 
+namespace {
+
+/// minimal number of operations of a matrix product for it to be
+/// computed in parallel
+constexpr Long64_t kParallelWork = 1 << 18;
+/// number of rows of a matrix product computed by one task
+constexpr Int_t kRowBlock = 64;
+
+/// non-zero elements of a block of rows of a sparse matrix
+struct SparseRows_t {
+   std::vector<Int_t> fRows;
+   std::vector<Int_t> fCols;
+   std::vector<Double_t> fData;
+   void Add(Int_t row,Int_t col,Double_t data) {
+      fRows.push_back(row);
+      fCols.push_back(col);
+      fData.push_back(data);
+   }
+};
+
+////////////////////////////////////////////////////////////////////////
+/// create a sparse matrix from its rows, computed by blocks
+///
+/// \param[in] nrow number of rows
+/// \param[in] ncol number of columns
+/// \param[in] work estimated number of operations
+/// \param[in] fillRows fillRows(first,last,rows) stores the non-zero
+/// elements of the rows [first,last) in rows, ordered by row and column
+///
+/// the blocks are computed in parallel if implicit multithreading is
+/// enabled and work is large enough. The result does not depend on the
+/// number of threads.
+template<class F>
+TMatrixDSparse *CreateSparseMatrixByRows(Int_t nrow,Int_t ncol,Long64_t work,F &&fillRows)
+{
+   Int_t nblock=(nrow+kRowBlock-1)/kRowBlock;
+   std::vector<SparseRows_t> blocks(nblock);
+   auto task=[&](Int_t iblock) {
+      fillRows(iblock*kRowBlock,std::min(nrow,(iblock+1)*kRowBlock),
+               blocks[iblock]);
+   };
+#ifdef R__USE_IMT
+   if(ROOT::IsImplicitMTEnabled() && (nblock>1) && (work>=kParallelWork)) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(task,ROOT::TSeqI(nblock));
+   } else
+#endif
+   {
+      for(Int_t iblock=0;iblock<nblock;iblock++) task(iblock);
+   }
+   TMatrixDSparse *r=new TMatrixDSparse(nrow,ncol);
+   SparseRows_t all;
+   if(nblock==1) {
+      all=std::move(blocks[0]);
+   } else {
+      size_t n=0;
+      for(const SparseRows_t &block : blocks) n += block.fData.size();
+      all.fRows.reserve(n);
+      all.fCols.reserve(n);
+      all.fData.reserve(n);
+      for(const SparseRows_t &block : blocks) {
+         all.fRows.insert(all.fRows.end(),block.fRows.begin(),block.fRows.end());
+         all.fCols.insert(all.fCols.end(),block.fCols.begin(),block.fCols.end());
+         all.fData.insert(all.fData.end(),block.fData.begin(),block.fData.end());
+      }
+   }
+   if(!all.fData.empty()) {
+      r->SetMatrixArray(all.fData.size(),all.fRows.data(),all.fCols.data(),
+                        all.fData.data());
+   }
+   return r;
+}
+
+} // namespace
+
 TUnfold::~TUnfold(void)
 {
    // delete all data members
@@ -134,6 +217,7 @@ TUnfold::~TUnfold(void)
    DeleteMatrix(&fY);
    DeleteMatrix(&fX0);
    DeleteMatrix(&fVyyInv);
+   ClearCachedProducts();
 
    ClearResults();
 }
@@ -159,6 +243,9 @@ void TUnfold::InitTUnfold(void)
    // output
    fX = nullptr;
    fVyyInv = nullptr;
+   fAtVyyInv = nullptr;
+   fAtVyyInvA = nullptr;
+   fLSquared = nullptr;
    fVxx = nullptr;
    fVxxInv = nullptr;
    fAx = nullptr;
@@ -232,6 +319,18 @@ void TUnfold::ClearResults(void)
    fRhoAvg = -1.0;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// delete the matrix products which do not depend on tau
+///
+/// they are kept by DoUnfold() for the next values of tau, e.g. in the
+/// scans of the L-curve, until the input or the regularisation changes
+void TUnfold::ClearCachedProducts(void)
+{
+   DeleteMatrix(&fAtVyyInv);
+   DeleteMatrix(&fAtVyyInvA);
+   DeleteMatrix(&fLSquared);
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// only for use by root streamer or derived classes
 ///
@@ -287,18 +386,30 @@ Double_t TUnfold::DoUnfold(void)
       }
    }
    //
-   // get matrix
+   // get matrices, which do not depend on tau and are kept for the
+   // next calls
    //              T
    //            fA fV  = mAt_V
+   //              T
+   //            fA fV fA
+   //              T
+   //            fL fL  = Lsquared
    //
-   TMatrixDSparse *AtVyyinv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+   if(!fAtVyyInv) {
+      fAtVyyInv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+      fAtVyyInvA=MultiplyMSparseMSparse(fAtVyyInv,fA);
+   }
+   if(!fLSquared) {
+      fLSquared=MultiplyMSparseTranspMSparse(fL,fL);
+   }
+   const TMatrixDSparse *AtVyyinv=fAtVyyInv;
+   const TMatrixDSparse *lSquared=fLSquared;
    //
    // get
    //       T
    //     fA fVyyinv fY + fTauSquared fBiasScale Lsquared fX0 = rhs
    //
    TMatrixDSparse *rhs=MultiplyMSparseM(AtVyyinv,fY);
-   TMatrixDSparse *lSquared=MultiplyMSparseTranspMSparse(fL,fL);
    if (fBiasScale != 0.0) {
      TMatrixDSparse *rhs2=MultiplyMSparseM(lSquared,fX0);
       AddMSparse(rhs, fTauSquared * fBiasScale ,rhs2);
@@ -309,7 +420,7 @@ Double_t TUnfold::DoUnfold(void)
    // get matrix
    //              T
    //           (fA fV)fA + fTauSquared*fLsquared  = fEinv
-   fEinv=MultiplyMSparseMSparse(AtVyyinv,fA);
+   fEinv=new TMatrixDSparse(*fAtVyyInvA);
    AddMSparse(fEinv,fTauSquared,lSquared);
 
    //
@@ -415,7 +526,6 @@ Double_t TUnfold::DoUnfold(void)
       DeleteMatrix(&corr);
    }
 
-   DeleteMatrix(&AtVyyinv);
 
    //
    // get error matrix on x
@@ -479,7 +589,6 @@ Double_t TUnfold::DoUnfold(void)
    DeleteMatrix(&epsilon);
 
    DeleteMatrix(&LsquaredDx);
-   DeleteMatrix(&lSquared);
 
    // calculate/store matrices defining the derivatives dx/dA
    fDXDAM[0]=new TMatrixDSparse(*fE);
@@ -609,58 +718,45 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparse(const TMatrixDSparse *a,
             a->GetNcols(),b->GetNrows());
    }
 
-   TMatrixDSparse *r=new TMatrixDSparse(a->GetNrows(),b->GetNcols());
    const Int_t *a_rows=a->GetRowIndexArray();
    const Int_t *a_cols=a->GetColIndexArray();
    const Double_t *a_data=a->GetMatrixArray();
    const Int_t *b_rows=b->GetRowIndexArray();
    const Int_t *b_cols=b->GetColIndexArray();
    const Double_t *b_data=b->GetMatrixArray();
-   // maximum size of the output matrix
-   int nMax=0;
-   for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-      if(a_rows[irow+1]>a_rows[irow]) nMax += b->GetNcols();
-   }
-   if((nMax>0)&&(a_cols)&&(b_cols)) {
-      Int_t *r_rows=new Int_t[nMax];
-      Int_t *r_cols=new Int_t[nMax];
-      Double_t *r_data=new Double_t[nMax];
-      Double_t *row_data=new Double_t[b->GetNcols()];
-      Int_t n=0;
-      for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-         if(a_rows[irow+1]<=a_rows[irow]) continue;
-         // clear row data
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            row_data[icol]=0.0;
-         }
-         // loop over a-columns in this a-row
-         for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
-            Int_t k=a_cols[ia];
-            // loop over b-columns in b-row k
-            for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
-               row_data[b_cols[ib]] += a_data[ia]*b_data[ib];
+   const Int_t nrow=a->GetNrows();
+   const Int_t ncol=b->GetNcols();
+   if((!a_cols)||(!b_cols)) {
+      return new TMatrixDSparse(nrow,ncol);
+   }
+   // estimated number of operations
+   Long64_t work=(Long64_t)nrow*ncol;
+   if(b->GetNrows()>0) {
+      work += (Long64_t)a_rows[nrow]*b_rows[b->GetNrows()]/b->GetNrows();
+   }
+   return CreateSparseMatrixByRows
+      (nrow,ncol,work,[&](Int_t first,Int_t last,SparseRows_t &r) {
+         std::vector<Double_t> row_data(ncol);
+         for (Int_t irow = first; irow < last; irow++) {
+            if(a_rows[irow+1]<=a_rows[irow]) continue;
+            // clear row data
+            std::fill(row_data.begin(),row_data.end(),0.0);
+            // loop over a-columns in this a-row
+            for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
+               Int_t k=a_cols[ia];
+               // loop over b-columns in b-row k
+               for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
+                  row_data[b_cols[ib]] += a_data[ia]*b_data[ib];
+               }
             }
-         }
-         // store nonzero elements
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            if(row_data[icol] != 0.0) {
-               r_rows[n]=irow;
-               r_cols[n]=icol;
-               r_data[n]=row_data[icol];
-               n++;
+            // store nonzero elements
+            for(Int_t icol=0;icol<ncol;icol++) {
+               if(row_data[icol] != 0.0) {
+                  r.Add(irow,icol,row_data[icol]);
+               }
             }
          }
-      }
-      if(n>0) {
-         r->SetMatrixArray(n,r_rows,r_cols,r_data);
-      }
-      delete[] r_rows;
-      delete[] r_cols;
-      delete[] r_data;
-      delete[] row_data;
-   }
-
-   return r;
+      });
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -683,68 +779,74 @@ TMatrixDSparse *TUnfold::MultiplyMSparseTranspMSparse
             a->GetNrows(),b->GetNrows());
    }
 
-   TMatrixDSparse *r=new TMatrixDSparse(a->GetNcols(),b->GetNcols());
    const Int_t *a_rows=a->GetRowIndexArray();
    const Int_t *a_cols=a->GetColIndexArray();
    const Double_t *a_data=a->GetMatrixArray();
    const Int_t *b_rows=b->GetRowIndexArray();
    const Int_t *b_cols=b->GetColIndexArray();
    const Double_t *b_data=b->GetMatrixArray();
-   // maximum size of the output matrix
-
-   // matrix multiplication
-   typedef std::map<Int_t,Double_t> MMatrixRow_t;
-   typedef std::map<Int_t, MMatrixRow_t > MMatrix_t;
-   MMatrix_t matrix;
-
-   for(Int_t iRowAB=0;iRowAB<a->GetNrows();iRowAB++) {
-      for(Int_t ia=a_rows[iRowAB];ia<a_rows[iRowAB+1];ia++) {
-         for(Int_t ib=b_rows[iRowAB];ib<b_rows[iRowAB+1];ib++) {
-            // this creates a new row if necessary
-            MMatrixRow_t &row=matrix[a_cols[ia]];
-            MMatrixRow_t::iterator icol=row.find(b_cols[ib]);
-            if(icol!=row.end()) {
-               // update existing row
-               (*icol).second += a_data[ia]*b_data[ib];
-            } else {
-               // create new row
-               row[b_cols[ib]] = a_data[ia]*b_data[ib];
-            }
-         }
-      }
-   }
+   const Int_t nrowAB=a->GetNrows();
+   const Int_t nrow=a->GetNcols();
+   const Int_t ncol=b->GetNcols();
 
-   Int_t n=0;
-   for(MMatrix_t::const_iterator irow=matrix.begin();
-       irow!=matrix.end();irow++) {
-      n += (*irow).second.size();
-   }
-   if(n>0) {
-      // pack matrix into arrays
-      Int_t *r_rows=new Int_t[n];
-      Int_t *r_cols=new Int_t[n];
-      Double_t *r_data=new Double_t[n];
-      n=0;
-      for(MMatrix_t::const_iterator irow=matrix.begin();
-          irow!=matrix.end();irow++) {
-         for(MMatrixRow_t::const_iterator icol=(*irow).second.begin();
-             icol!=(*irow).second.end();icol++) {
-            r_rows[n]=(*irow).first;
-            r_cols[n]=(*icol).first;
-            r_data[n]=(*icol).second;
-            n++;
-         }
-      }
-      // pack arrays into TMatrixDSparse
-      if(n>0) {
-         r->SetMatrixArray(n,r_rows,r_cols,r_data);
-      }
-      delete[] r_rows;
-      delete[] r_cols;
-      delete[] r_data;
+   // column-wise index of a: the elements of column i of a are
+   // aT_index[aT_start[i]..aT_start[i+1]), in increasing row order
+   const Int_t nA=a_rows[nrowAB];
+   std::vector<Int_t> aT_start(nrow+1,0);
+   std::vector<Int_t> aT_row(nA),aT_index(nA);
+   for(Int_t ia=0;ia<nA;ia++) {
+      aT_start[a_cols[ia]+1]++;
    }
-
-   return r;
+   for(Int_t i=0;i<nrow;i++) {
+      aT_start[i+1] += aT_start[i];
+   }
+   {
+      std::vector<Int_t> pos(aT_start.begin(),aT_start.end()-1);
+      for(Int_t iRowAB=0;iRowAB<nrowAB;iRowAB++) {
+         for(Int_t ia=a_rows[iRowAB];ia<a_rows[iRowAB+1];ia++) {
+            Int_t k=pos[a_cols[ia]]++;
+            aT_row[k]=iRowAB;
+            aT_index[k]=ia;
+         }
+      }
+   }
+
+   // matrix multiplication, row by row of the result.
+   // All the elements touched by the product are stored, including
+   // accidental zeros, and each element is summed in increasing order of
+   // the rows of a and b
+   Long64_t work=(Long64_t)nrow;
+   if(nrowAB>0) {
+      work += (Long64_t)nA*b_rows[nrowAB]/nrowAB;
+   }
+   return CreateSparseMatrixByRows
+      (nrow,ncol,work,[&](Int_t first,Int_t last,SparseRows_t &r) {
+         std::vector<Double_t> row_data(ncol);
+         std::vector<char> used(ncol,0);
+         std::vector<Int_t> icols;
+         for(Int_t irow=first;irow<last;irow++) {
+            icols.clear();
+            for(Int_t k=aT_start[irow];k<aT_start[irow+1];k++) {
+               Int_t iRowAB=aT_row[k];
+               Double_t a_ik=a_data[aT_index[k]];
+               for(Int_t ib=b_rows[iRowAB];ib<b_rows[iRowAB+1];ib++) {
+                  Int_t icol=b_cols[ib];
+                  if(used[icol]) {
+                     row_data[icol] += a_ik*b_data[ib];
+                  } else {
+                     used[icol]=1;
+                     row_data[icol] = a_ik*b_data[ib];
+                     icols.push_back(icol);
+                  }
+               }
+            }
+            std::sort(icols.begin(),icols.end());
+            for(Int_t icol : icols) {
+               r.Add(irow,icol,row_data[icol]);
+               used[icol]=0;
+            }
+         }
+      });
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -765,43 +867,27 @@ TMatrixDSparse *TUnfold::MultiplyMSparseM(const TMatrixDSparse *a,
             a->GetNcols(),b->GetNrows());
    }
 
-   TMatrixDSparse *r=new TMatrixDSparse(a->GetNrows(),b->GetNcols());
    const Int_t *a_rows=a->GetRowIndexArray();
    const Int_t *a_cols=a->GetColIndexArray();
    const Double_t *a_data=a->GetMatrixArray();
-   // maximum size of the output matrix
-   int nMax=0;
-   for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-      if(a_rows[irow+1]-a_rows[irow]>0) nMax += b->GetNcols();
-   }
-   if(nMax>0) {
-      Int_t *r_rows=new Int_t[nMax];
-      Int_t *r_cols=new Int_t[nMax];
-      Double_t *r_data=new Double_t[nMax];
-
-      Int_t n=0;
-      // fill matrix r
-      for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-         if(a_rows[irow+1]-a_rows[irow]<=0) continue;
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            r_rows[n]=irow;
-            r_cols[n]=icol;
-            r_data[n]=0.0;
-            for(Int_t i=a_rows[irow];i<a_rows[irow+1];i++) {
-               Int_t j=a_cols[i];
-               r_data[n] += a_data[i]*(*b)(j,icol);
+   const Int_t nrow=a->GetNrows();
+   const Int_t ncol=b->GetNcols();
+   Long64_t work=(Long64_t)a_rows[nrow]*ncol;
+   // fill matrix r
+   return CreateSparseMatrixByRows
+      (nrow,ncol,work,[&](Int_t first,Int_t last,SparseRows_t &r) {
+         for (Int_t irow = first; irow < last; irow++) {
+            if(a_rows[irow+1]-a_rows[irow]<=0) continue;
+            for(Int_t icol=0;icol<ncol;icol++) {
+               Double_t sum=0.0;
+               for(Int_t i=a_rows[irow];i<a_rows[irow+1];i++) {
+                  Int_t j=a_cols[i];
+                  sum += a_data[i]*(*b)(j,icol);
+               }
+               if(sum!=0.0) r.Add(irow,icol,sum);
             }
-            if(r_data[n]!=0.0) n++;
          }
-      }
-      if(n>0) {
-         r->SetMatrixArray(n,r_rows,r_cols,r_data);
-      }
-      delete[] r_rows;
-      delete[] r_cols;
-      delete[] r_data;
-   }
-   return r;
+      });
 }
 
 
@@ -852,53 +938,48 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparseTranspVector
       v_rows=v_sparse->GetRowIndexArray();
       v_data=v_sparse->GetMatrixArray();
    }
-   Int_t num_r=num_m1*num_m2+1;
-   Int_t *row_r=new Int_t[num_r];
-   Int_t *col_r=new Int_t[num_r];
-   Double_t *data_r=new Double_t[num_r];
-   num_r=0;
-   for(Int_t i=0;i<m1->GetNrows();i++) {
-      for(Int_t j=0;j<m2->GetNrows();j++) {
-         data_r[num_r]=0.0;
-         Int_t index_m1=rows_m1[i];
-         Int_t index_m2=rows_m2[j];
-         while((index_m1<rows_m1[i+1])&&(index_m2<rows_m2[j+1])) {
-            Int_t k1=cols_m1[index_m1];
-            Int_t k2=cols_m2[index_m2];
-            if(k1<k2) {
-               index_m1++;
-            } else if(k1>k2) {
-               index_m2++;
-            } else {
-               if(v_sparse) {
-                  Int_t v_index=v_rows[k1];
-                  if(v_index<v_rows[k1+1]) {
-                     data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
-                        * v_data[v_index];
+   Long64_t work=(Long64_t)num_m1*num_m2;
+   if(m1->GetNrows()>0) {
+      work *= (rows_m1[m1->GetNrows()]/m1->GetNrows()+1);
+   }
+   return CreateSparseMatrixByRows
+      (m1->GetNrows(),m2->GetNrows(),work,[&](Int_t first,Int_t last,SparseRows_t &r) {
+         for(Int_t i=first;i<last;i++) {
+            if(rows_m1[i]>=rows_m1[i+1]) continue;
+            for(Int_t j=0;j<m2->GetNrows();j++) {
+               Double_t data_r=0.0;
+               Int_t index_m1=rows_m1[i];
+               Int_t index_m2=rows_m2[j];
+               while((index_m1<rows_m1[i+1])&&(index_m2<rows_m2[j+1])) {
+                  Int_t k1=cols_m1[index_m1];
+                  Int_t k2=cols_m2[index_m2];
+                  if(k1<k2) {
+                     index_m1++;
+                  } else if(k1>k2) {
+                     index_m2++;
+                  } else {
+                     if(v_sparse) {
+                        Int_t v_index=v_rows[k1];
+                        if(v_index<v_rows[k1+1]) {
+                           data_r += data_m1[index_m1] * data_m2[index_m2]
+                              * v_data[v_index];
+                        }
+                     } else if(v) {
+                        data_r += data_m1[index_m1] * data_m2[index_m2]
+                           * (*v)(k1,0);
+                     } else {
+                        data_r += data_m1[index_m1] * data_m2[index_m2];
+                     }
+                     index_m1++;
+                     index_m2++;
                   }
-               } else if(v) {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
-                     * (*v)(k1,0);
-               } else {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2];
                }
-               index_m1++;
-               index_m2++;
+               if(data_r !=0.0) {
+                  r.Add(i,j,data_r);
+               }
             }
          }
-         if(data_r[num_r] !=0.0) {
-            row_r[num_r]=i;
-            col_r[num_r]=j;
-            num_r++;
-         }
-      }
-   }
-   TMatrixDSparse *r=CreateSparseMatrix(m1->GetNrows(),m2->GetNrows(),
-                                        num_r,row_r,col_r,data_r);
-   delete[] row_r;
-   delete[] col_r;
-   delete[] data_r;
-   return r;
+      });
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -1996,6 +2077,7 @@ Bool_t TUnfold::AddRegularisationCondition
    // replace the old matrix fL
    if(r) {
       DeleteMatrix(&fL);
+      DeleteMatrix(&fLSquared);
       fL=CreateSparseMatrix(rowMax+1,GetNx(),nF,l_row,l_col,l_data);
    }
    delete [] l_row;
@@ -2282,6 +2364,7 @@ Int_t TUnfold::SetInput(const TH1 *input, Double_t scaleBias,
   //   + see ClearResults
 
   DeleteMatrix(&fVyyInv);
+  ClearCachedProducts();
   fNdf=0;
 
   fBiasScale = scaleBias;
@@ -160,6 +160,15 @@ INCLUDED in the methods provided by the base class TUnfold.
 #include <cmath>
 
 #include "TUnfoldSys.h"
+#include "RConfigure.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <vector>
 
 ClassImp(TUnfoldSys)
 
@@ -668,7 +677,7 @@ void TUnfoldSys::PrepareSysError(void)
       fEmatUncorrX=PrepareUncorrEmat(GetDXDAM(0),GetDXDAM(1));
    }
    TMatrixDSparse *AM0=nullptr,*AM1=nullptr;
-   if(!fEmatUncorrAx) {
+   auto prepareAM=[&]() {
       if(!AM0) AM0=MultiplyMSparseMSparse(fA,GetDXDAM(0));
       if(!AM1) {
          AM1=MultiplyMSparseMSparse(fA,GetDXDAM(1));
@@ -684,8 +693,13 @@ void TUnfoldSys::PrepareSysError(void)
          delete[] rows_cols;
          AddMSparse(AM1,-1.,one);
          DeleteMatrix(&one);
+      }
+      if(!fEmatUncorrAx) {
          fEmatUncorrAx=PrepareUncorrEmat(AM0,AM1);
       }
+   };
+   if(!fEmatUncorrAx) {
+      prepareAM();
    }
    if((!fDeltaSysTau )&&(fDtau>0.0)) {
       fDeltaSysTau=new TMatrixDSparse(*GetDXDtauSquared());
@@ -700,38 +714,53 @@ void TUnfoldSys::PrepareSysError(void)
    TMapIter sysErrIn(fSysIn);
    const TObjString *key;
 
-   // calculate individual systematic errors
+   // find the systematic errors to be calculated
+   std::vector<const TObjString *> keysX,keysAx;
+   std::vector<const TMatrixDSparse *> dsysX,dsysAx;
    for(key=(const TObjString *)sysErrIn.Next();key;
        key=(const TObjString *)sysErrIn.Next()) {
       const TMatrixDSparse *dsys=
          (const TMatrixDSparse *)((const TPair *)*sysErrIn)->Value();
-      const TPair *named_emat=(const TPair *)
-         fDeltaCorrX->FindObject(key->GetString());
-      if(!named_emat) {
-         TMatrixDSparse *emat=PrepareCorrEmat(GetDXDAM(0),GetDXDAM(1),dsys);
-         fDeltaCorrX->Add(new TObjString(*key),emat);
+      if(!fDeltaCorrX->FindObject(key->GetString())) {
+         keysX.push_back(key);
+         dsysX.push_back(dsys);
       }
-      named_emat=(const TPair *)fDeltaCorrAx->FindObject(key->GetString());
-      if(!named_emat) {
-         if(!AM0) AM0=MultiplyMSparseMSparse(fA,GetDXDAM(0));
-         if(!AM1) {
-            AM1=MultiplyMSparseMSparse(fA,GetDXDAM(1));
-            Int_t *rows_cols=new Int_t[GetNy()];
-            Double_t *data=new Double_t[GetNy()];
-            for(Int_t i=0;i<GetNy();i++) {
-               rows_cols[i]=i;
-               data[i]=1.0;
-            }
-            TMatrixDSparse *one=CreateSparseMatrix
-               (GetNy(),GetNy(),GetNy(),rows_cols, rows_cols,data);
-            delete[] data;
-            delete[] rows_cols;
-            AddMSparse(AM1,-1.,one);
-            DeleteMatrix(&one);
-            fEmatUncorrAx=PrepareUncorrEmat(AM0,AM1);
-         }
-         TMatrixDSparse *emat=PrepareCorrEmat(AM0,AM1,dsys);
-         fDeltaCorrAx->Add(new TObjString(*key),emat);
+      if(!fDeltaCorrAx->FindObject(key->GetString())) {
+         keysAx.push_back(key);
+         dsysAx.push_back(dsys);
+      }
+   }
+   if(!keysAx.empty()) {
+      prepareAM();
+   }
+
+   // calculate individual systematic errors. The sources are
+   // independent, they are processed in parallel if implicit
+   // multithreading is enabled
+   Int_t nX=keysX.size();
+   Int_t nTask=nX+keysAx.size();
+   std::vector<TMatrixDSparse *> emat(nTask);
+   auto task=[&](Int_t i) {
+      if(i<nX) {
+         emat[i]=PrepareCorrEmat(GetDXDAM(0),GetDXDAM(1),dsysX[i]);
+      } else {
+         emat[i]=PrepareCorrEmat(AM0,AM1,dsysAx[i-nX]);
+      }
+   };
+#ifdef R__USE_IMT
+   if(ROOT::IsImplicitMTEnabled() && (nTask>1)) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(task,ROOT::TSeqI(nTask));
+   } else
+#endif
+   {
+      for(Int_t i=0;i<nTask;i++) task(i);
+   }
+   for(Int_t i=0;i<nTask;i++) {
+      if(i<nX) {
+         fDeltaCorrX->Add(new TObjString(*keysX[i]),emat[i]);
+      } else {
+         fDeltaCorrAx->Add(new TObjString(*keysAx[i-nX]),emat[i]);
       }
    }
    DeleteMatrix(&AM0);
@@ -0,0 +1,103 @@
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RFileBlockCache
+#define ROOT_RFileBlockCache
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+ * \class RFileBlockCache RFileBlockCache.hxx
+ * \ingroup IO
+ *
+ * A block-level read-through cache of remote files on a local disk, shared by the processes of a node.
+ *
+ * Contrary to TFile::SetCacheFileDir(), which downloads entire files, only the blocks that are actually read
+ * are stored. The cache directory contains one subdirectory per remote file, named by the MD5 sum of its URL,
+ * with one file per block. A block file is written under a temporary name and renamed, so that concurrent
+ * readers only ever see complete blocks. The `index` file records the number of cached bytes per remote file;
+ * it is updated under an exclusive lock (flock) of the `lock` file. When the cache exceeds its budget, the
+ * least recently used blocks are removed until it is at 90% of the budget; a hit refreshes the modification
+ * time of the block file, at most once per minute.
+ *
+ * The entries of a remote file are validated by its size and modification time: if they differ from the
+ * ones of the cached blocks, the blocks are dropped.
+ *
+ * The cache is configured by Configure() or by the ROOT environment: Cache.Block.Directory (disabled if
+ * empty), Cache.Block.Budget in MB (10240 by default) and Cache.Block.Size in kB (1024 by default).
+ */
+class RFileBlockCache {
+public:
+   /// A read request, either of the cache user or of the cache to the remote file
+   struct RRequest {
+      void *fBuffer = nullptr;
+      std::uint64_t fOffset = 0;
+      std::size_t fSize = 0;
+      /// The number of bytes actually read
+      std::size_t fOutBytes = 0;
+   };
+   /// Reads the requests from the remote file and sets their fOutBytes; throws std::runtime_error on failure.
+   /// The buffers of the requests are consecutive in memory, in the order of the requests.
+   using FetchFunc_t = std::function<void(RRequest *requests, std::size_t nReq)>;
+
+   static constexpr std::uint64_t kDefaultBudget = 10240ull * 1024 * 1024;
+   static constexpr std::size_t kDefaultBlockSize = 1024 * 1024;
+
+private:
+   std::string fDirectory;   ///< The subdirectory of the remote file
+   std::string fCacheRoot;   ///< The cache directory
+   std::string fUrlHash;     ///< The name of fDirectory in fCacheRoot
+   std::uint64_t fFileSize;  ///< The size of the remote file
+   std::size_t fBlockSize;
+   std::uint64_t fBudget;
+   std::atomic<std::uint64_t> fNBlocksHit{0};
+   std::atomic<std::uint64_t> fNBlocksMissed{0};
+
+   RFileBlockCache(const std::string &cacheRoot, const std::string &urlHash, std::uint64_t fileSize,
+                   std::size_t blockSize, std::uint64_t budget);
+
+   std::string GetBlockPath(std::uint64_t block) const;
+   /// The expected size of a block, smaller than fBlockSize for the last block of the file
+   std::size_t GetBlockSize(std::uint64_t block) const;
+   /// Adds nbytes to the cached bytes of this file in the index, and evicts blocks if the budget is exceeded
+   void AddToIndex(std::uint64_t nbytes);
+
+public:
+   RFileBlockCache(const RFileBlockCache &) = delete;
+   RFileBlockCache &operator=(const RFileBlockCache &) = delete;
+   ~RFileBlockCache() = default;
+
+   /// Set the cache directory, an empty directory disabling the cache, the size budget and the block size.
+   /// Affects the caches opened afterwards.
+   static void Configure(const std::string &directory, std::uint64_t budget = kDefaultBudget,
+                         std::size_t blockSize = kDefaultBlockSize);
+   static bool IsEnabled();
+   /// The cache of the remote file `url` with the given size and modification time (in seconds since the epoch,
+   /// or -1 if unknown). Returns nullptr if the cache is disabled or its directory cannot be used.
+   static std::unique_ptr<RFileBlockCache> Open(const std::string &url, std::uint64_t fileSize, std::int64_t modTime);
+
+   /// Serve the requests from the cache, fetching the missing blocks with `fetch` and storing them. The requests
+   /// beyond the end of the file are short. Throws std::runtime_error if fetching fails.
+   void Read(RRequest *requests, std::size_t nReq, const FetchFunc_t &fetch);
+
+   std::uint64_t GetNBlocksHit() const { return fNBlocksHit; }
+   std::uint64_t GetNBlocksMissed() const { return fNBlocksMissed; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
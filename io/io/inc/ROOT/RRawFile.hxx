@@ -177,6 +177,13 @@ public:
    void ReadV(RIOVec *ioVec, unsigned int nReq);
    /// Returns the limits regarding the ioVec input to ReadV for this specific file; may open the file as a side-effect.
    virtual RIOVecLimits GetReadVLimits() { return RIOVecLimits(); }
+   /// Returns true if ReadV() accepts request vectors exceeding the limits of GetReadVLimits(), splitting them
+   /// itself into several vector reads that are issued concurrently. Callers should then pass all their requests
+   /// in a single ReadV() call rather than one call per batch, so that the round trips overlap.
+   virtual bool HasPipelinedReadV() const { return false; }
+   /// Returns the modification time of the file in seconds since the epoch, or -1 if it is unknown; may open the
+   /// file as a side-effect.
+   virtual std::int64_t GetModificationTime() { return -1; }
 
    /// Turn off buffered reads; all scalar read requests go directly to the implementation. Buffering can be turned
    /// back on.
@@ -0,0 +1,130 @@
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RRawFileBlockCached
+#define ROOT_RRawFileBlockCached
+
+#include <ROOT/RFileBlockCache.hxx>
+#include <ROOT/RRawFile.hxx>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+ * \class RRawFileBlockCached RRawFileBlockCached.hxx
+ * \ingroup IO
+ *
+ * The RRawFileBlockCached wraps a remote RRawFile and reads it through the local RFileBlockCache. RRawFile::Create()
+ * returns it for remote files if the block cache is enabled. If the cache cannot be used, the reads go to the
+ * remote file directly.
+ */
+class RRawFileBlockCached : public RRawFile {
+private:
+   std::unique_ptr<RRawFile> fRemote;
+   std::unique_ptr<RFileBlockCache> fCache;
+
+   /// Read the requests from the remote file, in batches within its vector read limits
+   void Fetch(RFileBlockCache::RRequest *requests, std::size_t nReq)
+   {
+      std::vector<RIOVec> ioVec(nReq);
+      for (std::size_t i = 0; i < nReq; ++i) {
+         ioVec[i].fBuffer = requests[i].fBuffer;
+         ioVec[i].fOffset = requests[i].fOffset;
+         ioVec[i].fSize = requests[i].fSize;
+      }
+      if (fRemote->HasPipelinedReadV()) {
+         fRemote->ReadV(ioVec.data(), nReq);
+      } else {
+         const auto limits = fRemote->GetReadVLimits();
+         for (std::size_t i = 0; i < nReq;) {
+            std::size_t nBatch = 0;
+            std::uint64_t batchSize = 0;
+            while (i + nBatch < nReq && nBatch < limits.fMaxReqs && ioVec[i + nBatch].fSize <= limits.fMaxSingleSize &&
+                   batchSize + ioVec[i + nBatch].fSize <= limits.fMaxTotalSize) {
+               batchSize += ioVec[i + nBatch].fSize;
+               ++nBatch;
+            }
+            if (nBatch == 0) {
+               ioVec[i].fOutBytes = fRemote->ReadAt(ioVec[i].fBuffer, ioVec[i].fSize, ioVec[i].fOffset);
+               nBatch = 1;
+            } else {
+               fRemote->ReadV(&ioVec[i], nBatch);
+            }
+            i += nBatch;
+         }
+      }
+      for (std::size_t i = 0; i < nReq; ++i)
+         requests[i].fOutBytes = ioVec[i].fOutBytes;
+   }
+
+protected:
+   void OpenImpl() final
+   {
+      fCache = RFileBlockCache::Open(fUrl, fRemote->GetSize(), fRemote->GetModificationTime());
+      if (fOptions.fBlockSize == ROptions::kUseDefaultBlockSize)
+         fOptions.fBlockSize = 0;
+   }
+
+   size_t ReadAtImpl(void *buffer, size_t nbytes, std::uint64_t offset) final
+   {
+      if (!fCache)
+         return fRemote->ReadAt(buffer, nbytes, offset);
+      RFileBlockCache::RRequest request{buffer, offset, nbytes, 0};
+      fCache->Read(&request, 1, [this](RFileBlockCache::RRequest *r, std::size_t n) { Fetch(r, n); });
+      return request.fOutBytes;
+   }
+
+   void ReadVImpl(RIOVec *ioVec, unsigned int nReq) final
+   {
+      if (!fCache)
+         return fRemote->ReadV(ioVec, nReq);
+      std::vector<RFileBlockCache::RRequest> requests(nReq);
+      for (unsigned int i = 0; i < nReq; ++i)
+         requests[i] = RFileBlockCache::RRequest{ioVec[i].fBuffer, ioVec[i].fOffset, ioVec[i].fSize, 0};
+      fCache->Read(requests.data(), nReq, [this](RFileBlockCache::RRequest *r, std::size_t n) { Fetch(r, n); });
+      for (unsigned int i = 0; i < nReq; ++i)
+         ioVec[i].fOutBytes = requests[i].fOutBytes;
+   }
+
+   std::uint64_t GetSizeImpl() final { return fRemote->GetSize(); }
+
+public:
+   RRawFileBlockCached(std::unique_ptr<RRawFile> remote, ROptions options)
+      : RRawFile(remote->GetUrl(), options), fRemote(std::move(remote))
+   {
+      // The cache reads whole blocks, buffering in the remote file would only add a copy
+      fRemote->SetBuffering(false);
+   }
+
+   std::unique_ptr<RRawFile> Clone() const final
+   {
+      return std::make_unique<RRawFileBlockCached>(fRemote->Clone(), fOptions);
+   }
+
+   /// Without cache, the limits of the remote file apply
+   RIOVecLimits GetReadVLimits() final
+   {
+      EnsureOpen();
+      return fCache ? RIOVecLimits() : fRemote->GetReadVLimits();
+   }
+   bool HasPipelinedReadV() const final { return fRemote->HasPipelinedReadV() || fCache; }
+   std::int64_t GetModificationTime() final { return fRemote->GetModificationTime(); }
+
+   const RFileBlockCache *GetCache() const { return fCache.get(); }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
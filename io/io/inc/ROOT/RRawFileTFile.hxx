@@ -15,7 +15,12 @@
 
 #include <TFile.h>
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <numeric>
 #include <stdexcept>
+#include <vector>
 
 namespace ROOT {
 namespace Internal {
@@ -24,7 +29,8 @@ namespace Internal {
  * \class RRawFileTFile RRawFileTFile.hxx
  * \ingroup IO
  *
- * The RRawFileTFile wraps an open TFile, but does not take ownership.
+ * The RRawFileTFile wraps an open TFile, but does not take ownership. Vector reads are forwarded to
+ * TFile::ReadBuffers(), so that they use the coalescing and the vector reads of the TFile backend.
  */
 class RRawFileTFile : public RRawFile {
 private:
@@ -41,6 +47,40 @@ protected:
       return nbytes;
    }
 
+   void ReadVImpl(RIOVec *ioVec, unsigned int nReq) final
+   {
+      // TFile::ReadBuffers() reads the blocks in order into one contiguous buffer
+      std::vector<unsigned int> order(nReq);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(),
+                [ioVec](unsigned int a, unsigned int b) { return ioVec[a].fOffset < ioVec[b].fOffset; });
+      std::vector<Long64_t> pos(nReq);
+      std::vector<Int_t> len(nReq);
+      std::uint64_t total = 0;
+      for (unsigned int i = 0; i < nReq; ++i) {
+         const auto &req = ioVec[order[i]];
+         if (req.fSize > INT_MAX)
+            return RRawFile::ReadVImpl(ioVec, nReq);
+         pos[i] = req.fOffset;
+         len[i] = req.fSize;
+         total += req.fSize;
+      }
+      if (nReq < 2 || total > INT_MAX)
+         return RRawFile::ReadVImpl(ioVec, nReq);
+
+      std::vector<char> buffer(total);
+      if (fFile->ReadBuffers(buffer.data(), pos.data(), len.data(), nReq)) {
+         throw std::runtime_error("failed to read expected number of bytes");
+      }
+      std::size_t k = 0;
+      for (unsigned int i = 0; i < nReq; ++i) {
+         auto &req = ioVec[order[i]];
+         memcpy(req.fBuffer, buffer.data() + k, req.fSize);
+         req.fOutBytes = req.fSize;
+         k += req.fSize;
+      }
+   }
+
    std::uint64_t GetSizeImpl() final { return fFile->GetSize(); }
 
 public:
@@ -17,20 +17,33 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 namespace ROOT {
 namespace Internal {
 
+class RIoUring;
+
 /**
  * \class RRawFileUnix RRawFileUnix.hxx
  * \ingroup IO
  *
  * The RRawFileUnix class uses POSIX calls to read from a mounted file system. Thus the path name can refer,
  * for instance, to a named pipe instead of a regular file.
+ *
+ * If ROOT is built with io_uring support, vector reads are submitted asynchronously through an io_uring instance
+ * that is created on the first ReadV() call and reused for the lifetime of the object.
  */
 class RRawFileUnix : public RRawFile {
 private:
+   /// Allows for keeping the io_uring instance as a member without exposing liburing in this header
+   struct RIoUringDeleter {
+      void operator()(RIoUring *ring) const;
+   };
+
    int fFileDes = -1;
+   /// Lazily created on the first vector read; reusing the ring avoids its setup cost for every ReadV() call
+   std::unique_ptr<RIoUring, RIoUringDeleter> fIoUring;
 
 protected:
    void OpenImpl() final;
@@ -16,6 +16,7 @@
 #include "TMemFile.h"
 #include "ROOT/RConfig.hxx"
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -25,6 +26,10 @@ namespace ROOT {
 
 class TBufferMergerFile;
 
+namespace Internal {
+class TBufferMergerWriter;
+}
+
 /**
  * \class TBufferMerger TBufferMerger.hxx
  * \ingroup IO
@@ -36,6 +41,14 @@ class TBufferMergerFile;
  * socket, TBufferMerger uses threads that each write to a
  * TBufferMergerFile, which in turn push data into a queue
  * managed by the TBufferMerger.
+ *
+ * By default, TBufferMergerFile::Write() merges the file into the
+ * output under a lock, so that the writing threads contend on it.
+ * After EnableBackgroundMerge(), the writing threads instead copy
+ * their serialised TMemFile into a bounded lock-free queue and
+ * continue; a dedicated writer thread merges the queued buffers in
+ * batches. The writing threads wait when the queued buffers exceed
+ * the given memory limit.
  */
 
 class TBufferMerger {
@@ -68,11 +81,21 @@ public:
     */
    std::shared_ptr<TBufferMergerFile> GetFile();
 
-   _R__DEPRECATED_LATER("The queuing mechanism in TBufferMerger was removed in ROOT v6.32")
-   size_t GetQueueSize() const { return 0; }
+   /** Merge the TBufferMergerFiles in a dedicated writer thread rather than in the threads
+    *  that write them. Must be called before the first GetFile().
+    *  @param maxBuffered Number of bytes of queued buffers above which TBufferMergerFile::Write() waits
+    *  @param queueCapacity Maximum number of queued buffers
+    */
+   void EnableBackgroundMerge(size_t maxBuffered = 256 * 1024 * 1024, size_t queueCapacity = 256);
 
-   _R__DEPRECATED_LATER("The queuing mechanism in TBufferMerger was removed in ROOT v6.32")
-   size_t GetBuffered() const { return 0; }
+   /** Returns whether the files are merged by a dedicated writer thread, see EnableBackgroundMerge() */
+   bool IsBackgroundMerge() const { return fWriter != nullptr; }
+
+   /** Returns the number of buffers waiting to be merged by the writer thread */
+   size_t GetQueueSize() const;
+
+   /** Returns the number of bytes waiting to be merged by the writer thread */
+   size_t GetBuffered() const;
 
    _R__DEPRECATED_LATER("The queuing mechanism in TBufferMerger was removed in ROOT v6.32")
    size_t GetAutoSave() const { return 0; }
@@ -125,10 +148,12 @@ private:
    void Init(std::unique_ptr<TFile>);
 
    void Merge(TBufferMergerFile *memfile);
+   void Push(TBufferMergerFile *memfile);
 
    TFileMerger fMerger{false, false};                            //< TFileMerger used to merge all buffers
    std::mutex fMergeMutex;                                       //< Mutex used to lock fMerger
    std::vector<std::weak_ptr<TBufferMergerFile>> fAttachedFiles; //< Attached files
+   std::unique_ptr<Internal::TBufferMergerWriter> fWriter;       //< Writer thread and its queue, if any
 };
 
 /**
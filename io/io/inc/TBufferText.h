@@ -135,6 +135,8 @@ public:
 protected:
    static const char *fgFloatFmt;  ///<!  printf argument for floats, either "%f" or "%e" or "%10f" and so on
    static const char *fgDoubleFmt; ///<!  printf argument for doubles, either "%f" or "%e" or "%10f" and so on
+   static Bool_t fgFloatShortest;  ///<!  floats are written with shortest round-trip representation
+   static Bool_t fgDoubleShortest; ///<!  doubles are written with shortest round-trip representation
 
    ClassDefOverride(TBufferText, 0); // a TBuffer subclass for all text-based streamers
 };
@@ -26,9 +26,18 @@
 #include "TDatime.h"
 #include "TList.h"
 
+#include <memory>
+#include <vector>
+
 class TKey;
 class TFile;
 
+namespace ROOT {
+namespace Internal {
+struct RKeyIndex;
+}
+} // namespace ROOT
+
 class TDirectoryFile : public TDirectory {
 
 protected:
@@ -44,15 +53,22 @@ protected:
    Long64_t    fSeekKeys{0};             ///< Location of Keys record on file
    TFile      *fFile{nullptr};           ///< Pointer to current file in memory
    TList      *fKeys{nullptr};           ///< Pointer to keys list in memory
+   mutable std::unique_ptr<ROOT::Internal::RKeyIndex> fKeyIndex; ///<! Keys not in fKeys yet, see SetLazyKeys()
 
    void        CleanTargets();
    void        InitDirectoryFile(TClass *cl = nullptr);
    void        BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir);
+   Int_t       CountKeysOfClass(const char *classname) const;
+   void        ExpandKeyIndex() const;
 
 private:
    TDirectoryFile(const TDirectoryFile &directory) = delete;  //Directories cannot be copied
    void operator=(const TDirectoryFile &) = delete; //Directories cannot be copied
 
+   Int_t       BuildKeyIndex(std::vector<char> &&keys, Int_t nkeys, Long64_t fsize);
+   void        DropKeyIndex();
+   TKey       *FindKeyInIndex(const char *name, Short_t cycle, Bool_t exactCycle) const;
+
 public:
    // TDirectory status bits
    enum EStatusBits { kCloseDirectory = BIT(7) }; // Unused in ROOT, never set. Maybe only in external code.
@@ -91,10 +107,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
            TFile      *GetFile() const override { return fFile; }
            TKey       *GetKey(const char *name, Short_t cycle=9999) const override;
-           TList      *GetListOfKeys() const override { return fKeys; }
+           TList      *GetListOfKeys() const override { ExpandKeyIndex(); return fKeys; }
    const TDatime      &GetModificationDate() const { return fDatimeM; }
            Int_t       GetNbytesKeys() const override { return fNbytesKeys; }
-           Int_t       GetNkeys() const override { return fKeys->GetSize(); }
+           Int_t       GetNkeys() const override;
            Long64_t    GetSeekDir() const override { return fSeekDir; }
            Long64_t    GetSeekParent() const override { return fSeekParent; }
            Long64_t    GetSeekKeys() const override { return fSeekKeys; }
@@ -115,6 +131,8 @@ public:
            void        SaveSelf(Bool_t force = kFALSE) override;
            Int_t       SaveObjectAs(const TObject *obj, const char *filename="", Option_t *option="") const override;
            void        SetBufferSize(Int_t bufsize) override;
+   static  void        SetLazyKeys(Bool_t lazy = kTRUE);
+   static  Bool_t      GetLazyKeys();
            void        SetModified() override {fModified = kTRUE;}
            void        SetSeekDir(Long64_t v) override { fSeekDir = v; }
            void        SetTRefAction(TObject *ref, TObject *parent) override;
@@ -22,6 +22,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <atomic>
+#include <map>
 #include <string>
 
 #include "Compression.h"
@@ -52,6 +53,7 @@ class TFilePrefetch;
 
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
+  friend class TFileCacheWrite;
   friend class TFilePrefetch;
 // TODO: We need to make sure only one TBasket is being written at a time
 // if we are writing multiple baskets in parallel.
@@ -105,6 +107,8 @@ protected:
    Bool_t           fInitDone{kFALSE};        ///<!True if the file has been initialized
    Bool_t           fMustFlush{kTRUE};        ///<!True if the file buffers must be flushed
    Bool_t           fIsPcmFile{kFALSE};       ///<!True if the file is a ROOT pcm file.
+   char            *fMapAddress{nullptr};     ///<!Read-only mapping of the file in MMAP mode
+   Long64_t         fMapSize{0};              ///<!Size of the mapping
    TFileOpenHandle *fAsyncHandle{nullptr};    ///<!For proper automatic cleanup
    EAsyncOpenStatus fAsyncOpenStatus{kAOSNotAsync}; ///<!Status of an asynchronous open request
    TUrl             fUrl;                     ///<!URL of file
@@ -114,6 +118,8 @@ protected:
 
    bool             fGlobalRegistration = true; ///<! if true, bypass use of global lists
 
+   std::map<UInt_t, std::string> fZipDictionaries; ///<!Compression dictionaries used in this file, by dictionary ID
+
 #ifdef R__USE_IMT
    std::mutex                                 fWriteMutex;  ///<!Lock for writing baskets / keys into the file.
 #endif
@@ -177,6 +183,10 @@ private:
    static  TFile      *OpenFromCache(const char *name, Option_t * = "",
                                      const char *ftitle = "", Int_t compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault,
                                      Int_t netopt = 0);
+           Bool_t      ReadBuffersVectored(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
+           Bool_t      CopyFromMap(char *buf, Long64_t pos, Int_t len);
+           void        MapFile();
+           void        UnmapFile();
 
 public:
    /// TFile status bits. BIT(13) is taken up by TObject
@@ -205,6 +215,7 @@ public:
    TFile(const char *fname, Option_t *option="", const char *ftitle="", Int_t compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault);
    ~TFile() override;
 
+           void        AddZipDictionary(UInt_t dictID, const std::string &dict);
            void        Close(Option_t *option="") override; // *MENU*
            void        Copy(TObject &) const override { MayNotUse("Copy(TObject &)"); }
    virtual Bool_t      Cp(const char *dst, Bool_t progressbar = kTRUE,UInt_t buffersize = 1000000);
@@ -254,6 +265,7 @@ public:
    virtual Long64_t    GetSize() const;
    virtual TList      *GetStreamerInfoList() final; // Note: to override behavior, please override GetStreamerInfoListImpl
    const   TList      *GetStreamerInfoCache();
+   const std::map<UInt_t, std::string> &GetZipDictionaries() const { return fZipDictionaries; }
    virtual void        IncrementProcessIDs() { fNProcessIDs++; }
    virtual Bool_t      IsArchive() const { return fIsArchive; }
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
@@ -333,6 +345,8 @@ public:
                                        Bool_t forceCacheread = kFALSE);
    static const char  *GetCacheFileDir();
    static Bool_t       ShrinkCacheFileDir(Long64_t shrinkSize, Long_t cleanupInteval = 0);
+   static Bool_t       SetBlockCacheDir(std::string_view cacheDir, Long64_t budget = 10737418240LL,
+                                        Int_t blockSize = 1048576);
    static Bool_t       Cp(const char *src, const char *dst, Bool_t progressbar = kTRUE,
                           UInt_t buffersize = 1000000);
 
@@ -53,6 +53,7 @@ protected:
    Bool_t         fIsSorted;         ///< True if fSeek array is sorted
    Bool_t         fIsTransferred;    ///< True when fBuffer contains something valid
    Long64_t       fPrefetchedBlocks; ///< Number of blocks prefetched.
+   Int_t          fMaxGap;           ///<! Largest gap in bytes between two blocks that are read in one request
 
    //variables for the second block prefetched with the same semantics as for the first one
    Int_t          fBNseek;
@@ -96,6 +97,7 @@ public:
    virtual Int_t       GetNoCacheReadCalls() const { return fNoCacheReadCalls; }
    virtual Int_t       GetUnzipBuffer(char ** /*buf*/, Long64_t /*pos*/, Int_t /*len*/, Bool_t * /*free*/) { return -1; }
            Long64_t    GetPrefetchedBlocks() const { return fPrefetchedBlocks; }
+           Int_t       GetMaxGap() const { return fMaxGap; }
    virtual Bool_t      IsAsyncReading() const { return fAsyncReading; };
    virtual void        SetEnablePrefetching(Bool_t setPrefetching = kFALSE);
    virtual Bool_t      IsEnablePrefetching() const { return fEnablePrefetching; };
@@ -109,6 +111,7 @@ public:
    virtual Int_t       ReadBuffer(char *buf, Long64_t pos, Int_t len);
    virtual Int_t       SetBufferSize(Long64_t buffersize);
    virtual void        SetFile(TFile *file, TFile::ECacheAction action = TFile::kDisconnect);
+           void        SetMaxGap(Int_t gap) { fMaxGap = gap < 0 ? 0 : gap; }
    virtual void        SetSkipZip(Bool_t /*skip*/ = kTRUE) {} // This function is only used by TTreeCacheUnzip (ignore it)
    virtual void        Sort();
    virtual void        SecondSort();                          //Method used to sort and merge the chunks in the second block
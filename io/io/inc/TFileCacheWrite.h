@@ -14,8 +14,16 @@
 
 #include "TObject.h"
 
+#include <memory>
+
 class TFile;
 
+namespace ROOT {
+namespace Internal {
+struct RAsyncFileWriter;
+}
+} // namespace ROOT
+
 class TFileCacheWrite : public TObject {
 
 protected:
@@ -25,21 +33,28 @@ protected:
    TFile        *fFile;           ///< Pointer to file
    char         *fBuffer;         ///< [fBufferSize] buffer of contiguous prefetched blocks
    Bool_t        fRecursive;      ///< flag to avoid recursive calls
+   std::unique_ptr<ROOT::Internal::RAsyncFileWriter> fAsync; ///<! Background writer, see SetAsyncWrite()
 
 private:
    TFileCacheWrite(const TFileCacheWrite &) = delete;            //cannot be copied
    TFileCacheWrite& operator=(const TFileCacheWrite &) = delete;
 
+   Bool_t              FlushBuffer();
+   Bool_t              SubmitAsync();
+   Bool_t              WaitAsync();
+
 public:
    TFileCacheWrite();
    TFileCacheWrite(TFile *file, Int_t buffersize);
    ~TFileCacheWrite() override;
    virtual Bool_t      Flush();
    virtual Int_t       GetBytesInCache() const { return fNtot; }
+           Int_t       GetAsyncWrite() const;
            void        Print(Option_t *option="") const override;
    virtual Int_t       ReadBuffer(char *buf, Long64_t pos, Int_t len);
    virtual Int_t       WriteBuffer(const char *buf, Long64_t pos, Int_t len);
    virtual void        SetFile(TFile *file);
+           Bool_t      SetAsyncWrite(Int_t nbuffers = 2);
 
    ClassDefOverride(TFileCacheWrite,1)  //TFile cache when writing
 };
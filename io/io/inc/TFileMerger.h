@@ -54,8 +54,11 @@ protected:
    TString        fObjectNames;               ///< List of object names to be either merged exclusively or skipped
    TList          fMergeList;                 ///< list of TObjString containing the name of the files need to be merged
    TList          fExcessFiles;               ///<! List of TObjString containing the name of the files not yet added to fFileList due to user or system limitation on the max number of files opened.
+   Int_t          fKeySlice{0};               ///<! Index of the subset of the object names merged by this merger, see SetKeySlice()
+   Int_t          fNKeySlices{1};             ///<! Number of subsets the object names are split into
 
    Bool_t         OpenExcessFiles();
+   Bool_t         IsInKeySlice(const TString &path, const char *name) const;
    virtual Bool_t AddFile(TFile *source, Bool_t own, Bool_t cpProgress);
    virtual Bool_t MergeRecursive(TDirectory *target, TList *sourcelist, Int_t type = kRegular | kAll);
 
@@ -101,6 +104,9 @@ public:
    void        AddObjectNames(const char *name) {fObjectNames += name; fObjectNames += " ";}
    const char *GetObjectNames() const {return fObjectNames.Data();}
    void        ClearObjectNames() {fObjectNames.Clear();}
+   Int_t       GetKeySlice() const { return fKeySlice; }
+   Int_t       GetNKeySlices() const { return fNKeySlices; }
+   void        SetKeySlice(Int_t slice, Int_t nslices);
 
     //--- file management interface
    virtual Bool_t SetCWD(const char * /*path*/) { MayNotUse("SetCWD"); return kFALSE; }
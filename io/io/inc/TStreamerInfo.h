@@ -109,6 +109,8 @@ private:
    TStreamerInfoActions::TActionSequence *fWriteMemberWise;       ///<! List of write action resulting from the compilation for use in member wise streaming.
    TStreamerInfoActions::TActionSequence *fWriteMemberWiseVecPtr; ///<! List of write action resulting from the compilation for use in member wise streaming.
    TStreamerInfoActions::TActionSequence *fWriteText;             ///<! List of text write action resulting for the compilation, used for JSON.
+   std::atomic<Bool_t> fWriteActionsBuilt{kFALSE}; ///<! Whether the write action sequences are up to date, see BuildWriteActions()
+   std::atomic<Bool_t> fTextActionsBuilt{kFALSE};  ///<! Whether the text action sequences are up to date, see BuildTextActions()
 
    static std::atomic<Int_t>             fgCount;     ///<Number of TStreamerInfo instances
 
@@ -129,6 +131,8 @@ private:
    void AddWriteTextAction(TStreamerInfoActions::TActionSequence *writeSequence, Int_t index, TCompInfo *compinfo);
    void AddReadMemberWiseVecPtrAction(TStreamerInfoActions::TActionSequence *readSequence, Int_t index, TCompInfo *compinfo);
    void AddWriteMemberWiseVecPtrAction(TStreamerInfoActions::TActionSequence *writeSequence, Int_t index, TCompInfo *compinfo);
+   void BuildWriteActions();
+   void BuildTextActions();
 
 public:
 
@@ -207,10 +211,10 @@ public:
    Int_t               GetElementOffset(Int_t id) const override {return fCompFull[id]->fOffset;}
    TStreamerInfoActions::TActionSequence *GetReadMemberWiseActions(Bool_t forCollection) { return forCollection ? fReadMemberWiseVecPtr : fReadMemberWise; }
    TStreamerInfoActions::TActionSequence *GetReadObjectWiseActions() { return fReadObjectWise; }
-   TStreamerInfoActions::TActionSequence *GetReadTextActions() { return fReadText; }
-   TStreamerInfoActions::TActionSequence *GetWriteMemberWiseActions(Bool_t forCollection) { return forCollection ? fWriteMemberWiseVecPtr : fWriteMemberWise; }
-   TStreamerInfoActions::TActionSequence *GetWriteObjectWiseActions() { return fWriteObjectWise; }
-   TStreamerInfoActions::TActionSequence *GetWriteTextActions() { return fWriteText; }
+   TStreamerInfoActions::TActionSequence *GetReadTextActions() { if (!fTextActionsBuilt) BuildTextActions(); return fReadText; }
+   TStreamerInfoActions::TActionSequence *GetWriteMemberWiseActions(Bool_t forCollection) { if (!fWriteActionsBuilt) BuildWriteActions(); return forCollection ? fWriteMemberWiseVecPtr : fWriteMemberWise; }
+   TStreamerInfoActions::TActionSequence *GetWriteObjectWiseActions() { if (!fWriteActionsBuilt) BuildWriteActions(); return fWriteObjectWise; }
+   TStreamerInfoActions::TActionSequence *GetWriteTextActions() { if (!fTextActionsBuilt) BuildTextActions(); return fWriteText; }
    Int_t               GetNdata()   const {return fNdata;}
    Int_t               GetNelement() const { return fElements->GetEntriesFast(); }
    Int_t               GetNumber()  const override { return fNumber; }
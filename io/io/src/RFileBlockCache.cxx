@@ -0,0 +1,416 @@
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RFileBlockCache.hxx"
+
+#include "TEnv.h"
+#include "TError.h"
+#include "TMD5.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/// A hit refreshes the modification time of a block file if it is older than that, in seconds
+constexpr time_t kTouchInterval = 60;
+/// Temporary files older than that, in seconds, are left over by crashed writers and removed by the eviction
+constexpr time_t kStaleTmpAge = 3600;
+
+struct RCacheConfig {
+   std::mutex fLock;
+   bool fIsInitialized = false;
+   std::string fDirectory;
+   std::uint64_t fBudget = ROOT::Internal::RFileBlockCache::kDefaultBudget;
+   std::size_t fBlockSize = ROOT::Internal::RFileBlockCache::kDefaultBlockSize;
+};
+
+RCacheConfig &GetConfig()
+{
+   static RCacheConfig config;
+   std::lock_guard<std::mutex> guard(config.fLock);
+   if (!config.fIsInitialized && gEnv) {
+      config.fDirectory = gEnv->GetValue("Cache.Block.Directory", "");
+      const Long64_t budgetMB = gEnv->GetValue("Cache.Block.Budget", 10240);
+      const Long64_t blockSizeKB = gEnv->GetValue("Cache.Block.Size", 1024);
+      if (budgetMB > 0)
+         config.fBudget = budgetMB * 1024 * 1024;
+      if (blockSizeKB > 0)
+         config.fBlockSize = blockSizeKB * 1024;
+      config.fIsInitialized = true;
+   }
+   return config;
+}
+
+/// Holds an exclusive lock of the cache directory while in scope
+class RCacheLock {
+   int fFd = -1;
+
+public:
+   explicit RCacheLock(const std::string &cacheRoot)
+   {
+      fFd = open((cacheRoot + "/lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+      if (fFd >= 0 && flock(fFd, LOCK_EX) != 0) {
+         close(fFd);
+         fFd = -1;
+      }
+   }
+   RCacheLock(const RCacheLock &) = delete;
+   RCacheLock &operator=(const RCacheLock &) = delete;
+   ~RCacheLock()
+   {
+      if (fFd >= 0)
+         close(fFd);
+   }
+   explicit operator bool() const { return fFd >= 0; }
+};
+
+std::string MakeTmpPath(const std::string &path)
+{
+   static std::atomic<unsigned int> gCounter{0};
+   return path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(gCounter++);
+}
+
+bool IsTmpPath(const std::string &name)
+{
+   return name.find(".tmp.") != std::string::npos;
+}
+
+/// Write the file under a temporary name and rename it, so that readers never see a partial file
+bool WriteFileAtomically(const std::string &path, const void *buffer, std::size_t size)
+{
+   const auto tmpPath = MakeTmpPath(path);
+   int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+   if (fd < 0)
+      return false;
+   auto data = static_cast<const char *>(buffer);
+   std::size_t written = 0;
+   while (written < size) {
+      auto res = write(fd, data + written, size - written);
+      if (res < 0 && errno == EINTR)
+         continue;
+      if (res <= 0)
+         break;
+      written += res;
+   }
+   close(fd);
+   if (written != size || rename(tmpPath.c_str(), path.c_str()) != 0) {
+      unlink(tmpPath.c_str());
+      return false;
+   }
+   return true;
+}
+
+std::string ReadSmallFile(const std::string &path)
+{
+   std::ifstream file(path);
+   std::stringstream content;
+   content << file.rdbuf();
+   return content.str();
+}
+
+/// The index maps the URL hashes to the number of cached bytes
+using Index_t = std::map<std::string, std::uint64_t>;
+
+Index_t ReadIndex(const std::string &cacheRoot)
+{
+   Index_t index;
+   std::ifstream file(cacheRoot + "/index");
+   std::string hash;
+   std::uint64_t nbytes;
+   while (file >> hash >> nbytes)
+      index[hash] = nbytes;
+   return index;
+}
+
+void WriteIndex(const std::string &cacheRoot, const Index_t &index)
+{
+   std::string content;
+   for (const auto &entry : index)
+      content += entry.first + " " + std::to_string(entry.second) + "\n";
+   WriteFileAtomically(cacheRoot + "/index", content.data(), content.size());
+}
+
+/// Remove the blocks of a remote file, keeping the tag
+void RemoveBlocks(const std::string &directory)
+{
+   DIR *dir = opendir(directory.c_str());
+   if (!dir)
+      return;
+   while (auto entry = readdir(dir)) {
+      const std::string name = entry->d_name;
+      if (name == "." || name == ".." || name == "tag")
+         continue;
+      unlink((directory + "/" + name).c_str());
+   }
+   closedir(dir);
+}
+
+/// Recompute the index from the block files and remove the least recently used blocks until the cache is at
+/// 90% of the budget if it exceeds the budget. Must be called under the cache lock.
+void Evict(const std::string &cacheRoot, std::uint64_t budget, Index_t &index)
+{
+   struct RBlockFile {
+      std::string fPath;
+      std::string fHash;
+      std::uint64_t fSize;
+      time_t fMTime;
+   };
+   std::vector<RBlockFile> blocks;
+   std::uint64_t total = 0;
+   const time_t now = time(nullptr);
+   for (auto &entry : index) {
+      entry.second = 0;
+      const std::string directory = cacheRoot + "/" + entry.first;
+      DIR *dir = opendir(directory.c_str());
+      if (!dir)
+         continue;
+      while (auto dirEntry = readdir(dir)) {
+         const std::string name = dirEntry->d_name;
+         if (name == "." || name == ".." || name == "tag")
+            continue;
+         const std::string path = directory + "/" + name;
+         struct stat info;
+         if (stat(path.c_str(), &info) != 0)
+            continue;
+         if (IsTmpPath(name)) {
+            if (now - info.st_mtime > kStaleTmpAge)
+               unlink(path.c_str());
+            continue;
+         }
+         blocks.push_back({path, entry.first, static_cast<std::uint64_t>(info.st_size), info.st_mtime});
+         entry.second += info.st_size;
+         total += info.st_size;
+      }
+      closedir(dir);
+   }
+
+   if (total > budget) {
+      std::sort(blocks.begin(), blocks.end(),
+                [](const RBlockFile &a, const RBlockFile &b) { return a.fMTime < b.fMTime; });
+      const std::uint64_t target = budget / 10 * 9;
+      for (const auto &block : blocks) {
+         if (total <= target)
+            break;
+         if (unlink(block.fPath.c_str()) == 0) {
+            total -= block.fSize;
+            index[block.fHash] -= block.fSize;
+         }
+      }
+   }
+   WriteIndex(cacheRoot, index);
+}
+
+} // anonymous namespace
+
+ROOT::Internal::RFileBlockCache::RFileBlockCache(const std::string &cacheRoot, const std::string &urlHash,
+                                                 std::uint64_t fileSize, std::size_t blockSize, std::uint64_t budget)
+   : fDirectory(cacheRoot + "/" + urlHash),
+     fCacheRoot(cacheRoot),
+     fUrlHash(urlHash),
+     fFileSize(fileSize),
+     fBlockSize(blockSize),
+     fBudget(budget)
+{
+}
+
+void ROOT::Internal::RFileBlockCache::Configure(const std::string &directory, std::uint64_t budget,
+                                                std::size_t blockSize)
+{
+   auto &config = GetConfig();
+   std::lock_guard<std::mutex> guard(config.fLock);
+   config.fDirectory = directory;
+   config.fBudget = budget;
+   config.fBlockSize = std::max<std::size_t>(blockSize, 1);
+   config.fIsInitialized = true;
+}
+
+bool ROOT::Internal::RFileBlockCache::IsEnabled()
+{
+   auto &config = GetConfig();
+   std::lock_guard<std::mutex> guard(config.fLock);
+   return !config.fDirectory.empty();
+}
+
+std::unique_ptr<ROOT::Internal::RFileBlockCache>
+ROOT::Internal::RFileBlockCache::Open(const std::string &url, std::uint64_t fileSize, std::int64_t modTime)
+{
+   std::string cacheRoot;
+   std::uint64_t budget;
+   std::size_t blockSize;
+   {
+      auto &config = GetConfig();
+      std::lock_guard<std::mutex> guard(config.fLock);
+      cacheRoot = config.fDirectory;
+      budget = config.fBudget;
+      blockSize = config.fBlockSize;
+   }
+   if (cacheRoot.empty())
+      return nullptr;
+
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(url.data()), url.size());
+   md5.Final();
+   const std::string urlHash = md5.AsString();
+   const std::string directory = cacheRoot + "/" + urlHash;
+   if ((mkdir(cacheRoot.c_str(), 0777) != 0 && errno != EEXIST) ||
+       (mkdir(directory.c_str(), 0777) != 0 && errno != EEXIST)) {
+      ::Warning("RFileBlockCache::Open", "cannot create the cache directory %s: %s, reading %s without cache",
+                directory.c_str(), strerror(errno), url.c_str());
+      return nullptr;
+   }
+
+   const std::string tag = "size=" + std::to_string(fileSize) + " mtime=" + std::to_string(modTime) +
+                           " blocksize=" + std::to_string(blockSize) + "\n";
+   const std::string tagPath = directory + "/tag";
+   if (ReadSmallFile(tagPath) != tag) {
+      RCacheLock lock(cacheRoot);
+      if (!lock) {
+         ::Warning("RFileBlockCache::Open", "cannot lock the cache directory %s, reading %s without cache",
+                   cacheRoot.c_str(), url.c_str());
+         return nullptr;
+      }
+      // Another process may have validated the entry in the meantime
+      if (ReadSmallFile(tagPath) != tag) {
+         RemoveBlocks(directory);
+         auto index = ReadIndex(cacheRoot);
+         index[urlHash] = 0;
+         WriteIndex(cacheRoot, index);
+         if (!WriteFileAtomically(tagPath, tag.data(), tag.size()))
+            return nullptr;
+      }
+   }
+
+   return std::unique_ptr<RFileBlockCache>(new RFileBlockCache(cacheRoot, urlHash, fileSize, blockSize, budget));
+}
+
+std::string ROOT::Internal::RFileBlockCache::GetBlockPath(std::uint64_t block) const
+{
+   return fDirectory + "/" + std::to_string(block);
+}
+
+std::size_t ROOT::Internal::RFileBlockCache::GetBlockSize(std::uint64_t block) const
+{
+   const std::uint64_t offset = block * fBlockSize;
+   return (offset >= fFileSize) ? 0 : std::min<std::uint64_t>(fBlockSize, fFileSize - offset);
+}
+
+void ROOT::Internal::RFileBlockCache::AddToIndex(std::uint64_t nbytes)
+{
+   RCacheLock lock(fCacheRoot);
+   if (!lock)
+      return;
+   auto index = ReadIndex(fCacheRoot);
+   index[fUrlHash] += nbytes;
+   std::uint64_t total = 0;
+   for (const auto &entry : index)
+      total += entry.second;
+   if (total > fBudget)
+      Evict(fCacheRoot, fBudget, index);
+   else
+      WriteIndex(fCacheRoot, index);
+}
+
+void ROOT::Internal::RFileBlockCache::Read(RRequest *requests, std::size_t nReq, const FetchFunc_t &fetch)
+{
+   // The parts of the requests in every block
+   struct RSegment {
+      std::size_t fBlockOffset;
+      std::size_t fSize;
+      char *fDestination;
+   };
+   std::map<std::uint64_t, std::vector<RSegment>> segments;
+   for (std::size_t i = 0; i < nReq; ++i) {
+      auto &req = requests[i];
+      const std::uint64_t end = std::min<std::uint64_t>(req.fOffset + req.fSize, fFileSize);
+      req.fOutBytes = (end > req.fOffset) ? end - req.fOffset : 0;
+      for (std::uint64_t offset = req.fOffset; offset < end;) {
+         const std::uint64_t block = offset / fBlockSize;
+         const std::size_t blockOffset = offset - block * fBlockSize;
+         const std::size_t size = std::min<std::uint64_t>(fBlockSize - blockOffset, end - offset);
+         segments[block].push_back({blockOffset, size, static_cast<char *>(req.fBuffer) + (offset - req.fOffset)});
+         offset += size;
+      }
+   }
+
+   std::vector<std::uint64_t> missing;
+   for (const auto &entry : segments) {
+      const auto block = entry.first;
+      int fd = open(GetBlockPath(block).c_str(), O_RDONLY | O_CLOEXEC);
+      bool isHit = false;
+      struct stat info;
+      if (fd >= 0 && fstat(fd, &info) == 0 && static_cast<std::uint64_t>(info.st_size) == GetBlockSize(block)) {
+         isHit = true;
+         for (const auto &segment : entry.second) {
+            if (pread(fd, segment.fDestination, segment.fSize, segment.fBlockOffset) !=
+                static_cast<ssize_t>(segment.fSize)) {
+               isHit = false;
+               break;
+            }
+         }
+         if (isHit && time(nullptr) - info.st_mtime > kTouchInterval)
+            futimens(fd, nullptr);
+      }
+      if (fd >= 0)
+         close(fd);
+      if (!isHit)
+         missing.push_back(block);
+   }
+   fNBlocksHit += segments.size() - missing.size();
+   fNBlocksMissed += missing.size();
+   if (missing.empty())
+      return;
+
+   // Fetch the missing blocks into one buffer
+   std::vector<RRequest> fetchRequests(missing.size());
+   std::size_t fetchSize = 0;
+   for (std::size_t i = 0; i < missing.size(); ++i) {
+      fetchRequests[i].fOffset = missing[i] * fBlockSize;
+      fetchRequests[i].fSize = GetBlockSize(missing[i]);
+      fetchSize += fetchRequests[i].fSize;
+   }
+   auto buffer = std::make_unique<unsigned char[]>(fetchSize);
+   std::size_t bufferOffset = 0;
+   for (auto &req : fetchRequests) {
+      req.fBuffer = buffer.get() + bufferOffset;
+      bufferOffset += req.fSize;
+   }
+   fetch(fetchRequests.data(), fetchRequests.size());
+
+   std::uint64_t nbytesStored = 0;
+   for (std::size_t i = 0; i < missing.size(); ++i) {
+      const auto &req = fetchRequests[i];
+      auto data = static_cast<const unsigned char *>(req.fBuffer);
+      for (const auto &segment : segments[missing[i]]) {
+         if (segment.fBlockOffset + segment.fSize > req.fOutBytes)
+            throw std::runtime_error("RFileBlockCache: short read of block " + std::to_string(missing[i]));
+         memcpy(segment.fDestination, data + segment.fBlockOffset, segment.fSize);
+      }
+      // Only complete blocks are stored
+      if (req.fOutBytes == req.fSize && WriteFileAtomically(GetBlockPath(missing[i]), data, req.fSize))
+         nbytesStored += req.fSize;
+   }
+   if (nbytesStored > 0)
+      AddToIndex(nbytesStored);
+}
@@ -14,6 +14,8 @@
 #ifdef _WIN32
 #include <ROOT/RRawFileWin.hxx>
 #else
+#include <ROOT/RFileBlockCache.hxx>
+#include <ROOT/RRawFileBlockCached.hxx>
 #include <ROOT/RRawFileUnix.hxx>
 #endif
 
@@ -78,7 +80,12 @@ ROOT::Internal::RRawFile::Create(std::string_view url, ROptions options)
       if (TPluginHandler *h = gROOT->GetPluginManager()->
           FindHandler("ROOT::Internal::RRawFile", std::string(url).c_str())) {
          if (h->LoadPlugin() == 0) {
-            return std::unique_ptr<RRawFile>(reinterpret_cast<RRawFile *>(h->ExecPlugin(2, &url, &options)));
+            std::unique_ptr<RRawFile> remote(reinterpret_cast<RRawFile *>(h->ExecPlugin(2, &url, &options)));
+#ifndef _WIN32
+            if (RFileBlockCache::IsEnabled())
+               return std::make_unique<RRawFileBlockCached>(std::move(remote), options);
+#endif
+            return remote;
          }
          throw std::runtime_error("Cannot load plugin handler for " + plgclass);
       }
@@ -34,10 +34,21 @@ namespace {
 constexpr int kDefaultBlockSize = 4096; // If fstat() does not provide a block size hint, use this value instead
 } // anonymous namespace
 
+void ROOT::Internal::RRawFileUnix::RIoUringDeleter::operator()(RIoUring *ring) const
+{
+#ifdef R__HAS_URING
+   delete ring;
+#else
+   (void)ring;
+#endif
+}
+
 ROOT::Internal::RRawFileUnix::RRawFileUnix(std::string_view url, ROptions options) : RRawFile(url, options) {}
 
 ROOT::Internal::RRawFileUnix::~RRawFileUnix()
 {
+   // Tear down the ring before the file descriptor it may still reference
+   fIoUring.reset();
    if (fFileDes >= 0)
       close(fFileDes);
 }
@@ -98,7 +109,8 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
    thread_local bool uring_failed = false;
    if (!uring_failed) {
       try {
-         RIoUring ring; // throws std::runtime_error
+         if (!fIoUring)
+            fIoUring.reset(new RIoUring()); // throws std::runtime_error
          std::vector<RIoUring::RReadEvent> reads;
          reads.reserve(nReq);
          for (std::size_t i = 0; i < nReq; ++i) {
@@ -109,7 +121,7 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
             ev.fFileDes = fFileDes;
             reads.push_back(ev);
          }
-         ring.SubmitReadsAndWait(reads.data(), nReq);
+         fIoUring->SubmitReadsAndWait(reads.data(), nReq);
          for (std::size_t i = 0; i < nReq; ++i) {
             ioVec[i].fOutBytes = reads.at(i).fOutBytes;
          }
@@ -120,6 +132,7 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
          Warning("RRawFileUnix",
               "io_uring setup failed, falling back to blocking I/O in ReadV");
          uring_failed = true;
+         fIoUring.reset();
       }
    }
 #endif
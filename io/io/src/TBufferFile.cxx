@@ -36,6 +36,7 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "TStreamerInfoActions.h"
 #include "TInterpreter.h"
 #include "TVirtualMutex.h"
+#include "ROOT/RByteSwap.hxx"
 
 #if (defined(__linux) || defined(__APPLE__)) && defined(__i386__) && \
      defined(__GNUC__)
@@ -1334,8 +1335,8 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    bswapcpy16(h, fBufCur, n);
    fBufCur += sizeof(Short_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -1356,8 +1357,8 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -1390,8 +1391,8 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1411,8 +1412,8 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    bswapcpy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -1429,8 +1430,8 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -2080,8 +2081,8 @@ void TBufferFile::WriteFastArray(const Short_t *h, Long64_t n)
    bswapcpy16(fBufCur, h, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
+   ROOT::Internal::ByteSwapCopy16(fBufCur, h, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(fBufCur, h, l);
@@ -2113,8 +2114,8 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Long64_t n)
    bswapcpy32(fBufCur, ii, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, ii, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(fBufCur, ii, l);
@@ -2188,8 +2189,8 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Long64_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -2220,8 +2221,8 @@ void TBufferFile::WriteFastArray(const Float_t *f, Long64_t n)
    bswapcpy32(fBufCur, f, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, f, n);
+   fBufCur += l;
 # endif
 #else
    memcpy(fBufCur, f, l);
@@ -2249,8 +2250,8 @@ void TBufferFile::WriteFastArray(const Double_t *d, Long64_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -94,6 +94,7 @@ class Container {
 
 #include <typeinfo>
 #include <string>
+#include <charconv>
 #include <cstring>
 #include <locale.h>
 #include <cmath>
@@ -131,6 +132,19 @@ class Container {
 
 ClassImp(TBufferJSON);
 
+namespace {
+
+/// Append integer value to the string, without printf formatting
+template <typename T>
+void AppendInteger(TString &buf, T value)
+{
+   char sbuf[30];
+   auto res = std::to_chars(sbuf, sbuf + sizeof(sbuf), value);
+   buf.Append(sbuf, res.ptr - sbuf);
+}
+
+} // namespace
+
 enum { json_TArray = 100, json_TCollection = -130, json_TString = 110, json_stdstring = 120 };
 
 ///////////////////////////////////////////////////////////////
@@ -1426,7 +1440,7 @@ void TBufferJSON::JsonWriteObject(const void *obj, const TClass *cl, Bool_t chec
       if (stack->fValues.size() > 2)
          Error("JsonWriteObject", "Problem when writing TString or std::string");
       stack->fValues.clear();
-      AppendOutput(fValue.Data());
+      fOutput->Append(fValue);
       fValue.Clear();
    } else if ((special_kind > 0) && (special_kind < ROOT::kSTLend)) {
       // here make STL container processing
@@ -1568,7 +1582,7 @@ void TBufferJSON::JsonWriteObject(const void *obj, const TClass *cl, Bool_t chec
 
       if (fValue.Length() > 0) {
          AppendOutput(separ);
-         AppendOutput(fValue.Data());
+         fOutput->Append(fValue);
       }
 
       AppendOutput("]");
@@ -2439,7 +2453,7 @@ void TBufferJSON::PerformPostProcessing(TJSONStackObj *stack, const TClass *obj_
    if (fValue.Length() == 0) {
       AppendOutput("null");
    } else {
-      AppendOutput(fValue.Data());
+      fOutput->Append(fValue);
       fValue.Clear();
    }
 
@@ -3036,18 +3050,26 @@ void TBufferJSON::JsonWriteArrayCompress(const T *vname, Int_t arrsize, const ch
    bool is_base64 = Stack()->fBase64 || (fArrayCompact == kBase64);
 
    if (!is_base64 && ((fArrayCompact == 0) || (arrsize < 6))) {
-      fValue.Append("[");
+      // reserve space for typical values to avoid repeated reallocations of large arrays
+      Ssiz_t expected = fValue.Length() + arrsize * (fArraySepar.Length() + (sizeof(T) > 2 ? 8 : 3)) + 2;
+      if (expected > fValue.Capacity())
+         fValue.Capacity(expected);
+      fValue.Append('[');
       for (Int_t indx = 0; indx < arrsize; indx++) {
          if (indx > 0)
-            fValue.Append(fArraySepar.Data());
+            fValue.Append(fArraySepar);
          JsonWriteBasic(vname[indx]);
       }
-      fValue.Append("]");
+      fValue.Append(']');
    } else if (is_base64 && !arrsize) {
       fValue.Append("[]");
    } else {
-      fValue.Append("{");
-      fValue.Append(TString::Format("\"$arr\":\"%s\"%s\"len\":%d", typname, fArraySepar.Data(), arrsize));
+      fValue.Append("{\"$arr\":\"");
+      fValue.Append(typname);
+      fValue.Append('"');
+      fValue.Append(fArraySepar);
+      fValue.Append("\"len\":");
+      AppendInteger(fValue, arrsize);
       Int_t aindx(0), bindx(arrsize);
       while ((aindx < arrsize) && (vname[aindx] == 0))
          aindx++;
@@ -3466,7 +3488,7 @@ void TBufferJSON::WriteFastArray(void *start, const TClass *cl, Long64_t n, TMem
          JsonWriteObject(obj, cl, kFALSE);
 
          if (indexes.IsArray() && (fValue.Length() > 0)) {
-            AppendOutput(fValue.Data());
+            fOutput->Append(fValue);
             fValue.Clear();
          }
       }
@@ -3521,7 +3543,7 @@ Int_t TBufferJSON::WriteFastArray(void **start, const TClass *cl, Long64_t n, Bo
       }
 
       if (indexes.IsArray() && (fValue.Length() > 0)) {
-         AppendOutput(fValue.Data());
+         fOutput->Append(fValue);
          fValue.Clear();
       }
    }
@@ -3888,9 +3910,7 @@ void TBufferJSON::WriteCharStar(char *s)
 
 void TBufferJSON::JsonWriteBasic(Char_t value)
 {
-   char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
-   fValue.Append(buf);
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3898,9 +3918,7 @@ void TBufferJSON::JsonWriteBasic(Char_t value)
 
 void TBufferJSON::JsonWriteBasic(Short_t value)
 {
-   char buf[50];
-   snprintf(buf, sizeof(buf), "%hd", value);
-   fValue.Append(buf);
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3908,9 +3926,7 @@ void TBufferJSON::JsonWriteBasic(Short_t value)
 
 void TBufferJSON::JsonWriteBasic(Int_t value)
 {
-   char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
-   fValue.Append(buf);
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3918,9 +3934,7 @@ void TBufferJSON::JsonWriteBasic(Int_t value)
 
 void TBufferJSON::JsonWriteBasic(Long_t value)
 {
-   char buf[50];
-   snprintf(buf, sizeof(buf), "%ld", value);
-   fValue.Append(buf);
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3928,7 +3942,7 @@ void TBufferJSON::JsonWriteBasic(Long_t value)
 
 void TBufferJSON::JsonWriteBasic(Long64_t value)
 {
-   fValue.Append(std::to_string(value).c_str());
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3976,9 +3990,7 @@ void TBufferJSON::JsonWriteBasic(Bool_t value)
 
 void TBufferJSON::JsonWriteBasic(UChar_t value)
 {
-   char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
-   fValue.Append(buf);
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3986,9 +3998,7 @@ void TBufferJSON::JsonWriteBasic(UChar_t value)
 
 void TBufferJSON::JsonWriteBasic(UShort_t value)
 {
-   char buf[50];
-   snprintf(buf, sizeof(buf), "%hu", value);
-   fValue.Append(buf);
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3996,9 +4006,7 @@ void TBufferJSON::JsonWriteBasic(UShort_t value)
 
 void TBufferJSON::JsonWriteBasic(UInt_t value)
 {
-   char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
-   fValue.Append(buf);
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4006,9 +4014,7 @@ void TBufferJSON::JsonWriteBasic(UInt_t value)
 
 void TBufferJSON::JsonWriteBasic(ULong_t value)
 {
-   char buf[50];
-   snprintf(buf, sizeof(buf), "%lu", value);
-   fValue.Append(buf);
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4016,7 +4022,7 @@ void TBufferJSON::JsonWriteBasic(ULong_t value)
 
 void TBufferJSON::JsonWriteBasic(ULong64_t value)
 {
-   fValue.Append(std::to_string(value).c_str());
+   AppendInteger(fValue, value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -16,9 +16,201 @@
 #include "TROOT.h"
 #include "TVirtualMutex.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace ROOT {
+namespace Internal {
+
+/// The serialised content of a TBufferMergerFile, waiting to be merged
+struct TBufferMergerBuffer {
+   std::unique_ptr<char[]> fData;
+   Long64_t fSize = 0;
+};
+
+/**
+ * Bounded lock-free multi-producer single-consumer queue of buffers, after D. Vyukov's bounded queue: every cell has
+ * a sequence number that tells whether it is free for the producer at a given position or filled for the consumer.
+ */
+class TBufferMergerQueue {
+   struct Cell {
+      std::atomic<std::size_t> fSequence{0};
+      TBufferMergerBuffer *fBuffer = nullptr;
+   };
+
+   std::unique_ptr<Cell[]> fCells;
+   std::size_t fMask = 0;
+   alignas(64) std::atomic<std::size_t> fEnqueuePos{0};
+   alignas(64) std::size_t fDequeuePos = 0; ///< Only used by the consumer
+
+public:
+   explicit TBufferMergerQueue(std::size_t capacity)
+   {
+      std::size_t size = 2;
+      while (size < capacity)
+         size *= 2;
+      fCells.reset(new Cell[size]);
+      fMask = size - 1;
+      for (std::size_t i = 0; i < size; ++i)
+         fCells[i].fSequence.store(i, std::memory_order_relaxed);
+   }
+
+   /// Returns false if the queue is full
+   bool TryPush(TBufferMergerBuffer *buffer)
+   {
+      std::size_t pos = fEnqueuePos.load(std::memory_order_relaxed);
+      Cell *cell;
+      while (true) {
+         cell = &fCells[pos & fMask];
+         const std::size_t seq = cell->fSequence.load(std::memory_order_acquire);
+         const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+         if (diff == 0) {
+            if (fEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+               break;
+         } else if (diff < 0) {
+            return false;
+         } else {
+            pos = fEnqueuePos.load(std::memory_order_relaxed);
+         }
+      }
+      cell->fBuffer = buffer;
+      cell->fSequence.store(pos + 1, std::memory_order_release);
+      return true;
+   }
+
+   /// Returns nullptr if the queue is empty; must only be called by the consumer thread
+   TBufferMergerBuffer *TryPop()
+   {
+      Cell &cell = fCells[fDequeuePos & fMask];
+      const std::size_t seq = cell.fSequence.load(std::memory_order_acquire);
+      if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(fDequeuePos + 1) < 0)
+         return nullptr;
+      auto buffer = cell.fBuffer;
+      cell.fSequence.store(fDequeuePos + fMask + 1, std::memory_order_release);
+      ++fDequeuePos;
+      return buffer;
+   }
+};
+
+/**
+ * The writer thread of a TBufferMerger in background merge mode. The producers only take a lock if they have to wait
+ * for memory or room in the queue, or to wake up the writer thread if it sleeps on an empty queue.
+ */
+class TBufferMergerWriter {
+public:
+   using Batch_t = std::vector<std::unique_ptr<TBufferMergerBuffer>>;
+
+private:
+   static constexpr std::size_t kMaxBatchSize = 64;
+
+   TBufferMergerQueue fQueue;
+   const std::size_t fMaxBuffered;
+   std::atomic<std::size_t> fBuffered{0};
+   std::atomic<std::size_t> fQueueSize{0};
+   std::atomic<bool> fSleeping{false};
+   std::atomic<bool> fStop{false};
+   std::atomic<int> fNWaiting{0};
+   std::mutex fMutex;
+   std::condition_variable fWakeWriter;
+   std::condition_variable fWakeProducers;
+   std::thread fThread;
+
+   void WakeWriter()
+   {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (fSleeping.load(std::memory_order_relaxed)) {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fWakeWriter.notify_one();
+      }
+   }
+
+   void Run(const std::function<void(Batch_t &)> &merge)
+   {
+      Batch_t batch;
+      while (true) {
+         while (batch.size() < kMaxBatchSize) {
+            auto buffer = fQueue.TryPop();
+            if (!buffer)
+               break;
+            batch.emplace_back(buffer);
+         }
+         if (batch.empty()) {
+            std::unique_lock<std::mutex> lock(fMutex);
+            fSleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            fWakeWriter.wait(lock, [this] { return fQueueSize.load() > 0 || fStop.load(); });
+            fSleeping.store(false, std::memory_order_relaxed);
+            if (fQueueSize.load() == 0 && fStop.load())
+               return;
+            continue;
+         }
+
+         std::size_t nbytes = 0;
+         for (const auto &buffer : batch)
+            nbytes += buffer->fSize;
+         fQueueSize -= batch.size();
+         merge(batch);
+         batch.clear();
+         fBuffered -= nbytes;
+         if (fNWaiting.load() > 0) {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fWakeProducers.notify_all();
+         }
+      }
+   }
+
+public:
+   TBufferMergerWriter(std::size_t maxBuffered, std::size_t queueCapacity, std::function<void(Batch_t &)> merge)
+      : fQueue(queueCapacity), fMaxBuffered(maxBuffered)
+   {
+      fThread = std::thread([this, merge] { Run(merge); });
+   }
+
+   /// Merges the buffers that are still queued
+   ~TBufferMergerWriter()
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fStop = true;
+         fWakeWriter.notify_one();
+      }
+      fThread.join();
+   }
+
+   void Push(std::unique_ptr<TBufferMergerBuffer> buffer)
+   {
+      const std::size_t size = buffer->fSize;
+      // Back-pressure: wait until the writer thread has caught up, unless nothing is buffered at all.
+      if (fBuffered.load() > 0 && fBuffered.load() + size > fMaxBuffered) {
+         std::unique_lock<std::mutex> lock(fMutex);
+         ++fNWaiting;
+         fWakeProducers.wait(lock, [&] { return fBuffered.load() == 0 || fBuffered.load() + size <= fMaxBuffered; });
+         --fNWaiting;
+      }
+      fBuffered += size;
+      // Count the buffer before it is visible to the writer thread, so that it never sees a negative size.
+      ++fQueueSize;
+      while (!fQueue.TryPush(buffer.get())) {
+         WakeWriter();
+         std::unique_lock<std::mutex> lock(fMutex);
+         ++fNWaiting;
+         fWakeProducers.wait_for(lock, std::chrono::milliseconds(1));
+         --fNWaiting;
+      }
+      buffer.release();
+      WakeWriter();
+   }
+
+   std::size_t GetQueueSize() const { return fQueueSize.load(); }
+   std::size_t GetBuffered() const { return fBuffered.load(); }
+};
+
+} // namespace Internal
 
 TBufferMerger::TBufferMerger(const char *name, Option_t *option, Int_t compress)
 {
@@ -46,6 +238,9 @@ TBufferMerger::~TBufferMerger()
    for (const auto &f : fAttachedFiles)
       if (!f.expired()) Fatal("TBufferMerger", " TBufferMergerFiles must be destroyed before the server");
 
+   // Merge the buffers still in the queue and stop the writer thread.
+   fWriter.reset();
+
    // Since we support purely incremental merging, Merge does not write the target objects
    // that are attached to the file (TTree and histograms) and thus we need to write them
    // now.
@@ -73,6 +268,46 @@ void TBufferMerger::SetMergeOptions(const TString& options)
    fMerger.SetMergeOptions(options);
 }
 
+void TBufferMerger::EnableBackgroundMerge(size_t maxBuffered, size_t queueCapacity)
+{
+   if (fWriter)
+      return;
+   if (!fAttachedFiles.empty()) {
+      Error("EnableBackgroundMerge", "must be called before the first call to GetFile()");
+      return;
+   }
+   auto merge = [this](Internal::TBufferMergerWriter::Batch_t &batch) {
+      // The buffers are only referenced by the TMemFiles, which are deleted by Reset().
+      for (const auto &buffer : batch) {
+         fMerger.AddAdoptFile(new TMemFile(fMerger.GetOutputFileName(),
+                                           TMemFile::ZeroCopyView_t(buffer->fData.get(), buffer->fSize)));
+      }
+      fMerger.PartialMerge(TFileMerger::kAll | TFileMerger::kIncremental | TFileMerger::kDelayWrite |
+                           TFileMerger::kKeepCompression);
+      fMerger.Reset();
+   };
+   fWriter = std::make_unique<Internal::TBufferMergerWriter>(maxBuffered, queueCapacity, merge);
+}
+
+size_t TBufferMerger::GetQueueSize() const
+{
+   return fWriter ? fWriter->GetQueueSize() : 0;
+}
+
+size_t TBufferMerger::GetBuffered() const
+{
+   return fWriter ? fWriter->GetBuffered() : 0;
+}
+
+void TBufferMerger::Push(ROOT::TBufferMergerFile *memfile)
+{
+   auto buffer = std::make_unique<Internal::TBufferMergerBuffer>();
+   buffer->fSize = memfile->GetSize();
+   buffer->fData.reset(new char[buffer->fSize]);
+   memfile->CopyTo(buffer->fData.get(), buffer->fSize);
+   fWriter->Push(std::move(buffer));
+}
+
 void TBufferMerger::Merge(ROOT::TBufferMergerFile *memfile)
 {
    std::lock_guard q(fMergeMutex);
@@ -28,6 +28,15 @@ TBufferMergerFile::~TBufferMergerFile()
 
 Int_t TBufferMergerFile::Write(const char *name, Int_t opt, Int_t bufsize)
 {
+   if (fMerger.IsBackgroundMerge()) {
+      // Serialise the whole file in this thread; the writer thread merges the copy.
+      Int_t nbytes = TMemFile::Write(name, opt, bufsize);
+      if (nbytes)
+         fMerger.Push(this);
+      ResetAfterMerge(0);
+      return nbytes;
+   }
+
    // Make sure the compression of the basket is done in the unlocked thread and
    // not in the locked section.
    if (!fMerger.GetNotrees())
@@ -32,10 +32,33 @@ actions list for both are the same.
 #include "TError.h"
 #include "snprintf.h"
 
+#include <charconv>
+#include <cstring>
+
 ClassImp(TBufferText);
 
 const char *TBufferText::fgFloatFmt = "%e";
 const char *TBufferText::fgDoubleFmt = "%.14e";
+Bool_t TBufferText::fgFloatShortest = kFALSE;
+Bool_t TBufferText::fgDoubleShortest = kFALSE;
+
+namespace {
+
+/// Write shortest representation of the value, which is read back to exactly the same value
+template <typename T>
+const char *ConvertShortest(T value, char *buf, unsigned len)
+{
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+   auto res = std::to_chars(buf, buf + len - 1, value);
+   *res.ptr = 0;
+#else
+   // round-trip precision, but not necessarily shortest
+   snprintf(buf, len, (sizeof(T) == sizeof(float)) ? "%.9g" : "%.17g", value);
+#endif
+   return buf;
+}
+
+} // namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
@@ -794,6 +817,9 @@ void TBufferText::CompactFloatString(char *sbuf, unsigned len)
 ////////////////////////////////////////////////////////////////////////////////
 /// set printf format for float/double members, default "%e"
 /// to change format only for doubles, use SetDoubleFormat
+///
+/// Special format "shortest" selects the shortest representation which reads back to
+/// exactly the same value (like "0.1" or "1e-07"); it is considerably faster than printf
 
 void TBufferText::SetFloatFormat(const char *fmt)
 {
@@ -801,6 +827,7 @@ void TBufferText::SetFloatFormat(const char *fmt)
       fmt = "%e";
    fgFloatFmt = fmt;
    fgDoubleFmt = fmt;
+   fgFloatShortest = fgDoubleShortest = (strcmp(fmt, "shortest") == 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -820,6 +847,7 @@ void TBufferText::SetDoubleFormat(const char *fmt)
    if (!fmt)
       fmt = "%.14e";
    fgDoubleFmt = fmt;
+   fgDoubleShortest = (strcmp(fmt, "shortest") == 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -835,7 +863,9 @@ const char *TBufferText::GetDoubleFormat()
 
 const char *TBufferText::ConvertFloat(Float_t value, char *buf, unsigned len, Bool_t not_optimize)
 {
-   if (not_optimize) {
+   if (fgFloatShortest) {
+      ConvertShortest(value, buf, len);
+   } else if (not_optimize) {
       snprintf(buf, len, fgFloatFmt, value);
    } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e15)) {
       snprintf(buf, len, "%1.0f", value);
@@ -851,7 +881,9 @@ const char *TBufferText::ConvertFloat(Float_t value, char *buf, unsigned len, Bo
 
 const char *TBufferText::ConvertDouble(Double_t value, char *buf, unsigned len, Bool_t not_optimize)
 {
-   if (not_optimize) {
+   if (fgDoubleShortest) {
+      ConvertShortest(value, buf, len);
+   } else if (not_optimize) {
       snprintf(buf, len, fgFloatFmt, value);
    } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e25)) {
       snprintf(buf, len, "%1.0f", value);
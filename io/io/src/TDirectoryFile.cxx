@@ -21,9 +21,21 @@ Begin_Macro
 ../../../tutorials/io/fildir.C
 End_Macro
  The structure of a file is shown in TFile::TFile
+
+ When a directory is read, the keys of all its objects are read and
+ unstreamed as TKey objects. For files with a very large number of keys,
+ TDirectoryFile::SetLazyKeys() keeps the key list record as a compact
+ index instead, sorted by the hash of the key names, and creates the
+ TKey objects only for the names that are looked up with Get(), GetKey()
+ or FindKey(). Any other operation that needs the list of keys, e.g.
+ GetListOfKeys() or writing to the directory, creates all remaining keys.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <mutex>
+#include <vector>
 #include "Strlen.h"
 #include "strlcpy.h"
 #include "TDirectoryFile.h"
@@ -52,6 +64,55 @@ End_Macro
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
 
+namespace {
+std::atomic<Bool_t> gLazyKeys{kFALSE};
+/// Serializes the creation of the TKey objects from the key indices of all directories
+std::mutex gKeyIndexMutex;
+/// The bits of TKey::fSeekPdir that hold the location of the directory, see TKey::ReadKeyBuffer()
+const ULong64_t kSeekPdirMask = 0xffffffffffffULL;
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+/// The key list record of a directory read with TDirectoryFile::SetLazyKeys(),
+/// with the location of every key in it.
+struct RKeyIndex {
+   struct REntry {
+      UInt_t fNameHash{0};  ///< TString::Hash() of the key name
+      Int_t fOffset{0};     ///< Location of the key in fBuffer
+      Int_t fClassName{0};  ///< Location of the class name of the key in fBuffer
+      TKey *fKey{nullptr};  ///< The key, once it was looked up
+   };
+   std::vector<char> fBuffer;    ///< The keys as stored on file
+   std::vector<REntry> fEntries; ///< Sorted by name hash, in the order of the keys on file for equal hashes
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+namespace {
+/// Skip a string written by TString::FillBuffer() and return its characters; `end` is the end of the buffer.
+/// Returns nullptr if the string does not fit in the buffer.
+const char *SkipKeyString(char *&buffer, const char *end, Int_t &len)
+{
+   if (buffer >= end)
+      return nullptr;
+   UChar_t nwh = *buffer++;
+   len = nwh;
+   if (nwh == 255) {
+      if (end - buffer < (Long64_t)sizeof(Int_t))
+         return nullptr;
+      frombuf(buffer, &len);
+   }
+   if (len < 0 || end - buffer < len)
+      return nullptr;
+   const char *chars = buffer;
+   buffer += len;
+   return chars;
+}
+} // anonymous namespace
+
 ClassImp(TDirectoryFile);
 
 
@@ -177,6 +238,7 @@ void TDirectoryFile::InitDirectoryFile(TClass *cl)
 
 TDirectoryFile::~TDirectoryFile()
 {
+   DropKeyIndex();
    if (fKeys) {
       fKeys->Delete("slow");
       SafeDelete(fKeys);
@@ -230,6 +292,7 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
       return 0;
    }
 
+   ExpandKeyIndex();
    fModified = kTRUE;
 
    key->SetMotherDir(this);
@@ -263,6 +326,7 @@ void TDirectoryFile::Browse(TBrowser *b)
    TString name;
 
    if (b) {
+      ExpandKeyIndex();
       TObject *obj = nullptr;
       TIter nextin(fList);
       TKey *key = nullptr, *keyo = nullptr;
@@ -588,6 +652,7 @@ void TDirectoryFile::Close(Option_t *option)
    }
 
    // Delete keys from key list (but don't delete the list header)
+   DropKeyIndex();
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -974,6 +1039,14 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
+   if (fKeyIndex) {
+      TKey *key = FindKeyInIndex(namobj, cycle, kTRUE);
+      if (!key)
+         return nullptr;
+      TDirectory::TContext ctxt(this);
+      return key->ReadObj();
+   }
+
    auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
    if (!listOfKeys) {
       Error("Get", "Unexpected type of TDirectoryFile::fKeys!");
@@ -1097,6 +1170,14 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
+   if (fKeyIndex) {
+      TKey *key = FindKeyInIndex(namobj, cycle, kTRUE);
+      if (!key)
+         return nullptr;
+      TDirectory::TContext ctxt(this);
+      return key->ReadObjectAny(expectedClass);
+   }
+
    auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
    if (!listOfKeys) {
       Error("GetObjectChecked", "Unexpected type of TDirectoryFile::fKeys!");
@@ -1138,6 +1219,9 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 {
    if (!fKeys) return nullptr;
 
+   if (fKeyIndex)
+      return FindKeyInIndex(name, cycle, kFALSE);
+
    auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
    if (!listOfKeys) {
       Error("GetKey", "Unexpected type of TDirectoryFile::fKeys!");
@@ -1156,6 +1240,22 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of this directory.
+
+Int_t TDirectoryFile::GetNkeys() const
+{
+   return fKeys->GetSize() + (fKeyIndex ? (Int_t)fKeyIndex->fEntries.size() : 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Whether the keys of the directories read from now on are indexed lazily.
+
+Bool_t TDirectoryFile::GetLazyKeys()
+{
+   return gLazyKeys;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// List Directory contents
 ///
@@ -1208,6 +1308,7 @@ void TDirectoryFile::ls(Option_t *option) const
    }
 
    if (diskobj && fKeys) {
+      ExpandKeyIndex();
       //*-* Loop on all the keys
       for (TObjLink *lnk = fKeys->FirstLink(); lnk != nullptr; lnk = lnk->Next()) {
          TKey *key = (TKey*)lnk->GetObject();
@@ -1387,7 +1488,10 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
    TDirectory::TContext ctxt(this);
 
    char *buffer;
+   if (!forceRead)
+      ExpandKeyIndex();
    if (forceRead) {
+      DropKeyIndex();
       fKeys->Delete();
       //In case directory was updated by another process, read new
       //position for the keys
@@ -1430,6 +1534,12 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
       TKey *key;
       frombuf(buffer, &nkeys);
+      if (GetLazyKeys() && fKeys->IsEmpty()) {
+         // Delete the header key before the index exists, as the key destructor accesses the list of keys.
+         std::vector<char> keys(buffer, headerkey->GetBuffer() + fNbytesKeys);
+         delete headerkey;
+         return BuildKeyIndex(std::move(keys), nkeys, fsize);
+      }
       for (Int_t i = 0; i < nkeys; i++) {
          key = new TKey(this);
          key->ReadKeyBuffer(buffer);
@@ -1453,6 +1563,168 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
    return nkeys;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Index the `nkeys` keys of the key list record `keys`, which starts after the
+/// number of keys, without creating the TKey objects. Returns the number of keys
+/// indexed, which is smaller than `nkeys` if an illegal key was found.
+
+Int_t TDirectoryFile::BuildKeyIndex(std::vector<char> &&keys, Int_t nkeys, Long64_t fsize)
+{
+   auto index = std::make_unique<ROOT::Internal::RKeyIndex>();
+   index->fBuffer = std::move(keys);
+   index->fEntries.reserve(nkeys);
+   char *begin = index->fBuffer.data();
+   const char *end = begin + index->fBuffer.size();
+   char *buffer = begin;
+   // Size of the key header up to fSeekKey, see TKey::ReadKeyBuffer()
+   constexpr Long64_t kFixedLen = 2 * sizeof(Int_t) + sizeof(UInt_t) + 3 * sizeof(Short_t);
+
+   for (Int_t i = 0; i < nkeys; i++) {
+      ROOT::Internal::RKeyIndex::REntry entry;
+      entry.fOffset = buffer - begin;
+      Long64_t seekKey = 0, seekPdir = 0;
+      Version_t keyVersion = 0;
+      Bool_t legal = (end - buffer >= kFixedLen);
+      if (legal) {
+         char *version = buffer + sizeof(Int_t);
+         frombuf(version, &keyVersion);
+         buffer += kFixedLen;
+         const Long64_t seekLen = (keyVersion > 1000) ? 2 * sizeof(Long64_t) : 2 * sizeof(UInt_t);
+         legal = (end - buffer >= seekLen);
+      }
+      if (legal) {
+         if (keyVersion > 1000) {
+            frombuf(buffer, &seekKey);
+            frombuf(buffer, &seekPdir);
+            seekPdir &= kSeekPdirMask;
+         } else {
+            UInt_t seekkey, seekdir;
+            frombuf(buffer, &seekkey); seekKey = seekkey;
+            frombuf(buffer, &seekdir); seekPdir = seekdir;
+         }
+         legal = seekKey >= 64 && seekKey <= fsize && seekPdir >= 64 && seekPdir <= fsize;
+      }
+      Int_t len = 0;
+      const char *name = nullptr;
+      if (legal) {
+         entry.fClassName = buffer - begin;
+         legal = SkipKeyString(buffer, end, len) && (name = SkipKeyString(buffer, end, len));
+      }
+      if (legal) {
+         entry.fNameHash = TString::Hash(name, len);
+         Int_t titleLen;
+         legal = SkipKeyString(buffer, end, titleLen);
+      }
+      if (!legal) {
+         Error("ReadKeys","reading illegal key, exiting after %d keys",i);
+         nkeys = i;
+         break;
+      }
+      index->fEntries.emplace_back(entry);
+   }
+
+   std::stable_sort(index->fEntries.begin(), index->fEntries.end(),
+                    [](const auto &a, const auto &b) { return a.fNameHash < b.fNameHash; });
+   fKeyIndex = std::move(index);
+   return nkeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of the given class, without creating the TKey
+/// objects of a lazily read directory.
+
+Int_t TDirectoryFile::CountKeysOfClass(const char *classname) const
+{
+   Int_t n = 0;
+   if (fKeys) {
+      TIter next(fKeys);
+      while (auto key = static_cast<TKey *>(next())) {
+         if (!strcmp(key->GetClassName(), classname))
+            ++n;
+      }
+   }
+   if (fKeyIndex) {
+      TString name;
+      for (const auto &entry : fKeyIndex->fEntries) {
+         char *buffer = fKeyIndex->fBuffer.data() + entry.fClassName;
+         name.ReadBuffer(buffer);
+         // As in TKey::ReadKeyBuffer()
+         if (name == "TDirectory")
+            name = "TDirectoryFile";
+         if (name == classname)
+            ++n;
+      }
+   }
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the index of a lazily read directory and the keys created from it.
+
+void TDirectoryFile::DropKeyIndex()
+{
+   // The TKey destructor accesses the list of keys, which must not expand the index.
+   auto index = std::move(fKeyIndex);
+   if (!index)
+      return;
+   for (auto &entry : index->fEntries)
+      delete entry.fKey;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the remaining keys of a lazily read directory and move all of them to
+/// the list of keys, in the order of the keys on file.
+
+void TDirectoryFile::ExpandKeyIndex() const
+{
+   if (!fKeyIndex)
+      return;
+   auto index = std::move(fKeyIndex);
+   auto &entries = index->fEntries;
+   std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) { return a.fOffset < b.fOffset; });
+   for (auto &entry : entries) {
+      if (!entry.fKey) {
+         entry.fKey = new TKey(const_cast<TDirectoryFile *>(this));
+         char *buffer = index->fBuffer.data() + entry.fOffset;
+         entry.fKey->ReadKeyBuffer(buffer);
+      }
+      fKeys->Add(entry.fKey);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key with the given name in the index of a lazily read directory,
+/// creating the TKey objects of the keys with the same name hash. As in Get(),
+/// if `exactCycle` is true and the cycle is not 9999 the key must have the given
+/// cycle; otherwise, as in GetKey(), the first key with a cycle not larger than
+/// the given one is returned.
+///
+/// The lookup can be done concurrently for several directories, or for the same
+/// directory, as long as no other operation modifies them.
+
+TKey *TDirectoryFile::FindKeyInIndex(const char *name, Short_t cycle, Bool_t exactCycle) const
+{
+   auto &entries = fKeyIndex->fEntries;
+   const UInt_t hash = TString::Hash(name, strlen(name));
+   auto first = std::lower_bound(entries.begin(), entries.end(), hash,
+                                 [](const auto &entry, UInt_t h) { return entry.fNameHash < h; });
+
+   std::lock_guard<std::mutex> lock(gKeyIndexMutex);
+   for (auto it = first; it != entries.end() && it->fNameHash == hash; ++it) {
+      if (!it->fKey) {
+         it->fKey = new TKey(const_cast<TDirectoryFile *>(this));
+         char *buffer = fKeyIndex->fBuffer.data() + it->fOffset;
+         it->fKey->ReadKeyBuffer(buffer);
+      }
+      TKey *key = it->fKey;
+      if (strcmp(key->GetName(), name))
+         continue;
+      if (cycle == 9999 || (exactCycle ? cycle == key->GetCycle() : cycle >= key->GetCycle()))
+         return key;
+   }
+   return nullptr;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Read object with keyname from the current directory
@@ -1507,6 +1779,7 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    fSeekParent = 0; // updated by Init
    fSeekKeys = 0;   // updated by Init
    // Does not change: fFile
+   ExpandKeyIndex();
    TKey *key = fKeys ? (TKey*)fKeys->FindObject(fName) : nullptr;
    TClass *cl = IsA();
    if (key) {
@@ -1653,6 +1926,25 @@ void TDirectoryFile::SetBufferSize(Int_t bufsize)
    fBufferSize = bufsize;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set whether the keys of the directories read from now on are indexed lazily.
+///
+/// By default, reading a directory creates a TKey object for every key. With lazy
+/// keys, the key list record of the directory is kept in memory as read, with a
+/// small index sorted by the hash of the key names, and the TKey objects are only
+/// created by Get(), GetObjectChecked(), GetKey() and FindKey() for the names that
+/// are looked up. This considerably reduces the time and memory needed to open a
+/// file with a large number of keys, if only a few of them are needed. Any other
+/// access to the list of keys, e.g. GetListOfKeys(), creates the remaining keys.
+///
+/// The lookup of keys in lazily read directories is thread-safe. Reading the
+/// objects still requires the usual protection of the TFile they belong to.
+
+void TDirectoryFile::SetLazyKeys(Bool_t lazy)
+{
+   gLazyKeys = lazy;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Find the action to be executed in the dictionary of the parent class
 /// and store the corresponding exec number into fBits.
@@ -1910,6 +2202,7 @@ Int_t TDirectoryFile::Write(const char *n, Int_t opt, Int_t bufsize) const
 Int_t TDirectoryFile::WriteTObject(const TObject *obj, const char *name, Option_t *option, Int_t bufsize)
 {
    TDirectory::TContext ctxt(this);
+   ExpandKeyIndex();
 
    if (fFile==0) {
       const char *objname = "no name specified";
@@ -2050,6 +2343,7 @@ Int_t TDirectoryFile::WriteObjectAny(const void *obj, const char *classname, con
 Int_t TDirectoryFile::WriteObjectAny(const void *obj, const TClass *cl, const char *name, Option_t *option, Int_t bufsize)
 {
    TDirectory::TContext ctxt(this);
+   ExpandKeyIndex();
 
    if (!fFile) return 0;
 
@@ -2178,6 +2472,8 @@ void TDirectoryFile::WriteKeys()
       return;
    }
 
+   ExpandKeyIndex();
+
 //*-* Delete the old keys structure if it exists
    if (fSeekKeys != 0) {
       f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
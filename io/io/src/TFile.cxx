@@ -95,6 +95,8 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include <sys/stat.h>
 #ifndef WIN32
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
 #ifndef R__FBSD
 #include <sys/xattr.h>
 #endif
@@ -107,6 +109,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "Bytes.h"
 #include "Compression.h"
 #include "RConfigure.h"
+#include "RZip.h"
 #include "Strlen.h"
 #include "strlcpy.h"
 #include "snprintf.h"
@@ -143,14 +146,19 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TObjString.h"
 #include "TStopwatch.h"
 #include "compiledata.h"
+#include <climits>
 #include <cmath>
 #include <iostream>
 #include <set>
+#include <vector>
 #include "TSchemaRule.h"
 #include "TSchemaRuleSet.h"
 #include "TThreadSlots.h"
 #include "TGlobal.h"
 #include "ROOT/RConcurrentHashColl.hxx"
+#ifndef WIN32
+#include "ROOT/RFileBlockCache.hxx"
+#endif
 #include <memory>
 
 #ifdef R__FBSD
@@ -230,6 +238,7 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
 /// RECREATE                          | Create a new file, if the file already exists it will be overwritten.
 /// UPDATE                            | Open an existing file for writing. If no file exists, it is created.
 /// READ                              | Open an existing file for reading (default).
+/// MMAP                              | Open an existing local file for reading through a read-only shared memory mapping.
 /// NET                               | Used by derived remote file access classes, not a user callable option.
 /// WEB                               | Used by derived remote http access class, not a user callable option.
 /// READ_WITHOUT_GLOBALREGISTRATION   | Used by TTreeProcessorMT, not a user callable option.
@@ -422,6 +431,12 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
       }
    }
 
+   Bool_t mmap = kFALSE;
+   if (fOption == "MMAP") {
+      fOption = "READ";
+      mmap = kTRUE;
+   }
+
    if (fOption == "NET")
       return;
 
@@ -552,6 +567,8 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
          return;
       }
       fWritable = kFALSE;
+      if (mmap)
+         MapFile();
    }
 
    // calling virtual methods from constructor not a good idea, but it is how code was developed
@@ -897,7 +914,7 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                // #14068: we take into account the different way of expressing the version
                const auto separator = fVersion < 63200 ? "/" : ".";
                const auto thisVersion = gROOT->GetVersionInt();
@@ -915,11 +932,7 @@ void TFile::Init(Bool_t create)
 
    // Count number of TProcessIDs in this file
    {
-      TIter next(fKeys);
-      TKey *key;
-      while ((key = (TKey*)next())) {
-         if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
-      }
+      fNProcessIDs += CountKeysOfClass("TProcessID");
       fProcessIDs = new TObjArray(fNProcessIDs+1);
    }
 
@@ -958,6 +971,7 @@ void TFile::Close(Option_t *option)
 
    if (fIsArchive || !fIsRootFile) {
       FlushWriteCache();
+      UnmapFile();
       SysClose(fD);
       fD = -1;
 
@@ -1012,6 +1026,7 @@ void TFile::Close(Option_t *option)
       fFree->Delete();
    }
 
+   UnmapFile();
    if (IsOpen()) {
       SysClose(fD);
       fD = -1;
@@ -1734,6 +1749,9 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
          return kFALSE;
       }
 
+      if (fMapAddress && CopyFromMap(buf, pos, len))
+         return kFALSE;
+
       Seek(pos);
       ssize_t siz;
 
@@ -1779,6 +1797,9 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
          return kFALSE;
       }
 
+      if (fMapAddress && CopyFromMap(buf, GetRelOffset(), len))
+         return kFALSE;
+
       ssize_t siz;
       Double_t start = 0;
 
@@ -1817,6 +1838,8 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
 /// The value pos[i] is the seek position of block i of length len[i].
 /// Note that for nbuf=1, this call is equivalent to TFile::ReafBuffer.
 /// This function is overloaded by TNetFile, TWebFile, etc.
+/// For local files, blocks closer than the read-ahead size are merged and each
+/// merged range is read with a single scatter read (preadv) directly into buf.
 /// Returns kTRUE in case of failure.
 
 Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
@@ -1831,6 +1854,25 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   if (fMapAddress) {
+      TFileCacheRead *old = fCacheRead;
+      fCacheRead = nullptr;
+      Long64_t k = 0;
+      Bool_t result = kFALSE;
+      for (Int_t i = 0; i < nbuf && !result; k += len[i], ++i) {
+         if (!CopyFromMap(&buf[k], pos[i], len[i]))
+            result = ReadBuffer(&buf[k], pos[i], len[i]);
+      }
+      fCacheRead = old;
+      return result;
+   }
+
+#if defined(R__LINUX) || defined(R__FBSD)
+   // Derived classes may reimplement the Sys* functions, only use the file descriptor directly for plain files.
+   if (IsA() == TFile::Class() && fD >= 0 && nbuf > 1)
+      return ReadBuffersVectored(buf, pos, len, nbuf);
+#endif
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1881,6 +1923,171 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of ReadBuffers() for local files.
+///
+/// The blocks are merged into ranges as long as the gaps between them are
+/// smaller than the read-ahead size. Every range is read with one preadv()
+/// call that scatters the blocks into their place in buf and the gaps into a
+/// scratch buffer, so neither a seek nor a copy is needed. A block that starts
+/// before the end of the previous one starts a new range. Returns kTRUE in case of failure.
+
+Bool_t TFile::ReadBuffersVectored(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+#if defined(R__LINUX) || defined(R__FBSD)
+   if (!IsOpen())
+      return kTRUE;
+
+   Double_t start = 0;
+   if (gPerfStats) start = TTimeStamp();
+
+   const Long64_t maxGap = fgReadaheadSize;
+   std::vector<char> scratch;
+   std::vector<struct iovec> iov;
+   iov.reserve(std::min(2 * nbuf, IOV_MAX));
+
+   Long64_t k = 0;
+   Int_t i = 0;
+   while (i < nbuf) {
+      // Collect the blocks of one range
+      iov.clear();
+      const Long64_t begin = pos[i];
+      Long64_t end = begin;
+      Long64_t nbytes = 0;
+      Long64_t ngap = 0;
+      while (i < nbuf && static_cast<int>(iov.size()) + 2 <= IOV_MAX) {
+         const Long64_t gap = pos[i] - end;
+         if (gap < 0 || (gap > maxGap && !iov.empty()))
+            break;
+         if (gap > 0) {
+            if (static_cast<Long64_t>(scratch.size()) < gap)
+               scratch.resize(gap);
+            iov.push_back({scratch.data(), static_cast<size_t>(gap)});
+            ngap += gap;
+         }
+         iov.push_back({&buf[k + nbytes], static_cast<size_t>(len[i])});
+         nbytes += len[i];
+         end = pos[i] + len[i];
+         i++;
+      }
+
+      // Read the range, resuming after short reads
+      Long64_t offset = begin + fArchiveOffset;
+      std::size_t first = 0;
+      while (first < iov.size()) {
+         auto siz = preadv(fD, &iov[first], static_cast<int>(std::min<std::size_t>(iov.size() - first, IOV_MAX)), offset);
+         if (siz < 0 && errno == EINTR)
+            continue;
+         if (siz <= 0) {
+            if (siz < 0)
+               SysError("ReadBuffers", "error reading from file %s", GetName());
+            else
+               Error("ReadBuffers", "error reading all requested bytes from file %s at offset %lld", GetName(), offset);
+            return kTRUE;
+         }
+         fReadCalls++;
+         fgReadCalls++;
+         offset += siz;
+         while (first < iov.size() && static_cast<size_t>(siz) >= iov[first].iov_len) {
+            siz -= iov[first].iov_len;
+            first++;
+         }
+         if (siz > 0) {
+            iov[first].iov_base = static_cast<char *>(iov[first].iov_base) + siz;
+            iov[first].iov_len -= siz;
+         }
+      }
+
+      k += nbytes;
+      fBytesRead += nbytes;
+      fgBytesRead += nbytes;
+      fBytesReadExtra += ngap;
+   }
+   // Leave the file offset where the sequential implementation would have left it
+   Seek(pos[nbuf - 1] + len[nbuf - 1]);
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats)
+      gPerfStats->FileReadEvent(this, static_cast<Int_t>(k), start);
+   return kFALSE;
+#else
+   (void)buf;
+   (void)pos;
+   (void)len;
+   (void)nbuf;
+   return kTRUE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy len bytes at position pos from the memory mapping of the file.
+/// Returns kFALSE, and leaves it to the caller to read the file, if the
+/// range is not fully inside the mapping, e.g. because the file grew.
+
+Bool_t TFile::CopyFromMap(char *buf, Long64_t pos, Int_t len)
+{
+   const Long64_t off = pos + fArchiveOffset;
+   if (off < 0 || len < 0 || off + len > fMapSize)
+      return kFALSE;
+
+   Double_t start = 0;
+   if (gPerfStats) start = TTimeStamp();
+   memcpy(buf, fMapAddress + off, len);
+   fOffset = off + len;
+   fBytesRead  += len;
+   fgBytesRead += len;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats)
+      gPerfStats->FileReadEvent(this, len, start);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Map the file read-only into memory, for the MMAP option.
+///
+/// All the processes mapping the same file share the pages of the operating
+/// system page cache, so no per-process read buffers are needed and pages are
+/// only loaded when they are touched. If the file cannot be mapped, it is read
+/// normally.
+
+void TFile::MapFile()
+{
+#ifndef WIN32
+   Long_t id, flags, modtime;
+   Long64_t size = 0;
+   if (SysStat(fD, &id, &size, &flags, &modtime) || size <= 0) {
+      Warning("TFile", "cannot map empty or unreadable file %s, reading the file instead", GetName());
+      return;
+   }
+   void *addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fD, 0);
+   if (addr == MAP_FAILED) {
+      Warning("TFile", "cannot map file %s (%s), reading the file instead", GetName(), strerror(errno));
+      return;
+   }
+   fMapAddress = static_cast<char *>(addr);
+   fMapSize = size;
+#else
+   Warning("TFile", "memory mapped files are not supported on Windows, reading %s instead", GetName());
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the memory mapping created by MapFile(), if any.
+
+void TFile::UnmapFile()
+{
+   if (!fMapAddress)
+      return;
+#ifndef WIN32
+   ::munmap(fMapAddress, fMapSize);
+#endif
+   fMapAddress = nullptr;
+   fMapSize = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read buffer via cache.
 ///
@@ -2220,6 +2427,7 @@ Int_t TFile::ReOpen(Option_t *mode)
       // switch to UPDATE mode
 
       // close readonly file
+      UnmapFile();
       if (IsOpen()) {
          SysClose(fD);
          fD = -1;
@@ -3605,7 +3813,9 @@ Int_t TFile::MakeProjectParProofInf(const char *pack, const char *proofinf)
 
 void TFile::ReadStreamerInfo()
 {
-   auto listRetcode = GetStreamerInfoListImpl(/*lookupSICache*/ true);  // NOLINT: silence clang-tidy warnings
+   // A file opened for update needs its own copy of the compression dictionaries
+   // to write them again, so it cannot skip a record that was already read.
+   auto listRetcode = GetStreamerInfoListImpl(/*lookupSICache*/ !fWritable);  // NOLINT: silence clang-tidy warnings
    TList *list = listRetcode.fList;
    auto retcode = listRetcode.fReturnCode;
    if (!list) {
@@ -3662,7 +3872,20 @@ void TFile::ReadStreamerInfo()
          if (info->IsA() != TStreamerInfo::Class()) {
             if (mode==1) {
                TObject *obj = (TObject*)info;
-               if (strcmp(obj->GetName(),"listOfRules")==0) {
+               if (strcmp(obj->GetName(),"listOfZipDictionaries")==0) {
+                  // Make the dictionaries available to R__unzip before any data is read.
+                  TObjLink *dictlnk = ((TList*)obj)->FirstLink();
+                  while (dictlnk) {
+                     const TString &dict = ((TObjString*)dictlnk->GetObject())->String();
+                     UInt_t dictID = R__registerZipDictionary(dict.Data(), dict.Length());
+                     if (dictID)
+                        fZipDictionaries[dictID] = std::string(dict.Data(), dict.Length());
+                     else
+                        Warning("ReadStreamerInfo", "%s has an invalid compression dictionary.", GetName());
+                     dictlnk = dictlnk->Next();
+                  }
+                  ((TList*)obj)->SetOwner(kTRUE);
+               } else if (strcmp(obj->GetName(),"listOfRules")==0) {
 #if 0
                   // Completely ignore the rules for now.
                   TList *listOfRules = (TList*)obj;
@@ -3850,6 +4073,19 @@ void TFile::WriteStreamerInfo()
       list.Add(&listOfRules);
    }
 
+   // The compression dictionaries are stored with the StreamerInfo so that
+   // they are known before any data is read.
+   TList listOfZipDictionaries;
+   listOfZipDictionaries.SetOwner(kTRUE);
+   listOfZipDictionaries.SetName("listOfZipDictionaries");
+   for (const auto &dict : fZipDictionaries) {
+      TObjString *obj = new TObjString();
+      obj->String() = TString(dict.second.data(), dict.second.size());
+      listOfZipDictionaries.Add(obj);
+   }
+   if (listOfZipDictionaries.GetEntries())
+      list.Add(&listOfZipDictionaries);
+
    //free previous StreamerInfo record
    if (fSeekInfo) MakeFree(fSeekInfo,fSeekInfo+fNbytesInfo-1);
    //Create new key
@@ -3862,9 +4098,28 @@ void TFile::WriteStreamerInfo()
 
    fClassIndex->fArray[0] = 0;
 
+   list.Remove(&listOfZipDictionaries);
    list.RemoveLast(); // remove the listOfRules.
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record that data in this file is compressed with the given dictionary.
+///
+/// The dictionaries are written with the StreamerInfo record and registered
+/// with R__registerZipDictionary when the file is opened, so that R__unzip
+/// can decompress the data. This is used by TBasket for the
+/// ROOT::RCompressionSetting::EAlgorithm::kZSTDDict algorithm.
+
+void TFile::AddZipDictionary(UInt_t dictID, const std::string &dict)
+{
+   if (dictID == 0 || fZipDictionaries.count(dictID))
+      return;
+   fZipDictionaries[dictID] = dict;
+   // Make sure that the StreamerInfo record is written again.
+   if (fClassIndex && fClassIndex->fArray[0] != 2)
+      fClassIndex->fArray[0] = 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Open a file for reading through the file cache.
 ///
@@ -4649,6 +4904,42 @@ Bool_t TFile::SetCacheFileDir(std::string_view cachedir, Bool_t operatedisconnec
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sets the directory of the block cache of remote files, shared by the
+/// processes of the node. Contrary to SetCacheFileDir(), only the blocks of
+/// blockSize bytes that are actually read are stored, up to budget bytes in
+/// total; see ROOT::Internal::RFileBlockCache. An empty directory disables
+/// the cache. It applies to the remote files opened afterwards that support it
+/// (TNetXNGFile and the RRawFile of RNTuple).
+/// Returns kFALSE if the directory is not usable or the platform is not supported.
+
+Bool_t TFile::SetBlockCacheDir(std::string_view cacheDir, Long64_t budget, Int_t blockSize)
+{
+#ifdef WIN32
+   (void)cacheDir;
+   (void)budget;
+   (void)blockSize;
+   ::Error("TFile::SetBlockCacheDir", "the block cache is not supported on Windows");
+   return kFALSE;
+#else
+   TString cached{cacheDir};
+   if (!cached.IsNull()) {
+      gSystem->mkdir(cached, kTRUE);
+      if (gSystem->AccessPathName(cached, kWritePermission)) {
+         ::Error("TFile::SetBlockCacheDir", "no sufficient permissions on cache directory %s or cannot create it",
+                 cached.Data());
+         return kFALSE;
+      }
+   }
+   if (budget <= 0 || blockSize <= 0) {
+      ::Error("TFile::SetBlockCacheDir", "the budget and the block size must be positive");
+      return kFALSE;
+   }
+   ROOT::Internal::RFileBlockCache::Configure(cached.Data(), budget, blockSize);
+   return kTRUE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get the directory where to locally stage/cache remote files.
 
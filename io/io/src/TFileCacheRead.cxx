@@ -23,6 +23,12 @@
  TNetXNGFile and TWebFile (via TFile::ReadBuffers()).
  When processing TTree, TChain, a specialized class TTreeCache that
  derives from this class is automatically created.
+
+ Blocks that are adjacent on file are read with a single request. With
+ SetMaxGap() (or the rootrc variable `TFileCacheRead.MaxGap`), blocks that are
+ separated by at most the given number of bytes are also read together; the
+ bytes in between are read and discarded, trading bandwidth for fewer requests
+ on high-latency storage.
 */
 
 #include "TEnv.h"
@@ -85,6 +91,7 @@ TFileCacheRead::TFileCacheRead() : TObject()
    fEnablePrefetching = kFALSE;
    fPrefetch        = 0;
    fPrefetchedBlocks= 0;
+   fMaxGap          = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -134,6 +141,8 @@ TFileCacheRead::TFileCacheRead(TFile *file, Int_t buffersize, TObject *tree)
    fBuffer = 0;
    fPrefetch = 0;
    fPrefetchedBlocks = 0;
+   fMaxGap = gEnv->GetValue("TFileCacheRead.MaxGap", 0);
+   if (fMaxGap < 0) fMaxGap = 0;
 
    //initialise the prefetch object and set the cache directory
    // start the thread only if the file is not local
@@ -567,7 +576,8 @@ void TFileCacheRead::SetFile(TFile *file, TFile::ECacheAction action)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Sort buffers to be prefetched in increasing order of positions.
-/// Merge consecutive blocks if necessary.
+/// Merge consecutive blocks, or blocks separated by at most fMaxGap bytes,
+/// if necessary.
 
 void TFileCacheRead::Sort()
 {
@@ -591,32 +601,39 @@ void TFileCacheRead::Sort()
       ++effectiveNseek;
    }
    fNseek = effectiveNseek;
-   if (fNtot > fBufferSizeMin) {
-      fBufferSize = fNtot + 100;
-      delete [] fBuffer;
-      fBuffer = 0;
-      // If ReadBufferAsync is not supported by this implementation
-      // it means that we are using sync primitives, hence we need the local buffer
-      if (!fAsyncReading)
-         fBuffer = new char[fBufferSize];
-   }
+   // Blocks separated by at most fMaxGap bytes are merged into the same long
+   // buffer; the gap is read along and skipped, so fSeekPos accounts for it.
+   Int_t start = 0; // position of the current long buffer in fBuffer
    fPos[0]  = fSeekSort[0];
    fLen[0]  = fSeekSortLen[0];
    fSeekPos[0] = 0;
    for (i=1;i<fNseek;i++) {
-      fSeekPos[i] = fSeekPos[i-1] + fSeekSortLen[i-1];
       //in the test below 16 MBytes is pure empirirical and may depend on the file system.
       //increasing this number must be done with care, as it may increase
       //the job real time (mismatch with OS buffers)
-      if ((fSeekSort[i] != fSeekSort[i-1]+fSeekSortLen[i-1]) ||
-          (fLen[nb] > 16000000)) {
+      Long64_t gap = fSeekSort[i] - (fPos[nb] + fLen[nb]);
+      if (gap < 0 || gap > fMaxGap || (fLen[nb] > 16000000)) {
+         start += fLen[nb];
          nb++;
          fPos[nb] = fSeekSort[i];
          fLen[nb] = fSeekSortLen[i];
+         fSeekPos[i] = start;
       } else {
-         fLen[nb] += fSeekSortLen[i];
+         fSeekPos[i] = start + (Int_t)(fSeekSort[i] - fPos[nb]);
+         fLen[nb] += (Int_t)gap + fSeekSortLen[i];
       }
    }
+   // The gaps read along may make the buffer larger than the sum of the blocks.
+   Int_t ntot = TMath::Max(fNtot, start + fLen[nb]);
+   if (ntot > fBufferSizeMin) {
+      fBufferSize = ntot + 100;
+      delete [] fBuffer;
+      fBuffer = 0;
+      // If ReadBufferAsync is not supported by this implementation
+      // it means that we are using sync primitives, hence we need the local buffer
+      if (!fAsyncReading)
+         fBuffer = new char[fBufferSize];
+   }
    fNb = nb+1;
    fIsSorted = kTRUE;
 }
@@ -625,7 +642,8 @@ void TFileCacheRead::Sort()
 ////////////////////////////////////////////////////////////////////////////////
 /// Sort buffers to be prefetched in increasing order of positions.
 ///
-/// Merge consecutive blocks if necessary.
+/// Merge consecutive blocks, or blocks separated by at most fMaxGap bytes,
+/// if necessary.
 
 void TFileCacheRead::SecondSort()
 {
@@ -649,32 +667,39 @@ void TFileCacheRead::SecondSort()
       ++effectiveNseek;
    }
    fBNseek = effectiveNseek;
-   if (fBNtot > fBufferSizeMin) {
-      fBufferSize = fBNtot + 100;
-      delete [] fBuffer;
-      fBuffer = 0;
-      // If ReadBufferAsync is not supported by this implementation
-      // it means that we are using sync primitives, hence we need the local buffer
-      if (!fAsyncReading)
-         fBuffer = new char[fBufferSize];
-   }
+   // Blocks separated by at most fMaxGap bytes are merged into the same long
+   // buffer; the gap is read along and skipped, so fSeekPos accounts for it.
+   Int_t start = 0; // position of the current long buffer in fBuffer
    fBPos[0]  = fBSeekSort[0];
    fBLen[0]  = fBSeekSortLen[0];
    fBSeekPos[0] = 0;
    for (i=1;i<fBNseek;i++) {
-      fBSeekPos[i] = fBSeekPos[i-1] + fBSeekSortLen[i-1];
       //in the test below 16 MBytes is pure empirirical and may depend on the file system.
       //increasing this number must be done with care, as it may increase
       //the job real time (mismatch with OS buffers)
-      if ((fBSeekSort[i] != fBSeekSort[i-1]+fBSeekSortLen[i-1]) ||
-         (fBLen[nb] > 16000000)) {
+      Long64_t gap = fBSeekSort[i] - (fBPos[nb] + fBLen[nb]);
+      if (gap < 0 || gap > fMaxGap || (fBLen[nb] > 16000000)) {
+         start += fBLen[nb];
          nb++;
          fBPos[nb] = fBSeekSort[i];
          fBLen[nb] = fBSeekSortLen[i];
+         fBSeekPos[i] = start;
       } else {
-         fBLen[nb] += fBSeekSortLen[i];
+         fBSeekPos[i] = start + (Int_t)(fBSeekSort[i] - fBPos[nb]);
+         fBLen[nb] += (Int_t)gap + fBSeekSortLen[i];
       }
    }
+   // The gaps read along may make the buffer larger than the sum of the blocks.
+   Int_t ntot = TMath::Max(fBNtot, start + fBLen[nb]);
+   if (ntot > fBufferSizeMin) {
+      fBufferSize = ntot + 100;
+      delete [] fBuffer;
+      fBuffer = 0;
+      // If ReadBufferAsync is not supported by this implementation
+      // it means that we are using sync primitives, hence we need the local buffer
+      if (!fAsyncReading)
+         fBuffer = new char[fBufferSize];
+   }
    fBNb = nb+1;
    fBIsSorted = kTRUE;
 }
@@ -23,12 +23,116 @@ TNetXNGFile and TWebFile (via TFile::WriteBuffers()).
 
 The write cache is automatically created when writing a remote file
 (created in TFile::Open()).
+
+For local files, including files on network file systems mounted
+locally, the cache can write asynchronously with SetAsyncWrite():
+full buffers are then written by a background thread while the
+caller continues to fill the next buffer. Flush() waits for all
+the buffers to be written.
+~~~ {.cpp}
+auto f = TFile::Open("out.root", "RECREATE");
+auto cache = new TFileCacheWrite(f, 8000000);
+cache->SetAsyncWrite(4); // at most 4 buffers waiting to be written
+~~~
 */
 
 
 #include "TFile.h"
 #include "TFileCacheWrite.h"
 
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+/// A background thread writing the buffers handed over by TFileCacheWrite.
+/// The buffers are written in the order of submission, so later writes to
+/// the same region win as they do with synchronous writes.
+struct ROOT::Internal::RAsyncFileWriter {
+   struct RRequest {
+      std::unique_ptr<char[]> fBuffer;
+      Int_t fFd = -1;
+      Long64_t fOffset = 0;
+      Int_t fNbytes = 0;
+   };
+
+   Int_t fMaxInFlight;                           ///< Maximum number of buffers queued or being written
+   Int_t fInFlight = 0;                          ///< Number of buffers queued or being written
+   Bool_t fStop = kFALSE;                        ///< Set by the destructor, the queue is still drained
+   std::deque<RRequest> fQueue;                  ///< Buffers waiting to be written
+   std::vector<std::unique_ptr<char[]>> fSpare;  ///< Written buffers that can be reused
+   std::string fError;                           ///< First error, reported by the next WaitAsync()
+   std::mutex fMutex;
+   std::condition_variable fCv;
+   std::thread fThread;
+
+   explicit RAsyncFileWriter(Int_t maxInFlight) : fMaxInFlight(maxInFlight)
+   {
+      fThread = std::thread([this]() { Run(); });
+   }
+
+   ~RAsyncFileWriter()
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fStop = kTRUE;
+      }
+      fCv.notify_all();
+      fThread.join();
+   }
+
+   static std::string Write(const RRequest &req)
+   {
+#ifndef WIN32
+      const char *buf = req.fBuffer.get();
+      Long64_t offset = req.fOffset;
+      Int_t nbytes = req.fNbytes;
+      while (nbytes > 0) {
+         auto siz = ::pwrite(req.fFd, buf, nbytes, offset);
+         if (siz < 0 && errno == EINTR)
+            continue;
+         if (siz <= 0)
+            return siz < 0 ? std::string(strerror(errno)) : std::string("no bytes written");
+         buf += siz;
+         offset += siz;
+         nbytes -= siz;
+      }
+      return std::string();
+#else
+      (void)req;
+      return std::string("asynchronous writes are not supported on Windows");
+#endif
+   }
+
+   void Run()
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      while (true) {
+         fCv.wait(lock, [this]() { return fStop || !fQueue.empty(); });
+         if (fQueue.empty())
+            return;
+         RRequest req = std::move(fQueue.front());
+         fQueue.pop_front();
+         lock.unlock();
+         auto error = Write(req);
+         lock.lock();
+         if (!error.empty() && fError.empty())
+            fError = error;
+         fSpare.emplace_back(std::move(req.fBuffer));
+         fInFlight--;
+         fCv.notify_all();
+      }
+   }
+};
+
 ClassImp(TFileCacheWrite);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -69,15 +173,22 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
 
 TFileCacheWrite::~TFileCacheWrite()
 {
+   // Waits for the buffers in flight to be written
+   fAsync.reset();
    delete [] fBuffer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Flush the current write buffer to the file.
+/// In asynchronous mode, also wait until all the buffers in flight are written.
 /// Returns kTRUE in case of error.
 
 Bool_t TFileCacheWrite::Flush()
 {
+   if (fAsync) {
+      Bool_t status = SubmitAsync();
+      return WaitAsync() || status;
+   }
    if (!fNtot) return kFALSE;
    fFile->Seek(fSeekStart);
    //printf("Flushing buffer at fSeekStart=%lld, fNtot=%d\n",fSeekStart,fNtot);
@@ -88,6 +199,116 @@ Bool_t TFileCacheWrite::Flush()
    return status;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the current buffer when it is full or when the next block is not
+/// contiguous: synchronously, or by handing it to the background writer.
+/// Returns kTRUE in case of error.
+
+Bool_t TFileCacheWrite::FlushBuffer()
+{
+   return fAsync ? SubmitAsync() : Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the current buffer to the background writer and continue with a spare
+/// one, waiting if the maximum number of buffers are already in flight.
+/// Returns kTRUE in case of error.
+
+Bool_t TFileCacheWrite::SubmitAsync()
+{
+   if (!fNtot) return kFALSE;
+
+   ROOT::Internal::RAsyncFileWriter::RRequest req;
+   req.fFd = fFile->GetFd();
+   req.fOffset = fSeekStart + fFile->fArchiveOffset;
+   req.fNbytes = fNtot;
+   req.fBuffer.reset(fBuffer);
+   fBuffer = nullptr;
+   fNtot = 0;
+   fFile->fBytesWrite += req.fNbytes;
+   TFile::fgBytesWrite += req.fNbytes;
+
+   std::unique_lock<std::mutex> lock(fAsync->fMutex);
+   fAsync->fCv.wait(lock, [this]() { return fAsync->fInFlight < fAsync->fMaxInFlight; });
+   fAsync->fQueue.emplace_back(std::move(req));
+   fAsync->fInFlight++;
+   if (fAsync->fSpare.empty()) {
+      fBuffer = new char[fBufferSize];
+   } else {
+      fBuffer = fAsync->fSpare.back().release();
+      fAsync->fSpare.pop_back();
+   }
+   Bool_t failed = !fAsync->fError.empty();
+   lock.unlock();
+   fAsync->fCv.notify_all();
+   return failed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait until the background writer has written all the buffers in flight.
+/// Returns kTRUE and sets the write error bit of the file if any of them
+/// could not be written.
+
+Bool_t TFileCacheWrite::WaitAsync()
+{
+   std::string error;
+   {
+      std::unique_lock<std::mutex> lock(fAsync->fMutex);
+      fAsync->fCv.wait(lock, [this]() { return fAsync->fInFlight == 0; });
+      std::swap(error, fAsync->fError);
+   }
+   if (error.empty())
+      return kFALSE;
+   fFile->SetBit(TFile::kWriteError);
+   fFile->SetWritable(kFALSE);
+   Error("Flush", "error writing to file %s: %s", fFile->GetName(), error.c_str());
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the maximum number of buffers in flight in asynchronous mode, or 0
+/// if the cache writes synchronously.
+
+Int_t TFileCacheWrite::GetAsyncWrite() const
+{
+   return fAsync ? fAsync->fMaxInFlight : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write full buffers asynchronously with up to nbuffers buffers in flight,
+/// i.e. queued or being written by the background thread, in addition to the
+/// one being filled. The cache then uses up to nbuffers+1 times its size in
+/// memory. With nbuffers = 0, the cache writes synchronously again.
+///
+/// The background thread writes with pwrite() to the file descriptor, so this
+/// mode is only available for local files, which includes network file
+/// systems mounted locally. For other TFile implementations and on Windows,
+/// the cache stays synchronous and kFALSE is returned.
+///
+/// Reading back data through the file waits for the buffers in flight. An
+/// error in the background thread is reported by the next write or Flush().
+
+Bool_t TFileCacheWrite::SetAsyncWrite(Int_t nbuffers)
+{
+   if (fAsync) {
+      if (nbuffers == fAsync->fMaxInFlight)
+         return kTRUE;
+      WaitAsync();
+      fAsync.reset();
+   }
+   if (nbuffers <= 0)
+      return kTRUE;
+#ifndef WIN32
+   if (fFile && fFile->IsA() == TFile::Class() && fFile->GetFd() >= 0) {
+      fAsync = std::make_unique<ROOT::Internal::RAsyncFileWriter>(nbuffers);
+      return kTRUE;
+   }
+#endif
+   Warning("SetAsyncWrite", "asynchronous writes are not supported for %s, writing synchronously",
+           fFile ? fFile->GetName() : "a cache without file");
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print class internal structure.
 
@@ -107,6 +328,8 @@ void TFileCacheWrite::Print(Option_t *option) const
 
 Int_t TFileCacheWrite::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
+   // The data might be in a buffer in flight, make sure it is on disk
+   if (fAsync) WaitAsync();
    if (pos < fSeekStart || pos+len > fSeekStart+fNtot) return -1;
    memcpy(buf,fBuffer+pos-fSeekStart,len);
    return 0;
@@ -126,10 +349,11 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
 
    if (fSeekStart + fNtot != pos) {
       //we must flush the current cache
-      if (Flush()) return -1; //failure
+      if (FlushBuffer()) return -1; //failure
    }
    if (fNtot + len >= fBufferSize) {
-      if (Flush()) return -1; //failure
+      // a direct write must not overtake the buffers in flight
+      if (len >= fBufferSize ? Flush() : FlushBuffer()) return -1; //failure
       if (len >= fBufferSize) {
          //buffer larger than the cache itself: direct write to file
          fRecursive = kTRUE;
@@ -148,9 +372,15 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the file using this cache.
-/// Any write not yet flushed will be lost.
+/// Any write not yet flushed will be lost. Asynchronous writes are switched
+/// off and have to be enabled again with SetAsyncWrite().
 
 void TFileCacheWrite::SetFile(TFile *file)
 {
+   if (fAsync && file != fFile) {
+      // The buffers in flight are still written to the old file
+      WaitAsync();
+      fAsync.reset();
+   }
    fFile = file;
 }
@@ -20,6 +20,15 @@ any of its remote file access plugins. It is therefore useful in
 a Grid environment where the files might be accessible only remotely.
 The merging interface allows files containing histograms and trees
 to be merged, like the standalone hadd program.
+
+The objects of the input files can be split into disjoint subsets by
+their name with SetKeySlice(), so that several mergers, e.g. in
+separate processes, merge the same input files in parallel, each into
+its own output file. Directories are traversed by all the mergers;
+every other object is merged by exactly one of them, and the outputs
+can then be merged together without further Merge() calls on the
+objects. This is used by `hadd -j` when there are fewer groups of input
+files than processes.
 */
 
 #include "TFileMerger.h"
@@ -477,6 +486,12 @@ Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type,
    if (IsMergeable(cl))
       allNames.Add(new TObjString(keyname));
 
+   // Leave the objects of the other subsets to the other mergers.
+   if (fNKeySlices > 1 && !cl->InheritsFrom(TDirectory::Class()) && !IsInKeySlice(path, keyname)) {
+      oldkeyname = keyname;
+      return kTRUE;
+   }
+
    if (fNoTrees && cl->InheritsFrom(R__TTree_Class)) {
       // Skip the TTree objects and any related cycles.
       oldkeyname = keyname;
@@ -938,7 +953,7 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
    }
 
    // Special treament for the single file case to improve efficiency...
-   if ((fFileList.GetEntries() == 1) && !fExcessFiles.GetEntries() &&
+   if ((fFileList.GetEntries() == 1) && !fExcessFiles.GetEntries() && fNKeySlices == 1 &&
       !(in_type & (kIncremental | kOnlyListed | kSkipListed | kResetable | kNonResetable)) && !fCompressionChange && !fExplicitCompLevel) {
       fOutputFile->Close();
       SafeDelete(fOutputFile);
@@ -1110,6 +1125,45 @@ void TFileMerger::SetMaxOpenedFiles(Int_t newmax)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Merge only the objects whose name falls in the subset `slice` of `nslices`
+/// disjoint subsets; with `nslices` <= 1 (the default) all objects are merged.
+///
+/// The subset of an object is given by the hash of its path and name, so that
+/// all the mergers that are given the same `nslices` agree on it. Directories
+/// are created in the output by all of them.
+
+void TFileMerger::SetKeySlice(Int_t slice, Int_t nslices)
+{
+   if (nslices <= 1) {
+      fKeySlice = 0;
+      fNKeySlices = 1;
+      return;
+   }
+   if (slice < 0 || slice >= nslices) {
+      Error("SetKeySlice", "slice %d is not in [0, %d), merging all objects", slice, nslices);
+      fKeySlice = 0;
+      fNKeySlices = 1;
+      return;
+   }
+   fKeySlice = slice;
+   fNKeySlices = nslices;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the object `name` in the directory `path` belongs to the
+/// subset of the objects merged by this merger, see SetKeySlice().
+
+Bool_t TFileMerger::IsInKeySlice(const TString &path, const char *name) const
+{
+   if (fNKeySlices <= 1)
+      return kTRUE;
+   TString fullname(path);
+   fullname += '/';
+   fullname += name;
+   return fullname.Hash() % fNKeySlices == static_cast<UInt_t>(fKeySlice);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the prefix to be used when printing informational message.
 
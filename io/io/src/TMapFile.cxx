@@ -663,10 +663,13 @@ void TMapFile::Update(TObject *obj)
 
    Bool_t all = (obj == 0) ? kTRUE : kFALSE;
 
+   // one buffer (and its object map) is reused for all records, which matters
+   // when many objects are updated at a high rate
+   TBufferFile *b = nullptr;
+
    TMapRec *mr = fFirst;
    while (mr) {
       if (all || mr->fObject == obj) {
-         TBufferFile *b;
          if (!mr->fBufSize) {
             const char *cname = mr->fObject->ClassName();
             mr->fBufSize = GetBestBuffer();
@@ -676,17 +679,22 @@ void TMapFile::Update(TObject *obj)
             mr->fClassName = StrDup(cname);
             ROOT::Internal::gMmallocDesc = nullptr;
          }
-         b = new TBufferFile(TBuffer::kWrite, mr->fBufSize, mr->fBuffer, kFALSE, MemMapAllocFunc);
+         if (!b) {
+            b = new TBufferFile(TBuffer::kWrite, mr->fBufSize, mr->fBuffer, kFALSE, MemMapAllocFunc);
+         } else {
+            b->SetBuffer(mr->fBuffer, mr->fBufSize, kFALSE, MemMapAllocFunc);
+            b->ResetMap();
+         }
          b->MapObject(mr->fObject);  //register obj in map to handle self reference
          mr->fObject->Streamer(*b);
          mr->fBufSize = b->BufferSize() + 8; // extra space at end of buffer (used for free block count) there on
          mr->fBuffer  = b->Buffer();
          SumBuffer(b->Length());
          b->DetachBuffer();
-         delete b;
       }
       mr = mr->fNext;
    }
+   delete b;
 
    ReleaseSemaphore();
 }
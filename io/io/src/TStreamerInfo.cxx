@@ -2644,6 +2644,8 @@ void TStreamerInfo::Clear(Option_t *option)
       if (fWriteMemberWise) fWriteMemberWise->fActions.clear();
       if (fWriteMemberWiseVecPtr) fWriteMemberWiseVecPtr->fActions.clear();
       if (fWriteText) fWriteText->fActions.clear();
+      fWriteActionsBuilt = kFALSE;
+      fTextActionsBuilt = kFALSE;
    }
 }
 
@@ -25,6 +25,8 @@
 #include "TProcessID.h"
 #include "TFile.h"
 
+#include <type_traits>
+
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
 // More possible optimizations:
@@ -1718,12 +1720,63 @@ namespace TStreamerInfoActions
 
    struct VectorLooper {
 
+      /// Whether the values of type T can be byte-swapped directly from and to the buffer by the bulk kernels
+      /// below.  This is only the case for a plain TBufferFile (TBufferSQL and co. override the basic type readers)
+      /// and not for Long_t, whose size on file depends on the version of the file.
+      template <typename T>
+      static bool CanUseBulkKernel(const TBuffer &buf)
+      {
+         return !std::is_same<T, Long_t>::value && !std::is_same<T, ULong_t>::value &&
+                buf.IsA() == TBufferFile::Class();
+      }
+
+      /// Read the member of type T, at stride `incr`, of all the elements of a contiguous collection with a single
+      /// bound check instead of one virtual call per element, and as a single memcpy (plus byte swap) if the
+      /// elements hold nothing but this member.  Returns false if the buffer is too short, in which case nothing
+      /// was read.
+      template <typename T>
+      static bool ReadBulk(TBuffer &buf, char *iter, const char *end, Int_t incr)
+      {
+         const Long64_t n = (end - iter) / incr;
+         if (buf.Length() + n * (Long64_t)sizeof(T) > buf.BufferSize())
+            return false;
+         if (incr == sizeof(T)) {
+            buf.ReadFastArray((T *)iter, (Int_t)n);
+            return true;
+         }
+         char *cur = buf.GetCurrent();
+         for (; iter != end; iter += incr)
+            frombuf(cur, (T *)iter);
+         buf.SetBufferOffset((Int_t)(cur - buf.Buffer()));
+         return true;
+      }
+
+      /// Write counterpart of ReadBulk(); the buffer is expanded once for all the elements.
+      template <typename T>
+      static void WriteBulk(TBuffer &buf, const char *iter, const char *end, Int_t incr)
+      {
+         const Long64_t n = (end - iter) / incr;
+         const Long64_t needed = buf.Length() + n * (Long64_t)sizeof(T);
+         if (needed > buf.BufferSize())
+            buf.AutoExpand((Int_t)needed);
+         if (incr == sizeof(T)) {
+            buf.WriteFastArray((const T *)iter, (Int_t)n);
+            return;
+         }
+         char *cur = buf.GetCurrent();
+         for (; iter != end; iter += incr)
+            tobuf(cur, *(const T *)iter);
+         buf.SetBufferOffset((Int_t)(cur - buf.Buffer()));
+      }
+
       template <typename T>
       static INLINE_TEMPLATE_ARGS Int_t ReadBasicType(TBuffer &buf, void *iter, const void *end, const TLoopConfiguration *loopconfig, const TConfiguration *config)
       {
          const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
          iter = (char*)iter + config->fOffset;
          end = (char*)end + config->fOffset;
+         if (iter != end && CanUseBulkKernel<T>(buf) && ReadBulk<T>(buf, (char *)iter, (const char *)end, incr))
+            return 0;
          for(; iter != end; iter = (char*)iter + incr ) {
             T *x = (T*) ((char*) iter);
             buf >> *x;
@@ -1812,6 +1865,10 @@ namespace TStreamerInfoActions
          const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
          iter = (char*)iter + config->fOffset;
          end = (char*)end + config->fOffset;
+         if (iter != end && CanUseBulkKernel<T>(buf)) {
+            WriteBulk<T>(buf, (const char *)iter, (const char *)end, incr);
+            return 0;
+         }
          for(; iter != end; iter = (char*)iter + incr ) {
             T *x = (T*) ((char*) iter);
             buf << *x;
@@ -3006,26 +3063,17 @@ void TStreamerInfo::Compile()
    if (fReadObjectWise) fReadObjectWise->fActions.clear();
    else fReadObjectWise = new TStreamerInfoActions::TActionSequence(this,ndata);
 
-   if (fWriteObjectWise) fWriteObjectWise->fActions.clear();
-   else fWriteObjectWise = new TStreamerInfoActions::TActionSequence(this,ndata);
-
    if (fReadMemberWise) fReadMemberWise->fActions.clear();
    else fReadMemberWise = new TStreamerInfoActions::TActionSequence(this,ndata);
 
-   if (fReadText) fReadText->fActions.clear();
-   else fReadText = new TStreamerInfoActions::TActionSequence(this,ndata);
-
-   if (fWriteMemberWise) fWriteMemberWise->fActions.clear();
-   else fWriteMemberWise = new TStreamerInfoActions::TActionSequence(this,ndata);
-
    if (fReadMemberWiseVecPtr) fReadMemberWiseVecPtr->fActions.clear();
    else fReadMemberWiseVecPtr = new TStreamerInfoActions::TActionSequence(this, ndata, kTRUE);
 
-   if (fWriteMemberWiseVecPtr) fWriteMemberWiseVecPtr->fActions.clear();
-   else fWriteMemberWiseVecPtr = new TStreamerInfoActions::TActionSequence(this, ndata, kTRUE);
-
-   if (fWriteText) fWriteText->fActions.clear();
-   else fWriteText = new TStreamerInfoActions::TActionSequence(this,ndata);
+   // The write and text (JSON) actions are only built when first requested, see BuildWriteActions()
+   // and BuildTextActions(): most infos, e.g. the ones of old versions read from files, are never
+   // used for writing.
+   fWriteActionsBuilt = kFALSE;
+   fTextActionsBuilt = kFALSE;
 
    if (!ndata) {
       // This may be the case for empty classes (e.g., TAtt3D).
@@ -3186,19 +3234,13 @@ void TStreamerInfo::Compile()
          continue;
       }
       AddReadAction(fReadObjectWise, i, fCompOpt[i]);
-      AddWriteAction(fWriteObjectWise, i, fCompOpt[i]);
    }
    for (i = 0; i < fNfulldata; ++i) {
       if (!fCompFull[i]->fElem || fCompFull[i]->fElem->GetType()< 0) {
          continue;
       }
       AddReadAction(fReadMemberWise, i, fCompFull[i]);
-      AddWriteAction(fWriteMemberWise, i, fCompFull[i]);
       AddReadMemberWiseVecPtrAction(fReadMemberWiseVecPtr, i, fCompFull[i]);
-      AddWriteMemberWiseVecPtrAction(fWriteMemberWiseVecPtr, i, fCompFull[i]);
-
-      AddReadTextAction(fReadText, i, fCompFull[i]);
-      AddWriteTextAction(fWriteText, i, fCompFull[i]);
    }
    ComputeSize();
 
@@ -3210,6 +3252,71 @@ void TStreamerInfo::Compile()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Build the write action sequences of a compiled TStreamerInfo, on the first
+/// call to GetWriteObjectWiseActions() or GetWriteMemberWiseActions() after Compile().
+
+void TStreamerInfo::BuildWriteActions()
+{
+   R__LOCKGUARD(gInterpreterMutex);
+   if (fWriteActionsBuilt || !IsCompiled())
+      return;
+
+   Int_t ndata = fElements->GetEntriesFast();
+
+   if (fWriteObjectWise) fWriteObjectWise->fActions.clear();
+   else fWriteObjectWise = new TStreamerInfoActions::TActionSequence(this,ndata);
+
+   if (fWriteMemberWise) fWriteMemberWise->fActions.clear();
+   else fWriteMemberWise = new TStreamerInfoActions::TActionSequence(this,ndata);
+
+   if (fWriteMemberWiseVecPtr) fWriteMemberWiseVecPtr->fActions.clear();
+   else fWriteMemberWiseVecPtr = new TStreamerInfoActions::TActionSequence(this, ndata, kTRUE);
+
+   for (Int_t i = 0; i < fNdata; ++i) {
+      if (!fCompOpt[i]->fElem || fCompOpt[i]->fElem->GetType()< 0) {
+         continue;
+      }
+      AddWriteAction(fWriteObjectWise, i, fCompOpt[i]);
+   }
+   for (Int_t i = 0; i < fNfulldata; ++i) {
+      if (!fCompFull[i]->fElem || fCompFull[i]->fElem->GetType()< 0) {
+         continue;
+      }
+      AddWriteAction(fWriteMemberWise, i, fCompFull[i]);
+      AddWriteMemberWiseVecPtrAction(fWriteMemberWiseVecPtr, i, fCompFull[i]);
+   }
+   fWriteActionsBuilt = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the text (JSON) action sequences of a compiled TStreamerInfo, on the first
+/// call to GetReadTextActions() or GetWriteTextActions() after Compile().
+
+void TStreamerInfo::BuildTextActions()
+{
+   R__LOCKGUARD(gInterpreterMutex);
+   if (fTextActionsBuilt || !IsCompiled())
+      return;
+
+   Int_t ndata = fElements->GetEntriesFast();
+
+   if (fReadText) fReadText->fActions.clear();
+   else fReadText = new TStreamerInfoActions::TActionSequence(this,ndata);
+
+   if (fWriteText) fWriteText->fActions.clear();
+   else fWriteText = new TStreamerInfoActions::TActionSequence(this,ndata);
+
+   for (Int_t i = 0; i < fNfulldata; ++i) {
+      if (!fCompFull[i]->fElem || fCompFull[i]->fElem->GetType()< 0) {
+         continue;
+      }
+      AddReadTextAction(fReadText, i, fCompFull[i]);
+      AddWriteTextAction(fWriteText, i, fCompFull[i]);
+   }
+   fTextActionsBuilt = kTRUE;
+}
+
 template <typename From>
 static void AddReadConvertAction(TStreamerInfoActions::TActionSequence *sequence, Int_t newtype, TConfiguration *conf)
 {
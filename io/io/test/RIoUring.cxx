@@ -43,6 +43,39 @@ TEST(RRawFileUnix, ReadV)
    }
 }
 
+TEST(RIoUring, SubmitMoreThanQueueDepth)
+{
+   auto file = "test_uring_queue";
+   auto filesize = 2 << 20;
+   FileRaii fileGuard(file, std::string(filesize, 'a')); // ~2MB
+   RRawFileUnix f(file, RRawFile::ROptions());
+   auto size = f.GetSize();
+
+   RIoUring ring(4);
+   EXPECT_EQ(ring.GetQueueDepth(), 4);
+
+   unsigned int nReads = 100; // the queue is topped up as reads complete
+   auto iovecs = make_iovecs(nReads, size);
+   std::vector<RIoUring::RReadEvent> reads;
+   for (const auto &iovec : iovecs) {
+      RIoUring::RReadEvent ev;
+      ev.fBuffer = iovec.fBuffer;
+      ev.fOffset = iovec.fOffset;
+      ev.fSize = iovec.fSize;
+      ev.fFileDes = f.GetFd();
+      reads.push_back(ev);
+   }
+   ring.SubmitReadsAndWait(reads.data(), nReads);
+
+   for (std::size_t r = 0; r < nReads; ++r) {
+      EXPECT_EQ(std::min<std::uint64_t>(reads[r].fSize, size - reads[r].fOffset), reads[r].fOutBytes);
+      for (std::size_t i = 0; i < reads[r].fOutBytes; ++i) {
+         EXPECT_EQ('a', ((unsigned char *)reads[r].fBuffer)[i]);
+      }
+      free(reads[r].fBuffer);
+   }
+}
+
 TEST(RawUring, NopRoundTrip)
 {
    struct io_uring ring;
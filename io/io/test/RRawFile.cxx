@@ -1,10 +1,23 @@
 #include "io_test.hxx"
 
 #include "TFile.h"
+#include "TNamed.h"
+
+#include <iterator>
+#include <memory>
+#include <vector>
 
 #include "ROOT/RRawFileTFile.hxx"
 using ROOT::Internal::RRawFileTFile;
 
+#ifndef _WIN32
+#include "ROOT/RFileBlockCache.hxx"
+#include "ROOT/RRawFileBlockCached.hxx"
+#include "TSystem.h"
+using ROOT::Internal::RFileBlockCache;
+using ROOT::Internal::RRawFileBlockCached;
+#endif
+
 namespace {
 
 /**
@@ -272,3 +285,115 @@ TEST(RRawFileTFile, TFile)
    EXPECT_EQ(seek[2], 0);
    EXPECT_EQ(seek[3], 100);
 }
+
+TEST(RRawFileTFile, ReadV)
+{
+   FileRaii tfileGuard("test_rawfile_tfile_readv.root", "");
+   {
+      std::unique_ptr<TFile> file(TFile::Open(tfileGuard.GetPath().c_str(), "RECREATE"));
+      for (int i = 0; i < 100; ++i) {
+         TNamed named(("named" + std::to_string(i)).c_str(), std::string(1000 + i, 'a' + i % 26).c_str());
+         file->WriteTObject(&named);
+      }
+   }
+   std::ifstream istrm(tfileGuard.GetPath(), std::ios::binary);
+   std::string content((std::istreambuf_iterator<char>(istrm)), std::istreambuf_iterator<char>());
+   ASSERT_GT(content.size(), 100000u);
+
+   std::unique_ptr<TFile> file(TFile::Open(tfileGuard.GetPath().c_str()));
+   auto rawFile = std::make_unique<RRawFileTFile>(file.get());
+
+   // Unordered, adjacent, overlapping and far apart requests
+   std::vector<std::pair<std::uint64_t, std::size_t>> ranges{
+      {50000, 100}, {0, 4}, {4, 10}, {1000, 3000}, {2000, 10}, {90000, 5000}, {20, 1}};
+   std::vector<std::string> buffers;
+   std::vector<RRawFile::RIOVec> ioVec(ranges.size());
+   for (const auto &r : ranges)
+      buffers.emplace_back(r.second, '\0');
+   for (std::size_t i = 0; i < ranges.size(); ++i) {
+      ioVec[i].fBuffer = &buffers[i][0];
+      ioVec[i].fOffset = ranges[i].first;
+      ioVec[i].fSize = ranges[i].second;
+   }
+   rawFile->ReadV(ioVec.data(), ioVec.size());
+
+   for (std::size_t i = 0; i < ranges.size(); ++i) {
+      EXPECT_EQ(ranges[i].second, ioVec[i].fOutBytes);
+      EXPECT_EQ(content.substr(ranges[i].first, ranges[i].second), buffers[i]);
+   }
+}
+
+#ifndef _WIN32
+TEST(RRawFileBlockCached, ReadThrough)
+{
+   const std::string cacheDir = "test_rrawfile_blockcache";
+   gSystem->Exec(("rm -rf " + cacheDir).c_str());
+   RFileBlockCache::Configure(cacheDir, 1024 * 1024, 1000);
+
+   std::string content;
+   for (int i = 0; i < 10000; ++i)
+      content.push_back('a' + (i * 7) % 26);
+   RRawFile::ROptions options;
+   options.fBlockSize = 0;
+
+   auto read = [&](std::unique_ptr<RRawFileBlockCached> &f) {
+      std::vector<std::pair<std::uint64_t, std::size_t>> ranges{{5500, 100}, {0, 10}, {990, 20}, {9990, 100}};
+      std::vector<std::string> buffers;
+      std::vector<RRawFile::RIOVec> ioVec(ranges.size());
+      for (const auto &r : ranges)
+         buffers.emplace_back(r.second, '\0');
+      for (std::size_t i = 0; i < ranges.size(); ++i) {
+         ioVec[i].fBuffer = &buffers[i][0];
+         ioVec[i].fOffset = ranges[i].first;
+         ioVec[i].fSize = ranges[i].second;
+      }
+      f->ReadV(ioVec.data(), ioVec.size());
+      for (std::size_t i = 0; i < ranges.size(); ++i) {
+         const auto expected = content.substr(ranges[i].first, ranges[i].second);
+         EXPECT_EQ(expected.size(), ioVec[i].fOutBytes);
+         EXPECT_EQ(expected, buffers[i].substr(0, ioVec[i].fOutBytes));
+      }
+   };
+
+   auto mock = std::make_unique<RRawFileMock>(content, options);
+   auto mockPtr = mock.get();
+   auto f = std::make_unique<RRawFileBlockCached>(std::move(mock), options);
+   read(f);
+   ASSERT_NE(nullptr, f->GetCache());
+   // blocks 0, 1, 5 and 9
+   EXPECT_EQ(4u, f->GetCache()->GetNBlocksMissed());
+   EXPECT_EQ(0u, f->GetCache()->GetNBlocksHit());
+   EXPECT_EQ(4u, mockPtr->fNumReadAt);
+
+   // A second reader of the same file only reads from the cache
+   mock = std::make_unique<RRawFileMock>(content, options);
+   mockPtr = mock.get();
+   f = std::make_unique<RRawFileBlockCached>(std::move(mock), options);
+   read(f);
+   EXPECT_EQ(0u, f->GetCache()->GetNBlocksMissed());
+   EXPECT_EQ(4u, f->GetCache()->GetNBlocksHit());
+   EXPECT_EQ(0u, mockPtr->fNumReadAt);
+
+   // A file of a different size invalidates the cached blocks; the last request now also reads block 10
+   content += "xyz";
+   f = std::make_unique<RRawFileBlockCached>(std::make_unique<RRawFileMock>(content, options), options);
+   read(f);
+   EXPECT_EQ(5u, f->GetCache()->GetNBlocksMissed());
+   EXPECT_EQ(0u, f->GetCache()->GetNBlocksHit());
+
+   // With a budget of 3 blocks, the least recently used blocks are evicted
+   RFileBlockCache::Configure(cacheDir, 3000, 1000);
+   f = std::make_unique<RRawFileBlockCached>(std::make_unique<RRawFileMock>(content, options), options);
+   char buffer[10];
+   for (std::uint64_t offset = 0; offset < 8000; offset += 1000)
+      EXPECT_EQ(10u, f->ReadAt(buffer, 10, offset));
+   std::ifstream index(cacheDir + "/index");
+   std::string hash;
+   std::uint64_t nbytes = 0;
+   index >> hash >> nbytes;
+   EXPECT_LE(nbytes, 3000u);
+
+   RFileBlockCache::Configure("");
+   gSystem->Exec(("rm -rf " + cacheDir).c_str());
+}
+#endif
@@ -1,6 +1,7 @@
 #include "TBufferJSON.h"
 #include "TNamed.h"
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -47,3 +48,21 @@ TEST(TBufferJSON, utf8_3)
    EXPECT_EQ(str0, named1->GetTitle());
 }
 
+
+// check shortest round-trip representation of floating point values
+TEST(TBufferJSON, shortest_double)
+{
+   std::vector<double> vect{0.1, 1. / 3., 1e-7, 12345678., -2.5e100};
+
+   TBufferText::SetFloatFormat("shortest");
+   auto json = TBufferJSON::ToJSON(&vect, TBufferJSON::kNoSpaces);
+   TBufferText::SetFloatFormat();
+   TBufferText::SetDoubleFormat();
+
+   EXPECT_NE(json.Index("0.1,"), kNPOS);
+   EXPECT_NE(json.Index("12345678"), kNPOS);
+
+   auto vect1 = TBufferJSON::FromJSON<std::vector<double>>(json.Data());
+   ASSERT_TRUE(vect1);
+   EXPECT_EQ(vect, *vect1);
+}
@@ -224,3 +224,61 @@ TEST(TBufferMerger, SetMaxTreeSize)
 
    RemoveFile("tbuffermerger_setmaxtreesize.root");
 }
+
+TEST(TBufferMerger, BackgroundMerge)
+{
+   int nthreads = 8;
+   int nevents = 128;
+   int nwrites = 4;
+
+   ROOT::EnableThreadSafety();
+
+   {
+      // A small memory limit and queue to exercise the back-pressure.
+      TBufferMerger merger("tbuffermerger_background.root");
+      merger.EnableBackgroundMerge(4096, 2);
+      EXPECT_TRUE(merger.IsBackgroundMerge());
+      std::vector<std::thread> threads;
+      for (int i = 0; i < nthreads; ++i) {
+         threads.emplace_back([=, &merger]() {
+            auto myfile = merger.GetFile();
+            auto mytree = new TTree("mytree", "mytree");
+            mytree->ResetBit(kMustCleanup);
+            int n = 0;
+            mytree->Branch("n", &n, "n/I");
+            for (int w = 0; w < nwrites; ++w) {
+               for (int e = 0; e < nevents; ++e) {
+                  n = (i * nwrites + w) * nevents + e;
+                  mytree->Fill();
+               }
+               myfile->Write();
+            }
+            mytree->ResetBranchAddresses();
+         });
+      }
+
+      for (auto &&t : threads)
+         t.join();
+   }
+
+   ASSERT_TRUE(FileExists("tbuffermerger_background.root"));
+   {
+      TFile f("tbuffermerger_background.root");
+      auto t = f.Get<TTree>("mytree");
+      ASSERT_TRUE(t != nullptr);
+      const Long64_t nentries = nthreads * nwrites * nevents;
+      EXPECT_EQ(nentries, t->GetEntries());
+
+      int n;
+      Long64_t sum = 0;
+      t->SetBranchAddress("n", &n);
+      for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+         t->GetEntry(i);
+         sum += n;
+      }
+      EXPECT_EQ(nentries * (nentries - 1) / 2, sum);
+      t->ResetBranchAddresses();
+   }
+
+   RemoveFile("tbuffermerger_background.root");
+}
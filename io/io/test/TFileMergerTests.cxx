@@ -6,6 +6,10 @@
 #include "TTree.h"
 #include "TH1.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 static void CreateATuple(TMemFile &file, const char *name, double value)
 {
    auto mytree = new TTree(name, "A tree");
@@ -101,3 +105,50 @@ TEST(TFileMerger, MergeSingleOnlyListed)
    ASSERT_TRUE(output.get() && output->GetListOfKeys());
    EXPECT_EQ(output->GetListOfKeys()->GetSize(), 2);
 }
+
+TEST(TFileMerger, KeySlices)
+{
+   constexpr int kNHists = 20;
+   TMemFile a("slices_a.root", "CREATE");
+   TMemFile b("slices_b.root", "CREATE");
+   for (auto file : {&a, &b}) {
+      file->cd();
+      for (int i = 0; i < kNHists; ++i) {
+         auto hist = new TH1F(("hist" + std::to_string(i)).c_str(), "hist", 1, 0, 2);
+         hist->Fill(1, i);
+      }
+      file->Write();
+   }
+
+   // Every object is merged by exactly one of the two mergers.
+   std::vector<std::unique_ptr<TFileMerger>> mergers;
+   std::vector<TFile *> partials;
+   for (int slice = 0; slice < 2; ++slice) {
+      mergers.emplace_back(new TFileMerger);
+      auto &merger = *mergers.back();
+      merger.SetKeySlice(slice, 2);
+      EXPECT_EQ(slice, merger.GetKeySlice());
+      EXPECT_EQ(2, merger.GetNKeySlices());
+      ASSERT_TRUE(merger.OutputFile(std::make_unique<TMemFile>(("slice" + std::to_string(slice)).c_str(), "CREATE")));
+      merger.AddFile(&a, false);
+      merger.AddFile(&b, false);
+      // Incremental, so that the output file is kept open.
+      ASSERT_TRUE(merger.PartialMerge(TFileMerger::kAll | TFileMerger::kIncremental));
+      partials.push_back(merger.GetOutputFile());
+   }
+
+   int nkeys = 0;
+   for (int i = 0; i < kNHists; ++i) {
+      const auto name = "hist" + std::to_string(i);
+      auto h0 = partials[0]->Get<TH1F>(name.c_str());
+      auto h1 = partials[1]->Get<TH1F>(name.c_str());
+      EXPECT_TRUE((h0 == nullptr) != (h1 == nullptr)) << name;
+      auto h = h0 ? h0 : h1;
+      ASSERT_NE(h, nullptr);
+      EXPECT_DOUBLE_EQ(2. * i, h->GetBinContent(1));
+      ++nkeys;
+   }
+   EXPECT_EQ(kNHists, nkeys);
+   EXPECT_GT(partials[0]->GetListOfKeys()->GetSize(), 0);
+   EXPECT_GT(partials[1]->GetListOfKeys()->GetSize(), 0);
+}
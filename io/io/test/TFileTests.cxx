@@ -1,9 +1,14 @@
+#include <atomic>
 #include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "TDirectoryFile.h"
 #include "TFile.h"
+#include "TFileCacheWrite.h"
 #include "TKey.h"
 #include "TNamed.h"
 #include "TPluginManager.h"
@@ -135,3 +140,146 @@ TEST(TFile, ReadWithoutGlobalRegistrationNet)
    const auto netFile = "root://eospublic.cern.ch//eos/root-eos/h1/dstarmb.root";
    TestReadWithoutGlobalRegistrationIfPossible(netFile);
 }
+
+TEST(TFile, LazyKeys)
+{
+   auto filename{"tfile_lazykeys.root"};
+   constexpr int kNDirs = 4;
+   constexpr int kNKeys = 500;
+   {
+      TFile f{filename, "recreate"};
+      for (int d = 0; d < kNDirs; ++d) {
+         auto dir = f.mkdir(("dir" + std::to_string(d)).c_str());
+         for (int k = 0; k < kNKeys; ++k) {
+            const auto name = "obj" + std::to_string(k);
+            TNamed named{name.c_str(), std::to_string(d * kNKeys + k).c_str()};
+            dir->WriteTObject(&named);
+            if (k % 100 == 0)
+               dir->WriteTObject(&named); // a second cycle
+         }
+      }
+   }
+
+   // The order of the keys as read without the index
+   std::vector<std::string> expectedNames;
+   {
+      TFile f{filename};
+      for (auto key : TRangeDynCast<TKey>(f.Get<TDirectory>("dir1")->GetListOfKeys()))
+         expectedNames.emplace_back(std::string(key->GetName()) + ";" + std::to_string(key->GetCycle()));
+   }
+
+   TDirectoryFile::SetLazyKeys(kTRUE);
+   {
+      TFile f{filename};
+      EXPECT_EQ(kNDirs, f.GetNkeys());
+      std::vector<TDirectory *> dirs;
+      for (int d = 0; d < kNDirs; ++d) {
+         dirs.emplace_back(f.Get<TDirectory>(("dir" + std::to_string(d)).c_str()));
+         ASSERT_NE(nullptr, dirs.back());
+         EXPECT_EQ(kNKeys + kNKeys / 100, dirs.back()->GetNkeys());
+      }
+
+      auto named = dirs[2]->Get<TNamed>("obj42");
+      ASSERT_NE(nullptr, named);
+      EXPECT_STREQ(std::to_string(2 * kNKeys + 42).c_str(), named->GetTitle());
+      EXPECT_EQ(2, dirs[3]->GetKey("obj300")->GetCycle());
+      EXPECT_EQ(1, dirs[3]->GetKey("obj300", 1)->GetCycle());
+      EXPECT_NE(nullptr, dirs[3]->Get("obj300;1"));
+      EXPECT_EQ(nullptr, dirs[3]->Get("obj301;2"));
+      EXPECT_EQ(nullptr, dirs[3]->FindKey("missing"));
+
+      // Concurrent key lookups in all directories
+      std::vector<std::thread> threads;
+      std::atomic<int> nfound{0};
+      for (int d = 0; d < kNDirs; ++d) {
+         threads.emplace_back([&, d]() {
+            for (int t = 0; t < kNDirs; ++t)
+               for (int k = d; k < kNKeys; k += kNDirs)
+                  if (dirs[t]->GetKey(("obj" + std::to_string(k)).c_str()))
+                     ++nfound;
+         });
+      }
+      for (auto &t : threads)
+         t.join();
+      EXPECT_EQ(kNDirs * kNKeys, nfound);
+
+      // The list of keys contains all keys, in the order of the file, including those already looked up
+      std::vector<std::string> names;
+      for (auto key : TRangeDynCast<TKey>(dirs[1]->GetListOfKeys()))
+         names.emplace_back(std::string(key->GetName()) + ";" + std::to_string(key->GetCycle()));
+      EXPECT_EQ(expectedNames, names);
+      EXPECT_EQ(kNKeys + kNKeys / 100, dirs[1]->GetNkeys());
+   }
+   TDirectoryFile::SetLazyKeys(kFALSE);
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TFileCacheWrite, AsyncWrite)
+{
+   auto filename{"tfilecachewrite_async.root"};
+   constexpr int kNObjects = 200;
+   {
+      TFile f{filename, "recreate"};
+      // Small buffers so that many of them are handed to the background writer
+      auto cache = new TFileCacheWrite(&f, 16000);
+      EXPECT_TRUE(cache->SetAsyncWrite(2));
+      EXPECT_EQ(2, cache->GetAsyncWrite());
+      for (int i = 0; i < kNObjects; ++i) {
+         TNamed named(("named" + std::to_string(i)).c_str(), std::string(1000 + 10 * i, 'a' + i % 26).c_str());
+         f.WriteTObject(&named);
+      }
+      // Reading back waits for the buffers in flight
+      auto named = f.Get<TNamed>("named10");
+      ASSERT_NE(nullptr, named);
+      EXPECT_EQ(std::string(1100, 'k'), named->GetTitle());
+      EXPECT_FALSE(f.TestBit(TFile::kWriteError));
+   }
+
+   TFile f{filename};
+   EXPECT_FALSE(f.IsZombie());
+   for (int i = 0; i < kNObjects; ++i) {
+      auto named = f.Get<TNamed>(("named" + std::to_string(i)).c_str());
+      ASSERT_NE(nullptr, named);
+      EXPECT_EQ(std::string(1000 + 10 * i, 'a' + i % 26), named->GetTitle());
+   }
+   f.Close();
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, MMAP)
+{
+   auto filename{"tfile_mmap.root"};
+   {
+      TFile f{filename, "recreate"};
+      for (int i = 0; i < 100; ++i) {
+         TNamed named(("named" + std::to_string(i)).c_str(), std::string(100 + i, 'a' + i % 26).c_str());
+         f.WriteTObject(&named);
+      }
+   }
+
+   std::unique_ptr<TFile> f{TFile::Open(filename, "MMAP")};
+   ASSERT_TRUE(f && !f->IsZombie());
+   EXPECT_FALSE(f->IsWritable());
+   EXPECT_STREQ("READ", f->GetOption());
+   const auto readCalls = f->GetReadCalls();
+   for (int i = 99; i >= 0; --i) {
+      auto named = f->Get<TNamed>(("named" + std::to_string(i)).c_str());
+      ASSERT_NE(nullptr, named);
+      EXPECT_EQ(std::string(100 + i, 'a' + i % 26), named->GetTitle());
+   }
+   EXPECT_GT(f->GetBytesRead(), 100 * 100);
+   // The objects are copied from the mapping, without read calls
+   EXPECT_EQ(readCalls, f->GetReadCalls());
+
+   // Switching to update mode drops the mapping
+   EXPECT_EQ(0, f->ReOpen("UPDATE"));
+   TNamed named("another", "one");
+   f->WriteTObject(&named);
+   f->Close();
+
+   f.reset(TFile::Open(filename, "MMAP"));
+   EXPECT_STREQ("one", f->Get<TNamed>("another")->GetTitle());
+   f.reset();
+   gSystem->Unlink(filename);
+}
@@ -26,6 +26,11 @@
 // be communicated over MPI to a master writer which combines the data  //
 // before writing it to file.                                           //
 //                                                                      //
+// With SetMergeFanIn() the workers of a collector are arranged in a    //
+// tree: workers with children merge the data received from them with   //
+// their own data and forward the result, so that the collector only    //
+// receives the messages of its direct children.                        //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 #include "TMPIClientInfo.h"
@@ -35,12 +40,14 @@
 
 #include <mpi.h>
 
+#include <deque>
+#include <memory>
 #include <vector>
 
 class TMPIFile : public TMemFile {
 
 private:
-   Int_t fEndProcess = 0; // collector tracks number of exited processes
+   Int_t fEndProcess = 0; // collector and relays track number of exited children
    Int_t fSplitLevel;     // number of collectors to use
    Int_t fMPIColor;       // used by MPI ranks to track which collector to use
 
@@ -49,12 +56,19 @@ private:
    Int_t fMPILocalRank;  // rank number in sub communicator
    Int_t fMPILocalSize;  // number of ranks in sub communicator
 
-   MPI_Comm fSubComm;       // sub communicator handle
-   MPI_Request fMPIRequest; // request place holder
+   Int_t fMergeFanIn = 0;      // number of children per rank in the merge tree, 0 - all workers send to collector
+   Int_t fMaxPendingSends = 2; // number of messages a worker may have in flight before Sync() waits
+
+   MPI_Comm fSubComm; // sub communicator handle
 
    TString fMPIFilename; // output filename, only used by collector
 
-   char *fSendBuf = 0; // message buffer, only used by worker
+   struct SendRequest {
+      MPI_Request fRequest = MPI_REQUEST_NULL; // request of the non-blocking send
+      std::unique_ptr<char[]> fBuffer;         // message buffer, kept until the send completes
+   };
+
+   std::deque<SendRequest> fSendRequests; // sends in flight, only used by worker
 
    struct ParallelFileMerger : public TObject {
    private:
@@ -90,6 +104,13 @@ private:
    void SplitMPIComm();
    void UpdateEndProcess();
 
+   Int_t GetParentRank() const;
+   Int_t GetNumChildren(Int_t rank) const;
+   void ReceiveFromChildren(std::vector<TMemFile *> &inputs, Bool_t wait);
+   void SendMerged(std::vector<TMemFile *> &inputs, Bool_t withSelf);
+   void SendBuffer(TMemFile *file);
+   void WaitForPendingSends(std::size_t maxPending);
+
    Bool_t IsReceived();
 
 public:
@@ -109,6 +130,12 @@ public:
 
    TString GetMPIFilename() const { return fMPIFilename; };
 
+   // configuration of the merging, must be the same on all ranks
+   void SetMergeFanIn(Int_t fanin) { fMergeFanIn = fanin > 0 ? fanin : 0; };
+   Int_t GetMergeFanIn() const { return fMergeFanIn; };
+   void SetMaxPendingSends(Int_t max) { fMaxPendingSends = max > 1 ? max : 1; };
+   Int_t GetMaxPendingSends() const { return fMaxPendingSends; };
+
    // Collector Functions
    void RunCollector(Bool_t cache = kFALSE);
    Bool_t IsCollector();
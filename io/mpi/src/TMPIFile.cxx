@@ -10,11 +10,14 @@
  *************************************************************************/
 
 #include "TMPIFile.h"
+#include "TDirectory.h"
 #include "TFileCacheWrite.h"
 #include "TKey.h"
 #include "THashTable.h"
 #include "TMath.h"
 
+#include <algorithm>
+
 ClassImp(TMPIFile);
 
 /** \class TMPIFile
@@ -44,6 +47,16 @@ Begin_Macro (source)
 }
 End_Macro
 
+### Hierarchical merging
+
+With many workers per collector, the collector becomes the bottleneck. SetMergeFanIn(k) arranges
+the ranks of each sub-communicator in a tree where every rank receives from at most k children:
+rank r sends to rank (r-1)/k. A worker with children merges the buffers received from them with
+its own data in Sync() and forwards one buffer, and in Close() it keeps forwarding until all its
+children have exited. The workers send without waiting for the previous message as long as less
+than GetMaxPendingSends() messages are in flight, so the computation overlaps with the transfer.
+The fan-in must be set to the same value on all ranks before RunCollector() or the first Sync().
+
 See TMPIFile class for the list of functions
 */
 
@@ -58,8 +71,7 @@ const Int_t MIN_FILE_NUM = 2;
 
 TMPIFile::TMPIFile(const char *name, char *buffer, Long64_t size, Option_t *option, Int_t split, const char *ftitle,
                    Int_t compress)
-   : TMemFile(name, buffer, size, option, ftitle, compress), fSplitLevel(split), fMPIColor(0), fMPIRequest(0),
-     fSendBuf(0)
+   : TMemFile(name, buffer, size, option, ftitle, compress), fSplitLevel(split), fMPIColor(0)
 {
    // check that split is set to reasonable value
    CheckSplitLevel();
@@ -76,7 +88,7 @@ TMPIFile::TMPIFile(const char *name, char *buffer, Long64_t size, Option_t *opti
 /// \param[split] is the number of collectors to use
 
 TMPIFile::TMPIFile(const char *name, Option_t *option, Int_t split, const char *ftitle, Int_t compress)
-   : TMemFile(name, option, ftitle, compress), fSplitLevel(split), fMPIColor(0), fMPIRequest(0), fSendBuf(0)
+   : TMemFile(name, option, ftitle, compress), fSplitLevel(split), fMPIColor(0)
 {
    // check that split is set to reasonable value
    CheckSplitLevel();
@@ -103,9 +115,9 @@ TMPIFile::~TMPIFile()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// As worker ranks exit, they send the collector empty messages.
-/// This counter keeps track of the number of empty messages the collector
-/// has received. Thereby the collector knows when all workers have exited
+/// As worker ranks exit, they send their parent (the collector or a relaying worker) empty messages.
+/// This counter keeps track of the number of empty messages the rank
+/// has received. Thereby the rank knows when all its children have exited
 /// and it can exit
 
 void TMPIFile::UpdateEndProcess()
@@ -128,8 +140,8 @@ void TMPIFile::RunCollector(Bool_t cache)
    Int_t client_Id = 0;
    std::vector<char> buffer(0);
 
-   // loop until all other ranks in the subcommunicator have exited
-   while (fEndProcess != fMPILocalSize - 1) {
+   // loop until all children in the subcommunicator have exited
+   while (fEndProcess != GetNumChildren(0)) {
       // Info("RunCollector","process counter %i",fEndProcess);
       // check if message has been received
       MPI_Status status;
@@ -184,7 +196,7 @@ void TMPIFile::RunCollector(Bool_t cache)
       buffer.resize(0);
    }
 
-   if (fEndProcess == fMPILocalSize - 1) {
+   if (fEndProcess == GetNumChildren(0)) {
       mergers.Delete();
       return;
    }
@@ -388,10 +400,133 @@ Bool_t TMPIFile::IsCollector()
    return !fMPILocalRank;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the local rank to which this worker sends its data
+
+Int_t TMPIFile::GetParentRank() const
+{
+   return fMergeFanIn > 0 ? (fMPILocalRank - 1) / fMergeFanIn : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the number of ranks which send their data to the given local rank
+
+Int_t TMPIFile::GetNumChildren(Int_t rank) const
+{
+   if (fMergeFanIn <= 0)
+      return rank == 0 ? fMPILocalSize - 1 : 0;
+   Long64_t first = (Long64_t)rank * fMergeFanIn + 1;
+   Long64_t last = std::min<Long64_t>(first + fMergeFanIn, fMPILocalSize);
+   return last > first ? last - first : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called by the Workers with children: receives the pending messages of the children.
+/// If wait is true, blocks until at least one message is received.
+/// Non-empty messages are added to the inputs, empty messages are counted as exited children.
+
+void TMPIFile::ReceiveFromChildren(std::vector<TMemFile *> &inputs, Bool_t wait)
+{
+   std::vector<char> buffer;
+   while (fEndProcess < GetNumChildren(fMPILocalRank)) {
+      MPI_Status status;
+      Int_t flag = 0;
+      if (wait) {
+         MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, fSubComm, &status);
+         flag = 1;
+         wait = kFALSE;
+      } else {
+         MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, fSubComm, &flag, &status);
+      }
+      if (!flag)
+         break;
+
+      Int_t number_bytes;
+      MPI_Get_count(&status, MPI_CHAR, &number_bytes);
+      buffer.resize(number_bytes);
+      MPI_Recv(buffer.data(), number_bytes, MPI_CHAR, status.MPI_SOURCE, status.MPI_TAG, fSubComm, MPI_STATUS_IGNORE);
+
+      if (number_bytes == 0) {
+         this->UpdateEndProcess();
+      } else {
+         TDirectory::TContext ctxt;
+         TMemFile *transient = new TMemFile(GetName(), buffer.data(), number_bytes, "UPDATE");
+         if (transient->IsZombie()) {
+            Error("ReceiveFromChildren", "Failed to create TMemFile from buffer");
+            delete transient;
+         } else {
+            inputs.push_back(transient);
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called by the Workers with children: merges the received inputs, and the content
+/// of this file if withSelf is true, into one buffer and sends it to the parent rank.
+/// The inputs are deleted.
+
+void TMPIFile::SendMerged(std::vector<TMemFile *> &inputs, Bool_t withSelf)
+{
+   TDirectory::TContext ctxt;
+
+   TFileMerger merger(kFALSE, kFALSE);
+   merger.SetPrintLevel(0);
+   auto merged = new TMemFile(GetName(), "RECREATE", "", GetCompressionSettings());
+   if (!merger.OutputFile(std::unique_ptr<TFile>(merged))) {
+      Error("SendMerged", "Cannot create the merge output");
+      for (auto input : inputs)
+         delete input;
+      inputs.clear();
+      return;
+   }
+   if (withSelf)
+      merger.AddFile(this, kFALSE);
+   for (auto input : inputs)
+      merger.AddAdoptFile(input, kFALSE);
+   inputs.clear();
+
+   if (!merger.PartialMerge(TFileMerger::kAllIncremental | TFileMerger::kKeepCompression))
+      Error("SendMerged", "Failed to merge the data of the children");
+   merged->Write();
+   SendBuffer(merged);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called by the Workers only: copies the content of the file and sends it
+/// asynchronously to the parent rank. Waits only if the maximal number of
+/// sends is already in flight.
+
+void TMPIFile::SendBuffer(TMemFile *file)
+{
+   WaitForPendingSends(fMaxPendingSends - 1);
+
+   Int_t count = file->GetEND();
+   fSendRequests.emplace_back();
+   auto &req = fSendRequests.back();
+   req.fBuffer.reset(new char[count]);
+   file->CopyTo(req.fBuffer.get(), count);
+   MPI_Isend(req.fBuffer.get(), count, MPI_CHAR, GetParentRank(), fMPIColor, fSubComm, &req.fRequest);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Releases the buffers of completed sends and waits until at most maxPending
+/// sends are in flight.
+
+void TMPIFile::WaitForPendingSends(std::size_t maxPending)
+{
+   IsReceived();
+   while (fSendRequests.size() > maxPending) {
+      MPI_Wait(&fSendRequests.front().fRequest, MPI_STATUS_IGNORE);
+      fSendRequests.pop_front();
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Called by the Workers only: Copies the current content in memory and
 /// sends it asynchronously to the Collector for merging and writing to disk.
 ///
+/// Workers with children in the merge tree include the data received from them.
 
 void TMPIFile::CreateBufferAndSend()
 {
@@ -400,15 +535,20 @@ void TMPIFile::CreateBufferAndSend()
       return;
    }
    this->Write();
-   Int_t count = this->GetEND();
-   fSendBuf = new char[count];
-   this->CopyTo(fSendBuf, count);
-   MPI_Isend(fSendBuf, count, MPI_CHAR, 0, fMPIColor, fSubComm, &fMPIRequest);
+
+   std::vector<TMemFile *> inputs;
+   ReceiveFromChildren(inputs, kFALSE);
+   if (inputs.empty())
+      SendBuffer(this);
+   else
+      SendMerged(inputs, kTRUE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// For Workers: Creates an empty buffer and sends it to the Collector.
 /// This indicates the completion of the worker.
+///
+/// Workers with children first forward the data of the children until all of them have exited.
 
 void TMPIFile::CreateEmptyBufferAndSend()
 {
@@ -416,12 +556,16 @@ void TMPIFile::CreateEmptyBufferAndSend()
       return;
    }
 
-   if (!IsReceived()) {
-      MPI_Wait(&fMPIRequest, MPI_STATUS_IGNORE);
+   std::vector<TMemFile *> inputs;
+   while (fEndProcess < GetNumChildren(fMPILocalRank)) {
+      ReceiveFromChildren(inputs, kTRUE);
+      if (!inputs.empty())
+         SendMerged(inputs, kFALSE);
    }
-   delete[] fSendBuf; // empty the buffer once received by master
-   fSendBuf = nullptr;
-   MPI_Send(fSendBuf, 0, MPI_CHAR, 0, fMPIColor, fSubComm);
+
+   // empty the buffers once received by the parent
+   WaitForPendingSends(0);
+   MPI_Send(nullptr, 0, MPI_CHAR, GetParentRank(), fMPIColor, fSubComm);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -430,12 +574,6 @@ void TMPIFile::CreateEmptyBufferAndSend()
 
 void TMPIFile::Sync()
 {
-   // check if the previous send request is accepted by master.
-   if (!IsReceived()) {
-      MPI_Wait(&fMPIRequest, MPI_STATUS_IGNORE);
-   }
-   delete[] fSendBuf; // empty the buffer once received by master
-   fSendBuf = nullptr;
    CreateBufferAndSend();
    this->ResetAfterMerge((TFileMergeInfo *)0);
 }
@@ -537,14 +675,18 @@ void TMPIFile::SplitMPIComm()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Checks the member MPI_REQEUST object to see if a message has been received.
+/// Checks the pending send requests to see if the messages have been received.
+/// Buffers of completed sends are released.
 
 Bool_t TMPIFile::IsReceived()
 {
-   if (!fMPIRequest) {
-      return kTRUE;
+   for (auto iter = fSendRequests.begin(); iter != fSendRequests.end();) {
+      Int_t flag = 0;
+      MPI_Test(&iter->fRequest, &flag, MPI_STATUS_IGNORE);
+      if (flag)
+         iter = fSendRequests.erase(iter);
+      else
+         ++iter;
    }
-   Int_t flag = 0;
-   MPI_Test(&fMPIRequest, &flag, MPI_STATUS_IGNORE);
-   return flag;
+   return fSendRequests.empty();
 }
@@ -14,6 +14,8 @@
 
 #include "TObject.h"
 
+#include <cstddef>
+
 typedef void *XMLNodePointer_t;
 typedef void *XMLNsPointer_t;
 typedef void *XMLAttrPointer_t;
@@ -38,6 +40,8 @@ protected:
    XMLNodePointer_t ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream *inp, Int_t &resvalue);
    void DisplayError(Int_t error, Int_t linenumber);
    XMLDocPointer_t ParseStream(TXMLInputStream *input);
+   XMLDocPointer_t ParseBinaryBuffer(const char *buf, std::size_t len);
+   XMLNodePointer_t ReadBinaryNode(XMLNodePointer_t xmlparent, const char *&curr, const char *end);
 
    Bool_t fSkipComments; //! if true, do not create comments nodes in document during parsing
 
@@ -96,6 +100,7 @@ public:
    void AssignDtd(XMLDocPointer_t xmldoc, const char *dtdname, const char *rootname);
    void FreeDoc(XMLDocPointer_t xmldoc);
    void SaveDoc(XMLDocPointer_t xmldoc, const char *filename, Int_t layout = 1);
+   void SaveBinaryDoc(XMLDocPointer_t xmldoc, const char *filename);
    void DocSetRootElement(XMLDocPointer_t xmldoc, XMLNodePointer_t xmlnode);
    XMLNodePointer_t DocGetRootElement(XMLDocPointer_t xmldoc);
    XMLDocPointer_t ParseFile(const char *filename, Int_t maxbuf = 100000);
@@ -30,6 +30,7 @@
 #include <fstream>
 #include <cstdlib>
 #include <cstring>
+#include <string>
 
 ClassImp(TXMLEngine);
 
@@ -67,6 +68,80 @@ struct SXmlDoc_t {
    char *fDtdRoot;
 };
 
+namespace {
+
+// Binary document layout, see TXMLEngine::SaveBinaryDoc(). The leading zero byte
+// can never start a text xml file, which lets ParseFile() detect the format.
+const char gBinaryMagic[] = {'\0', 'R', 'X', 'B', 1};
+const std::size_t gBinaryMagicLen = sizeof(gBinaryMagic);
+
+void PutBinaryLength(std::string &out, std::size_t len)
+{
+   while (len >= 0x80) {
+      out.push_back(char((len & 0x7f) | 0x80));
+      len >>= 7;
+   }
+   out.push_back(char(len));
+}
+
+void PutBinaryString(std::string &out, const char *str, std::size_t len)
+{
+   PutBinaryLength(out, len);
+   out.append(str, len);
+}
+
+Bool_t GetBinaryLength(const char *&curr, const char *end, std::size_t &len)
+{
+   len = 0;
+   for (int shift = 0; (curr < end) && (shift < 64); shift += 7) {
+      unsigned char c = *curr++;
+      len |= std::size_t(c & 0x7f) << shift;
+      if (!(c & 0x80))
+         return kTRUE;
+   }
+   return kFALSE;
+}
+
+Bool_t GetBinaryString(const char *&curr, const char *end, const char *&str, std::size_t &len)
+{
+   if (!GetBinaryLength(curr, end, len) || (len > std::size_t(end - curr)))
+      return kFALSE;
+   str = curr;
+   curr += len;
+   return kTRUE;
+}
+
+void SaveBinaryNode(SXmlNode_t *node, std::string &out)
+{
+   out.push_back(char(node->fType));
+   const char *name = SXmlNode_t::Name(node);
+   PutBinaryString(out, name, strlen(name));
+
+   std::size_t nattr = 0, nsindx = 0;
+   for (SXmlAttr_t *attr = node->fAttr; attr; attr = attr->fNext)
+      if (attr == node->fNs)
+         nsindx = ++nattr;
+      else
+         ++nattr;
+   PutBinaryLength(out, nattr);
+   for (SXmlAttr_t *attr = node->fAttr; attr; attr = attr->fNext) {
+      const char *attrname = SXmlAttr_t::Name(attr);
+      std::size_t namelen = strlen(attrname);
+      PutBinaryString(out, attrname, namelen);
+      PutBinaryString(out, attrname + namelen + 1, strlen(attrname + namelen + 1));
+   }
+   PutBinaryLength(out, nsindx);
+
+   std::size_t nchilds = 0;
+   for (SXmlNode_t *child = node->fChild; child; child = child->fNext)
+      ++nchilds;
+   PutBinaryLength(out, nchilds);
+   for (SXmlNode_t *child = node->fChild; child; child = child->fNext)
+      SaveBinaryNode(child, out);
+}
+
+} // namespace
+
 class TXMLOutputStream {
 protected:
    std::ostream *fOut{nullptr};
@@ -1320,6 +1395,31 @@ void TXMLEngine::SaveDoc(XMLDocPointer_t xmldoc, const char *filename, Int_t lay
    } while (child);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// store document content to file in compact binary form
+/// Names, attributes and contents are written as length-prefixed strings,
+/// therefore reading such file back with ParseFile() requires neither
+/// tokenization nor unpacking of special characters. ParseFile() detects the
+/// binary form automatically, the produced document is identical to the
+/// one which was saved.
+
+void TXMLEngine::SaveBinaryDoc(XMLDocPointer_t xmldoc, const char *filename)
+{
+   if (!xmldoc || !filename || !*filename)
+      return;
+
+   SXmlDoc_t *doc = (SXmlDoc_t *)xmldoc;
+
+   std::string out(gBinaryMagic, gBinaryMagicLen);
+   PutBinaryString(out, doc->fDtdName ? doc->fDtdName : "", doc->fDtdName ? strlen(doc->fDtdName) : 0);
+   PutBinaryString(out, doc->fDtdRoot ? doc->fDtdRoot : "", doc->fDtdRoot ? strlen(doc->fDtdRoot) : 0);
+   SaveBinaryNode(doc->fRootNode, out);
+
+   std::ofstream fout(filename, std::ios::binary);
+   if (!fout.write(out.data(), out.size()))
+      Error("SaveBinaryDoc", "Fail to write file %s", filename);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// set main (root) node for document
 
@@ -1357,6 +1457,23 @@ XMLDocPointer_t TXMLEngine::ParseFile(const char *filename, Int_t maxbuf)
 {
    if (!filename || !*filename)
       return nullptr;
+
+   {
+      // documents stored with SaveBinaryDoc() are read with a single bulk read
+      std::ifstream fin(filename, std::ios::binary);
+      char magic[gBinaryMagicLen];
+      if (fin.read(magic, gBinaryMagicLen) && !memcmp(magic, gBinaryMagic, gBinaryMagicLen)) {
+         fin.seekg(0, std::ios::end);
+         std::string buf(std::size_t(fin.tellg()), '\0');
+         fin.seekg(0, std::ios::beg);
+         if (!fin.read(&buf[0], buf.size())) {
+            Error("ParseFile", "Fail to read binary xml file %s", filename);
+            return nullptr;
+         }
+         return ParseBinaryBuffer(buf.data(), buf.size());
+      }
+   }
+
    if (maxbuf < 100000)
       maxbuf = 100000;
    TXMLInputStream inp(true, filename, maxbuf);
@@ -1414,6 +1531,42 @@ XMLDocPointer_t TXMLEngine::ParseStream(TXMLInputStream *inp)
    return xmldoc;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// produces xml structures from buffer written by SaveBinaryDoc()
+
+XMLDocPointer_t TXMLEngine::ParseBinaryBuffer(const char *buf, std::size_t len)
+{
+   if (!buf || (len < gBinaryMagicLen) || memcmp(buf, gBinaryMagic, gBinaryMagicLen))
+      return nullptr;
+
+   const char *curr = buf + gBinaryMagicLen, *end = buf + len;
+
+   SXmlDoc_t *doc = new SXmlDoc_t;
+   doc->fRootNode = nullptr;
+   doc->fDtdName = nullptr;
+   doc->fDtdRoot = nullptr;
+
+   const char *str = nullptr;
+   std::size_t slen = 0;
+   Bool_t success = GetBinaryString(curr, end, str, slen);
+   if (success)
+      doc->fDtdName = Makenstr(str, slen);
+   success = success && GetBinaryString(curr, end, str, slen);
+   if (success)
+      doc->fDtdRoot = Makenstr(str, slen);
+
+   if (success)
+      doc->fRootNode = (SXmlNode_t *)ReadBinaryNode(nullptr, curr, end);
+
+   if (!doc->fRootNode || (curr != end)) {
+      Error("ParseFile", "Corrupted binary xml document");
+      FreeDoc((XMLDocPointer_t)doc);
+      return nullptr;
+   }
+
+   return (XMLDocPointer_t)doc;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// check that first node is xml processing instruction with correct xml version number
 
@@ -2217,6 +2370,66 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
    return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Creates node with all its attributes and children from the binary
+/// representation, written by SaveBinaryDoc(). Returns nullptr if data are corrupted
+
+XMLNodePointer_t TXMLEngine::ReadBinaryNode(XMLNodePointer_t xmlparent, const char *&curr, const char *end)
+{
+   if (curr >= end)
+      return nullptr;
+   Int_t type = (unsigned char)*curr++;
+   if ((type < kXML_NODE) || (type > kXML_CONTENT))
+      return nullptr;
+
+   const char *name = nullptr;
+   std::size_t namelen = 0;
+   if (!GetBinaryString(curr, end, name, namelen))
+      return nullptr;
+
+   SXmlNode_t *node = (SXmlNode_t *)AllocateNode(namelen, nullptr);
+   node->fType = (EXmlNodeType)type;
+   memcpy(SXmlNode_t::Name(node), name, namelen);
+   SXmlNode_t::Name(node)[namelen] = 0;
+
+   Bool_t success = kTRUE;
+   std::size_t nattr = 0, nsindx = 0, nchilds = 0;
+   success = GetBinaryLength(curr, end, nattr);
+   for (std::size_t n = 0; success && (n < nattr); ++n) {
+      const char *value = nullptr;
+      std::size_t valuelen = 0;
+      success = GetBinaryString(curr, end, name, namelen) && GetBinaryString(curr, end, value, valuelen);
+      if (success) {
+         char *attrname = SXmlAttr_t::Name(AllocateAttr(namelen, valuelen, (XMLNodePointer_t)node));
+         memcpy(attrname, name, namelen);
+         attrname[namelen] = 0;
+         memcpy(attrname + namelen + 1, value, valuelen);
+         attrname[namelen + 1 + valuelen] = 0;
+      }
+   }
+
+   success = success && GetBinaryLength(curr, end, nsindx) && (nsindx <= nattr);
+   if (success && (nsindx > 0)) {
+      node->fNs = node->fAttr;
+      while (--nsindx > 0)
+         node->fNs = node->fNs->fNext;
+   }
+
+   success = success && GetBinaryLength(curr, end, nchilds);
+   for (std::size_t n = 0; success && (n < nchilds); ++n)
+      success = ReadBinaryNode((XMLNodePointer_t)node, curr, end) != nullptr;
+
+   if (!success) {
+      FreeNode((XMLNodePointer_t)node);
+      return nullptr;
+   }
+
+   if (xmlparent)
+      AddChild(xmlparent, (XMLNodePointer_t)node);
+
+   return (XMLNodePointer_t)node;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Displays xml parsing error
 
@@ -40,7 +40,9 @@ def get_argparse():
         "Explicitly set the verbosity level: 0 request no output, 99 is the default"))
     parser.add_argument("-j", help=textwrap.fill(
         "Parallelize the execution in 'J' processes. If the number of "
-        "processes is not specified, use the system maximum."))
+        "processes is not specified, use the system maximum. If there are "
+        "fewer groups of 3 input files than processes, the objects of each "
+        "group are also split by name across processes."))
     parser.add_argument("-dbg", help=textwrap.fill(
         "Enable verbosity. If -j was specified, do not not delete partial files "
         "stored inside working directory."), action = 'store_true')
@@ -28,6 +28,8 @@
   \param -T   Do not merge Trees
   \param -v   Explicitly set the verbosity level: 0 request no output, 99 is the default
   \param -j   Parallelise the execution in `J` processes. If the number of processes is not specified, use the system maximum.
+              The input files are split into groups of at least 3 files; if there are fewer groups than processes,
+              the objects of each group are further split by name across the remaining processes.
   \param -dbg Enable verbosity. If -j was specified, do not not delete partial files stored inside working directory.
   \param -d   Carry out the partial multiprocess execution in the specified directory
   \param -n   Open at most `N` files at once (use 0 to request to use the system maximum)
@@ -104,6 +106,7 @@
 #include "ROOT/StringConv.hxx"
 #include "snprintf.h"
 
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -449,15 +452,24 @@ int main( int argc, char **argv )
    }
 
    auto step = (allSubfiles.size() + nProcesses - 1) / nProcesses;
+   // Number of disjoint subsets of the object names, each merged by its own process
+   Int_t nKeySlices = 1;
    if (multiproc && step < 3) {
       // At least 3 files per process
       step = 3;
-      nProcesses = (allSubfiles.size() + step - 1) / step;
+      const Int_t nGroups = (allSubfiles.size() + step - 1) / step;
+      // Use the remaining processes to split the objects of every group of files.
+      nKeySlices = std::max(1, nProcesses / nGroups);
+      nProcesses = nGroups * nKeySlices;
       std::cout << "Each process should handle at least 3 files for efficiency.";
-      std::cout << " Setting the number of processes to: " << nProcesses << std::endl;
+      std::cout << " Setting the number of processes to: " << nProcesses;
+      if (nKeySlices > 1)
+         std::cout << " (" << nGroups << " groups of files, " << nKeySlices << " subsets of objects each)";
+      std::cout << std::endl;
    }
    if (nProcesses == 1)
       multiproc = kFALSE;
+   const Int_t nGroups = (allSubfiles.size() + step - 1) / step;
 
    std::vector<std::string> partialFiles;
 
@@ -468,7 +480,7 @@ int main( int argc, char **argv )
    if (multiproc) {
       auto uuid = TUUID();
       auto partialTail = uuid.AsString();
-      for (auto i = 0; (i * step) < allSubfiles.size(); i++) {
+      for (auto i = 0; i < nGroups * nKeySlices; i++) {
          std::stringstream buffer;
          buffer << workingDir << "/partial" << i << "_" << partialTail << ".root";
          partialFiles.emplace_back(buffer.str());
@@ -511,18 +523,19 @@ int main( int argc, char **argv )
       return mergeFiles(merger);
    };
 
-   auto parallelMerge = [&](int start) {
+   auto parallelMerge = [&](int task) {
       TFileMerger mergerP(kFALSE, kFALSE);
       mergerP.SetMsgPrefix("hadd");
       mergerP.SetPrintLevel(verbosity - 1);
       if (maxopenedfiles > 0) {
          mergerP.SetMaxOpenedFiles(maxopenedfiles / nProcesses);
       }
-      if (!mergerP.OutputFile(partialFiles[start / step].c_str(), newcomp)) {
+      mergerP.SetKeySlice(task % nKeySlices, nKeySlices);
+      if (!mergerP.OutputFile(partialFiles[task].c_str(), newcomp)) {
          std::cerr << "hadd error opening target partial file" << std::endl;
          exit(1);
       }
-      return sequentialMerge(mergerP, start, step);
+      return sequentialMerge(mergerP, (task / nKeySlices) * step, step);
    };
 
    auto reductionFunc = [&]() {
@@ -537,7 +550,7 @@ int main( int argc, char **argv )
 #ifndef R__WIN32
    if (multiproc) {
       ROOT::TProcessExecutor p(nProcesses);
-      auto res = p.Map(parallelMerge, ROOT::TSeqI(0, allSubfiles.size(), step));
+      auto res = p.Map(parallelMerge, ROOT::TSeqI(0, partialFiles.size()));
       status = std::accumulate(res.begin(), res.end(), 0U) == partialFiles.size();
       if (status) {
          status = reductionFunc();
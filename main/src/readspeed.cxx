@@ -11,6 +11,9 @@
 #include "ReadSpeedCLI.hxx"
 #include "ReadSpeed.hxx"
 
+#include <fstream>
+#include <iostream>
+
 using namespace ReadSpeed;
 
 int main(int argc, char **argv)
@@ -20,7 +23,21 @@ int main(int argc, char **argv)
    if (!args.fShouldRun)
       return 1; // ParseArgs has printed the --help, has run the --test or has encountered an issue and logged about it
 
-   PrintThroughput(EvalThroughput(args.fData, args.fNThreads));
+   const auto results = EvalThroughputSweep(args.fData, args.fSweep);
+   for (std::size_t i = 0; i < results.size(); ++i) {
+      if (i > 0)
+         std::cout << '\n';
+      PrintThroughput(results[i]);
+   }
+
+   if (!args.fJSONFileName.empty()) {
+      std::ofstream json(args.fJSONFileName);
+      if (!json) {
+         std::cerr << "Could not open '" << args.fJSONFileName << "' for writing\n";
+         return 1;
+      }
+      WriteJSON(args.fData, results, json);
+   }
 
    return 0;
 }
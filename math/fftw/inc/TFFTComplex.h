@@ -28,7 +28,7 @@ protected:
    Int_t     fSign;      //sign of the exponent of the transform (-1 is FFTW_FORWARD and +1 FFTW_BACKWARD)
    TString   fFlags;     //transform flags
 
-   UInt_t MapFlag(Option_t *flag);
+   static UInt_t MapFlag(Option_t *flag);
 
 public:
    TFFTComplex();
@@ -62,6 +62,8 @@ public:
    void       SetPointsComplex(const Double_t *re, const Double_t *im) override;
    void       Transform() override;
 
+   static void TransformMany(Int_t n, Int_t howmany, const Double_t *in, Double_t *out, Int_t sign = -1, Option_t *flags = "ES");
+
    ClassDefOverride(TFFTComplex,0);
 };
 
@@ -27,7 +27,7 @@ class TFFTRealComplex: public TVirtualFFT {
    Int_t    *fN;         //transform sizes in each dimension
    TString   fFlags;     //transform flags
 
-   UInt_t MapFlag(Option_t *flag);
+   static UInt_t MapFlag(Option_t *flag);
 
  public:
    TFFTRealComplex();
@@ -61,6 +61,8 @@ class TFFTRealComplex: public TVirtualFFT {
    void       SetPointsComplex(const Double_t *re, const Double_t *im) override;
    void       Transform() override;
 
+   static void TransformMany(Int_t n, Int_t howmany, const Double_t *in, Double_t *out, Option_t *flags = "ES");
+
    ClassDefOverride(TFFTRealComplex,0);
 };
 
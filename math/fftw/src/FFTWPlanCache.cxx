@@ -0,0 +1,66 @@
+// @(#)root/fft:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "FFTWPlanCache.h"
+#include "fftw3.h"
+#include "TROOT.h"
+
+#include <map>
+#include <mutex>
+
+namespace {
+
+std::mutex &GetPlanMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+std::map<std::vector<Long64_t>, void *> &GetPlans()
+{
+   static std::map<std::vector<Long64_t>, void *> plans;
+   return plans;
+}
+
+/// Number of threads used by the plans of transforms of size points
+int GetPlanThreads(Long64_t size)
+{
+#ifdef R__HAS_FFTW_THREADS
+   if (size >= ROOT::Internal::FFTW::kThreadedSize && ROOT::IsImplicitMTEnabled())
+      return ROOT::GetThreadPoolSize();
+#else
+   (void)size;
+#endif
+   return 1;
+}
+
+} // anonymous namespace
+
+void *ROOT::Internal::FFTW::GetPlan(std::vector<Long64_t> key, Long64_t size, const std::function<void *()> &create)
+{
+   const int nthreads = GetPlanThreads(size);
+   key.push_back(nthreads);
+
+   std::lock_guard<std::mutex> lock(GetPlanMutex());
+   auto &plans = GetPlans();
+   auto it = plans.find(key);
+   if (it != plans.end())
+      return it->second;
+
+#ifdef R__HAS_FFTW_THREADS
+   static const bool threadsInitialized = fftw_init_threads();
+   if (threadsInitialized)
+      fftw_plan_with_nthreads(nthreads);
+#endif
+   void *plan = create();
+   if (plan)
+      plans.emplace(std::move(key), plan);
+   return plan;
+}
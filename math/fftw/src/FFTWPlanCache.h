@@ -0,0 +1,46 @@
+// @(#)root/fft:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_FFTWPlanCache
+#define ROOT_FFTWPlanCache
+
+#include "Rtypes.h"
+
+#include <functional>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace FFTW {
+
+/// Type of transform, first element of the plan keys
+enum EPlanType { kC2C, kC2R, kR2C, kR2R, kC2CMany, kR2CMany };
+
+/// Minimal number of points of a transform for its plan to use the FFTW threads
+constexpr Long64_t kThreadedSize = 1 << 16;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the fftw plan identified by key, creating it with create() the first
+/// time it is requested. The key must describe everything the plan depends on
+/// (type, sizes, kinds, flags, in-place or not); size is the number of points of
+/// the transform and decides whether the plan is multithreaded.
+///
+/// Plans are shared by all the transform objects and kept until the end of the
+/// process. The fftw planner is not thread-safe, so create() is called with a
+/// lock held; the returned plan can be executed concurrently on different arrays
+/// with the fftw_execute_dft/_r2c/_c2r/_r2r functions.
+
+void *GetPlan(std::vector<Long64_t> key, Long64_t size, const std::function<void *()> &create);
+
+} // namespace FFTW
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -42,6 +42,7 @@
 #include "TFFTComplex.h"
 #include "fftw3.h"
 #include "TComplex.h"
+#include "FFTWPlanCache.h"
 
 
 ClassImp(TFFTComplex);
@@ -102,13 +103,11 @@ TFFTComplex::TFFTComplex(Int_t ndim, Int_t *n, Bool_t inPlace)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays. The plan stays in the plan cache until the end of the
+///session, and is reused by the other transforms of the same size and type
 
 TFFTComplex::~TFFTComplex()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = nullptr;
    fftw_free((fftw_complex*)fIn);
    if (fOut)
@@ -136,20 +135,57 @@ TFFTComplex::~TFFTComplex()
 ///This option should be chosen depending on how many transforms of the same size and
 ///type are going to be done. Planning is only done once, for the first transform of this
 ///size and type.
+///
+///The plans are shared by all the transforms of the same size, type and flags, so Init()
+///only plans (and overwrites the arrays) the first time. With implicit multithreading
+///enabled, transforms of at least 2^16 points use multithreaded plans, provided ROOT is
+///linked against the fftw3_threads library.
 
 void TFFTComplex::Init( Option_t *flags, Int_t sign,const Int_t* /*kind*/)
 {
    fSign = sign;
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
-   fPlan = nullptr;
+   const UInt_t flag = MapFlag(flags);
+   std::vector<Long64_t> key{ROOT::Internal::FFTW::kC2C, fNdim, sign, flag, fOut == nullptr};
+   key.insert(key.end(), fN, fN + fNdim);
+   fPlan = ROOT::Internal::FFTW::GetPlan(key, fTotalSize, [&]() -> void * {
+      fftw_complex *out = fOut ? (fftw_complex*)fOut : (fftw_complex*)fIn;
+      return fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, out, sign, flag);
+   });
+}
 
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, (fftw_complex*)fOut, sign,MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, (fftw_complex*)fIn, sign, MapFlag(flags));
+////////////////////////////////////////////////////////////////////////////////
+///Computes howmany 1-dimensional transforms of size n with a single fftw plan.
+///The howmany input (and output) sequences are stored one after the other in the
+///arrays in and out, each point as a (re, im) pair; out may be equal to in for an
+///in-place transform, and in is not modified otherwise. The arrays don't need to be
+///allocated by fftw. sign and flags have the same meaning as in Init(), the plan is
+///created by the first call and reused by the following ones with the same parameters.
+
+void TFFTComplex::TransformMany(Int_t n, Int_t howmany, const Double_t *in, Double_t *out, Int_t sign, Option_t *flags)
+{
+   if (n <= 0 || howmany <= 0)
+      return;
+   const UInt_t flag = MapFlag(flags) | FFTW_UNALIGNED;
+   const Bool_t inPlace = (in == out);
+   const Long64_t size = Long64_t(n) * howmany;
+   void *plan = ROOT::Internal::FFTW::GetPlan({ROOT::Internal::FFTW::kC2CMany, n, howmany, sign, flag, inPlace}, size,
+                                              [&]() -> void * {
+      // planning may overwrite the arrays, use scratch ones
+      fftw_complex *a = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * size);
+      fftw_complex *b = inPlace ? a : (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * size);
+      void *p = (void*)fftw_plan_many_dft(1, &n, howmany, a, nullptr, 1, n, b, nullptr, 1, n, sign, flag);
+      if (b != a)
+         fftw_free(b);
+      fftw_free(a);
+      return p;
+   });
+   if (!plan) {
+      ::Error("TFFTComplex::TransformMany", "cannot create the fftw plan");
+      return;
+   }
+   fftw_execute_dft((fftw_plan)plan, (fftw_complex*)const_cast<Double_t*>(in), (fftw_complex*)out);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -158,7 +194,7 @@ void TFFTComplex::Init( Option_t *flags, Int_t sign,const Int_t* /*kind*/)
 void TFFTComplex::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft((fftw_plan)fPlan, (fftw_complex*)fIn, fOut ? (fftw_complex*)fOut : (fftw_complex*)fIn);
    else {
       Error("Transform", "transform not initialised");
       return;
@@ -44,6 +44,7 @@
 #include "TFFTComplexReal.h"
 #include "fftw3.h"
 #include "TComplex.h"
+#include "FFTWPlanCache.h"
 
 
 ClassImp(TFFTComplexReal);
@@ -108,13 +109,11 @@ TFFTComplexReal::TFFTComplexReal(Int_t ndim, Int_t *n, Bool_t inPlace)
 
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays. The plan stays in the plan cache until the end of the
+///session, and is reused by the other transforms of the same size and type
 
 TFFTComplexReal::~TFFTComplexReal()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = nullptr;
    fftw_free((fftw_complex*)fIn);
    if (fOut)
@@ -144,19 +143,23 @@ TFFTComplexReal::~TFFTComplexReal()
 ///This option should be chosen depending on how many transforms of the same size and
 ///type are going to be done. Planning is only done once, for the first transform of this
 ///size and type.
+///
+///The plans are shared by all the transforms of the same size, type and flags, so Init()
+///only plans (and overwrites the arrays) the first time. With implicit multithreading
+///enabled, transforms of at least 2^16 points use multithreaded plans, provided ROOT is
+///linked against the fftw3_threads library.
 
 void TFFTComplexReal::Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*/)
 {
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
-   fPlan = nullptr;
-
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN,(fftw_complex*)fIn,(Double_t*)fOut, MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN, (fftw_complex*)fIn, (Double_t*)fIn, MapFlag(flags));
+   const UInt_t flag = MapFlag(flags);
+   std::vector<Long64_t> key{ROOT::Internal::FFTW::kC2R, fNdim, flag, fOut == nullptr};
+   key.insert(key.end(), fN, fN + fNdim);
+   fPlan = ROOT::Internal::FFTW::GetPlan(key, fTotalSize, [&]() -> void * {
+      Double_t *out = fOut ? (Double_t*)fOut : (Double_t*)fIn;
+      return fftw_plan_dft_c2r(fNdim, fN, (fftw_complex*)fIn, out, flag);
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -165,7 +168,7 @@ void TFFTComplexReal::Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*
 void TFFTComplexReal::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft_c2r((fftw_plan)fPlan, (fftw_complex*)fIn, fOut ? (Double_t*)fOut : (Double_t*)fIn);
    else {
       Error("Transform", "transform was not initialized");
       return;
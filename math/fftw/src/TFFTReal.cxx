@@ -60,6 +60,7 @@
 
 #include "TFFTReal.h"
 #include "fftw3.h"
+#include "FFTWPlanCache.h"
 
 ClassImp(TFFTReal);
 
@@ -119,11 +120,10 @@ TFFTReal::TFFTReal(Int_t ndim, Int_t *n, Bool_t inPlace)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///clean-up
+///clean-up. The plan stays in the plan cache until the end of the session
 
 TFFTReal::~TFFTReal()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = nullptr;
    fftw_free(fIn);
    fIn = nullptr;
@@ -158,6 +158,11 @@ TFFTReal::~TFFTReal()
 ///  type are going to be done. Planning is only done once, for the first transform of this
 ///  size and type.
 ///
+///  The plans are shared by all the transforms of the same size, kinds and flags, so Init()
+///  only plans (and overwrites the arrays) the first time. With implicit multithreading
+///  enabled, transforms of at least 2^16 points use multithreaded plans, provided ROOT is
+///  linked against the fftw3_threads library.
+///
 /// #### 2nd parameter:
 ///    is dummy and doesn't need to be specified
 ///
@@ -175,18 +180,20 @@ TFFTReal::~TFFTReal()
 
 void TFFTReal::Init( Option_t* flags,Int_t /*sign*/, const Int_t *kind)
 {
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = nullptr;
 
    if (!fKind)
       fKind = (fftw_r2r_kind*)fftw_malloc(sizeof(fftw_r2r_kind)*fNdim);
 
    if (MapOptions(kind)){
-      if (fOut)
-         fPlan = (void*)fftw_plan_r2r(fNdim, fN, (Double_t*)fIn, (Double_t*)fOut, (fftw_r2r_kind*)fKind, MapFlag(flags));
-      else
-         fPlan = (void*)fftw_plan_r2r(fNdim, fN, (Double_t*)fIn, (Double_t*)fIn, (fftw_r2r_kind*)fKind, MapFlag(flags));
+      const UInt_t flag = MapFlag(flags);
+      std::vector<Long64_t> key{ROOT::Internal::FFTW::kR2R, fNdim, flag, fOut == nullptr};
+      key.insert(key.end(), fN, fN + fNdim);
+      key.insert(key.end(), (fftw_r2r_kind*)fKind, (fftw_r2r_kind*)fKind + fNdim);
+      fPlan = ROOT::Internal::FFTW::GetPlan(key, fTotalSize, [&]() -> void * {
+         Double_t *out = fOut ? (Double_t*)fOut : (Double_t*)fIn;
+         return fftw_plan_r2r(fNdim, fN, (Double_t*)fIn, out, (fftw_r2r_kind*)fKind, flag);
+      });
       fFlags = flags;
    }
 }
@@ -197,7 +204,7 @@ void TFFTReal::Init( Option_t* flags,Int_t /*sign*/, const Int_t *kind)
 void TFFTReal::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_r2r((fftw_plan)fPlan, (Double_t*)fIn, fOut ? (Double_t*)fOut : (Double_t*)fIn);
    else {
       Error("Transform", "transform hasn't been initialised");
       return;
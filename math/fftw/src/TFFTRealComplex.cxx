@@ -45,6 +45,7 @@
 #include "TFFTRealComplex.h"
 #include "fftw3.h"
 #include "TComplex.h"
+#include "FFTWPlanCache.h"
 
 
 ClassImp(TFFTRealComplex);
@@ -112,13 +113,11 @@ TFFTRealComplex::TFFTRealComplex(Int_t ndim, Int_t *n, Bool_t inPlace)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays. The plan stays in the plan cache until the end of the
+///session, and is reused by the other transforms of the same size and type
 
 TFFTRealComplex::~TFFTRealComplex()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = nullptr;
    fftw_free(fIn);
    fIn = nullptr;
@@ -148,19 +147,55 @@ TFFTRealComplex::~TFFTRealComplex()
 ///This option should be chosen depending on how many transforms of the same size and
 ///type are going to be done. Planning is only done once, for the first transform of this
 ///size and type.
+///
+///The plans are shared by all the transforms of the same size, type and flags, so Init()
+///only plans (and overwrites the arrays) the first time. With implicit multithreading
+///enabled, transforms of at least 2^16 points use multithreaded plans, provided ROOT is
+///linked against the fftw3_threads library.
 
 void TFFTRealComplex::Init(Option_t *flags,Int_t /*sign*/, const Int_t* /*kind*/)
 {
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
-   fPlan = nullptr;
+   const UInt_t flag = MapFlag(flags);
+   std::vector<Long64_t> key{ROOT::Internal::FFTW::kR2C, fNdim, flag, fOut == nullptr};
+   key.insert(key.end(), fN, fN + fNdim);
+   fPlan = ROOT::Internal::FFTW::GetPlan(key, fTotalSize, [&]() -> void * {
+      fftw_complex *out = fOut ? (fftw_complex*)fOut : (fftw_complex*)fIn;
+      return fftw_plan_dft_r2c(fNdim, fN, (Double_t*)fIn, out, flag);
+   });
+}
 
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft_r2c(fNdim, fN, (Double_t*)fIn, (fftw_complex*)fOut,MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft_r2c(fNdim, fN, (Double_t*)fIn, (fftw_complex*)fIn, MapFlag(flags));
+////////////////////////////////////////////////////////////////////////////////
+///Computes howmany 1-dimensional transforms of n real points with a single fftw plan.
+///The howmany input sequences are stored one after the other in the array in, and the
+///n/2+1 complex points of each output sequence, as (re, im) pairs, one after the other
+///in the array out (of size 2*howmany*(n/2+1)). The arrays must not overlap and don't
+///need to be allocated by fftw; in is not modified. flags has the same meaning as in
+///Init(), the plan is created by the first call and reused by the following ones with
+///the same parameters.
+
+void TFFTRealComplex::TransformMany(Int_t n, Int_t howmany, const Double_t *in, Double_t *out, Option_t *flags)
+{
+   if (n <= 0 || howmany <= 0)
+      return;
+   const UInt_t flag = MapFlag(flags) | FFTW_UNALIGNED;
+   const Int_t nout = n / 2 + 1;
+   void *plan = ROOT::Internal::FFTW::GetPlan({ROOT::Internal::FFTW::kR2CMany, n, howmany, flag},
+                                              Long64_t(n) * howmany, [&]() -> void * {
+      // planning may overwrite the arrays, use scratch ones
+      Double_t *a = (Double_t*)fftw_malloc(sizeof(Double_t) * n * howmany);
+      fftw_complex *b = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * nout * howmany);
+      void *p = (void*)fftw_plan_many_dft_r2c(1, &n, howmany, a, nullptr, 1, n, b, nullptr, 1, nout, flag);
+      fftw_free(b);
+      fftw_free(a);
+      return p;
+   });
+   if (!plan) {
+      ::Error("TFFTRealComplex::TransformMany", "cannot create the fftw plan");
+      return;
+   }
+   fftw_execute_dft_r2c((fftw_plan)plan, const_cast<Double_t*>(in), (fftw_complex*)out);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -170,7 +205,7 @@ void TFFTRealComplex::Transform()
 {
 
    if (fPlan){
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft_r2c((fftw_plan)fPlan, (Double_t*)fIn, fOut ? (fftw_complex*)fOut : (fftw_complex*)fIn);
    }
    else {
       Error("Transform", "transform hasn't been initialised");
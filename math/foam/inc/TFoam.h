@@ -72,6 +72,12 @@ protected:
    Double_t fMCerror;         ///< and its error
 
    Double_t *fAlpha;          ///< [fDim] Internal parameters of the hyper-rectangle
+   Int_t     fBatchSize = 0;  ///<! Number of points evaluated at once in the cell exploration, 0 for one by one
+
+   void EvalBatch(Int_t n, const Double_t *x, Double_t *rho);  // Evaluates the distribution at n points
+   TFoamCell *PickCell(Double_t random) const;                  // Active cell for a uniform random number
+   template <class Rndm>
+   Double_t GenerateWith(Rndm &rndm, Double_t *MCvect) const;  // Generates one event, leaving the FOAM unchanged
 
 public:
    TFoam();                          // Default constructor (used only by ROOT streamer)
@@ -99,6 +105,8 @@ public:
    virtual void     GetMCwt(Double_t &);     // Provides generated MC weight
    virtual Double_t GetMCwt();               // Provides generates MC weight
    virtual Double_t MCgenerate(Double_t *MCvect);// All three above function in one
+   Double_t GenerateEvent(TRandom &rng, Double_t *MCvect) const; // Thread-safe generation with the user's generator
+   void     GenerateEvents(Long64_t nev, Double_t *MCvects, Double_t *MCwts, ULong64_t seed) const; // Parallel generation
    // Finalization
    virtual void GetIntegMC(Double_t&, Double_t&);// Provides Integrand and abs. error from MC run
    virtual void GetIntNorm(Double_t&, Double_t&);// Provides normalization Inegrand
@@ -116,6 +124,7 @@ public:
    virtual void SetnCells(Long_t nCells){fNCells =nCells;}  // Sets maximum number of cells
    virtual void SetnSampl(Long_t nSampl){fNSampl =nSampl;}  // Sets no of MC events in cell exploration
    virtual void SetnBin(Int_t nBin){fNBin = nBin;}          // Sets no of bins in histogs in cell exploration
+   virtual void SetBatchSize(Int_t n){fBatchSize = n;}      // Sets no of points evaluated at once in cell exploration
    virtual void SetChat(Int_t Chat){fChat = Chat;}          // Sets option Chat, chat level
    virtual void SetOptRej(Int_t OptRej){fOptRej =OptRej;}   // Sets option for MC rejection
    virtual void SetOptDrive(Int_t OptDrive){fOptDrive =OptDrive;}  // Sets optimization switch
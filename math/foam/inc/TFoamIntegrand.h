@@ -5,12 +5,16 @@
 #define ROOT_TFoamIntegrand
 
 #include "TObject.h"
+#include "ROOT/RSpan.hxx"
 
 class TFoamIntegrand : public TObject  {
 public:
    TFoamIntegrand() { };
    ~TFoamIntegrand() override { };
    virtual Double_t Density(Int_t ndim, Double_t *) = 0;
+   virtual void DensityBatch(Int_t ndim, std::span<const Double_t> x, std::span<Double_t> rho);
+   /// Whether Density() and DensityBatch() may be called concurrently from several threads
+   virtual Bool_t IsThreadSafe() const { return kFALSE; }
 
    ClassDefOverride(TFoamIntegrand,1); //n-dimensional real positive integrand of FOAM
 };
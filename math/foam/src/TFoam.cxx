@@ -90,6 +90,16 @@ S. Jadach, Computer Physics Communications 152 (2003) 55.
 #include "TRandom.h"
 #include "TMath.h"
 #include "TInterpreter.h"
+#include "TROOT.h"
+#include "Math/RandomStreams.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
 
 ClassImp(TFoam);
 
@@ -557,17 +567,44 @@ void TFoam::Explore(TFoamCell *cell)
    for(i=0;i<fDim;i++) ((TH1D *)(*fHistEdg)[i])->Reset(); // Reset histograms
    fHistWt->Reset();
    //
+   // In batch mode the points are generated and evaluated by blocks of fBatchSize,
+   // the points of the last block beyond the exit condition are not used.
+   Int_t nBatch = (fBatchSize>0 && fRho && fDim>0) ? fBatchSize : 0;
+   std::vector<Double_t> alphaBatch, xBatch, rhoBatch;
+   Int_t iBatch=0, nInBatch=0;
    // ||||||||||||||||||||||||||BEGIN MC LOOP|||||||||||||||||||||||||||||
    Double_t nevEff=0.;
    for(iev=0;iev<fNSampl;iev++){
-      MakeAlpha();               // generate uniformly vector inside hypercube
+      if(nBatch>0) {
+         if(iBatch==nInBatch) {
+            nInBatch = (Int_t)TMath::Min((Long_t)nBatch, fNSampl-iev);
+            alphaBatch.resize(nInBatch*fDim);
+            xBatch.resize(nInBatch*fDim);
+            rhoBatch.resize(nInBatch);
+            for(Int_t ib=0; ib<nInBatch; ib++) {
+               MakeAlpha();
+               for(j=0; j<fDim; j++) {
+                  alphaBatch[ib*fDim+j]= fAlpha[j];
+                  xBatch[ib*fDim+j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+               }
+            }
+            EvalBatch(nInBatch, xBatch.data(), rhoBatch.data());
+            iBatch=0;
+         }
+         for(j=0; j<fDim; j++)
+            fAlpha[j]= alphaBatch[iBatch*fDim+j];
+         wt=dx*rhoBatch[iBatch];
+         iBatch++;
+      } else {
+         MakeAlpha();               // generate uniformly vector inside hypercube
 
-      if(fDim>0){
-      for(j=0; j<fDim; j++)
-         xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
-      }
+         if(fDim>0){
+         for(j=0; j<fDim; j++)
+            xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+         }
 
-      wt=dx*Eval(xRand);
+         wt=dx*Eval(xRand);
+      }
 
       nProj = 0;
       if(fDim>0) {
@@ -1076,18 +1113,53 @@ Double_t TFoam::Eval(Double_t *xRand)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal method.
+/// Evaluates the distribution at the n points x, stored one after the other,
+/// in one call of TFoamIntegrand::DensityBatch. If the integrand is thread-safe
+/// and implicit multithreading is enabled, the points are split among the threads.
+
+void TFoam::EvalBatch(Int_t n, const Double_t *x, Double_t *rho)
+{
+#ifdef R__USE_IMT
+   if (fRho->IsThreadSafe() && ROOT::IsImplicitMTEnabled() && n > 1) {
+      ROOT::TThreadExecutor pool;
+      const Int_t nPool = pool.GetPoolSize();
+      const Int_t chunk = (n + nPool - 1) / nPool;
+      const Int_t nChunks = (n + chunk - 1) / chunk;
+      pool.Foreach([&](Int_t ic) {
+         const Int_t first = ic * chunk;
+         const Int_t m = TMath::Min(chunk, n - first);
+         fRho->DensityBatch(fDim, std::span<const Double_t>(x + first * fDim, m * fDim),
+                            std::span<Double_t>(rho + first, m));
+      }, ROOT::TSeqI(nChunks));
+      return;
+   }
+#endif
+   fRho->DensityBatch(fDim, std::span<const Double_t>(x, n * fDim), std::span<Double_t>(rho, n));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal method.
 /// Return randomly chosen active cell with probability equal to its
 /// contribution into total driver integral using interpolation search.
 
 void TFoam::GenerCel2(TFoamCell *&pCell)
+{
+   pCell = PickCell(fPseRan->Rndm());
+}       // TFoam::GenerCel2
+
+////////////////////////////////////////////////////////////////////////////////
+/// Internal method.
+/// Return the active cell corresponding to the uniform random number random,
+/// the probability of a cell being equal to its contribution into total driver
+/// integral, using interpolation search.
+
+TFoamCell *TFoam::PickCell(Double_t random) const
 {
    Long_t  lo, hi, hit;
    Double_t fhit, flo, fhi;
-   Double_t random;
 
-   random=fPseRan->Rndm();
    lo  = 0;              hi =fNoAct-1;
    flo = fPrimAcu[lo];  fhi=fPrimAcu[hi];
    while(lo+1<hi) {
@@ -1106,10 +1178,10 @@ void TFoam::GenerCel2(TFoamCell *&pCell)
       }
    }
    if (fPrimAcu[lo]>random)
-      pCell = getCell(fCellsAct[lo]);
+      return getCell(fCellsAct[lo]);
    else
-      pCell = getCell(fCellsAct[hi]);
-}       // TFoam::GenerCel2
+      return getCell(fCellsAct[hi]);
+}       // TFoam::PickCell
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1199,6 +1271,89 @@ Double_t TFoam::MCgenerate(Double_t *MCvect)
    return(fMCwt);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal method.
+/// Generates one event like MakeEvent(), drawing the random numbers with
+/// rndm(), without modifying the FOAM: the MC statistics are not accumulated.
+/// Returns the MC weight.
+
+template <class Rndm>
+Double_t TFoam::GenerateWith(Rndm &rndm, Double_t *MCvect) const
+{
+   TFoamVect  cellPosi(fDim); TFoamVect  cellSize(fDim);
+   while (true) {
+      TFoamCell *rCell = PickCell(rndm());
+      rCell->GetHcub(cellPosi,cellSize);
+      for(Int_t j=0; j<fDim; j++)
+         MCvect[j]= cellPosi[j] +rndm()*cellSize[j];
+      Double_t mcwt = rCell->GetVolume()*fRho->Density(fDim,MCvect) / rCell->GetPrim();
+      if(fOptRej != 1)
+         return mcwt;
+      if( fMaxWtRej*rndm() > mcwt) continue;   // Wt=1 events, internal rejection
+      return (mcwt<fMaxWtRej) ? 1.0 : mcwt/fMaxWtRej;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// User method.
+/// Generates a MC event into MCvect with the random number generator rng and
+/// returns its MC weight, see MakeEvent().
+///
+/// The FOAM is not modified, in particular the MC statistics used by
+/// GetIntegMC() and Finalize() are not accumulated: several threads may
+/// generate events from the same initialized FOAM, each one with its own
+/// generator, provided the distribution is thread-safe (see
+/// TFoamIntegrand::IsThreadSafe()). Only distributions set with SetRho()
+/// are supported.
+
+Double_t TFoam::GenerateEvent(TRandom &rng, Double_t *MCvect) const
+{
+   if(!fRho || !fPrimAcu) {
+      Error("GenerateEvent", "FOAM not initialized with a compiled distribution \n");
+      return 0;
+   }
+   auto rndm = [&rng]() { return rng.Rndm(); };
+   return GenerateWith(rndm, MCvect);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// User method.
+/// Generates nev MC events: the fDim coordinates of event i are stored at
+/// MCvects[i*fDim] and its weight at MCwts[i], see GenerateEvent().
+///
+/// The events are generated by blocks, each one with its own non-overlapping
+/// stream of RANLUX++ random numbers derived from seed (see
+/// ROOT::Math::RandomStreams). If the distribution is thread-safe, the blocks
+/// are generated in parallel when implicit multithreading is enabled. The
+/// events only depend on seed, not on the number of threads.
+
+void TFoam::GenerateEvents(Long64_t nev, Double_t *MCvects, Double_t *MCwts, ULong64_t seed) const
+{
+   if(!fRho || !fPrimAcu) {
+      Error("GenerateEvents", "FOAM not initialized with a compiled distribution \n");
+      return;
+   }
+   constexpr Long64_t kEventsPerStream = 1024;
+   const UInt_t nStreams = (nev + kEventsPerStream - 1) / kEventsPerStream;
+   using Random_t = ROOT::Math::Random<ROOT::Math::RanluxppEngine2048>;
+   auto generate = [&](Random_t &rng, UInt_t stream) {
+      auto rndm = [&rng]() { return rng.Rndm(); };
+      const Long64_t last = TMath::Min(nev, (stream + 1) * kEventsPerStream);
+      for (Long64_t iev = stream * kEventsPerStream; iev < last; iev++)
+         MCwts[iev] = GenerateWith(rndm, MCvects + iev * fDim);
+   };
+   ROOT::Math::RandomStreams<ROOT::Math::RanluxppEngine2048> streams(seed);
+   if (fRho->IsThreadSafe()) {
+      streams.Foreach(generate, nStreams);
+   } else {
+      Random_t rng;
+      for (UInt_t stream = 0; stream < nStreams; stream++) {
+         streams.SetStream(rng, stream);
+         generate(rng, stream);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// User method.
 /// It provides the value of the integral calculated from the averages of the MC run
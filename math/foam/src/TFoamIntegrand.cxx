@@ -3,8 +3,32 @@
 
 #include "TFoamIntegrand.h"
 
+#include <algorithm>
+#include <vector>
+
 /** \class TFoamIntegrand
 Abstract class representing n-dimensional real positive integrand function
+
+Besides Density(), which evaluates the integrand at one point, integrands may
+override DensityBatch() to evaluate many points at once, e.g. with vectorised
+code. TFoam uses it during the exploration of the cells when a batch size is
+set with TFoam::SetBatchSize(). Integrands which can be evaluated concurrently
+should also override IsThreadSafe(), so that TFoam evaluates them in parallel
+when implicit multithreading is enabled.
 */
 
-ClassImp(TFoamIntegrand);
\ No newline at end of file
+ClassImp(TFoamIntegrand);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the density at rho.size() points, whose ndim coordinates are stored
+/// one point after the other in x. The default implementation calls Density()
+/// for each point.
+
+void TFoamIntegrand::DensityBatch(Int_t ndim, std::span<const Double_t> x, std::span<Double_t> rho)
+{
+   std::vector<Double_t> point(ndim);
+   for (std::size_t i = 0; i < rho.size(); ++i) {
+      std::copy(x.begin() + i * ndim, x.begin() + (i + 1) * ndim, point.begin());
+      rho[i] = Density(ndim, point.data());
+   }
+}
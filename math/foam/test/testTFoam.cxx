@@ -2,8 +2,12 @@
 // Author: Stephan Hageboeck, CERN  04/2020
 
 #include "TFoam.h"
+#include "TFoamIntegrand.h"
 #include "TFile.h"
 #include "TMath.h"
+#include "TRandom3.h"
+
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -50,3 +54,49 @@ TEST(TFoam, Readv1) {
     EXPECT_NEAR(x[1], results[i][1], 1.E-9);
   }
 }
+
+class Camel2Integrand : public TFoamIntegrand {
+public:
+   Double_t Density(Int_t nDim, Double_t *x) override { return Camel2(nDim, x); }
+   Bool_t IsThreadSafe() const override { return kTRUE; }
+};
+
+TEST(TFoam, BatchExplorationAndGeneration) {
+  TRandom3 rng(4357);
+  Camel2Integrand rho;
+  TFoam foam("foam");
+  foam.SetkDim(2);
+  foam.SetnCells(500);
+  foam.SetChat(0);
+  foam.SetBatchSize(64);
+  foam.SetRho(&rho);
+  foam.SetPseRan(&rng);
+  foam.Initialize();
+
+  // the generation with a copy of the generator reproduces MakeEvent()
+  TRandom3 copy(rng);
+  for (int i=0; i<5; ++i) {
+    double x[2], y[2];
+    foam.MakeEvent();
+    foam.GetMCvect(x);
+    const double wt = foam.GenerateEvent(copy, y);
+    EXPECT_EQ(x[0], y[0]);
+    EXPECT_EQ(x[1], y[1]);
+    EXPECT_EQ(foam.GetMCwt(), wt);
+  }
+
+  const Long64_t nev = 5000;
+  std::vector<double> x(2 * nev), wt(nev), x2(2 * nev), wt2(nev);
+  foam.GenerateEvents(nev, x.data(), wt.data(), 42);
+  foam.GenerateEvents(nev, x2.data(), wt2.data(), 42);
+  EXPECT_EQ(x, x2);
+  EXPECT_EQ(wt, wt2);
+
+  double mean = 0;
+  for (Long64_t i=0; i<nev; ++i) {
+    EXPECT_GE(x[2 * i], 0.);
+    EXPECT_LE(x[2 * i], 1.);
+    mean += x[2 * i] / nev;
+  }
+  EXPECT_NEAR(mean, 0.5, 0.02);
+}
@@ -0,0 +1,102 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024  LCG ROOT Math Team, CERN/EP-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for class BatchFitResult
+
+#ifndef ROOT_Fit_BatchFitResult
+#define ROOT_Fit_BatchFitResult
+
+#include <vector>
+
+namespace ROOT {
+
+   namespace Fit {
+
+//___________________________________________________________________________________
+/**
+   Compact result of a batch of independent fits of the same model, as returned by
+   ROOT::Fit::Fitter::FitBatch.
+   The results are stored as a structure of arrays: the values of the i-th fit are at index i
+   of the per-fit vectors, and its parameter values and errors at index i * NPar() + j
+   of the parameter vectors.
+
+   @ingroup FitMain
+*/
+class BatchFitResult {
+
+public:
+
+   BatchFitResult() {}
+
+   /// allocate the result for nfits fits of a model with npar parameters
+   BatchFitResult(unsigned int nfits, unsigned int npar) :
+      fNPar(npar),
+      fStatus(nfits, -1),
+      fValid(nfits, 0),
+      fMinFcn(nfits, 0),
+      fNdf(nfits, 0),
+      fNCalls(nfits, 0),
+      fParams(nfits * npar, 0),
+      fErrors(nfits * npar, 0)
+   {}
+
+   /// number of fits
+   unsigned int Size() const { return fStatus.size(); }
+
+   /// number of parameters of the fitted model
+   unsigned int NPar() const { return fNPar; }
+
+   /// minimizer status of fit i (-1 if the fit could not be done)
+   int Status(unsigned int i) const { return fStatus[i]; }
+
+   /// true if the minimization of fit i has converged
+   bool IsValid(unsigned int i) const { return fValid[i] != 0; }
+
+   /// minimum value of the objective function of fit i
+   /// (chi2 for least square fits, -log(L) for likelihood fits)
+   double MinFcnValue(unsigned int i) const { return fMinFcn[i]; }
+
+   /// number of degrees of freedom of fit i
+   unsigned int Ndf(unsigned int i) const { return fNdf[i]; }
+
+   /// number of objective function calls of fit i
+   unsigned int NCalls(unsigned int i) const { return fNCalls[i]; }
+
+   /// parameter values of fit i (array of NPar() values)
+   const double * Parameters(unsigned int i) const { return fParams.data() + i * fNPar; }
+
+   /// parameter errors of fit i (array of NPar() values)
+   const double * Errors(unsigned int i) const { return fErrors.data() + i * fNPar; }
+
+   /// value of parameter ipar of fit i
+   double Value(unsigned int i, unsigned int ipar) const { return fParams[i * fNPar + ipar]; }
+
+   /// error of parameter ipar of fit i
+   double Error(unsigned int i, unsigned int ipar) const { return fErrors[i * fNPar + ipar]; }
+
+private:
+
+   friend class Fitter;
+
+   unsigned int fNPar = 0;            ///< number of parameters of the model
+   std::vector<int> fStatus;          ///< minimizer status of each fit
+   std::vector<char> fValid;          ///< validity of each fit (not a vector<bool>, filled concurrently)
+   std::vector<double> fMinFcn;       ///< minimum of the objective function of each fit
+   std::vector<unsigned int> fNdf;    ///< number of degrees of freedom of each fit
+   std::vector<unsigned int> fNCalls; ///< number of function calls of each fit
+   std::vector<double> fParams;       ///< parameter values, NPar() per fit
+   std::vector<double> fErrors;       ///< parameter errors, NPar() per fit
+
+};
+
+   } // end namespace Fit
+
+} // end namespace ROOT
+
+#endif /* ROOT_Fit_BatchFitResult */
@@ -22,6 +22,7 @@ Classes used for fitting (regression analysis) and estimation of parameter value
 
 */
 
+#include "Fit/BatchFitResult.h"
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
 #include "Fit/FitConfig.h"
@@ -256,6 +257,21 @@ public:
       return DoLinearFit();
    }
 
+   /**
+      Fit many independent binned data sets (e.g. histograms filled with ROOT::Fit::FillData)
+      with the model function set before with SetFunction.
+      Every fit starts from the parameter settings and uses the minimizer options of the
+      current FitConfig. A least square fit is done by default, a binned likelihood
+      fit if useLikelihood is true.
+      When implicit multi-threading is enabled the fits are run in parallel on the IMT pool;
+      each task fits a chunk of data sets re-using one minimizer instance and one copy of
+      the model function, and none of them creates a FitResult.
+      The Fitter state (Result(), GetMinimizer(), ...) is not modified.
+      Note that the data sets are not copied.
+   */
+   BatchFitResult FitBatch(const std::vector<std::shared_ptr<BinData>> & data, bool useLikelihood = false,
+                           bool extended = true) const;
+
    /**
       Fit using the a generic FCN function as a C++ callable object implementing
       double () (const double *)
@@ -494,6 +510,9 @@ protected:
    bool DoUnbinnedLikelihoodFit( bool extended = false, const ROOT::EExecutionPolicy &executionPolicy = ROOT::EExecutionPolicy::kSequential);
    /// linear least square fit
    bool DoLinearFit();
+   /// fit the data sets of a batch in the range [begin, end)
+   void DoFitBatchRange(const std::vector<std::shared_ptr<BinData>> & data, bool useLikelihood, bool extended,
+                        unsigned int begin, unsigned int end, BatchFitResult & result) const;
    /// Set Objective function
    bool DoSetFCN(bool useExtFCN, const ROOT::Math::IMultiGenFunction &fcn, const double *params, unsigned int dataSize,
                  int fitType);
@@ -21,6 +21,7 @@
 #pragma link C++ class ROOT::Fit::UnBinData+;
 #pragma link C++ class ROOT::Fit::SparseData+;
 #pragma link C++ class ROOT::Fit::FitResult+;
+#pragma link C++ class ROOT::Fit::BatchFitResult+;
 #pragma link C++ class ROOT::Fit::ParameterSettings+;
 
 #pragma link C++ class ROOT::Fit::BasicFCN<ROOT::Math::IBaseFunctionMultiDim, ROOT::Math::IBaseFunctionMultiDim, ROOT::Fit::BinData>-;
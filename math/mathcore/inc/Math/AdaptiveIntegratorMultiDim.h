@@ -18,6 +18,8 @@
 
 #include "Math/VirtualIntegrator.h"
 
+#include <functional>
+
 namespace ROOT {
 namespace Math {
 
@@ -71,6 +73,19 @@ For a more detailed description of the method see References.
      Some analysis or suitable transformations of the integral prior to
      numerical work may contribute to numerical efficiency.
 
+### References:
+
+### Batch and parallel evaluation:
+
+The integration rule of each sub-region uses \f$ 2^n +2n(n+1) +1 \f$ points, which can be evaluated together:
+
+  - SetBatchFunction() gives a function evaluating the integrand at all the points of a region at once,
+    e.g. a vectorized implementation;
+  - SetParallel() evaluates the points of a region in parallel on the thread pool of ROOT, when implicit
+    multi-threading is enabled (see ROOT::EnableImplicitMT). The integrand function must then be thread safe.
+
+The result does not depend on the way the integrand is evaluated.
+
 ### References:
 
   1. A.C. Genz and A.A. Malik, Remarks on algorithm 006:
@@ -85,6 +100,10 @@ class AdaptiveIntegratorMultiDim : public VirtualIntegratorMultiDim {
 
 public:
 
+   /// Function evaluating the integrand at npoints points, whose coordinates are stored
+   /// contiguously in x (npoints * ndim values). The values are returned in result.
+   typedef std::function<void(unsigned int npoints, const double *x, double *result)> BatchFunction;
+
    /**
       Construct given optionally tolerance (absolute and relative), maximum number of function evaluation (maxpts)  and
       size of the working array.
@@ -166,6 +185,14 @@ public:
    ///set max points
    void SetMaxPts(unsigned int n) { fMaxPts = n; }
 
+   /// set a function evaluating the integrand at all the points of a sub-region at once
+   /// (it is used instead of the integrand function given in SetFunction, which must still be set)
+   void SetBatchFunction(const BatchFunction &f) { fBatchFun = f; }
+
+   /// evaluate the points of each sub-region in parallel, when implicit multi-threading is enabled
+   /// (the integrand function must be thread safe)
+   void SetParallel(bool on = true) { fParallel = on; }
+
    /// set the options
    void SetOptions(const ROOT::Math::IntegratorMultiDimOptions & opt) override;
 
@@ -177,6 +204,12 @@ protected:
    // internal function to compute the integral (if absVal is true compute abs value of function integral
    double DoIntegral(const double* xmin, const double * xmax, bool absVal = false);
 
+   // check if the npoints of a sub-region are evaluated in parallel
+   bool UseParallelEvaluation(unsigned int npoints) const;
+
+   // evaluate the integrand at npoints points stored contiguously in x
+   void EvalBatch(unsigned int npoints, const double *x, double *result) const;
+
  private:
 
    unsigned int fDim;     ///< dimensionality of integrand
@@ -193,6 +226,8 @@ protected:
    int fStatus;           ///< status of algorithm (error if not zero)
 
    const IMultiGenFunction* fFun;   // pointer to integrand function
+   BatchFunction fBatchFun;         // optional function evaluating the integrand at many points
+   bool fParallel = false;          // evaluate the points of a region in parallel
 
 };
 
@@ -0,0 +1,70 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024  LCG ROOT Math Team, CERN/EP-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+/**
+
+Array versions of the most common probability density functions, cumulative
+distributions, quantiles and special functions of MathCore.
+
+Each function evaluates the corresponding scalar function of ROOT::Math for all the
+values of the input span and writes the results in the output span, which must have
+at least the same size. The parameters of the distribution are the same for all the
+values. The loops are written so that the compiler can vectorize them where the
+scalar function allows it, and the results agree with the scalar functions to within
+rounding.
+
+Example:
+~~~{.cpp}
+std::vector<double> x(n), y(n);
+ROOT::Math::Batch::gaussian_pdf(x, y, sigma, mean);
+~~~
+
+@ingroup StatFunc
+
+*/
+
+#ifndef ROOT_Math_BatchFuncMathCore
+#define ROOT_Math_BatchFuncMathCore
+
+#include <ROOT/RSpan.hxx>
+
+namespace ROOT {
+namespace Math {
+namespace Batch {
+
+   /// Gaussian probability density function, see ROOT::Math::gaussian_pdf
+   void gaussian_pdf(std::span<const double> x, std::span<double> out, double sigma = 1, double x0 = 0);
+
+   /// Landau probability density function, see ROOT::Math::landau_pdf
+   void landau_pdf(std::span<const double> x, std::span<double> out, double xi = 1, double x0 = 0);
+
+   /// Crystal ball function, see ROOT::Math::crystalball_function
+   void crystalball_function(std::span<const double> x, std::span<double> out, double alpha, double n, double sigma,
+                             double mean = 0);
+
+   /// Cumulative distribution function of the normal distribution, see ROOT::Math::normal_cdf
+   void normal_cdf(std::span<const double> x, std::span<double> out, double sigma = 1, double x0 = 0);
+
+   /// Quantile of the normal distribution, see ROOT::Math::normal_quantile
+   void normal_quantile(std::span<const double> z, std::span<double> out, double sigma = 1);
+
+   /// Error function, see ROOT::Math::erf
+   void erf(std::span<const double> x, std::span<double> out);
+
+   /// Complementary error function, see ROOT::Math::erfc
+   void erfc(std::span<const double> x, std::span<double> out);
+
+   /// Natural logarithm of the gamma function, see ROOT::Math::lgamma
+   void lgamma(std::span<const double> x, std::span<double> out);
+
+} // namespace Batch
+} // namespace Math
+} // namespace ROOT
+
+#endif // ROOT_Math_BatchFuncMathCore
@@ -101,7 +101,11 @@ namespace ROOT {
 
    To speed up localisation of points (to see to which triangle belong) a grid is laid over the internal coordinate space.
    A reference to triangle ABC is added to _all_ grid cells that include ABC's bounding box.
-   The size of the grid is defined to be 25x25
+   The number of cells grows with the number of triangles (from 25x25 up to 1000x1000), so that each
+   cell refers to a few triangles only.
+
+   Many points can be interpolated at once with Interpolate(n, x, y, z); when ROOT's implicit
+   multi-threading is enabled the points are then interpolated in parallel.
 
    Optionally (if the compiler macro `HAS_GCAL` is defined ) the triangle findings and interpolation can be computed
    using the GCAL library. This is however not supported when using the class within ROOT
@@ -140,6 +144,10 @@ public:
    /// See the class documentation for  how the interpolation is computed.
    double  Interpolate(double x, double y);
 
+   /// Interpolate the n points (x[i],y[i]) and store the result in z[i], in parallel
+   /// when ROOT's implicit multi-threading is enabled.
+   void    Interpolate(int n, const double *x, const double *y, double *z);
+
    /// Find all triangles
    void      FindAllTriangles();
 
@@ -167,7 +175,7 @@ private:
    // internal methods
 
 
-   inline double Linear_transform(double x, double offset, double factor){
+   inline double Linear_transform(double x, double offset, double factor) const {
       return (x+offset)*factor;
    }
 
@@ -180,7 +188,7 @@ private:
    void DoFindTriangles();
 
    /// internal method to compute the interpolation
-   double  DoInterpolateNormalized(double x, double y);
+   double  DoInterpolateNormalized(double x, double y) const;
 
 
 
@@ -223,10 +231,11 @@ protected:
    std::vector<double> fXN; ///<! normalized X
    std::vector<double> fYN; ///<! normalized Y
 
-   static const int fNCells = 25; ///<! number of cells to divide the normalized space
+   int fNCells = 25; ///<! number of cells to divide the normalized space, in each direction
    double fXCellStep; ///<! inverse denominator to calculate X cell = fNCells / (fXNmax - fXNmin)
    double fYCellStep; ///<! inverse denominator to calculate X cell = fNCells / (fYNmax - fYNmin)
-   std::set<unsigned int> fCells[(fNCells+1)*(fNCells+1)]; ///<! grid cells with containing triangles
+   std::vector<unsigned int> fCellStart;     ///<! triangles of cell c are fCellTriangles[fCellStart[c]..fCellStart[c+1]-1]
+   std::vector<unsigned int> fCellTriangles; ///<! indices of the triangles of all grid cells, cell by cell
 
    inline unsigned int Cell(unsigned int x, unsigned int y) const {
       return x*(fNCells+1) + y;
@@ -131,6 +131,10 @@ http://dx.doi.org/10.1016/j.chaos.2016.05.003
          /// set the generator seed
          void  SetSeed(Result_t seed);
 
+         /// set the generator seed and select one of the 2^32 non-overlapping streams of this seed.
+         /// Stream 0 is the same as SetSeed(seed)
+         void  SetSeed(Result_t seed, uint32_t stream);
+
          // generate a random number (virtual interface)
          double Rndm() override { return Rndm_impl(); }
 
@@ -23,6 +23,10 @@
 
 #include "Math/RandomFunctions.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -72,6 +76,57 @@ namespace Math {
          fEngine.RandomArray(array, array+n);
       }
 
+      /**
+         Fill the array x with n random numbers uniformly distributed in ]a,b].
+         The numbers are generated first, then transformed by a loop which can be vectorised.
+      */
+      void UniformArray(std::size_t n, double * x, double a = 0, double b = 1) {
+         for (std::size_t i = 0; i < n; ++i)
+            x[i] = fEngine();
+         const double scale = b - a;
+         for (std::size_t i = 0; i < n; ++i)
+            x[i] = a + scale * x[i];
+      }
+
+      /**
+         Fill the array x with n Gaussian random numbers using the Box-Muller method on blocks
+         of pairs of uniform numbers, so that the transformation has no branch and can be vectorised.
+         The sequence differs from the one of repeated calls to Gaus.
+      */
+      void GausArray(std::size_t n, double * x, double mean = 0, double sigma = 1) {
+         constexpr std::size_t kBlock = 64;
+         double u1[kBlock], u2[kBlock];
+         for (std::size_t i = 0; i < n; i += 2 * kBlock) {
+            const std::size_t npairs = std::min(kBlock, (n - i + 1) / 2);
+            for (std::size_t k = 0; k < npairs; ++k) {
+               u1[k] = fEngine();
+               u2[k] = fEngine();
+            }
+            for (std::size_t k = 0; k < npairs; ++k) {
+               // the uniform numbers are in ]0,1], the logarithm is finite
+               const double r = sigma * std::sqrt(-2. * std::log(u1[k]));
+               const double phi = TMath::TwoPi() * u2[k];
+               u1[k] = mean + r * std::cos(phi);
+               u2[k] = mean + r * std::sin(phi);
+            }
+            for (std::size_t k = 0; k < npairs; ++k) {
+               x[i + 2 * k] = u1[k];
+               if (i + 2 * k + 1 < n)
+                  x[i + 2 * k + 1] = u2[k];
+            }
+         }
+      }
+
+      /**
+         Fill the array x with n exponential random numbers of mean tau, exp(-t/tau).
+      */
+      void ExpArray(std::size_t n, double * x, double tau) {
+         for (std::size_t i = 0; i < n; ++i)
+            x[i] = fEngine();
+         for (std::size_t i = 0; i < n; ++i)
+            x[i] = -tau * std::log(x[i]);
+      }
+
       /**
          Return the type (name) of the used generator
       */
@@ -221,6 +276,10 @@ namespace Math {
 
       void SetSeed(int seed) { fEngine.SetSeed(seed);}
 
+      /// Seed the engine with one of the non-overlapping streams of a seed.
+      /// Only available for the engines supporting streams (RanluxppEngine and MixMaxEngine), see RandomStreams
+      void SetSeed(uint64_t seed, uint32_t stream) { fEngine.SetSeed(seed, stream); }
+
    private:
 
       Engine fEngine;             ///<  random generator engine
@@ -237,6 +296,7 @@ namespace Math {
 
 #include "Math/MixMaxEngine.h"
 #include "Math/MersenneTwisterEngine.h"
+#include "Math/RanluxppEngine.h"
 #include "Math/StdEngine.h"
 
 namespace ROOT {
@@ -248,6 +308,7 @@ namespace Math {
    typedef   Random<ROOT::Math::MersenneTwisterEngine>   RandomMT19937;
    typedef   Random<ROOT::Math::StdEngine<std::mt19937_64>> RandomMT64;
    typedef   Random<ROOT::Math::StdEngine<std::ranlux48>> RandomRanlux48;
+   typedef   Random<ROOT::Math::RanluxppEngine2048>   RandomRanluxpp;
 
 } // namespace Math
 } // namespace ROOT
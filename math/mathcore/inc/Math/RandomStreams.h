@@ -0,0 +1,88 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024 , ROOT MathLib Team                             *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Math_RandomStreams
+#define ROOT_Math_RandomStreams
+
+#include "Math/Random.h"
+
+#include "RConfigure.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <cstdint>
+
+namespace ROOT {
+namespace Math {
+
+/**
+   Non-overlapping streams of random numbers for parallel Monte Carlo.
+
+   Task i of a parallel computation gets its own generator, seeded with stream i of a common
+   seed. The streams are guaranteed not to overlap by the jump-ahead of the engine, see
+   RanluxppEngine::SetSeed(uint64_t, uint32_t) and MixMaxEngine::SetSeed(uint64_t, uint32_t),
+   and the results only depend on the seed and on the number of tasks, not on the number of
+   threads nor on the order in which the tasks are run.
+
+   @code
+   ROOT::Math::RandomStreams<ROOT::Math::RanluxppEngine2048> streams(4357);
+   std::vector<double> sums(100);
+   streams.Foreach([&](ROOT::Math::RandomRanluxpp &rng, unsigned int task) {
+      double x[1000];
+      rng.GausArray(1000, x);
+      for (double v : x)
+         sums[task] += v;
+   }, 100);
+   @endcode
+
+   @ingroup Random
+*/
+template <class Engine>
+class RandomStreams {
+public:
+   explicit RandomStreams(uint64_t seed) : fSeed(seed) {}
+
+   uint64_t Seed() const { return fSeed; }
+
+   /// Seed rng with the stream of task i
+   void SetStream(Random<Engine> &rng, uint32_t i) const { rng.SetSeed(fSeed, i); }
+
+   /// Call func(rng, i) for the tasks i in [0, ntasks), rng being seeded with stream i. The tasks
+   /// are run in parallel when implicit multithreading is enabled.
+   template <class F>
+   void Foreach(F &&func, uint32_t ntasks) const
+   {
+      auto task = [&](uint32_t i) {
+         Random<Engine> rng;
+         SetStream(rng, i);
+         func(rng, i);
+      };
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled() && ntasks > 1) {
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(task, ROOT::TSeq<uint32_t>(ntasks));
+         return;
+      }
+#endif
+      for (uint32_t i = 0; i < ntasks; ++i)
+         task(i);
+   }
+
+private:
+   uint64_t fSeed; ///< seed common to all the streams
+};
+
+} // namespace Math
+} // namespace ROOT
+
+#endif /* ROOT_Math_RandomStreams */
@@ -31,6 +31,8 @@ private:
    std::unique_ptr<ImplType> fImpl;
 
 public:
+   using BaseType = TRandomEngine;
+
    RanluxppEngine(uint64_t seed = 314159265);
    ~RanluxppEngine() override;
 
@@ -43,6 +45,9 @@ public:
 
    /// Initialize and seed the state of the generator
    void SetSeed(uint64_t seed);
+   /// Seed the generator with one of the 2 ** 32 non-overlapping streams of 2 ** 48 states of `seed`.
+   /// Stream 0 is the same as SetSeed(seed).
+   void SetSeed(uint64_t seed, uint32_t stream);
    /// Skip `n` random numbers without generating them
    void Skip(uint64_t n);
 
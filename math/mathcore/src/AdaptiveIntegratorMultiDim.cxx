@@ -6,8 +6,14 @@
 #include "Math/IntegratorOptions.h"
 #include "Math/Error.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 namespace ROOT {
 namespace Math {
@@ -69,6 +75,41 @@ void AdaptiveIntegratorMultiDim::SetFunction(const IMultiGenFunction &f)
 
 void AdaptiveIntegratorMultiDim::SetRelTolerance(double relTol){ this->fRelTol = relTol; }
 
+bool AdaptiveIntegratorMultiDim::UseParallelEvaluation(unsigned int npoints) const
+{
+#ifdef R__USE_IMT
+   return fParallel && npoints > 1 && ROOT::IsImplicitMTEnabled();
+#else
+   (void)npoints;
+   return false;
+#endif
+}
+
+void AdaptiveIntegratorMultiDim::EvalBatch(unsigned int npoints, const double *x, double *result) const
+{
+   // evaluate the integrand at all the given points, with the batch function if given or
+   // in parallel on the IMT pool
+   if (fBatchFun) {
+      fBatchFun(npoints, x, result);
+      return;
+   }
+#ifdef R__USE_IMT
+   if (UseParallelEvaluation(npoints)) {
+      const unsigned int nchunks = std::min(npoints, ROOT::GetThreadPoolSize());
+      const unsigned int step = (npoints + nchunks - 1) / nchunks;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int ichunk) {
+         const unsigned int end = std::min(npoints, (ichunk + 1) * step);
+         for (unsigned int i = ichunk * step; i < end; ++i)
+            result[i] = (*fFun)(x + i * fDim);
+      }, ROOT::TSeqU(nchunks));
+      return;
+   }
+#endif
+   for (unsigned int i = 0; i < npoints; ++i)
+      result[i] = (*fFun)(x + i * fDim);
+}
+
 
 void AdaptiveIntegratorMultiDim::SetAbsTolerance(double absTol){ this->fAbsTol = absTol; }
 
@@ -184,76 +225,104 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
 
    //InitArgs(z,fParams);
 
-L20:
-   rgnvol = twondm;//=2^n
-   for (j=0; j<n; j++) {
-      rgnvol *= width[j]; //region volume
-      z[j]    = ctr[j]; //temporary node
-   }
-   sum1 = (*fFun)((const double*)z);//EvalPar(z,fParams); //evaluate function
-
-   difmax = 0;
-   sum2   = 0;
-   sum3   = 0;
-
-   //loop over coordinates
-   for (j=0; j<n; j++) {
-      z[j]    = ctr[j] - xl2*width[j];
-      if (absValue) f2 = std::abs((*fFun)(z));
-      else          f2 = (*fFun)(z);
-      z[j]    = ctr[j] + xl2*width[j];
-      if (absValue) f2 += std::abs((*fFun)(z));
-      else          f2 += (*fFun)(z);
-      widthl[j] = xl4*width[j];
-      z[j]    = ctr[j] - widthl[j];
-      if (absValue) f3 = std::abs((*fFun)(z));
-      else          f3 = (*fFun)(z);
-      z[j]    = ctr[j] + widthl[j];
-      if (absValue) f3 += std::abs((*fFun)(z));
-      else          f3 += (*fFun)(z);
-      sum2   += f2;//sum func eval with different weights separately
-      sum3   += f3;//for a given region
-      dif     = std::abs(7*f2-f3-12*sum1);
-      //storing dimension with biggest error/difference (?)
-      if (dif >= difmax) {
-         difmax=dif;
-         idvaxn=j+1;
+   // apply the integration rule to the current region (ctr, width), getting the function values from func.
+   // The points are always visited in the same order, so that the values can be computed beforehand in a batch
+   auto applyRule = [&](auto &&func) {
+      for (j=0; j<n; j++) z[j] = ctr[j];
+      sum1 = func(z); //evaluate function
+
+      difmax = 0;
+      sum2   = 0;
+      sum3   = 0;
+
+      //loop over coordinates
+      for (j=0; j<n; j++) {
+         z[j]    = ctr[j] - xl2*width[j];
+         if (absValue) f2 = std::abs(func(z));
+         else          f2 = func(z);
+         z[j]    = ctr[j] + xl2*width[j];
+         if (absValue) f2 += std::abs(func(z));
+         else          f2 += func(z);
+         widthl[j] = xl4*width[j];
+         z[j]    = ctr[j] - widthl[j];
+         if (absValue) f3 = std::abs(func(z));
+         else          f3 = func(z);
+         z[j]    = ctr[j] + widthl[j];
+         if (absValue) f3 += std::abs(func(z));
+         else          f3 += func(z);
+         sum2   += f2;//sum func eval with different weights separately
+         sum3   += f3;//for a given region
+         dif     = std::abs(7*f2-f3-12*sum1);
+         //storing dimension with biggest error/difference (?)
+         if (dif >= difmax) {
+            difmax=dif;
+            idvaxn=j+1;
+         }
+         z[j]    = ctr[j];
       }
-      z[j]    = ctr[j];
-   }
 
-   sum4 = 0;
-   for (j=1;j<n;j++) {
-      j1 = j-1;
-      for (k=j;k<n;k++) {
-         for (l=0;l<2;l++) {
-            widthl[j1] = -widthl[j1];
-            z[j1]    = ctr[j1] + widthl[j1];
-            for (m=0;m<2;m++) {
-               widthl[k] = -widthl[k];
-               z[k]    = ctr[k] + widthl[k];
-               if (absValue) sum4 += std::abs((*fFun)(z));
-               else            sum4 += (*fFun)(z);
+      sum4 = 0;
+      for (j=1;j<n;j++) {
+         j1 = j-1;
+         for (k=j;k<n;k++) {
+            for (l=0;l<2;l++) {
+               widthl[j1] = -widthl[j1];
+               z[j1]    = ctr[j1] + widthl[j1];
+               for (m=0;m<2;m++) {
+                  widthl[k] = -widthl[k];
+                  z[k]    = ctr[k] + widthl[k];
+                  if (absValue) sum4 += std::abs(func(z));
+                  else            sum4 += func(z);
+               }
             }
+            z[k] = ctr[k];
          }
-         z[k] = ctr[k];
+         z[j1] = ctr[j1];
       }
-      z[j1] = ctr[j1];
-   }
 
-   sum5 = 0;
+      sum5 = 0;
 
-   for (j=0;j<n;j++) {
-      widthl[j] = -xl5*width[j];
-      z[j] = ctr[j] + widthl[j];
+      for (j=0;j<n;j++) {
+         widthl[j] = -xl5*width[j];
+         z[j] = ctr[j] + widthl[j];
+      }
+   L90: //sum over end nodes ~gray codes
+      if (absValue) sum5 += std::abs(func(z));
+      else          sum5 += func(z);
+      for (j=0;j<n;j++) {
+         widthl[j] = -widthl[j];
+         z[j] = ctr[j] + widthl[j];
+         if (widthl[j] > 0) goto L90;
+      }
+   };
+
+   // points and function values of a region, when evaluating them in a batch
+   const bool useBatch = fBatchFun || UseParallelEvaluation(irlcls);
+   std::vector<double> points;
+   std::vector<double> values;
+   if (useBatch) {
+      points.reserve(irlcls * n);
+      values.resize(irlcls);
    }
-L90: //sum over end nodes ~gray codes
-   if (absValue) sum5 += std::abs((*fFun)(z));
-   else          sum5 += (*fFun)(z);
-   for (j=0;j<n;j++) {
-      widthl[j] = -widthl[j];
-      z[j] = ctr[j] + widthl[j];
-      if (widthl[j] > 0) goto L90;
+
+L20:
+   rgnvol = twondm;//=2^n
+   for (j=0; j<n; j++) {
+      rgnvol *= width[j]; //region volume
+   }
+
+   if (useBatch) {
+      // collect first all the points of the rule, evaluate them together and then apply the rule
+      points.clear();
+      applyRule([&](const double *x) {
+         points.insert(points.end(), x, x + n);
+         return 0.;
+      });
+      EvalBatch(irlcls, points.data(), values.data());
+      unsigned int ipoint = 0;
+      applyRule([&](const double *) { return values[ipoint++]; });
+   } else {
+      applyRule([&](const double *x) { return (*fFun)(x); });
    }
 
    rgncmp  = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
@@ -0,0 +1,109 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024  LCG ROOT Math Team, CERN/EP-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Implementation of the array versions of the MathCore statistical and special functions
+
+#include "Math/BatchFuncMathCore.h"
+#include "Math/Math.h"
+#include "Math/PdfFuncMathCore.h"
+#include "Math/ProbFuncMathCore.h"
+#include "Math/QuantFuncMathCore.h"
+#include "Math/SpecFuncMathCore.h"
+
+#include <cassert>
+#include <cmath>
+
+namespace ROOT {
+namespace Math {
+namespace Batch {
+
+void gaussian_pdf(std::span<const double> x, std::span<double> out, double sigma, double x0)
+{
+   assert(out.size() >= x.size());
+   const std::size_t n = x.size();
+   const double *in = x.data();
+   double *res = out.data();
+   // same expression as the scalar function, with the normalization computed once
+   const double norm = 1.0 / (std::sqrt(2 * M_PI) * std::fabs(sigma));
+   const double invSigma = 1.0 / sigma;
+   for (std::size_t i = 0; i < n; ++i) {
+      const double tmp = (in[i] - x0) * invSigma;
+      res[i] = norm * std::exp(-tmp * tmp / 2);
+   }
+}
+
+void landau_pdf(std::span<const double> x, std::span<double> out, double xi, double x0)
+{
+   assert(out.size() >= x.size());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      out[i] = ROOT::Math::landau_pdf(x[i], xi, x0);
+}
+
+void crystalball_function(std::span<const double> x, std::span<double> out, double alpha, double n, double sigma,
+                          double mean)
+{
+   assert(out.size() >= x.size());
+   const std::size_t size = x.size();
+   const double *in = x.data();
+   double *res = out.data();
+   if (sigma < 0.) {
+      for (std::size_t i = 0; i < size; ++i)
+         res[i] = 0.;
+      return;
+   }
+   // the parameters of the power-law tail do not depend on x
+   const double absAlpha = std::abs(alpha);
+   const double nDivAlpha = n / absAlpha;
+   const double AA = std::exp(-0.5 * absAlpha * absAlpha);
+   const double B = nDivAlpha - absAlpha;
+   const double sign = (alpha < 0) ? -1. : 1.;
+   for (std::size_t i = 0; i < size; ++i) {
+      const double z = sign * (in[i] - mean) / sigma;
+      res[i] = (z > -absAlpha) ? std::exp(-0.5 * z * z) : AA * std::pow(nDivAlpha / (B - z), n);
+   }
+}
+
+void normal_cdf(std::span<const double> x, std::span<double> out, double sigma, double x0)
+{
+   assert(out.size() >= x.size());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      out[i] = ROOT::Math::normal_cdf(x[i], sigma, x0);
+}
+
+void normal_quantile(std::span<const double> z, std::span<double> out, double sigma)
+{
+   assert(out.size() >= z.size());
+   for (std::size_t i = 0; i < z.size(); ++i)
+      out[i] = ROOT::Math::normal_quantile(z[i], sigma);
+}
+
+void erf(std::span<const double> x, std::span<double> out)
+{
+   assert(out.size() >= x.size());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      out[i] = ROOT::Math::erf(x[i]);
+}
+
+void erfc(std::span<const double> x, std::span<double> out)
+{
+   assert(out.size() >= x.size());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      out[i] = ROOT::Math::erfc(x[i]);
+}
+
+void lgamma(std::span<const double> x, std::span<double> out)
+{
+   assert(out.size() >= x.size());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      out[i] = ROOT::Math::lgamma(x[i]);
+}
+
+} // namespace Batch
+} // namespace Math
+} // namespace ROOT
@@ -22,11 +22,23 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 
 #include <iostream>
 #include <limits>
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TROOT.h"
+
+namespace {
+// below this number of points the overhead of the tasks is larger than the gain
+constexpr int kMinPointsParallelInterpolation = 1000;
+}
+#endif
+
 
 namespace ROOT {
 
@@ -131,6 +143,35 @@ double Delaunay2D::Interpolate(double x, double y)
    return zz;
 }
 
+//______________________________________________________________________________
+void Delaunay2D::Interpolate(int n, const double *x, const double *y, double *z)
+{
+   // Interpolate the n points (x[i],y[i]): the triangles are found once, then the
+   // interpolation only reads the triangulation and can run concurrently
+
+   FindAllTriangles();
+
+   auto interpolateRange = [&](int first, int last) {
+      for (int i = first; i < last; ++i) {
+         z[i] = (fNdt == 0) ? fZout
+                            : DoInterpolateNormalized(Linear_transform(x[i], fOffsetX, fScaleFactorX),
+                                                      Linear_transform(y[i], fOffsetY, fScaleFactorY));
+      }
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && fNdt > 0 && n >= kMinPointsParallelInterpolation) {
+      const int nchunks = std::min<int>(n, 4 * ROOT::GetThreadPoolSize());
+      const int chunkSize = (n + nchunks - 1) / nchunks;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](int ichunk) {
+         interpolateRange(ichunk * chunkSize, std::min(n, (ichunk + 1) * chunkSize));
+      }, ROOT::TSeqI(nchunks));
+      return;
+   }
+#endif
+   interpolateRange(0, n);
+}
+
 //______________________________________________________________________________
 void Delaunay2D::FindAllTriangles()
 {
@@ -166,10 +207,6 @@ void Delaunay2D::DoNormalizePoints() {
       fXN.push_back(Linear_transform(fX[n], fOffsetX, fScaleFactorX));
       fYN.push_back(Linear_transform(fY[n], fOffsetY, fScaleFactorY));
    }
-
-   //also initialize fXCellStep and FYCellStep
-   fXCellStep = fNCells / (fXNmax - fXNmin);
-   fYCellStep = fNCells / (fYNmax - fYNmin);
 }
 
 /// Triangle implementation for finding all the triangles
@@ -190,6 +227,23 @@ void Delaunay2D::DoFindTriangles() {
 
    fTriangles.resize(NumberOfTriangles);
 
+   // about one triangle per grid cell, but at least the historical 25x25 cells
+   fNCells = std::max(25, std::min(1000, int(std::sqrt(double(NumberOfTriangles)))));
+   fXCellStep = fNCells / (fXNmax - fXNmin);
+   fYCellStep = fNCells / (fYNmax - fYNmin);
+
+   // range of cells covered by the bounding box of a triangle, clamped to the grid
+   // (the triangles can exceed it when a range smaller than the points is given)
+   auto cellRange = [this](const Triangle &tri, int &cellXmin, int &cellXmax, int &cellYmin, int &cellYmax) {
+      auto clamp = [this](int c) { return std::max(0, std::min(fNCells, c)); };
+      auto bx = std::minmax({tri.x[0], tri.x[1], tri.x[2]});
+      auto by = std::minmax({tri.y[0], tri.y[1], tri.y[2]});
+      cellXmin = clamp(CellX(bx.first));
+      cellXmax = clamp(CellX(bx.second));
+      cellYmin = clamp(CellY(by.first));
+      cellYmax = clamp(CellY(by.second));
+   };
+
    for(i = 0; i < NumberOfTriangles; i++){
       Triangle tri;
       const auto& t = AllTriangles[i];
@@ -213,21 +267,28 @@ void Delaunay2D::DoFindTriangles() {
       tri.invDenom = 1 / ( (tri.y[1] - tri.y[2])*(tri.x[0] - tri.x[2]) + (tri.x[2] - tri.x[1])*(tri.y[0] - tri.y[2]) );
 
       fTriangles[i] = tri;
+   }
 
-      auto bx = std::minmax({tri.x[0], tri.x[1], tri.x[2]});
-      auto by = std::minmax({tri.y[0], tri.y[1], tri.y[2]});
-
-      unsigned int cellXmin = CellX(bx.first);
-      unsigned int cellXmax = CellX(bx.second);
-
-      unsigned int cellYmin = CellY(by.first);
-      unsigned int cellYmax = CellY(by.second);
-
-      for(unsigned int j = cellXmin; j <= cellXmax; j++) {
-         for(unsigned int k = cellYmin; k <= cellYmax; k++) {
-            fCells[Cell(j,k)].insert(i);
-         }
-      }
+   // fill the grid in compressed form: count the triangles of each cell, then store
+   // their indices cell after cell, in increasing order within a cell
+   const int nCells = (fNCells + 1) * (fNCells + 1);
+   fCellStart.assign(nCells + 1, 0);
+   int cellXmin, cellXmax, cellYmin, cellYmax;
+   for (const Triangle &tri : fTriangles) {
+      cellRange(tri, cellXmin, cellXmax, cellYmin, cellYmax);
+      for (int j = cellXmin; j <= cellXmax; j++)
+         for (int k = cellYmin; k <= cellYmax; k++)
+            fCellStart[Cell(j, k) + 1]++;
+   }
+   for (int c = 0; c < nCells; c++)
+      fCellStart[c + 1] += fCellStart[c];
+   fCellTriangles.resize(fCellStart[nCells]);
+   std::vector<unsigned int> next(fCellStart.begin(), fCellStart.end() - 1);
+   for (i = 0; i < NumberOfTriangles; i++) {
+      cellRange(fTriangles[i], cellXmin, cellXmax, cellYmin, cellYmax);
+      for (int j = cellXmin; j <= cellXmax; j++)
+         for (int k = cellYmin; k <= cellYmax; k++)
+            fCellTriangles[next[Cell(j, k)]++] = i;
    }
 }
 
@@ -238,7 +299,7 @@ void Delaunay2D::DoFindTriangles() {
 /// Relay that all the triangles have been found before
 /// see comment in class description (in Delaunay2D.h) for implementation details:
 /// finding barycentric coordinates and computing the interpolation
-double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
+double Delaunay2D::DoInterpolateNormalized(double xx, double yy) const
 {
 
    // compute barycentric coordinates of a point P(xx,yy,zz)
@@ -269,7 +330,9 @@ double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
    if (cX < 0 || cX > fNCells || cY < 0 || cY > fNCells)
       return fZout; // TODO some more fancy interpolation here
 
-   for (unsigned int t : fCells[Cell(cX, cY)]) {
+   const unsigned int cell = Cell(cX, cY);
+   for (unsigned int it = fCellStart[cell]; it < fCellStart[cell + 1]; ++it) {
+      const unsigned int t = fCellTriangles[it];
 
       auto coords = bayCoords(t);
 
@@ -328,14 +391,12 @@ void Delaunay2D::DoFindTriangles() {
 }
 
 /// CGAL implementation for interpolation
-double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
+double Delaunay2D::DoInterpolateNormalized(double xx, double yy) const
 {
    // Finds the Delaunay triangle that the point (xi,yi) sits in (if any) and
    // calculate a z-value for it by linearly interpolating the z-values that
    // make up that triangle.
-
-   // initialise the Delaunay algorithm if needed
-    FindAllTriangles();
+   // The triangles have been found by the caller (Interpolate).
 
    //coordinate computation
    Point p(xx, yy);
@@ -26,6 +26,12 @@
 #include "Fit/FitResult.h"
 #include "Math/Error.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
 #include <memory>
 
 #include "Math/IParamFunction.h"
@@ -689,6 +695,86 @@ struct ObjFuncTrait<ROOT::Math::FitMethodGradFunction> {
    static bool IsGrad() { return true; }
 };
 
+void Fitter::DoFitBatchRange(const std::vector<std::shared_ptr<BinData>> & data, bool useLikelihood,
+                             bool extended, unsigned int begin, unsigned int end, BatchFitResult & result) const
+{
+   // fit the data sets in the range [begin, end) re-using the same minimizer and model function
+   // (the model function is not thread safe, since its parameters are set at each evaluation)
+   std::shared_ptr<IModelFunction> func(dynamic_cast<IModelFunction *>(fFunc->Clone()));
+   FitConfig config(fConfig);
+   std::unique_ptr<ROOT::Math::Minimizer> minimizer(config.CreateMinimizer());
+   if (!minimizer) {
+      MATH_ERROR_MSG("Fitter::FitBatch","Minimizer cannot be created");
+      return;
+   }
+   ROOT::Math::MinimizerOptions opts = config.MinimizerOptions();
+   if (useLikelihood && opts.ErrorDef() == gDefaultErrorDef)
+      opts.SetErrorDef(0.5);
+   minimizer->SetOptions(opts);
+
+   const unsigned int npar = result.NPar();
+   for (unsigned int i = begin; i < end; ++i) {
+      if (!data[i]) continue;
+      std::unique_ptr<ROOT::Math::IMultiGenFunction> fcn;
+      if (useLikelihood)
+         fcn = std::make_unique<PoissonLikelihoodFCN<BaseFunc>>(data[i], func, 0, extended);
+      else
+         fcn = std::make_unique<Chi2FCN<BaseFunc>>(data[i], func);
+      minimizer->Clear();
+      minimizer->SetFunction(*fcn);
+      minimizer->SetVariables(config.ParamsSettings().begin(), config.ParamsSettings().end());
+      if (config.ParabErrors()) minimizer->SetValidError(true);
+
+      bool isValid = minimizer->Minimize();
+      result.fStatus[i] = minimizer->Status();
+      result.fValid[i] = isValid;
+      result.fMinFcn[i] = minimizer->MinValue();
+      const int ndf = int(data[i]->Size()) - int(minimizer->NFree());
+      result.fNdf[i] = (ndf > 0) ? ndf : 0;
+      result.fNCalls[i] = minimizer->NCalls();
+      const double * x = minimizer->X();
+      const double * err = minimizer->Errors();
+      for (unsigned int j = 0; j < npar; ++j) {
+         if (x) result.fParams[i * npar + j] = x[j];
+         if (err) result.fErrors[i * npar + j] = err[j];
+      }
+   }
+}
+
+BatchFitResult Fitter::FitBatch(const std::vector<std::shared_ptr<BinData>> & data, bool useLikelihood,
+                                bool extended) const
+{
+   // fit independently all the given data sets with the model function
+   const unsigned int nfits = data.size();
+   if (!fFunc) {
+      MATH_ERROR_MSG("Fitter::FitBatch","model function is not set");
+      return BatchFitResult();
+   }
+   if (fConfig.ParamsSettings().size() != fFunc->NPar()) {
+      MATH_ERROR_MSG("Fitter::FitBatch","wrong function dimension or wrong size for FitConfig");
+      return BatchFitResult();
+   }
+   BatchFitResult result(nfits, fFunc->NPar());
+   if (nfits == 0) return result;
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nfits > 1) {
+      // a few chunks per thread to balance fits of different durations
+      const unsigned int nchunks = std::min(nfits, 4 * ROOT::GetThreadPoolSize());
+      const unsigned int step = (nfits + nchunks - 1) / nchunks;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int ichunk) {
+         const unsigned int begin = ichunk * step;
+         const unsigned int end = std::min(nfits, begin + step);
+         if (begin < end) DoFitBatchRange(data, useLikelihood, extended, begin, end, result);
+      }, ROOT::TSeqU(nchunks));
+      return result;
+   }
+#endif
+   DoFitBatchRange(data, useLikelihood, extended, 0, nfits, result);
+   return result;
+}
+
 bool Fitter::DoInitMinimizer() {
    //initialize minimizer by creating it
    // and set there the objective function
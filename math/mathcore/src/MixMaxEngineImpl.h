@@ -56,6 +56,7 @@ namespace ROOT {
       }
       ~MixMaxEngineImpl() {}
       void SetSeed(uint64_t) { }
+      void SetSeedStream(uint64_t, uint32_t) { }
       double Rndm() { return -1; }
       double IntRndm() { return 0; }
       void SetState(const std::vector<uint64_t> &) { }
@@ -88,6 +89,10 @@ public:
       //seed_spbox(fRngState, seed);
       seed_uniquestream(fRngState, 0, 0, (uint32_t)(seed>>32), (uint32_t)seed );
    }
+   void SetSeedStream(Result_t seed, uint32_t stream) {
+      // the stream is the cluster ID of the unique stream, SetSeed using cluster 0
+      seed_uniquestream(fRngState, stream, 0, (uint32_t)(seed>>32), (uint32_t)seed );
+   }
    double Rndm() {
        return get_next_float(fRngState);
    }
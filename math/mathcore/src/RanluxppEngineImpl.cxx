@@ -365,6 +365,20 @@ public:
       Skip24();
    }
 
+   /// Skip `n` streams of 2 ** 48 states, see RanluxppEngine::SetSeed(uint64_t, uint32_t)
+   void SkipStreams(uint64_t n)
+   {
+      uint64_t a_skip[9];
+      powermod(kA, a_skip, uint64_t(1) << 48);
+      powermod(a_skip, a_skip, n);
+
+      uint64_t lcg[9];
+      to_lcg(fState, fCarry, lcg);
+      mulmod(a_skip, lcg);
+      to_ranlux(lcg, fState, fCarry);
+      fPosition = 0;
+   }
+
    /// Skip `n` random numbers without generating them
    void Skip(uint64_t n)
    {
@@ -380,7 +394,7 @@ public:
       n -= left;
       // Need to advance and possibly skip over blocks.
       int nPerState = kMaxPos / w;
-      int skip = (n / nPerState);
+      uint64_t skip = (n / nPerState);
 
       uint64_t a_skip[9];
       powermod(kA, a_skip, skip + 1);
@@ -431,6 +445,13 @@ void RanluxppEngine<p>::SetSeed(uint64_t seed)
    fImpl->SetSeedSibidanov(seed);
 }
 
+template <int p>
+void RanluxppEngine<p>::SetSeed(uint64_t seed, uint32_t stream)
+{
+   fImpl->SetSeedSibidanov(seed);
+   fImpl->SkipStreams(stream);
+}
+
 template <int p>
 void RanluxppEngine<p>::Skip(uint64_t n)
 {
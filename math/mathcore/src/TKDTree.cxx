@@ -13,9 +13,22 @@
 #include "TRandom.h"
 
 #include "TString.h"
+#include <algorithm>
 #include <cstring>
 #include <limits>
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TROOT.h"
+
+namespace {
+// below these sizes the overhead of the tasks is larger than the gain
+constexpr Int_t kMinPointsParallelBuild = 100000;
+constexpr Int_t kMinPointsParallelSearch = 1000;
+}
+#endif
+
 templateClassImp(TKDTree);
 
 
@@ -147,6 +160,10 @@ in the 2 subtrees as close as possible. The following section gives more details
     Most functions of the kd-tree don't require the original data to be present after the tree
     has been built. Check the functions documentation for more details.
 
+    If implicit multithreading is enabled (ROOT::EnableImplicitMT()), large trees are built in
+    parallel, and the FindNearestNeighbors() overload taking an array of points answers the
+    queries for all of them in parallel.
+
 #### 3b. Navigating the kd-tree
 
     Nodes of the tree are indexed top to bottom, left to right. The root node has index 0. Functions
@@ -449,71 +466,67 @@ void TKDTree<Index, Value>::Build()
    //
    //
    //4.
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && fNPoints >= kMinPointsParallelBuild) {
+      // The subtrees below a node use disjoint ranges of fIndPoints and disjoint nodes: split the
+      // top rows of the tree sequentially until there are enough subtrees for the thread pool,
+      // then build them in parallel.
+      struct Subtree { Int_t row, node, npoints, pos; };
+      std::vector<Subtree> subtrees{{0, 0, fNPoints, 0}};
+      const std::size_t ntasks = 4 * ROOT::GetThreadPoolSize();
+      while (subtrees.size() < ntasks) {
+         std::vector<Subtree> next;
+         for (const auto &t : subtrees) {
+            if (t.npoints <= fBucketSize) {
+               next.push_back(t);
+               continue;
+            }
+            Int_t nleft = SplitNode(t.row, t.node, t.npoints, t.pos);
+            next.push_back({t.row + 1, GetLeft(t.node), nleft, t.pos});
+            next.push_back({t.row + 1, GetRight(t.node), t.npoints - nleft, t.pos + nleft});
+         }
+         if (next.size() == subtrees.size())
+            break;
+         subtrees.swap(next);
+      }
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([this](const Subtree &t) { BuildSubtree(t.row, t.node, t.npoints, t.pos); }, subtrees);
+      return;
+   }
+#endif
+   BuildSubtree(0, 0, fNPoints, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Non recursive building of the subtree below node `node` of row `row`, holding the `npoints`
+/// points whose indexes start at fIndPoints[pos].
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::BuildSubtree(Int_t row, Int_t node, Int_t npoints, Int_t pos)
+{
    //    stack for non recursive build - size 128 bytes enough
    Int_t rowStack[128];
    Int_t nodeStack[128];
    Int_t npointStack[128];
    Int_t posStack[128];
    Int_t currentIndex = 0;
-   rowStack[0]    = 0;
-   nodeStack[0]   = 0;
-   npointStack[0] = fNPoints;
-   posStack[0]   = 0;
+   rowStack[0]    = row;
+   nodeStack[0]   = node;
+   npointStack[0] = npoints;
+   posStack[0]    = pos;
    //
    while (currentIndex>=0){
       //
-      Int_t npoints  = npointStack[currentIndex];
-      if (npoints<=fBucketSize) {
+      Int_t cnpoints = npointStack[currentIndex];
+      if (cnpoints<=fBucketSize) {
          currentIndex--;
          continue; // terminal node
       }
       Int_t crow     = rowStack[currentIndex];
       Int_t cpos     = posStack[currentIndex];
       Int_t cnode    = nodeStack[currentIndex];
-      //printf("currentIndex %d npoints %d node %d\n", currentIndex, npoints, cnode);
-      //
-      // divide points
-      Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
-      if (npoints%fBucketSize) nbuckets0++;            //
-      Int_t restRows = fRowT0-rowStack[currentIndex];  // rest of fully occupied node row
-      if (restRows<0) restRows =0;
-      for (;nbuckets0>(2<<restRows); restRows++) {}
-      Int_t nfull = 1<<restRows;
-      Int_t nrest = nbuckets0-nfull;
-      Int_t nleft =0, nright =0;
-      //
-      if (nrest>(nfull/2)){
-         nleft  = nfull*fBucketSize;
-         nright = npoints-nleft;
-      }else{
-         nright = nfull*fBucketSize/2;
-         nleft  = npoints-nright;
-      }
-
-      //
-      //find the axis with biggest spread
-      Value maxspread=0;
-      Value tempspread, min, max;
-      Index axspread=0;
-      Value *array;
-      for (Int_t idim=0; idim<fNDim; idim++){
-         array = fData[idim];
-         Spread(npoints, array, fIndPoints+cpos, min, max);
-         tempspread = max - min;
-         if (maxspread < tempspread) {
-            maxspread=tempspread;
-            axspread = idim;
-         }
-         if(cnode) continue;
-         //printf("set %d %6.3f %6.3f\n", idim, min, max);
-         fRange[2*idim] = min; fRange[2*idim+1] = max;
-      }
-      array = fData[axspread];
-      KOrdStat(npoints, array, nleft, fIndPoints+cpos);
-      fAxis[cnode]  = axspread;
-      fValue[cnode] = array[fIndPoints[cpos+nleft]];
-      //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
-      //
+      Int_t nleft    = SplitNode(crow, cnode, cnpoints, cpos);
+      Int_t nright   = cnpoints - nleft;
       //
       npointStack[currentIndex] = nleft;
       rowStack[currentIndex]    = crow+1;
@@ -524,14 +537,66 @@ void TKDTree<Index, Value>::Build()
       rowStack[currentIndex]    = crow+1;
       posStack[currentIndex]    = cpos+nleft;
       nodeStack[currentIndex]   = (cnode*2)+2;
-      //
-      if (false){
-         // consistency check
-         Info("Build()", "%s", Form("points %d left %d right %d", npoints, nleft, nright));
-         if (nleft<nright) Warning("Build", "Problem Left-Right");
-         if (nleft<0 || nright<0) Warning("Build()", "Problem Negative number");
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Divide the `npoints` points of node `cnode` of row `crow`, whose indexes start at
+/// fIndPoints[cpos], along the axis with the biggest spread. Sets the cutting axis and value
+/// of the node and returns the number of points of its left daughter.
+
+template <typename  Index, typename Value>
+Int_t TKDTree<Index, Value>::SplitNode(Int_t crow, Int_t cnode, Int_t npoints, Int_t cpos)
+{
+   // divide points
+   Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
+   if (npoints%fBucketSize) nbuckets0++;            //
+   Int_t restRows = fRowT0-crow;                    // rest of fully occupied node row
+   if (restRows<0) restRows =0;
+   for (;nbuckets0>(2<<restRows); restRows++) {}
+   Int_t nfull = 1<<restRows;
+   Int_t nrest = nbuckets0-nfull;
+   Int_t nleft =0, nright =0;
+   //
+   if (nrest>(nfull/2)){
+      nleft  = nfull*fBucketSize;
+      nright = npoints-nleft;
+   }else{
+      nright = nfull*fBucketSize/2;
+      nleft  = npoints-nright;
+   }
+
+   //
+   //find the axis with biggest spread
+   Value maxspread=0;
+   Value tempspread, min, max;
+   Index axspread=0;
+   Value *array;
+   for (Int_t idim=0; idim<fNDim; idim++){
+      array = fData[idim];
+      Spread(npoints, array, fIndPoints+cpos, min, max);
+      tempspread = max - min;
+      if (maxspread < tempspread) {
+         maxspread=tempspread;
+         axspread = idim;
       }
+      if(cnode) continue;
+      //printf("set %d %6.3f %6.3f\n", idim, min, max);
+      fRange[2*idim] = min; fRange[2*idim+1] = max;
+   }
+   array = fData[axspread];
+   KOrdStat(npoints, array, nleft, fIndPoints+cpos);
+   fAxis[cnode]  = axspread;
+   fValue[cnode] = array[fIndPoints[cpos+nleft]];
+   //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
+   //
+   if (false){
+      // consistency check
+      Info("Build()", "%s", Form("points %d left %d right %d", npoints, nleft, nright));
+      if (nleft<nright) Warning("Build", "Problem Left-Right");
+      if (nleft<0 || nright<0) Warning("Build()", "Problem Negative number");
    }
+   return nleft;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -556,6 +621,47 @@ void TKDTree<Index, Value>::FindNearestNeighbors(const Value *point, const Int_t
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find the kNN nearest neighbors of each of the npoints points of the array `points`,
+///in which the coordinates of point i are stored at points[i*GetNDim()] ... points[(i+1)*GetNDim()-1].
+///The indexes and distances of the neighbors of point i are stored at ind[i*kNN] and dist[i*kNN],
+///the arrays must be provided by the user and be at least npoints*kNN elements long.
+///If implicit multithreading is enabled, the points are processed in parallel.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindNearestNeighbors(Index npoints, const Value *points, const Int_t kNN, Index *ind, Value *dist)
+{
+   if (!ind || !dist) {
+      Error("FindNearestNeighbors", "Working arrays must be allocated by the user!");
+      return;
+   }
+   // the boundaries are computed once here, the searches below only read the tree
+   MakeBoundariesExact();
+   auto findRange = [&](Index first, Index last) {
+      for (Index i = first; i < last; i++) {
+         Index *indi = ind + i*kNN;
+         Value *disti = dist + i*kNN;
+         for (Int_t j=0; j<kNN; j++){
+            disti[j]=std::numeric_limits<Value>::max();
+            indi[j]=-1;
+         }
+         UpdateNearestNeighbors(0, points + i*fNDim, kNN, indi, disti);
+      }
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && npoints >= kMinPointsParallelSearch) {
+      const Index nchunks = std::min<Index>(npoints, 4 * ROOT::GetThreadPoolSize());
+      const Index chunkSize = (npoints + nchunks - 1) / nchunks;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Index ichunk) {
+         findRange(ichunk * chunkSize, std::min<Index>(npoints, (ichunk + 1) * chunkSize));
+      }, ROOT::TSeqU(nchunks));
+      return;
+   }
+#endif
+   findRange(0, npoints);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Update the nearest neighbors values by examining the node inode
 
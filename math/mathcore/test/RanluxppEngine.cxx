@@ -47,6 +47,26 @@ TEST(RanluxppEngine, random2048)
    EXPECT_EQ(rng.Rndm(), 0.74670661284082484599);
 }
 
+TEST(RanluxppEngine, streams)
+{
+   // Stream 0 is the plain seed, stream i starts 2 ** 48 states (12 numbers each) further.
+   RanluxppEngine2048 seeded(42), stream0, stream1, skipped(42);
+   stream0.SetSeed(42, 0);
+   stream1.SetSeed(42, 1);
+   skipped.Skip(uint64_t(12) << 48);
+   for (int i = 0; i < 50; i++) {
+      EXPECT_EQ(stream0.IntRndm(), seeded.IntRndm());
+      EXPECT_EQ(stream1.IntRndm(), skipped.IntRndm());
+   }
+
+   RanluxppEngine2048 other(42);
+   other.SetSeed(42, 2);
+   int same = 0;
+   for (int i = 0; i < 50; i++)
+      same += other.IntRndm() == stream1.IntRndm();
+   EXPECT_EQ(same, 0);
+}
+
 TEST(RanluxppCompatEngineJames, P3)
 {
    RanluxppCompatEngineJamesP3 rng(314159265);
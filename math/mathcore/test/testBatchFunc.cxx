@@ -0,0 +1,69 @@
+#include "Math/BatchFuncMathCore.h"
+#include "Math/PdfFuncMathCore.h"
+#include "Math/ProbFuncMathCore.h"
+#include "Math/QuantFuncMathCore.h"
+#include "Math/SpecFuncMathCore.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+std::vector<double> MakeGrid(double xmin, double xmax, std::size_t n)
+{
+   std::vector<double> x(n);
+   for (std::size_t i = 0; i < n; ++i)
+      x[i] = xmin + (xmax - xmin) * i / (n - 1);
+   return x;
+}
+
+} // namespace
+
+TEST(BatchFuncMathCore, PdfAndCdf)
+{
+   const auto x = MakeGrid(-10., 20., 1001);
+   std::vector<double> out(x.size());
+
+   ROOT::Math::Batch::gaussian_pdf(x, out, 2.5, 1.);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_NEAR(out[i], ROOT::Math::gaussian_pdf(x[i], 2.5, 1.), 1e-14);
+
+   ROOT::Math::Batch::landau_pdf(x, out, 0.7, 2.);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(out[i], ROOT::Math::landau_pdf(x[i], 0.7, 2.));
+
+   for (double alpha : {-1.5, 1.5}) {
+      ROOT::Math::Batch::crystalball_function(x, out, alpha, 3., 1.2, 0.5);
+      for (std::size_t i = 0; i < x.size(); ++i)
+         EXPECT_NEAR(out[i], ROOT::Math::crystalball_function(x[i], alpha, 3., 1.2, 0.5),
+                     1e-13 * ROOT::Math::crystalball_function(x[i], alpha, 3., 1.2, 0.5));
+   }
+
+   ROOT::Math::Batch::normal_cdf(x, out, 3., -1.);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(out[i], ROOT::Math::normal_cdf(x[i], 3., -1.));
+}
+
+TEST(BatchFuncMathCore, QuantileAndSpecialFunctions)
+{
+   const auto p = MakeGrid(1e-6, 1. - 1e-6, 501);
+   const auto x = MakeGrid(0.1, 30., 501);
+   std::vector<double> out(x.size());
+
+   ROOT::Math::Batch::normal_quantile(p, out, 2.);
+   for (std::size_t i = 0; i < p.size(); ++i)
+      EXPECT_DOUBLE_EQ(out[i], ROOT::Math::normal_quantile(p[i], 2.));
+
+   ROOT::Math::Batch::erf(x, out);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(out[i], ROOT::Math::erf(x[i]));
+
+   ROOT::Math::Batch::erfc(x, out);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(out[i], ROOT::Math::erfc(x[i]));
+
+   ROOT::Math::Batch::lgamma(x, out);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(out[i], ROOT::Math::lgamma(x[i]));
+}
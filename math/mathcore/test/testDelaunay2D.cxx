@@ -7,6 +7,9 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
+#include <vector>
+
 // test Delauney interpolation on edges of a triangle
 // some of these tests failed when using the older version
 // see issue #
@@ -62,3 +65,34 @@ TEST(Delaunay2D,interpolation_at_edges)
 }
 
 
+
+// interpolation of many points at once must give the same result as one by one
+TEST(Delaunay2D, batch_interpolation)
+{
+   const int n = 2000;
+   std::vector<double> x(n), y(n), z(n);
+   for (int i = 0; i < n; ++i) {
+      // deterministic, irregularly spread points
+      x[i] = std::fmod(i * 0.618034, 1.) * 4. - 2.;
+      y[i] = std::fmod(i * 0.414214, 1.) * 4. - 2.;
+      z[i] = std::exp(-x[i] * x[i] - y[i] * y[i]);
+   }
+   ROOT::Math::Delaunay2D d(n, x.data(), y.data(), z.data());
+   d.SetZOuterValue(-1.);
+
+   const int m = 100;
+   std::vector<double> xq, yq;
+   for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < m; ++j) {
+         xq.push_back(-2.2 + 4.4 * (i + 0.5) / m);
+         yq.push_back(-2.2 + 4.4 * (j + 0.5) / m);
+      }
+   }
+   std::vector<double> zq(xq.size());
+   d.Interpolate(xq.size(), xq.data(), yq.data(), zq.data());
+   EXPECT_GT(d.NumberOfTriangles(), 625);
+   for (std::size_t i = 0; i < xq.size(); ++i)
+      EXPECT_EQ(zq[i], d.Interpolate(xq[i], yq[i])) << "x = " << xq[i] << ", y = " << yq[i];
+   // the corners of the grid are outside of the convex hull of the points
+   EXPECT_EQ(zq[0], -1.);
+}
@@ -0,0 +1,95 @@
+#include "Fit/BatchFitResult.h"
+#include "Fit/BinData.h"
+#include "Fit/Fitter.h"
+#include "HFitInterface.h"
+#include "Math/WrappedMultiTF1.h"
+#include "TF1.h"
+#include "TH1.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::shared_ptr<ROOT::Fit::BinData>> MakeHistograms(unsigned int n)
+{
+   TRandom3 rndm(4357);
+   std::vector<std::shared_ptr<ROOT::Fit::BinData>> data;
+   for (unsigned int i = 0; i < n; ++i) {
+      TH1D h(("h" + std::to_string(i)).c_str(), "", 40, -5, 5);
+      h.SetDirectory(nullptr);
+      const double mean = rndm.Uniform(-1, 1);
+      const double sigma = rndm.Uniform(0.5, 1.5);
+      for (int j = 0; j < 2000; ++j)
+         h.Fill(rndm.Gaus(mean, sigma));
+      auto d = std::make_shared<ROOT::Fit::BinData>();
+      ROOT::Fit::FillData(*d, &h);
+      data.push_back(d);
+   }
+   return data;
+}
+
+void CompareWithSingleFits(bool useLikelihood)
+{
+   TF1 f("fgaus", "gaus", -5, 5);
+   ROOT::Math::WrappedMultiTF1 wf(f, 1);
+   auto data = MakeHistograms(20);
+
+   ROOT::Fit::Fitter fitter;
+   fitter.Config().SetMinimizer("Minuit2");
+   fitter.SetFunction(wf, false);
+   const double p0[3] = {100, 0, 1};
+   fitter.Config().SetParamsSettings(3, p0);
+   fitter.Config().SetUpdateAfterFit(false);
+
+   ROOT::Fit::BatchFitResult batch = fitter.FitBatch(data, useLikelihood);
+   ASSERT_EQ(batch.Size(), data.size());
+   ASSERT_EQ(batch.NPar(), 3u);
+
+   for (unsigned int i = 0; i < data.size(); ++i) {
+      const bool ok = useLikelihood ? fitter.LikelihoodFit(data[i]) : fitter.Fit(data[i]);
+      ASSERT_TRUE(ok);
+      const ROOT::Fit::FitResult &res = fitter.Result();
+      EXPECT_TRUE(batch.IsValid(i));
+      EXPECT_EQ(batch.Ndf(i), res.Ndf());
+      EXPECT_NEAR(batch.MinFcnValue(i), res.MinFcnValue(), 1e-6 * std::abs(res.MinFcnValue()));
+      for (unsigned int j = 0; j < 3; ++j) {
+         EXPECT_NEAR(batch.Value(i, j), res.Parameter(j), 1e-3 * res.ParError(j));
+         EXPECT_NEAR(batch.Error(i, j), res.ParError(j), 1e-3 * res.ParError(j));
+      }
+   }
+}
+
+} // namespace
+
+TEST(FitBatch, LeastSquare)
+{
+   CompareWithSingleFits(false);
+}
+
+TEST(FitBatch, BinnedLikelihood)
+{
+   CompareWithSingleFits(true);
+}
+
+#ifdef R__USE_IMT
+TEST(FitBatch, MultiThread)
+{
+   ROOT::EnableImplicitMT(4);
+   CompareWithSingleFits(false);
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+TEST(FitBatch, NoFunction)
+{
+   ROOT::Fit::Fitter fitter;
+   auto data = MakeHistograms(2);
+   EXPECT_EQ(fitter.FitBatch(data).Size(), 0u);
+}
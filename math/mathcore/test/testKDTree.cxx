@@ -0,0 +1,86 @@
+#include "TKDTree.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct Points {
+   std::vector<Double_t> x, y, z;
+   Points(Int_t n, UInt_t seed) : x(n), y(n), z(n)
+   {
+      TRandom3 rndm(seed);
+      for (Int_t i = 0; i < n; ++i) {
+         x[i] = rndm.Uniform(-100, 100);
+         y[i] = rndm.Uniform(-100, 100);
+         z[i] = rndm.Uniform(-100, 100);
+      }
+   }
+};
+
+std::unique_ptr<TKDTreeID> MakeTree(Points &p, Int_t bsize)
+{
+   auto tree = std::make_unique<TKDTreeID>(p.x.size(), 3, bsize);
+   tree->SetData(0, p.x.data());
+   tree->SetData(1, p.y.data());
+   tree->SetData(2, p.z.data());
+   tree->Build();
+   return tree;
+}
+
+} // namespace
+
+TEST(TKDTree, BatchedNearestNeighbors)
+{
+   const Int_t nref = 20000;
+   const Int_t nquery = 2000;
+   const Int_t nn = 10;
+   Points ref(nref, 1);
+   Points query(nquery, 2);
+   auto tree = MakeTree(ref, 10);
+
+   std::vector<Double_t> points(3 * nquery);
+   for (Int_t i = 0; i < nquery; ++i) {
+      points[3 * i] = query.x[i];
+      points[3 * i + 1] = query.y[i];
+      points[3 * i + 2] = query.z[i];
+   }
+   std::vector<Int_t> ind(nquery * nn);
+   std::vector<Double_t> dist(nquery * nn);
+   tree->FindNearestNeighbors(nquery, points.data(), nn, ind.data(), dist.data());
+
+   std::vector<Int_t> ind1(nn);
+   std::vector<Double_t> dist1(nn);
+   for (Int_t i = 0; i < nquery; ++i) {
+      tree->FindNearestNeighbors(&points[3 * i], nn, ind1.data(), dist1.data());
+      for (Int_t j = 0; j < nn; ++j) {
+         EXPECT_EQ(ind[i * nn + j], ind1[j]);
+         EXPECT_EQ(dist[i * nn + j], dist1[j]);
+      }
+   }
+}
+
+#ifdef R__USE_IMT
+TEST(TKDTree, ParallelBuild)
+{
+   const Int_t nref = 300000;
+   Points ref(nref, 3);
+   auto serial = MakeTree(ref, 16);
+
+   ROOT::EnableImplicitMT(4);
+   auto parallel = MakeTree(ref, 16);
+   ROOT::DisableImplicitMT();
+
+   ASSERT_EQ(serial->GetNNodes(), parallel->GetNNodes());
+   for (Int_t inode = 0; inode < serial->GetNNodes(); ++inode) {
+      EXPECT_EQ(serial->GetNodeAxis(inode), parallel->GetNodeAxis(inode));
+      EXPECT_EQ(serial->GetNodeValue(inode), parallel->GetNodeValue(inode));
+   }
+   for (Int_t i = 0; i < nref; ++i)
+      EXPECT_EQ(serial->GetIndPoints()[i], parallel->GetIndPoints()[i]);
+}
+#endif
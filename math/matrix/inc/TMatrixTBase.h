@@ -80,6 +80,7 @@ template<class Element> class TElementActionT;
 template<class Element> class TElementPosActionT;
 
 R__EXTERN Int_t gMatrixCheck;
+R__EXTERN Long64_t gMatrixBlockedMult;
 
 template<class Element> class TMatrixTBase : public TObject {
 
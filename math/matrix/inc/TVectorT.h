@@ -266,6 +266,8 @@ template<class Element> TVectorT<Element>  &Add         (      TVectorT      <El
                                                          const TVectorT<Element> &source);
 template<class Element> TVectorT<Element>  &Add         (      TVectorT      <Element>  &target,       Element              scalar, const TMatrixTSparse<Element>  &a,
                                                          const TVectorT<Element> &source);
+template<class Element> Int_t               SolveCG     (const TMatrixTSparse<Element>  &a,      const TVectorT <Element>  &b,      TVectorT            <Element>  &x,
+                                                         Double_t tol=1e-10,Int_t maxIter=0);
 template<class Element> TVectorT<Element>  &AddElemMult (      TVectorT      <Element>  &target,       Element              scalar, const TVectorT      <Element>  &source1,
                                                          const TVectorT      <Element>  &source2);
 template<class Element> TVectorT<Element>  &AddElemMult (      TVectorT      <Element>  &target,       Element              scalar, const TVectorT      <Element>  &source1,
@@ -20,6 +20,7 @@ See the \ref Matrix page for the documentation of the linear algebra package
 
 */
 
+#include <algorithm>
 #include <typeinfo>
 
 #include "TMatrixT.h"
@@ -30,9 +31,100 @@ See the \ref Matrix page for the documentation of the linear algebra package
 #include "TDecompLU.h"
 #include "TMatrixDEigen.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 templateClassImp(TMatrixT);
 
+namespace {
+// Blocking of the large matrix products: the rows of C are processed by blocks of kRowBlock,
+// possibly in parallel, and the loops over the inner dimension and the columns of C are split
+// in blocks of kInnerBlock and kColBlock, so that the block of B in use stays in cache.
+constexpr Int_t kRowBlock = 32;
+constexpr Int_t kInnerBlock = 128;
+constexpr Int_t kColBlock = 512;
+
+Bool_t UseBlockedMult(Int_t nrowsc, Int_t ninner, Int_t ncolsc)
+{
+   return gMatrixBlockedMult > 0 && Long64_t(nrowsc) * ninner * ncolsc >= gMatrixBlockedMult;
+}
+
+/// Call KERNEL(first, last) for the blocks of rows of C, in parallel if implicit
+/// multithreading is enabled.
+template <class Kernel>
+void ForEachRowBlock(Int_t nrowsc, Kernel &&kernel)
+{
+   const Int_t nblocks = (nrowsc + kRowBlock - 1) / kRowBlock;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nblocks > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t ib) { kernel(ib * kRowBlock, std::min(nrowsc, (ib + 1) * kRowBlock)); },
+                   ROOT::TSeqI(nblocks));
+      return;
+   }
+#endif
+   for (Int_t ib = 0; ib < nblocks; ib++)
+      kernel(ib * kRowBlock, std::min(nrowsc, (ib + 1) * kRowBlock));
+}
+
+/// Rows [first, last) of C = A * B, or of C = A^T * B with TRANSA. The innermost
+/// loop runs over a contiguous row of B and C and is vectorized.
+template <class Element, bool TransA>
+void BlockedAMultB(const Element *ap, Int_t ncolsa, const Element *bp, Int_t ninner, Int_t ncolsb, Element *cp,
+                   Int_t first, Int_t last)
+{
+   std::fill(cp + first * ncolsb, cp + last * ncolsb, Element(0));
+   for (Int_t j0 = 0; j0 < ncolsb; j0 += kColBlock) {
+      const Int_t j1 = std::min(ncolsb, j0 + kColBlock);
+      for (Int_t k0 = 0; k0 < ninner; k0 += kInnerBlock) {
+         const Int_t k1 = std::min(ninner, k0 + kInnerBlock);
+         for (Int_t i = first; i < last; i++) {
+            Element *crow = cp + i * ncolsb;
+            for (Int_t k = k0; k < k1; k++) {
+               const Element aik = TransA ? ap[k * ncolsa + i] : ap[i * ncolsa + k];
+               const Element *brow = bp + k * ncolsb;
+               for (Int_t j = j0; j < j1; j++)
+                  crow[j] += aik * brow[j];
+            }
+         }
+      }
+   }
+}
+
+/// Rows [first, last) of C = A * B^T, as dot products of the rows of A and B,
+/// reusing a block of rows of B for all the rows of C.
+template <class Element>
+void BlockedAMultBt(const Element *ap, Int_t ncols, const Element *bp, Int_t nrowsb, Element *cp, Int_t first,
+                    Int_t last)
+{
+   const Int_t jblock = std::max(1, kColBlock * kInnerBlock / std::max(ncols, 1) / 4);
+   for (Int_t j0 = 0; j0 < nrowsb; j0 += jblock) {
+      const Int_t j1 = std::min(nrowsb, j0 + jblock);
+      for (Int_t i = first; i < last; i++) {
+         const Element *arow = ap + i * ncols;
+         for (Int_t j = j0; j < j1; j++) {
+            const Element *brow = bp + j * ncols;
+            // independent partial sums, so that the reduction can be vectorized
+            Element sum[4] = {0, 0, 0, 0};
+            Int_t k = 0;
+            for (; k + 4 <= ncols; k += 4) {
+               sum[0] += arow[k] * brow[k];
+               sum[1] += arow[k + 1] * brow[k + 1];
+               sum[2] += arow[k + 2] * brow[k + 2];
+               sum[3] += arow[k + 3] * brow[k + 3];
+            }
+            for (; k < ncols; k++)
+               sum[0] += arow[k] * brow[k];
+            cp[i * nrowsb + j] = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+         }
+      }
+   }
+}
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor for (nrows x ncols) matrix
 
@@ -3081,6 +3173,13 @@ template <class Element>
 void TMatrixTAutoloadOps::AMultB(const Element *const ap, Int_t na, Int_t ncolsa, const Element *const bp, Int_t nb,
                                  Int_t ncolsb, Element *cp)
 {
+   const Int_t nrowsa = ncolsa > 0 ? na / ncolsa : 0;
+   if (UseBlockedMult(nrowsa, ncolsa, ncolsb)) {
+      ForEachRowBlock(nrowsa, [&](Int_t first, Int_t last) {
+         BlockedAMultB<Element, false>(ap, ncolsa, bp, ncolsa, ncolsb, cp, first, last);
+      });
+      return;
+   }
    const Element *arp0 = ap; // Pointer to  A[i,0];
    while (arp0 < ap + na) {
       for (const Element *bcp = bp; bcp < bp + ncolsb;) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3104,6 +3203,13 @@ template <class Element>
 void TMatrixTAutoloadOps::AtMultB(const Element *const ap, Int_t ncolsa, const Element *const bp, Int_t nb,
                                   Int_t ncolsb, Element *cp)
 {
+   const Int_t nrowsb = ncolsb > 0 ? nb / ncolsb : 0;
+   if (UseBlockedMult(ncolsa, nrowsb, ncolsb)) {
+      ForEachRowBlock(ncolsa, [&](Int_t first, Int_t last) {
+         BlockedAMultB<Element, true>(ap, ncolsa, bp, nrowsb, ncolsb, cp, first, last);
+      });
+      return;
+   }
    const Element *acp0 = ap; // Pointer to  A[i,0];
    while (acp0 < ap + ncolsa) {
       for (const Element *bcp = bp; bcp < bp + ncolsb;) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3128,6 +3234,14 @@ template <class Element>
 void TMatrixTAutoloadOps::AMultBt(const Element *const ap, Int_t na, Int_t ncolsa, const Element *const bp, Int_t nb,
                                   Int_t ncolsb, Element *cp)
 {
+   const Int_t nrowsa = ncolsa > 0 ? na / ncolsa : 0;
+   const Int_t nrowsb = ncolsb > 0 ? nb / ncolsb : 0;
+   if (UseBlockedMult(nrowsa, ncolsa, nrowsb)) {
+      ForEachRowBlock(nrowsa, [&](Int_t first, Int_t last) {
+         BlockedAMultBt(ap, ncolsa, bp, nrowsb, cp, first, last);
+      });
+      return;
+   }
    const Element *arp0 = ap; // Pointer to  A[i,0];
    while (arp0 < ap + na) {
       const Element *brp0 = bp; // Pointer to  B[j,0];
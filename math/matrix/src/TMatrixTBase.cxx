@@ -31,6 +31,8 @@ of the derived classes
 #include <climits>
 
 Int_t gMatrixCheck = 1;
+// Minimum number of multiply-adds of a matrix product for the blocked kernels, 0 to disable them
+Long64_t gMatrixBlockedMult = 64 * 64 * 64;
 
 templateClassImp(TMatrixTBase);
 
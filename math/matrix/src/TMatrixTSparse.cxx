@@ -95,6 +95,14 @@
 #include "TBuffer.h"
 #include "TMatrixT.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
 
 templateClassImp(TMatrixTSparse);
 
@@ -568,14 +576,6 @@ void TMatrixTSparse<Element>::conservative_sparse_sparse_product_impl(const TMat
    Int_t rowsLwb = lhs.GetColLwb();
    Int_t colsLwb = rhs.GetRowLwb();
 
-   auto mask = std::unique_ptr<bool[]>(new bool[rows]);
-   auto values = std::unique_ptr<Element[]>(new Element[rows]);
-   auto indices = std::unique_ptr<Int_t[]>(new Int_t[rows]);
-
-   std::memset(mask.get(), false, sizeof(bool) * rows);
-   std::memset(values.get(), 0, sizeof(Element) * rows);
-   std::memset(indices.get(), 0, sizeof(Int_t) * rows);
-
    const Int_t *pRowIndexlhs = lhs.GetRowIndexArray();
    const Int_t *pRowIndexrhs = rhs.GetRowIndexArray();
    const Int_t *lhsCol = lhs.GetColIndexArray();
@@ -583,24 +583,120 @@ void TMatrixTSparse<Element>::conservative_sparse_sparse_product_impl(const TMat
    const Element *lhsVal = lhs.GetMatrixArray();
    const Element *rhsVal = rhs.GetMatrixArray();
 
-   if (constr) {
-      // compute the number of non zero entries
-      Int_t estimated_nnz_prod = 0;
-      for (Int_t j = 0; j < cols; ++j) {
-         Int_t nnz = 0;
-         for (Int_t l = pRowIndexrhs[j]; l < pRowIndexrhs[j + 1]; ++l) {
-            Int_t k = *(rhsCol + l);
-            for (Int_t m = pRowIndexlhs[k]; m < pRowIndexlhs[k + 1]; ++m) {
-               Int_t i = *(lhsCol + m);
-               if (!mask[i]) {
-                  mask[i] = true;
-                  ++nnz;
-               }
+   // Each column of the result is accumulated in a dense work array of length rows,
+   // the mask flagging its non zeros. The work arrays are per thread.
+   struct Work {
+      std::vector<char> fMask;
+      std::vector<Element> fValues;
+      std::vector<Int_t> fIndices;
+      Work(Int_t n) : fMask(n, 0), fValues(n), fIndices(n) {}
+   };
+
+   // number of non zeros of column j
+   auto symbolic = [&](Int_t j, Work &w) {
+      Int_t nnz = 0;
+      for (Int_t l = pRowIndexrhs[j]; l < pRowIndexrhs[j + 1]; ++l) {
+         Int_t k = rhsCol[l];
+         for (Int_t m = pRowIndexlhs[k]; m < pRowIndexlhs[k + 1]; ++m) {
+            Int_t i = lhsCol[m];
+            if (!w.fMask[i]) {
+               w.fMask[i] = 1;
+               w.fIndices[nnz++] = i;
             }
          }
-         estimated_nnz_prod += nnz;
-         std::memset(mask.get(), false, sizeof(bool) * rows);
       }
+      for (Int_t n = 0; n < nnz; ++n)
+         w.fMask[w.fIndices[n]] = 0;
+      return nnz;
+   };
+
+   // compute column j and store it, sorted, from index p of the result
+   auto numeric = [&](Int_t j, Work &w, Int_t *pColIndex, Element *pData, Int_t p) {
+      Int_t nnz = 0;
+      for (Int_t l = pRowIndexrhs[j]; l < pRowIndexrhs[j + 1]; ++l) {
+         Element y = rhsVal[l];
+         Int_t k = rhsCol[l];
+         for (Int_t m = pRowIndexlhs[k]; m < pRowIndexlhs[k + 1]; ++m) {
+            Int_t i = lhsCol[m];
+            Element x = lhsVal[m];
+            if (!w.fMask[i]) {
+               w.fMask[i] = 1;
+               w.fValues[i] = x * y;
+               w.fIndices[nnz++] = i;
+            } else
+               w.fValues[i] += x * y;
+         }
+      }
+      if (nnz > rows / 16) {
+         // dense column: scanning the mask is cheaper than sorting
+         for (Int_t i = 0; i < rows; ++i) {
+            if (w.fMask[i]) {
+               w.fMask[i] = 0;
+               pColIndex[p] = i;
+               pData[p++] = w.fValues[i];
+            }
+         }
+      } else {
+         std::sort(w.fIndices.begin(), w.fIndices.begin() + nnz);
+         for (Int_t n = 0; n < nnz; ++n) {
+            const Int_t i = w.fIndices[n];
+            w.fMask[i] = 0;
+            pColIndex[p] = i;
+            pData[p++] = w.fValues[i];
+         }
+      }
+      return p;
+   };
+
+#ifdef R__USE_IMT
+   // Large products are computed by blocks of columns in parallel: the symbolic pass
+   // gives the position of each column in the result, so that the blocks can be filled
+   // independently.
+   constexpr Int_t kColBlock = 256;
+   const Int_t nblocks = (cols + kColBlock - 1) / kColBlock;
+   if (ROOT::IsImplicitMTEnabled() && nblocks > 1 && lhs.GetNoElements() + rhs.GetNoElements() >= 100000) {
+      ROOT::TThreadExecutor pool;
+      std::vector<Int_t> counts(cols + 1, 0);
+      pool.Foreach(
+         [&](Int_t ib) {
+            Work w(rows);
+            for (Int_t j = ib * kColBlock; j < std::min(cols, (ib + 1) * kColBlock); ++j)
+               counts[j + 1] = symbolic(j, w);
+         },
+         ROOT::TSeqI(nblocks));
+      for (Int_t j = 0; j < cols; ++j)
+         counts[j + 1] += counts[j];
+
+      if (constr) {
+         Allocate(cols, rows, colsLwb, rowsLwb, 1, counts[cols]);
+         if (counts[cols] == 0)
+            return;
+      } else if (this->fNelems != counts[cols]) {
+         Error("conservative_sparse_sparse_product_impl", "non zeros numbers do not match");
+         return;
+      }
+
+      Int_t *pRowIndex = this->GetRowIndexArray();
+      Int_t *pColIndex = this->GetColIndexArray();
+      Element *pData = this->GetMatrixArray();
+      std::copy(counts.begin(), counts.end(), pRowIndex);
+      pool.Foreach(
+         [&](Int_t ib) {
+            Work w(rows);
+            for (Int_t j = ib * kColBlock; j < std::min(cols, (ib + 1) * kColBlock); ++j)
+               numeric(j, w, pColIndex, pData, pRowIndex[j]);
+         },
+         ROOT::TSeqI(nblocks));
+      return;
+   }
+#endif
+
+   Work w(rows);
+   if (constr) {
+      // compute the number of non zero entries
+      Int_t estimated_nnz_prod = 0;
+      for (Int_t j = 0; j < cols; ++j)
+         estimated_nnz_prod += symbolic(j, w);
 
       const Int_t nc = estimated_nnz_prod; // rows*cols;
 
@@ -615,34 +711,8 @@ void TMatrixTSparse<Element>::conservative_sparse_sparse_product_impl(const TMat
    Element *pData = this->GetMatrixArray();
 
    // we compute each column of the result, one after the other
-   for (Int_t j = 0; j < cols; ++j) {
-      Int_t nnz = 0;
-      for (Int_t l = pRowIndexrhs[j]; l < pRowIndexrhs[j + 1]; ++l) {
-         double y = *(rhsVal + l);
-         Int_t k = *(rhsCol + l);
-         for (Int_t m = pRowIndexlhs[k]; m < pRowIndexlhs[k + 1]; ++m) {
-            Int_t i = *(lhsCol + m);
-            double x = *(lhsVal + m);
-            if (!mask[i]) {
-               mask[i] = true;
-               values[i] = x * y;
-               indices[nnz] = i;
-               ++nnz;
-            } else
-               values[i] += x * y;
-         }
-      }
-      pRowIndex[j + 1] = pRowIndex[j];
-      for (Int_t i = 0; i < rows; ++i) {
-         if (mask[i]) {
-            mask[i] = false;
-            Int_t p = pRowIndex[j + 1];
-            ++pRowIndex[j + 1];
-            pColIndex[p] = i;
-            pData[p] = values[i];
-         }
-      }
-   }
+   for (Int_t j = 0; j < cols; ++j)
+      pRowIndex[j + 1] = numeric(j, w, pColIndex, pData, pRowIndex[j]);
 
    if (gMatrixCheck) {
       if (this->fNelems != pRowIndex[cols]) {
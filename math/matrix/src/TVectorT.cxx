@@ -43,8 +43,51 @@ For usage examples see `$ROOTSYS/test/stressLinear.cxx`
 #include "TROOT.h"
 #include "Varargs.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
+
 templateClassImp(TVectorT);
 
+namespace {
+// Products of sparse matrices having at least kSparseParallelNnz non-zero elements with a
+// vector are computed by blocks of kSparseRowBlock rows, in parallel if implicit
+// multithreading is enabled. Each row is summed in the same order in both cases.
+constexpr Int_t kSparseParallelNnz = 100000;
+constexpr Int_t kSparseRowBlock = 1024;
+
+/// Call STORE(irow, sum) with the dot product of each row of A with the array SP.
+template <class Element, class Store>
+void SparseRowProducts(const TMatrixTSparse<Element> &a, const Element *sp, Store &&store)
+{
+   const Int_t nrows = a.GetNrows();
+   const Int_t *const pRowIndex = a.GetRowIndexArray();
+   const Int_t *const pColIndex = a.GetColIndexArray();
+   const Element *const mp = a.GetMatrixArray();
+   auto rows = [&](Int_t first, Int_t last) {
+      for (Int_t irow = first; irow < last; irow++) {
+         Element sum = 0.0;
+         for (Int_t index = pRowIndex[irow]; index < pRowIndex[irow + 1]; index++)
+            sum += mp[index] * sp[pColIndex[index]];
+         store(irow, sum);
+      }
+   };
+#ifdef R__USE_IMT
+   const Int_t nblocks = (nrows + kSparseRowBlock - 1) / kSparseRowBlock;
+   if (ROOT::IsImplicitMTEnabled() && nblocks > 1 && a.GetNoElements() >= kSparseParallelNnz) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t ib) { rows(ib * kSparseRowBlock, std::min(nrows, (ib + 1) * kSparseRowBlock)); },
+                   ROOT::TSeqI(nblocks));
+      return;
+   }
+#endif
+   rows(0, nrows);
+}
+} // namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete data pointer m, if it was assigned on the heap
@@ -1050,23 +1093,8 @@ TVectorT<Element> &TVectorT<Element>::operator*=(const TMatrixTSparse<Element> &
    }
    memset(fElements,0,fNrows*sizeof(Element));
 
-   const Int_t   * const pRowIndex = a.GetRowIndexArray();
-   const Int_t   * const pColIndex = a.GetColIndexArray();
-   const Element * const mp        = a.GetMatrixArray();     // Matrix row ptr
-
-   const Element * const sp = elements_old;
-         Element *       tp = this->GetMatrixArray(); // Target vector ptr
-
-   for (Int_t irow = 0; irow < fNrows; irow++) {
-      const Int_t sIndex = pRowIndex[irow];
-      const Int_t eIndex = pRowIndex[irow+1];
-      Element sum = 0.0;
-      for (Int_t index = sIndex; index < eIndex; index++) {
-         const Int_t icol = pColIndex[index];
-         sum += mp[index]*sp[icol];
-      }
-      tp[irow] = sum;
-   }
+   Element * const tp = this->GetMatrixArray(); // Target vector ptr
+   SparseRowProducts(a, elements_old, [tp](Int_t irow, Element sum) { tp[irow] = sum; });
 
    if (isAllocated)
       delete [] elements_old;
@@ -1781,60 +1809,113 @@ TVectorT<Element> &TMatrixTAutoloadOps::Add(TVectorT<Element> &target,Element sc
       }
    }
 
-   const Int_t   * const pRowIndex = a.GetRowIndexArray();
-   const Int_t   * const pColIndex = a.GetColIndexArray();
-   const Element * const mp        = a.GetMatrixArray();     // Matrix row ptr
-
    const Element * const sp = source.GetMatrixArray(); // Source vector ptr
-         Element *       tp = target.GetMatrixArray(); // Target vector ptr
+         Element * const tp = target.GetMatrixArray(); // Target vector ptr
+
+   if (scalar == 1.0)
+      SparseRowProducts(a, sp, [tp](Int_t irow, Element sum) { tp[irow] += sum; });
+   else if (scalar == 0.0)
+      SparseRowProducts(a, sp, [tp](Int_t irow, Element sum) { tp[irow] = sum; });
+   else if (scalar == -1.0)
+      SparseRowProducts(a, sp, [tp](Int_t irow, Element sum) { tp[irow] -= sum; });
+   else
+      SparseRowProducts(a, sp, [tp, scalar](Int_t irow, Element sum) { tp[irow] += scalar * sum; });
 
-   if (scalar == 1.0) {
-      for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-         const Int_t sIndex = pRowIndex[irow];
-         const Int_t eIndex = pRowIndex[irow+1];
-         Element sum = 0.0;
-         for (Int_t index = sIndex; index < eIndex; index++) {
-            const Int_t icol = pColIndex[index];
-            sum += mp[index]*sp[icol];
-         }
-         tp[irow] += sum;
-      }
-   } else if (scalar == 0.0) {
-      for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-         const Int_t sIndex = pRowIndex[irow];
-         const Int_t eIndex = pRowIndex[irow+1];
-         Element sum = 0.0;
-         for (Int_t index = sIndex; index < eIndex; index++) {
-            const Int_t icol = pColIndex[index];
-            sum += mp[index]*sp[icol];
-         }
-         tp[irow]  = sum;
+   return target;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Solve A * x = b with the Jacobi preconditioned conjugate gradient method, A being
+/// a square, symmetric and positive definite sparse matrix. x holds the initial guess
+/// on input; it is resized and set to zero if it does not match A.
+/// The iterations stop when the norm of the residual is below tol times the norm of b,
+/// or after maxIter iterations (the size of the system if maxIter <= 0).
+/// The products of A with a vector run in parallel for large matrices when implicit
+/// multithreading is enabled.
+/// Returns the number of iterations, or -1 if the method did not converge.
+
+template<class Element>
+Int_t TMatrixTAutoloadOps::SolveCG(const TMatrixTSparse<Element> &a,const TVectorT<Element> &b,TVectorT<Element> &x,
+                                   Double_t tol,Int_t maxIter)
+{
+   R__ASSERT(a.IsValid());
+   R__ASSERT(b.IsValid());
+   if (a.GetNrows() != a.GetNcols() || a.GetRowLwb() != a.GetColLwb()) {
+      Error("SolveCG","matrix should be square");
+      return -1;
+   }
+   if (a.GetNrows() != b.GetNrows() || a.GetRowLwb() != b.GetLwb()) {
+      Error("SolveCG","vector b and matrix are incompatible");
+      return -1;
+   }
+   if (!x.IsValid() || x.GetNrows() != b.GetNrows() || x.GetLwb() != b.GetLwb()) {
+      x.ResizeTo(b);
+      x.Zero();
+   }
+
+   const Int_t n = a.GetNrows();
+   if (maxIter <= 0)
+      maxIter = n;
+
+   // inverse of the diagonal as preconditioner
+   std::vector<Element> invDiag(n, Element(1.0));
+   const Int_t   * const pRowIndex = a.GetRowIndexArray();
+   const Int_t   * const pColIndex = a.GetColIndexArray();
+   const Element * const mp        = a.GetMatrixArray();
+   for (Int_t irow = 0; irow < n; irow++) {
+      for (Int_t index = pRowIndex[irow]; index < pRowIndex[irow+1]; index++) {
+         if (pColIndex[index] == irow && mp[index] != 0.0)
+            invDiag[irow] = 1.0/mp[index];
       }
-   } else if (scalar == -1.0) {
-     for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-        const Int_t sIndex = pRowIndex[irow];
-        const Int_t eIndex = pRowIndex[irow+1];
-        Element sum = 0.0;
-        for (Int_t index = sIndex; index < eIndex; index++) {
-           const Int_t icol = pColIndex[index];
-           sum += mp[index]*sp[icol];
-        }
-        tp[irow] -= sum;
+   }
+
+   std::vector<Element> r(n), z(n), p(n), q(n);
+   Element * const xp = x.GetMatrixArray();
+   const Element * const bp = b.GetMatrixArray();
+   Element * const qp = q.data();
+
+   SparseRowProducts(a, xp, [qp](Int_t irow, Element sum) { qp[irow] = sum; });
+   Double_t rz = 0.0;
+   Double_t bnorm2 = 0.0;
+   Double_t rnorm2 = 0.0;
+   for (Int_t i = 0; i < n; i++) {
+      r[i] = bp[i]-q[i];
+      z[i] = invDiag[i]*r[i];
+      p[i] = z[i];
+      rz += r[i]*z[i];
+      bnorm2 += bp[i]*bp[i];
+      rnorm2 += r[i]*r[i];
+   }
+   const Double_t threshold2 = tol*tol*(bnorm2 > 0.0 ? bnorm2 : 1.0);
+
+   for (Int_t iter = 0; iter < maxIter; iter++) {
+      if (rnorm2 <= threshold2)
+         return iter;
+      SparseRowProducts(a, p.data(), [qp](Int_t irow, Element sum) { qp[irow] = sum; });
+      Double_t pq = 0.0;
+      for (Int_t i = 0; i < n; i++)
+         pq += p[i]*q[i];
+      if (pq <= 0.0) {
+         Error("SolveCG","matrix is not positive definite");
+         return -1;
       }
-   } else {
-      for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-        const Int_t sIndex = pRowIndex[irow];
-        const Int_t eIndex = pRowIndex[irow+1];
-        Element sum = 0.0;
-        for (Int_t index = sIndex; index < eIndex; index++) {
-           const Int_t icol = pColIndex[index];
-           sum += mp[index]*sp[icol];
-        }
-        tp[irow] += scalar * sum;
+      const Double_t alpha = rz/pq;
+      Double_t rz_new = 0.0;
+      rnorm2 = 0.0;
+      for (Int_t i = 0; i < n; i++) {
+         xp[i] += alpha*p[i];
+         r[i]  -= alpha*q[i];
+         z[i]   = invDiag[i]*r[i];
+         rz_new += r[i]*z[i];
+         rnorm2 += r[i]*r[i];
       }
+      const Double_t beta = rz_new/rz;
+      rz = rz_new;
+      for (Int_t i = 0; i < n; i++)
+         p[i] = z[i]+beta*p[i];
    }
 
-   return target;
+   return rnorm2 <= threshold2 ? maxIter : -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2391,6 +2472,8 @@ template TVectorF &TMatrixTAutoloadOps::Add                 <Float_t>(      TVec
                                                                                const TVectorF &source);
 template TVectorF &TMatrixTAutoloadOps::Add                 <Float_t>(      TVectorF       &target,       Float_t   scalar, const TMatrixFSparse &a,
                                                                                const TVectorF &source);
+template Int_t    TMatrixTAutoloadOps::SolveCG             <Float_t>(const TMatrixFSparse &a,      const TVectorF &b,     TVectorF &x,
+                                                                           Double_t tol,Int_t maxIter);
 template TVectorF &TMatrixTAutoloadOps::AddElemMult         <Float_t>(      TVectorF       &target,       Float_t   scalar, const TVectorF       &source1,
                                                                                const TVectorF &source2);
 template TVectorF &TMatrixTAutoloadOps::AddElemMult         <Float_t>(      TVectorF       &target,       Float_t   scalar, const TVectorF       &source1,
@@ -2443,6 +2526,8 @@ template TVectorD &TMatrixTAutoloadOps::Add                 <Double_t>(      TVe
                                                                                 ,      const TVectorD &source);
 template TVectorD &TMatrixTAutoloadOps::Add                 <Double_t>(      TVectorD       &target,       Double_t  scalar, const TMatrixDSparse &a
                                                                                 ,      const TVectorD &source);
+template Int_t    TMatrixTAutoloadOps::SolveCG             <Double_t>(const TMatrixDSparse &a,      const TVectorD &b,     TVectorD &x,
+                                                                           Double_t tol,Int_t maxIter);
 template TVectorD &TMatrixTAutoloadOps::AddElemMult         <Double_t>(      TVectorD       &target,       Double_t  scalar, const TVectorD       &source1,
                                                                                 const TVectorD &source2);
 template TVectorD &TMatrixTAutoloadOps::AddElemMult         <Double_t>(      TVectorD       &target,       Double_t  scalar, const TVectorD       &source1,
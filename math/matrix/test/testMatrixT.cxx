@@ -217,3 +217,36 @@ TEST_F(testMatrixD, Eigen)
 
    CompareTMatrix(B, C);
 }
+
+// Compare the blocked product kernels with the reference loops
+TEST(testMatrixBlocked, Products)
+{
+   TMatrixD a(70, 130), b(130, 90), bt(90, 130);
+   for (int i = 0; i < a.GetNrows(); i++)
+      for (int j = 0; j < a.GetNcols(); j++)
+         a(i, j) = std::sin(i + 0.3 * j);
+   for (int i = 0; i < b.GetNrows(); i++)
+      for (int j = 0; j < b.GetNcols(); j++)
+         bt(j, i) = b(i, j) = std::cos(0.7 * i - j);
+
+   const Long64_t threshold = gMatrixBlockedMult;
+   gMatrixBlockedMult = 0;
+   TMatrixD ab(a, TMatrixD::kMult, b);
+   TMatrixD atab(a, TMatrixD::kTransposeMult, TMatrixD(a, TMatrixD::kMult, b));
+   TMatrixD abt(a, TMatrixD::kMultTranspose, bt);
+   gMatrixBlockedMult = 1;
+   TMatrixD ab2(a, TMatrixD::kMult, b);
+   TMatrixD atab2(a, TMatrixD::kTransposeMult, TMatrixD(a, TMatrixD::kMult, b));
+   TMatrixD abt2(a, TMatrixD::kMultTranspose, bt);
+   gMatrixBlockedMult = threshold;
+
+   for (int i = 0; i < ab.GetNrows(); i++) {
+      for (int j = 0; j < ab.GetNcols(); j++) {
+         EXPECT_NEAR(ab(i, j), ab2(i, j), 1e-10) << "  at entry (" << i << "," << j << ")";
+         EXPECT_NEAR(abt(i, j), abt2(i, j), 1e-10) << "  at entry (" << i << "," << j << ")";
+      }
+   }
+   for (int i = 0; i < atab.GetNrows(); i++)
+      for (int j = 0; j < atab.GetNcols(); j++)
+         EXPECT_NEAR(atab(i, j), atab2(i, j), 1e-8) << "  at entry (" << i << "," << j << ")";
+}
@@ -10,11 +10,13 @@
 
 #include "TMatrixD.h"
 #include "TMatrixDSparse.h"
+#include "TVectorD.h"
 #include "TMath.h"
 
 #include "gtest/gtest.h"
 
 #include <array>
+#include <vector>
 
 // https://github.com/root-project/root/issues/13848
 TEST(testSparse, LwbInit)
@@ -133,4 +135,59 @@ TEST(testSparse, kAtA)
    TMatrixDSparse m2(TMatrixDSparse::kAtA, A);
 
    EXPECT_EQ(m1, m2);
-}
\ No newline at end of file
+}
+// Product of larger matrices, checked against the dense product
+TEST(testSparse, AMultBLarge)
+{
+   const int n = 300;
+   std::vector<Int_t> rows, cols;
+   std::vector<Double_t> data;
+   for (int i = 0; i < n; i++) {
+      for (int j = (7 * i) % 13; j < n; j += 13) {
+         rows.push_back(i);
+         cols.push_back(j);
+         data.push_back(1. + 0.01 * i - 0.02 * j);
+      }
+   }
+   TMatrixDSparse a(0, n - 1, 0, n - 1, data.size(), rows.data(), cols.data(), data.data());
+   TMatrixDSparse b(TMatrixDSparse::kTransposed, a);
+   TMatrixDSparse c(a, TMatrixDSparse::kMult, b);
+
+   TMatrixD dense(TMatrixD(a), TMatrixD::kMult, TMatrixD(b));
+   TMatrixD cdense(c);
+   for (int i = 0; i < n; i++)
+      for (int j = 0; j < n; j++)
+         EXPECT_NEAR(cdense(i, j), dense(i, j), 1e-10);
+}
+
+// Conjugate gradient solution of the discretized 1D Laplace equation
+TEST(testSparse, SolveCG)
+{
+   const int n = 500;
+   std::vector<Int_t> rows, cols;
+   std::vector<Double_t> data;
+   for (int i = 0; i < n; i++) {
+      for (int j = i - 1; j <= i + 1; j++) {
+         if (j < 0 || j >= n)
+            continue;
+         rows.push_back(i);
+         cols.push_back(j);
+         data.push_back(i == j ? 2. + 0.001 * i : -1.);
+      }
+   }
+   TMatrixDSparse a(0, n - 1, 0, n - 1, data.size(), rows.data(), cols.data(), data.data());
+   TVectorD xtrue(n);
+   for (int i = 0; i < n; i++)
+      xtrue(i) = TMath::Sin(0.01 * i);
+   TVectorD b = a * xtrue;
+
+   TVectorD x;
+   Int_t niter = SolveCG(a, b, x, 1e-12);
+   EXPECT_GT(niter, 0);
+   ASSERT_EQ(x.GetNrows(), n);
+   for (int i = 0; i < n; i++)
+      EXPECT_NEAR(x(i), xtrue(i), 1e-8);
+
+   // a converged solution as initial guess needs no iteration
+   EXPECT_EQ(SolveCG(a, b, x, 1e-6), 0);
+}
@@ -64,6 +64,10 @@ public:
       as it searches for the Minimum or performs whatever analysis is requested by
       the user.
 
+      If the numerical derivatives are computed with several threads (see
+      MnStrategy::SetNumberOfThreads()), this function is called concurrently
+      for different parameter vectors and has to be thread safe.
+
       @param v function parameters as defined by the user.
 
       @return the Value of the function.
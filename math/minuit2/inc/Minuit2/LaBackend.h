@@ -0,0 +1,37 @@
+// @(#)root/minuit2:$Id$
+// Authors: M. Winkler, F. James, L. Moneta, A. Zsenei   2003-2005
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_LaBackend
+#define ROOT_Minuit2_LaBackend
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+/// Implementation used for the BLAS-like kernels (Mndaxpy, Mndspmv, mndspr, ...)
+/// and the matrix inversion behind LAVector and LASymMatrix.
+enum class LaBackend {
+   Internal, ///< Minuit2's own translations of the reference BLAS routines and mnvert (default)
+   BLAS      ///< Optimized BLAS and LAPACK libraries, only available if Minuit2 was built with minuit2_blas=ON
+};
+
+/// Select the linear algebra backend for all following computations.
+/// Returns false, and keeps the current backend, if the requested one is not available in this build.
+bool SetLaBackend(LaBackend backend);
+
+LaBackend GetLaBackend();
+
+/// Whether the given linear algebra backend is available in this build.
+bool IsLaBackendAvailable(LaBackend backend);
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_LaBackend
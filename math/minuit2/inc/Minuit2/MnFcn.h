@@ -13,6 +13,8 @@
 #include "Minuit2/MnConfig.h"
 #include "Minuit2/MnMatrix.h"
 
+#include <atomic>
+
 namespace ROOT {
 
 namespace Minuit2 {
@@ -50,7 +52,7 @@ private:
    const FCNBase &fFCN;
 
 protected:
-   mutable int fNumCall;
+   mutable std::atomic<int> fNumCall; ///< atomic, since the FCN may be called concurrently (see MnStrategy::SetNumberOfThreads())
 };
 
 } // namespace Minuit2
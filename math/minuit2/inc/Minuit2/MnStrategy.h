@@ -50,6 +50,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   unsigned int NumberOfThreads() const { return fNThreads; }
+
    bool IsLow() const { return fStrategy == 0; }
    bool IsMedium() const { return fStrategy == 1; }
    bool IsHigh() const { return fStrategy == 2; }
@@ -81,6 +83,14 @@ public:
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
 
+   // number of threads used to compute the components of the numerical gradient
+   // and the off-diagonal elements of the numerical Hessian in parallel
+   // 1 = serial computation (default)
+   // 0 = use as many threads as the ROOT implicit multi-threading pool
+   // This requires a FCN that can be evaluated concurrently (see FCNBase) and
+   // Minuit2 built as part of ROOT with imt=ON, otherwise it is ignored.
+   void SetNumberOfThreads(unsigned int n) { fNThreads = n; }
+
 private:
    unsigned int fStrategy;
 
@@ -94,6 +104,7 @@ private:
    int fHessCFDG2;
    int fHessForcePosDef;
    int fStoreLevel;
+   unsigned int fNThreads;
 };
 
 } // namespace Minuit2
@@ -0,0 +1,49 @@
+// @(#)root/minuit2:$Id$
+// Authors: M. Winkler, F. James, L. Moneta, A. Zsenei   2003-2005
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/LaBackend.h"
+
+#include <atomic>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+namespace {
+
+std::atomic<LaBackend> gLaBackend{LaBackend::Internal};
+
+} // namespace
+
+bool IsLaBackendAvailable(LaBackend backend)
+{
+#ifdef MINUIT2_USE_BLAS
+   (void)backend;
+   return true;
+#else
+   return backend == LaBackend::Internal;
+#endif
+}
+
+bool SetLaBackend(LaBackend backend)
+{
+   if (!IsLaBackendAvailable(backend))
+      return false;
+   gLaBackend = backend;
+   return true;
+}
+
+LaBackend GetLaBackend()
+{
+   return gLaBackend;
+}
+
+} // namespace Minuit2
+
+} // namespace ROOT
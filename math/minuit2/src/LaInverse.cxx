@@ -9,6 +9,14 @@
 
 #include "Minuit2/LaInverse.h"
 #include "Minuit2/LASymMatrix.h"
+#include "Minuit2/LaBackend.h"
+
+#ifdef MINUIT2_USE_BLAS
+#include <vector>
+
+extern "C" void dsptrf_(const char *uplo, const int *n, double *ap, int *ipiv, int *info);
+extern "C" void dsptri_(const char *uplo, const int *n, double *ap, const int *ipiv, double *work, int *info);
+#endif
 
 namespace ROOT {
 
@@ -16,6 +24,31 @@ namespace Minuit2 {
 
 int mnvert(LASymMatrix &t);
 
+#ifdef MINUIT2_USE_BLAS
+namespace {
+
+// inversion of the packed matrix with the Bunch-Kaufman factorization from LAPACK
+int lapackInvert(LASymMatrix &t)
+{
+   const int n = t.Nrow();
+   // like mnvert, fail for matrices with negative diagonal elements
+   for (int i = 0; i < n; i++) {
+      if (t(i, i) < 0.)
+         return 1;
+   }
+   std::vector<int> ipiv(n);
+   std::vector<double> work(n);
+   int info = 0;
+   dsptrf_("U", &n, t.Data(), ipiv.data(), &info);
+   if (info != 0)
+      return 1;
+   dsptri_("U", &n, t.Data(), ipiv.data(), work.data(), &info);
+   return info != 0 ? 1 : 0;
+}
+
+} // namespace
+#endif
+
 // symmetric matrix (positive definite only)
 
 int Invert(LASymMatrix &t)
@@ -31,6 +64,10 @@ int Invert(LASymMatrix &t)
          ifail = 1;
       else
          t.Data()[0] = 1. / tmp;
+#ifdef MINUIT2_USE_BLAS
+   } else if (GetLaBackend() == LaBackend::BLAS) {
+      ifail = lapackInvert(t);
+#endif
    } else {
       ifail = mnvert(t);
    }
@@ -431,6 +431,7 @@ ROOT::Minuit2::MnStrategy customizedStrategy(unsigned int strategyLevel, ROOT::M
    st.SetGradientStepTolerance(customize("GradientStepTolerance", st.GradientStepTolerance()));
    st.SetHessianStepTolerance(customize("HessianStepTolerance", st.HessianStepTolerance()));
    st.SetHessianG2Tolerance(customize("HessianG2Tolerance", st.HessianG2Tolerance()));
+   st.SetNumberOfThreads(customize("NumberOfThreads", int(st.NumberOfThreads())));
 
    return st;
 }
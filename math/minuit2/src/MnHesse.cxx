@@ -23,6 +23,15 @@
 #include "Minuit2/MnPrint.h"
 #include "Minuit2/MPIProcess.h"
 
+#ifdef USE_ROOT_ERROR
+// implicit multi-threading is only available when Minuit2 is built within ROOT
+#include "RConfigure.h"
+#endif
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 namespace ROOT {
 
 namespace Minuit2 {
@@ -298,6 +307,40 @@ MinimumState MnHesse::ComputeNumerical(const MnFcn &mfcn, const MinimumState &st
    // off-diagonal Elements
    // initial starting values
    bool doCentralFD = fStrategy.HessianCentralFDMixedDerivatives();
+#ifdef R__USE_IMT
+   if (n > 1 && fStrategy.NumberOfThreads() != 1) {
+      // compute the elements in parallel, each with its own copy of the point
+      std::vector<std::pair<unsigned int, unsigned int>> elements;
+      elements.reserve(n * (n - 1) / 2);
+      for (unsigned int i = 0; i < n; i++) {
+         for (unsigned int j = i + 1; j < n; j++)
+            elements.emplace_back(i, j);
+      }
+      ROOT::TThreadExecutor pool(fStrategy.NumberOfThreads());
+      pool.Foreach(
+         [&](unsigned int k) {
+            const unsigned int i = elements[k].first;
+            const unsigned int j = elements[k].second;
+            MnAlgebraicVector xij = x;
+            xij(i) += dirin(i);
+            xij(j) += dirin(j);
+            double fs1 = mfcn(xij);
+            if (!doCentralFD) {
+               vhmat(i, j) = (fs1 + amin - yy(i) - yy(j)) / (dirin(i) * dirin(j));
+            } else {
+               // three more function evaluations required for central fd
+               xij(i) -= 2. * dirin(i);
+               double fs3 = mfcn(xij);
+               xij(j) -= 2. * dirin(j);
+               double fs4 = mfcn(xij);
+               xij(i) += 2. * dirin(i);
+               double fs2 = mfcn(xij);
+               vhmat(i, j) = (fs1 - fs2 - fs3 + fs4) / (4. * dirin(i) * dirin(j));
+            }
+         },
+         ROOT::TSeqU(elements.size()));
+   } else
+#endif
    if (n > 0) {
       MPIProcess mpiprocOffDiagonal(n * (n - 1) / 2, 0);
       unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
@@ -27,6 +27,15 @@
 
 #include "Minuit2/MPIProcess.h"
 
+#ifdef USE_ROOT_ERROR
+// implicit multi-threading is only available when Minuit2 is built within ROOT
+#include "RConfigure.h"
+#endif
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 namespace ROOT {
 
 namespace Minuit2 {
@@ -97,35 +106,10 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
 
    print.Debug("Calculating gradient around function value", fcnmin, "\n\t at point", par.Vec());
 
-#ifndef _OPENMP
-
-   MPIProcess mpiproc(n, 0);
-
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
-   // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-   //#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for (int i = 0; i < int(n); i++) {
-
-#endif
-
-#ifdef _OPENMP
-      // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
-
+   // Computes the derivative with respect to parameter i at the point x. The
+   // components are independent of each other, so this can be done in parallel
+   // as long as every thread uses its own copy of x and its own MnPrint.
+   auto computeComponent = [&](unsigned int i, MnAlgebraicVector &x, MnPrint &printer) {
       double xtf = x(i);
       double epspri = eps2 + std::fabs(grd(i) * eps2);
       double stepb4 = 0.;
@@ -173,26 +157,14 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
 #pragma omp critical
 #endif
          {
-#ifdef _OPENMP
-            // must create thread-local MnPrint instances when printing inside threads
-            MnPrint printtl("Numerical2PGradientCalculator[OpenMP]");
-#endif
             if (i == 0 && j == 0) {
-#ifdef _OPENMP
-               printtl.Trace([&](std::ostream &os) {
-#else
-               print.Trace([&](std::ostream &os) {
-#endif
+               printer.Trace([&](std::ostream &os) {
                   os << std::setw(10) << "parameter" << std::setw(6) << "cycle" << std::setw(15) << "x" << std::setw(15)
                      << "step" << std::setw(15) << "f1" << std::setw(15) << "f2" << std::setw(15) << "grd"
                      << std::setw(15) << "g2" << std::endl;
                });
             }
-#ifdef _OPENMP
-            printtl.Trace([&](std::ostream &os) {
-#else
-            print.Trace([&](std::ostream &os) {
-#endif
+            printer.Trace([&](std::ostream &os) {
                const int pr = os.precision(13);
                const int iext = Trafo().ExtOfInt(i);
                os << std::setw(10) << Trafo().Name(iext) << std::setw(5) << j << "  " << x(i) << " " << step << " "
@@ -209,17 +181,55 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
             break;
          }
       }
+   };
+
+#ifdef R__USE_IMT
+   if (Strategy().NumberOfThreads() != 1) {
+      ROOT::TThreadExecutor pool(Strategy().NumberOfThreads());
+      pool.Foreach(
+         [&](unsigned int i) {
+            // each task needs its own copy of the point and its own MnPrint
+            MnAlgebraicVector x = par.Vec();
+            MnPrint printtl("Numerical2PGradientCalculator[IMT]");
+            computeComponent(i, x, printtl);
+         },
+         ROOT::TSeqU(n));
+   } else
+#endif
+   {
+#ifndef _OPENMP
 
-      //     vgrd(i) = grd;
-      //     vgrd2(i) = g2;
-      //     vgstp(i) = gstep;
-   }
+      MPIProcess mpiproc(n, 0);
+
+      // for serial execution this can be outside the loop
+      MnAlgebraicVector x = par.Vec();
+
+      unsigned int startElementIndex = mpiproc.StartElementIndex();
+      unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+      for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
+         computeComponent(i, x, print);
+      }
+
+      mpiproc.SyncVector(grd);
+      mpiproc.SyncVector(g2);
+      mpiproc.SyncVector(gstep);
+
+#else
+
+      // parallelize this loop using OpenMP
+#pragma omp parallel
+#pragma omp for
+      for (int i = 0; i < int(n); i++) {
+         // create in loop since each thread will use its own copy
+         MnAlgebraicVector x = par.Vec();
+         // must create thread-local MnPrint instances when printing inside threads
+         MnPrint printtl("Numerical2PGradientCalculator[OpenMP]");
+         computeComponent(i, x, printtl);
+      }
 
-#ifndef _OPENMP
-   mpiproc.SyncVector(grd);
-   mpiproc.SyncVector(g2);
-   mpiproc.SyncVector(gstep);
 #endif
+   }
 
    // print after parallel processing to avoid synchronization issues
    print.Debug([&](std::ostream &os) {
@@ -14,12 +14,25 @@
 
 #include <cmath>
 
+#include "Minuit2/LaBackend.h"
+
+#ifdef MINUIT2_USE_BLAS
+extern "C" double dasum_(const int *n, const double *dx, const int *incx);
+#endif
+
 namespace ROOT {
 
 namespace Minuit2 {
 
 double mndasum(unsigned int n, const double *dx, int incx)
 {
+#ifdef MINUIT2_USE_BLAS
+   if (GetLaBackend() == LaBackend::BLAS) {
+      const int nn = n;
+      return dasum_(&nn, dx, &incx);
+   }
+#endif
+
    /* System generated locals */
    int i__1, i__2;
    double ret_val, d__1, d__2, d__3, d__4, d__5, d__6;
@@ -12,12 +12,26 @@
       -lf2c -lm   (in that order)
 */
 
+#include "Minuit2/LaBackend.h"
+
+#ifdef MINUIT2_USE_BLAS
+extern "C" void daxpy_(const int *n, const double *da, const double *dx, const int *incx, double *dy, const int *incy);
+#endif
+
 namespace ROOT {
 
 namespace Minuit2 {
 
 int Mndaxpy(unsigned int n, double da, const double *dx, int incx, double *dy, int incy)
 {
+#ifdef MINUIT2_USE_BLAS
+   if (GetLaBackend() == LaBackend::BLAS) {
+      const int nn = n;
+      daxpy_(&nn, &da, dx, &incx, dy, &incy);
+      return 0;
+   }
+#endif
+
    /* System generated locals */
    int i__1;
 
@@ -12,12 +12,25 @@
    -lf2c -lm   (in that order)
 */
 
+#include "Minuit2/LaBackend.h"
+
+#ifdef MINUIT2_USE_BLAS
+extern "C" double ddot_(const int *n, const double *dx, const int *incx, const double *dy, const int *incy);
+#endif
+
 namespace ROOT {
 
 namespace Minuit2 {
 
 double mnddot(unsigned int n, const double *dx, int incx, const double *dy, int incy)
 {
+#ifdef MINUIT2_USE_BLAS
+   if (GetLaBackend() == LaBackend::BLAS) {
+      const int nn = n;
+      return ddot_(&nn, dx, &incx, dy, &incy);
+   }
+#endif
+
    /* System generated locals */
    int i__1;
    double ret_val;
@@ -12,12 +12,26 @@
    -lf2c -lm   (in that order)
 */
 
+#include "Minuit2/LaBackend.h"
+
+#ifdef MINUIT2_USE_BLAS
+extern "C" void dscal_(const int *n, const double *da, double *dx, const int *incx);
+#endif
+
 namespace ROOT {
 
 namespace Minuit2 {
 
 int Mndscal(unsigned int n, double da, double *dx, int incx)
 {
+#ifdef MINUIT2_USE_BLAS
+   if (GetLaBackend() == LaBackend::BLAS) {
+      const int nn = n;
+      dscal_(&nn, &da, dx, &incx);
+      return 0;
+   }
+#endif
+
    /* System generated locals */
    int i__1, i__2;
 
@@ -12,6 +12,13 @@
    -lf2c -lm   (in that order)
 */
 
+#include "Minuit2/LaBackend.h"
+
+#ifdef MINUIT2_USE_BLAS
+extern "C" void dspmv_(const char *uplo, const int *n, const double *alpha, const double *ap, const double *x,
+                       const int *incx, const double *beta, double *y, const int *incy);
+#endif
+
 namespace ROOT {
 
 namespace Minuit2 {
@@ -22,6 +29,14 @@ int mnxerbla(const char *, int);
 int Mndspmv(const char *uplo, unsigned int n, double alpha, const double *ap, const double *x, int incx, double beta,
             double *y, int incy)
 {
+#ifdef MINUIT2_USE_BLAS
+   if (GetLaBackend() == LaBackend::BLAS) {
+      const int nn = n;
+      dspmv_(uplo, &nn, &alpha, ap, x, &incx, &beta, y, &incy);
+      return 0;
+   }
+#endif
+
    /* System generated locals */
    int i__1, i__2;
 
@@ -0,0 +1,353 @@
+// @(#)root/smatrix:$Id$
+
+#ifndef ROOT_Math_SMatrixBatch
+#define ROOT_Math_SMatrixBatch
+
+/**
+   \class ROOT::Math::SMatrixBatch
+   \ingroup SMatrixSVector
+
+   A batch of N fixed size D1 x D2 matrices stored as a structure of arrays
+   (SoA): the N values of the element (i,j) of all the matrices are contiguous.
+
+   The same operation applied to all the matrices of a batch, as done when fitting
+   many tracks with a Kalman filter, is written as loops whose innermost index runs
+   over the N matrices, which the compiler vectorizes. N should be a multiple of the
+   SIMD width of T (e.g. 8 floats or 4 doubles with AVX).
+
+   Symmetric matrices are stored with all their D x D elements. The element (i,j) of
+   the matrix n of the batch is accessed as m(i,j,n); a whole SMatrix can be copied in
+   and out of a batch slot with Set and Get.
+
+   @code
+   SMatrixBatch<double,5,5,8> jac, cov, res;
+   // ... fill the slots with jac.Set(n, jacobian), cov.Set(n, covariance)
+   Similarity(jac, cov, res);        // res = jac * cov * jac^T for the 8 matrices
+   bool ok[8];
+   InvertChol(res, ok);              // in-place inversion of the 8 matrices
+   @endcode
+
+   @ingroup SMatrixSVector
+*/
+
+#include "Math/SMatrix.h"
+#include "Math/SVector.h"
+
+#include <cmath>
+
+namespace ROOT {
+
+namespace Math {
+
+template <class T, unsigned int D1, unsigned int D2 = D1, unsigned int N = 8>
+class SMatrixBatch {
+public:
+   typedef T value_type;
+
+   enum {
+      kRows = D1,       ///< number of rows of each matrix
+      kCols = D2,       ///< number of columns of each matrix
+      kSize = D1 * D2,  ///< number of elements of each matrix
+      kBatch = N        ///< number of matrices
+   };
+
+   /// all the elements are set to zero
+   SMatrixBatch() : fArray() {}
+
+   /// element (i,j) of the matrix n
+   T &operator()(unsigned int i, unsigned int j, unsigned int n) { return fArray[(i * D2 + j) * N + n]; }
+   const T &operator()(unsigned int i, unsigned int j, unsigned int n) const { return fArray[(i * D2 + j) * N + n]; }
+
+   /// the N values of the element (i,j), contiguous
+   T *Lanes(unsigned int i, unsigned int j) { return fArray + (i * D2 + j) * N; }
+   const T *Lanes(unsigned int i, unsigned int j) const { return fArray + (i * D2 + j) * N; }
+
+   T *Array() { return fArray; }
+   const T *Array() const { return fArray; }
+
+   /// copy the matrix m into the slot n
+   template <class R>
+   void Set(unsigned int n, const SMatrix<T, D1, D2, R> &m)
+   {
+      for (unsigned int i = 0; i < D1; ++i)
+         for (unsigned int j = 0; j < D2; ++j)
+            (*this)(i, j, n) = m(i, j);
+   }
+
+   /// copy the slot n into the matrix m. For a symmetric m, the lower triangle is used.
+   template <class R>
+   void Get(unsigned int n, SMatrix<T, D1, D2, R> &m) const
+   {
+      for (unsigned int i = 0; i < D1; ++i)
+         for (unsigned int j = 0; j < D2; ++j)
+            m(i, j) = (*this)(i, j, n);
+   }
+
+private:
+   alignas(64) T fArray[D1 * D2 * N];
+};
+
+/**
+   A batch of N vectors of dimension D, stored as a structure of arrays, see SMatrixBatch.
+
+   @ingroup SMatrixSVector
+*/
+template <class T, unsigned int D, unsigned int N = 8>
+class SVectorBatch {
+public:
+   typedef T value_type;
+
+   enum {
+      kSize = D, ///< dimension of each vector
+      kBatch = N ///< number of vectors
+   };
+
+   /// all the elements are set to zero
+   SVectorBatch() : fArray() {}
+
+   /// element i of the vector n
+   T &operator()(unsigned int i, unsigned int n) { return fArray[i * N + n]; }
+   const T &operator()(unsigned int i, unsigned int n) const { return fArray[i * N + n]; }
+
+   /// the N values of the element i, contiguous
+   T *Lanes(unsigned int i) { return fArray + i * N; }
+   const T *Lanes(unsigned int i) const { return fArray + i * N; }
+
+   /// copy the vector v into the slot n
+   void Set(unsigned int n, const SVector<T, D> &v)
+   {
+      for (unsigned int i = 0; i < D; ++i)
+         (*this)(i, n) = v(i);
+   }
+
+   /// copy the slot n into the vector v
+   void Get(unsigned int n, SVector<T, D> &v) const
+   {
+      for (unsigned int i = 0; i < D; ++i)
+         v(i) = (*this)(i, n);
+   }
+
+private:
+   alignas(64) T fArray[D * N];
+};
+
+/**
+   Batched matrix product: C = A * B for each of the N matrices.
+   C must not alias A or B.
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D, unsigned int D2, unsigned int N>
+inline void Multiply(const SMatrixBatch<T, D1, D, N> &a, const SMatrixBatch<T, D, D2, N> &b,
+                     SMatrixBatch<T, D1, D2, N> &c)
+{
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         T *cl = c.Lanes(i, j);
+         for (unsigned int n = 0; n < N; ++n)
+            cl[n] = 0;
+         for (unsigned int k = 0; k < D; ++k) {
+            const T *al = a.Lanes(i, k);
+            const T *bl = b.Lanes(k, j);
+            for (unsigned int n = 0; n < N; ++n)
+               cl[n] += al[n] * bl[n];
+         }
+      }
+   }
+}
+
+/**
+   Batched matrix-vector product: r = A * v for each of the N matrices.
+   r must not alias v.
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, unsigned int N>
+inline void Multiply(const SMatrixBatch<T, D1, D2, N> &a, const SVectorBatch<T, D2, N> &v, SVectorBatch<T, D1, N> &r)
+{
+   for (unsigned int i = 0; i < D1; ++i) {
+      T *rl = r.Lanes(i);
+      for (unsigned int n = 0; n < N; ++n)
+         rl[n] = 0;
+      for (unsigned int k = 0; k < D2; ++k) {
+         const T *al = a.Lanes(i, k);
+         const T *vl = v.Lanes(k);
+         for (unsigned int n = 0; n < N; ++n)
+            rl[n] += al[n] * vl[n];
+      }
+   }
+}
+
+/**
+   Batched transposition: At = A^T for each of the N matrices.
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, unsigned int N>
+inline void Transpose(const SMatrixBatch<T, D1, D2, N> &a, SMatrixBatch<T, D2, D1, N> &at)
+{
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         const T *al = a.Lanes(i, j);
+         T *tl = at.Lanes(j, i);
+         for (unsigned int n = 0; n < N; ++n)
+            tl[n] = al[n];
+      }
+   }
+}
+
+/**
+   Batched similarity product: B = U * A * U^T for each of the N matrices, A being
+   symmetric. Only the lower triangle of A is read; B is symmetric and fully filled.
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, unsigned int N>
+inline void Similarity(const SMatrixBatch<T, D1, D2, N> &u, const SMatrixBatch<T, D2, D2, N> &a,
+                       SMatrixBatch<T, D1, D1, N> &b)
+{
+   // tmp = U * A
+   SMatrixBatch<T, D1, D2, N> tmp;
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         T *tl = tmp.Lanes(i, j);
+         for (unsigned int k = 0; k < D2; ++k) {
+            const T *ul = u.Lanes(i, k);
+            const T *al = k >= j ? a.Lanes(k, j) : a.Lanes(j, k);
+            for (unsigned int n = 0; n < N; ++n)
+               tl[n] += ul[n] * al[n];
+         }
+      }
+   }
+   // B = tmp * U^T, lower triangle then mirrored
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         T *bl = b.Lanes(i, j);
+         for (unsigned int n = 0; n < N; ++n)
+            bl[n] = 0;
+         for (unsigned int k = 0; k < D2; ++k) {
+            const T *tl = tmp.Lanes(i, k);
+            const T *ul = u.Lanes(j, k);
+            for (unsigned int n = 0; n < N; ++n)
+               bl[n] += tl[n] * ul[n];
+         }
+         if (j < i) {
+            T *bt = b.Lanes(j, i);
+            for (unsigned int n = 0; n < N; ++n)
+               bt[n] = bl[n];
+         }
+      }
+   }
+}
+
+/**
+   Batched in-place inversion of symmetric positive definite matrices using the
+   Cholesky decomposition A = L * L^T, A^-1 = L^-T * L^-1. Only the lower triangle
+   of A is read; the inverse is fully filled.
+
+   The N inversions run in lockstep. A matrix which is not positive definite does not
+   stop the others: its slot is left unspecified and, if ok is given, ok[n] is set
+   to false.
+
+   @return true if all the N matrices were inverted
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D, unsigned int N>
+inline bool InvertChol(SMatrixBatch<T, D, D, N> &a, bool *ok = nullptr)
+{
+   bool good[N];
+   for (unsigned int n = 0; n < N; ++n)
+      good[n] = true;
+
+   // decomposition: the lower triangle of a is replaced by L, storing 1/L(j,j) on the diagonal
+   for (unsigned int j = 0; j < D; ++j) {
+      T *djj = a.Lanes(j, j);
+      for (unsigned int k = 0; k < j; ++k) {
+         const T *ljk = a.Lanes(j, k);
+         for (unsigned int n = 0; n < N; ++n)
+            djj[n] -= ljk[n] * ljk[n];
+      }
+      for (unsigned int n = 0; n < N; ++n) {
+         const bool positive = djj[n] > 0;
+         good[n] = good[n] && positive;
+         djj[n] = positive ? T(1) / std::sqrt(djj[n]) : T(1);
+      }
+      for (unsigned int i = j + 1; i < D; ++i) {
+         T *lij = a.Lanes(i, j);
+         for (unsigned int k = 0; k < j; ++k) {
+            const T *lik = a.Lanes(i, k);
+            const T *ljk = a.Lanes(j, k);
+            for (unsigned int n = 0; n < N; ++n)
+               lij[n] -= lik[n] * ljk[n];
+         }
+         for (unsigned int n = 0; n < N; ++n)
+            lij[n] *= djj[n];
+      }
+   }
+
+   // inverse of L, in the lower triangle
+   for (unsigned int j = 0; j < D; ++j) {
+      for (unsigned int i = j + 1; i < D; ++i) {
+         // Linv(i,j) = -1/L(i,i) * sum_{k=j}^{i-1} L(i,k) * Linv(k,j)
+         T sum[N];
+         const T *lij = a.Lanes(i, j);
+         const T *djj = a.Lanes(j, j);
+         for (unsigned int n = 0; n < N; ++n)
+            sum[n] = lij[n] * djj[n];
+         for (unsigned int k = j + 1; k < i; ++k) {
+            const T *lik = a.Lanes(i, k);
+            const T *ikj = a.Lanes(k, j);
+            for (unsigned int n = 0; n < N; ++n)
+               sum[n] += lik[n] * ikj[n];
+         }
+         T *iij = a.Lanes(i, j);
+         const T *dii = a.Lanes(i, i);
+         for (unsigned int n = 0; n < N; ++n)
+            iij[n] = -sum[n] * dii[n];
+      }
+   }
+
+   // A^-1 = Linv^T * Linv, the diagonal of Linv being the stored 1/L(j,j)
+   for (unsigned int i = 0; i < D; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         T sum[N];
+         const T *kii = a.Lanes(i, i);
+         const T *kij = a.Lanes(i, j);
+         for (unsigned int n = 0; n < N; ++n)
+            sum[n] = kii[n] * kij[n];
+         for (unsigned int k = i + 1; k < D; ++k) {
+            const T *lki = a.Lanes(k, i);
+            const T *lkj = a.Lanes(k, j);
+            for (unsigned int n = 0; n < N; ++n)
+               sum[n] += lki[n] * lkj[n];
+         }
+         // the lower triangle still holds Linv below row i, so the result goes to the upper one
+         T *uji = a.Lanes(j, i);
+         for (unsigned int n = 0; n < N; ++n)
+            uji[n] = sum[n];
+      }
+   }
+   for (unsigned int i = 0; i < D; ++i) {
+      for (unsigned int j = 0; j < i; ++j) {
+         const T *uji = a.Lanes(j, i);
+         T *lij = a.Lanes(i, j);
+         for (unsigned int n = 0; n < N; ++n)
+            lij[n] = uji[n];
+      }
+   }
+
+   bool all = true;
+   for (unsigned int n = 0; n < N; ++n) {
+      all = all && good[n];
+      if (ok)
+         ok[n] = good[n];
+   }
+   return all;
+}
+
+} // namespace Math
+
+} // namespace ROOT
+
+#endif
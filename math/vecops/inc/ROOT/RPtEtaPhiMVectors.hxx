@@ -0,0 +1,183 @@
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPTETAPHIMVECTORS
+#define ROOT_RPTETAPHIMVECTORS
+
+#include "ROOT/RVec.hxx"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ROOT {
+namespace Internal {
+namespace VecOps {
+
+// Vectorised kernels of RPtEtaPhiMVectors, see RVecKernels.cxx
+void PtEtaPhiMToPxPyPzEImpl(const float *pt, const float *eta, const float *phi, const float *m, std::size_t n,
+                            float *px, float *py, float *pz, float *e);
+void PtEtaPhiMToPxPyPzEImpl(const double *pt, const double *eta, const double *phi, const double *m, std::size_t n,
+                            double *px, double *py, double *pz, double *e);
+void CombinationMassesImpl(const float *pt, const float *eta, const float *phi, const float *m, std::size_t n,
+                           float *out);
+void CombinationMassesImpl(const double *pt, const double *eta, const double *phi, const double *m, std::size_t n,
+                           double *out);
+void DeltaRMatrixImpl(const float *eta1, const float *phi1, std::size_t n1, const float *eta2, const float *phi2,
+                      std::size_t n2, float c, float *out);
+void DeltaRMatrixImpl(const double *eta1, const double *phi1, std::size_t n1, const double *eta2, const double *phi2,
+                      std::size_t n2, double c, double *out);
+void BoostImpl(const float *pt, const float *eta, const float *phi, const float *m, std::size_t n, float bx, float by,
+               float bz, float *ptOut, float *etaOut, float *phiOut);
+void BoostImpl(const double *pt, const double *eta, const double *phi, const double *m, std::size_t n, double bx,
+               double by, double bz, double *ptOut, double *etaOut, double *phiOut);
+
+} // namespace VecOps
+} // namespace Internal
+
+namespace VecOps {
+
+/**
+\class ROOT::VecOps::RPtEtaPhiMVectors
+\ingroup vecops
+\brief A collection of four-vectors in the (pt, eta, phi, mass) coordinate system, stored as a structure of arrays.
+
+The four components are kept in four RVecs, as they are read from a dataset, instead of an RVec of
+ROOT::Math::PtEtaPhiMVector. The kinematic functions process whole collections with loops that the
+compiler vectorises, converting the coordinates of many vectors at once.
+
+A collection constructed from RVec lvalues, e.g. the columns of an RDataFrame, refers to their memory without
+copying it: these RVecs must outlive the collection. RVec rvalues are moved into the collection.
+
+~~~{.cpp}
+df.Define("mjj", [](const RVecF &pt, const RVecF &eta, const RVecF &phi, const RVecF &m) {
+     return RPtEtaPhiMVectors<float>(pt, eta, phi, m).CombinationMasses();
+  }, {"Jet_pt", "Jet_eta", "Jet_phi", "Jet_mass"});
+~~~
+*/
+template <typename T>
+class RPtEtaPhiMVectors {
+   static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+                 "RPtEtaPhiMVectors only supports float and double");
+
+   RVec<T> fPt;
+   RVec<T> fEta;
+   RVec<T> fPhi;
+   RVec<T> fM;
+
+   /// View on the memory of v, which is never modified through it
+   static RVec<T> Adopt(const RVec<T> &v) { return RVec<T>(const_cast<T *>(v.data()), v.size()); }
+   static RVec<T> Adopt(RVec<T> &&v) { return std::move(v); }
+
+   void CheckSizes() const
+   {
+      const auto size = fPt.size();
+      if (fEta.size() != size || fPhi.size() != size || fM.size() != size)
+         throw std::runtime_error("RPtEtaPhiMVectors: the components have different sizes.");
+   }
+
+public:
+   RPtEtaPhiMVectors() = default;
+
+   template <typename Pt_t, typename Eta_t, typename Phi_t, typename M_t>
+   RPtEtaPhiMVectors(Pt_t &&pt, Eta_t &&eta, Phi_t &&phi, M_t &&m)
+      : fPt(Adopt(std::forward<Pt_t>(pt))),
+        fEta(Adopt(std::forward<Eta_t>(eta))),
+        fPhi(Adopt(std::forward<Phi_t>(phi))),
+        fM(Adopt(std::forward<M_t>(m)))
+   {
+      CheckSizes();
+   }
+
+   /// Copy the components of an RVec of four-vectors, e.g. ROOT::Math::PtEtaPhiMVector
+   template <typename LV>
+   static RPtEtaPhiMVectors FromLorentzVectors(const RVec<LV> &v)
+   {
+      RVec<T> pt(v.size()), eta(v.size()), phi(v.size()), m(v.size());
+      for (std::size_t i = 0; i < v.size(); ++i) {
+         pt[i] = v[i].Pt();
+         eta[i] = v[i].Eta();
+         phi[i] = v[i].Phi();
+         m[i] = v[i].M();
+      }
+      return RPtEtaPhiMVectors(std::move(pt), std::move(eta), std::move(phi), std::move(m));
+   }
+
+   /// Build an RVec of four-vectors, e.g. ROOT::Math::PtEtaPhiMVector, from the collection
+   template <typename LV>
+   RVec<LV> ToLorentzVectors() const
+   {
+      return Construct<LV>(fPt, fEta, fPhi, fM);
+   }
+
+   std::size_t size() const { return fPt.size(); }
+   const RVec<T> &Pt() const { return fPt; }
+   const RVec<T> &Eta() const { return fEta; }
+   const RVec<T> &Phi() const { return fPhi; }
+   const RVec<T> &M() const { return fM; }
+
+   /// Fill the cartesian components of the vectors
+   void ToPxPyPzE(RVec<T> &px, RVec<T> &py, RVec<T> &pz, RVec<T> &e) const
+   {
+      const auto n = size();
+      px.resize(n);
+      py.resize(n);
+      pz.resize(n);
+      e.resize(n);
+      Internal::VecOps::PtEtaPhiMToPxPyPzEImpl(fPt.data(), fEta.data(), fPhi.data(), fM.data(), n, px.data(),
+                                               py.data(), pz.data(), e.data());
+   }
+
+   /// Invariant masses of the pairs made of the i-th vectors of this and other
+   RVec<T> InvariantMasses(const RPtEtaPhiMVectors &other) const
+   {
+      if (other.size() != size())
+         throw std::runtime_error("RPtEtaPhiMVectors: cannot pair collections of different sizes.");
+      return Internal::VecOps::InvariantMassesImpl(fPt, fEta, fPhi, fM, other.fPt, other.fEta, other.fPhi, other.fM);
+   }
+
+   /// Invariant masses of all the pairs (i, j), i < j, of vectors of the collection, in the order of
+   /// Combinations(size(), 2)
+   RVec<T> CombinationMasses() const
+   {
+      const auto n = size();
+      RVec<T> r(n > 1 ? n * (n - 1) / 2 : 0);
+      Internal::VecOps::CombinationMassesImpl(fPt.data(), fEta.data(), fPhi.data(), fM.data(), n, r.data());
+      return r;
+   }
+
+   /// Invariant mass of the sum of all the vectors
+   T InvariantMass() const { return ROOT::VecOps::InvariantMass(fPt, fEta, fPhi, fM); }
+
+   /// Distances in the (eta, phi) plane between the vectors of this and other, as a size() x other.size()
+   /// matrix stored by rows. The difference in phi is computed modulo c.
+   RVec<T> DeltaRMatrix(const RPtEtaPhiMVectors &other, T c = M_PI) const
+   {
+      RVec<T> r(size() * other.size());
+      Internal::VecOps::DeltaRMatrixImpl(fEta.data(), fPhi.data(), size(), other.fEta.data(), other.fPhi.data(),
+                                         other.size(), c, r.data());
+      return r;
+   }
+
+   /// Vectors boosted by the velocity (bx, by, bz), in units of c
+   RPtEtaPhiMVectors Boost(T bx, T by, T bz) const
+   {
+      const auto n = size();
+      RVec<T> pt(n), eta(n), phi(n);
+      Internal::VecOps::BoostImpl(fPt.data(), fEta.data(), fPhi.data(), fM.data(), n, bx, by, bz, pt.data(),
+                                  eta.data(), phi.data());
+      return RPtEtaPhiMVectors(std::move(pt), std::move(eta), std::move(phi), RVec<T>(fM));
+   }
+};
+
+} // namespace VecOps
+} // namespace ROOT
+
+#endif // ROOT_RPTETAPHIMVECTORS
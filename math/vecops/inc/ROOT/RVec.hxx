@@ -60,6 +60,8 @@ namespace ROOT {
 namespace VecOps {
 template<typename T>
 class RVec;
+template <typename F>
+class RVecExpr;
 }
 
 namespace Internal {
@@ -134,6 +136,68 @@ inline uint64_t NextPowerOf2(uint64_t A)
    return A + 1;
 }
 
+/**
+\class ROOT::Internal::VecOps::RVecArena
+\brief A bump allocator for the buffers of short-lived RVecs of trivially copyable types.
+
+While an RVecArena::RScope is alive, RVecs of trivially copyable types that need to grow on the current thread take
+their new buffer from the arena instead of the heap. Such buffers are never freed individually: all of them are
+released at once by Reset(), which makes the memory available for the next allocations.
+
+An RVec whose buffer comes from an arena must not be used after the arena is reset or destroyed. Growing such an RVec
+outside of the scope moves its elements to the heap.
+*/
+class RVecArena {
+   struct RChunk {
+      std::unique_ptr<char[]> fBuffer;
+      std::size_t fSize;
+   };
+   std::vector<RChunk> fChunks;
+   std::size_t fCurrentChunk = 0; ///< Chunk allocations are taken from
+   std::size_t fOffset = 0;       ///< First free byte in the current chunk
+   std::size_t fChunkSize;
+
+public:
+   /// RAII object that makes RVecs allocate from the given arena on this thread. A null arena makes it a no-op.
+   class RScope {
+      RVecArena *fArena;
+      RVecArena *fPrevious = nullptr;
+
+   public:
+      explicit RScope(RVecArena *arena) : fArena(arena)
+      {
+         if (fArena)
+            fPrevious = RVecArena::SetCurrent(fArena);
+      }
+      RScope(const RScope &) = delete;
+      RScope &operator=(const RScope &) = delete;
+      ~RScope()
+      {
+         if (fArena)
+            RVecArena::SetCurrent(fPrevious);
+      }
+   };
+
+   explicit RVecArena(std::size_t chunkSize = 64 * 1024) : fChunkSize(chunkSize) {}
+   RVecArena(const RVecArena &) = delete;
+   RVecArena &operator=(const RVecArena &) = delete;
+
+   void *Allocate(std::size_t bytes);
+   /// Release all allocations at once. The memory is kept for the next allocations.
+   void Reset()
+   {
+      fCurrentChunk = 0;
+      fOffset = 0;
+   }
+   /// Return the total size of the memory obtained from the heap by this arena.
+   std::size_t GetReservedBytes() const;
+
+   /// Return the arena RVecs allocate from on this thread, if any.
+   static RVecArena *GetCurrent();
+   /// Set the arena RVecs allocate from on this thread and return the previous one.
+   static RVecArena *SetCurrent(RVecArena *arena);
+};
+
 /// This is all the stuff common to all SmallVectors.
 class R__CLING_PTRCHECK(off) SmallVectorBase {
 public:
@@ -146,7 +210,9 @@ protected:
    /// Always >= 0.
    // Type is signed only for consistency with fCapacity.
    Size_T fSize = 0;
-   /// Always >= -1. fCapacity == -1 indicates the RVec is in "memory adoption" mode.
+   /// Always >= -1, except for buffers allocated from an RVecArena.
+   /// fCapacity == -1 indicates the RVec is in "memory adoption" mode.
+   /// fCapacity < -1 indicates that the buffer was allocated from an RVecArena and has capacity -fCapacity.
    Size_T fCapacity;
 
    /// The maximum value of the Size_T used.
@@ -170,9 +236,19 @@ protected:
    /// If false, the RVec is in "memory adoption" mode, i.e. it is acting as a view on a memory buffer it does not own.
    bool Owns() const { return fCapacity != -1; }
 
+   /// If true, the buffer was allocated from an RVecArena: it is released with the arena and must not be freed.
+   bool IsArenaAllocated() const { return fCapacity < -1; }
+
+   /// Free a buffer obtained from the heap. Buffers allocated from an RVecArena are left alone.
+   void FreeBuffer(void *buffer) const
+   {
+      if (!IsArenaAllocated())
+         free(buffer);
+   }
+
 public:
    size_t size() const { return fSize; }
-   size_t capacity() const noexcept { return Owns() ? fCapacity : fSize; }
+   size_t capacity() const noexcept { return fCapacity >= 0 ? fCapacity : (Owns() ? -fCapacity : fSize); }
 
    R__RVEC_NODISCARD bool empty() const { return !fSize; }
 
@@ -413,7 +489,7 @@ void R__CLING_PTRCHECK(off) SmallVectorTemplateBase<T, TriviallyCopyable>::grow(
 
       // If this wasn't grown from the inline copy, deallocate the old space.
       if (!this->isSmall())
-         free(this->begin());
+         this->FreeBuffer(this->begin());
    }
 
    this->fBeginX = NewElts;
@@ -549,6 +625,180 @@ void ResetView(RVec<T> &v, T* addr, std::size_t sz)
    v.fSize = sz;
 }
 
+// Building blocks of the lazy expressions of ROOT::VecOps::Lazy().
+// Each operand of an expression is stored by value as a function of the element index.
+
+template <typename T>
+struct RExprScalar {
+   T fValue;
+   const T &operator()(std::size_t) const { return fValue; }
+};
+
+template <typename T>
+struct RExprLeaf {
+   const T *fData;
+   const T &operator()(std::size_t i) const { return fData[i]; }
+};
+
+template <typename>
+struct IsRVecExpr : std::false_type {};
+
+template <typename F>
+struct IsRVecExpr<ROOT::VecOps::RVecExpr<F>> : std::true_type {};
+
+/// The type that stores the value of an expression: lazy expressions are evaluated into an RVec.
+template <typename T>
+struct RVecExprResult {
+   using type = T;
+};
+
+template <typename F>
+struct RVecExprResult<ROOT::VecOps::RVecExpr<F>> {
+   using type = RVec<typename ROOT::VecOps::RVecExpr<F>::value_type>;
+};
+
+/// Operands that are not RVecs nor expressions are broadcast to all elements.
+template <typename T>
+using EnableIfExprScalar_t = std::enable_if_t<!IsRVecExpr<T>::value && !IsRVec<T>::value>;
+
+constexpr std::size_t kExprScalarSize = std::size_t(-1);
+
+template <typename T>
+RExprScalar<T> MakeExprTerm(const T &x)
+{
+   return {x};
+}
+
+template <typename T>
+RExprLeaf<T> MakeExprTerm(const RVec<T> &v)
+{
+   return {v.data()};
+}
+
+template <typename F>
+const F &MakeExprTerm(const ROOT::VecOps::RVecExpr<F> &e)
+{
+   return e.GetFunction();
+}
+
+template <typename T>
+std::size_t ExprSize(const T &)
+{
+   return kExprScalarSize;
+}
+
+template <typename T>
+std::size_t ExprSize(const RVec<T> &v)
+{
+   return v.size();
+}
+
+template <typename F>
+std::size_t ExprSize(const ROOT::VecOps::RVecExpr<F> &e)
+{
+   return e.size();
+}
+
+inline std::size_t CommonExprSize(std::size_t s0, std::size_t s1, const char *opName)
+{
+   if (s0 == kExprScalarSize)
+      return s1;
+   if (s1 != kExprScalarSize && s0 != s1)
+      throw std::runtime_error(std::string("Cannot call operator ") + opName + " on vectors of different sizes.");
+   return s0;
+}
+
+template <typename A, typename Op>
+auto MakeUnaryExpr(const A &a, Op op)
+{
+   auto f = [ta = MakeExprTerm(a), op](std::size_t i) { return op(ta(i)); };
+   return ROOT::VecOps::RVecExpr<decltype(f)>(std::move(f), ExprSize(a));
+}
+
+template <typename A, typename B, typename Op>
+auto MakeBinaryExpr(const A &a, const B &b, Op op, const char *opName)
+{
+   auto f = [ta = MakeExprTerm(a), tb = MakeExprTerm(b), op](std::size_t i) { return op(ta(i), tb(i)); };
+   return ROOT::VecOps::RVecExpr<decltype(f)>(std::move(f), CommonExprSize(ExprSize(a), ExprSize(b), opName));
+}
+
+// Implementations of the hot RVec helpers. The overloads for float and double are explicitly vectorised kernels,
+// compiled for several instruction sets in RVecKernels.cxx; the best one for the CPU is selected at runtime.
+
+template <typename T>
+T SumImpl(const T *v, std::size_t n, const T &zero)
+{
+   return std::accumulate(v, v + n, zero);
+}
+float SumImpl(const float *v, std::size_t n, const float &zero);
+double SumImpl(const double *v, std::size_t n, const double &zero);
+
+template <typename T>
+T MaxImpl(const T *v, std::size_t n)
+{
+   return *std::max_element(v, v + n);
+}
+float MaxImpl(const float *v, std::size_t n);
+double MaxImpl(const double *v, std::size_t n);
+
+template <typename T>
+T MinImpl(const T *v, std::size_t n)
+{
+   return *std::min_element(v, v + n);
+}
+float MinImpl(const float *v, std::size_t n);
+double MinImpl(const double *v, std::size_t n);
+
+template <typename T>
+std::size_t ArgMaxImpl(const T *v, std::size_t n)
+{
+   return std::distance(v, std::max_element(v, v + n));
+}
+std::size_t ArgMaxImpl(const float *v, std::size_t n);
+std::size_t ArgMaxImpl(const double *v, std::size_t n);
+
+template <typename T>
+std::size_t ArgMinImpl(const T *v, std::size_t n)
+{
+   return std::distance(v, std::min_element(v, v + n));
+}
+std::size_t ArgMinImpl(const float *v, std::size_t n);
+std::size_t ArgMinImpl(const double *v, std::size_t n);
+
+template <typename T>
+void TakeImpl(const T *v, const std::size_t *idx, std::size_t n, T *out)
+{
+   for (std::size_t k = 0; k < n; ++k)
+      out[k] = v[idx[k]];
+}
+void TakeImpl(const float *v, const std::size_t *idx, std::size_t n, float *out);
+void TakeImpl(const double *v, const std::size_t *idx, std::size_t n, double *out);
+
+template <typename T0, typename T1, typename T2, typename T3, typename Common_t>
+RVec<Common_t> DeltaRImpl(const RVec<T0> &eta1, const RVec<T1> &eta2, const RVec<T2> &phi1, const RVec<T3> &phi2,
+                          const Common_t c, bool squared)
+{
+   const auto dphi = DeltaPhi(phi1, phi2, c);
+   RVec<Common_t> dr2 = (eta1 - eta2) * (eta1 - eta2) + dphi * dphi;
+   return squared ? dr2 : sqrt(dr2);
+}
+RVec<float> DeltaRImpl(const RVec<float> &eta1, const RVec<float> &eta2, const RVec<float> &phi1,
+                       const RVec<float> &phi2, const float c, bool squared);
+RVec<double> DeltaRImpl(const RVec<double> &eta1, const RVec<double> &eta2, const RVec<double> &phi1,
+                        const RVec<double> &phi2, const double c, bool squared);
+
+/// Whether all arguments of a helper have the same type, for which a vectorised kernel exists.
+template <typename T, typename... Ts>
+constexpr bool HasVectorisedKernel =
+   (std::is_same<T, float>::value || std::is_same<T, double>::value) && (std::is_same<T, Ts>::value && ...);
+
+RVec<float> InvariantMassesImpl(const RVec<float> &pt1, const RVec<float> &eta1, const RVec<float> &phi1,
+                                const RVec<float> &mass1, const RVec<float> &pt2, const RVec<float> &eta2,
+                                const RVec<float> &phi2, const RVec<float> &mass2);
+RVec<double> InvariantMassesImpl(const RVec<double> &pt1, const RVec<double> &eta1, const RVec<double> &phi1,
+                                 const RVec<double> &mass1, const RVec<double> &pt2, const RVec<double> &eta2,
+                                 const RVec<double> &phi2, const RVec<double> &mass2);
+
 } // namespace VecOps
 } // namespace Internal
 
@@ -579,7 +829,7 @@ public:
       // Subclass has already destructed this vector's elements.
       // If this wasn't grown from the inline copy, deallocate the old space.
       if (!this->isSmall() && this->Owns())
-         free(this->begin());
+         this->FreeBuffer(this->begin());
    }
 
    // also give up adopted memory if applicable
@@ -1056,7 +1306,7 @@ RVecImpl<T> &RVecImpl<T>::operator=(RVecImpl<T> &&RHS)
       if (this->Owns()) {
          this->destroy_range(this->begin(), this->end());
          if (!this->isSmall())
-            free(this->begin());
+            this->FreeBuffer(this->begin());
       }
       this->fBeginX = RHS.fBeginX;
       this->fSize = RHS.fSize;
@@ -1430,6 +1680,12 @@ are vectorized:
  - fast_expf, fast_logf, fast_sinf, fast_cosf, fast_tanf, fast_asinf, fast_acosf, fast_atanf
  - fast_exp, fast_log, fast_sin, fast_cos, fast_tan, fast_asin, fast_acos, fast_atan
 
+Each of these operations returns a new RVec. A chain of operations can instead be evaluated in a single loop,
+without temporary RVecs, by starting it with Lazy() (see RVecExpr):
+~~~{.cpp}
+RVecD pt = sqrt(Lazy(px) * px + Lazy(py) * py);
+~~~
+
 \anchor owningandadoptingmemory
 ## Owning and adopting memory
 RVec has contiguous memory associated to it. It can own it or simply adopt it. In the latter case,
@@ -1582,6 +1838,21 @@ public:
 
    RVec(T* p, size_t n) : SuperClass(p, n) {}
 
+   /// Evaluate a lazy expression, see Lazy().
+   template <typename F>
+   RVec(const RVecExpr<F> &expr)
+   {
+      expr.EvalInto(*this);
+   }
+
+   /// Evaluate a lazy expression reusing the memory of this RVec, see Lazy().
+   template <typename F>
+   RVec &operator=(const RVecExpr<F> &expr)
+   {
+      expr.EvalInto(*this);
+      return *this;
+   }
+
    // conversion
    template <typename U, typename = std::enable_if<std::is_convertible<T, U>::value>>
    operator RVec<U>() const
@@ -1610,6 +1881,145 @@ inline size_t CapacityInBytes(const RVecN<T, N> &X)
    return X.capacity_in_bytes();
 }
 
+///@name RVec Lazy Expressions
+///@{
+
+// clang-format off
+/**
+\class ROOT::VecOps::RVecExpr
+\ingroup vecops
+\brief A lazily evaluated element-wise expression of RVecs, see Lazy().
+
+The operators and mathematical functions supported by RVec return a new RVecExpr when one of their operands is an
+RVecExpr, instead of computing an RVec. The whole expression is evaluated in a single loop, without temporary RVecs,
+when it is assigned to an RVec or reduced with Sum(), Any() or All():
+~~~{.cpp}
+RVecD px, py, eta;
+RVecI good = sqrt(Lazy(px) * px + Lazy(py) * py) > 20 && abs(Lazy(eta)) < 2.4;
+auto nGood = Sum(sqrt(Lazy(px) * px + Lazy(py) * py) > 20);
+~~~
+An expression refers to the data of the RVecs it was built from, so it must be evaluated before they are modified or
+destroyed: in particular, it should not be stored in an `auto` variable. RDataFrame evaluates the expressions returned
+by Define into the RVec it keeps for the defined column, so that e.g.
+`df.Define("pt", "sqrt(Lazy(px) * px + Lazy(py) * py)")` does not allocate memory once the column is large enough.
+*/
+// clang-format on
+template <typename F>
+class RVecExpr {
+   F fFunc;           ///< Returns the element at a given index
+   std::size_t fSize;
+
+public:
+   using value_type = std::decay_t<decltype(std::declval<const F &>()(std::size_t{}))>;
+
+   RVecExpr(F func, std::size_t size) : fFunc(std::move(func)), fSize(size) {}
+
+   std::size_t size() const { return fSize; }
+   bool empty() const { return fSize == 0; }
+   value_type operator[](std::size_t i) const { return fFunc(i); }
+   const F &GetFunction() const { return fFunc; }
+
+   /// Evaluate the expression into an RVec, reusing its memory if large enough.
+   template <typename T>
+   void EvalInto(RVec<T> &out) const
+   {
+      out.resize(fSize);
+      auto *data = out.data();
+      for (std::size_t i = 0; i < fSize; ++i)
+         data[i] = fFunc(i);
+   }
+
+   RVec<value_type> Eval() const { return RVec<value_type>(*this); }
+};
+
+/// Start a lazy expression, see RVecExpr.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVecD px {1., 2., 3.}, py {1., 2., 3.};
+/// RVecD pt = sqrt(Lazy(px) * px + Lazy(py) * py);
+/// pt
+/// // (ROOT::VecOps::RVec<double> &) { 1.4142136, 2.8284271, 4.2426407 }
+/// ~~~
+template <typename T>
+RVecExpr<Internal::VecOps::RExprLeaf<T>> Lazy(const RVec<T> &v)
+{
+   return {{v.data()}, v.size()};
+}
+
+// An expression must not refer to a temporary RVec
+template <typename T>
+void Lazy(RVec<T> &&) = delete;
+
+/// Return the sum of the elements of a lazy expression, evaluated without intermediate RVecs.
+template <typename F>
+auto Sum(const RVecExpr<F> &e)
+{
+   using Sum_t = std::conditional_t<std::is_same<typename RVecExpr<F>::value_type, bool>::value, std::size_t,
+                                    typename RVecExpr<F>::value_type>;
+   Sum_t sum(0);
+   for (std::size_t i = 0; i < e.size(); ++i)
+      sum += e[i];
+   return sum;
+}
+
+/// Return true if any of the elements of a lazy expression is true, stopping at the first one.
+template <typename F>
+bool Any(const RVecExpr<F> &e)
+{
+   for (std::size_t i = 0; i < e.size(); ++i)
+      if (static_cast<bool>(e[i]))
+         return true;
+   return false;
+}
+
+/// Return true if all of the elements of a lazy expression are true, stopping at the first false one.
+template <typename F>
+bool All(const RVecExpr<F> &e)
+{
+   for (std::size_t i = 0; i < e.size(); ++i)
+      if (!static_cast<bool>(e[i]))
+         return false;
+   return true;
+}
+
+/// \cond
+// The overloads of a binary operator or function NAME when at least one operand is a lazy expression
+#define RVEC_EXPR_BINARY_OVERLOADS(NAME, OPNAME, FUNC)                                                 \
+   template <typename F0, typename F1>                                                                 \
+   auto NAME(const RVecExpr<F0> &e0, const RVecExpr<F1> &e1)                                           \
+   {                                                                                                   \
+      return Internal::VecOps::MakeBinaryExpr(e0, e1, FUNC, OPNAME);                                   \
+   }                                                                                                   \
+                                                                                                       \
+   template <typename F, typename T>                                                                   \
+   auto NAME(const RVecExpr<F> &e, const RVec<T> &v)                                                   \
+   {                                                                                                   \
+      return Internal::VecOps::MakeBinaryExpr(e, v, FUNC, OPNAME);                                     \
+   }                                                                                                   \
+                                                                                                       \
+   template <typename T, typename F>                                                                   \
+   auto NAME(const RVec<T> &v, const RVecExpr<F> &e)                                                   \
+   {                                                                                                   \
+      return Internal::VecOps::MakeBinaryExpr(v, e, FUNC, OPNAME);                                     \
+   }                                                                                                   \
+                                                                                                       \
+   template <typename F, typename T, typename = Internal::VecOps::EnableIfExprScalar_t<T>>             \
+   auto NAME(const RVecExpr<F> &e, const T &y)                                                         \
+   {                                                                                                   \
+      return Internal::VecOps::MakeBinaryExpr(e, y, FUNC, OPNAME);                                     \
+   }                                                                                                   \
+                                                                                                       \
+   template <typename T, typename F, typename = Internal::VecOps::EnableIfExprScalar_t<T>>             \
+   auto NAME(const T &x, const RVecExpr<F> &e)                                                         \
+   {                                                                                                   \
+      return Internal::VecOps::MakeBinaryExpr(x, e, FUNC, OPNAME);                                     \
+   }
+/// \endcond
+
+///@}
+
 ///@name RVec Unary Arithmetic Operators
 ///@{
 
@@ -1621,6 +2031,12 @@ RVec<T> operator OP(const RVec<T> &v)                                          \
    for (auto &x : ret)                                                         \
       x = OP x;                                                                \
 return ret;                                                                    \
+}                                                                              \
+                                                                               \
+template <typename F>                                                          \
+auto operator OP(const RVecExpr<F> &e)                                         \
+{                                                                              \
+   return Internal::VecOps::MakeUnaryExpr(e, [](const auto &x) { return OP x; }); \
 }                                                                              \
 
 RVEC_UNARY_OPERATOR(+)
@@ -1669,6 +2085,9 @@ auto operator OP(const RVec<T0> &v0, const RVec<T1> &v1)                       \
    std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), op);          \
    return ret;                                                                 \
 }                                                                              \
+                                                                               \
+RVEC_EXPR_BINARY_OVERLOADS(operator OP, #OP,                                   \
+                           ([](const auto &x, const auto &y) { return x OP y; })) \
 
 RVEC_BINARY_OPERATOR(+)
 RVEC_BINARY_OPERATOR(-)
@@ -1753,6 +2172,9 @@ auto operator OP(const RVec<T0> &v0, const RVec<T1> &v1)                       \
    std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), op);          \
    return ret;                                                                 \
 }                                                                              \
+                                                                               \
+RVEC_EXPR_BINARY_OVERLOADS(operator OP, #OP,                                   \
+                           ([](const auto &x, const auto &y) -> int { return x OP y; })) \
 
 RVEC_LOGICAL_OPERATOR(<)
 RVEC_LOGICAL_OPERATOR(>)
@@ -1793,6 +2215,13 @@ using PromoteTypes = decltype(PromoteType<U>() + PromoteType<V>());
       auto f = [](const T &x) { return FUNC(x); };                             \
       std::transform(v.begin(), v.end(), ret.begin(), f);                      \
       return ret;                                                              \
+   }                                                                           \
+                                                                               \
+   template <typename F>                                                       \
+   auto NAME(const RVecExpr<F> &e)                                             \
+   {                                                                           \
+      return Internal::VecOps::MakeUnaryExpr(                                  \
+         e, [](const auto &x) -> PromoteType<std::decay_t<decltype(x)>> { return FUNC(x); }); \
    }
 
 #define RVEC_BINARY_FUNCTION(NAME, FUNC)                                       \
@@ -1825,6 +2254,12 @@ using PromoteTypes = decltype(PromoteType<U>() + PromoteType<V>());
       std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), f);        \
       return ret;                                                              \
    }                                                                           \
+                                                                               \
+   RVEC_EXPR_BINARY_OVERLOADS(NAME, #NAME,                                     \
+                              ([](const auto &x, const auto &y)                \
+                                  -> PromoteTypes<std::decay_t<decltype(x)>, std::decay_t<decltype(y)>> { \
+                                 return FUNC(x, y);                            \
+                              }))                                              \
 
 #define RVEC_STD_UNARY_FUNCTION(F) RVEC_UNARY_FUNCTION(F, std::F)
 #define RVEC_STD_BINARY_FUNCTION(F) RVEC_BINARY_FUNCTION(F, std::F)
@@ -1905,6 +2340,7 @@ RVEC_VDT_UNARY_FUNCTION(fast_atan)
 #endif // R__HAS_VDT
 
 #undef RVEC_UNARY_FUNCTION
+#undef RVEC_EXPR_BINARY_OVERLOADS
 
 ///@}
 
@@ -1953,7 +2389,7 @@ auto Dot(const RVec<T> &v0, const RVec<V> &v1) -> decltype(v0[0] * v1[0])
 template <typename T>
 T Sum(const RVec<T> &v, const T zero = T(0))
 {
-   return std::accumulate(v.begin(), v.end(), zero);
+   return Internal::VecOps::SumImpl(v.data(), v.size(), zero);
 }
 
 inline std::size_t Sum(const RVec<bool> &v, std::size_t zero = 0ul)
@@ -2032,7 +2468,7 @@ R Mean(const RVec<T> &v, const R zero)
 template <typename T>
 T Max(const RVec<T> &v)
 {
-   return *std::max_element(v.begin(), v.end());
+   return Internal::VecOps::MaxImpl(v.data(), v.size());
 }
 
 /// Get the smallest element of an RVec
@@ -2048,7 +2484,7 @@ T Max(const RVec<T> &v)
 template <typename T>
 T Min(const RVec<T> &v)
 {
-   return *std::min_element(v.begin(), v.end());
+   return Internal::VecOps::MinImpl(v.data(), v.size());
 }
 
 /// Get the index of the greatest element of an RVec
@@ -2066,7 +2502,7 @@ T Min(const RVec<T> &v)
 template <typename T>
 std::size_t ArgMax(const RVec<T> &v)
 {
-   return std::distance(v.begin(), std::max_element(v.begin(), v.end()));
+   return Internal::VecOps::ArgMaxImpl(v.data(), v.size());
 }
 
 /// Get the index of the smallest element of an RVec
@@ -2084,7 +2520,7 @@ std::size_t ArgMax(const RVec<T> &v)
 template <typename T>
 std::size_t ArgMin(const RVec<T> &v)
 {
-   return std::distance(v.begin(), std::min_element(v.begin(), v.end()));
+   return Internal::VecOps::ArgMinImpl(v.data(), v.size());
 }
 
 /// Get the variance of the elements of an RVec
@@ -2341,8 +2777,7 @@ RVec<T> Take(const RVec<T> &v, const RVec<typename RVec<T>::size_type> &i)
    using size_type = typename RVec<T>::size_type;
    const size_type isize = i.size();
    RVec<T> r(isize);
-   for (size_type k = 0; k < isize; k++)
-      r[k] = v[i[k]];
+   Internal::VecOps::TakeImpl(v.data(), i.data(), isize, r.data());
    return r;
 }
 
@@ -2988,8 +3423,7 @@ RVec<Common_t> DeltaPhi(T0 v1, const RVec<T1>& v2, const Common_t c = M_PI)
 template <typename T0, typename T1 = T0, typename T2 = T0, typename T3 = T0, typename Common_t = std::common_type_t<T0, T1, T2, T3>>
 RVec<Common_t> DeltaR2(const RVec<T0>& eta1, const RVec<T1>& eta2, const RVec<T2>& phi1, const RVec<T3>& phi2, const Common_t c = M_PI)
 {
-   const auto dphi = DeltaPhi(phi1, phi2, c);
-   return (eta1 - eta2) * (eta1 - eta2) + dphi * dphi;
+   return Internal::VecOps::DeltaRImpl(eta1, eta2, phi1, phi2, c, /*squared=*/true);
 }
 
 /// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) from
@@ -3002,7 +3436,7 @@ RVec<Common_t> DeltaR2(const RVec<T0>& eta1, const RVec<T1>& eta2, const RVec<T2
 template <typename T0, typename T1 = T0, typename T2 = T0, typename T3 = T0, typename Common_t = std::common_type_t<T0, T1, T2, T3>>
 RVec<Common_t> DeltaR(const RVec<T0>& eta1, const RVec<T1>& eta2, const RVec<T2>& phi1, const RVec<T3>& phi2, const Common_t c = M_PI)
 {
-   return sqrt(DeltaR2(eta1, eta2, phi1, phi2, c));
+   return Internal::VecOps::DeltaRImpl(eta1, eta2, phi1, phi2, c, /*squared=*/false);
 }
 
 /// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) from
@@ -3139,24 +3573,28 @@ RVec<Common_t> InvariantMasses(
    R__ASSERT(eta1.size() == size && phi1.size() == size && mass1.size() == size);
    R__ASSERT(pt2.size() == size && phi2.size() == size && mass2.size() == size);
 
-   RVec<Common_t> inv_masses(size);
+   if constexpr (Internal::VecOps::HasVectorisedKernel<T0, T1, T2, T3, T4, T5, T6, T7>) {
+      return Internal::VecOps::InvariantMassesImpl(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2);
+   } else {
+      RVec<Common_t> inv_masses(size);
 
-   for (std::size_t i = 0u; i < size; ++i) {
-      // Conversion from (pt, eta, phi, mass) to (x, y, z, mass) coordinate system
-      const auto x1 = pt1[i] * std::cos(phi1[i]);
-      const auto y1 = pt1[i] * std::sin(phi1[i]);
-      const auto z1 = pt1[i] * std::sinh(eta1[i]);
-      
-      const auto x2 = pt2[i] * std::cos(phi2[i]);
-      const auto y2 = pt2[i] * std::sin(phi2[i]);
-      const auto z2 = pt2[i] * std::sinh(eta2[i]);
-      
-      // Numerically stable computation of Invariant Masses
-      inv_masses[i] = InvariantMasses_PxPyPzM(x1, y1, z1, mass1[i], x2, y2, z2, mass2[i]);
-   }
+      for (std::size_t i = 0u; i < size; ++i) {
+         // Conversion from (pt, eta, phi, mass) to (x, y, z, mass) coordinate system
+         const auto x1 = pt1[i] * std::cos(phi1[i]);
+         const auto y1 = pt1[i] * std::sin(phi1[i]);
+         const auto z1 = pt1[i] * std::sinh(eta1[i]);
 
-   // Return invariant mass with (+, -, -, -) metric
-   return inv_masses;
+         const auto x2 = pt2[i] * std::cos(phi2[i]);
+         const auto y2 = pt2[i] * std::sin(phi2[i]);
+         const auto z2 = pt2[i] * std::sinh(eta2[i]);
+
+         // Numerically stable computation of Invariant Masses
+         inv_masses[i] = InvariantMasses_PxPyPzM(x1, y1, z1, mass1[i], x2, y2, z2, mass2[i]);
+      }
+
+      // Return invariant mass with (+, -, -, -) metric
+      return inv_masses;
+   }
 }
 
 /// Return the invariant mass of multiple particles given the collections of the
@@ -68,7 +68,19 @@ void ROOT::Internal::VecOps::SmallVectorBase::grow_pod(void *FirstEl, size_t Min
    NewCapacity = std::min(std::max(NewCapacity, MinSize), SizeTypeMax());
 
    void *NewElts;
-   if (fBeginX == FirstEl || !this->Owns()) {
+   if (auto *arena = RVecArena::GetCurrent()) {
+      // A capacity of 1 could not be told apart from memory adoption mode, see fCapacity.
+      NewCapacity = std::max<size_t>(NewCapacity, 2);
+      NewElts = arena->Allocate(NewCapacity * TSize);
+      memcpy(NewElts, this->fBeginX, size() * TSize);
+      if (fBeginX != FirstEl && this->Owns())
+         FreeBuffer(this->fBeginX);
+      this->fBeginX = NewElts;
+      this->fCapacity = -static_cast<Size_T>(NewCapacity);
+      return;
+   }
+
+   if (fBeginX == FirstEl || !this->Owns() || IsArenaAllocated()) {
       NewElts = malloc(NewCapacity * TSize);
       R__ASSERT(NewElts != nullptr);
 
@@ -84,6 +96,55 @@ void ROOT::Internal::VecOps::SmallVectorBase::grow_pod(void *FirstEl, size_t Min
    this->fCapacity = NewCapacity;
 }
 
+namespace {
+/// The arena RVecs of trivially copyable types allocate from on this thread, see RVecArena::RScope.
+thread_local ROOT::Internal::VecOps::RVecArena *gCurrentArena = nullptr;
+} // anonymous namespace
+
+void *ROOT::Internal::VecOps::RVecArena::Allocate(std::size_t bytes)
+{
+   // same alignment guarantees as malloc
+   constexpr std::size_t align = alignof(std::max_align_t);
+   bytes = (bytes + align - 1) / align * align;
+
+   while (fCurrentChunk < fChunks.size()) {
+      if (fOffset + bytes <= fChunks[fCurrentChunk].fSize) {
+         void *ptr = fChunks[fCurrentChunk].fBuffer.get() + fOffset;
+         fOffset += bytes;
+         return ptr;
+      }
+      ++fCurrentChunk;
+      fOffset = 0;
+   }
+
+   // large buffers get a chunk of their own
+   const auto chunkSize = std::max(bytes, fChunkSize);
+   // operator new[] for char only guarantees the default new alignment, which is at least that of max_align_t
+   fChunks.push_back({std::unique_ptr<char[]>(new char[chunkSize]), chunkSize});
+   fCurrentChunk = fChunks.size() - 1;
+   fOffset = bytes;
+   return fChunks.back().fBuffer.get();
+}
+
+std::size_t ROOT::Internal::VecOps::RVecArena::GetReservedBytes() const
+{
+   std::size_t bytes = 0;
+   for (const auto &chunk : fChunks)
+      bytes += chunk.fSize;
+   return bytes;
+}
+
+ROOT::Internal::VecOps::RVecArena *ROOT::Internal::VecOps::RVecArena::GetCurrent()
+{
+   return gCurrentArena;
+}
+
+ROOT::Internal::VecOps::RVecArena *ROOT::Internal::VecOps::RVecArena::SetCurrent(RVecArena *arena)
+{
+   std::swap(arena, gCurrentArena);
+   return arena;
+}
+
 #if (_VECOPS_USE_EXTERN_TEMPLATES)
 
 namespace ROOT {
@@ -0,0 +1,530 @@
+// Author: Enrico Guiraud CERN 10/2024
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Vectorised kernels of the hot RVec helpers for float and double.
+//
+// The loops are written so that the compiler can vectorise them without -ffast-math: reductions keep one accumulator
+// per SIMD lane instead of reassociating a single one, and branches are replaced by selects. On x86_64 every kernel
+// is compiled for AVX-512, AVX2 and the baseline instruction set, and the dynamic loader picks the best version for
+// the CPU, so that binary distributions of ROOT profit from wide registers without requiring them.
+
+#include "ROOT/RPtEtaPhiMVectors.hxx"
+#include "ROOT/RVec.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__x86_64__) && defined(__ELF__) && !defined(__clang__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define R__RVEC_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef R__RVEC_KERNEL
+#define R__RVEC_KERNEL
+#endif
+
+namespace {
+
+/// Number of elements of type T in a 512-bit register: loops over blocks of this size fill any SIMD unit.
+template <typename T>
+constexpr std::size_t kLanes = 64 / sizeof(T);
+
+template <typename T>
+R__ALWAYS_INLINE T SumKernel(const T *v, std::size_t n, T zero)
+{
+   T acc[kLanes<T>] = {};
+   std::size_t i = 0;
+   for (; i + kLanes<T> <= n; i += kLanes<T>)
+      for (std::size_t l = 0; l < kLanes<T>; ++l)
+         acc[l] += v[i + l];
+   // for short vectors all lanes are zero and the result is the same as a sequential sum
+   T sum = zero;
+   for (std::size_t l = 0; l < kLanes<T>; ++l)
+      sum += acc[l];
+   for (; i < n; ++i)
+      sum += v[i];
+   return sum;
+}
+
+/// Return the first element of v for which no other element is better according to `better`.
+template <typename T, typename Better>
+R__ALWAYS_INLINE T ExtremumKernel(const T *v, std::size_t n, Better better)
+{
+   if (n < kLanes<T>)
+      return *std::min_element(v, v + n, better);
+   T best[kLanes<T>];
+   std::copy(v, v + kLanes<T>, best);
+   std::size_t i = kLanes<T>;
+   for (; i + kLanes<T> <= n; i += kLanes<T>)
+      for (std::size_t l = 0; l < kLanes<T>; ++l)
+         best[l] = better(v[i + l], best[l]) ? v[i + l] : best[l];
+   T r = best[0];
+   for (std::size_t l = 1; l < kLanes<T>; ++l)
+      r = better(best[l], r) ? best[l] : r;
+   for (; i < n; ++i)
+      r = better(v[i], r) ? v[i] : r;
+   return r;
+}
+
+/// Return the index of the first element of v for which no other element is better according to `better`.
+template <typename T, typename Better>
+R__ALWAYS_INLINE std::size_t ArgExtremumKernel(const T *v, std::size_t n, Better better)
+{
+   // indices as wide as the values, so that values and indices fill registers with the same number of lanes
+   using Idx_t = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+   if (n < kLanes<T> || n > std::numeric_limits<Idx_t>::max())
+      return std::distance(v, std::min_element(v, v + n, better));
+   T best[kLanes<T>];
+   Idx_t idx[kLanes<T>];
+   for (std::size_t l = 0; l < kLanes<T>; ++l) {
+      best[l] = v[l];
+      idx[l] = l;
+   }
+   std::size_t i = kLanes<T>;
+   for (; i + kLanes<T> <= n; i += kLanes<T>) {
+      for (std::size_t l = 0; l < kLanes<T>; ++l) {
+         // strict comparison: each lane keeps the first of equal elements
+         const bool isBetter = better(v[i + l], best[l]);
+         best[l] = isBetter ? v[i + l] : best[l];
+         idx[l] = isBetter ? static_cast<Idx_t>(i + l) : idx[l];
+      }
+   }
+   T r = best[0];
+   std::size_t rIdx = idx[0];
+   for (std::size_t l = 1; l < kLanes<T>; ++l) {
+      if (better(best[l], r) || (best[l] == r && idx[l] < rIdx)) {
+         r = best[l];
+         rIdx = idx[l];
+      }
+   }
+   for (; i < n; ++i) {
+      if (better(v[i], r)) {
+         r = v[i];
+         rIdx = i;
+      }
+   }
+   return rIdx;
+}
+
+struct Greater {
+   template <typename T>
+   bool operator()(T a, T b) const
+   {
+      return a > b;
+   }
+};
+
+struct Less {
+   template <typename T>
+   bool operator()(T a, T b) const
+   {
+      return a < b;
+   }
+};
+
+template <typename T>
+R__ALWAYS_INLINE void TakeKernel(const T *v, const std::size_t *idx, std::size_t n, T *out)
+{
+   for (std::size_t k = 0; k < n; ++k)
+      out[k] = v[idx[k]];
+}
+
+/// Return whether all angle differences were in (-2c, 2c), i.e. whether the branchless wrap-around was exact.
+template <typename T>
+R__ALWAYS_INLINE bool DeltaRKernel(const T *eta1, const T *eta2, const T *phi1, const T *phi2, T c, std::size_t n,
+                                   T *out, bool squared)
+{
+   const T c2 = 2 * c;
+   bool inRange = true;
+   for (std::size_t i = 0; i < n; ++i) {
+      T dphi = phi2[i] - phi1[i];
+      inRange &= std::abs(dphi) < c2;
+      dphi = dphi < -c ? dphi + c2 : dphi;
+      dphi = dphi > c ? dphi - c2 : dphi;
+      const T deta = eta1[i] - eta2[i];
+      const T dr2 = deta * deta + dphi * dphi;
+      out[i] = squared ? dr2 : std::sqrt(dr2);
+   }
+   return inRange;
+}
+
+#ifdef R__HAS_VDT
+R__ALWAYS_INLINE float FastCos(float x)
+{
+   return vdt::fast_cosf(x);
+}
+R__ALWAYS_INLINE double FastCos(double x)
+{
+   return vdt::fast_cos(x);
+}
+R__ALWAYS_INLINE float FastSin(float x)
+{
+   return vdt::fast_sinf(x);
+}
+R__ALWAYS_INLINE double FastSin(double x)
+{
+   return vdt::fast_sin(x);
+}
+R__ALWAYS_INLINE float FastSinh(float x)
+{
+   const float e = vdt::fast_expf(x);
+   return 0.5f * (e - 1.f / e);
+}
+R__ALWAYS_INLINE double FastSinh(double x)
+{
+   const double e = vdt::fast_exp(x);
+   return 0.5 * (e - 1. / e);
+}
+#else
+template <typename T>
+R__ALWAYS_INLINE T FastCos(T x)
+{
+   return std::cos(x);
+}
+template <typename T>
+R__ALWAYS_INLINE T FastSin(T x)
+{
+   return std::sin(x);
+}
+template <typename T>
+R__ALWAYS_INLINE T FastSinh(T x)
+{
+   return std::sinh(x);
+}
+#endif
+
+template <typename T>
+R__ALWAYS_INLINE void InvariantMassesKernel(const T *pt1, const T *eta1, const T *phi1, const T *mass1, const T *pt2,
+                                           const T *eta2, const T *phi2, const T *mass2, std::size_t n, T *out)
+{
+   // The conversion to cartesian coordinates vectorises, the numerically stable mass computation does not:
+   // convert blocks of elements to buffers on the stack, then compute the masses of the block.
+   constexpr std::size_t kBlock = 4 * kLanes<T>;
+   T x1[kBlock], y1[kBlock], z1[kBlock], x2[kBlock], y2[kBlock], z2[kBlock];
+   for (std::size_t b = 0; b < n; b += kBlock) {
+      const std::size_t m = std::min(kBlock, n - b);
+      for (std::size_t k = 0; k < m; ++k) {
+         x1[k] = pt1[b + k] * FastCos(phi1[b + k]);
+         y1[k] = pt1[b + k] * FastSin(phi1[b + k]);
+         z1[k] = pt1[b + k] * FastSinh(eta1[b + k]);
+         x2[k] = pt2[b + k] * FastCos(phi2[b + k]);
+         y2[k] = pt2[b + k] * FastSin(phi2[b + k]);
+         z2[k] = pt2[b + k] * FastSinh(eta2[b + k]);
+      }
+      for (std::size_t k = 0; k < m; ++k)
+         out[b + k] = ROOT::VecOps::InvariantMasses_PxPyPzM(x1[k], y1[k], z1[k], mass1[b + k], x2[k], y2[k], z2[k],
+                                                            mass2[b + k]);
+   }
+}
+
+template <typename T>
+R__ALWAYS_INLINE void PtEtaPhiMToPxPyPzEKernel(const T *pt, const T *eta, const T *phi, const T *m, std::size_t n,
+                                              T *px, T *py, T *pz, T *e)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      px[i] = pt[i] * FastCos(phi[i]);
+      py[i] = pt[i] * FastSin(phi[i]);
+      pz[i] = pt[i] * FastSinh(eta[i]);
+      e[i] = std::sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i] + m[i] * m[i]);
+   }
+}
+
+template <typename T>
+R__ALWAYS_INLINE void CombinationMassesKernel(const T *pt, const T *eta, const T *phi, const T *m, std::size_t n,
+                                             T *out)
+{
+   // convert once, then the inner loop over the second vector of the pairs reads contiguous arrays
+   ROOT::VecOps::RVec<T> x(n), y(n), z(n), e(n);
+   PtEtaPhiMToPxPyPzEKernel(pt, eta, phi, m, n, x.data(), y.data(), z.data(), e.data());
+   std::size_t k = 0;
+   for (std::size_t i = 0; i + 1 < n; ++i)
+      for (std::size_t j = i + 1; j < n; ++j)
+         out[k++] = ROOT::VecOps::InvariantMasses_PxPyPzM(x[i], y[i], z[i], m[i], x[j], y[j], z[j], m[j]);
+}
+
+/// Return whether all angle differences were in (-2c, 2c), as DeltaRKernel.
+template <typename T>
+R__ALWAYS_INLINE bool DeltaRMatrixKernel(const T *eta1, const T *phi1, std::size_t n1, const T *eta2, const T *phi2,
+                                         std::size_t n2, T c, T *out)
+{
+   const T c2 = 2 * c;
+   bool inRange = true;
+   for (std::size_t i = 0; i < n1; ++i) {
+      T *row = out + i * n2;
+      for (std::size_t j = 0; j < n2; ++j) {
+         T dphi = phi2[j] - phi1[i];
+         inRange &= std::abs(dphi) < c2;
+         dphi = dphi < -c ? dphi + c2 : dphi;
+         dphi = dphi > c ? dphi - c2 : dphi;
+         const T deta = eta1[i] - eta2[j];
+         row[j] = std::sqrt(deta * deta + dphi * dphi);
+      }
+   }
+   return inRange;
+}
+
+template <typename T>
+R__ALWAYS_INLINE void BoostKernel(const T *pt, const T *eta, const T *phi, const T *m, std::size_t n, T bx, T by, T bz,
+                                  T *ptOut, T *etaOut, T *phiOut)
+{
+   const T b2 = bx * bx + by * by + bz * bz;
+   const T gamma = 1 / std::sqrt(1 - b2);
+   const T gamma2 = b2 > 0 ? (gamma - 1) / b2 : T(0);
+   // as for the invariant masses, the boost vectorises but the conversion back to (pt, eta, phi) does not
+   constexpr std::size_t kBlock = 4 * kLanes<T>;
+   T x[kBlock], y[kBlock], z[kBlock], e[kBlock];
+   for (std::size_t b = 0; b < n; b += kBlock) {
+      const std::size_t nb = std::min(kBlock, n - b);
+      PtEtaPhiMToPxPyPzEKernel(pt + b, eta + b, phi + b, m + b, nb, x, y, z, e);
+      for (std::size_t k = 0; k < nb; ++k) {
+         const T bp = bx * x[k] + by * y[k] + bz * z[k];
+         const T f = gamma2 * bp + gamma * e[k];
+         x[k] += f * bx;
+         y[k] += f * by;
+         z[k] += f * bz;
+      }
+      for (std::size_t k = 0; k < nb; ++k) {
+         const T rho = std::sqrt(x[k] * x[k] + y[k] * y[k]);
+         ptOut[b + k] = rho;
+         phiOut[b + k] = (x[k] == 0 && y[k] == 0) ? T(0) : std::atan2(y[k], x[k]);
+         // same convention as ROOT::Math for vectors along the z axis
+         constexpr T kEtaMax = 22756;
+         const T etaAxis = z[k] == 0 ? T(0) : (z[k] > 0 ? z[k] + kEtaMax : z[k] - kEtaMax);
+         etaOut[b + k] = rho > 0 ? std::asinh(z[k] / rho) : etaAxis;
+      }
+   }
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace VecOps {
+
+R__RVEC_KERNEL float SumImpl(const float *v, std::size_t n, const float &zero)
+{
+   return SumKernel(v, n, zero);
+}
+
+R__RVEC_KERNEL double SumImpl(const double *v, std::size_t n, const double &zero)
+{
+   return SumKernel(v, n, zero);
+}
+
+R__RVEC_KERNEL float MaxImpl(const float *v, std::size_t n)
+{
+   return ExtremumKernel(v, n, Greater{});
+}
+
+R__RVEC_KERNEL double MaxImpl(const double *v, std::size_t n)
+{
+   return ExtremumKernel(v, n, Greater{});
+}
+
+R__RVEC_KERNEL float MinImpl(const float *v, std::size_t n)
+{
+   return ExtremumKernel(v, n, Less{});
+}
+
+R__RVEC_KERNEL double MinImpl(const double *v, std::size_t n)
+{
+   return ExtremumKernel(v, n, Less{});
+}
+
+R__RVEC_KERNEL std::size_t ArgMaxImpl(const float *v, std::size_t n)
+{
+   return ArgExtremumKernel(v, n, Greater{});
+}
+
+R__RVEC_KERNEL std::size_t ArgMaxImpl(const double *v, std::size_t n)
+{
+   return ArgExtremumKernel(v, n, Greater{});
+}
+
+R__RVEC_KERNEL std::size_t ArgMinImpl(const float *v, std::size_t n)
+{
+   return ArgExtremumKernel(v, n, Less{});
+}
+
+R__RVEC_KERNEL std::size_t ArgMinImpl(const double *v, std::size_t n)
+{
+   return ArgExtremumKernel(v, n, Less{});
+}
+
+R__RVEC_KERNEL void TakeImpl(const float *v, const std::size_t *idx, std::size_t n, float *out)
+{
+   TakeKernel(v, idx, n, out);
+}
+
+R__RVEC_KERNEL void TakeImpl(const double *v, const std::size_t *idx, std::size_t n, double *out)
+{
+   TakeKernel(v, idx, n, out);
+}
+
+R__RVEC_KERNEL static bool DeltaRLoop(const float *eta1, const float *eta2, const float *phi1, const float *phi2,
+                                      float c, std::size_t n, float *out, bool squared)
+{
+   return DeltaRKernel(eta1, eta2, phi1, phi2, c, n, out, squared);
+}
+
+R__RVEC_KERNEL static bool DeltaRLoop(const double *eta1, const double *eta2, const double *phi1, const double *phi2,
+                                      double c, std::size_t n, double *out, bool squared)
+{
+   return DeltaRKernel(eta1, eta2, phi1, phi2, c, n, out, squared);
+}
+
+template <typename T>
+static RVec<T> DeltaRVectorised(const RVec<T> &eta1, const RVec<T> &eta2, const RVec<T> &phi1, const RVec<T> &phi2,
+                                const T c, bool squared)
+{
+   const auto size = eta1.size();
+   if (eta2.size() != size || phi1.size() != size || phi2.size() != size)
+      throw std::runtime_error("Cannot compute DeltaR of vectors of different sizes.");
+   RVec<T> r(size);
+   if (!DeltaRLoop(eta1.data(), eta2.data(), phi1.data(), phi2.data(), c, size, r.data(), squared)) {
+      // rare angle differences larger than a full turn need the exact computation
+      for (std::size_t i = 0; i < size; ++i) {
+         const auto dphi = ROOT::VecOps::DeltaPhi(phi1[i], phi2[i], c);
+         const T dr2 = (eta1[i] - eta2[i]) * (eta1[i] - eta2[i]) + dphi * dphi;
+         r[i] = squared ? dr2 : std::sqrt(dr2);
+      }
+   }
+   return r;
+}
+
+RVec<float> DeltaRImpl(const RVec<float> &eta1, const RVec<float> &eta2, const RVec<float> &phi1,
+                       const RVec<float> &phi2, const float c, bool squared)
+{
+   return DeltaRVectorised(eta1, eta2, phi1, phi2, c, squared);
+}
+
+RVec<double> DeltaRImpl(const RVec<double> &eta1, const RVec<double> &eta2, const RVec<double> &phi1,
+                        const RVec<double> &phi2, const double c, bool squared)
+{
+   return DeltaRVectorised(eta1, eta2, phi1, phi2, c, squared);
+}
+
+R__RVEC_KERNEL static void InvariantMassesLoop(const float *pt1, const float *eta1, const float *phi1,
+                                               const float *mass1, const float *pt2, const float *eta2,
+                                               const float *phi2, const float *mass2, std::size_t n, float *out)
+{
+   InvariantMassesKernel(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2, n, out);
+}
+
+R__RVEC_KERNEL static void InvariantMassesLoop(const double *pt1, const double *eta1, const double *phi1,
+                                               const double *mass1, const double *pt2, const double *eta2,
+                                               const double *phi2, const double *mass2, std::size_t n, double *out)
+{
+   InvariantMassesKernel(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2, n, out);
+}
+
+RVec<float> InvariantMassesImpl(const RVec<float> &pt1, const RVec<float> &eta1, const RVec<float> &phi1,
+                                const RVec<float> &mass1, const RVec<float> &pt2, const RVec<float> &eta2,
+                                const RVec<float> &phi2, const RVec<float> &mass2)
+{
+   RVec<float> r(pt1.size());
+   InvariantMassesLoop(pt1.data(), eta1.data(), phi1.data(), mass1.data(), pt2.data(), eta2.data(), phi2.data(),
+                       mass2.data(), pt1.size(), r.data());
+   return r;
+}
+
+RVec<double> InvariantMassesImpl(const RVec<double> &pt1, const RVec<double> &eta1, const RVec<double> &phi1,
+                                 const RVec<double> &mass1, const RVec<double> &pt2, const RVec<double> &eta2,
+                                 const RVec<double> &phi2, const RVec<double> &mass2)
+{
+   RVec<double> r(pt1.size());
+   InvariantMassesLoop(pt1.data(), eta1.data(), phi1.data(), mass1.data(), pt2.data(), eta2.data(), phi2.data(),
+                       mass2.data(), pt1.size(), r.data());
+   return r;
+}
+
+R__RVEC_KERNEL void PtEtaPhiMToPxPyPzEImpl(const float *pt, const float *eta, const float *phi, const float *m,
+                                           std::size_t n, float *px, float *py, float *pz, float *e)
+{
+   PtEtaPhiMToPxPyPzEKernel(pt, eta, phi, m, n, px, py, pz, e);
+}
+
+R__RVEC_KERNEL void PtEtaPhiMToPxPyPzEImpl(const double *pt, const double *eta, const double *phi, const double *m,
+                                           std::size_t n, double *px, double *py, double *pz, double *e)
+{
+   PtEtaPhiMToPxPyPzEKernel(pt, eta, phi, m, n, px, py, pz, e);
+}
+
+R__RVEC_KERNEL void CombinationMassesImpl(const float *pt, const float *eta, const float *phi, const float *m,
+                                          std::size_t n, float *out)
+{
+   CombinationMassesKernel(pt, eta, phi, m, n, out);
+}
+
+R__RVEC_KERNEL void CombinationMassesImpl(const double *pt, const double *eta, const double *phi, const double *m,
+                                          std::size_t n, double *out)
+{
+   CombinationMassesKernel(pt, eta, phi, m, n, out);
+}
+
+R__RVEC_KERNEL static bool DeltaRMatrixLoop(const float *eta1, const float *phi1, std::size_t n1, const float *eta2,
+                                            const float *phi2, std::size_t n2, float c, float *out)
+{
+   return DeltaRMatrixKernel(eta1, phi1, n1, eta2, phi2, n2, c, out);
+}
+
+R__RVEC_KERNEL static bool DeltaRMatrixLoop(const double *eta1, const double *phi1, std::size_t n1,
+                                            const double *eta2, const double *phi2, std::size_t n2, double c,
+                                            double *out)
+{
+   return DeltaRMatrixKernel(eta1, phi1, n1, eta2, phi2, n2, c, out);
+}
+
+template <typename T>
+static void DeltaRMatrixVectorised(const T *eta1, const T *phi1, std::size_t n1, const T *eta2, const T *phi2,
+                                   std::size_t n2, T c, T *out)
+{
+   if (!DeltaRMatrixLoop(eta1, phi1, n1, eta2, phi2, n2, c, out)) {
+      // rare angle differences larger than a full turn need the exact computation
+      for (std::size_t i = 0; i < n1; ++i) {
+         for (std::size_t j = 0; j < n2; ++j) {
+            const auto dphi = ROOT::VecOps::DeltaPhi(phi1[i], phi2[j], c);
+            out[i * n2 + j] = std::sqrt((eta1[i] - eta2[j]) * (eta1[i] - eta2[j]) + dphi * dphi);
+         }
+      }
+   }
+}
+
+void DeltaRMatrixImpl(const float *eta1, const float *phi1, std::size_t n1, const float *eta2, const float *phi2,
+                      std::size_t n2, float c, float *out)
+{
+   DeltaRMatrixVectorised(eta1, phi1, n1, eta2, phi2, n2, c, out);
+}
+
+void DeltaRMatrixImpl(const double *eta1, const double *phi1, std::size_t n1, const double *eta2, const double *phi2,
+                      std::size_t n2, double c, double *out)
+{
+   DeltaRMatrixVectorised(eta1, phi1, n1, eta2, phi2, n2, c, out);
+}
+
+R__RVEC_KERNEL void BoostImpl(const float *pt, const float *eta, const float *phi, const float *m, std::size_t n,
+                              float bx, float by, float bz, float *ptOut, float *etaOut, float *phiOut)
+{
+   BoostKernel(pt, eta, phi, m, n, bx, by, bz, ptOut, etaOut, phiOut);
+}
+
+R__RVEC_KERNEL void BoostImpl(const double *pt, const double *eta, const double *phi, const double *m, std::size_t n,
+                              double bx, double by, double bz, double *ptOut, double *etaOut, double *phiOut)
+{
+   BoostKernel(pt, eta, phi, m, n, bx, by, bz, ptOut, etaOut, phiOut);
+}
+
+} // namespace VecOps
+} // namespace Internal
+} // namespace ROOT
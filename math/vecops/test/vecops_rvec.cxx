@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
+#include <Math/Boost.h>
 #include <Math/LorentzVector.h>
 #include <Math/PtEtaPhiM4D.h>
 #include <Math/Vector4Dfwd.h>
+#include <ROOT/RPtEtaPhiMVectors.hxx>
 #include <ROOT/RVec.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TFile.h>
@@ -519,6 +521,36 @@ void CheckEq(const T0 &v, const T0 &ref)
    }
 }
 
+TEST(VecOps, LazyExpressions)
+{
+   RVec<float> px{3.f, 30.f, 6.f, 0.f};
+   RVec<float> py{4.f, 40.f, 8.f, 1.f};
+   RVec<float> eta{1.f, -3.f, -.5f, 2.f};
+
+   RVec<float> pt = sqrt(Lazy(px) * px + Lazy(py) * py);
+   CheckEqual(pt, sqrt(px * px + py * py), "Lazy pt");
+
+   RVec<int> good = sqrt(Lazy(px) * px + Lazy(py) * py) > 9.f && abs(Lazy(eta)) < 2.4f;
+   RVec<int> goodRef = sqrt(px * px + py * py) > 9.f && abs(eta) < 2.4f;
+   CheckEq(good, goodRef);
+   EXPECT_EQ(Sum(Lazy(px) > 1.f), 3);
+   EXPECT_TRUE(Any(Lazy(eta) < -2.f));
+   EXPECT_FALSE(All(Lazy(eta) < 2.f));
+   CheckEqual(RVec<float>(2.f * -Lazy(px) + 1.f), 2.f * -px + 1.f, "Lazy scalars");
+   CheckEqual(RVec<double>(pow(Lazy(px), 2) + hypot(px, Lazy(py))), pow(px, 2) + hypot(px, py), "Lazy binary funcs");
+
+   // the result is evaluated in the memory of the target RVec
+   const auto *data = pt.data();
+   pt = Lazy(px) * 2.f;
+   EXPECT_EQ(data, pt.data());
+   CheckEqual(pt, px * 2.f, "Lazy assignment");
+   pt = Lazy(pt) + px;
+   CheckEqual(pt, px * 3.f, "Lazy aliasing");
+
+   RVec<float> shorter{1.f};
+   EXPECT_THROW(RVec<float>(Lazy(px) + shorter), std::runtime_error);
+}
+
 TEST(VecOps, InputOutput)
 {
    auto filename = "vecops_inputoutput.root";
@@ -1377,6 +1409,150 @@ TEST(VecOps, DeltaR)
    }
 }
 
+// The float and double versions of these helpers are vectorised kernels: check them against scalar references for
+// sizes that are not multiples of the SIMD width, with the extrema in the vectorised part and in the tail.
+template <typename T>
+void CheckVectorisedKernels()
+{
+   for (std::size_t n : {1u, 7u, 16u, 33u, 100u}) {
+      RVec<T> v(n), w(n), eta1(n), eta2(n), phi1(n), phi2(n);
+      RVec<std::size_t> idx(n);
+      for (std::size_t i = 0; i < n; ++i) {
+         v[i] = T(((i * 37) % 23) - 11.5);
+         w[i] = T(0.25 * i);
+         eta1[i] = T(std::sin(0.3 * i));
+         eta2[i] = T(std::cos(0.7 * i));
+         phi1[i] = T(3 * std::sin(1.1 * i));
+         phi2[i] = T(i % 9 == 0 ? 20. : 3 * std::cos(0.9 * i)); // some differences larger than 2 pi
+         idx[i] = (i * 5) % n;
+      }
+      v[n / 2] = T(50);
+      v[n - 1] = T(-50);
+      v[n / 3] = T(50); // ties: the first extremum must be returned
+
+      T sum = 0;
+      for (auto x : w)
+         sum += x;
+      EXPECT_NEAR(Sum(w), sum, 1e-4 * sum + 1e-6);
+      EXPECT_EQ(Max(v), *std::max_element(v.begin(), v.end()));
+      EXPECT_EQ(Min(v), *std::min_element(v.begin(), v.end()));
+      EXPECT_EQ(ArgMax(v), std::size_t(std::distance(v.begin(), std::max_element(v.begin(), v.end()))));
+      EXPECT_EQ(ArgMin(v), std::size_t(std::distance(v.begin(), std::min_element(v.begin(), v.end()))));
+
+      const auto taken = Take(w, idx);
+      const auto dr = DeltaR(eta1, eta2, phi1, phi2);
+      const auto dr2 = DeltaR2(eta1, eta2, phi1, phi2);
+      const auto masses = InvariantMasses(w + 1, eta1, phi1, w, w + 2, eta2, phi2, w);
+      for (std::size_t i = 0; i < n; ++i) {
+         EXPECT_EQ(taken[i], w[idx[i]]);
+         EXPECT_NEAR(dr[i], DeltaR(eta1[i], eta2[i], phi1[i], phi2[i]), 1e-5);
+         EXPECT_NEAR(dr2[i], dr[i] * dr[i], 1e-4);
+         auto p1 = ROOT::Math::PtEtaPhiMVector(w[i] + 1, eta1[i], phi1[i], w[i]);
+         auto p2 = ROOT::Math::PtEtaPhiMVector(w[i] + 2, eta2[i], phi2[i], w[i]);
+         EXPECT_NEAR(masses[i], (p1 + p2).mass(), 1e-4 * (p1 + p2).mass());
+      }
+   }
+}
+
+TEST(VecOps, VectorisedKernels)
+{
+   CheckVectorisedKernels<float>();
+   CheckVectorisedKernels<double>();
+}
+
+template <typename T>
+void CheckPtEtaPhiMVectors()
+{
+   using ROOT::Math::PtEtaPhiMVector;
+   const std::size_t n = 21;
+   RVec<T> pt(n), eta(n), phi(n), m(n);
+   for (std::size_t i = 0; i < n; ++i) {
+      pt[i] = T(5 + 3 * i);
+      eta[i] = T(2 * std::sin(0.4 * i));
+      phi[i] = T(3 * std::cos(1.3 * i));
+      m[i] = T(0.1 * (i % 4));
+   }
+   ROOT::VecOps::RPtEtaPhiMVectors<T> vecs(pt, eta, phi, m);
+   EXPECT_EQ(vecs.Pt().data(), pt.data()); // no copy
+   const auto lvs = vecs.template ToLorentzVectors<PtEtaPhiMVector>();
+
+   RVec<T> px, py, pz, e;
+   vecs.ToPxPyPzE(px, py, pz, e);
+   for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_NEAR(px[i], lvs[i].Px(), 1e-4 * lvs[i].E());
+      EXPECT_NEAR(pz[i], lvs[i].Pz(), 1e-4 * lvs[i].E());
+      EXPECT_NEAR(e[i], lvs[i].E(), 1e-4 * lvs[i].E());
+   }
+
+   const auto masses = vecs.CombinationMasses();
+   const auto comb = Combinations(pt, 2);
+   ASSERT_EQ(masses.size(), comb[0].size());
+   for (std::size_t k = 0; k < masses.size(); ++k) {
+      const auto mass = (lvs[comb[0][k]] + lvs[comb[1][k]]).M();
+      EXPECT_NEAR(masses[k], mass, 1e-4 * mass);
+   }
+
+   const auto dr = vecs.DeltaRMatrix(vecs);
+   for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+         EXPECT_NEAR(dr[i * n + j], DeltaR(eta[i], eta[j], phi[i], phi[j]), 1e-5);
+
+   const auto boosted = vecs.Boost(T(0.1), T(-0.3), T(0.5));
+   const ROOT::Math::Boost boost(0.1, -0.3, 0.5);
+   for (std::size_t i = 0; i < n; ++i) {
+      const auto ref = boost(lvs[i]);
+      EXPECT_NEAR(boosted.Pt()[i], ref.Pt(), 1e-4 * ref.E());
+      EXPECT_NEAR(boosted.Eta()[i], ref.Eta(), 1e-4);
+      EXPECT_NEAR(boosted.Phi()[i], ref.Phi(), 1e-4);
+   }
+}
+
+TEST(VecOps, PtEtaPhiMVectors)
+{
+   CheckPtEtaPhiMVectors<float>();
+   CheckPtEtaPhiMVectors<double>();
+}
+
+TEST(VecOps, Arena)
+{
+   using ROOT::Internal::VecOps::RVecArena;
+   RVecArena arena(1024);
+   RVec<int> outside;
+   for (int iter = 0; iter < 3; ++iter) {
+      {
+         RVecArena::RScope scope(&arena);
+         RVec<int> v;
+         for (int i = 0; i < 100; ++i)
+            v.push_back(i);
+         RVec<int> w(v.begin(), v.end());
+         RVec<int> big(1000, 1); // larger than a chunk
+         EXPECT_EQ(Sum(v), 4950);
+         EXPECT_EQ(Sum(w), 4950);
+         EXPECT_EQ(Sum(big), 1000);
+         EXPECT_GE(v.capacity(), 100u);
+         // RVecs of non-trivially copyable types are not allocated from the arena
+         RVec<std::string> s(100, "a");
+         EXPECT_EQ(s[99], "a");
+         outside = std::move(v);
+      }
+      // growing outside of the scope moves the elements to the heap
+      outside.resize(500, 2);
+      EXPECT_EQ(outside[99], 99);
+      EXPECT_EQ(outside[499], 2);
+      arena.Reset();
+   }
+   EXPECT_EQ(RVecArena::GetCurrent(), nullptr);
+   // the memory of the first iteration is reused after each reset
+   const auto reserved = arena.GetReservedBytes();
+   EXPECT_LT(reserved, 16 * 1024u);
+   {
+      RVecArena::RScope scope(&arena);
+      RVec<int> v(1000, 1);
+      EXPECT_EQ(Sum(v), 1000);
+   }
+   EXPECT_EQ(arena.GetReservedBytes(), reserved);
+}
+
 TEST(VecOps, Map)
 {
    RVec<float> a({1.f, 2.f, 3.f});
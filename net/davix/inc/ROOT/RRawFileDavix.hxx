@@ -28,7 +28,8 @@ struct RDavixFileDes;
 
 The RRawFileDavix class provides read-only access to remote non-ROOT files.  It uses the Davix library for
 the transport layer.  It instructs the RRawFile base class to buffer in larger chunks than the default for
-local files, assuming that remote file access has high(er) latency.
+local files, assuming that remote file access has high(er) latency. Vector reads coalesce nearby requests and
+are spread over several concurrent HTTP requests, see RDavixVectorReader.
 
 */
 
@@ -46,6 +47,7 @@ public:
    RRawFileDavix(std::string_view url, RRawFile::ROptions options);
    ~RRawFileDavix();
    std::unique_ptr<RRawFile> Clone() const final;
+   std::int64_t GetModificationTime() final;
 };
 
 } // namespace Internal
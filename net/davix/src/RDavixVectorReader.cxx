@@ -0,0 +1,189 @@
+// @(#)root/net:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "RDavixVectorReader.hxx"
+
+#include <TEnv.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <numeric>
+
+ROOT::Internal::RDavixVectorReader::RDavixVectorReader(Davix::DavPosix &posix, OpenFunc_t openFunc,
+                                                       unsigned int nStreams)
+   : fPosix(posix), fOpenFunc(std::move(openFunc)), fNStreams(std::max(nStreams, 1u)), fStreamFds(fNStreams, nullptr)
+{
+}
+
+ROOT::Internal::RDavixVectorReader::~RDavixVectorReader()
+{
+   for (auto fd : fStreamFds) {
+      if (fd)
+         fPosix.close(fd, nullptr);
+   }
+}
+
+unsigned int ROOT::Internal::RDavixVectorReader::GetDefaultNStreams()
+{
+   return std::max(gEnv ? gEnv->GetValue("Davix.ReadV.Streams", 4) : 4, 1);
+}
+
+std::vector<ROOT::Internal::RDavixVectorReader::RRange>
+ROOT::Internal::RDavixVectorReader::Coalesce(const Davix::DavIOVecInput *in, std::size_t n, std::size_t maxGap,
+                                             std::size_t maxRangeSize)
+{
+   std::vector<std::size_t> order(n);
+   std::iota(order.begin(), order.end(), 0);
+   std::stable_sort(order.begin(), order.end(),
+                    [in](std::size_t a, std::size_t b) { return in[a].diov_offset < in[b].diov_offset; });
+
+   std::vector<RRange> ranges;
+   for (auto idx : order) {
+      const std::uint64_t offset = in[idx].diov_offset;
+      const std::uint64_t end = offset + in[idx].diov_size;
+      if (!ranges.empty()) {
+         auto &last = ranges.back();
+         const std::uint64_t lastEnd = last.fOffset + last.fSize;
+         const std::uint64_t newEnd = std::max(lastEnd, end);
+         if (offset <= lastEnd + maxGap && newEnd - last.fOffset <= maxRangeSize) {
+            last.fSize = newEnd - last.fOffset;
+            last.fRequests.push_back(idx);
+            continue;
+         }
+      }
+      ranges.push_back(RRange{offset, static_cast<std::size_t>(in[idx].diov_size), {idx}});
+   }
+   return ranges;
+}
+
+void ROOT::Internal::RDavixVectorReader::RecordRead(std::size_t nbytes, double seconds)
+{
+   // Reads of less than this size are dominated by the round trip and do not tell about the bandwidth
+   constexpr std::size_t kMinBandwidthSample = 256 * 1024;
+
+   std::lock_guard<std::mutex> guard(fStatsLock);
+   fRtt = (fRtt < 0) ? seconds : std::min(fRtt, seconds);
+   if (nbytes >= kMinBandwidthSample && seconds > fRtt) {
+      const double bandwidth = nbytes / (seconds - fRtt);
+      fBandwidth = (fBandwidth < 0) ? bandwidth : 0.75 * fBandwidth + 0.25 * bandwidth;
+   }
+}
+
+std::size_t ROOT::Internal::RDavixVectorReader::GetCoalescingGap()
+{
+   std::lock_guard<std::mutex> guard(fStatsLock);
+   if (fRtt < 0 || fBandwidth < 0)
+      return kDefaultGap;
+   const double gap = fBandwidth * fRtt;
+   return static_cast<std::size_t>(std::clamp(gap, double(kMinGap), double(kMaxGap)));
+}
+
+dav_ssize_t ROOT::Internal::RDavixVectorReader::ReadV(Davix_fd *fd, const Davix::DavIOVecInput *in,
+                                                      Davix::DavIOVecOuput *out, std::size_t n,
+                                                      Davix::DavixError **err)
+{
+   std::lock_guard<std::mutex> guard(fReadLock);
+   if (n == 0)
+      return 0;
+
+   const auto ranges = Coalesce(in, n, GetCoalescingGap(), kMaxRangeSize);
+
+   // The ranges covering a single request are read into the request buffer, the others into a scratch buffer
+   std::vector<Davix::DavIOVecInput> rangeIn(ranges.size());
+   std::vector<Davix::DavIOVecOuput> rangeOut(ranges.size());
+   std::vector<std::unique_ptr<char[]>> scratch(ranges.size());
+   std::size_t totalSize = 0;
+   for (std::size_t i = 0; i < ranges.size(); ++i) {
+      const auto &range = ranges[i];
+      if (range.fRequests.size() == 1) {
+         rangeIn[i].diov_buffer = in[range.fRequests[0]].diov_buffer;
+      } else {
+         scratch[i] = std::make_unique<char[]>(range.fSize);
+         rangeIn[i].diov_buffer = scratch[i].get();
+      }
+      rangeIn[i].diov_offset = range.fOffset;
+      rangeIn[i].diov_size = range.fSize;
+      totalSize += range.fSize;
+   }
+
+   // Split the ranges, in the order of the offsets, into groups of about the same size, one per stream
+   std::size_t nGroups = std::min<std::size_t>({fNStreams, ranges.size(), std::max<std::size_t>(1, totalSize / kMinStreamSize)});
+   std::vector<Davix_fd *> groupFds{fd};
+   for (std::size_t g = 1; g < nGroups; ++g) {
+      if (!fStreamFds[g]) {
+         Davix::DavixError *openErr = nullptr;
+         fStreamFds[g] = fOpenFunc(&openErr);
+         Davix::DavixError::clearError(&openErr);
+      }
+      if (!fStreamFds[g])
+         break;
+      groupFds.push_back(fStreamFds[g]);
+   }
+   nGroups = groupFds.size();
+   std::vector<std::size_t> groupBegin{0};
+   std::size_t groupSize = 0;
+   for (std::size_t i = 0; i < ranges.size() && groupBegin.size() < nGroups; ++i) {
+      groupSize += ranges[i].fSize;
+      if (groupSize >= totalSize / nGroups * groupBegin.size() && i + 1 < ranges.size())
+         groupBegin.push_back(i + 1);
+   }
+   nGroups = groupBegin.size();
+   groupBegin.push_back(ranges.size());
+
+   auto readGroup = [&](std::size_t g, Davix::DavixError **groupErr) {
+      const std::size_t first = groupBegin[g];
+      const std::size_t count = groupBegin[g + 1] - first;
+      std::size_t nbytes = 0;
+      for (std::size_t i = first; i < first + count; ++i)
+         nbytes += ranges[i].fSize;
+      const auto start = std::chrono::steady_clock::now();
+      auto ret = fPosix.preadVec(groupFds[g], &rangeIn[first], &rangeOut[first], count, groupErr);
+      if (ret >= 0)
+         RecordRead(nbytes, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      return ret;
+   };
+
+   std::vector<Davix::DavixError *> groupErrs(nGroups, nullptr);
+   std::vector<std::future<dav_ssize_t>> futures;
+   for (std::size_t g = 1; g < nGroups; ++g)
+      futures.emplace_back(std::async(std::launch::async, readGroup, g, &groupErrs[g]));
+   bool failed = readGroup(0, &groupErrs[0]) < 0;
+   for (auto &f : futures)
+      failed = (f.get() < 0) || failed;
+
+   if (failed) {
+      for (auto &groupErr : groupErrs) {
+         if (groupErr && err && !*err)
+            std::swap(*err, groupErr);
+         Davix::DavixError::clearError(&groupErr);
+      }
+      return -1;
+   }
+
+   // Scatter the ranges into the requests; a range may be short at the end of the file
+   dav_ssize_t total = 0;
+   for (std::size_t i = 0; i < ranges.size(); ++i) {
+      const auto &range = ranges[i];
+      const std::uint64_t nread = rangeOut[i].diov_size;
+      for (auto idx : range.fRequests) {
+         const std::uint64_t begin = in[idx].diov_offset - range.fOffset;
+         const std::uint64_t nbytes = (nread > begin) ? std::min<std::uint64_t>(nread - begin, in[idx].diov_size) : 0;
+         if (scratch[i])
+            std::memcpy(in[idx].diov_buffer, scratch[i].get() + begin, nbytes);
+         out[idx].diov_buffer = in[idx].diov_buffer;
+         out[idx].diov_size = nbytes;
+         total += nbytes;
+      }
+   }
+   return total;
+}
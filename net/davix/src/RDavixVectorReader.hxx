@@ -0,0 +1,103 @@
+// @(#)root/net:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDavixVectorReader
+#define ROOT_RDavixVectorReader
+
+#include <davix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+\class ROOT::Internal::RDavixVectorReader
+Vector reads over HTTP for TDavixFile and RRawFileDavix.
+
+Many servers answer a multi-range GET with the ranges one after the other, or fall back to single-range
+requests, so that a vector read costs one round trip per range. The reader reduces the number of ranges and
+overlaps the round trips of the remaining ones:
+ - requests closer to each other than the coalescing gap are merged into one range, and the gap is read
+   and dropped. The gap is the number of bytes that can be transferred during one round trip, estimated
+   from the previous reads: the smallest duration of a read approximates the round-trip time and the
+   duration of the large reads beyond it gives the bandwidth.
+ - the ranges are distributed over up to `nStreams` descriptors of the same file, each of which issues its
+   own multi-range request concurrently. Davix keeps the connections of a context alive, so the additional
+   descriptors reuse the pooled connections after the first vector read.
+
+The reader is not thread-safe: concurrent calls of ReadV() are serialized.
+*/
+class RDavixVectorReader {
+public:
+   /// Opens another descriptor of the file; returns nullptr and sets the error on failure
+   using OpenFunc_t = std::function<Davix_fd *(Davix::DavixError **)>;
+
+   /// A range of the file covering one or more of the requests of a vector read
+   struct RRange {
+      std::uint64_t fOffset = 0;
+      std::size_t fSize = 0;
+      std::vector<std::size_t> fRequests; ///< Indexes of the covered requests
+   };
+
+   static constexpr std::size_t kDefaultGap = 64 * 1024;
+   static constexpr std::size_t kMinGap = 4 * 1024;
+   static constexpr std::size_t kMaxGap = 4 * 1024 * 1024;
+   /// Coalesced ranges are not grown beyond this size
+   static constexpr std::size_t kMaxRangeSize = 16 * 1024 * 1024;
+   /// A stream is only used if it gets at least that many bytes to read
+   static constexpr std::size_t kMinStreamSize = 1024 * 1024;
+
+private:
+   Davix::DavPosix &fPosix;
+   OpenFunc_t fOpenFunc;
+   unsigned int fNStreams;
+   /// The additional descriptors, opened on demand
+   std::vector<Davix_fd *> fStreamFds;
+   std::mutex fReadLock;
+
+   std::mutex fStatsLock;
+   double fRtt = -1;       ///< Smallest duration of a read in seconds, or -1 before the first read
+   double fBandwidth = -1; ///< Bytes per second, or -1 before the first large read
+
+   void RecordRead(std::size_t nbytes, double seconds);
+
+public:
+   RDavixVectorReader(Davix::DavPosix &posix, OpenFunc_t openFunc, unsigned int nStreams);
+   RDavixVectorReader(const RDavixVectorReader &) = delete;
+   RDavixVectorReader &operator=(const RDavixVectorReader &) = delete;
+   ~RDavixVectorReader();
+
+   /// The number of streams set by Davix.ReadV.Streams in the ROOT environment, 4 by default
+   static unsigned int GetDefaultNStreams();
+
+   /// Merge the requests whose distance is at most `maxGap` bytes into ranges of at most `maxRangeSize` bytes
+   /// (unless a single request is larger). The ranges are sorted by offset.
+   static std::vector<RRange>
+   Coalesce(const Davix::DavIOVecInput *in, std::size_t n, std::size_t maxGap, std::size_t maxRangeSize);
+
+   /// The coalescing gap for the next vector read
+   std::size_t GetCoalescingGap();
+
+   /// Read the `n` requests `in` through `fd` and the additional descriptors; same semantics as
+   /// Davix::DavPosix::preadVec()
+   dav_ssize_t
+   ReadV(Davix_fd *fd, const Davix::DavIOVecInput *in, Davix::DavIOVecOuput *out, std::size_t n,
+         Davix::DavixError **err);
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -10,6 +10,7 @@
  *************************************************************************/
 
 #include "ROOT/RRawFileDavix.hxx"
+#include "RDavixVectorReader.hxx"
 
 #include <TError.h>
 
@@ -36,6 +37,8 @@ struct RDavixFileDes {
    DAVIX_FD *fd;
    Davix::Context ctx;
    Davix::DavPosix pos;
+   /// Created on the first vector read; must be destructed before pos
+   std::unique_ptr<RDavixVectorReader> vectorReader;
 };
 
 } // namespace Internal
@@ -49,6 +52,7 @@ ROOT::Internal::RRawFileDavix::RRawFileDavix(std::string_view url, ROptions opti
 
 ROOT::Internal::RRawFileDavix::~RRawFileDavix()
 {
+   fFileDes->vectorReader.reset();
    if (fFileDes->fd != nullptr)
       fFileDes->pos.close(fFileDes->fd, nullptr);
 }
@@ -68,6 +72,17 @@ std::uint64_t ROOT::Internal::RRawFileDavix::GetSizeImpl()
    return buf.st_size;
 }
 
+std::int64_t ROOT::Internal::RRawFileDavix::GetModificationTime()
+{
+   struct stat buf;
+   Davix::DavixError *err = nullptr;
+   if (fFileDes->pos.stat(nullptr, fUrl, &buf, &err) == -1) {
+      Davix::DavixError::clearError(&err);
+      return -1;
+   }
+   return buf.st_mtime;
+}
+
 void ROOT::Internal::RRawFileDavix::OpenImpl()
 {
    Davix::DavixError *err = nullptr;
@@ -102,7 +117,12 @@ void ROOT::Internal::RRawFileDavix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
       R__ASSERT(ioVec[i].fSize > 0);
    }
 
-   auto ret = fFileDes->pos.preadVec(fFileDes->fd, in.data(), out.data(), nReq, &davixErr);
+   if (!fFileDes->vectorReader) {
+      auto openFunc = [this](Davix::DavixError **err) { return fFileDes->pos.open(nullptr, fUrl, O_RDONLY, err); };
+      fFileDes->vectorReader = std::make_unique<RDavixVectorReader>(fFileDes->pos, openFunc,
+                                                                    RDavixVectorReader::GetDefaultNStreams());
+   }
+   auto ret = fFileDes->vectorReader->ReadV(fFileDes->fd, in.data(), out.data(), nReq, &davixErr);
    if (ret < 0) {
       throw std::runtime_error("Cannot do vector read from '" + fUrl + "', error: " + davixErr->getErrMsg());
    }
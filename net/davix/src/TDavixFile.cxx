@@ -40,6 +40,7 @@
 #include "TBase64.h"
 #include "TVirtualPerfStats.h"
 #include "TDavixFileInternal.h"
+#include "RDavixVectorReader.hxx"
 #include "snprintf.h"
 
 #include <cerrno>
@@ -343,6 +344,7 @@ static int TDavixFile_http_authn_cert_X509(void *userdata, const Davix::SessionI
 
 TDavixFileInternal::~TDavixFileInternal()
 {
+   delete vectorReader;
    delete davixPosix;
    delete davixParam;
 }
@@ -401,9 +403,23 @@ Davix_fd *TDavixFileInternal::Open()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+ROOT::Internal::RDavixVectorReader *TDavixFileInternal::getVectorReader()
+{
+   if (!vectorReader) {
+      auto openFunc = [this](DavixError **err) { return davixPosix->open(davixParam, fUrl.GetUrl(), oflags, err); };
+      vectorReader = new ROOT::Internal::RDavixVectorReader(*davixPosix, openFunc,
+                                                            ROOT::Internal::RDavixVectorReader::GetDefaultNStreams());
+   }
+   return vectorReader;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void TDavixFileInternal::Close()
 {
    DavixError *davixErr = NULL;
+   delete vectorReader;
+   vectorReader = nullptr;
    if (davixFd != NULL && davixPosix->close(davixFd, &davixErr)) {
       Error("DavixClose", "can not to close file with davix: %s (%d)",
             davixErr->getErrMsg().c_str(), davixErr->getStatus());
@@ -983,7 +999,7 @@ Long64_t TDavixFile::DavixReadBuffers(Davix_fd *fd, char *buf, Long64_t *pos, In
       lastPos += len[i];
    }
 
-   Long64_t ret = d_ptr->davixPosix->preadVec(fd, in.get(), out.get(), nbuf, &davixErr);
+   Long64_t ret = d_ptr->getVectorReader()->ReadV(fd, in.get(), out.get(), nbuf, &davixErr);
    if (ret < 0) {
       Error("DavixReadBuffers", "can not read data with davix: %s (%d)",
             davixErr->getErrMsg().c_str(), davixErr->getStatus());
@@ -49,6 +49,12 @@ namespace Davix {
 }
 struct Davix_fd;
 
+namespace ROOT {
+namespace Internal {
+   class RDavixVectorReader;
+}
+}
+
 
 class TDavixFileInternal {
    friend class TDavixFile;
@@ -62,6 +68,7 @@ private:
       davixParam(nullptr),
       davixPosix(nullptr),
       davixFd(nullptr),
+      vectorReader(nullptr),
       fUrl(mUrl),
       opt(mopt),
       oflags(0),
@@ -74,6 +81,7 @@ private:
       davixParam(nullptr),
       davixPosix(nullptr),
       davixFd(nullptr),
+      vectorReader(nullptr),
       fUrl(url),
       opt(mopt),
       oflags(0),
@@ -95,6 +103,8 @@ private:
 
    Davix_fd * Open();
 
+   ROOT::Internal::RDavixVectorReader *getVectorReader();
+
    void Close();
 
    void enableGridMode();
@@ -133,6 +143,7 @@ private:
    Davix::RequestParams *davixParam;
    Davix::DavPosix *davixPosix;
    Davix_fd *davixFd;
+   ROOT::Internal::RDavixVectorReader *vectorReader;
    TUrl fUrl;
    Option_t* opt;
    int oflags;
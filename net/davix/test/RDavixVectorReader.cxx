@@ -0,0 +1,70 @@
+#include "../src/RDavixVectorReader.hxx"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using RDavixVectorReader = ROOT::Internal::RDavixVectorReader;
+
+namespace {
+std::vector<Davix::DavIOVecInput> MakeRequests(const std::vector<std::pair<dav_off_t, dav_size_t>> &requests)
+{
+   std::vector<Davix::DavIOVecInput> in(requests.size());
+   for (std::size_t i = 0; i < requests.size(); ++i) {
+      in[i].diov_buffer = nullptr;
+      in[i].diov_offset = requests[i].first;
+      in[i].diov_size = requests[i].second;
+   }
+   return in;
+}
+} // anonymous namespace
+
+TEST(RDavixVectorReader, Coalesce)
+{
+   // unsorted, with an overlap, a small gap and a large gap
+   auto in = MakeRequests({{1000, 100}, {0, 100}, {50, 100}, {180, 20}, {100000, 10}});
+   auto ranges = RDavixVectorReader::Coalesce(in.data(), in.size(), 1000, 1024 * 1024);
+   ASSERT_EQ(2u, ranges.size());
+   EXPECT_EQ(0u, ranges[0].fOffset);
+   EXPECT_EQ(1100u, ranges[0].fSize);
+   EXPECT_EQ((std::vector<std::size_t>{1, 2, 3, 0}), ranges[0].fRequests);
+   EXPECT_EQ(100000u, ranges[1].fOffset);
+   EXPECT_EQ(10u, ranges[1].fSize);
+   EXPECT_EQ((std::vector<std::size_t>{4}), ranges[1].fRequests);
+
+   // without gap, only touching and overlapping requests are merged
+   ranges = RDavixVectorReader::Coalesce(in.data(), in.size(), 0, 1024 * 1024);
+   EXPECT_EQ(4u, ranges.size());
+
+   // the size of the ranges is limited, but not the size of a single request
+   in = MakeRequests({{0, 600}, {600, 600}, {1200, 2000}});
+   ranges = RDavixVectorReader::Coalesce(in.data(), in.size(), 0, 1000);
+   ASSERT_EQ(3u, ranges.size());
+   EXPECT_EQ(2000u, ranges[2].fSize);
+}
+
+TEST(RDavixVectorReader, ReadV)
+{
+   Davix::Context ctx;
+   Davix::DavPosix posix(&ctx);
+   const std::string url = "http://root.cern/files/davix.test";
+   Davix::DavixError *err = nullptr;
+   auto fd = posix.open(nullptr, url, O_RDONLY, &err);
+   ASSERT_NE(nullptr, fd);
+   {
+      RDavixVectorReader reader(posix, [&](Davix::DavixError **e) { return posix.open(nullptr, url, O_RDONLY, e); }, 4);
+
+      // "Hello, World": all requests are coalesced into one range, the one beyond the end of the file is empty
+      char buffer[4] = {0, 0, 0, 0};
+      auto in = MakeRequests({{0, 1}, {7, 1}, {11, 1}, {1000, 1}});
+      for (int i = 0; i < 4; ++i)
+         in[i].diov_buffer = &buffer[i];
+      std::vector<Davix::DavIOVecOuput> out(in.size());
+      EXPECT_EQ(3, reader.ReadV(fd, in.data(), out.data(), in.size(), &err));
+      EXPECT_EQ('H', buffer[0]);
+      EXPECT_EQ('W', buffer[1]);
+      EXPECT_EQ('d', buffer[2]);
+      EXPECT_EQ(0, out[3].diov_size);
+   }
+   posix.close(fd, nullptr);
+}
@@ -27,6 +27,7 @@ class THttpWSHandler;
 class THttpCallArg : public TObject {
 
    friend class THttpServer;
+   friend class THttpResponseCache;
    friend class THttpWSEngine;
    friend class THttpWSHandler;
 
@@ -16,7 +16,10 @@
 #include "TList.h"
 #include "THttpCallArg.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <functional>
 #include <map>
 #include <string>
 #include <memory>
@@ -26,6 +29,8 @@
 
 class THttpEngine;
 class THttpTimer;
+class THttpMainTask;
+class THttpResponseCache;
 class TRootSniffer;
 
 class THttpServer : public TNamed {
@@ -60,6 +65,15 @@ protected:
    std::mutex fWSMutex;                                      ///<! mutex to protect WS handler lists
    std::vector<std::shared_ptr<THttpWSHandler>> fWSHandlers; ///<! list of WS handlers
 
+   std::queue<std::shared_ptr<THttpMainTask>> fMainTasks;    ///<! tasks of worker threads for main thread, protected by fMutex
+   std::vector<std::thread> fWorkers;                        ///<! worker threads for read-only requests
+   Int_t fNumWorkers{0};                                     ///<! number of worker threads
+   std::atomic<bool> fStopWorkers{false};                    ///<! stop flag for worker threads
+   std::mutex fWorkMutex;                                    ///<! mutex to protect list of worker requests
+   std::condition_variable fWorkCond;                        ///<! signals new requests for worker threads
+   std::queue<std::shared_ptr<THttpCallArg>> fWorkArgs;      ///<! requests for worker threads
+   std::unique_ptr<THttpResponseCache> fCache;               ///<! snapshots and responses for worker threads
+
    virtual void MissedRequest(THttpCallArg *arg);
 
    virtual void ProcessRequest(std::shared_ptr<THttpCallArg> arg);
@@ -68,6 +82,18 @@ protected:
 
    void StopServerThread();
 
+   void StopWorkerThreads();
+
+   Bool_t IsWorkerRequest(THttpCallArg &arg) const;
+
+   void ProcessWorkerRequest(std::shared_ptr<THttpCallArg> arg);
+
+   Bool_t RunInMainThread(std::function<void()> func);
+
+   Int_t ProcessMainTasks();
+
+   void AddResponseHeaders(THttpCallArg &arg);
+
    std::string BuildWSEntryPage();
 
    void ReplaceJSROOTLinks(std::shared_ptr<THttpCallArg> &arg, const std::string &version = "");
@@ -141,6 +167,11 @@ public:
 
    void CreateServerThread();
 
+   void SetWorkerThreads(Int_t nthreads, Long_t snapshotMs = 1000);
+
+   /** returns number of worker threads for read-only requests */
+   Int_t GetWorkerThreads() const { return fNumWorkers; }
+
    /** Check if file is requested, thread safe */
    Bool_t IsFileRequested(const char *uri, TString &res) const;
 
@@ -0,0 +1,227 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "THttpResponseCache.h"
+
+#include "THttpCallArg.h"
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TDirectory.h"
+#include "TFile.h"
+
+#include <algorithm>
+
+/** \class THttpResponseCache
+\ingroup http
+
+Snapshots of registered objects and responses of read-only requests, used by the worker threads of THttpServer
+
+A snapshot is the object streamed with TBufferFile in the main thread, where the object is modified.
+Worker threads read a private copy of the object back from the snapshot and produce the response
+without accessing the original object. A new snapshot of an item gets a new version only if the
+streamed object differs from the previous snapshot, therefore responses are cached per version and
+served again as long as the object does not change.
+
+Snapshots are considered up-to-date during the configured interval; responses which do not depend
+on a snapshot (like h.json) are cached during the same interval.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// destructor
+
+THttpResponseCache::Snapshot::~Snapshot() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns copy of the object, read back from the snapshot when called the first time
+///
+/// Can be used from any thread, returned object must not be modified
+
+TObject *THttpResponseCache::Snapshot::GetObject()
+{
+   std::call_once(fReadFlag, [this] {
+      auto obj = static_cast<TObject *>(fClass->New());
+      if (!obj)
+         return;
+
+      TDirectory::TContext ctxt(nullptr);
+      TFile *oldfile = gFile;
+      gFile = nullptr;
+
+      TBufferFile buf(TBuffer::kRead, fBuffer.length(), const_cast<char *>(fBuffer.data()), kFALSE);
+      buf.MapObject(obj);
+      obj->Streamer(buf);
+
+      gFile = oldfile;
+
+      fObject.reset(obj);
+   });
+
+   return fObject.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// constructor
+///
+/// @param intervalMs time during which snapshots are considered up-to-date
+/// @param maxSize maximal total size of cached responses
+
+THttpResponseCache::THttpResponseCache(Long_t intervalMs, std::size_t maxSize)
+   : fInterval(std::chrono::milliseconds(intervalMs)), fLastPurge(Clock_t::now()), fMaxResponsesSize(maxSize)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change time during which snapshots are considered up-to-date
+
+void THttpResponseCache::SetInterval(Long_t intervalMs)
+{
+   std::lock_guard<std::mutex> grd(fMutex);
+   fInterval = std::chrono::milliseconds(intervalMs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove snapshots which were not renewed for a long time
+
+void THttpResponseCache::PurgeSnapshots(Clock_t::time_point now)
+{
+   auto maxage = std::max<Clock_t::duration>(std::chrono::seconds(60), fInterval * 10);
+   if (now - fLastPurge < maxage)
+      return;
+   fLastPurge = now;
+
+   for (auto iter = fSnapshots.begin(); iter != fSnapshots.end();) {
+      if (now - iter->second->fTime > maxage)
+         iter = fSnapshots.erase(iter);
+      else
+         ++iter;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns snapshot of the item if it is still up-to-date
+///
+/// Can be used from any thread
+
+std::shared_ptr<THttpResponseCache::Snapshot> THttpResponseCache::FindSnapshot(const std::string &item)
+{
+   std::lock_guard<std::mutex> grd(fMutex);
+
+   auto iter = fSnapshots.find(item);
+   if ((iter == fSnapshots.end()) || (Clock_t::now() - iter->second->fTime >= fInterval))
+      return nullptr;
+
+   return iter->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Take snapshot of the object, which is found for specified item
+///
+/// Must be called from the thread where object is modified, normally the main thread.
+/// If streamed object is the same as in previous snapshot, previous snapshot is confirmed
+/// and returned. Returns nullptr if the object is not specified.
+
+std::shared_ptr<THttpResponseCache::Snapshot> THttpResponseCache::TakeSnapshot(const std::string &item, TObject *obj)
+{
+   if (!obj)
+      return nullptr;
+
+   TBufferFile buf(TBuffer::kWrite, 10000);
+   buf.MapObject(obj);
+   obj->Streamer(buf);
+
+   std::lock_guard<std::mutex> grd(fMutex);
+
+   auto now = Clock_t::now();
+
+   PurgeSnapshots(now);
+
+   auto &snap = fSnapshots[item];
+
+   if (snap && (snap->fClass == obj->IsA()) && (snap->fBuffer.length() == (std::size_t)buf.Length()) &&
+       std::equal(snap->fBuffer.begin(), snap->fBuffer.end(), buf.Buffer())) {
+      snap->fTime = now;
+      return snap;
+   }
+
+   snap = std::make_shared<Snapshot>();
+   snap->fClass = obj->IsA();
+   snap->fBuffer.assign(buf.Buffer(), buf.Length());
+   snap->fVersion = ++fLastVersion;
+   snap->fTime = now;
+
+   return snap;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill response from the cache
+///
+/// Response is found if it was produced for the same snapshot version.
+/// Responses produced with zero version are valid only for the snapshot interval.
+
+Bool_t THttpResponseCache::FindResponse(const std::string &key, ULong64_t version, THttpCallArg &arg)
+{
+   std::lock_guard<std::mutex> grd(fMutex);
+
+   auto iter = fResponseIndex.find(key);
+   if (iter == fResponseIndex.end())
+      return kFALSE;
+
+   auto &resp = *iter->second;
+   if ((resp.fVersion != version) || (!version && (Clock_t::now() - resp.fTime >= fInterval)))
+      return kFALSE;
+
+   fResponses.splice(fResponses.begin(), fResponses, iter->second);
+
+   arg.fContent = resp.fContent;
+   arg.fContentType = resp.fContentType;
+   arg.fHeader = resp.fHeader;
+   arg.fZipping = resp.fZipping;
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store response for the key and snapshot version
+///
+/// Least recently used responses are removed when total size exceeds the limit
+
+void THttpResponseCache::StoreResponse(const std::string &key, ULong64_t version, const THttpCallArg &arg)
+{
+   if (arg.fContent.length() > fMaxResponsesSize / 10)
+      return;
+
+   std::lock_guard<std::mutex> grd(fMutex);
+
+   auto iter = fResponseIndex.find(key);
+   if (iter != fResponseIndex.end()) {
+      fResponsesSize -= iter->second->fContent.length();
+      fResponses.erase(iter->second);
+      fResponseIndex.erase(iter);
+   }
+
+   while (!fResponses.empty() && (fResponsesSize + arg.fContent.length() > fMaxResponsesSize)) {
+      fResponsesSize -= fResponses.back().fContent.length();
+      fResponseIndex.erase(fResponses.back().fKey);
+      fResponses.pop_back();
+   }
+
+   fResponses.emplace_front();
+   auto &resp = fResponses.front();
+   resp.fKey = key;
+   resp.fVersion = version;
+   resp.fTime = Clock_t::now();
+   resp.fContent = arg.fContent;
+   resp.fContentType = arg.fContentType;
+   resp.fHeader = arg.fHeader;
+   resp.fZipping = arg.fZipping;
+
+   fResponsesSize += resp.fContent.length();
+   fResponseIndex[key] = fResponses.begin();
+}
@@ -0,0 +1,93 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THttpResponseCache
+#define ROOT_THttpResponseCache
+
+#include "Rtypes.h"
+#include "TString.h"
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class TClass;
+class TObject;
+class THttpCallArg;
+
+class THttpResponseCache {
+public:
+   using Clock_t = std::chrono::steady_clock;
+
+   /// Streamed copy of a registered object, taken in the main thread
+   class Snapshot {
+      friend class THttpResponseCache;
+
+      TClass *fClass{nullptr};           ///< class of the object
+      std::string fBuffer;               ///< object streamed with TBufferFile
+      ULong64_t fVersion{0};             ///< changes whenever the streamed object changes
+      Clock_t::time_point fTime;         ///< when the snapshot was taken or confirmed, protected by cache mutex
+      std::once_flag fReadFlag;          ///< guards creation of fObject
+      std::unique_ptr<TObject> fObject;  ///< object read back from fBuffer, created on demand
+
+   public:
+      ~Snapshot();
+
+      /** Returns version of the snapshot, identical snapshots of the same item have the same version */
+      ULong64_t GetVersion() const { return fVersion; }
+
+      /** Returns class of snapshot object */
+      TClass *GetClass() const { return fClass; }
+
+      TObject *GetObject();
+   };
+
+private:
+   /// Cached response of a read-only request
+   struct Response {
+      std::string fKey;              ///< request key
+      ULong64_t fVersion{0};         ///< snapshot version, 0 when response does not depend on a snapshot
+      Clock_t::time_point fTime;     ///< when the response was produced
+      std::string fContent;          ///< response content
+      TString fContentType;          ///< response content type
+      TString fHeader;               ///< response header
+      Int_t fZipping{0};             ///< zipping mode
+   };
+
+   std::mutex fMutex;                                                  ///< protects all members below
+   Clock_t::duration fInterval;                                        ///< validity of snapshots
+   ULong64_t fLastVersion{0};                                          ///< last assigned snapshot version
+   std::unordered_map<std::string, std::shared_ptr<Snapshot>> fSnapshots; ///< snapshots per item
+   Clock_t::time_point fLastPurge;                                     ///< last removal of unused snapshots
+   std::list<Response> fResponses;                                     ///< responses, recently used first
+   std::unordered_map<std::string, std::list<Response>::iterator> fResponseIndex; ///< responses by key
+   std::size_t fResponsesSize{0};                                      ///< total content size of responses
+   std::size_t fMaxResponsesSize{0};                                   ///< limit for fResponsesSize
+
+   void PurgeSnapshots(Clock_t::time_point now);
+
+public:
+   THttpResponseCache(Long_t intervalMs, std::size_t maxSize);
+
+   void SetInterval(Long_t intervalMs);
+
+   std::shared_ptr<Snapshot> FindSnapshot(const std::string &item);
+
+   std::shared_ptr<Snapshot> TakeSnapshot(const std::string &item, TObject *obj);
+
+   Bool_t FindResponse(const std::string &key, ULong64_t version, THttpCallArg &arg);
+
+   void StoreResponse(const std::string &key, ULong64_t version, const THttpCallArg &arg);
+};
+
+#endif
@@ -28,6 +28,8 @@
 #include "THttpWSHandler.h"
 #include "TRootSniffer.h"
 #include "TRootSnifferStore.h"
+#include "THttpResponseCache.h"
+#include "TBufferJSON.h"
 #include "TCivetweb.h"
 #include "TFastCgi.h"
 
@@ -35,6 +37,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
@@ -84,6 +87,16 @@ public:
    }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// Task of a worker thread, which must be executed in the main thread
+
+class THttpMainTask {
+public:
+   std::function<void()> fFunc; ///< function to execute
+   Bool_t fStarted{kFALSE};     ///< set when execution starts, protected by THttpServer::fMutex
+   Bool_t fCancelled{kFALSE};   ///< set when worker thread does not wait any longer, protected by THttpServer::fMutex
+   std::promise<void> fDone;    ///< fulfilled when execution is done
+};
 
 /** \class THttpServer
 \ingroup http
@@ -121,6 +134,12 @@ If objects content is changing in the application, one could
 enable monitoring flag in the browser - than objects view
 will be regularly updated.
 
+With many clients polling the same objects, the main thread may become the bottleneck.
+Then read-only requests (`root.json`, `root.bin`, images and `h.json`) can be handled by
+worker threads, see THttpServer::SetWorkerThreads():
+
+    serv->SetWorkerThreads(4);
+
 More information: https://root.cern/root/htmldoc/guides/HttpServer/HttpServer.html
 */
 
@@ -149,6 +168,7 @@ ClassImp(THttpServer);
 ///     cors           - enable CORS header with origin="*"
 ///     cors=domain    - enable CORS header with origin="domain"
 ///     basic_sniffer  - use basic sniffer without support of hist, gpad, graph classes
+///     workers=N      - handle read-only requests in N worker threads, see SetWorkerThreads()
 ///
 /// For example, create http server, which allows cors headers and disable scan of global lists,
 /// one should provide "http:8080;cors;noglobal" as parameter
@@ -227,6 +247,8 @@ THttpServer::THttpServer(const char *engine) : TNamed("http", "ROOT http server"
             SetCors(opt + 5);
          } else if (strcmp(opt, "cors") == 0) {
             SetCors("*");
+         } else if (strncmp(opt, "workers=", 8) == 0) {
+            SetWorkerThreads(TString(opt + 8).Atoi());
          } else
             CreateEngine(opt);
       }
@@ -242,6 +264,8 @@ THttpServer::THttpServer(const char *engine) : TNamed("http", "ROOT http server"
 
 THttpServer::~THttpServer()
 {
+   StopWorkerThreads();
+
    StopServerThread();
 
    if (fTerminated) {
@@ -552,6 +576,274 @@ void THttpServer::StopServerThread()
    fMainThrdId = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Handle read-only requests in worker threads
+///
+/// Requests for `root.json`, `root.bin`, `root.png`, `root.gif`, `root.jpeg` and `h.json` are queued
+/// for `nthreads` worker threads instead of the main thread. A worker asks the main thread for a
+/// snapshot of the requested object - a streamed copy, see THttpResponseCache - at most once per
+/// `snapshotMs` milliseconds. Objects which did not change since the previous snapshot keep their
+/// version, and responses already produced for this version are served from the cache without
+/// involving the main thread. JSON is produced by the worker from its own copy of the object;
+/// binary data and images are produced in the main thread, but also cached. `h.json` is cached for
+/// `snapshotMs` milliseconds.
+///
+/// Thus clients may get object content up to `snapshotMs` milliseconds old.
+/// Calls ROOT::EnableThreadSafety(). Specify nthreads = 0 to stop the worker threads.
+
+void THttpServer::SetWorkerThreads(Int_t nthreads, Long_t snapshotMs)
+{
+   StopWorkerThreads();
+
+   if (nthreads <= 0)
+      return;
+
+   ROOT::EnableThreadSafety();
+
+   if (!fCache)
+      fCache = std::make_unique<THttpResponseCache>(snapshotMs, 256 * 1024 * 1024);
+   else
+      fCache->SetInterval(snapshotMs);
+
+   fStopWorkers = false;
+   fNumWorkers = nthreads;
+
+   for (Int_t n = 0; n < nthreads; ++n) {
+      fWorkers.emplace_back([this] {
+         std::unique_lock<std::mutex> lk(fWorkMutex);
+         while (true) {
+            fWorkCond.wait(lk, [this] { return fStopWorkers || !fWorkArgs.empty(); });
+            if (fStopWorkers)
+               break;
+
+            auto arg = fWorkArgs.front();
+            fWorkArgs.pop();
+            lk.unlock();
+
+            ProcessWorkerRequest(arg);
+
+            lk.lock();
+         }
+      });
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop worker threads
+///
+/// Requests which are still queued are replied with 404
+
+void THttpServer::StopWorkerThreads()
+{
+   if (fWorkers.empty())
+      return;
+
+   {
+      std::lock_guard<std::mutex> grd(fWorkMutex);
+      fStopWorkers = true;
+   }
+   fWorkCond.notify_all();
+
+   for (auto &thrd : fWorkers)
+      thrd.join();
+   fWorkers.clear();
+   fNumWorkers = 0;
+
+   std::lock_guard<std::mutex> grd(fWorkMutex);
+   while (!fWorkArgs.empty()) {
+      auto arg = fWorkArgs.front();
+      fWorkArgs.pop();
+      arg->Set404();
+      arg->NotifyCondition();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Checks if request can be handled by worker threads
+
+Bool_t THttpServer::IsWorkerRequest(THttpCallArg &arg) const
+{
+   if (!fNumWorkers || fWSOnly || arg.IsPostMethod() || !arg.fPostData.empty())
+      return kFALSE;
+
+   TString filename = arg.fFileName;
+   if (filename.EndsWith(".gz"))
+      filename.Resize(filename.Length() - 3);
+
+   if (filename == "h.json")
+      return kTRUE;
+
+   return !arg.fPathName.IsNull() && ((filename == "root.json") || (filename == "root.bin") ||
+                                      (filename == "root.png") || (filename == "root.gif") || (filename == "root.jpeg"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execute function in the main thread and wait for its completion
+///
+/// Returns kFALSE if the server terminates or worker threads are stopped before execution
+
+Bool_t THttpServer::RunInMainThread(std::function<void()> func)
+{
+   auto task = std::make_shared<THttpMainTask>();
+   task->fFunc = std::move(func);
+   auto done = task->fDone.get_future();
+
+   {
+      std::lock_guard<std::mutex> grd(fMutex);
+      fMainTasks.push(task);
+   }
+
+   if (fTimer && fTimer->IsSlow())
+      fTimer->SetSlow(kFALSE);
+
+   while (done.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+      if (!fTerminated && !fStopWorkers)
+         continue;
+      std::lock_guard<std::mutex> grd(fMutex);
+      if (!task->fStarted) {
+         task->fCancelled = kTRUE;
+         return kFALSE;
+      }
+   }
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execute tasks submitted by worker threads, called in the main thread
+///
+/// Returns number of executed tasks
+
+Int_t THttpServer::ProcessMainTasks()
+{
+   Int_t cnt = 0;
+
+   std::unique_lock<std::mutex> lk(fMutex, std::defer_lock);
+
+   while (true) {
+      std::shared_ptr<THttpMainTask> task;
+
+      lk.lock();
+      while (!task && !fMainTasks.empty()) {
+         task = fMainTasks.front();
+         fMainTasks.pop();
+         if (task->fCancelled)
+            task.reset();
+         else
+            task->fStarted = kTRUE;
+      }
+      lk.unlock();
+
+      if (!task)
+         break;
+
+      cnt++;
+      try {
+         task->fFunc();
+      } catch (...) {
+      }
+      task->fDone.set_value();
+   }
+
+   return cnt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process read-only request in a worker thread
+///
+/// Takes a snapshot of the requested object in the main thread if the previous one is outdated
+/// and tries to reply with the cached response for the snapshot version. Otherwise JSON is produced
+/// in the worker thread from the snapshot and other kinds of requests are processed in the main thread.
+
+void THttpServer::ProcessWorkerRequest(std::shared_ptr<THttpCallArg> arg)
+{
+   auto process_in_main = [this, &arg] {
+      auto prev = fSniffer->SetCurrentCallArg(arg.get());
+      try {
+         ProcessRequest(arg);
+         fSniffer->SetCurrentCallArg(prev);
+      } catch (...) {
+         fSniffer->SetCurrentCallArg(prev);
+      }
+   };
+
+   TString filename = arg->fFileName;
+   Bool_t iszip = kFALSE;
+   if (filename.EndsWith(".gz")) {
+      filename.Resize(filename.Length() - 3);
+      iszip = kTRUE;
+   }
+
+   // access rights may depend on the user, therefore snapshots and responses are not shared between users
+   std::string user = arg->GetUserName() ? arg->GetUserName() : "";
+   std::string item = user + ":" + arg->fTopName.Data() + ":" + arg->fPathName.Data();
+   std::string key = item + "/" + arg->fFileName.Data() + "?" + arg->fQuery.Data();
+
+   std::shared_ptr<THttpResponseCache::Snapshot> snap;
+
+   if (filename != "h.json") {
+      snap = fCache->FindSnapshot(item);
+
+      if (!snap) {
+         Bool_t res = RunInMainThread([this, &arg, &item, &snap] {
+            auto prev = fSniffer->SetCurrentCallArg(arg.get());
+            snap = fCache->TakeSnapshot(item, fSniffer->FindTObjectInHierarchy(arg->fPathName.Data()));
+            fSniffer->SetCurrentCallArg(prev);
+         });
+
+         if (!res) {
+            arg->Set404();
+            arg->NotifyCondition();
+            return;
+         }
+      }
+
+      // not a TObject, not accessible or not existing - process as usual
+      if (!snap) {
+         if (!RunInMainThread(process_in_main))
+            arg->Set404();
+         arg->NotifyCondition();
+         return;
+      }
+   }
+
+   ULong64_t version = snap ? snap->GetVersion() : 0;
+
+   if (fCache->FindResponse(key, version, *arg)) {
+      arg->NotifyCondition();
+      return;
+   }
+
+   if (filename == "root.json") {
+      TUrl url;
+      url.SetOptions(arg->fQuery.Data());
+      url.ParseOptions();
+      Int_t compact = url.GetValueFromOptions("compact") ? url.GetIntValueFromOptions("compact") : 0;
+
+      TObject *obj = snap->GetObject();
+      if (obj) {
+         TString json = TBufferJSON::ConvertToJSON(obj, snap->GetClass(), compact >= 0 ? compact : 0);
+         arg->SetContent(std::string(json.Data()));
+      }
+
+      if (arg->fContent.empty()) {
+         arg->Set404();
+      } else {
+         arg->SetContentType(GetMimeType(filename.Data()));
+         if (iszip)
+            arg->SetZipping(THttpCallArg::kZipAlways);
+         AddResponseHeaders(*arg);
+      }
+   } else if (!RunInMainThread(process_in_main)) {
+      arg->Set404();
+   }
+
+   if (!arg->Is404())
+      fCache->StoreResponse(key, version, *arg);
+
+   arg->NotifyCondition();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Checked that filename does not contains relative path below current directory
 ///
@@ -650,6 +942,15 @@ Bool_t THttpServer::ExecuteHttp(std::shared_ptr<THttpCallArg> arg)
       return kTRUE;
    }
 
+   if (IsWorkerRequest(*arg)) {
+      std::unique_lock<std::mutex> lk(fWorkMutex);
+      fWorkArgs.push(arg);
+      fWorkCond.notify_one();
+      // wait until request is processed by worker thread
+      arg->fCond.wait(lk);
+      return kTRUE;
+   }
+
    if (fTimer && fTimer->IsSlow())
       fTimer->SetSlow(kFALSE);
 
@@ -687,6 +988,13 @@ Bool_t THttpServer::SubmitHttp(std::shared_ptr<THttpCallArg> arg, Bool_t can_run
       return kTRUE;
    }
 
+   if (IsWorkerRequest(*arg)) {
+      std::unique_lock<std::mutex> lk(fWorkMutex);
+      fWorkArgs.push(arg);
+      fWorkCond.notify_one();
+      return kFALSE;
+   }
+
    // add call arg to the list
    std::unique_lock<std::mutex> lk(fMutex);
    fArgs.push(arg);
@@ -727,11 +1035,12 @@ Int_t THttpServer::ProcessRequests()
    if (!recursion)
       fProcessingThrdId = id;
 
-   Int_t cnt = 0;
+   // first execute tasks of worker threads, they may wait for snapshots
+   Int_t cnt = ProcessMainTasks();
 
    std::unique_lock<std::mutex> lk(fMutex, std::defer_lock);
 
-   // first process requests in the queue
+   // then process requests in the queue
    while (true) {
       std::shared_ptr<THttpCallArg> arg;
 
@@ -1220,14 +1529,22 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
       arg->AddHeader(parname, TString::Format("%u", (unsigned)fSniffer->GetStreamerInfoHash()).Data());
    }
 
+   AddResponseHeaders(*arg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add no-cache and CORS headers to the response of object request
+
+void THttpServer::AddResponseHeaders(THttpCallArg &arg)
+{
    // try to avoid caching on the browser
-   arg->AddNoCacheHeader();
+   arg.AddNoCacheHeader();
 
    // potentially add cors headers
    if (IsCors())
-      arg->AddHeader("Access-Control-Allow-Origin", GetCors());
+      arg.AddHeader("Access-Control-Allow-Origin", GetCors());
    if (IsCorsCredentials())
-      arg->AddHeader("Access-Control-Allow-Credentials", GetCorsCredentials());
+      arg.AddHeader("Access-Control-Allow-Credentials", GetCorsCredentials());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
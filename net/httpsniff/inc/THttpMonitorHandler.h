@@ -0,0 +1,80 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THttpMonitorHandler
+#define ROOT_THttpMonitorHandler
+
+#include "THttpWSHandler.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class THttpServer;
+class TObject;
+class TH1;
+
+class THttpMonitorHandler : public THttpWSHandler {
+protected:
+   /// State of a monitored item, shared by all clients
+   struct ItemState {
+      std::chrono::steady_clock::time_point fCheckTime; ///< last time the object was checked
+      TClass *fClass{nullptr};                           ///< class of the object, nullptr if not found
+      ULong64_t fResetVersion{0};    ///< version of last change, which requires full update
+      ULong64_t fVersion{0};         ///< version of last change
+      Bool_t fIsHist{kFALSE};        ///< kTRUE if bin-wise changes are tracked
+      Int_t fPrecision{17};          ///< digits used for bin content
+      TString fTitle;                ///< histogram title
+      std::vector<Double_t> fLayout; ///< histogram binning
+      std::vector<Double_t> fStats;  ///< histogram entries, minimum, maximum and statistics
+      std::vector<Double_t> fContent; ///< histogram bin content
+      std::vector<Double_t> fSumw2;  ///< histogram sum of squares of weights, empty if not used
+      std::vector<ULong64_t> fBinVersion; ///< version of last change per bin
+      std::size_t fHash{0};          ///< hash of the streamed object if bin-wise changes are not tracked
+   };
+
+   THttpServer *fServer{nullptr};             ///<! server to access the objects
+   Long_t fCheckInterval{100};                ///<! minimal time between checks of the same object, ms
+   Int_t fMergeGap{4};                        ///<! changed bins closer than this are sent as one range
+   Int_t fZipThreshold{1024};                 ///<! larger updates are sent compressed
+   ULong64_t fVersion{0};                     ///<! last assigned version
+   std::map<std::string, ItemState> fItems;   ///<! states of monitored items
+   std::map<UInt_t, std::map<std::string, ULong64_t>> fClients; ///<! version of items known by each client
+
+   void CheckItem(const std::string &item, ItemState &state);
+
+   void CheckHistogram(TH1 *hist, ItemState &state);
+
+   void ProduceItemUpdate(const std::string &item, ItemState &state, ULong64_t version, std::string &res);
+
+   void SendUpdate(UInt_t wsid);
+
+   void PurgeItems();
+
+public:
+   THttpMonitorHandler(const char *name, THttpServer *serv);
+
+   /** Set minimal time between checks of the same object, in milliseconds */
+   void SetCheckInterval(Long_t ms) { fCheckInterval = ms; }
+
+   /** Set maximal number of unchanged bins between changed bins, sent as one range */
+   void SetMergeGap(Int_t gap) { fMergeGap = gap; }
+
+   /** Set size of updates, above which they are compressed */
+   void SetZipThreshold(Int_t sz) { fZipThreshold = sz; }
+
+   Bool_t ProcessWS(THttpCallArg *arg) override;
+
+   ClassDefOverride(THttpMonitorHandler, 0) // Websocket handler, providing incremental updates of monitored objects
+};
+
+#endif
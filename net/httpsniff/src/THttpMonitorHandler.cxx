@@ -0,0 +1,388 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "THttpMonitorHandler.h"
+
+#include "THttpCallArg.h"
+#include "THttpServer.h"
+#include "TRootSniffer.h"
+#include "TBufferFile.h"
+#include "TBufferJSON.h"
+#include "TArrayF.h"
+#include "TAxis.h"
+#include "TH1.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+
+#include <cstdio>
+#include <functional>
+#include <string_view>
+#include <utility>
+
+/** \class THttpMonitorHandler
+\ingroup http
+
+Websocket handler, which provides incremental updates of monitored objects
+
+Instead of polling `root.json` of every object, a client opens one websocket
+and subscribes to the items it displays:
+
+    auto handler = std::make_shared<THttpMonitorHandler>("monitor", serv);
+    serv->RegisterWS(handler);
+
+    let ws = new WebSocket("ws://hostname:8080/monitor/root.websocket");
+
+The client sends text messages:
+
+    SUB:item     subscribe to the item, for instance "SUB:/Files/job1.root/hpx"
+    UNSUB:item   unsubscribe from the item
+    FULL:item    request full object with next update
+    UPDATE       request update of all subscribed items
+
+Only `UPDATE` is replied, with a JSON array containing one entry per item changed since
+the previous update of the same client:
+
+    {"item":"name","v":57,"full":{...}}   // complete object as produced by TBufferJSON, null if not found
+    {"item":"name","v":58,"entries":100,"min":-1111,"max":-1111,"stats":[...],
+     "bins":[[first,[c1,c2,...]],...],"sumw2":[[first,[w1,w2,...]],...]}
+
+Histograms (except profiles) are sent as ranges of changed bins, with global bin numbers, when
+their binning, title and class did not change; `stats` are the values of TH1::GetStats().
+Other objects are sent completely if changed. Updates larger than the zip threshold are sent as
+text message `gzip` followed by binary message with gzip-compressed JSON array.
+
+Server keeps per item the version, when each bin was changed last time, and per client only
+the version of every item it received, therefore memory usage does not grow with number of clients.
+Objects are checked at most once per check interval, independent from the number of clients.
+*/
+
+ClassImp(THttpMonitorHandler);
+
+namespace {
+
+void AppendQuoted(std::string &res, const std::string &str)
+{
+   res.append("\"");
+   for (auto c : str) {
+      if ((c == '"') || (c == '\\'))
+         res.append("\\");
+      res.append(1, c);
+   }
+   res.append("\"");
+}
+
+void AppendNumber(std::string &res, Double_t value, Int_t precision = 17)
+{
+   char buf[40];
+   std::snprintf(buf, sizeof(buf), "%.*g", precision, value);
+   res.append(buf);
+}
+
+std::size_t HashObject(TObject *obj)
+{
+   TBufferFile buf(TBuffer::kWrite, 10000);
+   buf.MapObject(obj);
+   obj->Streamer(buf);
+   return std::hash<std::string_view>{}(std::string_view(buf.Buffer(), buf.Length()));
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// constructor
+
+THttpMonitorHandler::THttpMonitorHandler(const char *name, THttpServer *serv)
+   : THttpWSHandler(name, "incremental updates of monitored objects"), fServer(serv)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if the object of the item was changed, at most once per check interval
+
+void THttpMonitorHandler::CheckItem(const std::string &item, ItemState &state)
+{
+   auto now = std::chrono::steady_clock::now();
+   if (state.fVersion && (now - state.fCheckTime < std::chrono::milliseconds(fCheckInterval)))
+      return;
+   state.fCheckTime = now;
+
+   TObject *obj = fServer->GetSniffer()->FindTObjectInHierarchy(item.c_str());
+
+   auto hist = dynamic_cast<TH1 *>(obj);
+   if (hist && (hist->InheritsFrom(TProfile::Class()) || hist->InheritsFrom(TProfile2D::Class()) ||
+                hist->InheritsFrom(TProfile3D::Class())))
+      hist = nullptr;
+
+   TClass *cl = obj ? obj->IsA() : nullptr;
+
+   if (!state.fVersion || (state.fClass != cl) || (state.fIsHist != (hist != nullptr))) {
+      state.fClass = cl;
+      state.fIsHist = hist != nullptr;
+      state.fLayout.clear();
+      state.fHash = (obj && !hist) ? HashObject(obj) : 0;
+      if (!hist)
+         state.fVersion = state.fResetVersion = ++fVersion;
+   } else if (obj && !hist) {
+      auto hash = HashObject(obj);
+      if (hash != state.fHash) {
+         state.fHash = hash;
+         state.fVersion = state.fResetVersion = ++fVersion;
+      }
+   }
+
+   if (hist)
+      CheckHistogram(hist, state);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compare histogram with the stored state and mark changed bins with new version
+
+void THttpMonitorHandler::CheckHistogram(TH1 *hist, ItemState &state)
+{
+   Int_t ncells = hist->GetNcells();
+   Int_t nsumw2 = (hist->GetSumw2N() == ncells) ? ncells : 0;
+
+   std::vector<Double_t> layout;
+   for (auto axis : {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()}) {
+      layout.insert(layout.end(), {(Double_t)axis->GetNbins(), axis->GetXmin(), axis->GetXmax(),
+                                   (Double_t)axis->GetFirst(), (Double_t)axis->GetLast()});
+      auto bins = axis->GetXbins();
+      layout.insert(layout.end(), bins->GetArray(), bins->GetArray() + bins->GetSize());
+   }
+   layout.push_back(nsumw2);
+
+   Double_t stats[TH1::kNstat];
+   hist->GetStats(stats);
+   std::vector<Double_t> allstats{hist->GetEntries(), hist->GetMinimumStored(), hist->GetMaximumStored()};
+   allstats.insert(allstats.end(), stats, stats + TH1::kNstat);
+
+   if ((layout != state.fLayout) || (state.fTitle != hist->GetTitle())) {
+      state.fVersion = state.fResetVersion = ++fVersion;
+      state.fLayout = std::move(layout);
+      state.fTitle = hist->GetTitle();
+      state.fStats = std::move(allstats);
+      state.fPrecision = dynamic_cast<TArrayF *>(hist) ? 9 : 17;
+      state.fContent.resize(ncells);
+      state.fSumw2.resize(nsumw2);
+      state.fBinVersion.assign(ncells, state.fVersion);
+      for (Int_t n = 0; n < ncells; ++n) {
+         state.fContent[n] = hist->GetBinContent(n);
+         if (nsumw2)
+            state.fSumw2[n] = hist->GetSumw2()->At(n);
+      }
+      return;
+   }
+
+   ULong64_t version = 0;
+
+   for (Int_t n = 0; n < ncells; ++n) {
+      Double_t cont = hist->GetBinContent(n);
+      Double_t sumw2 = nsumw2 ? hist->GetSumw2()->At(n) : 0.;
+      if ((cont != state.fContent[n]) || (nsumw2 && (sumw2 != state.fSumw2[n]))) {
+         if (!version)
+            version = ++fVersion;
+         state.fContent[n] = cont;
+         if (nsumw2)
+            state.fSumw2[n] = sumw2;
+         state.fBinVersion[n] = version;
+      }
+   }
+
+   if (allstats != state.fStats) {
+      if (!version)
+         version = ++fVersion;
+      state.fStats = std::move(allstats);
+   }
+
+   if (version)
+      state.fVersion = version;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produce JSON with changes of the item since specified version
+
+void THttpMonitorHandler::ProduceItemUpdate(const std::string &item, ItemState &state, ULong64_t version,
+                                            std::string &res)
+{
+   res.append("{\"item\":");
+   AppendQuoted(res, item);
+   res.append(",\"v\":");
+   res.append(std::to_string(state.fVersion));
+
+   if (version < state.fResetVersion) {
+      TObject *obj = state.fClass ? fServer->GetSniffer()->FindTObjectInHierarchy(item.c_str()) : nullptr;
+      res.append(",\"full\":");
+      if (obj)
+         res.append(TBufferJSON::ConvertToJSON(obj, 23).Data());
+      else
+         res.append("null");
+      res.append("}");
+      return;
+   }
+
+   res.append(",\"entries\":");
+   AppendNumber(res, state.fStats[0]);
+   res.append(",\"min\":");
+   AppendNumber(res, state.fStats[1]);
+   res.append(",\"max\":");
+   AppendNumber(res, state.fStats[2]);
+   res.append(",\"stats\":[");
+   for (std::size_t n = 3; n < state.fStats.size(); ++n) {
+      if (n > 3)
+         res.append(",");
+      AppendNumber(res, state.fStats[n]);
+   }
+   res.append("]");
+
+   // collect ranges of changed bins, merging ranges separated by few unchanged bins
+   std::vector<std::pair<Int_t, Int_t>> ranges;
+   Int_t ncells = state.fBinVersion.size();
+   for (Int_t n = 0; n < ncells; ++n) {
+      if (state.fBinVersion[n] <= version)
+         continue;
+      Int_t last = n;
+      for (Int_t k = n + 1; (k < ncells) && (k - last <= fMergeGap + 1); ++k)
+         if (state.fBinVersion[k] > version)
+            last = k;
+      ranges.emplace_back(n, last);
+      n = last;
+   }
+
+   auto append_ranges = [&](const char *name, const std::vector<Double_t> &values) {
+      res.append(",\"");
+      res.append(name);
+      res.append("\":[");
+      for (std::size_t r = 0; r < ranges.size(); ++r) {
+         if (r > 0)
+            res.append(",");
+         res.append("[");
+         res.append(std::to_string(ranges[r].first));
+         res.append(",[");
+         for (Int_t n = ranges[r].first; n <= ranges[r].second; ++n) {
+            if (n > ranges[r].first)
+               res.append(",");
+            AppendNumber(res, values[n], state.fPrecision);
+         }
+         res.append("]]");
+      }
+      res.append("]");
+   };
+
+   append_ranges("bins", state.fContent);
+   if (!state.fSumw2.empty())
+      append_ranges("sumw2", state.fSumw2);
+
+   res.append("}");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Send changes of all subscribed items to the client
+
+void THttpMonitorHandler::SendUpdate(UInt_t wsid)
+{
+   auto &client = fClients[wsid];
+
+   std::string res = "[";
+
+   for (auto &entry : client) {
+      auto &state = fItems[entry.first];
+      CheckItem(entry.first, state);
+      if (entry.second >= state.fVersion)
+         continue;
+      if (res.length() > 1)
+         res.append(",");
+      ProduceItemUpdate(entry.first, state, entry.second, res);
+      entry.second = state.fVersion;
+   }
+
+   res.append("]");
+
+   if ((Int_t)res.length() > fZipThreshold) {
+      THttpCallArg zip;
+      zip.SetContent(std::move(res));
+      zip.CompressWithGzip();
+      SendHeaderWS(wsid, "gzip", zip.GetContent(), zip.GetContentLength());
+   } else {
+      SendCharStarWS(wsid, res.c_str());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove states of items without subscribed clients
+
+void THttpMonitorHandler::PurgeItems()
+{
+   for (auto iter = fItems.begin(); iter != fItems.end();) {
+      Bool_t used = kFALSE;
+      for (auto &client : fClients)
+         if (client.second.count(iter->first)) {
+            used = kTRUE;
+            break;
+         }
+      if (used)
+         ++iter;
+      else
+         iter = fItems.erase(iter);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process websocket requests of the clients
+
+Bool_t THttpMonitorHandler::ProcessWS(THttpCallArg *arg)
+{
+   if (!arg || !arg->GetWSId() || !fServer)
+      return kFALSE;
+
+   UInt_t wsid = arg->GetWSId();
+
+   if (arg->IsMethod("WS_CONNECT"))
+      return kTRUE;
+
+   if (arg->IsMethod("WS_READY")) {
+      fClients[wsid].clear();
+      return kTRUE;
+   }
+
+   if (arg->IsMethod("WS_CLOSE")) {
+      fClients.erase(wsid);
+      PurgeItems();
+      return kTRUE;
+   }
+
+   auto iter = fClients.find(wsid);
+   if (!arg->IsMethod("WS_DATA") || (iter == fClients.end()))
+      return kFALSE;
+
+   std::string msg((const char *)arg->GetPostData(), arg->GetPostDataLength());
+
+   if (msg == "UPDATE") {
+      SendUpdate(wsid);
+   } else if (msg.compare(0, 4, "SUB:") == 0) {
+      // check access rights of the client, the item state itself is shared
+      auto sniffer = fServer->GetSniffer();
+      auto prev = sniffer->SetCurrentCallArg(arg);
+      if (sniffer->FindTObjectInHierarchy(msg.c_str() + 4))
+         iter->second.emplace(msg.substr(4), 0);
+      sniffer->SetCurrentCallArg(prev);
+   } else if (msg.compare(0, 6, "UNSUB:") == 0) {
+      iter->second.erase(msg.substr(6));
+      PurgeItems();
+   } else if (msg.compare(0, 5, "FULL:") == 0) {
+      auto item = iter->second.find(msg.substr(5));
+      if (item != iter->second.end())
+         item->second = 0;
+   } else {
+      return kFALSE;
+   }
+
+   return kTRUE;
+}
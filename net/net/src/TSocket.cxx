@@ -1056,19 +1056,19 @@ void TSocket::SetCompressionAlgorithm(Int_t algorithm)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// See comments for function SetCompressionSettings
+///
+/// If no algorithm was selected, messages are compressed with LZ4.
 
 void TSocket::SetCompressionLevel(Int_t level)
 {
    if (level < 0) level = 0;
    if (level > 99) level = 99;
-   if (fCompress < 0) {
-      // if the algorithm is not defined yet use 0 as a default
-      fCompress = level;
-   } else {
-      int algorithm = fCompress / 100;
-      if (algorithm >= ROOT::RCompressionSetting::EAlgorithm::kUndefined) algorithm = 0;
-      fCompress = 100 * algorithm + level;
-   }
+   int algorithm = (fCompress < 0) ? 0 : fCompress / 100;
+   if (algorithm >= ROOT::RCompressionSetting::EAlgorithm::kUndefined) algorithm = 0;
+   // if the algorithm is not defined yet use LZ4, which is fast enough for interactive traffic
+   if (algorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal)
+      algorithm = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+   fCompress = 100 * algorithm + level;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
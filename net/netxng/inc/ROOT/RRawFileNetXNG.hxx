@@ -27,6 +27,9 @@ The RRawFileNetXNG class provides read-only access to remote files using root/ro
 XrdCl (XRootD client) library for the transport layer.  It instructs the RRawFile base class to buffer in
 larger chunks than the default for local files, assuming that remote file access has high(er) latency.
 
+Vector reads are split according to the server's readv limits and sent asynchronously, with up to
+NetXNG.ReadvMaxInFlight (default 8) vector reads in flight at any time.
+
 */
 
 class RRawFileNetXNG : public RRawFile
@@ -46,6 +49,8 @@ public:
    ~RRawFileNetXNG();
    std::unique_ptr<RRawFile> Clone() const final;
    RIOVecLimits GetReadVLimits() final;
+   bool HasPipelinedReadV() const final { return true; }
+   std::int64_t GetModificationTime() final;
 };
 
 } // namespace Internal
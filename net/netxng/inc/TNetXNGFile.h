@@ -32,6 +32,11 @@ namespace XrdCl {
    class URL;
 }
 class XrdSysCondVar;
+namespace ROOT {
+namespace Internal {
+   class RFileBlockCache;
+}
+}
 
 #ifdef __CLING__
 namespace XrdCl {
@@ -51,12 +56,14 @@ private:
    Int_t                   fReadvIorMax; // Max size of a single readv chunk
    Int_t                   fReadvIovMax; // Max number of readv chunks
    Int_t                   fQueryReadVParams;
+   Int_t                   fReadvMaxInFlight; // Max number of concurrent readv requests
+   ROOT::Internal::RFileBlockCache *fBlockCache; //! Local block cache, if enabled
    TString                 fNewUrl;
 
 public:
    TNetXNGFile() : TFile(),
       fFile(nullptr), fUrl(nullptr), fMode(XrdCl::OpenFlags::None), fInitCondVar(nullptr),
-      fReadvIorMax(0), fReadvIovMax(0) {}
+      fReadvIorMax(0), fReadvIovMax(0), fReadvMaxInFlight(0), fBlockCache(nullptr) {}
    TNetXNGFile(const char *url, const char *lurl, Option_t *mode, const char *title,
                Int_t compress, Int_t netopt, Bool_t parallelopen);
    TNetXNGFile(const char *url, Option_t *mode = "", const char *title = "",
@@ -83,6 +90,9 @@ private:
    virtual Bool_t IsUseable() const;
    virtual Bool_t GetVectorReadLimits();
    virtual void   SetEnv();
+   void           InitBlockCache();
+   Bool_t         ReadBuffersRemote(char *buffer, Long64_t *position, Int_t *length, Int_t nbuffs);
+   Bool_t         ReadBuffersViaBlockCache(char *buffer, Long64_t *position, Int_t *length, Int_t nbuffs);
    Int_t ParseOpenMode(Option_t *in, TString &modestr,
                        XrdCl::OpenFlags::Flags &mode, Bool_t assumeRead);
 
@@ -11,10 +11,15 @@
 
 #include "ROOT/RRawFileNetXNG.hxx"
 
+#include <TEnv.h>
 #include <TError.h>
 
+#include <algorithm>
 #include <cctype>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -26,6 +31,69 @@
 
 namespace {
 constexpr int kDefaultBlockSize = 128 * 1024; // Read in relatively large 128k blocks for better network utilization
+constexpr int kDefaultReadvMaxInFlight = 8;
+
+/// Collects the completions of the asynchronous vector reads issued by one ReadVImpl() call
+class RAsyncReadVState {
+   std::mutex fLock;
+   std::condition_variable fCvCompleted;
+   std::size_t fNInFlight = 0;
+   /// The number of bytes read per chunk, for every vector read
+   std::vector<std::vector<std::uint32_t>> fChunkLengths;
+   std::string fError;
+
+public:
+   explicit RAsyncReadVState(std::size_t nReads) : fChunkLengths(nReads) {}
+
+   void OnSent()
+   {
+      std::lock_guard<std::mutex> guard(fLock);
+      ++fNInFlight;
+   }
+
+   void OnCompleted(std::size_t idx, const XrdCl::XRootDStatus &status, XrdCl::VectorReadInfo *info)
+   {
+      std::lock_guard<std::mutex> guard(fLock);
+      if (status.IsOK() && info) {
+         for (const auto &chunk : info->GetChunks())
+            fChunkLengths[idx].push_back(chunk.length);
+      } else if (fError.empty()) {
+         fError = status.ToString() + "; " + status.GetErrorMessage();
+      }
+      --fNInFlight;
+      fCvCompleted.notify_one();
+   }
+
+   /// Blocks until at most maxInFlight vector reads are in flight; returns false if one of them failed
+   bool WaitInFlight(std::size_t maxInFlight)
+   {
+      std::unique_lock<std::mutex> lock(fLock);
+      fCvCompleted.wait(lock, [&] { return fNInFlight <= maxInFlight; });
+      return fError.empty();
+   }
+
+   const std::vector<std::uint32_t> &GetChunkLengths(std::size_t idx) const { return fChunkLengths[idx]; }
+   const std::string &GetError() const { return fError; }
+};
+
+class RAsyncReadVHandler : public XrdCl::ResponseHandler {
+   RAsyncReadVState &fState;
+   std::size_t fIdx;
+
+public:
+   RAsyncReadVHandler(RAsyncReadVState &state, std::size_t idx) : fState(state), fIdx(idx) {}
+
+   void HandleResponse(XrdCl::XRootDStatus *status, XrdCl::AnyObject *response) override
+   {
+      XrdCl::VectorReadInfo *info = nullptr;
+      if (status->IsOK() && response)
+         response->Get(info);
+      fState.OnCompleted(fIdx, *status, info);
+      delete response;
+      delete status;
+      delete this;
+   }
+};
 } // anonymous namespace
 
 namespace ROOT {
@@ -38,6 +106,8 @@ struct RRawFileNetXNGImpl {
    ~RRawFileNetXNGImpl() = default;
 
    XrdCl::File file;
+   /// Maximum number of concurrent vector reads in ReadVImpl()
+   std::size_t readvMaxInFlight = kDefaultReadvMaxInFlight;
 };
 
 } // namespace Internal
@@ -71,6 +141,18 @@ std::uint64_t ROOT::Internal::RRawFileNetXNG::GetSizeImpl()
    return ret;
 }
 
+std::int64_t ROOT::Internal::RRawFileNetXNG::GetModificationTime()
+{
+   EnsureOpen();
+   XrdCl::StatInfo *info = nullptr;
+   auto st = pImpl->file.Stat( false, info );
+   if( !st.IsOK() )
+     return -1;
+   std::int64_t ret = info->GetModTime();
+   delete info;
+   return ret;
+}
+
 void ROOT::Internal::RRawFileNetXNG::OpenImpl()
 {
    auto st = pImpl->file.Open( fUrl, XrdCl::OpenFlags::Read );
@@ -79,6 +161,7 @@ void ROOT::Internal::RRawFileNetXNG::OpenImpl()
                                st.ToString() + "; " + st.GetErrorMessage() );
    if (fOptions.fBlockSize == ROptions::kUseDefaultBlockSize)
       fOptions.fBlockSize = kDefaultBlockSize;
+   pImpl->readvMaxInFlight = std::max(gEnv->GetValue("NetXNG.ReadvMaxInFlight", kDefaultReadvMaxInFlight), 1);
 }
 
 size_t ROOT::Internal::RRawFileNetXNG::ReadAtImpl(void *buffer, size_t nbytes, std::uint64_t offset)
@@ -93,21 +176,59 @@ size_t ROOT::Internal::RRawFileNetXNG::ReadAtImpl(void *buffer, size_t nbytes, s
 
 void ROOT::Internal::RRawFileNetXNG::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
 {
-   XrdCl::ChunkList chunks;
-   chunks.reserve( nReq );
-   for( std::size_t i = 0; i < nReq; ++i )
-     chunks.emplace_back( ioVec[i].fOffset, ioVec[i].fSize, ioVec[i].fBuffer );
+   // Split the requests into chunks within the readv limits of the server and group the chunks into vector reads;
+   // requestIdx[i][j] is the index in ioVec of chunk j of the vector read i
+   const auto limits = GetReadVLimits();
+   std::vector<XrdCl::ChunkList> chunkLists(1);
+   std::vector<std::vector<unsigned int>> requestIdx(1);
+   std::uint64_t listSize = 0;
+   for (unsigned int i = 0; i < nReq; ++i) {
+      ioVec[i].fOutBytes = 0;
+      std::uint64_t offset = ioVec[i].fOffset;
+      auto buffer = static_cast<unsigned char *>(ioVec[i].fBuffer);
+      std::size_t remaining = ioVec[i].fSize;
+      while (remaining > 0) {
+         const std::size_t size = std::min(remaining, limits.fMaxSingleSize);
+         if (!chunkLists.back().empty() &&
+             (chunkLists.back().size() == limits.fMaxReqs || listSize + size > limits.fMaxTotalSize)) {
+            chunkLists.emplace_back();
+            requestIdx.emplace_back();
+            listSize = 0;
+         }
+         chunkLists.back().emplace_back(offset, size, buffer);
+         requestIdx.back().push_back(i);
+         listSize += size;
+         offset += size;
+         buffer += size;
+         remaining -= size;
+      }
+   }
+   if (chunkLists.back().empty())
+      return;
 
-   XrdCl::VectorReadInfo *info = nullptr;
-   auto st = pImpl->file.VectorRead( chunks, nullptr, info );
-   if( !st.IsOK() )
-     throw std::runtime_error( "Cannot do vector read from '" + fUrl + "', " +
-                               st.ToString() + "; " + st.GetErrorMessage() );
+   // Send the vector reads asynchronously, keeping at most readvMaxInFlight of them in flight; the buffers must
+   // stay valid until all the sent reads completed, also in case of errors
+   RAsyncReadVState state(chunkLists.size());
+   for (std::size_t i = 0; i < chunkLists.size(); ++i) {
+      if (!state.WaitInFlight(pImpl->readvMaxInFlight - 1))
+         break;
+      auto handler = new RAsyncReadVHandler(state, i);
+      state.OnSent();
+      auto st = pImpl->file.VectorRead(chunkLists[i], nullptr, handler);
+      if (!st.IsOK()) {
+         delete handler;
+         state.OnCompleted(i, st, nullptr);
+         break;
+      }
+   }
+   if (!state.WaitInFlight(0))
+      throw std::runtime_error("Cannot do vector read from '" + fUrl + "', " + state.GetError());
 
-   XrdCl::ChunkList &rsp = info->GetChunks();
-   for( std::size_t i = 0; i < nReq; ++i )
-     ioVec[i].fOutBytes = rsp[i].length;
-   delete info;
+   for (std::size_t i = 0; i < chunkLists.size(); ++i) {
+      const auto &lengths = state.GetChunkLengths(i);
+      for (std::size_t j = 0; j < lengths.size(); ++j)
+         ioVec[requestIdx[i][j]].fOutBytes += lengths[j];
+   }
 }
 
 ROOT::Internal::RRawFile::RIOVecLimits ROOT::Internal::RRawFileNetXNG::GetReadVLimits()
@@ -18,6 +18,7 @@
 //                                                                            //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "ROOT/RFileBlockCache.hxx"
 #include "TArchiveFile.h"
 #include "TNetXNGFile.h"
 #include "TEnv.h"
@@ -31,6 +32,8 @@
 #include <XrdCl/XrdClDefaultEnv.hh>
 #include <XrdVersion.hh>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Open handler for async open requests
@@ -159,6 +162,10 @@ TNetXNGFile::TNetXNGFile(const char *url, const char *lurl, Option_t *mode, cons
    fQueryReadVParams = 1;
    fReadvIorMax = 2097136;
    fReadvIovMax = 1024;
+   fReadvMaxInFlight = gEnv->GetValue("NetXNG.ReadvMaxInFlight", 8);
+   if (fReadvMaxInFlight < 1)
+      fReadvMaxInFlight = 1;
+   fBlockCache = nullptr;
 
    if (ParseOpenMode(mode, fOption, fMode, kTRUE)<0) {
       Error("Open", "could not parse open mode %s", mode);
@@ -214,6 +221,7 @@ TNetXNGFile::TNetXNGFile(const char *url, const char *lurl, Option_t *mode, cons
    bool create = false;
    if( (fMode & OpenFlags::New) || (fMode & OpenFlags::Delete) )
       create = true;
+   InitBlockCache();
    TFile::Init(create);
 
    // Get the vector read limits
@@ -227,6 +235,7 @@ TNetXNGFile::~TNetXNGFile()
 {
    if (IsOpen())
       Close();
+   delete fBlockCache;
    delete fUrl;
    delete fInitCondVar;
 }
@@ -255,6 +264,7 @@ void TNetXNGFile::Init(Bool_t create)
                                               kFALSE);
 
    // Initialize the file
+   InitBlockCache();
    TFile::Init(create);
 
    // Notify the monitoring system
@@ -294,6 +304,23 @@ Long64_t TNetXNGFile::GetSize() const
    return size;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set up the local block cache if enabled, see TFile::SetBlockCacheDir().
+/// Only files opened for reading are cached.
+
+void TNetXNGFile::InitBlockCache()
+{
+   if (fBlockCache || fMode != XrdCl::OpenFlags::Read || !ROOT::Internal::RFileBlockCache::IsEnabled())
+      return;
+
+   XrdCl::StatInfo *info = nullptr;
+   if (!fFile->Stat(false, info).IsOK())
+      return;
+   auto cache = ROOT::Internal::RFileBlockCache::Open(fUrl->GetLocation(), info->GetSize(), info->GetModTime());
+   delete info;
+   fBlockCache = cache.release();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Check if the file is open
 
@@ -322,6 +349,9 @@ void TNetXNGFile::Close(const Option_t */*option*/)
 {
    TFile::Close();
 
+   delete fBlockCache;
+   fBlockCache = nullptr;
+
    if (!fFile) return;
 
    XrdCl::XRootDStatus status = fFile->Close();
@@ -362,6 +392,9 @@ Int_t TNetXNGFile::ReOpen(Option_t *modestr)
       return 1;
    }
 
+   delete fBlockCache;
+   fBlockCache = nullptr;
+
    XRootDStatus st = fFile->Close();
    if (!st.IsOK()) {
       Error("ReOpen", "%s", st.ToStr().c_str());
@@ -375,6 +408,7 @@ Int_t TNetXNGFile::ReOpen(Option_t *modestr)
       Error("ReOpen", "%s", st.ToStr().c_str());
       return 1;
    }
+   InitBlockCache();
 
    return 0;
 }
@@ -423,13 +457,20 @@ Bool_t TNetXNGFile::ReadBuffer(char *buffer, Long64_t position, Int_t length)
 
    // Read the data
    uint32_t bytesRead = 0;
-   XRootDStatus st = fFile->Read(fOffset, length, buffer, bytesRead);
-   if (gDebug > 0)
-      Info("ReadBuffer", "%s bytes read: %u", st.ToStr().c_str(), bytesRead);
-
-   if (!st.IsOK()) {
-      Error("ReadBuffer", "%s", st.ToStr().c_str());
-      return kTRUE;
+   if (fBlockCache) {
+      Long64_t offset = fOffset;
+      if (ReadBuffersViaBlockCache(buffer, &offset, &length, 1))
+         return kTRUE;
+      bytesRead = length;
+   } else {
+      XRootDStatus st = fFile->Read(fOffset, length, buffer, bytesRead);
+      if (gDebug > 0)
+         Info("ReadBuffer", "%s bytes read: %u", st.ToStr().c_str(), bytesRead);
+
+      if (!st.IsOK()) {
+         Error("ReadBuffer", "%s", st.ToStr().c_str());
+         return kTRUE;
+      }
    }
 
    if ((Int_t)bytesRead != length) {
@@ -457,6 +498,9 @@ Bool_t TNetXNGFile::ReadBuffer(char *buffer, Long64_t position, Int_t length)
 ////////////////////////////////////////////////////////////////////////////////
 /// Read scattered data chunks in one operation
 ///
+/// The chunks are split in vector reads respecting the server limits, up to
+/// NetXNG.ReadvMaxInFlight (default 8) of which are in flight at any time.
+///
 /// param buffer:   a pointer to a buffer big enough to hold all of the
 ///                 requested data
 /// param position: position[i] is the seek position of chunk i of len
@@ -469,19 +513,13 @@ Bool_t TNetXNGFile::ReadBuffer(char *buffer, Long64_t position, Int_t length)
 Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
       Int_t nbuffs)
 {
-   using namespace XrdCl;
-
    // Check the file isn't a zombie or closed
    if (!IsUseable())
       return kTRUE;
 
-   std::vector<ChunkList>      chunkLists;
-   ChunkList                   chunks;
-   std::vector<XRootDStatus*> *statuses;
-   TSemaphore                 *semaphore;
-   Int_t                       totalBytes = 0;
-   Long64_t                    offset     = 0;
-   char                       *cursor     = buffer;
+   Int_t totalBytes = 0;
+   for (Int_t i = 0; i < nbuffs; ++i)
+      totalBytes += length[i];
 
    Double_t start = 0;
    if (gPerfStats) start = TTimeStamp();
@@ -490,10 +528,46 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
       for (Int_t i = 0; i < nbuffs; i++)
          position[i] += fArchiveOffset;
 
+   Bool_t failure = fBlockCache ? ReadBuffersViaBlockCache(buffer, position, length, nbuffs)
+                                : ReadBuffersRemote(buffer, position, length, nbuffs);
+   if (failure)
+      return kTRUE;
+
+   // Bump the globals
+   fBytesRead  += totalBytes;
+   fgBytesRead += totalBytes;
+   fReadCalls  ++;
+   fgReadCalls ++;
+
+   if (gPerfStats) {
+      fOffset = position[0];
+      gPerfStats->FileReadEvent(this, totalBytes, start);
+   }
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the chunks of ReadBuffers() from the server, positions including the
+/// archive offset. Returns kTRUE in case of failure.
+
+Bool_t TNetXNGFile::ReadBuffersRemote(char *buffer, Long64_t *position, Int_t *length,
+      Int_t nbuffs)
+{
+   using namespace XrdCl;
+
+   std::vector<ChunkList>      chunkLists;
+   ChunkList                   chunks;
+   std::vector<XRootDStatus*> *statuses;
+   TSemaphore                 *semaphore;
+   Long64_t                    offset     = 0;
+   char                       *cursor     = buffer;
+
    // Build a list of chunks. Put the buffers in the ChunkInfo's
    for (Int_t i = 0; i < nbuffs; ++i) {
-      totalBytes += length[i];
-
       // If the length is bigger than max readv size, split into smaller chunks
       if (length[i] > fReadvIorMax) {
          Int_t nsplit = length[i] / fReadvIorMax;
@@ -531,65 +605,96 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
    if( !chunks.empty() )
       chunkLists.push_back(chunks);
 
+   // Read asynchronously, keeping up to fReadvMaxInFlight requests in flight: a new vector read is sent
+   // as soon as one completes, so that the round trips of the chunk lists overlap
    TAsyncReadvHandler *handler;
    XRootDStatus        status;
    semaphore = new TSemaphore(0);
-   statuses  = new std::vector<XRootDStatus*>(chunkLists.size());
-
-   // Read asynchronously but wait for all responses
-   std::vector<ChunkList>::iterator it;
-   for (it = chunkLists.begin(); it != chunkLists.end(); ++it)
-   {
-      handler = new TAsyncReadvHandler(statuses, it - chunkLists.begin(),
-                                       semaphore);
-      status = fFile->VectorRead(*it, 0, handler);
-
-      if (!status.IsOK()) {
-         Error("ReadBuffers", "%s", status.ToStr().c_str());
-         return kTRUE;
+   statuses  = new std::vector<XRootDStatus*>(chunkLists.size(), nullptr);
+
+   Int_t nLists   = chunkLists.size();
+   Int_t nSent    = 0;
+   Int_t nDone    = 0;
+   Bool_t failure = kFALSE;
+   while (nDone < nLists) {
+      while (!failure && nSent < nLists && nSent - nDone < fReadvMaxInFlight) {
+         handler = new TAsyncReadvHandler(statuses, nSent, semaphore);
+         status = fFile->VectorRead(chunkLists[nSent], 0, handler);
+         if (!status.IsOK()) {
+            Error("ReadBuffers", "%s", status.ToStr().c_str());
+            delete handler;
+            failure = kTRUE;
+            break;
+         }
+         ++nSent;
       }
-   }
-
-   // Wait for all responses
-   for (it = chunkLists.begin(); it != chunkLists.end(); ++it) {
+      // After a failure, only wait for the requests already sent
+      if (nDone == nSent)
+         break;
       semaphore->Wait();
+      ++nDone;
    }
 
    // Check for errors
-   for (it = chunkLists.begin(); it != chunkLists.end(); ++it) {
-      XRootDStatus *st = statuses->at(it - chunkLists.begin());
-
-      if (!st->IsOK()) {
+   for (Int_t i = 0; i < nSent; ++i) {
+      XRootDStatus *st = statuses->at(i);
+      if (!failure && !st->IsOK()) {
          Error("ReadBuffers", "%s", st->ToStr().c_str());
-         for( ; it != chunkLists.end(); ++it )
-         {
-            st = statuses->at( it - chunkLists.begin() );
-            delete st;
-         }
-         delete statuses;
-         delete semaphore;
-
-         return kTRUE;
+         failure = kTRUE;
       }
       delete st;
    }
+   delete statuses;
+   delete semaphore;
+   return failure;
+}
 
-   // Bump the globals
-   fBytesRead  += totalBytes;
-   fgBytesRead += totalBytes;
-   fReadCalls  ++;
-   fgReadCalls ++;
+////////////////////////////////////////////////////////////////////////////////
+/// Read the chunks of ReadBuffers() through the local block cache, fetching the
+/// missing blocks from the server. Returns kTRUE in case of failure.
 
-   if (gPerfStats) {
-      fOffset = position[0];
-      gPerfStats->FileReadEvent(this, totalBytes, start);
+Bool_t TNetXNGFile::ReadBuffersViaBlockCache(char *buffer, Long64_t *position, Int_t *length,
+      Int_t nbuffs)
+{
+   using RRequest = ROOT::Internal::RFileBlockCache::RRequest;
+
+   std::vector<RRequest> requests(nbuffs);
+   char *cursor = buffer;
+   for (Int_t i = 0; i < nbuffs; ++i) {
+      requests[i].fBuffer = cursor;
+      requests[i].fOffset = position[i];
+      requests[i].fSize = length[i];
+      cursor += length[i];
    }
 
-   if (gMonitoringWriter)
-      gMonitoringWriter->SendFileReadProgress(this);
+   // The blocks to fetch are consecutive in memory, as ReadBuffersRemote() expects
+   auto fetch = [this](RRequest *blocks, std::size_t nBlocks) {
+      std::vector<Long64_t> blockPositions(nBlocks);
+      std::vector<Int_t> blockLengths(nBlocks);
+      for (std::size_t i = 0; i < nBlocks; ++i) {
+         blockPositions[i] = blocks[i].fOffset;
+         blockLengths[i] = blocks[i].fSize;
+      }
+      if (ReadBuffersRemote(static_cast<char *>(blocks[0].fBuffer), blockPositions.data(), blockLengths.data(),
+                            nBlocks))
+         throw std::runtime_error("cannot read the missing blocks from the server");
+      for (std::size_t i = 0; i < nBlocks; ++i)
+         blocks[i].fOutBytes = blocks[i].fSize;
+   };
+
+   try {
+      fBlockCache->Read(requests.data(), requests.size(), fetch);
+   } catch (const std::exception &e) {
+      Error("ReadBuffers", "%s", e.what());
+      return kTRUE;
+   }
 
-   delete statuses;
-   delete semaphore;
+   for (Int_t i = 0; i < nbuffs; ++i) {
+      if (requests[i].fOutBytes != static_cast<std::size_t>(length[i])) {
+         Error("ReadBuffers", "error reading all requested bytes, got %zu of %d", requests[i].fOutBytes, length[i]);
+         return kTRUE;
+      }
+   }
    return kFALSE;
 }
 
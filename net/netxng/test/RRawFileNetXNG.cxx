@@ -3,6 +3,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -69,3 +70,27 @@ TEST(RRawFileNetXNG, ReadV)
    EXPECT_EQ('T', buffer[0]);
    EXPECT_EQ('s', buffer[1]);
 }
+
+TEST(RRawFileNetXNG, ReadVPipelined)
+{
+   RRawFile::ROptions options;
+   options.fBlockSize = 0;
+   auto f = std::make_unique<RRawFileNetXNG>("root://eospublic.cern.ch//eos/root-eos/testfiles/xrootd.test", options);
+   EXPECT_TRUE(f->HasPipelinedReadV());
+
+   // More requests than allowed in a single vector read, so that several of them are in flight
+   const auto nReq = 3 * f->GetReadVLimits().fMaxReqs + 1;
+   std::vector<char> buffer(nReq, 0);
+   std::vector<RRawFile::RIOVec> iovec(nReq);
+   for (std::size_t i = 0; i < nReq; ++i) {
+      iovec[i].fBuffer = &buffer[i];
+      iovec[i].fOffset = (i % 2 == 0) ? 0 : 43;
+      iovec[i].fSize = 1;
+   }
+   f->ReadV(iovec.data(), nReq);
+
+   for (std::size_t i = 0; i < nReq; ++i) {
+      EXPECT_EQ(1U, iovec[i].fOutBytes);
+      EXPECT_EQ((i % 2 == 0) ? 'T' : 's', buffer[i]);
+   }
+}
@@ -91,6 +91,7 @@ enum Computer {
    NegativeLogarithms,
    NormalizedPdf,
    Novosibirsk,
+   PiecewiseInterpolation,
    Poisson,
    Polynomial,
    Power,
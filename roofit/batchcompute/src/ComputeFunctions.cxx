@@ -705,6 +705,118 @@ __rooglobal__ void computeNovosibirsk(Batches &batches)
       batches.output[i] = fast_exp(batches.output[i]);
 }
 
+namespace {
+
+/// Change of the interpolated value in PiecewiseInterpolation due to one parameter with value `x`, for the
+/// interpolation code `Code`. This is RooFit::Detail::MathFuncs::flexibleInterpSingle() with a boundary of one, but
+/// the code is a template argument so that the loops over the events have no branches that depend on it.
+template <int Code>
+__roodevice__ inline double piecewiseInterpolation(double low, double high, double nominal, double x, double res)
+{
+   if (Code == 0) {
+      // piece-wise linear
+      return x > 0 ? x * (high - nominal) : x * (nominal - low);
+   } else if (Code == 1) {
+      // piece-wise log
+      return x >= 0 ? res * (std::pow(high / nominal, +x) - 1) : res * (std::pow(low / nominal, -x) - 1);
+   } else if (Code == 2 || Code == 3) {
+      // parabolic with linear extrapolation
+      const double a = 0.5 * (high + low) - nominal;
+      const double b = 0.5 * (high - low);
+      if (x > 1) {
+         return (2 * a + b) * (x - 1) + high - nominal;
+      } else if (x < -1) {
+         return -1 * (2 * a - b) * (x + 1) + low - nominal;
+      }
+      return a * x * x + b * x;
+   } else if (Code == 4) {
+      // 6th degree polynomial with linear extrapolation
+      if (x >= 1) {
+         return x * (high - nominal);
+      } else if (x <= -1) {
+         return x * (nominal - low);
+      }
+      const double S = 0.5 * (high - low);
+      const double A = 0.0625 * (high + low - 2 * nominal);
+      return x * (S + x * A * (15 + x * x * (-10 + x * x * 3)));
+   } else {
+      // 6th degree polynomial with exponential extrapolation
+      if (x >= 1) {
+         return res * (std::pow(high / nominal, +x) - 1);
+      } else if (x <= -1) {
+         return res * (std::pow(low / nominal, -x) - 1);
+      }
+      const double up = high / nominal;
+      const double down = low / nominal;
+      const double logUp = std::log(up);
+      const double logDown = std::log(down);
+      const double upLog = up <= 0.0 ? 0.0 : up * logUp;
+      const double downLog = down <= 0.0 ? 0.0 : -down * logDown;
+      const double upLog2 = up <= 0.0 ? 0.0 : upLog * logUp;
+      const double downLog2 = down <= 0.0 ? 0.0 : -downLog * logDown;
+
+      const double S0 = 0.5 * (up + down);
+      const double A0 = 0.5 * (up - down);
+      const double S1 = 0.5 * (upLog + downLog);
+      const double A1 = 0.5 * (upLog - downLog);
+      const double S2 = 0.5 * (upLog2 + downLog2);
+      const double A2 = 0.5 * (upLog2 - downLog2);
+
+      const double a = 1. / 8 * (15 * A0 - 7 * S1 + A2);
+      const double b = 1. / 8 * (-24 + 24 * S0 - 9 * A1 + S2);
+      const double c = 1. / 4 * (-5 * A0 + 5 * S1 - A2);
+      const double d = 1. / 4 * (12 - 12 * S0 + 7 * A1 - S2);
+      const double e = 1. / 8 * (+3 * A0 - 3 * S1 + A2);
+      const double f = 1. / 8 * (-8 + 8 * S0 - 5 * A1 + S2);
+
+      return res * x * (a + x * (b + x * (c + x * (d + x * (e + x * f)))));
+   }
+}
+
+template <int Code>
+__roodevice__ void addPiecewiseInterpolation(Batches &batches, Batch nominal, Batch low, Batch high, double x)
+{
+   for (size_t i = BEGIN; i < batches.nEvents; i += STEP) {
+      batches.output[i] += piecewiseInterpolation<Code>(low[i], high[i], nominal[i], x, batches.output[i]);
+   }
+}
+
+} // namespace
+
+/// The arguments are the nominal values followed by the low and high variations for each parameter. The extra
+/// arguments are the number of parameters, whether to force the result to be positive, and the interpolation code and
+/// value of each parameter.
+__rooglobal__ void computePiecewiseInterpolation(Batches &batches)
+{
+   const int nParams = batches.extra[0];
+   const bool positiveDefinite = batches.extra[1];
+   Batch nominal = batches.args[0];
+
+   for (size_t i = BEGIN; i < batches.nEvents; i += STEP) {
+      batches.output[i] = nominal[i];
+   }
+
+   for (int k = 0; k < nParams; ++k) {
+      Batch low = batches.args[2 * k + 1];
+      Batch high = batches.args[2 * k + 2];
+      const double x = batches.extra[2 * k + 3];
+      switch (static_cast<int>(batches.extra[2 * k + 2])) {
+      case 0: addPiecewiseInterpolation<0>(batches, nominal, low, high, x); break;
+      case 1: addPiecewiseInterpolation<1>(batches, nominal, low, high, x); break;
+      case 2: addPiecewiseInterpolation<2>(batches, nominal, low, high, x); break;
+      case 3: addPiecewiseInterpolation<3>(batches, nominal, low, high, x); break;
+      case 4: addPiecewiseInterpolation<4>(batches, nominal, low, high, x); break;
+      default: addPiecewiseInterpolation<5>(batches, nominal, low, high, x); break;
+      }
+   }
+
+   if (positiveDefinite) {
+      for (size_t i = BEGIN; i < batches.nEvents; i += STEP) {
+         batches.output[i] = batches.output[i] < 0. ? 0. : batches.output[i];
+      }
+   }
+}
+
 __rooglobal__ void computePoisson(Batches &batches)
 {
    Batch x = batches.args[0];
@@ -946,6 +1058,7 @@ std::vector<void (*)(Batches &)> getFunctions()
            computeNegativeLogarithms,
            computeNormalizedPdf,
            computeNovosibirsk,
+           computePiecewiseInterpolation,
            computePoisson,
            computePolynomial,
            computePower,
@@ -101,6 +101,7 @@ protected:
 
   double evaluate() const override;
   void doEval(RooFit::EvalContext &) const override;
+  inline bool canComputeBatchWithCuda() const override { return true; }
 
   ClassDefOverride(PiecewiseInterpolation,4) // Sum of RooAbsReal objects
 };
@@ -20,6 +20,7 @@
 
 #include "RooStats/HistFactory/PiecewiseInterpolation.h"
 
+#include <RooBatchCompute.h>
 #include <RooFit/Detail/MathFuncs.h>
 
 #include "Riostream.h"
@@ -256,17 +257,16 @@ void PiecewiseInterpolation::translate(RooFit::Detail::CodeSquashContext &ctx) c
 /// \param[in] normSet Arguments to normalise over.
 void PiecewiseInterpolation::doEval(RooFit::EvalContext & ctx) const
 {
-  std::span<double> sum = ctx.output();
+  std::vector<std::span<const double>> vars;
+  std::vector<double> extraArgs;
+  vars.reserve(2 * _paramSet.size() + 1);
+  extraArgs.reserve(2 * _paramSet.size() + 2);
 
-  auto nominal = ctx.at(_nominal);
-  for(unsigned int j=0; j < nominal.size(); ++j) {
-    sum[j] = nominal[j];
-  }
+  vars.push_back(ctx.at(_nominal));
+  extraArgs.push_back(_paramSet.size());
+  extraArgs.push_back(_positiveDefinite);
 
   for (unsigned int i=0; i < _paramSet.size(); ++i) {
-    const double param = static_cast<RooAbsReal*>(_paramSet.at(i))->getVal();
-    auto low   = ctx.at(_lowSet.at(i));
-    auto high  = ctx.at(_highSet.at(i));
     const int icode = _interpCode[i];
 
     if (icode < 0 || icode > 5) {
@@ -275,18 +275,13 @@ void PiecewiseInterpolation::doEval(RooFit::EvalContext & ctx) const
       throw std::invalid_argument("PiecewiseInterpolation::doEval() got invalid interpolation code " + std::to_string(icode));
     }
 
-    for (unsigned int j=0; j < nominal.size(); ++j) {
-       using RooFit::Detail::MathFuncs::flexibleInterpSingle;
-       sum[j] += flexibleInterpSingle(icode, low[j], high[j], 1.0, nominal[j], param, sum[j]);
-    }
+    vars.push_back(ctx.at(_lowSet.at(i)));
+    vars.push_back(ctx.at(_highSet.at(i)));
+    extraArgs.push_back(icode);
+    extraArgs.push_back(static_cast<RooAbsReal*>(_paramSet.at(i))->getVal());
   }
 
-  if (_positiveDefinite) {
-    for(unsigned int j=0; j < nominal.size(); ++j) {
-      if (sum[j] < 0.)
-        sum[j] = 0.;
-    }
-  }
+  RooBatchCompute::compute(ctx.config(this), RooBatchCompute::PiecewiseInterpolation, ctx.output(), vars, extraArgs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,85 @@
+// Tests for the PiecewiseInterpolation
+// Authors: Jonas Rembser, CERN  10/2024
+
+#include <RooArgSet.h>
+#include <RooDataHist.h>
+#include <RooDataSet.h>
+#include <RooHistFunc.h>
+#include <RooRealVar.h>
+#include <RooStats/HistFactory/PiecewiseInterpolation.h>
+#include <RooFit/Detail/NormalizationHelpers.h>
+#include <RooFit/Evaluator.h>
+
+#include "RooFit/Detail/BatchModeDataHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stack>
+
+/// Validate the batched PiecewiseInterpolation against the scalar implementation for all interpolation codes, with
+/// parameter values inside and outside of the [-1, 1] interval where the codes use different formulae.
+TEST(PiecewiseInterpolation, BatchModeAllCodes)
+{
+   const int nBins = 10;
+   RooRealVar x{"x", "x", 0, nBins};
+   x.setBins(nBins);
+
+   RooDataHist nominalHist{"nominalHist", "nominalHist", x};
+   RooDataHist lowHist1{"lowHist1", "lowHist1", x};
+   RooDataHist highHist1{"highHist1", "highHist1", x};
+   RooDataHist lowHist2{"lowHist2", "lowHist2", x};
+   RooDataHist highHist2{"highHist2", "highHist2", x};
+   for (int i = 0; i < nBins; ++i) {
+      nominalHist.set(i, 10. + i, 0.);
+      lowHist1.set(i, 8. + 0.9 * i, 0.);
+      highHist1.set(i, 11. + 1.2 * i, 0.);
+      lowHist2.set(i, 9.5 + i, 0.);
+      highHist2.set(i, 10.2 + 1.1 * i, 0.);
+   }
+
+   RooHistFunc nominal{"nominal", "nominal", x, nominalHist};
+   RooHistFunc low1{"low1", "low1", x, lowHist1};
+   RooHistFunc high1{"high1", "high1", x, highHist1};
+   RooHistFunc low2{"low2", "low2", x, lowHist2};
+   RooHistFunc high2{"high2", "high2", x, highHist2};
+
+   RooRealVar alpha1{"alpha1", "alpha1", 0, -5, 5};
+   RooRealVar alpha2{"alpha2", "alpha2", 0, -5, 5};
+
+   PiecewiseInterpolation interp{"interp", "interp", nominal, {low1, low2}, {high1, high2}, {alpha1, alpha2}};
+
+   RooDataSet data{"data", "data", x};
+   for (int i = 0; i < nBins; ++i) {
+      x.setVal(i + 0.5);
+      data.add(x);
+   }
+
+   for (int code = 0; code <= 5; ++code) {
+      interp.setAllInterpCodes(code);
+      interp.setPositiveDefinite(code == 0);
+
+      std::unique_ptr<RooAbsReal> clone = RooFit::Detail::compileForNormSet<RooAbsReal>(interp, *data.get());
+      RooFit::Evaluator evaluator(*clone);
+      std::stack<std::vector<double>> vectorBuffers;
+      auto dataSpans =
+         RooFit::Detail::BatchModeDataHelpers::getDataSpans(data, "", nullptr, /*skipZeroWeights=*/true,
+                                                            /*takeGlobalObservablesFromData=*/false, vectorBuffers);
+      for (auto const &item : dataSpans) {
+         evaluator.setInput(item.first->GetName(), item.second, false);
+      }
+
+      for (double alpha1Val : {-1.7, -0.6, 0.0, 0.4, 2.3}) {
+         for (double alpha2Val : {-1.2, 0.8, 1.5}) {
+            alpha1.setVal(alpha1Val);
+            alpha2.setVal(alpha2Val);
+            std::span<const double> resultsBatch = evaluator.run();
+            for (int i = 0; i < nBins; ++i) {
+               x.setVal(i + 0.5);
+               EXPECT_NEAR(resultsBatch[i], interp.getVal(), 1e-10)
+                  << "code " << code << ", alpha1 = " << alpha1Val << ", alpha2 = " << alpha2Val << ", bin " << i;
+            }
+         }
+      }
+   }
+}
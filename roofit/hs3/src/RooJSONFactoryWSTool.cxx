@@ -32,7 +32,12 @@
 
 #include "RooFitImplHelpers.h"
 
+#include <RConfigure.h> // R__USE_IMT
 #include <TROOT.h>
+#ifdef R__USE_IMT
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <algorithm>
 #include <fstream>
@@ -513,6 +518,100 @@ void getObservables(RooWorkspace const &ws, const JSONNode &node, RooArgSet &out
    }
 }
 
+/**
+ * @brief The bin contents and errors of a binned dataset, decoded from their JSON sequences.
+ */
+struct BinnedValues {
+   JSONNode const *contentsNode = nullptr;
+   JSONNode const *errorsNode = nullptr;
+   std::vector<double> contents;
+   std::vector<double> errors;
+   bool decoded = false;
+};
+
+/**
+ * @brief Look up the sequences of bin contents and errors of a binned dataset.
+ *
+ * The lookup of the child nodes is not thread safe, so it is done before the values are decoded.
+ *
+ * @param n The JSONNode representing the binned data.
+ * @return BinnedValues The sequences to be decoded.
+ */
+BinnedValues findBinnedValues(const JSONNode &n)
+{
+   if (!n.has_child("contents"))
+      RooJSONFactoryWSTool::error("no contents given");
+
+   BinnedValues values;
+   values.contentsNode = &n["contents"];
+
+   if (!values.contentsNode->is_seq())
+      RooJSONFactoryWSTool::error("contents are not in list form");
+
+   if (n.has_child("errors")) {
+      values.errorsNode = &n["errors"];
+      if (!values.errorsNode->is_seq())
+         RooJSONFactoryWSTool::error("errors are not in list form");
+   }
+   return values;
+}
+
+void decodeBinnedValues(BinnedValues &values)
+{
+   values.contentsNode->read_seq_double(values.contents);
+   if (values.errorsNode)
+      values.errorsNode->read_seq_double(values.errors);
+   values.decoded = true;
+}
+
+/**
+ * @brief Decode the bin contents of several binned datasets.
+ *
+ * The datasets are independent, so with implicit multi-threading enabled they are decoded in parallel. This is the
+ * bulk of the work when importing binned data, while the creation of the datasets has to be serial.
+ *
+ * @param values The sequences to be decoded. Entries without contents are skipped.
+ * @return void
+ */
+void decodeBinnedValues(std::vector<BinnedValues> &values)
+{
+   auto decode = [&values](std::size_t i) {
+      if (values[i].contentsNode)
+         decodeBinnedValues(values[i]);
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && values.size() > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(decode, ROOT::TSeq<std::size_t>(values.size()));
+      return;
+   }
+#endif
+   for (std::size_t i = 0; i < values.size(); ++i) {
+      decode(i);
+   }
+}
+
+std::unique_ptr<RooDataHist> makeDataHist(const std::string &name, RooArgSet const &vars, BinnedValues const &values)
+{
+   auto bins = generateBinIndices(vars);
+   if (values.contents.size() != bins.size()) {
+      std::stringstream errMsg;
+      errMsg << "inconsistent bin numbers: contents=" << values.contents.size() << ", bins=" << bins.size();
+      RooJSONFactoryWSTool::error(errMsg.str());
+   }
+   if (values.errorsNode && values.errors.size() != bins.size()) {
+      std::stringstream errMsg;
+      errMsg << "inconsistent bin numbers: errors=" << values.errors.size() << ", bins=" << bins.size();
+      RooJSONFactoryWSTool::error(errMsg.str());
+   }
+   auto dh = std::make_unique<RooDataHist>(name, name, vars);
+   for (size_t ibin = 0; ibin < bins.size(); ++ibin) {
+      const double err = values.errorsNode ? values.errors[ibin] : -1;
+      dh->set(ibin, values.contents[ibin], err);
+   }
+   return dh;
+}
+
 /**
  * @brief Import data from the JSONNode into the workspace.
  *
@@ -521,10 +620,11 @@ void getObservables(RooWorkspace const &ws, const JSONNode &node, RooArgSet &out
  *
  * @param p The JSONNode representing the data to be imported.
  * @param workspace The RooWorkspace to which the data will be imported.
+ * @param binned The already decoded bin contents, if the data is binned and they were decoded beforehand.
  * @return std::unique_ptr<RooAbsData> A unique pointer to the RooAbsData object representing the imported data.
  *                                     The caller is responsible for managing the memory of the returned object.
  */
-std::unique_ptr<RooAbsData> loadData(const JSONNode &p, RooWorkspace &workspace)
+std::unique_ptr<RooAbsData> loadData(const JSONNode &p, RooWorkspace &workspace, BinnedValues const *binned = nullptr)
 {
    std::string name(RooJSONFactoryWSTool::name(p));
 
@@ -537,6 +637,8 @@ std::unique_ptr<RooAbsData> loadData(const JSONNode &p, RooWorkspace &workspace)
    std::string const &type = p["type"].val();
    if (type == "binned") {
       // binned
+      if (binned && binned->decoded)
+         return makeDataHist(name, RooJSONFactoryWSTool::readAxes(p), *binned);
       return RooJSONFactoryWSTool::readBinnedData(p, name, RooJSONFactoryWSTool::readAxes(p));
    } else if (type == "unbinned") {
       // unbinned
@@ -1330,16 +1432,7 @@ void RooJSONFactoryWSTool::exportHisto(RooArgSet const &vars, std::size_t n, dou
  */
 void RooJSONFactoryWSTool::exportArray(std::size_t n, double const *contents, JSONNode &output)
 {
-   output.set_seq();
-   for (std::size_t i = 0; i < n; ++i) {
-      double w = contents[i];
-      // To make sure there are no unnecessary floating points in the JSON
-      if (int(w) == w) {
-         output.append_child() << int(w);
-      } else {
-         output.append_child() << w;
-      }
-   }
+   output.fill_seq_double(contents, n);
 }
 
 /**
@@ -1597,45 +1690,9 @@ RooArgSet RooJSONFactoryWSTool::readAxes(const JSONNode &topNode)
 std::unique_ptr<RooDataHist>
 RooJSONFactoryWSTool::readBinnedData(const JSONNode &n, const std::string &name, RooArgSet const &vars)
 {
-   if (!n.has_child("contents"))
-      RooJSONFactoryWSTool::error("no contents given");
-
-   JSONNode const &contents = n["contents"];
-
-   if (!contents.is_seq())
-      RooJSONFactoryWSTool::error("contents are not in list form");
-
-   JSONNode const *errors = nullptr;
-   if (n.has_child("errors")) {
-      errors = &n["errors"];
-      if (!errors->is_seq())
-         RooJSONFactoryWSTool::error("errors are not in list form");
-   }
-
-   auto bins = generateBinIndices(vars);
-   if (contents.num_children() != bins.size()) {
-      std::stringstream errMsg;
-      errMsg << "inconsistent bin numbers: contents=" << contents.num_children() << ", bins=" << bins.size();
-      RooJSONFactoryWSTool::error(errMsg.str());
-   }
-   auto dh = std::make_unique<RooDataHist>(name, name, vars);
-   std::vector<double> contentVals;
-   contentVals.reserve(contents.num_children());
-   for (auto const &cont : contents.children()) {
-      contentVals.push_back(cont.val_double());
-   }
-   std::vector<double> errorVals;
-   if (errors) {
-      errorVals.reserve(errors->num_children());
-      for (auto const &err : errors->children()) {
-         errorVals.push_back(err.val_double());
-      }
-   }
-   for (size_t ibin = 0; ibin < bins.size(); ++ibin) {
-      const double err = errors ? errorVals[ibin] : -1;
-      dh->set(ibin, contentVals[ibin], err);
-   }
-   return dh;
+   BinnedValues values = findBinnedValues(n);
+   decodeBinnedValues(values);
+   return makeDataHist(name, vars, values);
 }
 
 /**
@@ -2154,8 +2211,17 @@ void RooJSONFactoryWSTool::importAllNodes(const JSONNode &n)
    // don't get imported.
    std::vector<std::unique_ptr<RooAbsData>> datasets;
    if (auto dataNode = n.find("data")) {
-      for (const auto &p : dataNode->children()) {
-         datasets.push_back(loadData(p, _workspace));
+      // The bin contents of the binned datasets are decoded upfront, in parallel if possible
+      std::vector<BinnedValues> binned(dataNode->num_children());
+      for (std::size_t i = 0; i < binned.size(); ++i) {
+         JSONNode const &p = dataNode->child(i);
+         if (p.has_child("type") && p["type"].val() == "binned")
+            binned[i] = findBinnedValues(p);
+      }
+      decodeBinnedValues(binned);
+      for (std::size_t i = 0; i < binned.size(); ++i) {
+         datasets.push_back(loadData(dataNode->child(i), _workspace, &binned[i]));
+         binned[i] = BinnedValues{};
       }
    }
 
@@ -8,6 +8,7 @@
 #include <RooAddPdf.h>
 #include <RooCategory.h>
 #include <RooConstVar.h>
+#include <RooDataHist.h>
 #include <RooExponential.h>
 #include <RooGenericPdf.h>
 #include <RooGaussian.h>
@@ -404,3 +405,47 @@ TEST(RooFitHS3, SimultaneousGaussians)
    int status = validate(simPdf);
    EXPECT_EQ(status, 0);
 }
+
+TEST(RooFitHS3, BinnedData)
+{
+   // Several independent binned datasets, whose bin contents are decoded before
+   // the datasets are created
+   const std::string jsonString = R"({
+   "metadata": {"hs3_version": "0.2"},
+   "data": [
+      {"name": "dataA", "type": "binned", "axes": [{"name": "x", "min": 0, "max": 3, "nbins": 3}],
+       "contents": [1, 2.5, 3]},
+      {"name": "dataB", "type": "binned", "axes": [{"name": "y", "min": 0, "max": 2, "nbins": 2}],
+       "contents": [4, 0.5], "errors": [2, 0.25]}
+   ]
+})";
+
+   RooWorkspace ws;
+   RooJSONFactoryWSTool{ws}.importJSONfromString(jsonString);
+
+   auto *dataA = dynamic_cast<RooDataHist *>(ws.data("dataA"));
+   auto *dataB = dynamic_cast<RooDataHist *>(ws.data("dataB"));
+   ASSERT_NE(dataA, nullptr);
+   ASSERT_NE(dataB, nullptr);
+   EXPECT_EQ(dataA->numEntries(), 3);
+   EXPECT_DOUBLE_EQ(dataA->weight(1), 2.5);
+   EXPECT_DOUBLE_EQ(dataA->sumEntries(), 6.5);
+   EXPECT_DOUBLE_EQ(dataB->weight(0), 4.);
+   dataB->get(0);
+   EXPECT_DOUBLE_EQ(dataB->weightError(RooAbsData::SumW2), 2.);
+
+   // Integral contents are written without floating points
+   const std::string json = RooJSONFactoryWSTool{ws}.exportJSONtoString();
+   EXPECT_NE(json.find("[1,2.5,3]"), std::string::npos) << json;
+
+   const std::string inconsistent = R"({
+   "metadata": {"hs3_version": "0.2"},
+   "data": [
+      {"name": "dataC", "type": "binned", "axes": [{"name": "z", "min": 0, "max": 2, "nbins": 2}],
+       "contents": [1, 2], "errors": [1]}
+   ]
+})";
+   RooWorkspace ws2;
+   RooHelpers::HijackMessageStream hijack(RooFit::ERROR, RooFit::IO);
+   EXPECT_THROW(RooJSONFactoryWSTool{ws2}.importJSONfromString(inconsistent), std::exception);
+}
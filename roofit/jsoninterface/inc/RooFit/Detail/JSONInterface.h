@@ -13,6 +13,7 @@
 #ifndef RooFit_Detail_JSONInterface_h
 #define RooFit_Detail_JSONInterface_h
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -152,6 +153,15 @@ public:
       }
    }
 
+   // Bulk access to sequences of numbers. Unlike filling or iterating the children one by one, the backends can
+   // implement these without creating a node for each value, which matters for the large arrays of binned data.
+
+   /// Fill the node with a sequence of n numbers. Integral values are written as integers.
+   virtual void fill_seq_double(double const *values, std::size_t n);
+   /// Read a sequence of numbers, replacing the content of the vector. With the nlohmann-json backend, this
+   /// doesn't modify the tree and can be called concurrently on different nodes.
+   virtual void read_seq_double(std::vector<double> &values) const;
+
    template <typename Matrix>
    void fill_mat(Matrix const &mat)
    {
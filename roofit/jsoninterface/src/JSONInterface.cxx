@@ -17,6 +17,8 @@
 #include "RYMLParser.h"
 #endif
 
+#include <cmath>
+#include <limits>
 #include <sstream>
 
 namespace {
@@ -43,6 +45,11 @@ private:
    Node_t &node;
    size_t pos;
 };
+
+bool isIntegral(double val)
+{
+   return std::abs(val) <= std::numeric_limits<int>::max() && int(val) == val;
+}
 } // namespace
 
 namespace RooFit {
@@ -62,6 +69,32 @@ JSONNode::const_children_view JSONNode::children() const
            const_child_iterator(std::make_unique<::ChildItImpl<const JSONNode>>(*this, this->num_children()))};
 }
 
+void JSONNode::fill_seq_double(double const *values, std::size_t n)
+{
+   set_seq();
+   for (std::size_t i = 0; i < n; ++i) {
+      const double w = values[i];
+      // To make sure there are no unnecessary floating points in the JSON
+      if (isIntegral(w)) {
+         append_child() << int(w);
+      } else {
+         append_child() << w;
+      }
+   }
+}
+
+void JSONNode::read_seq_double(std::vector<double> &values) const
+{
+   if (!is_seq()) {
+      throw std::runtime_error("node " + key() + " is not of sequence type!");
+   }
+   values.clear();
+   values.reserve(num_children());
+   for (auto const &child : children()) {
+      values.push_back(child.val_double());
+   }
+}
+
 std::ostream &operator<<(std::ostream &os, JSONNode const &s)
 {
    s.writeJSON(os);
@@ -12,6 +12,8 @@
 
 #include "JSONParser.h"
 
+#include <cmath>
+#include <limits>
 #include <sstream>
 
 #include <nlohmann/json.hpp>
@@ -313,6 +315,36 @@ const TJSONTree::Node &TJSONTree::Node::child(size_t pos) const
    return Impl::mkNode(tree, "", node->get().at(pos));
 }
 
+void TJSONTree::Node::fill_seq_double(double const *values, std::size_t n)
+{
+   // Filled directly, without going through one cached child node per value
+   nlohmann::json::array_t arr;
+   arr.reserve(n);
+   for (std::size_t i = 0; i < n; ++i) {
+      const double w = values[i];
+      // To make sure there are no unnecessary floating points in the JSON
+      if (std::abs(w) <= std::numeric_limits<int>::max() && int(w) == w) {
+         arr.emplace_back(int(w));
+      } else {
+         arr.emplace_back(w);
+      }
+   }
+   node->get() = std::move(arr);
+}
+
+void TJSONTree::Node::read_seq_double(std::vector<double> &values) const
+{
+   auto const &nd = node->get();
+   if (!nd.is_array()) {
+      throw std::runtime_error("node \"" + node->key() + "\" is not of sequence type!");
+   }
+   values.clear();
+   values.reserve(nd.size());
+   for (auto const &elem : nd) {
+      values.push_back(elem.get<double>());
+   }
+}
+
 using json_iterator = nlohmann::basic_json<>::iterator;
 using const_json_iterator = nlohmann::basic_json<>::const_iterator;
 
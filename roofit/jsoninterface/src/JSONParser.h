@@ -68,6 +68,8 @@ public:
       size_t num_children() const override;
       Node &child(size_t pos) override;
       const Node &child(size_t pos) const override;
+      void fill_seq_double(double const *values, std::size_t n) override;
+      void read_seq_double(std::vector<double> &values) const override;
 
       children_view children() override;
       const_children_view children() const override;
@@ -29,6 +29,10 @@ public:
    static void setTimingAnalysis(bool timingAnalysis);
    static bool getTimingAnalysis();
 
+   enum class Backend { Processes, Threads };
+   static bool setBackend(Backend backend);
+   static Backend getBackend();
+
    struct LikelihoodJob {
       // magic values to indicate that the number of tasks will be set automatically
       constexpr static std::size_t automaticNEventTasks = 0;
@@ -50,6 +54,7 @@ public:
 private:
    static unsigned int defaultNWorkers_;
    static bool timingAnalysis_;
+   static Backend backend_;
 };
 
 } // namespace MultiProcess
@@ -31,6 +31,7 @@ public:
 
    virtual void evaluate_task(std::size_t task) = 0;
    virtual void update_state();
+   virtual bool is_thread_safe() const;
 
    virtual void send_back_task_result_from_worker(std::size_t task) = 0;
    virtual bool receive_task_result_on_master(const zmq::message_t &message) = 0;
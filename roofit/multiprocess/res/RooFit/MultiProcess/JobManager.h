@@ -47,13 +47,20 @@ public:
    void activate();
    bool is_activated() const;
 
+   bool uses_threads() const;
+   bool is_master() const;
+
 private:
    explicit JobManager(std::size_t N_workers);
 
+   void run_tasks_in_threads();
+
    std::unique_ptr<ProcessManager> process_manager_ptr_;
    std::unique_ptr<Messenger> messenger_ptr_;
    std::unique_ptr<Queue> queue_ptr_;
    bool activated_ = false;
+   bool uses_threads_ = false;
+   std::size_t N_workers_;
 
    static std::map<std::size_t, Job *> job_objects_;
    static std::size_t job_counter_;
@@ -62,6 +62,17 @@ namespace MultiProcess {
  * can be set using either setTaskPriorities or suggestTaskOrder. If no priorities
  * are set, the Priority queue simply assumes equal priority for all tasks. The
  * resulting order then depends on the implementation of std::priority_queue.
+ *
+ * Finally, the backend that runs the tasks can be chosen with setBackend. The
+ * default, Backend::Processes, forks worker processes and a queue process that
+ * communicate with the master over ZeroMQ. With Backend::Threads, no processes are
+ * forked: the master runs the queued tasks on a ROOT::TThreadExecutor, which
+ * uses the implicit multi-threading pool if it is enabled (see
+ * ROOT::EnableImplicitMT), sharing its memory with the worker threads. This avoids the cost of sending state and results over sockets,
+ * which dominates when tasks are short, but it can only be used for Jobs that
+ * declare that their tasks can be evaluated concurrently (see
+ * Job::is_thread_safe). Like the queue type, the backend cannot be changed after
+ * the JobManager has been instantiated.
  */
 
 void Config::setDefaultNWorkers(unsigned int N_workers)
@@ -77,7 +88,8 @@ void Config::setDefaultNWorkers(unsigned int N_workers)
 
 void Config::setTimingAnalysis(bool timingAnalysis)
 {
-   if (JobManager::is_instantiated() && JobManager::instance()->process_manager().is_initialized()) {
+   if (JobManager::is_instantiated() && !JobManager::instance()->uses_threads() &&
+       JobManager::instance()->process_manager().is_initialized()) {
       printf("Warning: Config::setTimingAnalysis cannot set logging of timings, forking has already taken place!\n");
    } else {
       timingAnalysis_ = timingAnalysis;
@@ -94,6 +106,21 @@ unsigned int Config::getDefaultNWorkers()
    return defaultNWorkers_;
 }
 
+bool Config::setBackend(Backend backend)
+{
+   if (JobManager::is_instantiated()) {
+      printf("Warning: cannot set RooFit::MultiProcess backend after JobManager has been instantiated!\n");
+      return false;
+   }
+   backend_ = backend;
+   return true;
+}
+
+Config::Backend Config::getBackend()
+{
+   return backend_;
+}
+
 bool Config::Queue::setQueueType(QueueType queueType)
 {
    if (JobManager::is_instantiated()) {
@@ -148,6 +175,7 @@ std::size_t Config::LikelihoodJob::defaultNEventTasks = Config::LikelihoodJob::a
 std::size_t Config::LikelihoodJob::defaultNComponentTasks = Config::LikelihoodJob::automaticNComponentTasks;
 Config::Queue::QueueType Config::Queue::queueType_ = Config::Queue::QueueType::FIFO;
 bool Config::timingAnalysis_ = false;
+Config::Backend Config::backend_ = Config::Backend::Processes;
 
 } // namespace MultiProcess
 } // namespace RooFit
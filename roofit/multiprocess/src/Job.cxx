@@ -88,6 +88,18 @@ namespace MultiProcess {
  * Job::get_manager(). This function starts the worker_loop on the worker when
  * first called, meaning that the workers will not be running before they
  * are needed.
+ *
+ * ## Threads backend
+ *
+ * With Config::Backend::Threads, there are no worker processes: the tasks are
+ * evaluated by threads of the master process, which share its memory. No state
+ * has to be sent to the workers and no results have to be sent back, so
+ * update_state, send_back_task_result_from_worker and
+ * receive_task_result_on_master are not called. Instead, evaluate_task must
+ * store the result of a task directly in memory that belongs to that task, e.g.
+ * an element of a result vector, and gather_worker_results returns once all
+ * queued tasks have been evaluated. Because tasks are evaluated concurrently,
+ * this backend is only available for Jobs that override is_thread_safe().
  */
 
 Job::Job() : id_(JobManager::add_job_object(this)) {}
@@ -137,6 +149,16 @@ void Job::gather_worker_results()
 /// \note Implementers: make sure to also update the state_id_ member.
 void Job::update_state() {}
 
+/// \brief Whether evaluate_task can be called concurrently for different tasks
+///
+/// Jobs that return true can be used with Config::Backend::Threads. Their
+/// evaluate_task must then only read state that does not change while tasks
+/// are running and only write to memory that belongs to the task at hand.
+bool Job::is_thread_safe() const
+{
+   return false;
+}
+
 /// Get the current state identifier
 std::size_t Job::get_state_id()
 {
@@ -22,6 +22,16 @@
 #include "RooFit/MultiProcess/util.h"
 #include "RooFit/MultiProcess/Config.h"
 
+#include "RConfigure.h" // R__USE_IMT
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <utility>
+#include <vector>
+
 namespace RooFit {
 namespace MultiProcess {
 
@@ -43,6 +53,14 @@ namespace MultiProcess {
  * The default number of processes is set using 'std::thread::hardware_concurrency()'.
  * To change it, use 'Config::setDefaultNWorkers()' to set it to a different value
  * before creation of a new JobManager instance.
+ *
+ * With 'Config::Backend::Threads', no processes are forked and there is no
+ * messenger: 'retrieve()' takes the queued tasks and evaluates them on up to
+ * the default number of worker threads of a ROOT::TThreadExecutor, which shares
+ * the implicit multi-threading pool if it is enabled. The worker threads take
+ * their tasks from a list that is filled before they start, so neither locks
+ * nor messages to a queue process are involved. Only Jobs for which
+ * 'Job::is_thread_safe()' returns true can be run this way.
  */
 
 // static function
@@ -50,9 +68,11 @@ JobManager *JobManager::instance()
 {
    if (!JobManager::is_instantiated()) {
       instance_.reset(new JobManager(Config::getDefaultNWorkers())); // can't use make_unique, because ctor is private
-      instance_->messenger().test_connections(instance_->process_manager());
-      // set send to non blocking on all processes after checking the connections are working:
-      instance_->messenger().set_send_flag(zmq::send_flags::dontwait);
+      if (!instance_->uses_threads()) {
+         instance_->messenger().test_connections(instance_->process_manager());
+         // set send to non blocking on all processes after checking the connections are working:
+         instance_->messenger().set_send_flag(zmq::send_flags::dontwait);
+      }
    }
    return instance_.get();
 }
@@ -67,6 +87,7 @@ bool JobManager::is_instantiated()
 /// Don't construct JobManager objects manually, use the static instance if
 /// you need to run multiple jobs.
 JobManager::JobManager(std::size_t N_workers)
+   : uses_threads_(Config::getBackend() == Config::Backend::Threads), N_workers_(N_workers)
 {
    switch (Config::Queue::getQueueType()) {
    case Config::Queue::QueueType::FIFO: {
@@ -78,8 +99,10 @@ JobManager::JobManager(std::size_t N_workers)
       break;
    }
    }
-   process_manager_ptr_ = std::make_unique<ProcessManager>(N_workers);
-   messenger_ptr_ = std::make_unique<Messenger>(*process_manager_ptr_);
+   if (!uses_threads_) {
+      process_manager_ptr_ = std::make_unique<ProcessManager>(N_workers);
+      messenger_ptr_ = std::make_unique<Messenger>(*process_manager_ptr_);
+   }
 }
 
 JobManager::~JobManager()
@@ -111,7 +134,7 @@ JobManager::~JobManager()
 /// \return job_id for added job_object
 std::size_t JobManager::add_job_object(Job *job_object)
 {
-   if (JobManager::is_instantiated()) {
+   if (JobManager::is_instantiated() && !instance_->uses_threads()) {
       if (instance_->process_manager().is_initialized()) {
          std::stringstream ss;
          ss << "Cannot add Job to JobManager instantiation, forking has already taken place! Instance object at raw "
@@ -145,11 +168,19 @@ bool JobManager::remove_job_object(std::size_t job_object_id)
 
 ProcessManager &JobManager::process_manager() const
 {
+   if (uses_threads_) {
+      throw std::logic_error("in JobManager::process_manager: there are no worker processes with the Threads backend, "
+                             "see Config::setBackend");
+   }
    return *process_manager_ptr_;
 }
 
 Messenger &JobManager::messenger() const
 {
+   if (uses_threads_) {
+      throw std::logic_error(
+         "in JobManager::messenger: there is no messenger with the Threads backend, see Config::setBackend");
+   }
    return *messenger_ptr_;
 }
 
@@ -163,6 +194,11 @@ Queue *JobManager::queue() const
 /// \param requesting_job_id ID number of the Job in the JobManager's Job list
 void JobManager::retrieve(std::size_t requesting_job_id)
 {
+   if (uses_threads_) {
+      run_tasks_in_threads();
+      return;
+   }
+
    if (process_manager().is_master()) {
       bool job_fully_retrieved = false;
       while (not job_fully_retrieved) {
@@ -215,6 +251,10 @@ void JobManager::activate()
 {
    activated_ = true;
 
+   if (uses_threads_) {
+      return;
+   }
+
    if (process_manager().is_queue()) {
       queue()->loop();
       std::_Exit(0);
@@ -231,6 +271,50 @@ bool JobManager::is_activated() const
    return activated_;
 }
 
+/// Whether tasks are run by threads of this process instead of by forked worker processes, see Config::setBackend.
+bool JobManager::uses_threads() const
+{
+   return uses_threads_;
+}
+
+/// Whether this is the process that queues tasks and collects their results. This is always the case with the
+/// Threads backend, where there are no other processes.
+bool JobManager::is_master() const
+{
+   return uses_threads_ || process_manager().is_master();
+}
+
+/// \brief Evaluate all queued tasks on worker threads (Threads backend)
+///
+/// Only the calling thread touches the queue: it moves the tasks into a list,
+/// which the worker threads then only read. Results are written by the Jobs
+/// themselves in evaluate_task, so nothing has to be sent back.
+void JobManager::run_tasks_in_threads()
+{
+   std::vector<std::pair<Job *, std::size_t>> tasks;
+   JobTask job_task;
+   while (queue()->pop(job_task)) {
+      Job *job = get_job_object(job_task.job_id);
+      if (!job->is_thread_safe()) {
+         throw std::logic_error("in JobManager::run_tasks_in_threads: Job " + std::to_string(job_task.job_id) +
+                                " is not thread safe and cannot be run with the Threads backend");
+      }
+      tasks.emplace_back(job, job_task.task_id);
+   }
+
+   auto evaluate = [&tasks](std::size_t i) { tasks[i].first->evaluate_task(tasks[i].second); };
+#ifdef R__USE_IMT
+   if (N_workers_ > 1 && tasks.size() > 1) {
+      ROOT::TThreadExecutor pool(N_workers_);
+      pool.Foreach(evaluate, ROOT::TSeq<std::size_t>(tasks.size()));
+      return;
+   }
+#endif
+   for (std::size_t i = 0; i < tasks.size(); ++i) {
+      evaluate(i);
+   }
+}
+
 // initialize static members
 std::map<std::size_t, Job *> JobManager::job_objects_;
 std::size_t JobManager::job_counter_ = 0;
@@ -255,4 +255,64 @@ TEST_P(TestMPJob, singleJobUpdateState)
    EXPECT_EQ(Hex(y_parallel_after_change[3]), Hex(y_expected[3]));
 }
 
+
+// With the Threads backend, tasks write their results directly into the shared result vector.
+class xSquaredPlusBVectorThreaded : public RooFit::MultiProcess::Job {
+public:
+   explicit xSquaredPlusBVectorThreaded(xSquaredPlusBVectorSerial *serial) : serial_(serial) {}
+
+   std::vector<double> get_result()
+   {
+      if (get_manager()->is_master()) {
+         for (std::size_t task_id = 0; task_id < serial_->x_.size(); ++task_id) {
+            get_manager()->queue()->add({id_, state_id_, task_id});
+         }
+         gather_worker_results();
+      }
+      return serial_->result_;
+   }
+
+   bool is_thread_safe() const override { return true; }
+
+   void send_back_task_result_from_worker(std::size_t /*task*/) override {}
+   bool receive_task_result_on_master(const zmq::message_t & /*message*/) override { return true; }
+
+private:
+   void evaluate_task(std::size_t task) override
+   {
+      serial_->result_[task] = std::pow(serial_->x_[task], 2) + serial_->b_;
+   }
+
+   xSquaredPlusBVectorSerial *serial_;
+};
+
+TEST_P(TestMPJob, threadsBackend)
+{
+   std::vector<double> x(1000);
+   for (std::size_t i = 0; i < x.size(); ++i) {
+      x[i] = 0.5 * i;
+   }
+   xSquaredPlusBVectorSerial x_sq_plus_b(3., x);
+   auto y_expected = x_sq_plus_b.get_result();
+
+   RooFit::MultiProcess::Config::setDefaultNWorkers(GetParam());
+   ASSERT_TRUE(RooFit::MultiProcess::Config::setBackend(RooFit::MultiProcess::Config::Backend::Threads));
+   {
+      std::fill(x_sq_plus_b.result_.begin(), x_sq_plus_b.result_.end(), 0.);
+      xSquaredPlusBVectorThreaded x_sq_plus_b_threaded(&x_sq_plus_b);
+      auto y_threaded = x_sq_plus_b_threaded.get_result();
+      EXPECT_TRUE(RooFit::MultiProcess::JobManager::instance()->uses_threads());
+      EXPECT_EQ(y_threaded, y_expected);
+
+      // state changes on the master are seen by the workers without any update_state call
+      x_sq_plus_b.b_ = 4.;
+      y_threaded = x_sq_plus_b_threaded.get_result();
+      for (std::size_t i = 0; i < x.size(); ++i) {
+         EXPECT_EQ(Hex(y_threaded[i]), Hex(y_expected[i] + 1));
+      }
+   }
+   // the JobManager is gone with the last Job, so the backend can be reset
+   EXPECT_TRUE(RooFit::MultiProcess::Config::setBackend(RooFit::MultiProcess::Config::Backend::Processes));
+}
+
 INSTANTIATE_TEST_SUITE_P(NumberOfWorkerProcesses, TestMPJob, ::testing::Values(1, 2, 3));
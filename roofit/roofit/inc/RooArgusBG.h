@@ -47,6 +47,7 @@ protected:
   double evaluate() const override ;
   void doEval(RooFit::EvalContext &) const override;
   inline bool canComputeBatchWithCuda() const override { return true; }
+  inline bool canComputeBatchInChunks() const override { return true; }
 
 
 //   void initGenerator();
@@ -44,6 +44,7 @@ protected:
    double evaluate() const override;
    void doEval(RooFit::EvalContext &) const override;
    inline bool canComputeBatchWithCuda() const override { return true; }
+   inline bool canComputeBatchInChunks() const override { return true; }
 
 private:
    ClassDefOverride(RooBifurGauss, 1) // Bifurcated Gaussian PDF
@@ -40,6 +40,7 @@ private:
   double evaluate() const override;
   void doEval(RooFit::EvalContext &) const override;
   inline bool canComputeBatchWithCuda() const override { return true; }
+  inline bool canComputeBatchInChunks() const override { return true; }
 
   ClassDefOverride(RooChiSquarePdf,1) // Chi Square distribution (eg. the PDF )
 };
@@ -43,6 +43,7 @@ protected:
    double evaluate() const override;
    void doEval(RooFit::EvalContext &) const override;
    inline bool canComputeBatchWithCuda() const override { return true; }
+   inline bool canComputeBatchInChunks() const override { return true; }
 
 private:
    ClassDefOverride(RooDstD0BG, 1) // D*-D0 mass difference background PDF
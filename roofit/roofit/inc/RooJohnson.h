@@ -57,6 +57,7 @@ private:
   double evaluate() const override;
   void doEval(RooFit::EvalContext &) const override;
   inline bool canComputeBatchWithCuda() const override { return true; }
+  inline bool canComputeBatchInChunks() const override { return true; }
 
   ClassDefOverride(RooJohnson,1)
 };
@@ -49,6 +49,7 @@ protected:
    // CUDA support
    void doEval(RooFit::EvalContext &) const override;
    inline bool canComputeBatchWithCuda() const override { return true; }
+   inline bool canComputeBatchInChunks() const override { return true; }
 
    /// Evaluation
    double evaluate() const override;
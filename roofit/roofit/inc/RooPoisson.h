@@ -59,6 +59,7 @@ protected:
   double evaluate() const override;
   void doEval(RooFit::EvalContext &) const override;
   inline bool canComputeBatchWithCuda() const override { return true; }
+  inline bool canComputeBatchInChunks() const override { return true; }
 
   ClassDefOverride(RooPoisson,3) // A Poisson PDF
 };
@@ -546,6 +546,10 @@ public:
   };
 
   virtual bool canComputeBatchWithCuda() const { return false; }
+  /// Whether doEval() can be called concurrently for different chunks of the events, which is the case for nodes
+  /// that compute their output element by element without modifying their own state. Used by the multi-threaded
+  /// CPU mode of the RooFit::Evaluator.
+  virtual bool canComputeBatchInChunks() const { return false; }
   virtual bool isReducerNode() const { return false; }
 
   virtual void applyWeightSquared(bool flag);
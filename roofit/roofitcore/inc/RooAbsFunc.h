@@ -40,6 +40,7 @@ public:
   }
 
   virtual double operator()(const double xvector[]) const = 0;
+  virtual void getValues(std::vector<std::span<const double>> const &coordinates, std::span<double> output) const;
   virtual double getMinLimit(UInt_t dimension) const = 0;
   virtual double getMaxLimit(UInt_t dimension) const = 0;
 
@@ -55,6 +55,7 @@ public:
   bool isBinnedDistribution(const RooArgSet& obs) const override  ;
 
   void doEval(RooFit::EvalContext &) const override;
+  inline bool canComputeBatchWithCuda() const override { return true; }
 
   void translate(RooFit::Detail::CodeSquashContext &ctx) const override;
 
@@ -74,12 +74,31 @@ protected:
 
   std::vector<double>  scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooDataHist& hist, const RooArgSet& slicePos, Int_t& N, Int_t& N2, Int_t& zeroBin, double shift) const ;
 
+  /// Sampling of one of the input p.d.f.s, which is kept to skip the sampling and its Fourier transform
+  /// when only the parameters of the other input p.d.f. changed.
+  struct InputSampling {
+    RooArgSet params;                ///< Parameters of the input p.d.f.
+    std::vector<double> paramValues; ///< Values of the parameters for the current sampling
+    std::vector<double> values;      ///< Sampled values, including the buffer zones
+    Int_t N = 0;
+    Int_t N2 = 0;
+    Int_t zeroBin = 0;
+    bool sliceDependent = false; ///< Whether the input depends on other cached observables than the convolution observable
+    bool valid = false;
+
+    bool isUpToDate() const;
+    void setUpToDate();
+  };
+
   class FFTCacheElem : public PdfCacheElem {
   public:
     FFTCacheElem(const RooFFTConvPdf& self, const RooArgSet* nset) ;
 
     RooArgList containedArgs(Action) override ;
 
+    InputSampling input1;
+    InputSampling input2;
+
     std::unique_ptr<TVirtualFFT> fftr2c1;
     std::unique_ptr<TVirtualFFT> fftr2c2;
     std::unique_ptr<TVirtualFFT> fftc2r;
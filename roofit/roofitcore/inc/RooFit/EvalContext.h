@@ -22,6 +22,7 @@
 
 #include <Math/Util.h>
 
+#include <functional>
 #include <map>
 #include <stdexcept>
 #include <sstream>
@@ -114,10 +115,15 @@ public:
    void setOutputWithOffset(RooAbsArg const *arg, ROOT::Math::KahanSum<double> val,
                             ROOT::Math::KahanSum<double> const &offset);
 
+   std::size_t nChunks(std::size_t nEvents) const;
+   void forEachChunk(std::size_t nEvents,
+                     std::function<void(std::size_t iChunk, std::size_t begin, std::size_t end)> const &func) const;
+
 private:
    friend class Evaluator;
 
    OffsetMode _offsetMode = OffsetMode::WithoutOffset;
+   std::size_t _chunkSize = 0; ///< Number of events per chunk in the multi-threaded CPU mode, zero if disabled
    std::span<double> _currentOutput;
    std::vector<std::span<const double>> _ctx;
    bool _enableVectorBuffers = false;
@@ -21,6 +21,7 @@
 
 #include <memory>
 #include <stack>
+#include <vector>
 
 class ChangeOperModeRAII;
 class RooAbsArg;
@@ -47,11 +48,16 @@ public:
 
 private:
    void processVariable(NodeInfo &nodeInfo);
+   void processNode(NodeInfo &nodeInfo);
    void setClientsDirty(NodeInfo &nodeInfo);
+   void findDependentNodes();
+   void runDependentNodes();
    std::span<const double> getValHeterogeneous();
    void markGPUNodes();
    void assignToGPU(NodeInfo &info);
    void computeCPUNode(const RooAbsArg *node, NodeInfo &info);
+   void deferChunkedNode(NodeInfo &info);
+   void computeChunkedNodes();
    void setOperMode(RooAbsArg *arg, RooAbsArg::OperMode opMode);
    void syncDataTokens();
    void updateOutputSizes();
@@ -61,9 +67,14 @@ private:
    const bool _useGPU = false;
    int _nEvaluations = 0;
    bool _needToUpdateOutputSizes = false;
+   bool _needFullGraphSweep = true; // whether nodes may be dirty for other reasons than a changed variable
    RooFit::EvalContext _evalContextCPU;
    RooFit::EvalContext _evalContextCUDA;
    std::vector<NodeInfo> _nodes; // the ordered computation graph
+   std::vector<NodeInfo *> _chunkedNodes; // nodes waiting to be evaluated chunk by chunk, in the multi-threaded mode
+   std::vector<NodeInfo *> _variables;
+   std::vector<std::size_t> _scheduledNodes; // indices of the nodes to visit in the current sparse evaluation
+   std::vector<bool> _isScheduled;
    std::stack<std::unique_ptr<ChangeOperModeRAII>> _changeOperModeRAIIs;
 };
 
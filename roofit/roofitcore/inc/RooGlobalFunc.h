@@ -180,6 +180,7 @@ RooCmdArg Import(TTree& tree) ;
 RooCmdArg ImportFromFile(const char* fname, const char* tname) ;
 RooCmdArg StoreError(const RooArgSet& aset) ;
 RooCmdArg StoreAsymError(const RooArgSet& aset) ;
+RooCmdArg StoreAsFloat(const RooArgSet& aset) ;
 RooCmdArg OwnLinked() ;
 
 /** @} */
@@ -85,6 +85,7 @@ protected:
   double calculate(const RooArgList& partIntList) const;
   double evaluate() const override;
   void doEval(RooFit::EvalContext &) const override;
+  inline bool canComputeBatchWithCuda() const override { return true; }
 
   const char* makeFPName(const char *pfx,const RooArgSet& terms) const ;
   ProdMap* groupProductTerms(const RooArgSet&) const;
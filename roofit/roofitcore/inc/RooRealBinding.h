@@ -27,6 +27,10 @@ class RooAbsRealLValue;
 class RooAbsReal;
 class RooArgSet;
 
+namespace RooFit {
+class Evaluator;
+}
+
 class RooRealBinding : public RooAbsFunc {
 public:
   RooRealBinding(const RooAbsReal& func, const RooArgSet &vars, const RooArgSet* nset=nullptr, bool clipInvalid=false, const TNamed* rangeName=nullptr);
@@ -34,6 +38,7 @@ public:
   ~RooRealBinding() override;
 
   double operator()(const double xvector[]) const override;
+  void getValues(std::vector<std::span<const double>> const &coordinates, std::span<double> output) const override;
   double getMinLimit(UInt_t dimension) const override;
   double getMaxLimit(UInt_t dimension) const override;
 
@@ -62,6 +67,9 @@ protected:
   mutable std::vector<double>    _compSave ; ///<!
   mutable double _funcSave ; ///<!
 
+  mutable std::unique_ptr<RooAbsReal> _compiledFunc; ///<! Function compiled for the RooFit::Evaluator in getValues()
+  mutable std::unique_ptr<RooFit::Evaluator> _evaluator; ///<!
+
   ClassDefOverride(RooRealBinding,0) // Function binding to RooAbsReal object
 };
 
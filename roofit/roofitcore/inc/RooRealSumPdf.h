@@ -36,6 +36,11 @@ public:
   bool checkObservables(const RooArgSet* nset) const override ;
 
   void doEval(RooFit::EvalContext &) const override;
+  /// The floor and the check of the last coefficient are only implemented on the CPU.
+  inline bool canComputeBatchWithCuda() const override
+  {
+    return _funcList.size() == _coefList.size() && !_doFloor && !_doFloorGlobal;
+  }
 
   bool forceAnalyticalInt(const RooAbsArg& arg) const override { return arg.isFundamental() ; }
   Int_t getAnalyticalIntegralWN(RooArgSet& allVars, RooArgSet& numVars, const RooArgSet* normSet, const char* rangeName=nullptr) const override ;
@@ -209,7 +209,7 @@ public:
     }
 
     RealVector(const RealVector& other, RooAbsReal* real=nullptr) :
-      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf) {
+      _vec(other._vec), _vecF(other._vecF), _asFloat(other._asFloat), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf) {
       if (other._tracker) {
         _tracker = new RooChangeTracker(Form("track_%s",_nativeReal->GetName()),"tracker",other._tracker->parameters()) ;
       } else {
@@ -226,6 +226,8 @@ public:
       _real = other._real;
       _buf = other._buf;
       _nativeBuf = other._nativeBuf;
+      _asFloat = other._asFloat;
+      _vecF = other._vecF;
       if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(double))) {
         std::vector<double> tmp;
         tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(double)));
@@ -269,35 +271,69 @@ public:
       return _tracker->hasChanged(true) ;
     }
 
+    /// Store the values in single precision from now on, halving the memory
+    /// needed for this column. The values that are already stored are converted.
+    void setStoreAsFloat() {
+      if (_asFloat) return;
+      _vecF.assign(_vec.begin(), _vec.end());
+      std::vector<double>().swap(_vec);
+      _asFloat = true;
+    }
+
+    bool storeAsFloat() const { return _asFloat; }
+
     void fill() {
+      if (_asFloat) {
+        _vecF.push_back(static_cast<float>(*_buf));
+        return;
+      }
       _vec.push_back(*_buf);
     }
 
     void write(Int_t i) {
-      assert(static_cast<std::size_t>(i) < _vec.size());
+      assert(static_cast<std::size_t>(i) < size());
+      if (_asFloat) {
+        _vecF[i] = static_cast<float>(*_buf);
+        return;
+      }
       _vec[i] = *_buf ;
     }
 
     void reset() {
       _vec.clear();
+      _vecF.clear();
     }
 
     inline void load(std::size_t idx) const {
-      assert(idx < _vec.size());
-      *_buf = *(_vec.begin() + idx) ;
+      assert(idx < size());
+      *_buf = _asFloat ? _vecF[idx] : *(_vec.begin() + idx) ;
       *_nativeBuf = *_buf ;
     }
 
     std::span<const double> getRange(std::size_t first, std::size_t last) const {
+      if (_asFloat) {
+        // Single-precision columns are converted on demand into a transient
+        // buffer, because the batched computations work on doubles.
+        first = std::min(first, _vecF.size());
+        last = std::min(last, _vecF.size());
+        _batchBuf.resize(_vecF.size());
+        std::copy(_vecF.begin() + first, _vecF.begin() + last, _batchBuf.begin() + first);
+        return std::span<const double>(_batchBuf.data() + first, last - first);
+      }
+
       auto beg = std::min(_vec.cbegin() + first, _vec.cend());
       auto end = std::min(_vec.cbegin() + last,  _vec.cend());
 
       return std::span<const double>(&*beg, std::distance(beg, end));
     }
 
-    std::size_t size() const { return _vec.size() ; }
+    std::size_t size() const { return _asFloat ? _vecF.size() : _vec.size() ; }
 
     void resize(Int_t newSize) {
+      if (_asFloat) {
+        _vecF.resize(newSize);
+        return;
+      }
       if (newSize < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(double))) {
         // do an expensive copy, if we save at least a factor 2 in size
         std::vector<double> tmp;
@@ -313,6 +349,10 @@ public:
     }
 
     void reserve(Int_t newSize) {
+      if (_asFloat) {
+        _vecF.reserve(newSize);
+        return;
+      }
       _vec.reserve(newSize);
     }
 
@@ -324,6 +364,8 @@ public:
 
   protected:
     std::vector<double> _vec;
+    std::vector<float> _vecF; ///< Values of the column if it is stored in single precision
+    bool _asFloat = false; ///< Whether the values are stored in single precision
 
   private:
     friend class RooVectorDataStore ;
@@ -333,7 +375,8 @@ public:
     double* _nativeBuf = nullptr; ///<!
     RooChangeTracker* _tracker = nullptr;
     RooArgSet* _nset = nullptr; ///<!
-    ClassDef(RealVector,1) // STL-vector-based Data Storage class
+    mutable std::vector<double> _batchBuf; ///<! Double-precision copy of a single-precision column for getRange()
+    ClassDef(RealVector,2) // STL-vector-based Data Storage class
   } ;
 
 
@@ -26,6 +26,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 class TClass ;
 class RooAbsPdf ;
@@ -52,6 +53,7 @@ public:
   ~RooWorkspace() override ;
 
   TObject *Clone(const char *newname="") const override;
+  std::unique_ptr<RooWorkspace> cloneSharingData(const char *newname=nullptr) const;
 
   bool importClassCode(const char* pat="*", bool doReplace=false) ;
   bool importClassCode(TClass* theClass, bool doReplace=false) ;
@@ -242,6 +244,9 @@ public:
 
 
  private:
+    RooWorkspace(const RooWorkspace& other, bool shareData) ;
+    void moveDataToSharedPool() const ;
+
     friend class RooAbsArg;
     friend class RooAbsPdf;
     friend class RooConstraintSum;
@@ -279,6 +284,9 @@ public:
     bool _openTrans = false; ///<! Is there a transaction open?
     RooArgSet _sandboxNodes; ///<! Sandbox for incoming objects in a transaction
 
+    using SharedData = std::vector<std::unique_ptr<TObject>>;
+    mutable std::shared_ptr<SharedData> _sharedData; ///<! Datasets shared with the clones from cloneSharingData()
+
     ClassDefOverride(RooWorkspace, 8) // Persistable project container for (composite) pdfs, functions, variables and datasets
 } ;
 
@@ -31,3 +31,21 @@ the getMinLimit() and getMaxLimit() methods.
 #include "RooAbsFunc.h"
 
 ClassImp(RooAbsFunc);
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function at many points. The `coordinates` hold one span per
+/// dimension, with either the value in this dimension for each point, or a
+/// single value common to all points. The default implementation evaluates
+/// the points one by one.
+
+void RooAbsFunc::getValues(std::vector<std::span<const double>> const &coordinates, std::span<double> output) const
+{
+  std::vector<double> xvector(coordinates.size());
+  for (std::size_t i = 0; i < output.size(); ++i) {
+    for (std::size_t iDim = 0; iDim < coordinates.size(); ++iDim) {
+      xvector[iDim] = coordinates[iDim].size() == 1 ? coordinates[iDim][0] : coordinates[iDim][i];
+    }
+    output[i] = (*this)(xvector.data());
+  }
+}
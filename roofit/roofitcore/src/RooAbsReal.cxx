@@ -100,6 +100,7 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <sstream>
 #include <sys/types.h>
 
@@ -3438,6 +3439,11 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  // Evaluation errors can be logged concurrently by nodes evaluated in the multi-threaded CPU mode of the
+  // RooFit::Evaluator, see RooAbsArg::canComputeBatchInChunks()
+  static std::mutex logEvalErrorMutex;
+  std::lock_guard<std::mutex> lock(logEvalErrorMutex);
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -269,6 +269,7 @@ std::unique_ptr<RooDataSet> makeDataSetFromDataHist(RooDataHist const &hist)
 ///     <td> Interpret the given variable as event weight rather than as observable
 /// <tr><td> StoreError(const RooArgSet&)     <td> Store symmetric error along with value for given subset of observables
 /// <tr><td> StoreAsymError(const RooArgSet&) <td> Store asymmetric error along with value for given subset of observables
+/// <tr><td> StoreAsFloat(const RooArgSet&)   <td> Store the values of the given subset of observables in single precision to save memory
 /// <tr><td> `GlobalObservables(const RooArgSet&)` <td> Define the set of global observables to be stored in this RooDataSet.
 ///                                                     A snapshot of the passed RooArgSet is stored, meaning the values wont't change unexpectedly.
 /// </table>
@@ -303,6 +304,7 @@ RooDataSet::RooDataSet(RooStringView name, RooStringView title, const RooArgSet&
   pc.defineObject("dummy2","LinkDataSliceMany",0) ;
   pc.defineSet("errorSet","StoreError",0) ;
   pc.defineSet("asymErrSet","StoreAsymError",0) ;
+  pc.defineSet("floatSet","StoreAsFloat",0) ;
   pc.defineSet("glObs","GlobalObservables",0,nullptr) ;
   pc.defineMutex("ImportTree","ImportData","ImportDataSlice","LinkDataSlice","ImportFromFile") ;
   pc.defineMutex("CutSpec","CutVar") ;
@@ -342,6 +344,7 @@ RooDataSet::RooDataSet(RooStringView name, RooStringView title, const RooArgSet&
   const RooLinkedList& lnkSliceData = pc.getObjectList("lnkSliceData") ;
   RooCategory* indexCat = static_cast<RooCategory*>(pc.getObject("indexCat")) ;
   RooArgSet* asymErrorSet = pc.getSet("asymErrSet") ;
+  RooArgSet* floatSet = pc.getSet("floatSet") ;
   const char* fname = pc.getString("fname") ;
   const char* tname = pc.getString("tname") ;
   Int_t ownLinked = pc.getInt("ownLinked") ;
@@ -452,6 +455,13 @@ RooDataSet::RooDataSet(RooStringView name, RooStringView title, const RooArgSet&
         arg->attachToStore(*_dstore) ;
       }
     }
+    if (floatSet) {
+      std::unique_ptr<RooArgSet> intFloatSet{_vars.selectCommon(*floatSet)};
+      intFloatSet->setAttribAll("StoreAsFloat") ;
+      for(RooAbsArg* arg : *intFloatSet) {
+        arg->attachToStore(*_dstore) ;
+      }
+    }
 
     appendToDir(this,true) ;
 
@@ -123,6 +123,7 @@
 #include "RooGlobalFunc.h"
 #include "RooConstVar.h"
 #include "RooUniformBinning.h"
+#include "RooAbsCategory.h"
 
 #include "TClass.h"
 #include "TComplex.h"
@@ -439,6 +440,52 @@ RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooAr
   // and set all nodes on both pdfs to operMode AlwaysDirty
   hist()->setDirtyProp(false) ;
   convObs->setOperMode(ADirty,true) ;
+
+  // Track the parameters of the inputs to know which of them changed when the cache is filled again
+  RooArgSet otherObs{*hist()->get()};
+  otherObs.remove(*convObs, true, true);
+  pdf1Clone->getParameters(hist()->get(), input1.params);
+  pdf2Clone->getParameters(hist()->get(), input2.params);
+  input1.sliceDependent = pdf1Clone->dependsOn(otherObs);
+  input2.sliceDependent = pdf2Clone->dependsOn(otherObs);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check whether the sampling is still valid for the current parameter
+/// values. Samplings of inputs that depend on other cached observables than
+/// the convolution observable are different for each slice and never reused.
+
+bool RooFFTConvPdf::InputSampling::isUpToDate() const
+{
+  if (!valid || sliceDependent) {
+    return false;
+  }
+  std::size_t i = 0;
+  for (RooAbsArg *param : params) {
+    auto *real = dynamic_cast<RooAbsReal *>(param);
+    auto *cat = dynamic_cast<RooAbsCategory *>(param);
+    const double value = real ? real->getVal() : (cat ? cat->getCurrentIndex() : 0.0);
+    if (value != paramValues[i++]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remember the parameter values for which the sampling was made.
+
+void RooFFTConvPdf::InputSampling::setUpToDate()
+{
+  paramValues.clear();
+  for (RooAbsArg *param : params) {
+    auto *real = dynamic_cast<RooAbsReal *>(param);
+    auto *cat = dynamic_cast<RooAbsCategory *>(param);
+    paramValues.push_back(real ? real->getVal() : (cat ? cat->getCurrentIndex() : 0.0));
+  }
+  valid = true;
 }
 
 
@@ -572,17 +619,32 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   //
   //
 
-  Int_t N;
-  Int_t N2;
-  Int_t binShift1;
-  Int_t binShift2;
+  // Only sample the inputs whose parameters changed since they were last
+  // sampled. Typically, only the parameters of the signal p.d.f. change
+  // during a fit, and the sampling of the resolution model and its Fourier
+  // transform can be reused.
+  RooRealVar &x = const_cast<RooRealVar &>(static_cast<RooRealVar const &>(_x.arg()));
+  auto updateSampling = [&](InputSampling &input, RooAbsPdf &pdf, double shift) {
+    if (input.isUpToDate()) {
+      return false;
+    }
+    input.values = scanPdf(x, pdf, cacheHist, slicePos, input.N, input.N2, input.zeroBin, shift);
+    input.setUpToDate();
+    return true;
+  };
 
   RooRealVar* histX = static_cast<RooRealVar*>(cacheHist.get()->find(_x.arg().GetName())) ;
   if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
-  std::vector<double> input1 = scanPdf(const_cast<RooRealVar &>(static_cast<RooRealVar const&>(_x.arg())),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) ;
-  std::vector<double> input2 = scanPdf(const_cast<RooRealVar &>(static_cast<RooRealVar const&>(_x.arg())),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) ;
+  const bool update1 = updateSampling(aux.input1, *aux.pdf1Clone, _shift1);
+  const bool update2 = updateSampling(aux.input2, *aux.pdf2Clone, _shift2);
   if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
 
+  const Int_t N = aux.input1.N;
+  Int_t N2 = aux.input1.N2;
+  const Int_t binShift1 = aux.input1.zeroBin;
+  std::vector<double> &input1 = aux.input1.values;
+  std::vector<double> &input2 = aux.input2.values;
+
 #ifndef ROOFIT_MATH_FFTW3
   // If ROOT was NOT built with the fftw3 interface, we try to include fftw3.h
   // with the interpreter and run the concolution in the interpreter.
@@ -607,13 +669,18 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
     }
   }
 
-  // Real->Complex FFT Transform on p.d.f. 1 sampling
-  aux.fftr2c1->SetPoints(input1.data());
-  aux.fftr2c1->Transform();
+  // Real->Complex FFT Transform on p.d.f. 1 sampling, unless the transform
+  // of the unchanged sampling is still there
+  if (update1) {
+    aux.fftr2c1->SetPoints(input1.data());
+    aux.fftr2c1->Transform();
+  }
 
   // Real->Complex FFT Transform on p.d.f 2 sampling
-  aux.fftr2c2->SetPoints(input2.data());
-  aux.fftr2c2->Transform();
+  if (update2) {
+    aux.fftr2c2->SetPoints(input2.data());
+    aux.fftr2c2->Transform();
+  }
 
   // Loop over first half +1 of complex output results, multiply
   // and set as input of reverse transform
@@ -16,6 +16,13 @@
 #include <RooBatchCompute.h>
 #include <RooRealVar.h>
 
+#include <RConfigure.h> // R__USE_IMT
+
+#ifdef R__USE_IMT
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
 #include <algorithm>
 #include <stdexcept>
 
@@ -111,4 +118,44 @@ void EvalContext::setOutputWithOffset(RooAbsArg const *arg, ROOT::Math::KahanSum
    const_cast<double *>(_ctx[arg->dataToken()].data())[0] = val.Sum();
 }
 
+/// \brief Returns the number of chunks that forEachChunk() splits `nEvents` events into.
+///
+/// This is one unless the multi-threaded CPU mode of the Evaluator is enabled and there are enough events to make
+/// at least two chunks.
+std::size_t EvalContext::nChunks(std::size_t nEvents) const
+{
+   if (_chunkSize == 0 || nEvents < 2 * _chunkSize)
+      return 1;
+   return nEvents / _chunkSize + (nEvents % _chunkSize > 0);
+}
+
+/// \brief Calls a function for each chunk of a range of events, in parallel in the multi-threaded CPU mode.
+///
+/// The events `[0, nEvents)` are split in nChunks() consecutive chunks, and `func(iChunk, begin, end)` is called
+/// for each of them. The calls happen concurrently on the threads of the implicit multi-threading pool if the
+/// Evaluator enabled the multi-threaded CPU mode, so `func` must only write to the memory of its own chunk.
+///
+/// \param nEvents The number of events.
+/// \param func The function to call for each chunk.
+void EvalContext::forEachChunk(
+   std::size_t nEvents, std::function<void(std::size_t iChunk, std::size_t begin, std::size_t end)> const &func) const
+{
+   const std::size_t n = nChunks(nEvents);
+   if (n == 1) {
+      func(0, 0, nEvents);
+      return;
+   }
+   auto task = [&](std::size_t iChunk) {
+      func(iChunk, iChunk * _chunkSize, std::min(nEvents, (iChunk + 1) * _chunkSize));
+   };
+#ifdef R__USE_IMT
+   ROOT::TThreadExecutor executor;
+   executor.Foreach(task, ROOT::TSeq<std::size_t>(n));
+#else
+   for (std::size_t iChunk = 0; iChunk < n; ++iChunk) {
+      task(iChunk);
+   }
+#endif
+}
+
 } // namespace RooFit
@@ -24,6 +24,21 @@ computations take place in the RooBatchCompute library and can be carried off
 by either the CPU or a CUDA-supporting GPU. The Evaluator class takes care
 of data transfers. An instance of this class is created every time
 RooAbsPdf::fitTo() is called and gets destroyed when the fitting ends.
+
+If implicit multi-threading is enabled with ROOT::EnableImplicitMT() when the
+Evaluator is created, the CPU evaluation is multi-threaded: the events are
+split in chunks that fit in the CPU caches, and consecutive nodes that support
+it (see RooAbsArg::canComputeBatchInChunks()) are evaluated chunk by chunk on
+the threads of the pool. Reducer nodes like the likelihood also sum the chunks
+in parallel, and combine the partial sums in a fixed order, so that the result
+does not depend on the number of threads.
+
+For each variable, the Evaluator precomputes the sorted list of nodes that
+depend on it. Apart from the first evaluation and the evaluations after the
+inputs or the offset mode changed, only the nodes depending on the variables
+whose values changed are visited. This keeps the evaluations in numerical
+gradients, where one parameter is changed at a time, cheap also for large
+graphs like combined likelihoods with many channels.
 **/
 
 #include <RooFit/Evaluator.h>
@@ -42,6 +57,9 @@ RooAbsPdf::fitTo() is called and gets destroyed when the fitting ends.
 #include "RooFit/Detail/BatchModeDataHelpers.h"
 #include "RooFitImplHelpers.h"
 
+#include <TROOT.h> // ROOT::IsImplicitMTEnabled()
+
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <numeric>
@@ -51,6 +69,10 @@ namespace RooFit {
 
 namespace {
 
+// Number of events per chunk in the multi-threaded CPU mode: the inputs and outputs of a few nodes for one chunk fit in
+// the L2 cache of a core.
+constexpr std::size_t nEventsPerChunk = 8192;
+
 // To avoid deleted move assignment.
 template <class T>
 void assignSpan(std::span<T> &to, std::span<T> const &from)
@@ -100,6 +122,18 @@ struct NodeInfo {
 
    bool computeInGPU() const { return (absArg->isReducerNode() || !isScalar()) && absArg->canComputeBatchWithCuda(); }
 
+   /// Whether the node can be evaluated chunk by chunk in the multi-threaded CPU mode: its output is computed element
+   /// by element from inputs that are either scalars or of the same size as the output.
+   bool canComputeInChunks() const
+   {
+      if (isScalar() || fromArrayInput || isVariable || isCategory || absArg->isReducerNode() ||
+          !absArg->canComputeBatchInChunks()) {
+         return false;
+      }
+      return std::all_of(serverInfos.begin(), serverInfos.end(),
+                         [&](NodeInfo const *server) { return server->isScalar() || server->outputSize == outputSize; });
+   }
+
    RooAbsArg *absArg = nullptr;
    RooAbsArg::OperMode originalOperMode;
 
@@ -113,11 +147,14 @@ struct NodeInfo {
    bool isDirty = true;
    bool isCategory = false;
    bool hasLogged = false;
+   bool computeInChunks = false;
+   bool isChunkPending = false;
    std::size_t outputSize = 1;
    std::size_t lastSetValCount = std::numeric_limits<std::size_t>::max();
    double scalarBuffer = 0.0;
    std::vector<NodeInfo *> serverInfos;
    std::vector<NodeInfo *> clientInfos;
+   std::vector<std::size_t> dependentNodes; // for variables: the sorted indices of all nodes depending on them
 
    RooBatchCompute::CudaInterface::CudaEvent *event = nullptr;
    RooBatchCompute::CudaInterface::CudaStream *stream = nullptr;
@@ -160,6 +197,10 @@ Evaluator::Evaluator(const RooAbsReal &absReal, bool useGPU)
    _bufferManager = _useGPU ? RooBatchCompute::dispatchCUDA->createBufferManager()
                             : RooBatchCompute::dispatchCPU->createBufferManager();
 
+   if (!_useGPU && ROOT::IsImplicitMTEnabled()) {
+      _evalContextCPU._chunkSize = nEventsPerChunk;
+   }
+
    RooArgSet serverSet;
    ::RooHelpers::getSortedComputationGraph(_topNode, serverSet);
 
@@ -206,6 +247,7 @@ Evaluator::Evaluator(const RooAbsReal &absReal, bool useGPU)
    }
 
    syncDataTokens();
+   findDependentNodes();
 
    if (_useGPU) {
       // create events and streams for every node
@@ -219,6 +261,33 @@ Evaluator::Evaluator(const RooAbsReal &absReal, bool useGPU)
    }
 }
 
+/// Find for each variable the nodes that directly or indirectly depend on it. As the nodes are sorted topologically,
+/// the sorted node indices are also a valid evaluation order.
+void Evaluator::findDependentNodes()
+{
+   _isScheduled.assign(_nodes.size(), false);
+   std::vector<NodeInfo *> stack;
+   for (NodeInfo &info : _nodes) {
+      if (!info.isVariable)
+         continue;
+      _variables.emplace_back(&info);
+      stack.assign(info.clientInfos.begin(), info.clientInfos.end());
+      while (!stack.empty()) {
+         NodeInfo *client = stack.back();
+         stack.pop_back();
+         if (_isScheduled[client->iNode])
+            continue;
+         _isScheduled[client->iNode] = true;
+         info.dependentNodes.emplace_back(client->iNode);
+         stack.insert(stack.end(), client->clientInfos.begin(), client->clientInfos.end());
+      }
+      std::sort(info.dependentNodes.begin(), info.dependentNodes.end());
+      for (std::size_t iNode : info.dependentNodes) {
+         _isScheduled[iNode] = false;
+      }
+   }
+}
+
 /// If there are servers with the same name that got de-duplicated in the
 /// `_nodes` list, we need to set their data tokens too. We find such nodes by
 /// visiting the servers of every known node.
@@ -287,6 +356,7 @@ void Evaluator::setInput(std::string const &name, std::span<const double> inputA
    }
 
    _needToUpdateOutputSizes = true;
+   _needFullGraphSweep = true;
 }
 
 void Evaluator::updateOutputSizes()
@@ -322,6 +392,10 @@ void Evaluator::updateOutputSizes()
       }
    }
 
+   for (auto &info : _nodes) {
+      info.computeInChunks = _evalContextCPU.nChunks(info.outputSize) > 1 && info.canComputeInChunks();
+   }
+
    if (_useGPU) {
       markGPUNodes();
    }
@@ -391,6 +465,61 @@ void Evaluator::computeCPUNode(const RooAbsArg *node, NodeInfo &info)
    }
 }
 
+/// Prepare the output buffer of a node that is evaluated chunk by chunk, and add it to the nodes evaluated by the next
+/// call to computeChunkedNodes(). All the nodes evaluated together must have the same output size.
+void Evaluator::deferChunkedNode(NodeInfo &info)
+{
+   if (!_chunkedNodes.empty() && _chunkedNodes.front()->outputSize != info.outputSize) {
+      computeChunkedNodes();
+   }
+   if (!info.buffer) {
+      info.buffer = _bufferManager->makeCpuBuffer(info.outputSize);
+   }
+   _evalContextCPU.set(info.absArg, {info.buffer->hostReadPtr(), info.outputSize});
+   info.isChunkPending = true;
+   _chunkedNodes.emplace_back(&info);
+}
+
+/// Evaluate the deferred nodes chunk by chunk, in parallel. For each chunk, all the nodes are evaluated in order, so
+/// that the intermediate results of the chunk are still in the cache of the thread when they are used.
+void Evaluator::computeChunkedNodes()
+{
+   if (_chunkedNodes.empty())
+      return;
+
+   const std::size_t nEvents = _chunkedNodes.front()->outputSize;
+   std::vector<double *> outputs;
+   outputs.reserve(_chunkedNodes.size());
+   for (NodeInfo *info : _chunkedNodes) {
+      outputs.emplace_back(info->buffer->hostWritePtr());
+   }
+
+   _evalContextCPU.forEachChunk(nEvents, [&](std::size_t, std::size_t begin, std::size_t end) {
+      // A context in which all the inputs of the size of the events are restricted to the chunk
+      EvalContext ctx;
+      ctx._offsetMode = _evalContextCPU._offsetMode;
+      ctx._cfgs = _evalContextCPU._cfgs;
+      ctx._ctx = _evalContextCPU._ctx;
+      for (auto &span : ctx._ctx) {
+         if (span.size() == nEvents) {
+            assignSpan(span, {span.data() + begin, end - begin});
+         }
+      }
+      for (std::size_t i = 0; i < _chunkedNodes.size(); ++i) {
+         assignSpan(ctx._currentOutput, {outputs[i] + begin, end - begin});
+         ctx.enableVectorBuffers(true);
+         static_cast<RooAbsReal const *>(_chunkedNodes[i]->absArg)->doEval(ctx);
+         ctx.resetVectorBuffers();
+         ctx.enableVectorBuffers(false);
+      }
+   });
+
+   for (NodeInfo *info : _chunkedNodes) {
+      info->isChunkPending = false;
+   }
+   _chunkedNodes.clear();
+}
+
 /// Process a variable in the computation graph. This is a separate non-inlined
 /// function such that we can see in performance profiles how long this takes.
 void Evaluator::processVariable(NodeInfo &nodeInfo)
@@ -428,24 +557,97 @@ std::span<const double> Evaluator::run()
       return getValHeterogeneous();
    }
 
-   for (auto &nodeInfo : _nodes) {
-      if (!nodeInfo.fromArrayInput) {
-         if (nodeInfo.isVariable) {
-            processVariable(nodeInfo);
-         } else {
-            if (nodeInfo.isDirty) {
-               setClientsDirty(nodeInfo);
-               computeCPUNode(nodeInfo.absArg, nodeInfo);
-               nodeInfo.isDirty = false;
+   if (_needFullGraphSweep) {
+      for (auto &nodeInfo : _nodes) {
+         if (!nodeInfo.fromArrayInput) {
+            if (nodeInfo.isVariable) {
+               processVariable(nodeInfo);
+            } else {
+               processNode(nodeInfo);
             }
          }
       }
+      _needFullGraphSweep = false;
+   } else {
+      runDependentNodes();
    }
+   computeChunkedNodes();
 
    // return the final output
    return _evalContextCPU.at(&_topNode);
 }
 
+/// Evaluate a node that is not a variable if it is dirty, possibly deferring it to be evaluated in chunks.
+void Evaluator::processNode(NodeInfo &nodeInfo)
+{
+   if (!nodeInfo.isDirty)
+      return;
+   setClientsDirty(nodeInfo);
+   if (nodeInfo.computeInChunks) {
+      deferChunkedNode(nodeInfo);
+   } else {
+      // the deferred nodes have to be evaluated before their clients that can't be evaluated in chunks
+      if (std::any_of(nodeInfo.serverInfos.begin(), nodeInfo.serverInfos.end(),
+                      [](NodeInfo const *server) { return server->isChunkPending; })) {
+         computeChunkedNodes();
+      }
+      computeCPUNode(nodeInfo.absArg, nodeInfo);
+   }
+   nodeInfo.isDirty = false;
+}
+
+/// Evaluate only the nodes that depend on the variables whose values changed since the last evaluation, in
+/// topological order. If only one variable changed, as in the evaluations for a numerical gradient, its precomputed
+/// list of dependent nodes is used directly.
+void Evaluator::runDependentNodes()
+{
+   NodeInfo *changedVariable = nullptr;
+   std::size_t nChanged = 0;
+   for (NodeInfo *varInfo : _variables) {
+      const std::size_t lastSetValCount = varInfo->lastSetValCount;
+      if (varInfo->fromArrayInput)
+         continue;
+      processVariable(*varInfo);
+      if (varInfo->lastSetValCount == lastSetValCount)
+         continue;
+      if (nChanged++ == 0) {
+         changedVariable = varInfo;
+         continue;
+      }
+      // Several variables changed: merge their dependent nodes
+      if (nChanged == 2) {
+         _scheduledNodes.clear();
+         for (std::size_t iNode : changedVariable->dependentNodes) {
+            _isScheduled[iNode] = true;
+            _scheduledNodes.emplace_back(iNode);
+         }
+      }
+      for (std::size_t iNode : varInfo->dependentNodes) {
+         if (!_isScheduled[iNode]) {
+            _isScheduled[iNode] = true;
+            _scheduledNodes.emplace_back(iNode);
+         }
+      }
+   }
+
+   if (nChanged == 0)
+      return;
+
+   if (nChanged > 1) {
+      std::sort(_scheduledNodes.begin(), _scheduledNodes.end());
+      for (std::size_t iNode : _scheduledNodes) {
+         _isScheduled[iNode] = false;
+      }
+   }
+
+   for (std::size_t iNode : nChanged == 1 ? changedVariable->dependentNodes : _scheduledNodes) {
+      NodeInfo &nodeInfo = _nodes[iNode];
+      if (!nodeInfo.fromArrayInput) {
+         processNode(nodeInfo);
+      }
+   }
+}
+
 /// Returns the value of the top node in the computation graph
 std::span<const double> Evaluator::getValHeterogeneous()
 {
@@ -679,6 +881,7 @@ void Evaluator::setOffsetMode(RooFit::EvalContext::OffsetMode mode)
          nodeInfo.isDirty = true;
       }
    }
+   _needFullGraphSweep = true;
 }
 
 } // namespace RooFit
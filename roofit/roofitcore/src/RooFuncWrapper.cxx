@@ -23,11 +23,13 @@
 #include <RooSimultaneous.h>
 #include "RooEvaluatorWrapper.h"
 
+#include <TMD5.h>
 #include <TROOT.h>
 #include <TSystem.h>
 
 #include <fstream>
 #include <set>
+#include <unordered_set>
 
 namespace {
 
@@ -42,6 +44,15 @@ void replaceAll(std::string &str, const std::string &from, const std::string &to
    }
 }
 
+/// Names of the functions and gradients that were already declared to the interpreter in this process. The function
+/// names are derived from their code, so a function that is already declared can be reused as it is, skipping its
+/// compilation and differentiation.
+std::unordered_set<std::string> &declaredFunctions()
+{
+   static std::unordered_set<std::string> names;
+   return names;
+}
+
 } // namespace
 
 namespace RooFit {
@@ -138,22 +149,33 @@ void RooFuncWrapper::loadParamsAndData(RooAbsArg const *head, RooArgSet const &p
    }
 }
 
+/// Declare a function with the given body to the interpreter and return its name.
+/// The function is named after the MD5 digest of its body. If the same code was already generated in this process,
+/// for example when the same model is fitted again to toy data or in a likelihood scan, the function that was declared
+/// then is reused instead of being compiled again.
 std::string RooFuncWrapper::declareFunction(std::string const &funcBody)
 {
-   static int iFuncWrapper = 0;
-   auto funcName = "roo_func_wrapper_" + std::to_string(iFuncWrapper++);
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(funcBody.data()), funcBody.size());
+   md5.Final();
+   auto funcName = std::string("roo_func_wrapper_") + md5.AsString();
+
+   _collectedFunctions.emplace_back(funcName);
+   if (declaredFunctions().count(funcName)) {
+      return funcName;
+   }
 
    // Declare the function
    std::stringstream bodyWithSigStrm;
    bodyWithSigStrm << "double " << funcName << "(double* params, double const* obs, double const* xlArr) {\n"
                    << funcBody << "\n}";
-   _collectedFunctions.emplace_back(funcName);
    if (!gInterpreter->Declare(bodyWithSigStrm.str().c_str())) {
       std::stringstream errorMsg;
       errorMsg << "Function " << funcName << " could not be compiled. See above for details.";
       oocoutE(nullptr, InputArguments) << errorMsg.str() << std::endl;
       throw std::runtime_error(errorMsg.str().c_str());
    }
+   declaredFunctions().insert(funcName);
    return funcName;
 }
 
@@ -162,6 +184,13 @@ void RooFuncWrapper::createGradient()
    std::string gradName = _funcName + "_grad_0";
    std::string requestName = _funcName + "_req";
 
+   // The function was already differentiated for another wrapper with the same code
+   if (declaredFunctions().count(gradName)) {
+      _grad = reinterpret_cast<Grad>(gInterpreter->ProcessLine((gradName + ";").c_str()));
+      _hasGradient = true;
+      return;
+   }
+
    // Calculate gradient
    gInterpreter->Declare("#include <Math/CladDerivator.h>\n");
    // disable clang-format for making the following code unreadable.
@@ -180,6 +209,8 @@ void RooFuncWrapper::createGradient()
       throw std::runtime_error(errorMsg.str().c_str());
    }
 
+   declaredFunctions().insert(gradName);
+
    _grad = reinterpret_cast<Grad>(gInterpreter->ProcessLine((gradName + ";").c_str()));
    _hasGradient = true;
 }
@@ -377,6 +377,10 @@ RooCmdArg StoreAsymError(const RooArgSet &aset)
 {
    return RooCmdArg("StoreAsymError", 0, 0, 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &aset);
 }
+RooCmdArg StoreAsFloat(const RooArgSet &aset)
+{
+   return RooCmdArg("StoreAsFloat", 0, 0, 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &aset);
+}
 RooCmdArg OwnLinked()
 {
    return RooCmdArg("OwnLinked", 1, 0, 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
@@ -42,6 +42,8 @@ computation times.
 #include <TMath.h>
 #include <Math/Util.h>
 
+#include <cmath>
+#include <limits>
 #include <numeric>
 #include <stdexcept>
 #include <vector>
@@ -115,6 +117,56 @@ private:
    RooTemplateProxy<RooAbsReal> _weightVar;
 };
 
+// Restrict a per-event span to the events [begin, end). Scalar and empty spans are kept as they are.
+std::span<const double> chunkOf(std::span<const double> span, std::size_t begin, std::size_t end)
+{
+   return span.size() > 1 ? std::span<const double>{span.data() + begin, end - begin} : span;
+}
+
+// Compute the NLL of the events in parallel chunks in the multi-threaded CPU mode of the RooFit::Evaluator, see
+// RooFit::EvalContext::forEachChunk(). The partial sums are combined in the order of the chunks with Kahan
+// summation, so that the result doesn't depend on the number of threads.
+RooBatchCompute::ReduceNLLOutput reduceNLLInChunks(RooFit::EvalContext &ctx, RooBatchCompute::Config const &config,
+                                                   std::span<const double> probas, std::span<const double> weights,
+                                                   std::span<const double> offsetProbas)
+{
+   const std::size_t nChunks = config.useCuda() ? 1 : ctx.nChunks(probas.size());
+   if (nChunks == 1) {
+      return RooBatchCompute::reduceNLL(config, probas, weights, offsetProbas);
+   }
+
+   std::vector<RooBatchCompute::ReduceNLLOutput> chunkOutputs(nChunks);
+   ctx.forEachChunk(probas.size(), [&](std::size_t iChunk, std::size_t begin, std::size_t end) {
+      chunkOutputs[iChunk] = RooBatchCompute::reduceNLL(config, chunkOf(probas, begin, end),
+                                                        chunkOf(weights, begin, end), chunkOf(offsetProbas, begin, end));
+   });
+
+   RooBatchCompute::ReduceNLLOutput out;
+   ROOT::Math::KahanSum<double> nllSum;
+   // Chunks with evaluation errors return the sum of their "badness" packed in a NaN instead of their NLL
+   double badness = 0.0;
+   bool hasNaN = false;
+   for (auto const &chunkOut : chunkOutputs) {
+      out.nLargeValues += chunkOut.nLargeValues;
+      out.nNonPositiveValues += chunkOut.nNonPositiveValues;
+      out.nNaNValues += chunkOut.nNaNValues;
+      if (std::isnan(chunkOut.nllSum)) {
+         hasNaN = true;
+         badness += RooNaNPacker::unpackNaN(chunkOut.nllSum);
+      } else {
+         nllSum += ROOT::Math::KahanSum<double>{chunkOut.nllSum, chunkOut.nllSumCarry};
+      }
+   }
+
+   out.nllSum = nllSum.Sum();
+   out.nllSumCarry = nllSum.Carry();
+   if (hasNaN) {
+      out.nllSum = badness != 0. ? RooNaNPacker::packFloatIntoNaN(badness) : std::numeric_limits<double>::quiet_NaN();
+      out.nllSumCarry = 0.0;
+   }
+   return out;
+}
+
 } // namespace
 
 /** Construct a RooNLLVarNew
@@ -256,8 +308,8 @@ void RooNLLVarNew::doEval(RooFit::EvalContext &ctx) const
                                         : RooBatchCompute::reduceSum(config, weightsSumW2.data(), weightsSumW2.size());
    }
 
-   auto nllOut = RooBatchCompute::reduceNLL(config, probas, _weightSquared ? weightsSumW2 : weights,
-                                            _doBinOffset ? ctx.at(*_offsetPdf) : std::span<const double>{});
+   auto nllOut = reduceNLLInChunks(ctx, config, probas, _weightSquared ? weightsSumW2 : weights,
+                                   _doBinOffset ? ctx.at(*_offsetPdf) : std::span<const double>{});
 
    if (nllOut.nLargeValues > 0) {
       oocoutW(&*_pdf, Eval) << "RooAbsPdf::getLogVal(" << _pdf->GetName()
@@ -67,6 +67,7 @@ public:
    void translate(RooFit::Detail::CodeSquashContext &ctx) const override;
 
    bool canComputeBatchWithCuda() const override { return true; }
+   bool canComputeBatchInChunks() const override { return true; }
 
 protected:
    void doEval(RooFit::EvalContext &) const override;
@@ -31,6 +31,9 @@ Represents the product of a given set of RooAbsReal objects.
 #include "RooMsgService.h"
 #include "RooTrace.h"
 
+#include <RooBatchCompute.h>
+
+#include <array>
 #include <cmath>
 #include <memory>
 
@@ -373,30 +376,24 @@ double RooProduct::evaluate() const
 
 void RooProduct::doEval(RooFit::EvalContext & ctx) const
 {
-  std::span<double> output = ctx.output();
-  std::size_t nEvents = output.size();
-
-  for (unsigned int i = 0; i < nEvents; ++i) {
-    output[i] = 1.;
+  // The category indices are passed to the kernel as scalar factors
+  std::vector<double> catIndices;
+  catIndices.reserve(_compCSet.size());
+  for (const auto item : _compCSet) {
+    catIndices.push_back(static_cast<const RooAbsCategory*>(item)->getCurrentIndex());
   }
 
+  std::vector<std::span<const double>> factors;
+  factors.reserve(_compRSet.size() + catIndices.size());
   for (const auto item : _compRSet) {
-    auto rcomp = static_cast<const RooAbsReal*>(item);
-    auto componentValues = ctx.at(rcomp);
-
-    for (unsigned int i = 0; i < nEvents; ++i) {
-      output[i] *= componentValues.size() == 1 ? componentValues[0] : componentValues[i];
-    }
+    factors.push_back(ctx.at(item));
   }
-
-  for (const auto item : _compCSet) {
-    auto ccomp = static_cast<const RooAbsCategory*>(item);
-    const int catIndex = ccomp->getCurrentIndex();
-
-    for (unsigned int i = 0; i < nEvents; ++i) {
-      output[i] *= catIndex;
-    }
+  for (double const &catIndex : catIndices) {
+    factors.emplace_back(&catIndex, 1);
   }
+
+  std::array<double, 1> special{static_cast<double>(factors.size())};
+  RooBatchCompute::compute(ctx.config(this), RooBatchCompute::ProdPdf, ctx.output(), factors, special);
 }
 
 
@@ -30,6 +30,8 @@ of its servers and present it as a simple array oriented interface.
 #include "RooAbsRealLValue.h"
 #include "RooNameReg.h"
 #include "RooMsgService.h"
+#include "RooFit/Evaluator.h"
+#include "RooFit/Detail/NormalizationHelpers.h"
 
 #include <cassert>
 
@@ -182,6 +184,44 @@ double RooRealBinding::operator()(const double xvector[]) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the bound RooAbsReal at many points in one pass over its
+/// computation graph, with the RooFit::Evaluator. The graph is compiled for
+/// the normalization set of this binding at the first call. The values of the
+/// bound variables are not changed.
+
+void RooRealBinding::getValues(std::vector<std::span<const double>> const &coordinates, std::span<double> output) const
+{
+  assert(isValid());
+  _ncall += output.size();
+
+  if (!_evaluator) {
+    RooArgSet normSet;
+    if (_nset) {
+      normSet.add(*_nset);
+    }
+    _compiledFunc = RooFit::Detail::compileForNormSet(*_func, normSet);
+    _evaluator = std::make_unique<RooFit::Evaluator>(*_compiledFunc);
+  }
+
+  for (unsigned int index = 0; index < _dimension; ++index) {
+    _evaluator->setInput(_vars[index]->GetName(), coordinates[index], false);
+  }
+  std::span<const double> results = _evaluator->run();
+
+  for (std::size_t i = 0; i < output.size(); ++i) {
+    output[i] = results.size() == 1 ? results[0] : results[i];
+    if (_clipInvalid) {
+      for (unsigned int index = 0; index < _dimension; ++index) {
+        const double x = coordinates[index].size() == 1 ? coordinates[index][0] : coordinates[index][i];
+        if (!_vars[index]->isValidReal(x)) {
+          output[i] = 0.;
+        }
+      }
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return lower limit on i-th variable
 
@@ -53,6 +53,8 @@ to the fractions of the various functions. **This requires setting the last argu
 #include "RooMsgService.h"
 #include "RooNaNPacker.h"
 
+#include <RooBatchCompute.h>
+
 #include <TError.h>
 
 #include <algorithm>
@@ -254,26 +256,22 @@ void RooRealSumPdf::doEval(RooFit::EvalContext & ctx) const
   std::span<double> output = ctx.output();
   std::size_t nEvents = output.size();
 
-  // Do running sum of coef/func pairs, calculate lastCoef.
-  std::fill(output.begin(), output.end(), 0.);
+  // Collect the coef/func pairs, calculate lastCoef.
+  std::vector<std::span<const double>> funcs;
+  std::vector<double> coefs;
+  funcs.reserve(_funcList.size());
+  coefs.reserve(_funcList.size());
 
   double sumCoeff = 0.;
+  double invalidLastCoef = 0.;
   for (unsigned int i = 0; i < _funcList.size(); ++i) {
     const auto func = static_cast<RooAbsReal*>(&_funcList[i]);
     const auto coef = static_cast<RooAbsReal*>(i < _coefList.size() ? &_coefList[i] : nullptr);
     const double coefVal = coef != nullptr ? ctx.at(coef)[0] : (1. - sumCoeff);
 
     if (func->isSelectedComp()) {
-      auto funcValues = ctx.at(func);
-      if(funcValues.size() == 1) {
-        for (unsigned int j = 0; j < nEvents; ++j) {
-          output[j] += funcValues[0] * coefVal;
-        }
-      } else {
-        for (unsigned int j = 0; j < nEvents; ++j) {
-          output[j] += funcValues[j] * coefVal;
-        }
-      }
+      funcs.push_back(ctx.at(func));
+      coefs.push_back(coefVal);
     }
 
     // Warn about degeneration of last coefficient
@@ -284,13 +282,26 @@ void RooRealSumPdf::doEval(RooFit::EvalContext & ctx) const
             << sumCoeff << ". This means that the PDF is not properly normalised. If the PDF was meant to be extended, provide as many coefficients as functions." << endl ;
         _haveWarned = true;
       }
-      // Signal that we are in an undefined region by handing back one NaN.
-      output[0] = RooNaNPacker::packFloatIntoNaN(100.f * (coefVal < 0. ? -coefVal : coefVal - 1.));
+      invalidLastCoef = coefVal;
     }
 
     sumCoeff += coefVal;
   }
 
+  // The sum is zero if no component is selected
+  const double zero = 0.;
+  if (funcs.empty()) {
+    funcs.emplace_back(&zero, 1);
+    coefs.push_back(1.);
+  }
+
+  RooBatchCompute::compute(ctx.config(this), RooBatchCompute::AddPdf, output, funcs, coefs);
+
+  // Signal that we are in an undefined region by handing back one NaN.
+  if (invalidLastCoef != 0.) {
+    output[0] = RooNaNPacker::packFloatIntoNaN(100.f * (invalidLastCoef < 0. ? -invalidLastCoef : invalidLastCoef - 1.));
+  }
+
   // Introduce floor if so requested
   if (_doFloor || _doFloorGlobal) {
     for (unsigned int j = 0; j < nEvents; ++j) {
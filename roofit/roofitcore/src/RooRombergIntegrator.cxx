@@ -44,6 +44,7 @@ desired precision is reached.
 #include "RooMsgService.h"
 
 #include <cassert>
+#include <vector>
 
 namespace {
 
@@ -56,13 +57,16 @@ constexpr int nPoints = 5;
 /// evaluations than the trapezoidal rule. This rule can be used with
 /// a suitable change of variables to estimate improper integrals.
 
-double addMidpoints(std::function<double(double)> const &func, double savedResult, int n, double xmin, double xmax)
+double addMidpoints(RooFit::Detail::BatchIntegrand const &func, double savedResult, int n, double xmin, double xmax,
+                    std::vector<double> &xBuffer, std::vector<double> &yBuffer)
 {
    const double range = xmax - xmin;
 
    if (n == 1) {
-      double xmid = 0.5 * (xmin + xmax);
-      return range * func(xmid);
+      xBuffer.assign(1, 0.5 * (xmin + xmax));
+      yBuffer.resize(1);
+      func(xBuffer, yBuffer);
+      return range * yBuffer[0];
    }
 
    int it = 1;
@@ -73,13 +77,19 @@ double addMidpoints(std::function<double(double)> const &func, double savedResul
    double del = range / (3. * tnm);
    double ddel = del + del;
    double x = xmin + 0.5 * del;
-   double sum = 0;
-   for (int j = 1; j <= it; j++) {
-      sum += func(x);
+   xBuffer.resize(2 * it);
+   yBuffer.resize(2 * it);
+   for (int j = 0; j < it; j++) {
+      xBuffer[2 * j] = x;
       x += ddel;
-      sum += func(x);
+      xBuffer[2 * j + 1] = x;
       x += del;
    }
+   func(xBuffer, yBuffer);
+   double sum = 0;
+   for (double y : yBuffer) {
+      sum += y;
+   }
    return (savedResult + range * sum / tnm) / 3.;
 }
 
@@ -89,13 +99,17 @@ double addMidpoints(std::function<double(double)> const &func, double savedResul
 /// integrands that can be evaluated over its entire range, including the
 /// endpoints.
 
-double addTrapezoids(std::function<double(double)> const &func, double savedResult, int n, double xmin, double xmax)
+double addTrapezoids(RooFit::Detail::BatchIntegrand const &func, double savedResult, int n, double xmin, double xmax,
+                     std::vector<double> &xBuffer, std::vector<double> &yBuffer)
 {
    const double range = xmax - xmin;
 
    if (n == 1) {
       // use a single trapezoid to cover the full range
-      return 0.5 * range * (func(xmin) + func(xmax));
+      xBuffer.assign({xmin, xmax});
+      yBuffer.resize(2);
+      func(xBuffer, yBuffer);
+      return 0.5 * range * (yBuffer[0] + yBuffer[1]);
    }
 
    // break the range down into several trapezoids using 2**(n-2)
@@ -103,11 +117,16 @@ double addTrapezoids(std::function<double(double)> const &func, double savedResu
    const int nInt = 1 << (n - 2);
    const double del = range / nInt;
 
-   double sum = 0.;
-   // TODO Replace by batch computation
+   xBuffer.resize(nInt);
+   yBuffer.resize(nInt);
    for (int j = 0; j < nInt; ++j) {
-      double x = xmin + (0.5 + j) * del;
-      sum += func(x);
+      xBuffer[j] = xmin + (0.5 + j) * del;
+   }
+   func(xBuffer, yBuffer);
+
+   double sum = 0.;
+   for (double y : yBuffer) {
+      sum += y;
    }
 
    return 0.5 * (savedResult + range * sum / nInt);
@@ -158,7 +177,9 @@ std::pair<double, double> extrapolate(int n, double const *h, double const *s, d
 namespace RooFit {
 namespace Detail {
 
-std::pair<double, int> integrate1d(std::function<double(double)> func, bool doTrapezoid, int maxSteps, int minStepsZero,
+/// Integrate a function of one variable with Romberg's method. The function
+/// is evaluated at all the new abscissae of a refinement step at once.
+std::pair<double, int> integrate1d(BatchIntegrand const &func, bool doTrapezoid, int maxSteps, int minStepsZero,
                                    int fixSteps, double epsAbs, double epsRel, bool doExtrap, double xmin, double xmax,
                                    std::span<double> hArr, std::span<double> sArr)
 {
@@ -171,12 +192,16 @@ std::pair<double, int> integrate1d(std::function<double(double)> func, bool doTr
    std::array<double, nPoints + 1> cArr = {};
    std::array<double, nPoints + 1> dArr = {};
 
+   // Abscissae and function values of one refinement step
+   std::vector<double> xBuffer;
+   std::vector<double> yBuffer;
+
    hArr[1] = 1.0;
    double zeroThresh = epsAbs / range;
    for (int j = 1; j <= maxSteps; ++j) {
       // refine our estimate using the appropriate summation rule
-      sArr[j] =
-         doTrapezoid ? addTrapezoids(func, sArr[j - 1], j, xmin, xmax) : addMidpoints(func, sArr[j - 1], j, xmin, xmax);
+      sArr[j] = doTrapezoid ? addTrapezoids(func, sArr[j - 1], j, xmin, xmax, xBuffer, yBuffer)
+                            : addMidpoints(func, sArr[j - 1], j, xmin, xmax, xBuffer, yBuffer);
 
       if (j >= minStepsZero) {
          bool allZero(true);
@@ -249,6 +274,10 @@ void RooRombergIntegrator::registerIntegrator(RooNumIntFactory &fact)
    RooRealVar maxSteps("maxSteps", "Maximum number of steps", 20);
    RooRealVar minSteps("minSteps", "Minimum number of steps", 999);
    RooRealVar fixSteps("fixSteps", "Fixed number of steps", 0);
+   RooCategory batchEval("batchEvaluation", "Evaluate the integrand at all points of a refinement step at once");
+   batchEval.defineType("Off", 0);
+   batchEval.defineType("On", 1);
+   batchEval.setLabel("Off");
    RooRealVar numSeg("numSeg", "Number of segments", 3); // only for the segmented integrators
 
    std::string name = "RooIntegrator1D";
@@ -257,7 +286,7 @@ void RooRombergIntegrator::registerIntegrator(RooNumIntFactory &fact)
       return std::make_unique<RooRombergIntegrator>(function, config, 1, /*doSegmentation=*/false);
    };
 
-   fact.registerPlugin(name, creator, {sumRule, extrap, maxSteps, minSteps, fixSteps},
+   fact.registerPlugin(name, creator, {sumRule, extrap, maxSteps, minSteps, fixSteps, batchEval},
                        /*canIntegrate1D=*/true,
                        /*canIntegrate2D=*/false,
                        /*canIntegrateND=*/false,
@@ -350,6 +379,7 @@ RooRombergIntegrator::RooRombergIntegrator(const RooAbsFunc &function, const Roo
    _minStepsZero = (int)configSet.getRealValue("minSteps", 999);
    _fixSteps = (int)configSet.getRealValue("fixSteps", 0);
    _doExtrap = (bool)configSet.getCatIndex("extrapolation", 1);
+   _batchEval = (bool)configSet.getCatIndex("batchEvaluation", 0);
    if (doSegmentation) {
       _nSeg = (int)config.getConfigSection("RooSegmentedIntegrator1D").getRealValue("numSeg", 3);
       _epsAbs /= std::sqrt(_nSeg);
@@ -385,6 +415,7 @@ RooRombergIntegrator::RooRombergIntegrator(const RooAbsFunc &function, double xm
    _minStepsZero = (int)configSet.getRealValue("minSteps", 999);
    _fixSteps = (int)configSet.getRealValue("fixSteps", 0);
    _doExtrap = (bool)configSet.getCatIndex("extrapolation", 1);
+   _batchEval = (bool)configSet.getCatIndex("batchEvaluation", 0);
 
    _xmin.push_back(xmin);
    _xmax.push_back(xmax);
@@ -528,10 +559,21 @@ double RooRombergIntegrator::integral(int iDim, int nSeg, std::span<double> wksp
 
    std::span<double> nextWksp{wksp.data() + 2 * _maxSteps + 4, wksp.data() + wksp.size()};
 
-   auto func = [&](double x) {
-      _x[iDim] = x;
-
-      return iDim == 0 ? integrand(_x.data()) : integral(iDim - 1, _nSeg, nextWksp);
+   auto func = [&](std::span<const double> xs, std::span<double> ys) {
+      if (iDim == 0 && _batchEval) {
+         // The other coordinates are the same for all points
+         std::vector<std::span<const double>> coordinates;
+         coordinates.reserve(_x.size());
+         for (std::size_t i = 0; i < _x.size(); ++i) {
+            coordinates.emplace_back(i == 0 ? xs : std::span<const double>{&_x[i], 1});
+         }
+         _function->getValues(coordinates, ys);
+         return;
+      }
+      for (std::size_t i = 0; i < xs.size(); ++i) {
+         _x[iDim] = xs[i];
+         ys[i] = iDim == 0 ? integrand(_x.data()) : integral(iDim - 1, _nSeg, nextWksp);
+      }
    };
 
    std::tie(output, steps) =
@@ -26,7 +26,10 @@
 namespace RooFit {
 namespace Detail {
 
-std::pair<double, int> integrate1d(std::function<double(double)> func, bool doTrapezoid, int maxSteps, int minStepsZero,
+/// Fills the second span with the values of a function of one variable at the abscissae in the first span.
+using BatchIntegrand = std::function<void(std::span<const double>, std::span<double>)>;
+
+std::pair<double, int> integrate1d(BatchIntegrand const &func, bool doTrapezoid, int maxSteps, int minStepsZero,
                                    int fixSteps, double epsAbs, double epsRel, bool doExtrap, double xmin, double xmax,
                                    std::span<double> hArr, std::span<double> sArr);
 
@@ -76,6 +79,7 @@ protected:
    double _epsAbs;            ///< Absolute convergence tolerance
    double _epsRel;            ///< Relative convergence tolerance
    bool _doExtrap = true;     ///< Apply conversion step?
+   bool _batchEval = false;   ///< Evaluate all points of a refinement step with RooAbsFunc::getValues()?
    int _nSeg = 1;             ///< Number of segments
    std::vector<double> _xmin; ///<! Lower integration bounds
    std::vector<double> _xmax; ///<! Upper integration bounds
@@ -29,6 +29,10 @@ the requested column into the bound real.
 
 As a faster alternative to loading values one-by-one, one can use the function getBatches(),
 which returns spans pointing directly to the data.
+
+Columns of observables with the attribute `StoreAsFloat` (see RooFit::StoreAsFloat())
+are stored in single precision. They need half the memory, and are converted back to double
+precision when they are loaded or requested with getBatches().
 **/
 
 #include "RooVectorDataStore.h"
@@ -1073,9 +1077,9 @@ void RooVectorDataStore::dump()
   for (const auto elm : _realStoreList) {
     cout << "RealVector " << elm << " _nativeReal = " << elm->_nativeReal << " = " << elm->_nativeReal->GetName() << " bufptr = " << elm->_buf  << endl ;
     cout << " values : " ;
-    Int_t imax = elm->_vec.size()>10 ? 10 : elm->_vec.size() ;
-    for (Int_t i=0 ; i<imax ; i++) {
-      cout << elm->_vec[i] << " " ;
+    auto values = elm->getRange(0, 10);
+    for (double val : values) {
+      cout << val << " " ;
     }
     cout << endl ;
   }
@@ -1085,9 +1089,10 @@ void RooVectorDataStore::dump()
     << " bufptr = " << elm->_buf  << " errbufptr = " << elm->bufE() << endl ;
 
     cout << " values : " ;
-    Int_t imax = elm->_vec.size()>10 ? 10 : elm->_vec.size() ;
-    for (Int_t i=0 ; i<imax ; i++) {
-      cout << elm->_vec[i] << " " ;
+    auto values = elm->getRange(0, 10);
+    Int_t imax = values.size() ;
+    for (double val : values) {
+      cout << val << " " ;
     }
     cout << endl ;
     if (elm->bufE()) {
@@ -1246,6 +1251,7 @@ RooVectorDataStore::RealVector* RooVectorDataStore::addReal(RooAbsReal* real) {
   // First try a match by name
   for (auto realVec : _realStoreList) {
     if (realVec->bufArg()->namePtr()==real->namePtr()) {
+      if (real->getAttribute("StoreAsFloat")) realVec->setStoreAsFloat();
       return realVec;
     }
   }
@@ -1253,6 +1259,7 @@ RooVectorDataStore::RealVector* RooVectorDataStore::addReal(RooAbsReal* real) {
   // Then check if an entry already exists for a full real
   for (auto fullVec : _realfStoreList) {
     if (fullVec->bufArg()->namePtr()==real->namePtr()) {
+      if (real->getAttribute("StoreAsFloat")) fullVec->setStoreAsFloat();
       // Return full vector as RealVector base class here
       return fullVec;
     }
@@ -1260,6 +1267,7 @@ RooVectorDataStore::RealVector* RooVectorDataStore::addReal(RooAbsReal* real) {
 
   // If nothing found this will make an entry
   _realStoreList.push_back(new RealVector(real)) ;
+  if (real->getAttribute("StoreAsFloat")) _realStoreList.back()->setStoreAsFloat();
 
   return _realStoreList.back() ;
 }
@@ -1306,6 +1314,7 @@ RooVectorDataStore::RealFullVector* RooVectorDataStore::addRealFull(RooAbsReal*
   // First try a match by name
   for (auto fullVec : _realfStoreList) {
     if (std::string(fullVec->bufArg()->GetName())==real->GetName()) {
+    if (real->getAttribute("StoreAsFloat")) fullVec->setStoreAsFloat();
     return fullVec;
     }
   }
@@ -1316,6 +1325,7 @@ RooVectorDataStore::RealFullVector* RooVectorDataStore::addRealFull(RooAbsReal*
 
       // Convert element to full and add to full list
       _realfStoreList.push_back(new RealFullVector(*realVec,real)) ;
+      if (real->getAttribute("StoreAsFloat")) _realfStoreList.back()->setStoreAsFloat();
 
       // Delete bare element
       _realStoreList.erase(std::find(_realStoreList.begin(), _realStoreList.end(), realVec));
@@ -1327,6 +1337,7 @@ RooVectorDataStore::RealFullVector* RooVectorDataStore::addRealFull(RooAbsReal*
 
   // If nothing found this will make an entry
   _realfStoreList.push_back(new RealFullVector(real)) ;
+  if (real->getAttribute("StoreAsFloat")) _realfStoreList.back()->setStoreAsFloat();
 
   return _realfStoreList.back() ;
 }
@@ -1344,11 +1355,11 @@ void RooVectorDataStore::recomputeSumWeight() {
     const std::string wgtName = _wgtVar->GetName();
     for(auto const* real : _realStoreList) {
       if(wgtName == real->_nativeReal->GetName())
-        arr = real->_vec.data();
+        arr = real->getRange(0, size()).data();
     }
     for(auto const* real : _realfStoreList) {
       if(wgtName == real->_nativeReal->GetName())
-        arr = real->_vec.data();
+        arr = real->getRange(0, size()).data();
     }
   }
   if(arr == nullptr) {
@@ -1368,11 +1379,11 @@ RooVectorDataStore::ArraysStruct  RooVectorDataStore::getArrays() const {
   out.size = size();
 
   for(auto const* real : _realStoreList) {
-    out.reals.emplace_back(real->_nativeReal->GetName(), real->_vec.data());
+    out.reals.emplace_back(real->_nativeReal->GetName(), real->getRange(0, out.size).data());
   }
   for(auto const* realf : _realfStoreList) {
     std::string name = realf->_nativeReal->GetName();
-    out.reals.emplace_back(name, realf->_vec.data());
+    out.reals.emplace_back(name, realf->getRange(0, out.size).data());
     if(realf->bufE()) out.reals.emplace_back(name + "Err", realf->dataE().data());
     if(realf->bufEL()) out.reals.emplace_back(name + "ErrLo", realf->dataEL().data());
     if(realf->bufEH()) out.reals.emplace_back(name + "ErrHi", realf->dataEH().data());
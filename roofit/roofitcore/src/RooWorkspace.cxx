@@ -81,9 +81,11 @@ and try reading again.
 
 #include "ROOT/StringUtils.hxx"
 
+#include <algorithm>
 #include <map>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <iostream>
 #include <fstream>
 #include <cstring>
@@ -193,13 +195,31 @@ RooWorkspace::RooWorkspace(const char* name, bool /*doCINTExport*/)  :
 /// Workspace copy constructor
 
 RooWorkspace::RooWorkspace(const RooWorkspace& other) :
+  RooWorkspace(other, false)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy a workspace. If shareData is true, the datasets are not copied but
+/// shared with the other workspace, see cloneSharingData().
+
+RooWorkspace::RooWorkspace(const RooWorkspace& other, bool shareData) :
   TNamed(other), _uuid(other._uuid), _classes(other._classes,this)
 {
   // Copy owned nodes
   other._allOwnedNodes.snapshot(_allOwnedNodes,true) ;
 
   // Copy datasets
-  for(TObject *data2 : other._dataList) _dataList.Add(data2->Clone());
+  if (shareData) {
+    other.moveDataToSharedPool();
+    _sharedData = other._sharedData;
+    for(TObject *data2 : other._dataList) _dataList.Add(data2);
+    // The histograms of the copied RooHistPdfs and RooHistFuncs point to these
+    for(TObject *data2 : other._embeddedDataList) _embeddedDataList.Add(data2);
+  } else {
+    for(TObject *data2 : other._dataList) _dataList.Add(data2->Clone());
+  }
 
   // Copy snapshots
   for(auto * snap : static_range_cast<RooArgSet*>(other._snapshots)) {
@@ -240,11 +260,60 @@ TObject *RooWorkspace::Clone(const char *newname) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Clone the workspace without copying its datasets, which is much faster
+/// for workspaces with large datasets, e.g. to have a copy of the model per
+/// thread. The datasets, also those embedded in RooHistPdfs and RooHistFuncs,
+/// are shared between the clones and deleted with the last workspace that
+/// uses them, so they must not be modified. The pdfs, functions and snapshots
+/// are copied as with Clone().
+
+std::unique_ptr<RooWorkspace> RooWorkspace::cloneSharingData(const char *newname) const
+{
+   std::unique_ptr<RooWorkspace> out{new RooWorkspace{*this, true}};
+   if (newname && std::string(newname) != GetName()) {
+      out->SetName(newname);
+   }
+   return out;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transfer the ownership of the datasets to the pool that is shared with the
+/// clones from cloneSharingData(). The datasets stay in the lists of the
+/// workspace.
+
+void RooWorkspace::moveDataToSharedPool() const
+{
+   if (!_sharedData) {
+      _sharedData = std::make_shared<SharedData>();
+   }
+   auto isShared = [this](TObject *obj) {
+      return std::any_of(_sharedData->begin(), _sharedData->end(), [obj](auto const &d) { return d.get() == obj; });
+   };
+   for (auto *dataList : {&_dataList, &_embeddedDataList}) {
+      for (TObject *data : *dataList) {
+         if (!isShared(data)) {
+            _sharedData->emplace_back(data);
+         }
+      }
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Workspace destructor
 
 RooWorkspace::~RooWorkspace()
 {
+  // Shared datasets are deleted with the last workspace that uses them
+  if (_sharedData) {
+    for (auto const &data : *_sharedData) {
+      _dataList.Remove(data.get());
+      _embeddedDataList.Remove(data.get());
+    }
+  }
+
   // Delete contents
   _dataList.Delete() ;
   if (_dir) {
@@ -2490,12 +2559,16 @@ void RooWorkspace::Streamer(TBuffer &R__b)
       map<RooAbsArg *, vector<RooAbsArg *>> extValueClients;
       map<RooAbsArg *, vector<RooAbsArg *>> extShapeClients;
 
+      // The owned nodes are hashed, such that finding the external clients
+      // doesn't scale quadratically with the size of the workspace
+      const std::unordered_set<RooAbsArg const *> ownedNodes{_allOwnedNodes.begin(), _allOwnedNodes.end()};
+
       for (RooAbsArg *tmparg : _allOwnedNodes) {
 
          // Loop over client list of this arg
          std::vector<RooAbsArg *> clientsTmp{tmparg->_clientList.begin(), tmparg->_clientList.end()};
          for (auto client : clientsTmp) {
-            if (!_allOwnedNodes.containsInstance(*client)) {
+            if (ownedNodes.find(client) == ownedNodes.end()) {
 
                const auto refCount = tmparg->_clientList.refCount(client);
                auto &bufferVec = extClients[tmparg];
@@ -2508,7 +2581,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
          // Loop over value client list of this arg
          clientsTmp.assign(tmparg->_clientListValue.begin(), tmparg->_clientListValue.end());
          for (auto vclient : clientsTmp) {
-            if (!_allOwnedNodes.containsInstance(*vclient)) {
+            if (ownedNodes.find(vclient) == ownedNodes.end()) {
                cxcoutD(ObjectHandling) << "RooWorkspace::Streamer(" << GetName() << ") element " << tmparg->GetName()
                                        << " has external value client link to " << vclient << " (" << vclient->GetName()
                                        << ") with ref count " << tmparg->_clientListValue.refCount(vclient) << endl;
@@ -2524,7 +2597,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
          // Loop over shape client list of this arg
          clientsTmp.assign(tmparg->_clientListShape.begin(), tmparg->_clientListShape.end());
          for (auto sclient : clientsTmp) {
-            if (!_allOwnedNodes.containsInstance(*sclient)) {
+            if (ownedNodes.find(sclient) == ownedNodes.end()) {
                cxcoutD(ObjectHandling) << "RooWorkspace::Streamer(" << GetName() << ") element " << tmparg->GetName()
                                        << " has external shape client link to " << sclient << " (" << sclient->GetName()
                                        << ") with ref count " << tmparg->_clientListShape.refCount(sclient) << endl;
@@ -484,3 +484,44 @@ TEST(RooDataSet,RooStringVarStorage) {
    ASSERT_STREQ(dataClone.get(1)->getStringValue("str"),"str2");
 
 }
+
+/// Observables that are stored in single precision should give back their
+/// values rounded to float, both when loaded one-by-one and in batches.
+TEST(RooDataSet, StoreAsFloat)
+{
+   RooRealVar x{"x", "x", 0.0, 10.0};
+   RooRealVar y{"y", "y", 0.0, 10.0};
+   RooDataSet data{"data", "data", {x, y}, RooFit::StoreAsFloat(x)};
+
+   const std::vector<double> values{0.1, 1.0 / 3.0, 9.87654321};
+   for (double val : values) {
+      x.setVal(val);
+      y.setVal(val);
+      data.add({x, y});
+   }
+
+   auto batches = data.getBatches();
+   std::span<const double> xBatch;
+   std::span<const double> yBatch;
+   for (auto const &item : batches) {
+      if (std::string(item.first->GetName()) == "x")
+         xBatch = item.second;
+      else
+         yBatch = item.second;
+   }
+   ASSERT_EQ(xBatch.size(), values.size());
+   ASSERT_EQ(yBatch.size(), values.size());
+
+   for (std::size_t i = 0; i < values.size(); ++i) {
+      const RooArgSet *row = data.get(i);
+      EXPECT_EQ(row->getRealValue("x"), static_cast<float>(values[i]));
+      EXPECT_EQ(row->getRealValue("y"), values[i]);
+      EXPECT_EQ(xBatch[i], static_cast<float>(values[i]));
+      EXPECT_EQ(yBatch[i], values[i]);
+   }
+
+   // The single-precision storage is kept when the dataset is copied
+   std::unique_ptr<RooAbsData> reduced{data.reduce(RooFit::Cut("x > 0.2"))};
+   ASSERT_EQ(reduced->numEntries(), 2);
+   EXPECT_EQ(reduced->get(0)->getRealValue("x"), static_cast<float>(values[1]));
+}
@@ -124,6 +124,35 @@ TEST(RooFuncWrapper, GaussianNormalized)
    }
 }
 
+// Wrappers for the same model share the generated function and its gradient, which are only compiled once.
+TEST(RooFuncWrapper, ReuseDeclaredFunctions)
+{
+   RooWorkspace ws;
+   ws.factory("Gaussian::gauss(x[0, -10, 10], mu[0, -10, 10], sigma[2.0, 0.01, 10])");
+
+   RooAbsPdf &gauss = *ws.pdf("gauss");
+   RooRealVar &mu = *ws.var("mu");
+
+   RooArgSet normSet{*ws.var("x")};
+   std::unique_ptr<RooAbsReal> gaussNormalized = RooFit::Detail::compileForNormSet(gauss, normSet);
+
+   RooFit::Experimental::RooFuncWrapper gaussFunc1("gaussFunc1", "gaussFunc1", *gaussNormalized);
+   gaussFunc1.createGradient();
+   RooFit::Experimental::RooFuncWrapper gaussFunc2("gaussFunc2", "gaussFunc2", *gaussNormalized);
+   gaussFunc2.createGradient();
+
+   EXPECT_EQ(gaussFunc1.funcName(), gaussFunc2.funcName());
+
+   mu.setVal(1);
+   EXPECT_NEAR(gauss.getVal(normSet), gaussFunc2.getVal(), 1e-8);
+
+   std::vector<double> grad1(gaussFunc1.getNumParams());
+   std::vector<double> grad2(gaussFunc2.getNumParams());
+   gaussFunc1.gradient(grad1.data());
+   gaussFunc2.gradient(grad2.data());
+   EXPECT_EQ(grad1, grad2);
+}
+
 TEST(RooFuncWrapper, Exponential)
 {
 
@@ -368,7 +368,7 @@ TEST(RooIntegrator1D, RunErf_Midpoint)
    }
 }
 
-double testIntegrationMethod(int ndim, std::string const &label)
+double testIntegrationMethod(int ndim, std::string const &label, bool batchEvaluation = false)
 {
    constexpr bool verbose = false;
 
@@ -383,6 +383,7 @@ double testIntegrationMethod(int ndim, std::string const &label)
    }
 
    RooNumIntConfig cfg(*func.getIntegratorConfig());
+   cfg.getConfigSection("RooIntegrator1D").setCatLabel("batchEvaluation", batchEvaluation ? "On" : "Off");
 
    if (ndim == 2) {
       cfg.method2D().setLabel(label.c_str());
@@ -431,3 +432,20 @@ TEST(RooRombergIntegrator, CompareToReference)
       EXPECT_FLOAT_EQ(res, references2d[i]) << methods2d[i];
    }
 }
+
+// The integrand can be evaluated at all the points of a refinement step at
+// once with the RooFit::Evaluator. This must not change the results.
+TEST(RooRombergIntegrator, BatchEvaluation)
+{
+   RooHelpers::LocalChangeMsgLevel changeMsgLvl(RooFit::WARNING);
+
+   std::vector<std::string> methods1d{"RooIntegrator1D", "RooSegmentedIntegrator1D"};
+   std::vector<std::string> methods2d{"RooIntegrator2D", "RooSegmentedIntegrator2D"};
+
+   for (std::string const &method : methods1d) {
+      EXPECT_FLOAT_EQ(testIntegrationMethod(1, method, true), testIntegrationMethod(1, method)) << method;
+   }
+   for (std::string const &method : methods2d) {
+      EXPECT_FLOAT_EQ(testIntegrationMethod(2, method, true), testIntegrationMethod(2, method)) << method;
+   }
+}
@@ -24,7 +24,9 @@
 #include <RooSimultaneous.h>
 #include <RooWorkspace.h>
 
+#include <RConfigure.h> // R__USE_IMT
 #include <TMath.h>
+#include <TROOT.h>
 
 #include "gtest_wrapper.h"
 
@@ -793,3 +795,84 @@ TEST(CreateNLL, CombineStyleConstraints)
    const double refNllVal = -nChannels * (std::log(proba / nChannels) + std::log(proba));
    EXPECT_FLOAT_EQ(nll->getVal(), refNllVal);
 }
+
+#ifdef R__USE_IMT
+// The multi-threaded CPU mode of the RooFit::Evaluator, enabled by implicit
+// multi-threading, evaluates the pdfs and the likelihood in chunks of events.
+// It has to give the same likelihood as the single-threaded evaluation.
+TEST(RooNLLVarNew, MultiThreadedEvaluator)
+{
+   RooHelpers::LocalChangeMsgLevel changeMsgLvl(RooFit::WARNING);
+   RooRandom::randomGenerator()->SetSeed(1337);
+
+   RooWorkspace ws;
+   ws.factory("SUM::model(f[0.3, 0, 1] * Gaussian::gauss(x[-10, 10], mu[0, -10, 10], sigma[1, 0.1, 10]),"
+              " Exponential::expo(x, c[-0.2, -1, 0]))");
+   RooAbsPdf &model = *ws.pdf("model");
+   RooRealVar &x = *ws.var("x");
+   RooRealVar &mu = *ws.var("mu");
+
+   std::unique_ptr<RooDataSet> data{model.generate(x, 100000)};
+
+   std::unique_ptr<RooAbsReal> nllRef{model.createNLL(*data, RooFit::EvalBackend::Cpu())};
+   ROOT::EnableImplicitMT(4);
+   std::unique_ptr<RooAbsReal> nllMT{model.createNLL(*data, RooFit::EvalBackend::Cpu())};
+
+   for (double muVal : {0.0, 0.5, -1.0}) {
+      mu.setVal(muVal);
+      const double ref = nllRef->getVal();
+      const double val = nllMT->getVal();
+      EXPECT_NEAR(val, ref, 1e-10 * std::abs(ref)) << "mu = " << muVal;
+      // the partial sums are combined in a fixed order
+      mu.setVal(muVal + 0.1);
+      nllMT->getVal();
+      mu.setVal(muVal);
+      EXPECT_EQ(nllMT->getVal(), val) << "mu = " << muVal;
+   }
+
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+// After the first evaluation, the RooFit::Evaluator only re-evaluates the nodes
+// depending on the parameters that changed. Check that the likelihood stays
+// correct when changing one or several parameters at a time.
+TEST(RooNLLVarNew, ChangeSubsetOfParameters)
+{
+   RooHelpers::LocalChangeMsgLevel changeMsgLvl(RooFit::WARNING);
+   RooRandom::randomGenerator()->SetSeed(1337);
+
+   RooWorkspace ws;
+   ws.factory("SUM::model(f[0.3, 0, 1] * Gaussian::gauss(x[-10, 10], mu[0, -10, 10], sigma[1, 0.1, 10]),"
+              " Exponential::expo(x, c[-0.2, -1, 0]))");
+   RooAbsPdf &model = *ws.pdf("model");
+   RooRealVar &x = *ws.var("x");
+   RooRealVar &mu = *ws.var("mu");
+   RooRealVar &sigma = *ws.var("sigma");
+   RooRealVar &c = *ws.var("c");
+   RooRealVar &f = *ws.var("f");
+
+   std::unique_ptr<RooDataSet> data{model.generate(x, 1000)};
+
+   std::unique_ptr<RooAbsReal> nllRef{model.createNLL(*data, RooFit::EvalBackend::Legacy())};
+   std::unique_ptr<RooAbsReal> nll{model.createNLL(*data, RooFit::EvalBackend::Cpu())};
+
+   auto check = [&](const char *what) { EXPECT_NEAR(nll->getVal(), nllRef->getVal(), 1e-8) << what; };
+
+   check("initial values");
+   mu.setVal(0.5);
+   check("mu changed");
+   c.setVal(-0.3);
+   check("c changed");
+   f.setVal(0.4);
+   check("f changed");
+   mu.setVal(-0.5);
+   sigma.setVal(1.5);
+   check("mu and sigma changed");
+   mu.setVal(0.2);
+   sigma.setVal(0.8);
+   c.setVal(-0.1);
+   f.setVal(0.6);
+   check("all parameters changed");
+   check("no parameter changed");
+}
@@ -5,6 +5,7 @@
 #include "RooHelpers.h"
 #include "RooGaussian.h"
 #include "RooArgList.h"
+#include "RooDataSet.h"
 #include "RooRealVar.h"
 #include "RooAbsReal.h"
 #include "RooProdPdf.h"
@@ -264,3 +265,38 @@ TEST(RooWorkspace, Issue_7809)
    ASSERT_EQ(static_cast<RooProdPdf*>(ws.pdf("p3"))->pdfList().size(), 2);
    ASSERT_EQ(static_cast<RooProduct*>(ws.function("p4"))->components().size(), 2);
 }
+
+/// Clones that share the datasets of the original workspace, which may be
+/// deleted before the clones.
+TEST(RooWorkspace, CloneSharingData)
+{
+   auto ws = std::make_unique<RooWorkspace>("ws");
+   ws->factory("Gaussian::gauss(x[-10,10],mean[0,-5,5],sigma[1,0.1,10])");
+   std::unique_ptr<RooDataSet> data{ws->pdf("gauss")->generate(*ws->var("x"), 100)};
+   data->SetName("data");
+   ws->import(*data);
+
+   auto clone1 = ws->cloneSharingData("clone1");
+   auto clone2 = clone1->cloneSharingData();
+   EXPECT_STREQ(clone1->GetName(), "clone1");
+   EXPECT_STREQ(clone2->GetName(), "clone1");
+
+   // The model is copied, the data is shared
+   EXPECT_NE(clone1->pdf("gauss"), ws->pdf("gauss"));
+   EXPECT_EQ(clone1->data("data"), ws->data("data"));
+   EXPECT_EQ(clone2->data("data"), ws->data("data"));
+
+   ws.reset();
+   clone2->var("mean")->setVal(0.5);
+   ASSERT_NE(clone2->data("data"), nullptr);
+   EXPECT_EQ(clone2->data("data")->numEntries(), 100);
+   EXPECT_DOUBLE_EQ(clone1->var("mean")->getVal(), 0.);
+
+   // Data imported afterwards belongs to the clone alone
+   std::unique_ptr<RooDataSet> data2{clone2->pdf("gauss")->generate(*clone2->var("x"), 10)};
+   data2->SetName("data2");
+   clone2->import(*data2);
+   clone2.reset();
+   EXPECT_EQ(clone1->data("data")->numEntries(), 100);
+   EXPECT_EQ(clone1->data("data2"), nullptr);
+}
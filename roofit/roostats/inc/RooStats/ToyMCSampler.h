@@ -80,6 +80,7 @@ class ToyMCSampler: public TestStatSampler {
       SamplingDistribution* GetSamplingDistribution(RooArgSet& paramPoint) override;
       virtual RooDataSet* GetSamplingDistributions(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributionsSingleWorker(RooArgSet& paramPoint);
+      RooDataSet* GetSamplingDistributionsMultiProcess(RooArgSet& paramPoint);
 
       virtual SamplingDistribution* AppendSamplingDistribution(
          RooArgSet& allParameters,
@@ -229,6 +230,11 @@ class ToyMCSampler: public TestStatSampler {
       /// calling with argument or nullptr deactivates proof
       void SetProofConfig(ProofConfig *pc = nullptr) { fProofConfig = pc; }
 
+      /// Distribute the toys over the given number of forked worker processes
+      /// when no ProofConfig is set. Not supported on Windows.
+      void SetNWorkers(unsigned int nWorkers) { fNWorkers = nWorkers; }
+      unsigned int GetNWorkers() const { return fNWorkers; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
 
    protected:
@@ -275,6 +281,7 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData = nullptr; ///< in dev
 
       ProofConfig *fProofConfig = nullptr; ///<!
+      unsigned int fNWorkers = 1;          ///<! number of worker processes for runs without PROOF
 
       mutable NuisanceParametersSampler *fNuisanceParametersSampler = nullptr; ///<!
 
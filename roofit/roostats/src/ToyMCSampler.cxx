@@ -27,6 +27,14 @@ TestStatistic.
 For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
+
+Without PROOF, the toys can be distributed over several processes on the
+local machine with SetNWorkers(). Each worker is a forked copy of the
+current process, so it has its own copy of the model, and it generates its
+toys with its own random seed. The seeds are drawn from RooRandom in the
+parent process, so the results are reproducible for a given seed and number
+of workers. The sampling distributions of the workers are merged in the
+parent process.
 */
 
 #include "RooStats/ToyMCSampler.h"
@@ -50,6 +58,14 @@ ToyMCStudy with the RooStudyManager.
 
 #include "TMath.h"
 
+#include <algorithm>
+#include <cmath>
+
+#ifndef _MSC_VER
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 
 using namespace RooFit;
 using std::endl;
@@ -267,8 +283,11 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
 {
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig) {
+      if (fNWorkers > 1)
+         return GetSamplingDistributionsMultiProcess(paramPointIn);
       return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }
 
    // ======= P A R A L L E L   R U N =======
    if (!CheckConfig()){
@@ -309,6 +328,68 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Distribute the toys over fNWorkers forked processes, which each run
+/// GetSamplingDistributionsSingleWorker() with their share of the toys, and
+/// merge their results.
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProcess(RooArgSet& paramPointIn)
+{
+#ifdef _MSC_VER
+   oocoutW(nullptr, InputArguments)
+      << "ToyMCSampler: running with several worker processes is not supported on Windows, running serially." << endl;
+   return GetSamplingDistributionsSingleWorker(paramPointIn);
+#else
+   if (!CheckConfig()){
+      oocoutE(nullptr, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   const unsigned int nWorkers = std::max(1u, std::min<unsigned int>(fNWorkers, std::max(fNToys, 1)));
+
+   // Draw the seeds of the workers here, such that the result does not depend
+   // on the scheduling of the workers.
+   std::vector<UInt_t> seeds(nWorkers);
+   for (UInt_t &seed : seeds) {
+      seed = RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max());
+   }
+
+   // Each worker is a fork of this process, so the members can be changed
+   // there without affecting the parent.
+   const Int_t totToys = fNToys;
+   const double totToysInTails = fToysInTails;
+   const double totMaxToys = fMaxToys;
+   auto work = [&](unsigned int iWorker) {
+      RooRandom::randomGenerator()->SetSeed(seeds[iWorker]);
+      fNToys = totToys / nWorkers + (iWorker < totToys % nWorkers ? 1 : 0);
+      fToysInTails = std::ceil(totToysInTails / nWorkers);
+      fMaxToys = std::ceil(totMaxToys / nWorkers);
+      return GetSamplingDistributionsSingleWorker(paramPointIn);
+   };
+
+   oocoutP(nullptr, Generation) << "ToyMCSampler: generating " << totToys << " toys in " << nWorkers
+                                << " worker processes" << endl;
+
+   ROOT::TProcessExecutor executor(nWorkers);
+   std::vector<RooDataSet *> results = executor.Map(work, ROOT::TSeqU(nWorkers));
+
+   RooDataSet *output = nullptr;
+   for (RooDataSet *result : results) {
+      if (!result)
+         continue;
+      if (!output) {
+         output = result;
+      } else {
+         output->append(*result);
+         delete result;
+      }
+   }
+   return output;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the main function for serial runs. It is called automatically
 /// from inside GetSamplingDistribution when no ProofConfig is given.
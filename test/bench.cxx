@@ -15,14 +15,19 @@
 //     bench
 //   or
 //     bench -m   to stream objects memberwise
+//     bench -j results.json   to also store the timings in machine-readable form
 //
 // The test prints a summary table comparing performances for all above cases
 // (CPU, file size, compression factors).
+// With -j the timings of every step are written in the JSON layout of
+// Google Benchmark (one entry per step, times in seconds), so that they can
+// be compared between builds with the same tools as the rootbench results.
 // Reference numbers on a Pentium IV 2.4 Ghz machine are given as reference.
 //      Authors:  Rene Brun, Markus Frank
 
 #include "TROOT.h"
 #include "TClonesArray.h"
+#include "TDatime.h"
 #include "TStopwatch.h"
 #include "TSystem.h"
 #include "TStreamerInfo.h"
@@ -102,6 +107,47 @@ template <class TGen> TBenchData runTest(const char *name, int nevents, int nhit
    return data;
 }
 
+void writeJSON(const char *filename, const vector<TBenchData> &results)
+{
+   FILE *fp = fopen(filename, "w");
+   if (!fp) {
+      printf("bench: cannot open %s for writing\n", filename);
+      return;
+   }
+
+   SysInfo_t info;
+   gSystem->GetSysInfo(&info);
+
+   fprintf(fp, "{\n  \"context\": {\n");
+   fprintf(fp, "    \"date\": \"%s\",\n", TDatime().AsSQLString());
+   fprintf(fp, "    \"host_name\": \"%s\",\n", gSystem->HostName());
+   fprintf(fp, "    \"executable\": \"bench\",\n");
+   fprintf(fp, "    \"num_cpus\": %d,\n", info.fCpus);
+   fprintf(fp, "    \"root_version\": \"%s\"\n", gROOT->GetVersion());
+   fprintf(fp, "  },\n  \"benchmarks\": [");
+
+   bool first = true;
+   auto entry = [&](const TBenchData &d, const char *step, Double_t rt, Double_t cp, Long64_t nbytes) {
+      fprintf(fp, "%s\n    {\"name\": \"%s/%s\", \"run_type\": \"iteration\", \"iterations\": 1, "
+                  "\"real_time\": %g, \"cpu_time\": %g, \"time_unit\": \"s\"",
+              first ? "" : ",", d.fName.Data(), step, rt, cp);
+      if (nbytes >= 0)
+         fprintf(fp, ", \"bytes\": %lld", nbytes);
+      fprintf(fp, "}");
+      first = false;
+   };
+   for (auto &d : results) {
+      entry(d, "fill", d.rt1, d.cp1, -1);
+      entry(d, "write_comp0", d.rt2w, d.cp2w, d.nbytes1);
+      entry(d, "read_comp0", d.rt2r, d.cp2r, -1);
+      entry(d, "write_comp1", d.rt3w, d.cp3w, d.nbytes3);
+      entry(d, "read_comp1", d.rt3r, d.cp3r, -1);
+   }
+   fprintf(fp, "\n  ]\n}\n");
+   fclose(fp);
+   printf("bench: timings written to %s\n", filename);
+}
+
 template <class TGen> TBenchData runTest(const char *name, int nevents, int nhits, int splitlevel, Double_t &cptot, vector<TBenchData> &results)
 {
    TBenchData data = runTest<TGen>( name, nevents, nhits, splitlevel);
@@ -118,12 +164,15 @@ int main(int argc, char **argv)
    bool writereferences = false;
    bool memberwise = false;
    bool shortrun = false;
+   const char *jsonfile = nullptr;
 
    TVirtualStreamerInfo::SetStreamMemberWise(kFALSE);
    // by default stream objects objectwise
    // if program option "-m" is specified, stream memberwise
    for(int a=1; a<argc; ++a) {
-      if (strstr(argv[a],"-m")) {
+      if (!strcmp(argv[a],"-j") && a+1 < argc) {
+         jsonfile = argv[++a];
+      } else if (strstr(argv[a],"-m")) {
          TVirtualStreamerInfo::SetStreamMemberWise(kTRUE);
          printf("bench option -m specified. Streaming objects memberwise\n");
          memberwise = true;
@@ -338,6 +387,9 @@ int main(int argc, char **argv)
    printf("* Estimated ROOTMARKS         %8.2f      800.00                            *\n",rootmarks);
    printf("******************************************************************************\n");
 
+   if (jsonfile)
+      writeJSON(jsonfile, results);
+
    if (writereferences) {
       for(unsigned int t=0; t<results.size() && t<references.size(); ++t) {
          printf("references.push_back( TBenchData( \"%s\", %6.2f, %6.2f, %lld, %lld, %6.2f, %6.2f, %6.2f, %6.2f ) );\n",
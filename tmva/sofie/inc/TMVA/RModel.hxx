@@ -25,6 +25,10 @@ private:
 
    std::vector<std::unique_ptr<ROperator>> fOperators;
 
+   // offsets of the intermediate float tensors in a memory pool shared by tensors with disjoint lifetimes
+   std::unordered_map<std::string, size_t> fIntermediateMemoryOffsets; //!
+   size_t fIntermediateMemorySize = 0; //! size of the memory pool (in number of floats)
+
    const std::string SP = "   ";
 
 public:
@@ -84,6 +88,8 @@ public:
    bool IsInitializedTensor(const std::string &name) const;
    bool IsDynamicTensor(const std::string &name) const;
    bool IsInputTensor(const std::string &name) const;
+   // number of operators reading the tensor, as declared by the operators
+   size_t GetNumberOfTensorReaders(const std::string &name) const;
 
    // Add intermediate tensor
    void AddIntermediateTensor(std::string tensor_name, ETensorType type, std::vector<Dim> dim_shape);
@@ -100,6 +106,8 @@ public:
    std::shared_ptr<void> GetInitializedTensorData(std::string tensor_name);
 
    void Initialize(int batchSize = -1, bool verbose = false);
+   void FuseOperators(bool verbose = false);
+   void PlanIntermediateMemory(bool verbose = false);
    void GenerateInitializedTensorInfo();
    void GenerateIntermediateTensorInfo();
    void GenerateDynamicTensorInfo();
@@ -141,6 +149,7 @@ public:
    void HeadInitializedTensors(std::string name, int n_print = 50);
 
    bool UseSession() const { return fUseSession; }
+   bool UseInt8Gemm() const { return fUseInt8Gemm; }
 
    // Use the ClassDef macro to allow definition of custom streaming
    ClassDefNV(RModel, 2);
@@ -26,6 +26,7 @@ enum class Options {
    kRootBinaryWeightFile = 0x4,
    kGNN = 0x8,
    kGNNComponent = 0x10,
+   kInt8Gemm = 0x20, // quantize the weights and inputs of Gemm operators to int8
 };
 
 enum class WeightFileType { None, RootBinary, Text };
@@ -53,6 +54,7 @@ protected:
    bool fUseSession = true;
    bool fIsGNN = false;
    bool fIsGNNComponent = false;
+   bool fUseInt8Gemm = false; //! set by the kInt8Gemm option of Generate
 
 public:
    /**
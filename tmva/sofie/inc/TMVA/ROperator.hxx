@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 #include "TMVA/SOFIE_common.hxx"
 //#include "RModel.hxx"
@@ -30,6 +31,24 @@ public:
    // generate session data members specific to operator
    virtual std::string GenerateSessionMembersCode(std::string /*opName*/) { return ""; }
    virtual std::string Header() { return "";}
+   // tensors read and written by the operator, used by RModel to share the memory of the intermediate tensors
+   // (empty if the operator does not declare them)
+   const std::vector<std::string> &GetOpInputTensors() const { return fInputTensorNames; }
+   const std::vector<std::string> &GetOpOutputTensors() const { return fOutputTensorNames; }
+   // true if the output can be written in the memory of an input of the same size which is not used afterwards
+   virtual bool CanWorkInPlace() const { return false; }
+
+   // fusion of operators, done by RModel before initializing the operators
+   // expression computing an element-wise unary operator from the input value `x` (empty for other operators)
+   virtual std::string GetElementwiseExpression(const std::string & /*x*/) const { return ""; }
+   // parameters of an operator computing y = scale[c] * x + shift[c], with c the channel (second dimension)
+   virtual bool GetChannelAffine(RModel &, std::vector<float> & /*scale*/, std::vector<float> & /*shift*/) const
+   {
+      return false;
+   }
+   // fuse `op`, the only reader of the first output of this operator, which then writes the output of `op`.
+   // Returns false if the two operators cannot be fused.
+   virtual bool Fuse(RModel &, std::unique_ptr<ROperator> & /*op*/) { return false; }
 
 
    //virtual void Forward_reference() = 0;
@@ -40,6 +59,39 @@ protected:
 
    const std::string SP = "   ";    ///< space used to correctly indent the generated C++ code
    bool fUseSession = false;        ///< flag to identify if using the session class
+   std::vector<std::string> fInputTensorNames;  ///< names of the tensors read by the operator
+   std::vector<std::string> fOutputTensorNames; ///< names of the tensors written by the operator
+   std::vector<std::unique_ptr<ROperator>> fFusedOperators; ///< element-wise operators applied to the output
+
+   // fuse the element-wise operator `op`, renaming `output` (the first output) to the output of `op`
+   bool FuseElementwise(std::unique_ptr<ROperator> &op, std::string &output)
+   {
+      if (op->GetElementwiseExpression("x").empty())
+         return false;
+      output = op->GetOpOutputTensors()[0];
+      fOutputTensorNames[0] = output;
+      fFusedOperators.push_back(std::move(op));
+      return true;
+   }
+   // code assigning `value` to `output`, after applying the fused element-wise operators
+   std::string GenerateFusedAssignment(const std::string &output, const std::string &value, const std::string &indent) const
+   {
+      if (fFusedOperators.empty())
+         return indent + output + " = " + value + ";\n";
+      std::string code = indent + "{\n" + indent + SP + "float fused_value = " + value + ";\n";
+      for (auto &op : fFusedOperators)
+         code += indent + SP + "fused_value = " + op->GetElementwiseExpression("fused_value") + ";\n";
+      return code + indent + SP + output + " = fused_value;\n" + indent + "}\n";
+   }
+   // loop applying the fused element-wise operators in place to the tensor `name` of length `length`
+   std::string GenerateFusedOperatorsLoop(const std::string &name, const std::string &length) const
+   {
+      if (fFusedOperators.empty())
+         return "";
+      std::string code = SP + "for (size_t id = 0; id < " + length + " ; id++){\n";
+      code += GenerateFusedAssignment("tensor_" + name + "[id]", "tensor_" + name + "[id]", SP + SP);
+      return code + SP + "}\n";
+   }
 };
 
 
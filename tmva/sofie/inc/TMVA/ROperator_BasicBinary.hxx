@@ -63,7 +63,10 @@ private:
 public:
    ROperator_BasicBinary(){}
    ROperator_BasicBinary(std::string nameA, std::string nameB, std::string nameY):
-      fNA(UTILITY::Clean_name(nameA)), fNB(UTILITY::Clean_name(nameB)), fNY(UTILITY::Clean_name(nameY)){}
+      fNA(UTILITY::Clean_name(nameA)), fNB(UTILITY::Clean_name(nameB)), fNY(UTILITY::Clean_name(nameY)){
+         fInputTensorNames = { fNA, fNB };
+         fOutputTensorNames = { fNY };
+      }
 
    // type of output given input
    std::vector<ETensorType> TypeInference(std::vector<ETensorType> input) override {
@@ -129,8 +132,21 @@ public:
          fShapeY = fShapeA;
       }
       model.AddIntermediateTensor(fNY, model.GetTensorType(fNA), fShapeY);
+
+      fInputTensorNames = { fNA, fNB };
+      fOutputTensorNames = { fNY };
+      // the broadcasted tensors are written and read by this operator only
+      for (auto &name : { fNBroadcadstedA, fNBroadcadstedB }) {
+         if (!name.empty())
+            fOutputTensorNames.push_back(name);
+      }
    }
 
+   // element-wise operation: the output can overwrite an input of the same shape
+   bool CanWorkInPlace() const override { return true; }
+
+   bool Fuse(RModel &, std::unique_ptr<ROperator> &op) override { return FuseElementwise(op, fNY); }
+
    std::string GenerateInitCode() override {
       std::stringstream out;
       return out.str();
@@ -166,7 +182,9 @@ public:
       const std::string& nameA = fNBroadcadstedA.empty()? fNA : fNBroadcadstedA;
       const std::string& nameB = fNBroadcadstedB.empty()? fNB : fNBroadcadstedB;
       out << SP << "for (size_t id = 0; id < " << length << " ; id++){\n";
-      out << SP << SP << "tensor_" << fNY << "[id] = "  << BinaryOperatorTrait<T,Op>::Op( "tensor_" + nameA + "[id]" , "tensor_" + nameB + "[id]") <<  " ;\n";
+      out << GenerateFusedAssignment("tensor_" + fNY + "[id]",
+                                     BinaryOperatorTrait<T, Op>::Op("tensor_" + nameA + "[id]", "tensor_" + nameB + "[id]"),
+                                     SP + SP);
       out << SP << "}\n";
       return out.str();
    }
@@ -59,7 +59,17 @@ public:
 
    ROperator_BasicUnary(std::string nameX, std::string nameY)
       : fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY))
-   {}
+   {
+      fInputTensorNames = { fNX };
+      fOutputTensorNames = { fNY };
+   }
+
+   // element-wise operation: the output can overwrite the input
+   bool CanWorkInPlace() const override { return true; }
+
+   std::string GetElementwiseExpression(const std::string &x) const override { return UnaryOpTraits<T, Op>::Op(x); }
+
+   bool Fuse(RModel &, std::unique_ptr<ROperator> &op) override { return FuseElementwise(op, fNY); }
 
    std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input) override { return input; }
 
@@ -83,7 +93,7 @@ public:
       out << SP << "\n//---- Operator" << UnaryOpTraits<T, Op>::Name() << " " << OpName << "\n";
       size_t length = ConvertShapeToLength(fShapeX);
       out << SP << "for (size_t i = 0; i < " << length << "; i++) {\n";
-      out << SP << SP << "tensor_" << fNY << "[i] = " << UnaryOpTraits<T, Op>::Op("tensor_" + fNX + "[i]") << ";\n";
+      out << GenerateFusedAssignment("tensor_" + fNY + "[i]", GetElementwiseExpression("tensor_" + fNX + "[i]"), SP + SP);
       out << SP << "}\n";
       return out.str();
    }
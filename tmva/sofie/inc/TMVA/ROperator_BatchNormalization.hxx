@@ -52,6 +52,8 @@ public:
    fNB(UTILITY::Clean_name(nameB)), fNMean(UTILITY::Clean_name(nameMean)),
    fNVar(UTILITY::Clean_name(nameVar)), fNY(UTILITY::Clean_name(nameY))
    {
+      fInputTensorNames = { fNX, fNScale, fNB, fNMean, fNVar };
+      fOutputTensorNames = { fNY };
       if(std::is_same<T, float>::value){
       fType = "float";
       }
@@ -62,6 +64,38 @@ public:
    }
 
 
+   // Y is computed from a copy of X, which is skipped when they share their memory
+   bool CanWorkInPlace() const { return true; }
+
+   bool Fuse(RModel &, std::unique_ptr<ROperator> &op) { return FuseElementwise(op, fNY); }
+
+   // scale / sqrt(var + epsilon) and bias - mean * scale / sqrt(var + epsilon) per channel, from the
+   // parameters before they are broadcast to the shape of X by Initialize
+   bool GetChannelAffine(RModel &model, std::vector<float> &scale, std::vector<float> &shift) const {
+      if (fType != "float" || !fFusedOperators.empty())
+         return false;
+      size_t channels = 0;
+      for (auto &name : { fNScale, fNB, fNMean, fNVar }) {
+         if (!model.IsInitializedTensor(name) || model.GetTensorShape(name).size() != 1)
+            return false;
+         size_t length = model.GetTensorShape(name)[0];
+         if (channels != 0 && length != channels)
+            return false;
+         channels = length;
+      }
+      auto s = static_cast<float *>(model.GetInitializedTensorData(fNScale).get());
+      auto b = static_cast<float *>(model.GetInitializedTensorData(fNB).get());
+      auto m = static_cast<float *>(model.GetInitializedTensorData(fNMean).get());
+      auto v = static_cast<float *>(model.GetInitializedTensorData(fNVar).get());
+      scale.resize(channels);
+      shift.resize(channels);
+      for (size_t c = 0; c < channels; c++) {
+         scale[c] = s[c] / std::sqrt(v[c] + fepsilon);
+         shift[c] = b[c] - m[c] * scale[c];
+      }
+      return true;
+   }
+
    std::vector<ETensorType> TypeInference(std::vector<ETensorType> input) {
       ETensorType out = input[0];
       return {out};
@@ -197,7 +231,8 @@ public:
       out << SP << "constexpr int " << OpName << "_N =" << batchSize * channels * height * width << ";\n";
       out << SP << "constexpr int "<<OpName<< "_incx = 1;\n";
       out << SP << "constexpr int "<<OpName<< "_incy = 1;\n";
-      out << SP << "BLAS::scopy_(&" << OpName << "_N, " << "tensor_" << fNX << ", &" << OpName << "_incx," << "tensor_" << fNY << ", &" << OpName << "_incy);\n\n";
+      out << SP << "if (tensor_" << fNY << " != tensor_" << fNX << ")\n";
+      out << SP << SP << "BLAS::scopy_(&" << OpName << "_N, " << "tensor_" << fNX << ", &" << OpName << "_incx," << "tensor_" << fNY << ", &" << OpName << "_incy);\n\n";
 
       //// blas saxpy (Y = -Bmean + Y)
       out << SP << "float "<<OpName<< "_alpha = -1;\n";
@@ -213,6 +248,7 @@ public:
       out << SP <<OpName<< "_alpha = 1;\n";
       out << SP << "BLAS::saxpy_(&" << OpName << "_N, &" << OpName << "_alpha, " << "tensor_" << fNB << ", &" << OpName << "_incx, "
          << "tensor_" << fNY << ", &" << OpName << "_incy);\n\n";
+      out << GenerateFusedOperatorsLoop(fNY, std::to_string(n));
 
       return out.str();
    }
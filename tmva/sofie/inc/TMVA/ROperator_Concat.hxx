@@ -34,6 +34,8 @@
             fInputs.reserve(inputs.size());
             for (auto & name : inputs)
                fInputs.push_back(UTILITY::Clean_name(name));
+            fInputTensorNames = fInputs;
+            fOutputTensorNames = { fOutput };
          }
 
          std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
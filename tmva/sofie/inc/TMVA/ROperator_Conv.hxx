@@ -56,6 +56,8 @@ public:
       fNX(UTILITY::Clean_name(nameX)), fNW(UTILITY::Clean_name(nameW)),
       fNB(UTILITY::Clean_name(nameB)), fNY(UTILITY::Clean_name(nameY))
    {
+      fInputTensorNames = { fNX, fNW, fNB };
+      fOutputTensorNames = { fNY };
       if(std::is_same<T, float>::value) {
          fType = "float";
       } else {
@@ -72,6 +74,8 @@ public:
       fAttrPads(pads), fAttrStrides(strides),
       fNX(UTILITY::Clean_name(nameX)), fNW(UTILITY::Clean_name(nameW)), fNY(UTILITY::Clean_name(nameY))
    {
+      fInputTensorNames = { fNX, fNW };
+      fOutputTensorNames = { fNY };
       if(std::is_same<T, float>::value) {
          fType = "float";
       } else {
@@ -194,6 +198,53 @@ public:
       return ret;
    }
 
+   // fuse an activation, or fold a batch normalization into the weights and the bias
+   bool Fuse(RModel &model, std::unique_ptr<ROperator> &op) {
+      if (FuseElementwise(op, fNY))
+         return true;
+      std::vector<float> scale, shift;
+      if (!fFusedOperators.empty() || fType != "float" || !op->GetChannelAffine(model, scale, shift))
+         return false;
+      // the weights and the bias are modified, they must not be used by other operators
+      if (!model.IsInitializedTensor(fNW) || model.GetNumberOfTensorReaders(fNW) != 1)
+         return false;
+      auto shapeW = model.GetTensorShape(fNW);
+      size_t channels = shapeW[0];
+      if (scale.size() != channels)
+         return false;
+      std::string nameB = fNB.empty() ? fNW + "bias" : fNB;
+      if (fNB.empty() ? model.CheckIfTensorAlreadyExist(nameB)
+                      : !model.IsInitializedTensor(fNB) || model.GetNumberOfTensorReaders(fNB) != 1 ||
+                           ConvertShapeToLength(model.GetTensorShape(fNB)) != channels)
+         return false;
+
+      size_t length = ConvertShapeToLength(shapeW);
+      size_t channelLength = length / channels;
+      auto w = static_cast<float *>(model.GetInitializedTensorData(fNW).get());
+      std::shared_ptr<void> newW(new float[length], std::default_delete<float[]>());
+      auto foldedW = static_cast<float *>(newW.get());
+      for (size_t c = 0; c < channels; c++) {
+         for (size_t i = 0; i < channelLength; i++)
+            foldedW[c * channelLength + i] = w[c * channelLength + i] * scale[c];
+      }
+      auto b = fNB.empty() ? nullptr : static_cast<float *>(model.GetInitializedTensorData(fNB).get());
+      std::shared_ptr<void> newB(new float[channels], std::default_delete<float[]>());
+      auto foldedB = static_cast<float *>(newB.get());
+      for (size_t c = 0; c < channels; c++)
+         foldedB[c] = (b ? b[c] * scale[c] : 0.f) + shift[c];
+
+      model.UpdateInitializedTensor(fNW, model.GetTensorType(fNW), shapeW, newW);
+      if (fNB.empty())
+         model.AddInitializedTensor(nameB, ETensorType::FLOAT, {channels}, newB);
+      else
+         model.UpdateInitializedTensor(fNB, model.GetTensorType(fNB), {channels}, newB);
+      fNB = nameB;
+      fNY = op->GetOpOutputTensors()[0];
+      fInputTensorNames = { fNX, fNW, fNB };
+      fOutputTensorNames = { fNY };
+      return true;
+   }
+
    void Initialize(RModel& model) {
       fUseSession = model.UseSession();
       if (!model.CheckIfTensorAlreadyExist(fNX)) {
@@ -257,6 +308,10 @@ public:
             }
          }
       }
+      fInputTensorNames = { fNX, fNW };
+      if (!fNB2.empty())
+         fInputTensorNames.push_back(fNB2);
+      fOutputTensorNames = { fNY };
    }
 
    std::string GenerateInitCode() {
@@ -532,6 +587,8 @@ public:
 
       }
       out << SP << "}\n"; // end of batch size loop
+      // activation fused with the convolution
+      out << GenerateFusedOperatorsLoop(fNY, std::to_string(ConvertShapeToLength(fShapeY)));
 
       return out.str();
       }
@@ -29,6 +29,8 @@ public:
    ROperator_Elu(float alpha,std::string nameX, std::string nameY):
    falpha(alpha),fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY))
    {
+      fInputTensorNames = { fNX };
+      fOutputTensorNames = { fNY };
       if(std::is_same<T, float>::value){
          fType = "float";
       }
@@ -37,6 +39,17 @@ public:
 		}
    }
 
+   // element-wise operation: the output can overwrite the input
+   bool CanWorkInPlace() const { return true; }
+
+   std::string GetElementwiseExpression(const std::string &x) const {
+      std::stringstream alpha;
+      alpha << std::setprecision(std::numeric_limits<float>::max_digits10) << falpha;
+      return "((" + x + " >= 0 )? " + x + " : " + alpha.str() + " * std::exp(" + x + ") - 1)";
+   }
+
+   bool Fuse(RModel &, std::unique_ptr<ROperator> &op) { return FuseElementwise(op, fNY); }
+
    std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
       return input;
    }
@@ -63,11 +76,9 @@ public:
       std::stringstream out;
       size_t length = ConvertShapeToLength(fShape);
 
-      out << SP << "float " << OpName << "_alpha = " << std::setprecision(std::numeric_limits<float>::max_digits10) << falpha << ";\n";
-
       out << "\n//------ ELU \n";
       out << SP << "for (int id = 0; id < " << length << " ; id++){\n";
-      out << SP << SP << "tensor_" << fNY << "[id] = ((tensor_" << fNX << "[id] >= 0 )? tensor_" << fNX << "[id] : "<< OpName << "_alpha * std::exp(tensor_"<< fNX<<"[id]) - 1);\n";
+      out << GenerateFusedAssignment("tensor_" + fNY + "[id]", GetElementwiseExpression("tensor_" + fNX + "[id]"), SP + SP);
       out << SP << "}\n";
       return out.str();
    }
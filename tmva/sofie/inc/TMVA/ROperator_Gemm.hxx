@@ -24,6 +24,7 @@ namespace SOFIE{
 
    private:
       bool fIsDynamic = false;
+      bool fUseInt8 = false; // int8 weights and inputs with int32 accumulation
 
       float fAttrAlpha = 1.0;
       float fAttrBeta = 1.0;
@@ -48,6 +49,8 @@ namespace SOFIE{
          fAttrAlpha(alpha), fAttrBeta(beta), fAttrTransA(transA), fAttrTransB(transB), fNA(UTILITY::Clean_name(nameA)),
          fNB(UTILITY::Clean_name(nameB)), fNY(UTILITY::Clean_name(nameY))
       {
+         fInputTensorNames = { fNA, fNB };
+         fOutputTensorNames = { fNY };
          fType = "float";
          static_assert(std::is_same_v<T, float>,
                   "TMVA::SOFIE - Unsupported type parsing a Gemm operator");
@@ -57,6 +60,8 @@ namespace SOFIE{
          fAttrAlpha(alpha), fAttrBeta(beta), fAttrTransA(transA), fAttrTransB(transB), fNA(UTILITY::Clean_name(nameA)),
          fNB(UTILITY::Clean_name(nameB)), fNC(UTILITY::Clean_name(nameC)), fNY(UTILITY::Clean_name(nameY))
       {
+         fInputTensorNames = { fNA, fNB, fNC };
+         fOutputTensorNames = { fNY };
          fType = "float";
          static_assert(std::is_same_v<T, float>,
                   "TMVA::SOFIE - Unsupported type parsing a Gemm operator");
@@ -104,6 +109,8 @@ namespace SOFIE{
 
 
 
+      bool Fuse(RModel &, std::unique_ptr<ROperator> &op) { return FuseElementwise(op, fNY); }
+
       void Initialize(RModel& model){
          //TODO: propagate A or B as specified by ONNX standard
 
@@ -204,13 +211,54 @@ namespace SOFIE{
          else
             model.AddDynamicTensor(fNY, model.GetTensorType(fNA), fShapeY);
 
+         // the weights are quantized once in the Session constructor, so they must be known
+         fUseInt8 = model.UseInt8Gemm() && fAttrTransA == 0 && model.IsInitializedTensor(fNB);
+         if (fUseInt8)
+            model.AddNeededStdLib("cmath");
+
+         fInputTensorNames = { fNA, fNB };
+         if (!fNC2.empty())
+            fInputTensorNames.push_back(fNC2);
+         fOutputTensorNames = { fNY };
+
          model.AddNeededStdLib("algorithm");
 
       }
 
+      std::string GenerateSessionMembersCode(std::string /*opName*/)
+      {
+         if (!fUseInt8)
+            return "";
+         auto n = (fAttrTransB ? fShapeB[0].GetVal() : fShapeB[1].GetVal());
+         auto k = (fAttrTransB ? fShapeB[1].GetVal() : fShapeB[0].GetVal());
+         std::stringstream out;
+         // weights stored as n rows of length k, so that the dot products read contiguous memory
+         out << "std::vector<int8_t> fInt8_" << fNY << "_B = std::vector<int8_t>(" << n << " * " << k << ");\n";
+         out << "std::vector<float> fInt8_" << fNY << "_Bscale = std::vector<float>(" << n << ");\n";
+         out << "std::vector<int8_t> fInt8_" << fNY << "_A = std::vector<int8_t>(" << k << ");\n";
+         return out.str();
+      }
+
       std::string GenerateInitCode()
       {
          std::stringstream out;
+         if (fUseInt8) {
+            auto n = (fAttrTransB ? fShapeB[0].GetVal() : fShapeB[1].GetVal());
+            auto k = (fAttrTransB ? fShapeB[1].GetVal() : fShapeB[0].GetVal());
+            std::string index = fAttrTransB ? "j * " + k + " + l" : "l * " + n + " + j";
+            // symmetric quantization with one scale per output column
+            out << "//--- quantize weight tensor " << fNB << " to int8 for Gemm op\n";
+            out << SP << "for (int j = 0; j < " << n << "; j++) {\n";
+            out << SP << SP << "float amax = 0;\n";
+            out << SP << SP << "for (int l = 0; l < " << k << "; l++)\n";
+            out << SP << SP << SP << "amax = std::max(amax, std::abs(tensor_" << fNB << "[" << index << "]));\n";
+            out << SP << SP << "float scale = (amax > 0) ? amax / 127.f : 1.f;\n";
+            out << SP << SP << "fInt8_" << fNY << "_Bscale[j] = scale;\n";
+            out << SP << SP << "for (int l = 0; l < " << k << "; l++)\n";
+            out << SP << SP << SP << "fInt8_" << fNY << "_B[j * " << k << " + l] = static_cast<int8_t>(std::lround(tensor_"
+                << fNB << "[" << index << "] / scale));\n";
+            out << SP << "}\n";
+         }
          // generate initialization code for broadcasting of bias tensor
          if (fShapeC.size() != fShapeY.size() && fNC != fNC2) {
             // we broadcast here always C in Y output, so target shape is the one of Y
@@ -237,9 +285,11 @@ namespace SOFIE{
             throw std::runtime_error("TMVA SOFIE Gemm Op called to Generate without being initialized first");
          }
          std::stringstream out;
-         out << "\n//--------- Gemm\n";
-         out << SP << "char " << OpName << "_transA = " << (fAttrTransA ? "\'t\'" : "\'n\'") << ";\n";
-         out << SP << "char " << OpName << "_transB = " << (fAttrTransB ? "\'t\'" : "\'n\'") << ";\n";
+         out << "\n//--------- Gemm" << (fUseInt8 ? " (int8)" : "") << "\n";
+         if (!fUseInt8) {
+            out << SP << "char " << OpName << "_transA = " << (fAttrTransA ? "\'t\'" : "\'n\'") << ";\n";
+            out << SP << "char " << OpName << "_transB = " << (fAttrTransB ? "\'t\'" : "\'n\'") << ";\n";
+         }
 
          auto m = (fAttrTransA ? fShapeA[1].GetVal() : fShapeA[0].GetVal());
          auto n = (fAttrTransB ? fShapeB[0].GetVal() : fShapeB[1].GetVal());
@@ -251,8 +301,10 @@ namespace SOFIE{
          out << SP << "int " << OpName << "_k = " << k << ";\n";
          out << SP << "float " << OpName << "_alpha = " << std::setprecision(std::numeric_limits<float>::max_digits10) << fAttrAlpha << ";\n";
          out << SP << "float " << OpName << "_beta = " << std::setprecision(std::numeric_limits<float>::max_digits10) << fAttrBeta << ";\n";
-         out << SP << "int " << OpName << "_lda = " << (fAttrTransA ? m : k) << ";\n";
-         out << SP << "int " << OpName << "_ldb = " << (fAttrTransB ? k : n) << ";\n";
+         if (!fUseInt8) {
+            out << SP << "int " << OpName << "_lda = " << (fAttrTransA ? m : k) << ";\n";
+            out << SP << "int " << OpName << "_ldb = " << (fAttrTransB ? k : n) << ";\n";
+         }
          // case bias is present
          if (!fNC.empty()){
             if (fNC2 == fNC) {
@@ -274,11 +326,38 @@ namespace SOFIE{
                throw std::runtime_error("TMVA SOFIE Gemm Op " + OpName + " Bias tensor is not present but beta value in Gemm is not zero");
             }
          }
-         if (fType == "float"){
+         if (fUseInt8) {
+            // the rows of A are quantized with their own scale, the products are accumulated in int32
+            // in a loop which the compiler can vectorize with the integer dot product instructions
+            out << SP << "for (int i = 0; i < " << OpName << "_m; i++) {\n";
+            out << SP << SP << "const float * a = tensor_" << fNA << " + i * " << OpName << "_k;\n";
+            out << SP << SP << "float amax = 0;\n";
+            out << SP << SP << "for (int l = 0; l < " << OpName << "_k; l++)\n";
+            out << SP << SP << SP << "amax = std::max(amax, std::abs(a[l]));\n";
+            out << SP << SP << "float scaleA = (amax > 0) ? amax / 127.f : 1.f;\n";
+            out << SP << SP << "for (int l = 0; l < " << OpName << "_k; l++)\n";
+            out << SP << SP << SP << "fInt8_" << fNY << "_A[l] = static_cast<int8_t>(std::lround(a[l] / scaleA));\n";
+            out << SP << SP << "for (int j = 0; j < " << OpName << "_n; j++) {\n";
+            out << SP << SP << SP << "const int8_t * b = fInt8_" << fNY << "_B.data() + j * " << OpName << "_k;\n";
+            out << SP << SP << SP << "int32_t sum = 0;\n";
+            out << SP << SP << SP << "for (int l = 0; l < " << OpName << "_k; l++)\n";
+            out << SP << SP << SP << SP << "sum += int32_t(fInt8_" << fNY << "_A[l]) * int32_t(b[l]);\n";
+            out << SP << SP << SP << "float y = " << OpName << "_alpha * scaleA * fInt8_" << fNY << "_Bscale[j] * sum;\n";
+            std::string y = "tensor_" + fNY + "[i * " + OpName + "_n + j]";
+            if (!fNC.empty())
+               out << SP << SP << SP << y << " = y + " << OpName << "_beta * " << y << ";\n";
+            else
+               out << SP << SP << SP << y << " = y;\n";
+            out << SP << SP << "}\n";
+            out << SP << "}\n";
+            out << GenerateFusedOperatorsLoop(fNY, length);
+         } else if (fType == "float"){
             out << SP << "BLAS::sgemm_(&" << OpName << "_transB, &" << OpName << "_transA, &" << OpName
              << "_n, &" << OpName << "_m, &" << OpName << "_k, &" << OpName << "_alpha, " << "tensor_" << fNB
              << ", &" << OpName << "_ldb, " << "tensor_" << fNA << ", &" << OpName << "_lda, &" << OpName << "_beta, " << "tensor_" << fNY << ", &"
              << OpName << "_n);\n";
+            // activation fused with the Gemm
+            out << GenerateFusedOperatorsLoop(fNY, length);
           }
 
           return out.str();
@@ -24,7 +24,19 @@ private:
 public:
    ROperator_Relu(){}
    ROperator_Relu(std::string nameX, std::string nameY):
-      fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY)){}
+      fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY)){
+         fInputTensorNames = { fNX };
+         fOutputTensorNames = { fNY };
+      }
+
+   // element-wise operation: the output can overwrite the input
+   bool CanWorkInPlace() const { return true; }
+
+   std::string GetElementwiseExpression(const std::string &x) const {
+      return "((" + x + " > 0 )? " + x + " : 0)";
+   }
+
+   bool Fuse(RModel &, std::unique_ptr<ROperator> &op) { return FuseElementwise(op, fNY); }
 
    std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
       return input;
@@ -55,7 +67,7 @@ public:
       auto length = ConvertDynamicShapeToLength(fShape);
       out << "\n//------ RELU\n";
       out << SP << "for (int id = 0; id < " << length << " ; id++){\n";
-      out << SP << SP << "tensor_" << fNY << "[id] = ((tensor_" << fNX << "[id] > 0 )? tensor_" << fNX << "[id] : 0);\n";
+      out << GenerateFusedAssignment("tensor_" + fNY + "[id]", GetElementwiseExpression("tensor_" + fNX + "[id]"), SP + SP);
       out << SP << "}\n";
       return out.str();
    }
@@ -39,6 +39,8 @@ public:
       : fOpMode(opMode), fNData(UTILITY::Clean_name(nameData)), fNShape(UTILITY::Clean_name(nameShape)),
       fNOutput(UTILITY::Clean_name(nameOutput))
    {
+      fInputTensorNames = { fNData };
+      fOutputTensorNames = { fNOutput };
       if (opMode == Reshape) fAllowZero = attr_value;
       if (opMode == Flatten) fAxis = attr_value;
    }
@@ -50,6 +52,8 @@ public:
         fAttrAxes(attrAxes)
    {
       assert(fOpMode == Squeeze || fOpMode == Unsqueeze);
+      fInputTensorNames = { fNData };
+      fOutputTensorNames = { fNOutput };
    }
 
    // output type is same as input
@@ -24,7 +24,19 @@ private:
 public:
    ROperator_Selu(){}
    ROperator_Selu(std::string nameX, std::string nameY):
-      fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY)){}
+      fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY)){
+         fInputTensorNames = { fNX };
+         fOutputTensorNames = { fNY };
+      }
+
+   // element-wise operation: the output can overwrite the input
+   bool CanWorkInPlace() const { return true; }
+
+   std::string GetElementwiseExpression(const std::string &x) const {
+      return "1.0507009873554804934193349852946 * (std::max(float(0.0), " + x + ") + std::min(0.0, 1.6732632423543772848170429916717 * (std::exp(" + x + ")-1)))";
+   }
+
+   bool Fuse(RModel &, std::unique_ptr<ROperator> &op) { return FuseElementwise(op, fNY); }
 
    std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
       return input;
@@ -55,7 +67,7 @@ public:
          length *= i;
       }
       out << "\t" << "for (int id = 0; id < " << length << " ; id++){\n";
-      out << "\t\t" << "tensor_" << fNY << "[id] = 1.0507009873554804934193349852946 * (std::max(float(0.0), tensor_"  << fNX << "[id]) + std::min(0.0, 1.6732632423543772848170429916717 * (std::exp(" << "tensor_" << fNX << "[id]" <<")-1)));\n";
+      out << GenerateFusedAssignment("tensor_" + fNY + "[id]", GetElementwiseExpression("tensor_" + fNX + "[id]"), "\t\t");
       out << "\t}\n";
       return out.str();
    }
@@ -242,6 +242,9 @@ T* BroadcastTensor(const T* data, const std::vector<size_t>& shape, const std::v
    size_t targetLength = ConvertShapeToLength(targetShape);
    // newShape is an aray of size equal to dimension along which we are broadcasting the tensor
    T* broadcastedData = new T[targetLength];
+   // nothing to broadcast to an empty tensor, e.g. for a dynamic shape with a batch size of zero
+   if (targetLength == 0)
+      return broadcastedData;
    std::copy(data, data + curLength, broadcastedData);
    // Product of the previous dimensions of targetShape
    size_t arrayNum = 1;
@@ -28,6 +28,8 @@ RModel::RModel(RModel&& other) {
     fOperators = std::move(other.fOperators);
     fInitializedTensors = std::move(other.fInitializedTensors);
     fIntermediateTensorInfos = std::move(other.fIntermediateTensorInfos);
+    fIntermediateMemoryOffsets = std::move(other.fIntermediateMemoryOffsets);
+    fIntermediateMemorySize = other.fIntermediateMemorySize;
     fName = other.fName;
     fFileName = other.fFileName;
     fParseTime = other.fParseTime;
@@ -44,6 +46,8 @@ RModel& RModel::operator=(RModel&& other) {
     fOperators = std::move(other.fOperators);
     fInitializedTensors = std::move(other.fInitializedTensors);
     fIntermediateTensorInfos = std::move(other.fIntermediateTensorInfos);
+    fIntermediateMemoryOffsets = std::move(other.fIntermediateMemoryOffsets);
+    fIntermediateMemorySize = other.fIntermediateMemorySize;
     fName = other.fName;
     fFileName = other.fFileName;
     fParseTime = other.fParseTime;
@@ -193,6 +197,16 @@ bool RModel::IsInputTensor(const std::string& tensorName) const {
 }
 
 // generic addition of a tensor
+size_t RModel::GetNumberOfTensorReaders(const std::string &name) const {
+    size_t n = 0;
+    for (auto &op : fOperators) {
+        auto &inputs = op->GetOpInputTensors();
+        if (std::find(inputs.begin(), inputs.end(), name) != inputs.end())
+            n++;
+    }
+    return n;
+}
+
 void RModel::AddIntermediateTensor(std::string tensor_name, ETensorType type, std::vector<Dim> dim_shape) {
    auto int_shape = ConvertShapeToInt(dim_shape);
    if (!int_shape.empty())
@@ -339,6 +353,8 @@ void RModel::Initialize(int batchSize, bool verbose) {
       if (!modelHasWeights)
          fUseWeightFile = false;
    }
+   FuseOperators(verbose);
+
    // Go through model and initialize each operator
    int i = 0;
    for (auto &op : fOperators) {
@@ -351,6 +367,157 @@ void RModel::Initialize(int batchSize, bool verbose) {
    }
 }
 
+void RModel::FuseOperators(bool verbose) {
+   // Fuse into an operator the operator reading its output, when it is the only reader: element-wise operators
+   // are applied directly to the result (e.g. the activation after a Gemm), a batch normalization following a
+   // convolution is folded in its weights. This is done before the operators are initialized.
+   // the readers of the tensors are known only if all operators declare them
+   for (auto &op : fOperators) {
+      if (op->GetOpOutputTensors().empty())
+         return;
+   }
+   size_t nFused = 0;
+   for (size_t id = 0; id < fOperators.size(); id++) {
+      while (true) {
+         const std::string output = fOperators[id]->GetOpOutputTensors()[0];
+         // output tensors of the model must be kept
+         if (std::find(fOutputTensorNames.begin(), fOutputTensorNames.end(), output) != fOutputTensorNames.end())
+            break;
+         size_t reader = 0;
+         for (size_t j = id + 1; j < fOperators.size(); j++) {
+            auto &inputs = fOperators[j]->GetOpInputTensors();
+            if (std::find(inputs.begin(), inputs.end(), output) != inputs.end()) {
+               reader = j;
+               break;
+            }
+         }
+         if (reader == 0 || GetNumberOfTensorReaders(output) != 1 ||
+             fOperators[reader]->GetOpInputTensors()[0] != output ||
+             std::count(fOperators[reader]->GetOpInputTensors().begin(), fOperators[reader]->GetOpInputTensors().end(),
+                        output) != 1)
+            break;
+         if (!fOperators[id]->Fuse(*this, fOperators[reader]))
+            break;
+         fOperators.erase(fOperators.begin() + reader);
+         nFused++;
+      }
+   }
+   if (verbose && nFused > 0)
+      std::cout << "Fused " << nFused << " operators with the operators computing their input" << std::endl;
+}
+
+void RModel::PlanIntermediateMemory(bool verbose) {
+   // Assign to the intermediate float tensors offsets in a single memory pool, such that tensors which are
+   // alive at the same time do not overlap. A tensor is alive from the operator writing it to the last operator
+   // reading it, and operators are executed in the order of fOperators.
+   fIntermediateMemoryOffsets.clear();
+   fIntermediateMemorySize = 0;
+   // GNN components are generated in the same scope and cannot share one pool
+   if (fIsGNNComponent)
+      return;
+   // lifetimes are known only if all operators declare the tensors they use
+   for (auto &op : fOperators) {
+      if (op->GetOpOutputTensors().empty())
+         return;
+   }
+
+   struct Lifetime {
+      size_t first;
+      size_t last;
+   };
+   std::unordered_map<std::string, Lifetime> lifetimes;
+   for (size_t id = 0; id < fOperators.size(); id++) {
+      for (auto &name : fOperators[id]->GetOpOutputTensors()) {
+         auto f = fIntermediateTensorInfos.find(name);
+         // output tensors of the model are returned by infer and keep their own vector
+         if (f == fIntermediateTensorInfos.end() || f->second.type != ETensorType::FLOAT ||
+             std::find(fOutputTensorNames.begin(), fOutputTensorNames.end(), name) != fOutputTensorNames.end())
+            continue;
+         auto l = lifetimes.emplace(name, Lifetime{id, id}).first;
+         l->second.last = id;
+      }
+      for (auto &name : fOperators[id]->GetOpInputTensors()) {
+         auto l = lifetimes.find(name);
+         if (l != lifetimes.end())
+            l->second.last = std::max(l->second.last, id);
+      }
+   }
+   if (lifetimes.empty())
+      return;
+
+   // a buffer holds a chain of tensors where each one is written in place over the previous one
+   struct Buffer {
+      size_t first;
+      size_t last;
+      size_t length;
+      size_t offset;
+   };
+   std::vector<Buffer> buffers;
+   std::unordered_map<std::string, size_t> tensorBuffers;
+   // pad the buffers to 64 bytes to keep the tensors aligned
+   auto paddedLength = [](size_t length) { return (length + 15) / 16 * 16; };
+   size_t totalLength = 0;
+   for (size_t id = 0; id < fOperators.size(); id++) {
+      auto &op = fOperators[id];
+      for (auto &name : op->GetOpOutputTensors()) {
+         auto l = lifetimes.find(name);
+         if (l == lifetimes.end() || l->second.first != id || tensorBuffers.count(name))
+            continue;
+         size_t length = paddedLength(ConvertShapeToLength(fIntermediateTensorInfos[name].shape));
+         totalLength += length;
+         // reuse the memory of an input of the same size which is not used afterwards
+         if (op->CanWorkInPlace()) {
+            for (auto &input : op->GetOpInputTensors()) {
+               auto b = tensorBuffers.find(input);
+               if (b != tensorBuffers.end() && buffers[b->second].last == id && buffers[b->second].length == length) {
+                  tensorBuffers[name] = b->second;
+                  buffers[b->second].last = l->second.last;
+                  break;
+               }
+            }
+         }
+         if (tensorBuffers.count(name) == 0) {
+            tensorBuffers[name] = buffers.size();
+            buffers.push_back({id, l->second.last, length, 0});
+         }
+      }
+   }
+
+   // place the largest buffers first, each at the lowest offset not used by a buffer alive at the same time
+   std::vector<size_t> order(buffers.size());
+   for (size_t i = 0; i < order.size(); i++)
+      order[i] = i;
+   std::stable_sort(order.begin(), order.end(),
+                    [&buffers](size_t a, size_t b) { return buffers[a].length > buffers[b].length; });
+   std::vector<size_t> placed;
+   for (size_t i : order) {
+      auto &buffer = buffers[i];
+      std::vector<size_t> overlapping;
+      for (size_t j : placed) {
+         if (buffers[j].first <= buffer.last && buffer.first <= buffers[j].last)
+            overlapping.push_back(j);
+      }
+      std::sort(overlapping.begin(), overlapping.end(),
+                [&buffers](size_t a, size_t b) { return buffers[a].offset < buffers[b].offset; });
+      size_t offset = 0;
+      for (size_t j : overlapping) {
+         if (offset + buffer.length <= buffers[j].offset)
+            break;
+         offset = std::max(offset, buffers[j].offset + buffers[j].length);
+      }
+      buffer.offset = offset;
+      fIntermediateMemorySize = std::max(fIntermediateMemorySize, offset + buffer.length);
+      placed.push_back(i);
+   }
+   for (auto &t : tensorBuffers)
+      fIntermediateMemoryOffsets[t.first] = buffers[t.second].offset;
+
+   if (verbose) {
+      std::cout << "Memory pool of " << fIntermediateMemoryOffsets.size() << " intermediate tensors: "
+                << fIntermediateMemorySize << " floats instead of " << totalLength << std::endl;
+   }
+}
+
 void RModel::GenerateInitializedTensorInfo() {
     if (!fInitializedTensors.empty())
       fGC += "// initialized tensors\n";
@@ -394,9 +561,18 @@ void RModel::GenerateInitializedTensorInfo() {
 void RModel::GenerateIntermediateTensorInfo() {
    if (!fIntermediateTensorInfos.empty()) {
       fGC += "\n//--- declare and allocate the intermediate tensors\n";
+      if (fIntermediateMemorySize > 0) {
+         // must be declared before the tensor pointers which are initialized from it
+         fGC += "std::vector<float> fIntermediateMemoryPool = std::vector<float>(" +
+                std::to_string(fIntermediateMemorySize) + ");\n";
+      }
       for (auto &i : fIntermediateTensorInfos) {
          size_t length = ConvertShapeToLength(i.second.shape);
-         if (i.second.type == ETensorType::FLOAT) {
+         auto offset = fIntermediateMemoryOffsets.find(i.first);
+         if (offset != fIntermediateMemoryOffsets.end()) {
+            fGC += "float * tensor_" + i.first + " = fIntermediateMemoryPool.data() + " +
+                   std::to_string(offset->second) + ";\n";
+         } else if (i.second.type == ETensorType::FLOAT) {
             fGC += "std::vector<float> fTensor_" + i.first + " = std::vector<float>(" + std::to_string(length) + ");\n";
             fGC += "float * tensor_" + i.first + " = fTensor_" + i.first + ".data();\n";
          }
@@ -516,6 +692,23 @@ void RModel::GenerateOutput() {
    if (fInputTensorNames.size() > 0) fGC.pop_back();// remove last ","
    fGC += "){\n";
 
+   // grow the dynamic tensors when the shape parameters exceed the ones they are allocated for, so that
+   // the same Session can be used for any batch size: the buffers keep the largest size seen
+   if (fUseSession && !fShapeParams.empty() && !inputParams.empty()) {
+      std::string condition, args;
+      for (auto &p : fShapeParams) {
+         const std::string member = "fShapeParam_" + p.first;
+         if (inputParams.count(p.first) > 0) {
+            condition += (condition.empty() ? "" : " || ") + (p.first + " > " + member);
+            args += (args.empty() ? "" : ", ") + ("(" + p.first + " > " + member + " ? " + p.first + " : " + member + ")");
+         } else {
+            args += (args.empty() ? "" : ", ") + member;
+         }
+      }
+      fGC += SP + "if (" + condition + ")\n";
+      fGC += SP + SP + "AllocateDynamicTensors(" + args + ");\n";
+   }
+
    for (size_t id = 0; id < fOperators.size(); id++) {
       fGC += (fOperators[id]->Generate(std::to_string(id)));
    }
@@ -592,8 +785,14 @@ void RModel::Generate(std::underlying_type_t<Options> options, int batchSize, lo
         fIsGNN = true;
     if (static_cast<std::underlying_type_t<Options>>(Options::kGNNComponent) & options)
         fIsGNNComponent = true;
+    if (static_cast<std::underlying_type_t<Options>>(Options::kInt8Gemm) & options) {
+        if (!fUseSession)
+            throw std::runtime_error("TMVA-SOFIE: RModel::Generate: int8 Gemm operators need a Session class");
+        fUseInt8Gemm = true;
+    }
 
     Initialize(batchSize, verbose);
+    PlanIntermediateMemory(verbose);
     std::string hgname;
     if(!fIsGNNComponent) {
         fGC.clear();
@@ -646,15 +845,41 @@ void RModel::Generate(std::underlying_type_t<Options> options, int batchSize, lo
             //fUseWeightFile = fUseWeightFile;
         }
 
-        // now we have passed the parameters we can allocate the dynamic tensors
-        GenerateDynamicTensorInfo();
-
-        // add here initialization code  for operator
-        for (size_t id = 0; id < fOperators.size() ; id++) {
-            fGC += fOperators[id]->GenerateInitCode();
+        if (fShapeParams.empty()) {
+            GenerateDynamicTensorInfo();
+            // add here initialization code  for operator
+            for (size_t id = 0; id < fOperators.size() ; id++) {
+                fGC += fOperators[id]->GenerateInitCode();
+            }
+            fGC += "}\n\n";
+        } else {
+            // the dynamic tensors are allocated, and the operators initialized, in a separate function
+            // called again by infer when it is given larger shape parameters
+            std::string args;
+            for (auto & p : fShapeParams) {
+               args += (args.empty() ? "" : ", ") + p.first;
+            }
+            fGC += "   AllocateDynamicTensors(" + args + ");\n";
+            fGC += "}\n\n";
+            fGC += "//--- shape parameters for which the dynamic tensors are allocated\n";
+            for (auto & p : fShapeParams) {
+               fGC += "size_t fShapeParam_" + p.first + " = 0;\n";
+            }
+            std::string params;
+            for (auto & p : fShapeParams) {
+               params += (params.empty() ? "" : ", ") + ("size_t " + p.first);
+            }
+            fGC += "void AllocateDynamicTensors(" + params + ") {\n";
+            for (auto & p : fShapeParams) {
+               fGC += "   fShapeParam_" + p.first + " = " + p.first + ";\n";
+            }
+            GenerateDynamicTensorInfo();
+            // the initialization code of the operators can depend on the shape parameters (e.g. broadcasting of biases)
+            for (size_t id = 0; id < fOperators.size() ; id++) {
+                fGC += fOperators[id]->GenerateInitCode();
+            }
+            fGC += "}\n\n";
         }
-
-        fGC += "}\n\n";
     }
 
     GenerateOutput();
@@ -6,6 +6,7 @@
 #include <vector>
 #include <fstream>
 #include <limits>
+#include <cmath>
 
 #include "TMVA/RModel.hxx"
 #include "TMVA/RModelParser_ONNX.hxx"
@@ -16,14 +17,19 @@
 bool verbose = true;
 int sessionId = 0;
 
-void ExecuteSofieParser(std::string modelName) {
+void ExecuteSofieParser(std::string modelName, bool useInt8 = false) {
    using namespace TMVA::Experimental;
    SOFIE::RModelParser_ONNX parser;
    std::string inputName = modelName + ".onnx";
    std::cout << "parsing file " << inputName << std::endl;
    SOFIE::RModel model = parser.Parse(inputName);
    std::cout << "generating model.....\n";
-   model.Generate();
+   if (useInt8) {
+      // generate a separate Session class
+      modelName += "_int8";
+      model.SetFilename(modelName);
+   }
+   model.Generate(useInt8 ? SOFIE::Options::kInt8Gemm : SOFIE::Options::kDefault);
    std::string outputName = modelName + ".hxx";
    std::cout << "writing model as header .....\n";
    model.OutputGenerated(); // outputName);
@@ -55,7 +61,7 @@ std::vector<float> RunInference(float * x, int sId) {
    return *result;
 }
 
-void TestLinear(int nbatches, bool useBN = false, int inputSize = 10, int nlayers = 4)
+void TestLinear(int nbatches, bool useBN = false, int inputSize = 10, int nlayers = 4, bool useInt8 = false)
 {
    std::string modelName = "LinearModel";
    if (useBN) modelName += "_BN";
@@ -73,9 +79,9 @@ void TestLinear(int nbatches, bool useBN = false, int inputSize = 10, int nlayer
    printf("executing %s\n", command.c_str());
    gSystem->Exec(command.c_str());
 
-   ExecuteSofieParser(modelName);
+   ExecuteSofieParser(modelName, useInt8);
 
-   int id = DeclareCode(modelName);
+   int id = DeclareCode(useInt8 ? modelName + "_int8" : modelName);
 
    // input data
    std::vector<float> xinput(nbatches * inputSize);
@@ -94,7 +100,9 @@ void TestLinear(int nbatches, bool useBN = false, int inputSize = 10, int nlayer
       f >> refValue[i];
       if (verbose)
          std::cout << " result " << result.at(i) << " reference " << refValue[i] << std::endl;
-      EXPECT_NEAR(result.at(i), refValue[i], 10 * std::numeric_limits<float>::epsilon());
+      // the int8 quantization of weights and inputs gives a relative error of about 1% per layer
+      float tolerance = useInt8 ? 0.05f * (std::abs(refValue[i]) + 1.f) : 10 * std::numeric_limits<float>::epsilon();
+      EXPECT_NEAR(result.at(i), refValue[i], tolerance);
    }
 }
 
@@ -337,6 +345,10 @@ TEST(SOFIE, Linear_B4)
    // test batch =4 (equal output size)
    TestLinear(4);
 }
+TEST(SOFIE, Linear_Int8_B4)
+{
+   TestLinear(4, false, 10, 4, true);
+}
 TEST(SOFIE,Conv2d_B1) {
    TestConv("2d", 1);
 }
@@ -65,6 +65,11 @@ namespace TMVA {
       Bool_t WriteOptionsReference() const { return fWriteOptionsReference; }
       void   SetWriteOptionsReference( Bool_t w ) { fWriteOptionsReference = w; }
 
+      /// If set, weight files are written in the compact binary form of TXMLEngine::SaveBinaryDoc(),
+      /// which is read back without xml parsing; readers detect the format automatically
+      Bool_t WriteBinaryWeightFiles() const { return fWriteBinaryWeightFiles; }
+      void   SetWriteBinaryWeightFiles( Bool_t b ) { fWriteBinaryWeightFiles = b; }
+
       Bool_t DrawProgressBar() const { return fDrawProgressBar; }
       void   SetDrawProgressBar( Bool_t d ) { fDrawProgressBar = d; }
       UInt_t GetNCpu() { return fExecutor.GetPoolSize(); }
@@ -142,6 +147,7 @@ namespace TMVA {
       std::atomic<Bool_t> fUseColoredConsole;     ///< coloured standard output
       std::atomic<Bool_t> fSilent;                ///< no output at all
       std::atomic<Bool_t> fWriteOptionsReference; ///< if set true: Configurable objects write file with option reference
+      std::atomic<Bool_t> fWriteBinaryWeightFiles; ///< if set true: weight files are written in binary xml form
       mutable MsgLogger* fLogger;                 ///<! message logger
       MsgLogger& Log() const { return *fLogger; }
 
@@ -297,6 +297,11 @@ public:
       template <typename Function_t>
       void MapFrom(Function_t & f, const TCpuTensor<AFloat> &A);
 
+      /** Same as MapFrom but for a binary function \p f, taking the input values
+       *  from the tensors \p A and \p B, so that both are read in a single pass. */
+      template <typename Function_t>
+      void MapFrom(Function_t & f, const TCpuTensor<AFloat> &A, const TCpuTensor<AFloat> &B);
+
       size_t GetBufferUseCount() const { return this->GetContainer()->GetUseCount(); }
 
       void Print(const char *name = "Tensor") const
@@ -378,6 +383,35 @@ inline void TCpuTensor<AFloat>::MapFrom(Function_t &f, const TCpuTensor<AFloat>
    }
 }
 
+//______________________________________________________________________________
+template <typename AFloat>
+template <typename Function_t>
+inline void TCpuTensor<AFloat>::MapFrom(Function_t &f, const TCpuTensor<AFloat> &A, const TCpuTensor<AFloat> &B)
+{
+   AFloat *dataC = GetRawDataPointer();
+   const AFloat *dataA = A.GetRawDataPointer();
+   const AFloat *dataB = B.GetRawDataPointer();
+
+   size_t nelements = GetNoElements();
+   R__ASSERT(nelements == A.GetNoElements());
+   R__ASSERT(nelements == B.GetNoElements());
+   size_t nsteps = TCpuMatrix<AFloat>::GetNWorkItems(nelements);
+
+   auto ff = [&dataC, &dataA, &dataB, &nsteps, &nelements, &f](UInt_t workerID) {
+      size_t jMax = std::min(workerID + nsteps, nelements);
+      for (size_t j = workerID; j < jMax; ++j) {
+         dataC[j] = f(dataA[j], dataB[j]);
+      }
+      return 0;
+   };
+   if (nsteps < nelements) {
+      TMVA::Config::Instance().GetThreadExecutor().Foreach(ff, ROOT::TSeqI(0, nelements, nsteps));
+   } else {
+      R__ASSERT(nelements == nsteps);
+      ff(0);
+   }
+}
+
 
 } // namespace DNN
 } // namespace TMVA
@@ -41,6 +41,8 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "TH2.h"
+#include <map>
+#include <memory>
 #include <vector>
 
 #include "TMVA/Types.h"
@@ -191,6 +193,9 @@ namespace TMVA {
       inline void SetUseFisherCuts(Bool_t t=kTRUE)  { fUseFisherCuts = t;}
       inline void SetMinLinCorrForFisher(Double_t min){fMinLinCorrForFisher = min;}
       inline void SetUseExclusiveVars(Bool_t t=kTRUE){fUseExclusiveVars = t;}
+      /// bin the variables once at the root node and obtain the histograms of one of the daughter nodes
+      /// by subtracting those of its sister from the mother's (multithreaded version of TrainNodeFast only)
+      inline void SetUseGlobalBinning(Bool_t t=kTRUE){fUseGlobalBinning = t;}
       inline void SetNVars(Int_t n){fNvars = n;}
 
    private:
@@ -202,11 +207,27 @@ namespace TMVA {
       // calculates the purity S/(S+B) of a given event sample
       Double_t SamplePurity(EventList eventSample);
 
+      struct NodeHistograms;
+      // fill the histograms of all variables in the global binning for the events of a node
+      std::unique_ptr<NodeHistograms> FillNodeHistograms(const EventConstList & eventSample);
+      // cache the histograms of the daughter nodes, filling the ones of the smaller daughter and
+      // subtracting them from the histograms of the mother for the other one
+      void DivideNodeHistograms(const DecisionTreeNode *node,
+                                const DecisionTreeNode *left, const EventConstList & leftSample,
+                                const DecisionTreeNode *right, const EventConstList & rightSample);
+
       UInt_t    fNvars;               ///< number of variables used to separate S and B
       Int_t     fNCuts;               ///< number of grid point in variable cut scans
       Bool_t    fUseFisherCuts;       ///< use multivariate splits using the Fisher criterium
       Double_t  fMinLinCorrForFisher; ///< the minimum linear correlation between two variables demanded for use in fisher criterium in node splitting
       Bool_t    fUseExclusiveVars;    ///< individual variables already used in fisher criterium are not anymore analysed individually for node splitting
+      Bool_t    fUseGlobalBinning;    ///< bin the variables once at the root node and reuse the histograms of the mother nodes
+
+      std::vector<Double_t> fGlobalXmin;        ///< lower edge of the global binning of each variable
+      std::vector<Double_t> fGlobalXmax;        ///< upper edge of the global binning of each variable
+      std::vector<Double_t> fGlobalInvBinWidth; ///< inverse bin width of the global binning of each variable (0 if empty range)
+      std::vector<UInt_t>   fGlobalNBins;       ///< number of bins of the global binning of each variable
+      std::map<const DecisionTreeNode*, std::unique_ptr<NodeHistograms>> fNodeHistograms; ///<! histograms of the nodes still to be trained
 
       SeparationBase *fSepType;       ///< the separation criteria
       RegressionVariance *fRegType;   ///< the separation criteria used in Regression
@@ -26,6 +26,7 @@
 
 #include <array>
 #include <istream>
+#include <ostream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -60,8 +61,20 @@ public:
    /// Compute model prediction on a single event.
    inline std::vector<Value_t> Compute(std::vector<Value_t> const &x) const { return Compute<std::vector<Value_t>>(x); }
 
+   /// Compute model predictions on a batch of events, given as a tensor of shape {events, features}.
    RTensor<Value_t> Compute(RTensor<Value_t> const &x) const;
 
+   /// Compute model predictions on `nEvents` events stored row by row in `x`, with `nFeatures` values per
+   /// event. The outputs are written row by row in `y`, one value per event for binary classification and
+   /// regression, one value per class for multiclass models.
+   void ComputeBatch(const Value_t *x, std::size_t nEvents, std::size_t nFeatures, Value_t *y) const;
+
+   /// Pointer to a function compiled by Compile(), computing the prediction of the model on one event.
+   using Function_t = void (*)(const Value_t *x, Value_t *y);
+
+   std::string GenerateCode(std::string const &funcName) const;
+   Function_t Compile(std::string const &funcName) const;
+
    static RBDT LoadText(std::string const &txtpath, std::vector<std::string> &features, int nClasses, bool logistic,
                         Value_t baseScore);
 
@@ -72,6 +85,8 @@ private:
    void Softmax(const Value_t *array, Value_t *out) const;
    void ComputeImpl(const Value_t *array, Value_t *out) const;
    Value_t EvaluateBinary(const Value_t *array) const;
+   void ComputeBlock(const Value_t *x, std::size_t nEvents, std::size_t nFeatures, Value_t *y) const;
+   void GenerateNodeCode(std::ostream &os, int index, std::size_t nOut, int tree, int depth) const;
    static void correctIndices(std::span<int> indices, IndexMap const &nodeIndices, IndexMap const &leafIndices);
    static void terminateTree(TMVA::Experimental::RBDT &ff, int &nPreviousNodes, int &nPreviousLeaves,
                              IndexMap &nodeIndices, IndexMap &leafIndices, int &treesSkipped);
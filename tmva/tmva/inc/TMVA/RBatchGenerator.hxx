@@ -1,6 +1,7 @@
 #ifndef TMVA_BATCHGENERATOR
 #define TMVA_BATCHGENERATOR
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <thread>
@@ -37,6 +38,7 @@ private:
    std::size_t fMaxBatches;
    std::size_t fNumColumns;
    std::size_t fNumEntries;
+   std::size_t fNumLoadingThreads;
    std::size_t fCurrentRow = 0;
 
    float fValidationSplit;
@@ -68,7 +70,7 @@ public:
                    const std::size_t batchSize, const std::vector<std::string> &cols, const std::string &filters = "",
                    const std::vector<std::size_t> &vecSizes = {}, const float vecPadding = 0.0,
                    const float validationSplit = 0.0, const std::size_t maxChunks = 0, const std::size_t numColumns = 0,
-                   bool shuffle = true)
+                   bool shuffle = true, const std::size_t numLoadingThreads = 1)
       : fTreeName(treeName),
         fFileName(fileName),
         fChunkSize(chunkSize),
@@ -81,8 +83,13 @@ public:
         fMaxChunks(maxChunks),
         fNumColumns((numColumns != 0) ? numColumns : cols.size()),
         fShuffle(shuffle),
-        fUseWholeFile(maxChunks == 0)
+        fUseWholeFile(maxChunks == 0),
+        fNumLoadingThreads(std::max<std::size_t>(numLoadingThreads, 1))
    {
+      // the chunks are read by several RDataFrames running concurrently
+      if (fNumLoadingThreads > 1)
+         ROOT::EnableThreadSafety();
+
       // limits the number of batches that can be contained in the batchqueue based on the chunksize
       fMaxBatches = ceil((fChunkSize / fBatchSize) * (1 - fValidationSplit));
 
@@ -92,7 +99,7 @@ public:
       fNumEntries = t->GetEntries();
 
       fChunkLoader = std::make_unique<TMVA::Experimental::Internal::RChunkLoader<Args...>>(
-         fTreeName, fFileName, fChunkSize, fCols, fFilters, fVecSizes, fVecPadding);
+         fTreeName, fFileName, fChunkSize, fCols, fFilters, fVecSizes, fVecPadding, fNumLoadingThreads);
       fBatchLoader = std::make_unique<TMVA::Experimental::Internal::RBatchLoader>(fBatchSize, fNumColumns, fMaxBatches);
 
       // Create tensor to load the chunk into
@@ -1,7 +1,10 @@
 #ifndef TMVA_CHUNKLOADER
 #define TMVA_CHUNKLOADER
 
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 #include "TMVA/RTensor.hxx"
@@ -93,10 +96,11 @@ private:
    }
 
 public:
+   /// \param offset position in chunkTensor where the first value is written
    RChunkLoaderFunctor(TMVA::Experimental::RTensor<float> &chunkTensor,
                        const std::vector<std::size_t> &maxVecSizes = std::vector<std::size_t>(),
-                       const float vecPadding = 0.0)
-      : fChunkTensor(chunkTensor), fMaxVecSizes(maxVecSizes), fVecPadding(vecPadding)
+                       const float vecPadding = 0.0, const std::size_t offset = 0)
+      : fOffset(offset), fChunkTensor(chunkTensor), fMaxVecSizes(maxVecSizes), fVecPadding(vecPadding)
    {
    }
 
@@ -118,6 +122,7 @@ private:
    std::string fFileName;
    std::size_t fChunkSize;
    std::size_t fNumColumns;
+   std::size_t fNumThreads;
 
    std::vector<std::string> fCols;
    std::string fFilters;
@@ -134,9 +139,11 @@ public:
    /// \param filters
    /// \param vecSizes
    /// \param vecPadding
+   /// \param numThreads number of threads loading the chunks when there are no filters
    RChunkLoader(const std::string &treeName, const std::string &fileName, const std::size_t chunkSize,
                 const std::vector<std::string> &cols, const std::string &filters = "",
-                const std::vector<std::size_t> &vecSizes = {}, const float vecPadding = 0.0)
+                const std::vector<std::size_t> &vecSizes = {}, const float vecPadding = 0.0,
+                const std::size_t numThreads = 1)
       : fTreeName(treeName),
         fFileName(fileName),
         fChunkSize(chunkSize),
@@ -144,7 +151,8 @@ public:
         fFilters(filters),
         fVecSizes(vecSizes),
         fVecPadding(vecPadding),
-        fNumColumns(cols.size())
+        fNumColumns(cols.size()),
+        fNumThreads(numThreads)
    {
    }
 
@@ -155,6 +163,10 @@ public:
    std::pair<std::size_t, std::size_t>
    LoadChunk(TMVA::Experimental::RTensor<float> &chunkTensor, const std::size_t currentRow)
    {
+      if (fFilters.empty() && fNumThreads > 1) {
+         return loadNonFilteredParallel(chunkTensor, currentRow);
+      }
+
       RChunkLoaderFunctor<Args...> func(chunkTensor, fVecSizes, fVecPadding);
 
       // Create TDataFrame of the chunk
@@ -222,6 +234,57 @@ private:
       std::size_t passed_events = myCount.GetValue();
       return std::make_pair(processed_events, passed_events);
    }
+
+   /// \brief Load a chunk with fNumThreads threads, each running a RDataFrame over a contiguous range
+   /// of entries and writing its events in the corresponding rows of the chunk.
+   /// Without filters the row of an event in the chunk is known before reading it, so the ranges are
+   /// independent. Ranges after the end of the dataset are empty, so the loaded rows stay contiguous.
+   /// \param chunkTensor
+   /// \param currentRow
+   /// \return A pair of size_t defining the number of events processed and how many passed all filters
+   std::pair<std::size_t, std::size_t>
+   loadNonFilteredParallel(TMVA::Experimental::RTensor<float> &chunkTensor, const std::size_t currentRow)
+   {
+      const std::size_t rowSize = chunkTensor.GetShape()[1];
+      const std::size_t rangeSize = (fChunkSize + fNumThreads - 1) / fNumThreads;
+
+      std::vector<std::size_t> counts(fNumThreads, 0);
+      std::vector<std::exception_ptr> errors(fNumThreads);
+      std::vector<std::thread> threads;
+      for (std::size_t i = 0; i < fNumThreads && i * rangeSize < fChunkSize; i++) {
+         const std::size_t begin = i * rangeSize;
+         const std::size_t end = std::min(begin + rangeSize, fChunkSize);
+         threads.emplace_back([this, &chunkTensor, &counts, &errors, i, begin, end, rowSize, currentRow]() {
+            try {
+               RChunkLoaderFunctor<Args...> func(chunkTensor, fVecSizes, fVecPadding, begin * rowSize);
+               ROOT::RDF::Experimental::RDatasetSpec spec =
+                  ROOT::RDF::Experimental::RDatasetSpec()
+                     .AddSample({"", fTreeName, fFileName})
+                     .WithGlobalRange({static_cast<Long64_t>(currentRow + begin),
+                                       static_cast<Long64_t>(currentRow + end)});
+               ROOT::RDataFrame x_rdf(spec);
+               auto myCount = x_rdf.Count();
+               x_rdf.Foreach(func, fCols);
+               counts[i] = myCount.GetValue();
+            } catch (...) {
+               errors[i] = std::current_exception();
+            }
+         });
+      }
+      for (auto &thread : threads) {
+         thread.join();
+      }
+      for (auto &error : errors) {
+         if (error)
+            std::rethrow_exception(error);
+      }
+
+      std::size_t processed_events = 0;
+      for (auto count : counts) {
+         processed_events += count;
+      }
+      return std::make_pair(processed_events, processed_events);
+   }
 };
 
 } // namespace Internal
@@ -4,10 +4,13 @@
 #include "TString.h"
 #include "TXMLEngine.h"
 
+#include "TMVA/Config.h"
 #include "TMVA/RTensor.hxx"
 #include "TMVA/Reader.h"
 
+#include <algorithm> // std::copy, std::min
 #include <memory> // std::unique_ptr
+#include <mutex> // std::mutex
 #include <sstream> // std::stringstream
 
 namespace TMVA {
@@ -133,22 +136,130 @@ inline XMLConfig ParseXMLConfig(const std::string &filename)
 /// A replacement for the TMVA::Reader legacy interface.
 /// Performs inference for TMVA models stored as XML files.
 /// For neural network inference consider using [SOFIE](https://github.com/root-project/root/blob/master/tmva/sofie/README.md) instead.
+///
+/// The evaluation is thread-safe: the model is booked once per concurrent caller, in a TMVA::Reader
+/// owning its own input buffers, and the instances are kept in a pool for the following calls. The
+/// model evaluation itself does not take the global ROOT lock, so the Define nodes of a multi-threaded
+/// RDataFrame evaluate the model concurrently. The evaluation of an input RTensor is split in chunks
+/// of entries, evaluated in parallel with the TMVA thread executor if multi-threading is enabled.
 class RReader {
 private:
-   std::unique_ptr<Reader> fReader;
-   std::vector<float> fVariableValues;
+   /// A booked TMVA::Reader together with the memory its variables are bound to
+   struct Instance {
+      std::unique_ptr<Reader> fReader;
+      std::vector<float> fVariableValues;
+      std::vector<float> fSpectatorValues;
+   };
+
+   /// Instances which are not used by a caller at the moment
+   struct InstancePool {
+      std::mutex fMutex;
+      std::vector<std::unique_ptr<Instance>> fFree;
+   };
+
+   /// Give back the instance to the pool at the end of the scope
+   class InstanceGuard {
+      InstancePool &fPool;
+      std::unique_ptr<Instance> fInstance;
+
+   public:
+      InstanceGuard(InstancePool &pool, std::unique_ptr<Instance> instance)
+         : fPool(pool), fInstance(std::move(instance))
+      {
+      }
+      InstanceGuard(const InstanceGuard &) = delete;
+      InstanceGuard &operator=(const InstanceGuard &) = delete;
+      ~InstanceGuard()
+      {
+         std::lock_guard<std::mutex> lock(fPool.fMutex);
+         fPool.fFree.emplace_back(std::move(fInstance));
+      }
+      Instance &operator*() const { return *fInstance; }
+      Instance *operator->() const { return fInstance.get(); }
+   };
+
+   std::string fPath;
+   std::unique_ptr<InstancePool> fPool;
    std::vector<std::string> fVariables;
    std::vector<std::string> fVariableExpressions;
-   std::vector<float> fSpectatorValues;
    std::vector<std::string> fSpectators;
    std::vector<std::string> fSpectatorExpressions;
    unsigned int fNumClasses;
    const char *name = "RReader";
    Internal::AnalysisType fAnalysisType;
 
+   /// Book the model in a new TMVA::Reader
+   std::unique_ptr<Instance> CreateInstance() const
+   {
+      auto instance = std::make_unique<Instance>();
+      // Booking a method touches the global TMVA and ROOT state
+      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+      instance->fReader = std::make_unique<Reader>("Silent");
+      const auto numVars = fVariables.size();
+      instance->fVariableValues = std::vector<float>(numVars);
+      for (std::size_t i = 0; i < numVars; i++) {
+         instance->fReader->AddVariable(TString(fVariableExpressions[i]), &instance->fVariableValues[i]);
+      }
+      const auto numSpecs = fSpectators.size();
+      instance->fSpectatorValues = std::vector<float>(numSpecs);
+      for (std::size_t i = 0; i < numSpecs; i++) {
+         instance->fReader->AddSpectator(TString(fSpectatorExpressions[i]), &instance->fSpectatorValues[i]);
+      }
+      instance->fReader->BookMVA(name, fPath.c_str());
+      return instance;
+   }
+
+   /// Take a free instance from the pool, or book a new one if all of them are in use
+   InstanceGuard AcquireInstance() const
+   {
+      {
+         std::lock_guard<std::mutex> lock(fPool->fMutex);
+         if (!fPool->fFree.empty()) {
+            auto instance = std::move(fPool->fFree.back());
+            fPool->fFree.pop_back();
+            return InstanceGuard(*fPool, std::move(instance));
+         }
+      }
+      return InstanceGuard(*fPool, CreateInstance());
+   }
+
+   /// Copy over the inputs `x`, variables followed by spectators, to the memory used by the reader
+   void SetInputs(Instance &instance, const float *x) const
+   {
+      const auto nVars = fVariables.size();
+      std::copy(x, x + nVars, instance.fVariableValues.begin());
+      std::copy(x + nVars, x + nVars + fSpectators.size(), instance.fSpectatorValues.begin());
+   }
+
+   /// Evaluate the model on the inputs `x` and write the first `numOutputs` outputs to `y`
+   void Evaluate(Instance &instance, const float *x, float *y, std::size_t numOutputs) const
+   {
+      SetInputs(instance, x);
+
+      // Evaluate TMVA model
+      // Classification
+      if (fAnalysisType == Internal::AnalysisType::Classification) {
+         y[0] = instance.fReader->EvaluateMVA(name);
+      }
+      // Regression
+      else if (fAnalysisType == Internal::AnalysisType::Regression) {
+         const auto &r = instance.fReader->EvaluateRegression(name);
+         std::copy(r.begin(), r.begin() + std::min(numOutputs, r.size()), y);
+      }
+      // Multiclass
+      else if (fAnalysisType == Internal::AnalysisType::Multiclass) {
+         const auto &p = instance.fReader->EvaluateMulticlass(name);
+         std::copy(p.begin(), p.begin() + std::min(numOutputs, p.size()), y);
+      }
+      // Throw error
+      else {
+         throw std::runtime_error("RReader has undefined analysis type.");
+      }
+   }
+
 public:
    /// Create TMVA model from XML file
-   RReader(const std::string &path)
+   RReader(const std::string &path) : fPath(path), fPool(std::make_unique<InstancePool>())
    {
       // Load config
       auto c = Internal::ParseXMLConfig(path);
@@ -159,19 +270,8 @@ public:
       fAnalysisType = c.analysisType;
       fNumClasses = c.numClasses;
 
-      // Setup reader
-      fReader = std::make_unique<Reader>("Silent");
-      const auto numVars = fVariables.size();
-      fVariableValues = std::vector<float>(numVars);
-      for (std::size_t i = 0; i < numVars; i++) {
-         fReader->AddVariable(TString(fVariableExpressions[i]), &fVariableValues[i]);
-      }
-      const auto numSpecs = fSpectators.size();
-      fSpectatorValues = std::vector<float>(numSpecs);
-      for (std::size_t i = 0; i < numSpecs; i++) {
-         fReader->AddSpectator(TString(fSpectatorExpressions[i]), &fSpectatorValues[i]);
-      }
-      fReader->BookMVA(name, path.c_str());
+      // Setup the first reader, which also checks that the model can be booked
+      fPool->fFree.emplace_back(CreateInstance());
    }
 
    /// Compute model prediction on vector
@@ -180,30 +280,21 @@ public:
       if (x.size() != (fVariables.size()+fSpectators.size()))
          throw std::runtime_error("Size of input vector is not equal to number of variables.");
 
-      // Copy over inputs to memory used by TMVA reader
-      const auto nVars = fVariables.size();
-      for (std::size_t i = 0; i != nVars ; ++i) {
-         fVariableValues[i] = x[i];
-      }
-      for (std::size_t i = 0; i != fSpectators.size(); ++i) {
-         fSpectatorValues[i] = x[nVars+i];
-      }
-
-      // Take lock to protect model evaluation
-      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+      auto instance = AcquireInstance();
+      SetInputs(*instance, x.data());
 
       // Evaluate TMVA model
       // Classification
       if (fAnalysisType == Internal::AnalysisType::Classification) {
-         return std::vector<float>({static_cast<float>(fReader->EvaluateMVA(name))});
+         return std::vector<float>({static_cast<float>(instance->fReader->EvaluateMVA(name))});
       }
       // Regression
       else if (fAnalysisType == Internal::AnalysisType::Regression) {
-         return fReader->EvaluateRegression(name);
+         return instance->fReader->EvaluateRegression(name);
       }
       // Multiclass
       else if (fAnalysisType == Internal::AnalysisType::Multiclass) {
-         return fReader->EvaluateMulticlass(name);
+         return instance->fReader->EvaluateMulticlass(name);
       }
       // Throw error
       else {
@@ -232,32 +323,38 @@ public:
       RTensor<float> y({numEntries * numClasses});
       if (fAnalysisType == Internal::AnalysisType::Multiclass)
          y = y.Reshape({numEntries, numClasses});
+      if (numEntries == 0)
+         return y;
 
-      // Fill output tensor
-      const auto nVars = fVariables.size(); // number of non-spectator variables
-      for (std::size_t i = 0; i < numEntries; i++) {
-         for (std::size_t j = 0; j < nVars; j++) {
-            fVariableValues[j] = x(i, j);
-         }
-         for (std::size_t j = 0; j < fSpectators.size(); ++j) {
-            fSpectatorValues[j] = x(i, nVars+j);
-         }
-         R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
-         // Classification
-         if (fAnalysisType == Internal::AnalysisType::Classification) {
-            y(i) = fReader->EvaluateMVA(name);
-         }
-         // Regression
-         else if (fAnalysisType == Internal::AnalysisType::Regression) {
-            y(i) = fReader->EvaluateRegression(name)[0];
-         }
-         // Multiclass
-         else if (fAnalysisType == Internal::AnalysisType::Multiclass) {
-            const auto p = fReader->EvaluateMulticlass(name);
-            for (std::size_t k = 0; k < numClasses; k++)
-               y(i, k) = p[k];
+      // Inputs of a column-major tensor are gathered per entry
+      const bool rowMajor = x.GetMemoryLayout() == MemoryLayout::RowMajor;
+      const float *data = x.GetData();
+      float *out = y.GetData();
+
+      // Fill output tensor, in chunks of entries evaluated by one reader each
+      auto &executor = TMVA::Config::Instance().GetThreadExecutor();
+      const std::size_t minChunkSize = 1024;
+      const std::size_t numChunksMax = 4 * std::max(executor.GetPoolSize(), 1u);
+      const std::size_t chunkSize = std::max(minChunkSize, (numEntries + numChunksMax - 1) / numChunksMax);
+      const std::size_t numChunks = (numEntries + chunkSize - 1) / chunkSize;
+      auto evaluateChunk = [&](std::size_t chunk) {
+         auto instance = AcquireInstance();
+         std::vector<float> row(rowMajor ? 0 : numVars);
+         const auto end = std::min(numEntries, (chunk + 1) * chunkSize);
+         for (std::size_t i = chunk * chunkSize; i < end; i++) {
+            const float *xi = data + i * numVars;
+            if (!rowMajor) {
+               for (std::size_t j = 0; j < numVars; j++)
+                  row[j] = x(i, j);
+               xi = row.data();
+            }
+            Evaluate(*instance, xi, out + i * numClasses, numClasses);
          }
-      }
+      };
+      if (numChunks == 1)
+         evaluateChunk(0);
+      else
+         executor.Foreach(evaluateChunk, ROOT::TSeq<std::size_t>(numChunks));
 
       return y;
    }
@@ -0,0 +1,169 @@
+/**********************************************************************************
+ * Project: ROOT - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ *                                                                                *
+ * Description:                                                                   *
+ *      RDataFrame action evaluating a SOFIE model on batches of events           *
+ *                                                                                *
+ * Copyright (c) 2024:                                                            *
+ *      CERN, Switzerland                                                         *
+ *                                                                                *
+ **********************************************************************************/
+
+#ifndef TMVA_RSOFIEBATCHHELPER
+#define TMVA_RSOFIEBATCHHELPER
+
+#include <ROOT/RDF/RActionImpl.hxx>
+#include "RtypesCore.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class TTreeReader;
+
+namespace TMVA {
+namespace Experimental {
+
+/// Result of RSofieBatchHelper: the outputs of the model for the evaluated entries
+struct RSofieBatchResult {
+   std::vector<ULong64_t> fEntries; ///< entry numbers of the evaluated events, in increasing order
+   std::vector<float> fOutputs;     ///< outputs of the model, fNOutputs per event in the order of fEntries
+   std::size_t fNOutputs = 0;       ///< number of outputs of the model per event
+
+   /// Outputs of the model for the entry `entry`, or nullptr if it was not evaluated
+   const float *GetOutputs(ULong64_t entry) const
+   {
+      auto it = std::lower_bound(fEntries.begin(), fEntries.end(), entry);
+      if (it == fEntries.end() || *it != entry)
+         return nullptr;
+      return fOutputs.data() + (it - fEntries.begin()) * fNOutputs;
+   }
+};
+
+/// RDataFrame action evaluating a model generated by SOFIE on batches of events.
+///
+/// Contrary to SofieFunctor, which evaluates one event per call, the events are buffered per slot
+/// and the `infer` function of the Session is called once per `batchSize` events, so that the
+/// operators of the model (e.g. Gemm) work on matrices instead of vectors. The model must have a
+/// single input tensor of shape `{batchSize, N}`, i.e. it must be generated with this batch size,
+/// for example with `model.Generate(Options::kDefault, batchSize)`. The last incomplete batch of
+/// each slot is padded with zeros.
+///
+/// The results of a Define cannot be deferred until the batch is full, so the outputs are not
+/// available to the other nodes of the same event loop: they are returned in a RSofieBatchResult
+/// indexed by the entry number, which must be given as first column (`rdfentry_`):
+///
+/// ~~~{.cpp}
+/// using Helper_t = TMVA::Experimental::RSofieBatchHelper<3, TMVA_SOFIE_Model::Session>;
+/// auto res = df.Book<ULong64_t, float, float, float>(Helper_t(df.GetNSlots(), 256), {"rdfentry_", "x", "y", "z"});
+/// // the outputs can be used in a following event loop, e.g. in a Define
+/// auto score = [&res](ULong64_t entry) { return res->GetOutputs(entry)[0]; };
+/// ~~~
+template <std::size_t N, typename Session_t>
+class RSofieBatchHelper : public ROOT::Detail::RDF::RActionImpl<RSofieBatchHelper<N, Session_t>> {
+public:
+   using Result_t = RSofieBatchResult;
+
+private:
+   struct SlotData {
+      std::vector<float> fInput;            ///< inputs of the current batch
+      std::vector<ULong64_t> fBatchEntries; ///< entries of the current batch
+      std::vector<ULong64_t> fEntries;      ///< entries of the evaluated batches
+      std::vector<float> fOutputs;          ///< outputs of the evaluated batches
+      std::size_t fNOutputs = 0;            ///< number of outputs per event
+   };
+
+   std::shared_ptr<Result_t> fResult;
+   std::vector<Session_t> fSessions;
+   std::vector<SlotData> fSlots;
+   std::size_t fBatchSize;
+
+   void EvaluateBatch(unsigned int slot)
+   {
+      auto &data = fSlots[slot];
+      const std::size_t nEvents = data.fBatchEntries.size();
+      if (nEvents == 0)
+         return;
+      data.fInput.resize(fBatchSize * N, 0.f);
+      auto y = fSessions[slot].infer(data.fInput.data());
+      const std::size_t nOutputs = y.size() / fBatchSize;
+      if (nOutputs * fBatchSize != y.size())
+         throw std::runtime_error("RSofieBatchHelper: the size of the output of the model is not a multiple of the batch size");
+      data.fNOutputs = nOutputs;
+      data.fOutputs.insert(data.fOutputs.end(), y.begin(), y.begin() + nEvents * nOutputs);
+      data.fEntries.insert(data.fEntries.end(), data.fBatchEntries.begin(), data.fBatchEntries.end());
+      data.fBatchEntries.clear();
+      data.fInput.clear();
+   }
+
+public:
+   /// Create one Session per slot, passing `weightsFile` to its constructor if not empty
+   RSofieBatchHelper(unsigned int nSlots, std::size_t batchSize, const std::string &weightsFile = "")
+      : fResult(std::make_shared<Result_t>()), fSlots(std::max(nSlots, 1u)), fBatchSize(batchSize)
+   {
+      if (fBatchSize == 0)
+         throw std::invalid_argument("RSofieBatchHelper: the batch size must be positive");
+      fSessions.reserve(fSlots.size());
+      for (std::size_t i = 0; i < fSlots.size(); i++) {
+         if (weightsFile.empty())
+            fSessions.emplace_back();
+         else
+            fSessions.emplace_back(weightsFile);
+         fSlots[i].fInput.reserve(fBatchSize * N);
+         fSlots[i].fBatchEntries.reserve(fBatchSize);
+      }
+   }
+   RSofieBatchHelper(RSofieBatchHelper &&) = default;
+   RSofieBatchHelper(const RSofieBatchHelper &) = delete;
+
+   std::shared_ptr<Result_t> GetResultPtr() const { return fResult; }
+   void Initialize() {}
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   template <typename... Ts>
+   void Exec(unsigned int slot, ULong64_t entry, Ts... x)
+   {
+      static_assert(sizeof...(Ts) == N, "RSofieBatchHelper needs the entry number followed by N input columns");
+      auto &data = fSlots[slot];
+      data.fBatchEntries.push_back(entry);
+      (data.fInput.push_back(static_cast<float>(x)), ...);
+      if (data.fBatchEntries.size() == fBatchSize)
+         EvaluateBatch(slot);
+   }
+
+   /// Evaluate the incomplete batches and merge the outputs of the slots in the order of the entries
+   void Finalize()
+   {
+      std::vector<std::pair<ULong64_t, const float *>> outputs;
+      for (unsigned int slot = 0; slot < fSlots.size(); slot++) {
+         EvaluateBatch(slot);
+         auto &data = fSlots[slot];
+         if (data.fNOutputs > 0)
+            fResult->fNOutputs = data.fNOutputs;
+         for (std::size_t i = 0; i < data.fEntries.size(); i++)
+            outputs.emplace_back(data.fEntries[i], data.fOutputs.data() + i * data.fNOutputs);
+      }
+      std::sort(outputs.begin(), outputs.end(),
+                [](const std::pair<ULong64_t, const float *> &a, const std::pair<ULong64_t, const float *> &b) {
+                   return a.first < b.first;
+                });
+      fResult->fEntries.resize(outputs.size());
+      fResult->fOutputs.resize(outputs.size() * fResult->fNOutputs);
+      for (std::size_t i = 0; i < outputs.size(); i++) {
+         fResult->fEntries[i] = outputs[i].first;
+         std::copy(outputs[i].second, outputs[i].second + fResult->fNOutputs,
+                   fResult->fOutputs.begin() + i * fResult->fNOutputs);
+      }
+      fSlots.clear();
+   }
+
+   std::string GetActionName() { return "SofieBatchInference"; }
+};
+
+} // namespace Experimental
+} // namespace TMVA
+
+#endif // TMVA_RSOFIEBATCHHELPER
@@ -54,6 +54,7 @@ TMVA::Config::Config() :
    fUseColoredConsole    ( kTRUE  ),
    fSilent               ( kFALSE ),
    fWriteOptionsReference( kFALSE ),
+   fWriteBinaryWeightFiles( kFALSE ),
    fLogger               (new MsgLogger("Config"))
 {
    // plotting
@@ -45,7 +45,44 @@ void TCpu<AFloat>::ActivationFunctionBackward(Tensor_t & dX, const Tensor_t & /*
                                                 const AFloat /* alpha */, const AFloat /* beta */)
 {
    // scaling and translation not yet implemented
-   // output tensor (Y) could also be used to speed up derivative calculation
+   // output tensor (Y) could also be used to speed up derivative calculation, but it is
+   // modified in place by the dropout of the following layer
+   // for the most common functions compute dx = f'(x) * dY in a single pass over the tensors
+   switch (activFunct) {
+   case EActivationFunction::kIdentity: {
+      auto f = [](AFloat /*x*/, AFloat dy) { return dy; };
+      dX.MapFrom(f, X, dY);
+      return;
+   }
+   case EActivationFunction::kRelu: {
+      auto f = [](AFloat x, AFloat dy) {
+         AFloat df = (x < 0.0) ? 0.0 : 1.0;
+         return df * dy;
+      };
+      dX.MapFrom(f, X, dY);
+      return;
+   }
+   case EActivationFunction::kSigmoid: {
+      auto f = [](AFloat x, AFloat dy) {
+         AFloat sig = 1.0 / (1.0 + exp(-x));
+         AFloat df = sig * (1.0 - sig);
+         return df * dy;
+      };
+      dX.MapFrom(f, X, dY);
+      return;
+   }
+   case EActivationFunction::kTanh: {
+      auto f = [](AFloat x, AFloat dy) {
+         AFloat t = tanh(x);
+         AFloat df = 1 - t * t;
+         return df * dy;
+      };
+      dX.MapFrom(f, X, dY);
+      return;
+   }
+   default:
+      break;
+   }
    // compute dx = f'(x)
    TMVA::DNN::evaluateDerivative<TCpu<AFloat>>(dX, activFunct, X);
     // Compute element-wise product.  dx = f'(x) * dY
@@ -119,6 +119,7 @@ TMVA::DecisionTree::DecisionTree():
    fUseFisherCuts  (kFALSE),
    fMinLinCorrForFisher (1),
    fUseExclusiveVars (kTRUE),
+   fUseGlobalBinning (kFALSE),
    fSepType        (NULL),
    fRegType        (NULL),
    fMinSize        (0),
@@ -156,6 +157,7 @@ TMVA::DecisionTree::DecisionTree( TMVA::SeparationBase *sepType, Float_t minSize
    fUseFisherCuts  (kFALSE),
    fMinLinCorrForFisher (1),
    fUseExclusiveVars (kTRUE),
+   fUseGlobalBinning (kFALSE),
    fSepType        (sepType),
    fRegType        (NULL),
    fMinSize        (0),
@@ -204,6 +206,7 @@ TMVA::DecisionTree::DecisionTree( const DecisionTree &d ):
    fUseFisherCuts  (d.fUseFisherCuts),
    fMinLinCorrForFisher (d.fMinLinCorrForFisher),
    fUseExclusiveVars (d.fUseExclusiveVars),
+   fUseGlobalBinning (d.fUseGlobalBinning),
    fSepType    (d.fSepType),
    fRegType    (d.fRegType),
    fMinSize    (d.fMinSize),
@@ -594,6 +597,8 @@ UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & ev
          node->SetLeft(leftNode);
          node->SetRight(rightNode);
 
+         if (fUseGlobalBinning) this->DivideNodeHistograms(node, leftNode, leftSample, rightNode, rightSample);
+
          this->BuildTree(rightSample, rightNode);
          this->BuildTree(leftSample,  leftNode );
 
@@ -624,6 +629,9 @@ UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & ev
       if (node->GetDepth() > this->GetTotalTreeDepth()) this->SetTotalTreeDepth(node->GetDepth());
    }
 
+   // the histograms of a node that turned out to be a leaf are not needed anymore
+   fNodeHistograms.erase(node);
+
    //   if (IsRootNode) this->CleanTree();
    return fNNodes;
 }
@@ -1356,12 +1364,144 @@ struct TrainNodeInfo{
 
        return ret;
    };
+
+   // Define the subtraction operator, used to obtain the histograms of a daughter node
+   // from the ones of its mother and of its sister
+   TrainNodeInfo operator-(const TrainNodeInfo& other)
+   {
+       TrainNodeInfo ret(cNvars, nBins);
+
+       if(cNvars != other.cNvars)
+       {
+          std::cout << "!!! ERROR TrainNodeInfo1-TrainNodeInfo2 failure. cNvars1 != cNvars2." << std::endl;
+          return ret;
+       }
+
+       for (Int_t ivar=0; ivar<cNvars; ivar++) {
+          for (UInt_t ibin=0; ibin<nBins[ivar]; ibin++) {
+             ret.nSelS[ivar][ibin] = nSelS[ivar][ibin] - other.nSelS[ivar][ibin];
+             ret.nSelB[ivar][ibin] = nSelB[ivar][ibin] - other.nSelB[ivar][ibin];
+             ret.nSelS_unWeighted[ivar][ibin] = nSelS_unWeighted[ivar][ibin] - other.nSelS_unWeighted[ivar][ibin];
+             ret.nSelB_unWeighted[ivar][ibin] = nSelB_unWeighted[ivar][ibin] - other.nSelB_unWeighted[ivar][ibin];
+             ret.target[ivar][ibin] = target[ivar][ibin] - other.target[ivar][ibin];
+             ret.target2[ivar][ibin] = target2[ivar][ibin] - other.target2[ivar][ibin];
+          }
+       }
+
+       ret.nTotS = nTotS - other.nTotS;
+       ret.nTotS_unWeighted = nTotS_unWeighted - other.nTotS_unWeighted;
+       ret.nTotB = nTotB - other.nTotB;
+       ret.nTotB_unWeighted = nTotB_unWeighted - other.nTotB_unWeighted;
+
+       return ret;
+   };
  
 };
 //===========================================================================
 // Done with TrainNodeInfo declaration
 //===========================================================================
 
+// The (non-cumulative) histograms of a node in the global binning, kept until the node is trained
+struct TMVA::DecisionTree::NodeHistograms : public TrainNodeInfo {
+   NodeHistograms(TrainNodeInfo &&info) : TrainNodeInfo(std::move(info)) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histograms of all the variables in the global binning set up at the
+/// root node. As in TrainNodeFast, the events are split in chunks processed in
+/// parallel when there are many events per bin, otherwise the variables are.
+
+std::unique_ptr<TMVA::DecisionTree::NodeHistograms>
+TMVA::DecisionTree::FillNodeHistograms( const EventConstList & eventSample )
+{
+   UInt_t *nBins = fGlobalNBins.data();
+   UInt_t nPartitions = TMVA::Config::Instance().GetThreadExecutor().GetPoolSize();
+
+   // add the events [start, end) to the histograms of the variables [firstVar, lastVar),
+   // the totals being counted together with the first variable
+   auto fill = [this, &eventSample, nBins](TrainNodeInfo &info, UInt_t start, UInt_t end, UInt_t firstVar, UInt_t lastVar) {
+      for (UInt_t iev=start; iev<end; iev++) {
+         const TMVA::Event *evt = eventSample[iev];
+         const Double_t eventWeight = evt->GetWeight();
+         const Bool_t isSignal = (evt->GetClass() == fSigClass);
+         if (firstVar == 0) {
+            if (isSignal) {
+               info.nTotS+=eventWeight;
+               info.nTotS_unWeighted++;
+            }
+            else {
+               info.nTotB+=eventWeight;
+               info.nTotB_unWeighted++;
+            }
+         }
+         for (UInt_t ivar=firstVar; ivar<lastVar; ivar++) {
+            Int_t iBin = TMath::Min(Int_t(nBins[ivar]-1),TMath::Max(0,int (fGlobalInvBinWidth[ivar]*(evt->GetValueFast(ivar)-fGlobalXmin[ivar]) ) ));
+            if (isSignal) {
+               info.nSelS[ivar][iBin]+=eventWeight;
+               info.nSelS_unWeighted[ivar][iBin]++;
+            }
+            else {
+               info.nSelB[ivar][iBin]+=eventWeight;
+               info.nSelB_unWeighted[ivar][iBin]++;
+            }
+            if (DoRegression()) {
+               const Double_t tgt = evt->GetTarget(0);
+               info.target[ivar][iBin] +=eventWeight*tgt;
+               info.target2[ivar][iBin]+=eventWeight*tgt*tgt;
+            }
+         }
+      }
+   };
+
+   TrainNodeInfo nodeInfo(fNvars, nBins);
+   if (eventSample.size() >= fNvars*fNCuts*nPartitions*2) {
+      auto seeds = ROOT::TSeqU(nPartitions);
+      auto f = [this, &eventSample, &fill, nBins, nPartitions](UInt_t partition = 0){
+         UInt_t start = 1.0*partition/nPartitions*eventSample.size();
+         UInt_t end   = (partition+1.0)/nPartitions*eventSample.size();
+         TrainNodeInfo nodeInfof(fNvars, nBins);
+         fill(nodeInfof, start, end, 0, fNvars);
+         return nodeInfof;
+      };
+      TrainNodeInfo nodeInfoInit(fNvars, nBins);
+      auto redfunc = [nodeInfoInit](std::vector<TrainNodeInfo> v) -> TrainNodeInfo { return std::accumulate(v.begin(), v.end(), nodeInfoInit); };
+      nodeInfo = TMVA::Config::Instance().GetThreadExecutor().MapReduce(f, seeds, redfunc);
+   }
+   else {
+      auto fvarFill = [&nodeInfo, &eventSample, &fill](UInt_t ivar = 0){
+         fill(nodeInfo, 0, eventSample.size(), ivar, ivar+1);
+         return 0;
+      };
+      TMVA::Config::Instance().GetThreadExecutor().Map(fvarFill, ROOT::TSeqU(fNvars));
+   }
+   return std::make_unique<NodeHistograms>(std::move(nodeInfo));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cache the histograms of the daughter nodes of a node that was just split: only
+/// the histograms of the daughter with fewer events are filled, the ones of the
+/// other daughter are the difference between the histograms of the mother and of
+/// its sister.
+
+void TMVA::DecisionTree::DivideNodeHistograms( const DecisionTreeNode *node,
+                                               const DecisionTreeNode *left, const EventConstList & leftSample,
+                                               const DecisionTreeNode *right, const EventConstList & rightSample )
+{
+   auto it = fNodeHistograms.find(node);
+   if (it == fNodeHistograms.end()) return;
+   std::unique_ptr<NodeHistograms> mother = std::move(it->second);
+   fNodeHistograms.erase(it);
+
+   // the daughters will not be split if they reach the maximal depth
+   if (node->GetDepth()+1 >= fMaxDepth) return;
+
+   const Bool_t leftIsSmaller = leftSample.size() <= rightSample.size();
+   std::unique_ptr<NodeHistograms> smaller = FillNodeHistograms(leftIsSmaller ? leftSample : rightSample);
+   auto larger = std::make_unique<NodeHistograms>(*mother - *smaller);
+   fNodeHistograms[leftIsSmaller ? left : right] = std::move(smaller);
+   fNodeHistograms[leftIsSmaller ? right : left] = std::move(larger);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Decide how to split a node using one of the variables that gives
 /// the best separation of signal/background. In order to do this, for each
@@ -1474,6 +1614,26 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
    UInt_t cNvars = fNvars;
    if (fUseFisherCuts && fisherOK) cNvars++;  // use the Fisher output simple as additional variable
 
+   // #### with the global binning, the variables are binned once at the root node and the
+   // #### histograms of a node are filled when its mother is split (see DivideNodeHistograms)
+   const Bool_t useGlobalBinning = fUseGlobalBinning && !fUseFisherCuts;
+   if (useGlobalBinning && node == this->GetRoot()) {
+      fNodeHistograms.clear();
+      fGlobalXmin.resize(fNvars);
+      fGlobalXmax.resize(fNvars);
+      fGlobalInvBinWidth.resize(fNvars);
+      fGlobalNBins.resize(fNvars);
+      for (UInt_t ivar=0; ivar<fNvars; ivar++) {
+         fGlobalXmin[ivar] = node->GetSampleMin(ivar);
+         fGlobalXmax[ivar] = node->GetSampleMax(ivar);
+         const Bool_t isInteger = (fDataSetInfo->GetVariableInfo(ivar).GetVarType() == 'I');
+         fGlobalNBins[ivar] = isInteger ? UInt_t(node->GetSampleMax(ivar) - node->GetSampleMin(ivar) + 1) : UInt_t(fNCuts+1);
+         if (almost_equal_float(fGlobalXmax[ivar], fGlobalXmin[ivar])) fGlobalInvBinWidth[ivar] = 0;
+         else if (isInteger) fGlobalInvBinWidth[ivar] = 1;
+         else fGlobalInvBinWidth[ivar] = 1./(( fGlobalXmax[ivar] - fGlobalXmin[ivar] ) / Double_t(fGlobalNBins[ivar]));
+      }
+   }
+
    // #### set up the binning info arrays
    // #### each var has its own binning since some may be integers 
    UInt_t*   nBins = new UInt_t [cNvars];
@@ -1495,6 +1655,7 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
             nBins[ivar] = node->GetSampleMax(ivar) - node->GetSampleMin(ivar) + 1;
          }
       }
+      if (useGlobalBinning) nBins[ivar] = fGlobalNBins[ivar];
 
       cutValues[ivar] = new Double_t [nBins[ivar]];
    }
@@ -1509,6 +1670,10 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
             // std::cout << " will set useVariable[ivar]=false"<<std::endl;
             useVariable[ivar]=kFALSE;
          }
+         if (useGlobalBinning) { // scan the cuts of the global grid, in which the histograms are filled
+            xmin[ivar]=fGlobalXmin[ivar];
+            xmax[ivar]=fGlobalXmax[ivar];
+         }
 
       } else { // the fisher variable
          xmin[ivar]=999;
@@ -1584,7 +1749,14 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
 
    // #### When nbins is low compared to ndata this version of parallelization is faster, so use it 
    // #### Parallelize by chunking the data into the same number of sections as we have processors
-   if(eventSample.size() >= cNvars*fNCuts*nPartitions*2)
+   // #### With the global binning, take the histograms filled or subtracted when the mother was split
+   if (useGlobalBinning) {
+      auto it = fNodeHistograms.find(node);
+      if (it == fNodeHistograms.end()) it = fNodeHistograms.emplace(node, FillNodeHistograms(eventSample)).first;
+      // copy them, as they are turned into cumulative distributions below
+      nodeInfo = *it->second;
+   }
+   else if(eventSample.size() >= cNvars*fNCuts*nPartitions*2)
    {
       auto seeds = ROOT::TSeqU(nPartitions);
 
@@ -1890,6 +2062,9 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
 
 // Standard version of DecisionTree::TrainNodeFast (multithreading is not enabled)
 #else
+// the histograms of the nodes are only cached by the multithreaded version
+struct TMVA::DecisionTree::NodeHistograms {};
+
 Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                                             TMVA::DecisionTreeNode *node )
 {
@@ -181,6 +181,7 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
+   , fUseGlobalBinning(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseYesNoLeaf(kFALSE)
    , fNodePurityLimit(0)
    , fNNodesMax(0)
@@ -236,6 +237,7 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
+   , fUseGlobalBinning(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseYesNoLeaf(kFALSE)
    , fNodePurityLimit(0)
    , fNNodesMax(0)
@@ -311,6 +313,8 @@ Bool_t TMVA::MethodBDT::HasAnalysisType( Types::EAnalysisType type, UInt_t numbe
 ///  - nCuts:           the number of steps in the optimisation of the cut for a node (if < 0, then
 ///                  step size is determined by the events)
 ///  - UseFisherCuts:   use multivariate splits using the Fisher criterion
+///  - UseGlobalBinning: bin the variables once per tree and obtain the histograms of one of the daughters of a node
+///                  by subtraction (only with nCuts > 0, in multithreaded mode)
 ///  - UseYesNoLeaf     decide if the classification is done simply by the node type, or the S/B
 ///                  (from the training) in the leaf node
 ///  - NodePurityLimit  the minimum purity to classify a node as a signal node (used in pruning and boosting to determine
@@ -419,6 +423,7 @@ void TMVA::MethodBDT::DeclareOptions()
    DeclareOptionRef(fUseFisherCuts=kFALSE, "UseFisherCuts", "Use multivariate splits using the Fisher criterion");
    DeclareOptionRef(fMinLinCorrForFisher=.8,"MinLinCorrForFisher", "The minimum linear correlation between two variables demanded for use in Fisher criterion in node splitting");
    DeclareOptionRef(fUseExclusiveVars=kFALSE,"UseExclusiveVars","Variables already used in fisher criterion are not anymore analysed individually for node splitting");
+   DeclareOptionRef(fUseGlobalBinning=kFALSE,"UseGlobalBinning","Bin the variables once per tree in the nCuts grid of the whole sample, and obtain the histograms of the larger daughter of a node by subtraction from its mother (multithreaded mode only)");
 
 
    DeclareOptionRef(fDoPreselection=kFALSE,"DoPreselection","and and apply automatic pre-selection for 100% efficient signal (bkg) cuts prior to training");
@@ -606,6 +611,11 @@ void TMVA::MethodBDT::ProcessOptions()
       fNCuts=20;
    }
 
+   if (fUseGlobalBinning && (fUseFisherCuts || fNCuts <= 0)) {
+      Log() << kWARNING << "The option UseGlobalBinning needs nCuts > 0 and cannot be combined with UseFisherCuts, I will ignore it!" << Endl;
+      fUseGlobalBinning = kFALSE;
+   }
+
    if (fNTrees==0){
       Log() << kERROR << " Zero Decision Trees demanded... that does not work !! "
             << " I set it to 1 .. just so that the program does not crash"
@@ -1301,6 +1311,7 @@ void TMVA::MethodBDT::Train()
                fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher);
                fForest.back()->SetUseExclusiveVars(fUseExclusiveVars);
             }
+            fForest.back()->SetUseGlobalBinning(fUseGlobalBinning);
             // the minimum linear correlation between two variables demanded for use in fisher criterion in node splitting
 
             nNodesBeforePruning = fForest.back()->BuildTree(*fTrainSample);
@@ -1328,6 +1339,7 @@ void TMVA::MethodBDT::Train()
             fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher);
             fForest.back()->SetUseExclusiveVars(fUseExclusiveVars);
          }
+         fForest.back()->SetUseGlobalBinning(fUseGlobalBinning);
 
          nNodesBeforePruning = fForest.back()->BuildTree(*fTrainSample);
 
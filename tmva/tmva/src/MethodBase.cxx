@@ -1416,7 +1416,10 @@ void TMVA::MethodBase::WriteStateToFile() const
    gTools().xmlengine().DocSetRootElement(doc,rootnode);
    gTools().AddAttr(rootnode,"Method", GetMethodTypeName() + "::" + GetMethodName());
    WriteStateToXML(rootnode);
-   gTools().xmlengine().SaveDoc(doc,xmlfname);
+   if (gConfig().WriteBinaryWeightFiles())
+      gTools().xmlengine().SaveBinaryDoc(doc,xmlfname);
+   else
+      gTools().xmlengine().SaveDoc(doc,xmlfname);
    gTools().xmlengine().FreeDoc(doc);
 }
 
@@ -1434,6 +1437,7 @@ void TMVA::MethodBase::ReadStateFromFile()
          << gTools().Color("lightblue") << tfname << gTools().Color("reset") << Endl;
 
    if (tfname.EndsWith(".xml") ) {
+      // ParseFile also reads binary weight files, see Config::SetWriteBinaryWeightFiles()
       void* doc = gTools().xmlengine().ParseFile(tfname,gTools().xmlenginebuffersize()); // the default buffer size in TXMLEngine::ParseFile is 100k. Starting with ROOT 5.29 one can set the buffer size, see: http://savannah.cern.ch/bugs/?78864. This might be necessary for large XML files
       if (!doc) {
          Log() << kFATAL << "Error parsing XML file " << tfname << Endl;
@@ -21,17 +21,25 @@
 #include <ROOT/StringUtils.hxx>
 
 #include <TFile.h>
+#include <TInterpreter.h>
 #include <TSystem.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <stdlib.h>
 
 namespace {
 
+/// Number of events which go through a tree together in RBDT::ComputeBatch
+constexpr std::size_t kBlockSize = 64;
+
 template <class Value_t>
 void softmaxTransformInplace(Value_t *out, int nOut)
 {
@@ -112,20 +120,154 @@ RTensor<TMVA::Experimental::RBDT::Value_t> TMVA::Experimental::RBDT::Compute(RTe
    const std::size_t rows = x.GetShape()[0];
    const std::size_t cols = x.GetShape()[1];
    RTensor<Value_t> y({rows, nOut}, MemoryLayout::ColumnMajor);
-   std::vector<Value_t> xRow(cols);
-   std::vector<Value_t> yRow(nOut);
-   for (std::size_t iRow = 0; iRow < rows; ++iRow) {
-      for (std::size_t iCol = 0; iCol < cols; ++iCol) {
-         xRow[iCol] = x({iRow, iCol});
+   // copy the events block by block in row-major buffers, whatever the layout of x
+   std::vector<Value_t> xBlock(kBlockSize * cols);
+   std::vector<Value_t> yBlock(kBlockSize * nOut);
+   for (std::size_t first = 0; first < rows; first += kBlockSize) {
+      const std::size_t nEvents = std::min(kBlockSize, rows - first);
+      for (std::size_t iRow = 0; iRow < nEvents; ++iRow) {
+         for (std::size_t iCol = 0; iCol < cols; ++iCol) {
+            xBlock[iRow * cols + iCol] = x({first + iRow, iCol});
+         }
       }
-      ComputeImpl(xRow.data(), yRow.data());
-      for (std::size_t iOut = 0; iOut < nOut; ++iOut) {
-         y({iRow, iOut}) = yRow[iOut];
+      ComputeBlock(xBlock.data(), nEvents, cols, yBlock.data());
+      for (std::size_t iRow = 0; iRow < nEvents; ++iRow) {
+         for (std::size_t iOut = 0; iOut < nOut; ++iOut) {
+            y({first + iRow, iOut}) = yBlock[iRow * nOut + iOut];
+         }
       }
    }
    return y;
 }
 
+/// Compute model predictions on a batch of events stored row by row.
+///
+/// Contrary to Compute() on single events, which walks all trees for one event before the next one, the
+/// events are processed in blocks which walk each tree together, one level at a time: the nodes of a tree
+/// are loaded once per block instead of once per event, and the comparisons of the events of the block are
+/// independent of each other. The results are identical to the ones of the evaluation event by event.
+void TMVA::Experimental::RBDT::ComputeBatch(const Value_t *x, std::size_t nEvents, std::size_t nFeatures,
+                                            Value_t *y) const
+{
+   std::size_t nOut = fBaseResponses.size() > 2 ? fBaseResponses.size() : 1;
+   for (std::size_t first = 0; first < nEvents; first += kBlockSize) {
+      ComputeBlock(x + first * nFeatures, std::min(kBlockSize, nEvents - first), nFeatures, y + first * nOut);
+   }
+}
+
+void TMVA::Experimental::RBDT::ComputeBlock(const Value_t *x, std::size_t nEvents, std::size_t nFeatures,
+                                            Value_t *y) const
+{
+   std::size_t nOut = fBaseResponses.size() > 2 ? fBaseResponses.size() : 1;
+   for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+      for (std::size_t iOut = 0; iOut < nOut; ++iOut) {
+         y[iEvent * nOut + iOut] = fBaseScore + fBaseResponses[iOut];
+      }
+   }
+
+   std::array<int, kBlockSize> indices;
+   for (std::size_t iTree = 0; iTree < fRootIndices.size(); ++iTree) {
+      // The first level is evaluated for all events: afterwards, as the root node is never a child, a
+      // non-positive index is a leaf
+      const int root = fRootIndices[iTree];
+      for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+         indices[iEvent] =
+            x[iEvent * nFeatures + fCutIndices[root]] < fCutValues[root] ? fLeftIndices[root] : fRightIndices[root];
+      }
+      bool active = true;
+      while (active) {
+         active = false;
+         for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+            const int index = indices[iEvent];
+            if (index > 0) {
+               indices[iEvent] = x[iEvent * nFeatures + fCutIndices[index]] < fCutValues[index] ? fLeftIndices[index]
+                                                                                                 : fRightIndices[index];
+               active = true;
+            }
+         }
+      }
+      const std::size_t iOut = fTreeNumbers[iTree] % nOut;
+      for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+         y[iEvent * nOut + iOut] += fResponses[-indices[iEvent]];
+      }
+   }
+
+   for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+      if (nOut > 1) {
+         softmaxTransformInplace(y + iEvent * nOut, nOut);
+      } else if (fLogistic) {
+         y[iEvent] = 1.0 / (1.0 + std::exp(-y[iEvent]));
+      }
+   }
+}
+
+/// Generate the C++ code of a function `void funcName(const float *x, float *y)` computing the prediction
+/// of the model on one event, with one nested `if` statement per tree.
+///
+/// The cut values and responses are literals in the code, so that the compiler can lay out each tree as a
+/// sequence of branches without any memory indirection. As the size of the code grows with the number of
+/// nodes, this is meant for small forests. The code can be compiled with Compile(), or written to a file.
+std::string TMVA::Experimental::RBDT::GenerateCode(std::string const &funcName) const
+{
+   std::size_t nOut = fBaseResponses.size() > 2 ? fBaseResponses.size() : 1;
+   std::stringstream os;
+   // the scientific format always has a decimal point, so that an 'f' suffix makes a float literal
+   os << std::scientific << std::setprecision(std::numeric_limits<Value_t>::max_digits10);
+   os << "void " << funcName << "(const float *x, float *y)\n{\n";
+   for (std::size_t iOut = 0; iOut < nOut; ++iOut) {
+      os << "   y[" << iOut << "] = " << (fBaseScore + fBaseResponses[iOut]) << "f;\n";
+   }
+   for (std::size_t iTree = 0; iTree < fRootIndices.size(); ++iTree) {
+      GenerateNodeCode(os, fRootIndices[iTree], nOut, fTreeNumbers[iTree], 1);
+   }
+   if (nOut > 1) {
+      os << "   float wmax = y[0];\n";
+      os << "   for (int i = 1; i < " << nOut << "; ++i)\n";
+      os << "      wmax = y[i] > wmax ? y[i] : wmax;\n";
+      os << "   double norm = 0.;\n";
+      os << "   for (int i = 0; i < " << nOut << "; ++i) {\n";
+      os << "      y[i] = std::exp(y[i] - wmax);\n";
+      os << "      norm += y[i];\n";
+      os << "   }\n";
+      os << "   for (int i = 0; i < " << nOut << "; ++i)\n";
+      os << "      y[i] /= static_cast<float>(norm);\n";
+   } else if (fLogistic) {
+      os << "   y[0] = 1.0 / (1.0 + std::exp(-y[0]));\n";
+   }
+   os << "}\n";
+   return os.str();
+}
+
+void TMVA::Experimental::RBDT::GenerateNodeCode(std::ostream &os, int index, std::size_t nOut, int tree,
+                                                int depth) const
+{
+   const std::string indent(3 * depth, ' ');
+   // the root (depth 1) is always a node, while the index 0 of a child is the leaf 0
+   if (depth > 1 && index <= 0) {
+      os << indent << "y[" << tree % nOut << "] += " << fResponses[-index] << "f;\n";
+      return;
+   }
+   os << indent << "if (x[" << fCutIndices[index] << "] < " << fCutValues[index] << "f) {\n";
+   GenerateNodeCode(os, fLeftIndices[index], nOut, tree, depth + 1);
+   os << indent << "} else {\n";
+   GenerateNodeCode(os, fRightIndices[index], nOut, tree, depth + 1);
+   os << indent << "}\n";
+}
+
+/// Compile the code of GenerateCode() with the interpreter, and return a pointer to the function `funcName`,
+/// which must be a name not yet declared to the interpreter.
+TMVA::Experimental::RBDT::Function_t TMVA::Experimental::RBDT::Compile(std::string const &funcName) const
+{
+   if (!gInterpreter->Declare(("#include <cmath>\n" + GenerateCode(funcName)).c_str())) {
+      throw std::runtime_error("RBDT::Compile: failed to compile the code of function " + funcName);
+   }
+   auto func = reinterpret_cast<Function_t>(gInterpreter->Calc(("&" + funcName).c_str()));
+   if (!func) {
+      throw std::runtime_error("RBDT::Compile: failed to get the address of function " + funcName);
+   }
+   return func;
+}
+
 void TMVA::Experimental::RBDT::Softmax(const Value_t *array, Value_t *out) const
 {
    std::size_t nOut = fBaseResponses.size() > 2 ? fBaseResponses.size() : 1;
@@ -67,6 +67,28 @@ def _test_XGBMulticlass(label):
     np.testing.assert_array_almost_equal(y_xgb, y_bdt)
 
 
+def _test_XGBBinaryCompiled(label):
+    """
+    Compare response of the TMVA tree inference system and of its compiled code.
+    """
+    x, y = create_dataset(100, 10, 2)
+    xgb = xgboost.XGBClassifier(n_estimators=20, max_depth=3)
+    xgb.fit(x, y)
+    ROOT.TMVA.Experimental.SaveXGBoost(xgb, "myModel", "testXGBBinaryCompiled{}.root".format(label), num_inputs=10)
+    bdt = ROOT.TMVA.Experimental.RBDT("myModel", "testXGBBinaryCompiled{}.root".format(label))
+
+    func_name = "testXGBBinaryCompiled_{}".format(label)
+    bdt.Compile(func_name)
+    func = getattr(ROOT, func_name)
+    y_bdt = bdt.Compute(x).squeeze()
+    y_compiled = np.zeros(len(x), dtype=np.float32)
+    out = np.zeros(1, dtype=np.float32)
+    for i in range(len(x)):
+        func(np.ascontiguousarray(x[i]), out)
+        y_compiled[i] = out[0]
+    np.testing.assert_array_almost_equal(y_bdt, y_compiled)
+
+
 class RBDT(unittest.TestCase):
     """
     Test RBDT interface
@@ -90,6 +112,12 @@ class RBDT(unittest.TestCase):
         """
         _test_XGBRegression("default")
 
+    def test_XGBBinary_compiled(self):
+        """
+        Test the code generated for a model trained with binary XGBClassifier.
+        """
+        _test_XGBBinaryCompiled("default")
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -175,6 +175,25 @@ TEST(RReader, ClassificationComputeTensor)
    EXPECT_EQ(shapeY[0], shapeX[0]);
 }
 
+TEST(RReader, ClassificationComputeTensorMatchesVector)
+{
+   TrainClassificationModel();
+   ROOT::RDataFrame df("TreeS", filenameClassification);
+   auto x = AsTensor<float>(df, variablesClassification);
+
+   // the tensor is evaluated in chunks of entries, each by its own reader
+   RReader model(modelClassification);
+   auto y = model.Compute(x);
+
+   const auto numEntries = x.GetShape()[0];
+   std::vector<float> xi(variablesClassification.size());
+   for (std::size_t i = 0; i < numEntries; i++) {
+      for (std::size_t j = 0; j < xi.size(); j++)
+         xi[j] = x(i, j);
+      EXPECT_FLOAT_EQ(y(i), model.Compute(xi)[0]);
+   }
+}
+
 TEST(RReader, ClassificationComputeDataFrame)
 {
    TrainClassificationModel();
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <ROOT/RDataFrame.hxx>
+#include <TMVA/RSofieBatchHelper.hxx>
+
+#include <vector>
+
+using namespace TMVA::Experimental;
+
+// Session with the interface of the code generated by SOFIE for a model with batch size 4
+// and two outputs per event: the sum and the difference of the two inputs
+struct BatchSession {
+   static constexpr std::size_t kBatchSize = 4;
+   BatchSession(const std::string & = "") {}
+   std::vector<float> infer(float *x)
+   {
+      std::vector<float> y(2 * kBatchSize);
+      for (std::size_t i = 0; i < kBatchSize; i++) {
+         y[2 * i] = x[2 * i] + x[2 * i + 1];
+         y[2 * i + 1] = x[2 * i] - x[2 * i + 1];
+      }
+      return y;
+   }
+};
+
+static void CheckBatchInference(ROOT::RDataFrame &df)
+{
+   auto filtered = df.Define("x", [](ULong64_t e) { return float(e); }, {"rdfentry_"})
+                      .Define("y", [](ULong64_t e) { return 0.5f * e; }, {"rdfentry_"})
+                      .Filter([](ULong64_t e) { return e % 3 != 0; }, {"rdfentry_"});
+   auto res = filtered.Book<ULong64_t, float, float>(
+      RSofieBatchHelper<2, BatchSession>(df.GetNSlots(), BatchSession::kBatchSize), {"rdfentry_", "x", "y"});
+
+   EXPECT_EQ(res->fNOutputs, 2u);
+   ASSERT_EQ(res->fEntries.size(), 66u);
+   for (ULong64_t entry = 0; entry < 100; entry++) {
+      const float *y = res->GetOutputs(entry);
+      if (entry % 3 == 0) {
+         EXPECT_EQ(y, nullptr);
+         continue;
+      }
+      ASSERT_NE(y, nullptr);
+      EXPECT_FLOAT_EQ(y[0], 1.5f * entry);
+      EXPECT_FLOAT_EQ(y[1], 0.5f * entry);
+   }
+}
+
+TEST(RSofieBatchHelper, Sequential)
+{
+   ROOT::RDataFrame df(100);
+   CheckBatchInference(df);
+}
+
+#ifdef R__USE_IMT
+TEST(RSofieBatchHelper, MultiThread)
+{
+   ROOT::EnableImplicitMT(4);
+   ROOT::RDataFrame df(100);
+   CheckBatchInference(df);
+   ROOT::DisableImplicitMT();
+}
+#endif
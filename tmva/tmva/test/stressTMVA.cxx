@@ -3013,6 +3013,11 @@ void addClassificationTests(UnitTestSuite &TMVA_test, bool full = true)
                                                      "!H:!V:NTrees=400:nEventsMin=100:MaxDepth=3:BoostType=AdaBoost:"
                                                      "SeparationType=GiniIndex:nCuts=10:PruneMethod=NoPruning",
                                                      0.88, 0.98));
+   TMVA_test.addTest(new MethodUnitTestWithROCLimits(TMVA::Types::kBDT, "BDTGlobalBinning",
+                                                     "!H:!V:NTrees=400:nEventsMin=100:MaxDepth=3:BoostType=AdaBoost:"
+                                                     "SeparationType=GiniIndex:nCuts=10:PruneMethod=NoPruning:"
+                                                     "UseGlobalBinning",
+                                                     0.88, 0.98));
    if (full)
       TMVA_test.addTest(new MethodUnitTestWithROCLimits(
          TMVA::Types::kBDT, "BDTB",
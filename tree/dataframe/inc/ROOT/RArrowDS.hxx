@@ -15,6 +15,9 @@
 #include <memory>
 
 namespace arrow {
+class RecordBatch;
+class RecordBatchReader;
+class Schema;
 class Table;
 }
 
@@ -22,6 +25,7 @@ namespace ROOT {
 namespace Internal {
 namespace RDF {
 class TValueGetter;
+class TBatchValueGetter;
 } // namespace RDF
 } // namespace Internal
 
@@ -30,16 +34,28 @@ namespace RDF {
 class RArrowDS final : public RDataSource {
 private:
    std::shared_ptr<arrow::Table> fTable;
+   std::shared_ptr<arrow::RecordBatchReader> fBatchReader; // Only set when streaming record batches
+   std::shared_ptr<arrow::Schema> fSchema;
    std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
    std::vector<std::string> fColumnNames;
    size_t fNSlots = 0U;
 
    std::vector<std::pair<size_t, size_t>> fGetterIndex; // (columnId, visitorId)
    std::vector<std::unique_ptr<ROOT::Internal::RDF::TValueGetter>> fValueGetters; // Visitors to be used to track and get entries. One per column.
+
+   /// Streaming only: the record batches of the current entry ranges, with the global entry number of their first row
+   std::vector<std::pair<ULong64_t, std::shared_ptr<arrow::RecordBatch>>> fBatches;
+   std::vector<size_t> fBatchPerSlot; // Index in fBatches of the batch read by each slot
+   ULong64_t fNextEntry = 0ULL;       // Global entry number of the first row of the next batch to be read
+   std::vector<std::unique_ptr<ROOT::Internal::RDF::TBatchValueGetter>> fBatchValueGetters; // One per column
+
    std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &type) final;
+   size_t FindBatch(ULong64_t entry) const;
+   void SetBatch(unsigned int slot, size_t batchIdx);
 
 public:
    RArrowDS(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
+   RArrowDS(std::shared_ptr<arrow::RecordBatchReader> reader, std::vector<std::string> const &columns);
    ~RArrowDS();
    const std::vector<std::string> &GetColumnNames() const final;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
@@ -47,12 +63,15 @@ public:
    bool HasColumn(std::string_view colName) const final;
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
    void InitSlot(unsigned int slot, ULong64_t firstEntry) final;
+   void FinalizeSlot(unsigned int slot) final;
    void SetNSlots(unsigned int nSlots) final;
    void Initialize() final;
+   void Finalize() final;
    std::string GetLabel() final;
 };
 
 RDataFrame FromArrow(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columnNames);
+RDataFrame FromArrow(std::shared_ptr<arrow::RecordBatchReader> reader, std::vector<std::string> const &columnNames);
 
 } // namespace RDF
 
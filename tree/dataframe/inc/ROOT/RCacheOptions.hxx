@@ -0,0 +1,32 @@
+// Author: Enrico Guiraud CERN 10/2024
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEOPTIONS
+#define ROOT_RCACHEOPTIONS
+
+#include <cstddef>
+#include <string>
+
+namespace ROOT {
+
+namespace RDF {
+
+/// A collection of options to steer how Cache() stores the selected columns
+struct RCacheOptions {
+   /// Approximate memory in bytes that the cache may use while it is filled; 0 keeps all values in memory.
+   /// Otherwise, the values are written to fSpillFileName as an RNTuple, in clusters that fit the budget.
+   std::size_t fMemoryBudget = 0;
+   /// Local file to which the values are written if fMemoryBudget is set; it is overwritten if it exists
+   std::string fSpillFileName;
+};
+} // namespace RDF
+} // namespace ROOT
+
+#endif
@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <set>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include <TRegexp.h>
@@ -43,6 +44,7 @@ private:
    static const TRegexp fgIntRegex, fgDoubleRegex1, fgDoubleRegex2, fgDoubleRegex3, fgTrueRegex, fgFalseRegex;
 
    std::uint64_t fDataPos = 0;
+   std::uint64_t fReadPos = 0; // file position of the first line not yet loaded by GetEntryRanges
    bool fReadHeaders = false;
    unsigned int fNSlots = 0U;
    std::unique_ptr<ROOT::Internal::RRawFile> fCsvFile;
@@ -55,16 +57,21 @@ private:
    std::set<std::string> fColContainingEmpty; // store columns which had empty entry
    std::list<ColType_t> fColTypesList; // column types, order is the same as fHeaders, values the same as fColTypes
    std::vector<std::vector<void *>> fColAddresses;         // fColAddresses[column][slot] (same ordering as fHeaders)
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column] (same ordering as fHeaders)
-   std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
-   std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
-   std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
+   std::string fBuffer;                                    // raw text of the lines currently loaded
+   // Values of the lines currently loaded, fXColumns[column][entry] (same ordering as fHeaders). Only the vector of
+   // the type of the column is filled. SetEntry points the column addresses to these values, without copies.
+   std::vector<std::vector<double>> fDoubleColumns;
+   std::vector<std::vector<Long64_t>> fLong64Columns;
+   std::vector<std::vector<std::string>> fStringColumns;
+   std::vector<std::vector<char>> fBoolColumns;
    // This must be a deque to avoid the specialisation vector<bool>. This would not
    // work given that the pointer to the boolean in that case cannot be taken
    std::vector<std::deque<bool>> fBoolEvtValues; // one per column per slot
 
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
+   void FillRecord(std::string_view, std::size_t, const std::vector<ColType_t> &, std::vector<char> &);
+   void FillValue(std::string_view, std::size_t, std::size_t, ColType_t, std::vector<char> &);
+   std::vector<std::pair<std::size_t, std::size_t>> ReadLines();
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &) final;
    void ValidateColTypes(std::vector<std::string> &) const;
@@ -21,14 +21,17 @@
 
 #include "Compression.h"
 #include <string_view>
+#include "ROOT/RDataSource.hxx" // RColumnStats
 #include "ROOT/RVec.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
 #include "ROOT/RDF/RCutFlowReport.hxx"
+#include "ROOT/RDF/RLoopManager.hxx" // for SetResultFromMetadata
 #include "ROOT/RDF/RSampleInfo.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "ROOT/RDF/RDisplay.hxx"
+#include "RConfigure.h" // R__HAS_ROOT7
 #include "RtypesCore.h"
 #include "TBranch.h"
 #include "TClassEdit.h"
@@ -48,17 +51,27 @@
 #include "ROOT/RDF/RMergeableValue.hxx"
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <utility> // std::index_sequence
 #include <vector>
 #include <iomanip>
 #include <numeric> // std::accumulate in MeanHelper
 
+#ifdef R__HAS_ROOT7
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTupleFillContext.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleParallelWriter.hxx>
+#include <ROOT/RNTupleWriteOptions.hxx>
+#endif
+
 /// \cond HIDDEN_SYMBOLS
 
 namespace ROOT {
@@ -170,6 +183,8 @@ public:
    std::string GetActionName() { return "ForeachSlot"; }
 };
 
+class RVariedCounter;
+
 class R__CLING_PTRCHECK(off) CountHelper : public RActionImpl<CountHelper> {
    std::shared_ptr<ULong64_t> fResultCount;
    Results<ULong64_t> fCounts;
@@ -192,6 +207,8 @@ public:
 
    ULong64_t &PartialUpdate(unsigned int slot);
 
+   bool SetResultFromMetadata(RLoopManager &lm, const std::vector<std::string> &, TypeList<>);
+
    std::string GetActionName() { return "Count"; }
 
    CountHelper MakeNew(void *newResult)
@@ -199,6 +216,26 @@ public:
       auto &result = *static_cast<std::shared_ptr<ULong64_t> *>(newResult);
       return CountHelper(result, fCounts.size());
    }
+
+   static std::unique_ptr<RVariedCounter> MakeVariationsFiller(std::vector<CountHelper> &helpers, TypeList<>);
+};
+
+/// Counts the entries of all the systematic variations of a Count action at once, see RVariedAction.
+/// The counts of each slot are kept in one contiguous array and added to the helpers at the end of each task.
+class RVariedCounter {
+   std::vector<CountHelper> &fHelpers;
+   /// Per slot, the counts of each variation in the current task. Allocated separately to avoid false sharing.
+   std::vector<std::unique_ptr<std::vector<ULong64_t>>> fCounts;
+
+public:
+   RVariedCounter(std::vector<CountHelper> &helpers, unsigned int nSlots);
+   void Exec(unsigned int slot, const unsigned int *varIdx, std::size_t n)
+   {
+      auto &counts = *fCounts[slot];
+      for (std::size_t i = 0; i < n; ++i)
+         ++counts[varIdx[i]];
+   }
+   void FinalizeTask(unsigned int slot);
 };
 
 template <typename RNode_t>
@@ -339,11 +376,127 @@ public:
    }
 };
 
+/// Call mergeInto(to, from) for pairs of the n per-slot results in log2(n) rounds, each running concurrently in
+/// the implicit multi-threading pool, so that the result ends up in element 0.
+/// Return false without merging anything if implicit multi-threading is disabled.
+bool MergeInParallel(std::size_t n, const std::function<void(std::size_t, std::size_t)> &mergeInto);
+
+/// Fills the per-slot histograms of all the systematic variations of a Histo1D, Histo2D or Histo3D action at once,
+/// see RVariedAction. The bins of the values of all the variations that passed their filters are computed in a single
+/// loop, which vectorises for axes with fixed bin widths, and the statistics of each variation are accumulated in
+/// contiguous per-slot arrays, which are written to the histograms at the end of each task.
+/// Only TH1D, TH2D and TH3D histograms that do not extend their axes and do not buffer their entries are supported.
+class RVariedHistoFiller {
+   struct RSlotData {
+      std::vector<double> fValues[4];     ///< Scratch: the values of each input column for the variations to fill
+      std::vector<int> fBins;             ///< Scratch: the global bin of each value
+      std::vector<char> fInRange;         ///< Scratch: whether each value falls inside the axes
+      std::vector<double *> fBinContents; ///< Per variation, the bin contents of the histogram of this slot
+      std::vector<double *> fSumw2;       ///< Per variation, the sums of squares of weights, or null if not stored
+      std::vector<double> fStats;         ///< Statistics, TH1::kNstat arrays with one element per variation
+      std::vector<ULong64_t> fEntries;    ///< Per variation, the number of entries filled
+      std::vector<double> fInitialStats;  ///< The statistics of the histograms before the event loop, same layout
+      std::vector<double> fInitialEntries;
+   };
+
+   std::vector<std::vector<TH1 *>> fHists; ///< Per variation and per slot
+   int fDim = 1;
+   bool fIsWeighted = false;
+   bool fStatOverflows = false;
+   /// Per slot, allocated separately to avoid false sharing
+   std::vector<std::unique_ptr<RSlotData>> fSlots;
+
+   RVariedHistoFiller(std::vector<std::vector<TH1 *>> &&hists, std::size_t nColumns);
+   double *GetValueBuffer(unsigned int slot, std::size_t col, std::size_t n)
+   {
+      auto &values = fSlots[slot]->fValues[col];
+      values.resize(n);
+      return values.data();
+   }
+   void Fill(unsigned int slot, const unsigned int *varIdx, std::size_t n);
+
+public:
+   static std::unique_ptr<RVariedHistoFiller> Make(std::vector<std::vector<TH1 *>> &&hists, std::size_t nColumns);
+
+   /// Fill the histograms of the variations varIdx[0..n): values[c][i] is the value of column c for variation varIdx[i]
+   template <typename... ColTypes>
+   void Exec(unsigned int slot, const unsigned int *varIdx, std::size_t n, const ColTypes *const *...values)
+   {
+      std::size_t col = 0;
+      auto convert = [&](auto *const *colValues) {
+         double *buf = GetValueBuffer(slot, col++, n);
+         for (std::size_t i = 0; i < n; ++i)
+            buf[i] = static_cast<double>(*colValues[i]);
+      };
+      (convert(values), ...);
+      Fill(slot, varIdx, n);
+   }
+
+   void FinalizeTask(unsigned int slot);
+};
+
 /// The generic Fill helper: it calls Fill on per-thread objects and then Merge to produce a final result.
 /// For one-dimensional histograms, if no axes are specified, RDataFrame uses BufferedFillHelper instead.
+/// One-dimensional histograms filled with numbers are filled in blocks of values with TH1::FillN.
 template <typename HIST = Hist_t>
 class R__CLING_PTRCHECK(off) FillHelper : public RActionImpl<FillHelper<HIST>> {
+   /// Values and weights waiting to be filled with TH1::FillN
+   struct RFillNBuffer {
+      std::vector<double> fX;
+      std::vector<double> fW;
+   };
+   static constexpr std::size_t kFillNBufferSize = 256;
+
    std::vector<HIST *> fObjects;
+   std::vector<RFillNBuffer> fFillNBuffers; ///< One per slot, only used if fUseFillN
+   bool fUseFillN = false;
+
+   // FillN is used for the values (and weights) of one-dimensional histograms; TProfile::Fill(x, y) is not a weight
+   template <typename... Ts>
+   static constexpr bool IsFillNArgs()
+   {
+      return std::is_base_of<TH1, HIST>::value && (sizeof...(Ts) == 1 || sizeof...(Ts) == 2) &&
+             (std::is_arithmetic<Ts>::value && ...);
+   }
+
+   static bool CanUseFillN(TH1 *h) { return h->GetDimension() == 1 && !h->InheritsFrom("TProfile"); }
+   static bool CanUseFillN(...) { return false; }
+
+   template <typename X>
+   void BufferFillN(unsigned int slot, X x)
+   {
+      auto &buf = fFillNBuffers[slot];
+      buf.fX.push_back(x);
+      if (buf.fX.size() == kFillNBufferSize)
+         FlushFillN(slot);
+   }
+
+   template <typename X, typename W>
+   void BufferFillN(unsigned int slot, X x, W w)
+   {
+      auto &buf = fFillNBuffers[slot];
+      buf.fX.push_back(x);
+      buf.fW.push_back(w);
+      if (buf.fX.size() == kFillNBufferSize)
+         FlushFillN(slot);
+   }
+
+   void FlushFillN(unsigned int slot)
+   {
+      if constexpr (std::is_base_of<TH1, HIST>::value) {
+         if (!fUseFillN)
+            return;
+         auto &buf = fFillNBuffers[slot];
+         if (buf.fX.empty())
+            return;
+         // through TH1, as derived classes hide the FillN overloads they do not support
+         TH1 *h = fObjects[slot];
+         h->FillN(buf.fX.size(), buf.fX.data(), buf.fW.empty() ? nullptr : buf.fW.data());
+         buf.fX.clear();
+         buf.fW.clear();
+      }
+      (void)slot;
+   }
 
    template <typename H = HIST, typename = decltype(std::declval<H>().Reset())>
    void ResetIfPossible(H *h)
@@ -372,6 +525,18 @@ class R__CLING_PTRCHECK(off) FillHelper : public RActionImpl<FillHelper<HIST>> {
    auto Merge(std::vector<H *> &objs, int /*toincreaseoverloadpriority*/)
       -> decltype(objs[0]->Merge((TCollection *)nullptr), void())
    {
+      if constexpr (std::is_base_of<TH1, H>::value) {
+         // histograms with fixed axes have the same binning in all slots and can be merged pairwise concurrently
+         if (objs.size() > 2 && !objs[0]->CanExtendAllAxes()) {
+            const auto mergePair = [&objs](std::size_t to, std::size_t from) {
+               TList pair;
+               pair.Add(objs[from]);
+               objs[to]->Merge(&pair);
+            };
+            if (MergeInParallel(objs.size(), mergePair))
+               return;
+         }
+      }
       TList l;
       for (auto it = ++objs.begin(); it != objs.end(); ++it)
          l.Add(*it);
@@ -449,6 +614,12 @@ class R__CLING_PTRCHECK(off) FillHelper : public RActionImpl<FillHelper<HIST>> {
       // TODO this could be simplified with fold expressions or std::apply in C++17
       auto nop = [](auto &&...) {};
       for (; GetNthElement<ColIdx>(its...) != end; nop(++its...)) {
+         if constexpr (IsFillNArgs<std::decay_t<decltype(*its)>...>()) {
+            if (fUseFillN) {
+               BufferFillN(slot, *its...);
+               continue;
+            }
+         }
          thisSlotH->Fill(*its...);
       }
    }
@@ -457,7 +628,8 @@ public:
    FillHelper(FillHelper &&) = default;
    FillHelper(const FillHelper &) = delete;
 
-   FillHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots) : fObjects(nSlots, nullptr)
+   FillHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fObjects(nSlots, nullptr), fFillNBuffers(nSlots), fUseFillN(CanUseFillN(h.get()))
    {
       fObjects[0] = h.get();
       // Initialize all other slots
@@ -465,6 +637,10 @@ public:
          fObjects[i] = new HIST(*fObjects[0]);
          UnsetDirectoryIfPossible(fObjects[i]);
       }
+      if (fUseFillN) {
+         for (auto &buf : fFillNBuffers)
+            buf.fX.reserve(kFillNBufferSize);
+      }
    }
 
    void InitTask(TTreeReader *, unsigned int) {}
@@ -473,6 +649,12 @@ public:
    template <typename... ValTypes, std::enable_if_t<!Disjunction<IsDataContainer<ValTypes>...>::value, int> = 0>
    auto Exec(unsigned int slot, const ValTypes &...x) -> decltype(fObjects[slot]->Fill(x...), void())
    {
+      if constexpr (IsFillNArgs<ValTypes...>()) {
+         if (fUseFillN) {
+            BufferFillN(slot, x...);
+            return;
+         }
+      }
       fObjects[slot]->Fill(x...);
    }
 
@@ -513,8 +695,13 @@ public:
 
    void Initialize() { /* noop */}
 
+   void FinalizeTask(unsigned int slot) { FlushFillN(slot); }
+
    void Finalize()
    {
+      for (unsigned int slot = 0; slot < fObjects.size(); ++slot)
+         FlushFillN(slot);
+
       if (fObjects.size() == 1)
          return;
 
@@ -525,7 +712,11 @@ public:
          delete *it;
    }
 
-   HIST &PartialUpdate(unsigned int slot) { return *fObjects[slot]; }
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      FlushFillN(slot);
+      return *fObjects[slot];
+   }
 
    // Helper functions for RMergeableValue
    std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
@@ -555,6 +746,148 @@ public:
       UnsetDirectoryIfPossible(result.get());
       return FillHelper(result, fObjects.size());
    }
+
+   /// Return an object that fills the per-slot histograms of all the variations of an entry at once, or null if the
+   /// histograms are not supported by RVariedHistoFiller. Only histograms filled with scalar numbers are considered.
+   template <typename... ColTypes, typename H = HIST,
+             std::enable_if_t<std::is_base_of<TH1, H>::value && (std::is_arithmetic<ColTypes>::value && ...), int> = 0>
+   static std::unique_ptr<RVariedHistoFiller>
+   MakeVariationsFiller(std::vector<FillHelper> &helpers, TypeList<ColTypes...>)
+   {
+      std::vector<std::vector<TH1 *>> hists;
+      for (auto &h : helpers)
+         hists.emplace_back(h.fObjects.begin(), h.fObjects.end());
+      return RVariedHistoFiller::Make(std::move(hists), sizeof...(ColTypes));
+   }
+};
+
+
+/// Fills one TH1D, TH2D or TH3D from all slots: the bin contents and the sums of squares of weights are updated with
+/// relaxed atomic additions, while the other statistics are accumulated per slot and added to the histogram in
+/// Finalize(). Histograms that can extend their axes are not supported, as extending would move the bins.
+class RSharedHistoFiller {
+   /// Statistics of one slot, in the order of TH1::GetStats, on a cache line of its own
+   struct alignas(kCacheLineSize) RSlotStats {
+      double fStats[TH1::kNstat] = {};
+      ULong64_t fEntries = 0;
+   };
+
+   TH1 *fHist = nullptr;
+   double *fBins = nullptr;  ///< The bin contents of fHist
+   double *fSumw2 = nullptr; ///< The sums of squares of weights of fHist, nullptr if they are not stored
+   int fDim = 1;
+   bool fIsWeighted = false;   ///< Whether the value after the fDim coordinates is a weight
+   bool fStatOverflows = false; ///< Whether under/overflows enter the statistics, see TH1::GetStatOverflowsBehaviour
+   std::vector<RSlotStats> fSlotStats;
+
+public:
+   RSharedHistoFiller(TH1 &h, unsigned int nSlots, std::size_t nColumns);
+   /// Fill the coordinates in values[0..fDim), followed by the weight if the histogram is filled with weights
+   void Fill(unsigned int slot, const double *values);
+   void Finalize();
+};
+
+/// The helper of the Histo1D, Histo2D and Histo3D actions with the EFillStrategy::kSharedAtomic strategy.
+/// Contrary to FillHelper, no per-slot copies of the histogram are created and no merge is needed.
+template <typename HIST>
+class R__CLING_PTRCHECK(off) SharedFillHelper : public RActionImpl<SharedFillHelper<HIST>> {
+   std::shared_ptr<HIST> fResultHist;
+   unsigned int fNSlots;
+   std::size_t fNColumns;
+   RSharedHistoFiller fFiller;
+
+   template <typename T>
+   static auto Begin(const T &x)
+   {
+      if constexpr (IsDataContainer<T>::value)
+         return std::begin(x);
+      else
+         return &x;
+   }
+
+   template <typename T, typename It>
+   static void Advance(It &it)
+   {
+      if constexpr (IsDataContainer<T>::value)
+         ++it;
+   }
+
+   template <typename T>
+   static std::size_t GetSize(const T &x)
+   {
+      if constexpr (IsDataContainer<T>::value)
+         return std::size(x);
+      else
+         return 1;
+   }
+
+public:
+   SharedFillHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots, std::size_t nColumns)
+      : fResultHist(h), fNSlots(nSlots), fNColumns(nColumns), fFiller(*h, nSlots, nColumns)
+   {
+   }
+   SharedFillHelper(SharedFillHelper &&) = default;
+   SharedFillHelper(const SharedFillHelper &) = delete;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   // no container arguments
+   template <typename... ValTypes, std::enable_if_t<!Disjunction<IsDataContainer<ValTypes>...>::value, int> = 0>
+   void Exec(unsigned int slot, const ValTypes &...x)
+   {
+      const double values[] = {static_cast<double>(x)...};
+      fFiller.Fill(slot, values);
+   }
+
+   // at least one container argument: scalars are repeated for every element of the containers
+   template <typename... Xs, std::enable_if_t<Disjunction<IsDataContainer<Xs>...>::value, int> = 0>
+   void Exec(unsigned int slot, const Xs &...xs)
+   {
+      constexpr std::array<bool, sizeof...(Xs)> isContainer{IsDataContainer<Xs>::value...};
+      const std::array<std::size_t, sizeof...(Xs)> sizes{{GetSize(xs)...}};
+      const auto size = sizes[FindIdxTrue(isContainer)];
+      for (std::size_t i = 0; i < sizeof...(Xs); ++i) {
+         if (isContainer[i] && sizes[i] != size)
+            throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
+      }
+
+      auto its = std::make_tuple(Begin(xs)...);
+      for (std::size_t i = 0; i < size; ++i) {
+         std::apply(
+            [&](auto &...it) {
+               const double values[] = {static_cast<double>(*it)...};
+               fFiller.Fill(slot, values);
+               (Advance<Xs>(it), ...);
+            },
+            its);
+      }
+   }
+
+   void Initialize() { /* noop */}
+
+   void Finalize() { fFiller.Finalize(); }
+
+   /// The statistics of the shared histogram are only updated at the end of the event loop
+   HIST &PartialUpdate(unsigned int) { return *fResultHist; }
+
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableFill<HIST>>(*fResultHist);
+   }
+
+   std::string GetActionName()
+   {
+      return std::string(fResultHist->IsA()->GetName()) + "\\n" + std::string(fResultHist->GetName());
+   }
+
+   SharedFillHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<HIST> *>(newResult);
+      result->Reset();
+      result->SetDirectory(nullptr);
+      return SharedFillHelper(result, fNSlots, fNColumns);
+   }
 };
 
 class R__CLING_PTRCHECK(off) FillTGraphHelper : public ROOT::Detail::RDF::RActionImpl<FillTGraphHelper> {
@@ -1031,6 +1364,17 @@ public:
 
    ResultType &PartialUpdate(unsigned int slot) { return fMins[slot]; }
 
+   /// Set the minimum from exact statistics of the dataset column, see RDataSource::GetColumnStatsFromMetadata()
+   template <typename T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+   bool SetResultFromMetadata(RLoopManager &lm, const std::vector<std::string> &columns, TypeList<T>)
+   {
+      const auto stats = lm.GetColumnStatsFromMetadata(columns[0]);
+      if (!stats || !stats->fIsExact)
+         return false;
+      *fResultMin = static_cast<ResultType>(stats->fMin);
+      return true;
+   }
+
    std::string GetActionName() { return "Min"; }
 
    MinHelper MakeNew(void *newResult)
@@ -1081,6 +1425,17 @@ public:
 
    ResultType &PartialUpdate(unsigned int slot) { return fMaxs[slot]; }
 
+   /// Set the maximum from exact statistics of the dataset column, see RDataSource::GetColumnStatsFromMetadata()
+   template <typename T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+   bool SetResultFromMetadata(RLoopManager &lm, const std::vector<std::string> &columns, TypeList<T>)
+   {
+      const auto stats = lm.GetColumnStatsFromMetadata(columns[0]);
+      if (!stats || !stats->fIsExact)
+         return false;
+      *fResultMax = static_cast<ResultType>(stats->fMax);
+      return true;
+   }
+
    std::string GetActionName() { return "Max"; }
 
    MaxHelper MakeNew(void *newResult)
@@ -1090,6 +1445,9 @@ public:
    }
 };
 
+template <typename ResultType>
+class RVariedSummer;
+
 template <typename ResultType>
 class R__CLING_PTRCHECK(off) SumHelper : public RActionImpl<SumHelper<ResultType>> {
    std::shared_ptr<ResultType> fResultSum;
@@ -1172,6 +1530,61 @@ public:
       *result = NeutralElement(*result, -1);
       return SumHelper(result, fSums.size());
    }
+
+   /// Return an object that sums the values of all the variations of an entry at once, for scalar numbers.
+   template <typename T, typename R = ResultType,
+             std::enable_if_t<std::is_arithmetic<T>::value && std::is_arithmetic<R>::value, int> = 0>
+   static std::unique_ptr<RVariedSummer<ResultType>> MakeVariationsFiller(std::vector<SumHelper> &helpers, TypeList<T>)
+   {
+      return std::make_unique<RVariedSummer<ResultType>>(helpers, helpers[0].fSums.size());
+   }
+};
+
+/// Sums the values of all the systematic variations of a Sum action at once, see RVariedAction.
+/// The Kahan sums of each slot are kept in contiguous arrays and added to the helpers at the end of each task.
+template <typename ResultType>
+class RVariedSummer {
+   struct RSlotData {
+      std::vector<ResultType> fSums;
+      std::vector<ResultType> fCompensations;
+   };
+   std::vector<SumHelper<ResultType>> &fHelpers;
+   /// Per slot, allocated separately to avoid false sharing
+   std::vector<std::unique_ptr<RSlotData>> fSlots;
+
+public:
+   RVariedSummer(std::vector<SumHelper<ResultType>> &helpers, unsigned int nSlots) : fHelpers(helpers)
+   {
+      for (auto i = 0u; i < nSlots; ++i)
+         fSlots.emplace_back(new RSlotData{std::vector<ResultType>(helpers.size()),
+                                           std::vector<ResultType>(helpers.size())});
+   }
+
+   template <typename T>
+   void Exec(unsigned int slot, const unsigned int *varIdx, std::size_t n, const T *const *values)
+   {
+      auto *sums = fSlots[slot]->fSums.data();
+      auto *compensations = fSlots[slot]->fCompensations.data();
+      for (std::size_t i = 0; i < n; ++i) {
+         const auto v = varIdx[i];
+         // Kahan Sum:
+         ResultType y = static_cast<ResultType>(*values[i]) - compensations[v];
+         ResultType t = sums[v] + y;
+         compensations[v] = (t - sums[v]) - y;
+         sums[v] = t;
+      }
+   }
+
+   void FinalizeTask(unsigned int slot)
+   {
+      auto &data = *fSlots[slot];
+      for (std::size_t v = 0; v < fHelpers.size(); ++v) {
+         // the compensation holds the opposite of the low-order part lost by the sum
+         fHelpers[v].Exec(slot, data.fSums[v]);
+         fHelpers[v].Exec(slot, -data.fCompensations[v]);
+         data.fSums[v] = data.fCompensations[v] = ResultType{};
+      }
+   }
 };
 
 class R__CLING_PTRCHECK(off) MeanHelper : public RActionImpl<MeanHelper> {
@@ -1818,6 +2231,156 @@ public:
    }
 };
 
+#ifdef R__HAS_ROOT7
+/// Helper object for a Snapshot action writing an RNTuple, in single-thread and multi-thread runs.
+/// Every slot fills its own RNTupleFillContext of a common RNTupleParallelWriter, so slots only synchronize when
+/// they append a full cluster. As for TTree output, the order of the input entries is preserved only in
+/// single-thread runs.
+template <typename... ColTypes>
+class R__CLING_PTRCHECK(off) SnapshotRNTupleHelper : public RActionImpl<SnapshotRNTupleHelper<ColTypes...>> {
+   unsigned int fNSlots;
+   std::string fFileName;
+   std::string fNTupleName;
+   RSnapshotOptions fOptions;
+   ColumnNames_t fInputFieldNames; // This contains the resolved aliases
+   ColumnNames_t fOutputFieldNames;
+   std::function<void()> fOnWritten;   // Lets the result of the action read the output, see RInterface::Snapshot
+   std::unique_ptr<TFile> fOutputFile; // Only set in "UPDATE" mode
+   std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter> fWriter;
+   std::vector<std::shared_ptr<ROOT::Experimental::RNTupleFillContext>> fFillContexts;
+   std::vector<std::unique_ptr<ROOT::Experimental::REntry>> fEntries;
+   std::vector<std::vector<ROOT::Experimental::REntry::RFieldToken>> fTokens;
+   bool fHasRun = false;
+
+   template <std::size_t... S>
+   void AddFields(ROOT::Experimental::RNTupleModel &model, std::index_sequence<S...>)
+   {
+      (model.AddField(std::make_unique<ROOT::Experimental::RField<ColTypes>>(fOutputFieldNames[S])), ...);
+      (void)model; // in case there are no columns
+   }
+
+   template <std::size_t... S>
+   void BindValues(unsigned int slot, std::index_sequence<S...>, ColTypes &...values)
+   {
+      auto &entry = *fEntries[slot];
+      (entry.BindRawPtr(fTokens[slot][S], &values), ...);
+      (void)entry;
+   }
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   SnapshotRNTupleHelper(unsigned int nSlots, std::string_view filename, std::string_view dirname,
+                         std::string_view ntuplename, const ColumnNames_t &vfnames, const ColumnNames_t &fnames,
+                         const RSnapshotOptions &options, std::function<void()> onWritten)
+      : fNSlots(nSlots), fFileName(filename), fNTupleName(ntuplename), fOptions(options), fInputFieldNames(vfnames),
+        fOutputFieldNames(ReplaceDotWithUnderscore(fnames)), fOnWritten(std::move(onWritten))
+   {
+      if (!dirname.empty()) {
+         throw std::invalid_argument("Snapshot: RNTuple output cannot be written into the sub-directory \"" +
+                                     std::string(dirname) + "\"");
+      }
+      ValidateSnapshotOutput(fOptions, fNTupleName, fFileName);
+   }
+   SnapshotRNTupleHelper(const SnapshotRNTupleHelper &) = delete;
+   SnapshotRNTupleHelper(SnapshotRNTupleHelper &&) = default;
+   ~SnapshotRNTupleHelper()
+   {
+      if (!fNTupleName.empty() /*not moved from*/ && fOptions.fLazy && !fHasRun)
+         Warning("Snapshot", "A lazy Snapshot action was booked but never triggered.");
+   }
+
+   void Initialize()
+   {
+      auto model = ROOT::Experimental::RNTupleModel::CreateBare();
+      AddFields(*model, std::index_sequence_for<ColTypes...>{});
+      ROOT::Experimental::RNTupleWriteOptions writeOptions;
+      writeOptions.SetCompression(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel);
+      if (fOptions.fMemoryBudget > 0) {
+         // Every slot buffers one cluster, whose pages are at most as big as the cluster
+         const std::size_t clusterSize = std::max<std::size_t>(fOptions.fMemoryBudget / fNSlots, 64 * 1024);
+         writeOptions.SetApproxZippedClusterSize(std::min(writeOptions.GetApproxZippedClusterSize(), clusterSize));
+         writeOptions.SetMaxUnzippedPageSize(std::min(writeOptions.GetMaxUnzippedPageSize(), clusterSize));
+         writeOptions.SetMaxUnzippedClusterSize(clusterSize);
+      }
+
+      TString mode = fOptions.fMode;
+      mode.ToLower();
+      if (mode == "update") {
+         ::TDirectory::TContext c;
+         fOutputFile.reset(TFile::Open(fFileName.c_str(), "UPDATE"));
+         if (!fOutputFile || fOutputFile->IsZombie())
+            throw std::runtime_error("Snapshot: could not open output file " + fFileName);
+         fWriter = ROOT::Experimental::RNTupleParallelWriter::Append(std::move(model), fNTupleName, *fOutputFile,
+                                                                     writeOptions);
+      } else {
+         fWriter = ROOT::Experimental::RNTupleParallelWriter::Recreate(std::move(model), fNTupleName, fFileName,
+                                                                       writeOptions);
+      }
+      fFillContexts.resize(fNSlots);
+      fEntries.resize(fNSlots);
+      fTokens.resize(fNSlots);
+      fHasRun = true;
+   }
+
+   void InitTask(TTreeReader *, unsigned int slot)
+   {
+      // the fill context of a slot is kept across tasks, so that it can fill complete clusters
+      if (fFillContexts[slot])
+         return;
+      fFillContexts[slot] = fWriter->CreateFillContext();
+      fEntries[slot] = fFillContexts[slot]->GetModel().CreateBareEntry();
+      for (const auto &name : fOutputFieldNames)
+         fTokens[slot].emplace_back(fEntries[slot]->GetToken(name));
+   }
+
+   void Exec(unsigned int slot, ColTypes &...values)
+   {
+      BindValues(slot, std::index_sequence_for<ColTypes...>{}, values...);
+      fFillContexts[slot]->Fill(*fEntries[slot]);
+   }
+
+   void Finalize()
+   {
+      std::uint64_t nEntries = 0;
+      for (const auto &context : fFillContexts) {
+         if (context)
+            nEntries += context->GetNEntries();
+      }
+      // destroying the fill contexts flushes their last clusters, destroying the writer commits the dataset
+      fEntries.clear();
+      fTokens.clear();
+      fFillContexts.clear();
+      fWriter.reset();
+      fOutputFile.reset();
+
+      if (nEntries == 0) {
+         Warning("Snapshot",
+                 "No input entries (input dataset was empty or no entry passed the Filters). Output RNTuple is empty.");
+      }
+      if (fOnWritten)
+         fOnWritten();
+   }
+
+   std::string GetActionName() { return "Snapshot"; }
+
+   /**
+    * @brief Create a new SnapshotRNTupleHelper with a different output file name
+    *
+    * @param newName A type-erased string with the output file name
+    * @return SnapshotRNTupleHelper
+    *
+    * As for the TTree Snapshot helpers, the result of the cloned action is shared with the original one and keeps
+    * reading the original output file.
+    */
+   SnapshotRNTupleHelper MakeNew(void *newName)
+   {
+      const std::string finalName = *reinterpret_cast<const std::string *>(newName);
+      return SnapshotRNTupleHelper{fNSlots,          finalName,         "",       fNTupleName,
+                                   fInputFieldNames, fOutputFieldNames, fOptions, {}};
+   }
+};
+#endif // R__HAS_ROOT7
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class R__CLING_PTRCHECK(off) AggregateHelper
@@ -145,6 +145,10 @@ public:
       };
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Shows the time spent in the node, as measured by the RDataFrame profiler
+   void AddProfileTime(double seconds) { fName += "\\n" + std::to_string(seconds * 1e3) + " ms"; }
+
    std::string GetColor() const { return fColor; }
    unsigned int GetID() const { return fID; }
    std::string GetName() const { return fName; }
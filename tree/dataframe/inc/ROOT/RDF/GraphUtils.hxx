@@ -68,6 +68,10 @@ private:
    /// \brief Starting by an array of leaves, it draws the entire graph.
    std::string FromGraphActionsToDot(std::vector<std::shared_ptr<GraphNode>> leaves) const;
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Adds the times measured by the profiler of the loop manager, if any, to the visited nodes.
+   void AddProfileTimes(const RLoopManager &loopManager);
+
 public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Starting from the root node, prints the entire graph.
@@ -85,7 +89,9 @@ public:
       auto loopManager = rInterface.GetLoopManager();
       loopManager->Jit();
 
-      return FromGraphLeafToDot(*rInterface.GetProxiedPtr()->GetGraph(fVisitedMap));
+      auto leaf = rInterface.GetProxiedPtr()->GetGraph(fVisitedMap);
+      AddProfileTimes(*loopManager);
+      return FromGraphLeafToDot(*leaf);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -98,7 +104,9 @@ public:
       loopManager->Jit();
 
       auto actionPtr = resultPtr.fActionPtr;
-      return FromGraphLeafToDot(*actionPtr->GetGraph(fVisitedMap));
+      auto leaf = actionPtr->GetGraph(fVisitedMap);
+      AddProfileTimes(*loopManager);
+      return FromGraphLeafToDot(*leaf);
    }
 };
 
@@ -27,6 +27,12 @@ namespace ROOT {
 
 namespace RDF {
 
+/// How the Histo1D, Histo2D and Histo3D actions fill their result in multi-thread event loops
+enum class EFillStrategy {
+   kPerSlot,     ///< Each slot fills its own copy of the histogram; the copies are merged at the end of the event loop
+   kSharedAtomic ///< All slots fill the same histogram with atomic additions to the bin contents, using no extra memory
+};
+
 struct TH1DModel {
    TString fName;
    TString fTitle;
@@ -34,6 +40,7 @@ struct TH1DModel {
    double fXLow = 0.;
    double fXUp = 64.;
    std::vector<double> fBinXEdges;
+   EFillStrategy fFillStrategy = EFillStrategy::kPerSlot;
 
    TH1DModel() = default;
    TH1DModel(const TH1DModel &) = default;
@@ -56,6 +63,7 @@ struct TH2DModel {
    double fYUp = 64.;
    std::vector<double> fBinXEdges;
    std::vector<double> fBinYEdges;
+   EFillStrategy fFillStrategy = EFillStrategy::kPerSlot;
 
    TH2DModel() = default;
    TH2DModel(const TH2DModel &) = default;
@@ -85,6 +93,7 @@ struct TH3DModel {
    std::vector<double> fBinXEdges;
    std::vector<double> fBinYEdges;
    std::vector<double> fBinZEdges;
+   EFillStrategy fFillStrategy = EFillStrategy::kPerSlot;
 
    TH3DModel() = default;
    TH3DModel(const TH3DModel &) = default;
@@ -92,6 +92,7 @@ namespace ActionTags {
 struct Histo1D{};
 struct Histo2D{};
 struct Histo3D{};
+struct SharedFill{};
 struct HistoND{};
 struct Graph{};
 struct GraphAsymmErrors{};
@@ -155,6 +156,17 @@ BuildAction(const ColumnNames_t &bl, const std::shared_ptr<::TH1D> &h, const uns
    }
 }
 
+// Histo1D, Histo2D and Histo3D filling with the EFillStrategy::kSharedAtomic strategy
+template <typename... ColTypes, typename ActionResultType, typename PrevNodeType>
+std::unique_ptr<RActionBase>
+BuildAction(const ColumnNames_t &bl, const std::shared_ptr<ActionResultType> &h, const unsigned int nSlots,
+            std::shared_ptr<PrevNodeType> prevNode, ActionTags::SharedFill, const RColumnRegister &colRegister)
+{
+   using Helper_t = SharedFillHelper<ActionResultType>;
+   using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
+   return std::make_unique<Action_t>(Helper_t(h, nSlots, sizeof...(ColTypes)), bl, std::move(prevNode), colRegister);
+}
+
 template <typename... ColTypes, typename PrevNodeType>
 std::unique_ptr<RActionBase>
 BuildAction(const ColumnNames_t &bl, const std::shared_ptr<TGraph> &g, const unsigned int nSlots,
@@ -250,6 +262,7 @@ struct SnapshotHelperArgs {
    std::string fTreeName;
    std::vector<std::string> fOutputColNames;
    ROOT::RDF::RSnapshotOptions fOptions;
+   std::function<void()> fOnWritten; ///< Called once the output has been written, only used for RNTuple output
 };
 
 // Snapshot action
@@ -271,7 +284,18 @@ BuildAction(const ColumnNames_t &colNames, const std::shared_ptr<SnapshotHelperA
       isDefine[i] = colRegister.IsDefineOrAlias(colNames[i]);
 
    std::unique_ptr<RActionBase> actionPtr;
-   if (!ROOT::IsImplicitMTEnabled()) {
+   if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple) {
+#ifdef R__HAS_ROOT7
+      // the same helper serves single-thread and multi-thread snapshots, with one fill context per slot
+      using Helper_t = SnapshotRNTupleHelper<ColTypes...>;
+      using Action_t = RAction<Helper_t, PrevNodeType>;
+      actionPtr.reset(new Action_t(Helper_t(nSlots, filename, dirname, treename, colNames, outputColNames, options,
+                                            snapHelperArgs->fOnWritten),
+                                   colNames, prevNode, colRegister));
+#else
+      throw std::invalid_argument("Snapshot: RNTuple output requires ROOT to be built with root7=ON");
+#endif
+   } else if (!ROOT::IsImplicitMTEnabled()) {
       // single-thread snapshot
       using Helper_t = SnapshotHelper<ColTypes...>;
       using Action_t = RAction<Helper_t, PrevNodeType>;
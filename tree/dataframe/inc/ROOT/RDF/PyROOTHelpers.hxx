@@ -12,7 +12,15 @@
 #define ROOT_PyROOTHelpers
 
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RVec.hxx"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 #include <string>
 #include <utility>
@@ -69,6 +77,366 @@ ROOT::RDF::RResultPtr<std::vector<T>> RDataFrameTake(ROOT::RDF::RNode df, std::s
    return df.Take<T>(column);
 }
 
+/// Contiguous arrays filled by AsNumpyBuffers(), which numpy adopts without copying them. For each column, the
+/// values and, for jagged (RVec) columns, the nEntries + 1 offsets of the rows in the values, as in Awkward arrays.
+class RNumpyBuffers {
+   ULong64_t fNEntries = 0;
+   std::vector<std::shared_ptr<void>> fStorage; ///< Owns the arrays
+   std::vector<ULong64_t> fValuesAddress;
+   std::vector<ULong64_t> fNValues;
+   std::vector<ULong64_t> fOffsetsAddress; ///< 0 for the columns that are not jagged
+
+public:
+   explicit RNumpyBuffers(ULong64_t nEntries) : fNEntries(nEntries) {}
+
+   template <typename T>
+   void AddColumn(std::shared_ptr<std::vector<T>> values, std::shared_ptr<std::vector<ULong64_t>> offsets)
+   {
+      fValuesAddress.emplace_back(reinterpret_cast<ULong64_t>(values->data()));
+      fNValues.emplace_back(values->size());
+      fOffsetsAddress.emplace_back(offsets ? reinterpret_cast<ULong64_t>(offsets->data()) : 0);
+      fStorage.emplace_back(std::move(values));
+      if (offsets)
+         fStorage.emplace_back(std::move(offsets));
+   }
+
+   ULong64_t GetNEntries() const { return fNEntries; }
+   std::size_t GetNColumns() const { return fValuesAddress.size(); }
+   ULong64_t GetValuesAddress(std::size_t i) const { return fValuesAddress[i]; }
+   ULong64_t GetNValues(std::size_t i) const { return fNValues[i]; }
+   bool IsJagged(std::size_t i) const { return fOffsetsAddress[i] != 0; }
+   ULong64_t GetOffsetsAddress(std::size_t i) const { return fOffsetsAddress[i]; }
+};
+
+/// How the values of a column are stored by AsNumpyBuffers(): booleans as bytes, as numpy does, RVecs flattened
+template <typename T>
+struct RNumpyColumnTraits {
+   using Value_t = std::conditional_t<std::is_same<T, bool>::value, unsigned char, T>;
+   static constexpr bool kIsJagged = false;
+};
+
+template <typename T>
+struct RNumpyColumnTraits<ROOT::RVec<T>> {
+   using Value_t = typename RNumpyColumnTraits<T>::Value_t;
+   static constexpr bool kIsJagged = true;
+};
+
+/// Writes the rows of an event loop into preallocated arrays. The slots claim chunks of consecutive rows from a
+/// shared cursor and write into them directly, so that no per-slot vector has to be merged. The chunks that are
+/// still partially filled at the end leave holes, which are filled with the rows that found no chunk left.
+/// Rows are therefore in the same order in all the columns, but not in entry order in multi-thread runs.
+template <typename... ColTypes>
+class RNumpyFiller {
+   static constexpr std::size_t kNColumns = sizeof...(ColTypes);
+   static constexpr ULong64_t kChunkSize = 4096;
+
+   struct RChunk {
+      ULong64_t fBegin = 0;
+      ULong64_t fEnd = 0;
+      ULong64_t fFilled = 0;                          ///< End of the rows written so far
+      std::array<ULong64_t, kNColumns> fJaggedBegin{}; ///< Start of the chunk in the jagged values of its slot
+      unsigned int fSlot = 0;
+   };
+
+   struct RSlotData {
+      std::vector<RChunk> fChunks; ///< The last one is being filled
+      std::tuple<std::vector<typename RNumpyColumnTraits<ColTypes>::Value_t>...> fJaggedValues;
+      std::vector<std::tuple<ColTypes...>> fOverflow; ///< Rows written after the last chunk was claimed
+   };
+
+   ULong64_t fNEntries;
+   std::atomic<ULong64_t> fCursor{0};
+   std::vector<RSlotData> fSlots;
+   /// Column values, allocated upfront unless jagged
+   std::tuple<std::shared_ptr<std::vector<typename RNumpyColumnTraits<ColTypes>::Value_t>>...> fValues;
+   /// Offsets of the jagged columns, holding the length of row i at i + 1 until Finalize()
+   std::array<std::shared_ptr<std::vector<ULong64_t>>, kNColumns> fOffsets;
+
+   template <std::size_t... Idx>
+   void Allocate(std::index_sequence<Idx...>)
+   {
+      auto allocate = [this](auto &values, auto &offsets, bool isJagged) {
+         using Values_t = typename std::decay_t<decltype(values)>::element_type;
+         values = std::make_shared<Values_t>(isJagged ? 0 : fNEntries);
+         if (isJagged)
+            offsets = std::make_shared<std::vector<ULong64_t>>(fNEntries + 1);
+      };
+      (allocate(std::get<Idx>(fValues), fOffsets[Idx], RNumpyColumnTraits<ColTypes>::kIsJagged), ...);
+   }
+
+   template <std::size_t Idx, typename T>
+   void WriteValue(ULong64_t row, std::vector<typename RNumpyColumnTraits<T>::Value_t> &jaggedValues, const T &value)
+   {
+      if constexpr (RNumpyColumnTraits<T>::kIsJagged) {
+         jaggedValues.insert(jaggedValues.end(), value.begin(), value.end());
+         (*fOffsets[Idx])[row + 1] = value.size();
+      } else {
+         (*std::get<Idx>(fValues))[row] = value;
+      }
+   }
+
+   template <std::size_t... Idx>
+   void WriteRow(ULong64_t row, RSlotData &slotData, std::index_sequence<Idx...>, const ColTypes &...values)
+   {
+      (WriteValue<Idx>(row, std::get<Idx>(slotData.fJaggedValues), values), ...);
+   }
+
+   template <std::size_t... Idx>
+   std::array<ULong64_t, kNColumns> GetJaggedSizes(const RSlotData &slotData, std::index_sequence<Idx...>) const
+   {
+      return {std::get<Idx>(slotData.fJaggedValues).size()...};
+   }
+
+   /// Gather the jagged values of column Idx in row order, now that the offsets are known
+   template <std::size_t Idx>
+   void GatherJagged(const std::vector<const RChunk *> &chunks,
+                     const std::vector<std::pair<ULong64_t, const std::tuple<ColTypes...> *>> &holes)
+   {
+      using Col_t = std::tuple_element_t<Idx, std::tuple<ColTypes...>>;
+      if constexpr (RNumpyColumnTraits<Col_t>::kIsJagged) {
+         const auto &offsets = *fOffsets[Idx];
+         auto &values = *std::get<Idx>(fValues);
+         values.resize(offsets[fNEntries]);
+         for (auto chunk : chunks) {
+            const auto &slotValues = std::get<Idx>(fSlots[chunk->fSlot].fJaggedValues);
+            const auto begin = slotValues.begin() + chunk->fJaggedBegin[Idx];
+            std::copy(begin, begin + (offsets[chunk->fFilled] - offsets[chunk->fBegin]),
+                      values.begin() + offsets[chunk->fBegin]);
+         }
+         for (const auto &[row, rowValues] : holes) {
+            const auto &rvec = std::get<Idx>(*rowValues);
+            std::copy(rvec.begin(), rvec.end(), values.begin() + offsets[row]);
+         }
+      }
+   }
+
+   template <std::size_t... Idx>
+   void FillHoles(const std::vector<std::pair<ULong64_t, const std::tuple<ColTypes...> *>> &holes,
+                  const std::vector<const RChunk *> &chunks, std::index_sequence<Idx...>)
+   {
+      for (const auto &[row, rowValues] : holes) {
+         // the jagged values of the holes are gathered from the rows themselves
+         std::tuple<std::vector<typename RNumpyColumnTraits<ColTypes>::Value_t>...> discarded;
+         (WriteValue<Idx>(row, std::get<Idx>(discarded), std::get<Idx>(*rowValues)), ...);
+      }
+      for (auto &offsets : fOffsets) {
+         if (!offsets)
+            continue;
+         for (ULong64_t i = 0; i < fNEntries; ++i)
+            (*offsets)[i + 1] += (*offsets)[i];
+      }
+      (GatherJagged<Idx>(chunks, holes), ...);
+   }
+
+public:
+   RNumpyFiller(ULong64_t nEntries, unsigned int nSlots) : fNEntries(nEntries), fSlots(nSlots)
+   {
+      Allocate(std::index_sequence_for<ColTypes...>());
+   }
+
+   void Exec(unsigned int slot, const ColTypes &...values)
+   {
+      auto &slotData = fSlots[slot];
+      if (slotData.fChunks.empty() || slotData.fChunks.back().fFilled == slotData.fChunks.back().fEnd) {
+         const auto begin = fCursor.fetch_add(kChunkSize);
+         if (begin >= fNEntries) {
+            slotData.fOverflow.emplace_back(values...);
+            return;
+         }
+         RChunk chunk;
+         chunk.fBegin = chunk.fFilled = begin;
+         chunk.fEnd = std::min(begin + kChunkSize, fNEntries);
+         chunk.fJaggedBegin = GetJaggedSizes(slotData, std::index_sequence_for<ColTypes...>());
+         chunk.fSlot = slot;
+         slotData.fChunks.emplace_back(chunk);
+      }
+      WriteRow(slotData.fChunks.back().fFilled++, slotData, std::index_sequence_for<ColTypes...>(), values...);
+   }
+
+   RNumpyBuffers Finalize()
+   {
+      std::vector<const RChunk *> chunks;
+      for (const auto &slotData : fSlots) {
+         for (const auto &chunk : slotData.fChunks)
+            chunks.emplace_back(&chunk);
+      }
+      std::sort(chunks.begin(), chunks.end(), [](const RChunk *a, const RChunk *b) { return a->fBegin < b->fBegin; });
+
+      // The rows that were not written: the ends of the partially filled chunks and the rows never claimed
+      std::vector<ULong64_t> holeRows;
+      for (auto chunk : chunks) {
+         for (auto row = chunk->fFilled; row < chunk->fEnd; ++row)
+            holeRows.emplace_back(row);
+      }
+      for (auto row = std::min<ULong64_t>(fCursor.load(), fNEntries); row < fNEntries; ++row)
+         holeRows.emplace_back(row);
+      std::vector<const std::tuple<ColTypes...> *> overflow;
+      for (const auto &slotData : fSlots) {
+         for (const auto &row : slotData.fOverflow)
+            overflow.emplace_back(&row);
+      }
+      if (overflow.size() != holeRows.size()) {
+         throw std::runtime_error("AsNumpy: the event loop processed " +
+                                  std::to_string(fNEntries - holeRows.size() + overflow.size()) +
+                                  " entries, but the output arrays were allocated for " + std::to_string(fNEntries));
+      }
+      std::vector<std::pair<ULong64_t, const std::tuple<ColTypes...> *>> holes(holeRows.size());
+      for (std::size_t i = 0; i < holeRows.size(); ++i)
+         holes[i] = {holeRows[i], overflow[i]};
+      FillHoles(holes, chunks, std::index_sequence_for<ColTypes...>());
+
+      RNumpyBuffers buffers(fNEntries);
+      std::size_t i = 0;
+      std::apply([&](auto &...values) { (buffers.AddColumn(std::move(values), std::move(fOffsets[i++])), ...); },
+                 fValues);
+      return buffers;
+   }
+};
+
+/// Read columns into contiguous arrays allocated upfront, without intermediate per-slot vectors.
+/// \param[in] df The dataframe node.
+/// \param[in] columns The columns to read, of types ColTypes. RVec columns are returned as offsets and values.
+/// \param[in] nEntries Number of entries passing the filters of the node if known, e.g. the number of entries of
+///            the dataset without filters. If negative, a Count() pass computes it first.
+/// The event loop can run multi-threaded: each slot writes its rows into disjoint ranges of the arrays.
+template <typename... ColTypes>
+RNumpyBuffers AsNumpyBuffers(ROOT::RDF::RNode df, const std::vector<std::string> &columns, Long64_t nEntries = -1)
+{
+   if (nEntries < 0)
+      nEntries = *df.Count();
+   auto filler = std::make_shared<RNumpyFiller<ColTypes...>>(nEntries, df.GetNSlots());
+   df.ForeachSlot([filler](unsigned int slot, const ColTypes &...values) { filler->Exec(slot, values...); },
+                  columns);
+   return filler->Finalize();
+}
+
+/// Evaluates a vectorised callback on batches of entries, for Python functions compiled with numba or called
+/// through cppyy, which are expensive to call once per entry. The callback receives the number of entries of the
+/// batch, a pointer to the contiguous values of each input column and a pointer to the output array, which numpy
+/// can wrap without copying them. Booleans are passed as bytes, as numpy stores them.
+/// Each slot collects its own batches, so in multi-thread runs the callback is called concurrently.
+template <typename Ret, typename... ColTypes>
+class RBatchEvaluator {
+   static_assert(!std::disjunction_v<std::bool_constant<RNumpyColumnTraits<ColTypes>::kIsJagged>...>,
+                 "Only columns of fundamental types can be passed to batch callbacks");
+
+   template <typename T>
+   using Value_t = typename RNumpyColumnTraits<T>::Value_t;
+
+public:
+   using Callback_t = void (*)(std::size_t, const Value_t<ColTypes> *..., Ret *);
+
+private:
+   struct RSlotData {
+      std::tuple<std::vector<Value_t<ColTypes>>...> fInputs; ///< Values of the current batch
+      std::vector<ULong64_t> fBatchEntries;
+      std::vector<Ret> fOutput;
+      std::vector<ULong64_t> fEntries; ///< All the entries evaluated by the slot, and their results
+      std::vector<Ret> fResults;
+   };
+
+   Callback_t fCallback;
+   std::size_t fBatchSize;
+   std::vector<RSlotData> fSlots;
+
+   template <std::size_t... Idx>
+   void Push(RSlotData &slotData, std::index_sequence<Idx...>, const ColTypes &...values)
+   {
+      (std::get<Idx>(slotData.fInputs).emplace_back(values), ...);
+   }
+
+   template <std::size_t... Idx>
+   void Flush(RSlotData &slotData, std::index_sequence<Idx...>)
+   {
+      const auto n = slotData.fBatchEntries.size();
+      if (n == 0)
+         return;
+      slotData.fOutput.resize(n);
+      fCallback(n, std::get<Idx>(slotData.fInputs).data()..., slotData.fOutput.data());
+      slotData.fEntries.insert(slotData.fEntries.end(), slotData.fBatchEntries.begin(), slotData.fBatchEntries.end());
+      slotData.fResults.insert(slotData.fResults.end(), slotData.fOutput.begin(), slotData.fOutput.end());
+      slotData.fBatchEntries.clear();
+      (std::get<Idx>(slotData.fInputs).clear(), ...);
+   }
+
+public:
+   RBatchEvaluator(Callback_t callback, std::size_t batchSize, unsigned int nSlots)
+      : fCallback(callback), fBatchSize(std::max<std::size_t>(batchSize, 1)), fSlots(nSlots)
+   {
+   }
+
+   void Exec(unsigned int slot, ULong64_t entry, const ColTypes &...values)
+   {
+      auto &slotData = fSlots[slot];
+      slotData.fBatchEntries.emplace_back(entry);
+      Push(slotData, std::index_sequence_for<ColTypes...>(), values...);
+      if (slotData.fBatchEntries.size() == fBatchSize)
+         Flush(slotData, std::index_sequence_for<ColTypes...>());
+   }
+
+   /// Evaluate the last partial batches and return the results indexed by entry number
+   std::shared_ptr<const std::vector<Ret>> Finalize()
+   {
+      ULong64_t nEntries = 0;
+      for (auto &slotData : fSlots) {
+         Flush(slotData, std::index_sequence_for<ColTypes...>());
+         if (!slotData.fEntries.empty())
+            nEntries = std::max(nEntries, *std::max_element(slotData.fEntries.begin(), slotData.fEntries.end()) + 1);
+      }
+      auto results = std::make_shared<std::vector<Ret>>(nEntries);
+      for (auto &slotData : fSlots) {
+         for (std::size_t i = 0; i < slotData.fEntries.size(); ++i)
+            (*results)[slotData.fEntries[i]] = slotData.fResults[i];
+         slotData = RSlotData();
+      }
+      return results;
+   }
+};
+
+/// Run an event loop that evaluates a batch callback for all the entries of a node, see RBatchEvaluator.
+template <typename Ret, typename... ColTypes>
+std::shared_ptr<const std::vector<Ret>> EvaluateBatches(ROOT::RDF::RNode df, ULong64_t callbackAddress,
+                                                        const std::vector<std::string> &columns, std::size_t batchSize)
+{
+   using Evaluator_t = RBatchEvaluator<Ret, ColTypes...>;
+   auto evaluator = std::make_shared<Evaluator_t>(reinterpret_cast<typename Evaluator_t::Callback_t>(callbackAddress),
+                                                  batchSize, df.GetNSlots());
+   auto columnsWithEntry = columns;
+   columnsWithEntry.insert(columnsWithEntry.begin(), "rdfentry_");
+   df.ForeachSlot([evaluator](unsigned int slot, ULong64_t entry,
+                              const ColTypes &...values) { evaluator->Exec(slot, entry, values...); },
+                  columnsWithEntry);
+   return evaluator->Finalize();
+}
+
+/// Define a column with a vectorised callback, called once per batch of entries instead of once per entry.
+/// \param[in] df The dataframe node.
+/// \param[in] name The name of the new column.
+/// \param[in] callbackAddress Address of a `void(std::size_t n, const ColTypes *..., Ret *out)` function, e.g. the
+///            address of a numba cfunc, that writes the values of the n entries of a batch to out.
+/// \param[in] columns The input columns, of types ColTypes.
+/// \param[in] batchSize Maximum number of entries per call.
+/// The callback is evaluated eagerly for all the entries of the node, in an event loop run by this function, and the
+/// new column reads the results by entry number. The callback must therefore be deterministic, and thread-safe if
+/// implicit multi-threading is enabled.
+template <typename Ret, typename... ColTypes>
+ROOT::RDF::RNode DefineBatch(ROOT::RDF::RNode df, std::string_view name, ULong64_t callbackAddress,
+                             const std::vector<std::string> &columns, std::size_t batchSize = 4096)
+{
+   auto results = EvaluateBatches<Ret, ColTypes...>(df, callbackAddress, columns, batchSize);
+   return df.Define(name, [results](ULong64_t entry) { return (*results)[entry]; }, {"rdfentry_"});
+}
+
+/// Filter entries with a vectorised callback, which writes one byte per entry of the batch, non-zero to keep it.
+/// See DefineBatch() for the signature of the callback and for how it is evaluated.
+template <typename... ColTypes>
+ROOT::RDF::RNode FilterBatch(ROOT::RDF::RNode df, ULong64_t callbackAddress, const std::vector<std::string> &columns,
+                             std::string_view name = "", std::size_t batchSize = 4096)
+{
+   auto mask = EvaluateBatches<unsigned char, ColTypes...>(df, callbackAddress, columns, batchSize);
+   return df.Filter([mask](ULong64_t entry) { return (*mask)[entry] != 0; }, {"rdfentry_"}, name);
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -19,10 +19,13 @@
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RVariedAction.hxx"
 
+#include <algorithm> // std::any_of
 #include <array>
 #include <cstddef> // std::size_t
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
 #include <vector>
 
 namespace ROOT {
@@ -93,7 +96,7 @@ public:
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       RColumnReadersInfo info{RActionBase::GetColumnNames(), RActionBase::GetColRegister(), fIsDefine.data(),
-                              *fLoopManager};
+                              *fLoopManager, fPrevNode.IsGuardedByFilter()};
       fValues[slot] = GetColumnReaders(slot, r, ColumnTypes_t{}, info);
       fHelper.InitTask(r, slot);
    }
@@ -109,12 +112,19 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevNode.CheckFilters(slot, entry))
+      if (fPrevNode.CheckFilters(slot, entry)) {
+         RProfileScope profile(fLoopManager->GetProfiler(), slot, fProfileId);
          CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      }
    }
 
    void TriggerChildrenCount() final { fPrevNode.IncrChildrenCount(); }
 
+   void CollectRangeCutFilters(std::vector<const RFilterBase *> &filters) const final
+   {
+      fPrevNode.CollectRangeCutFilters(filters);
+   }
+
    /// Clean-up operations to be performed at the end of a task.
    void FinalizeSlot(unsigned int slot) final
    {
@@ -122,6 +132,40 @@ public:
       fHelper.CallFinalizeTask(slot);
    }
 
+   bool TrySetResultFromMetadata() final
+   {
+      // Only actions that read dataset columns of all the entries can be answered from the dataset metadata
+      if constexpr (std::is_same<PrevNode, RLoopManager>::value) {
+         if (std::any_of(fIsDefine.begin(), fIsDefine.end(), [](bool isDefine) { return isDefine; }))
+            return false;
+         if (!fHelper.CallSetResultFromMetadata(*fLoopManager, GetColumnNames(), ColumnTypes_t{}))
+            return false;
+         SetHasRun();
+         return true;
+      } else {
+         return false;
+      }
+   }
+
+   std::string GetCacheKey() final
+   {
+      // Varied results are not cached
+      if (!fCachedResult || !GetVariations().empty())
+         return "";
+      const auto &prevKey = fPrevNode.GetCacheKey();
+      if (prevKey.empty())
+         return "";
+      std::string key = prevKey + ";" + fHelper.GetActionName() + "<" + typeid(Helper).name() + "," +
+                        typeid(ColumnTypes_t).name() + ">(";
+      for (const auto &col : GetColumnNames()) {
+         const auto colKey = GetColRegister().GetCacheKey(col);
+         if (colKey.empty())
+            return "";
+         key += colKey + ",";
+      }
+      return key + ")";
+   }
+
    /// Clean-up and finalize the action result (e.g. merging slot-local results).
    /// It invokes the helper's Finalize method.
    void Finalize() final
@@ -180,6 +224,8 @@ public:
                                        GetColRegister());
    }
 
+   std::string GetActionName() final { return fHelper.GetActionName(); }
+
 private:
    ROOT::RDF::SampleCallback_t GetSampleCallback() final { return fHelper.GetSampleCallback(); }
 };
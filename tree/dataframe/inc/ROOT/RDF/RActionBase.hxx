@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ROOT {
 
@@ -25,6 +26,7 @@ namespace Detail {
 namespace RDF {
 class RLoopManager;
 class RDefineBase;
+class RFilterBase;
 class RMergeableValueBase;
 } // namespace RDF
 } // namespace Detail
@@ -34,6 +36,7 @@ namespace RDF {
 namespace GraphDrawing {
 class GraphNode;
 }
+class RCachedResultBase;
 
 using namespace ROOT::Detail::RDF;
 
@@ -42,6 +45,9 @@ protected:
    /// A raw pointer to the RLoopManager at the root of this functional graph.
    /// Never null: children nodes have shared ownership of parent nodes in the graph.
    RLoopManager *fLoopManager;
+   unsigned int fProfileId = 0; ///< Id of this node in the RProfiler of the loop manager, if profiling is enabled
+   /// Access to the result for the result cache of the loop manager. Null if the result cannot be cached.
+   std::unique_ptr<RCachedResultBase> fCachedResult;
 
 private:
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
@@ -67,8 +73,19 @@ public:
    virtual void Initialize() = 0;
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
+   /// Collect the filters upstream whose range cuts hold for all entries processed by this action, see
+   /// RNodeBase::CollectRangeCutFilters(). The default, no filters, prevents any cut from being pushed down.
+   virtual void CollectRangeCutFilters(std::vector<const RFilterBase *> &) const {}
    virtual void FinalizeSlot(unsigned int) = 0;
    virtual void Finalize() = 0;
+   /// Set the result from the metadata of the dataset, without an event loop, if the action supports it and processes
+   /// the whole dataset. If true is returned, the action has run and none of its other methods are called in this loop.
+   virtual bool TrySetResultFromMetadata() { return false; }
+   /// Describe how the result is computed from the dataset, for the result cache of the loop manager, see
+   /// RLoopManager::EnableResultCache(). An empty key means that the result cannot be cached.
+   virtual std::string GetCacheKey() { return ""; }
+   void SetCachedResult(std::unique_ptr<RCachedResultBase> cachedResult);
+   RCachedResultBase *GetCachedResult() const { return fCachedResult.get(); }
    /// This method is invoked to update a partial result during the event loop, right before passing the result to a
    /// user-defined callback registered via RResultPtr::RegisterCallback
    virtual void *PartialUpdate(unsigned int slot) = 0;
@@ -89,6 +106,9 @@ public:
    virtual ROOT::RDF::SampleCallback_t GetSampleCallback() = 0;
 
    const std::vector<std::string> &GetVariations() const { return fVariations; }
+   void SetProfileId(unsigned int id) { fProfileId = id; }
+   /// Name of the action, as shown by SaveGraph and in profiles
+   virtual std::string GetActionName() { return "Action"; }
 
    virtual std::unique_ptr<RActionBase> MakeVariedAction(std::vector<void *> &&results) = 0;
    virtual std::unique_ptr<RActionBase> CloneAction(void *newResult) = 0;
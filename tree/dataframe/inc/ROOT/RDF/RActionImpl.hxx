@@ -13,12 +13,15 @@
 
 #include <memory> // std::unique_ptr
 #include <stdexcept> // std::logic_error
+#include <string>
 #include <utility> // std::declval
+#include <vector>
 
 namespace ROOT {
 namespace Detail {
 namespace RDF {
 
+class RLoopManager;
 class RMergeableValueBase;
 
 /// Base class for action helpers, see RInterface::Book() for more information.
@@ -62,6 +65,20 @@ public:
                              "). Cannot Vary its result.");
    }
 
+   // call Helper::SetResultFromMetadata if present, return false otherwise
+   template <typename ColTypeList, typename T = Helper>
+   auto CallSetResultFromMetadata(RLoopManager &lm, const std::vector<std::string> &columns, ColTypeList types)
+      -> decltype(std::declval<T>().SetResultFromMetadata(lm, columns, types))
+   {
+      return static_cast<Helper *>(this)->SetResultFromMetadata(lm, columns, types);
+   }
+
+   template <typename... Args>
+   bool CallSetResultFromMetadata(RLoopManager &, const std::vector<std::string> &, Args...)
+   {
+      return false;
+   }
+
    // Helper functions for RMergeableValue
    virtual std::unique_ptr<RMergeableValueBase> GetMergeableValue() const
    {
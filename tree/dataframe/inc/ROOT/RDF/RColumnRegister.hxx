@@ -114,6 +114,8 @@ public:
 
    std::string_view ResolveAlias(std::string_view alias) const;
 
+   std::string GetCacheKey(std::string_view colName) const;
+
    void AddVariation(std::shared_ptr<RVariationBase> variation);
 
    std::vector<std::string> GetVariationsFor(const std::string &column) const;
@@ -22,6 +22,7 @@
 
 #include <array>
 #include <deque>
+#include <tuple>
 #include <type_traits>
 #include <utility> // std::index_sequence
 #include <vector>
@@ -55,7 +56,8 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
    using ColumnTypes_t =
       RDFInternal::RemoveFirstTwoParametersIf_t<std::is_same<ExtraArgsTag, SlotAndEntryTag>::value, ColumnTypesTmp_t>;
    using TypeInd_t = std::make_index_sequence<ColumnTypes_t::list_size>;
-   using ret_type = typename CallableTraits<F>::ret_type;
+   // lazy RVec expressions are evaluated into the RVec cached for the column
+   using ret_type = typename ROOT::Internal::VecOps::RVecExprResult<typename CallableTraits<F>::ret_type>::type;
    // Avoid instantiating vector<bool> as `operator[]` returns temporaries in that case. Use std::deque instead.
    using ValuesPerSlot_t =
       std::conditional_t<std::is_same<ret_type, bool>::value, std::deque<ret_type>, std::vector<ret_type>>;
@@ -70,19 +72,34 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
    /// The map key is the full variation name, e.g. "pt:up".
    std::unordered_map<std::string, std::unique_ptr<RDefineBase>> fVariedDefines;
 
+   /// Return the RVec arena of the slot, if enabled. The previous result is released first, as its memory may come
+   /// from the arena, which was reset since.
+   ROOT::Internal::VecOps::RVecArena *PrepareArena(unsigned int slot)
+   {
+      auto *arena = fLoopManager->GetRVecArena(slot);
+      if (arena)
+         fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] = ret_type();
+      return arena;
+   }
+
+   // The input values are read before entering the arena scope: readers of dataset columns keep their values, and
+   // therefore the buffers of their RVecs, across entries.
+
    template <typename... ColTypes, std::size_t... S>
    void UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, NoneTag)
    {
-      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
-         fExpression(fValues[slot][S]->template Get<ColTypes>(entry)...);
+      auto values = std::forward_as_tuple(fValues[slot][S]->template Get<ColTypes>(entry)...);
+      ROOT::Internal::VecOps::RVecArena::RScope arenaScope(PrepareArena(slot));
+      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] = fExpression(std::get<S>(values)...);
       (void)entry; // avoid unused parameter warning (gcc 12.1)
    }
 
    template <typename... ColTypes, std::size_t... S>
    void UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, SlotTag)
    {
-      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
-         fExpression(slot, fValues[slot][S]->template Get<ColTypes>(entry)...);
+      auto values = std::forward_as_tuple(fValues[slot][S]->template Get<ColTypes>(entry)...);
+      ROOT::Internal::VecOps::RVecArena::RScope arenaScope(PrepareArena(slot));
+      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] = fExpression(slot, std::get<S>(values)...);
       (void)entry; // avoid unused parameter warning (gcc 12.1)
    }
 
@@ -90,8 +107,9 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
    void
    UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, SlotAndEntryTag)
    {
-      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
-         fExpression(slot, entry, fValues[slot][S]->template Get<ColTypes>(entry)...);
+      auto values = std::forward_as_tuple(fValues[slot][S]->template Get<ColTypes>(entry)...);
+      ROOT::Internal::VecOps::RVecArena::RScope arenaScope(PrepareArena(slot));
+      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] = fExpression(slot, entry, std::get<S>(values)...);
    }
 
 public:
@@ -126,6 +144,7 @@ public:
    {
       if (entry != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
          // evaluate this define expression, cache the result
+         RDFInternal::RProfileScope profile(fLoopManager->GetProfiler(), slot, fProfileId);
          UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
          fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = entry;
       }
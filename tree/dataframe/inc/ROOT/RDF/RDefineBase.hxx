@@ -48,6 +48,10 @@ protected:
    ROOT::RVecB fIsDefine;
    std::vector<std::string> fVariationDeps; ///< List of systematic variations that affect the value of this define.
    std::string fVariation;                  ///< This indicates for what variation this define evaluates values.
+   unsigned int fProfileId = 0; ///< Id of this node in the RProfiler of the loop manager, if profiling is enabled
+   /// Description of how the values of this Define are computed, used to key the results in a result cache (see
+   /// RLoopManager::EnableResultCache()). Empty if it cannot be described, e.g. for Defines of C++ callables.
+   std::string fCacheKey;
 
 public:
    RDefineBase(std::string_view name, std::string_view type, const RDFInternal::RColumnRegister &colRegister,
@@ -70,6 +74,10 @@ public:
    virtual void FinalizeSlot(unsigned int slot) = 0;
 
    const std::vector<std::string> &GetVariations() const { return fVariationDeps; }
+   const std::string &GetVariationName() const { return fVariation; }
+   void SetProfileId(unsigned int id) { fProfileId = id; }
+   const std::string &GetCacheKey() const { return fCacheKey; }
+   void SetCacheKey(const std::string &key) { fCacheKey = key; }
 
    /// Create clones of this Define that work with values in varied "universes".
    virtual void MakeVariations(const std::vector<std::string> &variations) = 0;
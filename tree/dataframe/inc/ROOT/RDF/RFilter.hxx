@@ -96,6 +96,7 @@ public:
             fLastResult[slot * RDFInternal::CacheLineStep<int>()] = false;
          } else {
             // evaluate this filter, cache the result
+            RDFInternal::RProfileScope profile(fLoopManager->GetProfiler(), slot, fProfileId);
             auto passed = CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
             passed ? ++fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()]
                    : ++fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()];
@@ -117,7 +118,8 @@ public:
 
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
-      RDFInternal::RColumnReadersInfo info{fColumnNames, fColRegister, fIsDefine.data(), *fLoopManager};
+      RDFInternal::RColumnReadersInfo info{fColumnNames, fColRegister, fIsDefine.data(), *fLoopManager,
+                                           fPrevNode.IsGuardedByFilter()};
       fValues[slot] = RDFInternal::GetColumnReaders(slot, r, ColumnTypes_t{}, info, fVariation);
       fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
    }
@@ -152,6 +154,16 @@ public:
       fPrevNode.IncrChildrenCount();
    }
 
+   void CollectRangeCutFilters(std::vector<const RFilterBase *> &filters) const final
+   {
+      // named filters have to see all entries for the cut-flow report
+      if (HasName())
+         filters.clear();
+      else if (!fRangeCuts.empty())
+         filters.push_back(this);
+      fPrevNode.CollectRangeCutFilters(filters);
+   }
+
    void AddFilterName(std::vector<std::string> &filters) final
    {
       fPrevNode.AddFilterName(filters);
@@ -11,6 +11,7 @@
 #ifndef ROOT_RFILTERBASE
 #define ROOT_RFILTERBASE
 
+#include "ROOT/RDataSource.hxx" // RRangeCut
 #include "ROOT/RDF/RColumnRegister.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
@@ -48,6 +49,9 @@ protected:
    ROOT::RVecB fIsDefine;
    std::string fVariation; ///< This indicates for what variation this filter evaluates values.
    std::unordered_map<std::string, std::shared_ptr<RFilterBase>> fVariedFilters;
+   /// Cuts on data source columns implied by this filter, which can be pushed down to the data source
+   std::vector<ROOT::RDF::RRangeCut> fRangeCuts;
+   unsigned int fProfileId = 0; ///< Id of this node in the RProfiler of the loop manager, if profiling is enabled
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -72,6 +76,11 @@ public:
    /// Clean-up operations to be performed at the end of a task.
    virtual void FinalizeSlot(unsigned int slot) = 0;
    virtual void InitNode();
+   const std::vector<ROOT::RDF::RRangeCut> &GetRangeCuts() const { return fRangeCuts; }
+   void SetRangeCuts(const std::vector<ROOT::RDF::RRangeCut> &cuts) { fRangeCuts = cuts; }
+   bool IsGuardedByFilter() const final { return true; }
+   const std::string &GetVariationName() const { return fVariation; }
+   void SetProfileId(unsigned int id) { fProfileId = id; }
 };
 
 } // ns RDF
@@ -0,0 +1,220 @@
+/// \file RHistFillHelper.hxx
+/// \ingroup dataframe ROOT7
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RHISTFILLHELPER
+#define ROOT_RDF_RHISTFILLHELPER
+
+#include <ROOT/RDF/RActionImpl.hxx>
+#include <ROOT/RAxis.hxx>
+#include <ROOT/RHist.hxx>
+#include <ROOT/RHistConcurrentFill.hxx>
+#include <ROOT/RHistImpl.hxx>
+
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TH3D.h"
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class TTreeReader;
+
+namespace ROOT {
+namespace Experimental {
+namespace RDF {
+
+/**
+\class ROOT::Experimental::RDF::RHistFillHelper
+\ingroup dataframe
+Action helper filling a ROOT 7 histogram (RHist) from RDataFrame, to be used with RInterface::Book().
+
+The types of the axes are template arguments (RAxisEquidistant or RAxisIrregular), so that the
+filling calls the concrete RHistImpl directly: there is no virtual call per entry. Each slot
+buffers its entries in a RHistConcurrentFiller, which fills the histogram under the lock of a
+RHistConcurrentFillManager every 1024 entries, so the threads share one histogram.
+
+The columns are the coordinates, followed by an optional weight:
+
+~~~{.cpp}
+using Hist_t = ROOT::Experimental::RH2D;
+using namespace ROOT::Experimental;
+auto hist = std::make_shared<Hist_t>(RAxisConfig(100, 0., 1.), RAxisConfig({0., 1., 2., 5., 10.}));
+RDF::RHistFillHelper<Hist_t, RAxisEquidistant, RAxisIrregular> helper(hist, df.GetNSlots());
+auto result = df.Book<double, double, float>(std::move(helper), {"x", "y", "w"});
+std::unique_ptr<TH1> th2 = RDF::ConvertToTH1(*result);
+~~~
+*/
+template <class HIST, class... AXES>
+class R__CLING_PTRCHECK(off) RHistFillHelper : public ROOT::Detail::RDF::RActionImpl<RHistFillHelper<HIST, AXES...>> {
+   static_assert(sizeof...(AXES) == HIST::GetNDim(), "One axis type is needed per dimension of the histogram");
+   static_assert(((std::is_same<AXES, RAxisEquidistant>::value || std::is_same<AXES, RAxisIrregular>::value) && ...),
+                 "The axes must be RAxisEquidistant or RAxisIrregular");
+
+public:
+   using Result_t = HIST;
+   /// The concrete histogram implementation, filled without virtual calls
+   using Impl_t = Detail::RHistImpl<typename HIST::ImplBase_t::Stat_t, AXES...>;
+
+private:
+   static constexpr int kBufferSize = 1024;
+   using Manager_t = RHistConcurrentFillManager<Impl_t, kBufferSize>;
+   using Filler_t = RHistConcurrentFiller<Impl_t, kBufferSize>;
+
+   std::shared_ptr<HIST> fHist;
+   std::unique_ptr<Manager_t> fManager;
+   std::vector<std::unique_ptr<Filler_t>> fFillers; ///< One per slot
+
+public:
+   /// Fill `hist` from `nSlots` slots. Throws std::invalid_argument if the axes of `hist` are not of type AXES.
+   RHistFillHelper(const std::shared_ptr<HIST> &hist, unsigned int nSlots) : fHist(hist)
+   {
+      auto impl = dynamic_cast<Impl_t *>(fHist->GetImpl());
+      if (!impl)
+         throw std::invalid_argument("RHistFillHelper: the axes of the histogram do not match the template arguments");
+      fManager = std::make_unique<Manager_t>(*impl);
+      for (unsigned int i = 0; i < nSlots; ++i)
+         fFillers.emplace_back(std::make_unique<Filler_t>(*fManager));
+   }
+   RHistFillHelper(RHistFillHelper &&) = default;
+   RHistFillHelper(const RHistFillHelper &) = delete;
+
+   std::shared_ptr<HIST> GetResultPtr() const { return fHist; }
+   void Initialize() {}
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   /// Fill the coordinates `values`, followed by an optional weight.
+   template <typename... Ts>
+   void Exec(unsigned int slot, const Ts &...values)
+   {
+      constexpr int nDim = HIST::GetNDim();
+      static_assert(sizeof...(Ts) == nDim || sizeof...(Ts) == nDim + 1,
+                    "RHistFillHelper needs one column per dimension, and optionally a weight");
+      const std::array<double, sizeof...(Ts)> v{{static_cast<double>(values)...}};
+      typename Impl_t::CoordArray_t x;
+      for (int i = 0; i < nDim; ++i)
+         x[i] = v[i];
+      if constexpr (sizeof...(Ts) == nDim)
+         fFillers[slot]->Fill(x);
+      else
+         fFillers[slot]->Fill(x, v[nDim]);
+   }
+
+   /// Flush the buffers of all slots into the histogram.
+   void Finalize() { fFillers.clear(); }
+
+   std::string GetActionName() { return "FillRHist"; }
+};
+
+/// Convert a RHist of dimension 1, 2 or 3 to a TH1D, TH2D or TH3D with the same binning, bin
+/// contents and uncertainties (with Sumw2() if the histogram keeps the sums of squared weights),
+/// and number of entries. The statistics of the result are computed from its bin contents.
+template <class HIST>
+std::unique_ptr<TH1> ConvertToTH1(const HIST &hist)
+{
+   constexpr int nDim = HIST::GetNDim();
+   static_assert(nDim >= 1 && nDim <= 3, "Only histograms of dimension 1, 2 or 3 can be converted to TH1");
+   const auto &impl = *hist.GetImpl();
+
+   // the number of bins and the bin edges of an axis, for the TH1 constructors
+   struct AxisBins {
+      int fN = 1;
+      std::vector<double> fEdges;
+   };
+   std::array<AxisBins, 3> axes;
+   for (int i = 0; i < nDim; ++i) {
+      const RAxisBase &axis = impl.GetAxis(i);
+      axes[i].fN = axis.GetNBinsNoOver();
+      if (auto irregular = dynamic_cast<const RAxisIrregular *>(&axis))
+         axes[i].fEdges = irregular->GetBinBorders();
+      else
+         axes[i].fEdges = {axis.GetMinimum(), axis.GetMaximum()};
+   }
+   // variable bins if any axis is irregular, through the TH constructors taking bin edges
+   auto edges = [&axes](int i) {
+      auto &axis = axes[i];
+      if (axis.fEdges.size() == 2 && axis.fN > 1) {
+         const double low = axis.fEdges[0];
+         const double width = (axis.fEdges[1] - low) / axis.fN;
+         axis.fEdges.resize(axis.fN + 1);
+         for (int bin = 0; bin <= axis.fN; ++bin)
+            axis.fEdges[bin] = low + bin * width;
+      }
+      return axis.fEdges.data();
+   };
+   bool regular = true;
+   for (int i = 0; i < nDim; ++i)
+      regular = regular && axes[i].fEdges.size() == 2;
+
+   std::unique_ptr<TH1> th1;
+   const char *title = impl.GetTitle().c_str();
+   if (nDim == 1) {
+      th1 = regular ? std::make_unique<TH1D>("", title, axes[0].fN, axes[0].fEdges[0], axes[0].fEdges[1])
+                    : std::make_unique<TH1D>("", title, axes[0].fN, edges(0));
+   } else if (nDim == 2) {
+      th1 = regular ? std::make_unique<TH2D>("", title, axes[0].fN, axes[0].fEdges[0], axes[0].fEdges[1], axes[1].fN,
+                                             axes[1].fEdges[0], axes[1].fEdges[1])
+                    : std::make_unique<TH2D>("", title, axes[0].fN, edges(0), axes[1].fN, edges(1));
+   } else {
+      th1 = regular ? std::make_unique<TH3D>("", title, axes[0].fN, axes[0].fEdges[0], axes[0].fEdges[1], axes[1].fN,
+                                             axes[1].fEdges[0], axes[1].fEdges[1], axes[2].fN, axes[2].fEdges[0],
+                                             axes[2].fEdges[1])
+                    : std::make_unique<TH3D>("", title, axes[0].fN, edges(0), axes[1].fN, edges(1), axes[2].fN, edges(2));
+   }
+   th1->SetDirectory(nullptr);
+   const bool hasUncertainty = impl.HasBinUncertainty();
+   if (hasUncertainty)
+      th1->Sumw2();
+
+   // classic bins 0 and n+1 are the underflow and overflow bins, kUnderflowBin and kOverflowBin of RAxisBase
+   auto toLocalBin = [](int bin, int n, const RAxisBase &axis) {
+      if (bin == 0)
+         return axis.GetUnderflowBin();
+      if (bin == n + 1)
+         return axis.GetOverflowBin();
+      return bin;
+   };
+   std::array<int, 3> classicBins{};
+   typename HIST::ImplBase_t::BinArray_t localBins;
+   for (classicBins[2] = 0; classicBins[2] <= (nDim > 2 ? axes[2].fN + 1 : 0); ++classicBins[2]) {
+      for (classicBins[1] = 0; classicBins[1] <= (nDim > 1 ? axes[1].fN + 1 : 0); ++classicBins[1]) {
+         for (classicBins[0] = 0; classicBins[0] <= axes[0].fN + 1; ++classicBins[0]) {
+            bool valid = true;
+            for (int i = 0; i < nDim; ++i) {
+               localBins[i] = toLocalBin(classicBins[i], axes[i].fN, impl.GetAxis(i));
+               // growable axes have no under- and overflow bins
+               valid = valid && localBins[i] != RAxisBase::kInvalidBin;
+            }
+            if (!valid)
+               continue;
+            const int bin = impl.GetBinIndexFromLocalBins(localBins);
+            const int classicBin = th1->GetBin(classicBins[0], classicBins[1], classicBins[2]);
+            th1->SetBinContent(classicBin, impl.GetBinContentAsDouble(bin));
+            if (hasUncertainty)
+               th1->SetBinError(classicBin, impl.GetBinUncertainty(bin));
+         }
+      }
+   }
+   th1->ResetStats();
+   th1->SetEntries(hist.GetEntries());
+   return th1;
+}
+
+} // namespace RDF
+} // namespace Experimental
+} // namespace ROOT
+
+#endif // ROOT_RDF_RHISTFILLHELPER
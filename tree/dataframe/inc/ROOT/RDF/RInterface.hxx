@@ -28,6 +28,7 @@
 #include "ROOT/RDF/RDFDescription.hxx"
 #include "ROOT/RDF/RVariationsDescription.hxx"
 #include "ROOT/RResultPtr.hxx"
+#include "ROOT/RCacheOptions.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include <string_view>
 #include "ROOT/RVec.hxx"
@@ -1126,6 +1127,15 @@ public:
    /// opts.fLazy = true;
    /// df.Snapshot("outputTree", "outputFile.root", {"x"}, opts);
    /// ~~~
+   ///
+   /// Instead of a TTree, Snapshot can write an RNTuple. All processing slots then fill the same RNTuple in parallel,
+   /// without merging intermediate files; as for TTrees, the order of the entries is only preserved in single-thread
+   /// runs. Sub-directories are not supported for RNTuple output.
+   /// ~~~{.cpp}
+   /// RSnapshotOptions opts;
+   /// opts.fOutputFormat = ESnapshotOutputFormat::kRNTuple;
+   /// df.Snapshot("outputNTuple", "outputFile.root", {"x"}, opts);
+   /// ~~~
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>>
    Snapshot(std::string_view treename, std::string_view filename, const ColumnNames_t &columnList,
@@ -1174,13 +1184,7 @@ public:
 
       ::TDirectory::TContext ctxt;
 
-      // The CreateLMFromTTree function by default opens the file passed as input
-      // to check for the presence of the TTree inside. But at this moment the
-      // filename we are using here corresponds to a file which does not exist yet,
-      // i.e. the output file of the Snapshot call. Thus, checkFile=false will
-      // prevent the function from trying to open a non-existent file.
-      auto newRDF = std::make_shared<RInterface<RLoopManager>>(ROOT::Detail::RDF::CreateLMFromTTree(
-         fullTreeName, filename, colListNoAliasesWithSizeBranches, /*checkFile*/ false));
+      auto newRDF = MakeSnapshotResult(fullTreeName, filename, colListNoAliasesWithSizeBranches, *snapHelperArgs);
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, RDFDetail::RInferredType>(
          colListNoAliasesWithSizeBranches, newRDF, snapHelperArgs, fProxiedPtr,
@@ -1381,6 +1385,41 @@ public:
       return Cache(selectedColumns);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory or, within a memory budget, in a local file.
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] options options to steer where the cached values are kept.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// If `options.fMemoryBudget` is 0, this is equivalent to Cache(const ColumnNames_t &). Otherwise, the values are
+   /// written as an RNTuple to the local file `options.fSpillFileName` by all processing slots in parallel. Each slot
+   /// keeps in memory only the cluster it is filling, so that the memory used by the cache stays within the budget.
+   /// The returned dataframe reads the file back column by column, in parallel if implicit multi-threading is
+   /// enabled, which makes it suitable for selections that do not fit in memory and are processed many times.
+   /// The file is not removed when the returned dataframe is destroyed. This mode requires ROOT 7 support.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDF::RCacheOptions opts;
+   /// opts.fMemoryBudget = 2ull * 1024 * 1024 * 1024;
+   /// opts.fSpillFileName = "/scratch/selection_cache.root";
+   /// auto cached = df.Filter("nMuon == 2").Cache({"Muon_pt", "Muon_eta"}, opts);
+   /// ~~~
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options)
+   {
+      if (options.fMemoryBudget == 0)
+         return Cache(columnList);
+      if (options.fSpillFileName.empty())
+         throw std::invalid_argument("Cache: a spill file name is required when a memory budget is set.");
+
+      RSnapshotOptions snapshotOptions;
+      snapshotOptions.fOutputFormat = ESnapshotOutputFormat::kRNTuple;
+      // the cache is meant to be read back many times: favor decompression speed over file size
+      snapshotOptions.fCompressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+      snapshotOptions.fMemoryBudget = options.fMemoryBudget;
+      return *Snapshot("cache", options.fSpillFileName, columnList, snapshotOptions);
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates a node that filters entries based on range: [begin, end).
@@ -1566,6 +1605,7 @@ public:
       using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
       auto action = std::make_unique<Action_t>(Helper_t(cSPtr, nSlots), ColumnNames_t({}), fProxiedPtr,
                                                RDFInternal::RColumnRegister(fColRegister));
+      action->SetCachedResult(RDFInternal::MakeCachedResult(cSPtr));
       return MakeResultPtr(cSPtr, *fLoopManager, std::move(action));
    }
 
@@ -1621,6 +1661,12 @@ public:
    /// This action is *lazy*: upon invocation of this method the calculation is
    /// booked but not executed. Also see RResultPtr.
    ///
+   /// In multi-thread event loops, each slot fills its own copy of the histogram by default. For histograms
+   /// with many bins, setting the `fFillStrategy` of the model to ROOT::RDF::EFillStrategy::kSharedAtomic
+   /// makes all slots fill the same histogram with atomic additions instead, which needs no additional
+   /// memory per slot and no merge, at the cost of contention when many entries fall in the same bins.
+   /// This strategy is also available in Histo2D() and Histo3D() and requires fixed axis limits.
+   ///
    /// ### Example usage:
    /// ~~~{.cpp}
    /// // Deduce column type (this invocation needs jitting internally)
@@ -1648,7 +1694,7 @@ public:
 
       if (h->GetXaxis()->GetXmax() == h->GetXaxis()->GetXmin())
          RDFInternal::HistoUtils<::TH1D>::SetCanExtendAllAxes(*h);
-      return CreateAction<RDFInternal::ActionTags::Histo1D, V>(validatedColumns, h, h, fProxiedPtr);
+      return CreateHistoAction<RDFInternal::ActionTags::Histo1D, V>(validatedColumns, h, model.fFillStrategy);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -1706,7 +1752,7 @@ public:
          ROOT::Internal::RDF::RIgnoreErrorLevelRAII iel(kError);
          h = model.GetHistogram();
       }
-      return CreateAction<RDFInternal::ActionTags::Histo1D, V, W>(userColumns, h, h, fProxiedPtr);
+      return CreateHistoAction<RDFInternal::ActionTags::Histo1D, V, W>(userColumns, h, model.fFillStrategy);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -1797,7 +1843,7 @@ public:
       const auto userColumns = RDFInternal::AtLeastOneEmptyString(columnViews)
                                   ? ColumnNames_t()
                                   : ColumnNames_t(columnViews.begin(), columnViews.end());
-      return CreateAction<RDFInternal::ActionTags::Histo2D, V1, V2>(userColumns, h, h, fProxiedPtr);
+      return CreateHistoAction<RDFInternal::ActionTags::Histo2D, V1, V2>(userColumns, h, model.fFillStrategy);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -1840,7 +1886,7 @@ public:
       const auto userColumns = RDFInternal::AtLeastOneEmptyString(columnViews)
                                   ? ColumnNames_t()
                                   : ColumnNames_t(columnViews.begin(), columnViews.end());
-      return CreateAction<RDFInternal::ActionTags::Histo2D, V1, V2, W>(userColumns, h, h, fProxiedPtr);
+      return CreateHistoAction<RDFInternal::ActionTags::Histo2D, V1, V2, W>(userColumns, h, model.fFillStrategy);
    }
 
    template <typename V1, typename V2, typename W>
@@ -1893,7 +1939,7 @@ public:
       const auto userColumns = RDFInternal::AtLeastOneEmptyString(columnViews)
                                   ? ColumnNames_t()
                                   : ColumnNames_t(columnViews.begin(), columnViews.end());
-      return CreateAction<RDFInternal::ActionTags::Histo3D, V1, V2, V3>(userColumns, h, h, fProxiedPtr);
+      return CreateHistoAction<RDFInternal::ActionTags::Histo3D, V1, V2, V3>(userColumns, h, model.fFillStrategy);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -1942,7 +1988,7 @@ public:
       const auto userColumns = RDFInternal::AtLeastOneEmptyString(columnViews)
                                   ? ColumnNames_t()
                                   : ColumnNames_t(columnViews.begin(), columnViews.end());
-      return CreateAction<RDFInternal::ActionTags::Histo3D, V1, V2, V3, W>(userColumns, h, h, fProxiedPtr);
+      return CreateHistoAction<RDFInternal::ActionTags::Histo3D, V1, V2, V3, W>(userColumns, h, model.fFillStrategy);
    }
 
    template <typename V1, typename V2, typename V3, typename W>
@@ -2927,7 +2973,23 @@ public:
    }
 
 private:
-   template <typename F, typename DefineType, typename RetType = typename TTraits::CallableTraits<F>::ret_type>
+   /// Book a Histo1D, Histo2D or Histo3D action that fills h with the given strategy
+   template <typename ActionTag, typename... ColTypes, typename HIST>
+   RResultPtr<HIST>
+   CreateHistoAction(const ColumnNames_t &columns, const std::shared_ptr<HIST> &h, ROOT::RDF::EFillStrategy strategy)
+   {
+      if (strategy == ROOT::RDF::EFillStrategy::kPerSlot)
+         return CreateAction<ActionTag, ColTypes...>(columns, h, h, fProxiedPtr);
+      if (h->CanExtendAllAxes() || h->GetBuffer())
+         throw std::invalid_argument(std::string("The kSharedAtomic fill strategy requires fixed axis limits, but ") +
+                                     "histogram \"" + h->GetName() + "\" has none.");
+      return CreateAction<RDFInternal::ActionTags::SharedFill, ColTypes...>(columns, h, h, fProxiedPtr);
+   }
+
+private:
+   template <typename F, typename DefineType,
+             typename RetType = typename ROOT::Internal::VecOps::RVecExprResult<
+                typename TTraits::CallableTraits<F>::ret_type>::type>
    std::enable_if_t<std::is_default_constructible<RetType>::value, RInterface<Proxied, DS_t>>
    DefineImpl(std::string_view name, F &&expression, const ColumnNames_t &columns, const std::string &where)
    {
@@ -2976,7 +3038,9 @@ private:
    // This overload is chosen when the callable passed to Define or DefineSlot returns void.
    // It simply fires a compile-time error. This is preferable to a static_assert in the main `Define` overload because
    // this way compilation of `Define` has no way to continue after throwing the error.
-   template <typename F, typename DefineType, typename RetType = typename TTraits::CallableTraits<F>::ret_type,
+   template <typename F, typename DefineType,
+             typename RetType = typename ROOT::Internal::VecOps::RVecExprResult<
+                typename TTraits::CallableTraits<F>::ret_type>::type,
              bool IsFStringConv = std::is_convertible<F, std::string>::value,
              bool IsRetTypeDefConstr = std::is_default_constructible<RetType>::value>
    std::enable_if_t<!IsFStringConv && !IsRetTypeDefConstr, RInterface<Proxied, DS_t>>
@@ -2987,6 +3051,36 @@ private:
       return *this; // never reached
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Create the RDataFrame returned by Snapshot, which reads the output dataset.
+   /// For RNTuple output, the data source needs to open the output file, so the placeholder returned here is replaced
+   /// by the Snapshot action once the file is written.
+   std::shared_ptr<RInterface<RLoopManager>>
+   MakeSnapshotResult(std::string_view fullTreeName, std::string_view filename, const ColumnNames_t &defaultColumns,
+                      RDFInternal::SnapshotHelperArgs &snapHelperArgs)
+   {
+      if (snapHelperArgs.fOptions.fOutputFormat == ESnapshotOutputFormat::kRNTuple) {
+         auto newRDF = std::make_shared<RInterface<RLoopManager>>(std::make_shared<RLoopManager>(ULong64_t(0)));
+#ifdef R__HAS_ROOT7
+         std::weak_ptr<RInterface<RLoopManager>> weakRDF = newRDF;
+         snapHelperArgs.fOnWritten = [weakRDF, name = std::string(fullTreeName), file = std::string(filename),
+                                      defaultColumns] {
+            if (auto rdf = weakRDF.lock())
+               *rdf = RInterface<RLoopManager>(ROOT::Detail::RDF::CreateLMFromRNTuple(name, file, defaultColumns));
+         };
+#endif
+         return newRDF;
+      }
+
+      // The CreateLMFromTTree function by default opens the file passed as input
+      // to check for the presence of the TTree inside. But at this moment the
+      // filename we are using here corresponds to a file which does not exist yet,
+      // i.e. the output file of the Snapshot call. Thus, checkFile=false will
+      // prevent the function from trying to open a non-existent file.
+      return std::make_shared<RInterface<RLoopManager>>(
+         ROOT::Detail::RDF::CreateLMFromTTree(fullTreeName, filename, defaultColumns, /*checkFile=*/false));
+   }
+
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>> SnapshotImpl(std::string_view fullTreeName, std::string_view filename,
                                                      const ColumnNames_t &columnList, const RSnapshotOptions &options)
@@ -3008,13 +3102,7 @@ private:
 
       ::TDirectory::TContext ctxt;
 
-      // The CreateLMFromTTree function by default opens the file passed as input
-      // to check for the presence of the TTree inside. But at this moment the
-      // filename we are using here corresponds to a file which does not exist yet,
-      // i.e. the output file of the Snapshot call. Thus, checkFile=false will
-      // prevent the function from trying to open a non-existent file.
-      auto newRDF = std::make_shared<RInterface<RLoopManager>>(ROOT::Detail::RDF::CreateLMFromTTree(
-         fullTreeName, filename, /*defaultColumns=*/columnListWithoutSizeColumns, /*checkFile=*/false));
+      auto newRDF = MakeSnapshotResult(fullTreeName, filename, columnListWithoutSizeColumns, *snapHelperArgs);
 
       // The Snapshot helper will use validCols (with aliases resolved) as input columns, and
       // columnListWithoutSizeColumns (still with aliases in it, passed through snapHelperArgs) as output column names.
@@ -16,6 +16,7 @@
 #include <ROOT/RDF/RColumnRegister.hxx>
 #include <ROOT/RDF/RDisplay.hxx>
 #include <ROOT/RDF/RLoopManager.hxx>
+#include <ROOT/RDF/RResultCache.hxx>
 #include <ROOT/RDataSource.hxx>
 #include <ROOT/RResultPtr.hxx>
 #include <string_view>
@@ -160,6 +161,8 @@ protected:
 
       auto action = RDFInternal::BuildAction<ColTypes...>(validColumnNames, helperArg, nSlots, proxiedPtr, ActionTag{},
                                                           fColRegister);
+      if constexpr (RDFInternal::IsCacheableAction<ActionTag>::value)
+         action->SetCachedResult(RDFInternal::MakeCachedResult(r));
       return MakeResultPtr(r, *fLoopManager, std::move(action));
    }
 
@@ -192,6 +195,8 @@ protected:
          RDFInternal::JitBuildAction(validColumnNames, upcastNodeOnHeap, typeid(HelperArgType), typeid(ActionTag),
                                      helperArgOnHeap, tree, nSlots, fColRegister, fDataSource, jittedActionOnHeap);
       fLoopManager->ToJitExec(toJit);
+      if constexpr (RDFInternal::IsCacheableAction<ActionTag>::value)
+         jittedAction->SetCachedResult(RDFInternal::MakeCachedResult(r));
       return MakeResultPtr(r, *fLoopManager, std::move(jittedAction));
    }
 
@@ -210,6 +215,11 @@ public:
    ColumnNames_t GetDefinedColumnNames();
    unsigned int GetNSlots() const;
    unsigned int GetNRuns() const;
+   std::vector<double> GetSlotBusyTimes() const;
+   void EnableProfiling();
+   ROOT::RDF::Experimental::RProfileReport GetProfileReport() const;
+   void EnableRVecArenas();
+   void EnableResultCache(std::string_view fileName);
    unsigned int GetNFiles();
 };
 } // namespace RDF
@@ -45,20 +45,24 @@ public:
                  const std::vector<std::string> &prevVariations);
    ~RJittedAction();
 
-   void SetAction(std::unique_ptr<RActionBase> a) { fConcreteAction = std::move(a); }
+   void SetAction(std::unique_ptr<RActionBase> a);
 
    void Run(unsigned int slot, Long64_t entry) final;
    void Initialize() final;
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void TriggerChildrenCount() final;
+   void CollectRangeCutFilters(std::vector<const RFilterBase *> &filters) const final;
    void FinalizeSlot(unsigned int) final;
    void Finalize() final;
+   bool TrySetResultFromMetadata() final;
    void *PartialUpdate(unsigned int slot) final;
    bool HasRun() const final;
    void SetHasRun() final;
 
    std::shared_ptr<GraphDrawing::GraphNode>
    GetGraph(std::unordered_map<void *, std::shared_ptr<GraphDrawing::GraphNode>> &visitedMap) final;
+   std::string GetActionName() final;
+   std::string GetCacheKey() final;
 
    // Helper for RMergeableValue
    std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> GetMergeableValue() const final;
@@ -57,6 +57,7 @@ public:
    void ResetReportCount() final;
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
+   void CollectRangeCutFilters(std::vector<const RFilterBase *> &filters) const final;
    void FinalizeSlot(unsigned int slot) final;
    std::shared_ptr<RDFGraphDrawing::GraphNode>
    GetGraph(std::unordered_map<void *, std::shared_ptr<RDFGraphDrawing::GraphNode>> &visitedMap) final;
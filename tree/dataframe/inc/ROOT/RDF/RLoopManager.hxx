@@ -16,6 +16,7 @@
 #include "ROOT/RDF/RDatasetSpec.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/RNewSampleNotifier.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
 #include "ROOT/RDF/Utils.hxx"
 
@@ -23,6 +24,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <string_view>
@@ -39,6 +41,8 @@ namespace ROOT {
 namespace RDF {
 class RCutFlowReport;
 class RDataSource;
+struct RColumnStats;
+struct RRangeCut;
 } // ns RDF
 
 namespace Internal {
@@ -50,6 +54,7 @@ class RActionBase;
 class RVariationBase;
 class RDefinesWithReaders;
 class RVariationsWithReaders;
+class RResultCache;
 
 namespace GraphDrawing {
 class GraphCreatorHelper;
@@ -157,10 +162,27 @@ class RLoopManager : public RNodeBase {
    RDFInternal::RNewSampleNotifier fNewSampleNotifier;
    std::vector<ROOT::RDF::RSampleInfo> fSampleInfos;
    unsigned int fNRuns{0}; ///< Number of event loops run
+   /// Wall-clock time, in seconds, that each slot spent processing entries in the last event loop
+   std::vector<double> fSlotBusyTimes;
+   /// Times the nodes of the computation graph, see EnableProfiling(). Null if profiling is disabled.
+   std::unique_ptr<RDFInternal::RProfiler> fProfiler;
+   /// Per-slot arenas the RVecs created by Defines allocate from, see EnableRVecArenas(). Empty if disabled.
+   std::vector<std::unique_ptr<ROOT::Internal::VecOps::RVecArena>> fRVecArenas;
+   /// Where the results of the actions are stored and loaded from, see EnableResultCache(). Null if disabled.
+   std::unique_ptr<RDFInternal::RResultCache> fResultCache;
+   /// Actions of the current event loop whose results are stored in the result cache at the end of it, with their keys
+   std::vector<std::pair<RDFInternal::RActionBase *, std::string>> fActionsToCache;
+   /// Loop managers of other computation graphs that read their entries from the event loop of this one, see
+   /// SetSharedScanLoops(). Only set for the duration of one Run().
+   std::vector<RLoopManager *> fSharedScanLoops;
 
    /// Readers for TTree/RDataSource columns (one per slot), shared by all nodes in the computation graph.
    std::vector<std::unordered_map<std::string, std::unique_ptr<RColumnReaderBase>>> fDatasetColumnReaders;
 
+   /// For each slot and TTree column read in the current task, whether all the nodes that read it are guarded by a
+   /// Filter. Such columns are not added to the TTreeCache, see AddTreeColumnUse().
+   std::vector<std::unordered_map<std::string, bool>> fTreeColumnIsGuarded;
+
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
@@ -173,11 +195,18 @@ class RLoopManager : public RNodeBase {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   void RunSharedTreeEntry(TTreeReader &r, unsigned int slot, Long64_t entry);
+   bool AllSharedScanGraphsStopped() const;
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
    void CleanUpNodes();
    void CleanUpTask(TTreeReader *r, unsigned int slot);
    void EvalChildrenCounts();
+   std::vector<ROOT::RDF::RRangeCut> GetPushDownRangeCuts() const;
+   bool HasEventLoopObservers() const;
+   bool SetResultsFromMetadata();
+   std::string GetDatasetCacheKey() const;
+   bool LoadResultsFromCache();
    void SetupSampleCallbacks(TTreeReader *r, unsigned int slot);
    void UpdateSampleInfo(unsigned int slot, const std::pair<ULong64_t, ULong64_t> &range);
    void UpdateSampleInfo(unsigned int slot, TTreeReader &r);
@@ -201,7 +230,7 @@ public:
    RLoopManager &operator=(const RLoopManager &) = delete;
    RLoopManager(RLoopManager &&) = delete;
    RLoopManager &operator=(RLoopManager &&) = delete;
-   ~RLoopManager() = default;
+   ~RLoopManager();
 
    void JitDeclarations();
    void Jit();
@@ -212,6 +241,8 @@ public:
    ::TDirectory *GetDirectory() const;
    ULong64_t GetNEmptyEntries() const { return fEmptyEntryRange.second - fEmptyEntryRange.first; }
    RDataSource *GetDataSource() const { return fDataSource.get(); }
+   std::optional<ULong64_t> GetNEntriesFromMetadata() const;
+   std::optional<ROOT::RDF::RColumnStats> GetColumnStatsFromMetadata(const std::string &col) const;
    void Register(RDFInternal::RActionBase *actionPtr);
    void Deregister(RDFInternal::RActionBase *actionPtr);
    void Register(RFilterBase *filterPtr);
@@ -233,12 +264,30 @@ public:
    void ToJitExec(const std::string &) const;
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
    unsigned int GetNRuns() const { return fNRuns; }
+   const std::vector<double> &GetSlotBusyTimes() const { return fSlotBusyTimes; }
+   void EnableProfiling();
+   RDFInternal::RProfiler *GetProfiler() const { return fProfiler.get(); }
+   void EnableRVecArenas();
+   ROOT::Internal::VecOps::RVecArena *GetRVecArena(unsigned int slot) const
+   {
+      return fRVecArenas.empty() ? nullptr : fRVecArenas[slot].get();
+   }
+   void EnableResultCache(std::string_view fileName);
+   /// The loop manager reads the dataset: it is the root of the keys of the result cache, see EnableResultCache()
+   const std::string &GetCacheKey() const final
+   {
+      static const std::string key = "dataset";
+      return key;
+   }
+   std::string GetSharedScanKey() const;
+   void SetSharedScanLoops(std::vector<RLoopManager *> loops);
    bool HasDataSourceColumnReaders(const std::string &col, const std::type_info &ti) const;
    void AddDataSourceColumnReaders(const std::string &col, std::vector<std::unique_ptr<RColumnReaderBase>> &&readers,
                                    const std::type_info &ti);
    RColumnReaderBase *AddTreeColumnReader(unsigned int slot, const std::string &col,
                                           std::unique_ptr<RColumnReaderBase> &&reader, const std::type_info &ti);
    RColumnReaderBase *GetDatasetColumnReader(unsigned int slot, const std::string &col, const std::type_info &ti) const;
+   void AddTreeColumnUse(unsigned int slot, const std::string &col, bool isGuardedByFilter);
 
    /// End of recursive chain of calls, does nothing
    void AddFilterName(std::vector<std::string> &) final {}
@@ -49,6 +49,13 @@ void MergeValues(RMergeableValue<T> &OutputMergeable, const RMergeableValue<Ts>
 template <typename T, typename... Ts>
 void MergeValues(RMergeableVariations<T> &OutputMergeable, const RMergeableVariations<Ts> &... InputMergeables);
 
+template <typename T>
+std::unique_ptr<RMergeableValue<T>> MergeValues(std::vector<std::unique_ptr<RMergeableValue<T>>> &&Mergeables);
+
+template <typename T>
+std::unique_ptr<RMergeableVariations<T>>
+MergeValues(std::vector<std::unique_ptr<RMergeableVariations<T>>> &&Mergeables);
+
 /**
 \class ROOT::Detail::RDF::RMergeableValueBase
 \brief Base class of RMergeableValue.
@@ -802,6 +809,61 @@ void MergeValues(RMergeableVariations<T> &OutputMergeable, const RMergeableVaria
    // Cast to void to suppress unused-value warning in Clang
    (void)expander{0, (OutputMergeable.Merge(InputMergeables), 0)...};
 }
+
+/// \cond HIDDEN_SYMBOLS
+template <typename Mergeable_t>
+std::unique_ptr<Mergeable_t> TreeReduce(std::vector<std::unique_ptr<Mergeable_t>> &&mergeables)
+{
+   if (mergeables.empty())
+      throw std::invalid_argument("MergeValues: no mergeable values to merge.");
+   const auto n = mergeables.size();
+   for (std::size_t stride = 1; stride < n; stride *= 2) {
+      for (std::size_t i = 0; i + stride < n; i += 2 * stride) {
+         MergeValues(*mergeables[i], *mergeables[i + stride]);
+         mergeables[i + stride].reset(); // release partial results as soon as they are merged
+      }
+   }
+   return std::move(mergeables[0]);
+}
+/// \endcond
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Merge a sequence of RMergeableValue objects into one with a tree reduction.
+/// \param[in] Mergeables The mergeables containing the partial results, e.g. one per processed range of entries.
+/// \returns The mergeable holding the aggregated value.
+/// \throws std::invalid_argument If the sequence is empty.
+///
+/// Neighbouring mergeables are merged pairwise, then the results of these merges pairwise, and so on, so every merge
+/// combines partial results covering a similar number of ranges and each partial result is released as soon as it
+/// has been merged. Merging the consecutive subsequences of a sequence first, e.g. on different executors of a
+/// distributed computation, and then the results of those merges gives the same result as merging the whole sequence.
+///
+/// Example usage:
+/// ~~~{.cpp}
+/// using namespace ROOT::Detail::RDF;
+/// // partials is a std::vector<std::unique_ptr<RMergeableValue<TH1D>>>
+/// auto mergedptr = MergeValues(std::move(partials));
+/// const auto &mergedhisto = mergedptr->GetValue();
+/// ~~~
+template <typename T>
+std::unique_ptr<RMergeableValue<T>> MergeValues(std::vector<std::unique_ptr<RMergeableValue<T>>> &&Mergeables)
+{
+   return TreeReduce(std::move(Mergeables));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Merge a sequence of RMergeableVariations objects into one with a tree reduction.
+/// \param[in] Mergeables The mergeables containing the partial results, e.g. one per processed range of entries.
+/// \returns The mergeable holding the aggregated variations.
+/// \throws std::invalid_argument If the sequence is empty.
+///
+/// See the overload for RMergeableValue objects.
+template <typename T>
+std::unique_ptr<RMergeableVariations<T>>
+MergeValues(std::vector<std::unique_ptr<RMergeableVariations<T>>> &&Mergeables)
+{
+   return TreeReduce(std::move(Mergeables));
+}
 } // namespace RDF
 } // namespace Detail
 } // namespace ROOT
@@ -35,6 +35,7 @@ class GraphNode;
 namespace Detail {
 namespace RDF {
 
+class RFilterBase;
 class RLoopManager;
 
 /// Base class for non-leaf nodes of the computational graph.
@@ -46,6 +47,9 @@ protected:
    unsigned int fNChildren{0};      ///< Number of nodes of the functional graph hanging from this object
    unsigned int fNStopsReceived{0}; ///< Number of times that a children node signaled to stop processing entries.
    std::vector<std::string> fVariations; ///< List of systematic variations that affect this node.
+   /// Description of the computation graph up to this node, used to key the results in a result cache (see
+   /// RLoopManager::EnableResultCache()). Empty if the graph cannot be described, e.g. if it contains C++ callables.
+   std::string fCacheKey;
 
 public:
    RNodeBase(const std::vector<std::string> &variations = {}, RLoopManager *lm = nullptr)
@@ -69,10 +73,22 @@ public:
       fNStopsReceived = 0;
    }
 
+   /// Add the filters with range cuts between this node and the RLoopManager, whose cuts hold for every entry that
+   /// reaches this node. Nodes that must see all entries, i.e. ranges and named filters, drop the filters collected
+   /// so far.
+   virtual void CollectRangeCutFilters(std::vector<const RFilterBase *> &) const {}
+
+   /// Return true if the entries that reach the children of this node have passed at least one Filter, i.e. if the
+   /// children do not necessarily see every entry of the dataset.
+   virtual bool IsGuardedByFilter() const { return false; }
+
    virtual RLoopManager *GetLoopManagerUnchecked() { return fLoopManager; }
 
    const std::vector<std::string> &GetVariations() const { return fVariations; }
 
+   virtual const std::string &GetCacheKey() const { return fCacheKey; }
+   void SetCacheKey(const std::string &key) { fCacheKey = key; }
+
    /// Return a clone of this node that acts as a Filter working with values in the variationName "universe".
    virtual std::shared_ptr<RNodeBase> GetVariedFilter(const std::string & /*variationName*/)
    {
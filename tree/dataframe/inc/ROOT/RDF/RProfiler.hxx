@@ -0,0 +1,193 @@
+// Author: Enrico Guiraud CERN 10/2024
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROFILER
+#define ROOT_RDF_RPROFILER
+
+#include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+/**
+\class ROOT::RDF::Experimental::RProfileReport
+\ingroup dataframe
+\brief Time spent in each node of a computation graph during the last event loop, see RInterfaceBase::EnableProfiling().
+
+Times are exclusive: the time spent in a Filter does not include the time spent reading its input columns or
+evaluating the Defines it depends on, which are reported separately. Column entries report the time spent by the
+column readers of the dataset, i.e. reading and deserialising TTree branches or data source columns.
+*/
+class RProfileReport {
+public:
+   struct RNodeTimes {
+      std::string fKind;              ///< "Filter", "Define", "Vary", "Action" or "Column"
+      std::string fName;              ///< Name of the filter, defined column, action or dataset column
+      std::vector<double> fSlotTimes; ///< Exclusive time in seconds spent in this node by each slot
+      ULong64_t fCalls = 0;           ///< Number of evaluations, summed over all slots
+      double GetTotalTime() const;
+   };
+
+   /// A processing task: the entries of one slot between two InitSlot/FinalizeSlot calls.
+   struct RTaskTimes {
+      unsigned int fSlot = 0;
+      double fStart = 0.;              ///< Start of the task in seconds since the start of the event loop
+      double fEnd = 0.;                ///< End of the task in seconds since the start of the event loop
+      std::vector<double> fNodeTimes;  ///< Exclusive time spent in each node during the task, same order as GetNodes()
+   };
+
+private:
+   std::vector<RNodeTimes> fNodes;
+   std::vector<RTaskTimes> fTasks;
+
+public:
+   RProfileReport() = default;
+   RProfileReport(std::vector<RNodeTimes> &&nodes, std::vector<RTaskTimes> &&tasks);
+
+   const std::vector<RNodeTimes> &GetNodes() const { return fNodes; }
+   const std::vector<RTaskTimes> &GetTasks() const { return fTasks; }
+   void Print() const;
+   void SaveChromeTrace(const std::string &fileName) const;
+};
+
+} // namespace Experimental
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+
+/**
+\class ROOT::Internal::RDF::RProfiler
+\ingroup dataframe
+\brief Measures the exclusive time spent by each slot in each node of a computation graph.
+
+Nodes open an RProfileScope around their own work. Scopes nest, e.g. a Filter that reads a defined column opens the
+scope of the Define inside its own, and the time of a nested scope is subtracted from the enclosing one. Each slot
+only touches its own data, so no synchronisation is needed on the hot path.
+*/
+class RProfiler {
+public:
+   enum class ENodeKind { kFilter, kDefine, kVariation, kAction, kColumn };
+
+private:
+   using Clock_t = std::chrono::steady_clock;
+
+   struct RNodeInfo {
+      ENodeKind fKind;
+      std::string fName;
+   };
+
+   struct RSlotData {
+      std::vector<double> fTimes;
+      std::vector<ULong64_t> fCalls;
+      /// Start time and time spent in nested scopes of the open scopes
+      std::vector<std::pair<Clock_t::time_point, double>> fStack;
+      Clock_t::time_point fTaskStart;
+      std::vector<double> fTimesAtTaskStart;
+      std::vector<ROOT::RDF::Experimental::RProfileReport::RTaskTimes> fTasks;
+   };
+
+   std::vector<RNodeInfo> fNodes;
+   std::unordered_map<const void *, unsigned int> fNodeIds;
+   std::unordered_map<std::string, unsigned int> fColumnIds;
+   /// One entry per slot, allocated separately to avoid false sharing
+   std::vector<std::unique_ptr<RSlotData>> fSlots;
+   Clock_t::time_point fLoopStart;
+   /// Protects the node registry: column readers of TTree datasets are registered by the tasks
+   mutable std::mutex fMutex;
+
+public:
+   explicit RProfiler(unsigned int nSlots);
+
+   void StartLoop();
+   unsigned int RegisterNode(const void *node, ENodeKind kind, const std::string &name);
+   unsigned int RegisterColumn(const std::string &name);
+   void StartTask(unsigned int slot);
+   void EndTask(unsigned int slot);
+   double GetNodeTime(const void *node) const;
+   ROOT::RDF::Experimental::RProfileReport MakeReport() const;
+
+   void Begin(unsigned int slot) { fSlots[slot]->fStack.emplace_back(Clock_t::now(), 0.); }
+
+   void End(unsigned int slot, unsigned int id)
+   {
+      auto &data = *fSlots[slot];
+      const auto elapsed = std::chrono::duration<double>(Clock_t::now() - data.fStack.back().first).count();
+      const auto nested = data.fStack.back().second;
+      data.fStack.pop_back();
+      if (id >= data.fTimes.size()) {
+         data.fTimes.resize(id + 1, 0.);
+         data.fCalls.resize(id + 1, 0ull);
+      }
+      data.fTimes[id] += elapsed - nested;
+      ++data.fCalls[id];
+      if (!data.fStack.empty())
+         data.fStack.back().second += elapsed;
+   }
+};
+
+/// RAII object that attributes the time elapsed during its lifetime to a node. A null profiler makes it a no-op.
+class RProfileScope {
+   RProfiler *fProfiler;
+   unsigned int fSlot;
+   unsigned int fId;
+
+public:
+   RProfileScope(RProfiler *profiler, unsigned int slot, unsigned int id) : fProfiler(profiler), fSlot(slot), fId(id)
+   {
+      if (fProfiler)
+         fProfiler->Begin(fSlot);
+   }
+   RProfileScope(const RProfileScope &) = delete;
+   RProfileScope &operator=(const RProfileScope &) = delete;
+   ~RProfileScope()
+   {
+      if (fProfiler)
+         fProfiler->End(fSlot, fId);
+   }
+};
+
+/// A column reader that attributes the time spent in the wrapped dataset column reader to its column.
+class R__CLING_PTRCHECK(off) RProfiledColumnReader final : public ROOT::Detail::RDF::RColumnReaderBase {
+   std::unique_ptr<RColumnReaderBase> fReader;
+   RProfiler &fProfiler;
+   unsigned int fSlot;
+   unsigned int fId;
+
+   void *GetImpl(Long64_t entry) final
+   {
+      RProfileScope scope(&fProfiler, fSlot, fId);
+      // Get<char> returns the type-erased address of the value without touching it
+      return &fReader->template Get<char>(entry);
+   }
+
+public:
+   RProfiledColumnReader(std::unique_ptr<RColumnReaderBase> reader, RProfiler &profiler, unsigned int slot,
+                         unsigned int id)
+      : fReader(std::move(reader)), fProfiler(profiler), fSlot(slot), fId(id)
+   {
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RPROFILER
@@ -55,6 +55,10 @@ public:
         fPrevNodePtr(std::move(pd)), fPrevNode(*fPrevNodePtr)
    {
       fLoopManager->Register(this);
+      const auto &prevKey = fPrevNode.GetCacheKey();
+      if (!prevKey.empty())
+         fCacheKey = prevKey + ";Range(" + std::to_string(start) + "," + std::to_string(stop) + "," +
+                     std::to_string(stride) + ")";
    }
 
    RRange(const RRange &) = delete;
@@ -113,6 +117,13 @@ public:
 
    /// This function must be defined by all nodes, but only the filters will add their name
    void AddFilterName(std::vector<std::string> &filters) final { fPrevNode.AddFilterName(filters); }
+   /// The entries counted by the range must not depend on the filters that follow it
+   void CollectRangeCutFilters(std::vector<const RFilterBase *> &filters) const final
+   {
+      filters.clear();
+      fPrevNode.CollectRangeCutFilters(filters);
+   }
+   bool IsGuardedByFilter() const final { return fPrevNode.IsGuardedByFilter(); }
    std::shared_ptr<RDFGraphDrawing::GraphNode>
    GetGraph(std::unordered_map<void *, std::shared_ptr<RDFGraphDrawing::GraphNode>> &visitedMap) final
    {
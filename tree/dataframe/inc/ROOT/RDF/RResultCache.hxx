@@ -0,0 +1,151 @@
+// Author: Enrico Guiraud CERN 10/2024
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RRESULTCACHE
+#define ROOT_RDF_RRESULTCACHE
+
+#include "ROOT/RDF/InterfaceUtils.hxx" // ActionTags
+#include "RtypesCore.h"
+#include "TObject.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class TDirectory;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Type-erased access to the result of an action, to store it in and load it from a RResultCache.
+class RCachedResultBase {
+public:
+   virtual ~RCachedResultBase() = default;
+   /// Describe the result as it is before the event loop, i.e. the configuration of the action, e.g. the binning of a
+   /// histogram model or the initial value of a sum. It is part of the key of the result in the cache.
+   virtual std::string GetInitialState() const = 0;
+   /// Replace the result with the one stored in `dir` under `name`. Returns false if there is no such result.
+   virtual bool Load(TDirectory &dir, const std::string &name) = 0;
+   virtual void Store(TDirectory &dir, const std::string &name) const = 0;
+};
+
+std::string SerializeCachedObject(const TObject &obj);
+std::unique_ptr<TObject> LoadCachedObject(TDirectory &dir, const std::string &name);
+void StoreCachedObject(TDirectory &dir, const std::string &name, const TObject &obj);
+bool LoadCachedValue(TDirectory &dir, const std::string &name, Long64_t &value);
+bool LoadCachedValue(TDirectory &dir, const std::string &name, Double_t &value);
+void StoreCachedValue(TDirectory &dir, const std::string &name, Long64_t value);
+void StoreCachedValue(TDirectory &dir, const std::string &name, Double_t value);
+
+/// A result object, such as a histogram, that is stored in the cache as is.
+template <typename T>
+class RCachedObject final : public RCachedResultBase {
+   std::shared_ptr<T> fResult;
+
+public:
+   RCachedObject(const std::shared_ptr<T> &result) : fResult(result) {}
+   std::string GetInitialState() const final { return SerializeCachedObject(*fResult); }
+   bool Load(TDirectory &dir, const std::string &name) final
+   {
+      auto obj = LoadCachedObject(dir, name);
+      auto *cached = dynamic_cast<T *>(obj.get());
+      if (!cached)
+         return false;
+      *fResult = *cached;
+      return true;
+   }
+   void Store(TDirectory &dir, const std::string &name) const final { StoreCachedObject(dir, name, *fResult); }
+};
+
+/// An arithmetic result, stored in the cache as a TParameter<Long64_t> or TParameter<Double_t>.
+template <typename T>
+class RCachedValue final : public RCachedResultBase {
+   using Stored_t = std::conditional_t<std::is_integral<T>::value, Long64_t, Double_t>;
+   std::shared_ptr<T> fResult;
+
+public:
+   RCachedValue(const std::shared_ptr<T> &result) : fResult(result) {}
+   std::string GetInitialState() const final { return std::to_string(static_cast<Stored_t>(*fResult)); }
+   bool Load(TDirectory &dir, const std::string &name) final
+   {
+      Stored_t value;
+      if (!LoadCachedValue(dir, name, value))
+         return false;
+      *fResult = static_cast<T>(value);
+      return true;
+   }
+   void Store(TDirectory &dir, const std::string &name) const final
+   {
+      StoreCachedValue(dir, name, static_cast<Stored_t>(*fResult));
+   }
+};
+
+/// The actions whose result only depends on their input columns and on their initial result, and not on C++
+/// callables or objects provided by the user, can be cached.
+template <typename ActionTag>
+struct IsCacheableAction : std::false_type {};
+// clang-format off
+template <> struct IsCacheableAction<ActionTags::Histo1D> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::Histo2D> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::Histo3D> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::SharedFill> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::HistoND> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::Graph> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::GraphAsymmErrors> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::Profile1D> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::Profile2D> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::Min> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::Max> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::Sum> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::Mean> : std::true_type {};
+template <> struct IsCacheableAction<ActionTags::StdDev> : std::true_type {};
+// clang-format on
+
+/// Return an object that gives access to `result` for the result cache, or nullptr if the result cannot be cached.
+template <typename T>
+std::unique_ptr<RCachedResultBase> MakeCachedResult(const std::shared_ptr<T> &result)
+{
+   if constexpr (std::is_base_of<TObject, T>::value && std::is_copy_assignable<T>::value) {
+      return std::make_unique<RCachedObject<T>>(result);
+   } else if constexpr (std::is_arithmetic<T>::value && !std::is_same<T, long double>::value) {
+      return std::make_unique<RCachedValue<T>>(result);
+   } else {
+      (void)result;
+      return nullptr;
+   }
+}
+
+/// A file in which the results of the actions of a computation graph are stored, keyed by a description of how they
+/// are computed, so that later event loops can load them instead of computing them again.
+/// See RLoopManager::EnableResultCache().
+class RResultCache {
+   std::string fFileName;
+
+   static std::string MakeName(std::string_view key);
+
+public:
+   explicit RResultCache(std::string_view fileName) : fFileName(fileName) {}
+   const std::string &GetFileName() const { return fFileName; }
+   /// Load the result stored with the given key into `result`. Returns false if there is no such result.
+   bool Load(RCachedResultBase &result, std::string_view key) const;
+   /// Store the results with the given keys, replacing the ones stored with the same keys. Returns false if the cache
+   /// file cannot be written.
+   bool Store(const std::vector<std::pair<const RCachedResultBase *, std::string>> &results) const;
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RRESULTCACHE
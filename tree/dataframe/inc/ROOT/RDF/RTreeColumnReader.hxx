@@ -19,13 +19,46 @@
 #include <TTreeReaderArray.h>
 
 #include <array>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
+
+class TBranch;
+class TBufferFile;
+class TTree;
 
 namespace ROOT {
 namespace Internal {
 namespace RDF {
 
+/// Reads a variable-length branch of a fundamental type one basket at a time through the bulk I/O interface,
+/// see TBranch::GetBulkEntries(Long64_t, TBuffer &, TBuffer &). The elements of an entry are then accessed in place.
+class RTreeBulkArrayReader {
+   TTreeReader &fTreeReader;
+   std::string fBranchName;
+   const std::type_info &fElementType;
+   /// The tree (of the chain) for which fBranch was looked up
+   TTree *fTree = nullptr;
+   TBranch *fBranch = nullptr;
+   std::unique_ptr<TBufferFile> fValues;
+   std::unique_ptr<TBufferFile> fOffsets;
+   std::size_t fElementSize = 0;
+   /// First entry and number of entries of the basket in fValues
+   Long64_t fFirstEntry = -1;
+   Long64_t fNEntries = 0;
+
+public:
+   RTreeBulkArrayReader(TTreeReader &r, const std::string &branchName, const std::type_info &elementType);
+   ~RTreeBulkArrayReader();
+
+   /// Return the address of the first element of the current entry of the tree reader and set `size` to the number
+   /// of elements. Returns nullptr if the branch cannot be read in bulk, in which case the caller must fall back to
+   /// a TTreeReaderArray.
+   void *GetValues(std::size_t &size);
+};
+
 /// RTreeColumnReader specialization for TTree values read via TTreeReaderValues
 template <typename T>
 class R__CLING_PTRCHECK(off) RTreeColumnReader final : public ROOT::Detail::RDF::RColumnReaderBase {
@@ -61,11 +94,26 @@ class R__CLING_PTRCHECK(off) RTreeColumnReader<RVec<T>> final : public ROOT::Det
    /// Whether we already printed a warning about performing a copy of the TTreeReaderArray contents
    bool fCopyWarningPrinted = false;
 
+   /// Reads the branch in bulk if possible; reset as soon as bulk reading fails, e.g. for a branch of a friend
+   std::unique_ptr<RTreeBulkArrayReader> fBulkReader;
+
    void *GetImpl(Long64_t entry) final
    {
       if (entry == fLastEntry)
          return &fRVec; // we already pointed our fRVec to the right address
 
+      if (fBulkReader) {
+         std::size_t size = 0;
+         if (auto values = static_cast<T *>(fBulkReader->GetValues(size))) {
+            // This is a non-owning view on the values of the basket
+            RVec<T> rvec(values, size);
+            swap(fRVec, rvec);
+            fLastEntry = entry;
+            return &fRVec;
+         }
+         fBulkReader.reset();
+      }
+
       auto &readerArray = *fTreeArray;
       // We only use TTreeReaderArrays to read columns that users flagged as type `RVec`, so we need to check
       // that the branch stores the array as contiguous memory that we can actually wrap in an `RVec`.
@@ -125,6 +173,8 @@ public:
    RTreeColumnReader(TTreeReader &r, const std::string &colName)
       : fTreeArray(std::make_unique<TTreeReaderArray<T>>(r, colName.c_str()))
    {
+      if (std::is_arithmetic<T>::value)
+         fBulkReader = std::make_unique<RTreeBulkArrayReader>(r, colName, typeid(T));
    }
 };
 
@@ -222,6 +222,7 @@ public:
    {
       if (entry != fLastCheckedEntry[slot * CacheLineStep<Long64_t>()]) {
          // evaluate this filter, cache the result
+         RProfileScope profile(fLoopManager->GetProfiler(), slot, fProfileId);
          UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
          fLastCheckedEntry[slot * CacheLineStep<Long64_t>()] = entry;
       }
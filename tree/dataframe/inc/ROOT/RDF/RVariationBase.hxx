@@ -47,6 +47,7 @@ protected:
    ColumnNames_t fInputColumns;
    /// The nth flag signals whether the nth input column is a custom column or not.
    ROOT::RVecB fIsDefine;
+   unsigned int fProfileId = 0; ///< Id of this node in the RProfiler of the loop manager, if profiling is enabled
 
 public:
    RVariationBase(const std::vector<std::string> &colNames, std::string_view variationName,
@@ -71,6 +72,7 @@ public:
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
    /// Clean-up operations to be performed at the end of a task.
    virtual void FinalizeSlot(unsigned int slot) = 0;
+   void SetProfileId(unsigned int id) { fProfileId = id; }
 };
 
 } // namespace RDF
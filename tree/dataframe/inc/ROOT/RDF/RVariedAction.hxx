@@ -26,6 +26,8 @@
 #include <algorithm>
 #include <array>
 #include <memory>
+#include <tuple>
+#include <type_traits>
 #include <utility> // make_index_sequence
 #include <vector>
 
@@ -35,6 +37,32 @@ namespace RDF {
 
 namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 
+/// The type of the object returned by Helper::MakeVariationsFiller, or void if the helper does not provide one.
+/// A variations filler receives the values of all the variations that passed their filters for an entry at once, see
+/// RVariedAction::RunVariationsFiller.
+template <typename Helper, typename ColumnTypes_t, typename = void>
+struct VariationsFillerOf {
+   using type = void;
+};
+
+template <typename Helper, typename ColumnTypes_t>
+struct VariationsFillerOf<Helper, ColumnTypes_t,
+                          std::void_t<decltype(Helper::MakeVariationsFiller(std::declval<std::vector<Helper> &>(),
+                                                                            ColumnTypes_t{}))>> {
+   using type = typename decltype(Helper::MakeVariationsFiller(std::declval<std::vector<Helper> &>(),
+                                                               ColumnTypes_t{}))::element_type;
+};
+
+/// The variations of an entry that passed their filters, and the addresses of their values, for a variations filler.
+template <typename ColumnTypes_t>
+struct RVariationBatch;
+
+template <typename... ColTypes>
+struct RVariationBatch<TypeList<ColTypes...>> {
+   std::vector<unsigned int> fVarIdx;
+   std::tuple<std::vector<const ColTypes *>...> fValues;
+};
+
 /// Just like an RAction, but it has N action helpers and N previous nodes (N is the number of variations).
 template <typename Helper, typename PrevNode, typename ColumnTypes_t>
 class R__CLING_PTRCHECK(off) RVariedAction final : public RActionBase {
@@ -53,6 +81,13 @@ class R__CLING_PTRCHECK(off) RVariedAction final : public RActionBase {
    /// The nth flag signals whether the nth input column is a custom column or not.
    std::array<bool, ColumnTypes_t::list_size> fIsDefine;
 
+   using VariationsFiller_t = typename VariationsFillerOf<Helper, ColumnTypes_t>::type;
+   static constexpr bool kHasVariationsFiller = !std::is_void<VariationsFiller_t>::value;
+   /// If the helper supports it, fills the results of all variations at once instead of calling each helper's Exec.
+   std::unique_ptr<std::conditional_t<kHasVariationsFiller, VariationsFiller_t, char>> fVariationsFiller;
+   /// Per slot, allocated separately to avoid false sharing. Only used with a variations filler.
+   std::vector<std::unique_ptr<RVariationBatch<ColumnTypes_t>>> fBatches;
+
    /// \brief Creates new filter nodes, one per variation, from the upstream nominal one.
    /// \param nominal The nominal filter
    /// \return The varied filters
@@ -127,6 +162,14 @@ public:
    void Initialize() final
    {
       std::for_each(fHelpers.begin(), fHelpers.end(), [](Helper &h) { h.Initialize(); });
+      if constexpr (kHasVariationsFiller) {
+         // null if the helpers' results are not supported, e.g. histograms with axes that can extend
+         fVariationsFiller = Helper::MakeVariationsFiller(fHelpers, ColumnTypes_t{});
+         if (fVariationsFiller && fBatches.empty()) {
+            for (auto i = 0u; i < GetNSlots(); ++i)
+               fBatches.emplace_back(new RVariationBatch<ColumnTypes_t>());
+         }
+      }
    }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final
@@ -148,11 +191,38 @@ public:
       (void)entry;
    }
 
+   /// Collect the values of the variations that pass their filters, then fill all of them with one call.
+   template <typename... ColTypes, std::size_t... S>
+   void RunVariationsFiller(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>)
+   {
+      auto &batch = *fBatches[slot];
+      batch.fVarIdx.clear();
+      (std::get<S>(batch.fValues).clear(), ...);
+      for (auto varIdx = 0u; varIdx < GetVariations().size(); ++varIdx) {
+         if (fPrevNodes[varIdx]->CheckFilters(slot, entry)) {
+            batch.fVarIdx.emplace_back(varIdx);
+            (std::get<S>(batch.fValues)
+                .emplace_back(&fInputValues[slot][varIdx][S]->template Get<ColTypes>(entry)),
+             ...);
+         }
+      }
+      if (batch.fVarIdx.empty())
+         return;
+      RProfileScope profile(fLoopManager->GetProfiler(), slot, fProfileId);
+      fVariationsFiller->Exec(slot, batch.fVarIdx.data(), batch.fVarIdx.size(), std::get<S>(batch.fValues).data()...);
+   }
+
    void Run(unsigned int slot, Long64_t entry) final
    {
+      if constexpr (kHasVariationsFiller) {
+         if (fVariationsFiller)
+            return RunVariationsFiller(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      }
       for (auto varIdx = 0u; varIdx < GetVariations().size(); ++varIdx) {
-         if (fPrevNodes[varIdx]->CheckFilters(slot, entry))
+         if (fPrevNodes[varIdx]->CheckFilters(slot, entry)) {
+            RProfileScope profile(fLoopManager->GetProfiler(), slot, fProfileId);
             CallExec(slot, varIdx, entry, ColumnTypes_t{}, TypeInd_t{});
+         }
       }
    }
 
@@ -165,6 +235,10 @@ public:
    void FinalizeSlot(unsigned int slot) final
    {
       fInputValues[slot].clear();
+      if constexpr (kHasVariationsFiller) {
+         if (fVariationsFiller)
+            fVariationsFiller->FinalizeTask(slot);
+      }
       std::for_each(fHelpers.begin(), fHelpers.end(), [=](Helper &h) { h.CallFinalizeTask(slot); });
    }
 
@@ -176,6 +250,8 @@ public:
       SetHasRun();
    }
 
+   std::string GetActionName() final { return "Varied " + fHelpers[0].GetActionName(); }
+
    /// Return the partially-updated value connected to the first variation.
    void *PartialUpdate(unsigned int slot) final { return PartialUpdateImpl(slot); }
 
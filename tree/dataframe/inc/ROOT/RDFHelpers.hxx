@@ -171,6 +171,10 @@ RNode AsRNode(NodeType node)
 /// computation of all results is generally more efficient.
 /// It should be noted that user-defined operations (e.g., Filters and Defines) of the different RDataFrame graphs are assumed to be safe to call concurrently.
 ///
+/// Computation graphs that read the same entries of the same TTree or TChain, without friends or entry lists, share
+/// a single event loop: each column is read from storage once per entry and its value is passed to all graphs.
+/// In that case the user-defined operations of these graphs are called one after the other for each entry.
+///
 /// ~~~{.cpp}
 /// ROOT::RDataFrame df1("tree1", "file1.root");
 /// auto r1 = df1.Histo1D("var1");
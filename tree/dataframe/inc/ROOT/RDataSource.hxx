@@ -17,6 +17,7 @@
 #include "TString.h"
 
 #include <algorithm> // std::transform
+#include <optional>
 #include <string>
 #include <typeinfo>
 #include <vector>
@@ -74,6 +75,24 @@ public:
 
 namespace RDF {
 
+/// A cut on the values of a data source column that all the entries selected by the computation graph pass: entries
+/// for which the column value lies outside the closed interval [fMin, fMax] are certainly filtered out.
+/// See RDataSource::SetRangeCuts().
+struct RRangeCut {
+   std::string fColumnName;
+   double fMin;
+   double fMax;
+};
+
+/// The range of the values of a data source column, as known from the dataset metadata.
+/// See RDataSource::GetColumnStatsFromMetadata().
+struct RColumnStats {
+   double fMin;
+   double fMax;
+   /// Whether fMin and fMax are values actually taken by the column rather than (possibly loose) bounds
+   bool fIsExact;
+};
+
 // clang-format off
 /**
 \class ROOT::RDF::RDataSource
@@ -89,6 +108,7 @@ The sequence of calls that RDataFrame (or any other client of a RDataSource) per
 
  - SetNSlots() : inform RDataSource of the desired level of parallelism
  - GetColumnReaders() : retrieve from RDataSource per-thread readers for the desired columns
+ - SetRangeCuts() : inform RDataSource of the cuts that every selected entry of the coming event-loop passes
  - Initialize() : inform RDataSource that an event-loop is about to start
  - GetEntryRanges() : retrieve from RDataSource a set of ranges of entries that can be processed concurrently
  - InitSlot() : inform RDataSource that a certain thread is about to start working on a certain range of entries
@@ -201,6 +221,31 @@ public:
    // clang-format on
    virtual void Initialize() {}
 
+   // clang-format off
+   /// \brief Inform RDataSource of the cuts that any entry has to pass in order to be processed by the next event-loop.
+   /// \param[in] cuts The range cuts, possibly empty, pushed down from the Filters of the computation graph.
+   /// This method is called right before Initialize(), once per event-loop. The data source may use the cuts to leave
+   /// out of GetEntryRanges() the entries that cannot pass them, e.g. based on statistics of the stored values.
+   /// Since the Filters still evaluate the cuts, ignoring them (the default) is always correct.
+   // clang-format on
+   virtual void SetRangeCuts(const std::vector<RRangeCut> & /*cuts*/) {}
+
+   // clang-format off
+   /// \brief Return the number of entries of the dataset if it is known without reading any column, e.g. from the file
+   /// metadata. RDataFrame uses it to set the result of a Count() on the whole dataset without an event loop.
+   /// This method is called outside of event loops, before Initialize().
+   // clang-format on
+   virtual std::optional<ULong64_t> GetNEntriesFromMetadata() { return std::nullopt; }
+
+   // clang-format off
+   /// \brief Return the range of the values of a column over the whole dataset if it is known without reading the
+   /// column, e.g. from statistics stored in the file metadata. NaN values are not part of the range.
+   /// \param[in] colName The name of the column
+   /// RDataFrame uses exact statistics to set the results of Min() and Max() on the whole dataset without an event
+   /// loop. Returns nothing if the range is unknown, e.g. for an empty dataset.
+   // clang-format on
+   virtual std::optional<RColumnStats> GetColumnStatsFromMetadata(std::string_view /*colName*/) { return std::nullopt; }
+
    // clang-format off
    /// \brief Convenience method called at the start of the data processing associated to a slot.
    /// \param[in] slot The data processing slot wihch needs to be initialized
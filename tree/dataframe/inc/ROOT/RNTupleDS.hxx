@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -54,6 +55,8 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
       ULong64_t fFirstEntry = 0; ///< First entry index in fSource
       /// End entry index in fSource, e.g. the number of entries in the range is fLastEntry - fFirstEntry
       ULong64_t fLastEntry = 0;
+      /// The global entry number of the first entry in fSource, set by GetEntryRanges()
+      ULong64_t fEntryOffset = 0;
    };
 
    /// A clone of the first pages source's descriptor.
@@ -104,6 +107,14 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
    /// the fCurrentRanges vectors.  This is necessary because the returned ranges get distributed arbitrarily
    /// onto slots.  In the InitSlot method, the column readers use this map to find the correct range to connect to.
    std::unordered_map<ULong64_t, std::size_t> fFirstEntry2RangeIdx;
+   /// The cuts passed by RDataFrame for the current event loop, used to skip clusters, see GetSelectedRanges()
+   std::vector<ROOT::RDF::RRangeCut> fRangeCuts;
+
+   /// The descriptors of the files following the first one, only read by the methods that answer queries from the
+   /// dataset metadata, see LoadMetadataDescriptors()
+   std::vector<std::unique_ptr<RNTupleDescriptor>> fMetadataDescriptors;
+   /// The column statistics already computed by GetColumnStatsFromMetadata(), per column name
+   std::unordered_map<std::string, std::optional<ROOT::RDF::RColumnStats>> fColumnStats;
 
    /// The background thread that runs StageNextSources()
    std::thread fThreadStaging;
@@ -148,6 +159,13 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
    /// Upon return, the fNextRanges list is ordered.  It has usually fNSlots elements; fewer if there
    /// is not enough work to give at least one cluster to every slot.
    void PrepareNextRanges();
+   /// Returns the sub-ranges of `range`, in entry numbers of its page source, made of the clusters in which some
+   /// values may pass all of fRangeCuts. Clusters are only skipped based on the value ranges stored in the cluster
+   /// descriptors (see RNTupleWriteOptions::SetEnableValueRanges()) of top-level leaf fields.
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetSelectedRanges(const REntryRangeDS &range) const;
+   /// Opens the files following the first one, if not done yet, and keeps their descriptors in fMetadataDescriptors.
+   /// Only the metadata of the files is read. Must not be called during an event loop.
+   void LoadMetadataDescriptors();
 
    explicit RNTupleDS(std::unique_ptr<ROOT::Experimental::Internal::RPageSource> pageSource);
 
@@ -164,6 +182,9 @@ public:
    std::string GetTypeName(std::string_view colName) const final;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
    std::string GetLabel() final { return "RNTupleDS"; }
+   void SetRangeCuts(const std::vector<ROOT::RDF::RRangeCut> &cuts) final { fRangeCuts = cuts; }
+   std::optional<ULong64_t> GetNEntriesFromMetadata() final;
+   std::optional<ROOT::RDF::RColumnStats> GetColumnStatsFromMetadata(std::string_view colName) final;
 
    void Initialize() final;
    void InitSlot(unsigned int slot, ULong64_t firstEntry) final;
@@ -12,12 +12,21 @@
 #define ROOT_RSNAPSHOTOPTIONS
 
 #include <Compression.h>
+#include <cstddef>
 #include <string_view>
 #include <string>
 
 namespace ROOT {
 
 namespace RDF {
+
+/// The data format in which Snapshot writes its output
+enum class ESnapshotOutputFormat {
+   kDefault, ///< Currently TTree
+   kTTree,
+   kRNTuple ///< Written in parallel from all processing slots, requires ROOT 7 support
+};
+
 /// A collection of options to steer the creation of the dataset on file
 struct RSnapshotOptions {
    using ECAlgo = ROOT::RCompressionSetting::EAlgorithm::EValues;
@@ -43,6 +52,9 @@ struct RSnapshotOptions {
    int fSplitLevel = 99;                            ///< Split level of output tree
    bool fLazy = false;                              ///< Do not start the event loop when Snapshot is called
    bool fOverwriteIfExists = false; ///< If fMode is "UPDATE", overwrite object in output file if it already exists
+   ESnapshotOutputFormat fOutputFormat = ESnapshotOutputFormat::kDefault; ///< Data format of the output dataset
+   /// For RNTuple output, approximate memory in bytes for the clusters buffered by all slots; 0 for the defaults
+   std::size_t fMemoryBudget = 0;
 };
 } // namespace RDF
 } // namespace ROOT
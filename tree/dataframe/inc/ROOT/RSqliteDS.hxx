@@ -47,6 +47,11 @@ is used:
   - For expressions ("SELECT 1+1 FROM table"), the type of the first row of the result set determines the column type.
     That can result in a column to be of thought of type NULL where subsequent rows actually have meaningful values.
     The provided SELECT query can be used to avoid such ambiguities.
+
+SQlite steps through the result set sequentially. The data source fetches the rows in batches into column buffers,
+a few thousand rows per slot, and hands out one entry range per slot for each batch. With implicit multi-threading,
+the processing of the rows is therefore parallel while the SQlite query itself runs in a single thread. Selections
+on table columns are best expressed in the WHERE clause of the query, where SQlite can use the table indexes.
 */
 class RSqliteDS final : public ROOT::RDF::RDataSource {
 private:
@@ -79,11 +84,14 @@ private:
 
    std::unique_ptr<Internal::RSqliteDSDataSet> fDataSet;
    unsigned int fNSlots;
+   /// Number of rows fetched so far in the current event loop
    ULong64_t fNRow;
    std::vector<std::string> fColumnNames;
    std::vector<ETypes> fColumnTypes;
-   /// The data source is inherently single-threaded and returns only one row at a time. This vector holds the results.
-   std::vector<Value_t> fValues;
+   /// The values of the current entry of each slot, indexed by slot and column. The column readers point to them.
+   std::vector<std::vector<Value_t>> fValues;
+
+   void FetchRow(std::size_t row);
 
    // clang-format off
    /// Corresponds to the types defined in ETypes.
@@ -20,8 +20,19 @@ A RDataFrame that adapts an arrow::Table class can be constructed using the fact
 ROOT::RDF::FromArrow, which accepts one parameter:
 1. An arrow::Table smart pointer.
 
+Datasets that do not fit in memory can be streamed instead, passing an
+arrow::RecordBatchReader to ROOT::RDF::FromArrow: any Arrow source that produces
+record batches can be used, e.g. IPC files and streams, Parquet files read through
+parquet::arrow::FileReader or an arrow::dataset::Scanner, or Flight streams. Record
+batches are read on demand, a few per processing slot at a time, and each batch is
+processed as one task, so that batches are processed in parallel when implicit
+multi-threading is enabled. As the reader is consumed, a streaming RArrowDS can only be
+used for one event loop.
+
 The types of the columns are derived from the types in the associated
-arrow::Schema.
+arrow::Schema. Numerical columns are read directly from the Arrow buffers, and list
+columns are exposed as RVecs that view the Arrow buffers: no values are copied, except
+for booleans, which are bit-packed by Arrow, and strings.
 
 */
 // clang-format on
@@ -41,6 +52,7 @@ arrow::Schema.
 #pragma GCC diagnostic ignored "-Wshadow"
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #endif
+#include <arrow/record_batch.h>
 #include <arrow/table.h>
 #include <arrow/stl.h>
 #if defined(__GNUC__)
@@ -286,6 +298,49 @@ public:
    }
 };
 
+/// Helper class which keeps track for each slot of the array it reads when
+/// streaming record batches. Each slot reads the column of its own batch, so
+/// entries are relative to the first row of that batch.
+class TBatchValueGetter {
+private:
+   std::vector<void *> fValuesPtrPerSlot;
+   std::vector<ArrayPtrVisitor> fArrayVisitorPerSlot;
+   std::vector<std::shared_ptr<arrow::Array>> fArrayPerSlot;
+
+public:
+   TBatchValueGetter(size_t slots) : fValuesPtrPerSlot(slots, nullptr), fArrayPerSlot(slots)
+   {
+      for (size_t si = 0, se = fValuesPtrPerSlot.size(); si != se; ++si) {
+         fArrayVisitorPerSlot.push_back(ArrayPtrVisitor{fValuesPtrPerSlot.data() + si});
+      }
+   }
+
+   /// This returns the ptr to the ptr to actual data.
+   std::vector<void *> SlotPtrs()
+   {
+      std::vector<void *> result;
+      for (size_t i = 0; i < fValuesPtrPerSlot.size(); ++i) {
+         result.push_back(fValuesPtrPerSlot.data() + i);
+      }
+      return result;
+   }
+
+   void SetArray(unsigned int slot, std::shared_ptr<arrow::Array> array) { fArrayPerSlot[slot] = std::move(array); }
+
+   /// Set the current entry to be retrieved, relative to the beginning of the array of the slot
+   void SetEntry(unsigned int slot, ULong64_t entry)
+   {
+      assert(fArrayPerSlot[slot] != nullptr);
+      fArrayVisitorPerSlot[slot].SetEntry(entry);
+      auto status = fArrayPerSlot[slot]->Accept(fArrayVisitorPerSlot.data() + slot);
+      if (!status.ok()) {
+         std::string msg = "Could not get pointer for slot ";
+         msg += std::to_string(slot) + " looking at batch entry " + std::to_string(entry);
+         throw std::runtime_error(msg);
+      }
+   }
+};
+
 } // namespace RDF
 } // namespace Internal
 
@@ -386,7 +441,7 @@ public:
 /// \param[in] inColumns the name of the columns to use
 /// In case columns is empty, we use all the columns found in the table
 RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::string> const &inColumns)
-   : fTable{inTable}, fColumnNames{inColumns}
+   : fTable{inTable}, fSchema{inTable->schema()}, fColumnNames{inColumns}
 {
    auto &columnNames = fColumnNames;
    auto &table = fTable;
@@ -455,6 +510,39 @@ RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::strin
    }
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create an Arrow RDataSource which streams record batches.
+/// \param[in] inReader the reader of the record batches to process. It is consumed by the event loop.
+/// \param[in] inColumns the name of the columns to use
+/// In case columns is empty, we use all the columns found in the schema of the reader
+RArrowDS::RArrowDS(std::shared_ptr<arrow::RecordBatchReader> inReader, std::vector<std::string> const &inColumns)
+   : fBatchReader{inReader}, fSchema{inReader->schema()}, fColumnNames{inColumns}
+{
+   if (fColumnNames.empty()) {
+      for (auto &field : fSchema->fields()) {
+         fColumnNames.push_back(field->name());
+      }
+   }
+   if (fColumnNames.empty()) {
+      throw std::runtime_error("At least one column required");
+   }
+
+   for (auto &columnName : fColumnNames) {
+      const auto columnIdx = fSchema->GetFieldIndex(columnName);
+      if (columnIdx < 0) {
+         throw std::runtime_error("The dataset does not have column " + columnName);
+      }
+      fGetterIndex.push_back(std::make_pair(columnIdx, fGetterIndex.size()));
+
+      VerifyValidColumnType verifyType;
+      if (!fSchema->field(columnIdx)->type()->Accept(&verifyType).ok()) {
+         std::string msg = "Column ";
+         msg += columnName + " contains an unsupported type.";
+         throw std::runtime_error(msg);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Destructor.
 RArrowDS::~RArrowDS()
@@ -468,13 +556,35 @@ const std::vector<std::string> &RArrowDS::GetColumnNames() const
 
 std::vector<std::pair<ULong64_t, ULong64_t>> RArrowDS::GetEntryRanges()
 {
+   if (fBatchReader) {
+      // The batches of the previous ranges have been processed, and only the
+      // next few batches are kept in memory. Each batch is one range.
+      const auto maxBatches = 2 * fNSlots;
+      fBatches.clear();
+      std::shared_ptr<arrow::RecordBatch> batch;
+      while (fBatches.size() < maxBatches) {
+         auto status = fBatchReader->ReadNext(&batch);
+         if (!status.ok()) {
+            throw std::runtime_error("RArrowDS: could not read the next record batch: " + status.ToString());
+         }
+         if (!batch) {
+            break;
+         }
+         if (batch->num_rows() == 0) {
+            continue;
+         }
+         fBatches.emplace_back(fNextEntry, batch);
+         fEntryRanges.emplace_back(fNextEntry, fNextEntry + batch->num_rows());
+         fNextEntry += batch->num_rows();
+      }
+   }
    auto entryRanges(std::move(fEntryRanges)); // empty fEntryRanges
    return entryRanges;
 }
 
 std::string RArrowDS::GetTypeName(std::string_view colName) const
 {
-   auto field = fTable->schema()->GetFieldByName(std::string(colName));
+   auto field = fSchema->GetFieldByName(std::string(colName));
    if (!field) {
       std::string msg = "The dataset does not have column ";
       msg += colName;
@@ -492,15 +602,51 @@ std::string RArrowDS::GetTypeName(std::string_view colName) const
 
 bool RArrowDS::HasColumn(std::string_view colName) const
 {
-   auto field = fTable->schema()->GetFieldByName(std::string(colName));
+   auto field = fSchema->GetFieldByName(std::string(colName));
    if (!field) {
       return false;
    }
    return true;
 }
 
+/// Return the index in fBatches of the batch which contains the given entry.
+size_t RArrowDS::FindBatch(ULong64_t entry) const
+{
+   auto it = std::upper_bound(fBatches.begin(), fBatches.end(), entry,
+                              [](ULong64_t e, const auto &batch) { return e < batch.first; });
+   if (it == fBatches.begin()) {
+      throw std::runtime_error("RArrowDS: entry " + std::to_string(entry) + " is not in the current record batches");
+   }
+   return std::distance(fBatches.begin(), it) - 1;
+}
+
+/// Point the value getters of the slot to the columns of a batch.
+void RArrowDS::SetBatch(unsigned int slot, size_t batchIdx)
+{
+   fBatchPerSlot[slot] = batchIdx;
+   auto &batch = fBatches[batchIdx].second;
+   for (auto link : fGetterIndex) {
+      fBatchValueGetters[link.second]->SetArray(slot, batch->column(link.first));
+   }
+}
+
 bool RArrowDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
+   if (fBatchReader) {
+      // In single-thread runs, one task goes through the ranges of all the batches
+      auto batchIdx = fBatchPerSlot[slot];
+      if (batchIdx >= fBatches.size() || entry < fBatches[batchIdx].first ||
+          entry >= fBatches[batchIdx].first + fBatches[batchIdx].second->num_rows()) {
+         batchIdx = FindBatch(entry);
+         SetBatch(slot, batchIdx);
+      }
+      const auto batchEntry = entry - fBatches[batchIdx].first;
+      for (auto link : fGetterIndex) {
+         fBatchValueGetters[link.second]->SetEntry(slot, batchEntry);
+      }
+      return true;
+   }
+
    for (auto link : fGetterIndex) {
       auto &getter = fValueGetters[link.second];
       getter->SetEntry(slot, entry);
@@ -510,12 +656,28 @@ bool RArrowDS::SetEntry(unsigned int slot, ULong64_t entry)
 
 void RArrowDS::InitSlot(unsigned int slot, ULong64_t entry)
 {
+   if (fBatchReader) {
+      // The batch is looked up by SetEntry: single-thread runs always start at entry 0
+      fBatchPerSlot[slot] = fBatches.size();
+      return;
+   }
    for (auto link : fGetterIndex) {
       auto &getter = fValueGetters[link.second];
       getter->UncachedSlotLookup(slot, entry);
    }
 }
 
+void RArrowDS::FinalizeSlot(unsigned int slot)
+{
+   if (fBatchReader) {
+      // Do not keep a processed batch alive after the next call to GetEntryRanges
+      for (auto &getter : fBatchValueGetters) {
+         getter->SetArray(slot, nullptr);
+      }
+      fBatchPerSlot[slot] = fBatches.size();
+   }
+}
+
 void splitInEqualRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges, int nRecords, unsigned int nSlots)
 {
    ranges.clear();
@@ -558,6 +720,15 @@ void RArrowDS::SetNSlots(unsigned int nSlots)
    // We dump all the previous getters structures and we rebuild it.
    auto nColumns = fGetterIndex.size();
 
+   if (fBatchReader) {
+      fBatchPerSlot.assign(nSlots, 0);
+      fBatchValueGetters.clear();
+      for (size_t ci = 0; ci != nColumns; ++ci) {
+         fBatchValueGetters.emplace_back(std::make_unique<ROOT::Internal::RDF::TBatchValueGetter>(nSlots));
+      }
+      return;
+   }
+
    fValueGetters.clear();
    for (size_t ci = 0; ci != nColumns; ++ci) {
       auto chunkedArray = getData(fTable->column(fGetterIndex[ci].first));
@@ -579,19 +750,35 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
       throw std::runtime_error("No column found at index " + std::to_string(column));
    };
 
-   const int columnIdx = fTable->schema()->GetFieldIndex(std::string(colName));
+   const int columnIdx = fSchema->GetFieldIndex(std::string(colName));
    const int getterIdx = findGetterIndex(columnIdx);
    assert(getterIdx != -1);
+   if (fBatchReader) {
+      assert((unsigned int)getterIdx < fBatchValueGetters.size());
+      return fBatchValueGetters[getterIdx]->SlotPtrs();
+   }
    assert((unsigned int)getterIdx < fValueGetters.size());
    return fValueGetters[getterIdx]->SlotPtrs();
 }
 
 void RArrowDS::Initialize()
 {
+   if (fBatchReader) {
+      if (fNextEntry > 0) {
+         throw std::runtime_error("RArrowDS: the record batch reader has already been consumed by a previous event "
+                                  "loop, and cannot be read again.");
+      }
+      return;
+   }
    auto nRecords = getNRecords(fTable, fColumnNames);
    splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
 }
 
+void RArrowDS::Finalize()
+{
+   fBatches.clear();
+}
+
 std::string RArrowDS::GetLabel()
 {
    return "ArrowDS";
@@ -609,6 +796,21 @@ RDataFrame FromArrow(std::shared_ptr<arrow::Table> table, std::vector<std::strin
    return tdf;
 }
 
+/// \brief Factory method to create a Apache Arrow RDataFrame which streams record batches.
+///
+/// Creates a RDataFrame which reads its entries from the record batches of an arrow::RecordBatchReader,
+/// e.g. an IPC file or stream reader or the reader of a Parquet dataset scan. The batches are read on demand
+/// and processed in parallel if implicit multi-threading is enabled. The reader is consumed by the first
+/// event loop.
+/// \param[in] reader the reader of the record batches to process.
+/// \param[in] columnNames the name of the columns to use
+/// In case columnNames is empty, we use all the columns found in the schema of the reader
+RDataFrame FromArrow(std::shared_ptr<arrow::RecordBatchReader> reader, std::vector<std::string> const &columnNames)
+{
+   ROOT::RDataFrame tdf(std::make_unique<RArrowDS>(reader, columnNames));
+   return tdf;
+}
+
 } // namespace RDF
 
 } // namespace ROOT
@@ -71,6 +71,8 @@ double-quote characters must be represented by a pair of double-quote characters
 The current implementation of RCsvDS reads the entire CSV file content into memory before
 RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
 important to check both how much memory is available and the size of the CSV file.
+The file is read in large blocks and, when implicit multi-threading is enabled, the lines of each chunk are
+parsed in parallel.
 
 RCsvDS can handle empty cells and also allows the usage of the special keywords "NaN" and "nan" to
 indicate `nan` values. If the column is of type double, these cells are stored internally as `nan`.
@@ -83,10 +85,55 @@ Empty cells and explicit `nan`-s inside columns of type Long64_t/bool are stored
 #include <ROOT/RRawFile.hxx>
 #include <TError.h>
 
+#include <TROOT.h> // IsImplicitMTEnabled
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <memory>
-#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+
+namespace {
+/// Number of lines below which the lines of a chunk are parsed sequentially
+constexpr std::size_t kMinLinesForParallelParsing = 10000;
+
+/// Convert a field to a number like std::stod/std::stoll, without allocating a std::string.
+template <typename T>
+T ToNumber(std::string_view field)
+{
+   // strtod/strtoll need a null-terminated string: fields are short, copy them on the stack
+   char buf[64];
+   std::string longField;
+   const char *str = buf;
+   if (field.size() < sizeof(buf)) {
+      std::memcpy(buf, field.data(), field.size());
+      buf[field.size()] = '\0';
+   } else {
+      longField = std::string(field);
+      str = longField.c_str();
+   }
+
+   char *end = nullptr;
+   errno = 0;
+   T value;
+   if constexpr (std::is_same<T, double>::value)
+      value = std::strtod(str, &end);
+   else
+      value = std::strtoll(str, &end, 10);
+   if (end == str)
+      throw std::invalid_argument("RCsvDS: cannot convert \"" + std::string(field) + "\" to a number.");
+   if (errno == ERANGE && !std::is_same<T, double>::value)
+      throw std::out_of_range("RCsvDS: \"" + std::string(field) + "\" is out of the range of Long64_t.");
+   return value;
+}
+} // anonymous namespace
 
 namespace ROOT {
 
@@ -117,46 +164,65 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
+/// Convert one field of a line to the type of its column and store it in the column values of the given entry.
+/// Numbers are converted directly from the text of the line, without intermediate strings.
+void RCsvDS::FillValue(std::string_view field, std::size_t entry, std::size_t col, ColType_t colType,
+                       std::vector<char> &hasEmpty)
 {
-   auto i = 0U;
+   const bool isNaN = field.empty() || field == "nan" || field == "NaN";
 
-   auto columns = ParseColumns(line);
+   switch (colType) {
+   case 'D': {
+      fDoubleColumns[col][entry] = isNaN ? std::numeric_limits<double>::quiet_NaN() : ToNumber<double>(field);
+      break;
+   }
+   case 'L': {
+      if (isNaN)
+         hasEmpty[col] = true;
+      fLong64Columns[col][entry] = isNaN ? 0 : ToNumber<Long64_t>(field);
+      break;
+   }
+   case 'O': {
+      if (isNaN)
+         hasEmpty[col] = true;
+      const auto first = field.find_first_not_of(" \t");
+      fBoolColumns[col][entry] = !isNaN && first != std::string_view::npos && field.substr(first, 4) == "true";
+      break;
+   }
+   case 'T': {
+      fStringColumns[col][entry] = isNaN ? "nan" : std::string(field);
+      break;
+   }
+   }
+}
 
-   for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
+/// Parse one line into the column values of the given entry. Missing trailing fields are treated as empty cells.
+void RCsvDS::FillRecord(std::string_view line, std::size_t entry, const std::vector<ColType_t> &colTypes,
+                        std::vector<char> &hasEmpty)
+{
+   const auto nColumns = colTypes.size();
+
+   if (line.find('"') != std::string_view::npos) {
+      // quoted fields can contain delimiters and escaped quotes: use the general parser
+      const auto columns = ParseColumns(std::string(line));
+      for (auto i = 0u; i < nColumns; ++i)
+         FillValue(i < columns.size() ? std::string_view(columns[i]) : std::string_view(), entry, i, colTypes[i],
+                   hasEmpty);
+      return;
+   }
 
-      switch (colType) {
-      case 'D': {
-         record.emplace_back(new double((col != "nan") ? std::stod(col) : std::numeric_limits<double>::quiet_NaN()));
-         break;
-      }
-      case 'L': {
-         if (col != "nan") {
-            record.emplace_back(new Long64_t(std::stoll(col)));
-         } else {
-            fColContainingEmpty.insert(fHeaders[i]);
-            record.emplace_back(new Long64_t(0));
-         }
-         break;
-      }
-      case 'O': {
-         auto b = new bool();
-         record.emplace_back(b);
-         if (col != "nan") {
-            std::istringstream(col) >> std::boolalpha >> *b;
-         } else {
-            fColContainingEmpty.insert(fHeaders[i]);
-            *b = false;
-         }
-         break;
-      }
-      case 'T': {
-         record.emplace_back(new std::string(col));
-         break;
-      }
+   // no quotes: fields are delimited by the delimiter characters, found with (vectorised) memchr
+   std::size_t pos = 0;
+   for (auto i = 0u; i < nColumns; ++i) {
+      if (pos > line.size()) {
+         FillValue(std::string_view(), entry, i, colTypes[i], hasEmpty);
+         continue;
       }
-      ++i;
+      const auto *delim =
+         static_cast<const char *>(std::memchr(line.data() + pos, fDelimiter, line.size() - pos));
+      const std::size_t fieldEnd = delim ? delim - line.data() : line.size();
+      FillValue(line.substr(pos, fieldEnd - pos), entry, i, colTypes[i], hasEmpty);
+      pos = fieldEnd + 1;
    }
 }
 
@@ -185,16 +251,10 @@ std::vector<void *> RCsvDS::GetColumnReadersImpl(std::string_view colName, const
    const auto index = std::distance(colNames.begin(), std::find(colNames.begin(), colNames.end(), colName));
    std::vector<void *> ret(fNSlots);
    for (auto slot : ROOT::TSeqU(fNSlots)) {
+      // the addresses of doubles, integers and strings are set by SetEntry to the values of the current entry
       auto &val = fColAddresses[index][slot];
-      if (ti == typeid(double)) {
-         val = &fDoubleEvtValues[index][slot];
-      } else if (ti == typeid(Long64_t)) {
-         val = &fLong64EvtValues[index][slot];
-      } else if (ti == typeid(std::string)) {
-         val = &fStringEvtValues[index][slot];
-      } else {
+      if (ti == typeid(bool))
          val = &fBoolEvtValues[index][slot];
-      }
       ret[slot] = &val;
    }
    return ret;
@@ -367,6 +427,7 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
 
       // rewind
       fCsvFile->Seek(fDataPos);
+      fReadPos = fDataPos;
    } else {
       std::string msg = "Could not infer column types of CSV file ";
       msg += fileName;
@@ -376,31 +437,69 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
 
 void RCsvDS::FreeRecords()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'D': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'L': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'O': {
-            delete static_cast<bool *>(p);
+   fBuffer.clear();
+   for (auto &c : fDoubleColumns)
+      c.clear();
+   for (auto &c : fLong64Columns)
+      c.clear();
+   for (auto &c : fStringColumns)
+      c.clear();
+   for (auto &c : fBoolColumns)
+      c.clear();
+}
+
+/// Load the next lines of the file into fBuffer, in large blocks, and return the offsets of the beginning and end of
+/// each non-empty line, without line breaks. At most fLinesChunkSize lines are returned, all lines if it is -1.
+std::vector<std::pair<std::size_t, std::size_t>> RCsvDS::ReadLines()
+{
+   constexpr std::size_t kMinBlockSize = 1024 * 1024;
+   constexpr std::size_t kMaxBlockSize = 64 * 1024 * 1024;
+
+   std::vector<std::pair<std::size_t, std::size_t>> lines;
+   const auto maxLines = fLinesChunkSize == -1LL ? std::numeric_limits<std::size_t>::max()
+                                                 : static_cast<std::size_t>(fLinesChunkSize);
+   std::size_t blockSize = kMinBlockSize;
+   std::size_t lineStart = 0; // in fBuffer
+   std::size_t scanPos = 0;   // in fBuffer, where to look for the next line break
+   bool eof = false;
+
+   auto addLine = [&](std::size_t lineEnd) {
+      auto end = lineEnd;
+      if (end > lineStart && fBuffer[end - 1] == '\r')
+         --end; // Windows line break
+      if (end > lineStart) // skip empty lines
+         lines.emplace_back(lineStart, end);
+      lineStart = lineEnd + 1;
+   };
+
+   while (lines.size() < maxLines) {
+      if (scanPos == fBuffer.size()) {
+         if (eof)
             break;
-         }
-         case 'T': {
-            delete static_cast<std::string *>(p);
+         const auto oldSize = fBuffer.size();
+         fBuffer.resize(oldSize + blockSize);
+         const auto nRead = fCsvFile->ReadAt(&fBuffer[oldSize], blockSize, fReadPos + oldSize);
+         fBuffer.resize(oldSize + nRead);
+         blockSize = std::min(2 * blockSize, kMaxBlockSize);
+         if (nRead == 0) {
+            eof = true;
+            if (lineStart < fBuffer.size())
+               addLine(fBuffer.size()); // last line without line break
             break;
          }
-         }
       }
+      const auto *nl = static_cast<const char *>(std::memchr(&fBuffer[scanPos], '\n', fBuffer.size() - scanPos));
+      if (!nl) {
+         scanPos = fBuffer.size();
+         continue;
+      }
+      addLine(nl - fBuffer.data());
+      scanPos = lineStart;
    }
-   fRecords.clear();
+
+   // the lines that were read past the chunk are loaded again by the next call
+   fReadPos += std::min(lineStart, fBuffer.size());
+   return lines;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -412,7 +511,7 @@ RCsvDS::~RCsvDS()
 
 void RCsvDS::Finalize()
 {
-   fCsvFile->Seek(fDataPos);
+   fReadPos = fDataPos;
    fProcessedLines = 0ULL;
    fEntryRangesRequested = 0ULL;
    FreeRecords();
@@ -426,15 +525,58 @@ const std::vector<std::string> &RCsvDS::GetColumnNames() const
 std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
 {
    // Read records and store them in memory
-   auto linesToRead = fLinesChunkSize;
    FreeRecords();
+   const auto lines = ReadLines();
+   const auto nLines = lines.size();
+
+   const std::vector<ColType_t> colTypes(fColTypesList.begin(), fColTypesList.end());
+   const auto nColumns = colTypes.size();
+   for (auto i = 0u; i < nColumns; ++i) {
+      switch (colTypes[i]) {
+      case 'D': fDoubleColumns[i].resize(nLines); break;
+      case 'L': fLong64Columns[i].resize(nLines); break;
+      case 'O': fBoolColumns[i].resize(nLines); break;
+      case 'T': fStringColumns[i].resize(nLines); break;
+      }
+   }
 
-   std::string line;
-   while ((-1LL == fLinesChunkSize || 0 != linesToRead) && fCsvFile->Readln(line)) {
-      if (line.empty()) continue; // skip empty lines
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
-      --linesToRead;
+   // Parse the lines in contiguous blocks, concurrently if IMT is enabled: each block writes its own entries of the
+   // column values and records the columns with empty cells in its own flags
+   unsigned int nBlocks = 1u;
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> pool;
+   if (ROOT::IsImplicitMTEnabled() && nLines >= kMinLinesForParallelParsing) {
+      pool = std::make_unique<ROOT::TThreadExecutor>();
+      nBlocks = std::min<std::size_t>(4u * pool->GetPoolSize(), nLines / (kMinLinesForParallelParsing / 10));
+   }
+#endif
+   std::vector<std::vector<char>> hasEmpty(nBlocks, std::vector<char>(nColumns, false));
+   auto parseBlock = [&](unsigned int block) {
+      const auto begin = nLines * block / nBlocks;
+      const auto end = nLines * (block + 1) / nBlocks;
+      for (auto entry = begin; entry < end; ++entry) {
+         const auto &line = lines[entry];
+         FillRecord(std::string_view(fBuffer.data() + line.first, line.second - line.first), entry, colTypes,
+                    hasEmpty[block]);
+      }
+   };
+#ifdef R__USE_IMT
+   if (pool) {
+      pool->Foreach(parseBlock, ROOT::TSeqU(nBlocks));
+   } else
+#endif
+   {
+      parseBlock(0u);
+   }
+   // the text of the lines is not needed anymore
+   fBuffer.clear();
+   fBuffer.shrink_to_fit();
+
+   for (const auto &flags : hasEmpty) {
+      for (auto i = 0u; i < nColumns; ++i) {
+         if (flags[i])
+            fColContainingEmpty.insert(fHeaders[i]);
+      }
    }
 
    if (!fColContainingEmpty.empty()) {
@@ -451,14 +593,14 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
 
    if (gDebug > 0) {
       if (fLinesChunkSize == -1LL) {
-         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %zu lines read", fRecords.size());
+         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %zu lines read", nLines);
       } else {
-         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read", fLinesChunkSize, fRecords.size());
+         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read", fLinesChunkSize, nLines);
       }
    }
 
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
+   const auto nRecords = nLines;
    if (0 == nRecords)
       return entryRanges;
 
@@ -509,22 +651,21 @@ bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
    const auto recordPos = entry - offset;
    int colIndex = 0;
    for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[recordPos][colIndex];
       switch (colType) {
       case 'D': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
+         fColAddresses[colIndex][slot] = &fDoubleColumns[colIndex][recordPos];
          break;
       }
       case 'L': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
+         fColAddresses[colIndex][slot] = &fLong64Columns[colIndex][recordPos];
          break;
       }
       case 'O': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
+         fBoolEvtValues[colIndex][slot] = fBoolColumns[colIndex][recordPos];
          break;
       }
       case 'T': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
+         fColAddresses[colIndex][slot] = &fStringColumns[colIndex][recordPos];
          break;
       }
       }
@@ -543,10 +684,11 @@ void RCsvDS::SetNSlots(unsigned int nSlots)
    // Initialize the entire set of addresses
    fColAddresses.resize(nColumns, std::vector<void *>(fNSlots, nullptr));
 
-   // Initialize the per event data holders
-   fDoubleEvtValues.resize(nColumns, std::vector<double>(fNSlots));
-   fLong64EvtValues.resize(nColumns, std::vector<Long64_t>(fNSlots));
-   fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
+   // Initialize the column values and the per event data holders of booleans, the only values that are copied
+   fDoubleColumns.resize(nColumns);
+   fLong64Columns.resize(nColumns);
+   fStringColumns.resize(nColumns);
+   fBoolColumns.resize(nColumns);
    fBoolEvtValues.resize(nColumns, std::deque<bool>(fNSlots));
 }
 
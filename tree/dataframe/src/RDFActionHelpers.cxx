@@ -10,6 +10,16 @@
 
 #include "ROOT/RDF/ActionHelpers.hxx"
 #include "ROOT/RDF/Utils.hxx" // CacheLineStep
+#include "RConfigure.h" // R__USE_IMT
+#include "TArrayD.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TROOT.h" // IsImplicitMTEnabled
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif // R__USE_IMT
+
+#include <atomic>
 
 namespace ROOT {
 namespace Internal {
@@ -38,6 +48,15 @@ ULong64_t &CountHelper::PartialUpdate(unsigned int slot)
    return fCounts[slot];
 }
 
+bool CountHelper::SetResultFromMetadata(RLoopManager &lm, const std::vector<std::string> &, TypeList<>)
+{
+   const auto nEntries = lm.GetNEntriesFromMetadata();
+   if (!nEntries)
+      return false;
+   *fResultCount = *nEntries;
+   return true;
+}
+
 void BufferedFillHelper::UpdateMinMax(unsigned int slot, double v)
 {
    auto &thisMin = fMin[slot * CacheLineStep<BufEl_t>()];
@@ -107,6 +126,322 @@ void BufferedFillHelper::Finalize()
    }
 }
 
+bool MergeInParallel(std::size_t n, const std::function<void(std::size_t, std::size_t)> &mergeInto)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled())
+      return false;
+
+   ROOT::TThreadExecutor pool;
+   std::vector<std::size_t> targets;
+   for (std::size_t stride = 1; stride < n; stride *= 2) {
+      targets.clear();
+      for (std::size_t to = 0; to + stride < n; to += 2 * stride)
+         targets.push_back(to);
+      pool.Foreach([&](std::size_t to) { mergeInto(to, to + stride); }, targets);
+   }
+   return true;
+#else
+   (void)n;
+   (void)mergeInto;
+   return false;
+#endif // R__USE_IMT
+}
+
+namespace {
+/// Add v to x with a relaxed atomic operation, x being concurrently updated by other threads the same way
+void AtomicAdd(double &x, double v)
+{
+#if __cpp_lib_atomic_ref >= 201806L
+   std::atomic_ref<double>(x).fetch_add(v, std::memory_order_relaxed);
+#else
+   static_assert(sizeof(std::atomic<double>) == sizeof(double) && std::atomic<double>::is_always_lock_free,
+                 "atomic bin updates require lock-free atomic doubles");
+   auto &ax = reinterpret_cast<std::atomic<double> &>(x);
+   double expected = ax.load(std::memory_order_relaxed);
+   while (!ax.compare_exchange_weak(expected, expected + v, std::memory_order_relaxed))
+      ;
+#endif
+}
+} // anonymous namespace
+
+RSharedHistoFiller::RSharedHistoFiller(TH1 &h, unsigned int nSlots, std::size_t nColumns)
+   : fHist(&h), fDim(h.GetDimension()), fIsWeighted(nColumns == std::size_t(fDim) + 1),
+     fStatOverflows(h.GetStatOverflowsBehaviour()), fSlotStats(nSlots)
+{
+   auto *array = dynamic_cast<TArrayD *>(&h);
+   if (array == nullptr || fDim > 3)
+      throw std::invalid_argument(std::string("The shared atomic fill strategy does not support histograms of type ") +
+                                  h.IsA()->GetName() + ".");
+   if (nColumns != std::size_t(fDim) && !fIsWeighted)
+      throw std::invalid_argument("The shared atomic fill strategy requires one column per dimension of the "
+                                  "histogram, plus optionally one column of weights.");
+   // TH1::Fill switches to storing the sums of squares of weights at the first weight different from 1, which
+   // cannot be done concurrently, hence do it beforehand.
+   if (fIsWeighted && h.GetSumw2N() == 0 && !h.TestBit(TH1::kIsNotW))
+      h.Sumw2();
+   fBins = array->GetArray();
+   fSumw2 = h.GetSumw2N() > 0 ? h.GetSumw2()->GetArray() : nullptr;
+}
+
+void RSharedHistoFiller::Fill(unsigned int slot, const double *values)
+{
+   const double w = fIsWeighted ? values[fDim] : 1.;
+   int bins[3] = {0, 0, 0};
+   bool isInRange = true;
+   TAxis *axes[3] = {fHist->GetXaxis(), fHist->GetYaxis(), fHist->GetZaxis()};
+   for (int d = 0; d < fDim; ++d) {
+      bins[d] = axes[d]->FindFixBin(values[d]);
+      isInRange &= bins[d] > 0 && bins[d] <= axes[d]->GetNbins();
+   }
+   const auto bin = fHist->GetBin(bins[0], bins[1], bins[2]);
+   AtomicAdd(fBins[bin], w);
+   if (fSumw2)
+      AtomicAdd(fSumw2[bin], w * w);
+
+   auto &slotStats = fSlotStats[slot];
+   ++slotStats.fEntries;
+   if (!isInRange && !fStatOverflows)
+      return;
+   // same order as TH1::GetStats, TH2::GetStats and TH3::GetStats
+   auto *stats = slotStats.fStats;
+   const double x = values[0];
+   stats[0] += w;
+   stats[1] += w * w;
+   stats[2] += w * x;
+   stats[3] += w * x * x;
+   if (fDim > 1) {
+      const double y = values[1];
+      stats[4] += w * y;
+      stats[5] += w * y * y;
+      stats[6] += w * x * y;
+      if (fDim > 2) {
+         const double z = values[2];
+         stats[7] += w * z;
+         stats[8] += w * z * z;
+         stats[9] += w * x * z;
+         stats[10] += w * y * z;
+      }
+   }
+}
+
+void RSharedHistoFiller::Finalize()
+{
+   double stats[TH1::kNstat] = {};
+   fHist->GetStats(stats);
+   ULong64_t entries = 0;
+   for (const auto &slotStats : fSlotStats) {
+      for (int i = 0; i < TH1::kNstat; ++i)
+         stats[i] += slotStats.fStats[i];
+      entries += slotStats.fEntries;
+   }
+   const auto initialEntries = fHist->GetEntries();
+   fHist->PutStats(stats);
+   fHist->SetEntries(initialEntries + entries);
+}
+
+RVariedCounter::RVariedCounter(std::vector<CountHelper> &helpers, unsigned int nSlots) : fHelpers(helpers)
+{
+   for (auto i = 0u; i < nSlots; ++i)
+      fCounts.emplace_back(new std::vector<ULong64_t>(helpers.size(), 0ull));
+}
+
+void RVariedCounter::FinalizeTask(unsigned int slot)
+{
+   auto &counts = *fCounts[slot];
+   for (std::size_t v = 0; v < fHelpers.size(); ++v) {
+      fHelpers[v].PartialUpdate(slot) += counts[v];
+      counts[v] = 0;
+   }
+}
+
+std::unique_ptr<RVariedCounter> CountHelper::MakeVariationsFiller(std::vector<CountHelper> &helpers, TypeList<>)
+{
+   return std::make_unique<RVariedCounter>(helpers, helpers[0].fCounts.size());
+}
+
+namespace {
+bool HaveSameBinning(const TAxis &a1, const TAxis &a2)
+{
+   if (a1.GetNbins() != a2.GetNbins() || a1.GetXmin() != a2.GetXmin() || a1.GetXmax() != a2.GetXmax())
+      return false;
+   const auto &bins1 = *a1.GetXbins();
+   const auto &bins2 = *a2.GetXbins();
+   return bins1.GetSize() == bins2.GetSize() &&
+          std::equal(bins1.GetArray(), bins1.GetArray() + bins1.GetSize(), bins2.GetArray());
+}
+
+/// Compute the bins along one axis of the values x[0..n), with the same result as TAxis::FindFixBin.
+/// Bins are accumulated into the global bins with the given stride and inRange is cleared for under/overflows.
+void AddAxisBins(const TAxis &axis, const double *x, std::size_t n, int stride, int *bins, char *inRange)
+{
+   const int nbins = axis.GetNbins();
+   if (axis.IsVariableBinSize()) {
+      for (std::size_t i = 0; i < n; ++i) {
+         const int b = axis.FindFixBin(x[i]);
+         bins[i] += stride * b;
+         inRange[i] &= b > 0 && b <= nbins;
+      }
+      return;
+   }
+   // branch-free version of TAxis::FindFixBin for fixed bin widths, so that the loop vectorises
+   const double xmin = axis.GetXmin();
+   const double xmax = axis.GetXmax();
+   for (std::size_t i = 0; i < n; ++i) {
+      const bool isUnder = x[i] < xmin;
+      const bool isOver = !(x[i] < xmax); // also true for NaN
+      const double xc = (isUnder || isOver) ? xmin : x[i];
+      const int inner = 1 + int(nbins * (xc - xmin) / (xmax - xmin));
+      const int b = isUnder ? 0 : (isOver ? nbins + 1 : inner);
+      bins[i] += stride * b;
+      inRange[i] &= !(isUnder || isOver);
+   }
+}
+} // anonymous namespace
+
+std::unique_ptr<RVariedHistoFiller>
+RVariedHistoFiller::Make(std::vector<std::vector<TH1 *>> &&hists, std::size_t nColumns)
+{
+   const TH1 &ref = *hists[0][0];
+   const std::size_t dim = ref.GetDimension();
+   if (nColumns != dim && nColumns != dim + 1)
+      return nullptr;
+   const TAxis *refAxes[3] = {ref.GetXaxis(), ref.GetYaxis(), ref.GetZaxis()};
+   for (const auto &slotHists : hists) {
+      for (const TH1 *h : slotHists) {
+         const TClass *cl = h->IsA();
+         if (cl != TH1D::Class() && cl != TH2D::Class() && cl != TH3D::Class())
+            return nullptr;
+         if (h->GetBuffer() || h->GetStatOverflowsBehaviour() != ref.GetStatOverflowsBehaviour() ||
+             std::size_t(h->GetDimension()) != dim)
+            return nullptr;
+         const TAxis *axes[3] = {h->GetXaxis(), h->GetYaxis(), h->GetZaxis()};
+         for (std::size_t d = 0; d < dim; ++d) {
+            // TH1::Fill would extend these axes or look up bin labels
+            if (axes[d]->CanExtend() || axes[d]->IsAlphanumeric() || !HaveSameBinning(*axes[d], *refAxes[d]))
+               return nullptr;
+         }
+      }
+   }
+   return std::unique_ptr<RVariedHistoFiller>(new RVariedHistoFiller(std::move(hists), nColumns));
+}
+
+RVariedHistoFiller::RVariedHistoFiller(std::vector<std::vector<TH1 *>> &&hists, std::size_t nColumns)
+   : fHists(std::move(hists)),
+     fDim(fHists[0][0]->GetDimension()),
+     fIsWeighted(nColumns == std::size_t(fDim) + 1),
+     fStatOverflows(fHists[0][0]->GetStatOverflowsBehaviour())
+{
+   const auto nVar = fHists.size();
+   const auto nSlots = fHists[0].size();
+   for (auto slot = 0u; slot < nSlots; ++slot) {
+      auto data = std::make_unique<RSlotData>();
+      data->fStats.assign(TH1::kNstat * nVar, 0.);
+      data->fEntries.assign(nVar, 0ull);
+      data->fInitialStats.assign(TH1::kNstat * nVar, 0.);
+      for (std::size_t v = 0; v < nVar; ++v) {
+         TH1 *h = fHists[v][slot];
+         // TH1::Fill switches to storing the sums of squares of weights at the first weight different from 1, which
+         // is not checked for each value here, hence do it beforehand as RSharedHistoFiller does.
+         if (fIsWeighted && h->GetSumw2N() == 0 && !h->TestBit(TH1::kIsNotW))
+            h->Sumw2();
+         data->fBinContents.emplace_back(dynamic_cast<TArrayD *>(h)->GetArray());
+         data->fSumw2.emplace_back(h->GetSumw2N() > 0 ? h->GetSumw2()->GetArray() : nullptr);
+         double stats[TH1::kNstat] = {};
+         h->GetStats(stats);
+         for (int s = 0; s < TH1::kNstat; ++s)
+            data->fInitialStats[s * nVar + v] = stats[s];
+         data->fInitialEntries.emplace_back(h->GetEntries());
+      }
+      fSlots.emplace_back(std::move(data));
+   }
+}
+
+void RVariedHistoFiller::Fill(unsigned int slot, const unsigned int *varIdx, std::size_t n)
+{
+   auto &data = *fSlots[slot];
+   const auto nVar = fHists.size();
+   data.fBins.assign(n, 0);
+   data.fInRange.assign(n, 1);
+   int *bins = data.fBins.data();
+   char *inRange = data.fInRange.data();
+
+   const TH1 &ref = *fHists[0][0];
+   const TAxis *axes[3] = {ref.GetXaxis(), ref.GetYaxis(), ref.GetZaxis()};
+   int stride = 1;
+   for (int d = 0; d < fDim; ++d) {
+      AddAxisBins(*axes[d], data.fValues[d].data(), n, stride, bins, inRange);
+      stride *= axes[d]->GetNbins() + 2;
+   }
+
+   const double *w = fIsWeighted ? data.fValues[fDim].data() : nullptr;
+   for (std::size_t i = 0; i < n; ++i) {
+      const auto v = varIdx[i];
+      const double wi = w ? w[i] : 1.;
+      data.fBinContents[v][bins[i]] += wi;
+      if (data.fSumw2[v])
+         data.fSumw2[v][bins[i]] += wi * wi;
+      ++data.fEntries[v];
+   }
+
+   // Statistics in the same order as TH1::GetStats, TH2::GetStats and TH3::GetStats, one contiguous array per
+   // statistic. Values outside of the axes contribute with a null weight unless they are used in the statistics.
+   double *stats = data.fStats.data();
+   const double *x = data.fValues[0].data();
+   const double *y = fDim > 1 ? data.fValues[1].data() : nullptr;
+   const double *z = fDim > 2 ? data.fValues[2].data() : nullptr;
+   const auto statsOf = [&](auto &&accumulate) {
+      if (n == nVar) {
+         // all variations passed their filters, varIdx is the identity
+         for (std::size_t i = 0; i < n; ++i) {
+            const double wi = (fStatOverflows || inRange[i]) ? (w ? w[i] : 1.) : 0.;
+            accumulate(i, i, wi);
+         }
+      } else {
+         for (std::size_t i = 0; i < n; ++i) {
+            const double wi = (fStatOverflows || inRange[i]) ? (w ? w[i] : 1.) : 0.;
+            accumulate(varIdx[i], i, wi);
+         }
+      }
+   };
+   statsOf([&](std::size_t v, std::size_t i, double wi) {
+      stats[0 * nVar + v] += wi;
+      stats[1 * nVar + v] += wi * wi;
+      stats[2 * nVar + v] += wi * x[i];
+      stats[3 * nVar + v] += wi * x[i] * x[i];
+   });
+   if (fDim > 1) {
+      statsOf([&](std::size_t v, std::size_t i, double wi) {
+         stats[4 * nVar + v] += wi * y[i];
+         stats[5 * nVar + v] += wi * y[i] * y[i];
+         stats[6 * nVar + v] += wi * x[i] * y[i];
+      });
+   }
+   if (fDim > 2) {
+      statsOf([&](std::size_t v, std::size_t i, double wi) {
+         stats[7 * nVar + v] += wi * z[i];
+         stats[8 * nVar + v] += wi * z[i] * z[i];
+         stats[9 * nVar + v] += wi * x[i] * z[i];
+         stats[10 * nVar + v] += wi * y[i] * z[i];
+      });
+   }
+}
+
+/// Write the statistics accumulated so far to the histograms of this slot.
+void RVariedHistoFiller::FinalizeTask(unsigned int slot)
+{
+   auto &data = *fSlots[slot];
+   const auto nVar = fHists.size();
+   for (std::size_t v = 0; v < nVar; ++v) {
+      double stats[TH1::kNstat] = {};
+      for (int s = 0; s < TH1::kNstat; ++s)
+         stats[s] = data.fInitialStats[s * nVar + v] + data.fStats[s * nVar + v];
+      TH1 *h = fHists[v][slot];
+      h->PutStats(stats);
+      h->SetEntries(data.fInitialEntries[v] + data.fEntries[v]);
+   }
+}
+
 MeanHelper::MeanHelper(const std::shared_ptr<double> &meanVPtr, const unsigned int nSlots)
    : fResultMean(meanVPtr), fCounts(nSlots, 0), fSums(nSlots, 0), fPartialMeans(nSlots), fCompensations(nSlots)
 {
@@ -253,6 +253,18 @@ std::string_view RColumnRegister::ResolveAlias(std::string_view alias) const
    return alias; // not an alias, i.e. already resolved
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// \brief Return a description of the values of a column for the keys of a result cache.
+/// Dataset columns are described by their name, Defines by their cache key. The description is empty if the values
+/// cannot be described, e.g. if they are computed by a C++ callable. See RLoopManager::EnableResultCache().
+std::string RColumnRegister::GetCacheKey(std::string_view colName) const
+{
+   const auto name = ResolveAlias(colName);
+   if (const auto *define = GetDefine(name))
+      return define->GetCacheKey();
+   return "column:" + std::string(name);
+}
+
 /// Return a RDefineReader or a RVariationReader, or nullptr if not available.
 /// If requestedType does not match the actual type of the Define or Variation, an exception is thrown.
 RDFDetail::RColumnReaderBase *RColumnRegister::GetReader(unsigned int slot, const std::string &colName,
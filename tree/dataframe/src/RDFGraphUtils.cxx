@@ -161,10 +161,23 @@ std::string GraphCreatorHelper::RepresentGraph(RLoopManager *loopManager)
       nodes.emplace_back(action->GetGraph(fVisitedMap));
    for (auto *edge : edges)
       nodes.emplace_back(edge->GetGraph(fVisitedMap));
+   AddProfileTimes(*loopManager);
 
    return FromGraphActionsToDot(std::move(nodes));
 }
 
+void GraphCreatorHelper::AddProfileTimes(const RLoopManager &loopManager)
+{
+   const auto *profiler = loopManager.GetProfiler();
+   if (!profiler)
+      return;
+   for (auto &nodeAndGraphNode : fVisitedMap) {
+      const auto seconds = profiler->GetNodeTime(nodeAndGraphNode.first);
+      if (seconds >= 0.)
+         nodeAndGraphNode.second->AddProfileTime(seconds);
+   }
+}
+
 } // namespace GraphDrawing
 } // namespace RDF
 } // namespace Internal
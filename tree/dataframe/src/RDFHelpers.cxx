@@ -25,6 +25,8 @@
 #include <iostream>
 #include <set>
 #include <cstdio>
+#include <string>
+#include <unordered_map>
 
 // TODO, this function should be part of core libraries
 #include <numeric>
@@ -108,7 +110,30 @@ unsigned int ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
       << " unique computation graphs) completed"
       << (sw.RealTime() > 1e-3 ? " in " + std::to_string(sw.RealTime()) + " seconds." : " in less than 1ms.");
 
-   // Trigger the unique event loops
+   // Computation graphs that read the same dataset share one event loop, which reads each column once for all of
+   // them. The other graphs run their own event loop, concurrently.
+   std::vector<RResultHandle> loopsToRun;
+   std::vector<std::vector<ROOT::Detail::RDF::RLoopManager *>> sharedScanLoops;
+   std::unordered_map<std::string, std::size_t> keyToLoopIdx;
+   for (auto &h : uniqueLoops) {
+      auto key = h.fLoopManager ? h.fLoopManager->GetSharedScanKey() : std::string();
+      if (!key.empty()) {
+         auto it = keyToLoopIdx.find(key);
+         if (it != keyToLoopIdx.end()) {
+            sharedScanLoops[it->second].emplace_back(h.fLoopManager);
+            continue;
+         }
+         keyToLoopIdx.emplace(std::move(key), loopsToRun.size());
+      }
+      loopsToRun.emplace_back(h);
+      sharedScanLoops.emplace_back();
+   }
+   for (std::size_t i = 0; i < loopsToRun.size(); ++i) {
+      if (!sharedScanLoops[i].empty())
+         loopsToRun[i].fLoopManager->SetSharedScanLoops(std::move(sharedScanLoops[i]));
+   }
+
+   // Trigger the event loops
    auto run = [](RResultHandle &h) {
       if (h.fLoopManager)
          h.fLoopManager->Run(/*jit=*/false);
@@ -117,17 +142,17 @@ unsigned int ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
    sw.Start();
 #ifdef R__USE_IMT
    if (ROOT::IsImplicitMTEnabled()) {
-      ROOT::TThreadExecutor{}.Foreach(run, uniqueLoops);
+      ROOT::TThreadExecutor{}.Foreach(run, loopsToRun);
    } else {
 #endif
-      std::for_each(uniqueLoops.begin(), uniqueLoops.end(), run);
+      std::for_each(loopsToRun.begin(), loopsToRun.end(), run);
 #ifdef R__USE_IMT
    }
 #endif
    sw.Stop();
    R__LOG_INFO(ROOT::Detail::RDF::RDFLogChannel())
-      << "Finished RunGraphs run (" << uniqueLoops.size() << " unique computation graphs, " << sw.CpuTime() << "s CPU, "
-      << sw.RealTime() << "s elapsed).";
+      << "Finished RunGraphs run (" << uniqueLoops.size() << " unique computation graphs, " << loopsToRun.size()
+      << " event loops, " << sw.CpuTime() << "s CPU, " << sw.RealTime() << "s elapsed).";
 
    return uniqueLoops.size();
 }
@@ -19,17 +19,21 @@
 #include <ROOT/RDF/RLoopManager.hxx>
 #include <ROOT/RDF/RNodeBase.hxx>
 #include <ROOT/RDF/Utils.hxx>
+#include <ROOT/RLogger.hxx>
 #include <string_view>
 #include <TBranch.h>
 #include <TClass.h>
 #include <TClassEdit.h>
 #include <TDataType.h>
+#include <TEnv.h>
 #include <TError.h>
 #include <TLeaf.h>
+#include <TMD5.h>
 #include <TObjArray.h>
 #include <TPRegexp.h>
 #include <TROOT.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TTree.h>
 #include <TVirtualMutex.h>
 
@@ -47,10 +51,16 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>  // for size_t
+#include <fstream>
 #include <iterator> // for back_insert_iterator
+#include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -299,8 +309,63 @@ BuildFunctionString(const std::string &expr, const ColumnNames_t &vars, const Co
    return ss.str();
 }
 
+/// Return the directory of the persistent cache of jitted expressions, or an empty string if it is disabled.
+/// The directory is set with the `RDataFrame.JitCacheDir` key of the ROOT configuration (.rootrc).
+std::string GetJitCacheDir()
+{
+   TString dir = gEnv->GetValue("RDataFrame.JitCacheDir", "");
+   gSystem->ExpandPathName(dir);
+   return dir.Data();
+}
+
+/// Build the code of a jitted function into a shared library in the persistent cache directory and load it.
+/// The source file is named after `hash`, so that ACLiC compiles it only the first time the expression is seen and
+/// later processes just load the library. Return false if the code could not be compiled, e.g. because it uses
+/// functions or types that are only known to the interpreter: the caller should then declare it to cling as usual.
+bool DeclareFromJitCache(const std::string &cacheDir, const std::string &hash, const std::string &code)
+{
+   if (gSystem->AccessPathName(cacheDir.c_str()) && gSystem->mkdir(cacheDir.c_str(), kTRUE) != 0)
+      return false;
+
+   const auto base = cacheDir + "/rdfjit_" + hash;
+   const auto source = base + ".h";
+   const auto failed = base + ".failed";
+   // a previous process already tried and failed to compile this code
+   if (!gSystem->AccessPathName(failed.c_str()))
+      return false;
+
+   if (gSystem->AccessPathName(source.c_str())) {
+      // write to a file private to this process and rename it, so that concurrent jobs never see a partial source
+      const auto tmp = source + "." + std::to_string(gSystem->GetPid());
+      {
+         std::ofstream out(tmp);
+         out << "#include <ROOT/RVec.hxx>\n#include <ROOT/TypeTraits.hxx>\n#include <TMath.h>\n#include <cmath>\n"
+             << "using namespace std;\n"
+             << code << '\n';
+         if (!out)
+            return false;
+      }
+      if (gSystem->Rename(tmp.c_str(), source.c_str()) != 0) {
+         gSystem->Unlink(tmp.c_str());
+         if (gSystem->AccessPathName(source.c_str()))
+            return false;
+      }
+   }
+
+   R__LOG_DEBUG(10, ROOT::Detail::RDF::RDFLogChannel()) << "Loading jitted code from the cache: " << source;
+   // "k": keep the library for the next processes, "O": build it with optimizations
+   if (!gSystem->CompileMacro(source.c_str(), "kO")) {
+      std::ofstream{failed};
+      return false;
+   }
+   return true;
+}
+
 /// Declare a function to the interpreter in namespace R_rdf, return the name of the jitted function.
 /// If the function is already in GetJittedExprs, return the name for the function that has already been jitted.
+/// If a persistent cache directory is configured (see GetJitCacheDir()), the function is named after a hash of its
+/// code and of the ROOT version and is compiled into a shared library that later processes load instead of jitting
+/// the same code again.
 std::string DeclareFunction(const std::string &expr, const ColumnNames_t &vars, const ColumnNames_t &varTypes)
 {
    R__LOCKGUARD(gROOTMutex);
@@ -315,13 +380,25 @@ std::string DeclareFunction(const std::string &expr, const ColumnNames_t &vars,
    }
 
    // new expression
-   const auto funcBaseName = "func" + std::to_string(exprMap.size());
+   const auto cacheDir = GetJitCacheDir();
+   std::string hash;
+   if (!cacheDir.empty()) {
+      // the column types are part of the function signature, hence of funcCode
+      const std::string key = std::string(gROOT->GetVersion()) + '\n' + funcCode;
+      TMD5 md5;
+      md5.Update(reinterpret_cast<const UChar_t *>(key.data()), key.size());
+      md5.Final();
+      hash = md5.AsString();
+   }
+   const auto funcBaseName = hash.empty() ? "func" + std::to_string(exprMap.size()) : "func_" + hash;
    const auto funcFullName = "R_rdf::" + funcBaseName;
 
    const auto toDeclare = "namespace R_rdf {\nauto " + funcBaseName + funcCode + "\nusing " + funcBaseName +
-                          "_ret_t = typename ROOT::TypeTraits::CallableTraits<decltype(" + funcBaseName +
-                          ")>::ret_type;\n}";
-   ROOT::Internal::RDF::InterpreterDeclare(toDeclare);
+                          "_ret_t = typename ROOT::Internal::VecOps::RVecExprResult<typename "
+                          "ROOT::TypeTraits::CallableTraits<decltype(" +
+                          funcBaseName + ")>::ret_type>::type;\n}";
+   if (hash.empty() || !DeclareFromJitCache(cacheDir, hash, toDeclare))
+      ROOT::Internal::RDF::InterpreterDeclare(toDeclare);
 
    // InterpreterDeclare could throw. If it doesn't, mark the function as already jitted
    exprMap.insert({funcCode, funcFullName});
@@ -361,6 +438,195 @@ ThrowJitBuildActionHelperTypeError(const std::string &actionTypeNameBase, const
    throw std::runtime_error(exceptionText);
 }
 
+/// Remove leading and trailing white space
+std::string_view TrimWhiteSpace(std::string_view s)
+{
+   const auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)); };
+   while (!s.empty() && isSpace(s.front()))
+      s.remove_prefix(1);
+   while (!s.empty() && isSpace(s.back()))
+      s.remove_suffix(1);
+   return s;
+}
+
+/// Remove parentheses that enclose the whole expression, e.g. `((x > 3))` becomes `x > 3`
+std::string_view StripEnclosingParentheses(std::string_view s)
+{
+   s = TrimWhiteSpace(s);
+   while (s.size() >= 2 && s.front() == '(' && s.back() == ')') {
+      int depth = 0;
+      std::size_t i = 0;
+      for (; i < s.size(); ++i) {
+         depth += (s[i] == '(') - (s[i] == ')');
+         if (depth == 0)
+            break;
+      }
+      if (i != s.size() - 1)
+         break; // the first parenthesis closes before the end, as in `(a) && (b)`
+      s = TrimWhiteSpace(s.substr(1, s.size() - 2));
+   }
+   return s;
+}
+
+/// Split the expression into the terms of its top-level `&&` conjunction, descending into parenthesized
+/// conjunctions such as `(a && b) && c`.
+void SplitConjunction(std::string_view expr, std::vector<std::string_view> &terms)
+{
+   expr = StripEnclosingParentheses(expr);
+   int depth = 0;
+   std::size_t termStart = 0;
+   std::vector<std::string_view> subTerms;
+   for (std::size_t i = 0; i < expr.size(); ++i) {
+      depth += (expr[i] == '(') - (expr[i] == ')');
+      if (depth == 0 && expr.compare(i, 2, "&&") == 0) {
+         subTerms.emplace_back(expr.substr(termStart, i - termStart));
+         termStart = i + 2;
+         ++i;
+      }
+   }
+   subTerms.emplace_back(expr.substr(termStart));
+   if (subTerms.size() == 1) {
+      terms.emplace_back(expr);
+      return;
+   }
+   for (auto t : subTerms)
+      SplitConjunction(t, terms);
+}
+
+bool IsColumnNameToken(std::string_view s)
+{
+   if (s.empty() || !(std::isalpha(static_cast<unsigned char>(s[0])) || s[0] == '_'))
+      return false;
+   for (auto c : s) {
+      if (!(std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.'))
+         return false;
+   }
+   return s != "true" && s != "false";
+}
+
+/// Parse a decimal literal, optionally signed and with a `float` suffix. The value is the one that the compiler uses
+/// in the comparison. Hexadecimal, unsigned and `long` literals are refused because of the conversions they can
+/// trigger, as well as integers too large to be exactly represented as a double.
+bool ParseNumberToken(std::string_view s, double &value)
+{
+   const bool isFloat = !s.empty() && (s.back() == 'f' || s.back() == 'F');
+   if (isFloat)
+      s.remove_suffix(1);
+   if (s.empty())
+      return false;
+   for (auto c : s) {
+      if (!(std::isdigit(static_cast<unsigned char>(c)) || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-'))
+         return false;
+   }
+   const std::string str(s);
+   char *end = nullptr;
+   value = std::strtod(str.c_str(), &end);
+   if (isFloat)
+      value = static_cast<float>(value);
+   constexpr double kMaxExact = static_cast<double>(std::uint64_t(1) << std::numeric_limits<double>::digits);
+   return end == str.c_str() + str.size() && std::abs(value) <= kMaxExact;
+}
+
+/// If `term` is a comparison between a column and a number, return the corresponding range cut
+std::optional<ROOT::RDF::RRangeCut> ParseRangeCut(std::string_view term)
+{
+   term = StripEnclosingParentheses(term);
+   const auto opPos = term.find_first_of("<>=!");
+   if (opPos == std::string_view::npos || opPos == 0)
+      return std::nullopt;
+   const auto opLen = (opPos + 1 < term.size() && term[opPos + 1] == '=') ? 2 : 1;
+   const auto op = term.substr(opPos, opLen);
+   if (op == "=" || op == "!" || op == "!=")
+      return std::nullopt;
+
+   const auto lhs = TrimWhiteSpace(term.substr(0, opPos));
+   const auto rhs = TrimWhiteSpace(term.substr(opPos + opLen));
+   // `x < 3` and `3 > x` are the same cut
+   const bool isColumnLeft = IsColumnNameToken(lhs);
+   const auto column = isColumnLeft ? lhs : rhs;
+   double value = 0;
+   if (!IsColumnNameToken(column) || !ParseNumberToken(isColumnLeft ? rhs : lhs, value))
+      return std::nullopt;
+
+   constexpr double kInf = std::numeric_limits<double>::infinity();
+   ROOT::RDF::RRangeCut cut{std::string(column), -kInf, kInf};
+   // The interval is closed also for strict comparisons, which is conservative
+   const bool isUpperBound = (op[0] == '<') == isColumnLeft;
+   if (op == "==") {
+      cut.fMin = cut.fMax = value;
+   } else if (isUpperBound) {
+      cut.fMax = value;
+   } else {
+      cut.fMin = value;
+   }
+   return cut;
+}
+
+/// Whether a range cut on a column of the given type can be deduced from a comparison with a number: the type must
+/// be arithmetic, and comparisons of unsigned types with negative numbers are subject to conversions.
+bool IsRangeCutAllowed(const std::string &typeName, const ROOT::RDF::RRangeCut &cut)
+{
+   static const std::unordered_set<std::string> kSignedTypes{
+      "char",      "signed char", "short",        "int",          "long",          "long long",       "Char_t",
+      "Short_t",   "Int_t",       "Long_t",       "Long64_t",     "float",         "double",          "Float_t",
+      "Double_t",  "std::int8_t", "std::int16_t", "std::int32_t", "std::int64_t",  "int8_t",          "int16_t",
+      "int32_t",   "int64_t"};
+   static const std::unordered_set<std::string> kUnsignedTypes{
+      "unsigned char", "unsigned short", "unsigned int", "unsigned long", "unsigned long long", "UChar_t",
+      "UShort_t",      "UInt_t",         "ULong_t",      "ULong64_t",     "std::uint8_t",       "std::uint16_t",
+      "std::uint32_t", "std::uint64_t",  "uint8_t",      "uint16_t",      "uint32_t",           "uint64_t",
+      "std::size_t",   "size_t"};
+   if (kSignedTypes.count(typeName) > 0)
+      return true;
+   return kUnsignedTypes.count(typeName) > 0 && cut.fMax >= 0 && (cut.fMin >= 0 || std::isinf(cut.fMin));
+}
+
+/// Deduce the range cuts on data source columns that the entries passing a jitted Filter expression satisfy. Only the
+/// comparisons of a column with a number in the top-level `&&` conjunction are considered.
+std::vector<ROOT::RDF::RRangeCut>
+GetRangeCuts(std::string_view expression, const ROOT::Internal::RDF::RColumnRegister &colRegister,
+             ROOT::RDF::RDataSource *ds)
+{
+   std::vector<ROOT::RDF::RRangeCut> cuts;
+   // Only plain boolean expressions, not function bodies or expressions with alternatives
+   if (!ds || expression.find_first_of("|?,;{}\"'") != std::string_view::npos)
+      return cuts;
+
+   std::vector<std::string_view> terms;
+   SplitConjunction(expression, terms);
+   for (auto term : terms) {
+      auto cut = ParseRangeCut(term);
+      if (!cut)
+         continue;
+      cut->fColumnName = colRegister.ResolveAlias(cut->fColumnName);
+      if (colRegister.IsDefineOrAlias(cut->fColumnName) || !ds->HasColumn(cut->fColumnName) ||
+          !colRegister.GetVariationDeps(cut->fColumnName).empty() ||
+          !IsRangeCutAllowed(ds->GetTypeName(cut->fColumnName), *cut)) {
+         continue;
+      }
+      cuts.emplace_back(std::move(*cut));
+   }
+   return cuts;
+}
+
+/// Describe a jitted Filter or Define for the result cache, see RLoopManager::EnableResultCache().
+/// Return an empty key, i.e. make the node uncacheable, if any of its inputs cannot be described.
+std::string MakeCacheKey(const std::string &prevKey, std::string_view kind, std::string_view name,
+                         std::string_view expression, const ColumnNames_t &usedCols,
+                         const ROOT::Internal::RDF::RColumnRegister &colRegister)
+{
+   if (kind == "Filter" && prevKey.empty())
+      return "";
+   std::string key = prevKey + ";" + std::string(kind) + "(" + std::string(name) + ":" + std::string(expression) + "|";
+   for (const auto &col : usedCols) {
+      const auto colKey = colRegister.GetCacheKey(col);
+      if (colKey.empty())
+         return "";
+      key += colKey + ",";
+   }
+   return key + ")";
+}
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -681,6 +947,11 @@ BookFilterJit(std::shared_ptr<RDFDetail::RNodeBase> *prevNodeOnHeap, std::string
                     << "reinterpret_cast<ROOT::Internal::RDF::RColumnRegister*>(" << definesOnHeapAddr << ")"
                     << ");\n";
 
+   // Cuts that can be pushed down to the data source, see RLoopManager::GetPushDownRangeCuts()
+   jittedFilter->SetRangeCuts(GetRangeCuts(expression, colRegister, ds));
+   jittedFilter->SetCacheKey(MakeCacheKey((*prevNodeOnHeap)->GetCacheKey(), "Filter", name, expression,
+                                          parsedExpr.fUsedCols, colRegister));
+
    auto lm = jittedFilter->GetLoopManagerUnchecked();
    lm->ToJitExec(filterInvocation.str());
 
@@ -705,6 +976,7 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
    auto definesCopy = new RColumnRegister(colRegister);
    auto definesAddr = PrettyPrintAddr(definesCopy);
    auto jittedDefine = std::make_shared<RDFDetail::RJittedDefine>(name, type, lm, colRegister, parsedExpr.fUsedCols);
+   jittedDefine->SetCacheKey(MakeCacheKey("", "Define", name, expression, parsedExpr.fUsedCols, colRegister));
 
    std::stringstream defineInvocation;
    defineInvocation << "ROOT::Internal::RDF::JitDefineHelper<ROOT::Internal::RDF::DefineTypes::RDefineTag>(" << funcName
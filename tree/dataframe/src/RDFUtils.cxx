@@ -314,11 +314,22 @@ std::vector<std::string> ReplaceDotWithUnderscore(const std::vector<std::string>
    return newColNames;
 }
 
+namespace {
+/// Jitted expressions and the nodes instantiated around them run once per entry, and loops over RVec columns in
+/// numeric expressions only vectorise when optimised, hence always jit them with optimizations as TFormula does.
+/// The pragma applies to the cling transaction of the code it precedes.
+const std::string &OptimizePragma()
+{
+   static const std::string pragma = "#pragma cling optimize(2)\n";
+   return pragma;
+}
+} // anonymous namespace
+
 void InterpreterDeclare(const std::string &code)
 {
    R__LOG_DEBUG(10, RDFLogChannel()) << "Declaring the following code to cling:\n\n" << code << '\n';
 
-   if (!gInterpreter->Declare(code.c_str())) {
+   if (!gInterpreter->Declare((OptimizePragma() + code).c_str())) {
       const auto msg =
          "\nRDataFrame: An error occurred during just-in-time compilation. The lines above might indicate the cause of "
          "the crash\n All RDF objects that have not run an event loop yet should be considered in an invalid state.\n";
@@ -333,7 +344,7 @@ Long64_t InterpreterCalc(const std::string &code, const std::string &context)
    TInterpreter::EErrorCode errorCode(TInterpreter::kNoError); // storage for cling errors
 
    auto callCalc = [&errorCode, &context](const std::string &codeSlice) {
-      gInterpreter->Calc(codeSlice.c_str(), &errorCode);
+      gInterpreter->Calc((OptimizePragma() + codeSlice).c_str(), &errorCode);
       if (errorCode != TInterpreter::EErrorCode::kNoError) {
          std::string msg = "\nAn error occurred during just-in-time compilation";
          if (!context.empty())
@@ -949,6 +949,10 @@ ROOT::RDF::RunGraphs({histo1, histo2});
 histo1->Draw(); // results can then be used as usual
 ~~~
 
+If some of the computation graphs read the same TTree or TChain (same files, same trees, same entry range, no friends
+and no entry lists), RunGraphs() processes them in one shared event loop: every column is read from storage once per
+entry and is passed to all those graphs, instead of once per graph.
+
 ### Performance considerations
 
 To obtain the maximum performance out of RDataFrame, make sure to avoid just-in-time compiled versions of transformations and actions if at all possible.
@@ -964,6 +968,11 @@ before the first event loop is triggered: just-in-time compilation will happen o
 
 Also make sure not to count the just-in-time compilation time (which happens once before the event loop and does not depend on the size of the dataset) as part of the event loop runtime (which scales with the size of the dataset). RDataFrame has an experimental logging feature that simplifies measuring the time spent in just-in-time compilation and in the event loop (as well as providing some more interesting information). See [Activating RDataFrame execution logs](\ref rdf-logging).
 
+When reading a TTree, column values are only loaded when a node needs them. Columns that are only read by nodes
+downstream of a Filter, e.g. `df.Filter("nMuon == 2").Histo1D("Muon_pt")`, are not added to the TTreeCache: their
+baskets are read on demand, only for the entries that pass the filters, so that a very selective Filter does not cause
+the cache to read and decompress them for every cluster. Columns also used by a Define or Vary are always cached.
+
 ### Memory usage
 
 There are two reasons why RDataFrame may consume more memory than expected. Firstly, each result is duplicated for each worker thread, which e.g. in case of many (possibly multi-dimensional) histograms with fine binning can result in visible memory consumption during the event loop. The thread-local copies of the results are destroyed when the final result is produced. Reducing the number of threads or using coarser binning will reduce the memory usage.
@@ -1205,6 +1214,15 @@ df.Min<MyNumber_t>("myObject"); // OK, "myObject" is deduced to be of type `MyNu
 Deducing types at runtime requires the just-in-time compilation of the relevant actions, which has a small runtime
 overhead, so specifying the type of the columns as template parameters to the action is good practice when performance is a goal.
 
+The functions generated for string expressions passed to Filter() and Define() can also be kept across processes, which
+is useful when the same analysis runs in many short jobs. If the `RDataFrame.JitCacheDir` key of the ROOT configuration
+is set, e.g. with `RDataFrame.JitCacheDir: $HOME/.rdfjitcache` in `.rootrc` or with
+`gEnv->SetValue("RDataFrame.JitCacheDir", "/some/dir")`, each expression is compiled with ACLiC into a shared library in that
+directory, named after a hash of the expression, of the types of its columns and of the ROOT version. Later processes
+load that library instead of compiling the expression again. Expressions that use functions or types known only to the
+interpreter cannot be compiled on their own: they are jitted as usual. When many jobs share the cache directory, it is
+best to populate it from a single job first, as concurrent builds of the same library are not coordinated.
+
 When strings are passed as expressions to Filter() or Define(), fundamental types are passed as constants. This avoids certaincommon mistakes such as typing `x = 0` rather than `x == 0`:
 
 ~~~{.cpp}
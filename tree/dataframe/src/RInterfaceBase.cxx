@@ -404,6 +404,112 @@ unsigned int ROOT::RDF::RInterfaceBase::GetNRuns() const
    return fLoopManager->GetNRuns();
 }
 
+/// \brief Gets the time that each processing slot was busy during the last event loop.
+/// \return The wall-clock time in seconds spent by each slot processing entries, empty if no event loop was run
+///
+/// The difference between the busy times of the slots and the elapsed time of the event loop shows how well the
+/// work was balanced between the slots, e.g. whether some of them were idle while others processed large files.
+/// The times are also reported in the RDataFrame log at the info level.
+///
+/// Example usage:
+/// ~~~{.cpp}
+/// ROOT::EnableImplicitMT();
+/// ROOT::RDataFrame df(1000000);
+/// df.Sum("rdfentry_").GetValue(); // trigger the event loop
+/// for (auto t : df.GetSlotBusyTimes())
+///    std::cout << t << "s\n";
+/// ~~~
+std::vector<double> ROOT::RDF::RInterfaceBase::GetSlotBusyTimes() const
+{
+   return fLoopManager->GetSlotBusyTimes();
+}
+
+/// \brief Time every node of the computation graph in the following event loops.
+///
+/// When profiling is enabled, each processing slot measures the time it spends in each Filter, Define, Vary and
+/// action, and in the readers of each dataset column. Times are exclusive, e.g. the time spent reading the input
+/// columns of a Filter is attributed to the columns and not to the Filter. The measurements are retrieved with
+/// GetProfileReport(), can be exported to a Chrome trace with RProfileReport::SaveChromeTrace() and are shown next to
+/// each node in the output of SaveGraph().
+///
+/// Profiling affects the whole computation graph, and adds two clock readings to every node evaluation.
+/// It should be enabled before booking actions: readers of data source columns created earlier are not timed.
+///
+/// Example usage:
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// df.EnableProfiling();
+/// auto h = df.Define("pt", "sqrt(px*px + py*py)").Filter("pt > 20").Histo1D("pt");
+/// h->Draw(); // trigger the event loop
+/// auto report = df.GetProfileReport();
+/// report.Print();
+/// report.SaveChromeTrace("rdf_profile.json"); // open with https://ui.perfetto.dev
+/// ~~~
+void ROOT::RDF::RInterfaceBase::EnableProfiling()
+{
+   fLoopManager->EnableProfiling();
+}
+
+/// \brief Gets the time spent in each node of the computation graph during the last event loop.
+/// \return The profile of the last event loop, empty if EnableProfiling() was not called
+ROOT::RDF::Experimental::RProfileReport ROOT::RDF::RInterfaceBase::GetProfileReport() const
+{
+   auto *profiler = fLoopManager->GetProfiler();
+   return profiler ? profiler->MakeReport() : ROOT::RDF::Experimental::RProfileReport();
+}
+
+/// \brief Let the RVecs created by Defines allocate their buffers from a per-slot arena.
+///
+/// Every event, a Define that returns an RVec typically allocates and frees one or more buffers, e.g. for the result
+/// and for the temporaries of an expression like `pt[eta < 2.4] * 2`. When arenas are enabled, RVecs of trivially
+/// copyable types (e.g. RVec<float>, but not RVec<std::string>) that grow while a Define expression is evaluated take
+/// their memory from an arena of the processing slot instead of the heap. The arena is reset in bulk at the beginning
+/// of every entry, so that the same memory is reused event after event regardless of the size of the collections.
+///
+/// The values of defined columns are still available to all Filters, Defines and actions during the entry, and
+/// actions that keep values across entries (e.g. Take or Snapshot) copy them. However, the callables passed to Define
+/// must not keep RVecs that they filled across calls, e.g. in a captured variable: their memory is reused for the
+/// next entry. The arenas must be enabled before the event loop runs.
+///
+/// Example usage:
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("Events", "file.root");
+/// df.EnableRVecArenas();
+/// auto h = df.Define("goodJet_pt", "Jet_pt[Jet_pt > 30 && abs(Jet_eta) < 2.4]").Histo1D("goodJet_pt");
+/// ~~~
+void ROOT::RDF::RInterfaceBase::EnableRVecArenas()
+{
+   fLoopManager->EnableRVecArenas();
+}
+
+/// \brief Store the results of the event loops in a file, and load them from it instead of recomputing them.
+/// \param[in] fileName The ROOT file in which the results are stored. It is created if it does not exist.
+///
+/// Each result is stored with a key that describes how it is computed: the input files (identified by their path,
+/// UUID, size and modification date) and range of entries, the chain of Filters, Defines and Ranges upstream of the
+/// action with their expressions, the action with its input columns, and the initial state of the result, e.g. the
+/// model of a histogram. When all the results requested in an event loop are found in the cache, the event loop does
+/// not run at all, so that re-running an analysis in which only some of the actions changed only computes those.
+///
+/// Only the results of Histo1D/2D/3D, HistoND, Fill with a histogram, Graph, GraphAsymmErrors, Profile1D/2D, Min, Max,
+/// Sum, Mean, StdDev and Count are cached, and only if all the Filters and Defines they depend on are string
+/// expressions: C++ callables cannot be described, so the results computed with them are never cached. Results
+/// affected by systematic variations and event loops over data sources, TTree friends or entry lists are not cached.
+/// Note that C++ functions called in an expression are described by their name only: if their implementation
+/// changes, the cache file must be deleted.
+///
+/// Example usage:
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("Events", "file.root");
+/// df.EnableResultCache("rdf_results.root");
+/// auto h = df.Filter("nJet > 2").Histo1D({"h", "h", 100, 0., 200.}, "MET");
+/// h->Draw(); // the event loop runs only the first time this program is executed
+/// ~~~
+void ROOT::RDF::RInterfaceBase::EnableResultCache(std::string_view fileName)
+{
+   fLoopManager->EnableResultCache(fileName);
+}
+
 ROOT::RDF::ColumnNames_t ROOT::RDF::RInterfaceBase::GetColumnTypeNamesList(const ColumnNames_t &columnList)
 {
    std::vector<std::string> types;
@@ -433,6 +539,7 @@ void ROOT::RDF::RInterfaceBase::AddDefaultColumns()
 
    auto entryColumn = std::make_shared<NewColEntry_t>(entryColName, entryColType, std::move(entryColGen),
                                                       ColumnNames_t{}, fColRegister, *fLoopManager);
+   entryColumn->SetCacheKey(entryColName);
    fColRegister.AddDefine(std::move(entryColumn));
 
    // Slot number column
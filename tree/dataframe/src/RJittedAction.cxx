@@ -11,6 +11,7 @@
 #include "ROOT/RDF/RJittedAction.hxx"
 // Avoid error: invalid application of ‘sizeof’ to incomplete type in RJittedAction::GetMergeableValue
 #include "ROOT/RDF/RMergeableValue.hxx"
+#include "ROOT/RDF/RResultCache.hxx"
 
 #include <cassert>
 #include <memory>
@@ -67,6 +68,14 @@ RJittedAction::RJittedAction(RLoopManager &lm, const ROOT::RDF::ColumnNames_t &c
 
 RJittedAction::~RJittedAction() {}
 
+void RJittedAction::SetAction(std::unique_ptr<RActionBase> a)
+{
+   // Only the concrete action is registered with the loop manager, so it is the one that must know about the cache
+   if (fCachedResult)
+      a->SetCachedResult(std::move(fCachedResult));
+   fConcreteAction = std::move(a);
+}
+
 void RJittedAction::Run(unsigned int slot, Long64_t entry)
 {
    assert(fConcreteAction != nullptr);
@@ -91,6 +100,12 @@ void RJittedAction::TriggerChildrenCount()
    fConcreteAction->TriggerChildrenCount();
 }
 
+void RJittedAction::CollectRangeCutFilters(std::vector<const RFilterBase *> &filters) const
+{
+   assert(fConcreteAction != nullptr);
+   fConcreteAction->CollectRangeCutFilters(filters);
+}
+
 void RJittedAction::FinalizeSlot(unsigned int slot)
 {
    assert(fConcreteAction != nullptr);
@@ -103,6 +118,17 @@ void RJittedAction::Finalize()
    fConcreteAction->Finalize();
 }
 
+bool RJittedAction::TrySetResultFromMetadata()
+{
+   // Without jitting (see RLoopManager::Run) there is no concrete action to ask
+   return fConcreteAction != nullptr && fConcreteAction->TrySetResultFromMetadata();
+}
+
+std::string RJittedAction::GetCacheKey()
+{
+   return fConcreteAction != nullptr ? fConcreteAction->GetCacheKey() : "";
+}
+
 void *RJittedAction::PartialUpdate(unsigned int slot)
 {
    assert(fConcreteAction != nullptr);
@@ -132,6 +158,12 @@ std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::Get
    return fConcreteAction->GetGraph(visitedMap);
 }
 
+std::string RJittedAction::GetActionName()
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->GetActionName();
+}
+
 /**
    Retrieve a wrapper to the result of the action that knows how to merge
    with others of the same type.
@@ -45,6 +45,8 @@ void RJittedFilter::SetFilter(std::unique_ptr<RFilterBase> f)
    // the concrete filter has been registered with RLoopManager on creation, so let's deregister ourselves
    fLoopManager->Deregister(this);
    fConcreteFilter = std::move(f);
+   // the range cuts are deduced from the expression when the filter is booked, before jitting
+   fConcreteFilter->SetRangeCuts(fRangeCuts);
 }
 
 void RJittedFilter::InitSlot(TTreeReader *r, unsigned int slot)
@@ -128,6 +130,12 @@ void RJittedFilter::AddFilterName(std::vector<std::string> &filters)
    fConcreteFilter->AddFilterName(filters);
 }
 
+void RJittedFilter::CollectRangeCutFilters(std::vector<const RFilterBase *> &filters) const
+{
+   assert(fConcreteFilter != nullptr);
+   fConcreteFilter->CollectRangeCutFilters(filters);
+}
+
 std::shared_ptr<RDFGraphDrawing::GraphNode>
 RJittedFilter::GetGraph(std::unordered_map<void *, std::shared_ptr<RDFGraphDrawing::GraphNode>> &visitedMap)
 {
@@ -9,16 +9,18 @@
 #include "RConfigure.h" // R__USE_IMT
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/RDF/GraphNode.hxx"
-#include "ROOT/InternalTreeUtils.hxx" // GetTreeFullPaths
+#include "ROOT/InternalTreeUtils.hxx" // GetTreeFullPaths, GetFileNamesFromTree
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RDefineReader.hxx" // RDefinesWithReaders
 #include "ROOT/RDF/RFilterBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
+#include "ROOT/RDF/RResultCache.hxx"
 #include "ROOT/RDF/RVariationBase.hxx"
 #include "ROOT/RDF/RVariationReader.hxx" // RVariationsWithReaders
 #include "ROOT/RLogger.hxx"
+#include "ROOT/RTrace.hxx"
 #include "RtypesCore.h" // Long64_t
 #include "TStopwatch.h"
 #include "TBranchElement.h"
@@ -45,9 +47,14 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <exception> // std::uncaught_exceptions
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <sstream>
@@ -314,6 +321,19 @@ auto MakeDatasetColReadersKey(const std::string &colName, const std::type_info &
    //    df.Sum<RVecI>("stdVectorBranch");
    return colName + ':' + ti.name();
 }
+
+/// A RAII object that adds the wall-clock time elapsed during its lifetime to the busy time of a slot
+class RSlotBusyTimeRAII {
+   double &fBusyTime;
+   std::chrono::steady_clock::time_point fStart = std::chrono::steady_clock::now();
+
+public:
+   RSlotBusyTimeRAII(double &busyTime) : fBusyTime(busyTime) {}
+   ~RSlotBusyTimeRAII()
+   {
+      fBusyTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - fStart).count();
+   }
+};
 } // anonymous namespace
 
 namespace ROOT {
@@ -353,7 +373,8 @@ RLoopManager::RLoopManager(TTree *tree, const ColumnNames_t &defaultBranches)
    : fTree(std::shared_ptr<TTree>(tree, [](TTree *) {})), fDefaultColumns(defaultBranches),
      fNSlots(RDFInternal::GetNSlots()),
      fLoopType(ROOT::IsImplicitMTEnabled() ? ELoopType::kROOTFilesMT : ELoopType::kROOTFiles),
-     fNewSampleNotifier(fNSlots), fSampleInfos(fNSlots), fDatasetColumnReaders(fNSlots)
+     fNewSampleNotifier(fNSlots), fSampleInfos(fNSlots), fDatasetColumnReaders(fNSlots),
+     fTreeColumnIsGuarded(fNSlots)
 {
 }
 
@@ -364,7 +385,8 @@ RLoopManager::RLoopManager(std::unique_ptr<TTree> tree, const ColumnNames_t &def
      fLoopType(ROOT::IsImplicitMTEnabled() ? ELoopType::kROOTFilesMT : ELoopType::kROOTFiles),
      fNewSampleNotifier(fNSlots),
      fSampleInfos(fNSlots),
-     fDatasetColumnReaders(fNSlots)
+     fDatasetColumnReaders(fNSlots),
+     fTreeColumnIsGuarded(fNSlots)
 {
 }
 
@@ -374,14 +396,16 @@ RLoopManager::RLoopManager(ULong64_t nEmptyEntries)
      fLoopType(ROOT::IsImplicitMTEnabled() ? ELoopType::kNoFilesMT : ELoopType::kNoFiles),
      fNewSampleNotifier(fNSlots),
      fSampleInfos(fNSlots),
-     fDatasetColumnReaders(fNSlots)
+     fDatasetColumnReaders(fNSlots),
+     fTreeColumnIsGuarded(fNSlots)
 {
 }
 
 RLoopManager::RLoopManager(std::unique_ptr<RDataSource> ds, const ColumnNames_t &defaultBranches)
    : fDefaultColumns(defaultBranches), fNSlots(RDFInternal::GetNSlots()),
      fLoopType(ROOT::IsImplicitMTEnabled() ? ELoopType::kDataSourceMT : ELoopType::kDataSource),
-     fDataSource(std::move(ds)), fNewSampleNotifier(fNSlots), fSampleInfos(fNSlots), fDatasetColumnReaders(fNSlots)
+     fDataSource(std::move(ds)), fNewSampleNotifier(fNSlots), fSampleInfos(fNSlots), fDatasetColumnReaders(fNSlots),
+     fTreeColumnIsGuarded(fNSlots)
 {
    fDataSource->SetNSlots(fNSlots);
 }
@@ -391,11 +415,15 @@ RLoopManager::RLoopManager(ROOT::RDF::Experimental::RDatasetSpec &&spec)
      fLoopType(ROOT::IsImplicitMTEnabled() ? ELoopType::kROOTFilesMT : ELoopType::kROOTFiles),
      fNewSampleNotifier(fNSlots),
      fSampleInfos(fNSlots),
-     fDatasetColumnReaders(fNSlots)
+     fDatasetColumnReaders(fNSlots),
+     fTreeColumnIsGuarded(fNSlots)
 {
    ChangeSpec(std::move(spec));
 }
 
+// outlined to be able to destroy the members of incomplete types, e.g. the RResultCache
+RLoopManager::~RLoopManager() = default;
+
 /**
  * @brief Changes the internal TTree held by the RLoopManager.
  *
@@ -453,43 +481,46 @@ void RLoopManager::RunEmptySourceMT()
 #ifdef R__USE_IMT
    ROOT::Internal::RSlotStack slotStack(fNSlots);
    // Working with an empty tree.
-   // Evenly partition the entries according to fNSlots. Produce around 2 tasks per slot.
-   const auto nEmptyEntries = GetNEmptyEntries();
-   const auto nEntriesPerSlot = nEmptyEntries / (fNSlots * 2);
-   auto remainder = nEmptyEntries % (fNSlots * 2);
-   std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   ULong64_t begin = fEmptyEntryRange.first;
-   while (begin < fEmptyEntryRange.second) {
-      ULong64_t end = begin + nEntriesPerSlot;
-      if (remainder > 0) {
-         ++end;
-         --remainder;
-      }
-      entryRanges.emplace_back(begin, end);
-      begin = end;
-   }
-
-   // Each task will generate a subrange of entries
-   auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+   // Each task takes chunks of entries from a shared cursor until all entries are processed. The size of a chunk is a
+   // fraction of the entries that remain, so that chunks get smaller towards the end of the event loop and the tasks
+   // that are done early take over the work of the others instead of idling (guided scheduling).
+   const auto end = fEmptyEntryRange.second;
+   std::atomic<ULong64_t> next(fEmptyEntryRange.first);
+   auto genFunction = [this, &slotStack, &next, end](unsigned int) {
       ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
+      RSlotBusyTimeRAII busyTime(fSlotBusyTimes[slot]);
+      R__TRACE_SCOPE("rdf", "RDF task");
       RCallCleanUpTask cleanup(*this, slot);
       InitNodeSlots(nullptr, slot);
-      R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing({"an empty source", range.first, range.second, slot});
-      try {
-         UpdateSampleInfo(slot, range);
-         for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
-            RunAndCheckFilters(slot, currEntry);
+      while (true) {
+         auto first = next.load();
+         ULong64_t last = 0;
+         do {
+            if (first >= end)
+               return;
+            const auto remaining = end - first;
+            last = first + std::max<ULong64_t>(1ull, remaining / (2 * fNSlots));
+         } while (!next.compare_exchange_weak(first, last));
+         const std::pair<ULong64_t, ULong64_t> range(first, last);
+         R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing({"an empty source", range.first, range.second, slot});
+         try {
+            // every chunk is a data block of its own for the sample callbacks
+            UpdateSampleInfo(slot, range);
+            fNewSampleNotifier.SetFlag(slot);
+            for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
+               RunAndCheckFilters(slot, currEntry);
+            }
+         } catch (...) {
+            // Error might throw in experiment frameworks like CMSSW
+            std::cerr << "RDataFrame::Run: event loop was interrupted\n";
+            throw;
          }
-      } catch (...) {
-         // Error might throw in experiment frameworks like CMSSW
-         std::cerr << "RDataFrame::Run: event loop was interrupted\n";
-         throw;
       }
    };
 
    ROOT::TThreadExecutor pool;
-   pool.Foreach(genFunction, entryRanges);
+   pool.Foreach(genFunction, ROOT::TSeqU(fNSlots));
 
 #endif // not implemented otherwise
 }
@@ -497,6 +528,7 @@ void RLoopManager::RunEmptySourceMT()
 /// Run event loop with no source files, in sequence.
 void RLoopManager::RunEmptySource()
 {
+   RSlotBusyTimeRAII busyTime(fSlotBusyTimes[0]);
    InitNodeSlots(nullptr, 0);
    R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing(
       {"an empty source", fEmptyEntryRange.first, fEmptyEntryRange.second, 0u});
@@ -530,6 +562,8 @@ void RLoopManager::RunTreeProcessorMT()
    tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
       ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
+      RSlotBusyTimeRAII busyTime(fSlotBusyTimes[slot]);
+      R__TRACE_SCOPE("rdf", "RDF task");
       RCallCleanUpTask cleanup(*this, slot, &r);
       InitNodeSlots(&r, slot);
       R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, slot));
@@ -539,10 +573,7 @@ void RLoopManager::RunTreeProcessorMT()
       try {
          // recursive call to check filters and conditionally execute actions
          while (r.Next()) {
-            if (fNewSampleNotifier.CheckFlag(slot)) {
-               UpdateSampleInfo(slot, r);
-            }
-            RunAndCheckFilters(slot, count++);
+            RunSharedTreeEntry(r, slot, count++);
          }
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -572,6 +603,7 @@ void RLoopManager::RunTreeReader()
       if (r.SetEntriesRange(fBeginEntry, fEndEntry) != TTreeReader::kEntryValid)
          throw std::logic_error("Something went wrong in initializing the TTreeReader.");
 
+   RSlotBusyTimeRAII busyTime(fSlotBusyTimes[0]);
    RCallCleanUpTask cleanup(*this, 0u, &r);
    InitNodeSlots(&r, 0);
    R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, 0u));
@@ -579,17 +611,14 @@ void RLoopManager::RunTreeReader()
    // recursive call to check filters and conditionally execute actions
    // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
    try {
-      while (r.Next() && fNStopsReceived < fNChildren) {
-         if (fNewSampleNotifier.CheckFlag(0)) {
-            UpdateSampleInfo(/*slot*/0, r);
-         }
-         RunAndCheckFilters(0, r.GetCurrentEntry());
+      while (r.Next() && !AllSharedScanGraphsStopped()) {
+         RunSharedTreeEntry(r, /*slot*/ 0, r.GetCurrentEntry());
       }
    } catch (...) {
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
    }
-   if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && fNStopsReceived < fNChildren) {
+   if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && !AllSharedScanGraphsStopped()) {
       // something went wrong in the TTreeReader event loop
       throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
                                std::to_string(r.GetEntryStatus()));
@@ -603,6 +632,7 @@ void RLoopManager::RunDataSource()
    fDataSource->Initialize();
    auto ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty() && fNStopsReceived < fNChildren) {
+      RSlotBusyTimeRAII busyTime(fSlotBusyTimes[0]);
       InitNodeSlots(nullptr, 0u);
       fDataSource->InitSlot(0u, 0ull);
       RCallCleanUpTask cleanup(*this);
@@ -639,6 +669,8 @@ void RLoopManager::RunDataSourceMT()
    auto runOnRange = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
       ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
       const auto slot = slotRAII.fSlot;
+      RSlotBusyTimeRAII busyTime(fSlotBusyTimes[slot]);
+      R__TRACE_SCOPE("rdf", "RDF task");
       InitNodeSlots(nullptr, slot);
       RCallCleanUpTask cleanup(*this, slot);
       fDataSource->InitSlot(slot, range.first);
@@ -658,9 +690,15 @@ void RLoopManager::RunDataSourceMT()
       fDataSource->FinalizeSlot(slot);
    };
 
+   // Ranges cannot be split, as data sources only accept to start a task at the beginning of one of the ranges
+   // they returned, but the largest ranges are started first so that the smallest ones fill the end of the loop.
+   const auto largestFirst = [](const std::pair<ULong64_t, ULong64_t> &a, const std::pair<ULong64_t, ULong64_t> &b) {
+      return a.second - a.first > b.second - b.first;
+   };
    fDataSource->Initialize();
    auto ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty()) {
+      std::stable_sort(ranges.begin(), ranges.end(), largestFirst);
       pool.Foreach(runOnRange, ranges);
       ranges = fDataSource->GetEntryRanges();
    }
@@ -672,6 +710,10 @@ void RLoopManager::RunDataSourceMT()
 /// Named filters must be called even if the analysis logic would not require it, lest they report confusing results.
 void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
+   // the RVecs defined for the previous entry are not needed anymore
+   if (!fRVecArenas.empty())
+      fRVecArenas[slot]->Reset();
+
    // data-block callbacks run before the rest of the graph
    if (fNewSampleNotifier.CheckFlag(slot)) {
       for (auto &callback : fSampleCallbacks)
@@ -687,12 +729,44 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Process the current entry of the TTreeReader in this computation graph and in the ones that share its event loop,
+/// see SetSharedScanLoops(). Graphs that already received a stop signal from all their children are skipped.
+void RLoopManager::RunSharedTreeEntry(TTreeReader &r, unsigned int slot, Long64_t entry)
+{
+   auto runEntry = [&r, slot, entry](RLoopManager &lm) {
+      if (lm.fNStopsReceived >= lm.fNChildren)
+         return;
+      if (lm.fNewSampleNotifier.CheckFlag(slot)) {
+         lm.UpdateSampleInfo(slot, r);
+      }
+      lm.RunAndCheckFilters(slot, entry);
+   };
+   runEntry(*this);
+   for (auto *lm : fSharedScanLoops)
+      runEntry(*lm);
+}
+
+/// Whether this computation graph and all the ones that share its event loop can stop processing entries.
+bool RLoopManager::AllSharedScanGraphsStopped() const
+{
+   return fNStopsReceived >= fNChildren &&
+          std::all_of(fSharedScanLoops.begin(), fSharedScanLoops.end(),
+                      [](const RLoopManager *lm) { return lm->fNStopsReceived >= lm->fNChildren; });
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitSlot` method, to get them ready for running a task.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
+   // graphs that share the event loop read their columns from the same TTreeReader
+   for (auto *lm : fSharedScanLoops)
+      lm->InitNodeSlots(r, slot);
+
+   if (fProfiler)
+      fProfiler->StartTask(slot);
    SetupSampleCallbacks(r, slot);
+   fTreeColumnIsGuarded[slot].clear();
    for (auto *ptr : fBookedActions)
       ptr->InitSlot(r, slot);
    for (auto *ptr : fBookedFilters)
@@ -702,6 +776,25 @@ void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
    for (auto *ptr : fBookedVariations)
       ptr->InitSlot(r, slot);
 
+   if (r != nullptr) {
+      // The values of the guarded columns are only loaded for the entries that pass the filters, so they should not
+      // make the TTreeCache read their baskets for every cluster. With a shared event loop, a column must be guarded
+      // in all the graphs that read it.
+      auto isGuarded = fTreeColumnIsGuarded[slot];
+      for (auto *lm : fSharedScanLoops) {
+         for (const auto &colAndGuarded : lm->fTreeColumnIsGuarded[slot]) {
+            auto it = isGuarded.insert(colAndGuarded).first;
+            it->second = it->second && colAndGuarded.second;
+         }
+      }
+      std::vector<std::string> uncachedBranches;
+      for (const auto &colAndGuarded : isGuarded) {
+         if (colAndGuarded.second)
+            uncachedBranches.emplace_back(colAndGuarded.first);
+      }
+      r->SetUncachedBranches(uncachedBranches);
+   }
+
    for (auto &callback : fCallbacksOnce)
       callback(slot);
 }
@@ -756,12 +849,37 @@ void RLoopManager::UpdateSampleInfo(unsigned int slot, TTreeReader &r) {
 void RLoopManager::InitNodes()
 {
    EvalChildrenCounts();
+   if (fDataSource)
+      fDataSource->SetRangeCuts(GetPushDownRangeCuts());
    for (auto *filter : fBookedFilters)
       filter->InitNode();
    for (auto *range : fBookedRanges)
       range->InitNode();
    for (auto *ptr : fBookedActions)
       ptr->Initialize();
+
+   if (fProfiler) {
+      using ENodeKind = RDFInternal::RProfiler::ENodeKind;
+      auto withVariation = [](const std::string &name, const std::string &variation) {
+         return variation == "nominal" ? name : name + " [" + variation + "]";
+      };
+      for (auto *filter : fBookedFilters)
+         filter->SetProfileId(fProfiler->RegisterNode(
+            filter, ENodeKind::kFilter,
+            withVariation(filter->HasName() ? filter->GetName() : "Filter", filter->GetVariationName())));
+      for (auto *define : fBookedDefines)
+         define->SetProfileId(fProfiler->RegisterNode(define, ENodeKind::kDefine,
+                                                      withVariation(define->GetName(), define->GetVariationName())));
+      for (auto *variation : fBookedVariations) {
+         std::string name;
+         for (const auto &col : variation->GetColumnNames())
+            name += (name.empty() ? "" : ",") + col;
+         variation->SetProfileId(fProfiler->RegisterNode(variation, ENodeKind::kVariation, name));
+      }
+      for (auto *action : fBookedActions)
+         action->SetProfileId(fProfiler->RegisterNode(action, ENodeKind::kAction, action->GetActionName()));
+      fProfiler->StartLoop();
+   }
 }
 
 /// Perform clean-up operations. To be called at the end of each event loop.
@@ -770,8 +888,22 @@ void RLoopManager::CleanUpNodes()
    fMustRunNamedFilters = false;
 
    // forget RActions and detach TResultProxies
-   for (auto *ptr : fBookedActions)
-      ptr->Finalize();
+   {
+      R__TRACE_SCOPE("rdf", "RDF finalize");
+      for (auto *ptr : fBookedActions)
+         ptr->Finalize();
+   }
+
+   // results are only cached if the event loop completed
+   if (!fActionsToCache.empty() && std::uncaught_exceptions() == 0) {
+      std::vector<std::pair<const RDFInternal::RCachedResultBase *, std::string>> results;
+      for (auto &[action, key] : fActionsToCache)
+         results.emplace_back(action->GetCachedResult(), std::move(key));
+      if (!fResultCache->Store(results))
+         R__LOG_WARNING(RDFLogChannel()) << "Could not store the results of the event loop in the result cache "
+                                         << fResultCache->GetFileName() << '.';
+   }
+   fActionsToCache.clear();
 
    fRunActions.insert(fRunActions.begin(), fBookedActions.begin(), fBookedActions.end());
    fBookedActions.clear();
@@ -791,6 +923,8 @@ void RLoopManager::CleanUpNodes()
 /// Perform clean-up operations. To be called at the end of each task execution.
 void RLoopManager::CleanUpTask(TTreeReader *r, unsigned int slot)
 {
+   for (auto *lm : fSharedScanLoops)
+      lm->CleanUpTask(r, slot);
    if (r != nullptr)
       fNewSampleNotifier.GetChainNotifyLink(slot).RemoveLink(*r->GetTree());
    for (auto *ptr : fBookedActions)
@@ -799,6 +933,8 @@ void RLoopManager::CleanUpTask(TTreeReader *r, unsigned int slot)
       ptr->FinalizeSlot(slot);
    for (auto *ptr : fBookedDefines)
       ptr->FinalizeSlot(slot);
+   if (fProfiler)
+      fProfiler->EndTask(slot);
 
    if (fLoopType == ELoopType::kROOTFiles || fLoopType == ELoopType::kROOTFilesMT) {
       // we are reading from a tree/chain and we need to re-create the RTreeColumnReaders at every task
@@ -848,6 +984,165 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Return the range cuts that all the entries processed by the booked actions and named filters pass, i.e. the cuts
+/// of the filters that lie on the path of every one of them and that are not preceded by a Range or a named filter.
+/// Actions that do not report their path, e.g. varied actions, disable the push down.
+std::vector<ROOT::RDF::RRangeCut> RLoopManager::GetPushDownRangeCuts() const
+{
+   std::vector<ROOT::RDF::RRangeCut> cuts;
+   if (fBookedActions.empty())
+      return cuts;
+
+   std::vector<const RFilterBase *> common;
+   bool isFirst = true;
+   auto intersect = [&common, &isFirst](std::vector<const RFilterBase *> &filters) {
+      std::sort(filters.begin(), filters.end());
+      if (isFirst) {
+         common = std::move(filters);
+         isFirst = false;
+         return;
+      }
+      std::vector<const RFilterBase *> result;
+      std::set_intersection(common.begin(), common.end(), filters.begin(), filters.end(), std::back_inserter(result));
+      std::swap(common, result);
+   };
+   for (auto *actionPtr : fBookedActions) {
+      std::vector<const RFilterBase *> filters;
+      actionPtr->CollectRangeCutFilters(filters);
+      intersect(filters);
+      if (common.empty())
+         return cuts;
+   }
+   for (auto *namedFilterPtr : fBookedNamedFilters) {
+      std::vector<const RFilterBase *> filters;
+      namedFilterPtr->CollectRangeCutFilters(filters);
+      intersect(filters);
+      if (common.empty())
+         return cuts;
+   }
+
+   for (const auto *filter : common) {
+      const auto &filterCuts = filter->GetRangeCuts();
+      cuts.insert(cuts.end(), filterCuts.begin(), filterCuts.end());
+   }
+   return cuts;
+}
+
+/// Return the number of entries that an event loop would process, if it is known without reading the dataset, e.g.
+/// from the file metadata.
+std::optional<ULong64_t> RLoopManager::GetNEntriesFromMetadata() const
+{
+   if (fBeginEntry != 0 || fEndEntry != std::numeric_limits<Long64_t>::max())
+      return std::nullopt;
+   if (fDataSource)
+      return fDataSource->GetNEntriesFromMetadata();
+   if (fTree) {
+      if (fTree->GetEntryList())
+         return std::nullopt;
+      return fTree->GetEntries();
+   }
+   return GetNEmptyEntries();
+}
+
+/// Return the range of the values of dataset column `col` over all the entries that an event loop would process, if it
+/// is known without reading the column, see RDataSource::GetColumnStatsFromMetadata().
+std::optional<ROOT::RDF::RColumnStats> RLoopManager::GetColumnStatsFromMetadata(const std::string &col) const
+{
+   if (!fDataSource || !fDataSource->HasColumn(col))
+      return std::nullopt;
+   return fDataSource->GetColumnStatsFromMetadata(col);
+}
+
+/// Whether something other than the booked actions relies on the event loop running over every entry, i.e. callbacks,
+/// named filters that must run or computation graphs sharing the event loop.
+bool RLoopManager::HasEventLoopObservers() const
+{
+   return !fSharedScanLoops.empty() || !fCallbacksEveryNEvents.empty() || !fCallbacksOnce.empty() ||
+          !fSampleCallbacks.empty() || (fMustRunNamedFilters && !fBookedNamedFilters.empty());
+}
+
+/// Set the results of the booked actions that can be answered from the dataset metadata, e.g. a Count() of the whole
+/// dataset, and move them to the actions already run. Returns whether the result of any action was set.
+/// Nothing is done if the event loop has other observers, see HasEventLoopObservers().
+bool RLoopManager::SetResultsFromMetadata()
+{
+   if (HasEventLoopObservers())
+      return false;
+
+   std::vector<RDFInternal::RActionBase *> notSet;
+   for (auto *actionPtr : fBookedActions) {
+      if (actionPtr->TrySetResultFromMetadata())
+         fRunActions.emplace_back(actionPtr);
+      else
+         notSet.emplace_back(actionPtr);
+   }
+   const auto nSet = fBookedActions.size() - notSet.size();
+   fBookedActions = std::move(notSet);
+
+   if (nSet > 0)
+      R__LOG_INFO(RDFLogChannel()) << "The results of " << nSet << " actions were set from the dataset metadata.";
+   return nSet > 0;
+}
+
+/// Return a key that identifies the entries read by the event loop and their content, for the result cache, or an empty
+/// string if the results of this event loop cannot be cached. Trees are identified by GetSharedScanKey() and their
+/// files by their UUID, size and modification date, so that rewriting a file invalidates the results computed from it.
+std::string RLoopManager::GetDatasetCacheKey() const
+{
+   if (fLoopType == ELoopType::kNoFiles || fLoopType == ELoopType::kNoFilesMT)
+      return "empty:" + std::to_string(fEmptyEntryRange.first) + ':' + std::to_string(fEmptyEntryRange.second);
+
+   auto key = GetSharedScanKey();
+   if (key.empty())
+      return "";
+   for (const auto &fileName : ROOT::Internal::TreeUtils::GetFileNamesFromTree(*fTree)) {
+      std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
+      if (!file || file->IsZombie())
+         return "";
+      key += '\n' + std::string(file->GetUUID().AsString()) + '\t' + std::to_string(file->GetSize()) + '\t' +
+             file->GetModificationDate().AsSQLString();
+   }
+   return key;
+}
+
+/// Load the results of the booked actions that are in the result cache and move them to the actions already run.
+/// The cacheable actions whose results are not in the cache are stored in it at the end of the event loop, see
+/// CleanUpNodes(). Returns whether the result of any action was loaded.
+bool RLoopManager::LoadResultsFromCache()
+{
+   fActionsToCache.clear();
+   if (!fResultCache || fBookedActions.empty() || HasEventLoopObservers())
+      return false;
+   const auto datasetKey = GetDatasetCacheKey();
+   if (datasetKey.empty())
+      return false;
+
+   std::vector<RDFInternal::RActionBase *> notLoaded;
+   for (auto *actionPtr : fBookedActions) {
+      auto *cachedResult = actionPtr->GetCachedResult();
+      const auto actionKey = cachedResult ? actionPtr->GetCacheKey() : "";
+      if (actionKey.empty()) {
+         notLoaded.emplace_back(actionPtr);
+         continue;
+      }
+      auto key = datasetKey + '\n' + actionKey + '\n' + cachedResult->GetInitialState();
+      if (fResultCache->Load(*cachedResult, key)) {
+         actionPtr->SetHasRun();
+         fRunActions.emplace_back(actionPtr);
+      } else {
+         fActionsToCache.emplace_back(actionPtr, std::move(key));
+         notLoaded.emplace_back(actionPtr);
+      }
+   }
+   const auto nLoaded = fBookedActions.size() - notLoaded.size();
+   fBookedActions = std::move(notLoaded);
+
+   if (nLoaded > 0)
+      R__LOG_INFO(RDFLogChannel()) << "The results of " << nLoaded << " actions were loaded from the result cache "
+                                   << fResultCache->GetFileName() << '.';
+   return nLoaded > 0;
+}
+
 /// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
 /// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
 /// The jitting phase is skipped if the `jit` parameter is `false` (unsafe, use with care).
@@ -863,7 +1158,19 @@ void RLoopManager::Run(bool jit)
    if (jit)
       Jit();
 
+   const bool setFromMetadata = SetResultsFromMetadata();
+   const bool loadedFromCache = LoadResultsFromCache();
+   if ((setFromMetadata || loadedFromCache) && fBookedActions.empty()) {
+      R__LOG_INFO(RDFLogChannel()) << "Event loop number " << fNRuns
+                                   << " was not needed: all results were set from the dataset metadata or loaded "
+                                      "from the result cache.";
+      fNRuns++;
+      return;
+   }
+
    InitNodes();
+   for (auto *lm : fSharedScanLoops)
+      lm->InitNodes();
 
    // Exceptions can occur during the event loop. In order to ensure proper cleanup of nodes
    // we use RAII: even in case of an exception, the destructor of the object is invoked and
@@ -873,11 +1180,18 @@ void RLoopManager::Run(bool jit)
 
    public:
       NodesCleanerRAII(RLoopManager &thisRLM) : fRLM(thisRLM) {}
-      ~NodesCleanerRAII() { fRLM.CleanUpNodes(); }
+      ~NodesCleanerRAII()
+      {
+         for (auto *lm : fRLM.fSharedScanLoops)
+            lm->CleanUpNodes();
+         fRLM.fSharedScanLoops.clear();
+         fRLM.CleanUpNodes();
+      }
    };
 
    NodesCleanerRAII runKeeper(*this);
 
+   fSlotBusyTimes.assign(fNSlots, 0.);
    TStopwatch s;
    s.Start();
 
@@ -892,9 +1206,86 @@ void RLoopManager::Run(bool jit)
    s.Stop();
 
    fNRuns++;
+   for (auto *lm : fSharedScanLoops) {
+      lm->fNRuns++;
+      lm->fSlotBusyTimes = fSlotBusyTimes;
+   }
 
    R__LOG_INFO(RDFLogChannel()) << "Finished event loop number " << fNRuns - 1 << " (" << s.CpuTime() << "s CPU, "
                                 << s.RealTime() << "s elapsed).";
+   if (fNSlots > 1) {
+      const auto minMax = std::minmax_element(fSlotBusyTimes.begin(), fSlotBusyTimes.end());
+      R__LOG_INFO(RDFLogChannel()) << "Busy time per slot: min " << *minMax.first << "s, max " << *minMax.second
+                                   << "s, total "
+                                   << std::accumulate(fSlotBusyTimes.begin(), fSlotBusyTimes.end(), 0.) << "s.";
+   }
+}
+
+/// Time the Filters, Defines, Varies, actions and dataset column readers of this computation graph in the next event
+/// loops. Dataset columns are only timed if their readers are created after this call, which is always the case for
+/// TTree datasets and is the case for data sources if no action reading the column has been booked yet.
+void RLoopManager::EnableProfiling()
+{
+   if (!fProfiler)
+      fProfiler = std::make_unique<RDFInternal::RProfiler>(fNSlots);
+}
+
+/// Let the RVecs created by the Defines of this computation graph allocate from a per-slot arena that is reset at
+/// every entry, see RInterfaceBase::EnableRVecArenas().
+void RLoopManager::EnableRVecArenas()
+{
+   if (fRVecArenas.empty()) {
+      for (auto i = 0u; i < fNSlots; ++i)
+         fRVecArenas.emplace_back(std::make_unique<ROOT::Internal::VecOps::RVecArena>());
+   }
+}
+
+/// Store the results of the cacheable actions of the following event loops in the ROOT file `fileName`, and load them
+/// from it instead of running the event loop if they were already computed, see RInterfaceBase::EnableResultCache().
+void RLoopManager::EnableResultCache(std::string_view fileName)
+{
+   fResultCache = std::make_unique<RDFInternal::RResultCache>(fileName);
+}
+
+/// Return a key that identifies the dataset read by the event loop, or an empty string if the event loop cannot be
+/// shared with other computation graphs. Event loops with the same key read the same entries of the same trees, so
+/// they can be run as one, see SetSharedScanLoops(). Only TTree and TChain datasets without friends or entry lists
+/// are supported.
+std::string RLoopManager::GetSharedScanKey() const
+{
+   if ((fLoopType != ELoopType::kROOTFiles && fLoopType != ELoopType::kROOTFilesMT) || !fTree)
+      return "";
+   if (fTree->GetEntryList() || (fTree->GetListOfFriends() && fTree->GetListOfFriends()->GetEntries() > 0))
+      return "";
+
+   std::vector<std::string> fileNames;
+   std::vector<std::string> treeNames;
+   try {
+      fileNames = ROOT::Internal::TreeUtils::GetFileNamesFromTree(*fTree);
+      treeNames = ROOT::Internal::TreeUtils::GetTreeFullPaths(*fTree);
+   } catch (const std::runtime_error &) {
+      // e.g. in-memory trees
+      return "";
+   }
+   if (fileNames.size() != treeNames.size())
+      return "";
+
+   std::string key = std::to_string(fBeginEntry) + ':' + std::to_string(fEndEntry);
+   for (std::size_t i = 0; i < fileNames.size(); ++i)
+      key += '\n' + fileNames[i] + '\t' + treeNames[i];
+   return key;
+}
+
+/// Make the next Run() of this loop manager also process the computation graphs of `loops`, which must have the same
+/// GetSharedScanKey(). All graphs read their columns through the TTreeReader of this event loop, so that each column
+/// is read from storage once per entry, and their results are ready at the end of it.
+void RLoopManager::SetSharedScanLoops(std::vector<RLoopManager *> loops)
+{
+   for (auto *lm : loops) {
+      if (lm == this || lm->GetNSlots() != fNSlots || lm->GetSharedScanKey() != GetSharedScanKey())
+         throw std::logic_error("RLoopManager::SetSharedScanLoops: the computation graphs do not read the same dataset.");
+   }
+   fSharedScanLoops = std::move(loops);
 }
 
 /// Return the list of default columns -- empty if none was provided when constructing the RDataFrame
@@ -1083,6 +1474,9 @@ void RLoopManager::AddDataSourceColumnReaders(const std::string &col,
    assert(readers.size() == fNSlots);
 
    for (auto slot = 0u; slot < fNSlots; ++slot) {
+      if (fProfiler)
+         readers[slot] = std::make_unique<RDFInternal::RProfiledColumnReader>(
+            std::move(readers[slot]), *fProfiler, slot, fProfiler->RegisterColumn(col));
       fDatasetColumnReaders[slot][key] = std::move(readers[slot]);
    }
 }
@@ -1098,6 +1492,9 @@ RColumnReaderBase *RLoopManager::AddTreeColumnReader(unsigned int slot, const st
    const auto key = MakeDatasetColReadersKey(col, ti);
    // if a reader for this column and this slot was already there, we are doing something wrong
    assert(readers.find(key) == readers.end() || readers[key] == nullptr);
+   if (fProfiler)
+      reader = std::make_unique<RDFInternal::RProfiledColumnReader>(std::move(reader), *fProfiler, slot,
+                                                                    fProfiler->RegisterColumn(col));
    auto *rptr = reader.get();
    readers[key] = std::move(reader);
    return rptr;
@@ -1114,6 +1511,17 @@ RLoopManager::GetDatasetColumnReader(unsigned int slot, const std::string &col,
       return nullptr;
 }
 
+/// \brief Record that a node reads the TTree column `col` in this slot.
+/// \param[in] isGuardedByFilter Whether the node only sees entries that passed a Filter.
+/// If all the nodes that read a column are guarded by a Filter, the column is not added to the TTreeCache: its
+/// baskets are read on demand, only for the entries that reach these nodes. Defines and Vary count as unguarded, as
+/// they might be evaluated for every entry.
+void RLoopManager::AddTreeColumnUse(unsigned int slot, const std::string &col, bool isGuardedByFilter)
+{
+   auto it = fTreeColumnIsGuarded[slot].emplace(col, isGuardedByFilter).first;
+   it->second = it->second && isGuardedByFilter;
+}
+
 void RLoopManager::AddSampleCallback(void *nodePtr, SampleCallback_t &&callback)
 {
    if (callback)
@@ -26,7 +26,11 @@
 #include <TError.h>
 #include <TSystem.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -45,6 +49,10 @@
 * For each column containing an array or a collection, a corresponding column `#colname` is available to access
 * `colname.size()` without reading and deserializing the collection values.
 *
+* If the RNTuple was written with value ranges (see RNTupleWriteOptions::SetEnableValueRanges()), the clusters that
+* cannot pass the jitted Filters comparing a top-level numeric field with a number, e.g. `df.Filter("pt > 30")`, are
+* not read at all.
+*
 **/
 // clang-format on
 
@@ -581,6 +589,165 @@ void RNTupleDS::PrepareNextRanges()
    } // loop over tail of remaining files
 }
 
+std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetSelectedRanges(const REntryRangeDS &range) const
+{
+   std::vector<std::pair<ULong64_t, ULong64_t>> result;
+
+   auto descriptorGuard = range.fSource->GetSharedDescriptorGuard();
+   // The column IDs differ from file to file, so the cut columns are looked up in the descriptor of every source
+   std::vector<std::pair<DescriptorId_t, const ROOT::RDF::RRangeCut *>> cutColumns;
+   for (const auto &cut : fRangeCuts) {
+      const auto fieldId = descriptorGuard->FindFieldId(cut.fColumnName);
+      if (fieldId == kInvalidDescriptorId ||
+          descriptorGuard->GetFieldDescriptor(fieldId).GetStructure() != ENTupleStructure::kLeaf)
+         continue;
+      const auto columnId = descriptorGuard->FindPhysicalColumnId(fieldId, 0, 0);
+      if (columnId != kInvalidDescriptorId)
+         cutColumns.emplace_back(columnId, &cut);
+   }
+   if (cutColumns.empty()) {
+      result.emplace_back(range.fFirstEntry, range.fLastEntry);
+      return result;
+   }
+
+   auto clusterId = descriptorGuard->FindClusterId(0, 0);
+   while (clusterId != kInvalidDescriptorId) {
+      const auto &clusterDesc = descriptorGuard->GetClusterDescriptor(clusterId);
+      clusterId = descriptorGuard->FindNextClusterId(clusterId);
+      const auto start = std::max<ULong64_t>(clusterDesc.GetFirstEntryIndex(), range.fFirstEntry);
+      const auto end =
+         std::min<ULong64_t>(clusterDesc.GetFirstEntryIndex() + clusterDesc.GetNEntries(), range.fLastEntry);
+      if (start >= end)
+         continue;
+
+      bool isSelected = true;
+      for (const auto &[columnId, cut] : cutColumns) {
+         // Without a value range (e.g. for deferred columns) the cluster cannot be skipped
+         if (!clusterDesc.ContainsColumn(columnId))
+            continue;
+         const auto &columnRange = clusterDesc.GetColumnRange(columnId);
+         if (!columnRange.fIsSuppressed && columnRange.fValueRange &&
+             !columnRange.fValueRange->Overlaps(cut->fMin, cut->fMax)) {
+            isSelected = false;
+            break;
+         }
+      }
+      if (!isSelected)
+         continue;
+
+      if (!result.empty() && result.back().second == start) {
+         result.back().second = end;
+      } else {
+         result.emplace_back(start, end);
+      }
+   }
+   return result;
+}
+
+void RNTupleDS::LoadMetadataDescriptors()
+{
+   for (auto i = fMetadataDescriptors.size() + 1; i < fFileNames.size(); ++i) {
+      auto source = CreatePageSource(fNTupleName, fFileNames[i]);
+      source->Attach();
+      fMetadataDescriptors.emplace_back(source->GetSharedDescriptorGuard()->Clone());
+   }
+}
+
+std::optional<ULong64_t> RNTupleDS::GetNEntriesFromMetadata()
+{
+   LoadMetadataDescriptors();
+   ULong64_t nEntries = fPrincipalDescriptor->GetNEntries();
+   for (const auto &desc : fMetadataDescriptors)
+      nEntries += desc->GetNEntries();
+   return nEntries;
+}
+
+namespace {
+
+/// Extends `stats` with the value range of the top-level leaf field `fieldName` over all the clusters of `desc`, as
+/// stored in the cluster descriptors (see RNTupleWriteOptions::SetEnableValueRanges()).
+/// Returns false if the range of the values in some cluster is unknown.
+bool MergeColumnStats(const ROOT::Experimental::RNTupleDescriptor &desc, std::string_view fieldName,
+                      std::optional<ROOT::RDF::RColumnStats> &stats)
+{
+   using ROOT::Experimental::EColumnType;
+
+   const auto fieldId = desc.FindFieldId(fieldName);
+   if (fieldId == kInvalidDescriptorId)
+      return false;
+   const auto &fieldDesc = desc.GetFieldDescriptor(fieldId);
+   if (fieldDesc.GetStructure() != ENTupleStructure::kLeaf || fieldDesc.GetParentId() != desc.GetFieldZeroId())
+      return false;
+
+   // A leaf field has one principal column per column representation; in every cluster, only one of them is stored
+   std::vector<std::pair<DescriptorId_t, bool>> columns; // physical column id, whether the ranges are exact
+   for (const auto &columnDesc : desc.GetColumnIterable(fieldId)) {
+      if (columnDesc.GetIndex() != 0)
+         continue;
+      bool isExact = true;
+      switch (columnDesc.GetType()) {
+      // The ranges are computed before the values are packed into lossy on-disk representations
+      case EColumnType::kReal16:
+      case EColumnType::kReal32Trunc:
+      case EColumnType::kReal32Quant: isExact = false; break;
+      case EColumnType::kReal32:
+      case EColumnType::kSplitReal32: isExact = fieldDesc.GetTypeName() == "float"; break;
+      default: break;
+      }
+      columns.emplace_back(columnDesc.GetPhysicalId(), isExact);
+   }
+
+   // Beyond 2^53, the values may not be representable as double
+   constexpr double kMaxExact = static_cast<double>(std::uint64_t(1) << std::numeric_limits<double>::digits);
+   auto clusterId = desc.FindClusterId(0, 0);
+   while (clusterId != kInvalidDescriptorId) {
+      const auto &clusterDesc = desc.GetClusterDescriptor(clusterId);
+      clusterId = desc.FindNextClusterId(clusterId);
+      if (clusterDesc.GetNEntries() == 0)
+         continue;
+
+      auto column = std::find_if(columns.begin(), columns.end(), [&clusterDesc](const auto &c) {
+         return clusterDesc.ContainsColumn(c.first) && !clusterDesc.GetColumnRange(c.first).fIsSuppressed;
+      });
+      if (column == columns.end())
+         return false;
+      const auto &valueRange = clusterDesc.GetColumnRange(column->first).fValueRange;
+      if (!valueRange)
+         return false;
+
+      const bool isExact =
+         column->second && std::abs(valueRange->fMin) <= kMaxExact && std::abs(valueRange->fMax) <= kMaxExact;
+      if (!stats) {
+         stats = ROOT::RDF::RColumnStats{valueRange->fMin, valueRange->fMax, isExact};
+      } else {
+         stats->fMin = std::min(stats->fMin, valueRange->fMin);
+         stats->fMax = std::max(stats->fMax, valueRange->fMax);
+         stats->fIsExact = stats->fIsExact && isExact;
+      }
+   }
+   return true;
+}
+
+} // anonymous namespace
+
+std::optional<ROOT::RDF::RColumnStats> RNTupleDS::GetColumnStatsFromMetadata(std::string_view colName)
+{
+   const std::string name(colName);
+   if (auto it = fColumnStats.find(name); it != fColumnStats.end())
+      return it->second;
+
+   LoadMetadataDescriptors();
+   std::optional<ROOT::RDF::RColumnStats> stats;
+   bool isKnown = MergeColumnStats(*fPrincipalDescriptor, colName, stats);
+   for (auto it = fMetadataDescriptors.begin(); isKnown && it != fMetadataDescriptors.end(); ++it)
+      isKnown = MergeColumnStats(**it, colName, stats);
+   if (!isKnown)
+      stats.reset();
+
+   fColumnStats[name] = stats;
+   return stats;
+}
+
 std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
 {
    std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
@@ -631,6 +798,9 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
    // entry ranges, given the current state of the entry cursor.
    // We remember the connection from first absolute entry index of a range to its REntryRangeDS record
    // so that we can properly rewire the column reader in InitSlot
+   // With range cuts, clusters that cannot pass them are left out. In single-thread runs, the selected clusters are
+   // returned as separate ranges on the same page source; in multi-thread runs, every range has its own page source
+   // and may only be trimmed to its first and last selected cluster.
    fFirstEntry2RangeIdx.clear();
    ULong64_t nEntriesPerSource = 0;
    for (std::size_t i = 0; i < fCurrentRanges.size(); ++i) {
@@ -641,18 +811,34 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
          fSeenEntries += nEntriesPerSource;
          nEntriesPerSource = 0;
       }
-      auto start = fCurrentRanges[i].fFirstEntry + fSeenEntries;
-      auto end = fCurrentRanges[i].fLastEntry + fSeenEntries;
-      nEntriesPerSource += end - start;
+      fCurrentRanges[i].fEntryOffset = fSeenEntries;
+      nEntriesPerSource += fCurrentRanges[i].fLastEntry - fCurrentRanges[i].fFirstEntry;
 
-      fFirstEntry2RangeIdx[start] = i;
-      ranges.emplace_back(start, end);
+      if (fRangeCuts.empty()) {
+         ranges.emplace_back(fCurrentRanges[i].fFirstEntry + fSeenEntries, fCurrentRanges[i].fLastEntry + fSeenEntries);
+      } else {
+         const auto selected = GetSelectedRanges(fCurrentRanges[i]);
+         if (selected.empty())
+            continue;
+         if (fNSlots == 1) {
+            for (const auto &[start, end] : selected)
+               ranges.emplace_back(start + fSeenEntries, end + fSeenEntries);
+         } else {
+            ranges.emplace_back(selected.front().first + fSeenEntries, selected.back().second + fSeenEntries);
+         }
+      }
+      fFirstEntry2RangeIdx[ranges.back().first] = i;
    }
    fSeenEntries += nEntriesPerSource;
 
+   if (ranges.empty()) {
+      // All the clusters of this batch have been skipped, continue with the next one
+      return GetEntryRanges();
+   }
+
    if ((fNSlots == 1) && (fCurrentRanges[0].fSource)) {
       for (auto r : fActiveColumnReaders[0]) {
-         r->Connect(*fCurrentRanges[0].fSource, ranges[0].first);
+         r->Connect(*fCurrentRanges[0].fSource, fCurrentRanges[0].fEntryOffset);
       }
    }
 
@@ -666,7 +852,7 @@ void RNTupleDS::InitSlot(unsigned int slot, ULong64_t firstEntry)
 
    auto idxRange = fFirstEntry2RangeIdx.at(firstEntry);
    for (auto r : fActiveColumnReaders[slot]) {
-      r->Connect(*fCurrentRanges[idxRange].fSource, firstEntry - fCurrentRanges[idxRange].fFirstEntry);
+      r->Connect(*fCurrentRanges[idxRange].fSource, fCurrentRanges[idxRange].fEntryOffset);
    }
 }
 
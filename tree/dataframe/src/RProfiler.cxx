@@ -0,0 +1,237 @@
+// Author: Enrico Guiraud CERN 10/2024
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfiler.hxx"
+#include "TString.h" // Printf
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+const char *KindName(ROOT::Internal::RDF::RProfiler::ENodeKind kind)
+{
+   using ENodeKind = ROOT::Internal::RDF::RProfiler::ENodeKind;
+   switch (kind) {
+   case ENodeKind::kFilter: return "Filter";
+   case ENodeKind::kDefine: return "Define";
+   case ENodeKind::kVariation: return "Vary";
+   case ENodeKind::kAction: return "Action";
+   case ENodeKind::kColumn: return "Column";
+   }
+   return "";
+}
+
+std::string EscapeJSON(const std::string &s)
+{
+   std::string out;
+   out.reserve(s.size());
+   for (auto c : s) {
+      if (c == '"' || c == '\\')
+         out += '\\';
+      if (static_cast<unsigned char>(c) < 0x20)
+         continue;
+      out += c;
+   }
+   return out;
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+double RProfileReport::RNodeTimes::GetTotalTime() const
+{
+   return std::accumulate(fSlotTimes.begin(), fSlotTimes.end(), 0.);
+}
+
+RProfileReport::RProfileReport(std::vector<RNodeTimes> &&nodes, std::vector<RTaskTimes> &&tasks)
+   : fNodes(std::move(nodes)), fTasks(std::move(tasks))
+{
+}
+
+/// Print the nodes sorted by decreasing total time.
+void RProfileReport::Print() const
+{
+   std::vector<const RNodeTimes *> sorted;
+   for (const auto &n : fNodes)
+      sorted.emplace_back(&n);
+   std::stable_sort(sorted.begin(), sorted.end(),
+                    [](const RNodeTimes *a, const RNodeTimes *b) { return a->GetTotalTime() > b->GetTotalTime(); });
+   const auto total = std::accumulate(fNodes.begin(), fNodes.end(), 0.,
+                                      [](double t, const RNodeTimes &n) { return t + n.GetTotalTime(); });
+   for (const auto *n : sorted) {
+      const auto t = n->GetTotalTime();
+      Printf("%-7s %-30s: %10.3f ms %5.1f %% calls=%-12llu %8.1f ns/call", n->fKind.c_str(), n->fName.c_str(), t * 1e3,
+             total > 0. ? 100. * t / total : 0., n->fCalls, n->fCalls > 0 ? t * 1e9 / n->fCalls : 0.);
+   }
+}
+
+/// Write the profile in the Chrome trace event format, which can be loaded in Perfetto or chrome://tracing.
+/// Each processing slot is shown as a thread, with one event per task. Inside a task, the exclusive time of each node
+/// is shown as a child event; as the times are summed over the entries of the task, the child events are laid out one
+/// after the other and do not correspond to a precise moment in time.
+void RProfileReport::SaveChromeTrace(const std::string &fileName) const
+{
+   std::ofstream out(fileName);
+   if (!out)
+      throw std::runtime_error("RProfileReport: cannot open file \"" + fileName + "\" for writing.");
+
+   out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+   bool first = true;
+   auto writeEvent = [&](const std::string &name, const char *cat, unsigned int tid, double start, double duration) {
+      out << (first ? "" : ",") << "\n{\"name\":\"" << EscapeJSON(name) << "\",\"cat\":\"" << cat
+          << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid << ",\"ts\":" << start * 1e6 << ",\"dur\":" << duration * 1e6
+          << "}";
+      first = false;
+   };
+   for (const auto &task : fTasks) {
+      writeEvent("task", "rdf", task.fSlot, task.fStart, task.fEnd - task.fStart);
+      auto t = task.fStart;
+      for (auto i = 0u; i < task.fNodeTimes.size() && i < fNodes.size(); ++i) {
+         if (task.fNodeTimes[i] <= 0.)
+            continue;
+         writeEvent(fNodes[i].fKind + " " + fNodes[i].fName, fNodes[i].fKind.c_str(), task.fSlot, t,
+                    task.fNodeTimes[i]);
+         t += task.fNodeTimes[i];
+      }
+   }
+   out << "\n]}\n";
+}
+
+} // namespace Experimental
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+
+RProfiler::RProfiler(unsigned int nSlots)
+{
+   for (auto i = 0u; i < nSlots; ++i)
+      fSlots.emplace_back(new RSlotData());
+}
+
+/// Forget the timings of previous event loops.
+void RProfiler::StartLoop()
+{
+   for (auto &data : fSlots) {
+      std::fill(data->fTimes.begin(), data->fTimes.end(), 0.);
+      std::fill(data->fCalls.begin(), data->fCalls.end(), 0ull);
+      data->fStack.clear();
+      data->fTasks.clear();
+   }
+   fLoopStart = Clock_t::now();
+}
+
+/// Return the id of a Filter, Define, Vary or action node, registering it if needed.
+unsigned int RProfiler::RegisterNode(const void *node, ENodeKind kind, const std::string &name)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto it = fNodeIds.find(node);
+   if (it != fNodeIds.end()) {
+      fNodes[it->second] = {kind, name};
+      return it->second;
+   }
+   fNodes.push_back({kind, name});
+   return fNodeIds[node] = fNodes.size() - 1;
+}
+
+/// Return the id of the readers of a dataset column, registering it if needed. Thread-safe.
+unsigned int RProfiler::RegisterColumn(const std::string &name)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto it = fColumnIds.find(name);
+   if (it != fColumnIds.end())
+      return it->second;
+   fNodes.push_back({ENodeKind::kColumn, name});
+   return fColumnIds[name] = fNodes.size() - 1;
+}
+
+void RProfiler::StartTask(unsigned int slot)
+{
+   auto &data = *fSlots[slot];
+   data.fTaskStart = Clock_t::now();
+   data.fTimesAtTaskStart = data.fTimes;
+}
+
+void RProfiler::EndTask(unsigned int slot)
+{
+   auto &data = *fSlots[slot];
+   ROOT::RDF::Experimental::RProfileReport::RTaskTimes task;
+   task.fSlot = slot;
+   task.fStart = std::chrono::duration<double>(data.fTaskStart - fLoopStart).count();
+   task.fEnd = std::chrono::duration<double>(Clock_t::now() - fLoopStart).count();
+   task.fNodeTimes = data.fTimes;
+   for (auto i = 0u; i < data.fTimesAtTaskStart.size(); ++i)
+      task.fNodeTimes[i] -= data.fTimesAtTaskStart[i];
+   data.fTasks.emplace_back(std::move(task));
+}
+
+/// Return the time spent by all slots in a node during the last event loop, or a negative value if it was not timed.
+double RProfiler::GetNodeTime(const void *node) const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto it = fNodeIds.find(node);
+   if (it == fNodeIds.end())
+      return -1.;
+   double t = 0.;
+   for (const auto &data : fSlots) {
+      if (it->second < data->fTimes.size())
+         t += data->fTimes[it->second];
+   }
+   return t;
+}
+
+ROOT::RDF::Experimental::RProfileReport RProfiler::MakeReport() const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   std::vector<ROOT::RDF::Experimental::RProfileReport::RNodeTimes> nodes(fNodes.size());
+   for (auto i = 0u; i < fNodes.size(); ++i) {
+      nodes[i].fKind = KindName(fNodes[i].fKind);
+      nodes[i].fName = fNodes[i].fName;
+      nodes[i].fSlotTimes.assign(fSlots.size(), 0.);
+      for (auto slot = 0u; slot < fSlots.size(); ++slot) {
+         const auto &data = *fSlots[slot];
+         if (i < data.fTimes.size()) {
+            nodes[i].fSlotTimes[slot] = data.fTimes[i];
+            nodes[i].fCalls += data.fCalls[i];
+         }
+      }
+   }
+
+   std::vector<ROOT::RDF::Experimental::RProfileReport::RTaskTimes> tasks;
+   for (const auto &data : fSlots)
+      tasks.insert(tasks.end(), data->fTasks.begin(), data->fTasks.end());
+   std::sort(tasks.begin(), tasks.end(), [](const auto &a, const auto &b) { return a.fStart < b.fStart; });
+
+   // nodes that were never evaluated, e.g. the jitted wrappers of concrete nodes, are not reported
+   std::vector<ROOT::RDF::Experimental::RProfileReport::RNodeTimes> usedNodes;
+   std::vector<std::size_t> usedIdx;
+   for (auto i = 0u; i < nodes.size(); ++i) {
+      if (nodes[i].fCalls > 0) {
+         usedNodes.emplace_back(std::move(nodes[i]));
+         usedIdx.emplace_back(i);
+      }
+   }
+   for (auto &task : tasks) {
+      std::vector<double> times(usedIdx.size(), 0.);
+      for (auto j = 0u; j < usedIdx.size(); ++j)
+         times[j] = usedIdx[j] < task.fNodeTimes.size() ? task.fNodeTimes[usedIdx[j]] : 0.;
+      task.fNodeTimes = std::move(times);
+   }
+
+   return ROOT::RDF::Experimental::RProfileReport(std::move(usedNodes), std::move(tasks));
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,108 @@
+// Author: Enrico Guiraud CERN 10/2024
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RResultCache.hxx"
+#include "TBufferFile.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TMD5.h"
+#include "TParameter.h"
+#include "TSystem.h"
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+std::string SerializeCachedObject(const TObject &obj)
+{
+   TBufferFile buffer(TBuffer::kWrite);
+   buffer.WriteObject(&obj);
+   return std::string(buffer.Buffer(), buffer.Length());
+}
+
+std::unique_ptr<TObject> LoadCachedObject(TDirectory &dir, const std::string &name)
+{
+   return std::unique_ptr<TObject>(dir.Get(name.c_str()));
+}
+
+void StoreCachedObject(TDirectory &dir, const std::string &name, const TObject &obj)
+{
+   dir.WriteTObject(&obj, name.c_str(), "Overwrite");
+}
+
+namespace {
+template <typename T>
+bool LoadParameter(TDirectory &dir, const std::string &name, T &value)
+{
+   std::unique_ptr<TParameter<T>> param(dir.Get<TParameter<T>>(name.c_str()));
+   if (!param)
+      return false;
+   value = param->GetVal();
+   return true;
+}
+} // anonymous namespace
+
+bool LoadCachedValue(TDirectory &dir, const std::string &name, Long64_t &value)
+{
+   return LoadParameter(dir, name, value);
+}
+
+bool LoadCachedValue(TDirectory &dir, const std::string &name, Double_t &value)
+{
+   return LoadParameter(dir, name, value);
+}
+
+void StoreCachedValue(TDirectory &dir, const std::string &name, Long64_t value)
+{
+   TParameter<Long64_t> param(name.c_str(), value);
+   dir.WriteTObject(&param, name.c_str(), "Overwrite");
+}
+
+void StoreCachedValue(TDirectory &dir, const std::string &name, Double_t value)
+{
+   TParameter<Double_t> param(name.c_str(), value);
+   dir.WriteTObject(&param, name.c_str(), "Overwrite");
+}
+
+/// The keys describe whole computation graphs and can be long: results are stored under the MD5 digest of their key.
+std::string RResultCache::MakeName(std::string_view key)
+{
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(key.data()), key.size());
+   md5.Final();
+   return std::string("rdfresult_") + md5.AsString();
+}
+
+bool RResultCache::Load(RCachedResultBase &result, std::string_view key) const
+{
+   // A missing cache file is simply an empty cache
+   if (gSystem->AccessPathName(fFileName.c_str()))
+      return false;
+   std::unique_ptr<TFile> file(TFile::Open(fFileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
+   if (!file || file->IsZombie())
+      return false;
+   return result.Load(*file, MakeName(key));
+}
+
+bool RResultCache::Store(const std::vector<std::pair<const RCachedResultBase *, std::string>> &results) const
+{
+   if (results.empty())
+      return true;
+   std::unique_ptr<TFile> file(TFile::Open(fFileName.c_str(), "UPDATE"));
+   if (!file || file->IsZombie())
+      return false;
+   for (const auto &[result, key] : results)
+      result->Store(*file, MakeName(key));
+   return true;
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
@@ -16,13 +16,16 @@
 #include "TSystem.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cctype>
 #include <cerrno>
-#include <cstring> // for memcpy
+#include <cstring> // for memset
 #include <ctime>
 #include <memory> // for placement new
 #include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <sqlite3.h>
 
@@ -313,6 +316,20 @@ bool RegisterSqliteVfs()
    return (retval == SQLITE_OK);
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// Number of rows fetched per slot in one call to GetEntryRanges()
+constexpr std::size_t kBatchRowsPerSlot = 1024;
+
+////////////////////////////////////////////////////////////////////////////
+/// Element access that grows the vector as needed
+template <typename T>
+T &GrowingAt(std::vector<T> &v, std::size_t i)
+{
+   if (v.size() <= i)
+      v.resize(i + 1);
+   return v[i];
+}
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -323,8 +340,23 @@ namespace Internal {
 ////////////////////////////////////////////////////////////////////////////
 /// The state of an open dataset in terms of the sqlite3 C library.
 struct RSqliteDSDataSet {
+   /// The values of a column for the rows of the current batch. Only the vector matching the column type is used.
+   struct RColumnBuffer {
+      std::vector<Long64_t> fIntegers;
+      std::vector<double> fReals;
+      std::vector<std::string> fTexts;
+      std::vector<std::vector<unsigned char>> fBlobs;
+   };
+
    sqlite3 *fDb = nullptr;
    sqlite3_stmt *fQuery = nullptr;
+   /// Set once the query returned SQLITE_DONE. Stepping further would restart the query.
+   bool fIsDone = false;
+   /// First entry and number of rows of the current batch
+   ULong64_t fBatchBegin = 0;
+   std::size_t fBatchSize = 0;
+   /// One buffer per column of the query, filled for the active columns
+   std::vector<RColumnBuffer> fBuffers;
 };
 }
 
@@ -381,7 +413,10 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
    if ((retval != SQLITE_ROW) && (retval != SQLITE_DONE))
       SqliteError(retval);
 
-   fValues.reserve(colCount);
+   fDataSet->fBuffers.resize(colCount);
+   // The values of the first slot; SetNSlots() adds the others
+   fValues.resize(1);
+   fValues[0].reserve(colCount);
    for (int i = 0; i < colCount; ++i) {
       fColumnNames.emplace_back(sqlite3_column_name(fDataSet->fQuery, i));
       int type = SQLITE_NULL;
@@ -409,24 +444,24 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
       switch (type) {
       case SQLITE_INTEGER:
          fColumnTypes.push_back(ETypes::kInteger);
-         fValues.emplace_back(ETypes::kInteger);
+         fValues[0].emplace_back(ETypes::kInteger);
          break;
       case SQLITE_FLOAT:
          fColumnTypes.push_back(ETypes::kReal);
-         fValues.emplace_back(ETypes::kReal);
+         fValues[0].emplace_back(ETypes::kReal);
          break;
       case SQLITE_TEXT:
          fColumnTypes.push_back(ETypes::kText);
-         fValues.emplace_back(ETypes::kText);
+         fValues[0].emplace_back(ETypes::kText);
          break;
       case SQLITE_BLOB:
          fColumnTypes.push_back(ETypes::kBlob);
-         fValues.emplace_back(ETypes::kBlob);
+         fValues[0].emplace_back(ETypes::kBlob);
          break;
       case SQLITE_NULL:
          // TODO: Null values in first rows are not well handled
          fColumnTypes.push_back(ETypes::kNull);
-         fValues.emplace_back(ETypes::kNull);
+         fValues[0].emplace_back(ETypes::kNull);
          break;
       default: throw std::runtime_error("Unhandled data type");
       }
@@ -471,27 +506,90 @@ RDataSource::Record_t RSqliteDS::GetColumnReadersImpl(std::string_view name, con
       throw std::runtime_error(errmsg);
    }
 
-   fValues[index].fIsActive = true;
-   return std::vector<void *>{fNSlots, &fValues[index].fPtr};
+   std::vector<void *> ptrs;
+   ptrs.reserve(fValues.size());
+   for (auto &slotValues : fValues) {
+      slotValues[index].fIsActive = true;
+      ptrs.emplace_back(&slotValues[index].fPtr);
+   }
+   return ptrs;
 }
 
 ////////////////////////////////////////////////////////////////////////////
-/// Returns a range of size 1 as long as more rows are available in the SQL result set.
-/// This inherently serialized the RDF independent of the number of slots.
+/// Fetches the next batch of rows from the SQL result set and splits it into one entry range per slot.
+/// Returns an empty vector once all the rows have been read.
 std::vector<std::pair<ULong64_t, ULong64_t>> RSqliteDS::GetEntryRanges()
 {
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   int retval = sqlite3_step(fDataSet->fQuery);
-   switch (retval) {
-   case SQLITE_DONE: return entryRanges;
-   case SQLITE_ROW:
-      entryRanges.emplace_back(fNRow, fNRow + 1);
-      fNRow++;
+   if (fDataSet->fIsDone)
       return entryRanges;
-   default:
-      SqliteError(retval);
-      // Never here
-      abort();
+
+   const std::size_t nSlots = std::max(fNSlots, 1u);
+   const std::size_t maxRows = kBatchRowsPerSlot * nSlots;
+   std::size_t nRows = 0;
+   while (nRows < maxRows) {
+      int retval = sqlite3_step(fDataSet->fQuery);
+      if (retval == SQLITE_DONE) {
+         fDataSet->fIsDone = true;
+         break;
+      }
+      if (retval != SQLITE_ROW)
+         SqliteError(retval);
+      FetchRow(nRows);
+      nRows++;
+   }
+   if (nRows == 0)
+      return entryRanges;
+
+   fDataSet->fBatchBegin = fNRow;
+   fDataSet->fBatchSize = nRows;
+   fNRow += nRows;
+
+   const auto nRanges = std::min(nSlots, nRows);
+   entryRanges.reserve(nRanges);
+   for (std::size_t i = 0; i < nRanges; ++i) {
+      entryRanges.emplace_back(fDataSet->fBatchBegin + i * nRows / nRanges,
+                               fDataSet->fBatchBegin + (i + 1) * nRows / nRanges);
+   }
+   return entryRanges;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Copies the active columns of the current sqlite row into the column buffers at the given row of the batch.
+void RSqliteDS::FetchRow(std::size_t row)
+{
+   const auto &columnValues = fValues[0];
+   unsigned N = columnValues.size();
+   for (unsigned i = 0; i < N; ++i) {
+      if (!columnValues[i].fIsActive)
+         continue;
+
+      auto &buffer = fDataSet->fBuffers[i];
+      switch (columnValues[i].fType) {
+      case ETypes::kInteger: GrowingAt(buffer.fIntegers, row) = sqlite3_column_int64(fDataSet->fQuery, i); break;
+      case ETypes::kReal: GrowingAt(buffer.fReals, row) = sqlite3_column_double(fDataSet->fQuery, i); break;
+      case ETypes::kText: {
+         auto &text = GrowingAt(buffer.fTexts, row);
+         // Following the sqlite documentation, the size is queried after the conversion to text
+         auto ptr = reinterpret_cast<const char *>(sqlite3_column_text(fDataSet->fQuery, i));
+         auto nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
+         if (nbytes == 0) {
+            text.clear();
+         } else {
+            text.assign(ptr, nbytes);
+         }
+         break;
+      }
+      case ETypes::kBlob: {
+         auto &blob = GrowingAt(buffer.fBlobs, row);
+         auto ptr = static_cast<const unsigned char *>(sqlite3_column_blob(fDataSet->fQuery, i));
+         auto nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
+         blob.assign(ptr, ptr + nbytes);
+         break;
+      }
+      case ETypes::kNull: break;
+      default: throw std::runtime_error("Unhandled column type");
+      }
    }
 }
 
@@ -521,6 +619,9 @@ bool RSqliteDS::HasColumn(std::string_view colName) const
 void RSqliteDS::Initialize()
 {
    fNRow = 0;
+   fDataSet->fIsDone = false;
+   fDataSet->fBatchBegin = 0;
+   fDataSet->fBatchSize = 0;
    int retval = sqlite3_reset(fDataSet->fQuery);
    if (retval != SQLITE_OK)
       throw std::runtime_error("SQlite error, reset");
@@ -542,35 +643,23 @@ RDataFrame FromSqlite(std::string_view fileName, std::string_view query)
 }
 
 ////////////////////////////////////////////////////////////////////////////
-/// Stores the result of the current active sqlite query row as a C++ value.
-bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
+/// Copies the values of the given entry of the current batch to the values of the slot.
+bool RSqliteDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
-   assert(entry + 1 == fNRow);
-   (void)entry;
-   unsigned N = fValues.size();
+   assert(entry >= fDataSet->fBatchBegin && entry < fDataSet->fBatchBegin + fDataSet->fBatchSize);
+   const auto row = entry - fDataSet->fBatchBegin;
+   auto &values = fValues[slot];
+   unsigned N = values.size();
    for (unsigned i = 0; i < N; ++i) {
-      if (!fValues[i].fIsActive)
+      if (!values[i].fIsActive)
          continue;
 
-      int nbytes;
-      switch (fValues[i].fType) {
-      case ETypes::kInteger: fValues[i].fInteger = sqlite3_column_int64(fDataSet->fQuery, i); break;
-      case ETypes::kReal: fValues[i].fReal = sqlite3_column_double(fDataSet->fQuery, i); break;
-      case ETypes::kText:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
-         if (nbytes == 0) {
-            fValues[i].fText = "";
-         } else {
-            fValues[i].fText = reinterpret_cast<const char *>(sqlite3_column_text(fDataSet->fQuery, i));
-         }
-         break;
-      case ETypes::kBlob:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
-         fValues[i].fBlob.resize(nbytes);
-         if (nbytes > 0) {
-            std::memcpy(fValues[i].fBlob.data(), sqlite3_column_blob(fDataSet->fQuery, i), nbytes);
-         }
-         break;
+      const auto &buffer = fDataSet->fBuffers[i];
+      switch (values[i].fType) {
+      case ETypes::kInteger: values[i].fInteger = buffer.fIntegers[row]; break;
+      case ETypes::kReal: values[i].fReal = buffer.fReals[row]; break;
+      case ETypes::kText: values[i].fText = buffer.fTexts[row]; break;
+      case ETypes::kBlob: values[i].fBlob = buffer.fBlobs[row]; break;
       case ETypes::kNull: break;
       default: throw std::runtime_error("Unhandled column type");
       }
@@ -579,14 +668,23 @@ bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-/// Almost a no-op, many slots can in fact reduce the performance due to thread synchronization.
+/// Creates the values of each slot. The rows are fetched from SQlite sequentially but processed in parallel.
 void RSqliteDS::SetNSlots(unsigned int nSlots)
 {
-   if (nSlots > 1) {
-      ::Warning("SetNSlots", "Currently the SQlite data source faces performance degradation in multi-threaded mode. "
-                             "Consider turning off IMT.");
-   }
    fNSlots = nSlots;
+   // The values of the first slot are created in the constructor
+   fValues.resize(std::max(nSlots, 1u));
+   const auto &columnValues = fValues[0];
+   for (std::size_t slot = 1; slot < fValues.size(); ++slot) {
+      auto &slotValues = fValues[slot];
+      slotValues.clear();
+      // Reserve upfront, the values must not be moved after their construction
+      slotValues.reserve(columnValues.size());
+      for (const auto &value : columnValues) {
+         slotValues.emplace_back(value.fType);
+         slotValues.back().fIsActive = value.fIsActive;
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,76 @@
+// Author: Jakob Blomer CERN 10/2024
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RTreeColumnReader.hxx"
+
+#include <TBranch.h>
+#include <TBufferFile.h>
+#include <TDataType.h>
+#include <TMath.h>
+#include <TTree.h>
+
+ROOT::Internal::RDF::RTreeBulkArrayReader::RTreeBulkArrayReader(TTreeReader &r, const std::string &branchName,
+                                                                const std::type_info &elementType)
+   : fTreeReader(r),
+     fBranchName(branchName),
+     fElementType(elementType),
+     fValues(std::make_unique<TBufferFile>(TBuffer::kWrite, 32 * 1024)),
+     fOffsets(std::make_unique<TBufferFile>(TBuffer::kWrite, 32 * 1024))
+{
+}
+
+ROOT::Internal::RDF::RTreeBulkArrayReader::~RTreeBulkArrayReader() = default;
+
+void *ROOT::Internal::RDF::RTreeBulkArrayReader::GetValues(std::size_t &size)
+{
+   TTree *tree = fTreeReader.GetTree();
+   if (!tree)
+      return nullptr;
+   // For a chain, the entries are read from its current tree
+   tree = tree->GetTree();
+   if (!tree)
+      return nullptr;
+
+   if (tree != fTree) {
+      fTree = tree;
+      fFirstEntry = -1;
+      fNEntries = 0;
+      fBranch = tree->GetBranch(fBranchName.c_str());
+      // Branches of friend trees have their own entry numbering
+      if (!fBranch || fBranch->GetTree() != tree)
+         return nullptr;
+      EDataType type = kOther_t;
+      if (!fBranch->GetBulkRead().SupportsVarLengthBulkRead(&type) || type != TDataType::GetType(fElementType))
+         return nullptr;
+      fElementSize = TDataType::GetDataType(type)->Size();
+   }
+   if (!fBranch)
+      return nullptr;
+
+   // The tree reader has already loaded the entry, so that the tree knows the local entry number
+   const Long64_t entry = tree->GetReadEntry();
+   if (entry < fFirstEntry || entry >= fFirstEntry + fNEntries) {
+      const Int_t basket = TMath::BinarySearch(fBranch->GetWriteBasket() + 1, fBranch->GetBasketEntry(), entry);
+      if (basket < 0)
+         return nullptr;
+      const Long64_t first = fBranch->GetBasketEntry()[basket];
+      const Int_t nEntries = fBranch->GetBulkRead().GetBulkEntries(first, *fValues, *fOffsets);
+      if (nEntries <= 0 || entry >= first + nEntries) {
+         fBranch = nullptr;
+         return nullptr;
+      }
+      fFirstEntry = first;
+      fNEntries = nEntries;
+   }
+
+   const auto offsets = reinterpret_cast<const Int_t *>(fOffsets->GetCurrent()) + (entry - fFirstEntry);
+   size = offsets[1] - offsets[0];
+   return fValues->GetCurrent() + offsets[0] * fElementSize;
+}
@@ -0,0 +1,142 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDF/PyROOTHelpers.hxx"
+#include "ROOT/RVec.hxx"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using ROOT::Internal::RDF::AsNumpyBuffers;
+using ROOT::Internal::RDF::RNumpyBuffers;
+
+namespace {
+template <typename T>
+const T *GetValues(const RNumpyBuffers &buffers, std::size_t i)
+{
+   return reinterpret_cast<const T *>(buffers.GetValuesAddress(i));
+}
+
+const ULong64_t *GetOffsets(const RNumpyBuffers &buffers, std::size_t i)
+{
+   return reinterpret_cast<const ULong64_t *>(buffers.GetOffsetsAddress(i));
+}
+
+/// Check that the rows hold x, x % 2 == 0 and x % 3 values equal to x, whatever their order
+void CheckRows(const RNumpyBuffers &buffers, std::vector<ULong64_t> expected)
+{
+   ASSERT_EQ(buffers.GetNEntries(), expected.size());
+   ASSERT_EQ(buffers.GetNColumns(), 3u);
+   EXPECT_FALSE(buffers.IsJagged(0));
+   EXPECT_FALSE(buffers.IsJagged(1));
+   ASSERT_TRUE(buffers.IsJagged(2));
+
+   auto x = GetValues<ULong64_t>(buffers, 0);
+   auto even = GetValues<unsigned char>(buffers, 1);
+   auto offsets = GetOffsets(buffers, 2);
+   auto values = GetValues<float>(buffers, 2);
+   EXPECT_EQ(offsets[0], 0u);
+   EXPECT_EQ(offsets[buffers.GetNEntries()], buffers.GetNValues(2));
+   for (ULong64_t i = 0; i < buffers.GetNEntries(); ++i) {
+      EXPECT_EQ(even[i], x[i] % 2 == 0);
+      ASSERT_EQ(offsets[i + 1] - offsets[i], x[i] % 3);
+      for (auto j = offsets[i]; j < offsets[i + 1]; ++j)
+         EXPECT_EQ(values[j], float(x[i]));
+   }
+   std::vector<ULong64_t> rows(x, x + buffers.GetNEntries());
+   std::sort(rows.begin(), rows.end());
+   EXPECT_EQ(rows, expected);
+}
+
+void TestAsNumpyBuffers()
+{
+   const ULong64_t nEntries = 20000;
+   ROOT::RDataFrame df(nEntries);
+   auto df2 = df.Define("x", [](ULong64_t e) { return e; }, {"rdfentry_"})
+                 .Define("even", [](ULong64_t x) { return x % 2 == 0; }, {"x"})
+                 .Define("v", [](ULong64_t x) { return ROOT::RVecF(x % 3, float(x)); }, {"x"});
+
+   std::vector<ULong64_t> all(nEntries);
+   std::iota(all.begin(), all.end(), 0);
+   CheckRows(AsNumpyBuffers<ULong64_t, bool, ROOT::RVecF>(df2, {"x", "even", "v"}, nEntries), all);
+
+   // With a filter, the number of entries comes from a count pass
+   auto filtered = df2.Filter([](ULong64_t x) { return x % 5 != 0; }, {"x"});
+   std::vector<ULong64_t> passing;
+   std::copy_if(all.begin(), all.end(), std::back_inserter(passing), [](ULong64_t x) { return x % 5 != 0; });
+   CheckRows(AsNumpyBuffers<ULong64_t, bool, ROOT::RVecF>(filtered, {"x", "even", "v"}), passing);
+
+   EXPECT_THROW((AsNumpyBuffers<ULong64_t, bool, ROOT::RVecF>(filtered, {"x", "even", "v"}, nEntries)),
+                std::runtime_error);
+}
+} // anonymous namespace
+
+TEST(RDataFrameAsNumpy, Buffers)
+{
+   TestAsNumpyBuffers();
+}
+
+#ifdef R__USE_IMT
+TEST(RDataFrameAsNumpy, BuffersMT)
+{
+   ROOT::EnableImplicitMT(4);
+   TestAsNumpyBuffers();
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+namespace {
+void Square(std::size_t n, const double *x, double *out)
+{
+   for (std::size_t i = 0; i < n; ++i)
+      out[i] = x[i] * x[i];
+}
+
+void SelectEven(std::size_t n, const ULong64_t *x, const unsigned char *even, unsigned char *mask)
+{
+   for (std::size_t i = 0; i < n; ++i)
+      mask[i] = even[i] && x[i] % 3 == 0;
+}
+
+void TestBatchCallbacks()
+{
+   const ULong64_t nEntries = 10000;
+   ROOT::RDataFrame df(nEntries);
+   ROOT::RDF::RNode df2 = df.Define("x", [](ULong64_t e) { return e; }, {"rdfentry_"})
+                             .Define("xd", [](ULong64_t x) { return double(x); }, {"x"})
+                             .Define("even", [](ULong64_t x) { return x % 2 == 0; }, {"x"});
+
+   auto defined = ROOT::Internal::RDF::DefineBatch<double, double>(df2, "x2", reinterpret_cast<ULong64_t>(&Square),
+                                                                   {"xd"}, 100);
+   auto nWrong = defined.Filter([](double xd, double x2) { return x2 != xd * xd; }, {"xd", "x2"}).Count();
+   auto sum = defined.Sum<double>("x2");
+   EXPECT_EQ(*nWrong, 0u);
+   EXPECT_DOUBLE_EQ(*sum, double(nEntries - 1) * nEntries * (2 * nEntries - 1) / 6);
+
+   // The batch callbacks also work downstream of a filter
+   auto filtered = df2.Filter([](ULong64_t x) { return x >= 100; }, {"x"});
+   auto selected = ROOT::Internal::RDF::FilterBatch<ULong64_t, bool>(
+      filtered, reinterpret_cast<ULong64_t>(&SelectEven), {"x", "even"}, "even and multiple of 3", 64);
+   auto nSelected = selected.Count();
+   auto nNotSelected = selected.Filter([](ULong64_t x) { return x % 6 != 0; }, {"x"}).Count();
+   // the multiples of 6 in [100, nEntries)
+   EXPECT_EQ(*nSelected, (nEntries - 1) / 6 - 99 / 6);
+   EXPECT_EQ(*nNotSelected, 0u);
+}
+} // anonymous namespace
+
+TEST(RDataFrameAsNumpy, BatchCallbacks)
+{
+   TestBatchCallbacks();
+}
+
+#ifdef R__USE_IMT
+TEST(RDataFrameAsNumpy, BatchCallbacksMT)
+{
+   ROOT::EnableImplicitMT(4);
+   TestBatchCallbacks();
+   ROOT::DisableImplicitMT();
+}
+#endif
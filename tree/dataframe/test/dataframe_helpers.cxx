@@ -689,6 +689,48 @@ TEST(RunGraphs, AlreadyRun)
                        "Got 4 handles from which 2 link to results which are already ready.");
 }
 
+TEST(RunGraphs, SharedScan)
+{
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif // R__USE_IMT
+
+   const auto fname = "dataframe_helpers_sharedscan.root";
+   ROOT::RDataFrame(10).Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>("t", fname, {"x"});
+
+   // Graphs on the same dataset are processed entry by entry in the same event loop
+   std::vector<std::string> order;
+   auto record = [&order](const std::string &name) {
+      return [&order, name](int x) {
+         order.emplace_back(name + std::to_string(x));
+         return x;
+      };
+   };
+   ROOT::RDataFrame df1("t", fname);
+   auto r1 = df1.Define("y", record("a"), {"x"}).Sum<int>("y");
+   ROOT::RDataFrame df2("t", fname);
+   auto r2 = df2.Define("y", record("b"), {"x"}).Range(2).Sum<int>("y");
+   // a different range of entries is a different dataset
+   ROOT::RDF::Experimental::RDatasetSpec spec;
+   spec.AddSample(ROOT::RDF::Experimental::RSample("s", "t", fname)).WithGlobalRange({5, 10});
+   ROOT::RDataFrame df3(spec);
+   auto r3 = df3.Count();
+
+   EXPECT_EQ(ROOT::RDF::RunGraphs({r1, r2, r3}), 3u);
+
+   EXPECT_EQ(df1.GetNRuns(), 1u);
+   EXPECT_EQ(df2.GetNRuns(), 1u);
+   EXPECT_EQ(df3.GetNRuns(), 1u);
+   EXPECT_EQ(*r1, 45);
+   EXPECT_EQ(*r2, 1);
+   EXPECT_EQ(*r3, 5u);
+   // the Range stops the second graph only
+   const std::vector<std::string> expected{"a0", "b0", "a1", "b1", "a2", "a3", "a4", "a5", "a6", "a7", "a8", "a9"};
+   EXPECT_EQ(order, expected);
+
+   gSystem->Unlink(fname);
+}
+
 int ret42 () {return 42;}
 int ret1 () {return 1;}
 
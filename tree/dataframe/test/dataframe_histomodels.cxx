@@ -346,3 +346,91 @@ TEST(RDataFrameHisto, FillVecBool)
     EXPECT_EQ(h->GetBinContent(2), n);
     EXPECT_EQ(h->GetBinContent(3), 0u);
 }
+
+// One-dimensional histograms with a model are filled in blocks with TH1::FillN
+TEST(RDataFrameHisto, FillNBlocks)
+{
+   const auto n = 1000u;
+   ROOT::RDataFrame df(n);
+   auto d = df.Define("x", [](ULong64_t e) { return (e * 37) % 101 / 10.; }, {"rdfentry_"})
+               .Define("w", [](ULong64_t e) { return 1. + e % 3; }, {"rdfentry_"})
+               .Define("v", [](double x) { return ROOT::RVecF{float(x), float(x / 2)}; }, {"x"});
+   auto h = d.Histo1D<double>({"h", "h", 10, 0, 10}, "x");
+   auto hw = d.Histo1D<double, double>({"hw", "hw", 10, 0, 10}, "x", "w");
+   auto hv = d.Histo1D<ROOT::RVecF>({"hv", "hv", 10, 0, 10}, "v");
+   unsigned int nPartial = 0;
+   h.OnPartialResult(300, [&nPartial](TH1D &partial) { EXPECT_EQ(300 * ++nPartial, partial.GetEntries()); });
+
+   TH1D ref("ref", "ref", 10, 0, 10);
+   TH1D refw("refw", "refw", 10, 0, 10);
+   TH1D refv("refv", "refv", 10, 0, 10);
+   for (ULong64_t e = 0; e < n; ++e) {
+      const double x = (e * 37) % 101 / 10.;
+      ref.Fill(x);
+      refw.Fill(x, 1. + e % 3);
+      refv.Fill(float(x));
+      refv.Fill(float(x / 2));
+   }
+
+   EXPECT_EQ(3u, nPartial);
+   for (auto [res, exp] : {std::make_pair(h.GetPtr(), &ref), std::make_pair(hw.GetPtr(), &refw),
+                           std::make_pair(hv.GetPtr(), &refv)}) {
+      EXPECT_EQ(exp->GetEntries(), res->GetEntries());
+      EXPECT_DOUBLE_EQ(exp->GetMean(), res->GetMean());
+      EXPECT_DOUBLE_EQ(exp->GetStdDev(), res->GetStdDev());
+      for (int i = 0; i <= exp->GetNbinsX() + 1; ++i)
+         EXPECT_DOUBLE_EQ(exp->GetBinContent(i), res->GetBinContent(i));
+   }
+}
+
+// The shared atomic fill strategy fills the same histogram from all slots and must yield the per-slot result
+TEST(RDataFrameHisto, SharedAtomicFill)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   {
+      ROOT::RDataFrame df(10000);
+      auto d = df.Define("x", [](ULong64_t e) { return (e * 37) % 101 / 10. - 1.; }, {"rdfentry_"})
+                  .Define("y", [](ULong64_t e) { return (e * 13) % 7; }, {"rdfentry_"})
+                  .Define("w", [](ULong64_t e) { return 1. + e % 3; }, {"rdfentry_"})
+                  .Define("v", [](double x) { return ROOT::RVecD{x, x / 2}; }, {"x"});
+
+      TH1DModel m1("h1", "h1", 10, 0, 10);
+      TH2DModel m2("h2", "h2", 10, 0, 10, 5, 0, 5);
+      TH3DModel m3("h3", "h3", 10, 0, 10, 5, 0, 5, 2, 0, 2);
+      auto ref1 = d.Histo1D<double, double>(m1, "x", "w");
+      auto ref1v = d.Histo1D<ROOT::RVecD>(m1, "v");
+      auto ref2 = d.Histo2D<double, ULong64_t>(m2, "x", "y");
+      auto ref3 = d.Histo3D(m3, "x", "y", "w", "w");
+      m1.fFillStrategy = m2.fFillStrategy = m3.fFillStrategy = EFillStrategy::kSharedAtomic;
+      auto h1 = d.Histo1D<double, double>(m1, "x", "w");
+      auto h1v = d.Histo1D<ROOT::RVecD>(m1, "v");
+      auto h2 = d.Histo2D<double, ULong64_t>(m2, "x", "y");
+      auto h3 = d.Histo3D(m3, "x", "y", "w", "w");
+
+      for (auto [res, exp] : {std::make_pair<TH1 *, TH1 *>(h1.GetPtr(), ref1.GetPtr()),
+                              std::make_pair<TH1 *, TH1 *>(h1v.GetPtr(), ref1v.GetPtr()),
+                              std::make_pair<TH1 *, TH1 *>(h2.GetPtr(), ref2.GetPtr()),
+                              std::make_pair<TH1 *, TH1 *>(h3.GetPtr(), ref3.GetPtr())}) {
+         EXPECT_EQ(exp->GetEntries(), res->GetEntries());
+         for (int axis = 1; axis <= exp->GetDimension(); ++axis) {
+            EXPECT_NEAR(exp->GetMean(axis), res->GetMean(axis), 1e-9);
+            EXPECT_NEAR(exp->GetStdDev(axis), res->GetStdDev(axis), 1e-9);
+         }
+         EXPECT_EQ(exp->GetSumw2N(), res->GetSumw2N());
+         for (int i = 0; i < exp->GetNcells(); ++i) {
+            EXPECT_DOUBLE_EQ(exp->GetBinContent(i), res->GetBinContent(i));
+            EXPECT_DOUBLE_EQ(exp->GetBinError(i), res->GetBinError(i));
+         }
+      }
+
+      // histograms that extend their axes cannot be filled concurrently
+      TH1DModel mAuto("hAuto", "hAuto", 10, 0, 0);
+      mAuto.fFillStrategy = EFillStrategy::kSharedAtomic;
+      EXPECT_THROW(d.Histo1D<double>(mAuto, "x"), std::invalid_argument);
+   }
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
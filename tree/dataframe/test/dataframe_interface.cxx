@@ -6,6 +6,7 @@
 #include <string_view>
 #include "ROOT/RTrivialDS.hxx"
 #include "ROOT/TestSupport.hxx"
+#include "TEnv.h"
 #include "TMemFile.h"
 #include "TSystem.h"
 #include "TTree.h"
@@ -977,3 +978,35 @@ TEST(RDataFrameInterface, GetNFilesFromMoreFiles)
    ROOT::RDataFrame df{"t", filenames};
    EXPECT_EQ(df.GetNFiles(), 3);
 }
+
+TEST(RDataFrameInterface, JitCacheDir)
+{
+   const std::string cacheDir = "dataframe_interface_jitcache";
+   gEnv->SetValue("RDataFrame.JitCacheDir", cacheDir.c_str());
+
+   // a unique expression, so that it is not already declared by the other tests
+   ROOT::RDataFrame df(4);
+   auto sum = df.Define("x", "rdfentry_ * 3 + 17").Sum<ULong64_t>("x");
+   EXPECT_EQ(*sum, 3ull * (0 + 1 + 2 + 3) + 4 * 17);
+   gEnv->SetValue("RDataFrame.JitCacheDir", "");
+
+   // the library built for the expression stays in the cache for the next processes
+   void *dir = gSystem->OpenDirectory(cacheDir.c_str());
+   ASSERT_NE(dir, nullptr);
+   std::vector<std::string> entries;
+   while (const char *entry = gSystem->GetDirEntry(dir))
+      entries.emplace_back(entry);
+   gSystem->FreeDirectory(dir);
+
+   const std::string libSuffix = std::string("_h.") + gSystem->GetSoExt();
+   bool foundLibrary = false;
+   for (const auto &name : entries) {
+      if (name.find("rdfjit_") == 0 && name.size() > libSuffix.size() &&
+          name.compare(name.size() - libSuffix.size(), libSuffix.size(), libSuffix) == 0)
+         foundLibrary = true;
+      if (name != "." && name != "..")
+         gSystem->Unlink((cacheDir + "/" + name).c_str());
+   }
+   gSystem->Unlink(cacheDir.c_str());
+   EXPECT_TRUE(foundLibrary);
+}
@@ -348,6 +348,66 @@ TEST(RDataFrameMergeResults, Merge5Hists)
    EXPECT_DOUBLE_EQ(mh.GetMean(), 49.5);
 }
 
+TEST(RDataFrameMergeResults, MergeVectorOfValues)
+{
+   ROOT::RDataFrame df{100};
+   auto col1 = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+
+   // partial results of 7 ranges of entries
+   std::vector<ROOT::RDF::RResultPtr<TH1D>> hists;
+   std::vector<ROOT::RDF::RResultPtr<double>> sums;
+   for (auto i = 0u; i < 7u; ++i) {
+      auto range = col1.Filter([i](ULong64_t e) { return e * 7 / 100 == i; }, {"rdfentry_"});
+      hists.emplace_back(range.Histo1D<double>({"h", "h", 10, 0., 100.}, "x"));
+      sums.emplace_back(range.Sum<double>("x"));
+   }
+   std::vector<std::unique_ptr<ROOT::Detail::RDF::RMergeableValue<TH1D>>> mhists;
+   std::vector<std::unique_ptr<ROOT::Detail::RDF::RMergeableValue<double>>> msums;
+   for (auto i = 0u; i < 7u; ++i) {
+      mhists.emplace_back(GetMergeableValue(hists[i]));
+      msums.emplace_back(GetMergeableValue(sums[i]));
+   }
+
+   auto mergedh = MergeValues(std::move(mhists));
+   auto mergeds = MergeValues(std::move(msums));
+
+   EXPECT_EQ(mergedh->GetValue().GetEntries(), 100);
+   EXPECT_DOUBLE_EQ(mergedh->GetValue().GetMean(), 49.5);
+   for (int bin = 1; bin <= 10; ++bin)
+      EXPECT_EQ(mergedh->GetValue().GetBinContent(bin), 10);
+   EXPECT_DOUBLE_EQ(mergeds->GetValue(), 4950.);
+
+   EXPECT_THROW(MergeValues(std::vector<std::unique_ptr<ROOT::Detail::RDF::RMergeableValue<double>>>{}),
+                std::invalid_argument);
+}
+
+TEST(RDataFrameMergeResults, MergeVectorOfVariations)
+{
+   auto df = ROOT::RDataFrame(10).Define("x", [] { return 1; });
+   auto h = df.Vary(
+                 "x",
+                 []() {
+                    return ROOT::RVecI{-1, 2};
+                 },
+                 {}, 2)
+               .Histo1D<int>("x");
+   auto hs = ROOT::RDF::Experimental::VariationsFor(h);
+
+   std::vector<std::unique_ptr<ROOT::Detail::RDF::RMergeableVariations<TH1D>>> partials;
+   for (auto i = 0; i < 3; ++i)
+      partials.emplace_back(GetMergeableValue(hs));
+   auto merged = MergeValues(std::move(partials));
+
+   std::vector<int> expectedmeans{1, -1, 2};
+   const auto &keys = merged->GetKeys();
+   ASSERT_EQ(keys.size(), 3u);
+   for (auto i = 0; i < 3; i++) {
+      const auto &histo = merged->GetVariation(keys[i]);
+      EXPECT_EQ(histo.GetMean(), expectedmeans[i]);
+      EXPECT_EQ(histo.GetEntries(), 30);
+   }
+}
+
 TEST(RDataFrameMergeResults, WrongMergeMinMax)
 {
    // Tricky case: two results of the same type with the same RMergeableValue subclass, different action helper.
@@ -41,6 +41,27 @@ TEST(RDataFrameNodes, RSlotStackPutBackTooMany)
    EXPECT_DEATH(theTest(), "Trying to put back a slot to a full stack!");
 }
 
+TEST(RDataFrameNodes, RSlotStackPrefersLastSlot)
+{
+   ROOT::Internal::RSlotStack s(4);
+   const auto first = s.GetSlot();
+   const auto second = s.GetSlot();
+   EXPECT_NE(first, second);
+   s.ReturnSlot(first);
+   s.ReturnSlot(second);
+   // the slot taken last by this thread is handed out again
+   EXPECT_EQ(s.GetSlot(), second);
+   s.ReturnSlot(second);
+
+   unsigned int otherSlot = 0;
+   std::thread([&s, &otherSlot]() {
+      ROOT::Internal::RSlotStackRAII raii(s);
+      otherSlot = raii.fSlot;
+   }).join();
+   EXPECT_EQ(s.GetSlot(), second);
+   EXPECT_LT(otherSlot, 4u);
+}
+
 #endif
 
 TEST(RDataFrameNodes, RLoopManagerGetLoopManagerUnchecked)
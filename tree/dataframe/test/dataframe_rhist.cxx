@@ -0,0 +1,103 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDF/RHistFillHelper.hxx>
+#include <ROOT/RHist.hxx>
+#include <TH2.h>
+#include <TROOT.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+
+using namespace ROOT::Experimental;
+
+using RHistFillHelper2D = RDF::RHistFillHelper<RH2D, RAxisEquidistant, RAxisIrregular>;
+
+// x in [-0.5, 10.5) and y in [-1, 11): some entries go to the under- and overflow bins
+static double X(ULong64_t e)
+{
+   return (e % 110) * 0.1 - 0.5;
+}
+static float Y(ULong64_t e)
+{
+   return float((e * 7) % 12) - 1.f;
+}
+static double W(ULong64_t e)
+{
+   return 1. + e % 3;
+}
+
+static const int kNEntries = 10000;
+
+static ROOT::RDF::RNode MakeDataFrame()
+{
+   return ROOT::RDataFrame(kNEntries)
+      .Define("x", X, {"rdfentry_"})
+      .Define("y", Y, {"rdfentry_"})
+      .Define("w", W, {"rdfentry_"});
+}
+
+static std::shared_ptr<RH2D> MakeHist()
+{
+   return std::make_shared<RH2D>("h", RAxisConfig(20, 0., 10.), RAxisConfig({0., 1., 2., 5., 10.}));
+}
+
+void CheckRHistFill()
+{
+   auto df = MakeDataFrame();
+   auto hist = MakeHist();
+   auto result = df.Book<double, float, double>(RHistFillHelper2D(hist, df.GetNSlots()), {"x", "y", "w"});
+
+   const std::vector<double> yEdges{0., 1., 2., 5., 10.};
+   auto classic = df.Histo2D<double, float, double>({"classic", "classic", 20, 0., 10., 4, yEdges.data()}, "x", "y", "w");
+
+   // the same entries, filled one by one
+   auto reference = MakeHist();
+   for (ULong64_t e = 0; e < kNEntries; ++e)
+      reference->Fill({X(e), Y(e)}, W(e));
+
+   EXPECT_EQ(result->GetEntries(), kNEntries);
+   const auto *impl = result->GetImpl();
+   const auto *referenceImpl = reference->GetImpl();
+   for (int bin = -impl->GetNOverflowBins(); bin <= impl->GetNBinsNoOver(); ++bin) {
+      if (bin == 0)
+         continue;
+      // weights are integers, so the sums do not depend on the order of the entries
+      EXPECT_EQ(impl->GetBinContentAsDouble(bin), referenceImpl->GetBinContentAsDouble(bin)) << "bin " << bin;
+      EXPECT_EQ(impl->GetBinUncertainty(bin), referenceImpl->GetBinUncertainty(bin)) << "bin " << bin;
+   }
+
+   // compare with a TH2D filled with the same entries
+   auto th2 = RDF::ConvertToTH1(*result);
+   ASSERT_EQ(th2->GetNcells(), classic->GetNcells());
+   EXPECT_EQ(th2->GetEntries(), classic->GetEntries());
+   EXPECT_TRUE(th2->GetSumw2N());
+   for (int bin = 0; bin < classic->GetNcells(); ++bin) {
+      EXPECT_EQ(th2->GetBinContent(bin), classic->GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(th2->GetBinError(bin), classic->GetBinError(bin)) << "bin " << bin;
+   }
+   // the statistics of the converted histogram are computed from the bin centres
+   classic->ResetStats();
+   EXPECT_DOUBLE_EQ(th2->GetMean(1), classic->GetMean(1));
+   EXPECT_DOUBLE_EQ(th2->GetMean(2), classic->GetMean(2));
+}
+
+TEST(RDFRHist, Fill)
+{
+   CheckRHistFill();
+}
+
+#ifdef R__USE_IMT
+TEST(RDFRHist, FillMT)
+{
+   ROOT::EnableImplicitMT(4);
+   CheckRHistFill();
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+TEST(RDFRHist, AxisMismatch)
+{
+   using WrongHelper = RDF::RHistFillHelper<RH2D, RAxisEquidistant, RAxisEquidistant>;
+   EXPECT_THROW(WrongHelper(MakeHist(), 1), std::invalid_argument);
+}
@@ -17,6 +17,8 @@
 #include <algorithm> // std::sort
 #include <array>
 #include <chrono>
+#include <fstream>
+#include <numeric>
 #include <thread>
 #include <set>
 #include <random>
@@ -1082,6 +1084,133 @@ TEST_P(RDFSimpleTests, ReadStdArray)
    }
 }
 
+TEST_P(RDFSimpleTests, SlotBusyTimes)
+{
+   ROOT::RDataFrame df(1000);
+   EXPECT_TRUE(df.GetSlotBusyTimes().empty());
+   auto count = df.Define("x", [] { return std::sqrt(2.); }).Filter([](double x) { return x > 1.; }, {"x"}).Count();
+   EXPECT_EQ(*count, 1000ull);
+   const auto busyTimes = df.GetSlotBusyTimes();
+   ASSERT_EQ(busyTimes.size(), df.GetNSlots());
+   for (auto t : busyTimes)
+      EXPECT_GE(t, 0.);
+   EXPECT_GT(std::accumulate(busyTimes.begin(), busyTimes.end(), 0.), 0.);
+}
+
+TEST_P(RDFSimpleTests, ProfileReport)
+{
+   ROOT::RDataFrame df(1000);
+   EXPECT_TRUE(df.GetProfileReport().GetNodes().empty());
+   df.EnableProfiling();
+   auto count = df.Define("x", [] { return std::sqrt(2.); })
+                   .Filter([](double x) { return x > 1.; }, {"x"}, "xcut")
+                   .Count();
+   EXPECT_EQ(*count, 1000ull);
+
+   const auto report = df.GetProfileReport();
+   const auto &nodes = report.GetNodes();
+   ASSERT_EQ(nodes.size(), 3u);
+   std::set<std::string> kindsAndNames;
+   for (const auto &n : nodes) {
+      kindsAndNames.insert(n.fKind + ":" + n.fName);
+      EXPECT_EQ(n.fCalls, 1000ull);
+      ASSERT_EQ(n.fSlotTimes.size(), df.GetNSlots());
+      EXPECT_GE(n.GetTotalTime(), 0.);
+   }
+   EXPECT_EQ(kindsAndNames, (std::set<std::string>{"Define:x", "Filter:xcut", "Action:Count"}));
+   ASSERT_FALSE(report.GetTasks().empty());
+   for (const auto &t : report.GetTasks()) {
+      EXPECT_LE(t.fStart, t.fEnd);
+      EXPECT_EQ(t.fNodeTimes.size(), nodes.size());
+   }
+
+   const auto fname = std::string("dataframe_simple_profile") + (GetParam() ? "_mt" : "") + ".json";
+   report.SaveChromeTrace(fname);
+   std::ifstream f(fname);
+   std::string content((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+   EXPECT_NE(content.find("\"traceEvents\""), std::string::npos);
+   EXPECT_NE(content.find("Filter xcut"), std::string::npos);
+   gSystem->Unlink(fname.c_str());
+}
+
+TEST_P(RDFSimpleTests, RVecArenas)
+{
+   auto book = [](ROOT::RDF::RNode df) {
+      auto d = df.Define("n", [](ULong64_t e) { return int(e % 50); }, {"rdfentry_"})
+                  .Define("v",
+                          [](int n) {
+                             ROOT::RVecF v;
+                             for (int i = 0; i < n; ++i)
+                                v.push_back(i);
+                             return v;
+                          },
+                          {"n"})
+                  .Define("w", [](const ROOT::RVecF &v) { return v[v > 10.f] * 2.f; }, {"v"})
+                  .Define("s", [](const ROOT::RVecF &w) { return ROOT::RVec<std::string>(w.size(), "x"); }, {"w"});
+      return std::make_pair(d.Sum<ROOT::RVecF>("w"), d.Take<ROOT::RVecF>("w"));
+   };
+
+   ROOT::RDataFrame df(1000);
+   auto expected = book(df);
+
+   ROOT::RDataFrame dfArena(1000);
+   dfArena.EnableRVecArenas();
+   auto res = book(dfArena);
+
+   EXPECT_DOUBLE_EQ(*res.first, *expected.first);
+   auto taken = *res.second;
+   auto expectedTaken = *expected.second;
+   std::sort(taken.begin(), taken.end(), [](const ROOT::RVecF &a, const ROOT::RVecF &b) { return a.size() < b.size(); });
+   std::stable_sort(expectedTaken.begin(), expectedTaken.end(),
+                    [](const ROOT::RVecF &a, const ROOT::RVecF &b) { return a.size() < b.size(); });
+   ASSERT_EQ(taken.size(), expectedTaken.size());
+   for (std::size_t i = 0; i < taken.size(); ++i)
+      EXPECT_TRUE(All(taken[i] == expectedTaken[i]));
+}
+
+TEST_P(RDFSimpleTests, ResultCache)
+{
+   const std::string suffix = GetParam() ? "_mt" : "";
+   const auto fileName = "dataframe_simple_resultcache" + suffix + ".root";
+   const auto cacheName = "dataframe_simple_resultcache_results" + suffix + ".root";
+   gSystem->Unlink(cacheName.c_str());
+   ROOT::RDataFrame(100).Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"}).Snapshot("t", fileName);
+
+   for (auto i : {0, 1}) {
+      ROOT::RDataFrame df("t", fileName);
+      df.EnableResultCache(cacheName);
+      auto f = df.Define("y", "x * 2").Filter("y > 50");
+      auto h = f.Histo1D<double>({"h", "h", 10, 0., 200.}, "y");
+      auto m = f.Mean("y");
+      auto c = f.Count();
+      EXPECT_EQ(*c, 74ull);
+      EXPECT_DOUBLE_EQ(*m, 125.);
+      EXPECT_EQ(h->GetEntries(), 74);
+      EXPECT_DOUBLE_EQ(h->GetMean(), 125.);
+      // the second time all results are loaded from the cache and the event loop does not run
+      EXPECT_EQ(df.GetSlotBusyTimes().empty(), i == 1);
+   }
+
+   // a different histogram model is a different result
+   ROOT::RDataFrame df("t", fileName);
+   df.EnableResultCache(cacheName);
+   auto h = df.Define("y", "x * 2").Filter("y > 50").Histo1D<double>({"h", "h", 20, 0., 200.}, "y");
+   EXPECT_EQ(h->GetEntries(), 74);
+   EXPECT_FALSE(df.GetSlotBusyTimes().empty());
+
+   // results computed with C++ callables are never cached
+   for (auto i : {0, 1}) {
+      ROOT::RDataFrame df2("t", fileName);
+      df2.EnableResultCache(cacheName);
+      auto s = df2.Filter([](double x) { return x < 10; }, {"x"}).Sum<double>("x");
+      EXPECT_DOUBLE_EQ(*s, 45.);
+      EXPECT_FALSE(df2.GetSlotBusyTimes().empty()) << "iteration " << i;
+   }
+
+   gSystem->Unlink(fileName.c_str());
+   gSystem->Unlink(cacheName.c_str());
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_SUITE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
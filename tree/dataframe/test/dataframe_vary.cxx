@@ -3,6 +3,8 @@
 #include <ROOT/RDFHelpers.hxx>
 #include <TSystem.h>
 
+#include <functional>
+#include <map>
 #include <thread> // std::thread::hardware_concurrency
 
 #include "SimpleFiller.h" // for VaryFill
@@ -1347,6 +1349,60 @@ TEST_P(RDFVary, VaryHistos)
    delete res;
 }
 
+// Histo1D/2D/3D with axes, Sum and Count fill all their variations at once, check they match unvaried results
+TEST_P(RDFVary, VariationsFilledTogether)
+{
+   auto df = ROOT::RDataFrame(100).Define("x", [](ULong64_t e) { return double(e % 10); }, {"rdfentry_"});
+   auto dfv = df.Vary("x", [](double x) { return ROOT::RVecD{x * 0.5, x + 1.}; }, {"x"}, {"down", "up"})
+                 .Define("w", [](double x) { return 1. + x / 10.; }, {"x"})
+                 .Filter([](double x) { return x != 3.; }, {"x"});
+
+   auto h1 = dfv.Histo1D<double, double>({"h1", "h1", 5, 0., 8.}, "x", "w");
+   auto h2 = dfv.Histo2D<double, double>({"h2", "h2", 5, 0., 8., 4, 2., 6.}, "x", "x");
+   // variable bin widths
+   const double xbins[] = {0., 1., 2.5, 4., 10.};
+   const ROOT::RDF::TH3DModel h3Model{"h3", "h3", 4, xbins, 4, xbins, 4, xbins};
+   auto h3 = dfv.Histo3D<double, double, double, double>(h3Model, "x", "x", "x", "w");
+   auto sum = dfv.Sum<double>("x");
+   auto count = dfv.Count();
+   auto h1s = VariationsFor(h1);
+   auto h2s = VariationsFor(h2);
+   auto h3s = VariationsFor(h3);
+   auto sums = VariationsFor(sum);
+   auto counts = VariationsFor(count);
+
+   const std::map<std::string, std::function<double(double)>> variations{
+      {"nominal", [](double x) { return x; }},
+      {"x:down", [](double x) { return x * 0.5; }},
+      {"x:up", [](double x) { return x + 1.; }}};
+   for (const auto &[name, vary] : variations) {
+      auto ref = df.Define("xv", vary, {"x"})
+                    .Define("w", [](double x) { return 1. + x / 10.; }, {"xv"})
+                    .Filter([](double x) { return x != 3.; }, {"xv"});
+      auto refH1 = ref.Histo1D<double, double>({"h1", "h1", 5, 0., 8.}, "xv", "w");
+      auto refH2 = ref.Histo2D<double, double>({"h2", "h2", 5, 0., 8., 4, 2., 6.}, "xv", "xv");
+      auto refH3 = ref.Histo3D<double, double, double, double>(h3Model, "xv", "xv", "xv", "w");
+      auto refSum = ref.Sum<double>("xv");
+      auto refCount = ref.Count();
+
+      const std::vector<std::pair<const TH1 *, const TH1 *>> hists{
+         {&h1s[name], refH1.GetPtr()}, {&h2s[name], refH2.GetPtr()}, {&h3s[name], refH3.GetPtr()}};
+      for (const auto &[h, refH] : hists) {
+         ASSERT_EQ(h->GetNcells(), refH->GetNcells());
+         for (int bin = 0; bin < h->GetNcells(); ++bin) {
+            EXPECT_DOUBLE_EQ(h->GetBinContent(bin), refH->GetBinContent(bin)) << name << " " << h->GetName();
+            EXPECT_DOUBLE_EQ(h->GetBinError(bin), refH->GetBinError(bin)) << name << " " << h->GetName();
+         }
+         EXPECT_DOUBLE_EQ(h->GetEntries(), refH->GetEntries()) << name << " " << h->GetName();
+         EXPECT_DOUBLE_EQ(h->GetMean(), refH->GetMean()) << name << " " << h->GetName();
+         EXPECT_DOUBLE_EQ(h->GetStdDev(), refH->GetStdDev()) << name << " " << h->GetName();
+         EXPECT_DOUBLE_EQ(h->GetMean(2), refH->GetMean(2)) << name << " " << h->GetName();
+      }
+      EXPECT_DOUBLE_EQ(sums[name], *refSum) << name;
+      EXPECT_EQ(counts[name], *refCount) << name;
+   }
+}
+
 TEST_P(RDFVary, VaryMax)
 {
    auto h = ROOT::RDataFrame(10)
@@ -43,6 +43,20 @@ TEST(RDFAndVecOps, DefineRVec)
    EXPECT_DOUBLE_EQ(max, 3.);
 }
 
+TEST(RDFAndVecOps, DefineLazyExpression)
+{
+   auto df = RDataFrame(3).Define("x", [] { return RVec<double>{3., 4., -5.}; });
+   auto d = df.Define("y", [](const RVec<double> &x) { return sqrt(Lazy(x) * x) + 1.; }, {"x"})
+               .Define("z", "abs(Lazy(x)) > 3.5 && Lazy(x) < 4.5");
+   EXPECT_EQ(d.GetColumnType("y"), "ROOT::VecOps::RVec<double>");
+   EXPECT_EQ(d.GetColumnType("z"), "ROOT::VecOps::RVec<int>");
+   auto check = [](const RVec<double> &y, const RVec<int> &z) {
+      EXPECT_TRUE(All(y == RVec<double>{4., 5., 6.}));
+      EXPECT_TRUE(All(z == RVec<int>{0, 1, 1}));
+   };
+   d.Foreach(check, {"y", "z"});
+}
+
 TEST(RDFAndVecOps, SnapshotRVec)
 {
    // write RVec to file
@@ -129,3 +143,58 @@ TEST(RDFAndVecOps, RVecBool)
    gSystem->Unlink(filename);
 }
 
+
+TEST(RDFAndVecOps, ReadJaggedBranchesInBulk)
+{
+   const auto filename = "rdfjaggedbulk.root";
+   const auto treename = "t";
+   const auto nEntries = 5000;
+   {
+      TFile f(filename, "RECREATE");
+      TTree t(treename, treename);
+      int n = 0;
+      float arr[16];
+      std::vector<double> vec;
+      t.Branch("n", &n);
+      t.Branch("arr", arr, "arr[n]/F", 1024);
+      t.Branch("vec", &vec, 1024);
+      for (int i = 0; i < nEntries; ++i) {
+         n = i % 16;
+         vec.clear();
+         for (int j = 0; j < n; ++j) {
+            arr[j] = i + j;
+            vec.push_back(0.5 * (i + j));
+         }
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   ROOT::RDataFrame df(treename, filename);
+   auto c = df.Filter(
+                 [](const RVec<float> &arr, const RVec<double> &vec, ULong64_t entry) {
+                    const auto size = entry % 16;
+                    EXPECT_EQ(size, arr.size());
+                    EXPECT_EQ(size, vec.size());
+                    for (auto j = 0u; j < size; ++j) {
+                       EXPECT_FLOAT_EQ(entry + j, arr[j]);
+                       EXPECT_DOUBLE_EQ(0.5 * (entry + j), vec[j]);
+                    }
+                    return entry % 7 == 0;
+                 },
+                 {"arr", "vec", "rdfentry_"})
+               .Count();
+   EXPECT_EQ((nEntries + 6) / 7, *c);
+
+   // Entries are not read in order of the baskets if the range does not start at a basket boundary
+   auto sum = df.Range(1234, 4321)
+                 .Define("arrSum", [](const RVec<float> &arr) { return Sum(arr, 0.); }, {"arr"})
+                 .Sum<double>("arrSum");
+   double expected = 0;
+   for (int i = 1234; i < 4321; ++i)
+      for (int j = 0; j < i % 16; ++j)
+         expected += i + j;
+   EXPECT_DOUBLE_EQ(expected, *sum);
+
+   gSystem->Unlink(filename);
+}
@@ -263,6 +263,63 @@ TEST(RArrowDS, FromARDFWithJitting)
    EXPECT_EQ(40, *min);
 }
 
+std::shared_ptr<RecordBatchReader> createTestBatchReader(std::shared_ptr<Table> table)
+{
+   // Three batches of two rows. The reader keeps a reference to the table, which must outlive it.
+   auto reader = std::make_shared<TableBatchReader>(*table);
+   reader->set_chunksize(2);
+   return reader;
+}
+
+TEST(RArrowDS, BatchReaderEntryRanges)
+{
+   auto table = createTestTable();
+   RArrowDS tds(createTestBatchReader(table), {});
+   tds.SetNSlots(1U);
+   auto vals = tds.GetColumnReaders<Long64_t>("Age");
+   tds.Initialize();
+
+   std::vector<Long64_t> refs = {64, 50, 40, 30, 2, 0};
+   std::vector<std::pair<ULong64_t, ULong64_t>> allRanges;
+   for (auto ranges = tds.GetEntryRanges(); !ranges.empty(); ranges = tds.GetEntryRanges()) {
+      // only two batches per slot are in memory at a time
+      EXPECT_LE(ranges.size(), 2U);
+      tds.InitSlot(0U, 0ULL);
+      for (auto &&range : ranges) {
+         for (auto i : ROOT::TSeqU(range.first, range.second)) {
+            tds.SetEntry(0U, i);
+            EXPECT_EQ(refs[i], **vals[0]);
+         }
+         allRanges.push_back(range);
+      }
+      tds.FinalizeSlot(0U);
+   }
+   tds.Finalize();
+
+   ASSERT_EQ(3U, allRanges.size());
+   for (auto i : ROOT::TSeqU(3)) {
+      EXPECT_EQ(2U * i, allRanges[i].first);
+      EXPECT_EQ(2U * i + 2U, allRanges[i].second);
+   }
+}
+
+TEST(RArrowDS, FromBatchReader)
+{
+   auto table = createTestTable();
+   auto rdf = FromArrow(createTestBatchReader(table), {});
+   EXPECT_STREQ("string", rdf.GetColumnType("Name").c_str());
+   auto max = rdf.Max<double>("Height");
+   auto names = rdf.Filter([](bool m) { return m; }, {"Married"}).Take<std::string>("Name");
+   auto sumAge = rdf.Filter("Age<40").Sum<Long64_t>("Age");
+
+   EXPECT_DOUBLE_EQ(200.5, *max);
+   EXPECT_EQ((std::vector<std::string>{"Harry", "Bob,Bob", "Tom"}), *names);
+   EXPECT_EQ(32, *sumAge);
+
+   // the reader has been consumed
+   EXPECT_THROW(rdf.Count().GetValue(), std::runtime_error);
+}
+
 // NOW MT!-------------
 #ifdef R__USE_IMT
 
@@ -309,4 +366,17 @@ TEST(RArrowDS, FromARDFWithJittingMT)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RArrowDS, FromBatchReaderMT)
+{
+   auto table = createTestTable();
+   auto rdf = FromArrow(createTestBatchReader(table), {"Age", "Height"});
+   auto c = rdf.Count();
+   auto sumAge = rdf.Sum<Long64_t>("Age");
+   auto min = rdf.Min<double>("Height");
+
+   EXPECT_EQ(6U, *c);
+   EXPECT_EQ(186, *sumAge);
+   EXPECT_DOUBLE_EQ(.8, *min);
+}
+
 #endif // R__USE_IMT
@@ -3,6 +3,9 @@
 #include <ROOT/TSeq.hxx>
 #include <ROOT/TestSupport.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
+
+#include <fstream>
 
 #include <gtest/gtest.h>
 
@@ -428,4 +431,47 @@ TEST(RCsvDS, NanWarningChecks)
    EXPECT_EQ(d->AsString(), AsString);
 }
 
+// enough lines to be parsed in parallel
+TEST(RCsvDS, ParallelParsingMT)
+{
+   const auto fileName = "RCsvDS_test_parallel.csv";
+   const auto nLines = 100000ll;
+   {
+      std::ofstream f(fileName);
+      f << "i,x,name,flag\n";
+      for (auto i = 0ll; i < nLines; ++i) {
+         f << i << ',' << i + 0.5 << ',';
+         if (i % 3 == 0)
+            f << "\"n, " << i << "\"";
+         else
+            f << 'n' << i;
+         f << ',' << (i % 2 == 0 ? "true" : "false") << (i % 10 == 0 ? "\r\n" : "\n");
+         if (i % 1000 == 0)
+            f << '\n'; // empty lines are skipped
+      }
+   }
+
+   for (auto chunkSize : {-1ll, 30000ll}) {
+      auto df = ROOT::RDF::FromCSV(fileName, true, ',', chunkSize);
+      auto count = df.Count();
+      auto sumI = df.Sum<Long64_t>("i");
+      auto sumX = df.Sum<double>("x");
+      auto nTrue = df.Filter([](bool b) { return b; }, {"flag"}).Count();
+      auto nBadNames =
+         df.Filter(
+              [](Long64_t i, const std::string &name) {
+                 return name != (i % 3 == 0 ? "n, " : "n") + std::to_string(i);
+              },
+              {"i", "name"})
+            .Count();
+      EXPECT_EQ(*count, ULong64_t(nLines));
+      EXPECT_EQ(*sumI, nLines * (nLines - 1) / 2);
+      EXPECT_DOUBLE_EQ(*sumX, nLines * (nLines - 1) / 2 + 0.5 * nLines);
+      EXPECT_EQ(*nTrue, ULong64_t(nLines / 2));
+      EXPECT_EQ(*nBadNames, 0ull);
+   }
+
+   gSystem->Unlink(fileName);
+}
+
 #endif // R__USE_IMT
@@ -3,6 +3,8 @@
 #include <ROOT/RVec.hxx>
 
 #include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleWriteOptions.hxx>
 #include <ROOT/RNTupleWriter.hxx>
 #include <ROOT/RPageStorage.hxx>
 
@@ -16,6 +18,7 @@
 
 using ROOT::Experimental::RNTupleDS;
 using ROOT::Experimental::RNTupleModel;
+using ROOT::Experimental::RNTupleReader;
 using ROOT::Experimental::RNTupleWriter;
 using ROOT::Experimental::Internal::RPageSource;
 
@@ -569,3 +572,210 @@ TEST_F(RNTupleDSArraysDataset, UseArraySizeColumnMT)
    UseArraySizeColumn(fNtplName, fFileName);
 }
 #endif
+
+static void WriteSortedNTuple(const std::string &ntplName, const std::string &fileName)
+{
+   auto model = RNTupleModel::Create();
+   auto x = model->MakeField<int>("x");
+   auto y = model->MakeField<float>("y");
+   ROOT::Experimental::RNTupleWriteOptions options;
+   options.SetEnableValueRanges(true);
+   auto writer = RNTupleWriter::Recreate(std::move(model), ntplName, fileName, options);
+   // 10 clusters of 100 entries with increasing values of x
+   for (int i = 0; i < 1000; ++i) {
+      *x = i;
+      *y = 0.5f * i;
+      writer->Fill();
+      if (i % 100 == 99)
+         writer->CommitCluster();
+   }
+}
+
+TEST(RNTupleDSRangeCuts, SkipClusters)
+{
+   FileRAII fileGuard("RNTupleDS_test_rangecuts.root");
+   WriteSortedNTuple("ntuple", fileGuard.GetPath());
+
+   RNTupleDS ds("ntuple", fileGuard.GetPath());
+   ds.SetNSlots(1);
+   ds.SetRangeCuts({{"x", 250, 420}, {"y", -100, 200}});
+   ds.Initialize();
+   // Only the clusters with entries 200-299 and 300-399 can pass both cuts
+   const std::vector<std::pair<ULong64_t, ULong64_t>> expected{{200, 400}};
+   EXPECT_EQ(expected, ds.GetEntryRanges());
+   EXPECT_TRUE(ds.GetEntryRanges().empty());
+   ds.Finalize();
+
+   ds.SetRangeCuts({{"x", 2000, 3000}});
+   ds.Initialize();
+   EXPECT_TRUE(ds.GetEntryRanges().empty());
+   ds.Finalize();
+}
+
+static void FilterWithRangeCuts(const std::string &fileName)
+{
+   auto df = ROOT::RDF::Experimental::FromRNTuple("ntuple", fileName);
+   auto filtered = df.Filter("x >= 250 && 420 > x && y > 0");
+   auto count = filtered.Count();
+   auto sum = filtered.Sum<int>("x");
+   // Entries that do not pass the filter are still processed by other branches of the computation graph
+   auto total = df.Count();
+   auto nAbove = df.Filter("x > 899").Count();
+   EXPECT_EQ(170u, *count);
+   EXPECT_EQ((250 + 419) * 170 / 2, *sum);
+   EXPECT_EQ(1000u, *total);
+   EXPECT_EQ(100u, *nAbove);
+
+   // Without other actions, the cuts are pushed down; the result does not change
+   EXPECT_EQ(170u, *df.Filter("x >= 250 && x < 420").Count());
+   EXPECT_EQ(0u, *df.Filter("x < -1").Count());
+   // Named filters see all entries
+   auto named = df.Filter("x < 100", "low");
+   EXPECT_EQ(100u, *named.Count());
+   EXPECT_EQ(1000u, named.Report()->At("low").GetAll());
+}
+
+TEST(RNTupleDSRangeCuts, Filter)
+{
+   FileRAII fileGuard("RNTupleDS_test_rangecuts_filter.root");
+   WriteSortedNTuple("ntuple", fileGuard.GetPath());
+   FilterWithRangeCuts(fileGuard.GetPath());
+}
+
+#ifdef R__USE_IMT
+TEST(RNTupleDSRangeCuts, FilterMT)
+{
+   FileRAII fileGuard("RNTupleDS_test_rangecuts_filter_mt.root");
+   WriteSortedNTuple("ntuple", fileGuard.GetPath());
+   IMTRAII _;
+   FilterWithRangeCuts(fileGuard.GetPath());
+}
+#endif
+
+TEST(RNTupleDSMetadata, ColumnStats)
+{
+   FileRAII fileGuard1("RNTupleDS_test_metadata_1.root");
+   FileRAII fileGuard2("RNTupleDS_test_metadata_2.root");
+   WriteSortedNTuple("ntuple", fileGuard1.GetPath());
+   WriteSortedNTuple("ntuple", fileGuard2.GetPath());
+
+   RNTupleDS ds("ntuple", fileGuard1.GetPath());
+   EXPECT_EQ(1000u, ds.GetNEntriesFromMetadata());
+   auto stats = ds.GetColumnStatsFromMetadata("y");
+   ASSERT_TRUE(stats);
+   EXPECT_EQ(0., stats->fMin);
+   EXPECT_EQ(499.5, stats->fMax);
+   EXPECT_TRUE(stats->fIsExact);
+   EXPECT_FALSE(ds.GetColumnStatsFromMetadata("z"));
+
+   RNTupleDS chain("ntuple", {fileGuard1.GetPath(), fileGuard2.GetPath()});
+   EXPECT_EQ(2000u, chain.GetNEntriesFromMetadata());
+   stats = chain.GetColumnStatsFromMetadata("x");
+   ASSERT_TRUE(stats);
+   EXPECT_EQ(0., stats->fMin);
+   EXPECT_EQ(999., stats->fMax);
+   EXPECT_TRUE(stats->fIsExact);
+}
+
+TEST(RNTupleDSMetadata, ResultsWithoutEventLoop)
+{
+   FileRAII fileGuard("RNTupleDS_test_metadata_results.root");
+   WriteSortedNTuple("ntuple", fileGuard.GetPath());
+
+   auto df = ROOT::RDF::Experimental::FromRNTuple("ntuple", fileGuard.GetPath());
+   auto count = df.Count();
+   auto minX = df.Min<int>("x");
+   auto maxY = df.Max("y");
+   EXPECT_EQ(1000u, *count);
+   EXPECT_EQ(0, *minX);
+   EXPECT_EQ(499.5, *maxY);
+   EXPECT_EQ(1u, df.GetNRuns());
+   // No event loop has run, hence no slot has been busy
+   EXPECT_TRUE(df.GetSlotBusyTimes().empty());
+
+   // Results that depend on Filters or Defines need an event loop
+   auto nFiltered = df.Filter("x < 100").Count();
+   auto maxZ = df.Define("z", "-x").Max<int>("z");
+   EXPECT_EQ(100u, *nFiltered);
+   EXPECT_EQ(0, *maxZ);
+   EXPECT_EQ(2u, df.GetNRuns());
+   EXPECT_FALSE(df.GetSlotBusyTimes().empty());
+}
+
+static void SnapshotToRNTuple(const std::string &fileName)
+{
+   FileRAII fileGuard(fileName);
+
+   ROOT::RDF::RSnapshotOptions opts;
+   opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   auto snap = ROOT::RDataFrame(1000)
+                  .Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                  .Define("v", [](ULong64_t e) { return ROOT::RVecF(e % 3, float(e)); }, {"rdfentry_"})
+                  .Snapshot("ntpl", fileName, {"x", "v"}, opts);
+
+   // The result reads the RNTuple that has just been written
+   EXPECT_EQ(1000u, *snap->Count());
+   EXPECT_EQ(999 * 1000 / 2, *snap->Sum<int>("x"));
+   EXPECT_EQ(333u, *snap->Filter([](const ROOT::RVecF &v) { return v.size() == 1; }, {"v"}).Count());
+
+   ROOT::RDataFrame df(std::make_unique<RNTupleDS>("ntpl", fileName));
+   EXPECT_EQ(1000u, *df.Count());
+   auto nMismatches = df.Filter([](int x, const ROOT::RVecF &v) { return int(v.size()) != x % 3 || Any(v != x); },
+                                {"x", "v"})
+                         .Count();
+   EXPECT_EQ(0u, *nMismatches);
+}
+
+TEST(RNTupleDSSnapshot, Snapshot)
+{
+   SnapshotToRNTuple("RNTupleDS_test_snapshot.root");
+}
+
+#ifdef R__USE_IMT
+TEST(RNTupleDSSnapshot, SnapshotMT)
+{
+   IMTRAII _;
+
+   SnapshotToRNTuple("RNTupleDS_test_snapshot_mt.root");
+}
+#endif
+
+static void CacheWithSpillFile(const std::string &fileName)
+{
+   FileRAII fileGuard(fileName);
+
+   ROOT::RDF::RCacheOptions opts;
+   opts.fMemoryBudget = 256 * 1024;
+   opts.fSpillFileName = fileName;
+   auto cached = ROOT::RDataFrame(100000)
+                    .Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+                    .Define("y", [](ULong64_t e) { return int(e % 7); }, {"rdfentry_"})
+                    .Filter([](int y) { return y != 0; }, {"y"})
+                    .Cache({"x", "y"}, opts);
+
+   // The cache can be processed several times, and holds only the selected columns
+   for (int i = 0; i < 2; ++i) {
+      EXPECT_EQ(100000u - 14286u, *cached.Count());
+      EXPECT_EQ(0u, *cached.Filter([](double x, int y) { return ULong64_t(x) % 7 != ULong64_t(y); }, {"x", "y"})
+                        .Count());
+   }
+   EXPECT_EQ(2u, cached.GetColumnNames().size());
+
+   // The values were spilled in clusters that fit in the memory budget
+   auto reader = RNTupleReader::Open("cache", fileName);
+   EXPECT_GT(reader->GetDescriptor().GetNClusters(), 1u);
+}
+
+TEST(RNTupleDSCache, SpillFile)
+{
+   CacheWithSpillFile("RNTupleDS_test_cache_spill.root");
+}
+
+#ifdef R__USE_IMT
+TEST(RNTupleDSCache, SpillFileMT)
+{
+   IMTRAII _;
+
+   CacheWithSpillFile("RNTupleDS_test_cache_spill_mt.root");
+}
+#endif
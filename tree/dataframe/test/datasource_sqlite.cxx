@@ -124,13 +124,12 @@ TEST(RSqliteDS, ColumnReaders)
 {
    RSqliteDS rds(fileName0, query0);
    const auto nSlots = 2U;
-   ROOT_EXPECT_WARNING(rds.SetNSlots(nSlots), "SetNSlots",
-                       "Currently the SQlite data source faces performance degradation in multi-threaded mode. "
-                       "Consider turning off IMT.");
+   rds.SetNSlots(nSlots);
    auto vals = rds.GetColumnReaders<Long64_t>("fint");
    rds.Initialize();
    auto ranges = rds.GetEntryRanges();
-   EXPECT_EQ(1U, ranges.size());
+   // The two rows are split among the slots
+   EXPECT_EQ(2U, ranges.size());
    for (auto i : ROOT::TSeq<unsigned>(0, nSlots)) {
       EXPECT_TRUE(rds.SetEntry(i, ranges[0].first));
       auto val = **vals[i];
@@ -144,23 +143,53 @@ TEST(RSqliteDS, GetEntryRanges)
 {
    RSqliteDS rds(fileName0, query0);
    rds.Initialize();
+   // Both rows are fetched in a single batch
    auto ranges = rds.GetEntryRanges();
    ASSERT_EQ(1U, ranges.size());
    EXPECT_EQ(0U, ranges[0].first);
-   EXPECT_EQ(1U, ranges[0].second);
-   ranges = rds.GetEntryRanges();
-   ASSERT_EQ(1U, ranges.size());
-   EXPECT_EQ(1U, ranges[0].first);
    EXPECT_EQ(2U, ranges[0].second);
    ranges = rds.GetEntryRanges();
    EXPECT_EQ(0U, ranges.size());
+   ranges = rds.GetEntryRanges();
+   EXPECT_EQ(0U, ranges.size());
 
    // New event loop
    rds.Initialize();
    ranges = rds.GetEntryRanges();
    EXPECT_EQ(1U, ranges.size());
    EXPECT_EQ(0U, ranges[0].first);
-   EXPECT_EQ(1U, ranges[0].second);
+   EXPECT_EQ(2U, ranges[0].second);
+}
+
+TEST(RSqliteDS, Batches)
+{
+   // Enough rows for several batches
+   constexpr auto query = "WITH RECURSIVE cnt(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM cnt LIMIT 5000) "
+                          "SELECT x, 'row' || x AS name FROM cnt";
+   RSqliteDS rds(fileName0, query);
+   rds.SetNSlots(2);
+   auto vx = rds.GetColumnReaders<Long64_t>("x");
+   auto vname = rds.GetColumnReaders<std::string>("name");
+
+   rds.Initialize();
+   ULong64_t nEntries = 0;
+   for (auto ranges = rds.GetEntryRanges(); !ranges.empty(); ranges = rds.GetEntryRanges()) {
+      EXPECT_EQ(2U, ranges.size());
+      for (unsigned slot = 0; slot < ranges.size(); ++slot) {
+         const auto &range = ranges[slot];
+         EXPECT_EQ(nEntries, range.first);
+         for (auto entry = range.first; entry < range.second; ++entry) {
+            EXPECT_TRUE(rds.SetEntry(slot, entry));
+            EXPECT_EQ(Long64_t(entry + 1), **vx[slot]);
+            EXPECT_EQ("row" + std::to_string(entry + 1), **vname[slot]);
+         }
+         nEntries = range.second;
+      }
+   }
+   EXPECT_EQ(5000U, nEntries);
+
+   auto rdf = ROOT::RDF::FromSqlite(fileName0, query);
+   EXPECT_EQ(5000LL * 5001 / 2, *rdf.Sum<Long64_t>("x"));
 }
 
 TEST(RSqliteDS, SetEntry)
@@ -184,7 +213,6 @@ TEST(RSqliteDS, SetEntry)
    EXPECT_EQ('1', (**vblob[0])[0]);
    EXPECT_EQ(nullptr, **vnull[0]);
 
-   rds.GetEntryRanges();
    EXPECT_TRUE(rds.SetEntry(0, 1));
    EXPECT_EQ(2, **vint[0]);
    EXPECT_NEAR(2.0, **vreal[0], epsilon);
@@ -202,7 +230,6 @@ TEST(RSqliteDS, IMT)
    const auto nSlots = 4U;
    ROOT::EnableImplicitMT(nSlots);
 
-   ROOT::TestSupport::CheckDiagsRAII diagRAII{kWarning, "SetNSlots", "Currently the SQlite data source faces performance degradation in multi-threaded mode. Consider turning off IMT."};
    auto rdf = ROOT::RDF::FromSqlite(fileName0, query0);
    EXPECT_EQ(3, *rdf.Sum("fint"));
    EXPECT_NEAR(3.0, *rdf.Sum("freal"), epsilon);
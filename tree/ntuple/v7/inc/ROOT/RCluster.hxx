@@ -196,6 +196,8 @@ public:
    const ColumnSet_t &GetAvailPhysicalColumns() const { return fAvailPhysicalColumns; }
    bool ContainsColumn(DescriptorId_t colId) const { return fAvailPhysicalColumns.count(colId) > 0; }
    size_t GetNOnDiskPages() const { return fOnDiskPages.size(); }
+   /// The summed size of the on-disk pages of the cluster
+   std::size_t GetNBytesOnDisk() const;
 }; // class RCluster
 
 } // namespace Internal
@@ -17,8 +17,11 @@
 #define ROOT7_RClusterPool
 
 #include <ROOT/RCluster.hxx>
+#include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <memory>
@@ -49,6 +52,11 @@ reading waits for data from storage and generates no CPU load.
 The unzipping step of the pipeline therefore behaves differently depending on whether or not implicit multi-threading
 is turned on. If it is turned off, i.e. in a single-threaded environment, the cluster pool will only read the
 compressed pages and the page source has to uncompresses pages at a later point when data from the page is requested.
+
+If the read options set a maximum cluster bunch size larger than the initial one, the pool adapts the bunch size
+while reading. The bunch size is doubled if the reader had to wait for a cluster to arrive and it is decreased by one
+if reading a bunch takes less than half of the time spent to process it. The bunch size is further limited such that
+the compressed clusters in flight and in the pool fit into the configured memory budget.
 */
 // clang-format on
 class RClusterPool {
@@ -86,10 +94,18 @@ private:
    /// The number of clusters before the currently active cluster that should stay in the pool if present
    /// Reserved for later use.
    unsigned int fWindowPre = 0;
-   /// The number of clusters that are being read in a single vector read.
+   /// The number of clusters that are being read in a single vector read. Adapted by UpdateClusterBunchSize()
+   /// if fMaxClusterBunchSize is larger than the initial value.
    unsigned int fClusterBunchSize;
+   /// Upper limit for fClusterBunchSize; the pool has space for twice as many clusters
+   unsigned int fMaxClusterBunchSize;
+   /// Limits fClusterBunchSize such that the expected size of the clusters in the pool does not exceed the budget
+   std::uint64_t fMemoryBudget;
    /// Used as an ever-growing counter in GetCluster() to separate bunches of clusters from each other
    std::int64_t fBunchId = 0;
+   /// If true, the I/O thread passes all the queued read items to a single RPageSource::LoadClusters() call,
+   /// irrespective of their bunch id. Set from RNTupleReadOptions::GetUseIoUring().
+   bool fMergeBunches = false;
    /// The cache of clusters around the currently active cluster
    std::vector<std::unique_ptr<RCluster>> fPool;
 
@@ -103,6 +119,25 @@ private:
    /// The communication channel to the I/O thread
    std::deque<RReadItem> fReadQueue;
 
+   /// Set by the I/O thread: exponential moving average of the wall time to load a single cluster in nanoseconds,
+   /// i.e. the time of a LoadClusters() call divided by the number of clusters loaded in the call
+   std::atomic<std::int64_t> fNsReadPerCluster{0};
+   /// Set by the I/O thread: exponential moving average of the on-disk size of loaded clusters
+   std::atomic<std::int64_t> fNBytesPerCluster{0};
+   /// Exponential moving average of the wall time the reader spends on a cluster, excluding the time waiting for I/O
+   std::int64_t fNsProcessPerCluster = 0;
+   /// Whether the last GetCluster() call blocked waiting for the I/O thread
+   bool fHasStalled = false;
+   /// The cluster id of the last GetCluster() call and the time when it returned
+   DescriptorId_t fLastClusterId = kInvalidDescriptorId;
+   std::chrono::steady_clock::time_point fLastReturn;
+
+   Detail::RNTupleMetrics fMetrics;
+   /// Current cluster bunch size
+   Detail::RNTupleAtomicCounter *fCtrClusterBunchSize = nullptr;
+   /// Summed wall time that GetCluster() blocked waiting for the I/O thread
+   Detail::RNTupleAtomicCounter *fCtrTimeWallStall = nullptr;
+
    /// The I/O thread calls RPageSource::LoadClusters() asynchronously.  The thread is mostly waiting for the
    /// data to arrive (blocked by the kernel) and therefore can safely run in addition to the application
    /// main threads.
@@ -119,6 +154,9 @@ private:
    /// Executed at the end of GetCluster when all missing data pieces have been sent to the load queue.
    /// Ideally, the function returns without blocking if the cluster is already in the pool.
    RCluster *WaitFor(DescriptorId_t clusterId, const RCluster::ColumnSet_t &physicalColumns);
+   /// Called by GetCluster() when a new cluster is requested. Adjusts fClusterBunchSize according to the
+   /// measured read and processing times and the memory budget.
+   void UpdateClusterBunchSize();
 
 public:
    static constexpr unsigned int kDefaultClusterBunchSize = 1;
@@ -138,6 +176,10 @@ public:
 
    /// Used by the unit tests to drain the queue of clusters to be preloaded
    void WaitForInFlightClusters();
+
+   unsigned int GetClusterBunchSize() const { return fClusterBunchSize; }
+   /// Provides the current bunch size and the stall time; observed by the page source metrics
+   Detail::RNTupleMetrics &GetMetrics() { return fMetrics; }
 }; // class RClusterPool
 
 } // namespace Internal
@@ -30,6 +30,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <variant>
 
 namespace ROOT {
@@ -284,10 +285,19 @@ public:
 /// Template specializations for C++ std::string
 ////////////////////////////////////////////////////////////////////////////////
 
+/// Strings are stored either as an offset column plus the characters of all strings, or dictionary-encoded.
+/// Dictionary-encoded strings store per entry a cluster-local code into a per-cluster dictionary, which in turn
+/// consists of an offset column and a character column. Every distinct string is thus stored only once per cluster.
 template <>
 class RField<std::string> final : public RFieldBase {
 private:
    ClusterSize_t fIndex;
+   /// For dictionary-encoded strings, the column with the characters of the dictionary entries
+   Internal::RColumn *fDictionaryCharColumn = nullptr;
+   /// For dictionary-encoded strings when writing, the codes of the strings appended to the current cluster.
+   /// When reading, the dictionary of fDictionaryClusterId, as filled by FindDictionaryCode().
+   std::unordered_map<std::string, std::uint32_t> fDictionary;
+   DescriptorId_t fDictionaryClusterId = kInvalidDescriptorId;
 
    std::unique_ptr<RFieldBase> CloneImpl(std::string_view newName) const final
    {
@@ -303,8 +313,13 @@ private:
 
    std::size_t AppendImpl(const void *from) final;
    void ReadGlobalImpl(ROOT::Experimental::NTupleSize_t globalIndex, void *to) final;
+   void ReadDictionaryEntry(RClusterIndex entryIndex, std::string &to);
 
-   void CommitClusterImpl() final { fIndex = 0; }
+   void CommitClusterImpl() final
+   {
+      fIndex = 0;
+      fDictionary.clear();
+   }
 
 public:
    static std::string TypeName() { return "std::string"; }
@@ -319,6 +334,20 @@ public:
    size_t GetValueSize() const final { return sizeof(std::string); }
    size_t GetAlignment() const final { return std::alignment_of<std::string>(); }
    void AcceptVisitor(Detail::RFieldVisitor &visitor) const final;
+
+   /// Sets this field to store its strings dictionary-encoded, which benefits low-cardinality strings.
+   /// The dictionary encoding cannot be combined with other column representations.
+   void SetDictionaryEncoded();
+   /// Returns true if the column representation, set by SetDictionaryEncoded() or found on disk, is dictionary-encoded
+   bool IsDictionaryEncoded() const;
+   /// For dictionary-encoded strings connected to a page source, returns the cluster id and the cluster-local
+   /// dictionary code of the string of the given entry. Codes of the same cluster are equal if and only if the
+   /// strings are equal, so that the code can be compared in place of the string.
+   RClusterIndex GetDictionaryCode(NTupleSize_t globalIndex);
+   /// Returns the code of `value` in the dictionary of the given cluster, such that it can be compared to the result
+   /// of GetDictionaryCode(). If the dictionary does not contain `value`, the index part is kInvalidClusterIndex.
+   /// The dictionary of the last looked-up cluster is cached.
+   RClusterIndex FindDictionaryCode(DescriptorId_t clusterId, std::string_view value);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
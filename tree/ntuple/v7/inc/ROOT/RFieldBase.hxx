@@ -270,8 +270,9 @@ protected:
       } else if (representationIndex == 0 && !fAuxiliaryColumn) {
          fAuxiliaryColumn = column.get();
       } else {
-         // We currently have no fields with more than 2 columns in its column representation
-         R__ASSERT(representationIndex > 0);
+         // Further columns of the active representation, such as the dictionary characters of dictionary-encoded
+         // strings, are only accessible through fAvailableColumns
+         R__ASSERT(representationIndex > 0 || ColumnIndexT > 1);
       }
 
       if constexpr (sizeof...(TailTs))
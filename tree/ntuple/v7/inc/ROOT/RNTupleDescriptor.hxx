@@ -230,6 +230,25 @@ class RClusterDescriptor {
    friend class Internal::RClusterDescriptorBuilder;
 
 public:
+   /// Minimum and maximum of the values of a numeric column in a page or in a cluster. Optionally written, see
+   /// RNTupleWriteOptions::SetEnableValueRanges(). The bounds are conservative: integers that are not representable
+   /// as a double are rounded outwards and NaN values are ignored.
+   struct RValueRange {
+      double fMin = 0.0;
+      double fMax = 0.0;
+
+      /// Extends the range such that it also covers `other`
+      void Merge(const RValueRange &other)
+      {
+         fMin = std::min(fMin, other.fMin);
+         fMax = std::max(fMax, other.fMax);
+      }
+      /// Returns false if none of the values can be in the closed interval [lo, hi], e.g. for skipping a cluster
+      bool Overlaps(double lo, double hi) const { return fMin <= hi && fMax >= lo; }
+
+      bool operator==(const RValueRange &other) const { return fMin == other.fMin && fMax == other.fMax; }
+   };
+
    /// The window of element indexes of a particular column in a particular cluster
    struct RColumnRange {
       DescriptorId_t fPhysicalColumnId = kInvalidDescriptorId;
@@ -244,9 +263,8 @@ public:
       /// Their element index range, however, is aligned with the corresponding column of the
       /// primary column representation (see Section "Suppressed Columns" in the specification)
       bool fIsSuppressed = false;
-
-      // TODO(jblomer): we perhaps want to store summary information, such as average, min/max, etc.
-      // Should this be done on the field level?
+      /// Set if all the pages of the column range have a value range
+      std::optional<RValueRange> fValueRange;
 
       bool operator==(const RColumnRange &other) const
       {
@@ -288,6 +306,8 @@ public:
          RNTupleLocator fLocator;
          /// If true, the 8 bytes following the serialized page are an xxhash of the on-disk page data
          bool fHasChecksum = false;
+         /// Minimum and maximum value of the page's elements, if recorded for the column
+         std::optional<RValueRange> fValueRange;
 
          bool operator==(const RPageInfo &other) const
          {
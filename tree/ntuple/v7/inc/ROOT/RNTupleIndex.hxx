@@ -20,7 +20,6 @@
 
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace ROOT {
@@ -39,36 +38,47 @@ public:
 
 private:
    /////////////////////////////////////////////////////////////////////////////
-   /// Container for the hashes of the indexed fields.
-   class RIndexValue {
-   public:
-      std::vector<NTupleIndexValue_t> fFieldValues;
-      RIndexValue(const std::vector<NTupleIndexValue_t> &fieldValues)
-      {
-         fFieldValues.reserve(fieldValues.size());
-         fFieldValues = fieldValues;
+   /// Hash combinining the individual index values of a composite key. Uses the implementation from
+   /// `boost::hash_combine` (see
+   /// https://www.boost.org/doc/libs/1_55_0/doc/html/hash/reference.html#boost.hash_combine), followed by a final
+   /// mixing step that spreads the hash over all table slots.
+   static std::uint64_t HashKey(const NTupleIndexValue_t *key, std::size_t nKeyFields)
+   {
+      std::uint64_t combinedHash = 0;
+      for (std::size_t i = 0; i < nKeyFields; ++i) {
+         combinedHash ^= key[i] + 0x9e3779b9 + (key[i] << 6) + (key[i] >> 2);
       }
-      inline bool operator==(const RIndexValue &other) const { return other.fFieldValues == fFieldValues; }
-   };
+      combinedHash ^= combinedHash >> 33;
+      combinedHash *= 0xff51afd7ed558ccdULL;
+      combinedHash ^= combinedHash >> 33;
+      return combinedHash;
+   }
+
+   /// The index itself. An open-addressing hash table with linear probing that maps field values (or combinations
+   /// thereof in case the index is defined for multiple fields) to their respective entry numbers. The table slots
+   /// store the key number plus one, or zero for empty slots. The keys have a fixed width of fIndexFields.size()
+   /// values and are stored back to back in fKeys.
+   std::vector<std::uint64_t> fSlots;
+   /// The composite keys, in the order of their first occurrence
+   std::vector<NTupleIndexValue_t> fKeys;
+   /// The hash of every key, used to rehash the table without recomputing the hashes
+   std::vector<std::uint64_t> fKeyHashes;
+   /// The entry numbers of every key, in ascending order
+   std::vector<std::vector<NTupleSize_t>> fEntryNumbers;
 
    /////////////////////////////////////////////////////////////////////////////
-   /// Hash combinining the individual index value hashes from RIndexValue. Uses the implementation from
-   /// `boost::hash_combine` (see
-   /// https://www.boost.org/doc/libs/1_55_0/doc/html/hash/reference.html#boost.hash_combine).
-   struct RIndexValueHash {
-      inline std::size_t operator()(const RIndexValue &indexValue) const
-      {
-         std::size_t combinedHash = 0;
-         for (const auto &fieldVal : indexValue.fFieldValues) {
-            combinedHash ^= fieldVal + 0x9e3779b9 + (fieldVal << 6) + (fieldVal >> 2);
-         }
-         return combinedHash;
-      }
-   };
+   /// \brief Find the key number of a composite key.
+   ///
+   /// \return The key number or `kInvalidNTupleIndex` if the key is not in the index.
+   std::uint64_t FindKey(const NTupleIndexValue_t *key, std::uint64_t hash) const;
 
-   /// The index itself. Maps field values (or combinations thereof in case the index is defined for multiple fields) to
-   /// their respsective entry numbers.
-   std::unordered_map<RIndexValue, std::vector<NTupleSize_t>, RIndexValueHash> fIndex;
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Add an entry number to the list of entries of a composite key, which is inserted if it is new.
+   void Insert(const NTupleIndexValue_t *key, std::uint64_t hash, NTupleSize_t entryNumber);
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Double the number of table slots and re-insert the known keys.
+   void Grow();
 
    /// The page source belonging to the RNTuple for which to build the index.
    std::unique_ptr<RPageSource> fPageSource;
@@ -116,7 +126,11 @@ public:
    /////////////////////////////////////////////////////////////////////////////
    /// \brief Build the index.
    ///
+   /// The index fields are read cluster by cluster in bulk. With implicit multi-threading enabled, the clusters are
+   /// read and hashed in parallel, each with its own clone of the page source. The keys are inserted in entry order.
+   ///
    /// Only a built index can be queried (with RNTupleIndex::GetFirstEntryNumber or RNTupleIndex::GetAllEntryNumbers).
+   /// Queries do not modify the index and can be issued concurrently.
    void Build();
 
    /////////////////////////////////////////////////////////////////////////////
@@ -129,7 +143,7 @@ public:
    std::size_t GetSize() const
    {
       EnsureBuilt();
-      return fIndex.size();
+      return fEntryNumbers.size();
    }
 
    /////////////////////////////////////////////////////////////////////////////
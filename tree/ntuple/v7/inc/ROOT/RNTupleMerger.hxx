@@ -66,6 +66,9 @@ struct RNTupleMergeOptions {
    ENTupleMergeErrBehavior fErrBehavior = ENTupleMergeErrBehavior::kAbort;
    /// If true, the merger will emit further diagnostics and information.
    bool fExtraVerbose = false;
+   /// The number of sources that are attached (i.e., whose metadata is read) in the background while the current
+   /// source is being merged. Zero disables the prefetching. Prefetching requires implicit multi-threading.
+   std::size_t fNPrefetchSources = 4;
 };
 
 // clang-format off
@@ -24,6 +24,7 @@
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RSpan.hxx>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -64,6 +65,15 @@ for (const auto &entry : processor) {
 }
 ~~~
 
+Alternatively, the entries can be processed in parallel with ParallelForEach():
+
+~~~{.cpp}
+processor.ParallelForEach([](const RNTupleProcessor::RIterator::RProcessorState &state) {
+   auto pt = state->GetPtr<float>("pt");
+   // ...
+});
+~~~
+
 An RNTupleProcessor is created by providing one or more RNTupleSourceSpecs, each of which contains the name and storage
 location of a single RNTuple. The RNTuples are processed in the order in which they were provided.
 
@@ -112,6 +122,8 @@ private:
    };
 
    std::vector<RNTupleSourceSpec> fNTuples;
+   /// The frozen model from which the entries are created
+   std::unique_ptr<RNTupleModel> fModel;
    std::unique_ptr<REntry> fEntry;
    std::unique_ptr<Internal::RPageSource> fPageSource;
    std::vector<RFieldContext> fFieldContexts;
@@ -131,6 +143,14 @@ private:
    /// \brief Creates and connects concrete fields to the current page source, based on the proto-fields.
    void ConnectFields();
 
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Creates concrete fields from the proto-fields, connects them to the given page source and binds them to
+   /// the values of the given entry.
+   ///
+   /// \return The concrete fields, in the order of the field contexts. They need to stay alive as long as the entry
+   /// is used for reading.
+   std::vector<std::unique_ptr<RFieldBase>> ConnectFields(Internal::RPageSource &pageSource, REntry &entry) const;
+
 public:
    /////////////////////////////////////////////////////////////////////////////
    /// \brief Returns a reference to the entry used by the processor.
@@ -258,6 +278,20 @@ public:
 
    RIterator begin() { return RIterator(*this, 0, 0); }
    RIterator end() { return RIterator(*this, fNTuples.size(), kInvalidNTupleIndex); }
+
+   using ParallelCallback_t = std::function<void(const RIterator::RProcessorState &)>;
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Calls `callback` for every entry of the chain, using the implicit multi-threading thread pool.
+   ///
+   /// \param[in] callback Function called with the processor state of every entry. The callback is invoked
+   /// concurrently from multiple threads and the order of the entries is unspecified; it must be thread-safe.
+   ///
+   /// The chain is split into cluster-aligned entry ranges. Each range is read with its own clone of the RNTuple's
+   /// page source and its own REntry, created from the processor's model; the ranges are load-balanced across the
+   /// worker threads by work stealing. The values of the entry returned by GetEntry() are not modified. Without
+   /// implicit multi-threading, the ranges are processed sequentially.
+   void ParallelForEach(const ParallelCallback_t &callback);
 };
 
 } // namespace Internal
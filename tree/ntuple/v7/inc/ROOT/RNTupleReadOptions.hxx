@@ -16,6 +16,10 @@
 #ifndef ROOT7_RNTupleReadOptions
 #define ROOT7_RNTupleReadOptions
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
 namespace ROOT {
 namespace Experimental {
 
@@ -43,10 +47,36 @@ public:
 private:
    EClusterCache fClusterCache = EClusterCache::kDefault;
    unsigned int fClusterBunchSize = 1;
+   /// If larger than fClusterBunchSize, the cluster pool adapts the number of clusters per bunch at runtime between 1
+   /// and this value, depending on whether the reader has to wait for I/O and how long reading a bunch takes compared
+   /// to processing it. The initial bunch size is fClusterBunchSize.
+   unsigned int fMaxClusterBunchSize = 0;
+   /// Upper limit in bytes for the compressed clusters that are held in memory by the cluster pool when the bunch size
+   /// is adapted at runtime. Zero means unlimited. The budget never forces the bunch size below one cluster.
+   std::uint64_t fClusterMemoryBudget = 0;
    EImplicitMT fUseImplicitMT = EImplicitMT::kDefault;
    /// If true, the RNTupleReader will track metrics straight from its construction, as
    /// if calling `RNTupleReader::EnableMetrics()` before having created the object.
    bool fEnableMetrics = false;
+   /// If true, the I/O thread of the cluster pool merges all the cluster bunches that are queued for loading into
+   /// a single vector read. On local files and if ROOT is built with io_uring support, the read requests are then
+   /// kept in flight together in the kernel's io_uring submission queue instead of being issued bunch by bunch.
+   bool fUseIoUring = false;
+   /// If non-zero, pages are allocated by an RPageAllocatorPool that keeps up to the given number of bytes of
+   /// released page buffers for reuse. Zero uses plain heap allocation for every page.
+   std::size_t fPageAllocatorCacheSize = 0;
+   /// If true (and the page allocator cache is used), large page buffers are backed by transparent huge pages
+   bool fUseHugePages = false;
+   /// If true and the ntuple is stored in a local file, the file page source maps the file into memory instead of
+   /// reading clusters into buffers. Uncompressed pages whose on-disk layout matches the in-memory layout are then
+   /// used in place without a copy.
+   bool fUseMemoryMap = false;
+   /// If non-empty, RPageSource::Create() decorates the page source with an RPageSourceSharedCache that keeps
+   /// unzipped pages in the POSIX shared-memory segment of this name. Concurrent readers of the same RNTuple on one
+   /// host that use the same segment then unzip every page only once.
+   std::string fSharedPageCacheName;
+   /// Size in bytes of the shared-memory segment; only used by the process that creates the segment
+   std::size_t fSharedPageCacheSize = 1024 * 1024 * 1024;
 
 public:
    EClusterCache GetClusterCache() const { return fClusterCache; }
@@ -55,11 +85,35 @@ public:
    unsigned int GetClusterBunchSize() const { return fClusterBunchSize; }
    void SetClusterBunchSize(unsigned int val) { fClusterBunchSize = val; }
 
+   unsigned int GetMaxClusterBunchSize() const { return fMaxClusterBunchSize; }
+   void SetMaxClusterBunchSize(unsigned int val) { fMaxClusterBunchSize = val; }
+
+   std::uint64_t GetClusterMemoryBudget() const { return fClusterMemoryBudget; }
+   void SetClusterMemoryBudget(std::uint64_t val) { fClusterMemoryBudget = val; }
+
    EImplicitMT GetUseImplicitMT() const { return fUseImplicitMT; }
    void SetUseImplicitMT(EImplicitMT val) { fUseImplicitMT = val; }
 
    bool HasMetricsEnabled() const { return fEnableMetrics; }
    void SetMetricsEnabled(bool enable) { fEnableMetrics = enable; }
+
+   bool GetUseIoUring() const { return fUseIoUring; }
+   void SetUseIoUring(bool val) { fUseIoUring = val; }
+
+   std::size_t GetPageAllocatorCacheSize() const { return fPageAllocatorCacheSize; }
+   void SetPageAllocatorCacheSize(std::size_t val) { fPageAllocatorCacheSize = val; }
+
+   bool GetUseHugePages() const { return fUseHugePages; }
+   void SetUseHugePages(bool val) { fUseHugePages = val; }
+
+   bool GetUseMemoryMap() const { return fUseMemoryMap; }
+   void SetUseMemoryMap(bool val) { fUseMemoryMap = val; }
+
+   const std::string &GetSharedPageCacheName() const { return fSharedPageCacheName; }
+   void SetSharedPageCacheName(const std::string &val) { fSharedPageCacheName = val; }
+
+   std::size_t GetSharedPageCacheSize() const { return fSharedPageCacheSize; }
+   void SetSharedPageCacheSize(std::size_t val) { fSharedPageCacheSize = val; }
 };
 
 } // namespace Experimental
@@ -27,11 +27,13 @@
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RSpan.hxx>
 
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -238,6 +240,28 @@ public:
    /// Fills a user provided entry after checking that the entry has been instantiated from the ntuple model
    void LoadEntry(NTupleSize_t index, REntry &entry) { entry.Read(index); }
 
+   /// Reads the default entry in two phases, for selections that depend only on a few fields. For the entries of
+   /// every cluster, first only the values of the top-level fields `predicateFields` are read and `predicate`
+   /// is evaluated on them, which yields the cluster's selection bitmap. Then, the values of the remaining fields
+   /// are read only for the selected entries, and `callback` is invoked with the fully loaded default entry.
+   ///
+   /// The predicate fields and the remaining fields are read through separate clones of the page source.
+   /// Therefore, the columns of the remaining fields are never fetched for clusters without selected entries, and
+   /// only their pages that contain selected entries are unzipped.
+   ///
+   /// **Example: print the px values of the entries with a positive charge**
+   /// ~~~ {.cpp}
+   /// auto ntuple = RNTupleReader::Open("myNTuple", "some/file.root");
+   /// auto ptrCharge = ntuple->GetModel().GetDefaultEntry().GetPtr<int>("charge");
+   /// auto ptrPx = ntuple->GetModel().GetDefaultEntry().GetPtr<float>("px");
+   /// ntuple->LoadSelectedEntries(
+   ///    {"charge"}, [&](const REntry &) { return *ptrCharge > 0; },
+   ///    [&](NTupleSize_t index, const REntry &) { std::cout << index << ": " << *ptrPx << "\n"; });
+   /// ~~~
+   void LoadSelectedEntries(const std::vector<std::string> &predicateFields,
+                            const std::function<bool(const REntry &)> &predicate,
+                            const std::function<void(NTupleSize_t, const REntry &)> &callback);
+
    /// Returns an iterator over the entry indices of the RNTuple.
    ///
    /// **Example: iterate over all entries and print each entry in JSON format**
@@ -72,6 +72,9 @@ public:
    static constexpr std::uint16_t kFlagDeferredColumn = 0x08;
    static constexpr std::uint16_t kFlagHasValueRange = 0x10;
 
+   /// Flag in the optional trailer of a column's page list that indicates the presence of the page value ranges
+   static constexpr std::uint32_t kFlagPageListValueRanges = 0x01;
+
    static constexpr DescriptorId_t kZeroFieldId = std::uint64_t(-2);
 
    static constexpr int64_t kSuppressedColumnMarker = std::numeric_limits<std::int64_t>::min();
@@ -80,6 +80,8 @@ enum class EColumnType {
    kSplitUInt16,
    kReal32Trunc,
    kReal32Quant,
+   // cluster-local 32 bit index into a per-cluster dictionary; used for dictionary-encoded strings
+   kDictIndex32,
    kMax,
 };
 
@@ -18,8 +18,10 @@
 
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RSpan.hxx>
 #include <string_view>
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <type_traits>
@@ -138,6 +140,7 @@ accessed by index. For top-level fields, the index refers to the entry number. F
 nested collections have global index numbers that are derived from their parent indexes.
 
 Fields of simple types with a Map() method will use that and thus expose zero-copy access.
+Ranges of values within a cluster can be read at once with ReadBulk().
 */
 // clang-format on
 template <typename T, bool UserProvidedAddress>
@@ -152,6 +155,11 @@ private:
    FieldT fField;
    /// Used as a Read() destination for fields that are not mappable
    RFieldBase::RValue fValue;
+   /// Used as a ReadBulk() destination for value ranges that cannot be mapped from a single page; created on first use
+   std::unique_ptr<RFieldBase::RBulk> fBulk;
+   /// An all-true request mask for ReadBulk() calls without a user-provided mask
+   std::unique_ptr<bool[]> fBulkMaskReq;
+   std::size_t fBulkMaskReqSize = 0;
 
    void SetupField(DescriptorId_t fieldId, Internal::RPageSource *pageSource)
    {
@@ -228,6 +236,36 @@ public:
       return fField.MapV(clusterIndex, nItems);
    }
 
+   /// Reads the `count` values starting at `firstIndex` and returns them as a contiguous array. The range has to be
+   /// within a single cluster. For mappable types, the returned span aliases the page buffer if the range does not
+   /// cross a page boundary. Otherwise, the values are read in bulk into memory owned by the view. In the latter case,
+   /// only the values for which `maskReq` is true are guaranteed to be read; by default, all values are read.
+   /// The span is valid until the next call to ReadBulk() or until the view is destroyed.
+   std::span<const T> ReadBulk(RClusterIndex firstIndex, std::size_t count, const bool *maskReq = nullptr)
+   {
+      if (count == 0)
+         return std::span<const T>();
+
+      if constexpr (Internal::isMappable<FieldT>) {
+         NTupleSize_t nItems;
+         const T *values = fField.MapV(firstIndex, nItems);
+         if (nItems >= count)
+            return std::span<const T>(values, count);
+      }
+
+      if (!fBulk)
+         fBulk = std::make_unique<RFieldBase::RBulk>(fField.CreateBulk());
+      if (!maskReq) {
+         if (fBulkMaskReqSize < count) {
+            fBulkMaskReq = std::make_unique<bool[]>(count);
+            std::fill(fBulkMaskReq.get(), fBulkMaskReq.get() + count, true);
+            fBulkMaskReqSize = count;
+         }
+         maskReq = fBulkMaskReq.get();
+      }
+      return std::span<const T>(static_cast<const T *>(fBulk->ReadBulk(firstIndex, maskReq, count)), count);
+   }
+
    void Bind(std::shared_ptr<T> objPtr)
    {
       static_assert(
@@ -88,11 +88,24 @@ protected:
    bool fUseDirectIO = false;
    /// Whether to use implicit multi-threading to compress pages. Only has an effect if buffered writing is turned on.
    EImplicitMT fUseImplicitMT = EImplicitMT::kDefault;
+   /// Whether to seal the pages of a committed cluster in the background while the next cluster is being filled.
+   /// The cluster is written when the following cluster is committed (or when the cluster group is committed), such
+   /// that up to two clusters are buffered in memory. Only has an effect with buffered writing and implicit
+   /// multi-threading.
+   bool fUseDoubleBufferedClusters = false;
    /// If set, checksums will be calculated and written for every page.
    bool fEnablePageChecksums = true;
+   /// If set, the minimum and maximum value of every page of numeric columns is stored in the page list. Readers can
+   /// use the resulting per page and per cluster value ranges, e.g., to skip clusters that fail a range cut.
+   bool fEnableValueRanges = false;
    /// Specifies the max size of a payload storeable into a single TKey. When writing an RNTuple to a ROOT file,
    /// any payload whose size exceeds this will be split into multiple keys.
    std::uint64_t fMaxKeySize = kDefaultMaxKeySize;
+   /// If non-zero, pages are allocated by an RPageAllocatorPool that keeps up to the given number of bytes of
+   /// released page buffers for reuse. Zero uses plain heap allocation for every page.
+   std::size_t fPageAllocatorCacheSize = 0;
+   /// If true (and the page allocator cache is used), large page buffers are backed by transparent huge pages
+   bool fUseHugePages = false;
 
 public:
 
@@ -130,11 +143,23 @@ public:
    EImplicitMT GetUseImplicitMT() const { return fUseImplicitMT; }
    void SetUseImplicitMT(EImplicitMT val) { fUseImplicitMT = val; }
 
+   bool GetUseDoubleBufferedClusters() const { return fUseDoubleBufferedClusters; }
+   void SetUseDoubleBufferedClusters(bool val) { fUseDoubleBufferedClusters = val; }
+
    bool GetEnablePageChecksums() const { return fEnablePageChecksums; }
    /// Note that turning off page checksums will also turn off the same page merging optimization (see tuning.md)
    void SetEnablePageChecksums(bool val) { fEnablePageChecksums = val; }
 
+   bool GetEnableValueRanges() const { return fEnableValueRanges; }
+   void SetEnableValueRanges(bool val) { fEnableValueRanges = val; }
+
    std::uint64_t GetMaxKeySize() const { return fMaxKeySize; }
+
+   std::size_t GetPageAllocatorCacheSize() const { return fPageAllocatorCacheSize; }
+   void SetPageAllocatorCacheSize(std::size_t val) { fPageAllocatorCacheSize = val; }
+
+   bool GetUseHugePages() const { return fUseHugePages; }
+   void SetUseHugePages(bool val) { fUseHugePages = val; }
 };
 
 namespace Internal {
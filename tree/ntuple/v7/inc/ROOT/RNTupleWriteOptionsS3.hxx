@@ -0,0 +1,50 @@
+/// \file ROOT/RNTupleWriteOptionsS3.hxx
+/// \ingroup NTuple ROOT7
+/// \date 2024-10-16
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RNTupleWriteOptionsS3
+#define ROOT7_RNTupleWriteOptionsS3
+
+#include <ROOT/RNTupleWriteOptions.hxx>
+
+#include <cstdint>
+#include <memory>
+
+namespace ROOT {
+namespace Experimental {
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleWriteOptionsS3
+\ingroup NTuple
+\brief S3-specific user-tunable settings for storing ntuples
+*/
+// clang-format on
+class RNTupleWriteOptionsS3 : public RNTupleWriteOptions {
+   /// Every cluster is uploaded as a separate object; up to this many uploads run concurrently.
+   std::uint32_t fMaxConcurrentUploads = 4;
+
+public:
+   ~RNTupleWriteOptionsS3() override = default;
+   std::unique_ptr<RNTupleWriteOptions> Clone() const override { return std::make_unique<RNTupleWriteOptionsS3>(*this); }
+
+   std::uint32_t GetMaxConcurrentUploads() const { return fMaxConcurrentUploads; }
+   /// Set the number of cluster objects that are uploaded in the background while the next cluster is filled.
+   /// Every pending upload keeps the cluster in memory. A value of 0 uploads the clusters synchronously.
+   void SetMaxConcurrentUploads(std::uint32_t val) { fMaxConcurrentUploads = val; }
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif // ROOT7_RNTupleWriteOptionsS3
@@ -19,8 +19,12 @@
 #include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RPage.hxx>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <functional>
+#include <mutex>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -68,6 +72,62 @@ public:
    RPage NewPage(ColumnId_t columnId, std::size_t elementSize, std::size_t nElements) final;
 };
 
+// clang-format off
+/**
+\class ROOT::Experimental::Internal::RPageAllocatorPool
+\ingroup NTuple
+\brief Recycles the memory of released pages for subsequent allocations
+
+Page buffers are rounded up to the next power of two (size class). Released buffers are kept in free lists per size
+class instead of being returned to the system, up to a total of `maxNBytesCached` bytes; further released
+buffers are freed. The free lists are sharded by thread so that concurrent IMT tasks rarely contend for the same lock.
+A thread first tries to reuse a buffer from its own shard and then from the other shards.
+If requested, buffers of at least kHugePageSize bytes are mapped such that the kernel can back them by transparent
+huge pages (Linux only).
+*/
+// clang-format on
+class RPageAllocatorPool : public RPageAllocator {
+public:
+   static constexpr std::size_t kMinSizeClass = 64;
+   /// Size classes range from kMinSizeClass to kMinSizeClass * 2^(kNSizeClasses - 1), i.e. 64 B to 64 MiB.
+   /// Larger pages are allocated and freed directly.
+   static constexpr unsigned int kNSizeClasses = 21;
+   static constexpr unsigned int kNShards = 16;
+   static constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+private:
+   struct RShard {
+      std::mutex fLock;
+      std::array<std::vector<void *>, kNSizeClasses> fFreeLists;
+   };
+
+   std::array<RShard, kNShards> fShards;
+   /// The summed size of the buffers in all the free lists
+   std::atomic<std::size_t> fNBytesCached{0};
+   std::size_t fMaxNBytesCached;
+   bool fUseHugePages;
+
+   /// Returns kNSizeClasses if the buffer is too large to be pooled
+   static unsigned int GetSizeClass(std::size_t nbytes);
+   static std::size_t GetSizeClassNBytes(unsigned int sizeClass) { return kMinSizeClass << sizeClass; }
+   RShard &GetShardOfThisThread();
+   void *AllocateBuffer(std::size_t nbytes);
+   void FreeBuffer(void *buffer, std::size_t nbytes);
+
+protected:
+   void DeletePage(RPage &page) final;
+
+public:
+   explicit RPageAllocatorPool(std::size_t maxNBytesCached, bool useHugePages = false);
+   RPageAllocatorPool(const RPageAllocatorPool &) = delete;
+   RPageAllocatorPool &operator=(const RPageAllocatorPool &) = delete;
+   ~RPageAllocatorPool() override;
+
+   RPage NewPage(ColumnId_t columnId, std::size_t elementSize, std::size_t nElements) final;
+
+   std::size_t GetNBytesCached() const { return fNBytesCached.load(); }
+};
+
 } // namespace Internal
 } // namespace Experimental
 } // namespace ROOT
@@ -120,8 +120,30 @@ private:
    DescriptorId_t fNFields = 0;
    DescriptorId_t fNColumns = 0;
 
+   /// With double-buffered clusters, every buffered cluster has its own sealing task group. Committing a cluster
+   /// then only moves it to the pending cluster, which is written to the inner sink once the next cluster is
+   /// committed. Thus, sealing the last pages of a cluster overlaps with filling the next one.
+   std::unique_ptr<RTaskScheduler> fClusterTasks;
+   /// The buffered columns of the cluster that was committed last but not yet passed to the inner sink
+   std::vector<RColumnBuf> fPendingColumns;
+   std::vector<ColumnHandle_t> fPendingSuppressedColumns;
+   std::unique_ptr<RTaskScheduler> fPendingClusterTasks;
+   NTupleSize_t fPendingNEntries = 0;
+   bool fHasPendingCluster = false;
+   /// Number of bytes written by the inner sink for the last cluster; returned by CommitCluster() for a cluster
+   /// whose write is deferred.
+   std::uint64_t fNBytesLastCluster = 0;
+
    void ConnectFields(const std::vector<RFieldBase *> &fields, NTupleSize_t firstEntry);
+   /// Passes the sealed pages of the given buffered cluster to the inner sink and calls FlushClusterFn in the same
+   /// critical section. All pages must be sealed.
+   void CommitBufferedCluster(std::vector<RColumnBuf> &columns, std::vector<ColumnHandle_t> &suppressedColumns,
+                              std::function<void(void)> FlushClusterFn);
    void FlushClusterImpl(std::function<void(void)> FlushClusterFn);
+   /// Waits for the sealing tasks of the pending cluster, if any, and commits it to the inner sink
+   void CommitPendingCluster();
+   /// Returns the scheduler for sealing the pages of the cluster being filled, or nullptr to seal synchronously
+   RTaskScheduler *GetSealingTaskScheduler();
 
 public:
    explicit RPageSinkBuf(std::unique_ptr<RPageSink> inner);
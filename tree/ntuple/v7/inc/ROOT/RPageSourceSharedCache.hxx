@@ -0,0 +1,183 @@
+/// \file ROOT/RPageSourceSharedCache.hxx
+/// \ingroup NTuple ROOT7
+/// \author Jakob Blomer <jblomer@cern.ch>
+/// \date 2024-10-14
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RPageSourceSharedCache
+#define ROOT7_RPageSourceSharedCache
+
+#include <ROOT/RNTupleMetrics.hxx>
+#include <ROOT/RPageStorage.hxx>
+#include <ROOT/RSpan.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace Internal {
+
+// clang-format off
+/**
+\class ROOT::Experimental::Internal::RSharedPageCache
+\ingroup NTuple
+\brief An LRU cache of unzipped pages in a POSIX shared-memory segment
+
+The segment is created by the first process that opens it and then attached by all other processes using the same
+segment name. It consists of a header with a process-shared, robust mutex, a table of page entries, a hash index into
+that table, and the page data area. The data area is divided into fixed-size blocks; a page occupies a contiguous
+run of blocks. To make room for a new page, the least recently used pages are evicted until a large enough run of
+free blocks is available. Pages are copied in and out of the segment while holding the mutex.
+
+The segment outlives the processes that use it; it is only removed by Unlink().
+*/
+// clang-format on
+class RSharedPageCache {
+public:
+   /// Identifies an unzipped page across processes. All members are plain 64bit integers so that the key can be
+   /// hashed and compared bytewise.
+   struct RKey {
+      /// Identifies the RNTuple, see RPageSourceSharedCache
+      std::uint64_t fDatasetId = 0;
+      std::uint64_t fPhysicalColumnId = 0;
+      std::uint64_t fClusterId = 0;
+      std::uint64_t fPageNo = 0;
+      /// Identifies the in-memory type of the column elements because the same on-disk page can be unpacked into
+      /// different in-memory types
+      std::uint64_t fElementTypeId = 0;
+
+      bool operator==(const RKey &other) const
+      {
+         return fDatasetId == other.fDatasetId && fPhysicalColumnId == other.fPhysicalColumnId &&
+                fClusterId == other.fClusterId && fPageNo == other.fPageNo && fElementTypeId == other.fElementTypeId;
+      }
+   };
+
+   static constexpr std::size_t kDefaultBlockSize = 32 * 1024;
+
+private:
+   struct RHeader;
+   struct REntry;
+
+   std::string fName;
+   void *fBase = nullptr;
+   std::size_t fSize = 0;
+   RHeader *fHeader = nullptr;
+   /// One entry per block; only the entry of the first block of a page describes the page
+   REntry *fEntries = nullptr;
+   /// Hash index: the first entry of the collision chain of every bucket, or -1
+   std::int32_t *fBuckets = nullptr;
+   unsigned char *fData = nullptr;
+
+   static std::uint64_t HashKey(const RKey &key);
+   std::int32_t FindEntry(const RKey &key, std::uint64_t hash) const;
+   /// Returns the first block of a run of `nBlocks` free blocks, or -1
+   std::int32_t FindFreeBlocks(std::uint32_t nBlocks) const;
+   void RemoveEntry(std::int32_t idx);
+   /// Returns false if the cache is empty
+   bool EvictLeastRecentlyUsed();
+   /// Drops all pages; used after a process crashed while holding the mutex
+   void Clear();
+
+public:
+   /// Opens the shared-memory segment `name` or, if it does not yet exist, creates it with a size of `size` bytes.
+   /// The block size is only used when creating the segment.
+   RSharedPageCache(std::string_view name, std::size_t size, std::size_t blockSize = kDefaultBlockSize);
+   RSharedPageCache(const RSharedPageCache &) = delete;
+   RSharedPageCache &operator=(const RSharedPageCache &) = delete;
+   ~RSharedPageCache();
+
+   /// Removes the shared-memory segment `name`. Processes that have the segment open can continue to use it.
+   static void Unlink(std::string_view name);
+
+   /// If the cache contains the page `key` with a size of `nBytes`, copies it to `buffer`, marks it as recently used
+   /// and returns true.
+   bool Lookup(const RKey &key, void *buffer, std::size_t nBytes);
+   /// Copies the page into the cache, evicting the least recently used pages if necessary. Returns false if the page
+   /// is larger than the cache.
+   bool Insert(const RKey &key, const void *buffer, std::size_t nBytes);
+
+   const std::string &GetName() const { return fName; }
+   std::size_t GetBlockSize() const;
+   std::uint32_t GetNBlocks() const;
+   /// The number of pages currently cached
+   std::uint32_t GetNPages() const;
+}; // class RSharedPageCache
+
+// clang-format off
+/**
+\class ROOT::Experimental::Internal::RPageSourceSharedCache
+\ingroup NTuple
+\brief Page source decorator that shares unzipped pages between processes through an RSharedPageCache
+
+Pages are first looked up in the shared-memory cache. On a miss, the page is loaded and unzipped by the decorated
+page source and then copied into the cache, so that concurrent readers of the same RNTuple on the same host unzip
+every page only once. The RNTuple is identified by its storage location together with the name, header checksum, and
+footer size from the descriptor. Pages of the zero page are passed through.
+
+The decorator is used by RPageSource::Create() if RNTupleReadOptions::SetSharedPageCacheName() is set.
+The cache hit and miss counts are reported through the metrics of the page source.
+*/
+// clang-format on
+class RPageSourceSharedCache final : public RPageSource {
+private:
+   struct RCacheCounters {
+      Detail::RNTupleAtomicCounter &fNPageCacheHit;
+      Detail::RNTupleAtomicCounter &fNPageCacheMiss;
+      Detail::RNTupleAtomicCounter &fSzPageCacheHit;
+      Detail::RNTupleCalcPerf &fPageCacheHitRate;
+   };
+
+   std::unique_ptr<RPageSource> fSource;
+   std::string fLocation;
+   /// Shared by the clones of this page source
+   std::shared_ptr<RSharedPageCache> fCache;
+   std::uint64_t fDatasetId = 0;
+   std::unique_ptr<RCacheCounters> fCacheCounters;
+
+   RPageSourceSharedCache(std::unique_ptr<RPageSource> source, std::string_view location,
+                          std::shared_ptr<RSharedPageCache> cache, const RNTupleReadOptions &options);
+
+protected:
+   void LoadStructureImpl() final {}
+   RNTupleDescriptor AttachImpl() final;
+   std::unique_ptr<RPageSource> CloneImpl() const final;
+   RPageRef LoadPageImpl(ColumnHandle_t columnHandle, const RClusterInfo &clusterInfo,
+                         ClusterSize_t::ValueType idxInCluster) final;
+
+public:
+   /// Decorates `source`, which is stored in `location`. Opens or creates the shared-memory segment given by the
+   /// read options.
+   RPageSourceSharedCache(std::unique_ptr<RPageSource> source, std::string_view location,
+                          const RNTupleReadOptions &options);
+   ~RPageSourceSharedCache() final;
+
+   ColumnHandle_t AddColumn(DescriptorId_t fieldId, RColumn &column) final;
+   void DropColumn(ColumnHandle_t columnHandle) final;
+
+   void LoadSealedPage(DescriptorId_t physicalColumnId, RClusterIndex clusterIndex, RSealedPage &sealedPage) final;
+
+   std::vector<std::unique_ptr<RCluster>> LoadClusters(std::span<RCluster::RKey> clusterKeys) final;
+
+   const RSharedPageCache &GetCache() const { return *fCache; }
+}; // class RPageSourceSharedCache
+
+} // namespace Internal
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
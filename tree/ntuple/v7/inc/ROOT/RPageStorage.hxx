@@ -36,6 +36,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <shared_mutex>
 #include <unordered_set>
@@ -93,6 +94,8 @@ public:
       std::size_t fBufferSize = 0; ///< Size of the page payload and the trailing checksum (if available)
       std::uint32_t fNElements = 0;
       bool fHasChecksum = false; ///< If set, the last 8 bytes of the buffer are the xxhash of the rest of the buffer
+      /// Minimum and maximum of the page's values; set by sinks that record value ranges
+      std::optional<RClusterDescriptor::RValueRange> fValueRange;
 
    public:
       RSealedPage() = default;
@@ -122,6 +125,9 @@ public:
       bool GetHasChecksum() const { return fHasChecksum; }
       void SetHasChecksum(bool hasChecksum) { fHasChecksum = hasChecksum; }
 
+      const std::optional<RClusterDescriptor::RValueRange> &GetValueRange() const { return fValueRange; }
+      void SetValueRange(const std::optional<RClusterDescriptor::RValueRange> &valueRange) { fValueRange = valueRange; }
+
       void ChecksumIfEnabled();
       RResult<void> VerifyChecksumIfEnabled() const;
       /// Returns a failure if the sealed page has no checksum
@@ -145,7 +151,8 @@ public:
 protected:
    Detail::RNTupleMetrics fMetrics;
 
-   /// For the time being, we will use the heap allocator for all sources and sinks. This may change in the future.
+   /// The heap allocator by default; sources and sinks use a recycling RPageAllocatorPool if the read or write
+   /// options set a page allocator cache size.
    std::unique_ptr<RPageAllocator> fPageAllocator;
 
    std::string fNTupleName;
@@ -349,6 +356,10 @@ public:
    /// Seal a page using the provided info.
    static RSealedPage SealPage(const RSealPageConfig &config);
 
+   /// Returns the minimum and maximum of the values of an unsealed page. Returns an empty value range for columns of
+   /// non-numeric type (bits, chars, bytes, index and switch columns) and for pages without non-NaN values.
+   static std::optional<RClusterDescriptor::RValueRange> ComputeValueRange(const RPage &page, const RColumn &column);
+
    /// Incorporate incremental changes to the model into the ntuple descriptor. This happens, e.g. if new fields were
    /// added after the initial call to `RPageSink::Init(RNTupleModel &)`.
    /// `firstEntry` specifies the global index for the first stored element in the added columns.
@@ -667,6 +678,11 @@ protected:
    virtual std::unique_ptr<RPageSource> CloneImpl() const = 0;
    // Only called if a task scheduler is set. No-op be default.
    virtual void UnzipClusterImpl(RCluster *cluster);
+   /// Page sources whose sealed page buffers remain valid for the lifetime of the page source (e.g., memory mapped
+   /// files) can return a page that aliases the sealed page buffer instead of a copy. Returns a null page if the
+   /// sealed page cannot be used in place. The default implementation never maps pages.
+   virtual RPage TryMapSealedPage(const RSealedPage &sealedPage, const RColumnElementBase &element,
+                                  DescriptorId_t physicalColumnId);
    // Returns a page from storage if not found in the page pool. Should be able to handle zero page locators.
    virtual RPageRef LoadPageImpl(ColumnHandle_t columnHandle, const RClusterInfo &clusterInfo,
                                  ClusterSize_t::ValueType idxInCluster) = 0;
@@ -146,6 +146,10 @@ private:
    std::unique_ptr<RClusterPool> fClusterPool;
    /// Populated by LoadStructureImpl(), reset at the end of Attach()
    RStructureBuffer fStructureBuffer;
+   /// If memory mapping is requested by the read options and the file is a local file, the entire file is mapped
+   /// read-only after attaching. Clusters then consist of pages pointing into the mapping rather than read buffers.
+   unsigned char *fMmapBase = nullptr;
+   std::uint64_t fMmapSize = 0;
 
    RPageSourceFile(std::string_view ntupleName, const RNTupleReadOptions &options);
 
@@ -155,6 +159,12 @@ private:
    /// sending them to RRawFile::ReadV().
    std::unique_ptr<RCluster>
    PrepareSingleCluster(const RCluster::RKey &clusterKey, std::vector<ROOT::Internal::RRawFile::RIOVec> &readRequests);
+   /// In memory mapping mode, creates a cluster whose pages refer to the mapped file. Issues an asynchronous
+   /// read-ahead hint for the page ranges instead of reading them.
+   std::unique_ptr<RCluster> PrepareSingleClusterMapped(const RCluster::RKey &clusterKey);
+
+   /// Sets fMmapBase if memory mapping is requested and possible; otherwise the source falls back to regular reads
+   void MapFile();
 
 protected:
    void LoadStructureImpl() final;
@@ -164,6 +174,10 @@ protected:
 
    RPageRef LoadPageImpl(ColumnHandle_t columnHandle, const RClusterInfo &clusterInfo,
                          ClusterSize_t::ValueType idxInCluster) final;
+   /// In memory mapping mode, uncompressed pages of mappable column types whose on-disk position is suitably
+   /// aligned are used directly from the mapped file
+   RPage TryMapSealedPage(const RSealedPage &sealedPage, const RColumnElementBase &element,
+                          DescriptorId_t physicalColumnId) final;
 
 public:
    RPageSourceFile(std::string_view ntupleName, std::string_view path, const RNTupleReadOptions &options);
@@ -183,6 +197,9 @@ public:
    void LoadSealedPage(DescriptorId_t physicalColumnId, RClusterIndex clusterIndex, RSealedPage &sealedPage) final;
 
    std::vector<std::unique_ptr<RCluster>> LoadClusters(std::span<RCluster::RKey> clusterKeys) final;
+
+   /// Whether the file is memory mapped, i.e. if uncompressed pages can be read without copying
+   bool IsMemoryMapped() const { return fMmapBase != nullptr; }
 }; // class RPageSourceFile
 
 } // namespace Internal
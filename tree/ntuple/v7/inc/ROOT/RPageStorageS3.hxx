@@ -0,0 +1,162 @@
+/// \file ROOT/RPageStorageS3.hxx
+/// \ingroup NTuple ROOT7
+/// \date 2024-10-16
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RPageStorageS3
+#define ROOT7_RPageStorageS3
+
+#include <ROOT/RError.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleSerialize.hxx>
+#include <ROOT/RNTupleZip.hxx>
+#include <ROOT/RPageStorage.hxx>
+
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+namespace Internal {
+class RCluster;
+class RClusterPool;
+class RS3Bucket;
+
+// clang-format off
+/**
+\class ROOT::Experimental::Internal::RS3NTupleAnchor
+\ingroup NTuple
+\brief Entry point for an RNTuple stored in an S3 bucket. It contains the (un)compressed size of the header and
+footer objects. The anchor object is written last; an ntuple without anchor is incomplete.
+*/
+// clang-format on
+struct RS3NTupleAnchor {
+   /// Allows for evolving the struct in future versions
+   std::uint64_t fVersionAnchor = 1;
+   /// Version of the binary format supported by the writer
+   std::uint16_t fVersionEpoch = RNTuple::kVersionEpoch;
+   std::uint16_t fVersionMajor = RNTuple::kVersionMajor;
+   std::uint16_t fVersionMinor = RNTuple::kVersionMinor;
+   std::uint16_t fVersionPatch = RNTuple::kVersionPatch;
+   /// The size of the compressed ntuple header
+   std::uint32_t fNBytesHeader = 0;
+   /// The size of the uncompressed ntuple header
+   std::uint32_t fLenHeader = 0;
+   /// The size of the compressed ntuple footer
+   std::uint32_t fNBytesFooter = 0;
+   /// The size of the uncompressed ntuple footer
+   std::uint32_t fLenFooter = 0;
+
+   std::uint32_t Serialize(void *buffer) const;
+   RResult<std::uint32_t> Deserialize(const void *buffer, std::uint32_t bufSize);
+
+   static constexpr std::uint32_t GetSize() { return 32; }
+}; // struct RS3NTupleAnchor
+
+// clang-format off
+/**
+\class ROOT::Experimental::Internal::RPageSinkS3
+\ingroup NTuple
+\brief Storage provider that writes ntuple pages as objects into an S3 bucket
+
+The ntuple is stored below `<uri>/<ntuple name>/`: the objects `anchor`, `header` and `footer` hold the metadata,
+`pagelist.<N>` the page list of the N-th cluster group and `cluster.<N>` the sealed pages of the N-th cluster.
+The pages of a cluster are collected in memory and the cluster object is uploaded in the background while the next
+cluster is filled.
+*/
+// clang-format on
+class RPageSinkS3 : public RPagePersistentSink {
+private:
+   std::unique_ptr<RS3Bucket> fBucket;
+   /// \brief A URI of the form `s3://host/bucket/prefix` or `s3s://host/bucket/prefix`
+   std::string fURI;
+   /// Sealed pages of the current cluster
+   std::vector<unsigned char> fClusterBuffer;
+   /// Index of the object of the current cluster
+   std::uint32_t fClusterObjectId = 0;
+   /// Cluster group counter for the next committed cluster pagelist
+   std::uint64_t fClusterGroupId = 0;
+   /// Uploads of the staged clusters, oldest first
+   std::deque<std::future<void>> fUploads;
+   std::uint32_t fMaxConcurrentUploads = 0;
+   std::uint64_t fNBytesCurrentCluster = 0;
+
+   RS3NTupleAnchor fNTupleAnchor;
+
+   /// Wait until at most `maxPending` uploads are in flight; rethrows upload errors
+   void WaitForUploads(std::size_t maxPending);
+
+protected:
+   using RPagePersistentSink::InitImpl;
+   void InitImpl(unsigned char *serializedHeader, std::uint32_t length) final;
+   RNTupleLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RNTupleLocator
+   CommitSealedPageImpl(DescriptorId_t physicalColumnId, const RPageStorage::RSealedPage &sealedPage) final;
+   std::uint64_t StageClusterImpl() final;
+   RNTupleLocator CommitClusterGroupImpl(unsigned char *serializedPageList, std::uint32_t length) final;
+   using RPagePersistentSink::CommitDatasetImpl;
+   void CommitDatasetImpl(unsigned char *serializedFooter, std::uint32_t length) final;
+
+public:
+   RPageSinkS3(std::string_view ntupleName, std::string_view uri, const RNTupleWriteOptions &options);
+   ~RPageSinkS3() override;
+}; // class RPageSinkS3
+
+// clang-format off
+/**
+\class ROOT::Experimental::Internal::RPageSourceS3
+\ingroup NTuple
+\brief Storage provider that reads ntuple pages from objects in an S3 bucket
+
+The clusters requested together by the cluster pool are fetched with parallel requests, one per cluster object.
+*/
+// clang-format on
+class RPageSourceS3 : public RPageSource {
+private:
+   /// The last cluster from which a page got loaded.  Points into fClusterPool->fPool
+   RCluster *fCurrentCluster = nullptr;
+   std::unique_ptr<RS3Bucket> fBucket;
+   /// A URI of the form `s3://host/bucket/prefix` or `s3s://host/bucket/prefix`
+   std::string fURI;
+   /// The cluster pool asynchronously preloads the next few clusters
+   std::unique_ptr<RClusterPool> fClusterPool;
+
+   RPageRef LoadPageImpl(ColumnHandle_t columnHandle, const RClusterInfo &clusterInfo,
+                         ClusterSize_t::ValueType idxInCluster) final;
+
+protected:
+   void LoadStructureImpl() final {}
+   RNTupleDescriptor AttachImpl() final;
+   /// The cloned page source creates a new connection to the object store.
+   std::unique_ptr<RPageSource> CloneImpl() const final;
+
+public:
+   RPageSourceS3(std::string_view ntupleName, std::string_view uri, const RNTupleReadOptions &options);
+   ~RPageSourceS3() override;
+
+   void LoadSealedPage(DescriptorId_t physicalColumnId, RClusterIndex clusterIndex, RSealedPage &sealedPage) final;
+
+   std::vector<std::unique_ptr<RCluster>> LoadClusters(std::span<RCluster::RKey> clusterKeys) final;
+}; // class RPageSourceS3
+
+} // namespace Internal
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,78 @@
+/// \file ROOT/RS3.hxx
+/// \ingroup NTuple ROOT7
+/// \date 2024-10-16
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RS3
+#define ROOT7_RS3
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace ROOT {
+namespace Experimental {
+namespace Internal {
+
+struct RS3BucketImpl;
+
+// clang-format off
+/**
+\class ROOT::Experimental::Internal::RS3Bucket
+\ingroup NTuple
+\brief Access to the objects below a common prefix in an S3 bucket
+
+Objects are addressed by a key relative to the prefix given by the URL, e.g. `s3s://host/bucket/prefix`.
+The credentials and the region are taken from the `Davix.S3.*` resources or the `S3_*` environment variables,
+as for TDavixFile. All methods can be called concurrently; every call performs its own request(s).
+Failures are reported by throwing an RException.
+*/
+// clang-format on
+class RS3Bucket {
+public:
+   /// A byte range of an object to be read by GetV()
+   struct RRange {
+      void *fBuffer = nullptr;
+      std::uint64_t fOffset = 0;
+      std::size_t fSize = 0;
+   };
+
+private:
+   std::unique_ptr<RS3BucketImpl> fImpl;
+   std::string fUrl;
+
+   std::string GetObjectUrl(const std::string &key) const { return fUrl + "/" + key; }
+
+public:
+   explicit RS3Bucket(std::string_view url);
+   RS3Bucket(const RS3Bucket &) = delete;
+   RS3Bucket &operator=(const RS3Bucket &) = delete;
+   ~RS3Bucket();
+
+   const std::string &GetUrl() const { return fUrl; }
+
+   /// Create or replace the object with the given content
+   void Put(const std::string &key, const void *buffer, std::size_t nbytes);
+   /// Read a byte range of the object; returns the number of bytes read, which is smaller than nbytes
+   /// only at the end of the object
+   std::size_t Get(const std::string &key, void *buffer, std::size_t nbytes, std::uint64_t offset);
+   /// Read several byte ranges of the object with as few requests as possible
+   void GetV(const std::string &key, RRange *ranges, std::size_t nRanges);
+};
+
+} // namespace Internal
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
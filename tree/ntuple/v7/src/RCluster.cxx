@@ -64,3 +64,11 @@ void ROOT::Experimental::Internal::RCluster::SetColumnAvailable(DescriptorId_t p
 {
    fAvailPhysicalColumns.insert(physicalColumnId);
 }
+
+std::size_t ROOT::Experimental::Internal::RCluster::GetNBytesOnDisk() const
+{
+   std::size_t nbytes = 0;
+   for (const auto &kv : fOnDiskPages)
+      nbytes += kv.second.GetSize();
+   return nbytes;
+}
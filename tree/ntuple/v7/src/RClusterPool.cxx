@@ -15,6 +15,7 @@
 
 #include <ROOT/RClusterPool.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleReadOptions.hxx>
 #include <ROOT/RPageStorage.hxx>
 
 #include <TError.h>
@@ -51,10 +52,18 @@ bool ROOT::Experimental::Internal::RClusterPool::RInFlightCluster::operator<(con
 ROOT::Experimental::Internal::RClusterPool::RClusterPool(RPageSource &pageSource, unsigned int clusterBunchSize)
    : fPageSource(pageSource),
      fClusterBunchSize(clusterBunchSize),
-     fPool(2 * clusterBunchSize),
+     fMaxClusterBunchSize(std::max(clusterBunchSize, pageSource.GetReadOptions().GetMaxClusterBunchSize())),
+     fMemoryBudget(pageSource.GetReadOptions().GetClusterMemoryBudget()),
+     fMergeBunches(pageSource.GetReadOptions().GetUseIoUring()),
+     fPool(2 * fMaxClusterBunchSize),
+     fMetrics("RClusterPool"),
      fThreadIo(&RClusterPool::ExecReadClusters, this)
 {
    R__ASSERT(clusterBunchSize > 0);
+   fCtrClusterBunchSize = fMetrics.MakeCounter<Detail::RNTupleAtomicCounter *>(
+      "clusterBunchSize", "", "number of clusters preloaded in a single vector read");
+   fCtrTimeWallStall = fMetrics.MakeCounter<Detail::RNTupleAtomicCounter *>(
+      "timeWallStall", "ns", "wall clock time spent waiting for clusters to arrive");
 }
 
 ROOT::Experimental::Internal::RClusterPool::~RClusterPool()
@@ -89,13 +98,29 @@ void ROOT::Experimental::Internal::RClusterPool::ExecReadClusters()
                R__ASSERT(i == (readItems.size() - 1));
                return;
             }
-            if ((bunchId >= 0) && (item.fBunchId != bunchId))
+            if (!fMergeBunches && (bunchId >= 0) && (item.fBunchId != bunchId))
                break;
             bunchId = item.fBunchId;
             clusterKeys.emplace_back(item.fClusterKey);
          }
 
+         const auto tStart = std::chrono::steady_clock::now();
          auto clusters = fPageSource.LoadClusters(clusterKeys);
+         if (!clusters.empty()) {
+            const std::int64_t nsPerCluster =
+               std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart)
+                  .count() /
+               clusters.size();
+            std::int64_t nBytes = 0;
+            for (const auto &c : clusters)
+               nBytes += c->GetNBytesOnDisk();
+            const std::int64_t nBytesPerCluster = nBytes / clusters.size();
+            // Only the I/O thread writes these values, so load and store need not be a single atomic operation
+            const auto nsAvg = fNsReadPerCluster.load();
+            fNsReadPerCluster.store((nsAvg == 0) ? nsPerCluster : (3 * nsAvg + nsPerCluster) / 4);
+            const auto nBytesAvg = fNBytesPerCluster.load();
+            fNBytesPerCluster.store((nBytesAvg == 0) ? nBytesPerCluster : (3 * nBytesAvg + nBytesPerCluster) / 4);
+         }
          for (std::size_t i = 0; i < clusters.size(); ++i) {
             // Meanwhile, the user might have requested clusters outside the look-ahead window, so that we don't
             // need the cluster anymore, in which case we simply discard it right away, before moving it to the pool
@@ -197,10 +222,46 @@ public:
 
 } // anonymous namespace
 
+void ROOT::Experimental::Internal::RClusterPool::UpdateClusterBunchSize()
+{
+   if (fMaxClusterBunchSize == 1)
+      return;
+
+   const auto nsReadPerCluster = fNsReadPerCluster.load();
+   if (fHasStalled) {
+      // The reader caught up with the I/O thread: read further ahead
+      fClusterBunchSize = std::min(2 * fClusterBunchSize, fMaxClusterBunchSize);
+   } else if ((fClusterBunchSize > 1) && (nsReadPerCluster > 0) && (fNsProcessPerCluster > 0) &&
+              (2 * nsReadPerCluster < fNsProcessPerCluster)) {
+      // Reading a bunch takes less than half of the time needed to process it: a smaller look-ahead suffices
+      fClusterBunchSize--;
+   }
+
+   if (fMemoryBudget > 0) {
+      // Up to two bunches are either in flight or in the pool
+      const std::uint64_t nBytesPerCluster = fNBytesPerCluster.load();
+      while ((fClusterBunchSize > 1) && (2 * fClusterBunchSize * nBytesPerCluster > fMemoryBudget))
+         fClusterBunchSize--;
+   }
+
+   fCtrClusterBunchSize->SetValue(fClusterBunchSize);
+}
+
 ROOT::Experimental::Internal::RCluster *
 ROOT::Experimental::Internal::RClusterPool::GetCluster(DescriptorId_t clusterId,
                                                        const RCluster::ColumnSet_t &physicalColumns)
 {
+   if (clusterId != fLastClusterId) {
+      if (fLastClusterId != kInvalidDescriptorId) {
+         const std::int64_t nsProcess =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - fLastReturn)
+               .count();
+         fNsProcessPerCluster = (fNsProcessPerCluster == 0) ? nsProcess : (3 * fNsProcessPerCluster + nsProcess) / 4;
+      }
+      UpdateClusterBunchSize();
+      fLastClusterId = clusterId;
+   }
+
    std::set<DescriptorId_t> keep;
    RProvides provide;
    {
@@ -340,7 +401,10 @@ ROOT::Experimental::Internal::RClusterPool::GetCluster(DescriptorId_t clusterId,
       }
    } // work queue lock guard
 
-   return WaitFor(clusterId, physicalColumns);
+   fHasStalled = false;
+   auto result = WaitFor(clusterId, physicalColumns);
+   fLastReturn = std::chrono::steady_clock::now();
+   return result;
 }
 
 ROOT::Experimental::Internal::RCluster *
@@ -379,7 +443,16 @@ ROOT::Experimental::Internal::RClusterPool::WaitFor(DescriptorId_t clusterId,
          // is released.  We need to release the lock before potentially blocking on the cluster future.
       }
 
-      auto cptr = itr->fFuture.get();
+      std::unique_ptr<RCluster> cptr;
+      if (itr->fFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+         cptr = itr->fFuture.get();
+      } else {
+         fHasStalled = true;
+         const auto tStart = std::chrono::steady_clock::now();
+         cptr = itr->fFuture.get();
+         fCtrTimeWallStall->Add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count());
+      }
       // We were blocked waiting for the cluster, so assume that nobody discarded it.
       R__ASSERT(cptr != nullptr);
 
@@ -22,9 +22,18 @@
 #include <bitset>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <utility>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define R__BYTESPLIT_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define R__BYTESPLIT_NEON
+#include <arm_neon.h>
+#endif
+
 std::pair<std::uint16_t, std::uint16_t>
 ROOT::Experimental::Internal::RColumnElementBase::GetValidBitRange(EColumnType type)
 {
@@ -58,6 +67,7 @@ ROOT::Experimental::Internal::RColumnElementBase::GetValidBitRange(EColumnType t
    case EColumnType::kSplitUInt16: return std::make_pair(16, 16);
    case EColumnType::kReal32Trunc: return std::make_pair(10, 31);
    case EColumnType::kReal32Quant: return std::make_pair(1, 32);
+   case EColumnType::kDictIndex32: return std::make_pair(32, 32);
    default: assert(false);
    }
    // never here
@@ -96,6 +106,7 @@ std::string ROOT::Experimental::Internal::RColumnElementBase::GetTypeName(EColum
    case EColumnType::kSplitUInt16: return "SplitUInt16";
    case EColumnType::kReal32Trunc: return "Real32Trunc";
    case EColumnType::kReal32Quant: return "Real32Quant";
+   case EColumnType::kDictIndex32: return "DictIndex32";
    default: return "UNKNOWN";
    }
 }
@@ -137,6 +148,7 @@ ROOT::Experimental::Internal::RColumnElementBase::Generate<void>(EColumnType typ
    case EColumnType::kSplitUInt16: return std::make_unique<RColumnElement<std::uint16_t, EColumnType::kSplitUInt16>>();
    case EColumnType::kReal32Trunc: return std::make_unique<RColumnElement<float, EColumnType::kReal32Trunc>>();
    case EColumnType::kReal32Quant: return std::make_unique<RColumnElement<float, EColumnType::kReal32Quant>>();
+   case EColumnType::kDictIndex32: return std::make_unique<RColumnElement<std::uint32_t, EColumnType::kDictIndex32>>();
    default: assert(false);
    }
    // never here
@@ -288,3 +300,334 @@ void ROOT::Experimental::Internal::BitPacking::UnpackBits(void *dst, const void
    assert(prevWordLsb == 0);
    assert(dstIdx == count);
 }
+
+namespace {
+
+/// Scalar split of the elements `[begin, count)`; used as a fallback and to process the tail of a vectorized split
+void SplitScalar(unsigned char *dst, const unsigned char *src, std::size_t begin, std::size_t count, std::size_t N,
+                 std::size_t stride)
+{
+   for (std::size_t b = 0; b < N; ++b) {
+      unsigned char *stream = dst + b * stride;
+      for (std::size_t i = begin; i < count; ++i)
+         stream[i] = src[i * N + b];
+   }
+}
+
+/// Scalar counterpart of SplitScalar()
+void UnsplitScalar(unsigned char *dst, const unsigned char *src, std::size_t begin, std::size_t count, std::size_t N,
+                   std::size_t stride)
+{
+   for (std::size_t b = 0; b < N; ++b) {
+      const unsigned char *stream = src + b * stride;
+      for (std::size_t i = begin; i < count; ++i)
+         dst[i * N + b] = stream[i];
+   }
+}
+
+// The vectorized kernels transpose blocks of elements with N = 2, 4, or 8 bytes.  Within every 128 bit lane, a block
+// of 16 elements is processed in log2(N) rounds.  Unsplitting interleaves the bytes of stream `s` and stream
+// `s + nStreams / 2` (unpacklo/unpackhi, zip), which halves the number of streams and doubles their length.
+// After the last round, the registers hold the elements in memory order.  Splitting runs the rounds in reverse,
+// separating the even and the odd bytes (pack, unzip).  Wider registers process several such blocks side by side,
+// one in each 128 bit lane.
+
+#if defined(R__BYTESPLIT_X86)
+
+template <std::size_t N>
+__attribute__((target("avx2"))) std::size_t SplitAvx2(unsigned char *dst, const unsigned char *src, std::size_t count,
+                                                       std::size_t stride)
+{
+   constexpr std::size_t kNElemsPerBlock = 32;
+   const __m256i maskLo = _mm256_set1_epi16(0x00FF);
+   std::size_t i = 0;
+   for (; i + kNElemsPerBlock <= count; i += kNElemsPerBlock) {
+      const unsigned char *blockSrc = src + i * N;
+      __m256i r[N];
+      __m256i t[N];
+      for (std::size_t k = 0; k < N; k += 2) {
+         // lane 0 takes the first 16 elements, lane 1 the second 16 elements
+         const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blockSrc + k * 16));
+         const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blockSrc + 16 * N + k * 16));
+         r[k] = _mm256_permute2x128_si256(a, b, 0x20);
+         r[k + 1] = _mm256_permute2x128_si256(a, b, 0x31);
+      }
+      for (std::size_t nStreams = 2; nStreams <= N; nStreams *= 2) {
+         const std::size_t half = nStreams / 2;
+         const std::size_t nRegs = N / nStreams;
+         for (std::size_t s = 0; s < half; ++s) {
+            for (std::size_t k = 0; k < nRegs; ++k) {
+               const __m256i x = r[s * 2 * nRegs + 2 * k];
+               const __m256i y = r[s * 2 * nRegs + 2 * k + 1];
+               t[s * nRegs + k] = _mm256_packus_epi16(_mm256_and_si256(x, maskLo), _mm256_and_si256(y, maskLo));
+               t[(s + half) * nRegs + k] = _mm256_packus_epi16(_mm256_srli_epi16(x, 8), _mm256_srli_epi16(y, 8));
+            }
+         }
+         for (std::size_t k = 0; k < N; ++k)
+            r[k] = t[k];
+      }
+      for (std::size_t b = 0; b < N; ++b)
+         _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + b * stride + i), r[b]);
+   }
+   return i;
+}
+
+template <std::size_t N>
+__attribute__((target("avx2"))) std::size_t UnsplitAvx2(unsigned char *dst, const unsigned char *src,
+                                                         std::size_t count, std::size_t stride)
+{
+   constexpr std::size_t kNElemsPerBlock = 32;
+   std::size_t i = 0;
+   for (; i + kNElemsPerBlock <= count; i += kNElemsPerBlock) {
+      __m256i r[N];
+      __m256i t[N];
+      for (std::size_t b = 0; b < N; ++b)
+         r[b] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + b * stride + i));
+      for (std::size_t nStreams = N; nStreams > 1; nStreams /= 2) {
+         const std::size_t half = nStreams / 2;
+         const std::size_t nRegs = N / nStreams;
+         for (std::size_t s = 0; s < half; ++s) {
+            for (std::size_t k = 0; k < nRegs; ++k) {
+               const __m256i x = r[s * nRegs + k];
+               const __m256i y = r[(s + half) * nRegs + k];
+               t[s * 2 * nRegs + 2 * k] = _mm256_unpacklo_epi8(x, y);
+               t[s * 2 * nRegs + 2 * k + 1] = _mm256_unpackhi_epi8(x, y);
+            }
+         }
+         for (std::size_t k = 0; k < N; ++k)
+            r[k] = t[k];
+      }
+      unsigned char *blockDst = dst + i * N;
+      for (std::size_t k = 0; k < N; k += 2) {
+         _mm256_storeu_si256(reinterpret_cast<__m256i *>(blockDst + k * 16),
+                             _mm256_permute2x128_si256(r[k], r[k + 1], 0x20));
+         _mm256_storeu_si256(reinterpret_cast<__m256i *>(blockDst + 16 * N + k * 16),
+                             _mm256_permute2x128_si256(r[k], r[k + 1], 0x31));
+      }
+   }
+   return i;
+}
+
+template <std::size_t N>
+__attribute__((target("avx512f,avx512bw"))) std::size_t
+SplitAvx512(unsigned char *dst, const unsigned char *src, std::size_t count, std::size_t stride)
+{
+   constexpr std::size_t kNElemsPerBlock = 64;
+   const __m512i maskLo = _mm512_set1_epi16(0x00FF);
+   std::size_t i = 0;
+   for (; i + kNElemsPerBlock <= count; i += kNElemsPerBlock) {
+      const unsigned char *blockSrc = src + i * N;
+      __m512i r[N];
+      __m512i t[N];
+      for (std::size_t k = 0; k < N; ++k) {
+         // lane l takes the elements [16 * l, 16 * l + 16) of the block
+         const unsigned char *p = blockSrc + k * 16;
+         __m512i v = _mm512_castsi128_si512(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+         v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * N)), 1);
+         v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 32 * N)), 2);
+         r[k] = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 48 * N)), 3);
+      }
+      for (std::size_t nStreams = 2; nStreams <= N; nStreams *= 2) {
+         const std::size_t half = nStreams / 2;
+         const std::size_t nRegs = N / nStreams;
+         for (std::size_t s = 0; s < half; ++s) {
+            for (std::size_t k = 0; k < nRegs; ++k) {
+               const __m512i x = r[s * 2 * nRegs + 2 * k];
+               const __m512i y = r[s * 2 * nRegs + 2 * k + 1];
+               t[s * nRegs + k] = _mm512_packus_epi16(_mm512_and_si512(x, maskLo), _mm512_and_si512(y, maskLo));
+               t[(s + half) * nRegs + k] = _mm512_packus_epi16(_mm512_srli_epi16(x, 8), _mm512_srli_epi16(y, 8));
+            }
+         }
+         for (std::size_t k = 0; k < N; ++k)
+            r[k] = t[k];
+      }
+      for (std::size_t b = 0; b < N; ++b)
+         _mm512_storeu_si512(dst + b * stride + i, r[b]);
+   }
+   return i;
+}
+
+template <std::size_t N>
+__attribute__((target("avx512f,avx512bw"))) std::size_t
+UnsplitAvx512(unsigned char *dst, const unsigned char *src, std::size_t count, std::size_t stride)
+{
+   constexpr std::size_t kNElemsPerBlock = 64;
+   std::size_t i = 0;
+   for (; i + kNElemsPerBlock <= count; i += kNElemsPerBlock) {
+      __m512i r[N];
+      __m512i t[N];
+      for (std::size_t b = 0; b < N; ++b)
+         r[b] = _mm512_loadu_si512(src + b * stride + i);
+      for (std::size_t nStreams = N; nStreams > 1; nStreams /= 2) {
+         const std::size_t half = nStreams / 2;
+         const std::size_t nRegs = N / nStreams;
+         for (std::size_t s = 0; s < half; ++s) {
+            for (std::size_t k = 0; k < nRegs; ++k) {
+               const __m512i x = r[s * nRegs + k];
+               const __m512i y = r[(s + half) * nRegs + k];
+               t[s * 2 * nRegs + 2 * k] = _mm512_unpacklo_epi8(x, y);
+               t[s * 2 * nRegs + 2 * k + 1] = _mm512_unpackhi_epi8(x, y);
+            }
+         }
+         for (std::size_t k = 0; k < N; ++k)
+            r[k] = t[k];
+      }
+      unsigned char *blockDst = dst + i * N;
+      for (std::size_t k = 0; k < N; ++k) {
+         unsigned char *p = blockDst + k * 16;
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm512_extracti32x4_epi32(r[k], 0));
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(p + 16 * N), _mm512_extracti32x4_epi32(r[k], 1));
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(p + 32 * N), _mm512_extracti32x4_epi32(r[k], 2));
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(p + 48 * N), _mm512_extracti32x4_epi32(r[k], 3));
+      }
+   }
+   return i;
+}
+
+#elif defined(R__BYTESPLIT_NEON)
+
+template <std::size_t N>
+std::size_t SplitNeon(unsigned char *dst, const unsigned char *src, std::size_t count, std::size_t stride)
+{
+   constexpr std::size_t kNElemsPerBlock = 16;
+   std::size_t i = 0;
+   for (; i + kNElemsPerBlock <= count; i += kNElemsPerBlock) {
+      uint8x16_t r[N];
+      uint8x16_t t[N];
+      for (std::size_t k = 0; k < N; ++k)
+         r[k] = vld1q_u8(src + i * N + k * 16);
+      for (std::size_t nStreams = 2; nStreams <= N; nStreams *= 2) {
+         const std::size_t half = nStreams / 2;
+         const std::size_t nRegs = N / nStreams;
+         for (std::size_t s = 0; s < half; ++s) {
+            for (std::size_t k = 0; k < nRegs; ++k) {
+               const uint8x16_t x = r[s * 2 * nRegs + 2 * k];
+               const uint8x16_t y = r[s * 2 * nRegs + 2 * k + 1];
+               t[s * nRegs + k] = vuzp1q_u8(x, y);
+               t[(s + half) * nRegs + k] = vuzp2q_u8(x, y);
+            }
+         }
+         for (std::size_t k = 0; k < N; ++k)
+            r[k] = t[k];
+      }
+      for (std::size_t b = 0; b < N; ++b)
+         vst1q_u8(dst + b * stride + i, r[b]);
+   }
+   return i;
+}
+
+template <std::size_t N>
+std::size_t UnsplitNeon(unsigned char *dst, const unsigned char *src, std::size_t count, std::size_t stride)
+{
+   constexpr std::size_t kNElemsPerBlock = 16;
+   std::size_t i = 0;
+   for (; i + kNElemsPerBlock <= count; i += kNElemsPerBlock) {
+      uint8x16_t r[N];
+      uint8x16_t t[N];
+      for (std::size_t b = 0; b < N; ++b)
+         r[b] = vld1q_u8(src + b * stride + i);
+      for (std::size_t nStreams = N; nStreams > 1; nStreams /= 2) {
+         const std::size_t half = nStreams / 2;
+         const std::size_t nRegs = N / nStreams;
+         for (std::size_t s = 0; s < half; ++s) {
+            for (std::size_t k = 0; k < nRegs; ++k) {
+               const uint8x16_t x = r[s * nRegs + k];
+               const uint8x16_t y = r[(s + half) * nRegs + k];
+               t[s * 2 * nRegs + 2 * k] = vzip1q_u8(x, y);
+               t[s * 2 * nRegs + 2 * k + 1] = vzip2q_u8(x, y);
+            }
+         }
+         for (std::size_t k = 0; k < N; ++k)
+            r[k] = t[k];
+      }
+      for (std::size_t k = 0; k < N; ++k)
+         vst1q_u8(dst + i * N + k * 16, r[k]);
+   }
+   return i;
+}
+
+#endif
+
+/// Returns the number of leading elements that were processed by a vectorized kernel
+template <std::size_t N>
+std::size_t SplitVectorized(unsigned char *dst, const unsigned char *src, std::size_t count, std::size_t stride)
+{
+#if defined(R__BYTESPLIT_X86)
+   static const auto kernel = []() {
+      if (__builtin_cpu_supports("avx512bw"))
+         return &SplitAvx512<N>;
+      if (__builtin_cpu_supports("avx2"))
+         return &SplitAvx2<N>;
+      return static_cast<decltype(&SplitAvx2<N>)>(nullptr);
+   }();
+   return kernel ? kernel(dst, src, count, stride) : 0;
+#elif defined(R__BYTESPLIT_NEON)
+   return SplitNeon<N>(dst, src, count, stride);
+#else
+   (void)dst;
+   (void)src;
+   (void)count;
+   (void)stride;
+   return 0;
+#endif
+}
+
+/// Returns the number of leading elements that were processed by a vectorized kernel
+template <std::size_t N>
+std::size_t UnsplitVectorized(unsigned char *dst, const unsigned char *src, std::size_t count, std::size_t stride)
+{
+#if defined(R__BYTESPLIT_X86)
+   static const auto kernel = []() {
+      if (__builtin_cpu_supports("avx512bw"))
+         return &UnsplitAvx512<N>;
+      if (__builtin_cpu_supports("avx2"))
+         return &UnsplitAvx2<N>;
+      return static_cast<decltype(&UnsplitAvx2<N>)>(nullptr);
+   }();
+   return kernel ? kernel(dst, src, count, stride) : 0;
+#elif defined(R__BYTESPLIT_NEON)
+   return UnsplitNeon<N>(dst, src, count, stride);
+#else
+   (void)dst;
+   (void)src;
+   (void)count;
+   (void)stride;
+   return 0;
+#endif
+}
+
+} // anonymous namespace
+
+void ROOT::Experimental::Internal::ByteSplit::Split(void *dst, const void *src, std::size_t count, std::size_t N,
+                                                    std::size_t stride)
+{
+   assert(stride >= count);
+   auto dstArray = reinterpret_cast<unsigned char *>(dst);
+   auto srcArray = reinterpret_cast<const unsigned char *>(src);
+   std::size_t nDone = 0;
+   switch (N) {
+   case 1: memcpy(dstArray, srcArray, count); return;
+   case 2: nDone = SplitVectorized<2>(dstArray, srcArray, count, stride); break;
+   case 4: nDone = SplitVectorized<4>(dstArray, srcArray, count, stride); break;
+   case 8: nDone = SplitVectorized<8>(dstArray, srcArray, count, stride); break;
+   default: break;
+   }
+   SplitScalar(dstArray, srcArray, nDone, count, N, stride);
+}
+
+void ROOT::Experimental::Internal::ByteSplit::Unsplit(void *dst, const void *src, std::size_t count, std::size_t N,
+                                                      std::size_t stride)
+{
+   assert(stride >= count);
+   auto dstArray = reinterpret_cast<unsigned char *>(dst);
+   auto srcArray = reinterpret_cast<const unsigned char *>(src);
+   std::size_t nDone = 0;
+   switch (N) {
+   case 1: memcpy(dstArray, srcArray, count); return;
+   case 2: nDone = UnsplitVectorized<2>(dstArray, srcArray, count, stride); break;
+   case 4: nDone = UnsplitVectorized<4>(dstArray, srcArray, count, stride); break;
+   case 8: nDone = UnsplitVectorized<8>(dstArray, srcArray, count, stride); break;
+   default: break;
+   }
+   UnsplitScalar(dstArray, srcArray, nDone, count, N, stride);
+}
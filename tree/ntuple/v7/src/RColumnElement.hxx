@@ -11,8 +11,10 @@
 #include <ROOT/RConfig.hxx>
 #include <Byteswap.h>
 
+#include <algorithm>
 #include <bitset>
 #include <cassert>
+#include <type_traits>
 
 // NOTE: some tests might define R__LITTLE_ENDIAN to simulate a different-endianness machine
 #ifndef R__LITTLE_ENDIAN
@@ -52,6 +54,23 @@ void UnpackBits(void *dst, const void *src, std::size_t count, std::size_t sizeo
 
 } // namespace ROOT::Experimental::Internal::BitPacking
 
+namespace ROOT::Experimental::Internal::ByteSplit {
+
+/// Number of elements that the fused cast/delta/zigzag + split routines transform at a time through a stack buffer
+inline constexpr std::size_t kNElemsPerChunk = 1024;
+
+/// Rearranges the bytes of `count` items of size `N` contained in `src` into `N` byte streams.  Byte `b` of item `i`
+/// is stored in `dst[b * stride + i]`, i.e. `stride` is the number of items of the entire split array, which allows
+/// for splitting a sub range of the items.
+/// For `N` = 2, 4, 8, uses vectorized kernels (AVX2, AVX-512, or NEON) if supported by the CPU.
+/// Note that this function doesn't do any byte reordering for you.
+void Split(void *dst, const void *src, std::size_t count, std::size_t N, std::size_t stride);
+
+/// Undoes the effect of `Split`: item `i` in `dst` is assembled from the bytes `src[b * stride + i]`.
+void Unsplit(void *dst, const void *src, std::size_t count, std::size_t N, std::size_t stride);
+
+} // namespace ROOT::Experimental::Internal::ByteSplit
+
 namespace {
 
 // In this namespace, common routines are defined for element packing and unpacking of ints and floats.
@@ -152,14 +171,21 @@ inline void CastUnpack(void *destination, const void *source, std::size_t count)
 template <typename DestT, typename SourceT>
 inline void CastSplitPack(void *destination, const void *source, std::size_t count)
 {
+   using namespace ROOT::Experimental::Internal::ByteSplit;
    constexpr std::size_t N = sizeof(DestT);
-   auto splitArray = reinterpret_cast<char *>(destination);
+   auto splitArray = reinterpret_cast<unsigned char *>(destination);
    auto src = reinterpret_cast<const SourceT *>(source);
-   for (std::size_t i = 0; i < count; ++i) {
-      DestT val = src[i];
-      ByteSwapIfNecessary(val);
-      for (std::size_t b = 0; b < N; ++b) {
-         splitArray[b * count + i] = reinterpret_cast<const char *>(&val)[b];
+   if constexpr (std::is_same_v<DestT, SourceT> && R__LITTLE_ENDIAN == 1) {
+      Split(splitArray, src, count, N, count);
+   } else {
+      DestT buffer[kNElemsPerChunk];
+      for (std::size_t offset = 0; offset < count; offset += kNElemsPerChunk) {
+         const std::size_t n = std::min(kNElemsPerChunk, count - offset);
+         for (std::size_t i = 0; i < n; ++i) {
+            buffer[i] = src[offset + i];
+            ByteSwapIfNecessary(buffer[i]);
+         }
+         Split(splitArray + offset, buffer, n, N, count);
       }
    }
 }
@@ -170,16 +196,23 @@ inline void CastSplitPack(void *destination, const void *source, std::size_t cou
 template <typename DestT, typename SourceT>
 inline void CastSplitUnpack(void *destination, const void *source, std::size_t count)
 {
+   using namespace ROOT::Experimental::Internal::ByteSplit;
    constexpr std::size_t N = sizeof(SourceT);
    auto dst = reinterpret_cast<DestT *>(destination);
-   auto splitArray = reinterpret_cast<const char *>(source);
-   for (std::size_t i = 0; i < count; ++i) {
-      SourceT val = 0;
-      for (std::size_t b = 0; b < N; ++b) {
-         reinterpret_cast<char *>(&val)[b] = splitArray[b * count + i];
+   auto splitArray = reinterpret_cast<const unsigned char *>(source);
+   if constexpr (std::is_same_v<DestT, SourceT> && R__LITTLE_ENDIAN == 1) {
+      Unsplit(dst, splitArray, count, N, count);
+   } else {
+      SourceT buffer[kNElemsPerChunk];
+      for (std::size_t offset = 0; offset < count; offset += kNElemsPerChunk) {
+         const std::size_t n = std::min(kNElemsPerChunk, count - offset);
+         Unsplit(buffer, splitArray + offset, n, N, count);
+         for (std::size_t i = 0; i < n; ++i) {
+            SourceT val = buffer[i];
+            ByteSwapIfNecessary(val);
+            dst[offset + i] = val;
+         }
       }
-      ByteSwapIfNecessary(val);
-      dst[i] = val;
    }
 }
 
@@ -189,15 +222,19 @@ inline void CastSplitUnpack(void *destination, const void *source, std::size_t c
 template <typename DestT, typename SourceT>
 inline void CastDeltaSplitPack(void *destination, const void *source, std::size_t count)
 {
+   using namespace ROOT::Experimental::Internal::ByteSplit;
    constexpr std::size_t N = sizeof(DestT);
    auto src = reinterpret_cast<const SourceT *>(source);
-   auto splitArray = reinterpret_cast<char *>(destination);
-   for (std::size_t i = 0; i < count; ++i) {
-      DestT val = (i == 0) ? src[0] : src[i] - src[i - 1];
-      ByteSwapIfNecessary(val);
-      for (std::size_t b = 0; b < N; ++b) {
-         splitArray[b * count + i] = reinterpret_cast<char *>(&val)[b];
+   auto splitArray = reinterpret_cast<unsigned char *>(destination);
+   DestT buffer[kNElemsPerChunk];
+   for (std::size_t offset = 0; offset < count; offset += kNElemsPerChunk) {
+      const std::size_t n = std::min(kNElemsPerChunk, count - offset);
+      for (std::size_t i = 0; i < n; ++i) {
+         const std::size_t idx = offset + i;
+         buffer[i] = (idx == 0) ? src[0] : src[idx] - src[idx - 1];
+         ByteSwapIfNecessary(buffer[i]);
       }
+      Split(splitArray + offset, buffer, n, N, count);
    }
 }
 
@@ -207,16 +244,20 @@ inline void CastDeltaSplitPack(void *destination, const void *source, std::size_
 template <typename DestT, typename SourceT>
 inline void CastDeltaSplitUnpack(void *destination, const void *source, std::size_t count)
 {
+   using namespace ROOT::Experimental::Internal::ByteSplit;
    constexpr std::size_t N = sizeof(SourceT);
-   auto splitArray = reinterpret_cast<const char *>(source);
+   auto splitArray = reinterpret_cast<const unsigned char *>(source);
    auto dst = reinterpret_cast<DestT *>(destination);
-   for (std::size_t i = 0; i < count; ++i) {
-      SourceT val = 0;
-      for (std::size_t b = 0; b < N; ++b) {
-         reinterpret_cast<char *>(&val)[b] = splitArray[b * count + i];
+   SourceT buffer[kNElemsPerChunk];
+   for (std::size_t offset = 0; offset < count; offset += kNElemsPerChunk) {
+      const std::size_t n = std::min(kNElemsPerChunk, count - offset);
+      Unsplit(buffer, splitArray + offset, n, N, count);
+      for (std::size_t i = 0; i < n; ++i) {
+         const std::size_t idx = offset + i;
+         SourceT val = buffer[i];
+         ByteSwapIfNecessary(val);
+         dst[idx] = (idx == 0) ? val : dst[idx - 1] + val;
       }
-      ByteSwapIfNecessary(val);
-      dst[i] = (i == 0) ? val : dst[i - 1] + val;
    }
 }
 
@@ -226,17 +267,21 @@ inline void CastDeltaSplitUnpack(void *destination, const void *source, std::siz
 template <typename DestT, typename SourceT>
 inline void CastZigzagSplitPack(void *destination, const void *source, std::size_t count)
 {
+   using namespace ROOT::Experimental::Internal::ByteSplit;
    using UDestT = std::make_unsigned_t<DestT>;
    constexpr std::size_t kNBitsDestT = sizeof(DestT) * 8;
    constexpr std::size_t N = sizeof(DestT);
    auto src = reinterpret_cast<const SourceT *>(source);
-   auto splitArray = reinterpret_cast<char *>(destination);
-   for (std::size_t i = 0; i < count; ++i) {
-      UDestT val = (static_cast<DestT>(src[i]) << 1) ^ (static_cast<DestT>(src[i]) >> (kNBitsDestT - 1));
-      ByteSwapIfNecessary(val);
-      for (std::size_t b = 0; b < N; ++b) {
-         splitArray[b * count + i] = reinterpret_cast<char *>(&val)[b];
+   auto splitArray = reinterpret_cast<unsigned char *>(destination);
+   UDestT buffer[kNElemsPerChunk];
+   for (std::size_t offset = 0; offset < count; offset += kNElemsPerChunk) {
+      const std::size_t n = std::min(kNElemsPerChunk, count - offset);
+      for (std::size_t i = 0; i < n; ++i) {
+         const auto val = static_cast<DestT>(src[offset + i]);
+         buffer[i] = (val << 1) ^ (val >> (kNBitsDestT - 1));
+         ByteSwapIfNecessary(buffer[i]);
       }
+      Split(splitArray + offset, buffer, n, N, count);
    }
 }
 
@@ -246,17 +291,20 @@ inline void CastZigzagSplitPack(void *destination, const void *source, std::size
 template <typename DestT, typename SourceT>
 inline void CastZigzagSplitUnpack(void *destination, const void *source, std::size_t count)
 {
+   using namespace ROOT::Experimental::Internal::ByteSplit;
    using USourceT = std::make_unsigned_t<SourceT>;
    constexpr std::size_t N = sizeof(SourceT);
-   auto splitArray = reinterpret_cast<const char *>(source);
+   auto splitArray = reinterpret_cast<const unsigned char *>(source);
    auto dst = reinterpret_cast<DestT *>(destination);
-   for (std::size_t i = 0; i < count; ++i) {
-      USourceT val = 0;
-      for (std::size_t b = 0; b < N; ++b) {
-         reinterpret_cast<char *>(&val)[b] = splitArray[b * count + i];
+   USourceT buffer[kNElemsPerChunk];
+   for (std::size_t offset = 0; offset < count; offset += kNElemsPerChunk) {
+      const std::size_t n = std::min(kNElemsPerChunk, count - offset);
+      Unsplit(buffer, splitArray + offset, n, N, count);
+      for (std::size_t i = 0; i < n; ++i) {
+         USourceT val = buffer[i];
+         ByteSwapIfNecessary(val);
+         dst[offset + i] = static_cast<SourceT>((val >> 1) ^ -(static_cast<SourceT>(val) & 1));
       }
-      ByteSwapIfNecessary(val);
-      dst[i] = static_cast<SourceT>((val >> 1) ^ -(static_cast<SourceT>(val) & 1));
    }
 }
 } // namespace
@@ -303,6 +351,7 @@ std::unique_ptr<RColumnElementBase> GenerateColumnElementInternal(EColumnType ty
    case EColumnType::kSplitUInt16: return std::make_unique<RColumnElement<CppT, EColumnType::kSplitUInt16>>();
    case EColumnType::kReal32Trunc: return std::make_unique<RColumnElement<CppT, EColumnType::kReal32Trunc>>();
    case EColumnType::kReal32Quant: return std::make_unique<RColumnElement<CppT, EColumnType::kReal32Quant>>();
+   case EColumnType::kDictIndex32: return std::make_unique<RColumnElement<CppT, EColumnType::kDictIndex32>>();
    default: R__ASSERT(false);
    }
    // never here
@@ -1049,6 +1098,8 @@ DECLARE_RCOLUMNELEMENT_SPEC(std::uint32_t, EColumnType::kSplitUInt32, 32, RColum
                             <std::uint32_t, std::uint32_t>);
 DECLARE_RCOLUMNELEMENT_SPEC(std::uint32_t, EColumnType::kSplitInt32, 32, RColumnElementZigzagSplitLE,
                             <std::uint32_t, std::int32_t>);
+DECLARE_RCOLUMNELEMENT_SPEC(std::uint32_t, EColumnType::kDictIndex32, 32, RColumnElementSplitLE,
+                            <std::uint32_t, std::uint32_t>);
 
 DECLARE_RCOLUMNELEMENT_SPEC(std::int64_t, EColumnType::kInt64, 64, RColumnElementLE, <std::int64_t>);
 DECLARE_RCOLUMNELEMENT_SPEC(std::int64_t, EColumnType::kUInt64, 64, RColumnElementLE, <std::int64_t>);
@@ -263,8 +263,8 @@ std::tuple<void **, std::int32_t *, std::int32_t *> GetRVecDataMembers(void *rve
    std::int32_t *size = reinterpret_cast<std::int32_t *>(begin + 1);
    R__ASSERT(*size >= 0);
    // int32_t fCapacity is the third data member (1 int32_t after fSize)
+   // It is -1 if the RVec adopts its memory, and < -1 if its buffer was allocated from an RVecArena
    std::int32_t *capacity = size + 1;
-   R__ASSERT(*capacity >= -1);
    return {begin, size, capacity};
 }
 
@@ -347,7 +347,8 @@ void DestroyRVecWithChecks(std::size_t alignOfT, void **beginPtr, char *begin, s
       paddingMiddle = alignOfT - paddingMiddle;
    const bool isSmall = (reinterpret_cast<void *>(begin) == (beginPtr + dataMemberSz + paddingMiddle));
 
-   const bool owns = (*capacityPtr != -1);
+   // buffers allocated from an RVecArena are released by the arena
+   const bool owns = (*capacityPtr >= 0);
    if (!isSmall && owns)
       free(begin);
 }
@@ -1706,37 +1707,94 @@ void ROOT::Experimental::RIntegralField<std::int64_t>::AcceptVisitor(Detail::RFi
 const ROOT::Experimental::RFieldBase::RColumnRepresentations &
 ROOT::Experimental::RField<std::string>::GetColumnRepresentations() const
 {
-   static RColumnRepresentations representations({{EColumnType::kSplitIndex64, EColumnType::kChar},
-                                                  {EColumnType::kIndex64, EColumnType::kChar},
-                                                  {EColumnType::kSplitIndex32, EColumnType::kChar},
-                                                  {EColumnType::kIndex32, EColumnType::kChar}},
-                                                 {});
+   static RColumnRepresentations representations(
+      {{EColumnType::kSplitIndex64, EColumnType::kChar},
+       {EColumnType::kIndex64, EColumnType::kChar},
+       {EColumnType::kSplitIndex32, EColumnType::kChar},
+       {EColumnType::kIndex32, EColumnType::kChar},
+       {EColumnType::kDictIndex32, EColumnType::kSplitIndex64, EColumnType::kChar}},
+      {});
    return representations;
 }
 
 void ROOT::Experimental::RField<std::string>::GenerateColumns()
 {
-   GenerateColumnsImpl<ClusterSize_t, char>();
+   const auto representatives = GetColumnRepresentatives();
+   if (representatives[0][0] == EColumnType::kDictIndex32) {
+      if (representatives.size() > 1)
+         throw RException(R__FAIL("dictionary-encoded string field `" + GetQualifiedFieldName() +
+                                  "` cannot have multiple column representations"));
+      GenerateColumnsImpl<std::uint32_t, ClusterSize_t, char>();
+      fDictionaryCharColumn = fAvailableColumns[2].get();
+   } else {
+      GenerateColumnsImpl<ClusterSize_t, char>();
+   }
 }
 
 void ROOT::Experimental::RField<std::string>::GenerateColumns(const RNTupleDescriptor &desc)
 {
-   GenerateColumnsImpl<ClusterSize_t, char>(desc);
+   const bool isDictionaryEncoded = EnsureCompatibleColumnTypes(desc, 0)[0] == EColumnType::kDictIndex32;
+   for (std::uint16_t representationIndex = 1;; ++representationIndex) {
+      const auto &onDiskTypes = EnsureCompatibleColumnTypes(desc, representationIndex);
+      if (onDiskTypes.empty())
+         break;
+      if ((onDiskTypes[0] == EColumnType::kDictIndex32) != isDictionaryEncoded)
+         throw RException(R__FAIL("string field `" + GetQualifiedFieldName() +
+                                  "` mixes dictionary-encoded and plain column representations"));
+   }
+
+   if (isDictionaryEncoded) {
+      GenerateColumnsImpl<std::uint32_t, ClusterSize_t, char>(desc);
+      fDictionaryCharColumn = fAvailableColumns[2].get();
+   } else {
+      GenerateColumnsImpl<ClusterSize_t, char>(desc);
+   }
 }
 
 std::size_t ROOT::Experimental::RField<std::string>::AppendImpl(const void *from)
 {
    auto typedValue = static_cast<const std::string *>(from);
    auto length = typedValue->length();
+
+   if (fDictionaryCharColumn) {
+      const auto [itr, isNew] = fDictionary.try_emplace(*typedValue, fDictionary.size());
+      fPrincipalColumn->Append(&itr->second);
+      if (!isNew)
+         return fPrincipalColumn->GetElement()->GetPackedSize();
+
+      fDictionaryCharColumn->AppendV(typedValue->data(), length);
+      fIndex += length;
+      fAuxiliaryColumn->Append(&fIndex);
+      return length + fPrincipalColumn->GetElement()->GetPackedSize() + fAuxiliaryColumn->GetElement()->GetPackedSize();
+   }
+
    fAuxiliaryColumn->AppendV(typedValue->data(), length);
    fIndex += length;
    fPrincipalColumn->Append(&fIndex);
    return length + fPrincipalColumn->GetElement()->GetPackedSize();
 }
 
+void ROOT::Experimental::RField<std::string>::ReadDictionaryEntry(RClusterIndex entryIndex, std::string &to)
+{
+   RClusterIndex collectionStart;
+   ClusterSize_t nChars;
+   fAuxiliaryColumn->GetCollectionInfo(entryIndex, &collectionStart, &nChars);
+   if (nChars == 0) {
+      to.clear();
+   } else {
+      to.resize(nChars);
+      fDictionaryCharColumn->ReadV(collectionStart, nChars, const_cast<char *>(to.data()));
+   }
+}
+
 void ROOT::Experimental::RField<std::string>::ReadGlobalImpl(ROOT::Experimental::NTupleSize_t globalIndex, void *to)
 {
    auto typedValue = static_cast<std::string *>(to);
+   if (fDictionaryCharColumn) {
+      ReadDictionaryEntry(GetDictionaryCode(globalIndex), *typedValue);
+      return;
+   }
+
    RClusterIndex collectionStart;
    ClusterSize_t nChars;
    fPrincipalColumn->GetCollectionInfo(globalIndex, &collectionStart, &nChars);
@@ -1753,6 +1811,67 @@ void ROOT::Experimental::RField<std::string>::AcceptVisitor(Detail::RFieldVisito
    visitor.VisitStringField(*this);
 }
 
+void ROOT::Experimental::RField<std::string>::SetDictionaryEncoded()
+{
+   SetColumnRepresentatives({{EColumnType::kDictIndex32, EColumnType::kSplitIndex64, EColumnType::kChar}});
+}
+
+bool ROOT::Experimental::RField<std::string>::IsDictionaryEncoded() const
+{
+   return GetColumnRepresentatives()[0][0] == EColumnType::kDictIndex32;
+}
+
+ROOT::Experimental::RClusterIndex
+ROOT::Experimental::RField<std::string>::GetDictionaryCode(NTupleSize_t globalIndex)
+{
+   if (!fDictionaryCharColumn || !fPrincipalColumn->GetPageSource())
+      throw RException(R__FAIL("field `" + GetQualifiedFieldName() + "` is not a dictionary-encoded string field " +
+                               "connected to a page source"));
+   const auto clusterIndex = fPrincipalColumn->GetClusterIndex(globalIndex);
+   std::uint32_t code;
+   fPrincipalColumn->Read(clusterIndex, &code);
+   return RClusterIndex(clusterIndex.GetClusterId(), code);
+}
+
+ROOT::Experimental::RClusterIndex
+ROOT::Experimental::RField<std::string>::FindDictionaryCode(DescriptorId_t clusterId, std::string_view value)
+{
+   if (!fDictionaryCharColumn || !fPrincipalColumn->GetPageSource())
+      throw RException(R__FAIL("field `" + GetQualifiedFieldName() + "` is not a dictionary-encoded string field " +
+                               "connected to a page source"));
+
+   if (clusterId != fDictionaryClusterId) {
+      fDictionary.clear();
+      fDictionaryClusterId = kInvalidDescriptorId;
+
+      // The dictionary size is the number of elements of the (not suppressed) dictionary offset column
+      std::uint64_t nEntries = 0;
+      {
+         auto descriptorGuard = fPrincipalColumn->GetPageSource()->GetSharedDescriptorGuard();
+         const auto &clusterDesc = descriptorGuard->GetClusterDescriptor(clusterId);
+         for (const auto &column : fAvailableColumns) {
+            if (column->GetIndex() != 1)
+               continue;
+            const auto &columnRange = clusterDesc.GetColumnRange(column->GetOnDiskId());
+            if (!columnRange.fIsSuppressed) {
+               nEntries = columnRange.fNElements;
+               break;
+            }
+         }
+      }
+
+      std::string entry;
+      for (std::uint64_t i = 0; i < nEntries; ++i) {
+         ReadDictionaryEntry(RClusterIndex(clusterId, i), entry);
+         fDictionary.emplace(entry, i);
+      }
+      fDictionaryClusterId = clusterId;
+   }
+
+   auto itr = fDictionary.find(std::string(value));
+   return RClusterIndex(clusterId, (itr == fDictionary.end()) ? kInvalidClusterIndex : ClusterSize_t(itr->second));
+}
+
 //------------------------------------------------------------------------------
 
 ROOT::Experimental::RClassField::RClassField(std::string_view fieldName, std::string_view className)
@@ -2777,7 +2896,8 @@ void ROOT::Experimental::RRVecField::ReadGlobalImpl(NTupleSize_t globalIndex, vo
 
    // See "semantics of reading non-trivial objects" in RNTuple's architecture.md for details
    // on the element construction/destrution.
-   const bool owns = (*capacityPtr != -1);
+   // The buffer is neither freed nor reused if the RVec adopts its memory or if it was allocated from an RVecArena.
+   const bool owns = (*capacityPtr >= 0);
    const bool needsConstruct = !(fSubFields[0]->GetTraits() & kTraitTriviallyConstructible);
    const bool needsDestruct = owns && fItemDeleter;
 
@@ -3192,7 +3312,7 @@ void ROOT::Experimental::RArrayAsRVecField::ConstructValue(void *where) const
    // Need to allocate the RVec if it is the first time the value is being created.
    // See "semantics of reading non-trivial objects" in RNTuple's architecture.md for details
    // on the element construction.
-   const bool owns = (*capacityPtr != -1); // RVec is adopting the memory
+   const bool owns = (*capacityPtr >= 0); // RVec is not adopting the memory nor using an RVecArena
    const bool needsConstruct = !(fSubFields[0]->GetTraits() & kTraitTriviallyConstructible);
    const bool needsDestruct = owns && fItemDeleter;
 
@@ -573,9 +573,20 @@ ROOT::Experimental::RResult<void> ROOT::Experimental::Internal::RClusterDescript
       return R__FAIL("column ID conflict");
    RClusterDescriptor::RColumnRange columnRange{physicalId, firstElementIndex, ClusterSize_t{0}};
    columnRange.fCompressionSettings = compressionSettings;
+   bool hasValueRanges = !pageRange.fPageInfos.empty();
    for (const auto &pi : pageRange.fPageInfos) {
       columnRange.fNElements += pi.fNElements;
+      if (!pi.fValueRange) {
+         hasValueRanges = false;
+      } else if (hasValueRanges) {
+         if (columnRange.fValueRange)
+            columnRange.fValueRange->Merge(*pi.fValueRange);
+         else
+            columnRange.fValueRange = pi.fValueRange;
+      }
    }
+   if (!hasValueRanges)
+      columnRange.fValueRange.reset();
    fCluster.fPageRanges[physicalId] = pageRange.Clone();
    fCluster.fColumnRanges[physicalId] = columnRange;
    return RResult<void>::Success();
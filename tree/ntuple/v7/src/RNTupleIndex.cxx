@@ -14,6 +14,14 @@
  *************************************************************************/
 
 #include <ROOT/RNTupleIndex.hxx>
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+#include <TROOT.h>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
 
 namespace {
 ROOT::Experimental::Internal::RNTupleIndex::NTupleIndexValue_t
@@ -31,6 +39,16 @@ CastValuePtr(void *valuePtr, const ROOT::Experimental::RFieldBase &field)
 
    return value;
 }
+
+/// The index keys and their hashes of the entries of a single cluster
+struct RClusterKeys {
+   ROOT::Experimental::DescriptorId_t fClusterId = ROOT::Experimental::kInvalidDescriptorId;
+   ROOT::Experimental::NTupleSize_t fFirstEntry = 0;
+   ROOT::Experimental::NTupleSize_t fNEntries = 0;
+   /// The composite keys of the entries, back to back
+   std::vector<ROOT::Experimental::Internal::RNTupleIndex::NTupleIndexValue_t> fKeys;
+   std::vector<std::uint64_t> fHashes;
+};
 } // anonymous namespace
 
 ROOT::Experimental::Internal::RNTupleIndex::RNTupleIndex(const std::vector<std::string> &fieldNames,
@@ -74,6 +92,67 @@ ROOT::Experimental::Internal::RNTupleIndex::Create(const std::vector<std::string
    return index;
 }
 
+std::uint64_t
+ROOT::Experimental::Internal::RNTupleIndex::FindKey(const NTupleIndexValue_t *key, std::uint64_t hash) const
+{
+   if (fSlots.empty())
+      return kInvalidNTupleIndex;
+
+   const auto nKeyFields = fIndexFields.size();
+   const std::uint64_t mask = fSlots.size() - 1;
+   for (auto slotIdx = hash & mask;; slotIdx = (slotIdx + 1) & mask) {
+      const auto slot = fSlots[slotIdx];
+      if (slot == 0)
+         return kInvalidNTupleIndex;
+      const auto keyIdx = slot - 1;
+      if (fKeyHashes[keyIdx] == hash &&
+          std::equal(key, key + nKeyFields, fKeys.begin() + keyIdx * nKeyFields)) {
+         return keyIdx;
+      }
+   }
+}
+
+void ROOT::Experimental::Internal::RNTupleIndex::Grow()
+{
+   const std::size_t nSlots = std::max<std::size_t>(16, 2 * fSlots.size());
+   fSlots.assign(nSlots, 0);
+   const std::uint64_t mask = nSlots - 1;
+   for (std::uint64_t keyIdx = 0; keyIdx < fKeyHashes.size(); ++keyIdx) {
+      auto slotIdx = fKeyHashes[keyIdx] & mask;
+      while (fSlots[slotIdx] != 0)
+         slotIdx = (slotIdx + 1) & mask;
+      fSlots[slotIdx] = keyIdx + 1;
+   }
+}
+
+void ROOT::Experimental::Internal::RNTupleIndex::Insert(const NTupleIndexValue_t *key, std::uint64_t hash,
+                                                        NTupleSize_t entryNumber)
+{
+   const auto nKeyFields = fIndexFields.size();
+   // Keep the load factor below 1/2
+   if (2 * (fEntryNumbers.size() + 1) > fSlots.size())
+      Grow();
+
+   const std::uint64_t mask = fSlots.size() - 1;
+   auto slotIdx = hash & mask;
+   for (;; slotIdx = (slotIdx + 1) & mask) {
+      const auto slot = fSlots[slotIdx];
+      if (slot == 0)
+         break;
+      const auto keyIdx = slot - 1;
+      if (fKeyHashes[keyIdx] == hash &&
+          std::equal(key, key + nKeyFields, fKeys.begin() + keyIdx * nKeyFields)) {
+         fEntryNumbers[keyIdx].push_back(entryNumber);
+         return;
+      }
+   }
+
+   fSlots[slotIdx] = fEntryNumbers.size() + 1;
+   fKeys.insert(fKeys.end(), key, key + nKeyFields);
+   fKeyHashes.push_back(hash);
+   fEntryNumbers.push_back({entryNumber});
+}
+
 void ROOT::Experimental::Internal::RNTupleIndex::Build()
 {
    if (fIsBuilt)
@@ -83,30 +162,79 @@ void ROOT::Experimental::Internal::RNTupleIndex::Build()
                                                                 "std::int64_t",  "std::uint8_t", "std::uint16_t",
                                                                 "std::uint32_t", "std::uint64_t"};
 
-   std::vector<RFieldBase::RValue> fieldValues;
-   fieldValues.reserve(fIndexFields.size());
-
    for (const auto &field : fIndexFields) {
       if (allowedTypes.find(field->GetTypeName()) == allowedTypes.end()) {
          throw RException(R__FAIL("Cannot use field \"" + field->GetFieldName() + "\" with type \"" +
                                   field->GetTypeName() + "\" for indexing. Only integral types are allowed."));
       }
-      fieldValues.emplace_back(field->CreateValue());
    }
 
-   std::vector<NTupleIndexValue_t> indexValues;
-   indexValues.reserve(fIndexFields.size());
+   std::vector<RClusterKeys> clusterKeys;
+   std::vector<DescriptorId_t> fieldIds;
+   {
+      auto desc = fPageSource->GetSharedDescriptorGuard();
+      for (const auto &clusterDesc : desc->GetClusterIterable()) {
+         if (clusterDesc.GetNEntries() == 0)
+            continue;
+         auto &keys = clusterKeys.emplace_back();
+         keys.fClusterId = clusterDesc.GetId();
+         keys.fFirstEntry = clusterDesc.GetFirstEntryIndex();
+         keys.fNEntries = clusterDesc.GetNEntries();
+      }
+      for (const auto &field : fIndexFields)
+         fieldIds.emplace_back(field->GetOnDiskId());
+   }
+   std::sort(clusterKeys.begin(), clusterKeys.end(),
+             [](const RClusterKeys &a, const RClusterKeys &b) { return a.fFirstEntry < b.fFirstEntry; });
 
-   for (unsigned i = 0; i < fPageSource->GetNEntries(); ++i) {
-      indexValues.clear();
-      for (auto &fieldValue : fieldValues) {
-         // TODO(fdegeus): use bulk reading
-         fieldValue.Read(i);
+   const auto nKeyFields = fIndexFields.size();
+   // Reads the index fields of a cluster in bulk and computes the keys and their hashes. Every invocation uses its own
+   // page source and fields, so that clusters can be processed concurrently.
+   auto fnReadCluster = [&](std::size_t clusterIdx) {
+      auto &keys = clusterKeys[clusterIdx];
+      auto pageSource = fPageSource->Clone();
 
-         auto valuePtr = fieldValue.GetPtr<void>();
-         indexValues.push_back(CastValuePtr(valuePtr.get(), fieldValue.GetField()));
+      keys.fKeys.resize(keys.fNEntries * nKeyFields);
+      const auto maskReq = std::make_unique<bool[]>(keys.fNEntries);
+      std::fill(maskReq.get(), maskReq.get() + keys.fNEntries, true);
+      for (std::size_t i = 0; i < nKeyFields; ++i) {
+         auto field = fIndexFields[i]->Clone(fIndexFields[i]->GetFieldName());
+         field->SetOnDiskId(fieldIds[i]);
+         CallConnectPageSourceOnField(*field, *pageSource);
+
+         // For top-level fields, the cluster-local element index is the entry index relative to the cluster
+         auto bulk = field->CreateBulk();
+         auto values = static_cast<unsigned char *>(
+            bulk.ReadBulk(RClusterIndex(keys.fClusterId, 0), maskReq.get(), keys.fNEntries));
+         const auto valueSize = field->GetValueSize();
+         for (std::size_t j = 0; j < keys.fNEntries; ++j) {
+            keys.fKeys[j * nKeyFields + i] = CastValuePtr(values + j * valueSize, *field);
+         }
+      }
+
+      keys.fHashes.resize(keys.fNEntries);
+      for (std::size_t j = 0; j < keys.fNEntries; ++j) {
+         keys.fHashes[j] = HashKey(&keys.fKeys[j * nKeyFields], nKeyFields);
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor().Foreach(fnReadCluster, ROOT::TSeq<std::size_t>(clusterKeys.size()));
+   } else
+#endif
+   {
+      for (std::size_t i = 0; i < clusterKeys.size(); ++i)
+         fnReadCluster(i);
+   }
+
+   // The insertion is done sequentially, in entry order, so that the entry numbers of every key are sorted
+   for (auto &keys : clusterKeys) {
+      for (std::size_t j = 0; j < keys.fNEntries; ++j) {
+         Insert(&keys.fKeys[j * nKeyFields], keys.fHashes[j], keys.fFirstEntry + j);
       }
-      fIndex[RIndexValue(indexValues)].push_back(i);
+      keys.fKeys = {};
+      keys.fHashes = {};
    }
 
    fIsBuilt = true;
@@ -136,10 +264,9 @@ ROOT::Experimental::Internal::RNTupleIndex::GetAllEntryNumbers(const std::vector
       indexValues.push_back(CastValuePtr(valuePtrs[i], *fIndexFields[i]));
    }
 
-   auto entryNumber = fIndex.find(RIndexValue(indexValues));
-
-   if (entryNumber == fIndex.end())
+   const auto keyIdx = FindKey(indexValues.data(), HashKey(indexValues.data(), indexValues.size()));
+   if (keyIdx == kInvalidNTupleIndex)
       return nullptr;
 
-   return &(entryNumber->second);
+   return &fEntryNumbers[keyIdx];
 }
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <deque>
+#include <future>
 #include <inttypes.h> // for PRIu64
 #include <unordered_map>
 #include <vector>
@@ -384,19 +385,24 @@ void RNTupleMerger::MergeCommonColumns(RClusterPool &clusterPool, DescriptorId_t
 
    const auto &clusterDesc = mergeData.fSrcDescriptor->GetClusterDescriptor(clusterId);
 
+   // The recompression tasks of all the columns of the cluster run concurrently, so the column elements they
+   // reference have to stay alive until the tasks are finished.
+   std::vector<std::unique_ptr<RColumnElementBase>> columnElements;
+
    for (const auto &column : commonColumns) {
       const auto &columnId = column.fInputId;
       R__ASSERT(clusterDesc.ContainsColumn(columnId));
 
       const auto &columnDesc = mergeData.fSrcDescriptor->GetColumnDescriptor(columnId);
-      const auto srcColElement = RColumnElementBase::Generate(columnDesc.GetType());
-      const auto dstColElement = RColumnElementBase::Generate(column.fColumnType);
+      const auto &srcColElement = columnElements.emplace_back(RColumnElementBase::Generate(columnDesc.GetType()));
+      const auto &dstColElement = columnElements.emplace_back(RColumnElementBase::Generate(column.fColumnType));
 
       // Now get the pages for this column in this cluster
       const auto &pages = clusterDesc.GetPageRange(columnId);
 
-      RPageStorage::SealedPageSequence_t sealedPages;
-      sealedPages.resize(pages.fPageInfos.size());
+      // Emplaced directly into the deque such that the addresses of the sealed pages referenced by the
+      // recompression tasks remain stable
+      auto &sealedPages = sealedPageData.fPagesV.emplace_back(pages.fPageInfos.size());
 
       // Each column range potentially has a distinct compression settings
       const auto colRangeCompressionSettings = clusterDesc.GetColumnRange(columnId).fCompressionSettings;
@@ -451,13 +457,11 @@ void RNTupleMerger::MergeCommonColumns(RClusterPool &clusterPool, DescriptorId_t
 
       } // end of loop over pages
 
-      if (fTaskGroup)
-         fTaskGroup->Wait();
-
-      sealedPageData.fPagesV.push_back(std::move(sealedPages));
-      sealedPageData.fGroups.emplace_back(column.fOutputId, sealedPageData.fPagesV.back().cbegin(),
-                                          sealedPageData.fPagesV.back().cend());
+      sealedPageData.fGroups.emplace_back(column.fOutputId, sealedPages.cbegin(), sealedPages.cend());
    } // end loop over common columns
+
+   if (fTaskGroup)
+      fTaskGroup->Wait();
 }
 
 // Generates default values for columns that are not present in the current source RNTuple
@@ -677,9 +681,27 @@ RNTupleMerger::Merge(std::span<RPageSource *> sources, RPageSink &destination, c
       }                                                                              \
    } while (0)
 
+   // Attaching a source reads its header, footer and page lists, which is latency bound for remote storage.
+   // Therefore, the next few sources are attached in the background while the current one is being merged.
+   // Sources may be backed by a TFile, so we only do so if ROOT's thread safety is enabled through IMT.
+   std::vector<std::future<void>> attachTasks(sources.size());
+   const bool usePrefetch = fTaskGroup.has_value() && mergeOpts.fNPrefetchSources > 0;
+   auto fnPrefetch = [&](std::size_t idx) {
+      if (!usePrefetch || idx >= sources.size() || attachTasks[idx].valid())
+         return;
+      attachTasks[idx] = std::async(std::launch::async, [source = sources[idx]]() { source->Attach(); });
+   };
+
    // Merge main loop
-   for (RPageSource *source : sources) {
-      source->Attach();
+   for (std::size_t i = 0; i < sources.size(); ++i) {
+      RPageSource *source = sources[i];
+      for (std::size_t j = 1; j <= mergeOpts.fNPrefetchSources; ++j)
+         fnPrefetch(i + j);
+
+      if (attachTasks[i].valid())
+         attachTasks[i].get();
+      else
+         source->Attach();
       auto srcDescriptor = source->GetSharedDescriptorGuard();
       mergeData.fSrcDescriptor = &srcDescriptor.GetRef();
 
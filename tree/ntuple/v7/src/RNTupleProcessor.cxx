@@ -16,6 +16,24 @@
 #include <ROOT/RNTupleProcessor.hxx>
 
 #include <ROOT/RFieldBase.hxx>
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+#include <TROOT.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/// A cluster-aligned range of entries of one of the processor's RNTuples; the unit of work of ParallelForEach()
+struct RProcessorRange {
+   std::size_t fNTupleIndex = 0;
+   ROOT::Experimental::NTupleSize_t fFirstEntry = 0; ///< Entry index local to the RNTuple
+   ROOT::Experimental::NTupleSize_t fNEntries = 0;
+};
+
+} // anonymous namespace
 
 ROOT::Experimental::NTupleSize_t
 ROOT::Experimental::Internal::RNTupleProcessor::ConnectNTuple(const RNTupleSourceSpec &ntuple)
@@ -31,24 +49,96 @@ ROOT::Experimental::Internal::RNTupleProcessor::ConnectNTuple(const RNTupleSourc
 
 void ROOT::Experimental::Internal::RNTupleProcessor::ConnectFields()
 {
-   auto desc = fPageSource->GetSharedDescriptorGuard();
+   auto concreteFields = ConnectFields(*fPageSource, *fEntry);
+   for (std::size_t i = 0; i < fFieldContexts.size(); ++i) {
+      fFieldContexts[i].fConcreteField = std::move(concreteFields[i]);
+   }
+}
 
-   for (auto &fieldContext : fFieldContexts) {
+std::vector<std::unique_ptr<ROOT::Experimental::RFieldBase>>
+ROOT::Experimental::Internal::RNTupleProcessor::ConnectFields(RPageSource &pageSource, REntry &entry) const
+{
+   std::vector<std::unique_ptr<RFieldBase>> concreteFields;
+   auto desc = pageSource.GetSharedDescriptorGuard();
+
+   for (const auto &fieldContext : fFieldContexts) {
       auto fieldId = desc->FindFieldId(fieldContext.GetProtoField().GetFieldName());
       if (fieldId == kInvalidDescriptorId) {
          throw RException(
             R__FAIL("field \"" + fieldContext.GetProtoField().GetFieldName() + "\" not found in current RNTuple"));
       }
 
-      fieldContext.SetConcreteField();
-      fieldContext.fConcreteField->SetOnDiskId(desc->FindFieldId(fieldContext.GetProtoField().GetFieldName()));
-      Internal::CallConnectPageSourceOnField(*fieldContext.fConcreteField, *fPageSource);
+      auto &concreteField = concreteFields.emplace_back(
+         fieldContext.fProtoField->Clone(fieldContext.GetProtoField().GetFieldName()));
+      concreteField->SetOnDiskId(fieldId);
+      Internal::CallConnectPageSourceOnField(*concreteField, pageSource);
 
-      auto valuePtr = fEntry->GetPtr<void>(fieldContext.fToken);
-      auto value = fieldContext.fConcreteField->CreateValue();
+      auto valuePtr = entry.GetPtr<void>(fieldContext.fToken);
+      auto value = concreteField->CreateValue();
       value.Bind(valuePtr);
-      fEntry->UpdateValue(fieldContext.fToken, value);
+      entry.UpdateValue(fieldContext.fToken, value);
    }
+   return concreteFields;
+}
+
+void ROOT::Experimental::Internal::RNTupleProcessor::ParallelForEach(const ParallelCallback_t &callback)
+{
+   const auto nNTuples = fNTuples.size();
+   // Attached page sources serve as prototypes for the page sources of the entry ranges: cloning an attached page
+   // source does not read the RNTuple's metadata again.
+   std::vector<std::unique_ptr<RPageSource>> protoSources(nNTuples);
+   std::vector<std::vector<RProcessorRange>> rangesPerNTuple(nNTuples);
+   auto fnAttach = [&](std::size_t ntupleIndex) {
+      auto &source = protoSources[ntupleIndex];
+      source = RPageSource::Create(fNTuples[ntupleIndex].fName, fNTuples[ntupleIndex].fLocation);
+      source->Attach();
+
+      auto &ranges = rangesPerNTuple[ntupleIndex];
+      auto desc = source->GetSharedDescriptorGuard();
+      for (const auto &clusterDesc : desc->GetClusterIterable()) {
+         if (clusterDesc.GetNEntries() == 0)
+            continue;
+         ranges.push_back(
+            RProcessorRange{ntupleIndex, clusterDesc.GetFirstEntryIndex(), clusterDesc.GetNEntries()});
+      }
+      std::sort(ranges.begin(), ranges.end(),
+                [](const RProcessorRange &a, const RProcessorRange &b) { return a.fFirstEntry < b.fFirstEntry; });
+   };
+
+   auto fnForEach = [](auto &&fn, std::size_t n) {
+#ifdef R__USE_IMT
+      if (IsImplicitMTEnabled()) {
+         ROOT::TThreadExecutor().Foreach(fn, ROOT::TSeq<std::size_t>(n));
+         return;
+      }
+#endif
+      for (std::size_t i = 0; i < n; ++i)
+         fn(i);
+   };
+
+   // Opening the RNTuples is latency bound, so it is done in parallel as well
+   fnForEach(fnAttach, nNTuples);
+
+   std::vector<RProcessorRange> ranges;
+   std::vector<NTupleSize_t> globalOffsets(nNTuples, 0);
+   for (std::size_t i = 0; i < nNTuples; ++i) {
+      if (i > 0)
+         globalOffsets[i] = globalOffsets[i - 1] + protoSources[i - 1]->GetNEntries();
+      ranges.insert(ranges.end(), rangesPerNTuple[i].begin(), rangesPerNTuple[i].end());
+   }
+
+   auto fnProcessRange = [&](std::size_t rangeIndex) {
+      const auto &range = ranges[rangeIndex];
+      auto entry = fModel->CreateEntry();
+      auto source = protoSources[range.fNTupleIndex]->Clone();
+      auto concreteFields = ConnectFields(*source, *entry);
+
+      for (auto i = range.fFirstEntry; i < range.fFirstEntry + range.fNEntries; ++i) {
+         entry->Read(i);
+         callback(RIterator::RProcessorState(*entry, globalOffsets[range.fNTupleIndex] + i, i, range.fNTupleIndex));
+      }
+   };
+   fnForEach(fnProcessRange, ranges.size());
 }
 
 ROOT::Experimental::Internal::RNTupleProcessor::RNTupleProcessor(const std::vector<RNTupleSourceSpec> &ntuples,
@@ -85,6 +175,7 @@ ROOT::Experimental::Internal::RNTupleProcessor::RNTupleProcessor(const std::vect
 
       fFieldContexts.emplace_back(field.Clone(field.GetFieldName()), token);
    }
+   fModel = std::move(model);
 
    ConnectFields();
 }
@@ -25,6 +25,8 @@
 
 #include <TROOT.h>
 
+#include <algorithm>
+
 void ROOT::Experimental::RNTupleReader::ConnectModel(RNTupleModel &model)
 {
    auto &fieldZero = model.GetFieldZero();
@@ -133,6 +135,78 @@ const ROOT::Experimental::RNTupleModel &ROOT::Experimental::RNTupleReader::GetMo
    return *fModel;
 }
 
+void ROOT::Experimental::RNTupleReader::LoadSelectedEntries(
+   const std::vector<std::string> &predicateFields, const std::function<bool(const REntry &)> &predicate,
+   const std::function<void(NTupleSize_t, const REntry &)> &callback)
+{
+   auto &entry = const_cast<RNTupleModel &>(GetModel()).GetDefaultEntry();
+
+   std::vector<bool> isPredicateValue(entry.fValues.size(), false);
+   for (const auto &fieldName : predicateFields) {
+      // Throws if there is no such top-level field
+      entry.GetToken(fieldName);
+      isPredicateValue[entry.fFieldName2Token.at(fieldName)] = true;
+   }
+
+   // The fields of the model stay connected to fSource; the two reading phases use their own page sources, so that
+   // each page source's cluster pool only loads the columns of one of the phases.
+   auto predicateSource = fSource->Clone();
+   auto payloadSource = fSource->Clone();
+   std::vector<std::unique_ptr<RFieldBase>> fields;
+   std::vector<RFieldBase::RValue> predicateValues;
+   std::vector<RFieldBase::RValue> payloadValues;
+   for (std::size_t i = 0; i < entry.fValues.size(); ++i) {
+      const auto &value = entry.fValues[i];
+      auto &field = fields.emplace_back(value.GetField().Clone(value.GetField().GetFieldName()));
+      field->SetOnDiskId(value.GetField().GetOnDiskId());
+      Internal::CallConnectPageSourceOnField(*field, isPredicateValue[i] ? *predicateSource : *payloadSource);
+      auto &values = isPredicateValue[i] ? predicateValues : payloadValues;
+      values.emplace_back(field->BindValue(value.GetPtr<void>()));
+   }
+
+   std::vector<Internal::RPageSource::REntryRange> clusterRanges;
+   {
+      auto descriptorGuard = fSource->GetSharedDescriptorGuard();
+      for (const auto &clusterDesc : descriptorGuard->GetClusterIterable()) {
+         if (clusterDesc.GetNEntries() > 0)
+            clusterRanges.push_back({clusterDesc.GetFirstEntryIndex(), clusterDesc.GetNEntries()});
+      }
+   }
+   std::sort(clusterRanges.begin(), clusterRanges.end(),
+             [](const auto &a, const auto &b) { return a.fFirstEntry < b.fFirstEntry; });
+
+   std::vector<bool> selection;
+   for (const auto &range : clusterRanges) {
+      // Phase 1: evaluate the predicate for all entries of the cluster
+      selection.assign(range.fNEntries, false);
+      std::size_t nSelected = 0;
+      for (NTupleSize_t i = 0; i < range.fNEntries; ++i) {
+         for (auto &value : predicateValues)
+            value.Read(range.fFirstEntry + i);
+         if (predicate(entry)) {
+            selection[i] = true;
+            ++nSelected;
+         }
+      }
+      if (nSelected == 0)
+         continue;
+
+      // Phase 2: read the remaining values of the selected entries. Restricting the payload source's entry range to
+      // the current cluster prevents its cluster pool from prefetching clusters that may have no selected entries.
+      payloadSource->SetEntryRange(range);
+      for (NTupleSize_t i = 0; i < range.fNEntries; ++i) {
+         if (!selection[i])
+            continue;
+         const auto index = range.fFirstEntry + i;
+         for (auto &value : predicateValues)
+            value.Read(index);
+         for (auto &value : payloadValues)
+            value.Read(index);
+         callback(index, entry);
+      }
+   }
+}
+
 void ROOT::Experimental::RNTupleReader::PrintInfo(const ENTupleInfo what, std::ostream &output) const
 {
    // TODO(lesimon): In a later version, these variables may be defined by the user or the ideal width may be read out
@@ -28,6 +28,7 @@
 #include <TVirtualStreamerInfo.h>
 #include <xxhash.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstring> // for memcpy
@@ -709,6 +710,7 @@ ROOT::Experimental::Internal::RNTupleSerializer::SerializeColumnType(ROOT::Exper
    case EColumnType::kSplitUInt16: return SerializeUInt16(0x15, buffer);
    case EColumnType::kReal32Trunc: return SerializeUInt16(0x1D, buffer);
    case EColumnType::kReal32Quant: return SerializeUInt16(0x1E, buffer);
+   case EColumnType::kDictIndex32: return SerializeUInt16(0x1F, buffer);
    default: throw RException(R__FAIL("ROOT bug: unexpected column type"));
    }
 }
@@ -751,6 +753,7 @@ ROOT::Experimental::Internal::RNTupleSerializer::DeserializeColumnType(const voi
    case 0x15: type = EColumnType::kSplitUInt16; break;
    case 0x1D: type = EColumnType::kReal32Trunc; break;
    case 0x1E: type = EColumnType::kReal32Quant; break;
+   case 0x1F: type = EColumnType::kDictIndex32; break;
    default: return R__FAIL("unexpected on-disk column type");
    }
    return result;
@@ -1574,6 +1577,23 @@ ROOT::Experimental::Internal::RNTupleSerializer::SerializePageList(void *buffer,
             }
             pos += SerializeInt64(columnRange.fFirstElementIndex, *where);
             pos += SerializeUInt32(columnRange.fCompressionSettings, *where);
+
+            // Optional page value ranges, appended to the frame such that readers not aware of them skip over them
+            const bool hasValueRanges =
+               !pageRange.fPageInfos.empty() &&
+               std::all_of(pageRange.fPageInfos.begin(), pageRange.fPageInfos.end(),
+                           [](const RClusterDescriptor::RPageRange::RPageInfo &pi) { return pi.fValueRange.has_value(); });
+            if (hasValueRanges) {
+               pos += SerializeUInt32(kFlagPageListValueRanges, *where);
+               for (const auto &pi : pageRange.fPageInfos) {
+                  std::uint64_t intMin, intMax;
+                  static_assert(sizeof(pi.fValueRange->fMin) == sizeof(intMin));
+                  memcpy(&intMin, &pi.fValueRange->fMin, sizeof(intMin));
+                  memcpy(&intMax, &pi.fValueRange->fMax, sizeof(intMax));
+                  pos += SerializeUInt64(intMin, *where);
+                  pos += SerializeUInt64(intMax, *where);
+               }
+            }
          }
 
          pos += SerializeFramePostscript(buffer ? innerFrame : nullptr, pos - innerFrame);
@@ -1894,6 +1914,25 @@ ROOT::Experimental::Internal::RNTupleSerializer::DeserializePageList(const void
                return R__FAIL("page list frame too short");
             std::uint32_t compressionSettings;
             bytes += DeserializeUInt32(bytes, compressionSettings);
+
+            if (fnInnerFrameSizeLeft() >= sizeof(std::uint32_t)) {
+               std::uint32_t flags;
+               bytes += DeserializeUInt32(bytes, flags);
+               if (flags & kFlagPageListValueRanges) {
+                  if (fnInnerFrameSizeLeft() < nPages * 2 * sizeof(std::uint64_t))
+                     return R__FAIL("page list frame too short");
+                  for (auto &pi : pageRange.fPageInfos) {
+                     std::uint64_t minInt, maxInt;
+                     bytes += DeserializeUInt64(bytes, minInt);
+                     bytes += DeserializeUInt64(bytes, maxInt);
+                     RClusterDescriptor::RValueRange valueRange;
+                     memcpy(&valueRange.fMin, &minInt, sizeof(minInt));
+                     memcpy(&valueRange.fMax, &maxInt, sizeof(maxInt));
+                     pi.fValueRange = valueRange;
+                  }
+               }
+            }
+
             clusterBuilders[i].CommitColumnRange(j, columnOffset, compressionSettings, pageRange);
          }
 
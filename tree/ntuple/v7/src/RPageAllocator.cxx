@@ -14,11 +14,19 @@
  *************************************************************************/
 
 
+#include <ROOT/RConfig.hxx>
 #include <ROOT/RPageAllocator.hxx>
 
 #include <TError.h>
 
 #include <algorithm>
+#include <functional>
+#include <new>
+#include <thread>
+
+#ifdef R__LINUX
+#include <sys/mman.h>
+#endif
 
 ROOT::Experimental::Internal::RPage ROOT::Experimental::Internal::RPageAllocatorHeap::NewPage(ColumnId_t columnId,
                                                                                               std::size_t elementSize,
@@ -34,3 +42,126 @@ void ROOT::Experimental::Internal::RPageAllocatorHeap::DeletePage(RPage &page)
 {
    delete[] reinterpret_cast<unsigned char *>(page.GetBuffer());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+ROOT::Experimental::Internal::RPageAllocatorPool::RPageAllocatorPool(std::size_t maxNBytesCached, bool useHugePages)
+   : fMaxNBytesCached(maxNBytesCached), fUseHugePages(useHugePages)
+{
+}
+
+ROOT::Experimental::Internal::RPageAllocatorPool::~RPageAllocatorPool()
+{
+   for (auto &shard : fShards) {
+      for (unsigned int i = 0; i < kNSizeClasses; ++i) {
+         for (auto buffer : shard.fFreeLists[i])
+            FreeBuffer(buffer, GetSizeClassNBytes(i));
+      }
+   }
+}
+
+unsigned int ROOT::Experimental::Internal::RPageAllocatorPool::GetSizeClass(std::size_t nbytes)
+{
+   unsigned int sizeClass = 0;
+   while ((sizeClass < kNSizeClasses) && (GetSizeClassNBytes(sizeClass) < nbytes))
+      ++sizeClass;
+   return sizeClass;
+}
+
+ROOT::Experimental::Internal::RPageAllocatorPool::RShard &
+ROOT::Experimental::Internal::RPageAllocatorPool::GetShardOfThisThread()
+{
+   thread_local const std::size_t idxShard = std::hash<std::thread::id>()(std::this_thread::get_id()) % kNShards;
+   return fShards[idxShard];
+}
+
+void *ROOT::Experimental::Internal::RPageAllocatorPool::AllocateBuffer(std::size_t nbytes)
+{
+#ifdef R__LINUX
+   if (fUseHugePages && (nbytes >= kHugePageSize)) {
+      void *buffer = mmap(nullptr, nbytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (buffer == MAP_FAILED)
+         throw std::bad_alloc();
+      // Only a hint; failure leaves us with regular pages
+      madvise(buffer, nbytes, MADV_HUGEPAGE);
+      return buffer;
+   }
+#endif
+   return new unsigned char[nbytes];
+}
+
+void ROOT::Experimental::Internal::RPageAllocatorPool::FreeBuffer(void *buffer, std::size_t nbytes)
+{
+#ifdef R__LINUX
+   if (fUseHugePages && (nbytes >= kHugePageSize)) {
+      munmap(buffer, nbytes);
+      return;
+   }
+#else
+   (void)nbytes;
+#endif
+   delete[] reinterpret_cast<unsigned char *>(buffer);
+}
+
+ROOT::Experimental::Internal::RPage ROOT::Experimental::Internal::RPageAllocatorPool::NewPage(ColumnId_t columnId,
+                                                                                              std::size_t elementSize,
+                                                                                              std::size_t nElements)
+{
+   R__ASSERT((elementSize > 0) && (nElements > 0));
+   const auto nbytes = elementSize * nElements;
+   const auto sizeClass = GetSizeClass(nbytes);
+   if (sizeClass == kNSizeClasses)
+      return RPage(columnId, AllocateBuffer(nbytes), this, elementSize, nElements);
+
+   // Try the free list of this thread's shard first, then steal from other shards without blocking
+   auto &ownShard = GetShardOfThisThread();
+   void *buffer = nullptr;
+   {
+      std::lock_guard<std::mutex> guard(ownShard.fLock);
+      auto &freeList = ownShard.fFreeLists[sizeClass];
+      if (!freeList.empty()) {
+         buffer = freeList.back();
+         freeList.pop_back();
+      }
+   }
+   for (unsigned int i = 0; !buffer && (i < kNShards); ++i) {
+      auto &shard = fShards[i];
+      if ((&shard == &ownShard) || !shard.fLock.try_lock())
+         continue;
+      auto &freeList = shard.fFreeLists[sizeClass];
+      if (!freeList.empty()) {
+         buffer = freeList.back();
+         freeList.pop_back();
+      }
+      shard.fLock.unlock();
+   }
+
+   if (buffer) {
+      fNBytesCached -= GetSizeClassNBytes(sizeClass);
+   } else {
+      buffer = AllocateBuffer(GetSizeClassNBytes(sizeClass));
+   }
+   return RPage(columnId, buffer, this, elementSize, nElements);
+}
+
+void ROOT::Experimental::Internal::RPageAllocatorPool::DeletePage(RPage &page)
+{
+   // The page capacity is the number of bytes requested in NewPage(), so it maps to the same size class
+   const auto nbytes = page.GetCapacity();
+   const auto sizeClass = GetSizeClass(nbytes);
+   if (sizeClass == kNSizeClasses) {
+      FreeBuffer(page.GetBuffer(), nbytes);
+      return;
+   }
+
+   const auto nbytesClass = GetSizeClassNBytes(sizeClass);
+   if (fNBytesCached.fetch_add(nbytesClass) + nbytesClass > fMaxNBytesCached) {
+      fNBytesCached -= nbytesClass;
+      FreeBuffer(page.GetBuffer(), nbytesClass);
+      return;
+   }
+
+   auto &shard = GetShardOfThisThread();
+   std::lock_guard<std::mutex> guard(shard.fLock);
+   shard.fFreeLists[sizeClass].emplace_back(page.GetBuffer());
+}
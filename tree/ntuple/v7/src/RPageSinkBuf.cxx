@@ -19,9 +19,11 @@
 #include <ROOT/RNTupleWriteOptions.hxx>
 #include <ROOT/RNTupleZip.hxx>
 #include <ROOT/RPageSinkBuf.hxx>
+#include <ROOT/RNTupleImtTaskScheduler.hxx>
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 void ROOT::Experimental::Internal::RPageSinkBuf::RColumnBuf::DropBufferedPages()
 {
@@ -50,6 +52,10 @@ ROOT::Experimental::Internal::RPageSinkBuf::~RPageSinkBuf()
    // This cannot be moved to the base class destructor, given non-static members have been destroyed by the time the
    // base class destructor is invoked.
    WaitForAllTasks();
+   if (fClusterTasks)
+      fClusterTasks->Wait();
+   if (fPendingClusterTasks)
+      fPendingClusterTasks->Wait();
 }
 
 ROOT::Experimental::Internal::RPageStorage::ColumnHandle_t
@@ -92,6 +98,7 @@ void ROOT::Experimental::Internal::RPageSinkBuf::InitImpl(RNTupleModel &model)
 void ROOT::Experimental::Internal::RPageSinkBuf::UpdateSchema(const RNTupleModelChangeset &changeset,
                                                               NTupleSize_t firstEntry)
 {
+   CommitPendingCluster();
    ConnectFields(changeset.fAddedFields, firstEntry);
 
    // The buffered page sink maintains a copy of the RNTupleModel for the inner sink; replicate the changes there
@@ -148,7 +155,8 @@ void ROOT::Experimental::Internal::RPageSinkBuf::CommitPage(ColumnHandle_t colum
    R__ASSERT(zipItem.fBuf);
    auto &sealedPage = fBufferedColumns.at(colId).RegisterSealedPage();
 
-   if (!fTaskScheduler) {
+   auto taskScheduler = GetSealingTaskScheduler();
+   if (!taskScheduler) {
       // Seal the page right now, avoiding the allocation and copy, but making sure that the page buffer is not aliased.
       RSealPageConfig config;
       config.fPage = &page;
@@ -158,6 +166,8 @@ void ROOT::Experimental::Internal::RPageSinkBuf::CommitPage(ColumnHandle_t colum
       config.fAllowAlias = false;
       config.fBuffer = zipItem.fBuf.get();
       sealedPage = SealPage(config);
+      if (GetWriteOptions().GetEnableValueRanges())
+         sealedPage.SetValueRange(ComputeValueRange(page, *columnHandle.fColumn));
       zipItem.fSealedPage = &sealedPage;
       return;
    }
@@ -171,7 +181,8 @@ void ROOT::Experimental::Internal::RPageSinkBuf::CommitPage(ColumnHandle_t colum
    fCounters->fParallelZip.SetValue(1);
    // Thread safety: Each thread works on a distinct zipItem which owns its
    // compression buffer.
-   fTaskScheduler->AddTask([this, &zipItem, &sealedPage, &element] {
+   const auto column = columnHandle.fColumn;
+   taskScheduler->AddTask([this, &zipItem, &sealedPage, &element, column] {
       RSealPageConfig config;
       config.fPage = &zipItem.fPage;
       config.fElement = &element;
@@ -180,10 +191,24 @@ void ROOT::Experimental::Internal::RPageSinkBuf::CommitPage(ColumnHandle_t colum
       config.fAllowAlias = true;
       config.fBuffer = zipItem.fBuf.get();
       sealedPage = SealPage(config);
+      if (GetWriteOptions().GetEnableValueRanges())
+         sealedPage.SetValueRange(ComputeValueRange(zipItem.fPage, *column));
       zipItem.fSealedPage = &sealedPage;
    });
 }
 
+ROOT::Experimental::Internal::RPageStorage::RTaskScheduler *
+ROOT::Experimental::Internal::RPageSinkBuf::GetSealingTaskScheduler()
+{
+   if (!fTaskScheduler)
+      return nullptr;
+#ifdef R__USE_IMT
+   if (!fClusterTasks && GetWriteOptions().GetUseDoubleBufferedClusters())
+      fClusterTasks = std::make_unique<RNTupleImtTaskScheduler>();
+#endif
+   return fClusterTasks ? fClusterTasks.get() : fTaskScheduler;
+}
+
 void ROOT::Experimental::Internal::RPageSinkBuf::CommitSealedPage(DescriptorId_t /*physicalColumnId*/,
                                                                   const RSealedPage & /*sealedPage*/)
 {
@@ -195,16 +220,13 @@ void ROOT::Experimental::Internal::RPageSinkBuf::CommitSealedPageV(std::span<RPa
    throw RException(R__FAIL("should never commit sealed pages to RPageSinkBuf"));
 }
 
-// We implement both StageCluster() and CommitCluster() because we can call CommitCluster() on the inner sink more
-// efficiently in a single critical section. For parallel writing, it also guarantees that we produce a fully sequential
-// file.
-void ROOT::Experimental::Internal::RPageSinkBuf::FlushClusterImpl(std::function<void(void)> FlushClusterFn)
+void ROOT::Experimental::Internal::RPageSinkBuf::CommitBufferedCluster(std::vector<RColumnBuf> &columns,
+                                                                       std::vector<ColumnHandle_t> &suppressedColumns,
+                                                                       std::function<void(void)> FlushClusterFn)
 {
-   WaitForAllTasks();
-
    std::vector<RSealedPageGroup> toCommit;
-   toCommit.reserve(fBufferedColumns.size());
-   for (auto &bufColumn : fBufferedColumns) {
+   toCommit.reserve(columns.size());
+   for (auto &bufColumn : columns) {
       R__ASSERT(bufColumn.HasSealedPagesOnly());
       const auto &sealedPages = bufColumn.GetSealedPages();
       toCommit.emplace_back(bufColumn.GetHandle().fPhysicalId, sealedPages.cbegin(), sealedPages.cend());
@@ -215,21 +237,66 @@ void ROOT::Experimental::Internal::RPageSinkBuf::FlushClusterImpl(std::function<
       Detail::RNTuplePlainTimer timer(fCounters->fTimeWallCriticalSection, fCounters->fTimeCpuCriticalSection);
       fInnerSink->CommitSealedPageV(toCommit);
 
-      for (auto handle : fSuppressedColumns)
+      for (auto handle : suppressedColumns)
          fInnerSink->CommitSuppressedColumn(handle);
-      fSuppressedColumns.clear();
+      suppressedColumns.clear();
 
       FlushClusterFn();
    }
 
-   for (auto &bufColumn : fBufferedColumns)
+   for (auto &bufColumn : columns)
       bufColumn.DropBufferedPages();
 }
 
+// We implement both StageCluster() and CommitCluster() because we can call CommitCluster() on the inner sink more
+// efficiently in a single critical section. For parallel writing, it also guarantees that we produce a fully sequential
+// file.
+void ROOT::Experimental::Internal::RPageSinkBuf::FlushClusterImpl(std::function<void(void)> FlushClusterFn)
+{
+   CommitPendingCluster();
+
+   WaitForAllTasks();
+   if (fClusterTasks)
+      fClusterTasks->Wait();
+
+   CommitBufferedCluster(fBufferedColumns, fSuppressedColumns, FlushClusterFn);
+}
+
+void ROOT::Experimental::Internal::RPageSinkBuf::CommitPendingCluster()
+{
+   if (!fHasPendingCluster)
+      return;
+
+   fPendingClusterTasks->Wait();
+   CommitBufferedCluster(fPendingColumns, fPendingSuppressedColumns,
+                         [&] { fNBytesLastCluster = fInnerSink->CommitCluster(fPendingNEntries); });
+   fHasPendingCluster = false;
+}
+
 std::uint64_t ROOT::Experimental::Internal::RPageSinkBuf::CommitCluster(ROOT::Experimental::NTupleSize_t nNewEntries)
 {
+   // The first cluster is written synchronously, such that the caller gets a first measurement of the compressed
+   // cluster size. Afterwards, the returned size of a deferred cluster is the size of the previous cluster.
+   if (fClusterTasks && fNBytesLastCluster > 0) {
+      CommitPendingCluster();
+
+#ifdef R__USE_IMT
+      // fClusterTasks is only set with IMT
+      if (!fPendingClusterTasks)
+         fPendingClusterTasks = std::make_unique<RNTupleImtTaskScheduler>();
+#endif
+      std::swap(fClusterTasks, fPendingClusterTasks);
+      std::swap(fBufferedColumns, fPendingColumns);
+      std::swap(fSuppressedColumns, fPendingSuppressedColumns);
+      fBufferedColumns.resize(fNColumns);
+      fPendingNEntries = nNewEntries;
+      fHasPendingCluster = true;
+      return fNBytesLastCluster;
+   }
+
    std::uint64_t nbytes;
    FlushClusterImpl([&] { nbytes = fInnerSink->CommitCluster(nNewEntries); });
+   fNBytesLastCluster = nbytes;
    return nbytes;
 }
 
@@ -250,6 +317,7 @@ void ROOT::Experimental::Internal::RPageSinkBuf::CommitStagedClusters(std::span<
 
 void ROOT::Experimental::Internal::RPageSinkBuf::CommitClusterGroup()
 {
+   CommitPendingCluster();
    RPageSink::RSinkGuard g(fInnerSink->GetSinkGuard());
    Detail::RNTuplePlainTimer timer(fCounters->fTimeWallCriticalSection, fCounters->fTimeCpuCriticalSection);
    fInnerSink->CommitClusterGroup();
@@ -257,6 +325,7 @@ void ROOT::Experimental::Internal::RPageSinkBuf::CommitClusterGroup()
 
 void ROOT::Experimental::Internal::RPageSinkBuf::CommitDatasetImpl()
 {
+   CommitPendingCluster();
    RPageSink::RSinkGuard g(fInnerSink->GetSinkGuard());
    Detail::RNTuplePlainTimer timer(fCounters->fTimeWallCriticalSection, fCounters->fTimeCpuCriticalSection);
    fInnerSink->CommitDataset();
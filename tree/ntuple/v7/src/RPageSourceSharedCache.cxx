@@ -0,0 +1,556 @@
+/// \file RPageSourceSharedCache.cxx
+/// \ingroup NTuple ROOT7
+/// \author Jakob Blomer <jblomer@cern.ch>
+/// \date 2024-10-14
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RCluster.hxx>
+#include <ROOT/RColumn.hxx>
+#include <ROOT/RError.hxx>
+#include <ROOT/RNTupleReadOptions.hxx>
+#include <ROOT/RPageAllocator.hxx>
+#include <ROOT/RPageSourceSharedCache.hxx>
+
+#include <xxhash.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+
+namespace {
+constexpr std::uint64_t kMagic = 0x52534850434143ULL; // "RSHPCAC"
+/// How long a process waits for another process to finish the initialization of a new segment
+constexpr auto kInitTimeout = std::chrono::seconds(10);
+/// The page data area starts at a page boundary
+constexpr std::size_t kDataAlignment = 4096;
+
+std::string GetSegmentName(std::string_view name)
+{
+   // POSIX shared-memory object names start with a slash
+   if (!name.empty() && name[0] == '/')
+      return std::string(name);
+   return "/" + std::string(name);
+}
+
+std::size_t AlignUp(std::size_t n, std::size_t alignment)
+{
+   return (n + alignment - 1) / alignment * alignment;
+}
+} // anonymous namespace
+
+struct ROOT::Experimental::Internal::RSharedPageCache::RHeader {
+   /// Set last, once the segment is initialized
+   std::atomic<std::uint64_t> fMagic;
+   std::uint64_t fBlockSize;
+   std::uint64_t fNBlocks;
+   std::uint64_t fEntriesOffset;
+   std::uint64_t fBucketsOffset;
+   std::uint64_t fDataOffset;
+   /// Logical clock for the LRU policy, incremented on every page access
+   std::uint64_t fTick;
+   std::uint64_t fNPages;
+   pthread_mutex_t fMutex;
+};
+
+struct ROOT::Experimental::Internal::RSharedPageCache::REntry {
+   RKey fKey;
+   /// Page size in bytes
+   std::uint64_t fNBytes;
+   /// Value of the logical clock at the last access
+   std::uint64_t fLastUse;
+   /// For the first block of a page, the number of blocks of the page; zero otherwise
+   std::uint32_t fNBlocks;
+   /// Next entry in the collision chain of the hash index, or -1
+   std::int32_t fNext;
+   /// For occupied blocks, the first block of the page; -1 for free blocks
+   std::int32_t fFirstBlock;
+};
+
+namespace {
+/// Locks the process-shared mutex of the segment. If the previous owner died while holding the mutex, the cache
+/// content may be inconsistent and is dropped.
+class RSegmentLockGuard {
+   pthread_mutex_t &fMutex;
+
+public:
+   template <typename ClearFuncT>
+   RSegmentLockGuard(pthread_mutex_t &mutex, ClearFuncT clear) : fMutex(mutex)
+   {
+      auto rc = pthread_mutex_lock(&fMutex);
+#ifdef __linux__
+      if (rc == EOWNERDEAD) {
+         clear();
+         pthread_mutex_consistent(&fMutex);
+         rc = 0;
+      }
+#else
+      (void)clear;
+#endif
+      if (rc != 0) {
+         throw ROOT::Experimental::RException(R__FAIL("cannot lock shared page cache: " + std::string(strerror(rc))));
+      }
+   }
+   RSegmentLockGuard(const RSegmentLockGuard &) = delete;
+   RSegmentLockGuard &operator=(const RSegmentLockGuard &) = delete;
+   ~RSegmentLockGuard() { pthread_mutex_unlock(&fMutex); }
+};
+} // anonymous namespace
+
+ROOT::Experimental::Internal::RSharedPageCache::RSharedPageCache(std::string_view name, std::size_t size,
+                                                                 std::size_t blockSize)
+   : fName(GetSegmentName(name))
+{
+   const auto entriesOffset = AlignUp(sizeof(RHeader), alignof(REntry));
+   if (blockSize == 0)
+      throw RException(R__FAIL("invalid block size for the shared page cache"));
+
+   bool isCreator = true;
+   int fd = shm_open(fName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+   if (fd < 0) {
+      if (errno != EEXIST)
+         throw RException(R__FAIL("cannot create shared-memory segment " + fName + ": " + strerror(errno)));
+      isCreator = false;
+      fd = shm_open(fName.c_str(), O_RDWR, 0600);
+      if (fd < 0)
+         throw RException(R__FAIL("cannot open shared-memory segment " + fName + ": " + strerror(errno)));
+   }
+
+   if (isCreator) {
+      // Room for at least a single block
+      if (size < entriesOffset + kDataAlignment + sizeof(REntry) + sizeof(std::int32_t) + blockSize) {
+         close(fd);
+         shm_unlink(fName.c_str());
+         throw RException(R__FAIL("shared page cache size too small"));
+      }
+      if (ftruncate(fd, size) != 0) {
+         const int err = errno;
+         close(fd);
+         shm_unlink(fName.c_str());
+         throw RException(R__FAIL("cannot resize shared-memory segment " + fName + ": " + strerror(err)));
+      }
+      fSize = size;
+   } else {
+      // The creator may not yet have resized the segment
+      const auto deadline = std::chrono::steady_clock::now() + kInitTimeout;
+      struct stat info;
+      while (true) {
+         if (fstat(fd, &info) != 0) {
+            const int err = errno;
+            close(fd);
+            throw RException(R__FAIL("cannot stat shared-memory segment " + fName + ": " + strerror(err)));
+         }
+         if (info.st_size > 0)
+            break;
+         if (std::chrono::steady_clock::now() > deadline) {
+            close(fd);
+            throw RException(R__FAIL("timeout waiting for the initialization of shared-memory segment " + fName));
+         }
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      fSize = info.st_size;
+   }
+
+   fBase = mmap(nullptr, fSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (fBase == MAP_FAILED) {
+      fBase = nullptr;
+      if (isCreator)
+         shm_unlink(fName.c_str());
+      throw RException(R__FAIL("cannot map shared-memory segment " + fName + ": " + strerror(errno)));
+   }
+   fHeader = static_cast<RHeader *>(fBase);
+
+   if (isCreator) {
+      // Every block costs its data, its entry, and its hash bucket
+      const auto nBlocks = std::min<std::size_t>(
+         (fSize - entriesOffset - kDataAlignment) / (blockSize + sizeof(REntry) + sizeof(std::int32_t)),
+         std::numeric_limits<std::int32_t>::max());
+      const auto bucketsOffset = entriesOffset + nBlocks * sizeof(REntry);
+      const auto dataOffset = AlignUp(bucketsOffset + nBlocks * sizeof(std::int32_t), kDataAlignment);
+      R__ASSERT(dataOffset + nBlocks * blockSize <= fSize);
+
+      fHeader->fBlockSize = blockSize;
+      fHeader->fNBlocks = nBlocks;
+      fHeader->fEntriesOffset = entriesOffset;
+      fHeader->fBucketsOffset = bucketsOffset;
+      fHeader->fDataOffset = dataOffset;
+
+      pthread_mutexattr_t attr;
+      pthread_mutexattr_init(&attr);
+      pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+#ifdef __linux__
+      pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+#endif
+      pthread_mutex_init(&fHeader->fMutex, &attr);
+      pthread_mutexattr_destroy(&attr);
+   } else {
+      const auto deadline = std::chrono::steady_clock::now() + kInitTimeout;
+      while (fHeader->fMagic.load(std::memory_order_acquire) != kMagic) {
+         if (std::chrono::steady_clock::now() > deadline) {
+            munmap(fBase, fSize);
+            throw RException(R__FAIL("timeout waiting for the initialization of shared-memory segment " + fName));
+         }
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+   }
+
+   auto base = static_cast<unsigned char *>(fBase);
+   fEntries = reinterpret_cast<REntry *>(base + fHeader->fEntriesOffset);
+   fBuckets = reinterpret_cast<std::int32_t *>(base + fHeader->fBucketsOffset);
+   fData = base + fHeader->fDataOffset;
+
+   if (isCreator) {
+      Clear();
+      fHeader->fMagic.store(kMagic, std::memory_order_release);
+   }
+}
+
+ROOT::Experimental::Internal::RSharedPageCache::~RSharedPageCache()
+{
+   if (fBase)
+      munmap(fBase, fSize);
+}
+
+void ROOT::Experimental::Internal::RSharedPageCache::Unlink(std::string_view name)
+{
+   shm_unlink(GetSegmentName(name).c_str());
+}
+
+std::uint64_t ROOT::Experimental::Internal::RSharedPageCache::HashKey(const RKey &key)
+{
+   return XXH3_64bits(&key, sizeof(key));
+}
+
+void ROOT::Experimental::Internal::RSharedPageCache::Clear()
+{
+   const auto nBlocks = fHeader->fNBlocks;
+   for (std::uint64_t i = 0; i < nBlocks; ++i) {
+      fEntries[i].fNBlocks = 0;
+      fEntries[i].fNext = -1;
+      fEntries[i].fFirstBlock = -1;
+      fBuckets[i] = -1;
+   }
+   fHeader->fTick = 0;
+   fHeader->fNPages = 0;
+}
+
+std::int32_t ROOT::Experimental::Internal::RSharedPageCache::FindEntry(const RKey &key, std::uint64_t hash) const
+{
+   for (auto idx = fBuckets[hash % fHeader->fNBlocks]; idx >= 0; idx = fEntries[idx].fNext) {
+      if (fEntries[idx].fKey == key)
+         return idx;
+   }
+   return -1;
+}
+
+std::int32_t ROOT::Experimental::Internal::RSharedPageCache::FindFreeBlocks(std::uint32_t nBlocks) const
+{
+   std::uint32_t nFree = 0;
+   for (std::uint64_t i = 0; i < fHeader->fNBlocks; ++i) {
+      if (fEntries[i].fFirstBlock >= 0) {
+         nFree = 0;
+         continue;
+      }
+      if (++nFree == nBlocks)
+         return i + 1 - nBlocks;
+   }
+   return -1;
+}
+
+void ROOT::Experimental::Internal::RSharedPageCache::RemoveEntry(std::int32_t idx)
+{
+   auto &entry = fEntries[idx];
+   auto *link = &fBuckets[HashKey(entry.fKey) % fHeader->fNBlocks];
+   while (*link != idx) {
+      R__ASSERT(*link >= 0);
+      link = &fEntries[*link].fNext;
+   }
+   *link = entry.fNext;
+
+   for (std::uint32_t i = 0; i < entry.fNBlocks; ++i)
+      fEntries[idx + i].fFirstBlock = -1;
+   entry.fNBlocks = 0;
+   entry.fNext = -1;
+   fHeader->fNPages--;
+}
+
+bool ROOT::Experimental::Internal::RSharedPageCache::EvictLeastRecentlyUsed()
+{
+   std::int32_t victim = -1;
+   for (std::uint64_t i = 0; i < fHeader->fNBlocks; ++i) {
+      if (fEntries[i].fNBlocks == 0)
+         continue;
+      if (victim < 0 || fEntries[i].fLastUse < fEntries[victim].fLastUse)
+         victim = i;
+   }
+   if (victim < 0)
+      return false;
+   RemoveEntry(victim);
+   return true;
+}
+
+bool ROOT::Experimental::Internal::RSharedPageCache::Lookup(const RKey &key, void *buffer, std::size_t nBytes)
+{
+   const auto hash = HashKey(key);
+   RSegmentLockGuard guard(fHeader->fMutex, [this]() { Clear(); });
+   const auto idx = FindEntry(key, hash);
+   if (idx < 0 || fEntries[idx].fNBytes != nBytes)
+      return false;
+   memcpy(buffer, fData + idx * fHeader->fBlockSize, nBytes);
+   fEntries[idx].fLastUse = ++fHeader->fTick;
+   return true;
+}
+
+bool ROOT::Experimental::Internal::RSharedPageCache::Insert(const RKey &key, const void *buffer, std::size_t nBytes)
+{
+   const auto nBlocks = std::max<std::size_t>(1, (nBytes + fHeader->fBlockSize - 1) / fHeader->fBlockSize);
+   if (nBlocks > fHeader->fNBlocks)
+      return false;
+
+   const auto hash = HashKey(key);
+   RSegmentLockGuard guard(fHeader->fMutex, [this]() { Clear(); });
+   auto idx = FindEntry(key, hash);
+   if (idx >= 0) {
+      // Another process was faster
+      if (fEntries[idx].fNBytes == nBytes) {
+         fEntries[idx].fLastUse = ++fHeader->fTick;
+         return true;
+      }
+      RemoveEntry(idx);
+   }
+
+   while ((idx = FindFreeBlocks(nBlocks)) < 0) {
+      if (!EvictLeastRecentlyUsed())
+         return false;
+   }
+
+   auto &entry = fEntries[idx];
+   entry.fKey = key;
+   entry.fNBytes = nBytes;
+   entry.fLastUse = ++fHeader->fTick;
+   entry.fNBlocks = nBlocks;
+   auto &bucket = fBuckets[hash % fHeader->fNBlocks];
+   entry.fNext = bucket;
+   bucket = idx;
+   for (std::uint32_t i = 0; i < nBlocks; ++i)
+      fEntries[idx + i].fFirstBlock = idx;
+   fHeader->fNPages++;
+
+   memcpy(fData + idx * fHeader->fBlockSize, buffer, nBytes);
+   return true;
+}
+
+std::size_t ROOT::Experimental::Internal::RSharedPageCache::GetBlockSize() const
+{
+   return fHeader->fBlockSize;
+}
+
+std::uint32_t ROOT::Experimental::Internal::RSharedPageCache::GetNBlocks() const
+{
+   return fHeader->fNBlocks;
+}
+
+std::uint32_t ROOT::Experimental::Internal::RSharedPageCache::GetNPages() const
+{
+   RSegmentLockGuard guard(fHeader->fMutex, [this]() { const_cast<RSharedPageCache *>(this)->Clear(); });
+   return fHeader->fNPages;
+}
+
+#else // _WIN32
+
+struct ROOT::Experimental::Internal::RSharedPageCache::RHeader {};
+struct ROOT::Experimental::Internal::RSharedPageCache::REntry {};
+
+ROOT::Experimental::Internal::RSharedPageCache::RSharedPageCache(std::string_view, std::size_t, std::size_t)
+{
+   throw RException(R__FAIL("the shared page cache is not supported on Windows"));
+}
+
+ROOT::Experimental::Internal::RSharedPageCache::~RSharedPageCache() = default;
+
+void ROOT::Experimental::Internal::RSharedPageCache::Unlink(std::string_view) {}
+
+bool ROOT::Experimental::Internal::RSharedPageCache::Lookup(const RKey &, void *, std::size_t)
+{
+   return false;
+}
+
+bool ROOT::Experimental::Internal::RSharedPageCache::Insert(const RKey &, const void *, std::size_t)
+{
+   return false;
+}
+
+std::size_t ROOT::Experimental::Internal::RSharedPageCache::GetBlockSize() const
+{
+   return 0;
+}
+
+std::uint32_t ROOT::Experimental::Internal::RSharedPageCache::GetNBlocks() const
+{
+   return 0;
+}
+
+std::uint32_t ROOT::Experimental::Internal::RSharedPageCache::GetNPages() const
+{
+   return 0;
+}
+
+#endif // _WIN32
+
+//------------------------------------------------------------------------------
+
+ROOT::Experimental::Internal::RPageSourceSharedCache::RPageSourceSharedCache(std::unique_ptr<RPageSource> source,
+                                                                             std::string_view location,
+                                                                             const RNTupleReadOptions &options)
+   : RPageSourceSharedCache(std::move(source), location,
+                            std::make_shared<RSharedPageCache>(options.GetSharedPageCacheName(),
+                                                               options.GetSharedPageCacheSize()),
+                            options)
+{
+}
+
+ROOT::Experimental::Internal::RPageSourceSharedCache::RPageSourceSharedCache(std::unique_ptr<RPageSource> source,
+                                                                             std::string_view location,
+                                                                             std::shared_ptr<RSharedPageCache> cache,
+                                                                             const RNTupleReadOptions &options)
+   : RPageSource(source->GetNTupleName(), options), fSource(std::move(source)), fLocation(location), fCache(cache)
+{
+   fMetrics = Detail::RNTupleMetrics("RPageSourceSharedCache");
+   fCacheCounters = std::make_unique<RCacheCounters>(RCacheCounters{
+      *fMetrics.MakeCounter<Detail::RNTupleAtomicCounter *>("nPageCacheHit", "",
+                                                            "number of pages served by the shared page cache"),
+      *fMetrics.MakeCounter<Detail::RNTupleAtomicCounter *>("nPageCacheMiss", "",
+                                                            "number of pages not found in the shared page cache"),
+      *fMetrics.MakeCounter<Detail::RNTupleAtomicCounter *>("szPageCacheHit", "B",
+                                                            "volume served by the shared page cache"),
+      *fMetrics.MakeCounter<Detail::RNTupleCalcPerf *>(
+         "pageCacheHitRate", "%", "fraction of pages served by the shared page cache", fMetrics,
+         [](const Detail::RNTupleMetrics &metrics) -> std::pair<bool, double> {
+            if (const auto nHit = metrics.GetLocalCounter("nPageCacheHit")) {
+               if (const auto nMiss = metrics.GetLocalCounter("nPageCacheMiss")) {
+                  const auto nTotal = nHit->GetValueAsInt() + nMiss->GetValueAsInt();
+                  if (nTotal > 0)
+                     return {true, 100. * nHit->GetValueAsInt() / nTotal};
+               }
+            }
+            return {false, -1.};
+         })});
+   fMetrics.ObserveMetrics(fSource->GetMetrics());
+}
+
+ROOT::Experimental::Internal::RPageSourceSharedCache::~RPageSourceSharedCache() = default;
+
+ROOT::Experimental::RNTupleDescriptor ROOT::Experimental::Internal::RPageSourceSharedCache::AttachImpl()
+{
+   fSource->Attach();
+   auto descriptorGuard = fSource->GetSharedDescriptorGuard();
+
+   std::string datasetId = fLocation;
+   datasetId.push_back('\0');
+   datasetId += descriptorGuard->GetName();
+   for (auto n : {descriptorGuard->GetOnDiskHeaderXxHash3(), descriptorGuard->GetOnDiskHeaderSize(),
+                  descriptorGuard->GetOnDiskFooterSize(), descriptorGuard->GetNEntries()}) {
+      datasetId.append(reinterpret_cast<const char *>(&n), sizeof(n));
+   }
+   fDatasetId = XXH3_64bits(datasetId.data(), datasetId.size());
+
+   return std::move(*descriptorGuard->Clone());
+}
+
+std::unique_ptr<ROOT::Experimental::Internal::RPageSource>
+ROOT::Experimental::Internal::RPageSourceSharedCache::CloneImpl() const
+{
+   auto clone = std::unique_ptr<RPageSourceSharedCache>(
+      new RPageSourceSharedCache(fSource->Clone(), fLocation, fCache, fOptions));
+   clone->fDatasetId = fDatasetId;
+   return clone;
+}
+
+ROOT::Experimental::Internal::RPageStorage::ColumnHandle_t
+ROOT::Experimental::Internal::RPageSourceSharedCache::AddColumn(DescriptorId_t fieldId, RColumn &column)
+{
+   fSource->AddColumn(fieldId, column);
+   return RPageSource::AddColumn(fieldId, column);
+}
+
+void ROOT::Experimental::Internal::RPageSourceSharedCache::DropColumn(ColumnHandle_t columnHandle)
+{
+   RPageSource::DropColumn(columnHandle);
+   fSource->DropColumn(columnHandle);
+}
+
+ROOT::Experimental::Internal::RPageRef
+ROOT::Experimental::Internal::RPageSourceSharedCache::LoadPageImpl(ColumnHandle_t columnHandle,
+                                                                   const RClusterInfo &clusterInfo,
+                                                                   ClusterSize_t::ValueType idxInCluster)
+{
+   const auto columnId = columnHandle.fPhysicalId;
+   const auto clusterId = clusterInfo.fClusterId;
+   const auto &pageInfo = clusterInfo.fPageInfo;
+
+   if (pageInfo.fLocator.fType == RNTupleLocator::kTypePageZero)
+      return fSource->LoadPage(columnHandle, RClusterIndex(clusterId, idxInCluster));
+
+   const auto element = columnHandle.fColumn->GetElement();
+   const auto elementSize = element->GetSize();
+   const auto nBytes = elementSize * pageInfo.fNElements;
+   const char *elementTypeName = typeid(*element).name();
+   const RSharedPageCache::RKey key{fDatasetId, columnId, clusterId, pageInfo.fPageNo,
+                                    XXH3_64bits(elementTypeName, strlen(elementTypeName))};
+
+   auto newPage = fPageAllocator->NewPage(columnId, elementSize, pageInfo.fNElements);
+   if (fCache->Lookup(key, newPage.GetBuffer(), nBytes)) {
+      fCacheCounters->fNPageCacheHit.Inc();
+      fCacheCounters->fSzPageCacheHit.Add(nBytes);
+      newPage.GrowUnchecked(pageInfo.fNElements);
+      newPage.SetWindow(clusterInfo.fColumnOffset + pageInfo.fFirstInPage,
+                        RPage::RClusterInfo(clusterId, clusterInfo.fColumnOffset));
+      return fPagePool.RegisterPage(std::move(newPage));
+   }
+
+   fCacheCounters->fNPageCacheMiss.Inc();
+   auto pageRef = fSource->LoadPage(columnHandle, RClusterIndex(clusterId, idxInCluster));
+   if (pageRef.Get().GetNBytes() == nBytes)
+      fCache->Insert(key, pageRef.Get().GetBuffer(), nBytes);
+   return pageRef;
+}
+
+void ROOT::Experimental::Internal::RPageSourceSharedCache::LoadSealedPage(DescriptorId_t physicalColumnId,
+                                                                          RClusterIndex clusterIndex,
+                                                                          RSealedPage &sealedPage)
+{
+   fSource->LoadSealedPage(physicalColumnId, clusterIndex, sealedPage);
+}
+
+std::vector<std::unique_ptr<ROOT::Experimental::Internal::RCluster>>
+ROOT::Experimental::Internal::RPageSourceSharedCache::LoadClusters(std::span<RCluster::RKey> clusterKeys)
+{
+   // Like the friends page source, the decorator does not pre-load any clusters itself. On a cache miss, the
+   // decorated page source loads the page through its own cluster pool.
+   return std::vector<std::unique_ptr<ROOT::Experimental::Internal::RCluster>>(clusterKeys.size());
+}
@@ -15,6 +15,7 @@
 
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageStorageFile.hxx>
+#include <ROOT/RTrace.hxx>
 #include <ROOT/RColumn.hxx>
 #include <ROOT/RFieldBase.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
@@ -23,10 +24,14 @@
 #include <ROOT/RNTupleSerialize.hxx>
 #include <ROOT/RPageAllocator.hxx>
 #include <ROOT/RPageSinkBuf.hxx>
+#include <ROOT/RPageSourceSharedCache.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #ifdef R__ENABLE_DAOS
 #include <ROOT/RPageStorageDaos.hxx>
 #endif
+#ifdef R__ENABLE_S3
+#include <ROOT/RPageStorageS3.hxx>
+#endif
 
 #include <Compression.h>
 #include <TError.h>
@@ -34,9 +39,12 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
@@ -137,6 +145,10 @@ bool ROOT::Experimental::Internal::RPageSource::REntryRange::IntersectsWith(cons
 ROOT::Experimental::Internal::RPageSource::RPageSource(std::string_view name, const RNTupleReadOptions &options)
    : RPageStorage(name), fOptions(options)
 {
+   if (options.GetPageAllocatorCacheSize() > 0) {
+      fPageAllocator =
+         std::make_unique<RPageAllocatorPool>(options.GetPageAllocatorCacheSize(), options.GetUseHugePages());
+   }
 }
 
 ROOT::Experimental::Internal::RPageSource::~RPageSource() {}
@@ -151,14 +163,26 @@ ROOT::Experimental::Internal::RPageSource::Create(std::string_view ntupleName, s
    if (location.empty()) {
       throw RException(R__FAIL("empty storage location"));
    }
-   if (location.find("daos://") == 0)
+   std::unique_ptr<RPageSource> source;
+   if (location.find("daos://") == 0) {
 #ifdef R__ENABLE_DAOS
-      return std::make_unique<RPageSourceDaos>(ntupleName, location, options);
+      source = std::make_unique<RPageSourceDaos>(ntupleName, location, options);
 #else
       throw RException(R__FAIL("This RNTuple build does not support DAOS."));
 #endif
+   } else if (location.find("s3://") == 0 || location.find("s3s://") == 0) {
+#ifdef R__ENABLE_S3
+      source = std::make_unique<RPageSourceS3>(ntupleName, location, options);
+#else
+      throw RException(R__FAIL("This RNTuple build does not support S3."));
+#endif
+   } else {
+      source = std::make_unique<RPageSourceFile>(ntupleName, location, options);
+   }
 
-   return std::make_unique<RPageSourceFile>(ntupleName, location, options);
+   if (!options.GetSharedPageCacheName().empty())
+      return std::make_unique<RPageSourceSharedCache>(std::move(source), location, options);
+   return source;
 }
 
 ROOT::Experimental::Internal::RPageStorage::ColumnHandle_t
@@ -261,13 +285,16 @@ void ROOT::Experimental::Internal::RPageSource::UnzipClusterImpl(RCluster *clust
          auto taskFunc = [this, columnId, clusterId, firstInPage, sealedPage, element = allElements.back().get(),
                           &foundChecksumFailure,
                           indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex]() {
-            auto rv = UnsealPage(sealedPage, *element, columnId);
-            if (!rv) {
-               foundChecksumFailure = true;
-               return;
+            auto newPage = TryMapSealedPage(sealedPage, *element, columnId);
+            if (newPage.IsNull()) {
+               auto rv = UnsealPage(sealedPage, *element, columnId);
+               if (!rv) {
+                  foundChecksumFailure = true;
+                  return;
+               }
+               newPage = rv.Unwrap();
+               fCounters->fSzUnzip.Add(element->GetSize() * sealedPage.GetNElements());
             }
-            auto newPage = rv.Unwrap();
-            fCounters->fSzUnzip.Add(element->GetSize() * sealedPage.GetNElements());
 
             newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
             fPagePool.PreloadPage(std::move(newPage));
@@ -289,6 +316,14 @@ void ROOT::Experimental::Internal::RPageSource::UnzipClusterImpl(RCluster *clust
    }
 }
 
+ROOT::Experimental::Internal::RPage
+ROOT::Experimental::Internal::RPageSource::TryMapSealedPage(const RSealedPage & /*sealedPage*/,
+                                                            const RColumnElementBase & /*element*/,
+                                                            DescriptorId_t /*physicalColumnId*/)
+{
+   return RPage();
+}
+
 void ROOT::Experimental::Internal::RPageSource::PrepareLoadCluster(
    const RCluster::RKey &clusterKey, ROnDiskPageMap &pageZeroMap,
    std::function<void(DescriptorId_t, NTupleSize_t, const RClusterDescriptor::RPageRange::RPageInfo &)> perPageFunc)
@@ -481,6 +516,7 @@ ROOT::Experimental::RResult<ROOT::Experimental::Internal::RPage>
 ROOT::Experimental::Internal::RPageSource::UnsealPage(const RSealedPage &sealedPage, const RColumnElementBase &element,
                                                       DescriptorId_t physicalColumnId, RPageAllocator &pageAlloc)
 {
+   R__TRACE_SCOPE("io", "RPageSource::UnsealPage");
    // Unsealing a page zero is a no-op.  `RPageRange::ExtendToFitColumnRange()` guarantees that the page zero buffer is
    // large enough to hold `sealedPage.fNElements`
    if (sealedPage.GetBuffer() == RPage::GetPageZeroBuffer()) {
@@ -605,6 +641,10 @@ bool ROOT::Experimental::Internal::RWritePageMemoryManager::TryUpdate(RColumn &c
 ROOT::Experimental::Internal::RPageSink::RPageSink(std::string_view name, const RNTupleWriteOptions &options)
    : RPageStorage(name), fOptions(options.Clone()), fWritePageMemoryManager(options.GetPageBufferBudget())
 {
+   if (options.GetPageAllocatorCacheSize() > 0) {
+      fPageAllocator =
+         std::make_unique<RPageAllocatorPool>(options.GetPageAllocatorCacheSize(), options.GetUseHugePages());
+   }
 }
 
 ROOT::Experimental::Internal::RPageSink::~RPageSink() {}
@@ -664,6 +704,100 @@ ROOT::Experimental::Internal::RPageSink::SealPage(const RPage &page, const RColu
    return SealPage(config);
 }
 
+namespace {
+
+template <typename T>
+std::optional<ROOT::Experimental::RClusterDescriptor::RValueRange>
+ComputeValueRangeImpl(const void *buffer, std::size_t nElements)
+{
+   const T *values = reinterpret_cast<const T *>(buffer);
+   bool isEmpty = true;
+   T min{};
+   T max{};
+   for (std::size_t i = 0; i < nElements; ++i) {
+      const T v = values[i];
+      if constexpr (std::is_floating_point_v<T>) {
+         if (std::isnan(v))
+            continue;
+      }
+      if (isEmpty) {
+         min = max = v;
+         isEmpty = false;
+         continue;
+      }
+      min = std::min(min, v);
+      max = std::max(max, v);
+   }
+   if (isEmpty)
+      return std::nullopt;
+
+   ROOT::Experimental::RClusterDescriptor::RValueRange range{static_cast<double>(min), static_cast<double>(max)};
+   if constexpr (std::is_integral_v<T> && (sizeof(T) == 8)) {
+      // Beyond 2^53, 64bit integers are not necessarily representable as double; keep the range conservative
+      constexpr double kMaxExact = static_cast<double>(std::uint64_t(1) << std::numeric_limits<double>::digits);
+      if (std::abs(range.fMin) > kMaxExact)
+         range.fMin = std::nextafter(range.fMin, -std::numeric_limits<double>::infinity());
+      if (std::abs(range.fMax) > kMaxExact)
+         range.fMax = std::nextafter(range.fMax, std::numeric_limits<double>::infinity());
+   }
+   return range;
+}
+
+} // anonymous namespace
+
+std::optional<ROOT::Experimental::RClusterDescriptor::RValueRange>
+ROOT::Experimental::Internal::RPageSink::ComputeValueRange(const RPage &page, const RColumn &column)
+{
+   // The page buffer holds the in-memory representation of the elements, whose width may differ from the on-disk
+   // representation given by the column type. Hence we dispatch on the column type's kind and the element size.
+   const auto elementSize = column.GetElement()->GetSize();
+   const auto nElements = page.GetNElements();
+   const void *buffer = page.GetBuffer();
+   switch (column.GetType()) {
+   case EColumnType::kInt64:
+   case EColumnType::kInt32:
+   case EColumnType::kInt16:
+   case EColumnType::kInt8:
+   case EColumnType::kSplitInt64:
+   case EColumnType::kSplitInt32:
+   case EColumnType::kSplitInt16:
+      switch (elementSize) {
+      case 1: return ComputeValueRangeImpl<std::int8_t>(buffer, nElements);
+      case 2: return ComputeValueRangeImpl<std::int16_t>(buffer, nElements);
+      case 4: return ComputeValueRangeImpl<std::int32_t>(buffer, nElements);
+      case 8: return ComputeValueRangeImpl<std::int64_t>(buffer, nElements);
+      default: return std::nullopt;
+      }
+   case EColumnType::kUInt64:
+   case EColumnType::kUInt32:
+   case EColumnType::kUInt16:
+   case EColumnType::kUInt8:
+   case EColumnType::kSplitUInt64:
+   case EColumnType::kSplitUInt32:
+   case EColumnType::kSplitUInt16:
+      switch (elementSize) {
+      case 1: return ComputeValueRangeImpl<std::uint8_t>(buffer, nElements);
+      case 2: return ComputeValueRangeImpl<std::uint16_t>(buffer, nElements);
+      case 4: return ComputeValueRangeImpl<std::uint32_t>(buffer, nElements);
+      case 8: return ComputeValueRangeImpl<std::uint64_t>(buffer, nElements);
+      default: return std::nullopt;
+      }
+   case EColumnType::kReal64:
+   case EColumnType::kReal32:
+   case EColumnType::kReal16:
+   case EColumnType::kSplitReal64:
+   case EColumnType::kSplitReal32:
+   case EColumnType::kReal32Trunc:
+   case EColumnType::kReal32Quant:
+      switch (elementSize) {
+      case 4: return ComputeValueRangeImpl<float>(buffer, nElements);
+      case 8: return ComputeValueRangeImpl<double>(buffer, nElements);
+      default: return std::nullopt;
+      }
+   default: return std::nullopt;
+   }
+}
+
 void ROOT::Experimental::Internal::RPageSink::CommitDataset()
 {
    for (const auto &cb : fOnDatasetCommitCallbacks)
@@ -701,6 +835,13 @@ ROOT::Experimental::Internal::RPagePersistentSink::Create(std::string_view ntupl
       throw RException(R__FAIL("This RNTuple build does not support DAOS."));
 #endif
    }
+   if (location.find("s3://") == 0 || location.find("s3s://") == 0) {
+#ifdef R__ENABLE_S3
+      return std::make_unique<RPageSinkS3>(ntupleName, location, options);
+#else
+      throw RException(R__FAIL("This RNTuple build does not support S3."));
+#endif
+   }
 
    // Otherwise assume that the user wants us to create a file.
    return std::make_unique<RPageSinkFile>(ntupleName, location, options);
@@ -886,6 +1027,8 @@ void ROOT::Experimental::Internal::RPagePersistentSink::CommitPage(ColumnHandle_
    pageInfo.fNElements = page.GetNElements();
    pageInfo.fLocator = CommitPageImpl(columnHandle, page);
    pageInfo.fHasChecksum = GetWriteOptions().GetEnablePageChecksums();
+   if (GetWriteOptions().GetEnableValueRanges())
+      pageInfo.fValueRange = ComputeValueRange(page, *columnHandle.fColumn);
    fOpenPageRanges.at(columnHandle.fPhysicalId).fPageInfos.emplace_back(pageInfo);
 }
 
@@ -898,6 +1041,7 @@ void ROOT::Experimental::Internal::RPagePersistentSink::CommitSealedPage(Descrip
    pageInfo.fNElements = sealedPage.GetNElements();
    pageInfo.fLocator = CommitSealedPageImpl(physicalColumnId, sealedPage);
    pageInfo.fHasChecksum = sealedPage.GetHasChecksum();
+   pageInfo.fValueRange = sealedPage.GetValueRange();
    fOpenPageRanges.at(physicalColumnId).fPageInfos.emplace_back(pageInfo);
 }
 
@@ -981,6 +1125,7 @@ void ROOT::Experimental::Internal::RPagePersistentSink::CommitSealedPageV(
          pageInfo.fNElements = sealedPageIt->GetNElements();
          pageInfo.fLocator = locators[locatorIndexes[i++]];
          pageInfo.fHasChecksum = sealedPageIt->GetHasChecksum();
+         pageInfo.fValueRange = sealedPageIt->GetValueRange();
          fOpenPageRanges.at(range.fPhysicalColumnId).fPageInfos.emplace_back(pageInfo);
       }
    }
@@ -501,6 +501,7 @@ ROOT::Experimental::Internal::RPageSourceDaos::RPageSourceDaos(std::string_view
      fClusterPool(std::make_unique<RClusterPool>(*this, options.GetClusterBunchSize()))
 {
    EnableDefaultMetrics("RPageSourceDaos");
+   fMetrics.ObserveMetrics(fClusterPool->GetMetrics());
 
    auto args = ParseDaosURI(uri);
    auto pool = std::make_shared<RDaosPool>(args.fPoolLabel);
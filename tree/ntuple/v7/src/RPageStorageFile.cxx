@@ -15,6 +15,7 @@
 
 #include <ROOT/RCluster.hxx>
 #include <ROOT/RClusterPool.hxx>
+#include <ROOT/RColumnElementBase.hxx>
 #include <ROOT/RLogger.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleModel.hxx>
@@ -26,6 +27,10 @@
 #include <ROOT/RPageStorageFile.hxx>
 #include <ROOT/RRawFile.hxx>
 #include <ROOT/RRawFileTFile.hxx>
+#include <ROOT/RTrace.hxx>
+#ifndef _WIN32
+#include <ROOT/RRawFileUnix.hxx>
+#endif
 #include <ROOT/RNTupleUtil.hxx>
 
 #include <RVersion.h>
@@ -43,6 +48,10 @@
 #include <functional>
 #include <mutex>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 ROOT::Experimental::Internal::RPageSinkFile::RPageSinkFile(std::string_view ntupleName,
                                                            const RNTupleWriteOptions &options)
    : RPagePersistentSink(ntupleName, options)
@@ -261,6 +270,7 @@ ROOT::Experimental::Internal::RPageSourceFile::RPageSourceFile(std::string_view
      fClusterPool(std::make_unique<RClusterPool>(*this, options.GetClusterBunchSize()))
 {
    EnableDefaultMetrics("RPageSourceFile");
+   fMetrics.ObserveMetrics(fClusterPool->GetMetrics());
 }
 
 ROOT::Experimental::Internal::RPageSourceFile::RPageSourceFile(std::string_view ntupleName,
@@ -307,7 +317,37 @@ ROOT::Experimental::Internal::RPageSourceFile::CreateFromAnchor(const RNTuple &a
    return pageSource;
 }
 
-ROOT::Experimental::Internal::RPageSourceFile::~RPageSourceFile() = default;
+ROOT::Experimental::Internal::RPageSourceFile::~RPageSourceFile()
+{
+#ifndef _WIN32
+   if (fMmapBase) {
+      // Stop the I/O thread before its clusters lose their backing memory
+      fClusterPool.reset();
+      munmap(fMmapBase, fMmapSize);
+   }
+#endif
+}
+
+void ROOT::Experimental::Internal::RPageSourceFile::MapFile()
+{
+#ifndef _WIN32
+   if (!fOptions.GetUseMemoryMap() || fMmapBase)
+      return;
+   auto unixFile = dynamic_cast<ROOT::Internal::RRawFileUnix *>(fFile.get());
+   if (!unixFile)
+      return;
+   const auto size = unixFile->GetSize(); // opens the file if necessary
+   if (size == 0)
+      return;
+   void *base = mmap(nullptr, size, PROT_READ, MAP_SHARED, unixFile->GetFd(), 0);
+   if (base == MAP_FAILED) {
+      R__LOG_WARNING(NTupleLog()) << "cannot memory map '" << unixFile->GetUrl() << "', using regular reads";
+      return;
+   }
+   fMmapBase = static_cast<unsigned char *>(base);
+   fMmapSize = size;
+#endif
+}
 
 void ROOT::Experimental::Internal::RPageSourceFile::LoadStructureImpl()
 {
@@ -387,6 +427,7 @@ ROOT::Experimental::RNTupleDescriptor ROOT::Experimental::Internal::RPageSourceF
 
    // For the page reads, we rely on the I/O scheduler to define the read requests
    fFile->SetBuffering(false);
+   MapFile();
 
    return desc;
 }
@@ -424,6 +465,7 @@ ROOT::Experimental::Internal::RPageSourceFile::LoadPageImpl(ColumnHandle_t colum
                                                             const RClusterInfo &clusterInfo,
                                                             ClusterSize_t::ValueType idxInCluster)
 {
+   R__TRACE_SCOPE("io", "RPageSourceFile::LoadPage");
    const auto columnId = columnHandle.fPhysicalId;
    const auto clusterId = clusterInfo.fClusterId;
    const auto pageInfo = clusterInfo.fPageInfo;
@@ -445,7 +487,11 @@ ROOT::Experimental::Internal::RPageSourceFile::LoadPageImpl(ColumnHandle_t colum
    sealedPage.SetBufferSize(pageInfo.fLocator.fBytesOnStorage + pageInfo.fHasChecksum * kNBytesPageChecksum);
    std::unique_ptr<unsigned char[]> directReadBuffer; // only used if cluster pool is turned off
 
-   if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
+   if (fMmapBase && (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff)) {
+      fCounters->fNPageRead.Inc();
+      fCounters->fSzReadPayload.Add(sealedPage.GetBufferSize());
+      sealedPage.SetBuffer(fMmapBase + pageInfo.fLocator.GetPosition<std::uint64_t>());
+   } else if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
       directReadBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[sealedPage.GetBufferSize()]);
       fReader.ReadBuffer(directReadBuffer.get(), sealedPage.GetBufferSize(),
                          pageInfo.fLocator.GetPosition<std::uint64_t>());
@@ -468,8 +514,8 @@ ROOT::Experimental::Internal::RPageSourceFile::LoadPageImpl(ColumnHandle_t colum
       sealedPage.SetBuffer(onDiskPage->GetAddress());
    }
 
-   RPage newPage;
-   {
+   RPage newPage = TryMapSealedPage(sealedPage, *element, columnId);
+   if (newPage.IsNull()) {
       Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
       newPage = UnsealPage(sealedPage, *element, columnId).Unwrap();
       fCounters->fSzUnzip.Add(elementSize * pageInfo.fNElements);
@@ -487,9 +533,73 @@ ROOT::Experimental::Internal::RPageSourceFile::CloneImpl() const
    auto clone = new RPageSourceFile(fNTupleName, fOptions);
    clone->fFile = fFile->Clone();
    clone->fReader = RMiniFileReader(clone->fFile.get());
+   // The clone of an attached source is not attached again, so it needs to set up its own mapping here
+   if (fMmapBase)
+      clone->MapFile();
    return std::unique_ptr<RPageSourceFile>(clone);
 }
 
+ROOT::Experimental::Internal::RPage
+ROOT::Experimental::Internal::RPageSourceFile::TryMapSealedPage(const RSealedPage &sealedPage,
+                                                                const RColumnElementBase &element,
+                                                                DescriptorId_t physicalColumnId)
+{
+   if (!fMmapBase || !element.IsMappable())
+      return RPage();
+   auto buffer = static_cast<const unsigned char *>(sealedPage.GetBuffer());
+   if ((buffer < fMmapBase) || (buffer >= fMmapBase + fMmapSize))
+      return RPage();
+   // Compressed page
+   if (sealedPage.GetDataSize() != element.GetPackedSize(sealedPage.GetNElements()))
+      return RPage();
+   if (reinterpret_cast<std::uintptr_t>(buffer) % element.GetSize() != 0)
+      return RPage();
+   // On failure, UnsealPage() will report the checksum error
+   if (!sealedPage.VerifyChecksumIfEnabled())
+      return RPage();
+
+   // The page has no allocator, it is a non-owning view into the mapped file
+   RPage page(physicalColumnId, const_cast<unsigned char *>(buffer), nullptr, element.GetSize(),
+              sealedPage.GetNElements());
+   page.GrowUnchecked(sealedPage.GetNElements());
+   return page;
+}
+
+std::unique_ptr<ROOT::Experimental::Internal::RCluster>
+ROOT::Experimental::Internal::RPageSourceFile::PrepareSingleClusterMapped(const RCluster::RKey &clusterKey)
+{
+   auto pageMap = std::make_unique<ROnDiskPageMap>();
+   auto pageZeroMap = std::make_unique<ROnDiskPageMap>();
+   std::size_t nPages = 0;
+   std::size_t szPayload = 0;
+   PrepareLoadCluster(clusterKey, *pageZeroMap,
+                      [&](DescriptorId_t physicalColumnId, NTupleSize_t pageNo,
+                          const RClusterDescriptor::RPageRange::RPageInfo &pageInfo) {
+                         const auto offset = pageInfo.fLocator.GetPosition<std::uint64_t>();
+                         const auto nBytes =
+                            pageInfo.fLocator.fBytesOnStorage + pageInfo.fHasChecksum * kNBytesPageChecksum;
+                         R__ASSERT(offset + nBytes <= fMmapSize);
+                         pageMap->Register(ROnDiskPage::Key(physicalColumnId, pageNo),
+                                           ROnDiskPage(fMmapBase + offset, nBytes));
+#ifndef _WIN32
+                         // The hint needs to start at an OS page boundary
+                         const std::uint64_t alignedOffset = offset & ~std::uint64_t(4095);
+                         madvise(fMmapBase + alignedOffset, offset + nBytes - alignedOffset, MADV_WILLNEED);
+#endif
+                         nPages++;
+                         szPayload += nBytes;
+                      });
+   fCounters->fNPageRead.Add(nPages);
+   fCounters->fSzReadPayload.Add(szPayload);
+
+   auto cluster = std::make_unique<RCluster>(clusterKey.fClusterId);
+   cluster->Adopt(std::move(pageMap));
+   cluster->Adopt(std::move(pageZeroMap));
+   for (auto colId : clusterKey.fPhysicalColumnSet)
+      cluster->SetColumnAvailable(colId);
+   return cluster;
+}
+
 std::unique_ptr<ROOT::Experimental::Internal::RCluster>
 ROOT::Experimental::Internal::RPageSourceFile::PrepareSingleCluster(
    const RCluster::RKey &clusterKey, std::vector<ROOT::Internal::RRawFile::RIOVec> &readRequests)
@@ -612,17 +722,45 @@ ROOT::Experimental::Internal::RPageSourceFile::PrepareSingleCluster(
 std::vector<std::unique_ptr<ROOT::Experimental::Internal::RCluster>>
 ROOT::Experimental::Internal::RPageSourceFile::LoadClusters(std::span<RCluster::RKey> clusterKeys)
 {
+   R__TRACE_SCOPE("io", "RPageSourceFile::LoadClusters");
    fCounters->fNClusterLoaded.Add(clusterKeys.size());
 
    std::vector<std::unique_ptr<ROOT::Experimental::Internal::RCluster>> clusters;
    std::vector<ROOT::Internal::RRawFile::RIOVec> readRequests;
 
    clusters.reserve(clusterKeys.size());
+   if (fMmapBase) {
+      for (auto key : clusterKeys)
+         clusters.emplace_back(PrepareSingleClusterMapped(key));
+      return clusters;
+   }
+
    for (auto key : clusterKeys) {
       clusters.emplace_back(PrepareSingleCluster(key, readRequests));
    }
 
    auto nReqs = readRequests.size();
+   if (fFile->HasPipelinedReadV()) {
+      // The file splits the requests into concurrent vector reads itself; we only read split blobs separately.
+      std::vector<ROOT::Internal::RRawFile::RIOVec> vectorRequests;
+      vectorRequests.reserve(nReqs);
+      for (const auto &req : readRequests) {
+         if (req.fSize > fReader.GetMaxKeySize()) {
+            Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
+            fReader.ReadBuffer(req.fBuffer, req.fSize, req.fOffset);
+         } else {
+            vectorRequests.emplace_back(req);
+         }
+      }
+      if (!vectorRequests.empty()) {
+         Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
+         fFile->ReadV(vectorRequests.data(), vectorRequests.size());
+         fCounters->fNReadV.Inc();
+      }
+      fCounters->fNRead.Add(nReqs);
+      return clusters;
+   }
+
    auto readvLimits = fFile->GetReadVLimits();
    // We never want to do vectorized reads of split blobs, so we limit our single size to maxKeySize.
    readvLimits.fMaxSingleSize = std::min<size_t>(readvLimits.fMaxSingleSize, fReader.GetMaxKeySize());
@@ -0,0 +1,515 @@
+/// \file RPageStorageS3.cxx
+/// \ingroup NTuple ROOT7
+/// \date 2024-10-16
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RCluster.hxx>
+#include <ROOT/RClusterPool.hxx>
+#include <ROOT/RColumn.hxx>
+#include <ROOT/RLogger.hxx>
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleSerialize.hxx>
+#include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RNTupleWriteOptionsS3.hxx>
+#include <ROOT/RNTupleZip.hxx>
+#include <ROOT/RPage.hxx>
+#include <ROOT/RPagePool.hxx>
+#include <ROOT/RPageStorageS3.hxx>
+#include <ROOT/RS3.hxx>
+
+#include <TError.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace {
+
+/// \brief Unpacks a 64-bit page locator into the index of the cluster object and the offset of the page within it
+std::pair<std::uint32_t, std::uint32_t> DecodeS3PagePosition(const ROOT::Experimental::RNTupleLocatorObject64 &address)
+{
+   auto position = static_cast<std::uint32_t>(address.fLocation & 0xFFFFFFFF);
+   auto offset = static_cast<std::uint32_t>(address.fLocation >> 32);
+   return {position, offset};
+}
+
+/// \brief Packs the index of the cluster object and the offset of the page within it into a 64-bit locator
+ROOT::Experimental::RNTupleLocatorObject64 EncodeS3PagePosition(std::uint64_t position, std::uint64_t offset)
+{
+   if (offset > std::numeric_limits<std::uint32_t>::max())
+      throw ROOT::Experimental::RException(R__FAIL("S3 cluster object too large"));
+   return ROOT::Experimental::RNTupleLocatorObject64{(position & 0xFFFFFFFF) | (offset << 32)};
+}
+
+std::string GetClusterKey(std::uint64_t position)
+{
+   return "cluster." + std::to_string(position);
+}
+
+std::string GetPageListKey(std::uint64_t position)
+{
+   return "pagelist." + std::to_string(position);
+}
+
+std::string GetNTupleUrl(std::string_view uri, std::string_view ntupleName)
+{
+   std::string url(uri);
+   while (!url.empty() && url.back() == '/')
+      url.pop_back();
+   return url + "/" + std::string(ntupleName);
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::uint32_t ROOT::Experimental::Internal::RS3NTupleAnchor::Serialize(void *buffer) const
+{
+   if (buffer != nullptr) {
+      auto bytes = reinterpret_cast<unsigned char *>(buffer);
+      bytes += RNTupleSerializer::SerializeUInt64(fVersionAnchor, bytes);
+      bytes += RNTupleSerializer::SerializeUInt16(fVersionEpoch, bytes);
+      bytes += RNTupleSerializer::SerializeUInt16(fVersionMajor, bytes);
+      bytes += RNTupleSerializer::SerializeUInt16(fVersionMinor, bytes);
+      bytes += RNTupleSerializer::SerializeUInt16(fVersionPatch, bytes);
+      bytes += RNTupleSerializer::SerializeUInt32(fNBytesHeader, bytes);
+      bytes += RNTupleSerializer::SerializeUInt32(fLenHeader, bytes);
+      bytes += RNTupleSerializer::SerializeUInt32(fNBytesFooter, bytes);
+      bytes += RNTupleSerializer::SerializeUInt32(fLenFooter, bytes);
+   }
+   return GetSize();
+}
+
+ROOT::Experimental::RResult<std::uint32_t>
+ROOT::Experimental::Internal::RS3NTupleAnchor::Deserialize(const void *buffer, std::uint32_t bufSize)
+{
+   if (bufSize < GetSize())
+      return R__FAIL("S3 anchor too short");
+
+   auto bytes = reinterpret_cast<const unsigned char *>(buffer);
+   bytes += RNTupleSerializer::DeserializeUInt64(bytes, fVersionAnchor);
+   if (fVersionAnchor != RS3NTupleAnchor().fVersionAnchor) {
+      return R__FAIL("unsupported S3 anchor version: " + std::to_string(fVersionAnchor));
+   }
+
+   bytes += RNTupleSerializer::DeserializeUInt16(bytes, fVersionEpoch);
+   bytes += RNTupleSerializer::DeserializeUInt16(bytes, fVersionMajor);
+   bytes += RNTupleSerializer::DeserializeUInt16(bytes, fVersionMinor);
+   bytes += RNTupleSerializer::DeserializeUInt16(bytes, fVersionPatch);
+   bytes += RNTupleSerializer::DeserializeUInt32(bytes, fNBytesHeader);
+   bytes += RNTupleSerializer::DeserializeUInt32(bytes, fLenHeader);
+   bytes += RNTupleSerializer::DeserializeUInt32(bytes, fNBytesFooter);
+   bytes += RNTupleSerializer::DeserializeUInt32(bytes, fLenFooter);
+   return GetSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ROOT::Experimental::Internal::RPageSinkS3::RPageSinkS3(std::string_view ntupleName, std::string_view uri,
+                                                       const RNTupleWriteOptions &options)
+   : RPagePersistentSink(ntupleName, options), fURI(uri)
+{
+   static std::once_flag once;
+   std::call_once(once, []() {
+      R__LOG_WARNING(NTupleLog()) << "The S3 backend is experimental and still under development. "
+                                  << "Do not store real data with this version of RNTuple!";
+   });
+   fCompressor = std::make_unique<RNTupleCompressor>();
+   EnableDefaultMetrics("RPageSinkS3");
+}
+
+ROOT::Experimental::Internal::RPageSinkS3::~RPageSinkS3()
+{
+   // Uploads of a sink that was not committed are abandoned; their errors are of no interest anymore
+   for (auto &upload : fUploads) {
+      try {
+         upload.get();
+      } catch (const RException &) {
+      }
+   }
+}
+
+void ROOT::Experimental::Internal::RPageSinkS3::WaitForUploads(std::size_t maxPending)
+{
+   Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallWrite, fCounters->fTimeCpuWrite);
+   while (fUploads.size() > maxPending) {
+      auto upload = std::move(fUploads.front());
+      fUploads.pop_front();
+      upload.get();
+   }
+}
+
+void ROOT::Experimental::Internal::RPageSinkS3::InitImpl(unsigned char *serializedHeader, std::uint32_t length)
+{
+   auto opts = dynamic_cast<RNTupleWriteOptionsS3 *>(fOptions.get());
+   fMaxConcurrentUploads =
+      opts ? opts->GetMaxConcurrentUploads() : RNTupleWriteOptionsS3().GetMaxConcurrentUploads();
+   fClusterBuffer.reserve(GetWriteOptions().GetApproxZippedClusterSize());
+
+   fBucket = std::make_unique<RS3Bucket>(GetNTupleUrl(fURI, fNTupleName));
+
+   auto zipBuffer = std::make_unique<unsigned char[]>(length);
+   auto szZipHeader = fCompressor->Zip(serializedHeader, length, GetWriteOptions().GetCompression(),
+                                       RNTupleCompressor::MakeMemCopyWriter(zipBuffer.get()));
+   fBucket->Put("header", zipBuffer.get(), szZipHeader);
+   fNTupleAnchor.fLenHeader = length;
+   fNTupleAnchor.fNBytesHeader = szZipHeader;
+}
+
+ROOT::Experimental::RNTupleLocator
+ROOT::Experimental::Internal::RPageSinkS3::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
+{
+   auto element = columnHandle.fColumn->GetElement();
+   RPageStorage::RSealedPage sealedPage;
+   {
+      Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallZip, fCounters->fTimeCpuZip);
+      sealedPage = SealPage(page, *element);
+   }
+
+   fCounters->fSzZip.Add(page.GetNBytes());
+   return CommitSealedPageImpl(columnHandle.fPhysicalId, sealedPage);
+}
+
+ROOT::Experimental::RNTupleLocator
+ROOT::Experimental::Internal::RPageSinkS3::CommitSealedPageImpl(DescriptorId_t /* physicalColumnId */,
+                                                                const RPageStorage::RSealedPage &sealedPage)
+{
+   const auto offset = fClusterBuffer.size();
+   auto bytes = static_cast<const unsigned char *>(sealedPage.GetBuffer());
+   fClusterBuffer.insert(fClusterBuffer.end(), bytes, bytes + sealedPage.GetBufferSize());
+
+   RNTupleLocator result;
+   result.fPosition = EncodeS3PagePosition(fClusterObjectId, offset);
+   result.fBytesOnStorage = sealedPage.GetDataSize();
+   result.fType = RNTupleLocator::kTypeDAOS;
+   fCounters->fNPageCommitted.Inc();
+   fCounters->fSzWritePayload.Add(sealedPage.GetBufferSize());
+   fNBytesCurrentCluster += sealedPage.GetBufferSize();
+   return result;
+}
+
+std::uint64_t ROOT::Experimental::Internal::RPageSinkS3::StageClusterImpl()
+{
+   WaitForUploads(fMaxConcurrentUploads > 0 ? fMaxConcurrentUploads - 1 : 0);
+
+   auto key = GetClusterKey(fClusterObjectId++);
+   std::vector<unsigned char> buffer;
+   buffer.reserve(GetWriteOptions().GetApproxZippedClusterSize());
+   std::swap(buffer, fClusterBuffer);
+
+   if (fMaxConcurrentUploads == 0) {
+      Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallWrite, fCounters->fTimeCpuWrite);
+      fBucket->Put(key, buffer.data(), buffer.size());
+   } else {
+      auto bucket = fBucket.get();
+      fUploads.emplace_back(std::async(std::launch::async, [bucket, key = std::move(key), buffer = std::move(buffer)]() {
+         bucket->Put(key, buffer.data(), buffer.size());
+      }));
+   }
+   return std::exchange(fNBytesCurrentCluster, 0);
+}
+
+ROOT::Experimental::RNTupleLocator
+ROOT::Experimental::Internal::RPageSinkS3::CommitClusterGroupImpl(unsigned char *serializedPageList,
+                                                                  std::uint32_t length)
+{
+   auto bufPageListZip = std::make_unique<unsigned char[]>(length);
+   auto szPageListZip = fCompressor->Zip(serializedPageList, length, GetWriteOptions().GetCompression(),
+                                         RNTupleCompressor::MakeMemCopyWriter(bufPageListZip.get()));
+
+   auto offsetData = fClusterGroupId++;
+   fBucket->Put(GetPageListKey(offsetData), bufPageListZip.get(), szPageListZip);
+   RNTupleLocator result;
+   result.fPosition = RNTupleLocatorObject64{offsetData};
+   result.fBytesOnStorage = szPageListZip;
+   result.fType = RNTupleLocator::kTypeDAOS;
+   fCounters->fSzWritePayload.Add(static_cast<int64_t>(szPageListZip));
+   return result;
+}
+
+void ROOT::Experimental::Internal::RPageSinkS3::CommitDatasetImpl(unsigned char *serializedFooter,
+                                                                  std::uint32_t length)
+{
+   WaitForUploads(0);
+
+   auto bufFooterZip = std::make_unique<unsigned char[]>(length);
+   auto szFooterZip = fCompressor->Zip(serializedFooter, length, GetWriteOptions().GetCompression(),
+                                       RNTupleCompressor::MakeMemCopyWriter(bufFooterZip.get()));
+   fBucket->Put("footer", bufFooterZip.get(), szFooterZip);
+   fNTupleAnchor.fLenFooter = length;
+   fNTupleAnchor.fNBytesFooter = szFooterZip;
+
+   // The anchor is written last, once all other objects are in place
+   unsigned char anchor[RS3NTupleAnchor::GetSize()];
+   fNTupleAnchor.Serialize(anchor);
+   fBucket->Put("anchor", anchor, RS3NTupleAnchor::GetSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ROOT::Experimental::Internal::RPageSourceS3::RPageSourceS3(std::string_view ntupleName, std::string_view uri,
+                                                           const RNTupleReadOptions &options)
+   : RPageSource(ntupleName, options),
+     fBucket(std::make_unique<RS3Bucket>(GetNTupleUrl(uri, ntupleName))),
+     fURI(uri),
+     fClusterPool(std::make_unique<RClusterPool>(*this, options.GetClusterBunchSize()))
+{
+   EnableDefaultMetrics("RPageSourceS3");
+   fMetrics.ObserveMetrics(fClusterPool->GetMetrics());
+}
+
+ROOT::Experimental::Internal::RPageSourceS3::~RPageSourceS3() = default;
+
+ROOT::Experimental::RNTupleDescriptor ROOT::Experimental::Internal::RPageSourceS3::AttachImpl()
+{
+   RNTupleDescriptorBuilder descBuilder;
+   RS3NTupleAnchor anchor;
+   std::unique_ptr<unsigned char[]> buffer, zipBuffer;
+
+   unsigned char anchorBuffer[RS3NTupleAnchor::GetSize()];
+   if (fBucket->Get("anchor", anchorBuffer, RS3NTupleAnchor::GetSize(), 0) != RS3NTupleAnchor::GetSize()) {
+      throw RException(R__FAIL("Attach: requested ntuple '" + fNTupleName + "' is not present in S3 bucket."));
+   }
+   anchor.Deserialize(anchorBuffer, RS3NTupleAnchor::GetSize()).Unwrap();
+   if (anchor.fVersionEpoch != RNTuple::kVersionEpoch) {
+      throw RException(R__FAIL("unsupported RNTuple epoch version: " + std::to_string(anchor.fVersionEpoch)));
+   }
+
+   auto fnReadObject = [&](const std::string &key, std::uint32_t nbytes, std::uint32_t len) {
+      buffer = std::make_unique<unsigned char[]>(len);
+      zipBuffer = std::make_unique<unsigned char[]>(nbytes);
+      if (fBucket->Get(key, zipBuffer.get(), nbytes, 0) != nbytes)
+         throw RException(R__FAIL("Attach: short read of '" + key + "' from S3 bucket."));
+      RNTupleDecompressor::Unzip(zipBuffer.get(), nbytes, len, buffer.get());
+   };
+
+   descBuilder.SetOnDiskHeaderSize(anchor.fNBytesHeader);
+   fnReadObject("header", anchor.fNBytesHeader, anchor.fLenHeader);
+   RNTupleSerializer::DeserializeHeader(buffer.get(), anchor.fLenHeader, descBuilder);
+
+   descBuilder.AddToOnDiskFooterSize(anchor.fNBytesFooter);
+   fnReadObject("footer", anchor.fNBytesFooter, anchor.fLenFooter);
+   RNTupleSerializer::DeserializeFooter(buffer.get(), anchor.fLenFooter, descBuilder);
+
+   auto desc = descBuilder.MoveDescriptor();
+   if (desc.GetName() != fNTupleName) {
+      throw RException(R__FAIL("Attach: found ntuple '" + desc.GetName() + "' instead of '" + fNTupleName + "'."));
+   }
+
+   for (const auto &cgDesc : desc.GetClusterGroupIterable()) {
+      const auto &locator = cgDesc.GetPageListLocator();
+      fnReadObject(GetPageListKey(locator.GetPosition<RNTupleLocatorObject64>().fLocation), locator.fBytesOnStorage,
+                   cgDesc.GetPageListLength());
+      RNTupleSerializer::DeserializePageList(buffer.get(), cgDesc.GetPageListLength(), cgDesc.GetId(), desc);
+   }
+
+   return desc;
+}
+
+void ROOT::Experimental::Internal::RPageSourceS3::LoadSealedPage(DescriptorId_t physicalColumnId,
+                                                                 RClusterIndex clusterIndex, RSealedPage &sealedPage)
+{
+   const auto clusterId = clusterIndex.GetClusterId();
+
+   RClusterDescriptor::RPageRange::RPageInfo pageInfo;
+   {
+      auto descriptorGuard = GetSharedDescriptorGuard();
+      const auto &clusterDescriptor = descriptorGuard->GetClusterDescriptor(clusterId);
+      pageInfo = clusterDescriptor.GetPageRange(physicalColumnId).Find(clusterIndex.GetIndex());
+   }
+
+   sealedPage.SetBufferSize(pageInfo.fLocator.fBytesOnStorage + pageInfo.fHasChecksum * kNBytesPageChecksum);
+   sealedPage.SetNElements(pageInfo.fNElements);
+   sealedPage.SetHasChecksum(pageInfo.fHasChecksum);
+   if (!sealedPage.GetBuffer())
+      return;
+
+   if (pageInfo.fLocator.fType == RNTupleLocator::kTypePageZero) {
+      assert(!pageInfo.fHasChecksum);
+      memcpy(const_cast<void *>(sealedPage.GetBuffer()), RPage::GetPageZeroBuffer(), sealedPage.GetBufferSize());
+      return;
+   }
+
+   const auto [position, offset] = DecodeS3PagePosition(pageInfo.fLocator.GetPosition<RNTupleLocatorObject64>());
+   RS3Bucket::RRange range{const_cast<void *>(sealedPage.GetBuffer()), offset, sealedPage.GetBufferSize()};
+   fBucket->GetV(GetClusterKey(position), &range, 1);
+
+   sealedPage.VerifyChecksumIfEnabled().ThrowOnError();
+}
+
+ROOT::Experimental::Internal::RPageRef
+ROOT::Experimental::Internal::RPageSourceS3::LoadPageImpl(ColumnHandle_t columnHandle, const RClusterInfo &clusterInfo,
+                                                          ClusterSize_t::ValueType idxInCluster)
+{
+   const auto columnId = columnHandle.fPhysicalId;
+   const auto clusterId = clusterInfo.fClusterId;
+   const auto &pageInfo = clusterInfo.fPageInfo;
+
+   const auto element = columnHandle.fColumn->GetElement();
+   const auto elementSize = element->GetSize();
+
+   if (pageInfo.fLocator.fType == RNTupleLocator::kTypePageZero) {
+      auto pageZero = RPage::MakePageZero(columnId, elementSize);
+      pageZero.GrowUnchecked(pageInfo.fNElements);
+      pageZero.SetWindow(clusterInfo.fColumnOffset + pageInfo.fFirstInPage,
+                         RPage::RClusterInfo(clusterId, clusterInfo.fColumnOffset));
+      return fPagePool.RegisterPage(std::move(pageZero));
+   }
+
+   RSealedPage sealedPage;
+   sealedPage.SetNElements(pageInfo.fNElements);
+   sealedPage.SetHasChecksum(pageInfo.fHasChecksum);
+   sealedPage.SetBufferSize(pageInfo.fLocator.fBytesOnStorage + pageInfo.fHasChecksum * kNBytesPageChecksum);
+   std::unique_ptr<unsigned char[]> directReadBuffer; // only used if cluster pool is turned off
+
+   if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
+      directReadBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[sealedPage.GetBufferSize()]);
+      const auto [position, offset] = DecodeS3PagePosition(pageInfo.fLocator.GetPosition<RNTupleLocatorObject64>());
+      RS3Bucket::RRange range{directReadBuffer.get(), offset, sealedPage.GetBufferSize()};
+      {
+         Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
+         fBucket->GetV(GetClusterKey(position), &range, 1);
+      }
+      fCounters->fNPageRead.Inc();
+      fCounters->fNRead.Inc();
+      fCounters->fSzReadPayload.Add(sealedPage.GetBufferSize());
+      sealedPage.SetBuffer(directReadBuffer.get());
+   } else {
+      if (!fCurrentCluster || (fCurrentCluster->GetId() != clusterId) || !fCurrentCluster->ContainsColumn(columnId))
+         fCurrentCluster = fClusterPool->GetCluster(clusterId, fActivePhysicalColumns.ToColumnSet());
+      R__ASSERT(fCurrentCluster->ContainsColumn(columnId));
+
+      auto cachedPageRef = fPagePool.GetPage(columnId, RClusterIndex(clusterId, idxInCluster));
+      if (!cachedPageRef.Get().IsNull())
+         return cachedPageRef;
+
+      ROnDiskPage::Key key(columnId, pageInfo.fPageNo);
+      auto onDiskPage = fCurrentCluster->GetOnDiskPage(key);
+      R__ASSERT(onDiskPage && (sealedPage.GetBufferSize() == onDiskPage->GetSize()));
+      sealedPage.SetBuffer(onDiskPage->GetAddress());
+   }
+
+   RPage newPage;
+   {
+      Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
+      newPage = UnsealPage(sealedPage, *element, columnId).Unwrap();
+      fCounters->fSzUnzip.Add(elementSize * pageInfo.fNElements);
+   }
+
+   newPage.SetWindow(clusterInfo.fColumnOffset + pageInfo.fFirstInPage,
+                     RPage::RClusterInfo(clusterId, clusterInfo.fColumnOffset));
+   fCounters->fNPageUnsealed.Inc();
+   return fPagePool.RegisterPage(std::move(newPage));
+}
+
+std::unique_ptr<ROOT::Experimental::Internal::RPageSource>
+ROOT::Experimental::Internal::RPageSourceS3::CloneImpl() const
+{
+   auto clone = new RPageSourceS3(fNTupleName, fURI, fOptions);
+   return std::unique_ptr<RPageSourceS3>(clone);
+}
+
+std::vector<std::unique_ptr<ROOT::Experimental::Internal::RCluster>>
+ROOT::Experimental::Internal::RPageSourceS3::LoadClusters(std::span<RCluster::RKey> clusterKeys)
+{
+   struct RS3SealedPageLocator {
+      DescriptorId_t fColumnId = 0;
+      NTupleSize_t fPageNo = 0;
+      std::uint64_t fOffset = 0;
+      std::uint64_t fBufferSize = 0; // page payload + checksum (if available)
+   };
+
+   // Byte ranges to be read, grouped by cluster object. Usually all pages of a cluster are in the same object;
+   // pages that were deduplicated during a merge can refer to the object of an earlier cluster.
+   std::map<std::uint32_t, std::vector<RS3Bucket::RRange>> readRequests;
+
+   auto fnPrepareSingleCluster = [&](const RCluster::RKey &clusterKey) {
+      std::map<std::uint32_t, std::vector<RS3SealedPageLocator>> onDiskPages;
+      std::size_t clusterBufSz = 0, nPages = 0;
+      auto pageZeroMap = std::make_unique<ROnDiskPageMap>();
+      PrepareLoadCluster(clusterKey, *pageZeroMap,
+                         [&](DescriptorId_t physicalColumnId, NTupleSize_t pageNo,
+                             const RClusterDescriptor::RPageRange::RPageInfo &pageInfo) {
+                            const auto &pageLocator = pageInfo.fLocator;
+                            const auto [position, offset] =
+                               DecodeS3PagePosition(pageLocator.GetPosition<RNTupleLocatorObject64>());
+                            auto pageBufferSize =
+                               pageLocator.fBytesOnStorage + pageInfo.fHasChecksum * kNBytesPageChecksum;
+                            onDiskPages[position].push_back({physicalColumnId, pageNo, offset, pageBufferSize});
+                            ++nPages;
+                            clusterBufSz += pageBufferSize;
+                         });
+
+      auto clusterBuffer = new unsigned char[clusterBufSz];
+      auto pageMap = std::make_unique<ROnDiskPageMapHeap>(std::unique_ptr<unsigned char[]>(clusterBuffer));
+
+      auto pageBuffer = clusterBuffer;
+      for (auto &[position, pageVec] : onDiskPages) {
+         std::sort(pageVec.begin(), pageVec.end(),
+                   [](const RS3SealedPageLocator &a, const RS3SealedPageLocator &b) { return a.fOffset < b.fOffset; });
+         auto &ranges = readRequests[position];
+         for (const auto &s : pageVec) {
+            pageMap->Register(ROnDiskPage::Key(s.fColumnId, s.fPageNo), ROnDiskPage(pageBuffer, s.fBufferSize));
+            // Adjacent pages are read as a single range
+            if (!ranges.empty() && (ranges.back().fOffset + ranges.back().fSize == s.fOffset) &&
+                (static_cast<unsigned char *>(ranges.back().fBuffer) + ranges.back().fSize == pageBuffer)) {
+               ranges.back().fSize += s.fBufferSize;
+            } else {
+               ranges.push_back({pageBuffer, s.fOffset, s.fBufferSize});
+            }
+            pageBuffer += s.fBufferSize;
+         }
+      }
+      fCounters->fNPageRead.Add(nPages);
+      fCounters->fSzReadPayload.Add(clusterBufSz);
+
+      auto cluster = std::make_unique<RCluster>(clusterKey.fClusterId);
+      cluster->Adopt(std::move(pageMap));
+      cluster->Adopt(std::move(pageZeroMap));
+      for (auto colId : clusterKey.fPhysicalColumnSet)
+         cluster->SetColumnAvailable(colId);
+      return cluster;
+   };
+
+   fCounters->fNClusterLoaded.Add(clusterKeys.size());
+
+   std::vector<std::unique_ptr<ROOT::Experimental::Internal::RCluster>> clusters;
+   for (auto key : clusterKeys) {
+      clusters.emplace_back(fnPrepareSingleCluster(key));
+   }
+
+   std::size_t nRanges = 0;
+   {
+      Detail::RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
+      // One request per cluster object, all of them in flight at the same time
+      std::vector<std::future<void>> reads;
+      for (auto &request : readRequests) {
+         auto ranges = &request.second;
+         nRanges += ranges->size();
+         reads.emplace_back(std::async(std::launch::async, [this, key = GetClusterKey(request.first), ranges]() {
+            fBucket->GetV(key, ranges->data(), ranges->size());
+         }));
+      }
+      for (auto &r : reads)
+         r.wait();
+      for (auto &r : reads)
+         r.get();
+   }
+   fCounters->fNReadV.Inc();
+   fCounters->fNRead.Add(nRanges);
+
+   return clusters;
+}
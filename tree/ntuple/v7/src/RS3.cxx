@@ -0,0 +1,120 @@
+/// \file RS3.cxx
+/// \ingroup NTuple ROOT7
+/// \date 2024-10-16
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RError.hxx>
+#include <ROOT/RS3.hxx>
+
+#include <TEnv.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include <davix.hpp>
+
+namespace ROOT {
+namespace Experimental {
+namespace Internal {
+
+struct RS3BucketImpl {
+   Davix::Context fContext;
+   Davix::RequestParams fParams;
+};
+
+} // namespace Internal
+} // namespace Experimental
+} // namespace ROOT
+
+namespace {
+const char *GetS3Setting(const char *resource, const char *envVar)
+{
+   return gEnv->GetValue(resource, std::getenv(envVar));
+}
+} // anonymous namespace
+
+ROOT::Experimental::Internal::RS3Bucket::RS3Bucket(std::string_view url)
+   : fImpl(std::make_unique<RS3BucketImpl>()), fUrl(url)
+{
+   while (!fUrl.empty() && fUrl.back() == '/')
+      fUrl.pop_back();
+
+   auto &params = fImpl->fParams;
+   params.setTransparentRedirectionSupport(true);
+   const char *secretKey = GetS3Setting("Davix.S3.SecretKey", "S3_SECRET_KEY");
+   const char *accessKey = GetS3Setting("Davix.S3.AccessKey", "S3_ACCESS_KEY");
+   if (secretKey && accessKey) {
+      params.setAwsAuthorizationKeys(secretKey, accessKey);
+      if (const char *region = GetS3Setting("Davix.S3.Region", "S3_REGION"))
+         params.setAwsRegion(region);
+      if (const char *token = GetS3Setting("Davix.S3.Token", "S3_TOKEN"))
+         params.setAwsToken(token);
+   }
+}
+
+ROOT::Experimental::Internal::RS3Bucket::~RS3Bucket() = default;
+
+void ROOT::Experimental::Internal::RS3Bucket::Put(const std::string &key, const void *buffer, std::size_t nbytes)
+{
+   try {
+      Davix::DavFile file(fImpl->fContext, Davix::Uri(GetObjectUrl(key)));
+      file.put(&fImpl->fParams, static_cast<const char *>(buffer), nbytes);
+   } catch (const Davix::DavixException &e) {
+      throw RException(R__FAIL("cannot upload '" + GetObjectUrl(key) + "': " + e.what()));
+   }
+}
+
+std::size_t ROOT::Experimental::Internal::RS3Bucket::Get(const std::string &key, void *buffer, std::size_t nbytes,
+                                                         std::uint64_t offset)
+{
+   Davix::DavixError *err = nullptr;
+   Davix::DavFile file(fImpl->fContext, Davix::Uri(GetObjectUrl(key)));
+   auto nread = file.readPartial(&fImpl->fParams, buffer, nbytes, offset, &err);
+   if (nread < 0) {
+      std::string msg = err ? err->getErrMsg() : "unknown error";
+      Davix::DavixError::clearError(&err);
+      throw RException(R__FAIL("cannot read '" + GetObjectUrl(key) + "': " + msg));
+   }
+   return nread;
+}
+
+void ROOT::Experimental::Internal::RS3Bucket::GetV(const std::string &key, RRange *ranges, std::size_t nRanges)
+{
+   if (nRanges == 0)
+      return;
+   if (nRanges == 1) {
+      if (Get(key, ranges[0].fBuffer, ranges[0].fSize, ranges[0].fOffset) != ranges[0].fSize)
+         throw RException(R__FAIL("short read from '" + GetObjectUrl(key) + "'"));
+      return;
+   }
+
+   // Davix issues a multi-range request and falls back to single range requests if the server does not support it
+   std::vector<Davix::DavIOVecInput> in(nRanges);
+   std::vector<Davix::DavIOVecOuput> out(nRanges);
+   for (std::size_t i = 0; i < nRanges; ++i) {
+      in[i].diov_buffer = ranges[i].fBuffer;
+      in[i].diov_offset = ranges[i].fOffset;
+      in[i].diov_size = ranges[i].fSize;
+   }
+
+   Davix::DavixError *err = nullptr;
+   Davix::DavFile file(fImpl->fContext, Davix::Uri(GetObjectUrl(key)));
+   if (file.readPartialBufferVec(&fImpl->fParams, in.data(), out.data(), nRanges, &err) < 0) {
+      std::string msg = err ? err->getErrMsg() : "unknown error";
+      Davix::DavixError::clearError(&err);
+      throw RException(R__FAIL("cannot read '" + GetObjectUrl(key) + "': " + msg));
+   }
+   for (std::size_t i = 0; i < nRanges; ++i) {
+      if (out[i].diov_size != static_cast<dav_ssize_t>(ranges[i].fSize))
+         throw RException(R__FAIL("short read from '" + GetObjectUrl(key) + "'"));
+   }
+}
@@ -904,3 +904,52 @@ TEST(RFieldBase, CreateObject)
    auto ptrClass = RField<LowPrecisionFloats>("name").CreateObject<LowPrecisionFloats>();
    EXPECT_DOUBLE_EQ(1.0, ptrClass->b);
 }
+
+TEST(RNTuple, LoadSelectedEntries)
+{
+   FileRaii fileGuard("test_ntuple_load_selected_entries.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto ptrCharge = model->MakeField<int>("charge");
+      auto ptrPx = model->MakeField<float>("px");
+      auto ptrHits = model->MakeField<std::vector<float>>("hits");
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath());
+      for (int i = 0; i < 40; ++i) {
+         // Only the entries of the second cluster have a positive charge
+         *ptrCharge = (i >= 10 && i < 20 && i % 2 == 0) ? 1 : -1;
+         *ptrPx = float(i);
+         ptrHits->assign(i % 3, float(i));
+         writer->Fill();
+         if (i % 10 == 9)
+            writer->CommitCluster();
+      }
+   }
+
+   auto reader = RNTupleReader::Open("ntpl", fileGuard.GetPath());
+   EXPECT_EQ(4u, reader->GetDescriptor().GetNClusters());
+   const auto &entry = reader->GetModel().GetDefaultEntry();
+   auto ptrCharge = entry.GetPtr<int>("charge");
+   auto ptrPx = entry.GetPtr<float>("px");
+   auto ptrHits = entry.GetPtr<std::vector<float>>("hits");
+
+   std::vector<NTupleSize_t> selected;
+   reader->LoadSelectedEntries(
+      {"charge"}, [&](const REntry &) { return *ptrCharge > 0; },
+      [&](NTupleSize_t index, const REntry &) {
+         selected.push_back(index);
+         EXPECT_EQ(1, *ptrCharge);
+         EXPECT_FLOAT_EQ(float(index), *ptrPx);
+         EXPECT_EQ(std::vector<float>(index % 3, float(index)), *ptrHits);
+      });
+   EXPECT_EQ(std::vector<NTupleSize_t>({10, 12, 14, 16, 18}), selected);
+
+   selected.clear();
+   reader->LoadSelectedEntries(
+      {"charge"}, [&](const REntry &) { return false; },
+      [&](NTupleSize_t index, const REntry &) { selected.push_back(index); });
+   EXPECT_TRUE(selected.empty());
+
+   EXPECT_THROW(reader->LoadSelectedEntries(
+                   {"nonexistent"}, [](const REntry &) { return true; }, [](NTupleSize_t, const REntry &) {}),
+                RException);
+}
@@ -18,9 +18,11 @@
 #include <ROOT/TThreadExecutor.hxx>
 #endif
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -49,8 +51,14 @@ public:
    /// Records the cluster IDs requests by LoadClusters() calls
    std::vector<ROOT::Experimental::DescriptorId_t> fReqsClusterIds;
    std::vector<ROOT::Experimental::Internal::RCluster::ColumnSet_t> fReqsColumns;
-
-   RPageSourceMock() : RPageSource("test", ROOT::Experimental::RNTupleReadOptions())
+   /// Number of LoadClusters() calls, i.e. number of vector reads issued by the cluster pool
+   unsigned int fNLoadClustersCalls = 0;
+   /// Artificial latency of LoadClusters() calls
+   std::chrono::milliseconds fLoadDelay{0};
+   /// Size of the (fake) on-disk pages
+   std::uint32_t fPageSize = 0;
+
+   explicit RPageSourceMock(const ROOT::Experimental::RNTupleReadOptions &options = {}) : RPageSource("test", options)
    {
       ROOT::Experimental::Internal::RNTupleDescriptorBuilder descBuilder;
       descBuilder.SetNTuple("ntpl", "");
@@ -75,13 +83,15 @@ public:
    std::vector<std::unique_ptr<RCluster>> LoadClusters(std::span<RCluster::RKey> clusterKeys) final
    {
       std::vector<std::unique_ptr<RCluster>> result;
+      fNLoadClustersCalls++;
+      std::this_thread::sleep_for(fLoadDelay);
       for (auto key : clusterKeys) {
          fReqsClusterIds.emplace_back(key.fClusterId);
          fReqsColumns.emplace_back(key.fPhysicalColumnSet);
          auto cluster = std::make_unique<RCluster>(key.fClusterId);
          auto pageMap = std::make_unique<ROOT::Experimental::Internal::ROnDiskPageMap>();
          for (auto colId : key.fPhysicalColumnSet) {
-            pageMap->Register(ROnDiskPage::Key(colId, 0), ROnDiskPage(nullptr, 0));
+            pageMap->Register(ROnDiskPage::Key(colId, 0), ROnDiskPage(nullptr, fPageSize));
             cluster->SetColumnAvailable(colId);
          }
          cluster->Adopt(std::move(pageMap));
@@ -255,6 +265,65 @@ TEST(ClusterPool, GetClusterBasics)
    EXPECT_EQ(5U, p4.fReqsClusterIds[3]);
 }
 
+TEST(ClusterPool, MergeBunches)
+{
+   RPageSourceMock p1;
+   {
+      RClusterPool c1(p1, 2);
+      c1.GetCluster(0, {0});
+      c1.WaitForInFlightClusters();
+   }
+   ASSERT_EQ(4U, p1.fReqsClusterIds.size());
+   EXPECT_EQ(2U, p1.fNLoadClustersCalls);
+
+   ROOT::Experimental::RNTupleReadOptions options;
+   options.SetUseIoUring(true);
+   RPageSourceMock p2(options);
+   {
+      RClusterPool c2(p2, 2);
+      c2.GetCluster(0, {0});
+      c2.WaitForInFlightClusters();
+   }
+   ASSERT_EQ(4U, p2.fReqsClusterIds.size());
+   for (unsigned i = 0; i < 4; ++i)
+      EXPECT_EQ(i, p2.fReqsClusterIds[i]);
+   // Both bunches are sent to the page source in one go
+   EXPECT_EQ(1U, p2.fNLoadClustersCalls);
+}
+
+TEST(ClusterPool, AdaptiveBunchSize)
+{
+   ROOT::Experimental::RNTupleReadOptions options;
+   options.SetMaxClusterBunchSize(4);
+   RPageSourceMock p1(options);
+   p1.fLoadDelay = std::chrono::milliseconds(50);
+   {
+      RClusterPool c1(p1, 1);
+      c1.GetMetrics().Enable();
+      EXPECT_EQ(1U, c1.GetClusterBunchSize());
+      // The first cluster is never in the pool, so the reader has to wait for the I/O thread
+      c1.GetCluster(0, {0});
+      c1.GetCluster(1, {0});
+      EXPECT_EQ(2U, c1.GetClusterBunchSize());
+      EXPECT_GT(c1.GetMetrics().GetCounter("RClusterPool.timeWallStall")->GetValueAsInt(), 0);
+      EXPECT_EQ(2, c1.GetMetrics().GetCounter("RClusterPool.clusterBunchSize")->GetValueAsInt());
+      c1.WaitForInFlightClusters();
+   }
+
+   // A memory budget that holds only a single cluster keeps the bunch size at one
+   options.SetClusterMemoryBudget(1000);
+   RPageSourceMock p2(options);
+   p2.fLoadDelay = std::chrono::milliseconds(50);
+   p2.fPageSize = 1000;
+   {
+      RClusterPool c2(p2, 1);
+      c2.GetCluster(0, {0});
+      c2.GetCluster(1, {0});
+      EXPECT_EQ(1U, c2.GetClusterBunchSize());
+      c2.WaitForInFlightClusters();
+   }
+}
+
 TEST(ClusterPool, SetEntryRange)
 {
    RPageSourceMock p1;
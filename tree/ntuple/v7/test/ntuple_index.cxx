@@ -257,3 +257,47 @@ TEST(RNTupleIndex, MultipleMatches)
    entryIdxs = index->GetAllEntryNumbers<std::uint64_t>(4);
    EXPECT_EQ(nullptr, entryIdxs);
 }
+
+TEST(RNTupleIndex, MultipleClusters)
+{
+   FileRaii fileGuard("test_ntuple_index_multiple_clusters.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto fldRun = model->MakeField<std::uint32_t>("run");
+      auto fldEvent = model->MakeField<std::int64_t>("event");
+
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath());
+
+      // Every (run, event) pair occurs twice, once in the first and once in the second half of the entries
+      for (int i = 0; i < 10000; ++i) {
+         *fldRun = (i % 5000) % 7;
+         *fldEvent = -static_cast<std::int64_t>(i % 5000);
+         ntuple->Fill();
+         if (i % 1000 == 999)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto fnCheck = [&]() {
+      auto pageSource = RPageSource::Create("ntuple", fileGuard.GetPath());
+      auto index = RNTupleIndex::Create({"run", "event"}, *pageSource);
+
+      EXPECT_EQ(5000ULL, index->GetSize());
+      for (std::int64_t i = 0; i < 5000; ++i) {
+         const auto entryIdxs = index->GetAllEntryNumbers<std::uint32_t, std::int64_t>(i % 7, -i);
+         ASSERT_NE(nullptr, entryIdxs);
+         const auto expected =
+            std::vector<std::uint64_t>{static_cast<std::uint64_t>(i), static_cast<std::uint64_t>(i + 5000)};
+         EXPECT_EQ(expected, *entryIdxs);
+      }
+      EXPECT_EQ(ROOT::Experimental::kInvalidNTupleIndex, (index->GetFirstEntryNumber<std::uint32_t, std::int64_t>(1, 0)));
+      EXPECT_EQ(ROOT::Experimental::kInvalidNTupleIndex, (index->GetFirstEntryNumber<std::uint32_t, std::int64_t>(0, 1)));
+   };
+
+   fnCheck();
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   fnCheck();
+   ROOT::DisableImplicitMT();
+#endif
+}
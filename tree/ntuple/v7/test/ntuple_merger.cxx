@@ -994,3 +994,62 @@ TEST(RNTupleMerger, MergeLateModelExtension)
       }
    }
 }
+
+#ifdef R__USE_IMT
+TEST(RNTupleMerger, MergeParallel)
+{
+   ROOT::EnableImplicitMT(4);
+
+   constexpr int kNSources = 6;
+   constexpr int kNEntriesPerSource = 2000;
+   std::vector<std::unique_ptr<FileRaii>> fileGuards;
+   for (int s = 0; s < kNSources; ++s) {
+      fileGuards.emplace_back(
+         std::make_unique<FileRaii>("test_ntuple_merge_parallel_in_" + std::to_string(s) + ".root"));
+      auto model = RNTupleModel::Create();
+      auto fieldFoo = model->MakeField<int>("foo");
+      auto fieldBar = model->MakeField<std::vector<float>>("bar");
+      auto writeOpts = RNTupleWriteOptions();
+      writeOpts.SetCompression(505);
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuards.back()->GetPath(), writeOpts);
+      for (int i = 0; i < kNEntriesPerSource; ++i) {
+         *fieldFoo = s * kNEntriesPerSource + i;
+         *fieldBar = std::vector<float>(i % 4, i);
+         writer->Fill();
+         if (i % 500 == 499)
+            writer->CommitCluster();
+      }
+   }
+
+   FileRaii fileGuardOut("test_ntuple_merge_parallel_out.root");
+   {
+      std::vector<std::unique_ptr<RPageSource>> sources;
+      std::vector<RPageSource *> sourcePtrs;
+      for (const auto &fileGuard : fileGuards) {
+         sources.push_back(RPageSource::Create("ntuple", fileGuard->GetPath(), RNTupleReadOptions()));
+         sourcePtrs.push_back(sources.back().get());
+      }
+
+      auto destination = std::make_unique<RPageSinkFile>("ntuple", fileGuardOut.GetPath(), RNTupleWriteOptions());
+      RNTupleMerger merger;
+      auto opts = RNTupleMergeOptions{};
+      opts.fCompressionSettings = 101;
+      opts.fNPrefetchSources = 2;
+      auto res = merger.Merge(sourcePtrs, *destination, opts);
+      EXPECT_TRUE(bool(res));
+   }
+
+   auto reader = RNTupleReader::Open("ntuple", fileGuardOut.GetPath());
+   ASSERT_EQ(kNSources * kNEntriesPerSource, reader->GetNEntries());
+   EXPECT_EQ(kNSources * kNEntriesPerSource / 500, reader->GetDescriptor().GetNClusters());
+   auto viewFoo = reader->GetView<int>("foo");
+   auto viewBar = reader->GetView<std::vector<float>>("bar");
+   for (auto i : reader->GetEntryRange()) {
+      ASSERT_EQ(static_cast<int>(i), viewFoo(i));
+      const auto iLocal = i % kNEntriesPerSource;
+      ASSERT_EQ(std::vector<float>(iLocal % 4, iLocal), viewBar(i));
+   }
+
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -9,6 +9,7 @@
 #include <type_traits>
 #include <utility>
 #include <random>
+#include <vector>
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -102,6 +103,35 @@ TEST(Packing, Bitfield)
    }
 }
 
+TEST(Packing, ByteSplit)
+{
+   using namespace ROOT::Experimental::Internal::ByteSplit;
+
+   std::mt19937 gen(42);
+   std::uniform_int_distribution<int> dist(0, 255);
+   // Cover the vectorized block sizes of all kernels, the scalar tail, and element sizes without a vectorized kernel
+   for (std::size_t N : {1, 2, 3, 4, 8}) {
+      for (std::size_t count : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+         const std::size_t stride = count + 3;
+         std::vector<unsigned char> items(count * N);
+         for (auto &byte : items)
+            byte = dist(gen);
+
+         std::vector<unsigned char> split(stride * N, 0);
+         Split(split.data(), items.data(), count, N, stride);
+         for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t b = 0; b < N; ++b) {
+               EXPECT_EQ(items[i * N + b], split[b * stride + i]) << "N=" << N << " count=" << count << " i=" << i;
+            }
+         }
+
+         std::vector<unsigned char> unsplit(count * N, 0);
+         Unsplit(unsplit.data(), split.data(), count, N, stride);
+         EXPECT_EQ(items, unsplit) << "N=" << N << " count=" << count;
+      }
+   }
+}
+
 TEST(Packing, HalfPrecisionFloat)
 {
    auto element32_16 = RColumnElementBase::Generate<float>(EColumnType::kReal16);
@@ -11,6 +11,44 @@ TEST(Pages, Allocation)
    EXPECT_EQ(0U, page.GetNBytes());
 }
 
+TEST(Pages, AllocatorPool)
+{
+   RPageAllocatorPool allocator(1024);
+
+   void *buffer = nullptr;
+   {
+      auto page = allocator.NewPage(42, 4, 16);
+      EXPECT_FALSE(page.IsNull());
+      EXPECT_EQ(16U, page.GetMaxElements());
+      buffer = page.GetBuffer();
+   }
+   // 64 bytes are cached for reuse
+   EXPECT_EQ(64U, allocator.GetNBytesCached());
+   {
+      // Same size class: the buffer is recycled
+      auto page = allocator.NewPage(1, 8, 5);
+      EXPECT_EQ(buffer, page.GetBuffer());
+      EXPECT_EQ(5U, page.GetMaxElements());
+      EXPECT_EQ(0U, allocator.GetNBytesCached());
+   }
+
+   {
+      // Larger than the cache budget: released pages are freed
+      auto page = allocator.NewPage(1, 1, 2000);
+      EXPECT_FALSE(page.IsNull());
+   }
+   EXPECT_EQ(64U, allocator.GetNBytesCached());
+
+   {
+      // Pages above the largest size class are never cached
+      RPageAllocatorPool largeAllocator(std::size_t(-1));
+      auto page = largeAllocator.NewPage(1, 1, 128 * 1024 * 1024);
+      EXPECT_FALSE(page.IsNull());
+      page = RPage();
+      EXPECT_EQ(0U, largeAllocator.GetNBytesCached());
+   }
+}
+
 TEST(Pages, Pool)
 {
    RPageAllocatorHeap allocator;
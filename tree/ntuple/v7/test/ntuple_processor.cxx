@@ -2,6 +2,8 @@
 
 #include <ROOT/RNTupleProcessor.hxx>
 
+#include <atomic>
+
 using ROOT::Experimental::RNTupleModel;
 using ROOT::Experimental::RNTupleWriter;
 using ROOT::Experimental::Internal::RNTupleProcessor;
@@ -296,3 +298,57 @@ TEST(RNTupleProcessor, ChainUnalignedModels)
       EXPECT_THAT(err.what(), testing::HasSubstr("field \"y\" not found in current RNTuple"));
    }
 }
+
+TEST(RNTupleProcessor, ParallelForEach)
+{
+   FileRaii fileGuard1("test_ntuple_processor_parallel1.root");
+   FileRaii fileGuard2("test_ntuple_processor_parallel2.root");
+   FileRaii fileGuard3("test_ntuple_processor_parallel3.root");
+   const std::vector<std::pair<const FileRaii *, unsigned>> files = {
+      {&fileGuard1, 1000}, {&fileGuard2, 0}, {&fileGuard3, 450}};
+   unsigned nTotal = 0;
+   for (const auto &[fileGuard, nEntries] : files) {
+      auto model = RNTupleModel::Create();
+      auto fldX = model->MakeField<float>("x");
+      auto fldY = model->MakeField<std::vector<float>>("y");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard->GetPath());
+
+      for (unsigned i = 0; i < nEntries; ++i) {
+         *fldX = static_cast<float>(nTotal + i);
+         *fldY = std::vector<float>(i % 3, static_cast<float>(i));
+         ntuple->Fill();
+         if (i % 100 == 99)
+            ntuple->CommitCluster();
+      }
+      nTotal += nEntries;
+   }
+
+   std::vector<RNTupleSourceSpec> ntuples = {{"ntuple", fileGuard1.GetPath()},
+                                             {"ntuple", fileGuard2.GetPath()},
+                                             {"ntuple", fileGuard3.GetPath()}};
+
+   auto fnCheck = [&]() {
+      RNTupleProcessor proc(ntuples);
+      std::vector<std::atomic<int>> nSeen(nTotal);
+      proc.ParallelForEach([&](const RNTupleProcessor::RIterator::RProcessorState &state) {
+         auto globalIndex = state.GetGlobalEntryIndex();
+         ASSERT_LT(globalIndex, nTotal);
+         nSeen[globalIndex]++;
+         EXPECT_EQ(static_cast<float>(globalIndex), *state->GetPtr<float>("x"));
+         auto localIndex = state.GetLocalEntryIndex();
+         EXPECT_EQ(std::vector<float>(localIndex % 3, static_cast<float>(localIndex)),
+                   *state->GetPtr<std::vector<float>>("y"));
+         EXPECT_EQ(state.GetNTupleIndex() == 0 ? globalIndex : globalIndex - 1000, localIndex);
+         EXPECT_NE(1U, state.GetNTupleIndex());
+      });
+      for (unsigned i = 0; i < nTotal; ++i)
+         EXPECT_EQ(1, nSeen[i]) << i;
+   };
+
+   fnCheck();
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   fnCheck();
+   ROOT::DisableImplicitMT();
+#endif
+}
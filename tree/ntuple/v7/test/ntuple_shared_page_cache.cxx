@@ -0,0 +1,125 @@
+#include "ntuple_test.hxx"
+
+#include <unistd.h>
+
+namespace {
+/// Removes the shared-memory segment, which would otherwise outlive the test
+class SegmentRaii {
+   std::string fName;
+
+public:
+   explicit SegmentRaii(const std::string &name) : fName(name + "_" + std::to_string(getpid()))
+   {
+      RSharedPageCache::Unlink(fName);
+   }
+   SegmentRaii(const SegmentRaii &) = delete;
+   SegmentRaii &operator=(const SegmentRaii &) = delete;
+   ~SegmentRaii() { RSharedPageCache::Unlink(fName); }
+   const std::string &GetName() const { return fName; }
+};
+} // anonymous namespace
+
+TEST(RSharedPageCache, Basics)
+{
+   SegmentRaii segmentGuard("test_ntuple_shared_page_cache_basics");
+
+   RSharedPageCache cache(segmentGuard.GetName(), 64 * 1024, 1024);
+   EXPECT_EQ(1024u, cache.GetBlockSize());
+   const auto nBlocks = cache.GetNBlocks();
+   EXPECT_GT(nBlocks, 4u);
+   EXPECT_EQ(0u, cache.GetNPages());
+
+   std::vector<unsigned char> page(1000);
+   std::vector<unsigned char> buffer(1000);
+   RSharedPageCache::RKey key;
+   key.fDatasetId = 42;
+   EXPECT_FALSE(cache.Lookup(key, buffer.data(), buffer.size()));
+   for (std::uint32_t i = 0; i < nBlocks; ++i) {
+      key.fPageNo = i;
+      std::fill(page.begin(), page.end(), static_cast<unsigned char>(i));
+      EXPECT_TRUE(cache.Insert(key, page.data(), page.size()));
+   }
+   EXPECT_EQ(nBlocks, cache.GetNPages());
+
+   // A second instance attaches to the same segment
+   RSharedPageCache other(segmentGuard.GetName(), 0);
+   EXPECT_EQ(nBlocks, other.GetNBlocks());
+   key.fPageNo = 0;
+   EXPECT_TRUE(other.Lookup(key, buffer.data(), buffer.size()));
+   EXPECT_EQ(std::vector<unsigned char>(1000, 0), buffer);
+   // Size mismatch
+   EXPECT_FALSE(other.Lookup(key, buffer.data(), 999));
+
+   // The cache is full; page 0 was just used, so page 1 is the least recently used page
+   key.fPageNo = nBlocks;
+   EXPECT_TRUE(cache.Insert(key, page.data(), page.size()));
+   key.fPageNo = 1;
+   EXPECT_FALSE(cache.Lookup(key, buffer.data(), buffer.size()));
+   key.fPageNo = 0;
+   EXPECT_TRUE(cache.Lookup(key, buffer.data(), buffer.size()));
+   EXPECT_EQ(nBlocks, cache.GetNPages());
+
+   // A page that spans three blocks evicts the pages of the three least recently used blocks
+   std::vector<unsigned char> largePage(2500, 0xFF);
+   key.fPageNo = 1000;
+   EXPECT_TRUE(cache.Insert(key, largePage.data(), largePage.size()));
+   std::vector<unsigned char> largeBuffer(2500);
+   EXPECT_TRUE(other.Lookup(key, largeBuffer.data(), largeBuffer.size()));
+   EXPECT_EQ(largePage, largeBuffer);
+   EXPECT_EQ(nBlocks - 2, cache.GetNPages());
+   key.fPageNo = 0;
+   EXPECT_TRUE(cache.Lookup(key, buffer.data(), buffer.size()));
+
+   std::vector<unsigned char> hugePage((nBlocks + 1) * 1024);
+   EXPECT_FALSE(cache.Insert(key, hugePage.data(), hugePage.size()));
+}
+
+TEST(RPageSourceSharedCache, Read)
+{
+   FileRaii fileGuard("test_ntuple_shared_page_cache_read.root");
+   SegmentRaii segmentGuard("test_ntuple_shared_page_cache_read");
+
+   {
+      auto model = RNTupleModel::Create();
+      auto ptrPt = model->MakeField<float>("pt");
+      auto ptrTag = model->MakeField<std::string>("tag");
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath());
+      for (int i = 0; i < 1000; ++i) {
+         *ptrPt = i;
+         *ptrTag = std::to_string(i);
+         writer->Fill();
+         if (i == 499)
+            writer->CommitCluster();
+      }
+   }
+
+   RNTupleReadOptions options;
+   options.SetSharedPageCacheName(segmentGuard.GetName());
+   options.SetSharedPageCacheSize(16 * 1024 * 1024);
+
+   auto fnReadAll = [&]() {
+      auto reader = RNTupleReader::Open("ntpl", fileGuard.GetPath(), options);
+      reader->EnableMetrics();
+      auto viewPt = reader->GetView<float>("pt");
+      auto viewTag = reader->GetView<std::string>("tag");
+      for (auto i : reader->GetEntryRange()) {
+         EXPECT_FLOAT_EQ(i, viewPt(i));
+         EXPECT_EQ(std::to_string(i), viewTag(i));
+      }
+      const auto &metrics = reader->GetMetrics();
+      return std::make_pair(
+         metrics.GetCounter("RNTupleReader.RPageSourceSharedCache.nPageCacheHit")->GetValueAsInt(),
+         metrics.GetCounter("RNTupleReader.RPageSourceSharedCache.nPageCacheMiss")->GetValueAsInt());
+   };
+
+   const auto [nHit1, nMiss1] = fnReadAll();
+   EXPECT_EQ(0, nHit1);
+   EXPECT_GT(nMiss1, 0);
+   // The second reader finds all the pages in the shared cache
+   const auto [nHit2, nMiss2] = fnReadAll();
+   EXPECT_EQ(nMiss1, nHit2);
+   EXPECT_EQ(0, nMiss2);
+
+   RSharedPageCache cache(segmentGuard.GetName(), 0);
+   EXPECT_EQ(static_cast<std::uint32_t>(nMiss1), cache.GetNPages());
+}
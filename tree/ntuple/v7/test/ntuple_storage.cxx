@@ -706,6 +706,45 @@ TEST(RPageSinkBuf, ParallelZipIMT)
 }
 #endif
 
+#ifdef R__USE_IMT
+TEST(RPageSinkBuf, DoubleBufferedClusters)
+{
+   ROOT::EnableImplicitMT(2);
+
+   FileRaii fileGuard("test_ntuple_sinkbuf_double_buffered.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto fldVec = model->MakeField<std::vector<float>>("vec");
+
+      RNTupleWriteOptions options;
+      options.SetUseDoubleBufferedClusters(true);
+      options.SetMaxUnzippedPageSize(4096);
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath(), options);
+      for (int i = 0; i < 5000; i++) {
+         fldVec->assign(100, static_cast<float>(i));
+         writer->Fill();
+         if (i % 1000 == 999) {
+            writer->CommitCluster();
+         }
+         if (i == 2999) {
+            writer->CommitCluster(true /* commitClusterGroup */);
+         }
+      }
+   }
+
+   auto reader = RNTupleReader::Open("ntpl", fileGuard.GetPath());
+   EXPECT_EQ(5000U, reader->GetNEntries());
+   EXPECT_EQ(5U, reader->GetDescriptor().GetNClusters());
+   EXPECT_EQ(2U, reader->GetDescriptor().GetNClusterGroups());
+   auto viewVec = reader->GetView<std::vector<float>>("vec");
+   for (auto i : reader->GetEntryRange()) {
+      ASSERT_EQ(std::vector<float>(100, static_cast<float>(i)), viewVec(i));
+   }
+
+   ROOT::DisableImplicitMT();
+}
+#endif
+
 TEST(RPageSinkBuf, CommitSealedPageV)
 {
    RNTupleWriteOptions options;
@@ -1121,3 +1160,125 @@ TEST(RPageSinkFile, StreamerInfo)
    }
    FAIL() << "not all streamer infos found! ";
 }
+
+TEST(RPageSourceFile, MemoryMap)
+{
+   FileRaii fileGuard("test_ntuple_storage_mmap.root");
+
+   {
+      auto model = RNTupleModel::Create();
+      auto ptrInt = model->MakeField<std::int32_t>("int");
+      auto ptrDouble = model->MakeField<double>("double");
+      auto ptrVec = model->MakeField<std::vector<float>>("vec");
+      RNTupleWriteOptions options;
+      options.SetCompression(0);
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath(), options);
+      for (int i = 0; i < 1000; ++i) {
+         *ptrInt = i;
+         *ptrDouble = 0.5 * i;
+         *ptrVec = std::vector<float>(i % 3, i);
+         writer->Fill();
+         if (i == 500)
+            writer->CommitCluster();
+      }
+   }
+
+   RNTupleReadOptions options;
+   options.SetUseMemoryMap(true);
+   {
+      RPageSourceFile source("ntpl", fileGuard.GetPath(), options);
+      EXPECT_FALSE(source.IsMemoryMapped());
+      source.Attach();
+#ifndef _WIN32
+      EXPECT_TRUE(source.IsMemoryMapped());
+      auto clone = source.Clone();
+      EXPECT_TRUE(static_cast<RPageSourceFile *>(clone.get())->IsMemoryMapped());
+#endif
+   }
+
+   for (auto clusterCache : {RNTupleReadOptions::EClusterCache::kOn, RNTupleReadOptions::EClusterCache::kOff}) {
+      options.SetClusterCache(clusterCache);
+      auto reader = RNTupleReader::Open("ntpl", fileGuard.GetPath(), options);
+      ASSERT_EQ(1000U, reader->GetNEntries());
+      auto viewInt = reader->GetView<std::int32_t>("int");
+      auto viewDouble = reader->GetView<double>("double");
+      auto viewVec = reader->GetView<std::vector<float>>("vec");
+      for (auto i : reader->GetEntryRange()) {
+         EXPECT_EQ(static_cast<std::int32_t>(i), viewInt(i));
+         EXPECT_DOUBLE_EQ(0.5 * i, viewDouble(i));
+         EXPECT_EQ(std::vector<float>(i % 3, i), viewVec(i));
+      }
+   }
+}
+
+TEST(RPageSink, ValueRanges)
+{
+   FileRaii fileGuard("test_ntuple_storage_value_ranges.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto fldInt = model->MakeField<std::int32_t>("int");
+      auto fldFloat = model->MakeField<float>("float");
+      auto fldU64 = model->MakeField<std::uint64_t>("u64");
+      auto fldStr = model->MakeField<std::string>("str");
+
+      RNTupleWriteOptions options;
+      options.SetEnableValueRanges(true);
+      options.SetMaxUnzippedPageSize(512);
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath(), options);
+      for (int i = 0; i < 2000; i++) {
+         *fldInt = i - 1000;
+         *fldFloat = (i % 10 == 0) ? std::numeric_limits<float>::quiet_NaN() : 0.5f * i;
+         *fldU64 = std::numeric_limits<std::uint64_t>::max() - i;
+         *fldStr = "abc";
+         writer->Fill();
+         if (i == 999)
+            writer->CommitCluster();
+      }
+   }
+
+   auto reader = RNTupleReader::Open("ntpl", fileGuard.GetPath());
+   const auto &desc = reader->GetDescriptor();
+   ASSERT_EQ(2U, desc.GetNClusters());
+   const auto intColId = desc.FindPhysicalColumnId(desc.FindFieldId("int"), 0, 0);
+   const auto floatColId = desc.FindPhysicalColumnId(desc.FindFieldId("float"), 0, 0);
+   const auto u64ColId = desc.FindPhysicalColumnId(desc.FindFieldId("u64"), 0, 0);
+   const auto strOffsetColId = desc.FindPhysicalColumnId(desc.FindFieldId("str"), 0, 0);
+   const auto strCharColId = desc.FindPhysicalColumnId(desc.FindFieldId("str"), 1, 0);
+
+   for (std::uint64_t i = 0; i < 2; ++i) {
+      const auto &clusterDesc = desc.GetClusterDescriptor(desc.FindClusterId(intColId, i * 1000));
+      const auto &intRange = clusterDesc.GetColumnRange(intColId).fValueRange;
+      ASSERT_TRUE(intRange);
+      EXPECT_EQ(i * 1000.0 - 1000.0, intRange->fMin);
+      EXPECT_EQ(i * 1000.0 - 1.0, intRange->fMax);
+      EXPECT_TRUE(intRange->Overlaps(-1.0, 0.0));
+      EXPECT_EQ(i == 0, intRange->Overlaps(-2000.0, -500.0));
+
+      const auto &floatRange = clusterDesc.GetColumnRange(floatColId).fValueRange;
+      ASSERT_TRUE(floatRange);
+      EXPECT_FLOAT_EQ(0.5 * (i * 1000 + 1), floatRange->fMin);
+      EXPECT_FLOAT_EQ(0.5 * (i * 1000 + 999), floatRange->fMax);
+
+      const auto &u64Range = clusterDesc.GetColumnRange(u64ColId).fValueRange;
+      ASSERT_TRUE(u64Range);
+      EXPECT_LE(u64Range->fMin, static_cast<double>(std::numeric_limits<std::uint64_t>::max() - 999 - i * 1000));
+      EXPECT_GE(u64Range->fMax, static_cast<double>(std::numeric_limits<std::uint64_t>::max() - i * 1000));
+
+      EXPECT_FALSE(clusterDesc.GetColumnRange(strOffsetColId).fValueRange);
+      EXPECT_FALSE(clusterDesc.GetColumnRange(strCharColId).fValueRange);
+
+      const auto &pageRange = clusterDesc.GetPageRange(intColId);
+      EXPECT_GT(pageRange.fPageInfos.size(), 1U);
+      std::int64_t firstValue = i * 1000 - 1000;
+      for (const auto &pi : pageRange.fPageInfos) {
+         ASSERT_TRUE(pi.fValueRange);
+         EXPECT_EQ(static_cast<double>(firstValue), pi.fValueRange->fMin);
+         EXPECT_EQ(static_cast<double>(firstValue + pi.fNElements - 1), pi.fValueRange->fMax);
+         firstValue += pi.fNElements;
+      }
+   }
+
+   auto viewInt = reader->GetView<std::int32_t>("int");
+   for (auto i : reader->GetEntryRange())
+      EXPECT_EQ(static_cast<std::int32_t>(i) - 1000, viewInt(i));
+}
@@ -26,6 +26,7 @@
 #include <ROOT/RPagePool.hxx>
 #include <ROOT/RPageSinkBuf.hxx>
 #include <ROOT/RPageSourceFriends.hxx>
+#include <ROOT/RPageSourceSharedCache.hxx>
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #include <ROOT/RRawFile.hxx>
@@ -67,6 +68,7 @@ using RClusterGroupDescriptorBuilder = ROOT::Experimental::Internal::RClusterGro
 using RColumnDescriptorBuilder = ROOT::Experimental::Internal::RColumnDescriptorBuilder;
 using RColumnElementBase = ROOT::Experimental::Internal::RColumnElementBase;
 using RColumnSwitch = ROOT::Experimental::RColumnSwitch;
+using REntry = ROOT::Experimental::REntry;
 using ROOT::Experimental::Internal::RExtraTypeInfoDescriptorBuilder;
 using RFieldDescriptorBuilder = ROOT::Experimental::Internal::RFieldDescriptorBuilder;
 using RException = ROOT::Experimental::RException;
@@ -104,6 +106,7 @@ using RNTuplePlainTimer = ROOT::Experimental::Detail::RNTuplePlainTimer;
 using RNTupleSerializer = ROOT::Experimental::Internal::RNTupleSerializer;
 using RPage = ROOT::Experimental::Internal::RPage;
 using RPageAllocatorHeap = ROOT::Experimental::Internal::RPageAllocatorHeap;
+using RPageAllocatorPool = ROOT::Experimental::Internal::RPageAllocatorPool;
 using RPagePool = ROOT::Experimental::Internal::RPagePool;
 using RPageSink = ROOT::Experimental::Internal::RPageSink;
 using RPageSinkBuf = ROOT::Experimental::Internal::RPageSinkBuf;
@@ -111,10 +114,12 @@ using RPageSinkFile = ROOT::Experimental::Internal::RPageSinkFile;
 using RPageSource = ROOT::Experimental::Internal::RPageSource;
 using RPageSourceFile = ROOT::Experimental::Internal::RPageSourceFile;
 using RPageSourceFriends = ROOT::Experimental::Internal::RPageSourceFriends;
+using RPageSourceSharedCache = ROOT::Experimental::Internal::RPageSourceSharedCache;
 using RPageStorage = ROOT::Experimental::Internal::RPageStorage;
 using RPrepareVisitor = ROOT::Experimental::RPrepareVisitor;
 using RPrintSchemaVisitor = ROOT::Experimental::RPrintSchemaVisitor;
 using RRawFile = ROOT::Internal::RRawFile;
+using RSharedPageCache = ROOT::Experimental::Internal::RSharedPageCache;
 template <class T>
 using RResult = ROOT::Experimental::RResult<T>;
 using EContainerFormat = RNTupleFileWriter::EContainerFormat;
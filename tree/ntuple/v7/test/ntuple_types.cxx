@@ -2253,3 +2253,75 @@ TEST(RNTuple, RColumnRepresentations)
                 {{EColumnType::kReal64}, {EColumnType::kSplitReal64}, {EColumnType::kReal32}, {EColumnType::kReal16}}),
              colReps2.GetDeserializationTypes());
 }
+
+TEST(RNTuple, DictionaryEncodedString)
+{
+   FileRaii fileGuard("test_ntuple_dictionary_encoded_string.root");
+
+   const std::vector<std::string> triggers{"HLT_IsoMu24", "HLT_Ele32", "", "HLT_PFJet500"};
+   {
+      auto fldTrigger = std::make_unique<RField<std::string>>("trigger");
+      EXPECT_FALSE(fldTrigger->IsDictionaryEncoded());
+      fldTrigger->SetDictionaryEncoded();
+      EXPECT_TRUE(fldTrigger->IsDictionaryEncoded());
+
+      auto model = RNTupleModel::Create();
+      model->AddField(std::move(fldTrigger));
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath());
+      auto ptrTrigger = writer->GetModel().GetDefaultEntry().GetPtr<std::string>("trigger");
+      for (unsigned i = 0; i < 30; ++i) {
+         // The last string only appears in the second cluster
+         *ptrTrigger = triggers[i % ((i >= 10 && i < 20) ? 4 : 3)];
+         writer->Fill();
+         if (i % 10 == 9)
+            writer->CommitCluster();
+      }
+   }
+
+   auto source = std::make_unique<RPageSourceFile>("ntuple", fileGuard.GetPath(), RNTupleReadOptions());
+   source->Attach();
+   {
+      auto descriptorGuard = source->GetSharedDescriptorGuard();
+      const auto fieldId = descriptorGuard->FindFieldId("trigger");
+      std::vector<EColumnType> columnTypes;
+      for (const auto &c : descriptorGuard->GetColumnIterable(fieldId))
+         columnTypes.emplace_back(c.GetType());
+      EXPECT_EQ(std::vector<EColumnType>({EColumnType::kDictIndex32, EColumnType::kSplitIndex64, EColumnType::kChar}),
+                columnTypes);
+      // Every cluster stores each of its distinct strings once
+      const auto dictionaryColumnId = descriptorGuard->FindPhysicalColumnId(fieldId, 1, 0);
+      EXPECT_EQ(3u, descriptorGuard->GetClusterDescriptor(0).GetColumnRange(dictionaryColumnId).fNElements);
+      EXPECT_EQ(4u, descriptorGuard->GetClusterDescriptor(1).GetColumnRange(dictionaryColumnId).fNElements);
+   }
+
+   RField<std::string> field("trigger");
+   field.SetOnDiskId(source->GetSharedDescriptorGuard()->FindFieldId("trigger"));
+   ROOT::Experimental::Internal::CallConnectPageSourceOnField(field, *source);
+   EXPECT_TRUE(field.IsDictionaryEncoded());
+
+   auto value = field.CreateValue();
+   for (unsigned i = 0; i < 30; ++i) {
+      value.Read(i);
+      const auto &expected = triggers[i % ((i >= 10 && i < 20) ? 4 : 3)];
+      EXPECT_EQ(expected, value.GetRef<std::string>());
+
+      const auto code = field.GetDictionaryCode(i);
+      EXPECT_EQ(i / 10, code.GetClusterId());
+      EXPECT_EQ(code, field.FindDictionaryCode(code.GetClusterId(), expected));
+      EXPECT_EQ(expected == "HLT_PFJet500", field.FindDictionaryCode(code.GetClusterId(), "HLT_PFJet500") == code);
+   }
+   EXPECT_EQ(ROOT::Experimental::kInvalidClusterIndex, field.FindDictionaryCode(0, "HLT_PFJet500").GetIndex());
+
+   auto reader = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   auto viewTrigger = reader->GetView<std::string>("trigger");
+   EXPECT_EQ("HLT_PFJet500", viewTrigger(13));
+   EXPECT_EQ("", viewTrigger(29));
+
+   auto fldMixed = std::make_unique<RField<std::string>>("mixed");
+   fldMixed->SetColumnRepresentatives({{EColumnType::kDictIndex32, EColumnType::kSplitIndex64, EColumnType::kChar},
+                                       {EColumnType::kSplitIndex64, EColumnType::kChar}});
+   auto model = RNTupleModel::Create();
+   model->AddField(std::move(fldMixed));
+   FileRaii fileGuardMixed("test_ntuple_dictionary_encoded_string_mixed.root");
+   EXPECT_THROW(RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuardMixed.GetPath()), RException);
+}
@@ -131,6 +131,60 @@ TEST(RNTuple, BulkCollectionView)
    }
 }
 
+TEST(RNTuple, ReadBulkView)
+{
+   FileRaii fileGuard("test_ntuple_read_bulk_view.root");
+
+   auto model = RNTupleModel::Create();
+   auto fieldPt = model->MakeField<float>("pt");
+   auto fieldVec = model->MakeField<std::vector<float>>("vec");
+   auto eltsPerPage = 1000;
+   {
+      RNTupleWriteOptions opt;
+      opt.SetMaxUnzippedPageSize(eltsPerPage * sizeof(float));
+      auto writer = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath(), opt);
+      for (int i = 0; i < 10'000; i++) {
+         *fieldPt = i;
+         *fieldVec = std::vector<float>(i % 3, i);
+         writer->Fill();
+      }
+   }
+   auto reader = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   ASSERT_EQ(1U, reader->GetDescriptor().GetNClusters());
+   const auto clusterId = reader->GetDescriptor().FindClusterId(0, 0);
+   auto viewPt = reader->GetView<float>("pt");
+
+   EXPECT_TRUE(viewPt.ReadBulk(RClusterIndex(clusterId, 0), 0).empty());
+
+   // Within a page, the span aliases the page buffer
+   NTupleSize_t nPageItems = 0;
+   const float *pageBuf = viewPt.MapV(RClusterIndex(clusterId, 10), nPageItems);
+   auto span = viewPt.ReadBulk(RClusterIndex(clusterId, 10), 20);
+   ASSERT_EQ(20U, span.size());
+   EXPECT_EQ(pageBuf, span.data());
+   for (std::size_t i = 0; i < span.size(); ++i)
+      EXPECT_FLOAT_EQ(10 + i, span[i]);
+
+   // Across page boundaries, the values are copied into the bulk buffer
+   auto spanCopy = viewPt.ReadBulk(RClusterIndex(clusterId, eltsPerPage - 5), 2 * eltsPerPage);
+   ASSERT_EQ(2U * eltsPerPage, spanCopy.size());
+   for (std::size_t i = 0; i < spanCopy.size(); ++i)
+      EXPECT_FLOAT_EQ(eltsPerPage - 5 + i, spanCopy[i]);
+
+   // Non-mappable types always go through the bulk buffer; the request mask selects the values to be read
+   auto viewVec = reader->GetView<std::vector<float>>("vec");
+   auto vecSpan = viewVec.ReadBulk(RClusterIndex(clusterId, 100), 10);
+   ASSERT_EQ(10U, vecSpan.size());
+   for (std::size_t i = 0; i < vecSpan.size(); ++i)
+      EXPECT_EQ(std::vector<float>((100 + i) % 3, 100 + i), vecSpan[i]);
+
+   bool maskReq[10] = {false, true, false, true, false, true, false, true, false, true};
+   auto vecSpanMasked = viewVec.ReadBulk(RClusterIndex(clusterId, 200), 10, maskReq);
+   ASSERT_EQ(10U, vecSpanMasked.size());
+   for (std::size_t i = 1; i < vecSpanMasked.size(); i += 2)
+      EXPECT_EQ(std::vector<float>((200 + i) % 3, 200 + i), vecSpanMasked[i]);
+}
+
 TEST(RNTuple, Composable)
 {
    FileRaii fileGuard("test_ntuple_composable.root");
@@ -0,0 +1,189 @@
+/// \file ROOT/RNTupleEncodingAdvisor.hxx
+/// \ingroup NTuple ROOT7
+/// \date 2024-11-04
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RNTupleEncodingAdvisor
+#define ROOT7_RNTupleEncodingAdvisor
+
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RNTupleWriteOptions.hxx>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+class RNTuple;
+class RNTupleModel;
+
+namespace Internal {
+class RPageSource;
+} // namespace Internal
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleEncodingAdvisor
+\ingroup NTuple
+\brief Choose the column encodings and the compression of an RNTuple from a sample of its data.
+
+Where the RNTupleInspector reports how an RNTuple is stored, the RNTupleEncodingAdvisor tells how it should be stored.
+It reads the pages of the first entries of an existing RNTuple and re-encodes them, column by column, with every
+alternative column type that the field supports: split and unsplit encodings, 32 and 64 bit offsets for the
+collections and, if the user allows for a precision loss on a field, 32 and 16 bit floating-point numbers,
+`kReal32Trunc` and `kReal32Quant` with the smallest bit width that honours the tolerance. Each encoding is compressed
+with each of the candidate compression settings, and the compressed size as well as the time taken to decompress and
+unpack the pages are measured.
+
+The candidates are ranked by the time it takes to read them, i.e. the compressed size divided by the throughput of
+the storage plus the decompression and unpacking time. As the compression is a property of the whole RNTuple, the
+advice consists of the compression setting with the smallest total read time and of the best encoding of each column
+for that setting. It can be turned into write options and applied to the model used to write the data.
+
+Only the columns of fields with a single column are re-encoded: fundamental types and the offsets of collections.
+The others (strings, booleans, enums...) keep their encoding and only contribute to the choice of the compression.
+
+~~~ {.cpp}
+#include <ROOT/RNTupleEncodingAdvisor.hxx>
+using ROOT::Experimental::RNTupleEncodingAdvisor;
+
+auto advisor = RNTupleEncodingAdvisor::Create("Events", "sample.root");
+RNTupleEncodingAdvisor::ROptions options;
+options.fTolerances["jet_pt"].fRelative = 1e-3; // allow a 0.1% precision loss on the jet pt
+auto advice = advisor->Advise(options);
+advice.Print();
+
+auto model = CreateEventsModel();
+advice.Apply(*model);
+auto writer = RNTupleWriter::Recreate(std::move(model), "Events", "out.root", advice.GetWriteOptions());
+~~~
+*/
+// clang-format on
+class RNTupleEncodingAdvisor {
+public:
+   /// The precision loss allowed on a floating-point field. Without tolerance, only lossless encodings are tried.
+   struct RTolerance {
+      /// Maximum relative error |x' - x| / |x|, allows for 32 bit (for doubles), 16 bit and truncated floats
+      double fRelative = 0;
+      /// Maximum absolute error |x' - x|, allows for floats quantized in [fMin, fMax]. All the values written later
+      /// must be within that range: it should come from the physics, not from the sample.
+      double fAbsolute = 0;
+      double fMin = 0;
+      double fMax = 0;
+   };
+
+   struct ROptions {
+      /// Number of entries read from the beginning of the RNTuple; whole clusters are read
+      std::uint64_t fNSampleEntries = 10000;
+      /// Compression settings to try, as algorithm * 100 + level
+      std::vector<int> fCompressionSettings = {0, 404, 505, 207};
+      /// Throughput of the storage the data is read from, in bytes per second. Zero means that only the size matters.
+      double fReadThroughput = 100e6;
+      /// Number of times decompression and unpacking are timed, the fastest time being kept
+      unsigned int fNRepetitions = 3;
+      /// Tolerances of the floating-point fields, by qualified field name
+      std::unordered_map<std::string, RTolerance> fTolerances;
+   };
+
+   /// An encoding of a column measured on the sample
+   struct RCandidate {
+      EColumnType fType = EColumnType::kUnknown;
+      std::uint16_t fBitsOnStorage = 0;
+      /// Only used by kReal32Quant
+      double fMin = 0;
+      double fMax = 0;
+      /// Compressed size of the sample, in bytes, for each compression setting of the options
+      std::vector<std::uint64_t> fCompressedSize;
+      /// Time to decompress the sample, in seconds, for each compression setting of the options
+      std::vector<double> fUnzipTime;
+      /// Time to unpack the sample from its on-disk representation, in seconds
+      double fUnpackTime = 0;
+   };
+
+   /// The encodings of a column, the first one being the current encoding
+   struct RColumnAdvice {
+      std::string fFieldName;
+      DescriptorId_t fPhysicalColumnId = kInvalidDescriptorId;
+      std::uint64_t fNElements = 0;
+      /// Size in memory of the sample
+      std::uint64_t fUncompressedSize = 0;
+      /// Whether the column can be re-encoded. If not, fCandidates only contains the current encoding.
+      bool fCanReencode = false;
+      std::vector<RCandidate> fCandidates;
+      /// Index in fCandidates of the encoding to use with the advised compression
+      std::size_t fBest = 0;
+   };
+
+   class RAdvice {
+      friend class RNTupleEncodingAdvisor;
+
+      std::vector<int> fCompressionSettings;
+      double fReadThroughput = 0;
+      int fCompression = 0;
+      int fCurrentCompression = 0;
+      std::vector<RColumnAdvice> fColumns;
+
+   public:
+      /// The compression setting with the smallest read time
+      int GetCompression() const { return fCompression; }
+      const std::vector<RColumnAdvice> &GetColumns() const { return fColumns; }
+      /// Read time of a candidate for the given index in the compression settings of the options
+      double GetReadTime(const RCandidate &candidate, std::size_t compressionIdx) const;
+      /// Compressed size and read time of the sample with the advised and with the current setup
+      std::uint64_t GetCompressedSize() const;
+      std::uint64_t GetCurrentCompressedSize() const;
+      double GetReadTime() const;
+      double GetCurrentReadTime() const;
+
+      /// Write options with the advised compression
+      RNTupleWriteOptions GetWriteOptions(const RNTupleWriteOptions &options = RNTupleWriteOptions()) const;
+      /// Set the advised column representatives of the fields of a model that is not frozen. Fields that are not
+      /// in the model are ignored.
+      void Apply(RNTupleModel &model) const;
+      void Print(std::ostream &output = std::cout) const;
+   };
+
+private:
+   std::unique_ptr<Internal::RPageSource> fPageSource;
+   std::unique_ptr<RNTupleDescriptor> fDescriptor;
+
+   RNTupleEncodingAdvisor(std::unique_ptr<Internal::RPageSource> pageSource);
+
+public:
+   RNTupleEncodingAdvisor(const RNTupleEncodingAdvisor &other) = delete;
+   RNTupleEncodingAdvisor &operator=(const RNTupleEncodingAdvisor &other) = delete;
+   RNTupleEncodingAdvisor(RNTupleEncodingAdvisor &&other) = delete;
+   RNTupleEncodingAdvisor &operator=(RNTupleEncodingAdvisor &&other) = delete;
+   ~RNTupleEncodingAdvisor();
+
+   static std::unique_ptr<RNTupleEncodingAdvisor> Create(const RNTuple &sourceNTuple);
+   static std::unique_ptr<RNTupleEncodingAdvisor> Create(std::string_view ntupleName, std::string_view storage);
+
+   const RNTupleDescriptor *GetDescriptor() const { return fDescriptor.get(); }
+
+   /// Read the sample and measure the candidate encodings and compression settings. Throws an RException if a
+   /// tolerance is given for a field that does not exist or is not a floating-point field.
+   RAdvice Advise(const ROptions &options) const;
+   RAdvice Advise() const { return Advise(ROptions()); }
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
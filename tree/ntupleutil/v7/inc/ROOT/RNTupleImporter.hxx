@@ -251,6 +251,13 @@ private:
    RResult<void> PrepareSchema();
    void ReportSchema();
 
+   /// Whether Import() can read and write the entries concurrently; requires implicit multi-threading
+   bool CanImportParallel(std::int64_t nEntries) const;
+   /// Imports chunks of clusters of the input tree in parallel tasks, each with its own copy of the input tree and
+   /// its own fill context of an RNTupleParallelWriter. The clusters of the contexts are committed in the order of
+   /// the input entries.
+   void ImportParallel(std::int64_t nEntries);
+
 public:
    RNTupleImporter(const RNTupleImporter &other) = delete;
    RNTupleImporter &operator=(const RNTupleImporter &other) = delete;
@@ -286,6 +293,11 @@ public:
    ///    fields and the model
    /// 2. An event loop reads every entry from the TTree, applies transformations where necessary, and writes the
    ///    output entry to the RNTuple.
+   ///
+   /// If implicit multi-threading is enabled, the clusters of the input tree are imported concurrently: the input
+   /// tree needs to be a plain tree read from a file, without leaf count arrays, and the write options need to use
+   /// buffered writing. Otherwise the entries are imported sequentially. In either case, the order of the entries
+   /// is preserved. The parallel import reports the progress only once it is done.
    void Import();
 }; // class RNTupleImporter
 
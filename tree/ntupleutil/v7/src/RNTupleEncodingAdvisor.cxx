@@ -0,0 +1,593 @@
+/// \file RNTupleEncodingAdvisor.cxx
+/// \ingroup NTuple ROOT7
+/// \date 2024-11-04
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RColumnElementBase.hxx>
+#include <ROOT/RError.hxx>
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTupleEncodingAdvisor.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleZip.hxx>
+#include <ROOT/RPageStorageFile.hxx>
+
+#include <Compression.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+
+namespace {
+
+using ROOT::Experimental::DescriptorId_t;
+using ROOT::Experimental::EColumnType;
+using ROOT::Experimental::RNTupleEncodingAdvisor;
+using ROOT::Experimental::Internal::EColumnCppType;
+using ROOT::Experimental::Internal::RColumnElementBase;
+
+/// The in-memory type of the values of a column, and the encodings that can represent it
+struct RColumnFamily {
+   EColumnCppType fCppType = EColumnCppType::kChar;
+   bool fIsReal = false;
+   bool fIsDouble = false;
+   std::vector<EColumnType> fLossless;
+   /// Only tried with a relative tolerance; kReal32Trunc is handled separately
+   std::vector<EColumnType> fLossy;
+};
+
+bool IsIndexType(EColumnType type)
+{
+   return type == EColumnType::kIndex64 || type == EColumnType::kIndex32 || type == EColumnType::kSplitIndex64 ||
+          type == EColumnType::kSplitIndex32;
+}
+
+/// Returns false if the column of the given field cannot be re-encoded
+bool GetColumnFamily(const std::string &typeName, EColumnType onDiskType, RColumnFamily &family)
+{
+   if (IsIndexType(onDiskType)) {
+      family.fCppType = EColumnCppType::kClusterSize;
+      family.fLossless = {EColumnType::kSplitIndex64, EColumnType::kIndex64, EColumnType::kSplitIndex32,
+                          EColumnType::kIndex32};
+      return true;
+   }
+   if (typeName == "float") {
+      family.fCppType = EColumnCppType::kFloat;
+      family.fIsReal = true;
+      family.fLossless = {EColumnType::kSplitReal32, EColumnType::kReal32};
+      family.fLossy = {EColumnType::kReal16};
+      return true;
+   }
+   if (typeName == "double") {
+      family.fCppType = EColumnCppType::kDouble;
+      family.fIsReal = true;
+      family.fIsDouble = true;
+      family.fLossless = {EColumnType::kSplitReal64, EColumnType::kReal64};
+      family.fLossy = {EColumnType::kSplitReal32, EColumnType::kReal32, EColumnType::kReal16};
+      return true;
+   }
+
+   static const std::vector<std::tuple<std::string, EColumnCppType, EColumnType, EColumnType>> integers = {
+      {"std::int8_t", EColumnCppType::kInt8, EColumnType::kInt8, EColumnType::kInt8},
+      {"std::uint8_t", EColumnCppType::kUint8, EColumnType::kUInt8, EColumnType::kUInt8},
+      {"std::int16_t", EColumnCppType::kInt16, EColumnType::kSplitInt16, EColumnType::kInt16},
+      {"std::uint16_t", EColumnCppType::kUint16, EColumnType::kSplitUInt16, EColumnType::kUInt16},
+      {"std::int32_t", EColumnCppType::kInt32, EColumnType::kSplitInt32, EColumnType::kInt32},
+      {"std::uint32_t", EColumnCppType::kUint32, EColumnType::kSplitUInt32, EColumnType::kUInt32},
+      {"std::int64_t", EColumnCppType::kInt64, EColumnType::kSplitInt64, EColumnType::kInt64},
+      {"std::uint64_t", EColumnCppType::kUint64, EColumnType::kSplitUInt64, EColumnType::kUInt64}};
+   for (const auto &[name, cppType, split, unsplit] : integers) {
+      if (typeName != name)
+         continue;
+      family.fCppType = cppType;
+      family.fLossless = {split};
+      if (unsplit != split)
+         family.fLossless.push_back(unsplit);
+      return true;
+   }
+   return false;
+}
+
+std::unique_ptr<RColumnElementBase>
+MakeElement(const RColumnFamily *family, EColumnType type, std::uint16_t bits, double min, double max)
+{
+   auto element = family ? ROOT::Experimental::Internal::GenerateColumnElement(family->fCppType, type)
+                         : RColumnElementBase::Generate(type);
+   if (type == EColumnType::kReal32Trunc || type == EColumnType::kReal32Quant)
+      element->SetBitsOnStorage(bits);
+   if (type == EColumnType::kReal32Quant)
+      element->SetValueRange(min, max);
+   return element;
+}
+
+/// The sample of a column: its pages, packed as on disk and unpacked in memory
+struct RColumnSample {
+   std::vector<std::uint32_t> fNElements;
+   std::vector<std::vector<unsigned char>> fPacked;
+   std::vector<std::vector<unsigned char>> fUnpacked;
+};
+
+template <typename T>
+bool IsWithinTolerance(const RColumnSample &sample, const std::vector<std::vector<unsigned char>> &roundTrip,
+                       const RNTupleEncodingAdvisor::RTolerance &tolerance, bool quantized)
+{
+   for (std::size_t p = 0; p < sample.fUnpacked.size(); ++p) {
+      auto values = reinterpret_cast<const T *>(sample.fUnpacked[p].data());
+      auto result = reinterpret_cast<const T *>(roundTrip[p].data());
+      for (std::uint32_t i = 0; i < sample.fNElements[p]; ++i) {
+         const double x = values[i];
+         const double y = result[i];
+         if (quantized) {
+            if (!(x >= tolerance.fMin && x <= tolerance.fMax) || std::abs(y - x) > tolerance.fAbsolute)
+               return false;
+         } else if (std::isnan(x) || std::isinf(x)) {
+            if (std::isnan(x) != std::isnan(y) || (std::isinf(x) && x != y))
+               return false;
+         } else if (!(std::abs(y - x) <= tolerance.fRelative * std::abs(x))) {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+/// Whether the sample survives packing with the given element within the tolerance
+bool IsWithinTolerance(const RColumnSample &sample, const RColumnFamily &family, const RColumnElementBase &element,
+                       const RNTupleEncodingAdvisor::RTolerance &tolerance, bool quantized)
+{
+   std::vector<std::vector<unsigned char>> roundTrip(sample.fUnpacked.size());
+   std::vector<unsigned char> packed;
+   for (std::size_t p = 0; p < sample.fUnpacked.size(); ++p) {
+      const auto n = sample.fNElements[p];
+      packed.resize(element.GetPackedSize(n));
+      roundTrip[p].resize(sample.fUnpacked[p].size());
+      try {
+         element.Pack(packed.data(), sample.fUnpacked[p].data(), n);
+      } catch (const ROOT::Experimental::RException &) {
+         // e.g. a value outside of the quantization range
+         return false;
+      }
+      element.Unpack(roundTrip[p].data(), packed.data(), n);
+   }
+   return family.fIsDouble ? IsWithinTolerance<double>(sample, roundTrip, tolerance, quantized)
+                           : IsWithinTolerance<float>(sample, roundTrip, tolerance, quantized);
+}
+
+double Seconds(std::chrono::steady_clock::duration d)
+{
+   return std::chrono::duration<double>(d).count();
+}
+
+/// Fill the compressed sizes and the timings of a candidate
+void Measure(const std::vector<std::vector<unsigned char>> &packedPages, const std::vector<std::uint32_t> &nElements,
+             const RColumnElementBase &element, const RNTupleEncodingAdvisor::ROptions &options,
+             const std::vector<int> &compressionSettings, RNTupleEncodingAdvisor::RCandidate &candidate)
+{
+   using ROOT::Experimental::Internal::RNTupleCompressor;
+   using ROOT::Experimental::Internal::RNTupleDecompressor;
+   using Clock_t = std::chrono::steady_clock;
+
+   std::size_t maxPacked = 0;
+   std::size_t maxUnpacked = 0;
+   for (std::size_t p = 0; p < packedPages.size(); ++p) {
+      maxPacked = std::max(maxPacked, packedPages[p].size());
+      maxUnpacked = std::max(maxUnpacked, element.GetSize() * nElements[p]);
+   }
+   std::vector<unsigned char> target(std::max(maxPacked, maxUnpacked));
+   const unsigned int nRepetitions = std::max(1u, options.fNRepetitions);
+
+   candidate.fUnpackTime = std::numeric_limits<double>::max();
+   for (unsigned int r = 0; r < nRepetitions; ++r) {
+      const auto start = Clock_t::now();
+      for (std::size_t p = 0; p < packedPages.size(); ++p)
+         element.Unpack(target.data(), packedPages[p].data(), nElements[p]);
+      candidate.fUnpackTime = std::min(candidate.fUnpackTime, Seconds(Clock_t::now() - start));
+   }
+
+   std::vector<std::vector<unsigned char>> zipped(packedPages.size());
+   for (auto compression : compressionSettings) {
+      std::uint64_t size = 0;
+      for (std::size_t p = 0; p < packedPages.size(); ++p) {
+         zipped[p].resize(packedPages[p].size());
+         if (packedPages[p].empty())
+            continue;
+         zipped[p].resize(
+            RNTupleCompressor::Zip(packedPages[p].data(), packedPages[p].size(), compression, zipped[p].data()));
+         size += zipped[p].size();
+      }
+      candidate.fCompressedSize.push_back(size);
+
+      double unzipTime = std::numeric_limits<double>::max();
+      for (unsigned int r = 0; r < nRepetitions; ++r) {
+         const auto start = Clock_t::now();
+         for (std::size_t p = 0; p < packedPages.size(); ++p) {
+            if (zipped[p].size() != packedPages[p].size())
+               RNTupleDecompressor::Unzip(zipped[p].data(), zipped[p].size(), packedPages[p].size(), target.data());
+         }
+         unzipTime = std::min(unzipTime, Seconds(Clock_t::now() - start));
+      }
+      candidate.fUnzipTime.push_back(unzipTime);
+   }
+}
+
+std::string GetEncodingAsString(const RNTupleEncodingAdvisor::RCandidate &candidate)
+{
+   auto result = RColumnElementBase::GetTypeName(candidate.fType);
+   if (candidate.fType == EColumnType::kReal32Trunc || candidate.fType == EColumnType::kReal32Quant)
+      result += "(" + std::to_string(candidate.fBitsOnStorage) + ")";
+   return result;
+}
+
+} // anonymous namespace
+
+ROOT::Experimental::RNTupleEncodingAdvisor::RNTupleEncodingAdvisor(std::unique_ptr<Internal::RPageSource> pageSource)
+   : fPageSource(std::move(pageSource))
+{
+   fPageSource->Attach();
+   auto descriptorGuard = fPageSource->GetSharedDescriptorGuard();
+   fDescriptor = descriptorGuard->Clone();
+}
+
+// NOTE: outlined to avoid including RPageStorage in the header
+ROOT::Experimental::RNTupleEncodingAdvisor::~RNTupleEncodingAdvisor() = default;
+
+std::unique_ptr<ROOT::Experimental::RNTupleEncodingAdvisor>
+ROOT::Experimental::RNTupleEncodingAdvisor::Create(const RNTuple &sourceNTuple)
+{
+   auto pageSource = Internal::RPageSourceFile::CreateFromAnchor(sourceNTuple);
+   return std::unique_ptr<RNTupleEncodingAdvisor>(new RNTupleEncodingAdvisor(std::move(pageSource)));
+}
+
+std::unique_ptr<ROOT::Experimental::RNTupleEncodingAdvisor>
+ROOT::Experimental::RNTupleEncodingAdvisor::Create(std::string_view ntupleName, std::string_view storage)
+{
+   auto pageSource = Internal::RPageSource::Create(ntupleName, storage);
+   return std::unique_ptr<RNTupleEncodingAdvisor>(new RNTupleEncodingAdvisor(std::move(pageSource)));
+}
+
+ROOT::Experimental::RNTupleEncodingAdvisor::RAdvice
+ROOT::Experimental::RNTupleEncodingAdvisor::Advise(const ROptions &options) const
+{
+   RAdvice advice;
+   advice.fReadThroughput = options.fReadThroughput;
+
+   std::unordered_map<std::string, DescriptorId_t> fieldIds;
+   for (const auto &fieldDesc : fDescriptor->GetFieldIterable(fDescriptor->GetFieldZeroId())) {
+      std::vector<DescriptorId_t> fieldQueue{fieldDesc.GetId()};
+      while (!fieldQueue.empty()) {
+         const auto fieldId = fieldQueue.back();
+         fieldQueue.pop_back();
+         fieldIds[fDescriptor->GetQualifiedFieldName(fieldId)] = fieldId;
+         for (const auto &subField : fDescriptor->GetFieldIterable(fieldId))
+            fieldQueue.push_back(subField.GetId());
+      }
+   }
+   for (const auto &[name, tolerance] : options.fTolerances) {
+      auto itr = fieldIds.find(name);
+      if (itr == fieldIds.end())
+         throw RException(R__FAIL("no field named '" + name + "' in RNTuple '" + fDescriptor->GetName() + "'"));
+      const auto &typeName = fDescriptor->GetFieldDescriptor(itr->second).GetTypeName();
+      if (typeName != "float" && typeName != "double")
+         throw RException(R__FAIL("tolerance given for field '" + name + "' of non floating-point type " + typeName));
+      if (tolerance.fAbsolute > 0 && !(tolerance.fMin < tolerance.fMax))
+         throw RException(R__FAIL("quantization range of field '" + name + "' is empty"));
+   }
+
+   // The current compression is always measured, to compare with
+   advice.fCurrentCompression = kUnknownCompressionSettings;
+   for (const auto &clusterDesc : fDescriptor->GetClusterIterable()) {
+      for (const auto &columnRange : clusterDesc.GetColumnRangeIterable()) {
+         if (columnRange.fCompressionSettings != kUnknownCompressionSettings) {
+            advice.fCurrentCompression = columnRange.fCompressionSettings;
+            break;
+         }
+      }
+      if (advice.fCurrentCompression != kUnknownCompressionSettings)
+         break;
+   }
+   advice.fCompressionSettings = options.fCompressionSettings;
+   if (advice.fCurrentCompression != kUnknownCompressionSettings &&
+       std::find(advice.fCompressionSettings.begin(), advice.fCompressionSettings.end(),
+                 advice.fCurrentCompression) == advice.fCompressionSettings.end()) {
+      advice.fCompressionSettings.push_back(advice.fCurrentCompression);
+   }
+   if (advice.fCompressionSettings.empty())
+      throw RException(R__FAIL("no compression setting to try"));
+
+   std::vector<DescriptorId_t> sampleClusters;
+   for (const auto &clusterDesc : fDescriptor->GetClusterIterable()) {
+      if (clusterDesc.GetFirstEntryIndex() < options.fNSampleEntries)
+         sampleClusters.push_back(clusterDesc.GetId());
+   }
+
+   std::vector<unsigned char> sealedBuffer;
+   for (const auto &colDesc : fDescriptor->GetColumnIterable()) {
+      if (colDesc.IsAliasColumn())
+         continue;
+      const auto colId = colDesc.GetPhysicalId();
+      const auto &fieldDesc = fDescriptor->GetFieldDescriptor(colDesc.GetFieldId());
+
+      RColumnAdvice column;
+      column.fFieldName = fDescriptor->GetQualifiedFieldName(fieldDesc.GetId());
+      column.fPhysicalColumnId = colId;
+
+      std::size_t nColumns = 0;
+      for (const auto &c : fDescriptor->GetColumnIterable(fieldDesc.GetId())) {
+         (void)c;
+         ++nColumns;
+      }
+      RColumnFamily family;
+      column.fCanReencode = (nColumns == 1) && GetColumnFamily(fieldDesc.GetTypeName(), colDesc.GetType(), family);
+
+      RCandidate current;
+      current.fType = colDesc.GetType();
+      current.fBitsOnStorage = colDesc.GetBitsOnStorage();
+      if (auto range = colDesc.GetValueRange()) {
+         current.fMin = range->fMin;
+         current.fMax = range->fMax;
+      }
+      auto currentElement = MakeElement(column.fCanReencode ? &family : nullptr, current.fType,
+                                        current.fBitsOnStorage, current.fMin, current.fMax);
+
+      RColumnSample sample;
+      for (auto clusterId : sampleClusters) {
+         const auto &clusterDesc = fDescriptor->GetClusterDescriptor(clusterId);
+         if (!clusterDesc.ContainsColumn(colId) || clusterDesc.GetColumnRange(colId).fIsSuppressed)
+            continue;
+         ClusterSize_t::ValueType firstInPage = 0;
+         for (const auto &pageInfo : clusterDesc.GetPageRange(colId).fPageInfos) {
+            Internal::RPageStorage::RSealedPage sealedPage;
+            fPageSource->LoadSealedPage(colId, RClusterIndex(clusterId, firstInPage), sealedPage);
+            sealedBuffer.resize(sealedPage.GetBufferSize());
+            sealedPage.SetBuffer(sealedBuffer.data());
+            fPageSource->LoadSealedPage(colId, RClusterIndex(clusterId, firstInPage), sealedPage);
+            firstInPage += pageInfo.fNElements;
+
+            const auto n = sealedPage.GetNElements();
+            std::vector<unsigned char> packed(currentElement->GetPackedSize(n));
+            if (sealedPage.GetDataSize() != packed.size()) {
+               Internal::RNTupleDecompressor::Unzip(sealedPage.GetBuffer(), sealedPage.GetDataSize(), packed.size(),
+                                                    packed.data());
+            } else {
+               std::memcpy(packed.data(), sealedPage.GetBuffer(), packed.size());
+            }
+            if (column.fCanReencode) {
+               std::vector<unsigned char> unpacked(currentElement->GetSize() * n);
+               currentElement->Unpack(unpacked.data(), packed.data(), n);
+               sample.fUnpacked.emplace_back(std::move(unpacked));
+            }
+            sample.fNElements.push_back(n);
+            sample.fPacked.emplace_back(std::move(packed));
+            column.fNElements += n;
+         }
+      }
+      column.fUncompressedSize = column.fNElements * currentElement->GetSize();
+
+      Measure(sample.fPacked, sample.fNElements, *currentElement, options, advice.fCompressionSettings, current);
+      column.fCandidates.emplace_back(std::move(current));
+
+      if (column.fCanReencode) {
+         auto isCurrent = [&column](EColumnType type, std::uint16_t bits) {
+            const auto &c = column.fCandidates[0];
+            return c.fType == type && (c.fBitsOnStorage == bits || bits == 0);
+         };
+         auto addCandidate = [&](EColumnType type, double min, double max, const RColumnElementBase &element) {
+            RCandidate candidate;
+            candidate.fType = type;
+            candidate.fBitsOnStorage = element.GetBitsOnStorage();
+            candidate.fMin = min;
+            candidate.fMax = max;
+            std::vector<std::vector<unsigned char>> packedPages(sample.fUnpacked.size());
+            for (std::size_t p = 0; p < sample.fUnpacked.size(); ++p) {
+               packedPages[p].resize(element.GetPackedSize(sample.fNElements[p]));
+               element.Pack(packedPages[p].data(), sample.fUnpacked[p].data(), sample.fNElements[p]);
+            }
+            Measure(packedPages, sample.fNElements, element, options, advice.fCompressionSettings, candidate);
+            column.fCandidates.emplace_back(std::move(candidate));
+         };
+
+         for (auto type : family.fLossless) {
+            if (isCurrent(type, 0))
+               continue;
+            addCandidate(type, 0, 0, *MakeElement(&family, type, 0, 0, 0));
+         }
+
+         auto itrTolerance = options.fTolerances.find(column.fFieldName);
+         if (family.fIsReal && itrTolerance != options.fTolerances.end()) {
+            const auto &tolerance = itrTolerance->second;
+            if (tolerance.fRelative > 0) {
+               for (auto type : family.fLossy) {
+                  auto element = MakeElement(&family, type, 0, 0, 0);
+                  if (!isCurrent(type, 0) && IsWithinTolerance(sample, family, *element, tolerance, false))
+                     addCandidate(type, 0, 0, *element);
+               }
+               if (!family.fIsDouble) {
+                  const auto [minBits, maxBits] = RColumnElementBase::GetValidBitRange(EColumnType::kReal32Trunc);
+                  for (auto bits = minBits; bits <= maxBits; ++bits) {
+                     auto element = MakeElement(&family, EColumnType::kReal32Trunc, bits, 0, 0);
+                     if (!IsWithinTolerance(sample, family, *element, tolerance, false))
+                        continue;
+                     if (!isCurrent(EColumnType::kReal32Trunc, bits))
+                        addCandidate(EColumnType::kReal32Trunc, 0, 0, *element);
+                     break;
+                  }
+               }
+            }
+            if (tolerance.fAbsolute > 0 && !family.fIsDouble) {
+               const auto [minBits, maxBits] = RColumnElementBase::GetValidBitRange(EColumnType::kReal32Quant);
+               for (auto bits = minBits; bits <= maxBits; ++bits) {
+                  auto element =
+                     MakeElement(&family, EColumnType::kReal32Quant, bits, tolerance.fMin, tolerance.fMax);
+                  if (!IsWithinTolerance(sample, family, *element, tolerance, true))
+                     continue;
+                  if (!isCurrent(EColumnType::kReal32Quant, bits))
+                     addCandidate(EColumnType::kReal32Quant, tolerance.fMin, tolerance.fMax, *element);
+                  break;
+               }
+            }
+         }
+      }
+
+      advice.fColumns.emplace_back(std::move(column));
+   }
+
+   // Pick the compression with the smallest total read time, each column using its best encoding for it
+   auto bestCandidate = [&advice](const RColumnAdvice &column, std::size_t compressionIdx) {
+      std::size_t best = 0;
+      for (std::size_t i = 1; i < column.fCandidates.size(); ++i) {
+         if (advice.GetReadTime(column.fCandidates[i], compressionIdx) <
+             advice.GetReadTime(column.fCandidates[best], compressionIdx))
+            best = i;
+      }
+      return best;
+   };
+   std::size_t bestCompressionIdx = 0;
+   double bestReadTime = std::numeric_limits<double>::max();
+   for (std::size_t k = 0; k < advice.fCompressionSettings.size(); ++k) {
+      double readTime = 0;
+      for (const auto &column : advice.fColumns)
+         readTime += advice.GetReadTime(column.fCandidates[bestCandidate(column, k)], k);
+      if (readTime < bestReadTime) {
+         bestReadTime = readTime;
+         bestCompressionIdx = k;
+      }
+   }
+   advice.fCompression = advice.fCompressionSettings[bestCompressionIdx];
+   for (auto &column : advice.fColumns)
+      column.fBest = bestCandidate(column, bestCompressionIdx);
+
+   return advice;
+}
+
+//------------------------------------------------------------------------------
+
+double ROOT::Experimental::RNTupleEncodingAdvisor::RAdvice::GetReadTime(const RCandidate &candidate,
+                                                                     std::size_t compressionIdx) const
+{
+   // Without storage throughput, the size in bytes is the cost
+   if (fReadThroughput <= 0)
+      return candidate.fCompressedSize[compressionIdx];
+   return candidate.fCompressedSize[compressionIdx] / fReadThroughput + candidate.fUnzipTime[compressionIdx] +
+          candidate.fUnpackTime;
+}
+
+namespace {
+std::size_t GetCompressionIdx(const std::vector<int> &settings, int compression)
+{
+   auto itr = std::find(settings.begin(), settings.end(), compression);
+   return itr == settings.end() ? 0 : std::distance(settings.begin(), itr);
+}
+} // anonymous namespace
+
+std::uint64_t ROOT::Experimental::RNTupleEncodingAdvisor::RAdvice::GetCompressedSize() const
+{
+   const auto k = GetCompressionIdx(fCompressionSettings, fCompression);
+   std::uint64_t size = 0;
+   for (const auto &column : fColumns)
+      size += column.fCandidates[column.fBest].fCompressedSize[k];
+   return size;
+}
+
+std::uint64_t ROOT::Experimental::RNTupleEncodingAdvisor::RAdvice::GetCurrentCompressedSize() const
+{
+   const auto k = GetCompressionIdx(fCompressionSettings, fCurrentCompression);
+   std::uint64_t size = 0;
+   for (const auto &column : fColumns)
+      size += column.fCandidates[0].fCompressedSize[k];
+   return size;
+}
+
+double ROOT::Experimental::RNTupleEncodingAdvisor::RAdvice::GetReadTime() const
+{
+   const auto k = GetCompressionIdx(fCompressionSettings, fCompression);
+   double readTime = 0;
+   for (const auto &column : fColumns)
+      readTime += GetReadTime(column.fCandidates[column.fBest], k);
+   return readTime;
+}
+
+double ROOT::Experimental::RNTupleEncodingAdvisor::RAdvice::GetCurrentReadTime() const
+{
+   const auto k = GetCompressionIdx(fCompressionSettings, fCurrentCompression);
+   double readTime = 0;
+   for (const auto &column : fColumns)
+      readTime += GetReadTime(column.fCandidates[0], k);
+   return readTime;
+}
+
+ROOT::Experimental::RNTupleWriteOptions
+ROOT::Experimental::RNTupleEncodingAdvisor::RAdvice::GetWriteOptions(const RNTupleWriteOptions &options) const
+{
+   auto result = options;
+   result.SetCompression(fCompression);
+   return result;
+}
+
+void ROOT::Experimental::RNTupleEncodingAdvisor::RAdvice::Apply(RNTupleModel &model) const
+{
+   std::unordered_map<std::string, const RCandidate *> encodings;
+   for (const auto &column : fColumns) {
+      if (column.fCanReencode)
+         encodings[column.fFieldName] = &column.fCandidates[column.fBest];
+   }
+
+   for (auto &field : model.GetFieldZero()) {
+      auto itr = encodings.find(field.GetQualifiedFieldName());
+      if (itr == encodings.end())
+         continue;
+      const auto &candidate = *itr->second;
+      if (auto floatField = dynamic_cast<RField<float> *>(&field)) {
+         if (candidate.fType == EColumnType::kReal32Trunc) {
+            floatField->SetTruncated(candidate.fBitsOnStorage);
+            continue;
+         }
+         if (candidate.fType == EColumnType::kReal32Quant) {
+            floatField->SetQuantized(candidate.fMin, candidate.fMax, candidate.fBitsOnStorage);
+            continue;
+         }
+      }
+      field.SetColumnRepresentatives({{candidate.fType}});
+   }
+}
+
+void ROOT::Experimental::RNTupleEncodingAdvisor::RAdvice::Print(std::ostream &output) const
+{
+   const auto kAdvised = GetCompressionIdx(fCompressionSettings, fCompression);
+   const auto kCurrent = GetCompressionIdx(fCompressionSettings, fCurrentCompression);
+
+   auto compressionAsString = [](int compression) {
+      if (compression == kUnknownCompressionSettings)
+         return std::string("unknown");
+      const int algorithm = compression / 100;
+      return RCompressionSetting::AlgorithmToString(static_cast<RCompressionSetting::EAlgorithm::EValues>(algorithm)) +
+             " (level " + std::to_string(compression % 100) + ")";
+   };
+   output << "Current compression: " << compressionAsString(fCurrentCompression) << "\n";
+   output << "Advised compression: " << compressionAsString(fCompression) << "\n";
+   output << "Sample size:         " << GetCurrentCompressedSize() << " -> " << GetCompressedSize() << " bytes\n";
+   output << "Sample read time:    " << GetCurrentReadTime() << " -> " << GetReadTime()
+          << (fReadThroughput > 0 ? " s" : " (bytes)") << "\n\n";
+
+   output << " field                          | current encoding | advised encoding | current bytes | advised bytes\n";
+   output << "--------------------------------|------------------|------------------|---------------|--------------\n";
+   for (const auto &column : fColumns) {
+      const auto &current = column.fCandidates[0];
+      const auto &best = column.fCandidates[column.fBest];
+      output << " " << std::setw(30) << std::left << column.fFieldName << " | " << std::setw(16)
+             << GetEncodingAsString(current) << " | " << std::setw(16)
+             << (column.fCanReencode ? GetEncodingAsString(best) : std::string("-")) << " | " << std::setw(13)
+             << std::right << current.fCompressedSize[kCurrent] << " | " << std::setw(13)
+             << best.fCompressedSize[kAdvised] << "\n";
+   }
+}
@@ -15,7 +15,9 @@
 
 #include <ROOT/RError.hxx>
 #include <ROOT/RField.hxx>
+#include <ROOT/RNTupleFillContext.hxx>
 #include <ROOT/RNTupleImporter.hxx>
+#include <ROOT/RNTupleParallelWriter.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RNTupleWriteOptions.hxx>
 #include <ROOT/RNTupleWriter.hxx>
@@ -23,8 +25,13 @@
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #include <string_view>
+#ifdef R__USE_IMT
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <TBranch.h>
+#include <TBufferFile.h>
 #include <TChain.h>
 #include <TClass.h>
 #include <TDataType.h>
@@ -32,7 +39,10 @@
 #include <TLeafC.h>
 #include <TLeafElement.h>
 #include <TLeafObject.h>
+#include <TMath.h>
+#include <TROOT.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
@@ -67,6 +77,69 @@ public:
    }
 };
 
+#ifdef R__USE_IMT
+/// Reads a branch holding a scalar or a fixed-size array of a fundamental type basket by basket with
+/// TBranch::GetBulkEntries() and copies the values of the requested entry into the import buffer of the branch.
+/// This avoids the per-entry overhead of TBranch::GetEntry().
+class RBulkBranchReader {
+private:
+   TBranch &fBranch;
+   unsigned char *fBuffer;   ///< The destination of SetBranchAddress() for the branch
+   std::size_t fElemSize;    ///< Size of the fundamental type
+   Int_t fLen;               ///< Number of elements per entry
+   TBufferFile fValues{TBuffer::kWrite, 32 * 1024};
+   TBufferFile fOffsets{TBuffer::kWrite, 1024};
+   Long64_t fFirstEntry = 0; ///< First entry of the basket currently held in fValues
+   Long64_t fNEntries = 0;   ///< Number of entries of the basket currently held in fValues
+
+   RBulkBranchReader(TBranch &branch, unsigned char *buffer, std::size_t elemSize, Int_t len)
+      : fBranch(branch), fBuffer(buffer), fElemSize(elemSize), fLen(len)
+   {
+   }
+
+public:
+   /// Returns nullptr if the branch cannot be read in bulk
+   static std::unique_ptr<RBulkBranchReader> Create(TBranch &branch, unsigned char *buffer)
+   {
+      if (branch.IsA() != TBranch::Class() || branch.GetNleaves() != 1)
+         return nullptr;
+      auto leaf = static_cast<TLeaf *>(branch.GetListOfLeaves()->First());
+      // C strings have a variable length and leaf count arrays are imported as collections
+      if (leaf->IsA() == TLeafC::Class() || leaf->GetLeafCount())
+         return nullptr;
+      EDataType type = kOther_t;
+      if (!branch.SupportsVarLengthBulkRead(&type))
+         return nullptr;
+      const std::size_t elemSize = TDataType::GetDataType(type)->Size();
+      if (elemSize != static_cast<std::size_t>(leaf->GetLenType()))
+         return nullptr;
+      return std::unique_ptr<RBulkBranchReader>(new RBulkBranchReader(branch, buffer, elemSize, leaf->GetLenStatic()));
+   }
+
+   /// Returns false if the entry cannot be read in bulk, the caller needs to fall back to TBranch::GetEntry()
+   bool Read(Long64_t entry)
+   {
+      if (entry < fFirstEntry || entry >= fFirstEntry + fNEntries) {
+         fNEntries = 0;
+         const Int_t basket = TMath::BinarySearch(fBranch.GetWriteBasket() + 1, fBranch.GetBasketEntry(), entry);
+         if (basket < 0)
+            return false;
+         fFirstEntry = fBranch.GetBasketEntry()[basket];
+         const Int_t nEntries = fBranch.GetBulkRead().GetBulkEntries(fFirstEntry, fValues, fOffsets);
+         if (nEntries <= 0 || entry >= fFirstEntry + nEntries)
+            return false;
+         fNEntries = nEntries;
+      }
+      const auto offsets = reinterpret_cast<const Int_t *>(fOffsets.GetCurrent());
+      const auto idx = entry - fFirstEntry;
+      if (offsets[idx + 1] - offsets[idx] != fLen)
+         return false;
+      memcpy(fBuffer, fValues.GetCurrent() + offsets[idx] * fElemSize, fLen * fElemSize);
+      return true;
+   }
+};
+#endif
+
 } // anonymous namespace
 
 ROOT::Experimental::RResult<void>
@@ -390,6 +463,21 @@ void ROOT::Experimental::RNTupleImporter::Import()
 
    PrepareSchema();
 
+   fProgressCallback = fIsQuiet ? nullptr : std::make_unique<RDefaultProgressCallback>();
+
+   auto nEntries = fSourceTree->GetEntries();
+
+   if (fMaxEntries >= 0 && fMaxEntries < nEntries) {
+      nEntries = fMaxEntries;
+   }
+
+#ifdef R__USE_IMT
+   if (CanImportParallel(nEntries)) {
+      ImportParallel(nEntries);
+      return;
+   }
+#endif
+
    std::unique_ptr<Internal::RPageSink> sink =
       std::make_unique<Internal::RPageSinkFile>(fNTupleName, *fDestFile, fWriteOptions);
    sink->GetMetrics().Enable();
@@ -403,14 +491,6 @@ void ROOT::Experimental::RNTupleImporter::Import()
    // The guard needs to be destructed before the writer goes out of scope
    RImportGuard importGuard(*this);
 
-   fProgressCallback = fIsQuiet ? nullptr : std::make_unique<RDefaultProgressCallback>();
-
-   auto nEntries = fSourceTree->GetEntries();
-
-   if (fMaxEntries >= 0 && fMaxEntries < nEntries) {
-      nEntries = fMaxEntries;
-   }
-
    for (decltype(nEntries) i = 0; i < nEntries; ++i) {
       fSourceTree->GetEntry(i);
 
@@ -442,3 +522,120 @@ void ROOT::Experimental::RNTupleImporter::Import()
    if (fProgressCallback)
       fProgressCallback->Finish(ctrZippedBytes->GetValueAsInt(), nEntries);
 }
+
+#ifdef R__USE_IMT
+bool ROOT::Experimental::RNTupleImporter::CanImportParallel(std::int64_t nEntries) const
+{
+   if (!ROOT::IsImplicitMTEnabled() || nEntries <= 0)
+      return false;
+   // The fill contexts of the parallel writer buffer their pages
+   if (!fWriteOptions.GetUseBufferedWrite())
+      return false;
+   // Every task opens its own copy of the input tree, which thus needs to be a plain tree read from a file
+   if (fSourceTree->IsA() != TTree::Class() || !fSourceTree->GetDirectory())
+      return false;
+   if (fSourceTree->GetListOfFriends() && fSourceTree->GetListOfFriends()->GetEntries() > 0)
+      return false;
+   auto file = fSourceTree->GetCurrentFile();
+   if (!file || file->IsWritable())
+      return false;
+   // The collection writer of the untyped collections is shared by all the clones of the model
+   return fLeafCountCollections.empty();
+}
+
+void ROOT::Experimental::RNTupleImporter::ImportParallel(std::int64_t nEntries)
+{
+   // Group the clusters of the input tree into chunks, a few per thread, that are imported by independent tasks
+   std::vector<std::pair<Long64_t, Long64_t>> chunks;
+   const Long64_t nEntriesPerChunk = std::max<Long64_t>(1, nEntries / (4 * ROOT::GetThreadPoolSize()));
+   auto clusterIter = fSourceTree->GetClusterIterator(0);
+   Long64_t start;
+   while ((start = clusterIter()) < nEntries) {
+      const Long64_t end = std::min<Long64_t>(clusterIter.GetNextEntry(), nEntries);
+      if (chunks.empty() || chunks.back().second - chunks.back().first >= nEntriesPerChunk)
+         chunks.emplace_back(start, end);
+      else
+         chunks.back().second = end;
+   }
+
+   const std::string sourceFileName = fSourceTree->GetCurrentFile()->GetName();
+   std::string treePath = fSourceTree->GetDirectory()->GetPath();
+   treePath = treePath.substr(treePath.find(":/") + 2);
+   if (!treePath.empty())
+      treePath += "/";
+   treePath += fSourceTree->GetName();
+
+   auto ntplWriter = RNTupleParallelWriter::Append(std::move(fModel), fNTupleName, *fDestFile, fWriteOptions);
+   ntplWriter->EnableMetrics();
+   auto ctrZippedBytes = ntplWriter->GetMetrics().GetCounter("RNTupleParallelWriter.RPageSinkFile.szWritePayload");
+   // The guard needs to be destructed before the writer goes out of scope
+   RImportGuard importGuard(*this);
+   // The fill contexts need to be destructed before the writer goes out of scope
+   std::vector<std::shared_ptr<RNTupleFillContext>> contexts(chunks.size());
+
+   auto fnImportChunk = [&](unsigned int i) {
+      // Every task sets up its own input tree and branch buffers
+      auto importer = std::unique_ptr<RNTupleImporter>(new RNTupleImporter());
+      importer->fSourceFile = std::unique_ptr<TFile>(TFile::Open(sourceFileName.c_str()));
+      if (!importer->fSourceFile || importer->fSourceFile->IsZombie())
+         throw RException(R__FAIL("cannot open source file " + sourceFileName));
+      importer->fSourceTree = importer->fSourceFile->Get<TTree>(treePath.c_str());
+      if (!importer->fSourceTree)
+         throw RException(R__FAIL("cannot read TTree " + treePath + " from " + sourceFileName));
+      importer->fSourceTree->SetImplicitMT(false);
+      importer->fConvertDotsInBranchNames = fConvertDotsInBranchNames;
+      importer->fIsQuiet = true;
+      auto result = importer->PrepareSchema();
+      if (!result)
+         throw RException(R__FORWARD_ERROR(result));
+
+      auto context = ntplWriter->CreateFillContext();
+      // The clusters are committed in the order of the chunks once all the tasks are done
+      context->EnableStagedClusterCommitting();
+      auto entry = context->GetModel().CreateBareEntry();
+      for (const auto &f : importer->fImportFields)
+         entry->BindRawPtr(f.fField->GetFieldName(), f.fFieldBuffer);
+
+      std::vector<TBranch *> branches;
+      std::vector<std::unique_ptr<RBulkBranchReader>> bulkReaders;
+      for (const auto &b : importer->fImportBranches) {
+         branches.emplace_back(importer->fSourceTree->GetBranch(b.fBranchName.c_str()));
+         bulkReaders.emplace_back(RBulkBranchReader::Create(*branches.back(), b.fBranchBuffer.get()));
+      }
+
+      const auto [first, last] = chunks[i];
+      importer->fSourceTree->SetCacheEntryRange(first, last);
+      for (Long64_t e = first; e < last; ++e) {
+         importer->fSourceTree->LoadTree(e);
+         for (std::size_t b = 0; b < branches.size(); ++b) {
+            if (bulkReaders[b] && bulkReaders[b]->Read(e))
+               continue;
+            bulkReaders[b].reset();
+            branches[b]->GetEntry(e);
+         }
+
+         for (auto &t : importer->fImportTransformations) {
+            auto transformResult = t->Transform(importer->fImportBranches[t->fImportBranchIdx],
+                                                importer->fImportFields[t->fImportFieldIdx]);
+            if (!transformResult)
+               throw RException(R__FORWARD_ERROR(transformResult));
+            t->ResetEntry();
+         }
+
+         context->Fill(*entry);
+      }
+      context->FlushCluster();
+      contexts[i] = std::move(context);
+   };
+
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(fnImportChunk, ROOT::TSeqU(chunks.size()));
+
+   for (auto &context : contexts)
+      context->CommitStagedClusters();
+   contexts.clear();
+
+   if (fProgressCallback)
+      fProgressCallback->Finish(ctrZippedBytes->GetValueAsInt(), nEntries);
+}
+#endif
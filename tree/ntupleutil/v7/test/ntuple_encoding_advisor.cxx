@@ -0,0 +1,140 @@
+#include <ROOT/RNTupleEncodingAdvisor.hxx>
+#include <ROOT/RNTupleWriteOptions.hxx>
+
+#include "ntupleutil_test.hxx"
+
+#include <algorithm>
+#include <sstream>
+
+using ROOT::Experimental::EColumnType;
+using ROOT::Experimental::RNTupleEncodingAdvisor;
+using ROOT::Experimental::RNTupleModel;
+using ROOT::Experimental::RNTupleReader;
+using ROOT::Experimental::RNTupleWriteOptions;
+using ROOT::Experimental::RNTupleWriter;
+
+namespace {
+void WriteSample(const std::string &path)
+{
+   auto model = RNTupleModel::Create();
+   auto ptrPt = model->MakeField<float>("pt");
+   auto ptrEnergy = model->MakeField<double>("energy");
+   auto ptrId = model->MakeField<std::int32_t>("id");
+   auto ptrHits = model->MakeField<std::vector<float>>("hits");
+
+   auto writeOptions = RNTupleWriteOptions();
+   writeOptions.SetCompression(505);
+   auto writer = RNTupleWriter::Recreate(std::move(model), "ntuple", path, writeOptions);
+   for (int i = 0; i < 1000; ++i) {
+      *ptrPt = 1.f + 0.25f * (i % 37);
+      *ptrEnergy = 100. + 0.5 * (i % 91);
+      *ptrId = i % 5;
+      ptrHits->assign(i % 4, 0.5f * (i % 11));
+      writer->Fill();
+   }
+}
+} // anonymous namespace
+
+TEST(RNTupleEncodingAdvisor, Advise)
+{
+   FileRaii fileGuard("test_ntuple_encoding_advisor_advise.root");
+   WriteSample(fileGuard.GetPath());
+
+   auto advisor = RNTupleEncodingAdvisor::Create("ntuple", fileGuard.GetPath());
+   EXPECT_EQ(advisor->GetDescriptor()->GetName(), "ntuple");
+
+   RNTupleEncodingAdvisor::ROptions options;
+   options.fCompressionSettings = {0, 404};
+   options.fNRepetitions = 1;
+   options.fTolerances["pt"].fRelative = 1e-3;
+   auto advice = advisor->Advise(options);
+
+   const auto &columns = advice.GetColumns();
+   // pt, energy, id, the offsets of hits and hits._0
+   ASSERT_EQ(5u, columns.size());
+   for (const auto &column : columns) {
+      EXPECT_TRUE(column.fCanReencode) << column.fFieldName;
+      EXPECT_LT(column.fBest, column.fCandidates.size());
+      // The current compression is added to the settings to try
+      for (const auto &candidate : column.fCandidates) {
+         EXPECT_EQ(3u, candidate.fCompressedSize.size());
+         EXPECT_EQ(3u, candidate.fUnzipTime.size());
+      }
+   }
+
+   auto findColumn = [&columns](const std::string &name) {
+      return std::find_if(columns.begin(), columns.end(), [&name](const auto &c) { return c.fFieldName == name; });
+   };
+   auto itrPt = findColumn("pt");
+   ASSERT_NE(columns.end(), itrPt);
+   EXPECT_EQ(1000u, itrPt->fNElements);
+   EXPECT_EQ(EColumnType::kSplitReal32, itrPt->fCandidates[0].fType);
+   // The values are multiples of 1/4 below 10, they survive a truncation to a few mantissa bits
+   auto itrTrunc = std::find_if(itrPt->fCandidates.begin(), itrPt->fCandidates.end(),
+                                [](const auto &c) { return c.fType == EColumnType::kReal32Trunc; });
+   ASSERT_NE(itrPt->fCandidates.end(), itrTrunc);
+   EXPECT_LT(itrTrunc->fBitsOnStorage, 32);
+
+   // Without tolerance, only lossless encodings are tried
+   auto itrEnergy = findColumn("energy");
+   ASSERT_NE(columns.end(), itrEnergy);
+   for (const auto &candidate : itrEnergy->fCandidates) {
+      EXPECT_TRUE(candidate.fType == EColumnType::kSplitReal64 || candidate.fType == EColumnType::kReal64);
+   }
+   auto itrHits = findColumn("hits");
+   ASSERT_NE(columns.end(), itrHits);
+   EXPECT_EQ(4u, itrHits->fCandidates.size());
+
+   EXPECT_LE(advice.GetReadTime(), advice.GetCurrentReadTime());
+   EXPECT_EQ(advice.GetCompression(), advice.GetWriteOptions().GetCompression());
+
+   std::ostringstream os;
+   advice.Print(os);
+   EXPECT_NE(std::string::npos, os.str().find("hits"));
+
+   options.fTolerances["id"].fRelative = 1e-3;
+   EXPECT_THROW(advisor->Advise(options), ROOT::Experimental::RException);
+   options.fTolerances.erase("id");
+   options.fTolerances["nonexistent"].fRelative = 1e-3;
+   EXPECT_THROW(advisor->Advise(options), ROOT::Experimental::RException);
+}
+
+TEST(RNTupleEncodingAdvisor, Apply)
+{
+   FileRaii fileGuard("test_ntuple_encoding_advisor_apply.root");
+   WriteSample(fileGuard.GetPath());
+
+   RNTupleEncodingAdvisor::ROptions options;
+   options.fCompressionSettings = {0};
+   options.fReadThroughput = 0;
+   options.fNRepetitions = 1;
+   options.fTolerances["pt"].fAbsolute = 0.01;
+   options.fTolerances["pt"].fMin = 0;
+   options.fTolerances["pt"].fMax = 20;
+   auto advice = RNTupleEncodingAdvisor::Create("ntuple", fileGuard.GetPath())->Advise(options);
+
+   FileRaii fileGuardOut("test_ntuple_encoding_advisor_apply_out.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto ptrPt = model->MakeField<float>("pt");
+      auto ptrHits = model->MakeField<std::vector<float>>("hits");
+      advice.Apply(*model);
+      auto writer =
+         RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuardOut.GetPath(), advice.GetWriteOptions());
+      *ptrPt = 2.5f;
+      ptrHits->assign(3, 1.f);
+      writer->Fill();
+   }
+
+   const auto &columns = advice.GetColumns();
+   auto itrPt = std::find_if(columns.begin(), columns.end(), [](const auto &c) { return c.fFieldName == "pt"; });
+   ASSERT_NE(columns.end(), itrPt);
+   const auto &best = itrPt->fCandidates[itrPt->fBest];
+
+   auto reader = RNTupleReader::Open("ntuple", fileGuardOut.GetPath());
+   const auto &desc = reader->GetDescriptor();
+   const auto &columnDesc = desc.GetColumnDescriptor(desc.FindPhysicalColumnId(desc.FindFieldId("pt"), 0, 0));
+   EXPECT_EQ(best.fType, columnDesc.GetType());
+   auto viewPt = reader->GetView<float>("pt");
+   EXPECT_NEAR(2.5f, viewPt(0), 0.01);
+}
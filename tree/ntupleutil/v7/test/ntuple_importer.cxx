@@ -1,6 +1,7 @@
 #include <ROOT/RNTupleImporter.hxx>
 
 #include <TFile.h>
+#include <TROOT.h>
 #include <TTree.h>
 #include <TChain.h>
 
@@ -707,3 +708,66 @@ TEST(RNTUpleImporter, MaxEntries)
    reader = RNTupleReader::Open("ntuple4", fileGuard.GetPath());
    EXPECT_EQ(5U, reader->GetNEntries());
 }
+
+TEST(RNTupleImporter, ImplicitMT)
+{
+   FileRaii treeFileGuard("test_ntuple_importer_imt_tree.root");
+   {
+      std::unique_ptr<TFile> file(TFile::Open(treeFileGuard.GetPath().c_str(), "RECREATE"));
+      auto tree = std::make_unique<TTree>("tree", "");
+      tree->SetAutoFlush(1000);
+      Int_t a = 0;
+      Float_t b[2] = {0, 0};
+      char c[16];
+      std::vector<double> *vec = new std::vector<double>;
+      struct {
+         Int_t a = 0;
+         Int_t b = 0;
+      } leafList;
+      tree->Branch("a", &a);
+      tree->Branch("b", b, "b[2]/F");
+      tree->Branch("c", c, "c/C");
+      tree->Branch("vec", &vec);
+      tree->Branch("branch", &leafList, "a/I:b/I");
+      for (Int_t i = 0; i < 20000; ++i) {
+         a = i;
+         b[0] = i * 0.5f;
+         b[1] = -i;
+         snprintf(c, sizeof(c), "%d", i);
+         vec->assign(i % 4, 0.25 * i);
+         leafList.a = i;
+         leafList.b = 2 * i;
+         tree->Fill();
+      }
+      tree->Write();
+      delete vec;
+   }
+
+   FileRaii fileGuard("test_ntuple_importer_imt.root");
+   ROOT::EnableImplicitMT(4);
+   auto importer = RNTupleImporter::Create(treeFileGuard.GetPath(), "tree", fileGuard.GetPath());
+   importer->SetIsQuiet(true);
+   importer->SetMaxEntries(19500);
+   importer->Import();
+   ROOT::DisableImplicitMT();
+
+   auto reader = RNTupleReader::Open("tree", fileGuard.GetPath());
+   EXPECT_EQ(19500U, reader->GetNEntries());
+   auto viewA = reader->GetView<std::int32_t>("a");
+   auto viewB = reader->GetView<std::array<float, 2>>("b");
+   auto viewC = reader->GetView<std::string>("c");
+   auto viewVec = reader->GetView<std::vector<double>>("vec");
+   auto viewBranchA = reader->GetView<std::int32_t>("branch.a");
+   auto viewBranchB = reader->GetView<std::int32_t>("branch.b");
+   for (std::int32_t i = 0; i < 19500; ++i) {
+      ASSERT_EQ(i, viewA(i));
+      EXPECT_FLOAT_EQ(i * 0.5f, viewB(i)[0]);
+      EXPECT_FLOAT_EQ(-i, viewB(i)[1]);
+      EXPECT_EQ(std::to_string(i), viewC(i));
+      ASSERT_EQ(static_cast<std::size_t>(i % 4), viewVec(i).size());
+      for (auto v : viewVec(i))
+         EXPECT_DOUBLE_EQ(0.25 * i, v);
+      EXPECT_EQ(i, viewBranchA(i));
+      EXPECT_EQ(2 * i, viewBranchB(i));
+   }
+}
@@ -13,12 +13,27 @@
 
 #include <TFile.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <regex>
 
+namespace ROOT {
+namespace Experimental {
+class RNTupleReader;
+}
+} // namespace ROOT
+
 namespace ReadSpeed {
 
+struct EntryRange {
+   Long64_t fStart = -1;
+   Long64_t fEnd = -1;
+};
+
+/// Whether clusters are prefetched: TTree::SetClusterPrefetch() for TTrees, the cluster cache for RNTuples.
+enum class EClusterPrefetch { kDefault, kOff, kOn };
+
 struct Data {
    /// Either a single tree name common for all files, or one tree name per file.
    std::vector<std::string> fTreeNames;
@@ -28,6 +43,15 @@ struct Data {
    std::vector<std::string> fBranchNames;
    /// If the branch names should use regex matching.
    bool fUseRegex = false;
+   /// If the datasets are RNTuples: fTreeNames then holds the ntuple names and fBranchNames the top-level field names.
+   bool fIsRNTuple = false;
+   /// Size of the TTreeCache in bytes, -1 to keep the default. Ignored for RNTuples.
+   Long64_t fCacheSize = -1;
+   /// Cluster prefetching setting.
+   EClusterPrefetch fClusterPrefetch = EClusterPrefetch::kDefault;
+   /// Entry ranges to read, one vector per file, e.g. replaying the tasks of a recorded job. All entries are read if
+   /// empty.
+   std::vector<std::vector<EntryRange>> fEntryRanges;
 };
 
 struct Result {
@@ -45,16 +69,33 @@ struct Result {
    ULong64_t fCompressedBytesRead;
    /// Size of ROOT's thread pool for the run (0 indicates a single-thread run with no thread pool present).
    unsigned int fThreadPoolSize;
-};
-
-struct EntryRange {
-   Long64_t fStart = -1;
-   Long64_t fEnd = -1;
+   /// Time spent reading from storage, in seconds, summed over all threads. Negative if not measured.
+   double fReadTime = -1.;
+   /// Time spent decompressing baskets, or unsealing (decompressing and unpacking) pages, in seconds, summed over
+   /// all threads. Negative if not measured.
+   double fUnzipTime = -1.;
+   /// Remaining real time, spent deserializing the values. Only measured for single-thread runs, negative otherwise.
+   double fDeserializeTime = -1.;
+   /// TTreeCache size of the run, -1 for the default.
+   Long64_t fCacheSize = -1;
+   /// Cluster prefetching setting of the run.
+   EClusterPrefetch fClusterPrefetch = EClusterPrefetch::kDefault;
 };
 
 struct ByteData {
    ULong64_t fUncompressedBytesRead;
    ULong64_t fCompressedBytesRead;
+   /// Time spent reading from storage, in seconds.
+   double fReadTime = 0.;
+   /// Time spent decompressing (and unpacking), in seconds.
+   double fUnzipTime = 0.;
+};
+
+/// The settings swept by EvalThroughputSweep(): every combination is run once.
+struct Sweep {
+   std::vector<unsigned int> fNThreads{0};
+   std::vector<Long64_t> fCacheSizes{-1};
+   std::vector<EClusterPrefetch> fClusterPrefetch{EClusterPrefetch::kDefault};
 };
 
 struct ReadSpeedRegex {
@@ -65,11 +106,22 @@ struct ReadSpeedRegex {
 };
 
 std::vector<std::string> GetMatchingBranchNames(const std::string &fileName, const std::string &treeName,
-                                                const std::vector<ReadSpeedRegex> &regexes);
+                                                const std::vector<ReadSpeedRegex> &regexes, bool isRNTuple = false);
 
 // Read branches listed in branchNames in tree treeName in file fileName, return number of uncompressed bytes read.
 ByteData ReadTree(TFile *file, const std::string &treeName, const std::vector<std::string> &branchNames,
-                  EntryRange range = {-1, -1});
+                  EntryRange range = {-1, -1}, Long64_t cacheSize = -1,
+                  EClusterPrefetch prefetch = EClusterPrefetch::kDefault, bool measurePhases = false);
+
+// Open the RNTuple ntupleName in file fileName for ReadNTuple(), with metrics enabled. Throws if ROOT was built without
+// RNTuple support.
+std::unique_ptr<ROOT::Experimental::RNTupleReader>
+OpenNTuple(const std::string &fileName, const std::string &ntupleName,
+           EClusterPrefetch prefetch = EClusterPrefetch::kDefault);
+
+// Read the top-level fields listed in fieldNames, return the number of bytes unsealed and read.
+ByteData ReadNTuple(ROOT::Experimental::RNTupleReader &reader, const std::vector<std::string> &fieldNames,
+                    EntryRange range = {-1, -1});
 
 Result EvalThroughputST(const Data &d);
 
@@ -87,6 +139,9 @@ Result EvalThroughputMT(const Data &d, unsigned nThreads);
 
 Result EvalThroughput(const Data &d, unsigned nThreads);
 
+// Run EvalThroughput() for every combination of the settings of the sweep.
+std::vector<Result> EvalThroughputSweep(const Data &d, const Sweep &sweep);
+
 } // namespace ReadSpeed
 
 #endif // ROOTREADSPEED
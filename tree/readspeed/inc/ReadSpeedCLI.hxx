@@ -16,17 +16,29 @@
 
 #include "ReadSpeed.hxx"
 
+#include <iosfwd>
+#include <string>
 #include <vector>
 
 namespace ReadSpeed {
 
 void PrintThroughput(const Result &r);
 
+// Write the results of a sweep as a JSON document.
+void WriteJSON(const Data &d, const std::vector<Result> &results, std::ostream &os);
+
+// Read the entry ranges to replay, one "<file index> <first entry> <end entry>" per line, see --replay.
+std::vector<std::vector<EntryRange>> ReadEntryRanges(std::istream &is, std::size_t nFiles);
+
 struct Args {
    Data fData;
    unsigned int fNThreads = 0;
    bool fAllBranches = false;
    bool fShouldRun = false;
+   /// The settings to sweep, the first thread count being fNThreads.
+   Sweep fSweep;
+   /// If not empty, the results are written in JSON format to this file.
+   std::string fJSONFileName;
 };
 
 Args ParseArgs(const std::vector<std::string> &args);
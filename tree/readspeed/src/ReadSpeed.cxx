@@ -18,10 +18,19 @@
 #include <ROOT/RSlotStack.hxx>
 #endif
 
+#ifdef R__HAS_ROOT7
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleMetrics.hxx>
+#include <ROOT/RNTupleReadOptions.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleView.hxx>
+#endif
+
 #include <ROOT/InternalTreeUtils.hxx> // for ROOT::Internal::TreeUtils::GetTopLevelBranchNames
 #include <TBranch.h>
 #include <TStopwatch.h>
 #include <TTree.h>
+#include <TTreePerfStats.h>
 
 #include <algorithm>
 #include <cassert>
@@ -34,9 +43,33 @@
 
 using namespace ReadSpeed;
 
-std::vector<std::string> ReadSpeed::GetMatchingBranchNames(const std::string &fileName, const std::string &treeName,
-                                                           const std::vector<ReadSpeedRegex> &regexes)
+#ifdef R__HAS_ROOT7
+std::unique_ptr<ROOT::Experimental::RNTupleReader>
+ReadSpeed::OpenNTuple(const std::string &fileName, const std::string &ntupleName, EClusterPrefetch prefetch)
+{
+   using ROOT::Experimental::RNTupleReadOptions;
+
+   RNTupleReadOptions options;
+   options.SetMetricsEnabled(true);
+   if (prefetch != EClusterPrefetch::kDefault)
+      options.SetClusterCache(prefetch == EClusterPrefetch::kOn ? RNTupleReadOptions::EClusterCache::kOn
+                                                                : RNTupleReadOptions::EClusterCache::kOff);
+   return ROOT::Experimental::RNTupleReader::Open(ntupleName, fileName, options);
+}
+#endif
+
+std::vector<std::string> GetTopLevelNames(const std::string &fileName, const std::string &treeName, bool isRNTuple)
 {
+   if (isRNTuple) {
+      std::vector<std::string> fieldNames;
+#ifdef R__HAS_ROOT7
+      auto reader = OpenNTuple(fileName, treeName);
+      for (const auto &f : reader->GetDescriptor().GetTopLevelFields())
+         fieldNames.emplace_back(f.GetFieldName());
+#endif
+      return fieldNames;
+   }
+
    const auto f = std::unique_ptr<TFile>(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
    if (f == nullptr || f->IsZombie())
       throw std::runtime_error("Could not open file '" + fileName + '\'');
@@ -44,7 +77,13 @@ std::vector<std::string> ReadSpeed::GetMatchingBranchNames(const std::string &fi
    if (t == nullptr)
       throw std::runtime_error("Could not retrieve tree '" + treeName + "' from file '" + fileName + '\'');
 
-   const auto unfilteredBranchNames = ROOT::Internal::TreeUtils::GetTopLevelBranchNames(*t);
+   return ROOT::Internal::TreeUtils::GetTopLevelBranchNames(*t);
+}
+
+std::vector<std::string> ReadSpeed::GetMatchingBranchNames(const std::string &fileName, const std::string &treeName,
+                                                           const std::vector<ReadSpeedRegex> &regexes, bool isRNTuple)
+{
+   const auto unfilteredBranchNames = GetTopLevelNames(fileName, treeName, isRNTuple);
    std::set<ReadSpeedRegex> usedRegexes;
    std::vector<std::string> branchNames;
 
@@ -102,7 +141,7 @@ std::vector<std::vector<std::string>> GetPerFileBranchNames(const Data &d)
    for (const auto &fName : d.fFileNames) {
       std::vector<std::string> branchNames;
       if (d.fUseRegex)
-         branchNames = GetMatchingBranchNames(fName, d.fTreeNames[treeIdx], regexes);
+         branchNames = GetMatchingBranchNames(fName, d.fTreeNames[treeIdx], regexes, d.fIsRNTuple);
       else
          branchNames = d.fBranchNames;
 
@@ -122,19 +161,31 @@ ByteData SumBytes(const std::vector<ByteData> &bytesData) {
    const auto compressedBytes =
       std::accumulate(bytesData.begin(), bytesData.end(), 0ull,
                         [](ULong64_t sum, const ByteData &o) { return sum + o.fCompressedBytesRead; });
+   const auto readTime = std::accumulate(bytesData.begin(), bytesData.end(), 0.,
+                                         [](double sum, const ByteData &o) { return sum + o.fReadTime; });
+   const auto unzipTime = std::accumulate(bytesData.begin(), bytesData.end(), 0.,
+                                          [](double sum, const ByteData &o) { return sum + o.fUnzipTime; });
 
-   return {uncompressedBytes, compressedBytes};
+   return {uncompressedBytes, compressedBytes, readTime, unzipTime};
 };
 
 // Read branches listed in branchNames in tree treeName in file fileName, return number of uncompressed bytes read.
 ByteData ReadSpeed::ReadTree(TFile *f, const std::string &treeName, const std::vector<std::string> &branchNames,
-                             EntryRange range)
+                             EntryRange range, Long64_t cacheSize, EClusterPrefetch prefetch, bool measurePhases)
 {
    std::unique_ptr<TTree> t(f->Get<TTree>(treeName.c_str()));
    if (t == nullptr)
       throw std::runtime_error("Could not retrieve tree '" + treeName + "' from file '" + f->GetName() + '\'');
 
    t->SetBranchStatus("*", 0);
+   if (cacheSize >= 0)
+      t->SetCacheSize(cacheSize);
+   if (prefetch != EClusterPrefetch::kDefault)
+      t->SetClusterPrefetch(prefetch == EClusterPrefetch::kOn);
+   // Records the time spent reading from the file and decompressing the baskets of this tree
+   std::unique_ptr<TTreePerfStats> perfStats;
+   if (measurePhases)
+      perfStats = std::make_unique<TTreePerfStats>("readspeed", t.get());
 
    std::vector<TBranch *> branches;
    for (const auto &bName : branchNames) {
@@ -162,38 +213,101 @@ ByteData ReadSpeed::ReadTree(TFile *f, const std::string &treeName, const std::v
          bytesRead += b->GetEntry(e);
 
    const ULong64_t fileBytesRead = f->GetBytesRead() - fileStartBytes;
+   if (perfStats)
+      return {bytesRead, fileBytesRead, perfStats->GetDiskTime(), perfStats->GetUnzipTime()};
    return {bytesRead, fileBytesRead};
 }
 
+#ifdef R__HAS_ROOT7
+ByteData ReadSpeed::ReadNTuple(ROOT::Experimental::RNTupleReader &reader, const std::vector<std::string> &fieldNames,
+                               EntryRange range)
+{
+   std::vector<ROOT::Experimental::RNTupleView<void, false>> views;
+   for (const auto &fName : fieldNames)
+      views.emplace_back(reader.GetView<void>(fName));
+
+   const Long64_t nEntries = reader.GetNEntries();
+   if (range.fStart == -1ll)
+      range = EntryRange{0ll, nEntries};
+   else if (range.fEnd > nEntries)
+      throw std::runtime_error("Range end (" + std::to_string(range.fEnd) + ") is beyond the end of ntuple '" +
+                               reader.GetDescriptor().GetName() + "' with " + std::to_string(nEntries) + " entries.");
+
+   const auto &metrics = reader.GetMetrics();
+   const auto prefix = std::string("RNTupleReader.RPageSourceFile.");
+   auto getValue = [&](const std::string &name) -> ULong64_t {
+      const auto counter = metrics.GetCounter(prefix + name);
+      return counter ? counter->GetValueAsInt() : 0;
+   };
+   const auto unzipBytesStart = getValue("szUnzip");
+   const auto readBytesStart = getValue("szReadPayload") + getValue("szReadOverhead");
+   const auto readTimeStart = getValue("timeWallRead");
+   const auto unzipTimeStart = getValue("timeWallUnzip");
+
+   for (auto e = range.fStart; e < range.fEnd; ++e)
+      for (auto &v : views)
+         v(e);
+
+   const auto readBytes = getValue("szReadPayload") + getValue("szReadOverhead") - readBytesStart;
+   return {getValue("szUnzip") - unzipBytesStart, readBytes, 1e-9 * (getValue("timeWallRead") - readTimeStart),
+           1e-9 * (getValue("timeWallUnzip") - unzipTimeStart)};
+}
+#endif
+
 Result ReadSpeed::EvalThroughputST(const Data &d)
 {
    auto treeIdx = 0;
    auto fileIdx = 0;
-   ULong64_t uncompressedBytesRead = 0;
-   ULong64_t compressedBytesRead = 0;
+   std::vector<ByteData> fileByteData;
 
    TStopwatch sw;
    const auto fileBranchNames = GetPerFileBranchNames(d);
 
    for (const auto &fileName : d.fFileNames) {
-      auto f = std::unique_ptr<TFile>(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
-      if (f == nullptr || f->IsZombie())
-         throw std::runtime_error("Could not open file '" + fileName + '\'');
-
-      sw.Start(false);
+      // Either the replayed entry ranges or all entries
+      const auto ranges = d.fEntryRanges.empty() ? std::vector<EntryRange>{EntryRange{}} : d.fEntryRanges[fileIdx];
+      std::vector<ByteData> byteData;
+
+      if (d.fIsRNTuple) {
+#ifdef R__HAS_ROOT7
+         auto reader = OpenNTuple(fileName, d.fTreeNames[treeIdx], d.fClusterPrefetch);
+
+         sw.Start(false);
+         for (const auto &range : ranges)
+            byteData.emplace_back(ReadNTuple(*reader, fileBranchNames[fileIdx], range));
+         sw.Stop();
+#endif
+      } else {
+         auto f = std::unique_ptr<TFile>(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
+         if (f == nullptr || f->IsZombie())
+            throw std::runtime_error("Could not open file '" + fileName + '\'');
 
-      const auto byteData = ReadTree(f.get(), d.fTreeNames[treeIdx], fileBranchNames[fileIdx]);
-      uncompressedBytesRead += byteData.fUncompressedBytesRead;
-      compressedBytesRead += byteData.fCompressedBytesRead;
+         sw.Start(false);
+         for (const auto &range : ranges)
+            byteData.emplace_back(ReadTree(f.get(), d.fTreeNames[treeIdx], fileBranchNames[fileIdx], range,
+                                           d.fCacheSize, d.fClusterPrefetch, /*measurePhases=*/true));
+         sw.Stop();
+      }
+      fileByteData.emplace_back(SumBytes(byteData));
 
       if (d.fTreeNames.size() > 1)
          ++treeIdx;
       ++fileIdx;
-
-      sw.Stop();
    }
 
-   return {sw.RealTime(), sw.CpuTime(), 0., 0., uncompressedBytesRead, compressedBytesRead, 0};
+   const auto totalByteData = SumBytes(fileByteData);
+   Result r{sw.RealTime(),
+            sw.CpuTime(),
+            0.,
+            0.,
+            totalByteData.fUncompressedBytesRead,
+            totalByteData.fCompressedBytesRead,
+            0};
+   r.fReadTime = totalByteData.fReadTime;
+   r.fUnzipTime = totalByteData.fUnzipTime;
+   // Reading ahead in the background can overlap with the other phases
+   r.fDeserializeTime = std::max(0., r.fRealTime - r.fReadTime - r.fUnzipTime);
+   return r;
 }
 
 // Return a vector of EntryRanges per file, i.e. a vector of vectors of EntryRanges with outer size equal to
@@ -208,6 +322,19 @@ std::vector<std::vector<EntryRange>> ReadSpeed::GetClusters(const Data &d)
       if (f == nullptr || f->IsZombie())
          throw std::runtime_error("There was a problem opening file '" + fileName + '\'');
       const auto &treeName = d.fTreeNames.size() > 1 ? d.fTreeNames[fileIdx] : d.fTreeNames[0];
+      if (d.fIsRNTuple) {
+#ifdef R__HAS_ROOT7
+         auto reader = OpenNTuple(fileName, treeName);
+         const auto &desc = reader->GetDescriptor();
+         for (const auto &c : desc.GetClusterIterable()) {
+            const Long64_t first = c.GetFirstEntryIndex();
+            ranges[fileIdx].emplace_back(EntryRange{first, first + static_cast<Long64_t>(c.GetNEntries())});
+         }
+         std::sort(ranges[fileIdx].begin(), ranges[fileIdx].end(),
+                   [](const EntryRange &a, const EntryRange &b) { return a.fStart < b.fStart; });
+#endif
+         continue;
+      }
       auto *t = f->Get<TTree>(treeName.c_str()); // TFile owns this TTree
       if (t == nullptr)
          throw std::runtime_error("There was a problem retrieving TTree '" + treeName + "' from file '" + fileName +
@@ -279,7 +406,8 @@ Result ReadSpeed::EvalThroughputMT(const Data &d, unsigned nThreads)
    const unsigned int maxTasksPerFile =
       std::ceil(float(ROOT::TTreeProcessorMT::GetTasksPerWorkerHint() * actualThreads) / float(d.fFileNames.size()));
 
-   const auto rangesPerFile = MergeClusters(GetClusters(d), maxTasksPerFile);
+   // Replayed entry ranges are used as they are, as tasks
+   const auto rangesPerFile = d.fEntryRanges.empty() ? MergeClusters(GetClusters(d), maxTasksPerFile) : d.fEntryRanges;
    clsw.Stop();
 
    const size_t nranges =
@@ -291,6 +419,9 @@ Result ReadSpeed::EvalThroughputMT(const Data &d, unsigned nThreads)
    ROOT::Internal::RSlotStack slotStack(actualThreads);
    std::vector<int> lastFileIdxs(actualThreads, -1);
    std::vector<std::unique_ptr<TFile>> lastTFiles(actualThreads);
+#ifdef R__HAS_ROOT7
+   std::vector<std::unique_ptr<ROOT::Experimental::RNTupleReader>> lastReaders(actualThreads);
+#endif
 
    auto processFile = [&](int fileIdx) {
       const auto &fileName = d.fFileNames[fileIdx];
@@ -303,6 +434,17 @@ Result ReadSpeed::EvalThroughputMT(const Data &d, unsigned nThreads)
          auto &file = lastTFiles[slotIndex];
          auto &lastIndex = lastFileIdxs[slotIndex];
 
+         if (d.fIsRNTuple) {
+#ifdef R__HAS_ROOT7
+            auto &reader = lastReaders[slotIndex];
+            if (lastIndex != fileIdx) {
+               reader = OpenNTuple(fileName, treeName, d.fClusterPrefetch);
+               lastIndex = fileIdx;
+            }
+            return ReadNTuple(*reader, branchNames, range);
+#endif
+         }
+
          if (lastIndex != fileIdx) {
             file.reset(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
             lastIndex = fileIdx;
@@ -311,7 +453,8 @@ Result ReadSpeed::EvalThroughputMT(const Data &d, unsigned nThreads)
          if (file == nullptr || file->IsZombie())
             throw std::runtime_error("Could not open file '" + fileName + '\'');
 
-         auto result = ReadTree(file.get(), treeName, branchNames, range);
+         auto result = ReadTree(file.get(), treeName, branchNames, range, d.fCacheSize, d.fClusterPrefetch,
+                                /*measurePhases=*/true);
 
          return result;
       };
@@ -326,13 +469,16 @@ Result ReadSpeed::EvalThroughputMT(const Data &d, unsigned nThreads)
    const auto totalByteData = pool.MapReduce(processFile, ROOT::TSeqUL(d.fFileNames.size()), SumBytes);
    sw.Stop();
 
-   return {sw.RealTime(),
-           sw.CpuTime(),
-           clsw.RealTime(),
-           clsw.CpuTime(),
-           totalByteData.fUncompressedBytesRead,
-           totalByteData.fCompressedBytesRead,
-           actualThreads};
+   Result r{sw.RealTime(),
+            sw.CpuTime(),
+            clsw.RealTime(),
+            clsw.CpuTime(),
+            totalByteData.fUncompressedBytesRead,
+            totalByteData.fCompressedBytesRead,
+            actualThreads};
+   r.fReadTime = totalByteData.fReadTime;
+   r.fUnzipTime = totalByteData.fUnzipTime;
+   return r;
 #else
    (void)d;
    (void)nThreads;
@@ -358,15 +504,44 @@ Result ReadSpeed::EvalThroughput(const Data &d, unsigned nThreads)
       std::cerr << "Please provide either one tree name or as many as the file names\n";
       std::terminate();
    }
+   if (!d.fEntryRanges.empty() && d.fEntryRanges.size() != d.fFileNames.size()) {
+      std::cerr << "Please provide the entry ranges of every file\n";
+      std::terminate();
+   }
+#ifndef R__HAS_ROOT7
+   if (d.fIsRNTuple) {
+      std::cerr << "RNTuples were requested, but ROOT was built without RNTuple support.\n";
+      std::terminate();
+   }
+#endif
 
 #ifdef R__USE_IMT
-   return nThreads > 0 ? EvalThroughputMT(d, nThreads) : EvalThroughputST(d);
+   auto r = nThreads > 0 ? EvalThroughputMT(d, nThreads) : EvalThroughputST(d);
 #else
    if (nThreads > 0) {
       std::cerr << nThreads
                 << " threads were requested, but ROOT was built without implicit multi-threading (IMT) support.\n";
       std::terminate();
    }
-   return EvalThroughputST(d);
+   auto r = EvalThroughputST(d);
 #endif
+   r.fCacheSize = d.fCacheSize;
+   r.fClusterPrefetch = d.fClusterPrefetch;
+   return r;
+}
+
+std::vector<Result> ReadSpeed::EvalThroughputSweep(const Data &d, const Sweep &sweep)
+{
+   std::vector<Result> results;
+   Data data = d;
+   for (const auto nThreads : sweep.fNThreads) {
+      for (const auto cacheSize : sweep.fCacheSizes) {
+         for (const auto prefetch : sweep.fClusterPrefetch) {
+            data.fCacheSize = cacheSize;
+            data.fClusterPrefetch = prefetch;
+            results.emplace_back(EvalThroughput(data, nThreads));
+         }
+      }
+   }
+   return results;
 }
@@ -14,18 +14,24 @@
 #include <ROOT/TTreeProcessorMT.hxx> // for TTreeProcessorMT::SetTasksPerWorkerHint
 #endif
 
+#include <fstream>
 #include <iostream>
 #include <cstring>
+#include <sstream>
 
 using namespace ReadSpeed;
 
 const auto usageText = "Usage:\n"
                        " rootreadspeed --files fname1 [fname2 ...]\n"
-                       "               --trees tname1 [tname2 ...]\n"
+                       "               (--trees tname1 [tname2 ...] | --ntuples nname1 [nname2 ...])\n"
                        "               (--all-branches | --branches bname1 [bname2 ...] | --branches-regex bregex1 "
                        "[bregex2 ...])\n"
-                       "               [--threads nthreads]\n"
+                       "               [--threads nthreads1 [nthreads2 ...]]\n"
                        "               [--tasks-per-worker ntasks]\n"
+                       "               [--cache-sizes nbytes1 [nbytes2 ...]]\n"
+                       "               [--cluster-prefetch (on|off) [(on|off) ...]]\n"
+                       "               [--replay fname]\n"
+                       "               [--json fname]\n"
                        " rootreadspeed (--help|-h)\n"
                        " \n"
                        " Use -h for usage help, --help for detailed information.\n";
@@ -41,6 +47,10 @@ const auto argUsageText =
    "      If only one TTree is provided then it will be used for all files.\n"
    "      If multiple TTrees are specified, each TTree is read from the respective file.\n"
    "\n"
+   "    --ntuples nname1 [nname2...]\n"
+   "      The list of RNTuples to read from the files, instead of TTrees. The branch options below then select the "
+   "top-level fields.\n"
+   "\n"
    "  Specifying branches:\n"
    "    Branches can be specified using one of the following flags. Currently only one can be used at a time.\n"
    "\n"
@@ -53,11 +63,23 @@ const auto argUsageText =
    "at least one branch.\n"
    "\n"
    "  Meta arguments:\n"
-   "    --threads nthreads\n"
+   "    --threads nthreads1 [nthreads2...]\n"
    "      The number of threads to use for file reading. Will automatically cap to the number of available threads on "
-   "the machine.\n"
+   "the machine. If several values are given, the benchmark is run once for each of them.\n"
    "    --tasks-per-worker ntasks\n"
-   "      The number of tasks to generate for each worker thread when using multithreading.";
+   "      The number of tasks to generate for each worker thread when using multithreading.\n"
+   "    --cache-sizes nbytes1 [nbytes2...]\n"
+   "      The TTreeCache sizes to run the benchmark with, in bytes. Ignored for RNTuples.\n"
+   "    --cluster-prefetch (on|off) [(on|off)...]\n"
+   "      Whether clusters are prefetched: TTree::SetClusterPrefetch for TTrees, the cluster cache for RNTuples.\n"
+   "    --replay fname\n"
+   "      Read only the entry ranges listed in the file, one '<file index> <first entry> <end entry>' per line, e.g. "
+   "the ranges processed by an RDataFrame job as reported by RSampleInfo::EntryRange() in DefinePerSample. When "
+   "using multithreading, every range is a task.\n"
+   "    --json fname\n"
+   "      Write the results to the file in JSON format.\n"
+   "\n"
+   "  The benchmark is run for every combination of the values of --threads, --cache-sizes and --cluster-prefetch.";
 
 const auto fullUsageText =
    "Description:\n"
@@ -75,6 +97,12 @@ const auto fullUsageText =
    "branch values in the TTree. Throughput is calculated as the total number of bytes over the total runtime "
    "(including decompression time) in the uncompressed and compressed cases.\n"
    "\n\n"
+   "Time breakdown:\n"
+   "\n"
+   "The time spent reading from storage and decompressing is measured with TTreePerfStats for TTrees and with the "
+   "RNTuple metrics for RNTuples, where decompression includes the unpacking of the pages. Both are summed over all "
+   "threads. For single-thread runs, the remaining real time is reported as deserialisation time.\n"
+   "\n\n"
    "Interpreting results:\n"
    "\n"
    "There are three possible scenarios when using rootreadspeed, namely:\n"
@@ -126,9 +154,26 @@ const auto fullUsageText =
    "TTreeReader and RDataFrame to read branch values selectively, based on event cuts, and this overhead will be "
    "reduced significantly when using RDataFrame in conjunction with RNTuple.";
 
+namespace {
+
+const char *PrefetchName(EClusterPrefetch prefetch)
+{
+   switch (prefetch) {
+   case EClusterPrefetch::kOn: return "on";
+   case EClusterPrefetch::kOff: return "off";
+   default: return "default";
+   }
+}
+
+} // anonymous namespace
+
 void ReadSpeed::PrintThroughput(const Result &r)
 {
    std::cout << "Thread pool size:\t\t" << r.fThreadPoolSize << '\n';
+   if (r.fCacheSize >= 0)
+      std::cout << "TTreeCache size:\t\t" << r.fCacheSize << " bytes\n";
+   if (r.fClusterPrefetch != EClusterPrefetch::kDefault)
+      std::cout << "Cluster prefetching:\t\t" << PrefetchName(r.fClusterPrefetch) << '\n';
 
    if (r.fMTSetupRealTime > 0.) {
       std::cout << "Real time to setup MT run:\t" << r.fMTSetupRealTime << " s\n";
@@ -137,6 +182,12 @@ void ReadSpeed::PrintThroughput(const Result &r)
 
    std::cout << "Real time:\t\t\t" << r.fRealTime << " s\n";
    std::cout << "CPU time:\t\t\t" << r.fCpuTime << " s\n";
+   if (r.fReadTime >= 0.)
+      std::cout << "Storage read time:\t\t" << r.fReadTime << " s\n";
+   if (r.fUnzipTime >= 0.)
+      std::cout << "Decompression time:\t\t" << r.fUnzipTime << " s\n";
+   if (r.fDeserializeTime >= 0.)
+      std::cout << "Deserialisation time:\t\t" << r.fDeserializeTime << " s\n";
 
    std::cout << "Uncompressed data read:\t\t" << r.fUncompressedBytesRead << " bytes\n";
    std::cout << "Compressed data read:\t\t" << r.fCompressedBytesRead << " bytes\n";
@@ -164,6 +215,62 @@ void ReadSpeed::PrintThroughput(const Result &r)
    std::cout << "For details run with the --help command.\n";
 }
 
+void ReadSpeed::WriteJSON(const Data &d, const std::vector<Result> &results, std::ostream &os)
+{
+   auto writeStrings = [&os](const std::vector<std::string> &strings) {
+      os << '[';
+      for (std::size_t i = 0; i < strings.size(); ++i) {
+         os << (i ? ", " : "") << '"';
+         for (const char c : strings[i]) {
+            if (c == '"' || c == '\\')
+               os << '\\';
+            os << c;
+         }
+         os << '"';
+      }
+      os << ']';
+   };
+
+   os << "{\n  \"format\": \"" << (d.fIsRNTuple ? "RNTuple" : "TTree") << "\",\n";
+   os << "  \"files\": ";
+   writeStrings(d.fFileNames);
+   os << ",\n  \"datasets\": ";
+   writeStrings(d.fTreeNames);
+   os << ",\n  \"branches\": ";
+   writeStrings(d.fBranchNames);
+   os << ",\n  \"replay\": " << (d.fEntryRanges.empty() ? "false" : "true") << ",\n";
+   os << "  \"results\": [";
+   for (std::size_t i = 0; i < results.size(); ++i) {
+      const auto &r = results[i];
+      os << (i ? ",\n" : "\n") << "    {\"threads\": " << r.fThreadPoolSize << ", \"cacheSize\": " << r.fCacheSize
+         << ", \"clusterPrefetch\": \"" << PrefetchName(r.fClusterPrefetch) << "\", \"realTime\": " << r.fRealTime
+         << ", \"cpuTime\": " << r.fCpuTime << ", \"mtSetupRealTime\": " << r.fMTSetupRealTime
+         << ", \"mtSetupCpuTime\": " << r.fMTSetupCpuTime << ", \"readTime\": " << r.fReadTime
+         << ", \"unzipTime\": " << r.fUnzipTime << ", \"deserializeTime\": " << r.fDeserializeTime
+         << ", \"uncompressedBytes\": " << r.fUncompressedBytesRead
+         << ", \"compressedBytes\": " << r.fCompressedBytesRead << "}";
+   }
+   os << "\n  ]\n}\n";
+}
+
+std::vector<std::vector<EntryRange>> ReadSpeed::ReadEntryRanges(std::istream &is, std::size_t nFiles)
+{
+   std::vector<std::vector<EntryRange>> ranges(nFiles);
+   std::string line;
+   while (std::getline(is, line)) {
+      if (line.empty() || line[0] == '#')
+         continue;
+      std::istringstream fields(line);
+      std::size_t fileIdx;
+      EntryRange range;
+      if (!(fields >> fileIdx >> range.fStart >> range.fEnd) || fileIdx >= nFiles || range.fStart < 0 ||
+          range.fEnd < range.fStart)
+         throw std::runtime_error("Invalid entry range '" + line + '\'');
+      ranges[fileIdx].emplace_back(range);
+   }
+   return ranges;
+}
+
 Args ReadSpeed::ParseArgs(const std::vector<std::string> &args)
 {
    // Print help message and exit if "--help"
@@ -183,9 +290,26 @@ Args ReadSpeed::ParseArgs(const std::vector<std::string> &args)
    }
 
    Data d;
-   unsigned int nThreads = 0;
+   Sweep sweep;
+   std::vector<unsigned int> nThreads;
+   std::vector<Long64_t> cacheSizes;
+   std::vector<EClusterPrefetch> prefetch;
+   std::string replayFileName;
+   std::string jsonFileName;
 
-   enum class EArgState { kNone, kTrees, kFiles, kBranches, kThreads, kTasksPerWorkerHint } argState = EArgState::kNone;
+   enum class EArgState {
+      kNone,
+      kTrees,
+      kNTuples,
+      kFiles,
+      kBranches,
+      kThreads,
+      kTasksPerWorkerHint,
+      kCacheSizes,
+      kClusterPrefetch,
+      kReplay,
+      kJSON
+   } argState = EArgState::kNone;
    enum class EBranchState { kNone, kRegular, kRegex, kAll } branchState = EBranchState::kNone;
    const auto branchOptionsErrMsg =
       "Options --all-branches, --branches, and --branches-regex are mutually exclusive. You can use only one.\n";
@@ -195,6 +319,9 @@ Args ReadSpeed::ParseArgs(const std::vector<std::string> &args)
 
       if (arg == "--trees") {
          argState = EArgState::kTrees;
+      } else if (arg == "--ntuples") {
+         argState = EArgState::kNTuples;
+         d.fIsRNTuple = true;
       } else if (arg == "--files") {
          argState = EArgState::kFiles;
       } else if (arg == "--all-branches") {
@@ -225,16 +352,41 @@ Args ReadSpeed::ParseArgs(const std::vector<std::string> &args)
          argState = EArgState::kThreads;
       } else if (arg == "--tasks-per-worker") {
          argState = EArgState::kTasksPerWorkerHint;
+      } else if (arg == "--cache-sizes") {
+         argState = EArgState::kCacheSizes;
+      } else if (arg == "--cluster-prefetch") {
+         argState = EArgState::kClusterPrefetch;
+      } else if (arg == "--replay") {
+         argState = EArgState::kReplay;
+      } else if (arg == "--json") {
+         argState = EArgState::kJSON;
       } else if (arg[0] == '-') {
          std::cerr << "Unrecognized option '" << arg << "'\n";
          return {};
       } else {
          switch (argState) {
-         case EArgState::kTrees: d.fTreeNames.emplace_back(arg); break;
+         case EArgState::kTrees:
+         case EArgState::kNTuples: d.fTreeNames.emplace_back(arg); break;
          case EArgState::kFiles: d.fFileNames.emplace_back(arg); break;
          case EArgState::kBranches: d.fBranchNames.emplace_back(arg); break;
-         case EArgState::kThreads:
-            nThreads = std::stoi(arg);
+         case EArgState::kThreads: nThreads.emplace_back(std::stoi(arg)); break;
+         case EArgState::kCacheSizes: cacheSizes.emplace_back(std::stoll(arg)); break;
+         case EArgState::kClusterPrefetch:
+            if (arg == "on") {
+               prefetch.emplace_back(EClusterPrefetch::kOn);
+            } else if (arg == "off") {
+               prefetch.emplace_back(EClusterPrefetch::kOff);
+            } else {
+               std::cerr << "Invalid cluster prefetch setting '" << arg << "', expected 'on' or 'off'\n";
+               return {};
+            }
+            break;
+         case EArgState::kReplay:
+            replayFileName = arg;
+            argState = EArgState::kNone;
+            break;
+         case EArgState::kJSON:
+            jsonFileName = arg;
             argState = EArgState::kNone;
             break;
          case EArgState::kTasksPerWorkerHint:
@@ -251,7 +403,30 @@ Args ReadSpeed::ParseArgs(const std::vector<std::string> &args)
       }
    }
 
-   return Args{std::move(d), nThreads, branchState == EBranchState::kAll, /*fShouldRun=*/true};
+   if (!replayFileName.empty()) {
+      std::ifstream replayFile(replayFileName);
+      if (!replayFile) {
+         std::cerr << "Could not open the entry ranges file '" << replayFileName << "'\n";
+         return {};
+      }
+      try {
+         d.fEntryRanges = ReadEntryRanges(replayFile, d.fFileNames.size());
+      } catch (const std::runtime_error &e) {
+         std::cerr << e.what() << '\n';
+         return {};
+      }
+   }
+
+   if (!nThreads.empty())
+      sweep.fNThreads = nThreads;
+   if (!cacheSizes.empty())
+      sweep.fCacheSizes = cacheSizes;
+   if (!prefetch.empty())
+      sweep.fClusterPrefetch = prefetch;
+
+   const auto firstNThreads = sweep.fNThreads[0];
+   return Args{std::move(d), firstNThreads, branchState == EBranchState::kAll, /*fShouldRun=*/true, std::move(sweep),
+               std::move(jsonFileName)};
 }
 
 Args ReadSpeed::ParseArgs(int argc, char **argv)
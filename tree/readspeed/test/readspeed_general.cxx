@@ -12,6 +12,8 @@
 #include "TSystem.h"
 #include "TTree.h"
 
+#include <sstream>
+
 using namespace ReadSpeed;
 
 // Helper function to generate a .root file with some dummy data in it.
@@ -80,6 +82,30 @@ TEST_F(ReadSpeedIntegration, MultiThread)
 }
 #endif
 
+TEST_F(ReadSpeedIntegration, Replay)
+{
+   Data d{{"t"}, {"readspeedinput1.root", "readspeedinput2.root"}, {"x"}};
+   d.fEntryRanges = {{{0, 1000}, {5000, 6000}}, {{100, 200}}};
+   const auto result = EvalThroughput(d, 0);
+
+   EXPECT_EQ(result.fUncompressedBytesRead, 2100 * 4) << "Wrong number of uncompressed bytes read";
+   EXPECT_GE(result.fReadTime, 0.) << "Storage read time not measured";
+   EXPECT_GE(result.fUnzipTime, 0.) << "Decompression time not measured";
+}
+
+TEST_F(ReadSpeedIntegration, SweepCacheSizes)
+{
+   Sweep sweep;
+   sweep.fCacheSizes = {0, 10000000};
+   const auto results = EvalThroughputSweep({{"t"}, {"readspeedinput1.root"}, {"x"}}, sweep);
+
+   ASSERT_EQ(results.size(), 2u);
+   EXPECT_EQ(results[0].fCacheSize, 0);
+   EXPECT_EQ(results[1].fCacheSize, 10000000);
+   for (const auto &r : results)
+      EXPECT_EQ(r.fUncompressedBytesRead, 40000000) << "Wrong number of uncompressed bytes read";
+}
+
 TEST_F(ReadSpeedIntegration, NonExistentFile)
 {
    ROOT::TestSupport::CheckDiagsRAII diag;
@@ -266,6 +292,89 @@ TEST(ReadSpeedCLI, MultipleThreads)
    EXPECT_EQ(parsedArgs.fNThreads, threads) << "Program not using the correct amount of threads";
 }
 
+TEST(ReadSpeedCLI, Sweep)
+{
+   const std::vector<std::string> allArgs{
+      "root-readspeed",
+      "--files",
+      "doesnotexist.root",
+      "--ntuples",
+      "n",
+      "--branches",
+      "x",
+      "--threads",
+      "0",
+      "4",
+      "--cache-sizes",
+      "0",
+      "1000000",
+      "--cluster-prefetch",
+      "on",
+      "off",
+      "--json",
+      "readspeed.json",
+   };
+
+   const auto parsedArgs = ParseArgs(allArgs);
+
+   EXPECT_TRUE(parsedArgs.fShouldRun) << "Program not running when given valid arguments";
+   EXPECT_TRUE(parsedArgs.fData.fIsRNTuple) << "Program not reading RNTuples when it should";
+   EXPECT_EQ(parsedArgs.fData.fTreeNames, std::vector<std::string>{"n"}) << "List of parsed ntuples not correct";
+   EXPECT_EQ(parsedArgs.fNThreads, 0) << "Program not set to single thread mode first";
+   EXPECT_EQ(parsedArgs.fSweep.fNThreads, (std::vector<unsigned int>{0, 4})) << "Thread counts not parsed correctly";
+   EXPECT_EQ(parsedArgs.fSweep.fCacheSizes, (std::vector<Long64_t>{0, 1000000})) << "Cache sizes not parsed correctly";
+   EXPECT_EQ(parsedArgs.fSweep.fClusterPrefetch,
+             (std::vector<EClusterPrefetch>{EClusterPrefetch::kOn, EClusterPrefetch::kOff}))
+      << "Cluster prefetch settings not parsed correctly";
+   EXPECT_EQ(parsedArgs.fJSONFileName, "readspeed.json") << "JSON file name not parsed correctly";
+}
+
+TEST(ReadSpeedCLI, InvalidClusterPrefetch)
+{
+   const std::vector<std::string> allArgs{
+      "root-readspeed", "--files", "doesnotexist.root", "--trees", "t", "--branches", "x", "--cluster-prefetch", "yes",
+   };
+
+   const auto parsedArgs = ParseArgs(allArgs);
+
+   EXPECT_TRUE(!parsedArgs.fShouldRun) << "Program running with an invalid cluster prefetch setting";
+}
+
+TEST(ReadSpeedCLI, EntryRanges)
+{
+   std::istringstream ranges("# file first end\n1 100 200\n0 0 50\n\n1 0 100\n");
+   const auto parsed = ReadEntryRanges(ranges, 2);
+
+   ASSERT_EQ(parsed.size(), 2u);
+   ASSERT_EQ(parsed[0].size(), 1u);
+   EXPECT_EQ(parsed[0][0].fStart, 0);
+   EXPECT_EQ(parsed[0][0].fEnd, 50);
+   ASSERT_EQ(parsed[1].size(), 2u);
+   EXPECT_EQ(parsed[1][0].fStart, 100);
+   EXPECT_EQ(parsed[1][1].fEnd, 100);
+
+   std::istringstream badFile("2 0 10\n");
+   EXPECT_THROW(ReadEntryRanges(badFile, 2), std::runtime_error) << "Should throw for an invalid file index";
+   std::istringstream badRange("0 10 5\n");
+   EXPECT_THROW(ReadEntryRanges(badRange, 2), std::runtime_error) << "Should throw for an invalid range";
+}
+
+TEST(ReadSpeedCLI, JSON)
+{
+   Result r{1., 2., 0., 0., 100, 10, 4};
+   r.fCacheSize = 1000;
+   r.fClusterPrefetch = EClusterPrefetch::kOn;
+   std::ostringstream os;
+   WriteJSON({{"t"}, {"file\"a.root"}, {"x"}}, {r}, os);
+   const auto json = os.str();
+
+   EXPECT_NE(json.find("\"format\": \"TTree\""), std::string::npos) << json;
+   EXPECT_NE(json.find("\"files\": [\"file\\\"a.root\"]"), std::string::npos) << json;
+   EXPECT_NE(json.find("\"threads\": 4, \"cacheSize\": 1000, \"clusterPrefetch\": \"on\""), std::string::npos)
+      << json;
+   EXPECT_NE(json.find("\"uncompressedBytes\": 100, \"compressedBytes\": 10"), std::string::npos) << json;
+}
+
 #ifdef R__USE_IMT
 TEST(ReadSpeedCLI, WorkerThreadsHint)
 {
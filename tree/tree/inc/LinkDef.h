@@ -33,6 +33,10 @@
 #pragma link C++ class TEventList-;
 #pragma link C++ class TFriendElement+;
 #pragma link C++ class ROOT::TIOFeatures+;
+#pragma link C++ class ROOT::TBasketCostModel+;
+#pragma link C++ class ROOT::TBasketCostModel::TBranchStats+;
+#pragma link C++ class ROOT::TBasketCostModel::TBranchCost+;
+#pragma link C++ class ROOT::TBasketCostModel::TResult+;
 #pragma link C++ class TTreeFriendLeafIter;
 #pragma link C++ class TLeaf-;
 #pragma link C++ class TLeafElement+;
@@ -83,6 +83,21 @@ std::vector<std::string> ExpandGlob(const std::string &glob);
 
 std::pair<std::vector<Long64_t>, Long64_t> GetClustersAndEntries(std::string_view treename, std::string_view path);
 
+/// What is known of a tree of a dataset before processing it, see GetTreesMetadata()
+struct RTreeMetadata {
+   /// Number of entries, -1 if the file could not be opened, -2 if the tree is not in the file
+   Long64_t fEntries = -1;
+   /// Beginning of each cluster followed by the number of entries, as returned by GetClustersAndEntries()
+   std::vector<Long64_t> fClusterBoundaries;
+   std::vector<std::string> fBranchNames; ///< Names of the top-level branches
+};
+
+std::vector<RTreeMetadata>
+GetTreesMetadata(const std::vector<std::string> &treeNames, const std::vector<std::string> &fileNames);
+
+std::vector<std::pair<Long64_t, Long64_t>>
+MakeClusterAlignedRanges(const std::vector<Long64_t> &clusterBoundaries, unsigned int nRanges);
+
 std::pair<bool, std::string> TreeUsesIndexedFriends(const TTree &tree);
 
 } // namespace TreeUtils
@@ -0,0 +1,105 @@
+// Author: Jakob Blomer CERN 10/2024
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketCostModel
+#define ROOT_TBasketCostModel
+
+#include "RtypesCore.h"
+
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+class TBasketCostModel {
+public:
+   /// How the tree is going to be read
+   enum class EReadPattern {
+      kFullScan, ///< All entries of all branches are read sequentially
+      kSparse    ///< A subset of the branches and/or of the entries is read
+   };
+
+   /// Properties of a branch measured from the entries written so far
+   struct TBranchStats {
+      std::string fName;
+      Double_t fBytesPerEntry = 0;       ///< Uncompressed bytes per entry
+      Double_t fCompressionFactor = 1;   ///< Uncompressed over compressed size
+      Int_t fCompressionAlgorithm = 0;   ///< One of ROOT::RCompressionSetting::EAlgorithm::EValues
+      Int_t fCompressionLevel = 0;       ///< 0 if the branch is not compressed
+   };
+
+   /// Predicted cost of reading one branch with the chosen settings
+   struct TBranchCost {
+      std::string fName;
+      Int_t fBasketSize = 0;             ///< Chosen basket payload size in bytes
+      Double_t fEntriesPerBasket = 0;
+      Double_t fZipBytes = 0;            ///< Compressed bytes read per tree entry
+      Double_t fSeekTime = 0;            ///< Latency per tree entry, in seconds
+      Double_t fTransferTime = 0;        ///< Transfer time per tree entry, in seconds
+      Double_t fUnzipTime = 0;           ///< Decompression time per tree entry, in seconds
+      Double_t GetTime() const { return fSeekTime + fTransferTime + fUnzipTime; }
+   };
+
+   /// The settings chosen by Optimize()
+   struct TResult {
+      Long64_t fClusterSize = 0;         ///< Entries per cluster, to be used with TTree::SetAutoFlush
+      ULong64_t fMemory = 0;             ///< Sum of the basket sizes, i.e. the write buffer memory
+      Double_t fTimePerEntry = 0;        ///< Predicted read time per entry for the read pattern, in seconds
+      std::vector<TBranchCost> fBranches;
+   };
+
+private:
+   EReadPattern fReadPattern = EReadPattern::kFullScan;
+   Double_t fBranchFraction = 1;       ///< Fraction of the branches read in the sparse pattern
+   Double_t fEntryFraction = 1;        ///< Fraction of the entries read in the sparse pattern
+   Double_t fLatency = 1e-4;           ///< Seconds per read request
+   Double_t fBandwidth = 200e6;        ///< Storage bandwidth in bytes per second
+   Double_t fBasketOverhead = 5e-6;    ///< Fixed CPU cost of unpacking a basket in seconds
+   ULong64_t fMaxMemory = 10000000;    ///< Upper limit on the sum of the basket sizes
+   Long64_t fCacheSize = 30000000;     ///< TTreeCache size assumed for reading
+
+   Double_t GetEffectiveBranchFraction() const;
+   Double_t GetEffectiveEntryFraction() const;
+
+public:
+   TBasketCostModel() = default;
+   TBasketCostModel(EReadPattern pattern, Double_t latency, Double_t bandwidth)
+      : fReadPattern(pattern), fLatency(latency), fBandwidth(bandwidth)
+   {
+   }
+
+   /// Decompression throughput in uncompressed bytes per second; 0 means no decompression is needed
+   static Double_t GetUnzipRate(Int_t algorithm, Int_t level);
+
+   TBranchCost GetBranchCost(const TBranchStats &stats, Long64_t clusterSize, Int_t basketSize) const;
+   TResult Optimize(const std::vector<TBranchStats> &branches) const;
+
+   EReadPattern GetReadPattern() const { return fReadPattern; }
+   Double_t GetBranchFraction() const { return fBranchFraction; }
+   Double_t GetEntryFraction() const { return fEntryFraction; }
+   Double_t GetLatency() const { return fLatency; }
+   Double_t GetBandwidth() const { return fBandwidth; }
+   Double_t GetBasketOverhead() const { return fBasketOverhead; }
+   ULong64_t GetMaxMemory() const { return fMaxMemory; }
+   Long64_t GetCacheSize() const { return fCacheSize; }
+
+   void SetReadPattern(EReadPattern pattern) { fReadPattern = pattern; }
+   void SetBranchFraction(Double_t fraction) { fBranchFraction = fraction; }
+   void SetEntryFraction(Double_t fraction) { fEntryFraction = fraction; }
+   void SetLatency(Double_t seconds) { fLatency = seconds; }
+   void SetBandwidth(Double_t bytesPerSecond) { fBandwidth = bytesPerSecond; }
+   void SetBasketOverhead(Double_t seconds) { fBasketOverhead = seconds; }
+   void SetMaxMemory(ULong64_t bytes) { fMaxMemory = bytes; }
+   void SetCacheSize(Long64_t bytes) { fCacheSize = bytes; }
+};
+
+} // namespace ROOT
+
+#endif
@@ -31,6 +31,10 @@
 #include "Compression.h"
 #include "ROOT/TIOFeatures.hxx"
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 class TTree;
 class TBasket;
 class TBranchElement;
@@ -76,8 +80,12 @@ public:
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf);
    /// See TBranch::GetEntriesSerialized(Long64_t evt, TBuffer &user_buf, TBuffer *count_buf);
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf, TBuffer *count_buf);
+   /// See TBranch::GetBulkEntries(Long64_t evt, TBuffer &user_buf, TBuffer &offset_buf);
+   Int_t GetBulkEntries(Long64_t evt, TBuffer &user_buf, TBuffer &offset_buf);
    /// Return true if the branch can be read through the bulk interfaces.
    bool SupportsBulkRead() const;
+   /// See TBranch::SupportsVarLengthBulkRead(EDataType *type);
+   bool SupportsVarLengthBulkRead(EDataType *type = nullptr) const;
 
 private:
    TBulkBranchRead(TBranch &parent)
@@ -157,6 +165,12 @@ protected:
    using CacheInfo_t = ROOT::Internal::TBranchCacheInfo;
    CacheInfo_t fCacheInfo;        ///<! Hold info about which basket are in the cache and if they have been retrieved from the cache.
 
+   std::string         fZipDict;            ///<! Trained zstd dictionary, see UpdateZipDictionary()
+   UInt_t              fZipDictID{0};       ///<! ID of fZipDict, 0 if none
+   bool                fZipDictTrained{false}; ///<! True once the training has been attempted
+   std::vector<char>   fZipDictSamples;     ///<! Uncompressed basket content collected for the training
+   std::vector<size_t> fZipDictSampleSizes; ///<! Sizes of the samples in fZipDictSamples
+
    typedef void (TBranch::*ReadLeaves_t)(TBuffer &b);
    ReadLeaves_t fReadLeaves;      ///<! Pointer to the ReadLeaves implementation to use.
    typedef void (TBranch::*FillLeaves_t)(TBuffer &b);
@@ -182,6 +196,8 @@ private:
    Int_t    GetBasketAndFirst(TBasket*& basket, Long64_t& first, TBuffer* user_buffer);
    TBasket *GetBasketImpl(Int_t basket, TBuffer* user_buffer);
    Int_t    GetBulkEntries(Long64_t, TBuffer&);
+   Int_t    GetBulkEntries(Long64_t, TBuffer&, TBuffer&);
+   Int_t    GetVarLengthBulkHeader(EDataType &type) const;
    Int_t    GetEntriesSerialized(Long64_t N, TBuffer& user_buf) {return GetEntriesSerialized(N, user_buf, nullptr);}
    Int_t    GetEntriesSerialized(Long64_t, TBuffer&, TBuffer*);
    Int_t    FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
@@ -287,8 +303,11 @@ public:
    virtual void      SetTree(TTree *tree) { fTree = tree; }
    virtual void      SetupAddresses();
            bool      SupportsBulkRead() const;
+           bool      SupportsVarLengthBulkRead(EDataType *type = nullptr) const;
    virtual void      UpdateAddress() {}
    virtual void      UpdateFile();
+           UInt_t    UpdateZipDictionary(const char *buffer, Int_t size);
+           const std::string &GetZipDictionary() const { return fZipDict; }
 
    static  void      ResetCount();
 
@@ -320,7 +339,9 @@ namespace Internal {
 inline Int_t  TBulkBranchRead::GetBulkEntries(Long64_t evt, TBuffer& user_buf) { return fParent.GetBulkEntries(evt, user_buf); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf) { return fParent.GetEntriesSerialized(evt, user_buf); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf, TBuffer* count_buf) { return fParent.GetEntriesSerialized(evt, user_buf, count_buf); }
+inline Int_t  TBulkBranchRead::GetBulkEntries(Long64_t evt, TBuffer& user_buf, TBuffer& offset_buf) { return fParent.GetBulkEntries(evt, user_buf, offset_buf); }
 inline bool   TBulkBranchRead::SupportsBulkRead() const { return fParent.SupportsBulkRead(); }
+inline bool   TBulkBranchRead::SupportsVarLengthBulkRead(EDataType *type) const { return fParent.SupportsVarLengthBulkRead(type); }
 
 }  // Internal
 }  // Experimental
@@ -23,13 +23,24 @@
 
 #include "TTree.h"
 
+#include <memory>
+
 class TFile;
+class TFileOpenHandle;
 class TBrowser;
 class TCut;
 class TEntryList;
 class TEventList;
 class TCollection;
 
+#ifdef R__USE_IMT
+namespace ROOT {
+namespace Experimental {
+class TTaskGroup;
+}
+}
+#endif
+
 class TChain : public TTree {
 
 protected:
@@ -44,6 +55,15 @@ protected:
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
    bool         fGlobalRegistration;  ///<! if true, bypass use of global lists
+   bool         fPrefetchNextFile;    ///<! if true, the next file is opened and its first cluster read ahead of time
+   Long64_t     fPrefetchEntry;       ///<! Entry of the current tree from which on the next file is prefetched
+   Int_t        fNextTreeNumber;      ///<! Tree number of the file being prefetched, or -1
+   TFile       *fNextFile;            ///<! Pointer to the prefetched file (We own the file).
+   TTree       *fNextTree;            ///<! Pointer to the tree in fNextFile (the file owns it)
+   TFileOpenHandle *fNextFileHandle;  ///<! Pending asynchronous open of the next file
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::Experimental::TTaskGroup> fPrefetchTaskGroup; ///<! Opens and prefetches the next file
+#endif
 
 private:
    TChain(const TChain&);            // not implemented
@@ -53,7 +73,11 @@ private:
 
 protected:
    void InvalidateCurrentTree();
+   void PrefetchNextTree();
+   void ReadTreeHeaders();
    void ReleaseChainProof();
+   void ReleaseNextTree();
+   void WaitNextTree();
 
 public:
    // TChain constants
@@ -116,6 +140,7 @@ public:
    Int_t     GetNbranches() override;
    Long64_t  GetReadEntry() const override;
    TList            *GetStatus() const { return fStatus; }
+   bool      GetPrefetchNextFile() const { return fPrefetchNextFile; }
    TTree    *GetTree() const override { return fTree; }
    Int_t     GetTreeNumber() const override { return fTreeNumber; }
            Long64_t *GetTreeOffset() const { return fTreeOffset; }
@@ -166,6 +191,7 @@ public:
    void      SetMakeClass(Int_t make) override { TTree::SetMakeClass(make); if (fTree) fTree->SetMakeClass(make);}
    void      SetName(const char *name) override;
    virtual void      SetPacketSize(Int_t size = 100);
+   virtual void      SetPrefetchNextFile(bool on = true);
    virtual void      SetProof(bool on = true, bool refresh = false, bool gettreeheader = false);
    void      SetWeight(Double_t w=1, Option_t *option="") override;
    virtual void      UseCache(Int_t maxCacheSize = 10, Int_t pageSize = 0);
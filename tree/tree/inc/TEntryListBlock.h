@@ -26,9 +26,9 @@
 // again changed to 1).
 //
 // Operations on blocks (see also function comments):
-// - Merge() - adds all entries from one block to the other. If the first block
-//             uses array representation, it's changed to bits representation only
-//             if the total number of passing entries is still less than kBlockSize
+// - Merge() - adds all entries from one block to the other
+// - Subtract() - removes the entries of the other block from this one
+// - Intersect() - keeps only the entries that are also in the other block
 // - GetEntry(n) - returns n-th non-zero entry.
 // - Next()      - return next non-zero entry. In case of representation 1), Next()
 //                 is faster than GetEntry()
@@ -55,6 +55,9 @@ class TEntryListBlock:public TObject
    Int_t    fLastIndexReturned; ///<! to optimize GetEntry() in a loop
 
    void Transform(bool dir, UShort_t *indexnew);
+   void ToBits();
+   void GetBits(UShort_t *bits) const;
+   Int_t Combine(const TEntryListBlock *block, Int_t op);
 
  public:
 
@@ -69,6 +72,8 @@ class TEntryListBlock:public TObject
    Int_t   Contains(Int_t entry);
    void    OptimizeStorage();
    Int_t   Merge(TEntryListBlock *block);
+   Int_t   Subtract(const TEntryListBlock *block);
+   Int_t   Intersect(const TEntryListBlock *block);
    Int_t   Next();
    Int_t   GetEntry(Int_t entry);
    void    ResetIndices() {fLastIndexQueried = -1, fLastIndexReturned = -1;}
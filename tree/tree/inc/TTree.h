@@ -27,6 +27,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "Compression.h"
+#include "ROOT/TBasketCostModel.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "TArrayD.h"
 #include "TArrayI.h"
@@ -140,6 +141,7 @@ protected:
    bool           fCacheDoClusterPrefetch;///<! true if cache is prefetching whole clusters
    bool           fCacheUserSet;          ///<! true if the cache setting was explicitly given by user
    bool           fIMTEnabled;            ///<! true if implicit multi-threading is enabled for this tree
+   bool           fIMTParallelFill{false};///<! true if Fill streams the top-level branches in parallel when IMT is on
    UInt_t         fNEntriesSinceSorting;  ///<! Number of entries processed since the last re-sorting of branches
    std::vector<std::pair<Long64_t,TBranch*>> fSortedBranches; ///<! Branches to be processed in parallel when IMT is on, sorted by average task time
    std::vector<TBranch*> fSeqBranches;    ///<! Branches to be processed sequentially when IMT is on
@@ -423,6 +425,7 @@ public:
    virtual TTree          *CloneTree(Long64_t nentries = -1, Option_t* option = "");
    virtual void            CopyAddresses(TTree*,bool undo = false);
    virtual Long64_t        CopyEntries(TTree* tree, Long64_t nentries = -1, Option_t *option = "", bool needCopyAddresses = false);
+           Long64_t        CopyEntryRange(TTree* tree, Long64_t first, Long64_t last, Option_t *option = "");
    virtual TTree          *CopyTree(const char* selection, Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0);
    virtual TBasket        *CreateBasket(TBranch*);
    virtual void            DirectoryAutoAdd(TDirectory *);
@@ -518,6 +521,7 @@ public:
    virtual const char     *GetFriendAlias(TTree*) const;
            TH1            *GetHistogram() { return GetPlayer()->GetHistogram(); }
    virtual bool            GetImplicitMT() { return fIMTEnabled; }
+   virtual bool            GetParallelFill() const { return fIMTParallelFill; }
    virtual Int_t          *GetIndex() { return &fIndex.fArray[0]; }
    virtual Double_t       *GetIndexValues() { return &fIndexValues.fArray[0]; }
            ROOT::TIOFeatures GetIOFeatures() const;
@@ -599,6 +603,7 @@ public:
    static  TTree          *MergeTrees(TList* list, Option_t* option = "");
            bool            Notify() override;
    virtual void            OptimizeBaskets(ULong64_t maxMemory=10000000, Float_t minComp=1.1, Option_t *option="");
+   virtual ROOT::TBasketCostModel::TResult OptimizeBaskets(const ROOT::TBasketCostModel &model, Option_t *option="");
            TPrincipal     *Principal(const char* varexp = "", const char* selection = "", Option_t* option = "np", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0);
            void            Print(Option_t* option = "") const override; // *MENU*
    virtual void            PrintCacheStats(Option_t* option = "") const;
@@ -659,6 +664,7 @@ public:
    virtual void            SetEventList(TEventList* list);
    virtual void            SetEntryList(TEntryList* list, Option_t *opt="");
    virtual void            SetImplicitMT(bool enabled) { fIMTEnabled = enabled; }
+   virtual void            SetParallelFill(bool enabled = true) { fIMTParallelFill = enabled; }
    virtual void            SetMakeClass(Int_t make);
    virtual void            SetMaxEntryLoop(Long64_t maxev = kMaxEntries) { fMaxEntryLoop = maxev; } // *MENU*
    static  void            SetMaxTreeSize(Long64_t maxsize = 100000000000LL);
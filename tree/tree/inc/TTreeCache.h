@@ -67,6 +67,9 @@ protected:
 
    bool         fLearnPrefilling{false}; ///<! true if we are in the process of executing LearnPrefill
 
+   Long64_t     fMemoryBudget{0};     ///<! If positive, hard limit on the cache size, shared among the cached branches
+   std::vector<Long64_t> fBranchQuota; ///<! Share of the cache of each cached branch, in the order of fBranches
+
    // These members hold cached data for missed branches when miss optimization
    // is enabled.  Pointers are only initialized if the miss cache is enabled.
    bool     fOptimizeMisses{false}; ///<! true if we should optimize cache misses.
@@ -124,6 +127,8 @@ private:
    TBranch *CalculateMissEntries(Long64_t, int, bool);    ///< Given an file read, try to determine the corresponding branch.
    bool     ProcessMiss(Long64_t pos, int len); ///<! Given a file read not in the miss cache, handle (possibly) loading the data.
 
+   void     UpdateMemoryBudget(); ///< Size the cache and the branch shares from the cached branches and the memory budget
+
 public:
 
    TTreeCache();
@@ -137,6 +142,7 @@ public:
    virtual void         Enable() {fEnabled = true;}
    bool                 GetOptimizeMisses() const { return fOptimizeMisses; }
    const TObjArray     *GetCachedBranches() const { return fBranches; }
+   const TList         *GetCachedBranchNames() const { return fBrNames; }
    EPrefillType         GetConfiguredPrefillType() const;
    Double_t             GetEfficiency() const;
    Double_t             GetEfficiencyRel() const;
@@ -146,12 +152,15 @@ public:
    virtual EPrefillType GetLearnPrefill() const {return fPrefillType;}
    Double_t             GetMissEfficiency() const;
    Double_t             GetMissEfficiencyRel() const;
+   Long64_t             GetMemoryBudget() const { return fMemoryBudget; }
+   Long64_t             GetBranchQuota(const TBranch *b) const;
    TTree               *GetTree() const {return fTree;}
    bool                 IsAutoCreated() const {return fAutoCreated;}
    virtual bool         IsEnabled() const {return fEnabled;}
    bool                 IsLearning() const override {return fIsLearning;}
 
    virtual bool         FillBuffer();
+   Long64_t             FillBufferForEntries(const std::vector<Long64_t> &entries);
    Int_t                LearnBranch(TBranch *b, bool subgbranches = false) override;
    virtual void         LearnPrefill();
 
@@ -167,6 +176,7 @@ public:
    void                 SetFile(TFile *file, TFile::ECacheAction action=TFile::kDisconnect) override;
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
    static void          SetLearnEntries(Int_t n = 10);
+   void                 SetMemoryBudget(Long64_t budget);
    void                 SetOptimizeMisses(bool opt);
    void                 StartLearningPhase();
    virtual void         StopLearningPhase();
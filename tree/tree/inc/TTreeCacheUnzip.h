@@ -94,16 +94,24 @@ protected:
 
    // Unzipping related members
    Int_t       fNseekMax;         ///<!  fNseek can change so we need to know its max size
-   Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
+   Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of the baskets unzipped by one IMT task
    Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
 
+   // Unzip-ahead pipeline, filled by the main thread while no unzipping task is running
+   std::vector<Int_t>    fUnzipOrder;     ///<! Basket indices in the order in which the reader consumes them
+   std::vector<Long64_t> fUnzipEntry;     ///<! [fNseek] First entry of the baskets, used to compute fUnzipOrder
+   std::vector<Int_t>    fUnzipBufferPos; ///<! [fNseek] Offset of the zipped baskets in fBuffer, or -1
+   std::atomic<Int_t>    fUnzipNext;      ///<! Position in fUnzipOrder of the next basket to be claimed
+   std::atomic<Long64_t> fUnzipPending;   ///<! Summed size of the unzipped baskets not yet consumed by the reader
+   std::atomic<Int_t>    fNUnzipTasks;    ///<! Number of running unzipping tasks
+
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
    // Members use to keep statistics
    Int_t       fNFound;           ///<! number of blocks that were found in the cache
    Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
    Int_t       fNStalls;          ///<! number of hits which caused a stall
-   Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   std::atomic<Int_t> fNUnzip;    ///<! number of blocks that were unzipped
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &) = delete;
@@ -114,6 +122,13 @@ private:
 
    // Private methods
    void  Init();
+   bool  CanUnzipAhead() const;
+   Int_t ClaimNextBasket();
+   Int_t ConsumeUnzipped(Int_t index);
+   void  StopTasks();
+#ifdef R__USE_IMT
+   void  StartTasks();
+#endif
 
 public:
    TTreeCacheUnzip();
@@ -58,6 +58,8 @@ class TTreeCloner {
    Long64_t        fCacheSize;   ///< Requested size of the file cache
    TFileCacheRead *fFileCache;   ///< File Cache used to reduce the number of individual reads
    TFileCacheRead *fPrevCache;   ///< Cache that set before the TTreeCloner ctor for the 'from' TTree if any.
+   Long64_t   fFirstEntry;       ///< First entry of the range to be cloned
+   Long64_t   fLastEntry;        ///< End of the range to be cloned, -1 to clone all the entries.
 
    enum ECloneMethod {
       kDefault             = 0,
@@ -83,6 +85,7 @@ class TTreeCloner {
    friend class CompareSeek;
    friend class CompareEntry;
 
+   void AddClusterRange(Long64_t lastEntry, Long64_t size);
    void ImportClusterRanges();
    void CreateCache();
    UInt_t FillCache(UInt_t from);
@@ -113,6 +116,7 @@ public:
    void   CollectBaskets();
    void   CopyMemoryBaskets();
    void   CopyStreamerInfos();
+   void   AlignEntryRange(Long64_t &first, Long64_t &last) const;
    void   CopyProcessIds();
    const char *GetWarning() const { return fWarningMsg; }
    bool   IsInPlace() const { return fFromTree == fToTree; }
@@ -120,6 +124,7 @@ public:
    bool   IsValid() { return fIsValid; }
    bool   NeedConversion() { return fNeedConversion; }
    void   SetCacheSize(Long64_t size);
+   bool   SetEntryRange(Long64_t first, Long64_t last);
    void   SortBaskets();
    void   WriteBaskets();
 
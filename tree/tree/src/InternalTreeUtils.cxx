@@ -12,6 +12,7 @@
 #include "TChain.h"
 #include "TCollection.h" // TRangeStaticCast
 #include "TDirectory.h"  // TDirectory::TContext
+#include "TEnv.h"
 #include "TFile.h"
 #include "TFriendElement.h"
 #include "TObjString.h"
@@ -22,12 +23,23 @@
 #include "TTree.h"
 #include "TVirtualIndex.h"
 
+#include <algorithm>
+#include <fstream>
 #include <limits>
+#include <numeric> // std::iota
+#include <sstream>
+#include <unordered_map>
 #include <utility> // std::pair
 #include <vector>
 #include <stdexcept> // std::runtime_error
 #include <string>
 
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h" // ROOT::IsImplicitMTEnabled
+#endif
+
 // Recursively get the top level branches from the specified tree and all of its attached friends.
 static void GetTopLevelBranchNamesImpl(TTree &t, std::unordered_set<std::string> &bNamesReg, std::vector<std::string> &bNames,
                                        std::unordered_set<TTree *> &analysedTrees, const std::string friendName = "")
@@ -554,6 +566,178 @@ std::pair<std::vector<Long64_t>, Long64_t> GetClustersAndEntries(std::string_vie
    return std::make_pair(std::move(boundaries), std::move(nEntries));
 }
 
+namespace {
+RTreeMetadata ReadTreeMetadata(const std::string &treeName, const std::string &fileName)
+{
+   RTreeMetadata metadata;
+   ::TDirectory::TContext ctxt;
+   std::unique_ptr<TFile> inFile{TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION")};
+   if (!inFile || inFile->IsZombie())
+      return metadata;
+   auto tree = inFile->Get<TTree>(treeName.c_str()); // owned by the file
+   if (!tree) {
+      metadata.fEntries = -2;
+      return metadata;
+   }
+   // Avoid calling TROOT::RecursiveRemove for this tree, it takes the read lock and we don't need it.
+   tree->ResetBit(kMustCleanup);
+   ClearMustCleanupBits(*tree->GetListOfBranches());
+
+   metadata.fEntries = tree->GetEntriesFast();
+   auto clusterIt = tree->GetClusterIterator(0);
+   Long64_t clusterBegin = clusterIt();
+   metadata.fClusterBoundaries.push_back(clusterBegin);
+   while (clusterBegin < metadata.fEntries) {
+      clusterBegin = clusterIt();
+      metadata.fClusterBoundaries.push_back(std::min(clusterBegin, metadata.fEntries));
+   }
+   for (auto *branch : ROOT::Detail::TRangeStaticCast<TBranch>(tree->GetListOfBranches()))
+      metadata.fBranchNames.emplace_back(branch->GetName());
+   return metadata;
+}
+
+/// The sidecar file holds a line per tree: file name, tree name, number of entries, cluster boundaries and branch
+/// names, separated by tabs, the elements of the lists being separated by spaces.
+std::unordered_map<std::string, RTreeMetadata> ReadMetadataCache(const std::string &path)
+{
+   std::unordered_map<std::string, RTreeMetadata> cache;
+   std::ifstream input(path);
+   std::string line;
+   while (std::getline(input, line)) {
+      std::vector<std::string> columns;
+      std::istringstream lineStream(line);
+      for (std::string column; std::getline(lineStream, column, '\t');)
+         columns.emplace_back(std::move(column));
+      if (columns.size() < 4)
+         continue;
+      RTreeMetadata metadata;
+      std::istringstream(columns[2]) >> metadata.fEntries;
+      std::istringstream boundaries(columns[3]);
+      for (Long64_t boundary; boundaries >> boundary;)
+         metadata.fClusterBoundaries.push_back(boundary);
+      if (columns.size() > 4) {
+         std::istringstream branches(columns[4]);
+         for (std::string name; branches >> name;)
+            metadata.fBranchNames.emplace_back(std::move(name));
+      }
+      if (metadata.fEntries < 0 || metadata.fClusterBoundaries.empty() ||
+          metadata.fClusterBoundaries.back() != metadata.fEntries)
+         continue;
+      cache[columns[0] + '\t' + columns[1]] = std::move(metadata);
+   }
+   return cache;
+}
+
+void AppendToMetadataCache(const std::string &path, const std::string &fileName, const std::string &treeName,
+                           const RTreeMetadata &metadata)
+{
+   std::ostringstream line;
+   line << fileName << '\t' << treeName << '\t' << metadata.fEntries << '\t';
+   for (std::size_t i = 0; i < metadata.fClusterBoundaries.size(); ++i)
+      line << (i ? " " : "") << metadata.fClusterBoundaries[i];
+   line << '\t';
+   for (std::size_t i = 0; i < metadata.fBranchNames.size(); ++i)
+      line << (i ? " " : "") << metadata.fBranchNames[i];
+   line << '\n';
+   // A single write per line, so that concurrent jobs sharing the cache do not interleave their lines
+   std::ofstream output(path, std::ios::app);
+   output << line.str() << std::flush;
+}
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Read the number of entries, the cluster boundaries and the branch names of several trees.
+/// \param[in] treeNames Name of the tree in each file.
+/// \param[in] fileNames Files to read, with the same size as treeNames.
+/// \return The metadata of the trees, in the order of the inputs. No exception is thrown for the files that cannot
+///         be opened or do not contain the tree, see RTreeMetadata::fEntries.
+///
+/// With implicit multi-threading, the files are opened concurrently. Each file is opened once, to read the tree
+/// header: on remote storage, for datasets of thousands of files, opening them one after the other can take longer
+/// than processing them.
+///
+/// If the rootrc variable `TChain.MetadataCache` names a file, the metadata of the trees found in it are not read
+/// again, and the metadata of the trees that were read is appended to it. The entries are identified by file and
+/// tree name only: the cache must be removed if the files change.
+std::vector<RTreeMetadata>
+GetTreesMetadata(const std::vector<std::string> &treeNames, const std::vector<std::string> &fileNames)
+{
+   R__ASSERT(treeNames.size() == fileNames.size());
+   const auto nTrees = fileNames.size();
+   std::vector<RTreeMetadata> metadata(nTrees);
+
+   const std::string cachePath = gEnv->GetValue("TChain.MetadataCache", "");
+   std::vector<std::size_t> toRead;
+   if (!cachePath.empty()) {
+      auto cache = ReadMetadataCache(cachePath);
+      for (std::size_t i = 0; i < nTrees; ++i) {
+         auto itr = cache.find(fileNames[i] + '\t' + treeNames[i]);
+         if (itr != cache.end())
+            metadata[i] = itr->second;
+         else
+            toRead.push_back(i);
+      }
+   } else {
+      toRead.resize(nTrees);
+      std::iota(toRead.begin(), toRead.end(), 0);
+   }
+
+   auto readOne = [&](std::size_t i) {
+      const auto idx = toRead[i];
+      metadata[idx] = ReadTreeMetadata(treeNames[idx], fileNames[idx]);
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && toRead.size() > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(readOne, ROOT::TSeq<std::size_t>(toRead.size()));
+   } else
+#endif
+   {
+      for (std::size_t i = 0; i < toRead.size(); ++i)
+         readOne(i);
+   }
+
+   if (!cachePath.empty()) {
+      for (auto i : toRead) {
+         if (metadata[i].fEntries >= 0)
+            AppendToMetadataCache(cachePath, fileNames[i], treeNames[i], metadata[i]);
+      }
+   }
+   return metadata;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Split the entries of a tree into ranges that start and end at cluster boundaries.
+/// \param[in] clusterBoundaries The cluster boundaries, as returned by GetClustersAndEntries.
+/// \param[in] nRanges The requested number of ranges.
+/// \return The [begin, end) entry ranges, in order. Ranges are as balanced in number of entries as the clusters allow,
+///         so there can be fewer than nRanges of them, e.g. if the tree has fewer clusters.
+///
+/// Ranges that do not cut clusters can be processed, and retried on failure, independently from each other without
+/// reading any basket twice, e.g. by the tasks of a distributed event loop.
+std::vector<std::pair<Long64_t, Long64_t>>
+MakeClusterAlignedRanges(const std::vector<Long64_t> &clusterBoundaries, unsigned int nRanges)
+{
+   std::vector<std::pair<Long64_t, Long64_t>> ranges;
+   if (clusterBoundaries.size() < 2 || nRanges == 0)
+      return ranges;
+   const auto first = clusterBoundaries.front();
+   const auto nEntries = clusterBoundaries.back() - first;
+   auto begin = first;
+   auto boundary = clusterBoundaries.begin() + 1;
+   for (auto i = 1u; i <= nRanges && begin < clusterBoundaries.back(); ++i) {
+      // close the range at the first cluster boundary past its ideal end
+      const Long64_t idealEnd = first + static_cast<Long64_t>(static_cast<double>(nEntries) * i / nRanges);
+      while (*boundary < idealEnd && boundary + 1 != clusterBoundaries.end())
+         ++boundary;
+      if (*boundary <= begin)
+         continue;
+      ranges.emplace_back(begin, *boundary);
+      begin = *boundary;
+   }
+   return ranges;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Check whether the input tree is using any TTreeIndex
 /// \param[in] tree The input TTree/TChain.
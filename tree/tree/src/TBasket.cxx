@@ -24,6 +24,7 @@
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
 #include "ROOT/TIOFeatures.hxx"
+#include "ROOT/RTrace.hxx"
 #include "RZip.h"
 
 #include <bitset>
@@ -463,6 +464,7 @@ void TBasket::ResetEntryOffset()
 
 Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
 {
+   R__TRACE_SCOPE("io", "TBasket::ReadBasketBuffers");
    if(!fBranch->GetDirectory()) {
       return -1;
    }
@@ -618,7 +620,10 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
             goto AfterBuffer;
          }
 
-         R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
+         {
+            R__TRACE_SCOPE("io", "R__unzip");
+            R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
+         }
          if (!nout) break;
          noutot += nout;
          nintot += nin;
@@ -1228,6 +1233,14 @@ Int_t TBasket::WriteBuffer()
       fBuffer = fCompressedBufferRef->Buffer();
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       char *bufcur = &fBuffer[fKeylen];
+      // The dictionary is trained by the branch from its first baskets and stored in the file
+      // so that it is available to the readers.
+      UInt_t dictID = 0;
+      if (cxAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTDDict) {
+         dictID = fBranch->UpdateZipDictionary(objbuf, fObjlen);
+         if (dictID)
+            file->AddZipDictionary(dictID, fBranch->GetZipDictionary());
+      }
       noutot = 0;
       nzip   = 0;
       for (Int_t i = 0; i < nbuffers; ++i) {
@@ -1242,7 +1255,10 @@ Int_t TBasket::WriteBuffer()
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         if (dictID)
+            R__zipWithDictionary(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, dictID);
+         else
+            R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
 #ifdef R__USE_IMT
          sentry.lock();
 #endif  // R__USE_IMT
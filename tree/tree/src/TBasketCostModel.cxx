@@ -0,0 +1,218 @@
+// Author: Jakob Blomer CERN 10/2024
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TBasketCostModel.hxx"
+#include "Compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+
+/**
+ * \class ROOT::TBasketCostModel
+ * \ingroup tree
+ *
+ * `TBasketCostModel` predicts the cost of reading a TTree from the basket sizes and the cluster size, and picks
+ * the values that minimize it.  It is used by TTree::OptimizeBaskets(ROOT::TBasketCostModel &, Option_t *).
+ *
+ * The model describes the storage by its latency per read request and its bandwidth, and the CPU by a fixed cost
+ * per basket plus a decompression throughput that depends on the compression algorithm of the branch.  The total
+ * size of the baskets, i.e. the memory needed to write the tree, is bounded by `SetMaxMemory()`, and the compressed
+ * size of a cluster, i.e. the memory needed to read it, by `SetCacheSize()`.
+ *
+ * For every branch, the read time per tree entry is the sum of
+ *  - the seek time: in the full-scan pattern, the TTreeCache reads a whole cluster with one request per
+ *    `SetCacheSize()` bytes; in the sparse pattern, every basket that is needed is a separate request;
+ *  - the transfer time of the compressed baskets that are needed;
+ *  - the decompression time of these baskets.
+ *
+ * In the sparse pattern, a fraction `SetBranchFraction()` of the branches is read, and a fraction
+ * `SetEntryFraction()` of the entries is selected uniformly.  A basket needs to be read if any of its entries is
+ * selected, so sparse entry selections favor smaller baskets while seek-bound storage favors larger ones.
+ *
+ * Example usage:
+ * ~~~ {.cpp}
+ * ROOT::TBasketCostModel model(ROOT::TBasketCostModel::EReadPattern::kSparse, 0.04, 50e6);
+ * model.SetBranchFraction(0.1);
+ * tree->OptimizeBaskets(model, "d");
+ * ~~~
+ */
+
+namespace {
+/// Approximate size of the key of a basket on disk
+constexpr Double_t kKeyLength = 100;
+constexpr Int_t kMinBasketSize = 512;
+constexpr Int_t kMaxBasketSize = 64 * 1024 * 1024;
+constexpr Long64_t kMaxClusterSize = Long64_t(1) << 24;
+
+Int_t RoundUpBasketSize(Double_t size)
+{
+   if (size >= kMaxBasketSize)
+      return kMaxBasketSize;
+   Int_t rounded = Int_t(std::ceil(size / kMinBasketSize)) * kMinBasketSize;
+   return std::max(rounded, kMinBasketSize);
+}
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the decompression throughput of the given algorithm in uncompressed
+/// bytes per second. These are typical single-core numbers; a level of 0 means
+/// that the branch is not compressed and 0 is returned.
+
+Double_t ROOT::TBasketCostModel::GetUnzipRate(Int_t algorithm, Int_t level)
+{
+   if (level == 0)
+      return 0;
+   switch (algorithm) {
+   case ROOT::RCompressionSetting::EAlgorithm::kLZMA: return 100e6;
+   case ROOT::RCompressionSetting::EAlgorithm::kLZ4: return 2500e6;
+   case ROOT::RCompressionSetting::EAlgorithm::kZSTD:
+   case ROOT::RCompressionSetting::EAlgorithm::kZSTDDict: return 1000e6;
+   default: return 300e6; // zlib, which is also the global default
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Double_t ROOT::TBasketCostModel::GetEffectiveBranchFraction() const
+{
+   if (fReadPattern == EReadPattern::kFullScan)
+      return 1;
+   return std::clamp(fBranchFraction, 0., 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Double_t ROOT::TBasketCostModel::GetEffectiveEntryFraction() const
+{
+   if (fReadPattern == EReadPattern::kFullScan)
+      return 1;
+   return std::clamp(fEntryFraction, 0., 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Predict the cost per tree entry of reading the branch when the tree is
+/// written in clusters of `clusterSize` entries and baskets of `basketSize`
+/// bytes. In the full-scan pattern, the seek time is not included because it is
+/// shared by all the branches of a cluster; Optimize() adds it.
+
+ROOT::TBasketCostModel::TBranchCost
+ROOT::TBasketCostModel::GetBranchCost(const TBranchStats &stats, Long64_t clusterSize, Int_t basketSize) const
+{
+   TBranchCost cost;
+   cost.fName = stats.fName;
+   cost.fBasketSize = basketSize;
+
+   const Double_t bytesPerEntry = std::max(stats.fBytesPerEntry, 1e-3);
+   const Double_t entriesPerBasket =
+      std::clamp(std::floor(basketSize / bytesPerEntry), 1., Double_t(std::max(clusterSize, Long64_t(1))));
+   const Double_t basketsPerCluster = std::ceil(clusterSize / entriesPerBasket);
+   cost.fEntriesPerBasket = entriesPerBasket;
+
+   // Probability that at least one entry of a basket is selected
+   const Double_t entryFraction = GetEffectiveEntryFraction();
+   const Double_t pRead = (entryFraction >= 1) ? 1. : 1. - std::pow(1. - entryFraction, entriesPerBasket);
+   const Double_t basketsRead = basketsPerCluster * pRead;
+
+   const Double_t zipBasketSize = entriesPerBasket * bytesPerEntry / std::max(stats.fCompressionFactor, 1.) + kKeyLength;
+   const Double_t unzipRate = GetUnzipRate(stats.fCompressionAlgorithm, stats.fCompressionLevel);
+
+   cost.fZipBytes = basketsRead * zipBasketSize / clusterSize;
+   cost.fTransferTime = cost.fZipBytes / fBandwidth;
+   cost.fUnzipTime = basketsRead * fBasketOverhead;
+   if (unzipRate > 0)
+      cost.fUnzipTime += basketsRead * entriesPerBasket * bytesPerEntry / unzipRate;
+   cost.fUnzipTime /= clusterSize;
+   if (fReadPattern == EReadPattern::kSparse)
+      cost.fSeekTime = basketsRead * fLatency / clusterSize;
+   return cost;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the cluster size and the basket size of each branch that minimize the
+/// predicted read time per entry, given that the sum of the basket sizes must
+/// not exceed the memory limit and that the compressed cluster must fit in the
+/// cache size. Cluster sizes are tried in powers of two; among
+/// settings whose cost is within 0.1%, the smaller cluster size is preferred as
+/// it needs less memory.
+
+ROOT::TBasketCostModel::TResult ROOT::TBasketCostModel::Optimize(const std::vector<TBranchStats> &branches) const
+{
+   TResult best;
+   best.fTimePerEntry = std::numeric_limits<Double_t>::max();
+   if (branches.empty())
+      return best;
+
+   const Double_t branchFraction = GetEffectiveBranchFraction();
+   const auto nbranches = branches.size();
+
+   std::vector<TBranchCost> costs(nbranches);
+   for (Long64_t clusterSize = 1; clusterSize <= kMaxClusterSize; clusterSize *= 2) {
+      // Best basket size of every branch on its own, from one basket per cluster down to the minimum size.
+      ULong64_t memory = 0;
+      for (std::size_t i = 0; i < nbranches; ++i) {
+         const Double_t clusterBytes = clusterSize * std::max(branches[i].fBytesPerEntry, 1e-3);
+         costs[i] = GetBranchCost(branches[i], clusterSize, RoundUpBasketSize(clusterBytes));
+         for (Double_t size = clusterBytes / 2; size >= kMinBasketSize; size /= 2) {
+            auto candidate = GetBranchCost(branches[i], clusterSize, RoundUpBasketSize(size));
+            if (candidate.GetTime() < costs[i].GetTime())
+               costs[i] = candidate;
+         }
+         memory += costs[i].fBasketSize;
+      }
+
+      // Halve the largest baskets until the memory limit is respected.
+      std::priority_queue<std::pair<Int_t, std::size_t>> largest;
+      for (std::size_t i = 0; i < nbranches; ++i)
+         largest.emplace(costs[i].fBasketSize, i);
+      while (memory > fMaxMemory && !largest.empty()) {
+         auto i = largest.top().second;
+         largest.pop();
+         if (costs[i].fBasketSize <= kMinBasketSize)
+            continue;
+         memory -= costs[i].fBasketSize;
+         costs[i] = GetBranchCost(branches[i], clusterSize, RoundUpBasketSize(costs[i].fBasketSize / 2.));
+         memory += costs[i].fBasketSize;
+         largest.emplace(costs[i].fBasketSize, i);
+      }
+
+      // The cluster should fit in the TTreeCache, which holds the memory used for reading.
+      Double_t zipBytesPerEntry = 0;
+      for (const auto &c : costs)
+         zipBytesPerEntry += branchFraction * c.fZipBytes;
+      if (clusterSize > 1 && zipBytesPerEntry * clusterSize > fCacheSize)
+         break;
+
+      if (fReadPattern == EReadPattern::kFullScan) {
+         // The TTreeCache reads the cluster in chunks of the cache size; the
+         // requests are attributed to the branches by their share of the bytes.
+         const Double_t nRequests =
+            std::max(1., std::ceil(zipBytesPerEntry * clusterSize / std::max(fCacheSize, Long64_t(1))));
+         for (auto &c : costs) {
+            const Double_t share = (zipBytesPerEntry > 0) ? c.fZipBytes / zipBytesPerEntry : 1. / nbranches;
+            c.fSeekTime = nRequests * share * fLatency / clusterSize;
+         }
+      }
+
+      Double_t time = 0;
+      for (const auto &c : costs)
+         time += branchFraction * c.GetTime();
+
+      if (time < best.fTimePerEntry * (1. - 1e-3)) {
+         best.fClusterSize = clusterSize;
+         best.fMemory = memory;
+         best.fTimePerEntry = time;
+         best.fBranches = costs;
+      }
+   }
+   return best;
+}
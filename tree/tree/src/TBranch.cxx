@@ -28,6 +28,7 @@
 #include "TLeafC.h"
 #include "TLeafD.h"
 #include "TLeafD32.h"
+#include "TLeafElement.h"
 #include "TLeafF.h"
 #include "TLeafF16.h"
 #include "TLeafI.h"
@@ -43,6 +44,7 @@
 #include "TTree.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
+#include "TVirtualCollectionProxy.h"
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
 #include "TVirtualPerfStats.h"
@@ -52,7 +54,9 @@
 #include "TBranchIMTHelper.h"
 
 #include "ROOT/TIOFeatures.hxx"
+#include "RZip.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstring>
@@ -1433,6 +1437,62 @@ bool TBranch::SupportsBulkRead() const {
           (static_cast<TLeaf*>(fLeaves.UncheckedAt(0))->GetDeserializeType() != TLeaf::DeserializeType::kExternal);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if this branch can be read by
+/// GetBulkEntries(Long64_t, TBuffer&, TBuffer&), false otherwise.  If `type`
+/// is given, it is set to the type of the elements.
+
+bool TBranch::SupportsVarLengthBulkRead(EDataType *type) const {
+   EDataType elemType = kOther_t;
+   if (GetVarLengthBulkHeader(elemType) < 0)
+      return false;
+   if (type)
+      *type = elemType;
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Determine the element type for the variable-length bulk IO.
+///
+/// Returns the length of the header that precedes the elements of every
+/// entry in the basket (0 for leaves, 10 for the byte count, version and
+/// size of an unsplit std::vector), or -1 if bulk IO is not supported.
+
+Int_t TBranch::GetVarLengthBulkHeader(EDataType &type) const
+{
+   if (fNleaves != 1) return -1;
+   TLeaf *leaf = static_cast<TLeaf*>(fLeaves.UncheckedAt(0));
+
+   TClass *cl = nullptr;
+   type = kOther_t;
+   if (const_cast<TBranch *>(this)->GetExpectedType(cl, type)) return -1;
+
+   Int_t headerLen = 0;
+   if (cl) {
+      TVirtualCollectionProxy *proxy = cl->GetCollectionProxy();
+      if (!proxy || proxy->GetCollectionType() != ROOT::kSTLvector || proxy->GetValueClass()) return -1;
+      type = proxy->GetType();
+      // std::vector<bool> is not stored as contiguous bools in memory
+      if (type == kBool_t) return -1;
+      headerLen = 10;
+   } else if (leaf->InheritsFrom(TLeafElement::Class()) && leaf->GetLeafCount()) {
+      // Variable-size arrays of split objects carry a per-entry array marker
+      return -1;
+   } else if (leaf->GetDeserializeType() == TLeaf::DeserializeType::kExternal) {
+      return -1;
+   }
+
+   switch (type) {
+      case kChar_t: case kUChar_t: case kBool_t:
+      case kShort_t: case kUShort_t:
+      case kInt_t: case kUInt_t: case kFloat_t:
+      case kDouble_t: case kLong64_t: case kULong64_t:
+         return headerLen;
+      default:
+         return -1;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \brief Read a basket of events into the given buffer with byte swapping.
 ///
@@ -1684,6 +1744,156 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    return N;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Read a basket of events of a variable-length branch into the given
+///        buffers with byte swapping.
+///
+/// \return On success, the number of events of the type held by this branch
+///         that have been read into the buffers. -1 on failure.
+///
+/// On success, the values of all the events are stored contiguously and in host
+/// byte order in `user_buf`, and `offset_buf` holds N+1 `Int_t` element offsets
+/// in host byte order.  The values of event `i` (relative to `entry`) are then
+///
+/// ~~~{.cpp}
+/// auto values = reinterpret_cast<T*>(user_buf.GetCurrent());
+/// auto offsets = reinterpret_cast<Int_t*>(offset_buf.GetCurrent());
+/// // values[offsets[i]], ..., values[offsets[i + 1] - 1]
+/// ~~~
+///
+/// where T is the element type stored on this branch, see SupportsVarLengthBulkRead().
+/// Supported are leaves with a leaf count (`x[n]/F`), fixed-size arrays (`x[3]/F`),
+/// scalars, and unsplit `std::vector` of fundamental types.  The leaf count branch
+/// does not need to be read for the offsets, they are taken from the basket.
+///
+/// \note This interface is not meant to be exposed to end users, but rather it should
+///       be wrapped by higher-level interfaces.
+///
+Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf, TBuffer &offset_buf)
+{
+   EDataType type = kOther_t;
+   const Int_t headerLen = GetVarLengthBulkHeader(type);
+   if (R__unlikely(headerLen < 0)) return -1;
+   const Int_t elemSize = TDataType::GetDataType(type)->Size();
+
+   // Remember which entry we are reading.
+   fReadEntry = entry;
+
+   bool enabled = !TestBit(kDoNotProcess);
+   if (R__unlikely(!enabled)) return -1;
+   TBasket *basket = nullptr;
+   Long64_t first;
+   Int_t result = GetBasketAndFirst(basket, first, &user_buf);
+   if (R__unlikely(result < 0)) return -1;
+   // Only support reading from full baskets.
+   if (R__unlikely(entry != first)) return -1;
+
+   basket->PrepareBasket(entry);
+   TBuffer* buf = basket->GetBufferRef();
+
+   // Test for very old ROOT files.
+   if (R__unlikely(!buf)) {
+      Error("GetBulkEntries", "Failed to get a new buffer.\n");
+      return -1;
+   }
+   // Test for displacements, which aren't supported in fast mode.
+   if (R__unlikely(basket->GetDisplacement())) {
+      Error("GetBulkEntries", "Basket has displacement.\n");
+      return -1;
+   }
+
+   if (&user_buf != buf) {
+      // The basket was already in memory and might (and might not) be backed by persistent
+      // storage.
+      R__ASSERT(result == fReadBasket);
+      if (fBasketSeek[fReadBasket]) {
+         // It is backed, so we can be destructive
+         user_buf.SetBuffer(buf->Buffer(), buf->BufferSize());
+         buf->ResetBit(TBufferIO::kIsOwner);
+         fCurrentBasket = nullptr;
+         fBaskets[fReadBasket] = nullptr;
+      } else {
+         // This is the only copy, we can't return it as is to the user, just make a copy.
+         if (user_buf.BufferSize() < buf->BufferSize()) {
+            user_buf.AutoExpand(buf->BufferSize());
+         }
+         memcpy(user_buf.Buffer(), buf->Buffer(), buf->BufferSize());
+      }
+   }
+
+   Int_t bufbegin = basket->GetKeylen();
+   Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
+   if (R__unlikely(N != basket->GetNevBuf())) {
+      Error("GetBulkEntries", "Basket holds %d entries, expected %d.\n", basket->GetNevBuf(), N);
+      return -1;
+   }
+
+   // Without an offset array, every entry has the same length.
+   Int_t *entryOffset = basket->GetEntryOffset();
+   if (R__unlikely(!entryOffset && headerLen)) {
+      Error("GetBulkEntries", "Basket has no entry offsets.\n");
+      return -1;
+   }
+   const Int_t fixedLen = basket->GetNevBufSize();
+   const Int_t last = entryOffset ? basket->GetLast() : bufbegin + N * fixedLen;
+
+   const Int_t offsetSize = (N + 1) * sizeof(Int_t);
+   if (offset_buf.BufferSize() < offsetSize) {
+      offset_buf.AutoExpand(offsetSize);
+   }
+   Int_t *offsets = reinterpret_cast<Int_t *>(offset_buf.Buffer());
+
+   // Compute the element offsets and, for collections, strip the per-entry header
+   // such that the values end up stored contiguously.
+   char *base = user_buf.Buffer();
+   char *dest = base + bufbegin;
+   Int_t nElements = 0;
+   for (Int_t idx = 0; idx < N; ++idx) {
+      const Int_t begin = entryOffset ? entryOffset[idx] : bufbegin + idx * fixedLen;
+      const Int_t end = (idx + 1 < N) ? (entryOffset ? entryOffset[idx + 1] : begin + fixedLen) : last;
+      const Int_t nbytes = end - begin - headerLen;
+      if (R__unlikely(nbytes < 0 || nbytes % elemSize)) {
+         Error("GetBulkEntries", "Entry %d of the basket has an unexpected size of %d bytes.\n", idx, end - begin);
+         return -1;
+      }
+      if (headerLen) {
+         const UInt_t kByteCountMask = 0x40000000;  // The byte count is OR'ed with this
+         char *header = base + begin;
+         UInt_t byteCount;
+         Version_t version;
+         Int_t size;
+         frombuf(header, &byteCount);
+         frombuf(header, &version);
+         frombuf(header, &size);
+         if (R__unlikely(!(byteCount & kByteCountMask) || size * elemSize != nbytes)) {
+            Error("GetBulkEntries", "Entry %d of the basket has an unexpected collection header.\n", idx);
+            return -1;
+         }
+         memmove(dest, base + begin + headerLen, nbytes);
+      }
+      offsets[idx] = nElements;
+      nElements += nbytes / elemSize;
+      dest += nbytes;
+   }
+   offsets[N] = nElements;
+   offset_buf.SetBufferOffset(0);
+
+   user_buf.SetBufferOffset(bufbegin);
+   if (elemSize > 1 && R__unlikely(!user_buf.ByteSwapBuffer(nElements, type))) {
+      Error("GetBulkEntries", "Failed to byte swap the values.\n");
+      return -1;
+   }
+   user_buf.SetBufferOffset(bufbegin);
+
+   if (fCurrentBasket == nullptr) {
+      R__ASSERT(fExtraBasket == nullptr && "fExtraBasket should have been set to nullptr by GetFreshBasket");
+      fExtraBasket = basket;
+      basket->DisownBuffer();
+   }
+
+   return N;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of entry and return total number of bytes read.
 ///
@@ -3322,3 +3532,52 @@ void TBranch::UpdateFile()
       branch->UpdateFile();
    }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the uncompressed content of a basket as a sample for training the
+/// zstd dictionary of this branch, used by TBasket::WriteBuffer for the
+/// ROOT::RCompressionSetting::EAlgorithm::kZSTDDict algorithm.
+///
+/// The dictionary is trained once, from the baskets written until the first
+/// cluster is complete or until about 1 MB of samples is collected; the
+/// baskets written before are compressed without dictionary.  Returns the ID
+/// of the dictionary, or 0 if it is not (yet) available.
+
+UInt_t TBranch::UpdateZipDictionary(const char *buffer, Int_t size)
+{
+   constexpr size_t kMaxSampleSize = 4096;
+   constexpr size_t kMaxSamplesSize = 1024 * 1024;
+   constexpr size_t kMaxDictSize = 16 * 1024;
+   constexpr size_t kMinDictSize = 256;
+
+   if (fZipDictTrained)
+      return fZipDictID;
+
+   for (Int_t pos = 0; pos < size && fZipDictSamples.size() < kMaxSamplesSize; pos += kMaxSampleSize) {
+      const auto len = std::min(kMaxSampleSize, size_t(size - pos));
+      fZipDictSamples.insert(fZipDictSamples.end(), buffer + pos, buffer + pos + len);
+      fZipDictSampleSizes.push_back(len);
+   }
+
+   const Long64_t autoflush = fTree ? fTree->GetAutoFlush() : 0;
+   const bool clusterDone = autoflush > 0 && fTree->GetEntries() >= autoflush;
+   if (!clusterDone && fZipDictSamples.size() < kMaxSamplesSize)
+      return 0;
+
+   fZipDictTrained = true;
+   const size_t capacity = std::min(kMaxDictSize, fZipDictSamples.size() / 10);
+   if (capacity >= kMinDictSize) {
+      std::string dict(capacity, '\0');
+      const auto dictSize = R__trainZipDictionary(&dict[0], capacity, fZipDictSamples.data(),
+                                                  fZipDictSampleSizes.data(), fZipDictSampleSizes.size());
+      if (dictSize > 0) {
+         dict.resize(dictSize);
+         fZipDictID = R__registerZipDictionary(dict.data(), dict.size());
+         if (fZipDictID)
+            fZipDict = std::move(dict);
+      }
+   }
+   std::vector<char>().swap(fZipDictSamples);
+   std::vector<size_t>().swap(fZipDictSampleSizes);
+   return fZipDictID;
+}
@@ -30,6 +30,7 @@ the trees in the chain.
 #include <iostream>
 #include <cfloat>
 #include <string>
+#include <vector>
 
 #include "TBranch.h"
 #include "TBrowser.h"
@@ -57,6 +58,7 @@ the trees in the chain.
 #include "TEventList.h"
 #include "TEntryList.h"
 #include "TEntryListFromFile.h"
+#include "TEnv.h"
 #include "TFileStager.h"
 #include "TFilePrefetch.h"
 #include "TVirtualMutex.h"
@@ -64,6 +66,10 @@ the trees in the chain.
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#endif
+
 ClassImp(TChain);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -71,7 +77,9 @@ ClassImp(TChain);
 
 TChain::TChain(Mode mode)
    : TTree(), fTreeOffsetLen(100), fNtrees(0), fTreeNumber(-1), fTreeOffset(nullptr), fCanDeleteRefs(false), fTree(nullptr),
-     fFile(nullptr), fFiles(nullptr), fStatus(nullptr), fProofChain(nullptr), fGlobalRegistration(mode == kWithGlobalRegistration)
+     fFile(nullptr), fFiles(nullptr), fStatus(nullptr), fProofChain(nullptr), fGlobalRegistration(mode == kWithGlobalRegistration),
+     fPrefetchNextFile(gEnv->GetValue("TChain.PrefetchNextFile", 0) != 0), fPrefetchEntry(-1), fNextTreeNumber(-1),
+     fNextFile(nullptr), fNextTree(nullptr), fNextFileHandle(nullptr)
 {
    fTreeOffset = new Long64_t[fTreeOffsetLen];
    fFiles = new TObjArray(fTreeOffsetLen);
@@ -140,7 +148,9 @@ TChain::TChain(Mode mode)
 TChain::TChain(const char *name, const char *title, Mode mode)
    : TTree(name, title, /*splitlevel*/ 99, nullptr), fTreeOffsetLen(100), fNtrees(0), fTreeNumber(-1), fTreeOffset(nullptr),
      fCanDeleteRefs(false), fTree(nullptr), fFile(nullptr), fFiles(nullptr), fStatus(nullptr), fProofChain(nullptr),
-     fGlobalRegistration(mode == kWithGlobalRegistration)
+     fGlobalRegistration(mode == kWithGlobalRegistration),
+     fPrefetchNextFile(gEnv->GetValue("TChain.PrefetchNextFile", 0) != 0), fPrefetchEntry(-1), fNextTreeNumber(-1),
+     fNextFile(nullptr), fNextTree(nullptr), fNextFileHandle(nullptr)
 {
    //
    //*-*
@@ -180,6 +190,7 @@ TChain::~TChain()
    }
 
    SafeDelete(fProofChain);
+   ReleaseNextTree();
    fStatus->Delete();
    delete fStatus;
    fStatus = nullptr;
@@ -973,7 +984,10 @@ Long64_t TChain::GetChainEntryNumber(Long64_t entry) const
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the total number of entries in the chain.
 /// In case the number of entries in each tree is not yet known,
-/// the offset table is computed.
+/// the offset table is computed. With implicit multi-threading, or if the
+/// rootrc variable `TChain.MetadataCache` is set, the headers of the trees
+/// whose number of entries is unknown are read concurrently, or taken from
+/// the cache, see ROOT::Internal::TreeUtils::GetTreesMetadata().
 
 Long64_t TChain::GetEntries() const
 {
@@ -984,12 +998,56 @@ Long64_t TChain::GetEntries() const
                                " run TChain::SetProof(true, true) first");
       return fProofChain->GetEntries();
    }
+   if (fEntries == TTree::kMaxEntries && (ROOT::IsImplicitMTEnabled() || *gEnv->GetValue("TChain.MetadataCache", ""))) {
+      const_cast<TChain*>(this)->ReadTreeHeaders();
+   }
    if (fEntries == TTree::kMaxEntries) {
       const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
    return fEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the number of entries of the elements of the chain added with
+/// TTree::kMaxEntries entries, and the offset table, from the headers of their
+/// trees, which are read concurrently with implicit multi-threading.
+/// Unlike LoadTree(), no tree is loaded. The elements whose file cannot be
+/// opened are left unknown, for LoadTree() to report the error.
+
+void TChain::ReadTreeHeaders()
+{
+   std::vector<Int_t> unknown;
+   std::vector<std::string> treeNames;
+   std::vector<std::string> fileNames;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      TChainElement *element = (TChainElement *)fFiles->UncheckedAt(i);
+      if (element->GetEntries() == TTree::kMaxEntries) {
+         unknown.push_back(i);
+         treeNames.emplace_back(element->GetName());
+         fileNames.emplace_back(element->GetTitle());
+      }
+   }
+   if (unknown.empty()) {
+      return;
+   }
+
+   const auto metadata = ROOT::Internal::TreeUtils::GetTreesMetadata(treeNames, fileNames);
+   for (std::size_t k = 0; k < unknown.size(); ++k) {
+      if (metadata[k].fEntries >= 0) {
+         ((TChainElement *)fFiles->UncheckedAt(unknown[k]))->SetNumberEntries(metadata[k].fEntries);
+      }
+   }
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      Long64_t nentries = ((TChainElement *)fFiles->UncheckedAt(i))->GetEntries();
+      if (fTreeOffset[i] == TTree::kMaxEntries || nentries == TTree::kMaxEntries) {
+         fTreeOffset[i + 1] = TTree::kMaxEntries;
+      } else {
+         fTreeOffset[i + 1] = fTreeOffset[i] + nentries;
+      }
+   }
+   fEntries = fTreeOffset[fNtrees];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get entry from the file to memory.
 ///
@@ -1367,6 +1425,11 @@ Long64_t TChain::LoadTree(Long64_t entry)
       // next loop).
       fTree->LoadTree(treeReadEntry);
 
+      // Start opening the next file once the last cluster of this one is reached.
+      if (fPrefetchEntry >= 0 && treeReadEntry >= fPrefetchEntry) {
+         PrefetchNextTree();
+      }
+
       if (fFriends) {
          // The current tree has not changed but some of its friends might.
          //
@@ -1514,9 +1577,25 @@ Long64_t TChain::LoadTree(Long64_t entry)
       }
    }
 
+   // Take over the file if it was prefetched, otherwise discard the prefetch.
+   TTree *prefetchedTree = nullptr;
+   TFile *prefetchedFile = nullptr;
+   if (fNextTreeNumber == treenum && fFiles->At(treenum) == element) {
+      WaitNextTree();
+      prefetchedFile = fNextFile;
+      prefetchedTree = fNextTree;
+      fNextFile = nullptr;
+      fNextTree = nullptr;
+   }
+   ReleaseNextTree();
+
    // FIXME: We leak memory here, we've just lost the open file
    //        if we did not delete it above.
-   {
+   if (prefetchedFile) {
+      fFile = prefetchedFile;
+      if (fGlobalRegistration)
+         fFile->SetBit(kMustCleanup);
+   } else {
       TDirectory::TContext ctxt;
       const char *option = fGlobalRegistration ? "READ" : "READ_WITHOUT_GLOBALREGISTRATION";
       fFile = TFile::Open(element->GetTitle(), option);
@@ -1539,7 +1618,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
          fPerfStats->SetFile(fFile);
 
       // Note: We do *not* own fTree after this, the file does!
-      fTree = dynamic_cast<TTree*>(fFile->Get(element->GetName()));
+      fTree = prefetchedTree ? prefetchedTree : dynamic_cast<TTree*>(fFile->Get(element->GetName()));
       if (!fTree) {
          // Now that we do not check during the addition, we need to check here!
          Error("LoadTree", "Cannot find tree with name %s in file %s", element->GetName(), element->GetTitle());
@@ -1562,8 +1641,13 @@ Long64_t TChain::LoadTree(Long64_t entry)
    // FIXME: We may set fDirectory to zero here!
    fDirectory = fFile;
 
-   // Reuse cache from previous file (if any).
-   if (tpf) {
+   // Reuse cache from previous file (if any), unless the prefetch already
+   // attached a filled cache with the same branches to the new file.
+   TTreeCache *prefetchedCache = (fFile && prefetchedTree) ? prefetchedTree->GetReadCache(fFile) : nullptr;
+   if (prefetchedCache) {
+      delete tpf;
+      tpf = nullptr;
+   } else if (tpf) {
       if (fFile) {
          // FIXME: fTree may be zero here.
          tpf->UpdateBranches(fTree);
@@ -1646,6 +1730,14 @@ Long64_t TChain::LoadTree(Long64_t entry)
 
    // Change the new current tree to the new entry.
    Long64_t loadResult = fTree->LoadTree(treeReadEntry);
+
+   // Find the last cluster of the new tree; the next file is prefetched as soon
+   // as it is reached.
+   fPrefetchEntry = -1;
+   if (fPrefetchNextFile && fTreeNumber < fNtrees - 1 && nentries > 0 && treeReadEntry >= 0) {
+      TClusterIterator clusterIter = fTree->GetClusterIterator(nentries - 1);
+      fPrefetchEntry = clusterIter();
+   }
    if (loadResult == treeReadEntry) {
       element->SetLoadResult(0);
    } else {
@@ -1748,6 +1840,11 @@ Long64_t TChain::LoadTree(Long64_t entry)
       if(!fNotify->Notify()) return -6;
    }
 
+   // The new tree may consist of a single cluster.
+   if (fPrefetchEntry >= 0 && treeReadEntry >= fPrefetchEntry) {
+      PrefetchNextTree();
+   }
+
    // Return the new local entry number.
    return treeReadEntry;
 }
@@ -2235,6 +2332,81 @@ void TChain::ParseTreeFilename(const char *name, TString &filename, TString &tre
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the file of the tree following the current one ahead of time.
+///
+/// This is called by LoadTree() once the current tree enters its last cluster,
+/// if SetPrefetchNextFile() is enabled. With implicit multi-threading, the file
+/// is opened in a task which also creates a TTreeCache of the current cache size
+/// for the next tree, adds the branches learnt by the current cache and reads
+/// the first cluster. Otherwise the file is opened with TFile::AsyncOpen(),
+/// which does not block for remote files. The next call to LoadTree() that
+/// switches to this tree picks up the opened file and its filled cache.
+
+void TChain::PrefetchNextTree()
+{
+   fPrefetchEntry = -1;
+   Int_t treenum = fTreeNumber + 1;
+   if (!fPrefetchNextFile || !fTree || treenum >= fNtrees || fNextTreeNumber == treenum) {
+      return;
+   }
+   ReleaseNextTree();
+
+   TChainElement *element = (TChainElement *)fFiles->At(treenum);
+   if (!element) {
+      return;
+   }
+   fNextTreeNumber = treenum;
+   const char *option = fGlobalRegistration ? "READ" : "READ_WITHOUT_GLOBALREGISTRATION";
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled()) {
+      // The cache of the next tree starts with the branches learnt by the current one.
+      Long64_t cacheSize = 0;
+      std::vector<std::string> branchNames;
+      TTreeCache *tpf = fFile ? fTree->GetReadCache(fFile) : nullptr;
+      if (tpf && !tpf->IsLearning() && tpf->GetCachedBranchNames()) {
+         cacheSize = tpf->GetBufferSize();
+         TIter next(tpf->GetCachedBranchNames());
+         while (auto os = (TObjString *)next()) {
+            branchNames.emplace_back(os->GetName());
+         }
+      }
+
+      std::string url(element->GetTitle());
+      std::string treename(element->GetName());
+      fPrefetchTaskGroup = std::make_unique<ROOT::Experimental::TTaskGroup>();
+      fPrefetchTaskGroup->Run([this, url, treename, option, cacheSize, branchNames]() {
+         TDirectory::TContext ctxt;
+         TFile *file = TFile::Open(url.c_str(), option);
+         if (!file || file->IsZombie()) {
+            delete file;
+            return;
+         }
+         TTree *tree = dynamic_cast<TTree *>(file->Get(treename.c_str()));
+         if (tree && cacheSize > 0 && !branchNames.empty() && tree->SetCacheSize(cacheSize) == 0) {
+            TTreeCache *cache = tree->GetReadCache(file);
+            if (cache) {
+               for (const auto &name : branchNames) {
+                  if (tree->GetBranch(name.c_str())) {
+                     cache->AddBranch(name.c_str());
+                  }
+               }
+               cache->StopLearningPhase();
+               cache->FillBuffer();
+            }
+         }
+         // Only read by LoadTree() after waiting for this task.
+         fNextFile = file;
+         fNextTree = tree;
+      });
+      return;
+   }
+#endif
+
+   fNextFileHandle = TFile::AsyncOpen(element->GetTitle(), option);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print the header information of each tree in the chain.
 /// See TTree::Print for a list of options.
@@ -2341,11 +2513,31 @@ void TChain::RemoveFriend(TTree* oldFriend)
    InvalidateCurrentTree();
 }
 
-////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Discard the file prefetched by PrefetchNextTree(), if any.
+
+void TChain::ReleaseNextTree()
+{
+   WaitNextTree();
+   if (fNextFile) {
+      auto tc = fNextTree ? fNextTree->GetReadCache(fNextFile) : nullptr;
+      if (tc) {
+         delete tc;
+         fNextFile->SetCacheRead(nullptr, fNextTree);
+      }
+      delete fNextFile;
+   }
+   fNextFile = nullptr;
+   fNextTree = nullptr;
+   fNextTreeNumber = -1;
+}
+
+////////////////
 /// Resets the state of this chain.
 
 void TChain::Reset(Option_t*)
 {
+   ReleaseNextTree();
    delete fFile;
    fFile = nullptr;
    fNtrees         = 0;
@@ -2998,7 +3190,27 @@ void TChain::SetPacketSize(Int_t size)
    }
 }
 
-////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable opening the next file of the chain ahead of time.
+///
+/// If enabled, LoadTree() starts opening the file of the next tree as soon as
+/// the last cluster of the current tree is reached, so that a sequential loop
+/// over the chain does not stall on opening the next file. With implicit
+/// multi-threading enabled, the first cluster of the next tree is also read in
+/// the background into a TTreeCache caching the branches learnt for the
+/// current tree. This is most useful for remote files. The default is taken
+/// from the rootrc variable TChain.PrefetchNextFile, which defaults to 0.
+
+void TChain::SetPrefetchNextFile(bool on)
+{
+   fPrefetchNextFile = on;
+   if (!on) {
+      fPrefetchEntry = -1;
+      ReleaseNextTree();
+   }
+}
+
+////////////////
 /// Enable/Disable PROOF processing on the current default Proof (gProof).
 ///
 /// "Draw" and "Processed" commands will be handled by PROOF.
@@ -3115,3 +3327,35 @@ void TChain::Streamer(TBuffer& b)
 void TChain::UseCache(Int_t /* maxCacheSize */, Int_t /* pageSize */)
 {
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait until the file prefetched by PrefetchNextTree() is open.
+///
+/// Sets fNextFile and fNextTree, which are null if the file or the tree could
+/// not be opened.
+
+void TChain::WaitNextTree()
+{
+#ifdef R__USE_IMT
+   if (fPrefetchTaskGroup) {
+      fPrefetchTaskGroup->Wait();
+      fPrefetchTaskGroup.reset();
+   }
+#endif
+   if (fNextFileHandle) {
+      TFileOpenHandle *handle = fNextFileHandle;
+      fNextFileHandle = nullptr;
+      {
+         TDirectory::TContext ctxt;
+         fNextFile = TFile::Open(handle);
+      }
+      if (fNextFile && fNextFile->IsZombie()) {
+         delete fNextFile;
+         fNextFile = nullptr;
+      }
+      TChainElement *element = (TChainElement *)fFiles->At(fNextTreeNumber);
+      if (fNextFile && element) {
+         fNextTree = dynamic_cast<TTree *>(fNextFile->Get(element->GetName()));
+      }
+   }
+}
@@ -132,6 +132,9 @@ There are two types of entry lists:
     except for the last block).
     Individual entry lists can be merged (functions Merge() and Add())
     to make an entry list for a TChain of corresponding TTrees.
+    The entries of an entry list can also be removed with Subtract(), or
+    restricted to the ones of another list with Intersect(). These operations
+    combine the blocks word by word, in parallel if IMT is on.
 Begin_Macro
 entrylist_figure1.C
 End_Macro
@@ -160,9 +163,46 @@ End_Macro
 #include "TRegexp.h"
 #include "TSystem.h"
 #include "TObjString.h"
+#include "TROOT.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <vector>
 
 ClassImp(TEntryList);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(i) for the blocks i in [0, n), and return the sum of the results,
+/// the changes of the number of entries of the blocks. The blocks are
+/// independent: they are processed in parallel if IMT is on.
+
+template <class F>
+Long64_t ForEachBlock(Int_t n, F &&func)
+{
+   Long64_t sum = 0;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && n > 1) {
+      std::vector<Long64_t> results(n);
+      ROOT::TThreadExecutor pool;
+      pool.ParallelFor(0u, n, 1u, [&](std::size_t begin, std::size_t end) {
+         for (auto i = begin; i < end; ++i)
+            results[i] = func(i);
+      });
+      for (auto r : results)
+         sum += r;
+      return sum;
+   }
+#endif
+   for (Int_t i = 0; i < n; i++)
+      sum += func(i);
+   return sum;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// default c-tor
 
@@ -431,14 +471,12 @@ void TEntryList::Add(const TEntryList *elist)
             TEntryListBlock *block2=nullptr;
             Int_t i;
             Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
-            Long64_t nnew, nold;
-            for (i=0; i<nmin; i++){
-               block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
-               block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
-               nold = block1->GetNPassed();
-               nnew = block1->Merge(block2);
-               fN = fN - nold + nnew;
-            }
+            fN += ForEachBlock(nmin, [this, elist](Int_t iblock) -> Long64_t {
+               auto blockThis = (TEntryListBlock*)fBlocks->UncheckedAt(iblock);
+               auto blockOther = (TEntryListBlock*)elist->fBlocks->UncheckedAt(iblock);
+               Long64_t nold = blockThis->GetNPassed();
+               return blockThis->Merge(blockOther) - nold;
+            });
             if (fNBlocks<elist->fNBlocks){
                Int_t nmax = elist->fNBlocks;
                for (i=nmin; i<nmax; i++){
@@ -1341,13 +1379,17 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
-            }
+            //same tree, subtract block by block
+            if (!elist->fBlocks) return;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            fN += ForEachBlock(nmin, [this, elist](Int_t iblock) -> Long64_t {
+               auto blockThis = (TEntryListBlock*)fBlocks->UncheckedAt(iblock);
+               auto blockOther = (TEntryListBlock*)elist->fBlocks->UncheckedAt(iblock);
+               Long64_t nold = blockThis->GetNPassed();
+               return blockThis->Subtract(blockOther) - nold;
+            });
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
@@ -1382,6 +1424,57 @@ void TEntryList::Subtract(const TEntryList *elist)
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all the entries of this entry list, that are not contained in elist
+///
+/// The entries of the trees for which elist has no sub-list are all removed.
+/// The lists for the same tree are intersected block by block.
+
+void TEntryList::Intersect(const TEntryList *elist)
+{
+   if (!fLists){
+      if (!fBlocks) return;
+      //find the list of elist for the same tree as this list
+      const TEntryList *other = nullptr;
+      if (!elist->fLists){
+         if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
+             !strcmp(elist->fFileName.Data(),fFileName.Data()))
+            other = elist;
+      } else {
+         TIter next1(elist->GetLists());
+         TEntryList *templist = nullptr;
+         while ((templist = (TEntryList*)next1())){
+            if (!strcmp(templist->fTreeName.Data(),fTreeName.Data()) &&
+                !strcmp(templist->fFileName.Data(),fFileName.Data())){
+               other = templist;
+               break;
+            }
+         }
+      }
+      //the blocks missing in the other list are intersected with an empty block
+      const TEntryListBlock empty;
+      const Int_t nother = (other && other->fBlocks) ? other->fNBlocks : 0;
+      fN += ForEachBlock(fNBlocks, [&](Int_t iblock) -> Long64_t {
+         auto blockThis = (TEntryListBlock*)fBlocks->UncheckedAt(iblock);
+         auto blockOther = iblock < nother ? (TEntryListBlock*)other->fBlocks->UncheckedAt(iblock) : &empty;
+         Long64_t nold = blockThis->GetNPassed();
+         return blockThis->Intersect(blockOther) - nold;
+      });
+      fLastIndexQueried = -1;
+      fLastIndexReturned = 0;
+   } else {
+      //this list has sublists
+      TIter next2(fLists);
+      TEntryList *templist = nullptr;
+      Long64_t oldn=0;
+      while ((templist = (TEntryList*)next2())){
+         oldn = templist->GetN();
+         templist->Intersect(elist);
+         fN = fN - oldn + templist->GetN();
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TEntryList operator||(TEntryList &elist1, TEntryList &elist2)
@@ -35,9 +35,12 @@ End_Macro
 
 ## Operations on blocks (see also function comments)
 
- - __Merge__() - adds all entries from one block to the other. If the first block
-             uses array representation, it's changed to bits representation only
-             if the total number of passing entries is still less than kBlockSize
+ - __Merge__() - adds all entries from one block to the other
+ - __Subtract__() - removes the entries of the other block from this one
+ - __Intersect__() - keeps only the entries that are also in the other block
+
+   These operations work on whole words of the bits representation, in loops
+   that the compiler vectorizes, and leave the block in its optimal representation.
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
@@ -46,6 +49,34 @@ End_Macro
 #include "TEntryListBlock.h"
 #include "TString.h"
 
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+namespace {
+
+/// Number of bits set in the first n words of bits
+Int_t CountBits(const UShort_t *bits, Int_t n)
+{
+   Int_t count = 0;
+   for (Int_t i = 0; i < n; i++)
+      count += std::bitset<16>(bits[i]).count();
+   return count;
+}
+
+/// Position of the lowest bit set in word, which must not be 0
+Int_t LowestBit(UInt_t word)
+{
+   Int_t j = 0;
+   while ((word & (1u << j)) == 0)
+      j++;
+   return j;
+}
+
+enum EBlockOperation { kUnion, kDifference, kIntersection };
+
+} // anonymous namespace
+
 ClassImp(TEntryListBlock);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -207,33 +238,15 @@ Int_t TEntryListBlock::Contains(Int_t entry)
       return result;
    }
    //list
-   if (entry < fCurrent) fCurrent = 0;
-   if (fPassing && fIndices){
-      for (Int_t i = fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return true;
-         }
-      }
-   } else {
-      if (!fIndices || fNPassed==0){
-         //all entries pass
-         return true;
-      }
-      if (entry > fIndices[fNPassed-1])
-         return true;
-      for (Int_t i= fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return false;
-         }
-         if (fIndices[i]>entry){
-            fCurrent = i;
-            return true;
-         }
-      }
+   if (!fIndices || fNPassed==0){
+      //no entries stored: none pass if fPassing, all pass otherwise
+      return !fPassing;
    }
-   return 0;
+   // the list is sorted
+   const UShort_t *pos = std::lower_bound(fIndices, fIndices + fNPassed, entry);
+   fCurrent = pos - fIndices;
+   bool found = pos != fIndices + fNPassed && *pos == entry;
+   return fPassing ? found : !found;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,127 +255,103 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
+      if (fIndices)
+         delete [] fIndices;
       fN = block->fN;
-      fIndices = new UShort_t[fN];
-      for (i=0; i<fN; i++)
-         fIndices[i] = block->fIndices[i];
+      fIndices = nullptr;
+      if (block->fIndices) {
+         fIndices = new UShort_t[fN];
+         std::memcpy(fIndices, block->fIndices, fN * sizeof(UShort_t));
+      }
       fNPassed = block->fNPassed;
       fType = block->fType;
       fPassing = block->fPassing;
       fCurrent = block->fCurrent;
       fLastIndexReturned = -1;
       fLastIndexQueried = -1;
-      return fNPassed;
+      return GetNPassed();
    }
-   if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
-         }
-      }
+   return Combine(block, kUnion);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries of the other block from this block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(const TEntryListBlock *block)
+{
+   return Combine(block, kDifference);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries of this block which are also in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Intersect(const TEntryListBlock *block)
+{
+   return Combine(block, kIntersection);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Combine the bits of this block with the ones of the other block, word by
+/// word: op is one of kUnion, kDifference and kIntersection.
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Combine(const TEntryListBlock *block, Int_t op)
+{
+   UShort_t bits[kBlockSize];
+   block->GetBits(bits);
+   ToBits();
+   if (op == kUnion) {
+      for (Int_t i = 0; i < kBlockSize; i++)
+         fIndices[i] |= bits[i];
+   } else if (op == kDifference) {
+      for (Int_t i = 0; i < kBlockSize; i++)
+         fIndices[i] &= ~bits[i];
    } else {
-      //stored as a list
-      if (GetNPassed() + block->GetNPassed() > kBlockSize){
-         //change to bits
-         UShort_t *bits = new UShort_t[kBlockSize];
-         Transform(true, bits);
-         Merge(block);
-      } else {
-         //this is only possible if fPassing=1 in both blocks
-         if (block->fType==1){
-            //second block stored as a list
-            //make a bigger list
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            UShort_t *elst = block->fIndices;
-            Int_t newpos, elpos;
-            newpos = elpos = 0;
-            for (i=0; i<fNPassed; i++) {
-               while (elpos < en && fIndices[i] > elst[elpos]) {
-                  newlist[newpos] = elst[elpos];
-                  newpos++;
-                  elpos++;
-               }
-               if (fIndices[i] == elst[elpos]) elpos++;
-               newlist[newpos] = fIndices[i];
-               newpos++;
-            }
-            while (elpos < en) {
-               newlist[newpos] = elst[elpos];
-               newpos++;
-               elpos++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         } else {
-            //second block is stored as bits
-
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            Int_t newpos, current;
-            newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
-                  newpos++;
-               }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
-            }
-            while(current<fNPassed){
-               newlist[newpos] = fIndices[current];
-               newpos++;
-               current++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         }
-      }
+      for (Int_t i = 0; i < kBlockSize; i++)
+         fIndices[i] &= bits[i];
    }
+   fNPassed = CountBits(fIndices, kBlockSize);
+   fCurrent = 0;
    fLastIndexQueried = -1;
    fLastIndexReturned = -1;
    OptimizeStorage();
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the bits representation of the block to bits, an array of kBlockSize
+/// words, whatever the representation of the block is
+
+void TEntryListBlock::GetBits(UShort_t *bits) const
+{
+   if (fType == 0 && fIndices) {
+      std::memcpy(bits, fIndices, kBlockSize * sizeof(UShort_t));
+      return;
+   }
+   std::fill(bits, bits + kBlockSize, fPassing ? 0 : 0xFFFF);
+   if (!fIndices)
+      return;
+   for (Int_t i = 0; i < fNPassed; i++)
+      bits[fIndices[i] >> 4] ^= 1 << (fIndices[i] & 15);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change to the bits representation, allocating the bits of an empty block
+
+void TEntryListBlock::ToBits()
+{
+   if (fType == 0 && fIndices)
+      return;
+   if (!fIndices)
+      fNPassed = 0;
+   Transform(true, new UShort_t[kBlockSize]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -382,16 +371,22 @@ Int_t TEntryListBlock::GetNPassed()
 Int_t TEntryListBlock::GetEntry(Int_t entry)
 {
    if (entry > kBlockSize*16) return -1;
-   if (entry > GetNPassed()) return -1;
+   if (entry >= GetNPassed()) return -1;
    if (entry == fLastIndexQueried+1) return Next();
    else {
       Int_t i=0; Int_t j=0; Int_t entries_found=0;
       if (fType==0){
+         // skip the words before the one holding the entry
+         Int_t nbits = CountBits(fIndices + i, 1);
+         while (entries_found + nbits < entry+1){
+            entries_found += nbits;
+            i++;
+            nbits = CountBits(fIndices + i, 1);
+         }
          if ((fIndices[i] & (1<<j))!=0)
             entries_found++;
          while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
+            j++;
             if ((fIndices[i] & (1<<j))!=0)
                entries_found++;
          }
@@ -454,18 +449,13 @@ Int_t TEntryListBlock::Next()
 
    if (fType==0) {
       //bits
-      Int_t i=0;
-      Int_t j=0;
       fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      bool result=(fIndices[i] & (1<<j))!=0;
-      while (!result) {
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j)) != 0;
-      }
-      fLastIndexReturned = i*16+j;
+      Int_t i = fLastIndexReturned>>4;
+      // mask the bits below the current position, then skip the empty words
+      UInt_t word = fIndices[i] & (0xFFFFu << (fLastIndexReturned & 15));
+      while (!word)
+         word = fIndices[++i];
+      fLastIndexReturned = i*16+LowestBit(word);
       fLastIndexQueried++;
       return fLastIndexReturned;
 
@@ -442,6 +442,7 @@ End_Macro
 #include <climits>
 #include <algorithm>
 #include <set>
+#include <memory>
 
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
@@ -3506,9 +3507,11 @@ namespace {
 ///
 /// Returns number of bytes copied to this tree.
 ///
-/// If 'option' contains the word 'fast' and nentries is -1, the cloning will be
-/// done without unzipping or unstreaming the baskets (i.e., a direct copy of the
-/// raw bytes on disk).
+/// If 'option' contains the word 'fast', the cloning will be done without
+/// unzipping or unstreaming the baskets (i.e., a direct copy of the raw bytes on
+/// disk). If nentries is smaller than the number of entries of tree, only the
+/// entries of the last copied TTree that are in baskets extending beyond
+/// nentries are unzipped and filled again, see CopyEntryRange().
 ///
 /// When 'fast' is specified, 'option' can also contains a sorting order for the
 /// baskets in the output file.
@@ -3579,7 +3582,7 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
       nentries = treeEntries;
    }
 
-   if (fastClone && (nentries < 0 || nentries == tree->GetEntriesFast())) {
+   if (fastClone) {
       // Quickly copy the basket without decompression and streaming.
       Long64_t totbytes = GetTotBytes();
       for (Long64_t i = 0; i < nentries; i += tree->GetTree()->GetEntries()) {
@@ -3597,6 +3600,17 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
                }
             }
          }
+         if (i + tree->GetTree()->GetEntries() > nentries) {
+            // Only the first entries of this tree are copied.
+            if (needCopyAddresses) {
+               tree->SetMakeClass(fMakeClass);
+               CopyAddresses(tree);
+            }
+            CopyEntryRange(tree->GetTree(), 0, nentries - i, option);
+            if (needCopyAddresses)
+               tree->ResetBranchAddresses();
+            break;
+         }
          TTreeCloner cloner(tree->GetTree(), this, option, TTreeCloner::kNoWarnings);
          if (cloner.IsValid()) {
             this->SetEntries(this->GetEntries() + tree->GetTree()->GetEntries());
@@ -3682,6 +3696,69 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
    return nbytes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the entries [first, last) of tree, a TTree and not a TChain, to this
+/// tree. As for CopyEntries(), the branches intended to be copied must already
+/// be connected.
+///
+/// If 'option' contains the word 'fast', the baskets lying entirely in the
+/// range are copied without unzipping or unstreaming them (see TTreeCloner),
+/// and only the entries at the edges of the range, in baskets extending beyond
+/// it, are read and filled again. 'option' can also contain a sorting order of
+/// the baskets, see CloneTree(). When the fast copy is not possible, all the
+/// entries are read and filled.
+///
+/// Returns number of bytes copied to this tree.
+
+Long64_t TTree::CopyEntryRange(TTree *tree, Long64_t first, Long64_t last, Option_t *option /* = "" */)
+{
+   if (!tree) {
+      return 0;
+   }
+   last = TMath::Min(last, tree->GetEntries());
+   if (first >= last) {
+      return 0;
+   }
+   TString opt = option;
+   opt.ToLower();
+   Long64_t totbytes = GetTotBytes();
+
+   // The range of entries copied as raw baskets, empty if none
+   Long64_t rawFirst = last;
+   Long64_t rawLast = last;
+   std::unique_ptr<TTreeCloner> cloner;
+   if (opt.Contains("fast")) {
+      cloner = std::make_unique<TTreeCloner>(tree, this, option, TTreeCloner::kNoWarnings);
+      if (cloner->IsValid()) {
+         rawFirst = first;
+         rawLast = last;
+         cloner->AlignEntryRange(rawFirst, rawLast);
+         if (rawFirst >= rawLast)
+            rawFirst = rawLast = last;
+      }
+   }
+
+   auto fillRange = [this, tree](Long64_t begin, Long64_t end) {
+      for (Long64_t entry = begin; entry < end; ++entry) {
+         if (tree->GetEntry(entry) <= 0) {
+            return false;
+         }
+         this->Fill();
+      }
+      return true;
+   };
+   if (!fillRange(first, rawFirst)) {
+      return GetTotBytes() - totbytes;
+   }
+   if (rawFirst < rawLast && cloner->SetEntryRange(rawFirst, rawLast)) {
+      cloner->Exec();
+   } else {
+      rawLast = rawFirst;
+   }
+   fillRange(rawLast, last);
+   return GetTotBytes() - totbytes;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy a tree with selection.
 ///
@@ -3695,6 +3772,11 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
 /// branch addresses.  When the original tree is deleted, all the
 /// branch addresses of the copied tree are set to zero.
 ///
+/// If option contains "fast" and there is no selection, the baskets lying
+/// entirely within runs of consecutive selected entries are copied without
+/// unzipping them. This makes the skims with an entry list keeping long runs
+/// of entries much faster, see TTreePlayer::CopyTree.
+///
 /// For examples of CopyTree, see the tutorials:
 ///
 /// - copytree.C:
@@ -4344,6 +4426,30 @@ Long64_t TTree::Draw(const char* varexp, const TCut& selection, Option_t* option
 ///
 /// When option contains "norm" the output histogram is normalized to 1.
 ///
+/// ### Compiling the expressions
+///
+/// When option contains "jit", the expressions and the selection are compiled
+/// to native code instead of being interpreted by TTreeFormula. This covers
+/// numerical branches holding a scalar or a one-dimensional array (with
+/// constant indices or the implicit loop over the instances), the arithmetic,
+/// comparison and logical operators, the usual mathematical functions, the
+/// TMath functions, `Iteration$`, `Length$`, `Sum$`, `Min$` and `Max$`. Other
+/// expressions, and outputs other than histograms and graphs, are silently
+/// processed without compilation.
+///
+/// ### Implicit multithreading
+///
+/// When implicit multithreading is enabled (see ROOT::EnableImplicitMT) and
+/// the tree is read from files, the clusters are processed in parallel
+/// provided the result doesn't depend on the order of the entries: when
+/// filling a histogram with fixed axes, e.g. `tree.Draw("pt>>h(100,0,50)")`,
+/// or, for a TTree, a TEntryList or a TEventList. The contents of the
+/// histogram are the same as in the sequential loop, up to the rounding of
+/// the sums of weights, but the values returned by TTree::GetVal are not in
+/// the order of the entries. Drawing with automatic axis ranges, to graphs, or
+/// with a TEntryList set on the tree is sequential, as are chains whose trees
+/// have individual weights.
+///
 /// ### Saving the result of Draw to a TEventList, a TEntryList or a TEntryListArray
 ///
 /// TTree::Draw can be used to fill a TEventList object (list of entry numbers)
@@ -4600,6 +4706,12 @@ void TTree::DropBuffers(Int_t)
 /// \note This method calls `TTree::ChangeFile` when the tree reaches a size
 ///       greater than `TTree::fgMaxTreeSize`. This doesn't happen if the tree is
 ///       attached to a `TMemFile` or derivate.
+///
+/// \note If implicit multi-threading is enabled and SetParallelFill() was
+///       called, the top-level branches are streamed into their baskets
+///       concurrently, in contiguous groups of branches per task. Full baskets
+///       are written out by the task that filled them. This is not done if the
+///       tree has a TBranchRef, because TRef's are resolved through global state.
 
 Int_t TTree::Fill()
 {
@@ -4624,6 +4736,32 @@ Int_t TTree::Fill()
       fIMTZipBytes.store(0);
       fIMTTotBytes.store(0);
    }
+
+   // The top-level branches do not share any buffers, so they can be streamed
+   // concurrently; the results are checked in the sequential loop below.
+   const auto nthreads = static_cast<Int_t>(ROOT::GetThreadPoolSize());
+   const bool parallelFill = useIMT && fIMTParallelFill && !fBranchRef && nbranches > 1 && nthreads > 1;
+   std::vector<Int_t> nwritten;
+   if (parallelFill) {
+      nwritten.assign(nbranches, 0);
+      // A few groups per thread balance the load without paying for one task per branch.
+      const Int_t ntasks = std::min(nbranches, 4 * nthreads);
+      std::atomic<Int_t> pos(0);
+
+      auto fillFunction = [&]() {
+         Int_t j = pos.fetch_add(1);
+         const Int_t first = Long64_t(j) * nbranches / ntasks;
+         const Int_t last = Long64_t(j + 1) * nbranches / ntasks;
+         for (Int_t i = first; i < last; ++i) {
+            TBranch *branch = (TBranch *)fBranches.UncheckedAt(i);
+            if (!branch->TestBit(kDoNotProcess))
+               nwritten[i] = branch->FillImpl(nullptr);
+         }
+      };
+
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(fillFunction, ntasks);
+   }
 #endif
 
    for (Int_t i = 0; i < nbranches; ++i) {
@@ -4636,7 +4774,7 @@ Int_t TTree::Fill()
 #ifndef R__USE_IMT
       nwrite = branch->FillImpl(nullptr);
 #else
-      nwrite = branch->FillImpl(useIMT ? &imtHelper : nullptr);
+      nwrite = parallelFill ? nwritten[i] : branch->FillImpl(useIMT ? &imtHelper : nullptr);
 #endif
       if (nwrite < 0) {
          if (nerror < 2) {
@@ -7171,6 +7309,80 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Choose the branch buffer sizes and the cluster size with a cost model of the
+/// way the tree is going to be read.
+///
+/// This function may be called after having filled a representative sample of
+/// entries. From the branch buffers written so far it measures, for every branch
+/// holding data, the uncompressed size per entry and the compression factor.
+/// The model (see ROOT::TBasketCostModel) then predicts the read time for the
+/// given read pattern, compression algorithm and storage latency, and picks the
+/// basket sizes and the cluster size that minimize it within the memory limit
+/// of the model. The basket sizes are set on the branches and the cluster size
+/// is set with SetAutoFlush().
+///
+/// Returns the chosen settings together with the predicted read cost of each
+/// branch. If option ="d" the predicted cost per branch is printed.
+
+ROOT::TBasketCostModel::TResult TTree::OptimizeBaskets(const ROOT::TBasketCostModel &model, Option_t *option)
+{
+   //Flush existing baskets if the file is writable
+   if (this->GetDirectory()->IsWritable()) this->FlushBasketsImpl();
+
+   TString opt( option );
+   opt.ToLower();
+   bool pDebug = opt.Contains("d");
+
+   // Collect the branches holding data; the leaves of a branch are next to each other.
+   std::vector<TBranch *> branches;
+   std::vector<ROOT::TBasketCostModel::TBranchStats> stats;
+   TIter next(GetListOfLeaves());
+   TLeaf *leaf = nullptr;
+   while ((leaf = (TLeaf *)next())) {
+      TBranch *branch = leaf->GetBranch();
+      if ((!branches.empty() && branches.back() == branch) || branch->GetListOfBranches()->GetEntries() > 0)
+         continue;
+      if (branch->GetEntries() == 0 || branch->GetTotBytes() == 0)
+         continue;
+      ROOT::TBasketCostModel::TBranchStats s;
+      s.fName = branch->GetName();
+      s.fBytesPerEntry = Double_t(branch->GetTotBytes()) / branch->GetEntries();
+      if (branch->GetZipBytes() > 0)
+         s.fCompressionFactor = Double_t(branch->GetTotBytes()) / branch->GetZipBytes();
+      s.fCompressionAlgorithm = branch->GetCompressionAlgorithm();
+      s.fCompressionLevel = branch->GetCompressionLevel();
+      branches.push_back(branch);
+      stats.push_back(s);
+   }
+   if (branches.empty()) {
+      // We're being called too early, we really have nothing to do ...
+      return ROOT::TBasketCostModel::TResult();
+   }
+
+   auto result = model.Optimize(stats);
+   for (std::size_t i = 0; i < branches.size(); ++i) {
+      const auto &cost = result.fBranches[i];
+      Int_t newBsize = cost.fBasketSize;
+      // The entry offsets are stored in the same buffer as the object data.
+      if (branches[i]->GetEntryOffsetLen()) {
+         newBsize += Int_t(cost.fEntriesPerBasket) * sizeof(Int_t) * 2;
+         newBsize = newBsize - newBsize % 512 + 512;
+      }
+      if (pDebug)
+         Info("OptimizeBaskets", "Changing buffer size from %6d to %6d bytes for %s, predicted read cost %.3g s/entry\n",
+              branches[i]->GetBasketSize(), newBsize, branches[i]->GetName(), cost.GetTime());
+      branches[i]->SetBasketSize(newBsize);
+   }
+   SetAutoFlush(result.fClusterSize);
+
+   if (pDebug) {
+      Info("OptimizeBaskets", "cluster size = %lld entries, memory = %llu bytes\n", result.fClusterSize, result.fMemory);
+      Info("OptimizeBaskets", "predicted read cost = %.3g s/entry\n", result.fTimePerEntry);
+   }
+   return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to the Principal Components Analysis class.
 ///
@@ -299,6 +299,8 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TMath.h"
 #include "TBranchCacheInfo.h"
 #include "TVirtualPerfStats.h"
+#include "ROOT/RTrace.hxx"
+#include <algorithm>
 #include <climits>
 
 #include <memory>
@@ -324,6 +326,7 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
    fEntryNext = fEntryMin + fgLearnEntries;
    Int_t nleaves = tree->GetListOfLeaves()->GetEntriesFast();
    fBranches = new TObjArray(nleaves);
+   fMemoryBudget = (Long64_t)gEnv->GetValue("TTreeCache.MemoryBudget", 0.);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1113,6 +1116,7 @@ struct BasketRanges {
 
 bool TTreeCache::FillBuffer()
 {
+   R__TRACE_SCOPE("io", "TTreeCache::FillBuffer");
 
    if (fNbranches <= 0) return false;
    TTree *tree = ((TBranch*)fBranches->UncheckedAt(0))->GetTree();
@@ -1231,6 +1235,10 @@ bool TTreeCache::FillBuffer()
    // the end of the training phase).
    if (fEntryCurrent <= entry && entry < fEntryNext) return false;
 
+   // Resize the cache for the branches that are now cached.
+   if (fMemoryBudget > 0 && fBranchQuota.size() != (std::size_t)fNbranches)
+      UpdateMemoryBudget();
+
    // Triggered by the user, not the learning phase
    if (entry == -1)
       entry = 0;
@@ -1334,11 +1342,14 @@ bool TTreeCache::FillBuffer()
    Long64_t maxReadEntry = minEntry; // If we are stopped before the end of the 2nd pass, this marker will where we need to start next time.
    Int_t nReadPrefRequest = 0;
    auto perfStats = GetTree()->GetPerfStats();
+   bool quotaReached = false;          // A branch used up its share of the memory budget
+   Long64_t quotaEntryNext = fEntryMax; // First entry of the first basket left out because of the quota
 
    struct collectionInfo {
       Int_t fClusterStart{-1}; // First basket belonging to the current cluster
       Int_t fCurrent{-1};       // Currently visited basket
       bool fLoadedOnce{false};
+      Long64_t fBytes{0};       // Bytes registered for this branch
 
       void Rewind() { fCurrent = (fClusterStart >= 0) ? fClusterStart : 0; }
    };
@@ -1371,7 +1382,7 @@ bool TTreeCache::FillBuffer()
       auto CollectBaskets = [this, elist, chainOffset, entry, clusterIterations, resetBranchInfo, perfStats,
        &cursor, &lowestMaxEntry, &maxReadEntry, &minEntry,
        &reachedEnd, &skippedFirst, &oncePerBranch, &nDistinctLoad, &progress,
-       &ranges, &memRanges, &reqRanges,
+       &ranges, &memRanges, &reqRanges, &quotaReached, &quotaEntryNext,
        &ntotCurrentBuf, &nReadPrefRequest](EPass pass, ENarrow narrow, Long64_t maxCollectEntry) {
          // The first pass we add one basket per branches around the requested entry
          // then in the second pass we add the other baskets of the cluster.
@@ -1535,6 +1546,20 @@ bool TTreeCache::FillBuffer()
                   }
                }
 
+               if (cursor[i].fLoadedOnce && i < (Int_t)fBranchQuota.size() &&
+                   cursor[i].fBytes + len > fBranchQuota[i]) {
+                  // This branch used up its share of the memory budget; leave its
+                  // remaining baskets for the next refill rather than taking the
+                  // space of the other branches.
+                  if (showMore || gDebug > 5)
+                     Info("FillBuffer", "Branch %s reached its quota of %lld bytes at basket %d", b->GetName(),
+                          fBranchQuota[i], j);
+                  quotaReached = true;
+                  if (entries[j] > entry && entries[j] < quotaEntryNext)
+                     quotaEntryNext = entries[j];
+                  break; // Without consuming the basket.
+               }
+
                if (((Long64_t)ntotCurrentBuf + len) > fBufferSizeMin) {
                   // Humm ... we are going to go over the requested size.
                   if (clusterIterations > 0 && cursor[i].fLoadedOnce) {
@@ -1550,6 +1575,16 @@ bool TTreeCache::FillBuffer()
                      fEntryNext = minEntry;
                      filled = true;
                      break;
+                  } else if (fMemoryBudget > 0 && cursor[i].fLoadedOnce) {
+                     // The memory budget is a hard limit: do not go over it to
+                     // even out the range of the branches.
+                     if (showMore || gDebug > 5) {
+                        Info("FillBuffer", "Breaking early because %lld is greater than the budget %d at pass %d",
+                             ((Long64_t)ntotCurrentBuf + len), fBufferSizeMin, pass);
+                     }
+                     fEntryNext = maxReadEntry;
+                     filled = true;
+                     break;
                   } else {
                      if (pass == kStart || !cursor[i].fLoadedOnce) {
                         if (((Long64_t)ntotCurrentBuf + len) > 4LL * fBufferSizeMin) {
@@ -1600,6 +1635,7 @@ bool TTreeCache::FillBuffer()
                   cursor[i].fLoadedOnce = true;
                   ++nDistinctLoad;
                }
+               cursor[i].fBytes += len;
                if (R__unlikely(perfStats)) {
                   perfStats->SetLoaded(i, j);
                }
@@ -1714,7 +1750,9 @@ bool TTreeCache::FillBuffer()
       // be 'large' (i.e. 30Mb * 300 intervals) and can overflow the numerical limit of Int_t (i.e. become
       // artificially negative).   To avoid this issue we promote ntotCurrentBuf to a long long (64 bits rather than 32
       // bits)
-      if (!((fBufferSizeMin > ((Long64_t)ntotCurrentBuf * (clusterIterations + 1)) / clusterIterations) &&
+      // With a memory budget, we also stop as soon as one branch is out of its share.
+      if (quotaReached ||
+          !((fBufferSizeMin > ((Long64_t)ntotCurrentBuf * (clusterIterations + 1)) / clusterIterations) &&
             (prevNtot < ntotCurrentBuf) && (minEntry < fEntryMax))) {
          if (showMore || gDebug > 6)
             Info("FillBuffer", "Breaking because %d <= %lld || (%d >= %d) || %lld >= %lld", fBufferSizeMin,
@@ -1735,6 +1773,11 @@ bool TTreeCache::FillBuffer()
       fNextClusterStart = fEntryNext;
    } while (true);
 
+   if (quotaEntryNext < fEntryNext) {
+      // Refill from the first basket that was left out because of a branch quota.
+      fEntryNext = quotaEntryNext;
+   }
+
    if (showMore || gDebug > 6) {
       Info("FillBuffer", "Mem ranges");
       memRanges.Print();
@@ -1794,6 +1837,78 @@ bool TTreeCache::FillBuffer()
    return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the cache with the baskets of the cached branches holding the given
+/// entries, rather than with whole clusters.
+///
+/// This serves sparse or out-of-order reads whose entries are known in advance,
+/// for instance the entries of a friend tree looked up through its index (see
+/// TTreeIndex::LookAheadFriend). The entries must be sorted in increasing order.
+/// Their baskets are registered in that order until the cache is full, and all
+/// of them are read in one go, in file order, at the next cache lookup.
+///
+/// Returns the number of leading entries whose baskets are all in the cache
+/// (or already in memory). Nothing is done, and 0 is returned, during the
+/// learning phase, when prefetching is enabled and for a TTreeCacheUnzip,
+/// which keeps its own bookkeeping of the buffer; the regular filling of the
+/// cache then applies.
+
+Long64_t TTreeCache::FillBufferForEntries(const std::vector<Long64_t> &entries)
+{
+   if (fNbranches <= 0 || entries.empty() || fIsLearning || fEnablePrefetching || IsA() != TTreeCache::Class())
+      return 0;
+
+   TTreeCache::ResetCache();
+
+   std::vector<Int_t> lastBasket(fNbranches, -1);
+   Long64_t ncovered = 0;
+   Int_t nReadPrefRequest = 0;
+   bool full = false;
+   for (auto entry : entries) {
+      for (Int_t i = 0; i < fNbranches && !full; ++i) {
+         TBranch *b = (TBranch *)fBranches->UncheckedAt(i);
+         if (b->GetDirectory() == nullptr || b->TestBit(TBranch::kDoNotProcess))
+            continue;
+         if (b->GetDirectory()->GetFile() != fFile)
+            continue;
+         Int_t *lbaskets = b->GetBasketBytes();
+         Long64_t *bentries = b->GetBasketEntry();
+         if (!lbaskets || !bentries)
+            continue;
+         // The entries are sorted, so are the baskets holding them.
+         const Int_t j = TMath::BinarySearch(b->GetWriteBasket() + 1, bentries, entry);
+         if (j < 0 || j == lastBasket[i])
+            continue;
+         lastBasket[i] = j;
+         // This basket has already been read
+         if (j < b->GetListOfBaskets()->GetSize() && b->GetListOfBaskets()->UncheckedAt(j))
+            continue;
+         const Long64_t pos = b->GetBasketSeek(j);
+         const Int_t len = lbaskets[j];
+         if (pos <= 0 || len <= 0)
+            continue;
+         if ((Long64_t)fNtot + len > fBufferSizeMin) {
+            full = true;
+            break;
+         }
+         TFileCacheRead::Prefetch(pos, len);
+         b->fCacheInfo.SetIsInCache(j);
+         ++nReadPrefRequest;
+      }
+      if (full)
+         break;
+      ++ncovered;
+   }
+
+   if (ncovered > 0) {
+      // Misses within this range are read directly instead of refilling the cache.
+      fEntryCurrent = entries.front();
+      fEntryNext = entries[ncovered - 1] + 1;
+   }
+   fNReadPref += nReadPrefRequest;
+   return ncovered;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the desired prefill type from the environment or resource variable
 /// - 0 - No prefill
@@ -1867,6 +1982,19 @@ Double_t TTreeCache::GetMissEfficiencyRel() const
    return static_cast<double>(fNMissReadOk) / static_cast<double>(fNMissReadOk + fNMissReadMiss);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the share of the cache, in bytes, that branch b may use when the
+/// cache is filled, or 0 if there is no memory budget or b is not cached.
+
+Long64_t TTreeCache::GetBranchQuota(const TBranch *b) const
+{
+   for (std::size_t i = 0; i < fBranchQuota.size(); ++i) {
+      if (fBranches->UncheckedAt(i) == b)
+         return fBranchQuota[i];
+   }
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static function returning the number of entries used to train the cache
 /// see SetLearnEntries
@@ -1908,6 +2036,8 @@ void TTreeCache::Print(Option_t *option) const
    printf("Secondary Efficiency ..............: %f\n", GetMissEfficiency());
    printf("Secondary Efficiency Rel ..........: %f\n", GetMissEfficiencyRel());
    printf("Learn entries......................: %d\n",TTreeCache::GetLearnEntries());
+   if (fMemoryBudget > 0)
+      printf("Memory budget......................: %lld\n", fMemoryBudget);
    if ( opt.Contains("cachedbranches") ) {
       opt.ReplaceAll("cachedbranches","");
       printf("Cached branches....................:\n");
@@ -2162,6 +2292,32 @@ void TTreeCache::SetLearnPrefill(TTreeCache::EPrefillType type /* = kNoPrefill *
    fPrefillType = type;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Limit the memory used by the cache to budget bytes; 0 removes the limit.
+///
+/// Without a budget, the size of the cache is set by TTree::SetCacheSize,
+/// by default from the compressed size of a cluster of the whole tree, and the
+/// cache may temporarily hold up to four times that size to get at least one
+/// basket of every branch. With a budget, the cache is sized when it is first
+/// filled after the learning phase, and for every new tree of a TChain, to
+/// 1.5 times the compressed size of a cluster of the cached branches only,
+/// but never more than the budget. This size is then a hard limit, except for
+/// the first basket of each branch. Each cached branch gets a share of the
+/// cache proportional to its compressed size, i.e. to the bytes it reads; a
+/// branch that has used up its share leaves its next baskets for the next
+/// refill, so that a few large branches do not push the others out of the
+/// cache. The default budget can be set with the rootrc variable
+/// `TTreeCache.MemoryBudget`.
+///
+/// To reduce the number of read requests when the cached baskets are
+/// not adjacent on file, see also TFileCacheRead::SetMaxGap.
+
+void TTreeCache::SetMemoryBudget(Long64_t budget)
+{
+   fMemoryBudget = budget > 0 ? budget : 0;
+   fBranchQuota.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The name should be enough to explain the method.
 /// The only additional comments is that the cache is cleaned before
@@ -2173,6 +2329,7 @@ void TTreeCache::StartLearningPhase()
    fIsManual = false;
    fNbranches  = 0;
    if (fBrNames) fBrNames->Delete();
+   fBranchQuota.clear();
    fIsTransferred = false;
    fEntryCurrent = -1;
 }
@@ -2239,11 +2396,57 @@ void TTreeCache::UpdateBranches(TTree *tree)
       fNbranches++;
    }
 
+   fBranchQuota.clear();
+
    auto perfStats = GetTree()->GetPerfStats();
    if (perfStats)
       perfStats->UpdateBranchIndices(fBranches);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the size of the cache and the share of each cached branch from the
+/// compressed size of the cached branches and the memory budget, see
+/// SetMemoryBudget.
+
+void TTreeCache::UpdateMemoryBudget()
+{
+   fBranchQuota.clear();
+   if (fMemoryBudget <= 0 || fNbranches <= 0)
+      return;
+
+   TTree *tree = ((TBranch *)fBranches->UncheckedAt(0))->GetTree();
+   const Long64_t nentries = tree->GetEntries();
+   if (nentries <= 0)
+      return;
+   TTree::TClusterIterator clusterIter = tree->GetClusterIterator(fEntryMin);
+   const Long64_t clusterStart = clusterIter();
+   const Long64_t clusterEntries = std::max(clusterIter.GetNextEntry() - clusterStart, (Long64_t)1);
+
+   std::vector<Double_t> zipBytes(fNbranches);
+   Double_t totZipBytes = 0;
+   for (Int_t i = 0; i < fNbranches; ++i) {
+      TBranch *b = (TBranch *)fBranches->UncheckedAt(i);
+      zipBytes[i] = b->GetZipBytes();
+      totZipBytes += zipBytes[i];
+   }
+
+   // Same margin as TTree::GetCacheAutoSize, for clusters larger than the first one.
+   const Double_t clusterBytes = 1.5 * totZipBytes * clusterEntries / nentries;
+   const Long64_t size = std::min<Long64_t>(fMemoryBudget, (Long64_t)clusterBytes);
+   SetBufferSize(size);
+
+   // SetBufferSize clamps the size, so use the actual one.
+   const Long64_t bufferSize = fBufferSizeMin;
+   fBranchQuota.resize(fNbranches);
+   for (Int_t i = 0; i < fNbranches; ++i) {
+      fBranchQuota[i] = (totZipBytes > 0) ? (Long64_t)(bufferSize * zipBytes[i] / totZipBytes)
+                                          : bufferSize / fNbranches;
+   }
+   if (gDebug > 0)
+      Info("UpdateMemoryBudget", "Cache size set to %lld bytes for %d branches (budget %lld bytes)", bufferSize,
+           fNbranches, fMemoryBudget);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Perform an initial prefetch, attempting to read as much of the learning
 /// phase baskets for all branches at once
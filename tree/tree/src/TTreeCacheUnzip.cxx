@@ -33,6 +33,7 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <algorithm>
 #include <memory>
 
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
@@ -42,8 +43,8 @@ TTreeCacheUnzip::EParUnzipMode TTreeCacheUnzip::fgParallel = TTreeCacheUnzip::kD
 
 // The unzip cache does not consume memory by itself, it just allocates in advance
 // mem blocks which are then picked as they are by the baskets.
-// Hence there is no good reason to limit it too much
-Double_t TTreeCacheUnzip::fgRelBuffSize = .5;
+// It bounds how far the unzipping tasks run ahead of the reader.
+Double_t TTreeCacheUnzip::fgRelBuffSize = 2.;
 
 ClassImp(TTreeCacheUnzip);
 
@@ -163,6 +164,9 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipNext(0),
+   fUnzipPending(0),
+   fNUnzipTasks(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
@@ -182,6 +186,9 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipNext(0),
+   fUnzipPending(0),
+   fNUnzipTasks(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
@@ -270,7 +277,6 @@ bool TTreeCacheUnzip::FillBuffer()
    if (fNbranches <= 0) return false;
 
    // Fill the cache buffer with the branches in the cache.
-   fIsTransferred = false;
 
    TTree *tree = ((TBranch*)fBranches->UncheckedAt(0))->GetTree();
    Long64_t entry = tree->GetReadEntry();
@@ -305,8 +311,13 @@ bool TTreeCacheUnzip::FillBuffer()
       }
    }
 
+   // The unzipping tasks read from the cache buffer, so they must be finished before it is refilled
+   StopTasks();
+   fIsTransferred = false;
+
    //clear cache buffer
    TFileCacheRead::Prefetch(0,0);
+   fUnzipEntry.clear();
 
    //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
@@ -338,6 +349,7 @@ bool TTreeCacheUnzip::FillBuffer()
          fNReadPref++;
 
          TFileCacheRead::Prefetch(pos, len);
+         fUnzipEntry.push_back(entries[j]);
       }
       if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
    }
@@ -359,6 +371,7 @@ bool TTreeCacheUnzip::FillBuffer()
 
 Int_t TTreeCacheUnzip::SetBufferSize(Long64_t buffersize)
 {
+   StopTasks();
    Int_t res = TTreeCache::SetBufferSize(buffersize);
    if (res < 0) {
       return res;
@@ -501,9 +514,14 @@ Int_t TTreeCacheUnzip::GetRecordHeader(char *buf, Int_t maxbytes, Int_t &nbytes,
 
 void TTreeCacheUnzip::ResetCache()
 {
+   StopTasks();
+
    // Reset all the lists and wipe all the chunks
    fCycle++;
    fUnzipState.Clear(fNseekMax);
+   fUnzipOrder.clear();
+   fUnzipBufferPos.clear();
+   fUnzipPending = 0;
 
    if(fNseekMax < fNseek){
       if (gDebug > 0)
@@ -523,52 +541,42 @@ void TTreeCacheUnzip::ResetCache()
 /// in fUnzipStatus to exclusively unzip the basket, we must update
 /// fUnzipStatus after fUnzipChunks and fUnzipLen and make sure fUnzipChunks
 /// and fUnzipLen are ready before main thread fetch the data.
+///
+/// If the baskets have been transferred into the cache buffer, the zipped
+/// basket is unzipped in place without taking the I/O mutex. This is safe
+/// because the cache buffer is only refilled after all unzipping tasks
+/// have been stopped, see StopTasks().
 
 Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 {
-   Int_t myCycle;
    const Int_t hlen = 128;
    Int_t objlen = 0, keylen = 0;
    Int_t nbytes = 0;
-   Int_t readbuf = 0;
 
-   Long64_t rdoffs = 0;
-   Int_t rdlen = 0;
-
-   // To synchronize with the 'paging'
-   myCycle = fCycle;
-   rdoffs = fSeek[index];
-   rdlen = fSeekLen[index];
-
-   Int_t loc = -1;
-   if (!fNseek || fIsLearning) {
-      return 1;
-   }
-
-   if ((myCycle != fCycle) || !fIsTransferred)  {
+   if (!fNseek || fIsLearning || !fIsTransferred) {
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
       return 1;
    }
 
-   // Prepare a memory buffer of adequate size
-   char* locbuff = nullptr;
-   if (rdlen > 16384) {
-      locbuff = new char[rdlen];
-   } else if (rdlen * 3 < 16384) {
-      locbuff = new char[rdlen * 2];
-   } else {
-      locbuff = new char[16384];
-   }
+   Long64_t rdoffs = fSeek[index];
+   Int_t rdlen = fSeekLen[index];
 
-   readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
-
-   if (readbuf <= 0) {
-      fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-      if (locbuff) delete [] locbuff;
-      return -1;
+   char *src = nullptr;
+   std::unique_ptr<char[]> locbuff;
+   if ((index < (Int_t)fUnzipBufferPos.size()) && (fUnzipBufferPos[index] >= 0)) {
+      src = fBuffer + fUnzipBufferPos[index];
+   } else {
+      // Fall back to a copy through the file cache, e.g. with asynchronous reading
+      Int_t loc = -1;
+      locbuff.reset(new char[std::max(rdlen, hlen)]);
+      if (ReadBufferExt(locbuff.get(), rdoffs, rdlen, loc) <= 0) {
+         fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
+         return -1;
+      }
+      src = locbuff.get();
    }
 
-   GetRecordHeader(locbuff, hlen, nbytes, objlen, keylen);
+   GetRecordHeader(src, hlen, nbytes, objlen, keylen);
 
    Int_t len = (objlen > nbytes - keylen) ? keylen + objlen : nbytes;
    // If the single unzipped chunk is really too big, reset it to not processable
@@ -576,24 +584,19 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    // This block will be unzipped synchronously in the main thread
    // TODO: ROOT internally breaks zipped buffers into 16MB blocks, we can probably still unzip in parallel.
    if (len > 4 * fUnzipBufferSize) {
-           if (gDebug > 0)
-                   Info("UnzipCache", "Block %d is too big, skipping.", index);
+      if (gDebug > 0)
+         Info("UnzipCache", "Block %d is too big, skipping.", index);
 
-           fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-           if (locbuff) delete [] locbuff;
-           return 0;
+      fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
+      return 0;
    }
 
    // Unzip it into a new blk
    char *ptr = nullptr;
-   Int_t loclen = UnzipBuffer(&ptr, locbuff);
+   Int_t loclen = UnzipBuffer(&ptr, src);
    if ((loclen > 0) && (loclen == objlen + keylen)) {
-      if ((myCycle != fCycle) || !fIsTransferred) {
-         fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-         if (locbuff) delete [] locbuff;
-         delete [] ptr;
-         return 1;
-      }
+      // Account for the block before publishing it, the reader subtracts it again when it picks the block
+      fUnzipPending += loclen;
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
       fNUnzip++;
    } else {
@@ -601,56 +604,147 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
       delete [] ptr;
    }
 
-   if (locbuff) delete [] locbuff;
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if there are baskets left to be unzipped and the unzipped
+/// baskets not yet consumed by the reader do not exceed fUnzipBufferSize.
+
+bool TTreeCacheUnzip::CanUnzipAhead() const
+{
+   return (fUnzipNext.load() < (Int_t)fUnzipOrder.size()) && (fUnzipPending.load() < fUnzipBufferSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Claim the next basket in reading order that is still untouched.
+/// Returns its index or -1 if there is no such basket or if the unzipping
+/// tasks are too far ahead of the reader.
+
+Int_t TTreeCacheUnzip::ClaimNextBasket()
+{
+   const Int_t nOrder = fUnzipOrder.size();
+   while (CanUnzipAhead()) {
+      Int_t next = fUnzipNext.fetch_add(1);
+      if (next >= nOrder)
+         return -1;
+      Int_t index = fUnzipOrder[next];
+      if (fUnzipState.TryUnzipping(index))
+         return index;
+   }
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop claiming new baskets and wait for the running unzipping tasks.
+/// Must be called by the main thread before the cache buffer or the
+/// unzipping state is modified.
+
+void TTreeCacheUnzip::StopTasks()
+{
 #ifdef R__USE_IMT
+   if (!fUnzipTaskGroup)
+      return;
+   fUnzipNext.store(fUnzipOrder.size());
+   fUnzipTaskGroup->Cancel();
+   fUnzipTaskGroup.reset();
+   // Tasks that were cancelled before they started did not unregister themselves
+   fNUnzipTasks.store(0);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// Account for an unzipped basket picked by the reader and restart the
+/// unzipping tasks if they stopped because they were too far ahead.
+/// Returns the length of the unzipped basket.
 
-Int_t TTreeCacheUnzip::CreateTasks()
+Int_t TTreeCacheUnzip::ConsumeUnzipped(Int_t index)
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
-         // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
-
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
-         }
-         return nullptr;
-      };
-
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
+   const Int_t len = fUnzipState.fUnzipLen[index];
+   fUnzipPending -= len;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && (fNUnzipTasks.load() == 0) && CanUnzipAhead())
+      StartTasks();
+#endif
+   return len;
+}
+
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// Launch the unzipping tasks on the baskets of fUnzipOrder that are not yet
+/// claimed. Every task claims one basket at a time, so that the work is
+/// balanced across all the threads of the pool. A task exits once it is
+/// fUnzipBufferSize ahead of the reader; GetUnzipBuffer() restarts the tasks
+/// when the reader catches up.
+
+void TTreeCacheUnzip::StartTasks()
+{
+   auto unzipFunction = [this]() {
+      do {
+         Int_t index;
+         while ((index = ClaimNextBasket()) >= 0) {
+            if (UnzipCache(index) && gDebug > 0)
+               Info("UnzipCache", "Unzipping failed or cache is in learning state");
          }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
-      }
-      ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
+         fNUnzipTasks--;
+         // The reader may have consumed baskets after the last claim failed but before
+         // the task count was decremented, in which case it did not restart any task.
+      } while (CanUnzipAhead() && (fNUnzipTasks++, true));
    };
 
-   fUnzipTaskGroup = std::make_unique<ROOT::Experimental::TTaskGroup>();
-   fUnzipTaskGroup->Run(mapFunction);
+   if (!CanUnzipAhead())
+      return;
+
+   // Do not spawn more tasks than there are groups of fUnzipGroupSize bytes to unzip
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+   Long64_t totsz = 0;
+   for (Int_t i = fUnzipNext.load(); i < (Int_t)fUnzipOrder.size(); ++i)
+      totsz += fSeekLen[fUnzipOrder[i]];
+   Int_t nTasks = std::max(1, (Int_t)std::min<Long64_t>(ROOT::GetThreadPoolSize(), totsz / fUnzipGroupSize));
+
+   if (!fUnzipTaskGroup)
+      fUnzipTaskGroup = std::make_unique<ROOT::Experimental::TTaskGroup>();
+   for (Int_t i = 0; i < nTasks; ++i) {
+      fNUnzipTasks++;
+      fUnzipTaskGroup->Run(unzipFunction);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the unzip-ahead pipeline for the baskets in the cache and start
+/// the unzipping tasks. The baskets are unzipped in the order of their first
+/// entry, so that the baskets of all branches advance together with the
+/// reader and every branch has its next baskets unzipped ahead of time.
+
+Int_t TTreeCacheUnzip::CreateTasks()
+{
+   StopTasks();
+
+   if (fNseekMax < fNseek) {
+      fUnzipState.Reset(fNseekMax, fNseek);
+      fNseekMax = fNseek;
+   }
+
+   fUnzipOrder.resize(fNseek);
+   for (Int_t i = 0; i < fNseek; ++i)
+      fUnzipOrder[i] = i;
+   if ((Int_t)fUnzipEntry.size() >= fNseek) {
+      std::stable_sort(fUnzipOrder.begin(), fUnzipOrder.end(),
+                       [this](Int_t a, Int_t b) { return fUnzipEntry[a] < fUnzipEntry[b]; });
+   }
+
+   // Locate the zipped baskets in the cache buffer, if it has been filled by a vectored read
+   fUnzipBufferPos.assign(fNseek, -1);
+   if (fIsSorted && fIsTransferred && fBuffer && !fAsyncReading && !fEnablePrefetching && !fFile->GetCacheWrite()) {
+      for (Int_t i = 0; i < fNseek; ++i) {
+         Int_t loc = (Int_t)TMath::BinarySearch(fNseek, fSeekSort, fSeek[i]);
+         if ((loc >= 0) && (fSeekSort[loc] == fSeek[i]) && (fSeekSortLen[loc] >= fSeekLen[i]))
+            fUnzipBufferPos[i] = fSeekPos[loc];
+      }
+   }
+
+   fUnzipNext = 0;
+   StartTasks();
 
    return 0;
 }
@@ -688,6 +782,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, bool
          if (gDebug > 0)
             Info("GetUnzipBuffer", "Changing fNseekMax from:%d to:%d", fNseekMax, fNseek);
 
+         StopTasks();
          fUnzipState.Reset(fNseekMax, fNseek);
          fNseekMax = fNseek;
       }
@@ -716,7 +811,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, bool
                }
 
                fNFound++;
-               return fUnzipState.fUnzipLen[seekidx];
+               return ConsumeUnzipped(seekidx);
             }
 
             // If the requested basket is being unzipped by a background task, we try to steal a blk to unzip.
@@ -724,15 +819,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, bool
 
             if (fUnzipState.IsProgress(seekidx)) {
                if (fEmpty) {
-                  for (Int_t ii = 0; ii < fNseek; ++ii) {
-                     Int_t idx = (seekidx + 1 + ii) % fNseek;
-                     if (fUnzipState.IsUntouched(idx)) {
-                        if(fUnzipState.TryUnzipping(idx)) {
-                           reqi = idx;
-                           break;
-                        }
-                     }
-                  }
+                  reqi = ClaimNextBasket();
                   if (reqi < 0) {
                      fEmpty = false;
                   } else {
@@ -765,7 +852,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, bool
             }
 
             fNStalls++;
-            return fUnzipState.fUnzipLen[seekidx];
+            return ConsumeUnzipped(seekidx);
          } else {
             // This is a complete miss. We want to avoid the background tasks
             // to try unzipping this block in the future.
@@ -792,12 +879,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, bool
    res = 0;
    if (!ReadBufferExt(fCompBuffer, pos, len, loc)) {
       // Cache is invalidated and we need to wait for all unzipping tasks to be finished before fill new baskets in cache.
-#ifdef R__USE_IMT
-      if(ROOT::IsImplicitMTEnabled() && fUnzipTaskGroup) {
-         fUnzipTaskGroup->Cancel();
-         fUnzipTaskGroup.reset();
-      }
-#endif
+      StopTasks();
       {
          // Fill new baskets into cache.
          R__LOCKGUARD(fIOMutex.get());
@@ -835,7 +917,9 @@ void TTreeCacheUnzip::SetUnzipRelBufferSize(Float_t relbufferSize)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets the size for the unzipping cache... by default it should be
-/// two times the size of the prefetching cache
+/// two times the size of the prefetching cache.
+/// The unzipping tasks stop claiming baskets while the unzipped baskets
+/// that are not yet consumed by the reader exceed this size.
 
 void TTreeCacheUnzip::SetUnzipBufferSize(Long64_t bufferSize)
 {
@@ -949,7 +1033,7 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
    printf("Max allowed mem for pending buffers: %lld\n", fUnzipBufferSize);
-   printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
+   printf("Number of blocks unzipped by threads: %d\n", fNUnzip.load());
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
    printf("Number of misses: %d\n", fNMissed);
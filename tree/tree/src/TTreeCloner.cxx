@@ -13,6 +13,11 @@
 \ingroup tree
 
 Class implementing or helping  the various TTree cloning method
+
+The cloning can be restricted to a range of entries with SetEntryRange(), as
+long as the boundaries of the range are also boundaries of the baskets of all
+the branches. AlignEntryRange() finds the largest such range within a range of
+entries; TTree::CopyEntryRange() copies the entries outside of it one by one.
 */
 
 #include "TBasket.h"
@@ -37,6 +42,21 @@ Class implementing or helping  the various TTree cloning method
 #include "snprintf.h"
 
 #include <algorithm>
+#include <vector>
+
+namespace {
+
+/// True if the branch has no basket at all, like the non-terminal 'object'
+/// branches of TBranchElement
+bool HasNoBaskets(TBranch *branch)
+{
+   if (branch->GetWriteBasket() != 0)
+      return false;
+   auto basket = static_cast<TBasket *>(branch->GetListOfBaskets()->At(0));
+   return !basket || basket->GetNevBuf() == 0;
+}
+
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -147,7 +167,9 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, TDirectory *newdirectory, Optio
    fToStartEntries(0),
    fCacheSize(0LL),
    fFileCache(nullptr),
-   fPrevCache(nullptr)
+   fPrevCache(nullptr),
+   fFirstEntry(0),
+   fLastEntry(-1)
 {
    TString opt(method);
    opt.ToLower();
@@ -452,21 +474,29 @@ void TTreeCloner::CollectBaskets()
 {
    UInt_t len = fFromBranches.GetEntriesFast();
 
-   for(UInt_t i=0,bi=0; i<len; ++i) {
+   UInt_t bi = 0;
+   for(UInt_t i=0; i<len; ++i) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt(i);
-      for(Int_t b=0; b<from->GetWriteBasket(); ++b,++bi) {
+      for(Int_t b=0; b<from->GetWriteBasket(); ++b) {
+         if (fLastEntry >= 0 && (from->GetBasketEntry()[b] < fFirstEntry || from->GetBasketEntry()[b] >= fLastEntry)) {
+            // the basket is outside of the range
+            continue;
+         }
          fBasketBranchNum[bi] = i;
          fBasketNum[bi] = b;
          fBasketSeek[bi] = from->GetBasketSeek(b);
          //fprintf(stderr,"For %s %d %lld\n",from->GetName(),bi,fBasketSeek[bi]);
          fBasketEntry[bi] = from->GetBasketEntry()[b];
          fBasketIndex[bi] = bi;
+         ++bi;
       }
    }
+   // only the baskets in the range are cloned
+   fMaxBaskets = bi;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Make sure that all the needed TStreamerInfo are
+/// Make sure that all the needed TStreamerInfo and zstd dictionaries are
 /// present in the output file
 
 void TTreeCloner::CopyStreamerInfos()
@@ -505,6 +535,10 @@ void TTreeCloner::CopyStreamerInfos()
       }
    }
    delete l;
+
+   // The copied baskets may have been compressed with zstd dictionaries.
+   for (const auto &dict : fromFile->GetZipDictionaries())
+      toFile->AddZipDictionary(dict.first, dict.second);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -520,6 +554,13 @@ void TTreeCloner::CopyMemoryBaskets()
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( i );
       TBranch *to   = (TBranch*)fToBranches.UncheckedAt( i );
 
+      if (fLastEntry >= 0) {
+         // the range ends before the baskets in memory, if any
+         to->AddLastBasket(fToStartEntries + fLastEntry - fFirstEntry);
+         if (from->GetEntries() != 0 && HasNoBaskets(from))
+            to->SetEntries(to->GetEntries() + fLastEntry - fFirstEntry);
+         continue;
+      }
       basket = (!from->GetListOfBaskets()->IsEmpty()) ? from->GetBasket(from->GetWriteBasket()) : nullptr;
       if (basket && basket->GetNevBuf()) {
          basket = (TBasket*)basket->Clone();
@@ -628,6 +669,24 @@ void TTreeCloner::ImportClusterRanges()
    if (IsInPlace())
       return;
 
+   if (fLastEntry >= 0) {
+      // Close the entries already in the output tree, like TTree::ImportClusterRanges
+      if (fToStartEntries && (fToTree->fNClusterRange == 0 ||
+                              fToTree->fClusterRangeEnd[fToTree->fNClusterRange - 1] != fToStartEntries - 1)) {
+         AddClusterRange(fToStartEntries - 1, fToTree->fAutoFlush < 0 ? 0 : fToTree->fAutoFlush);
+      }
+      // then add the clusters of the input tree, clipped to the range
+      TTree::TClusterIterator clusterIter = fFromTree->GetClusterIterator(fFirstEntry);
+      Long64_t start;
+      while ((start = clusterIter()) < fLastEntry) {
+         start = std::max(start, fFirstEntry);
+         Long64_t end = std::min(clusterIter.GetNextEntry(), fLastEntry);
+         AddClusterRange(fToStartEntries + end - fFirstEntry - 1, end - start);
+      }
+      fToTree->SetEntries(fToStartEntries + fLastEntry - fFirstEntry);
+      return;
+   }
+
    // First undo, the external call to SetEntries
    // We could improve the interface to optional tell the TTreeCloner that the
    // SetEntries was not done.
@@ -643,6 +702,101 @@ void TTreeCloner::ImportClusterRanges()
    fToTree->SetEntries(fToTree->GetEntries() + fFromTree->GetTree()->GetEntries());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add to the output tree a cluster range ending at lastEntry (inclusive),
+/// made of clusters of the given size. The previous range is extended instead
+/// if it has the same cluster size and ends one cluster before.
+
+void TTreeCloner::AddClusterRange(Long64_t lastEntry, Long64_t size)
+{
+   TTree *to = fToTree;
+   Int_t n = to->fNClusterRange;
+   if (n && size && to->fClusterSize[n-1] == size && to->fClusterRangeEnd[n-1] + size == lastEntry) {
+      to->fClusterRangeEnd[n-1] = lastEntry;
+      return;
+   }
+   if (n + 1 > to->fMaxClusterRange) {
+      if (to->fMaxClusterRange) {
+         Int_t newsize = std::max(10, 2 * to->fMaxClusterRange);
+         to->fClusterRangeEnd = (Long64_t*)TStorage::ReAlloc(to->fClusterRangeEnd,
+                                                             newsize*sizeof(Long64_t),to->fMaxClusterRange*sizeof(Long64_t));
+         to->fClusterSize = (Long64_t*)TStorage::ReAlloc(to->fClusterSize,
+                                                         newsize*sizeof(Long64_t),to->fMaxClusterRange*sizeof(Long64_t));
+         to->fMaxClusterRange = newsize;
+      } else {
+         to->fMaxClusterRange = 2;
+         to->fClusterRangeEnd = new Long64_t[to->fMaxClusterRange];
+         to->fClusterSize = new Long64_t[to->fMaxClusterRange];
+      }
+   }
+   to->fClusterRangeEnd[n] = lastEntry;
+   to->fClusterSize[n] = size;
+   ++to->fNClusterRange;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Shrink the range of entries [first, last) of the input tree to the largest
+/// range whose boundaries are boundaries of the baskets on file of all the
+/// branches, i.e. the largest range that can be cloned without unzipping any
+/// basket. first is set to last if there is no such range.
+
+void TTreeCloner::AlignEntryRange(Long64_t &first, Long64_t &last) const
+{
+   std::vector<Long64_t> common, boundaries, tmp;
+   bool constrained = false;
+   for (Int_t i = 0; i < fFromBranches.GetEntriesFast(); ++i) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt(i);
+      if (HasNoBaskets(from))
+         continue;
+      // the start of the write basket is the end of the baskets on file
+      const Long64_t *basketEntry = from->GetBasketEntry();
+      boundaries.assign(basketEntry, basketEntry + from->GetWriteBasket() + 1);
+      if (!constrained) {
+         common.swap(boundaries);
+         constrained = true;
+      } else {
+         tmp.clear();
+         std::set_intersection(common.begin(), common.end(), boundaries.begin(), boundaries.end(),
+                               std::back_inserter(tmp));
+         common.swap(tmp);
+      }
+   }
+   auto lo = std::lower_bound(common.begin(), common.end(), first);
+   auto hi = std::upper_bound(common.begin(), common.end(), last);
+   if (lo == common.end() || hi == common.begin() || *lo >= *(hi - 1)) {
+      first = last;
+      return;
+   }
+   first = *lo;
+   last = *(hi - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Restrict the cloning to the entries [first, last) of the input tree, which
+/// are appended to the output tree. Both must be boundaries of the baskets of
+/// all the branches, see AlignEntryRange(); otherwise the range is not changed
+/// and false is returned. To be called right before Exec(), after any filling
+/// of the output tree.
+
+bool TTreeCloner::SetEntryRange(Long64_t first, Long64_t last)
+{
+   Long64_t alignedFirst = first;
+   Long64_t alignedLast = last;
+   AlignEntryRange(alignedFirst, alignedLast);
+   if (IsInPlace() || alignedFirst != first || alignedLast != last) {
+      fWarningMsg.Form("The range of entries [%lld, %lld) of %s can not be cloned without unzipping baskets.",
+                       first, last, fFromTree->GetName());
+      if (!(fOptions & kNoWarnings)) {
+         Warning("TTreeCloner::SetEntryRange", "%s", fWarningMsg.Data());
+      }
+      return false;
+   }
+   fFirstEntry = first;
+   fLastEntry = last;
+   fToStartEntries = fToTree->GetEntries();
+   return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the cache size used by the matching TFile.
 /// Note that the default is to use the same size as the default TTreeCache for
@@ -767,13 +921,13 @@ void TTreeCloner::WriteBaskets()
          basket->LoadBasketBuffers(pos,len,fromfile,fFromTree);
          basket->IncrementPidOffset(fPidOffset);
          basket->CopyTo(tofile);
-         to->AddBasket(*basket,true,fToStartEntries + from->GetBasketEntry()[index]);
+         to->AddBasket(*basket,true,fToStartEntries + from->GetBasketEntry()[index] - fFirstEntry);
       } else {
          TBasket *frombasket = from->GetBasket( index );
          if (frombasket && frombasket->GetNevBuf()>0) {
             TBasket *tobasket = (TBasket*)frombasket->Clone();
             tobasket->SetBranch(to);
-            to->AddBasket(*tobasket, false, fToStartEntries+from->GetBasketEntry()[index]);
+            to->AddBasket(*tobasket, false, fToStartEntries+from->GetBasketEntry()[index]-fFirstEntry);
             to->FlushOneBasket(to->GetWriteBasket());
          }
       }
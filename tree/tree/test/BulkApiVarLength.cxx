@@ -6,6 +6,7 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TStopwatch.h"
+#include "TSystem.h"
 #include "TTreeReader.h"
 #include "TTreeReaderValue.h"
 #include "TTreeReaderArray.h"
@@ -15,6 +16,8 @@
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 class BulkApiVariableTest : public ::testing::Test {
 public:
    static constexpr Long64_t fClusterSize = 1e5;
@@ -233,3 +236,78 @@ TEST_F(BulkApiVariableTest, serializedRead)
    printf("Bulk Serialized API: Successful read of all events.\n");
    printf("Bulk Serialized API: Total elapsed time (seconds) for API: %.2f\n", sw.RealTime());
 }
+
+TEST(BulkApiVarLength, offsetRead)
+{
+   const std::string fileName = "BulkApiTestOffsets.root";
+   const Long64_t nEvents = 20000;
+   {
+      TFile hfile{fileName.c_str(), "RECREATE"};
+      TTree tree{"T", "A ROOT tree of jagged branches."};
+      int n = 0;
+      float f[10];
+      std::vector<double> v;
+      tree.Branch("n", &n, "n/I");
+      tree.Branch("f", f, "f[n]/F", 4000);
+      tree.Branch("v", &v, 4000);
+      for (Long64_t ev = 0; ev < nEvents; ev++) {
+         n = ev % 10;
+         v.clear();
+         for (int idx = 0; idx < n; idx++) {
+            f[idx] = ev + idx;
+            v.push_back(2 * (ev + idx));
+         }
+         tree.Fill();
+      }
+      hfile.Write();
+   }
+
+   std::unique_ptr<TFile> hfile{TFile::Open(fileName.c_str())};
+   auto tree = hfile->Get<TTree>("T");
+   ASSERT_TRUE(tree);
+   auto branchFloat = tree->GetBranch("f");
+   auto branchVector = tree->GetBranch("v");
+   EDataType type = kOther_t;
+   EXPECT_TRUE(branchFloat->GetBulkRead().SupportsVarLengthBulkRead(&type));
+   EXPECT_EQ(kFloat_t, type);
+   EXPECT_TRUE(branchVector->GetBulkRead().SupportsVarLengthBulkRead(&type));
+   EXPECT_EQ(kDouble_t, type);
+
+   TBufferFile valueBuf(TBuffer::kWrite, 32 * 1024);
+   TBufferFile offsetBuf(TBuffer::kWrite, 32 * 1024);
+   for (auto branch : {branchFloat, branchVector}) {
+      const double factor = (branch == branchFloat) ? 1 : 2;
+      Long64_t evt = 0;
+      while (evt < nEvents) {
+         auto count = branch->GetBulkRead().GetBulkEntries(evt, valueBuf, offsetBuf);
+         ASSERT_GT(count, 0);
+         auto offsets = reinterpret_cast<Int_t *>(offsetBuf.GetCurrent());
+         for (Int_t idx = 0; idx < count; idx++, evt++) {
+            ASSERT_EQ(evt % 10, offsets[idx + 1] - offsets[idx]);
+            for (Int_t j = offsets[idx]; j < offsets[idx + 1]; j++) {
+               double value = (branch == branchFloat) ? reinterpret_cast<float *>(valueBuf.GetCurrent())[j]
+                                                      : reinterpret_cast<double *>(valueBuf.GetCurrent())[j];
+               ASSERT_EQ(factor * (evt + j - offsets[idx]), value);
+            }
+         }
+      }
+   }
+
+   ROOT::Experimental::TTreeReaderFast myReader("T", hfile.get());
+   ROOT::Experimental::TTreeReaderArrayFast<float> myF(myReader, "f");
+   ROOT::Experimental::TTreeReaderArrayFast<double> myV(myReader, "v");
+   Long64_t evt = 0;
+   for (auto entry : myReader) {
+      ASSERT_EQ(evt, entry);
+      ASSERT_EQ(static_cast<std::size_t>(evt % 10), myF.GetSize());
+      ASSERT_EQ(static_cast<std::size_t>(evt % 10), myV.GetSize());
+      for (std::size_t idx = 0; idx < myF.GetSize(); idx++) {
+         ASSERT_EQ(static_cast<float>(evt + idx), myF[idx]);
+         ASSERT_EQ(static_cast<double>(2 * (evt + idx)), myV[idx]);
+      }
+      evt++;
+   }
+   ASSERT_EQ(nEvents, evt);
+
+   gSystem->Unlink(fileName.c_str());
+}
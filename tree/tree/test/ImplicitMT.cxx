@@ -3,9 +3,13 @@
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TTree.h"
+#include "TTreeCacheUnzip.h"
 
 #include "gtest/gtest.h"
 
+#include <string>
+#include <vector>
+
 #ifdef R__USE_IMT
 
 // ROOT-9668
@@ -57,4 +61,101 @@ TEST(TChainImplicitMT, propagateToTTree)
    gSystem->Unlink(fname1);
 }
 
+TEST(TTreeCacheUnzip, ParallelUnzipReadBack)
+{
+   ROOT::EnableImplicitMT(4);
+   const auto fname = "parallelUnzipReadBack.root";
+   const Long64_t nEntries = 200000;
+   {
+      TFile f(fname, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(20000);
+      Long64_t x = 0;
+      double y = 0.;
+      t.Branch("x", &x)->SetBasketSize(4000);
+      t.Branch("y", &y)->SetBasketSize(8000);
+      for (Long64_t i = 0; i < nEntries; ++i) {
+         x = i;
+         y = 0.5 * i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   const auto oldMode = TTreeCacheUnzip::GetParallelUnzip();
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      TFile f(fname);
+      auto t = f.Get<TTree>("t");
+      t->SetCacheSize(1000000);
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(f.GetCacheRead(t));
+      ASSERT_NE(nullptr, cache);
+
+      Long64_t x = -1;
+      double y = -1.;
+      t->SetBranchAddress("x", &x);
+      t->SetBranchAddress("y", &y);
+      for (Long64_t i = 0; i < nEntries; ++i) {
+         t->GetEntry(i);
+         ASSERT_EQ(i, x);
+         ASSERT_EQ(0.5 * i, y);
+      }
+      EXPECT_GT(cache->GetNUnzip(), 0);
+   }
+   TTreeCacheUnzip::SetParallelUnzip(oldMode);
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(fname);
+}
+
+TEST(TTreeImplicitMT, ParallelFillReadBack)
+{
+   ROOT::EnableImplicitMT(4);
+   const auto fname = "parallelFillReadBack.root";
+   const int nBranches = 64;
+   const Long64_t nEntries = 20000;
+   {
+      TFile f(fname, "RECREATE");
+      TTree t("t", "t");
+      t.SetParallelFill();
+      EXPECT_TRUE(t.GetParallelFill());
+      std::vector<Long64_t> x(nBranches);
+      std::vector<std::vector<float>> v(nBranches);
+      for (int b = 0; b < nBranches; ++b) {
+         t.Branch(("x" + std::to_string(b)).c_str(), &x[b])->SetBasketSize(2000);
+         t.Branch(("v" + std::to_string(b)).c_str(), &v[b]);
+      }
+      for (Long64_t i = 0; i < nEntries; ++i) {
+         for (int b = 0; b < nBranches; ++b) {
+            x[b] = i * nBranches + b;
+            v[b].assign(i % 4, float(b));
+         }
+         EXPECT_GT(t.Fill(), 0);
+      }
+      t.Write();
+   }
+
+   {
+      std::vector<Long64_t> x(nBranches);
+      std::vector<std::vector<float>> vStorage(nBranches);
+      std::vector<std::vector<float> *> v(nBranches);
+      TFile f(fname);
+      auto t = f.Get<TTree>("t");
+      ASSERT_EQ(nEntries, t->GetEntries());
+      for (int b = 0; b < nBranches; ++b) {
+         v[b] = &vStorage[b];
+         t->SetBranchAddress(("x" + std::to_string(b)).c_str(), &x[b]);
+         t->SetBranchAddress(("v" + std::to_string(b)).c_str(), &v[b]);
+      }
+      for (Long64_t i = 0; i < nEntries; ++i) {
+         t->GetEntry(i);
+         for (int b = 0; b < nBranches; ++b) {
+            ASSERT_EQ(i * nBranches + b, x[b]);
+            ASSERT_EQ(std::size_t(i % 4), v[b]->size());
+         }
+      }
+   }
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(fname);
+}
+
 #endif // R__USE_IMT
@@ -0,0 +1,82 @@
+#include "SillyStruct.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <vector>
+
+namespace {
+constexpr int kNEntries = 200;
+
+// Entry e holds e % 17 elements, so that empty and odd-sized collections are covered.
+void FillVector(std::vector<SillyStruct> &v, int e)
+{
+   v.resize(e % 17);
+   for (int j = 0; j < int(v.size()); ++j) {
+      v[j].f = e + 0.5f * j;
+      v[j].i = e * 100 + j;
+      v[j].d = -e - 0.25 * j;
+      v[j].SetUniqueID(j);
+   }
+}
+
+void FillMap(std::map<int, float> &m, int e)
+{
+   m.clear();
+   for (int j = 0; j < e % 13; ++j)
+      m[e * 100 + j] = e - 0.5f * j;
+}
+} // anonymous namespace
+
+// The members of std::vector<SillyStruct> and the pairs of std::map<int, float> are streamed member-wise, by the
+// bulk kernels of the collection loopers.
+TEST(STLMemberWise, VectorAndMap)
+{
+   const auto filename = "stlmemberwise_vectorandmap.root";
+   for (int split : {0, 99}) {
+      {
+         TFile f(filename, "RECREATE");
+         TTree t("t", "t");
+         std::vector<SillyStruct> v;
+         std::map<int, float> m;
+         t.Branch("v", &v, 32000, split);
+         t.Branch("m", &m, 32000, split);
+         for (int e = 0; e < kNEntries; ++e) {
+            FillVector(v, e);
+            FillMap(m, e);
+            t.Fill();
+         }
+         t.Write();
+      }
+
+      TFile f(filename);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(t, nullptr);
+      std::vector<SillyStruct> readV;
+      std::map<int, float> readM;
+      auto v = &readV;
+      auto m = &readM;
+      t->SetBranchAddress("v", &v);
+      t->SetBranchAddress("m", &m);
+      std::vector<SillyStruct> expectedV;
+      std::map<int, float> expectedM;
+      for (int e = 0; e < kNEntries; ++e) {
+         t->GetEntry(e);
+         FillVector(expectedV, e);
+         FillMap(expectedM, e);
+         ASSERT_EQ(expectedV.size(), v->size());
+         for (std::size_t j = 0; j < v->size(); ++j) {
+            EXPECT_EQ(expectedV[j].f, (*v)[j].f);
+            EXPECT_EQ(expectedV[j].i, (*v)[j].i);
+            EXPECT_EQ(expectedV[j].d, (*v)[j].d);
+            EXPECT_EQ(expectedV[j].GetUniqueID(), (*v)[j].GetUniqueID());
+         }
+         EXPECT_EQ(expectedM, *m);
+      }
+      t->ResetBranchAddresses();
+   }
+   gSystem->Unlink(filename);
+}
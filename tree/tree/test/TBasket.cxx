@@ -4,12 +4,15 @@
 #include "TBranch.h"
 #include "TEnum.h"
 #include "TEnumConstant.h"
+#include "TFile.h"
 #include "TMemFile.h"
+#include "TSystem.h"
 #include "TTree.h"
 
 #include "ROOT/TestSupport.hxx"
 #include "gtest/gtest.h"
 
+#include <string>
 #include <vector>
 
 static const Int_t gSampleEvents = 100;
@@ -411,3 +414,40 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<bool *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, true);
 }
+
+TEST(TBasket, ZSTDDictionary)
+{
+   const auto filename = "tbasket_zstddict.root";
+   {
+      TFile f(filename, "RECREATE", "", ROOT::CompressionSettings(ROOT::RCompressionSetting::EAlgorithm::kZSTDDict, 5));
+      TTree t("t", "t");
+      t.SetAutoFlush(1000);
+      Int_t idx;
+      char text[64];
+      t.Branch("idx", &idx, "idx/I", 1024);
+      t.Branch("text", text, "text/C", 1024);
+      for (idx = 0; idx < 10000; idx++) {
+         snprintf(text, sizeof(text), "entry number %d of the dictionary test", idx);
+         t.Fill();
+      }
+      t.Write();
+      EXPECT_FALSE(t.GetBranch("text")->GetZipDictionary().empty());
+   }
+
+   TFile f(filename);
+   EXPECT_FALSE(f.GetZipDictionaries().empty());
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   Int_t idx;
+   char text[64];
+   t->SetBranchAddress("idx", &idx);
+   t->SetBranchAddress("text", text);
+   ASSERT_EQ(10000, t->GetEntries());
+   for (Long64_t e = 0; e < t->GetEntries(); e++) {
+      t->GetEntry(e);
+      EXPECT_EQ(e, idx);
+      EXPECT_EQ("entry number " + std::to_string(e) + " of the dictionary test", std::string(text));
+   }
+
+   gSystem->Unlink(filename);
+}
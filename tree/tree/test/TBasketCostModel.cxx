@@ -0,0 +1,97 @@
+#include "ROOT/TBasketCostModel.hxx"
+#include "Compression.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using ROOT::TBasketCostModel;
+
+static std::vector<TBasketCostModel::TBranchStats> MakeStats(std::size_t nbranches, Double_t bytesPerEntry)
+{
+   std::vector<TBasketCostModel::TBranchStats> stats(nbranches);
+   for (auto &s : stats) {
+      s.fName = "b";
+      s.fBytesPerEntry = bytesPerEntry;
+      s.fCompressionFactor = 2;
+      s.fCompressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kZSTD;
+      s.fCompressionLevel = 5;
+   }
+   return stats;
+}
+
+TEST(TBasketCostModel, MemoryLimit)
+{
+   TBasketCostModel model;
+   model.SetMaxMemory(1000000);
+   auto result = model.Optimize(MakeStats(100, 8));
+   ASSERT_EQ(100u, result.fBranches.size());
+   EXPECT_GT(result.fClusterSize, 0);
+   EXPECT_LE(result.fMemory, 1000000u);
+   ULong64_t memory = 0;
+   for (const auto &b : result.fBranches) {
+      EXPECT_GE(b.fBasketSize, 512);
+      EXPECT_GT(b.GetTime(), 0);
+      memory += b.fBasketSize;
+   }
+   EXPECT_EQ(memory, result.fMemory);
+}
+
+TEST(TBasketCostModel, ReadPattern)
+{
+   const auto stats = MakeStats(10, 100);
+
+   TBasketCostModel fullScan(TBasketCostModel::EReadPattern::kFullScan, 1e-4, 200e6);
+   auto resultFullScan = fullScan.Optimize(stats);
+
+   // Selecting few entries favors small baskets
+   TBasketCostModel sparseEntries(TBasketCostModel::EReadPattern::kSparse, 1e-4, 200e6);
+   sparseEntries.SetEntryFraction(0.001);
+   auto resultSparse = sparseEntries.Optimize(stats);
+   EXPECT_LT(resultSparse.fBranches[0].fBasketSize, resultFullScan.fBranches[0].fBasketSize);
+
+   // Reading a subset of the branches only is cheaper
+   TBasketCostModel sparseBranches(TBasketCostModel::EReadPattern::kSparse, 1e-4, 200e6);
+   sparseBranches.SetBranchFraction(0.1);
+   EXPECT_LT(sparseBranches.Optimize(stats).fTimePerEntry, resultFullScan.fTimePerEntry);
+
+   // A high latency favors larger clusters
+   TBasketCostModel remote(TBasketCostModel::EReadPattern::kFullScan, 4e-2, 200e6);
+   remote.SetCacheSize(1000000000);
+   EXPECT_GE(remote.Optimize(stats).fClusterSize, resultFullScan.fClusterSize);
+}
+
+TEST(TBasketCostModel, OptimizeTreeBaskets)
+{
+   const auto fname = "basketcostmodel.root";
+   TFile f(fname, "RECREATE");
+   TTree t("t", "t");
+   t.SetAutoFlush(0);
+   double x = 0;
+   int n = 0;
+   float v[16];
+   t.Branch("x", &x);
+   t.Branch("n", &n);
+   t.Branch("v", v, "v[n]/F");
+   for (int i = 0; i < 1000; ++i) {
+      x = i;
+      n = i % 16;
+      for (int j = 0; j < n; ++j)
+         v[j] = j;
+      t.Fill();
+   }
+
+   TBasketCostModel model;
+   model.SetMaxMemory(100000);
+   auto result = t.OptimizeBaskets(model);
+   ASSERT_EQ(3u, result.fBranches.size());
+   EXPECT_EQ(result.fClusterSize, t.GetAutoFlush());
+   EXPECT_EQ(result.fBranches[0].fBasketSize, t.GetBranch("x")->GetBasketSize());
+   EXPECT_GE(t.GetBranch("v")->GetBasketSize(), result.fBranches[2].fBasketSize);
+
+   f.Close();
+   gSystem->Unlink(fname);
+}
@@ -1,8 +1,13 @@
 #include <TChain.h>
+#include <TEnv.h>
 #include <TFile.h>
 #include <TSystem.h>
 #include <TTree.h>
  
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 class TTreeCache;
@@ -30,3 +35,107 @@ TEST(TChain, GetReadCacheBug)
 
    gSystem->Unlink(filename);
 }
+
+TEST(TChain, PrefetchNextFile)
+{
+   const auto treename = "tree";
+   const std::vector<std::string> filenames{"tchain_prefetchnextfile_0.root", "tchain_prefetchnextfile_1.root",
+                                            "tchain_prefetchnextfile_2.root"};
+   int value = 0;
+   for (const auto &filename : filenames) {
+      TFile f(filename.c_str(), "recreate");
+      ASSERT_FALSE(f.IsZombie());
+      TTree t(treename, treename);
+      int x = 0;
+      t.Branch("x", &x);
+      t.SetAutoFlush(100);
+      for (int i = 0; i < 1000; ++i) {
+         x = value++;
+         t.Fill();
+      }
+      t.Write();
+      f.Close();
+   }
+
+   TChain chain(treename);
+   for (const auto &filename : filenames)
+      chain.Add(filename.c_str());
+   chain.SetPrefetchNextFile();
+   EXPECT_TRUE(chain.GetPrefetchNextFile());
+   chain.SetCacheSize(10000000);
+
+   int x = -1;
+   chain.SetBranchAddress("x", &x);
+   const auto nentries = chain.GetEntries();
+   ASSERT_EQ(nentries, value);
+   for (Long64_t i = 0; i < nentries; ++i) {
+      ASSERT_GT(chain.GetEntry(i), 0);
+      EXPECT_EQ(x, i);
+      EXPECT_EQ(chain.GetTreeNumber(), i / 1000);
+   }
+   EXPECT_NE(chain.GetReadCache(chain.GetCurrentFile()), nullptr);
+
+   // Random access to an earlier tree discards the prefetched file
+   ASSERT_GT(chain.GetEntry(1950), 0);
+   ASSERT_GT(chain.GetEntry(10), 0);
+   EXPECT_EQ(x, 10);
+
+   for (const auto &filename : filenames)
+      gSystem->Unlink(filename.c_str());
+}
+
+TEST(TChain, MetadataCache)
+{
+   const auto treename = "tree";
+   const std::vector<std::string> filenames{"tchain_metadatacache_0.root", "tchain_metadatacache_1.root",
+                                            "tchain_metadatacache_2.root"};
+   const auto cachename = "tchain_metadatacache.txt";
+   gSystem->Unlink(cachename);
+   for (std::size_t n = 0; n < filenames.size(); ++n) {
+      TFile f(filenames[n].c_str(), "recreate");
+      ASSERT_FALSE(f.IsZombie());
+      TTree t(treename, treename);
+      int x = 0;
+      t.Branch("x", &x);
+      t.SetAutoFlush(100);
+      for (std::size_t i = 0; i < 250 * (n + 1); ++i)
+         t.Fill();
+      t.Write();
+      f.Close();
+   }
+
+   const std::string previous = gEnv->GetValue("TChain.MetadataCache", "");
+   gEnv->SetValue("TChain.MetadataCache", cachename);
+   {
+      TChain chain(treename);
+      for (const auto &filename : filenames)
+         chain.Add(filename.c_str(), TChain::kBigNumber);
+      EXPECT_EQ(chain.GetEntries(), 1500);
+      EXPECT_EQ(chain.GetTreeOffset()[1], 250);
+      EXPECT_EQ(chain.GetTreeOffset()[2], 750);
+      ASSERT_GT(chain.GetEntry(1499), 0);
+   }
+
+   std::ifstream cache(cachename);
+   std::string line;
+   std::size_t nlines = 0;
+   while (std::getline(cache, line)) {
+      if (nlines++ == 0)
+         EXPECT_NE(line.find("\t250\t0 100 200 250\tx"), std::string::npos) << line;
+   }
+   EXPECT_EQ(nlines, filenames.size());
+
+   // The number of entries now comes from the cache, without opening the files
+   gSystem->Unlink(filenames[2].c_str());
+   {
+      TChain chain(treename);
+      for (const auto &filename : filenames)
+         chain.Add(filename.c_str(), TChain::kBigNumber);
+      EXPECT_EQ(chain.GetEntries(), 1500);
+   }
+
+   gEnv->SetValue("TChain.MetadataCache", previous.c_str());
+   gSystem->Unlink(cachename);
+   for (const auto &filename : filenames)
+      gSystem->Unlink(filename.c_str());
+}
@@ -0,0 +1,114 @@
+#include "TBranch.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int kNBranches = 8;
+constexpr int kNEntries = 20000;
+
+void WriteTree(const char *filename)
+{
+   TFile f(filename, "RECREATE");
+   TTree t("t", "t");
+   t.SetAutoFlush(2000);
+   // Branch i holds i+1 doubles, so that the branches read different amounts of bytes.
+   std::vector<std::vector<double>> values(kNBranches);
+   for (int i = 0; i < kNBranches; ++i) {
+      values[i].resize(i + 1);
+      t.Branch(("b" + std::to_string(i)).c_str(), values[i].data(),
+               ("x[" + std::to_string(i + 1) + "]/D").c_str());
+   }
+   for (int e = 0; e < kNEntries; ++e) {
+      for (int i = 0; i < kNBranches; ++i)
+         for (auto &x : values[i])
+            x = e * 10 + i;
+      t.Fill();
+   }
+   t.Write();
+}
+
+void ReadAndCheck(TTree *t, const std::vector<int> &branches)
+{
+   std::vector<std::vector<double>> values(kNBranches);
+   t->SetBranchStatus("*", false);
+   for (auto i : branches) {
+      values[i].resize(i + 1);
+      const auto name = "b" + std::to_string(i);
+      t->SetBranchStatus(name.c_str(), true);
+      t->SetBranchAddress(name.c_str(), values[i].data());
+   }
+   for (Long64_t e = 0; e < t->GetEntries(); ++e) {
+      t->GetEntry(e);
+      for (auto i : branches)
+         for (auto x : values[i])
+            ASSERT_EQ(x, e * 10 + i);
+   }
+}
+} // anonymous namespace
+
+TEST(TTreeCache, MemoryBudget)
+{
+   const auto filename = "ttreecache_memorybudget.root";
+   WriteTree(filename);
+
+   TFile f(filename);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   t->SetCacheSize(10000000);
+   auto tc = t->GetReadCache(&f);
+   ASSERT_NE(tc, nullptr);
+
+   const Long64_t budget = 200000;
+   tc->SetMemoryBudget(budget);
+   EXPECT_EQ(budget, tc->GetMemoryBudget());
+   t->AddBranchToCache("b1");
+   t->AddBranchToCache("b7");
+   t->StopCacheLearningPhase();
+
+   ReadAndCheck(t, {1, 7});
+
+   // The cache is sized from the two cached branches, not from the whole tree, and within the budget.
+   EXPECT_LE(tc->GetBufferSize(), budget);
+   const auto quota1 = tc->GetBranchQuota(t->GetBranch("b1"));
+   const auto quota7 = tc->GetBranchQuota(t->GetBranch("b7"));
+   EXPECT_GT(quota1, 0);
+   EXPECT_GT(quota7, quota1);
+   EXPECT_LE(quota1 + quota7, tc->GetBufferSize());
+   EXPECT_EQ(0, tc->GetBranchQuota(t->GetBranch("b0")));
+   EXPECT_GT(tc->GetEfficiency(), 0.5);
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TTreeCache, MaxGap)
+{
+   const auto filename = "ttreecache_maxgap.root";
+   WriteTree(filename);
+
+   for (Int_t maxGap : {0, 1000000}) {
+      TFile f(filename);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(t, nullptr);
+      t->SetCacheSize(10000000);
+      auto tc = t->GetReadCache(&f);
+      ASSERT_NE(tc, nullptr);
+      tc->SetMaxGap(maxGap);
+      EXPECT_EQ(maxGap, tc->GetMaxGap());
+      // The baskets of b0 and b2 are separated by those of b1, which are read along with a large enough gap.
+      t->AddBranchToCache("b0");
+      t->AddBranchToCache("b2");
+      t->StopCacheLearningPhase();
+
+      ReadAndCheck(t, {0, 2});
+      EXPECT_GT(tc->GetEfficiency(), 0.9);
+   }
+
+   gSystem->Unlink(filename);
+}
@@ -0,0 +1,110 @@
+#include "TEntryList.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr Long64_t kEntries = 10000;
+
+class TTreeClonerRange : public ::testing::Test {
+protected:
+   static void SetUpTestSuite()
+   {
+      TFile file("clonerrange_in.root", "recreate");
+      TTree t("t", "t");
+      Long64_t i = 0;
+      int n = 0;
+      float v[5];
+      t.Branch("i", &i, "i/L");
+      t.Branch("n", &n, "n/I");
+      t.Branch("v", v, "v[n]/F");
+      t.SetAutoFlush(1000);
+      for (i = 0; i < kEntries; ++i) {
+         n = i % 5;
+         for (int j = 0; j < n; ++j)
+            v[j] = i + 0.5f * j;
+         t.Fill();
+      }
+      t.Write();
+   }
+   static void TearDownTestSuite()
+   {
+      gSystem->Unlink("clonerrange_in.root");
+      gSystem->Unlink("clonerrange_out.root");
+   }
+};
+
+// Check that the tree holds the given entries of the input tree
+void ExpectEntries(TTree *tree, const std::vector<Long64_t> &entries)
+{
+   ASSERT_EQ(tree->GetEntries(), static_cast<Long64_t>(entries.size()));
+   Long64_t i = 0;
+   int n = 0;
+   float v[5];
+   tree->SetBranchAddress("i", &i);
+   tree->SetBranchAddress("n", &n);
+   tree->SetBranchAddress("v", v);
+   for (Long64_t k = 0; k < tree->GetEntries(); ++k) {
+      tree->GetEntry(k);
+      ASSERT_EQ(i, entries[k]) << k;
+      ASSERT_EQ(n, entries[k] % 5) << k;
+      for (int j = 0; j < n; ++j)
+         ASSERT_FLOAT_EQ(v[j], entries[k] + 0.5f * j) << k;
+   }
+   tree->ResetBranchAddresses();
+}
+
+} // anonymous namespace
+
+TEST_F(TTreeClonerRange, CopyEntries)
+{
+   TFile in("clonerrange_in.root");
+   auto t = in.Get<TTree>("t");
+   TFile out("clonerrange_out.root", "recreate");
+   std::unique_ptr<TTree> copy(t->CloneTree(0));
+   // 5500 is not a cluster boundary: the baskets of the last 500 entries are unzipped
+   copy->CopyEntries(t, 5500, "fast");
+   std::vector<Long64_t> expected;
+   for (Long64_t e = 0; e < 5500; ++e)
+      expected.push_back(e);
+   ExpectEntries(copy.get(), expected);
+}
+
+TEST_F(TTreeClonerRange, CopyTreeWithEntryList)
+{
+   TFile in("clonerrange_in.root");
+   auto t = in.Get<TTree>("t");
+   TEntryList elist("elist", "", t);
+   std::vector<Long64_t> expected;
+   for (Long64_t e = 0; e < kEntries; ++e) {
+      // a few isolated entries, then long runs crossing the cluster boundaries
+      if (e % 997 == 3 || (e >= 1500 && e < 4200) || (e >= 6000 && e < 9000)) {
+         elist.Enter(e);
+         expected.push_back(e);
+      }
+   }
+   t->SetEntryList(&elist);
+   TFile out("clonerrange_out.root", "recreate");
+   std::unique_ptr<TTree> fast(t->CopyTree("", "fast"));
+   std::unique_ptr<TTree> slow(t->CopyTree(""));
+   t->SetEntryList(nullptr);
+   ExpectEntries(fast.get(), expected);
+   ExpectEntries(slow.get(), expected);
+   // the fast copy has the same clusters as the input inside the runs
+   auto clusters = fast->GetClusterIterator(0);
+   Long64_t start;
+   std::vector<Long64_t> boundaries;
+   while ((start = clusters()) < fast->GetEntries())
+      boundaries.push_back(start);
+   for (Long64_t e : {2000, 3000, 6000, 7000, 8000}) {
+      Long64_t position = std::find(expected.begin(), expected.end(), e) - expected.begin();
+      EXPECT_NE(std::find(boundaries.begin(), boundaries.end(), position), boundaries.end()) << e;
+   }
+}
@@ -1,3 +1,4 @@
+#include "ROOT/InternalTreeUtils.hxx"
 #include "TFile.h"
 #include "TTree.h"
 #include "TBranch.h"
@@ -53,3 +54,40 @@ TEST_F(TTreeClusterTest, countBaskets)
 
    delete file;
 }
+
+TEST_F(TTreeClusterTest, clusterAlignedRanges)
+{
+   using ROOT::Internal::TreeUtils::MakeClusterAlignedRanges;
+   using Ranges_t = std::vector<std::pair<Long64_t, Long64_t>>;
+
+   const auto clusters = ROOT::Internal::TreeUtils::GetClustersAndEntries("tree", "TTreeClusterTest.root");
+   EXPECT_EQ(clusters.first, (std::vector<Long64_t>{0, 500, 1000}));
+   EXPECT_EQ(clusters.second, 1000);
+   EXPECT_EQ(MakeClusterAlignedRanges(clusters.first, 1), (Ranges_t{{0, 1000}}));
+   // there cannot be more ranges than clusters
+   EXPECT_EQ(MakeClusterAlignedRanges(clusters.first, 5), (Ranges_t{{0, 500}, {500, 1000}}));
+
+   const std::vector<Long64_t> boundaries{0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100};
+   EXPECT_EQ(MakeClusterAlignedRanges(boundaries, 3), (Ranges_t{{0, 40}, {40, 70}, {70, 100}}));
+   EXPECT_EQ(MakeClusterAlignedRanges(boundaries, 5), (Ranges_t{{0, 20}, {20, 40}, {40, 60}, {60, 80}, {80, 100}}));
+   // the first range ends at the first boundary past its ideal end, 200, which leaves nothing for the second one
+   EXPECT_EQ(MakeClusterAlignedRanges({100, 150, 300}, 2), (Ranges_t{{100, 300}}));
+   EXPECT_TRUE(MakeClusterAlignedRanges({}, 2).empty());
+}
+
+TEST_F(TTreeClusterTest, treesMetadata)
+{
+   const auto metadata = ROOT::Internal::TreeUtils::GetTreesMetadata({"tree", "tree2", "notree"},
+                                                                     {"TTreeClusterTest.root", "TTreeClusterTest.root",
+                                                                      "TTreeClusterTest.root"});
+   ASSERT_EQ(metadata.size(), 3u);
+   const auto clusters = ROOT::Internal::TreeUtils::GetClustersAndEntries("tree", "TTreeClusterTest.root");
+   EXPECT_EQ(metadata[0].fEntries, clusters.second);
+   EXPECT_EQ(metadata[0].fClusterBoundaries, clusters.first);
+   EXPECT_EQ(metadata[0].fBranchNames, std::vector<std::string>{"branch"});
+   EXPECT_EQ(metadata[1].fEntries, 1000);
+   EXPECT_EQ(metadata[2].fEntries, -2);
+
+   const auto missing = ROOT::Internal::TreeUtils::GetTreesMetadata({"tree"}, {"TTreeClusterTest_missing.root"});
+   EXPECT_EQ(missing[0].fEntries, -1);
+}
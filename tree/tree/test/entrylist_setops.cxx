@@ -0,0 +1,100 @@
+#include "TEntryList.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+namespace {
+
+// Entries of several blocks, with dense and sparse blocks so that both the bits and the list
+// representations are exercised
+std::set<Long64_t> MakeEntries(Long64_t step, Long64_t offset)
+{
+   std::set<Long64_t> entries;
+   for (Long64_t entry = offset; entry < 64000; entry += step)
+      entries.insert(entry);
+   for (Long64_t entry = 64000 + offset; entry < 3 * 64000; entry += 2)
+      entries.insert(entry);
+   for (Long64_t entry = 3 * 64000; entry < 4 * 64000; entry += 1)
+      if (entry % (step + 13) != 0)
+         entries.insert(entry);
+   return entries;
+}
+
+void Fill(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   for (auto entry : entries)
+      elist.Enter(entry);
+   elist.OptimizeStorage();
+}
+
+void ExpectEntries(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   ASSERT_EQ(elist.GetN(), static_cast<Long64_t>(entries.size()));
+   Long64_t i = 0;
+   for (auto entry : entries)
+      EXPECT_EQ(elist.GetEntry(i++), entry);
+   for (Long64_t entry = 0; entry < 4 * 64000; entry += 37)
+      EXPECT_EQ(elist.Contains(entry) != 0, entries.count(entry) != 0) << entry;
+}
+
+void TestSetOperations()
+{
+   auto a = MakeEntries(3, 0);
+   auto b = MakeEntries(5, 1);
+
+   std::set<Long64_t> expected;
+   std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected, expected.end()));
+   TEntryList l1, l2;
+   Fill(l1, a);
+   Fill(l2, b);
+   l1.Add(&l2);
+   ExpectEntries(l1, expected);
+
+   expected.clear();
+   std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected, expected.end()));
+   TEntryList l3, l4;
+   Fill(l3, a);
+   Fill(l4, b);
+   l3.Subtract(&l4);
+   ExpectEntries(l3, expected);
+
+   expected.clear();
+   std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected, expected.end()));
+   TEntryList l5, l6;
+   Fill(l5, a);
+   Fill(l6, b);
+   l5.Intersect(&l6);
+   ExpectEntries(l5, expected);
+}
+
+} // anonymous namespace
+
+TEST(TEntryList, SetOperations)
+{
+   TestSetOperations();
+}
+
+#ifdef R__USE_IMT
+TEST(TEntryList, SetOperationsMT)
+{
+   ROOT::EnableImplicitMT(4);
+   TestSetOperations();
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+TEST(TEntryList, IntersectDifferentTrees)
+{
+   TEntryList l1("l1", "", "t1", "f.root");
+   TEntryList l2("l2", "", "t2", "f.root");
+   l1.Enter(1);
+   l1.Enter(2);
+   l2.Enter(2);
+   l1.Intersect(&l2);
+   EXPECT_EQ(l1.GetN(), 0);
+   EXPECT_EQ(l1.Contains(2), 0);
+}
@@ -66,7 +66,7 @@ class TTreeReaderValueFastBase {
              }
              fRemaining -= adjust;
           } else {
-             fRemaining = fBranch->GetBulkRead().GetEntriesSerialized(eventNum, fBuffer);
+             fRemaining = ReadEntries(eventNum);
              if (R__unlikely(fRemaining < 0)) {
                 fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadError;
                 //printf("Failed to retrieve entries from the branch.\n");
@@ -84,13 +84,18 @@ class TTreeReaderValueFastBase {
 
    protected:
 
+      // Read the events of the basket starting at eventNum into fBuffer; returns the number of events read.
+      virtual Int_t ReadEntries(Long64_t eventNum) {
+         return fBranch->GetBulkRead().GetEntriesSerialized(eventNum, fBuffer);
+      }
+
       // Adjust the current buffer offset forward N events.
       virtual Int_t Adjust(Int_t eventCount) {
          Int_t bufOffset = fBuffer.Length();
-         fBuffer.SetBufferOffset(bufOffset + eventCount*GetSize());
+         fBuffer.SetBufferOffset(bufOffset + eventCount*GetElementSize());
          return 0;
       }
-      virtual UInt_t GetSize() = 0;
+      virtual UInt_t GetElementSize() = 0;
 
       void MarkTreeReaderUnavailable() {
          fTreeReader = nullptr;
@@ -142,7 +147,7 @@ class TTreeReaderValueFast final : public ROOT::Experimental::Internal::TTreeRea
       T* Deserialize(char *) {return nullptr;}
 
       const char *GetTypeName() override {return "{INCOMPLETE}";}
-      UInt_t GetSize() override {return sizeof(T);}
+      UInt_t GetElementSize() override {return sizeof(T);}
 };
 
 template<>
@@ -162,7 +167,7 @@ class TTreeReaderValueFast<float> final : public ROOT::Experimental::Internal::T
    protected:
       const char *GetTypeName() override {return "float";}
       const char *BranchTypeName() override {return "float";}
-      UInt_t GetSize() override {return sizeof(float);}
+      UInt_t GetElementSize() override {return sizeof(float);}
       float * Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       float fTmp;
@@ -187,7 +192,7 @@ class TTreeReaderValueFast<double> final : public ROOT::Experimental::Internal::
    protected:
       const char *GetTypeName() override {return "double";}
       const char *BranchTypeName() override {return "double";}
-      UInt_t GetSize() override {return sizeof(double);}
+      UInt_t GetElementSize() override {return sizeof(double);}
       double* Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       double fTmp;
@@ -210,7 +215,7 @@ class TTreeReaderValueFast<Int_t> final : public ROOT::Experimental::Internal::T
    protected:
       const char *GetTypeName() override {return "integer";}
       const char *BranchTypeName() override {return "integer";}
-      UInt_t GetSize() override {return sizeof(Int_t);}
+      UInt_t GetElementSize() override {return sizeof(Int_t);}
       Int_t* Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       Int_t fTmp;
@@ -233,7 +238,7 @@ class TTreeReaderValueFast<UInt_t> final : public ROOT::Experimental::Internal::
    protected:
       const char *GetTypeName() override {return "unsigned integer";}
       const char *BranchTypeName() override {return "unsigned integer";}
-      UInt_t GetSize() override {return sizeof(UInt_t);}
+      UInt_t GetElementSize() override {return sizeof(UInt_t);}
       UInt_t* Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       UInt_t fTmp;
@@ -256,12 +261,58 @@ class TTreeReaderValueFast<bool> final : public ROOT::Experimental::Internal::TT
    protected:
       const char *GetTypeName() override {return "unsigned integer";}
       const char *BranchTypeName() override {return "unsigned integer";}
-      UInt_t GetSize() override {return sizeof(bool);}
+      UInt_t GetElementSize() override {return sizeof(bool);}
       bool* Deserialize(char *input) {frombuf(input, &fTmp); return &fTmp;}
 
       bool fTmp;
 };
 
+/* Reads variable-length branches -- `x[n]/F` leaves, fixed-size arrays, and
+ * unsplit std::vector of fundamental types -- one basket at a time.  The values
+ * of the basket are byte-swapped once when it is read; the elements of the
+ * current event are then accessed in place.
+ */
+template <typename T>
+class TTreeReaderArrayFast final : public ROOT::Experimental::Internal::TTreeReaderValueFastBase {
+   static_assert(std::is_arithmetic<T>::value, "TTreeReaderArrayFast only supports fundamental types");
+
+   public:
+      TTreeReaderArrayFast(TTreeReaderFast &tr, const std::string &branchname) :
+            TTreeReaderValueFastBase(&tr, branchname),
+            fOffsetBuffer(TBuffer::kWrite, 32*1024) {}
+
+      std::size_t GetSize() const { return Offsets()[fEvtIndex + 1] - Offsets()[fEvtIndex]; }
+      bool IsEmpty() const { return !GetSize(); }
+      T *begin() const { return Values() + Offsets()[fEvtIndex]; }
+      T *end() const { return Values() + Offsets()[fEvtIndex + 1]; }
+      T &At(std::size_t idx) const { return begin()[idx]; }
+      T &operator[](std::size_t idx) const { return At(idx); }
+
+   protected:
+      Int_t ReadEntries(Long64_t eventNum) override {
+         fFirstEvent = 0;
+         return fBranch->GetBulkRead().GetBulkEntries(eventNum, fBuffer, fOffsetBuffer);
+      }
+      Int_t Adjust(Int_t eventCount) override {
+         fFirstEvent += eventCount;
+         return 0;
+      }
+
+      const char *GetTypeName() override {return "array";}
+      const char *BranchTypeName() override {return "array";}
+      UInt_t GetElementSize() override {return sizeof(T);}
+
+   private:
+      T *Values() const { return reinterpret_cast<T *>(const_cast<TBufferFile &>(fBuffer).GetCurrent()); }
+      const Int_t *Offsets() const
+      {
+         return reinterpret_cast<const Int_t *>(const_cast<TBufferFile &>(fOffsetBuffer).GetCurrent()) + fFirstEvent;
+      }
+
+      TBufferFile fOffsetBuffer;  // N+1 element offsets of the events in fBuffer.
+      Int_t        fFirstEvent{0}; // Index in fOffsetBuffer of the event at fEventBase.
+};
+
 }  // Experimental
 }  // ROOT
 
@@ -107,6 +107,7 @@ public:
    /// See TSelectorDraw::GetVal
    virtual Double_t *GetV4() const   {return GetVal(3);}
    virtual Double_t *GetW() const    {return fW;}
+   virtual void      FillValues(const Double_t *values, Double_t weight);
    bool      Notify() override;
    bool      Process(Long64_t /*entry*/) override { return false; }
    void      ProcessFill(Long64_t entry) override;
@@ -24,6 +24,8 @@
 
 #include "TVirtualIndex.h"
 
+#include <vector>
+
 class TTreeFormula;
 
 class TTreeIndex : public TVirtualIndex {
@@ -38,9 +40,13 @@ protected:
    TTreeFormula  *fMinorFormula;        ///<! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  ///<! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  ///<! Pointer to minor TreeFormula in Parent tree (if any)
+   const TTree   *fLookAheadParent = nullptr; ///<! Parent tree of the entries looked up ahead (see LookAheadFriend)
+   Long64_t       fLookAheadFirst = 0;        ///<! First parent entry looked up ahead
+   std::vector<Long64_t> fLookAheadEntries;   ///<! Entry numbers matching the parent entries looked up ahead
 
    TTreeFormula  *GetMajorFormulaParent(const TTree *parent);
    TTreeFormula  *GetMinorFormulaParent(const TTree *parent);
+   void           ResetLookAhead();
 
 private:
    TTreeIndex(const TTreeIndex&) = delete;            // Not implemented.
@@ -65,6 +71,7 @@ public:
    virtual TTreeFormula  *GetMajorFormula();
    virtual TTreeFormula  *GetMinorFormula();
    bool           IsValidFor(const TTree *parent) override;
+   void           LookAheadFriend(const TTree *parent, Long64_t first, Long64_t last, std::vector<Long64_t> &entries);
    void           Print(Option_t *option="") const override;
    void           UpdateFormulaLeaves(const TTree *parent) override;
    void           SetTree(TTree *T) override;
@@ -53,10 +53,12 @@ protected:
    TList         *fInput;           ///<! input list to the selector
    TList         *fFormulaList;     ///<! Pointer to a list of coordinated list TTreeFormula (used by Scan and Query)
    TSelector     *fSelectorUpdate;  ///<! Set to the selector address when it's entry list needs to be updated by the UpdateFormulaLeaves function
+   bool           fDrawJit;         ///<! True if the expressions of DrawSelect are compiled (option "jit")
 
 protected:
    const   char  *GetNameByIndex(TString &varexp, Int_t *index,Int_t colindex);
    void           DeleteSelectorFromFile();
+   bool           ProcessDraw(Long64_t firstentry, Long64_t nentries);
 
 public:
    TTreePlayer();
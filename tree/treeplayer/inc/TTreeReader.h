@@ -30,6 +30,7 @@
 #include <iterator>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 class TDictionary;
 class TDirectory;
@@ -229,6 +230,11 @@ public:
 
    EEntryStatus SetEntriesRange(Long64_t beginEntry, Long64_t endEntry);
 
+   /// Do not add the branches with these names to the TTreeCache. Their values are still read on access, one basket
+   /// at a time; this avoids filling the cache with branches that are read only for a few entries.
+   /// Must be called before the first entry is loaded.
+   void SetUncachedBranches(const std::vector<std::string> &branchNames) { fUncachedBranches = branchNames; }
+
    ///  Get the begin and end entry numbers
    ///
    /// \return a pair contained the begin and end entry numbers.
@@ -326,6 +332,9 @@ private:
    Long64_t fBeginEntry = 0LL; ///< This allows us to propagate the range to the TTreeCache
    bool fProxiesSet = false; ///< True if the proxies have been set, false otherwise
    bool fSetEntryBaseCallingLoadTree = false; ///< True if during the LoadTree execution triggered by SetEntryBase.
+   std::vector<std::string> fUncachedBranches; ///< Branches of the readers that are not added to the TTreeCache
+   Long64_t fFriendLookAheadBegin = -1; ///< First entry of fTree whose indexed friend entries were looked up ahead
+   Long64_t fFriendLookAheadEnd = -1;   ///< Entry of fTree following the last one whose indexed friend entries were looked up ahead
 
    // Flag to activate or deactivate warnings in case the friend trees have
    // more entries than the main one. In some cases we may want to deactivate
@@ -334,6 +343,7 @@ private:
    // alignment.
    bool fWarnAboutLongerFriends{true};
    void WarnIfFriendsHaveMoreEntries();
+   void LookAheadIndexedFriends(Long64_t entry);
 
    friend class ROOT::Internal::TTreeReaderValueBase;
    friend class ROOT::Internal::TTreeReaderArrayBase;
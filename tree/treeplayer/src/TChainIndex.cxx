@@ -22,12 +22,21 @@ and kept inside this chain index.
 
 #include "TChainIndex.h"
 #include "TChain.h"
+#include "TChainElement.h"
 #include "TTreeFormula.h"
 #include "TTreeIndex.h"
 #include "TFile.h"
 #include "TError.h"
+#include "TROOT.h"
+#include "TreeIndexUtils.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 #include <cstring> // std::strlen
+#include <memory>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 /// \class TChainIndex::TChainIndexEntry
@@ -79,6 +88,8 @@ TChainIndex::TChainIndex(): TVirtualIndex()
 /// If any of those requirements isn't met the object becomes a zombie.
 /// If some subtrees don't have indices the indices are created and stored inside this
 /// TChainIndex.
+/// When the implicit multi-threading is enabled, these indices are built in
+/// parallel, the trees being read from their files by the tasks.
 
 TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *minorname)
            : TVirtualIndex()
@@ -98,9 +109,19 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
    fMajorName          = majorname;
    fMinorName          = minorname;
    Int_t i = 0;
+   bool built = false;
+
+#ifdef R__USE_IMT
+   // Build the indices of the trees in parallel, each task reading its own file.
+   if (ROOT::IsImplicitMTEnabled() && chain->GetNtrees() > 1 && !chain->GetListOfFriends()) {
+      if (!BuildIndicesMT(chain))
+         return;
+      built = true;
+   }
+#endif
 
    // Go through all the trees and check if they have indeces. If not then build them.
-   for (i = 0; i < chain->GetNtrees(); i++) {
+   for (i = built ? chain->GetNtrees() : 0; i < chain->GetNtrees(); i++) {
       chain->LoadTree((chain->GetTreeOffset())[i]);
       TVirtualIndex *index = chain->GetTree()->GetTreeIndex();
 
@@ -150,6 +171,90 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
    }
 }
 
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// Fill fEntries with the indices of the trees of chain, building them in
+/// parallel when the trees don't have one. Return false, the object being a
+/// zombie if needed, in case of error.
+
+bool TChainIndex::BuildIndicesMT(TChain *chain)
+{
+   const Int_t ntrees = chain->GetNtrees();
+   std::vector<TChainIndexEntry> entries(ntrees);
+   std::vector<TString> errors(ntrees);
+   std::vector<bool> zombies(ntrees, true);
+
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(
+      [&](Int_t k) {
+         auto element = static_cast<TChainElement *>(chain->GetListOfFiles()->At(k));
+         std::unique_ptr<TFile> file(TFile::Open(element->GetTitle()));
+         TTree *tree = (file && !file->IsZombie()) ? file->Get<TTree>(element->GetName()) : nullptr;
+         if (!tree) {
+            errors[k] = "Error creating a tree index on a tree in the chain";
+            return;
+         }
+         // if an index already exists, major/minorname must correspond to this one
+         TVirtualIndex *index = tree->GetTreeIndex();
+         if (index) {
+            if (strcmp(fMajorName, index->GetMajorName()) || strcmp(fMinorName, index->GetMinorName())) {
+               errors[k].Form("Tree in file %s has an index built with majorname=%s and minorname=%s",
+                              file->GetName(), index->GetMajorName(), index->GetMinorName());
+               return;
+            }
+            auto ti_index = dynamic_cast<TTreeIndex *>(index);
+            if (index->IsZombie() || index->GetN() == 0) {
+               errors[k] = "Error creating a tree index on a tree in the chain";
+            } else if (!ti_index) {
+               errors[k].Form("The underlying TTree must have a TTreeIndex but has a %s.", index->IsA()->GetName());
+               zombies[k] = false;
+            } else {
+               entries[k].SetMinMaxFrom(ti_index);
+            }
+            return;
+         }
+         // the parallelism is over the trees, the index values are evaluated sequentially
+         const bool sequential = ROOT::Internal::TreeIndex::SequentialBuild();
+         ROOT::Internal::TreeIndex::SequentialBuild() = true;
+         TTreeIndex treeIndex(tree, fMajorName, fMinorName);
+         ROOT::Internal::TreeIndex::SequentialBuild() = sequential;
+         if (treeIndex.IsZombie() || treeIndex.GetN() == 0) {
+            errors[k] = "Error creating a tree index on a tree in the chain";
+            return;
+         }
+         // the copy is not attached to the tree, which is deleted with the file
+         auto copy = static_cast<TTreeIndex *>(treeIndex.Clone());
+         entries[k].SetMinMaxFrom(copy);
+         entries[k].fTreeIndex = copy;
+      },
+      ROOT::TSeqI(ntrees));
+
+   fEntries.reserve(ntrees);
+   for (Int_t k = 0; k < ntrees; k++) {
+      if (errors[k].Length()) {
+         for (Int_t j = k; j < ntrees; j++)
+            delete entries[j].fTreeIndex;
+         if (zombies[k]) {
+            DeleteIndices();
+            MakeZombie();
+         }
+         Error("TChainIndex", "%s", errors[k].Data());
+         return false;
+      }
+      // moved rather than copied, the copy constructor clones the index
+      fEntries.emplace_back();
+      TChainIndexEntry &entry = fEntries.back();
+      entry.fMinIndexValue = entries[k].fMinIndexValue;
+      entry.fMinIndexValMinor = entries[k].fMinIndexValMinor;
+      entry.fMaxIndexValue = entries[k].fMaxIndexValue;
+      entry.fMaxIndexValMinor = entries[k].fMaxIndexValMinor;
+      entry.fTreeIndex = entries[k].fTreeIndex;
+      entries[k].fTreeIndex = nullptr;
+   }
+   return true;
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add an index to this chain.
 /// if delaySort is false (default) check if the indices of different trees are in order.
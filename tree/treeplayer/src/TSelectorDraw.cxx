@@ -1148,6 +1148,29 @@ UInt_t TSelectorDraw::SplitNames(const TString &varexp, std::vector<TString> &na
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the values of the fDimension expressions for one selected instance,
+/// weight being the value of the selection. This is the equivalent of
+/// ProcessFill for values computed outside of the TTreeFormulas, see option
+/// "jit" of TTreePlayer::DrawSelect.
+
+void TSelectorDraw::FillValues(const Double_t *values, Double_t weight)
+{
+   if (fNfill >= fTree->GetEstimate())
+      fNfill = 0;
+
+   fW[fNfill] = fWeight * weight;
+   if (!fW[fNfill]) return;
+   if (fVal) {
+      for (Int_t i = 0; i < fDimension; ++i)
+         fVal[i][fNfill] = values[i];
+   }
+   fNfill++;
+   if (fNfill >= fTree->GetEstimate()) {
+      TakeAction();
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This function is called at the first entry of a new tree in a chain.
 
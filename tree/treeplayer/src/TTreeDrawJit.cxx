@@ -0,0 +1,459 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TTreeDrawJit.h"
+
+#include "RConfigure.h"
+#include "TBranch.h"
+#include "TInterpreter.h"
+#include "TLeaf.h"
+#include "TLeafC.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TVirtualMutex.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace {
+
+/// Number of values buffered by a reader before they are passed to the sink
+constexpr std::size_t kRowsBuffer = 1 << 14;
+
+struct Token {
+   enum EKind { kIdentifier, kNumber, kOperator };
+   EKind fKind;
+   std::string fText;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Split expr in tokens, return false if it contains anything not supported.
+
+bool Tokenize(const char *expr, std::vector<Token> &tokens)
+{
+   static const char *const twoCharOps[] = {"&&", "||", "==", "!=", "<=", ">="};
+   const std::string s = expr;
+   std::size_t i = 0;
+   while (i < s.size()) {
+      const char c = s[i];
+      if (std::isspace(c)) {
+         ++i;
+      } else if (std::isalpha(c) || c == '_') {
+         std::size_t j = i + 1;
+         while (true) {
+            while (j < s.size() && (std::isalnum(s[j]) || s[j] == '_'))
+               ++j;
+            // qualified names, e.g. TMath::Sqrt
+            if (j + 2 < s.size() && s[j] == ':' && s[j + 1] == ':' && std::isalpha(s[j + 2]))
+               j += 2;
+            else
+               break;
+         }
+         if (j < s.size() && s[j] == '$')
+            ++j;
+         tokens.push_back({Token::kIdentifier, s.substr(i, j - i)});
+         i = j;
+      } else if (std::isdigit(c) || (c == '.' && i + 1 < s.size() && std::isdigit(s[i + 1]))) {
+         std::size_t j = i;
+         while (j < s.size() && (std::isdigit(s[j]) || s[j] == '.'))
+            ++j;
+         if (j < s.size() && (s[j] == 'e' || s[j] == 'E')) {
+            ++j;
+            if (j < s.size() && (s[j] == '+' || s[j] == '-'))
+               ++j;
+            while (j < s.size() && std::isdigit(s[j]))
+               ++j;
+         }
+         if (j < s.size() && (std::isalpha(s[j]) || s[j] == '_'))
+            return false; // hexadecimal or suffixed literals
+         tokens.push_back({Token::kNumber, s.substr(i, j - i)});
+         i = j;
+      } else {
+         bool found = false;
+         for (const char *op : twoCharOps) {
+            if (s.compare(i, 2, op) == 0) {
+               tokens.push_back({Token::kOperator, op});
+               i += 2;
+               found = true;
+               break;
+            }
+         }
+         if (found)
+            continue;
+         // '^', '%' and the bitwise operators don't have the TTreeFormula meaning in C++
+         if (!std::strchr("+-*/()[],<>!", c))
+            return false;
+         tokens.push_back({Token::kOperator, std::string(1, c)});
+         ++i;
+      }
+   }
+   return !tokens.empty();
+}
+
+/// Mathematical functions of TTreeFormula and their C++ equivalent
+const std::map<std::string, std::string> &GetFunctions()
+{
+   static const std::map<std::string, std::string> functions{
+      {"sqrt", "std::sqrt"},   {"abs", "std::abs"},     {"fabs", "std::fabs"},   {"exp", "std::exp"},
+      {"log", "std::log"},     {"log10", "std::log10"}, {"sin", "std::sin"},     {"cos", "std::cos"},
+      {"tan", "std::tan"},     {"asin", "std::asin"},   {"acos", "std::acos"},   {"atan", "std::atan"},
+      {"atan2", "std::atan2"}, {"sinh", "std::sinh"},   {"cosh", "std::cosh"},   {"tanh", "std::tanh"},
+      {"pow", "std::pow"},     {"floor", "std::floor"}, {"ceil", "std::ceil"},   {"min", "TMath::Min"},
+      {"max", "TMath::Max"}};
+   return functions;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Lowering of TTreeFormula expressions to C++.
+
+class Lowerer {
+   struct Leaf {
+      std::string fType;
+      bool fIsArray;
+   };
+
+   TTree *fTree;
+   std::map<std::string, Leaf> fLeaves; ///< Branches read by the expressions
+
+   const Leaf *FindLeaf(const std::string &name);
+   std::size_t FindClosing(const std::vector<Token> &t, std::size_t open) const;
+
+public:
+   explicit Lowerer(TTree *tree) : fTree(tree) {}
+
+   bool Lower(const std::vector<Token> &t, std::size_t begin, std::size_t end, Int_t depth,
+              std::set<std::string> &arrays, std::string &out);
+   static std::string Size(const std::set<std::string> &arrays);
+   std::string Declarations() const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the description of branch name, nullptr if it is not a numerical
+/// branch with a single scalar or one-dimensional array leaf.
+
+const Lowerer::Leaf *Lowerer::FindLeaf(const std::string &name)
+{
+   auto it = fLeaves.find(name);
+   if (it != fLeaves.end())
+      return &it->second;
+
+   TBranch *branch = fTree->GetBranch(name.c_str());
+   if (!branch || branch->IsA() != TBranch::Class() || branch->GetListOfLeaves()->GetEntriesFast() != 1)
+      return nullptr;
+   auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->At(0));
+   if (leaf->InheritsFrom(TLeafC::Class()))
+      return nullptr;
+   static const std::set<std::string> types{"Bool_t",  "Char_t",   "UChar_t", "Short_t",  "UShort_t",
+                                            "Int_t",   "UInt_t",   "Long_t",  "ULong_t",  "Long64_t",
+                                            "ULong64_t", "Float_t", "Double_t"};
+   const std::string type = leaf->GetTypeName();
+   if (!types.count(type))
+      return nullptr;
+   const std::string title = leaf->GetTitle();
+   if (std::count(title.begin(), title.end(), '[') > 1)
+      return nullptr;
+   const bool isArray = leaf->GetLeafCount() || leaf->GetLenStatic() > 1;
+   return &fLeaves.emplace(name, Leaf{type, isArray}).first->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Index of the parenthesis closing the one at open, t.size() if none.
+
+std::size_t Lowerer::FindClosing(const std::vector<Token> &t, std::size_t open) const
+{
+   Int_t level = 0;
+   for (std::size_t i = open; i < t.size(); ++i) {
+      if (t[i].fText == "(")
+         ++level;
+      else if (t[i].fText == ")" && --level == 0)
+         return i;
+   }
+   return t.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// C++ expression of the number of instances of the implicit loop over arrays.
+
+std::string Lowerer::Size(const std::set<std::string> &arrays)
+{
+   if (arrays.empty())
+      return "std::size_t(1)";
+   std::string size;
+   for (const auto &name : arrays)
+      size += (size.empty() ? "std::min<std::size_t>({" : ", ") + std::string("a_") + name + ".GetSize()";
+   return size + "})";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Lower the tokens [begin, end) to a C++ expression. depth is the depth of the
+/// implicit loops, whose index is i<depth>; the arrays looped over are added to
+/// arrays. Return false if the tokens use anything not supported.
+
+bool Lowerer::Lower(const std::vector<Token> &t, std::size_t begin, std::size_t end, Int_t depth,
+                    std::set<std::string> &arrays, std::string &out)
+{
+   const std::string index = "i" + std::to_string(depth);
+   // for each open parenthesis, whether it is a function call (where commas are allowed)
+   std::vector<bool> calls;
+   bool operand = false;
+   for (std::size_t i = begin; i < end; ++i) {
+      const Token &tok = t[i];
+      const bool call = i + 1 < end && t[i + 1].fText == "(";
+
+      if (tok.fKind == Token::kNumber) {
+         out += tok.fText;
+         if (tok.fText.find_first_of(".eE") == std::string::npos)
+            out += ".";
+         operand = true;
+
+      } else if (tok.fKind == Token::kOperator) {
+         if (tok.fText == "[" || tok.fText == "]")
+            return false;
+         if (tok.fText == "(") {
+            calls.push_back(operand);
+         } else if (tok.fText == ")") {
+            if (calls.empty())
+               return false;
+            calls.pop_back();
+         } else if (tok.fText == ",") {
+            if (calls.empty() || !calls.back())
+               return false;
+         }
+         out += tok.fText;
+         operand = tok.fText == ")";
+
+      } else if (call && (tok.fText == "Sum$" || tok.fText == "Min$" || tok.fText == "Max$" || tok.fText == "Length$")) {
+         const std::size_t close = FindClosing(t, i + 1);
+         if (close >= end || close == i + 2)
+            return false;
+         std::set<std::string> inner;
+         std::string expr;
+         // commas at the top level of the argument are rejected as not being in a call
+         if (!Lower(t, i + 2, close, depth + 1, inner, expr))
+            return false;
+         const std::string n = "n" + std::to_string(depth + 1);
+         const std::string j = "i" + std::to_string(depth + 1);
+         const std::string loop = "const std::size_t " + n + " = " + Size(inner) + "; for (std::size_t " + j +
+                                  " = 0; " + j + " < " + n + "; ++" + j + ")";
+         if (tok.fText == "Length$")
+            out += "Double_t(" + Size(inner) + ")";
+         else if (tok.fText == "Sum$")
+            out += "([&]() { Double_t s = 0; " + loop + " s += " + expr + "; return s; }())";
+         else
+            out += "([&]() { Double_t m = 0; " + loop + " { const Double_t v = " + expr + "; if (" + j + " == 0 || v " +
+                   (tok.fText == "Max$" ? ">" : "<") + " m) m = v; } return m; }())";
+         i = close;
+         operand = true;
+
+      } else if (call) {
+         const auto &functions = GetFunctions();
+         auto it = functions.find(tok.fText);
+         if (it != functions.end())
+            out += it->second;
+         else if (tok.fText.compare(0, 7, "TMath::") == 0 && tok.fText.find('$') == std::string::npos)
+            out += tok.fText;
+         else
+            return false;
+         operand = true;
+
+      } else if (tok.fText == "Iteration$") {
+         out += "Double_t(" + index + ")";
+         operand = true;
+
+      } else {
+         const Leaf *leaf = FindLeaf(tok.fText);
+         if (!leaf)
+            return false;
+         if (!leaf->fIsArray) {
+            out += "Double_t(*v_" + tok.fText + ")";
+         } else if (i + 1 < end && t[i + 1].fText == "[") {
+            // constant index, the instance is skipped if it is out of range
+            if (i + 3 >= end || t[i + 2].fKind != Token::kNumber ||
+                t[i + 2].fText.find_first_not_of("0123456789") != std::string::npos || t[i + 3].fText != "]" ||
+                (i + 4 < end && t[i + 4].fText == "["))
+               return false;
+            out += "R__TTreeDrawJit::At(a_" + tok.fText + ", " + t[i + 2].fText + ", ok)";
+            i += 3;
+         } else {
+            arrays.insert(tok.fText);
+            out += "Double_t(a_" + tok.fText + "[" + index + "])";
+         }
+         operand = true;
+      }
+   }
+   return calls.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declarations of the TTreeReaderValues and TTreeReaderArrays of the branches.
+
+std::string Lowerer::Declarations() const
+{
+   std::string decl;
+   for (const auto &leaf : fLeaves) {
+      const std::string &name = leaf.first;
+      if (leaf.second.fIsArray)
+         decl += "   TTreeReaderArray<" + leaf.second.fType + "> a_" + name + "(r, \"" + name + "\");\n";
+      else
+         decl += "   TTreeReaderValue<" + leaf.second.fType + "> v_" + name + "(r, \"" + name + "\");\n";
+   }
+   return decl;
+}
+
+struct SinkContext {
+   const ROOT::Internal::TTreeDrawJit::Sink_t *fSink;
+   std::mutex *fMutex;
+};
+
+void CallSink(void *context, std::vector<Double_t> &rows)
+{
+   auto ctx = static_cast<SinkContext *>(context);
+   if (rows.empty())
+      return;
+   if (ctx->fMutex) {
+      std::lock_guard<std::mutex> lock(*ctx->fMutex);
+      (*ctx->fSink)(rows);
+   } else {
+      (*ctx->fSink)(rows);
+   }
+   rows.clear();
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the expressions (the dimensions of TTree::Draw, in the order of
+/// TSelectorDraw) and the selection, which can be empty. Return nullptr if
+/// they can't be lowered to C++ or compiled.
+
+std::unique_ptr<ROOT::Internal::TTreeDrawJit>
+ROOT::Internal::TTreeDrawJit::Create(TTree *tree, const std::vector<TString> &expressions, const char *selection)
+{
+   if (!tree || expressions.empty() || !gInterpreter)
+      return nullptr;
+
+   Lowerer lowerer(tree);
+   std::set<std::string> arrays;
+   std::vector<std::string> exprs;
+   for (const auto &expression : expressions) {
+      std::vector<Token> tokens;
+      std::string expr;
+      if (!Tokenize(expression.Data(), tokens) || !lowerer.Lower(tokens, 0, tokens.size(), 0, arrays, expr))
+         return nullptr;
+      exprs.push_back(expr);
+   }
+   std::string weight = "1.";
+   if (selection && selection[0]) {
+      std::vector<Token> tokens;
+      weight.clear();
+      if (!Tokenize(selection, tokens) || !lowerer.Lower(tokens, 0, tokens.size(), 0, arrays, weight))
+         return nullptr;
+   }
+
+   std::string body = "(TTreeReader &r, std::vector<Double_t> &rows, void (*sink)(void *, std::vector<Double_t> &), "
+                      "void *context)\n{\n";
+   body += lowerer.Declarations();
+   body += "   while (r.Next()) {\n";
+   body += "      const std::size_t n0 = " + Lowerer::Size(arrays) + ";\n";
+   body += "      for (std::size_t i0 = 0; i0 < n0; ++i0) {\n";
+   body += "         bool ok = true;\n";
+   body += "         const Double_t w = " + weight + ";\n";
+   body += "         if (!ok || w == 0) continue;\n";
+   std::string row;
+   for (std::size_t k = 0; k < exprs.size(); ++k) {
+      body += "         const Double_t x" + std::to_string(k) + " = " + exprs[k] + ";\n";
+      row += "x" + std::to_string(k) + ", ";
+   }
+   body += "         if (!ok) continue;\n";
+   body += "         rows.insert(rows.end(), {" + row + "w});\n";
+   body += "      }\n";
+   body += "      if (rows.size() >= " + std::to_string(kRowsBuffer) + ") sink(context, rows);\n";
+   body += "   }\n";
+   body += "   sink(context, rows);\n}\n";
+
+   // the functions are compiled once per process
+   static std::map<std::string, Function_t> functions;
+   R__LOCKGUARD(gInterpreterMutex);
+   auto it = functions.find(body);
+   if (it != functions.end())
+      return std::unique_ptr<TTreeDrawJit>(new TTreeDrawJit(it->second, expressions.size()));
+
+   static bool declared = gInterpreter->Declare(R"CODE(
+#include "TTreeReader.h"
+#include "TTreeReaderArray.h"
+#include "TTreeReaderValue.h"
+#include "TMath.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+namespace R__TTreeDrawJit {
+template <typename T>
+Double_t At(TTreeReaderArray<T> &a, std::size_t i, bool &ok)
+{
+   if (i < a.GetSize())
+      return a[i];
+   ok = false;
+   return 0;
+}
+}
+)CODE");
+   if (!declared)
+      return nullptr;
+
+   const std::string name = "Fill" + std::to_string(functions.size());
+   if (!gInterpreter->Declare(("namespace R__TTreeDrawJit {\nvoid " + name + body + "}\n").c_str()))
+      return nullptr;
+   TInterpreter::EErrorCode error = TInterpreter::kNoError;
+   auto address = gInterpreter->Calc(("(Longptr_t)&R__TTreeDrawJit::" + name + ";").c_str(), &error);
+   if (error != TInterpreter::kNoError || !address)
+      return nullptr;
+   auto function = reinterpret_cast<Function_t>(address);
+   functions.emplace(body, function);
+   return std::unique_ptr<TTreeDrawJit>(new TTreeDrawJit(function, expressions.size()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process the entries [firstentry, firstentry + nentries) of tree and pass the
+/// selected rows to sink. With parallel, and implicit multithreading enabled,
+/// the clusters are processed concurrently and sink is called with a lock held,
+/// in a non-deterministic order; the tree must then be read from files.
+
+void ROOT::Internal::TTreeDrawJit::Run(TTree *tree, Long64_t firstentry, Long64_t nentries, bool parallel,
+                                       const Sink_t &sink) const
+{
+#ifdef R__USE_IMT
+   if (parallel && ROOT::IsImplicitMTEnabled() && tree->GetCurrentFile()) {
+      std::mutex mutex;
+      SinkContext context{&sink, &mutex};
+      ROOT::TTreeProcessorMT processor(*tree, 0u, {firstentry, firstentry + nentries});
+      processor.Process([&](TTreeReader &reader) {
+         std::vector<Double_t> rows;
+         fFunction(reader, rows, &CallSink, &context);
+      });
+      return;
+   }
+#else
+   (void)parallel;
+#endif
+   SinkContext context{&sink, nullptr};
+   TTreeReader reader(tree);
+   reader.SetEntriesRange(firstentry, firstentry + nentries);
+   std::vector<Double_t> rows;
+   fFunction(reader, rows, &CallSink, &context);
+}
@@ -0,0 +1,66 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeDrawJit
+#define ROOT_TTreeDrawJit
+
+#include "Rtypes.h"
+#include "TString.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class TTree;
+class TTreeReader;
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Native code for the expressions of TTree::Draw, see option "jit" of
+/// TTreePlayer::DrawSelect.
+///
+/// The expressions and the selection are lowered to a C++ function reading the
+/// branches with a TTreeReader, which is compiled by cling. Only the most common
+/// subset of the TTreeFormula syntax is supported: arithmetic and logical
+/// operators, the usual mathematical functions, the TMath functions, numerical
+/// branches holding a single leaf (scalars and one-dimensional arrays, with
+/// constant indices or the implicit loop over the instances), Iteration$,
+/// Length$, Sum$, Min$ and Max$. Create() returns nullptr for anything else,
+/// and the caller falls back to TTreeFormula.
+
+class TTreeDrawJit {
+public:
+   /// Receives rows of values, the dimension values of a row followed by its weight, and clears them
+   using Sink_t = std::function<void(std::vector<Double_t> &rows)>;
+
+private:
+   using Function_t = void (*)(TTreeReader &reader, std::vector<Double_t> &rows,
+                               void (*sink)(void *context, std::vector<Double_t> &rows), void *context);
+
+   Function_t fFunction = nullptr; ///< Compiled function
+   Int_t fDimension = 0;           ///< Number of expressions
+
+   TTreeDrawJit(Function_t function, Int_t dimension) : fFunction(function), fDimension(dimension) {}
+
+public:
+   static std::unique_ptr<TTreeDrawJit>
+   Create(TTree *tree, const std::vector<TString> &expressions, const char *selection);
+
+   Int_t GetDimension() const { return fDimension; }
+
+   void Run(TTree *tree, Long64_t firstentry, Long64_t nentries, bool parallel, const Sink_t &sink) const;
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -19,31 +19,254 @@ A Tree Index with majorname and minorname.
 #include "TTree.h"
 #include "TBuffer.h"
 #include "TMath.h"
-
+#include "TROOT.h"
+#include "TFile.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TLeafC.h"
+#include "TreeIndexUtils.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#include <atomic>
+#include <mutex>
+#endif
+
+#include <algorithm> // std::fill, std::min
 #include <cstring> // std::strlen
+#include <memory>
+#include <utility>
+#include <vector>
 
 ClassImp(TTreeIndex);
 
 
-struct IndexSortComparator {
+namespace {
+
+/// Number of bits of the digits of the radix sort
+constexpr Int_t kDigitBits = 11;
+constexpr UInt_t kBuckets = 1u << kDigitBits;
+/// Minimal number of index values of the blocks of the parallel loops
+constexpr Long64_t kBlockSize = 1 << 16;
 
-  IndexSortComparator(Long64_t *major, Long64_t *minor)
-        : fValMajor(major), fValMinor(minor)
-  {}
+/// Index value with its serial number, as unsigned 128-bit integer
+struct IndexKey {
+   ULong64_t fHigh;
+   ULong64_t fLow;
+   Long64_t fSerial;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(block) for the blocks [0, nblocks), in parallel if implicit
+/// multi-threading is enabled.
 
-   template<typename Index>
-   bool operator()(Index i1, Index i2) {
-      if( *(fValMajor + i1) == *(fValMajor + i2) )
-         return *(fValMinor + i1) < *(fValMinor + i2);
-      else
-         return *(fValMajor + i1) < *(fValMajor + i2);
+template <typename F>
+void ForeachBlock(Long64_t nblocks, F &&func)
+{
+#ifdef R__USE_IMT
+   if (nblocks > 1 && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(func, ROOT::TSeq<Long64_t>(nblocks));
+      return;
    }
+#endif
+   for (Long64_t b = 0; b < nblocks; ++b)
+      func(b);
+}
 
-  // pointers to the start of index values tables keeping upper 64bit and lower 64bit
-  // of combined indexed 128bit value
-  Long64_t *fValMajor, *fValMinor;
-};
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the n index values (major[i], minor[i]), the serial numbers being i,
+/// and store the serial numbers and the values in sorted order. This is a
+/// least significant digit radix sort of the 128-bit keys, whose passes are
+/// run in parallel over blocks of keys if implicit multi-threading is
+/// enabled. The sort is stable: equal index values keep the order of their
+/// serial numbers. The passes whose digit is the same for all the keys, e.g.
+/// the high bits of small run numbers, are skipped.
+
+void SortIndex(Long64_t n, const Long64_t *major, const Long64_t *minor, Long64_t *index, Long64_t *sortedMajor,
+               Long64_t *sortedMinor)
+{
+   // flipping the sign bits orders the signed values as unsigned ones
+   const ULong64_t sign = 1ull << 63;
+   Long64_t nblocks = 1;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled())
+      nblocks = std::max<Long64_t>(1, std::min<Long64_t>(n / kBlockSize, 4 * ROOT::GetThreadPoolSize()));
+#endif
+   const Long64_t blockSize = (n + nblocks - 1) / nblocks;
+   auto blockRange = [&](Long64_t b) {
+      return std::make_pair(b * blockSize, std::min(n, (b + 1) * blockSize));
+   };
+
+   std::vector<IndexKey> keys(n), sorted(n);
+   ForeachBlock(nblocks, [&](Long64_t b) {
+      const auto range = blockRange(b);
+      for (Long64_t i = range.first; i < range.second; ++i)
+         keys[i] = {ULong64_t(major[i]) ^ sign, ULong64_t(minor[i]) ^ sign, i};
+   });
+
+   std::vector<Long64_t> counts(nblocks * kBuckets);
+   for (Int_t shift = 0; shift < 128; shift += kDigitBits) {
+      auto digit = [shift](const IndexKey &key) -> UInt_t {
+         if (shift >= 64)
+            return (key.fHigh >> (shift - 64)) & (kBuckets - 1);
+         if (shift + kDigitBits <= 64)
+            return (key.fLow >> shift) & (kBuckets - 1);
+         return ((key.fLow >> shift) | (key.fHigh << (64 - shift))) & (kBuckets - 1);
+      };
+      std::fill(counts.begin(), counts.end(), 0);
+      ForeachBlock(nblocks, [&](Long64_t b) {
+         const auto range = blockRange(b);
+         Long64_t *count = &counts[b * kBuckets];
+         for (Long64_t i = range.first; i < range.second; ++i)
+            ++count[digit(keys[i])];
+      });
+      // offsets of the blocks in the buckets, in the order of the blocks for stability
+      Long64_t offset = 0;
+      bool trivial = false;
+      for (UInt_t d = 0; d < kBuckets; ++d) {
+         const Long64_t start = offset;
+         for (Long64_t b = 0; b < nblocks; ++b) {
+            const Long64_t count = counts[b * kBuckets + d];
+            counts[b * kBuckets + d] = offset;
+            offset += count;
+         }
+         if (offset - start == n)
+            trivial = true;
+      }
+      if (trivial)
+         continue;
+      ForeachBlock(nblocks, [&](Long64_t b) {
+         const auto range = blockRange(b);
+         Long64_t *next = &counts[b * kBuckets];
+         for (Long64_t i = range.first; i < range.second; ++i)
+            sorted[next[digit(keys[i])]++] = keys[i];
+      });
+      std::swap(keys, sorted);
+   }
+
+   ForeachBlock(nblocks, [&](Long64_t b) {
+      const auto range = blockRange(b);
+      for (Long64_t i = range.first; i < range.second; ++i) {
+         index[i] = keys[i].fSerial;
+         sortedMajor[i] = Long64_t(keys[i].fHigh ^ sign);
+         sortedMinor[i] = Long64_t(keys[i].fLow ^ sign);
+      }
+   });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Value of an index formula, warning if it may not be represented exactly.
+
+LongDouble_t EvalAndRangeCheck(TTreeFormula *formula, bool isMajor, const char *name, Long64_t entry)
+{
+   LongDouble_t ret = formula->EvalInstance<LongDouble_t>();
+   // Check whether the value (vs significant bits) of ldRet can represent
+   // the full precision of the returned value. If we return 10^60, the
+   // value fits into a long double, but if sizeof(long double) ==
+   // sizeof(double) it cannot store the ones: the value returned by
+   // EvalInstance() only stores the higher bits.
+   LongDouble_t retCloserToZero = ret;
+   if (ret > 0)
+      retCloserToZero -= 1;
+   else
+      retCloserToZero += 1;
+   if (retCloserToZero == ret) {
+      Warning("TTreeIndex::TTreeIndex",
+              "In tree entry %lld, %s value %s=%Lf possibly out of range for internal `long double`", entry,
+              isMajor ? "major" : "minor", name, ret);
+   }
+   return ret;
+}
+
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// Leaf of tree holding the index values given by name, if name is a branch
+/// holding a single integer: its values are then read directly, without a
+/// TTreeFormula.
+
+TLeaf *GetIntegerLeaf(TTree *tree, const char *name)
+{
+   TBranch *branch = tree->GetBranch(name);
+   if (!branch || branch->IsA() != TBranch::Class() || branch->GetListOfLeaves()->GetEntriesFast() != 1)
+      return nullptr;
+   auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->At(0));
+   if (leaf->GetLeafCount() || leaf->GetLenStatic() != 1 || leaf->InheritsFrom(TLeafC::Class()))
+      return nullptr;
+   static const char *const types[] = {"Bool_t", "Char_t",  "UChar_t",  "Short_t",  "UShort_t", "Int_t",
+                                       "UInt_t", "Long_t",  "ULong_t",  "Long64_t", "ULong64_t"};
+   for (const char *type : types) {
+      if (!std::strcmp(leaf->GetTypeName(), type))
+         return leaf;
+   }
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the index values of all the entries of tree, a TTree read from a
+/// file, in parallel over its clusters. Return false if the tree can't be
+/// processed by TTreeProcessorMT.
+
+bool EvalIndexValuesMT(TTree *tree, const TString &majorname, const TString &minorname, Long64_t *major,
+                       Long64_t *minor)
+{
+   std::unique_ptr<ROOT::TTreeProcessorMT> processor;
+   try {
+      processor = std::make_unique<ROOT::TTreeProcessorMT>(*tree);
+   } catch (const std::exception &) {
+      return false;
+   }
+   std::mutex mutex;
+   std::atomic<bool> ok{true};
+   processor->Process([&](TTreeReader &reader) {
+      TTree *chain = reader.GetTree();
+      // one formula or leaf for the major and for the minor values
+      std::unique_ptr<TTreeFormula> formulas[2];
+      TLeaf *leaves[2] = {nullptr, nullptr};
+      const TString *names[2] = {&majorname, &minorname};
+      Long64_t *values[2] = {major, minor};
+      Int_t treenumber = -1;
+      while (ok && reader.Next()) {
+         if (chain->GetTreeNumber() != treenumber) {
+            treenumber = chain->GetTreeNumber();
+            for (Int_t k = 0; k < 2; ++k) {
+               leaves[k] = GetIntegerLeaf(chain->GetTree(), names[k]->Data());
+               if (leaves[k]) {
+                  continue;
+               } else if (formulas[k]) {
+                  formulas[k]->UpdateFormulaLeaves();
+               } else {
+                  // the compilation of the formulas is not thread-safe
+                  std::lock_guard<std::mutex> lock(mutex);
+                  formulas[k] = std::make_unique<TTreeFormula>(k ? "Minor" : "Major", names[k]->Data(), chain);
+                  formulas[k]->SetQuickLoad(true);
+                  if (formulas[k]->GetNdim() != 1)
+                     ok = false;
+               }
+            }
+         }
+         const Long64_t entry = reader.GetCurrentEntry();
+         const Long64_t local = chain->GetTree()->GetReadEntry();
+         for (Int_t k = 0; k < 2; ++k) {
+            if (leaves[k]) {
+               leaves[k]->GetBranch()->GetEntry(local);
+               values[k][entry] = leaves[k]->GetValueLong64();
+            } else if (formulas[k]) {
+               values[k][entry] = EvalAndRangeCheck(formulas[k].get(), k == 0, names[k]->Data(), entry);
+            }
+         }
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      formulas[0].reset();
+      formulas[1].reset();
+   });
+   return ok;
+}
+#endif
 
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -95,6 +318,11 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
 ///
 /// To build an index with only majorname, specify minorname="0" (default)
 ///
+/// When the implicit multi-threading is enabled, the index values of a TTree
+/// read from a file are evaluated in parallel over its clusters, the branches
+/// holding a single integer being read without a TTreeFormula, and they are
+/// sorted by a parallel radix sort.
+///
 /// ## TreeIndex and Friend Trees
 ///
 /// Assuming a parent Tree T and a friend Tree TF, the following cases are supported:
@@ -171,7 +399,15 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
    Int_t current = -1;
-   for (i=0;i<fN;i++) {
+   bool evaluated = false;
+#ifdef R__USE_IMT
+   // a TTree read from a file is processed in parallel over its clusters
+   TFile *file = fTree->GetCurrentFile();
+   if (ROOT::IsImplicitMTEnabled() && !ROOT::Internal::TreeIndex::SequentialBuild() && fTree->IsA() == TTree::Class() &&
+       file && !file->IsWritable() && fN >= kBlockSize)
+      evaluated = EvalIndexValuesMT(fTree, fMajorName, fMinorName, tmp_major, tmp_minor);
+#endif
+   for (i = evaluated ? fN : 0; i < fN; i++) {
       Long64_t centry = fTree->LoadTree(i);
       if (centry < 0) break;
       if (fTree->GetTreeNumber() != current) {
@@ -179,38 +415,13 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
          fMajorFormula->UpdateFormulaLeaves();
          fMinorFormula->UpdateFormulaLeaves();
       }
-      auto GetAndRangeCheck = [this](bool isMajor, Long64_t entry) {
-         LongDouble_t ret = (isMajor ? fMajorFormula : fMinorFormula)->EvalInstance<LongDouble_t>();
-         // Check whether the value (vs significant bits) of ldRet can represent
-         // the full precision of the returned value. If we return 10^60, the
-         // value fits into a long double, but if sizeof(long double) ==
-         // sizeof(double) it cannot store the ones: the value returned by
-         // EvalInstance() only stores the higher bits.
-         LongDouble_t retCloserToZero = ret;
-         if (ret > 0)
-            retCloserToZero -= 1;
-         else
-            retCloserToZero += 1;
-         if (retCloserToZero == ret) {
-            Warning("TTreeIndex",
-                    "In tree entry %lld, %s value %s=%Lf possibly out of range for internal `long double`", entry,
-                    isMajor ? "major" : "minor", isMajor ? fMajorName.Data() : fMinorName.Data(), ret);
-         }
-         return ret;
-      };
-      tmp_major[i] = GetAndRangeCheck(true, i);
-      tmp_minor[i] = GetAndRangeCheck(false, i);
+      tmp_major[i] = EvalAndRangeCheck(fMajorFormula, true, fMajorName.Data(), i);
+      tmp_minor[i] = EvalAndRangeCheck(fMinorFormula, false, fMinorName.Data(), i);
    }
    fIndex = new Long64_t[fN];
-   for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
-   //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
-   for (i=0;i<fN;i++) {
-      fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
-   }
+   SortIndex(fN, tmp_major, tmp_minor, fIndex, fIndexValues, fIndexValuesMinor);
 
    delete [] tmp_major;
    delete [] tmp_minor;
@@ -239,6 +450,7 @@ TTreeIndex::~TTreeIndex()
 
 void TTreeIndex::Append(const TVirtualIndex *add, bool delaySort )
 {
+   ResetLookAhead();
 
    if (add && add->GetN()) {
       // Create new buffer (if needed)
@@ -291,19 +503,13 @@ void TTreeIndex::Append(const TVirtualIndex *add, bool delaySort )
       Long64_t *ind = fIndex;
       Long64_t *conv = new Long64_t[fN];
 
-      for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
-      //Long64_t *w = fIndexValues;
-      //TMath::Sort(fN,w,conv,0);
-
       fIndex = new Long64_t[fN];
       fIndexValues = new Long64_t[fN];
       fIndexValuesMinor = new Long64_t[fN];
+      SortIndex(fN, addValues, addValues2, conv, fIndexValues, fIndexValuesMinor);
 
-      for (Int_t i=0;i<fN;i++) {
+      for (Long64_t i = 0; i < fN; i++) {
          fIndex[i] = ind[conv[i]];
-         fIndexValues[i] = addValues[conv[i]];
-         fIndexValuesMinor[i] = addValues2[conv[i]];
       }
       delete [] addValues;
       delete [] addValues2;
@@ -347,6 +553,9 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
    Long64_t pentry = parent->GetReadEntry();
    if (pentry >= parent->GetEntries())
       return -2;
+   if (parent == fLookAheadParent && pentry >= fLookAheadFirst &&
+       pentry < fLookAheadFirst + (Long64_t)fLookAheadEntries.size())
+      return fLookAheadEntries[pentry - fLookAheadFirst];
    GetMajorFormulaParent(parent);
    GetMinorFormulaParent(parent);
    if (!fMajorFormulaParent || !fMinorFormulaParent) return -1;
@@ -373,6 +582,77 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Look up at once the entries of this tree matching the entries [first, last)
+/// of the parent tree.
+///
+/// The major and minor values of the parent entries are evaluated up front and
+/// the matching entry numbers are kept, so that GetEntryNumberFriend() answers
+/// from memory while the parent read entry stays in [first, last). The matching
+/// entries, sorted and without duplicates, are returned in `entries`, e.g. to
+/// fill the cache of this tree with TTreeCache::FillBufferForEntries().
+///
+/// The read entry of the parent is left unchanged, but the buffers of the
+/// branches holding the major and minor values are overwritten: the current
+/// entry of the parent must be read again. Nothing is looked up if the major or
+/// minor expression involves a tree other than the parent, e.g. one of its
+/// friends.
+
+void TTreeIndex::LookAheadFriend(const TTree *parent, Long64_t first, Long64_t last, std::vector<Long64_t> &entries)
+{
+   entries.clear();
+   ResetLookAhead();
+   if (!parent || !fTree)
+      return;
+   last = std::min(last, parent->GetEntries());
+   if (first < 0 || first >= last)
+      return;
+   GetMajorFormulaParent(parent);
+   GetMinorFormulaParent(parent);
+   if (!fMajorFormulaParent || !fMinorFormulaParent)
+      return;
+   if (!fMajorFormulaParent->GetNdim() || !fMinorFormulaParent->GetNdim())
+      return;
+   for (auto formula : {fMajorFormulaParent, fMinorFormulaParent}) {
+      for (Int_t i = 0; i < formula->GetNcodes(); ++i) {
+         TLeaf *leaf = formula->GetLeaf(i);
+         if (leaf && leaf->GetBranch()->GetTree() != parent)
+            return;
+      }
+   }
+
+   // Only the read entry of the parent moves, its friends are not loaded.
+   TTree *mparent = const_cast<TTree *>(parent);
+   const Long64_t readEntry = mparent->fReadEntry;
+   fLookAheadEntries.reserve(last - first);
+   for (Long64_t pentry = first; pentry < last; ++pentry) {
+      mparent->fReadEntry = pentry;
+      Long64_t majorv = (Long64_t)fMajorFormulaParent->EvalInstance();
+      Long64_t minorv = (Long64_t)fMinorFormulaParent->EvalInstance();
+      fLookAheadEntries.push_back(fTree->GetEntryNumberWithIndex(majorv, minorv));
+   }
+   mparent->fReadEntry = readEntry;
+   fLookAheadParent = parent;
+   fLookAheadFirst = first;
+
+   entries.reserve(fLookAheadEntries.size());
+   for (auto entry : fLookAheadEntries)
+      if (entry >= 0)
+         entries.push_back(entry);
+   std::sort(entries.begin(), entries.end());
+   entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the entries looked up by LookAheadFriend().
+
+void TTreeIndex::ResetLookAhead()
+{
+   fLookAheadParent = nullptr;
+   fLookAheadFirst = 0;
+   fLookAheadEntries.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// find position where major|minor values are in the IndexValues tables
 /// this is the index in IndexValues table, not entry# !
@@ -618,6 +898,7 @@ void TTreeIndex::Streamer(TBuffer &R__b)
 
 void TTreeIndex::UpdateFormulaLeaves(const TTree *parent)
 {
+   ResetLookAhead();
    if (fMajorFormula)       { fMajorFormula->UpdateFormulaLeaves();}
    if (fMinorFormula)       { fMinorFormula->UpdateFormulaLeaves();}
    if (fMajorFormulaParent) {
@@ -637,6 +918,7 @@ void TTreeIndex::UpdateFormulaLeaves(const TTree *parent)
 
 void TTreeIndex::SetTree(TTree *T)
 {
+   ResetLookAhead();
    fTree = T;
 }
 
@@ -78,6 +78,15 @@ extra libraries (Histogram, display, etc).
 #include "TObjString.h"
 #include "TTreeProxyGenerator.h"
 #include "TTreeReaderGenerator.h"
+#include "TTreeDrawJit.h"
+#include "RConfigure.h"
+#include "TEntryListArray.h"
+#include "TTreeReader.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include <mutex>
+#endif
 #include "TTreeIndex.h"
 #include "TChainIndex.h"
 #include "TRefProxy.h"
@@ -97,6 +106,91 @@ extra libraries (Histogram, display, etc).
 
 R__EXTERN Foption_t Foption;
 
+namespace {
+
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// TSelectorDraw evaluating the TTreeFormulas of a task of the parallel
+/// TTree::Draw, see TTreePlayer::ProcessDraw. The selected rows are passed to
+/// the TSelectorDraw of the TTreePlayer instead of filling the output.
+
+class TSelectorDrawTask : public TSelectorDraw {
+   TSelectorDraw *fMain; ///< Selector filling the output
+   TTree *fMainTree;     ///< Tree of fMain
+   std::mutex &fMutex;   ///< Serialises the calls to fMain
+
+   /// Number of rows buffered before they are passed to fMain
+   static constexpr Long64_t kTaskEstimate = 4096;
+
+public:
+   TSelectorDrawTask(TSelectorDraw *main, TTree *maintree, std::mutex &mutex)
+      : fMain(main), fMainTree(maintree), fMutex(mutex)
+   {
+   }
+
+   ~TSelectorDrawTask() override
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      ClearFormula();
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// Compile the expressions for tree, the TTree (or TChain) of the task.
+
+   bool Init(TTree *tree, const char *varexp, const char *selection)
+   {
+      fTree = tree;
+      {
+         // the compilation of the formulas is not thread-safe
+         std::lock_guard<std::mutex> lock(fMutex);
+         if (!CompileVariables(varexp, selection) || fObjEval)
+            return false;
+      }
+      for (Int_t i = 0; i < fDimension; ++i) {
+         fVarMultiple[i] = fVar[i] && fVar[i]->GetMultiplicity();
+         fVal[i] = new Double_t[kTaskEstimate];
+      }
+      fSelectMultiple = fSelect && fSelect->GetMultiplicity();
+      // the rows of an entry list are entered one by one
+      fTree->SetEstimate(fDimension ? kTaskEstimate : 1);
+      fForceRead = fTree->TestBit(TTree::kForceRead);
+      fW = new Double_t[kTaskEstimate];
+      fNfill = 0;
+      return true;
+   }
+
+   bool Notify() override
+   {
+      TSelectorDraw::Notify();
+      // the weight of the tree is applied by fMain
+      fWeight = 1;
+      return true;
+   }
+
+   void TakeAction() override
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      // TSelectorDraw::TakeAction uses the current entry of the tree for the entry lists
+      if (fDimension == 0)
+         fMainTree->LoadTree(fTree->GetReadEntry());
+      std::vector<Double_t> values(fDimension);
+      for (Int_t i = 0; i < fNfill; ++i) {
+         for (Int_t k = 0; k < fDimension; ++k)
+            values[k] = fVal[k][i];
+         fMain->FillValues(values.data(), fW[i]);
+      }
+   }
+
+   void Terminate() override
+   {
+      if (fNfill && fNfill < fTree->GetEstimate())
+         TakeAction();
+   }
+};
+#endif
+
+} // anonymous namespace
+
 TVirtualFitter *tFitter = nullptr;
 
 ClassImp(TTreePlayer);
@@ -118,6 +212,7 @@ TTreePlayer::TTreePlayer()
    fSelectorFromFile = nullptr;
    fSelectorClass    = nullptr;
    fSelectorUpdate   = nullptr;
+   fDrawJit          = false;
    fInput            = new TList();
    fInput->Add(new TNamed("varexp",""));
    fInput->Add(new TNamed("selection",""));
@@ -167,7 +262,11 @@ TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, co
 /// selected entries.
 ///
 /// -  selection is a standard selection expression (see TTreePlayer::Draw)
-/// -  option is reserved for possible future use
+/// -  option can contain "fast": without selection, the selected entries (all
+///    of them or the ones of the entry list of the tree) are copied by runs of
+///    consecutive entries, the baskets lying entirely in a run being copied
+///    without unzipping them, see TTree::CopyEntryRange. The option can also
+///    contain a sorting order of the baskets, see TTree::CloneTree.
 /// -  nentries is the number of entries to process (default is all)
 /// -  first is the first entry to process (default is 0)
 ///
@@ -192,7 +291,7 @@ TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, co
 ///   T2->Write();
 /// ~~~
 
-TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentries,
+TTree *TTreePlayer::CopyTree(const char *selection, Option_t *option, Long64_t nentries,
                              Long64_t firstentry)
 {
 
@@ -227,6 +326,27 @@ TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentrie
       fFormulaList->Add(select);
    }
 
+   TString opt = option;
+   opt.ToLower();
+   if (!select && opt.Contains("fast")) {
+      // Copy the runs of consecutive entries, the baskets lying entirely in a
+      // run being copied without unzipping them.
+      entry = firstentry;
+      while (entry < firstentry + nentries) {
+         entryNumber = fTree->GetEntryNumber(entry);
+         if (entryNumber < 0) break;
+         Long64_t n = 1;
+         while (entry + n < firstentry + nentries && fTree->GetEntryNumber(entry + n) == entryNumber + n)
+            ++n;
+         Long64_t localEntry = fTree->LoadTree(entryNumber);
+         if (localEntry < 0) break;
+         n = TMath::Min(n, fTree->GetTree()->GetEntries() - localEntry);
+         tree->CopyEntryRange(fTree->GetTree(), localEntry, localEntry + n, option);
+         entry += n;
+      }
+      return tree;
+   }
+
    //loop on the specified entries
    Int_t tnumber = -1;
    for (entry=firstentry;entry<firstentry+nentries;entry++) {
@@ -402,6 +522,15 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    if (cvarexp) cvarexp->SetTitle(varexp0);
    if (cselection) cselection->SetTitle(selection);
 
+   // option "jit" only changes how the expressions are evaluated
+   TString drawopt = option;
+   bool optjit = false;
+   for (Ssiz_t pos; (pos = drawopt.Index("jit", 0, TString::kIgnoreCase)) != kNPOS;) {
+      drawopt.Remove(pos, 3);
+      optjit = true;
+   }
+   option = drawopt.Data();
+
    TString opt = option;
    opt.ToLower();
    bool optpara   = false;
@@ -412,6 +541,7 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    if (opt.Contains("para")) optpara = true;
    if (opt.Contains("candle")) optcandle = true;
    if (opt.Contains("gl5d")) optgl5d = true;
+   if (opt.Contains("entrylist") || evlist || elist) optjit = false;
    bool pgl = gStyle->GetCanvasPreferGL();
    if (optgl5d) {
       fTree->SetEstimate(fTree->GetEntries());
@@ -425,7 +555,9 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    if (nentries > fTree->GetMaxEntryLoop()) nentries = fTree->GetMaxEntryLoop();
 
    // invoke the selector
+   fDrawJit = optjit && !optpara && !optcandle && !optgl5d;
    Long64_t nrows = Process(fSelector,option,nentries,firstentry);
+   fDrawJit = false;
    fSelectedRows = nrows;
    fDimension = fSelector->GetDimension();
 
@@ -2255,6 +2387,9 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
 
    bool process = (selector->GetAbort() != TSelector::kAbortProcess &&
                     (selector->Version() != 0 || selector->GetStatus() != -1)) ? true : false;
+   // TTree::Draw with option "jit" or implicit multithreading
+   if (process && selector == fSelector && ProcessDraw(firstentry, nentries))
+      process = false;
    if (process) {
 
       Long64_t readbytesatstart = 0;
@@ -2347,6 +2482,105 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
    return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Process the entries of DrawSelect without the entry loop of Process, once
+/// fSelector has been initialised. Return false, nothing having been done,
+/// if neither option "jit" nor implicit multithreading apply.
+///
+/// With option "jit", the expressions and the selection are compiled to native
+/// code by ROOT::Internal::TTreeDrawJit, and their values are passed to
+/// fSelector with TSelectorDraw::FillValues.
+///
+/// When implicit multithreading is enabled, a tree read from files is
+/// processed by ROOT::TTreeProcessorMT, its clusters in parallel, provided the
+/// output doesn't depend on the order of the entries: a histogram with fixed
+/// axes, or a TEntryList or TEventList for a TTree. Each task evaluates its own
+/// TTreeFormulas, and passes the selected rows to fSelector with a lock held.
+/// The histogram is then the same as in the sequential loop, up to the
+/// rounding of the sums of weights, but the values returned by
+/// TSelectorDraw::GetVal are in a non-deterministic order.
+
+bool TTreePlayer::ProcessDraw(Long64_t firstentry, Long64_t nentries)
+{
+   // the weights of the trees of a chain are applied by TSelectorDraw::Notify
+   if (fTree->IsA() == TChain::Class() && !fTree->TestBit(TChain::kGlobalWeight))
+      return false;
+   if (fTree->GetEntryList() || fTree->GetEventList())
+      return false;
+
+   TObject *obj = fInput->FindObject("varexp");
+   TString varexp = obj ? obj->GetTitle() : "";
+   Ssiz_t redirect = varexp.Index(">>");
+   if (redirect != kNPOS)
+      varexp.Remove(redirect);
+   obj = fInput->FindObject("selection");
+   const TString selection = obj ? obj->GetTitle() : "";
+
+   const Int_t action = fSelector->GetAction();
+   const Int_t dimension = fSelector->GetDimension();
+   TObject *output = fSelector->GetObject();
+   auto hist = dynamic_cast<TH1 *>(output);
+   const bool fills = std::abs(action) == 1 || std::abs(action) == 2 || action == 4 || action == 23 ||
+                      (action == 3 && hist && !hist->TestBit(kCanDelete));
+   const bool histogram = fills && hist && hist->GetBufferSize() == 0 && !hist->CanExtendAllAxes();
+   bool parallel = false;
+#ifdef R__USE_IMT
+   const bool entries = action == 5 && output && !output->InheritsFrom(TEntryListArray::Class()) &&
+                        fTree->IsA() != TChain::Class();
+   TFile *file = fTree->GetCurrentFile();
+   parallel = ROOT::IsImplicitMTEnabled() && file && !file->IsWritable() && fTree->GetUpdate() == 0 &&
+              (histogram || entries) && !(dimension == 1 && fSelector->GetVar1()->EvalClass());
+#endif
+
+   std::unique_ptr<ROOT::Internal::TTreeDrawJit> jit;
+   if (fDrawJit && dimension > 0 && (action < 5 || action > 8)) {
+      std::vector<TString> names;
+      fSelector->SplitNames(varexp, names);
+      jit = ROOT::Internal::TTreeDrawJit::Create(fTree, names, selection.Data());
+      if (jit && jit->GetDimension() != dimension)
+         jit.reset();
+   }
+   if (jit) {
+      jit->Run(fTree, firstentry, nentries, parallel && histogram, [&](std::vector<Double_t> &rows) {
+         for (std::size_t i = 0; i < rows.size(); i += dimension + 1)
+            fSelector->FillValues(&rows[i], rows[i + dimension]);
+      });
+      return true;
+   }
+
+#ifdef R__USE_IMT
+   if (!parallel)
+      return false;
+   std::unique_ptr<ROOT::TTreeProcessorMT> processor;
+   try {
+      processor = std::make_unique<ROOT::TTreeProcessorMT>(*fTree, 0u,
+                                                           std::make_pair(firstentry, firstentry + nentries));
+   } catch (const std::exception &) {
+      return false;
+   }
+   std::mutex mutex;
+   processor->Process([&](TTreeReader &reader) {
+      TSelectorDrawTask task(fSelector, fTree, mutex);
+      if (!task.Init(reader.GetTree(), varexp, selection)) {
+         Error("TTreePlayer::ProcessDraw", "Cannot compile the expressions for %s", reader.GetTree()->GetName());
+         return;
+      }
+      Int_t treenumber = -1;
+      while (reader.Next()) {
+         if (reader.GetTree()->GetTreeNumber() != treenumber) {
+            treenumber = reader.GetTree()->GetTreeNumber();
+            task.Notify();
+         }
+         task.ProcessFill(reader.GetCurrentEntry());
+      }
+      task.Terminate();
+   });
+   return true;
+#else
+   return false;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// cleanup pointers in the player pointing to obj
 
@@ -22,11 +22,20 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+Consecutive clusters of a file are grouped in larger subranges, according to
+TTreeProcessorMT::GetTasksPerWorkerHint(), while all workers are busy. When some of the
+workers become idle, e.g. at the end of the processing when only a few large files are
+left, the clusters that remain are handed out in smaller subranges so that the idle
+workers share the work of the busy ones.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 
 #include "TROOT.h"
+#include "ROOT/TSeq.hxx"
 #include "ROOT/TTreeProcessorMT.hxx"
 
 using namespace ROOT;
@@ -132,8 +141,13 @@ ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames,
 {
    // Note that as a side-effect of opening all files that are going to be used in the
    // analysis once, all necessary streamers will be loaded into memory.
-   TDirectory::TContext c;
+   // Without a range, the headers of all trees are read concurrently, or taken from the metadata cache, see
+   // TreeUtils::GetTreesMetadata. With a range, the files are opened one after the other until the end of the range.
    const auto nFileNames = fileNames.size();
+   const bool hasRangeEnd = range.second != std::numeric_limits<Long64_t>::max();
+   std::vector<ROOT::Internal::TreeUtils::RTreeMetadata> metadata;
+   if (!hasRangeEnd)
+      metadata = ROOT::Internal::TreeUtils::GetTreesMetadata(treeNames, fileNames);
    std::vector<std::vector<EntryRange>> clustersPerFile;
    std::vector<Long64_t> entriesPerFile;
    entriesPerFile.reserve(nFileNames);
@@ -143,30 +157,25 @@ ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames,
       const auto &fileName = fileNames[i];
       const auto &treeName = treeNames[i];
 
-      std::unique_ptr<TFile> f(TFile::Open(
-         fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION")); // need TFile::Open to load plugins if need be
-      if (!f || f->IsZombie()) {
+      const auto treeMetadata =
+         hasRangeEnd ? ROOT::Internal::TreeUtils::GetTreesMetadata({treeName}, {fileName})[0] : std::move(metadata[i]);
+      if (treeMetadata.fEntries == -1) {
          const auto msg = "TTreeProcessorMT::Process: an error occurred while opening file \"" + fileName + "\"";
          throw std::runtime_error(msg);
       }
-      auto *t = f->Get<TTree>(treeName.c_str()); // t will be deleted by f
-
-      if (!t) {
+      if (treeMetadata.fEntries < 0) {
          const auto msg = "TTreeProcessorMT::Process: an error occurred while getting tree \"" + treeName +
                           "\" from file \"" + fileName + "\"";
          throw std::runtime_error(msg);
       }
 
-      // Avoid calling TROOT::RecursiveRemove for this tree, it takes the read lock and we don't need it.
-      t->ResetBit(kMustCleanup);
-      ROOT::Internal::TreeUtils::ClearMustCleanupBits(*t->GetListOfBranches());
-      auto clusterIter = t->GetClusterIterator(0);
-      Long64_t clusterStart = 0ll, clusterEnd = 0ll;
-      const Long64_t entries = t->GetEntries();
+      const Long64_t entries = treeMetadata.fEntries;
+      const auto &boundaries = treeMetadata.fClusterBoundaries;
       // Iterate over the clusters in the current file
       std::vector<EntryRange> entryRanges;
-      while ((clusterStart = clusterIter()) < entries && !rangeEndReached) {
-         clusterEnd = clusterIter.GetNextEntry();
+      for (std::size_t c = 0; c + 1 < boundaries.size() && !rangeEndReached; ++c) {
+         const Long64_t clusterStart = boundaries[c];
+         const Long64_t clusterEnd = boundaries[c + 1];
          // Currently, if a user specified a range, the clusters will be only globally obtained
          // Assume that there are 3 files with entries: [0, 100], [0, 150], [0, 200] (in this order)
          // Since the cluster boundaries are obtained sequentially, applying the offsets, the boundaries
@@ -244,6 +253,50 @@ ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames,
    return std::make_pair(std::move(eventRangesPerFile), std::move(entriesPerFile));
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Process the contiguous entry ranges of one file (usually its clusters) in chunks of consecutive ranges, which
+/// `nTasks` concurrent tasks take from a shared cursor. While all workers of the pool are busy processing, a chunk
+/// holds up to `fold` ranges, which bounds the number of TTreeReaders created. While some workers are idle, e.g. at
+/// the end of the event loop when the remaining work is in a few large files, the remaining ranges are split in
+/// smaller chunks that the idle workers take over through the tasks of this file that have not started yet.
+void ProcessRangesDynamically(ROOT::TThreadExecutor &pool, const std::vector<EntryRange> &ranges, std::size_t fold,
+                              std::atomic<unsigned int> &nBusy, const std::function<void(const EntryRange &)> &process)
+{
+   const auto n = ranges.size();
+   if (n == 0)
+      return;
+   const auto poolSize = pool.GetPoolSize();
+   // a single chunk cannot be split later, leave the second half of the file to the workers that become idle
+   fold = std::max<std::size_t>(1, std::min(fold, (n + 1) / 2));
+
+   std::atomic<std::size_t> next{0};
+   auto work = [&](unsigned int) {
+      while (true) {
+         const auto busy = nBusy.load(std::memory_order_relaxed);
+         const auto nIdle = busy < poolSize ? poolSize - busy : 0u;
+         auto first = next.load();
+         std::size_t last = 0;
+         do {
+            if (first >= n)
+               return;
+            const auto remaining = n - first;
+            const auto chunk = nIdle > 0 ? std::min(fold, (remaining + nIdle) / (nIdle + 1)) : fold;
+            last = first + std::min(remaining, std::max<std::size_t>(chunk, 1));
+         } while (!next.compare_exchange_weak(first, last));
+
+         ++nBusy;
+         try {
+            process(EntryRange{ranges[first].first, ranges[last - 1].second});
+         } catch (...) {
+            --nBusy;
+            throw;
+         }
+         --nBusy;
+      }
+   };
+   pool.Foreach(work, ROOT::TSeqU(std::min<std::size_t>(n, poolSize)));
+}
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -453,9 +506,15 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree, UInt_t nThreads, const EntryRang
 /// \param[in] func User-defined function that processes a subrange of entries
 void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 {
-   // compute number of tasks per file
+   // compute number of tasks per file, as long as all workers are busy
    const unsigned int maxTasksPerFile =
       std::ceil(float(GetTasksPerWorkerHint() * fPool.GetPoolSize()) / float(fFileNames.size()));
+   // clusters are not fused upfront but grouped in chunks while processing, see ProcessRangesDynamically
+   const unsigned int noFusion = std::numeric_limits<unsigned int>::max();
+   auto getFold = [maxTasksPerFile](std::size_t nClusters) {
+      return (nClusters + maxTasksPerFile - 1) / maxTasksPerFile;
+   };
+   std::atomic<unsigned int> nBusy{0};
 
    // If an entry list or friend trees are present, we need to generate clusters with global entry numbers,
    // so we do it here for all files.
@@ -470,7 +529,7 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    auto &allClusters = allClusterAndEntries.first;
    const auto &allEntries = allClusterAndEntries.second;
    if (shouldRetrieveAllClusters) {
-      allClusterAndEntries = MakeClusters(fTreeNames, fFileNames, maxTasksPerFile, fGlobalRange);
+      allClusterAndEntries = MakeClusters(fTreeNames, fFileNames, noFusion, fGlobalRange);
       if (hasEntryList)
          allClusters = ConvertToElistClusters(std::move(allClusters), fEntryList, fTreeNames, fFileNames, allEntries);
    }
@@ -482,7 +541,8 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
             fTreeView->GetTreeReader(c.first, c.second, fTreeNames, fFileNames, fFriendInfo, fEntryList, allEntries);
          func(*r);
       };
-      fPool.Foreach(processCluster, allClusters[fileIdx]);
+      const auto &clusters = allClusters[fileIdx];
+      ProcessRangesDynamically(fPool, clusters, getFold(clusters.size()), nBusy, processCluster);
    };
 
    // Per-file processing that also retrieves cluster info for a file
@@ -490,14 +550,14 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
       // Evaluate clusters (with local entry numbers) and number of entries for this file
       const auto &treeNames = std::vector<std::string>({fTreeNames[fileIdx]});
       const auto &fileNames = std::vector<std::string>({fFileNames[fileIdx]});
-      const auto clustersAndEntries = MakeClusters(treeNames, fileNames, maxTasksPerFile);
+      const auto clustersAndEntries = MakeClusters(treeNames, fileNames, noFusion);
       const auto &clusters = clustersAndEntries.first[0];
       const auto &entries = clustersAndEntries.second[0];
       auto processCluster = [&](const EntryRange &c) {
          auto r = fTreeView->GetTreeReader(c.first, c.second, treeNames, fileNames, fFriendInfo, fEntryList, {entries});
          func(*r);
       };
-      fPool.Foreach(processCluster, clusters);
+      ProcessRangesDynamically(fPool, clusters, getFold(clusters.size()), nBusy, processCluster);
    };
 
    const auto firstNonEmpty =
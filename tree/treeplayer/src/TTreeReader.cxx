@@ -12,14 +12,18 @@
 #include "TTreeReader.h"
 
 #include "TChain.h"
+#include "TCollection.h" // TRangeStaticCast
 #include "TDirectory.h"
 #include "TEntryList.h"
 #include "TTreeCache.h"
+#include "TTreeIndex.h"
 #include "TTreeReaderValue.h"
 #include "TFriendElement.h"
 #include "TFriendProxy.h"
 #include "ROOT/InternalTreeUtils.hxx"
 
+#include <algorithm>
+
 // clang-format off
 /**
  \class TTreeReader
@@ -261,12 +265,53 @@ TTreeReader::~TTreeReader()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the reading of the friends of fTree indexed by a TTreeIndex for the
+/// cluster of fTree holding `entry`.
+///
+/// Without this, each entry looks up its friend entry through the index and
+/// the friend is read in random order, defeating its TTreeCache. Instead, the
+/// friend entries needed by the whole cluster are looked up at once (see
+/// TTreeIndex::LookAheadFriend()) and the baskets holding them are read into
+/// the friend's TTreeCache in file order (see TTreeCache::FillBufferForEntries()).
+/// Only plain TTree friends of a plain TTree are handled; the others, and
+/// friends whose TTreeCache is not created yet or still learning, are read as
+/// before.
+
+void TTreeReader::LookAheadIndexedFriends(Long64_t entry)
+{
+   fFriendLookAheadBegin = fFriendLookAheadEnd = -1;
+   const auto *friendsList = fTree->GetListOfFriends();
+   if (!friendsList || friendsList->GetEntries() == 0 || entry >= fTree->GetEntriesFast())
+      return;
+
+   auto clusterIter = fTree->GetClusterIterator(entry);
+   fFriendLookAheadBegin = clusterIter();
+   fFriendLookAheadEnd = clusterIter.GetNextEntry();
+
+   std::vector<Long64_t> entries;
+   for (auto fe : ROOT::Detail::TRangeStaticCast<TFriendElement>(*friendsList)) {
+      TTree *frTree = fe->GetTree();
+      if (!frTree || frTree->InheritsFrom(TChain::Class()))
+         continue;
+      auto index = dynamic_cast<TTreeIndex *>(frTree->GetTreeIndex());
+      if (!index)
+         continue;
+      index->LookAheadFriend(fTree, fFriendLookAheadBegin, fFriendLookAheadEnd, entries);
+      TFile *frFile = frTree->GetCurrentFile();
+      if (TTreeCache *cache = frFile ? frTree->GetReadCache(frFile) : nullptr)
+         cache->FillBufferForEntries(entries);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialization of the director.
 
 void TTreeReader::Initialize()
 {
    fEntry = -1;
+   fFriendLookAheadBegin = -1;
+   fFriendLookAheadEnd = -1;
    if (!fTree) {
       fEntryStatus = kEntryNoTree;
       fLoadTreeStatus = kNoTree;
@@ -364,7 +409,7 @@ bool TTreeReader::SetProxies() {
    // Now we need to properly set the TTreeCache. We do this in steps:
    // 1. We set the entry range according to the entry range of the TTreeReader
    // 2. We add to the cache the branches identifying them by the name the user provided
-   //    upon creation of the TTreeReader{Value, Array}s
+   //    upon creation of the TTreeReader{Value, Array}s, except for those in fUncachedBranches
    // 3. We stop the learning phase.
    // Operations 1, 2 and 3 need to happen in this order. See: https://sft.its.cern.ch/jira/browse/ROOT-9773?focusedCommentId=87837
    if (fProxiesSet) {
@@ -376,6 +421,9 @@ bool TTreeReader::SetProxies() {
             fTree->SetCacheEntryRange(fBeginEntry, lastEntry);
          }
          for (auto value: fValues) {
+            if (std::find(fUncachedBranches.begin(), fUncachedBranches.end(), value->GetBranchName()) !=
+                fUncachedBranches.end())
+               continue;
             fTree->AddBranchToCache(value->GetProxy()->GetBranchName(), true);
          }
          fTree->StopCacheLearningPhase();
@@ -609,6 +657,10 @@ TTreeReader::EEntryStatus TTreeReader::SetEntryBase(Long64_t entry, bool local)
       }
    }
 
+   if (!IsChain() && entryAfterList >= 0 &&
+       (entryAfterList < fFriendLookAheadBegin || entryAfterList >= fFriendLookAheadEnd))
+      LookAheadIndexedFriends(entryAfterList);
+
    TTree* treeToCallLoadOn = local ? fTree->GetTree() : fTree;
 
    fSetEntryBaseCallingLoadTree = true;
@@ -0,0 +1,33 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TreeIndexUtils
+#define ROOT_TreeIndexUtils
+
+namespace ROOT {
+namespace Internal {
+namespace TreeIndex {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Whether the TTreeIndexes built by the current thread must evaluate their
+/// index values sequentially, e.g. in the tasks of a TChainIndex building the
+/// indices of its trees in parallel.
+
+inline bool &SequentialBuild()
+{
+   thread_local bool sequential = false;
+   return sequential;
+}
+
+} // namespace TreeIndex
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -5,6 +5,7 @@
 #include "TLeaf.h"
 #include "TROOT.h"
 #include "TTree.h"
+#include "TTreeCache.h"
 #include "TTreeReader.h"
 #include "TTreeReaderValue.h"
 #include "TTreeReaderArray.h"
@@ -534,3 +535,43 @@ TEST(TTreeReaderBasic, ZeroEntriesTree)
    EXPECT_TRUE(b++ == e);
    EXPECT_TRUE(++b_copy == e);
 }
+
+TEST(TTreeReaderBasic, UncachedBranches)
+{
+   const auto filename = "TTreeReaderBasicUncachedBranches.root";
+   {
+      TFile f(filename, "RECREATE");
+      TTree t("t", "t");
+      int x = 0;
+      int y = 0;
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      for (x = 0; x < 100; ++x) {
+         y = 2 * x;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(filename);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   TTreeReader r(t);
+   TTreeReaderValue<int> x(r, "x");
+   TTreeReaderValue<int> y(r, "y");
+   r.SetUncachedBranches({"y"});
+   while (r.Next()) {
+      if (*x % 10 == 0) {
+         EXPECT_EQ(*y, 2 * *x);
+      }
+   }
+
+   auto cache = dynamic_cast<TTreeCache *>(f.GetCacheRead(t));
+   ASSERT_NE(cache, nullptr);
+   const auto cached = cache->GetCachedBranches();
+   ASSERT_NE(cached, nullptr);
+   EXPECT_NE(cached->FindObject(t->GetBranch("x")), nullptr);
+   EXPECT_EQ(cached->FindObject(t->GetBranch("y")), nullptr);
+
+   gSystem->Unlink(filename);
+}
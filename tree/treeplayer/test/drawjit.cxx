@@ -0,0 +1,89 @@
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+std::unique_ptr<TTree> MakeTree()
+{
+   auto tree = std::make_unique<TTree>("drawjit", "In-memory test tree");
+   tree->SetDirectory(nullptr);
+   Int_t n = 0;
+   Float_t pt[10];
+   Double_t x = 0;
+   tree->Branch("n", &n, "n/I");
+   tree->Branch("pt", pt, "pt[n]/F");
+   tree->Branch("x", &x, "x/D");
+   for (Int_t i = 0; i < 1000; ++i) {
+      n = i % 7;
+      for (Int_t j = 0; j < n; ++j)
+         pt[j] = 0.1f * ((i * 13 + j * 7) % 100);
+      x = 0.01 * (i % 250) - 1;
+      tree->Fill();
+   }
+   tree->ResetBranchAddresses();
+   return tree;
+}
+
+void ExpectSame(const TH1 &h1, const TH1 &h2)
+{
+   ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+   EXPECT_DOUBLE_EQ(h1.GetEntries(), h2.GetEntries());
+   for (Int_t i = 0; i < h1.GetNcells(); ++i)
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(i), h2.GetBinContent(i)) << "bin " << i;
+}
+
+void Compare(TTree &tree, const char *varexp, const char *selection)
+{
+   TH1D h1("h1", "", 50, -2, 12);
+   TH1D h2("h2", "", 50, -2, 12);
+   auto n1 = tree.Draw(TString::Format("%s>>h1", varexp), selection, "goff");
+   auto n2 = tree.Draw(TString::Format("%s>>h2", varexp), selection, "goff jit");
+   EXPECT_EQ(n1, n2) << varexp << " " << selection;
+   ExpectSame(h1, h2);
+}
+
+} // anonymous namespace
+
+TEST(TTreeDrawJit, Scalars)
+{
+   auto tree = MakeTree();
+   Compare(*tree, "x*10", "");
+   Compare(*tree, "sqrt(abs(x))+TMath::Power(x,2)", "x>0 && n!=3");
+   Compare(*tree, "n", "x*(n+1)");
+}
+
+TEST(TTreeDrawJit, Arrays)
+{
+   auto tree = MakeTree();
+   Compare(*tree, "pt", "");
+   Compare(*tree, "pt*(x>0)+Iteration$", "pt>2");
+   Compare(*tree, "pt[2]", "");
+   Compare(*tree, "Sum$(pt)/3", "Length$(pt)>1");
+   Compare(*tree, "Max$(pt)-Min$(pt)", "");
+   Compare(*tree, "Length$(pt)", "Sum$(pt>5)>=2");
+}
+
+TEST(TTreeDrawJit, TwoDimensions)
+{
+   auto tree = MakeTree();
+   TH2D h1("h1", "", 20, -1, 2, 20, 0, 10);
+   TH2D h2("h2", "", 20, -1, 2, 20, 0, 10);
+   auto n1 = tree->Draw("pt:x>>h1", "n>2", "goff");
+   auto n2 = tree->Draw("pt:x>>h2", "n>2", "goff jit");
+   EXPECT_EQ(n1, n2);
+   ExpectSame(h1, h2);
+}
+
+TEST(TTreeDrawJit, Fallback)
+{
+   auto tree = MakeTree();
+   // Entry$ is not supported by the compiled expressions
+   Compare(*tree, "x+Entry$/1000.", "");
+   // neither are the bitwise operators
+   Compare(*tree, "n&1", "");
+}
@@ -0,0 +1,128 @@
+#include <TChain.h>
+#include <TEntryList.h>
+#include <TEventList.h>
+#include <TFile.h>
+#include <TH1D.h>
+#include <TH2D.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+void WriteFile(const char *filename, int first, int nevents)
+{
+   TFile file(filename, "recreate");
+   TTree t("t", "t");
+   int n = 0;
+   float pt[8];
+   double x = 0;
+   t.Branch("n", &n, "n/I");
+   t.Branch("pt", pt, "pt[n]/F");
+   t.Branch("x", &x, "x/D");
+   t.SetAutoFlush(500);
+   for (int i = first; i < first + nevents; ++i) {
+      n = i % 8;
+      for (int j = 0; j < n; ++j)
+         pt[j] = 0.1f * ((i * 13 + j * 7) % 100);
+      x = 0.01 * (i % 250) - 1;
+      t.Fill();
+   }
+   t.Write();
+}
+
+void ExpectSame(const TH1 &h1, const TH1 &h2)
+{
+   ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+   EXPECT_DOUBLE_EQ(h1.GetEntries(), h2.GetEntries());
+   for (int i = 0; i < h1.GetNcells(); ++i)
+      EXPECT_NEAR(h1.GetBinContent(i), h2.GetBinContent(i), 1e-9 * std::abs(h1.GetBinContent(i))) << "bin " << i;
+}
+
+class TTreeDrawMT : public ::testing::Test {
+protected:
+   static void SetUpTestSuite()
+   {
+      WriteFile("drawmt_0.root", 0, 5000);
+      WriteFile("drawmt_1.root", 5000, 3000);
+   }
+   static void TearDownTestSuite()
+   {
+      gSystem->Unlink("drawmt_0.root");
+      gSystem->Unlink("drawmt_1.root");
+   }
+   void TearDown() override { ROOT::DisableImplicitMT(); }
+
+   // Draw varexp>>name with and without implicit multithreading
+   static void Compare(TTree &tree, TH1 &seq, TH1 &mt, const char *varexp, const char *selection,
+                       const char *option = "goff")
+   {
+      const auto n1 = tree.Draw(TString::Format("%s>>%s", varexp, seq.GetName()), selection, option);
+      ROOT::EnableImplicitMT(4);
+      const auto n2 = tree.Draw(TString::Format("%s>>%s", varexp, mt.GetName()), selection, option);
+      ROOT::DisableImplicitMT();
+      EXPECT_EQ(n1, n2) << varexp << " " << selection;
+      ExpectSame(seq, mt);
+   }
+};
+
+} // anonymous namespace
+
+TEST_F(TTreeDrawMT, Histograms)
+{
+   TFile file("drawmt_0.root");
+   auto tree = file.Get<TTree>("t");
+   TH1D h1("h1", "", 50, -2, 12), h2("h2", "", 50, -2, 12);
+   Compare(*tree, h1, h2, "pt", "x>0");
+   TH1D h3("h3", "", 40, 0, 40), h4("h4", "", 40, 0, 40);
+   Compare(*tree, h3, h4, "Sum$(pt)", "n>2");
+   TH2D h5("h5", "", 20, -1, 2, 20, 0, 10), h6("h6", "", 20, -1, 2, 20, 0, 10);
+   Compare(*tree, h5, h6, "pt:x", "pt>2");
+   // compiled expressions
+   TH1D h7("h7", "", 50, -2, 12), h8("h8", "", 50, -2, 12);
+   Compare(*tree, h7, h8, "pt*(x>0)", "", "goff jit");
+}
+
+TEST_F(TTreeDrawMT, Chain)
+{
+   TChain chain("t");
+   chain.Add("drawmt_0.root");
+   chain.Add("drawmt_1.root");
+   chain.SetWeight(2, "global");
+   TH1D h1("h1", "", 50, -2, 12), h2("h2", "", 50, -2, 12);
+   Compare(chain, h1, h2, "pt[1]", "x<0.5");
+}
+
+TEST_F(TTreeDrawMT, EntryLists)
+{
+   TFile file("drawmt_0.root");
+   auto tree = file.Get<TTree>("t");
+
+   tree->Draw(">>elseq", "Length$(pt)>3 && x>0", "entrylist");
+   ROOT::EnableImplicitMT(4);
+   tree->Draw(">>elmt", "Length$(pt)>3 && x>0", "entrylist");
+   tree->Draw(">>evmt", "pt>8");
+   ROOT::DisableImplicitMT();
+   tree->Draw(">>evseq", "pt>8");
+
+   auto elseq = gDirectory->Get<TEntryList>("elseq");
+   auto elmt = gDirectory->Get<TEntryList>("elmt");
+   ASSERT_NE(elseq, nullptr);
+   ASSERT_NE(elmt, nullptr);
+   ASSERT_EQ(elseq->GetN(), elmt->GetN());
+   for (Long64_t i = 0; i < elseq->GetN(); ++i)
+      EXPECT_EQ(elseq->GetEntry(i), elmt->GetEntry(i));
+
+   auto evseq = gDirectory->Get<TEventList>("evseq");
+   auto evmt = gDirectory->Get<TEventList>("evmt");
+   ASSERT_NE(evseq, nullptr);
+   ASSERT_NE(evmt, nullptr);
+   ASSERT_EQ(evseq->GetN(), evmt->GetN());
+   for (Int_t i = 0; i < evseq->GetN(); ++i)
+      EXPECT_EQ(evseq->GetEntry(i), evmt->GetEntry(i));
+}
@@ -0,0 +1,99 @@
+#include <TChain.h>
+#include <TChainIndex.h>
+#include <TFile.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TTreeIndex.h>
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+// enough entries for the index values to be evaluated and sorted in parallel
+constexpr int kEntries = 150000;
+
+void WriteFile(const char *filename, int first, int runOffset)
+{
+   TFile file(filename, "recreate");
+   TTree t("t", "t");
+   int run = 0;
+   Long64_t event = 0;
+   t.Branch("run", &run, "run/I");
+   t.Branch("event", &event, "event/L");
+   t.SetAutoFlush(10000);
+   for (int i = first; i < first + kEntries; ++i) {
+      run = runOffset + (i * 7919) % 13 - 6;
+      event = (i * 104729LL) % 1000003 - 500000;
+      t.Fill();
+   }
+   t.Write();
+}
+
+class TTreeIndexMT : public ::testing::Test {
+protected:
+   static void SetUpTestSuite()
+   {
+      // the run numbers of the files don't overlap, as required by TChainIndex
+      WriteFile("indexmt_0.root", 0, 0);
+      WriteFile("indexmt_1.root", kEntries, 100);
+   }
+   static void TearDownTestSuite()
+   {
+      gSystem->Unlink("indexmt_0.root");
+      gSystem->Unlink("indexmt_1.root");
+   }
+   void TearDown() override { ROOT::DisableImplicitMT(); }
+};
+
+} // anonymous namespace
+
+TEST_F(TTreeIndexMT, Tree)
+{
+   TFile file("indexmt_0.root");
+   auto tree = file.Get<TTree>("t");
+   // one index reads the leaves, the other one goes through TTreeFormula
+   TTreeIndex serial(tree, "run", "event");
+   TTreeIndex serialExpr(tree, "run+1", "2*event");
+   ROOT::EnableImplicitMT(4);
+   TTreeIndex parallel(tree, "run", "event");
+   TTreeIndex parallelExpr(tree, "run+1", "2*event");
+
+   ASSERT_EQ(serial.GetN(), kEntries);
+   ASSERT_EQ(parallel.GetN(), kEntries);
+   ASSERT_EQ(parallelExpr.GetN(), kEntries);
+   for (Long64_t i = 0; i < kEntries; ++i) {
+      ASSERT_EQ(serial.GetIndex()[i], parallel.GetIndex()[i]) << i;
+      ASSERT_EQ(serial.GetIndexValues()[i], parallel.GetIndexValues()[i]) << i;
+      ASSERT_EQ(serial.GetIndexValuesMinor()[i], parallel.GetIndexValuesMinor()[i]) << i;
+      ASSERT_EQ(serialExpr.GetIndex()[i], parallelExpr.GetIndex()[i]) << i;
+   }
+}
+
+TEST_F(TTreeIndexMT, Chain)
+{
+   TChain chain("t");
+   chain.Add("indexmt_0.root");
+   chain.Add("indexmt_1.root");
+   TChainIndex serial(&chain, "run", "event");
+   ROOT::EnableImplicitMT(4);
+   TChainIndex parallel(&chain, "run", "event");
+   ASSERT_FALSE(serial.IsZombie());
+   ASSERT_FALSE(parallel.IsZombie());
+
+   TFile file("indexmt_1.root");
+   auto tree = file.Get<TTree>("t");
+   int run = 0;
+   Long64_t event = 0;
+   tree->SetBranchAddress("run", &run);
+   tree->SetBranchAddress("event", &event);
+   for (Long64_t i = 0; i < kEntries; i += 997) {
+      tree->GetEntry(i);
+      EXPECT_EQ(serial.GetEntryNumberWithIndex(run, event), kEntries + i);
+      EXPECT_EQ(parallel.GetEntryNumberWithIndex(run, event), kEntries + i);
+      EXPECT_EQ(parallel.GetEntryNumberWithIndex(run - 100, event), serial.GetEntryNumberWithIndex(run - 100, event));
+   }
+   EXPECT_EQ(parallel.GetEntryNumberWithIndex(1000, 0), -1);
+}
@@ -371,21 +371,18 @@ TEST(TreeProcessorMT, LimitNTasks_CheckEntries)
    ROOT::TTreeProcessorMT p(filename, treename);
    p.Process(f);
 
-   if (nslots == 4) {
-      EXPECT_EQ(nTasks, 40U) << "Wrong number of tasks generated!\n";
-      EXPECT_EQ(nEntriesCountsMap[24], 9U) << "Wrong number of tasks with 24 clusters each!\n";
-      EXPECT_EQ(nEntriesCountsMap[25], 31U) << "Wrong number of tasks with 25 clusters each!\n";
-   }
-   else if (nslots == 2) {
-      EXPECT_EQ(nTasks, 20U) << "Wrong number of tasks generated!\n";
-      EXPECT_EQ(nEntriesCountsMap[49], 9U) << "Wrong number of tasks with 49 clusters each!\n";
-      EXPECT_EQ(nEntriesCountsMap[50], 11U) << "Wrong number of tasks with 50 clusters each!\n";
-   }
-   else if (nslots == 1) {
-      EXPECT_EQ(nTasks, 10U) << "Wrong number of tasks generated!\n";
-      EXPECT_EQ(nEntriesCountsMap[99], 9U) << "Wrong number of tasks with 99 clusters each!\n";
-      EXPECT_EQ(nEntriesCountsMap[100], 1U) << "Wrong number of tasks with 100 clusters each!\n";
+   // While all workers are busy, tasks hold ceil(nClusters / (GetTasksPerWorkerHint() * nslots)) clusters, here of
+   // one entry each. Smaller tasks are only created for the workers that are idle, e.g. at the end.
+   const auto maxEntriesPerTask =
+      (nEvents + ROOT::TTreeProcessorMT::GetTasksPerWorkerHint() * nslots - 1) /
+      (ROOT::TTreeProcessorMT::GetTasksPerWorkerHint() * nslots);
+   EXPECT_GE(nTasks, (nEvents + maxEntriesPerTask - 1) / maxEntriesPerTask) << "Wrong number of tasks generated!\n";
+   auto nProcessed = 0U;
+   for (const auto &entriesAndCount : nEntriesCountsMap) {
+      EXPECT_LE(entriesAndCount.first, maxEntriesPerTask) << "Tasks with too many clusters were generated!\n";
+      nProcessed += entriesAndCount.first * entriesAndCount.second;
    }
+   EXPECT_EQ(nProcessed, unsigned(nEvents));
 
    gSystem->Unlink(filename);
    ROOT::DisableImplicitMT();
@@ -214,3 +214,74 @@ TEST_F(TTreeReaderFriends, MainTreeShorterTChainExtraFriend)
                       /*matchFullMessage*/ true);
    r.SetEntry(2);
 }
+
+// Friend indexed by (run, event) and stored in a different order than the main tree: its entries needed by
+// each cluster of the main tree are looked up ahead.
+TEST(TTreeReaderIndexedFriend, LookAhead)
+{
+   const auto mainFileName = "ttreereader_indexedfriend_main.root";
+   const auto friendFileName = "ttreereader_indexedfriend_friend.root";
+   {
+      TFile f(mainFileName, "RECREATE");
+      TTree t("events", "events");
+      t.SetAutoFlush(100);
+      int run{}, event{};
+      t.Branch("run", &run);
+      t.Branch("event", &event);
+      for (int i = 0; i < 1000; ++i) {
+         run = i / 250;
+         event = i;
+         t.Fill();
+      }
+      f.Write();
+   }
+   {
+      TFile f(friendFileName, "RECREATE");
+      TTree t("calib", "calib");
+      t.SetAutoFlush(100);
+      int run{}, event{};
+      double c{};
+      t.Branch("run", &run);
+      t.Branch("event", &event);
+      t.Branch("c", &c);
+      for (int k = 0; k < 1000; ++k) {
+         const int i = (k * 37) % 1000;
+         run = i / 250;
+         event = i;
+         c = 0.5 * i;
+         t.Fill();
+      }
+      t.BuildIndex("run", "event");
+      f.Write();
+   }
+
+   {
+      std::unique_ptr<TFile> fMain{TFile::Open(mainFileName)};
+      auto tMain = fMain->Get<TTree>("events");
+      std::unique_ptr<TFile> fFriend{TFile::Open(friendFileName)};
+      auto tFriend = fFriend->Get<TTree>("calib");
+      ASSERT_NE(tFriend->GetTreeIndex(), nullptr);
+      tMain->AddFriend(tFriend);
+
+      TTreeReader r(tMain);
+      TTreeReaderValue<int> event(r, "event");
+      TTreeReaderValue<double> c(r, "c");
+      Long64_t n = 0;
+      while (r.Next()) {
+         EXPECT_EQ(*event, r.GetCurrentEntry());
+         EXPECT_DOUBLE_EQ(*c, 0.5 * *event);
+         ++n;
+      }
+      EXPECT_EQ(n, 1000);
+
+      // Jumping around the clusters of the main tree
+      for (Long64_t entry : {999, 3, 512, 511, 0, 100}) {
+         ASSERT_EQ(r.SetEntry(entry), TTreeReader::kEntryValid);
+         EXPECT_EQ(*event, entry);
+         EXPECT_DOUBLE_EQ(*c, 0.5 * entry);
+      }
+   }
+
+   std::remove(mainFileName);
+   std::remove(friendFileName);
+}